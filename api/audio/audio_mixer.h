@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -48,6 +49,22 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // The audio level of the most recently received audio, as signaled by the
+    // sender in the RTP audio level header extension (RFC 6464), i.e. in -dBov
+    // where 0 is the loudest and 127 is silence. Lets a mixer rank the sources
+    // before getting their audio. Returns nullopt if the level is unknown.
+    virtual absl::optional<int> LatestAudioLevel() const {
+      return absl::nullopt;
+    }
+
+    // Called instead of GetAudioFrameWithInfo() when the mixer will not mix
+    // this source in this round. Advances the source by 10 ms, without
+    // necessarily producing the audio. `audio_frame` may be overwritten. The
+    // default implementation gets the audio and drops it.
+    virtual void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) {
+      GetAudioFrameWithInfo(sample_rate_hz, audio_frame);
+    }
+
     virtual ~Source() {}
   };
 
@@ -93,6 +93,9 @@ struct RTC_EXPORT EchoCanceller3Config {
     bool use_linear_filter = true;
     bool high_pass_filter_echo_reference = false;
     bool export_linear_aec_output = false;
+    // Threads, besides the calling one, that adapt the filters of the capture
+    // channels in parallel. The channels are adapted one at a time if zero.
+    int num_worker_threads = 0;
   } filter;
 
   struct Erle {
@@ -23,6 +23,7 @@ TEST(EchoCanceller3JsonHelpers, ToStringAndParseJson) {
   cfg.filter.coarse_initial.length_blocks = 3u;
   cfg.filter.high_pass_filter_echo_reference =
       !cfg.filter.high_pass_filter_echo_reference;
+  cfg.filter.num_worker_threads = 2;
   cfg.comfort_noise.noise_floor_dbfs = 100.f;
   cfg.echo_model.model_reverb_in_nonlinear_mode = false;
   cfg.suppressor.normal_tuning.mask_hf.enr_suppress = .5f;
@@ -53,6 +54,8 @@ TEST(EchoCanceller3JsonHelpers, ToStringAndParseJson) {
             cfg_transformed.filter.refined.error_floor);
   EXPECT_EQ(cfg.filter.high_pass_filter_echo_reference,
             cfg_transformed.filter.high_pass_filter_echo_reference);
+  EXPECT_EQ(cfg.filter.num_worker_threads,
+            cfg_transformed.filter.num_worker_threads);
   EXPECT_EQ(cfg.comfort_noise.noise_floor_dbfs,
             cfg_transformed.comfort_noise.noise_floor_dbfs);
   EXPECT_EQ(cfg.echo_model.model_reverb_in_nonlinear_mode,
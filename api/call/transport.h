@@ -16,6 +16,7 @@
 
 #include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -36,6 +37,10 @@ struct PacketOptions {
   bool is_retransmit = false;
   bool included_in_feedback = false;
   bool included_in_allocation = false;
+  // Whether this packet can be sent as part of a batch, and whether it is
+  // the last packet of that batch. See rtc::PacketOptions.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
 };
 
 class Transport {
@@ -45,6 +50,15 @@ class Transport {
                        const PacketOptions& options) = 0;
   virtual bool SendRtcp(const uint8_t* packet, size_t length) = 0;
 
+  // Like SendRtp(), but shares the packet buffer with the transport instead
+  // of handing it a pointer to copy from. A transport that owns the last
+  // reference to the buffer may then encrypt and send it in place, provided
+  // the buffer has spare capacity for the SRTP authentication tag.
+  virtual bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                             const PacketOptions& options) {
+    return SendRtp(packet.cdata(), packet.size(), options);
+  }
+
  protected:
   virtual ~Transport() {}
 };
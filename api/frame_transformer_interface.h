@@ -93,6 +93,13 @@ class FrameTransformerInterface : public rtc::RefCountInterface {
   virtual void Transform(
       std::unique_ptr<TransformableFrameInterface> transformable_frame) = 0;
 
+  // Returns true if Transform() may be called on any thread and hands each
+  // frame back to the registered callback before it returns, e.g. for
+  // encryption done in place. The frames are then passed on right away,
+  // instead of being posted back to the sequence that Transform() was called
+  // on.
+  virtual bool IsSynchronous() const { return false; }
+
   virtual void RegisterTransformedFrameCallback(
       rtc::scoped_refptr<TransformedFrameCallback>) {}
   virtual void RegisterTransformedFrameSinkCallback(
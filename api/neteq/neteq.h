@@ -133,6 +133,11 @@ class NetEq {
     int min_delay_ms = 0;
     bool enable_fast_accelerate = false;
     bool enable_muted_state = false;
+    // If positive and `enable_muted_state` is set, the sync buffer, the
+    // decoders and the other large buffers are released once the output has
+    // been muted for this long, and are rebuilt when the next packet arrives.
+    // This saves memory for idle streams.
+    int hibernate_after_ms = 0;
     bool enable_rtx_handling = false;
     absl::optional<AudioCodecPairId> codec_pair_id;
     bool for_test_no_time_stretching = false;  // Use only for testing.
@@ -213,6 +218,16 @@ class NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) = 0;
 
+  // Like GetAudio(), but the packets that are due for playout are consumed
+  // without being decoded, and `audio_frame` is muted. This keeps the jitter
+  // buffer, the delay estimation and the statistics running, at a fraction of
+  // the cost, for streams that are not played out for the moment, e.g. all but
+  // the loudest participants of a conference. The decoder is reset before it
+  // decodes again, so the first output after a switch back to GetAudio()
+  // starts without codec history.
+  virtual int GetAudioWithoutDecoding(AudioFrame* audio_frame,
+                                      int* current_sample_rate_hz = nullptr) = 0;
+
   // Replaces the current set of decoders with the given one.
   virtual void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) = 0;
 
@@ -12,6 +12,8 @@
 
 #include <utility>
 
+#include "rtc_base/checks.h"
+
 namespace webrtc {
 
 PeerConnectionInterface::IceServer::IceServer() = default;
@@ -100,6 +102,15 @@ PeerConnectionFactoryInterface::CreatePeerConnectionOrError(
   return RTCError(RTCErrorType::INTERNAL_ERROR);
 }
 
+void PeerConnectionFactoryInterface::GetPeerConnectionStats(
+    std::vector<rtc::scoped_refptr<PeerConnectionInterface>> peer_connections,
+    std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks) {
+  RTC_DCHECK_EQ(peer_connections.size(), callbacks.size());
+  for (size_t i = 0; i < peer_connections.size(); ++i) {
+    peer_connections[i]->GetStats(callbacks[i].get());
+  }
+}
+
 RtpCapabilities PeerConnectionFactoryInterface::GetRtpSenderCapabilities(
     cricket::MediaType kind) const {
   return {};
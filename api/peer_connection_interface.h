@@ -99,6 +99,7 @@
 #include "api/neteq/neteq_factory.h"
 #include "api/network_state_predictor.h"
 #include "api/packet_socket_factory.h"
+#include "api/peer_connection_thread_pool.h"
 #include "api/rtc_error.h"
 #include "api/rtc_event_log/rtc_event_log_factory_interface.h"
 #include "api/rtc_event_log_output.h"
@@ -951,6 +952,15 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
   virtual void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) = 0;
+  // Like the spec-compliant GetStats(), but only delivers the stats objects
+  // that are new or have changed since the previous call to GetStatsDelta(),
+  // which is cheaper to process when polling stats frequently. Stats objects
+  // that are removed are not signaled. This is not part of the spec. The
+  // default implementation delivers the full report, which is a valid delta.
+  virtual void GetStatsDelta(
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+    GetStats(callback.get());
+  }
   // Clear cached stats in the RTCStatsCollector.
   // Exposed for testing while waiting for automatic cache clear to work.
   // https://bugs.webrtc.org/8693
@@ -1420,6 +1430,11 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // Provides `network_thread` and `worker_thread` if both are null, instead
+  // of the factory starting threads of its own. The factory gets the pair for
+  // `thread_pool_shard` if set, and the next pair in turn otherwise.
+  rtc::scoped_refptr<PeerConnectionThreadPool> thread_pool;
+  absl::optional<uint64_t> thread_pool_shard;
   rtc::SocketFactory* socket_factory = nullptr;
   std::unique_ptr<TaskQueueFactory> task_queue_factory;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
@@ -1485,6 +1500,12 @@ class RTC_EXPORT PeerConnectionFactoryInterface
 
     // Sets crypto related options, e.g. enabled cipher suites.
     CryptoOptions crypto_options = CryptoOptions::NoGcm();
+
+    // If `certificate_pool.size` is positive, DTLS certificates are generated
+    // ahead of time for the PeerConnections that are created without a
+    // certificate and generator of their own, so that their creation doesn't
+    // wait for key generation during bursts.
+    rtc::RTCCertificatePool::Config certificate_pool;
   };
 
   // Set the options to be used for subsequently created PeerConnections.
@@ -1568,6 +1589,17 @@ class RTC_EXPORT PeerConnectionFactoryInterface
   // Stops logging the AEC dump.
   virtual void StopAecDump() = 0;
 
+  // Gets spec-compliant stats for each of `peer_connections`, like
+  // PeerConnectionInterface::GetStats() does, with `callbacks[i]` receiving
+  // the report of `peer_connections[i]`. The stats of all the PeerConnections
+  // are gathered together, with one hop to each of the worker and network
+  // threads rather than one per PeerConnection. The PeerConnections must
+  // have been created by this factory. The default implementation calls
+  // GetStats() on each PeerConnection.
+  virtual void GetPeerConnectionStats(
+      std::vector<rtc::scoped_refptr<PeerConnectionInterface>> peer_connections,
+      std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks);
+
  protected:
   // Dtor and ctor protected as objects shouldn't be created or deleted via
   // this interface.
@@ -1587,8 +1619,14 @@ class RTC_EXPORT PeerConnectionFactoryInterface
 // video-specific interfaces, and omit the corresponding modules from its
 // build.
 //
+// If an application only uses data channels, it can leave both `media_engine`
+// and `call_factory` null. The resulting PeerConnections then have no media
+// engine and no `Call`, and unless a `worker_thread` is given, the network
+// thread is used as the worker thread, instead of starting one.
+//
 // If `network_thread` or `worker_thread` are null, the PeerConnectionFactory
-// will create the necessary thread internally. If `signaling_thread` is null,
+// will create the necessary thread internally, unless both are null and a
+// `thread_pool` is given to take them from. If `signaling_thread` is null,
 // the PeerConnectionFactory will use the thread on which this method is called
 // as the signaling thread, wrapping it in an rtc::Thread object if needed.
 RTC_EXPORT rtc::scoped_refptr<PeerConnectionFactoryInterface>
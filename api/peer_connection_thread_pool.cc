@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/peer_connection_thread_pool.h"
+
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#endif
+
+#include <string>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+namespace {
+
+void PinToCpu(rtc::Thread* thread, int cpu) {
+#if defined(WEBRTC_LINUX)
+  thread->PostTask(ToQueuedTask([cpu] {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    // Zero means the calling thread.
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+      RTC_LOG_ERR(LS_WARNING) << "Failed to pin thread to CPU " << cpu;
+  }));
+#else
+  RTC_LOG(LS_WARNING) << "Pinning threads to CPUs is not supported.";
+#endif
+}
+
+}  // namespace
+
+rtc::scoped_refptr<PeerConnectionThreadPool> PeerConnectionThreadPool::Create(
+    const Config& config) {
+  return rtc::scoped_refptr<PeerConnectionThreadPool>(
+      new PeerConnectionThreadPool(config));
+}
+
+PeerConnectionThreadPool::PeerConnectionThreadPool(const Config& config) {
+  RTC_DCHECK_GT(config.num_thread_pairs, 0);
+  thread_pairs_.resize(config.num_thread_pairs);
+  for (size_t i = 0; i < thread_pairs_.size(); ++i) {
+    OwnedThreadPair& pair = thread_pairs_[i];
+    pair.network_thread = rtc::Thread::CreateWithSocketServer();
+    pair.network_thread->SetName("pc_network_thread_" + std::to_string(i),
+                                 nullptr);
+    pair.network_thread->Start();
+    pair.worker_thread = rtc::Thread::Create();
+    pair.worker_thread->SetName("pc_worker_thread_" + std::to_string(i),
+                                nullptr);
+    pair.worker_thread->Start();
+    if (!config.cpus.empty()) {
+      int cpu = config.cpus[i % config.cpus.size()];
+      PinToCpu(pair.network_thread.get(), cpu);
+      PinToCpu(pair.worker_thread.get(), cpu);
+    }
+  }
+}
+
+PeerConnectionThreadPool::~PeerConnectionThreadPool() = default;
+
+PeerConnectionThreadPool::ThreadPair PeerConnectionThreadPool::GetThreadPair(
+    uint64_t shard) const {
+  const OwnedThreadPair& pair = thread_pairs_[shard % thread_pairs_.size()];
+  return {pair.network_thread.get(), pair.worker_thread.get()};
+}
+
+PeerConnectionThreadPool::ThreadPair
+PeerConnectionThreadPool::NextThreadPair() {
+  return GetThreadPair(next_thread_pair_.fetch_add(1));
+}
+
+}  // namespace webrtc
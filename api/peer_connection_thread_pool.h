@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_PEER_CONNECTION_THREAD_POOL_H_
+#define API_PEER_CONNECTION_THREAD_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+// A pool of network and worker thread pairs to be shared by several
+// PeerConnectionFactories, e.g. one per tenant of a server, instead of each
+// of them starting threads of its own. All PeerConnections of a factory run
+// on the thread pair the factory got, so spreading connections across the
+// pool is done by picking the factory, or its shard, per connection.
+//
+// The threads of a pair can be pinned to a CPU, so that a process scales
+// across cores with one pair per core. Pinning is only supported on Linux,
+// and ignored with a warning elsewhere.
+//
+// Thread-safe.
+class RTC_EXPORT PeerConnectionThreadPool : public rtc::RefCountedBase {
+ public:
+  struct Config {
+    size_t num_thread_pairs = 1;
+    // If not empty, the threads of the i:th pair are pinned to
+    // `cpus[i % cpus.size()]`.
+    std::vector<int> cpus;
+  };
+
+  struct ThreadPair {
+    rtc::Thread* network_thread;
+    rtc::Thread* worker_thread;
+  };
+
+  // Starts the threads.
+  static rtc::scoped_refptr<PeerConnectionThreadPool> Create(
+      const Config& config);
+
+  PeerConnectionThreadPool(const PeerConnectionThreadPool&) = delete;
+  PeerConnectionThreadPool& operator=(const PeerConnectionThreadPool&) =
+      delete;
+
+  size_t num_thread_pairs() const { return thread_pairs_.size(); }
+
+  // Returns the pair that `shard`, e.g. a hash of a tenant id, maps to.
+  ThreadPair GetThreadPair(uint64_t shard) const;
+  // Returns the pairs in turn.
+  ThreadPair NextThreadPair();
+
+ protected:
+  explicit PeerConnectionThreadPool(const Config& config);
+  // Stops the threads.
+  ~PeerConnectionThreadPool() override;
+
+ private:
+  struct OwnedThreadPair {
+    std::unique_ptr<rtc::Thread> network_thread;
+    // Declared after `network_thread`, so that it is stopped first.
+    std::unique_ptr<rtc::Thread> worker_thread;
+  };
+
+  std::vector<OwnedThreadPair> thread_pairs_;
+  std::atomic<uint64_t> next_thread_pair_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // API_PEER_CONNECTION_THREAD_POOL_H_
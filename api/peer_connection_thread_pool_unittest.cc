@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/peer_connection_thread_pool.h"
+
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#endif
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+PeerConnectionThreadPool::Config ConfigWithThreadPairs(size_t num) {
+  PeerConnectionThreadPool::Config config;
+  config.num_thread_pairs = num;
+  return config;
+}
+
+TEST(PeerConnectionThreadPoolTest, ShardsMapToThreadPairs) {
+  auto pool = PeerConnectionThreadPool::Create(ConfigWithThreadPairs(2));
+  ASSERT_EQ(pool->num_thread_pairs(), 2u);
+
+  PeerConnectionThreadPool::ThreadPair first = pool->GetThreadPair(0);
+  PeerConnectionThreadPool::ThreadPair second = pool->GetThreadPair(1);
+  EXPECT_NE(first.network_thread, second.network_thread);
+  EXPECT_NE(first.worker_thread, second.worker_thread);
+  EXPECT_NE(first.network_thread, first.worker_thread);
+  EXPECT_EQ(pool->GetThreadPair(2).worker_thread, first.worker_thread);
+  EXPECT_EQ(pool->GetThreadPair(3).worker_thread, second.worker_thread);
+
+  EXPECT_TRUE(first.network_thread->socketserver());
+  EXPECT_TRUE(first.worker_thread->Invoke<bool>(
+      RTC_FROM_HERE, [&] { return first.worker_thread->IsCurrent(); }));
+}
+
+TEST(PeerConnectionThreadPoolTest, HandsOutThreadPairsInTurn) {
+  auto pool = PeerConnectionThreadPool::Create(ConfigWithThreadPairs(2));
+
+  EXPECT_EQ(pool->NextThreadPair().worker_thread,
+            pool->GetThreadPair(0).worker_thread);
+  EXPECT_EQ(pool->NextThreadPair().worker_thread,
+            pool->GetThreadPair(1).worker_thread);
+  EXPECT_EQ(pool->NextThreadPair().worker_thread,
+            pool->GetThreadPair(0).worker_thread);
+}
+
+#if defined(WEBRTC_LINUX)
+TEST(PeerConnectionThreadPoolTest, PinsThreadsToCpus) {
+  PeerConnectionThreadPool::Config config = ConfigWithThreadPairs(1);
+  config.cpus = {0};
+  auto pool = PeerConnectionThreadPool::Create(config);
+
+  rtc::Thread* worker_thread = pool->GetThreadPair(0).worker_thread;
+  int num_cpus = worker_thread->Invoke<int>(RTC_FROM_HERE, [] {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+    return CPU_ISSET(0, &cpu_set) ? CPU_COUNT(&cpu_set) : 0;
+  });
+  EXPECT_EQ(num_cpus, 1);
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
@@ -12,6 +12,12 @@
 
 namespace webrtc {
 
+void RtpSenderInterface::SetParametersAsync(
+    const RtpParameters& parameters,
+    std::function<void(RTCError)> callback) {
+  callback(SetParameters(parameters));
+}
+
 void RtpSenderInterface::SetFrameEncryptor(
     rtc::scoped_refptr<FrameEncryptorInterface> frame_encryptor) {}
 
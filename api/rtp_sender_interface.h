@@ -14,6 +14,7 @@
 #ifndef API_RTP_SENDER_INTERFACE_H_
 #define API_RTP_SENDER_INTERFACE_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,12 @@ class RTC_EXPORT RtpSenderInterface : public rtc::RefCountInterface {
   // rtpparameters.h
   // The encodings are in increasing quality order for simulcast.
   virtual RTCError SetParameters(const RtpParameters& parameters) = 0;
+  // Like SetParameters(), but doesn't block the calling thread while the
+  // parameters are applied to the media channel. `callback` is invoked with
+  // the result on the signaling thread, possibly before this method returns.
+  // The default implementation calls SetParameters().
+  virtual void SetParametersAsync(const RtpParameters& parameters,
+                                  std::function<void(RTCError)> callback);
 
   // Returns null for a video sender.
   virtual rtc::scoped_refptr<DtmfSenderInterface> GetDtmfSender() const = 0;
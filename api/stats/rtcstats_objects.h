@@ -523,6 +523,11 @@ class RTC_EXPORT RTCInboundRTPStreamStats final
   RTCStatsMember<uint32_t> pli_count;
   RTCStatsMember<uint32_t> nack_count;
   RTCStatsMember<uint64_t> qp_sum;
+  // Non-standard video-only member. Percentiles of the time, in seconds,
+  // sampled "timing frames" spent in each stage of the pipeline from capture
+  // to render, keyed by "<stage>.p50", "<stage>.p95" and "<stage>.p99".
+  RTCNonStandardStatsMember<std::map<std::string, double>>
+      timing_frame_stage_delays;
 };
 
 // https://w3c.github.io/webrtc-stats/#outboundrtpstats-dict*
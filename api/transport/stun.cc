@@ -17,11 +17,14 @@
 #include <memory>
 #include <utility>
 
+#include "api/function_view.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/crc32.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/message_digest.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 using rtc::ByteBufferReader;
 using rtc::ByteBufferWriter;
@@ -80,8 +83,88 @@ bool LengthValid(int type, int length) {
   return true;
 }
 
+// Keeps HMAC-SHA1 keys for the passwords that were last given as strings. ICE
+// keeps signing and validating its checks with the same few passwords, and
+// hashing the pads of the key costs more than hashing a binding request.
+// Owners of a single credential can keep its StunMessageIntegrityKey instead.
+class StunKeyCache {
+ public:
+  // Runs `compute` with a key for `password`.
+  bool WithKey(
+      absl::string_view password,
+      rtc::FunctionView<bool(const StunMessageIntegrityKey&)> compute) {
+    webrtc::MutexLock lock(&mutex_);
+    for (const StunMessageIntegrityKey& key : keys_) {
+      if (key.password() == password) {
+        return compute(key);
+      }
+    }
+    // Replaces the oldest key.
+    StunMessageIntegrityKey& key = keys_[next_key_];
+    next_key_ = (next_key_ + 1) % kNumKeys;
+    key.SetPassword(password);
+    return compute(key);
+  }
+
+ private:
+  static constexpr size_t kNumKeys = 4;
+
+  webrtc::Mutex mutex_;
+  StunMessageIntegrityKey keys_[kNumKeys] RTC_GUARDED_BY(mutex_);
+  size_t next_key_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+bool WithCachedKey(
+    absl::string_view password,
+    rtc::FunctionView<bool(const StunMessageIntegrityKey&)> compute) {
+  static StunKeyCache* const cache = new StunKeyCache();
+  return cache->WithKey(password, compute);
+}
+
 }  // namespace
 
+StunMessageIntegrityKey::StunMessageIntegrityKey()
+    : StunMessageIntegrityKey("") {}
+
+StunMessageIntegrityKey::StunMessageIntegrityKey(absl::string_view password) {
+  SetPassword(password);
+}
+
+StunMessageIntegrityKey::StunMessageIntegrityKey(StunMessageIntegrityKey&&) =
+    default;
+
+StunMessageIntegrityKey& StunMessageIntegrityKey::operator=(
+    StunMessageIntegrityKey&&) = default;
+
+StunMessageIntegrityKey::~StunMessageIntegrityKey() = default;
+
+void StunMessageIntegrityKey::SetPassword(absl::string_view password) {
+  if (digest_ && password == password_) {
+    return;
+  }
+  password_ = std::string(password);
+  digest_.reset(rtc::MessageDigestFactory::CreateHmac(
+      rtc::DIGEST_SHA_1, password_.data(), password_.size()));
+}
+
+bool StunMessageIntegrityKey::ComputeHmac(
+    const char* data,
+    size_t size,
+    uint16_t message_length,
+    char hmac[kStunMessageIntegritySize]) const {
+  RTC_DCHECK_GE(size, kStunHeaderSize);
+  if (!digest_) {
+    return false;
+  }
+  char length[sizeof(message_length)];
+  rtc::SetBE16(length, message_length);
+  digest_->Update(data, 2);
+  digest_->Update(length, sizeof(length));
+  digest_->Update(data + 4, size - 4);
+  return digest_->Finish(hmac, kStunMessageIntegritySize) ==
+         kStunMessageIntegritySize;
+}
+
 const char STUN_ERROR_REASON_TRY_ALTERNATE_SERVER[] = "Try Alternate Server";
 const char STUN_ERROR_REASON_BAD_REQUEST[] = "Bad Request";
 const char STUN_ERROR_REASON_UNAUTHORIZED[] = "Unauthorized";
@@ -240,11 +323,20 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 
 StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
     const std::string& password) {
-  password_ = password;
+  WithCachedKey(password, [this](const StunMessageIntegrityKey& key) {
+    ValidateMessageIntegrity(key);
+    return true;
+  });
+  return integrity_;
+}
+
+StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
+    const StunMessageIntegrityKey& key) {
+  password_ = key.password();
   if (GetByteString(STUN_ATTR_MESSAGE_INTEGRITY)) {
     if (ValidateMessageIntegrityOfType(
             STUN_ATTR_MESSAGE_INTEGRITY, kStunMessageIntegritySize,
-            buffer_.c_str(), buffer_.size(), password)) {
+            buffer_.c_str(), buffer_.size(), key)) {
       integrity_ = IntegrityStatus::kIntegrityOk;
     } else {
       integrity_ = IntegrityStatus::kIntegrityBad;
@@ -252,7 +344,7 @@ StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
   } else if (GetByteString(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32)) {
     if (ValidateMessageIntegrityOfType(
             STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32, kStunMessageIntegrity32Size,
-            buffer_.c_str(), buffer_.size(), password)) {
+            buffer_.c_str(), buffer_.size(), key)) {
       integrity_ = IntegrityStatus::kIntegrityOk;
     } else {
       integrity_ = IntegrityStatus::kIntegrityBad;
@@ -266,26 +358,31 @@ StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
 bool StunMessage::ValidateMessageIntegrity(const char* data,
                                            size_t size,
                                            const std::string& password) {
-  return ValidateMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
-                                        kStunMessageIntegritySize, data, size,
-                                        password);
+  return WithCachedKey(password, [&](const StunMessageIntegrityKey& key) {
+    return ValidateMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
+                                          kStunMessageIntegritySize, data,
+                                          size, key);
+  });
 }
 
 bool StunMessage::ValidateMessageIntegrity32(const char* data,
                                              size_t size,
                                              const std::string& password) {
-  return ValidateMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
-                                        kStunMessageIntegrity32Size, data, size,
-                                        password);
+  return WithCachedKey(password, [&](const StunMessageIntegrityKey& key) {
+    return ValidateMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
+                                          kStunMessageIntegrity32Size, data,
+                                          size, key);
+  });
 }
 
 // Verifies a STUN message has a valid MESSAGE-INTEGRITY attribute, using the
 // procedure outlined in RFC 5389, section 15.4.
-bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
-                                                 size_t mi_attr_size,
-                                                 const char* data,
-                                                 size_t size,
-                                                 const std::string& password) {
+bool StunMessage::ValidateMessageIntegrityOfType(
+    int mi_attr_type,
+    size_t mi_attr_size,
+    const char* data,
+    size_t size,
+    const StunMessageIntegrityKey& key) {
   RTC_DCHECK(mi_attr_size <= kStunMessageIntegritySize);
 
   // Verifying the size of the message.
@@ -332,30 +429,20 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
 
   // Getting length of the message to calculate Message Integrity.
   size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + mi_attr_size) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset =
-        size - (mi_pos + kStunAttributeHeaderSize + mi_attr_size);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
+  // Stun message may have other attributes after message integrity. The
+  // length parameter in the stun message is adjusted to exclude them, when
+  // calculating the HMAC.
+  //      0                   1                   2                   3
+  //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  //     |0 0|     STUN Message Type     |         Message Length        |
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  size_t adjusted_len =
+      mi_pos + kStunAttributeHeaderSize + mi_attr_size - kStunHeaderSize;
 
   char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  if (!key.ComputeHmac(data, mi_pos, static_cast<uint16_t>(adjusted_len),
+                       hmac)) {
     return false;
   }
 
@@ -365,21 +452,31 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
+  return WithCachedKey(password, [this](const StunMessageIntegrityKey& key) {
+    return AddMessageIntegrity(key);
+  });
+}
+
+bool StunMessage::AddMessageIntegrity(const StunMessageIntegrityKey& key) {
   return AddMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
-                                   kStunMessageIntegritySize, password.c_str(),
-                                   password.size());
+                                   kStunMessageIntegritySize, key);
 }
 
 bool StunMessage::AddMessageIntegrity32(absl::string_view password) {
+  return WithCachedKey(password, [this](const StunMessageIntegrityKey& key) {
+    return AddMessageIntegrity32(key);
+  });
+}
+
+bool StunMessage::AddMessageIntegrity32(const StunMessageIntegrityKey& key) {
   return AddMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
-                                   kStunMessageIntegrity32Size, password.data(),
-                                   password.length());
+                                   kStunMessageIntegrity32Size, key);
 }
 
-bool StunMessage::AddMessageIntegrityOfType(int attr_type,
-                                            size_t attr_size,
-                                            const char* key,
-                                            size_t keylen) {
+bool StunMessage::AddMessageIntegrityOfType(
+    int attr_type,
+    size_t attr_size,
+    const StunMessageIntegrityKey& key) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   RTC_DCHECK(attr_size <= kStunMessageIntegritySize);
@@ -393,13 +490,10 @@ bool StunMessage::AddMessageIntegrityOfType(int attr_type,
   if (!Write(&buf))
     return false;
 
-  int msg_len_for_hmac = static_cast<int>(
-      buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
+  size_t msg_len_for_hmac =
+      buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length();
   char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1, key, keylen, buf.Data(),
-                                msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  if (!key.ComputeHmac(buf.Data(), msg_len_for_hmac, length_, hmac)) {
     RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
                          "has dummy value.";
     return false;
@@ -407,7 +501,7 @@ bool StunMessage::AddMessageIntegrityOfType(int attr_type,
 
   // Insert correct HMAC into the attribute.
   msg_integrity_attr->CopyBytes(hmac, attr_size);
-  password_.assign(key, keylen);
+  password_ = key.password();
   integrity_ = IntegrityStatus::kIntegrityOk;
   return true;
 }
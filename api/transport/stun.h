@@ -26,6 +26,7 @@
 #include "api/array_view.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 
 namespace cricket {
@@ -138,6 +139,35 @@ class StunUInt32Attribute;
 class StunUInt64Attribute;
 class StunXorAddressAttribute;
 
+// A password that signs or validates the MESSAGE-INTEGRITY of many messages,
+// along with an HMAC-SHA1 digest keyed with it. The inner and outer pads of
+// the key are hashed when the password changes, instead of for every message.
+// Not thread safe.
+class StunMessageIntegrityKey {
+ public:
+  StunMessageIntegrityKey();
+  explicit StunMessageIntegrityKey(absl::string_view password);
+  StunMessageIntegrityKey(StunMessageIntegrityKey&&);
+  StunMessageIntegrityKey& operator=(StunMessageIntegrityKey&&);
+  ~StunMessageIntegrityKey();
+
+  const std::string& password() const { return password_; }
+  // Does nothing if `password` is the current password.
+  void SetPassword(absl::string_view password);
+
+  // Computes the HMAC-SHA1 of the `size` bytes of the STUN message `data`, as
+  // if its header had `message_length` as length.
+  bool ComputeHmac(const char* data,
+                   size_t size,
+                   uint16_t message_length,
+                   char hmac[kStunMessageIntegritySize]) const;
+
+ private:
+  std::string password_;
+  // Finish() resets the digest, so it keeps no state between computations.
+  mutable std::unique_ptr<rtc::MessageDigest> digest_;
+};
+
 // Records a complete STUN/TURN message.  Each message consists of a type and
 // any number of attributes.  Each attribute is parsed into an instance of an
 // appropriate class (see above).  The Get* methods will return instances of
@@ -201,6 +231,7 @@ class StunMessage {
   // Validates that a STUN message has a correct MESSAGE-INTEGRITY value.
   // This uses the buffered raw-format message stored by Read().
   IntegrityStatus ValidateMessageIntegrity(const std::string& password);
+  IntegrityStatus ValidateMessageIntegrity(const StunMessageIntegrityKey& key);
 
   // Returns the current integrity status of the message.
   IntegrityStatus integrity() const { return integrity_; }
@@ -219,10 +250,12 @@ class StunMessage {
 
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
+  bool AddMessageIntegrity(const StunMessageIntegrityKey& key);
 
   // Adds a STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32 attribute that is valid for the
   // current message.
   bool AddMessageIntegrity32(absl::string_view password);
+  bool AddMessageIntegrity32(const StunMessageIntegrityKey& key);
 
   // Verify that a buffer has stun magic cookie and one of the specified
   // methods. Note that it does not check for the existance of FINGERPRINT.
@@ -295,13 +328,13 @@ class StunMessage {
   static bool IsValidTransactionId(const std::string& transaction_id);
   bool AddMessageIntegrityOfType(int mi_attr_type,
                                  size_t mi_attr_size,
-                                 const char* key,
-                                 size_t keylen);
-  static bool ValidateMessageIntegrityOfType(int mi_attr_type,
-                                             size_t mi_attr_size,
-                                             const char* data,
-                                             size_t size,
-                                             const std::string& password);
+                                 const StunMessageIntegrityKey& key);
+  static bool ValidateMessageIntegrityOfType(
+      int mi_attr_type,
+      size_t mi_attr_size,
+      const char* data,
+      size_t size,
+      const StunMessageIntegrityKey& key);
 
   uint16_t type_;
   uint16_t length_;
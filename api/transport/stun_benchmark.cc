@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures building and parsing the STUN binding requests that ICE sends as
+// connectivity checks and keepalives.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/stun.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kUsername[] = "rfrag:lfrag";
+constexpr char kPassword[] = "remotepasswordremotepass";
+
+// Builds a binding request the way ConnectionRequest::Prepare() does.
+void PrepareBindingRequest(cricket::IceMessage* request,
+                           const std::string& password = kPassword) {
+  request->SetType(cricket::STUN_BINDING_REQUEST);
+  request->SetTransactionID("0123456789ab");
+  request->AddAttribute(std::make_unique<cricket::StunByteStringAttribute>(
+      cricket::STUN_ATTR_USERNAME, kUsername));
+  request->AddAttribute(std::make_unique<cricket::StunUInt32Attribute>(
+      cricket::STUN_ATTR_GOOG_NETWORK_INFO, 0x00010032));
+  request->AddAttribute(std::make_unique<cricket::StunUInt64Attribute>(
+      cricket::STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdef));
+  request->AddAttribute(std::make_unique<cricket::StunByteStringAttribute>(
+      cricket::STUN_ATTR_USE_CANDIDATE));
+  request->AddAttribute(std::make_unique<cricket::StunUInt32Attribute>(
+      cricket::STUN_ATTR_PRIORITY, 0x6e7f1eff));
+  request->AddMessageIntegrity(password);
+  request->AddFingerprint();
+}
+
+std::string CreateBindingRequest(const std::string& password = kPassword) {
+  cricket::IceMessage request;
+  PrepareBindingRequest(&request, password);
+  rtc::ByteBufferWriter buf;
+  RTC_CHECK(request.Write(&buf));
+  return std::string(buf.Data(), buf.Length());
+}
+
+void BM_WriteBindingRequest(benchmark::State& state) {
+  for (auto s : state) {
+    cricket::IceMessage request;
+    PrepareBindingRequest(&request);
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    benchmark::DoNotOptimize(buf.Data());
+  }
+}
+BENCHMARK(BM_WriteBindingRequest);
+
+// Validates and reads a binding request the way Port::GetStunMessage() does.
+void BM_ReadBindingRequest(benchmark::State& state) {
+  const std::string packet = CreateBindingRequest();
+  for (auto s : state) {
+    RTC_CHECK(
+        cricket::StunMessage::ValidateFingerprint(packet.data(), packet.size()));
+    cricket::IceMessage request;
+    rtc::ByteBufferReader buf(packet.data(), packet.size());
+    RTC_CHECK(request.Read(&buf));
+    RTC_CHECK(request.ValidateMessageIntegrity(kPassword) ==
+              cricket::StunMessage::IntegrityStatus::kIntegrityOk);
+    benchmark::DoNotOptimize(
+        request.GetByteString(cricket::STUN_ATTR_USERNAME));
+  }
+}
+BENCHMARK(BM_ReadBindingRequest);
+
+// Validates requests of `state.range(0)` connections with different
+// passwords, given as strings if `state.range(1)` is 0 and as
+// StunMessageIntegrityKeys otherwise.
+void BM_ValidateBindingRequests(benchmark::State& state) {
+  const int num_connections = state.range(0);
+  const bool keys = state.range(1) != 0;
+  std::vector<std::string> passwords;
+  std::vector<cricket::StunMessageIntegrityKey> integrity_keys;
+  std::vector<std::unique_ptr<cricket::IceMessage>> requests;
+  for (int i = 0; i < num_connections; ++i) {
+    passwords.push_back(kPassword + std::to_string(i));
+    integrity_keys.emplace_back(passwords.back());
+    const std::string packet = CreateBindingRequest(passwords.back());
+    requests.push_back(std::make_unique<cricket::IceMessage>());
+    rtc::ByteBufferReader buf(packet.data(), packet.size());
+    RTC_CHECK(requests.back()->Read(&buf));
+  }
+  int i = 0;
+  for (auto s : state) {
+    cricket::StunMessage::IntegrityStatus status =
+        keys ? requests[i]->ValidateMessageIntegrity(integrity_keys[i])
+             : requests[i]->ValidateMessageIntegrity(passwords[i]);
+    RTC_CHECK(status == cricket::StunMessage::IntegrityStatus::kIntegrityOk);
+    i = (i + 1) % num_connections;
+  }
+}
+BENCHMARK(BM_ValidateBindingRequests)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({100, 0})
+    ->Args({100, 1});
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+
+Results:
+
+Run on a single 2 GHz core against OpenSSL 3, fastest of 8 repetitions, before
+and after keeping the HMAC-SHA1 digests keyed with the last used passwords.
+-----------------------------------------------
+Benchmark                    Before       After
+-----------------------------------------------
+BM_WriteBindingRequest      2362 ns     1233 ns
+BM_ReadBindingRequest       2152 ns     1085 ns
+
+Setting up the keyed digest took more time than hashing the request.
+
+Validating the requests of many connections, fastest of 5 repetitions. With
+more passwords than the cache holds, passwords given as strings are keyed for
+every request, while StunMessageIntegrityKeys keep their keyed digests.
+------------------------------------------------
+Benchmark                                   Time
+------------------------------------------------
+BM_ValidateBindingRequests/1/0            354 ns
+BM_ValidateBindingRequests/1/1            353 ns
+BM_ValidateBindingRequests/100/0         1744 ns
+BM_ValidateBindingRequests/100/1          504 ns
+
+*/
@@ -1271,6 +1271,39 @@ TEST_F(StunTest, AddMessageIntegrity) {
       kRfc5769SampleMsgPassword));
 }
 
+TEST_F(StunTest, AddAndValidateMessageIntegrityWithKey) {
+  StunMessageIntegrityKey key(kRfc5769SampleMsgPassword);
+  IceMessage msg;
+  rtc::ByteBufferReader buf(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+      sizeof(kRfc5769SampleRequestWithoutMI));
+  EXPECT_TRUE(msg.Read(&buf));
+  EXPECT_TRUE(msg.AddMessageIntegrity(key));
+  EXPECT_EQ(kRfc5769SampleMsgPassword, msg.password());
+  const StunByteStringAttribute* mi_attr =
+      msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+  EXPECT_EQ(
+      0, memcmp(mi_attr->bytes(), kCalculatedHmac1, sizeof(kCalculatedHmac1)));
+
+  // The key can be used again.
+  IceMessage msg2;
+  rtc::ByteBufferReader buf2(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest));
+  EXPECT_TRUE(msg2.Read(&buf2));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            msg2.ValidateMessageIntegrity(key));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            msg2.ValidateMessageIntegrity(key));
+
+  key.SetPassword("InvalidPassword");
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+            msg2.ValidateMessageIntegrity(key));
+  key.SetPassword(kRfc5769SampleMsgPassword);
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            msg2.ValidateMessageIntegrity(key));
+}
+
 // Check our STUN message validation code against the RFC5769 test messages.
 TEST_F(StunTest, ValidateMessageIntegrity32) {
   // Try the messages from RFC 5769.
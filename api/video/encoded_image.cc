@@ -10,15 +10,22 @@
 
 #include "api/video/encoded_image.h"
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "rtc_base/ref_counted_object.h"
 
 namespace webrtc {
 
-EncodedImageBuffer::EncodedImageBuffer(size_t size) : size_(size) {
-  buffer_ = static_cast<uint8_t*>(malloc(size));
+EncodedImageBuffer::EncodedImageBuffer(size_t size)
+    : size_(size), allocator_(GetMediaBufferAllocator()) {
+  buffer_ = static_cast<uint8_t*>(
+      allocator_ ? allocator_->Allocate(size, alignof(std::max_align_t))
+                 : malloc(size));
+  live_object_.SetBytes(size);
 }
 
 EncodedImageBuffer::EncodedImageBuffer(const uint8_t* data, size_t size)
@@ -27,7 +34,11 @@ EncodedImageBuffer::EncodedImageBuffer(const uint8_t* data, size_t size)
 }
 
 EncodedImageBuffer::~EncodedImageBuffer() {
-  free(buffer_);
+  if (!allocator_) {
+    free(buffer_);
+  } else if (buffer_) {
+    allocator_->Free(buffer_, size_);
+  }
 }
 
 // static
@@ -57,8 +68,26 @@ void EncodedImageBuffer::Realloc(size_t size) {
   // More specifically, it breaks expectations of
   // VCMSessionInfo::UpdateDataPointers.
   RTC_DCHECK(size > 0);
-  buffer_ = static_cast<uint8_t*>(realloc(buffer_, size));
+  if (allocator_) {
+    uint8_t* buffer = static_cast<uint8_t*>(
+        allocator_->Allocate(size, alignof(std::max_align_t)));
+    if (buffer_) {
+      memcpy(buffer, buffer_, std::min(size, size_));
+      allocator_->Free(buffer_, size_);
+    }
+    buffer_ = buffer;
+  } else {
+    buffer_ = static_cast<uint8_t*>(realloc(buffer_, size));
+  }
   size_ = size;
+  live_object_.SetBytes(size);
+}
+
+// static
+rtc::LiveObjectCounter& EncodedImageBuffer::LiveObjects() {
+  static rtc::LiveObjectCounter* const counter =
+      new rtc::LiveObjectCounter("EncodedImageBuffer");
+  return *counter;
 }
 
 EncodedImage::EncodedImage() = default;
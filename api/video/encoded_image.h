@@ -26,7 +26,10 @@
 #include "api/video/video_rotation.h"
 #include "api/video/video_timing.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/media_buffer_allocator.h"
+#include "rtc_base/memory_usage.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -63,6 +66,13 @@ class RTC_EXPORT EncodedImageBuffer : public EncodedImageBufferInterface {
 
   size_t size_;
   uint8_t* buffer_;
+
+ private:
+  static rtc::LiveObjectCounter& LiveObjects();
+
+  // The allocator `buffer_` comes from, or null for malloc().
+  MediaBufferAllocator* const allocator_;
+  RTC_NO_UNIQUE_ADDRESS rtc::LiveObject live_object_{LiveObjects()};
 };
 
 // TODO(bug.webrtc.org/9378): This is a legacy api class, which is slowly being
@@ -164,6 +174,13 @@ class RTC_EXPORT EncodedImage {
     at_target_quality_ = at_target_quality;
   }
 
+  // The speed setting that the encoder used for the image, on the scale of
+  // the encoder. Only set by encoders that adjust their speed at runtime.
+  absl::optional<int> EncoderSpeed() const { return encoder_speed_; }
+  void SetEncoderSpeed(absl::optional<int> encoder_speed) {
+    encoder_speed_ = encoder_speed;
+  }
+
   uint32_t _encodedWidth = 0;
   uint32_t _encodedHeight = 0;
   // NTP time of the capture time in local timebase in milliseconds.
@@ -212,6 +229,7 @@ class RTC_EXPORT EncodedImage {
   bool retransmission_allowed_ = true;
   // True if the encoded image can be considered to be of target quality.
   bool at_target_quality_ = false;
+  absl::optional<int> encoder_speed_;
 };
 
 }  // namespace webrtc
@@ -46,18 +46,26 @@ I420Buffer::I420Buffer(int width,
       stride_y_(stride_y),
       stride_u_(stride_u),
       stride_v_(stride_v),
-      data_(static_cast<uint8_t*>(
-          AlignedMalloc(I420DataSize(height, stride_y, stride_u, stride_v),
-                        kBufferAlignment))) {
+      data_(AllocateMediaBuffer(
+          I420DataSize(height, stride_y, stride_u, stride_v),
+          kBufferAlignment)) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   RTC_DCHECK_GE(stride_y, width);
   RTC_DCHECK_GE(stride_u, (width + 1) / 2);
   RTC_DCHECK_GE(stride_v, (width + 1) / 2);
+  live_object_.SetBytes(I420DataSize(height, stride_y, stride_u, stride_v));
 }
 
 I420Buffer::~I420Buffer() {}
 
+// static
+rtc::LiveObjectCounter& I420Buffer::LiveObjects() {
+  static rtc::LiveObjectCounter* const counter =
+      new rtc::LiveObjectCounter("I420Buffer");
+  return *counter;
+}
+
 // static
 rtc::scoped_refptr<I420Buffer> I420Buffer::Create(int width, int height) {
   return rtc::make_ref_counted<I420Buffer>(width, height);
@@ -18,7 +18,9 @@
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
-#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/memory/media_buffer_allocator.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -105,12 +107,15 @@ class RTC_EXPORT I420Buffer : public I420BufferInterface {
   ~I420Buffer() override;
 
  private:
+  static rtc::LiveObjectCounter& LiveObjects();
+
   const int width_;
   const int height_;
   const int stride_y_;
   const int stride_u_;
   const int stride_v_;
-  const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  const std::unique_ptr<uint8_t, MediaBufferDeleter> data_;
+  RTC_NO_UNIQUE_ADDRESS rtc::LiveObject live_object_{LiveObjects()};
 };
 
 }  // namespace webrtc
@@ -47,9 +47,9 @@ I444Buffer::I444Buffer(int width,
       stride_y_(stride_y),
       stride_u_(stride_u),
       stride_v_(stride_v),
-      data_(static_cast<uint8_t*>(
-          AlignedMalloc(I444DataSize(height, stride_y, stride_u, stride_v),
-                        kBufferAlignment))) {
+      data_(AllocateMediaBuffer(
+          I444DataSize(height, stride_y, stride_u, stride_v),
+          kBufferAlignment)) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   RTC_DCHECK_GE(stride_y, width);
@@ -18,7 +18,7 @@
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
-#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/memory/media_buffer_allocator.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -96,7 +96,7 @@ class RTC_EXPORT I444Buffer : public I444BufferInterface {
   const int stride_y_;
   const int stride_u_;
   const int stride_v_;
-  const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  const std::unique_ptr<uint8_t, MediaBufferDeleter> data_;
 };
 
 }  // namespace webrtc
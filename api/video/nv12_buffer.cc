@@ -14,6 +14,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
 
 namespace webrtc {
@@ -36,9 +37,9 @@ NV12Buffer::NV12Buffer(int width, int height, int stride_y, int stride_uv)
       height_(height),
       stride_y_(stride_y),
       stride_uv_(stride_uv),
-      data_(static_cast<uint8_t*>(
-          AlignedMalloc(NV12DataSize(height_, stride_y_, stride_uv),
-                        kBufferAlignment))) {
+      data_(AllocateMediaBuffer(
+          NV12DataSize(height_, stride_y_, stride_uv),
+          kBufferAlignment)) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   RTC_DCHECK_GE(stride_y, width);
@@ -118,6 +119,15 @@ size_t NV12Buffer::UVOffset() const {
   return stride_y_ * height_;
 }
 
+// static
+void NV12Buffer::SetBlack(NV12Buffer* buffer) {
+  libyuv::SetPlane(buffer->MutableDataY(), buffer->StrideY(), buffer->width(),
+                   buffer->height(), 0);
+  // U and V are both 128, so the interleaved plane is filled in one pass.
+  libyuv::SetPlane(buffer->MutableDataUV(), buffer->StrideUV(),
+                   2 * buffer->ChromaWidth(), buffer->ChromaHeight(), 128);
+}
+
 void NV12Buffer::InitializeData() {
   memset(data_.get(), 0, NV12DataSize(height_, stride_y_, stride_uv_));
 }
@@ -16,7 +16,7 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
-#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/memory/media_buffer_allocator.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -48,6 +48,9 @@ class RTC_EXPORT NV12Buffer : public NV12BufferInterface {
   uint8_t* MutableDataY();
   uint8_t* MutableDataUV();
 
+  // Sets the buffer to all black.
+  static void SetBlack(NV12Buffer* buffer);
+
   // Sets all three planes to all zeros. Used to work around for
   // quirks in memory checkers
   // (https://bugs.chromium.org/p/libyuv/issues/detail?id=377) and
@@ -77,7 +80,7 @@ class RTC_EXPORT NV12Buffer : public NV12BufferInterface {
   const int height_;
   const int stride_y_;
   const int stride_uv_;
-  const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  const std::unique_ptr<uint8_t, MediaBufferDeleter> data_;
 };
 
 }  // namespace webrtc
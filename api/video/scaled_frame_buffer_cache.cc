@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/scaled_frame_buffer_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ScaledFrameBufferCache::ScaledFrameBufferCache() = default;
+ScaledFrameBufferCache::~ScaledFrameBufferCache() = default;
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaledFrameBufferCache::CropAndScale(
+    const rtc::scoped_refptr<VideoFrameBuffer>& source,
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  RTC_DCHECK(source);
+  auto matches = [&](const Entry& entry) {
+    return entry.source == source && entry.offset_x == offset_x &&
+           entry.offset_y == offset_y && entry.crop_width == crop_width &&
+           entry.crop_height == crop_height &&
+           entry.scaled_width == scaled_width &&
+           entry.scaled_height == scaled_height;
+  };
+  {
+    MutexLock lock(&lock_);
+    auto it = std::find_if(entries_.begin(), entries_.end(), matches);
+    if (it != entries_.end())
+      return it->result;
+  }
+
+  // Scale without holding the lock, so that consumers of other resolutions
+  // aren't blocked. If two consumers race, the first result is kept.
+  rtc::scoped_refptr<VideoFrameBuffer> result =
+      source->CropAndScale(offset_x, offset_y, crop_width, crop_height,
+                           scaled_width, scaled_height);
+  if (!result)
+    return nullptr;
+
+  MutexLock lock(&lock_);
+  auto it = std::find_if(entries_.begin(), entries_.end(), matches);
+  if (it != entries_.end())
+    return it->result;
+
+  Entry entry{source,
+              offset_x,
+              offset_y,
+              crop_width,
+              crop_height,
+              scaled_width,
+              scaled_height,
+              result};
+  // Keep the entries of a source buffer together.
+  auto last_of_source =
+      std::find_if(entries_.rbegin(), entries_.rend(),
+                   [&](const Entry& other) { return other.source == source; });
+  if (last_of_source != entries_.rend()) {
+    entries_.insert(last_of_source.base(), std::move(entry));
+    return result;
+  }
+
+  size_t num_sources = 0;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (i == 0 || entries_[i].source != entries_[i - 1].source)
+      ++num_sources;
+  }
+  if (num_sources >= kMaxSourceBuffers) {
+    // Drop the scaled buffers of the oldest source buffer.
+    rtc::scoped_refptr<VideoFrameBuffer> oldest = entries_.front().source;
+    while (!entries_.empty() && entries_.front().source == oldest)
+      entries_.pop_front();
+  }
+  entries_.push_back(std::move(entry));
+  return result;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaledFrameBufferCache::Scale(
+    const rtc::scoped_refptr<VideoFrameBuffer>& source,
+    int scaled_width,
+    int scaled_height) {
+  RTC_DCHECK(source);
+  return CropAndScale(source, 0, 0, source->width(), source->height(),
+                      scaled_width, scaled_height);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_SCALED_FRAME_BUFFER_CACHE_H_
+#define API_VIDEO_SCALED_FRAME_BUFFER_CACHE_H_
+
+#include <deque>
+
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares cropped and scaled versions of frame buffers between the consumers
+// of the same frames, e.g. the send streams that encode one source at the
+// same resolution. Frame buffers are immutable, so that the first consumer
+// that asks for a resolution scales the buffer and the others reuse the
+// result. Scaled buffers are kept for the `kMaxSourceBuffers` most recent
+// source buffers, and keep these alive. Thread safe.
+//
+// Create with rtc::make_ref_counted<ScaledFrameBufferCache>().
+class RTC_EXPORT ScaledFrameBufferCache final
+    : public rtc::RefCountedNonVirtual<ScaledFrameBufferCache> {
+ public:
+  static constexpr size_t kMaxSourceBuffers = 4;
+
+  ScaledFrameBufferCache();
+
+  // Returns the result of `source`->CropAndScale() with the same arguments,
+  // or null on failure.
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      const rtc::scoped_refptr<VideoFrameBuffer>& source,
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height);
+
+  // Same as above, for `source`->Scale().
+  rtc::scoped_refptr<VideoFrameBuffer> Scale(
+      const rtc::scoped_refptr<VideoFrameBuffer>& source,
+      int scaled_width,
+      int scaled_height);
+
+ private:
+  friend class rtc::RefCountedNonVirtual<ScaledFrameBufferCache>;
+  ~ScaledFrameBufferCache();
+
+  struct Entry {
+    rtc::scoped_refptr<VideoFrameBuffer> source;
+    int offset_x;
+    int offset_y;
+    int crop_width;
+    int crop_height;
+    int scaled_width;
+    int scaled_height;
+    rtc::scoped_refptr<VideoFrameBuffer> result;
+  };
+
+  Mutex lock_;
+  // Ordered by the first use of their source buffer.
+  std::deque<Entry> entries_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_SCALED_FRAME_BUFFER_CACHE_H_
@@ -82,6 +82,19 @@ TEST(NV12BufferTest, ReadPixels) {
   }
 }
 
+TEST(NV12BufferTest, SetBlack) {
+  rtc::scoped_refptr<NV12Buffer> buf(NV12Buffer::Create(5, 3));
+  FillNV12Buffer(buf);
+  NV12Buffer::SetBlack(buf.get());
+  for (int row = 0; row < buf->height(); ++row) {
+    for (int col = 0; col < buf->width(); ++col) {
+      EXPECT_EQ(0, GetY(buf, col, row));
+      EXPECT_EQ(128, GetU(buf, col, row));
+      EXPECT_EQ(128, GetV(buf, col, row));
+    }
+  }
+}
+
 TEST(NV12BufferTest, ToI420) {
   constexpr int width = 3;
   constexpr int height = 3;
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/scaled_frame_buffer_cache.h"
+
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<I420Buffer> CreateBuffer() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(buffer.get());
+  return buffer;
+}
+
+TEST(ScaledFrameBufferCacheTest, ReusesScaledBufferOfSameSource) {
+  auto cache = rtc::make_ref_counted<ScaledFrameBufferCache>();
+  rtc::scoped_refptr<VideoFrameBuffer> source = CreateBuffer();
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = cache->Scale(source, 320, 180);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(scaled->width(), 320);
+  EXPECT_EQ(scaled->height(), 180);
+  EXPECT_EQ(cache->Scale(source, 320, 180), scaled);
+  EXPECT_EQ(cache->CropAndScale(source, 0, 0, 640, 360, 320, 180), scaled);
+
+  // Other resolutions and crops are scaled separately.
+  EXPECT_NE(cache->Scale(source, 160, 90), scaled);
+  EXPECT_NE(cache->CropAndScale(source, 2, 0, 636, 360, 320, 180), scaled);
+  // As are other source buffers.
+  EXPECT_NE(cache->Scale(CreateBuffer(), 320, 180), scaled);
+}
+
+TEST(ScaledFrameBufferCacheTest, KeepsScaledBuffersOfRecentSources) {
+  auto cache = rtc::make_ref_counted<ScaledFrameBufferCache>();
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> sources;
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> scaled;
+  for (size_t i = 0; i <= ScaledFrameBufferCache::kMaxSourceBuffers; ++i) {
+    sources.push_back(CreateBuffer());
+    scaled.push_back(cache->Scale(sources.back(), 320, 180));
+  }
+  // The first source was dropped when the last one was added.
+  EXPECT_NE(cache->Scale(sources[0], 320, 180), scaled[0]);
+  EXPECT_EQ(cache->Scale(sources.back(), 320, 180), scaled.back());
+}
+
+}  // namespace
+}  // namespace webrtc
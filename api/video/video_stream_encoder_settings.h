@@ -13,6 +13,8 @@
 
 #include <string>
 
+#include "api/scoped_refptr.h"
+#include "api/video/scaled_frame_buffer_cache.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
@@ -50,6 +52,10 @@ struct VideoStreamEncoderSettings {
   // Ownership stays with WebrtcVideoEngine (delegated from PeerConnection).
   VideoBitrateAllocatorFactory* bitrate_allocator_factory = nullptr;
 
+  // If set, frames that need to be cropped or scaled before encoding are
+  // shared with the other encoders using the same cache.
+  rtc::scoped_refptr<ScaledFrameBufferCache> scaled_frame_buffer_cache;
+
   // Negotiated capabilities which the VideoEncoder may expect the other
   // side to use.
   VideoEncoder::Capabilities capabilities;
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video_codecs/encoder_resource_broker.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+int64_t Weight(const EncoderResourceBroker::Request& request) {
+  int64_t priority_factor = 2;
+  switch (request.priority) {
+    case EncoderResourceBroker::Priority::kLow:
+      priority_factor = 1;
+      break;
+    case EncoderResourceBroker::Priority::kNormal:
+      priority_factor = 2;
+      break;
+    case EncoderResourceBroker::Priority::kHigh:
+      priority_factor = 4;
+      break;
+  }
+  return std::max(request.pixels, 1) * priority_factor;
+}
+
+}  // namespace
+
+EncoderResourceBroker::ThreadQuota::ThreadQuota(EncoderResourceBroker* broker,
+                                                int threads,
+                                                int64_t weight)
+    : broker_(broker), threads_(threads), weight_(weight) {}
+
+EncoderResourceBroker::ThreadQuota::~ThreadQuota() {
+  broker_->ReleaseThreads(threads_, weight_);
+}
+
+EncoderResourceBroker::EncoderResourceBroker() = default;
+
+EncoderResourceBroker::~EncoderResourceBroker() {
+  RTC_DCHECK_EQ(acquired_threads_, 0);
+  RTC_DCHECK_EQ(total_weight_, 0);
+}
+
+// static
+EncoderResourceBroker& EncoderResourceBroker::Default() {
+  static EncoderResourceBroker* const broker = new EncoderResourceBroker();
+  return *broker;
+}
+
+void EncoderResourceBroker::SetMaxTotalThreads(int max_total_threads) {
+  RTC_DCHECK_GE(max_total_threads, 0);
+  MutexLock lock(&mutex_);
+  max_total_threads_ = max_total_threads;
+}
+
+std::unique_ptr<EncoderResourceBroker::ThreadQuota>
+EncoderResourceBroker::RequestThreads(const Request& request) {
+  RTC_DCHECK_GT(request.desired_threads, 0);
+  const int64_t weight = Weight(request);
+  MutexLock lock(&mutex_);
+  int threads = request.desired_threads;
+  if (max_total_threads_ > 0) {
+    // Take the free threads if there are enough, otherwise the share of the
+    // limit in proportion to the weight, which the other encoders give up when
+    // they are initialized again.
+    const int available = max_total_threads_ - acquired_threads_;
+    const int fair_share = static_cast<int>(max_total_threads_ * weight /
+                                            (total_weight_ + weight));
+    threads = std::max(1, std::min(threads, std::max(available, fair_share)));
+  }
+  acquired_threads_ += threads;
+  total_weight_ += weight;
+  return std::unique_ptr<ThreadQuota>(new ThreadQuota(this, threads, weight));
+}
+
+int EncoderResourceBroker::acquired_threads() const {
+  MutexLock lock(&mutex_);
+  return acquired_threads_;
+}
+
+void EncoderResourceBroker::ReleaseThreads(int threads, int64_t weight) {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK_GE(acquired_threads_, threads);
+  RTC_DCHECK_GE(total_weight_, weight);
+  acquired_threads_ -= threads;
+  total_weight_ -= weight;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_CODECS_ENCODER_RESOURCE_BROKER_H_
+#define API_VIDEO_CODECS_ENCODER_RESOURCE_BROKER_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Hands out thread quotas to the software video encoders of a process, so that
+// hosts running many encoders do not oversubscribe their cores. An encoder
+// requests its quota when it is initialized and returns it when it is
+// released.
+//
+// Without a limit, every encoder gets the threads it asks for. With a limit,
+// threads are shared in proportion to the pixel count and priority of the
+// encoders. Quotas are fixed for the lifetime of an encoder configuration, so
+// the shares are rebalanced as encoders are released and initialized again.
+// Until then, the encoders may exceed the limit by their fair shares, and every
+// encoder gets at least one thread. Thread safe.
+class RTC_EXPORT EncoderResourceBroker {
+ public:
+  enum class Priority { kLow, kNormal, kHigh };
+
+  struct Request {
+    // The number of threads the encoder would use on its own.
+    int desired_threads = 1;
+    // The number of pixels of the largest layer of the encoder.
+    int pixels = 0;
+    Priority priority = Priority::kNormal;
+  };
+
+  // The threads granted to an encoder. They are returned to the broker when
+  // the quota is destroyed, which must happen before the broker is destroyed.
+  class RTC_EXPORT ThreadQuota {
+   public:
+    ~ThreadQuota();
+
+    ThreadQuota(const ThreadQuota&) = delete;
+    ThreadQuota& operator=(const ThreadQuota&) = delete;
+
+    int threads() const { return threads_; }
+
+   private:
+    friend class EncoderResourceBroker;
+    ThreadQuota(EncoderResourceBroker* broker, int threads, int64_t weight);
+
+    EncoderResourceBroker* const broker_;
+    const int threads_;
+    const int64_t weight_;
+  };
+
+  EncoderResourceBroker();
+  ~EncoderResourceBroker();
+
+  EncoderResourceBroker(const EncoderResourceBroker&) = delete;
+  EncoderResourceBroker& operator=(const EncoderResourceBroker&) = delete;
+
+  // The broker used by the built-in encoders.
+  static EncoderResourceBroker& Default();
+
+  // Sets the maximum total number of threads of all encoders, or 0 for no
+  // limit, which is the default. Applies to the quotas requested after the
+  // call.
+  void SetMaxTotalThreads(int max_total_threads);
+
+  std::unique_ptr<ThreadQuota> RequestThreads(const Request& request);
+
+  // The total number of threads of the outstanding quotas.
+  int acquired_threads() const;
+
+ private:
+  void ReleaseThreads(int threads, int64_t weight);
+
+  mutable Mutex mutex_;
+  int max_total_threads_ RTC_GUARDED_BY(mutex_) = 0;
+  int acquired_threads_ RTC_GUARDED_BY(mutex_) = 0;
+  // Sum of the weights of the outstanding quotas.
+  int64_t total_weight_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_CODECS_ENCODER_RESOURCE_BROKER_H_
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video_codecs/encoder_resource_broker.h"
+
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Priority = EncoderResourceBroker::Priority;
+using Request = EncoderResourceBroker::Request;
+
+constexpr int kPixels360p = 640 * 360;
+constexpr int kPixels720p = 1280 * 720;
+
+}  // namespace
+
+TEST(EncoderResourceBrokerTest, GrantsDesiredThreadsWithoutLimit) {
+  EncoderResourceBroker broker;
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> first =
+      broker.RequestThreads({8, kPixels720p, Priority::kNormal});
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> second =
+      broker.RequestThreads({8, kPixels720p, Priority::kNormal});
+  EXPECT_EQ(8, first->threads());
+  EXPECT_EQ(8, second->threads());
+  EXPECT_EQ(16, broker.acquired_threads());
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(0, broker.acquired_threads());
+}
+
+TEST(EncoderResourceBrokerTest, TakesFreeThreadsWithinLimit) {
+  EncoderResourceBroker broker;
+  broker.SetMaxTotalThreads(6);
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> first =
+      broker.RequestThreads({4, kPixels720p, Priority::kNormal});
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> second =
+      broker.RequestThreads({2, kPixels720p, Priority::kNormal});
+  EXPECT_EQ(4, first->threads());
+  EXPECT_EQ(2, second->threads());
+  EXPECT_EQ(6, broker.acquired_threads());
+}
+
+TEST(EncoderResourceBrokerTest, RebalancesWhenEncodersAreReinitialized) {
+  EncoderResourceBroker broker;
+  broker.SetMaxTotalThreads(8);
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> first =
+      broker.RequestThreads({8, kPixels720p, Priority::kNormal});
+  EXPECT_EQ(8, first->threads());
+
+  // The second encoder gets its fair share, even if it exceeds the limit.
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> second =
+      broker.RequestThreads({8, kPixels720p, Priority::kNormal});
+  EXPECT_EQ(4, second->threads());
+  EXPECT_EQ(12, broker.acquired_threads());
+
+  // The first encoder gives up the threads beyond its share once initialized
+  // again.
+  first.reset();
+  first = broker.RequestThreads({8, kPixels720p, Priority::kNormal});
+  EXPECT_EQ(4, first->threads());
+  EXPECT_EQ(8, broker.acquired_threads());
+}
+
+TEST(EncoderResourceBrokerTest, SharesInProportionToPixelsAndPriority) {
+  EncoderResourceBroker broker;
+  broker.SetMaxTotalThreads(12);
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> low =
+      broker.RequestThreads({12, kPixels720p, Priority::kLow});
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> high =
+      broker.RequestThreads({12, kPixels720p, Priority::kHigh});
+  // 4 / (1 + 4) of the limit.
+  EXPECT_EQ(9, high->threads());
+
+  // A 360p encoder has a quarter of the weight of a 720p encoder.
+  high.reset();
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> small =
+      broker.RequestThreads({12, kPixels360p, Priority::kHigh});
+  // 1 / (1 + 1) of the limit.
+  EXPECT_EQ(6, small->threads());
+}
+
+TEST(EncoderResourceBrokerTest, GrantsAtLeastOneThread) {
+  EncoderResourceBroker broker;
+  broker.SetMaxTotalThreads(2);
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> quotas[4];
+  for (auto& quota : quotas) {
+    quota = broker.RequestThreads({4, kPixels360p, Priority::kNormal});
+  }
+  EXPECT_EQ(2, quotas[0]->threads());
+  EXPECT_EQ(1, quotas[1]->threads());
+  EXPECT_EQ(1, quotas[2]->threads());
+  EXPECT_EQ(1, quotas[3]->threads());
+}
+
+}  // namespace webrtc
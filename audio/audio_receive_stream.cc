@@ -84,7 +84,7 @@ std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
       config.jitter_buffer_enable_rtx_handling, config.enable_non_sender_rtt,
       config.decoder_factory, config.codec_pair_id,
       std::move(config.frame_decryptor), config.crypto_options,
-      std::move(config.frame_transformer));
+      std::move(config.frame_transformer), config.encoded_frame_observer);
 }
 }  // namespace
 
@@ -198,7 +198,10 @@ void AudioReceiveStream::Start() {
   }
   channel_receive_->StartPlayout();
   playing_ = true;
-  audio_state()->AddReceivingStream(this);
+  // A forwarding stream has no audio to mix.
+  if (!config_.encoded_frame_observer) {
+    audio_state()->AddReceivingStream(this);
+  }
 }
 
 void AudioReceiveStream::Stop() {
@@ -208,7 +211,9 @@ void AudioReceiveStream::Stop() {
   }
   channel_receive_->StopPlayout();
   playing_ = false;
-  audio_state()->RemoveReceivingStream(this);
+  if (!config_.encoded_frame_observer) {
+    audio_state()->RemoveReceivingStream(this);
+  }
 }
 
 bool AudioReceiveStream::IsRunning() const {
@@ -405,6 +410,17 @@ int AudioReceiveStream::PreferredSampleRate() const {
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStream::LatestAudioLevel() const {
+  return channel_receive_->LatestAudioLevel();
+}
+
+void AudioReceiveStream::SkipAudioFrame(int sample_rate_hz,
+                                        AudioFrame* audio_frame) {
+  channel_receive_->SkipAudioFrame(sample_rate_hz, audio_frame);
+  // The skipped packets count as delivered, as when they are played out.
+  source_tracker_.OnFrameDelivered(audio_frame->packet_infos_);
+}
+
 uint32_t AudioReceiveStream::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return config_.rtp.remote_ssrc;
@@ -109,6 +109,8 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> LatestAudioLevel() const override;
+  void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) override;
 
   // Syncable
   uint32_t id() const override;
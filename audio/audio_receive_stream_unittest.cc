@@ -369,6 +369,29 @@ TEST(AudioReceiveStreamTest, StreamsShouldBeAddedToMixerOnceOnStart) {
   }
 }
 
+TEST(AudioReceiveStreamTest, ForwardingStreamIsNotAddedToMixer) {
+  class NullEncodedAudioFrameObserver : public EncodedAudioFrameObserver {
+   public:
+    void OnEncodedAudioFrame(rtc::ArrayView<const uint8_t> payload,
+                             const RTPHeader& header) override {}
+  } observer;
+
+  for (bool use_null_audio_processing : {false, true}) {
+    ConfigHelper helper(use_null_audio_processing);
+    helper.config().encoded_frame_observer = &observer;
+    auto recv_stream = helper.CreateAudioReceiveStream();
+
+    EXPECT_CALL(*helper.channel_receive(), StartPlayout()).Times(1);
+    EXPECT_CALL(*helper.channel_receive(), StopPlayout()).Times(1);
+    EXPECT_CALL(*helper.audio_mixer(), AddSource(_)).Times(0);
+    EXPECT_CALL(*helper.audio_mixer(), RemoveSource(_)).Times(0);
+
+    recv_stream->Start();
+    recv_stream->Stop();
+    recv_stream->UnregisterFromTransport();
+  }
+}
+
 TEST(AudioReceiveStreamTest, ReconfigureWithUpdatedConfig) {
   for (bool use_null_audio_processing : {false, true}) {
     ConfigHelper helper(use_null_audio_processing);
@@ -294,6 +294,51 @@ TEST_P(AudioStateTest, RecordedAudioArrivesAtMultipleStreams) {
   audio_state->RemoveSendingStream(&stream_2);
 }
 
+TEST_P(AudioStateTest, RecordedAudioLongerThan10msArrivesIn10msFrames) {
+  ConfigHelper helper(GetParam());
+
+  if (GetParam().use_async_audio_processing) {
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkSet);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), ProcessCalled).Times(3);
+    EXPECT_CALL(helper.mock_audio_frame_processor(), SinkCleared);
+  }
+
+  rtc::scoped_refptr<internal::AudioState> audio_state(
+      rtc::make_ref_counted<internal::AudioState>(helper.config()));
+
+  MockAudioSendStream stream;
+  audio_state->AddSendingStream(&stream, 8000, 1);
+
+  EXPECT_CALL(stream, SendAudioDataForMock(::testing::Field(
+                          &AudioFrame::samples_per_channel_,
+                          ::testing::Eq(80u))))
+      .Times(3);
+  MockAudioProcessing* ap =
+      static_cast<MockAudioProcessing*>(audio_state->audio_processing());
+  if (ap) {
+    // The later frames were buffered for a shorter time.
+    ::testing::InSequence s;
+    EXPECT_CALL(*ap, set_stream_delay_ms(25));
+    EXPECT_CALL(*ap, set_stream_delay_ms(15));
+    EXPECT_CALL(*ap, set_stream_delay_ms(5));
+  }
+
+  constexpr int kSampleRate = 16000;
+  constexpr size_t kNumChannels = 1;
+  std::vector<int16_t> audio_data;
+  for (int i = 0; i < 3; ++i) {
+    auto audio_data_10ms = Create10msTestData(kSampleRate, kNumChannels);
+    audio_data.insert(audio_data.end(), audio_data_10ms.begin(),
+                      audio_data_10ms.end());
+  }
+  uint32_t new_mic_level = 667;
+  audio_state->audio_transport()->RecordedDataIsAvailable(
+      &audio_data[0], 3 * kSampleRate / 100, kNumChannels * 2, kNumChannels,
+      kSampleRate, 25, 0, 0, false, new_mic_level);
+
+  audio_state->RemoveSendingStream(&stream);
+}
+
 TEST_P(AudioStateTest, EnableChannelSwap) {
   constexpr int kSampleRate = 16000;
   constexpr size_t kNumChannels = 2;
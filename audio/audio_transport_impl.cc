@@ -139,9 +139,13 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
   RTC_DCHECK_LE(number_of_channels, 2);
   RTC_DCHECK_EQ(2 * number_of_channels, bytes_per_sample);
   RTC_DCHECK_GE(sample_rate, AudioProcessing::NativeRate::kSampleRate8kHz);
-  // 100 = 1 second / data duration (10 ms).
-  RTC_DCHECK_EQ(number_of_frames * 100, sample_rate);
-  RTC_DCHECK_LE(bytes_per_sample * number_of_frames * number_of_channels,
+  // 100 = 1 second / data duration (10 ms). Devices that capture in larger
+  // periods may deliver several 10 ms frames at once, which are then processed
+  // one by one but handed to the senders together.
+  const size_t frames_per_10ms = sample_rate / 100;
+  RTC_DCHECK_GT(number_of_frames, 0);
+  RTC_DCHECK_EQ(number_of_frames % frames_per_10ms, 0);
+  RTC_DCHECK_LE(bytes_per_sample * frames_per_10ms * number_of_channels,
                 AudioFrame::kMaxDataSizeBytes);
 
   int send_sample_rate_hz = 0;
@@ -154,23 +158,40 @@ int32_t AudioTransportImpl::RecordedDataIsAvailable(
     swap_stereo_channels = swap_stereo_channels_;
   }
 
-  std::unique_ptr<AudioFrame> audio_frame(new AudioFrame());
-  InitializeCaptureFrame(sample_rate, send_sample_rate_hz, number_of_channels,
-                         send_num_channels, audio_frame.get());
-  voe::RemixAndResample(static_cast<const int16_t*>(audio_data),
-                        number_of_frames, number_of_channels, sample_rate,
-                        &capture_resampler_, audio_frame.get());
-  ProcessCaptureFrame(audio_delay_milliseconds, key_pressed,
-                      swap_stereo_channels, audio_processing_,
-                      audio_frame.get());
-  audio_frame->set_absolute_capture_timestamp_ms(estimated_capture_time_ns /
-                                                 1000000);
+  const size_t num_10ms_frames = number_of_frames / frames_per_10ms;
+  std::vector<std::unique_ptr<AudioFrame>> audio_frames;
+  audio_frames.reserve(num_10ms_frames);
+  for (size_t i = 0; i < num_10ms_frames; ++i) {
+    std::unique_ptr<AudioFrame> audio_frame(new AudioFrame());
+    InitializeCaptureFrame(sample_rate, send_sample_rate_hz,
+                           number_of_channels, send_num_channels,
+                           audio_frame.get());
+    voe::RemixAndResample(static_cast<const int16_t*>(audio_data) +
+                              i * frames_per_10ms * number_of_channels,
+                          frames_per_10ms, number_of_channels, sample_rate,
+                          &capture_resampler_, audio_frame.get());
+    // Every later frame was captured 10 ms after the previous one, and so
+    // spent 10 ms less in the device buffers.
+    const uint32_t delay_ms =
+        audio_delay_milliseconds -
+        std::min<uint32_t>(audio_delay_milliseconds, 10 * i);
+    ProcessCaptureFrame(delay_ms, key_pressed, swap_stereo_channels,
+                        audio_processing_, audio_frame.get());
+    int64_t capture_time_ms = estimated_capture_time_ns / 1000000;
+    if (capture_time_ms != 0)
+      capture_time_ms += 10 * i;
+    audio_frame->set_absolute_capture_timestamp_ms(capture_time_ms);
+
+    RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
+    audio_frames.push_back(std::move(audio_frame));
+  }
 
-  RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
-  if (async_audio_processing_)
-    async_audio_processing_->Process(std::move(audio_frame));
-  else
-    SendProcessedData(std::move(audio_frame));
+  if (async_audio_processing_) {
+    for (auto& audio_frame : audio_frames)
+      async_audio_processing_->Process(std::move(audio_frame));
+  } else {
+    SendProcessedData(std::move(audio_frames));
+  }
 
   return 0;
 }
@@ -179,6 +200,18 @@ void AudioTransportImpl::SendProcessedData(
     std::unique_ptr<AudioFrame> audio_frame) {
   RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
   MutexLock lock(&capture_lock_);
+  SendToAudioSenders(std::move(audio_frame));
+}
+
+void AudioTransportImpl::SendProcessedData(
+    std::vector<std::unique_ptr<AudioFrame>> audio_frames) {
+  MutexLock lock(&capture_lock_);
+  for (auto& audio_frame : audio_frames)
+    SendToAudioSenders(std::move(audio_frame));
+}
+
+void AudioTransportImpl::SendToAudioSenders(
+    std::unique_ptr<AudioFrame> audio_frame) {
   if (audio_senders_.empty())
     return;
 
@@ -209,23 +242,32 @@ int32_t AudioTransportImpl::NeedMorePlayData(const size_t nSamples,
       samplesPerSec,
       static_cast<uint32_t>(AudioProcessing::NativeRate::kSampleRate8kHz));
 
-  // 100 = 1 second / data duration (10 ms).
-  RTC_DCHECK_EQ(nSamples * 100, samplesPerSec);
-  RTC_DCHECK_LE(nBytesPerSample * nSamples * nChannels,
+  // 100 = 1 second / data duration (10 ms). Requests for several 10 ms
+  // frames at once are served by mixing one frame at a time.
+  const size_t samples_per_10ms = samplesPerSec / 100;
+  RTC_DCHECK_GT(nSamples, 0);
+  RTC_DCHECK_EQ(nSamples % samples_per_10ms, 0);
+  RTC_DCHECK_LE(nBytesPerSample * samples_per_10ms * nChannels,
                 AudioFrame::kMaxDataSizeBytes);
 
-  mixer_->Mix(nChannels, &mixed_frame_);
-  *elapsed_time_ms = mixed_frame_.elapsed_time_ms_;
-  *ntp_time_ms = mixed_frame_.ntp_time_ms_;
+  nSamplesOut = 0;
+  for (size_t i = 0; i < nSamples / samples_per_10ms; ++i) {
+    mixer_->Mix(nChannels, &mixed_frame_);
+    if (i == 0) {
+      *elapsed_time_ms = mixed_frame_.elapsed_time_ms_;
+      *ntp_time_ms = mixed_frame_.ntp_time_ms_;
+    }
 
-  if (audio_processing_) {
-    const auto error =
-        ProcessReverseAudioFrame(audio_processing_, &mixed_frame_);
-    RTC_DCHECK_EQ(error, AudioProcessing::kNoError);
-  }
+    if (audio_processing_) {
+      const auto error =
+          ProcessReverseAudioFrame(audio_processing_, &mixed_frame_);
+      RTC_DCHECK_EQ(error, AudioProcessing::kNoError);
+    }
 
-  nSamplesOut = Resample(mixed_frame_, samplesPerSec, &render_resampler_,
-                         static_cast<int16_t*>(audioSamples));
+    nSamplesOut +=
+        Resample(mixed_frame_, samplesPerSec, &render_resampler_,
+                 static_cast<int16_t*>(audioSamples) + nSamplesOut);
+  }
   RTC_DCHECK_EQ(nSamplesOut, nChannels * nSamples);
   return 0;
 }
@@ -92,6 +92,10 @@ class AudioTransportImpl : public AudioTransport {
 
  private:
   void SendProcessedData(std::unique_ptr<AudioFrame> audio_frame);
+  // Takes `capture_lock_` once for all of `audio_frames`.
+  void SendProcessedData(std::vector<std::unique_ptr<AudioFrame>> audio_frames);
+  void SendToAudioSenders(std::unique_ptr<AudioFrame> audio_frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
 
   // Shared.
   AudioProcessing* audio_processing_ = nullptr;
@@ -101,7 +101,8 @@ class ChannelReceive : public ChannelReceiveInterface,
       absl::optional<AudioCodecPairId> codec_pair_id,
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
       const webrtc::CryptoOptions& crypto_options,
-      rtc::scoped_refptr<FrameTransformerInterface> frame_transformer);
+      rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+      EncodedAudioFrameObserver* encoded_frame_observer);
   ~ChannelReceive() override;
 
   void SetSink(AudioSinkInterface* sink) override;
@@ -166,6 +167,9 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   int PreferredSampleRate() const override;
 
+  absl::optional<int> LatestAudioLevel() const override;
+  void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) override;
+
   void SetSourceTracker(SourceTracker* source_tracker) override;
 
   // Associate to a send channel.
@@ -267,6 +271,10 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   mutable Mutex ts_stats_lock_;
 
+  // The audio level of the most recently received packet, if it has one.
+  mutable Mutex audio_level_mutex_;
+  absl::optional<int> latest_audio_level_ RTC_GUARDED_BY(audio_level_mutex_);
+
   std::unique_ptr<rtc::TimestampWrapAroundHandler> rtp_ts_wraparound_handler_;
   // The rtp timestamp of the first played out audio frame.
   int64_t capture_start_rtp_time_stamp_;
@@ -297,6 +305,9 @@ class ChannelReceive : public ChannelReceiveInterface,
   rtc::scoped_refptr<ChannelReceiveFrameTransformerDelegate>
       frame_transformer_delegate_;
 
+  // If set, received frames are forwarded to it instead of being decoded.
+  EncodedAudioFrameObserver* const encoded_frame_observer_;
+
   // Counter that's used to control the frequency of reporting histograms
   // from the `GetAudioFrameWithInfo` callback.
   int audio_frame_interval_count_ RTC_GUARDED_BY(audio_thread_race_checker_) =
@@ -335,6 +346,23 @@ void ChannelReceive::OnReceivedPayloadData(
     return;
   }
 
+  if (rtpHeader.extension.hasAudioLevel) {
+    MutexLock lock(&audio_level_mutex_);
+    latest_audio_level_ = rtpHeader.extension.audioLevel;
+  }
+
+  if (encoded_frame_observer_) {
+    // Forward the frame without decoding it. As when playout is muted, this is
+    // when the frame counts as delivered.
+    if (source_tracker_) {
+      RtpPacketInfos::vector_type packet_vector = {
+          RtpPacketInfo(rtpHeader, clock_->CurrentTime())};
+      source_tracker_->OnFrameDelivered(RtpPacketInfos(packet_vector));
+    }
+    encoded_frame_observer_->OnEncodedAudioFrame(payload, rtpHeader);
+    return;
+  }
+
   // Push the incoming payload (parsed and ready for decoding) into the ACM
   if (acm_receiver_.InsertPacket(rtpHeader, payload) != 0) {
     RTC_DLOG(LS_ERROR) << "ChannelReceive::OnReceivedPayloadData() unable to "
@@ -380,6 +408,14 @@ AudioMixer::Source::AudioFrameInfo ChannelReceive::GetAudioFrameWithInfo(
   RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
   audio_frame->sample_rate_hz_ = sample_rate_hz;
 
+  if (encoded_frame_observer_) {
+    // Nothing is decoded when forwarding.
+    audio_frame->num_channels_ = 1;
+    audio_frame->samples_per_channel_ = sample_rate_hz / 100;
+    audio_frame->Mute();
+    return AudioMixer::Source::AudioFrameInfo::kMuted;
+  }
+
   event_log_->Log(std::make_unique<RtcEventAudioPlayout>(remote_ssrc_));
 
   // Get 10ms raw PCM data from the ACM (mixer limits output frequency)
@@ -509,6 +545,23 @@ int ChannelReceive::PreferredSampleRate() const {
                   acm_receiver_.last_output_sample_rate_hz());
 }
 
+absl::optional<int> ChannelReceive::LatestAudioLevel() const {
+  MutexLock lock(&audio_level_mutex_);
+  return latest_audio_level_;
+}
+
+void ChannelReceive::SkipAudioFrame(int sample_rate_hz,
+                                    AudioFrame* audio_frame) {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  // Keep NetEq running, but leave out the decoding and everything that
+  // processes the decoded audio. The output is muted.
+  if (acm_receiver_.GetAudioWithoutDecoding(audio_frame) == -1) {
+    RTC_DLOG(LS_ERROR) << "ChannelReceive::SkipAudioFrame() failed!";
+    return;
+  }
+  _outputAudioLevel.ComputeLevel(*audio_frame, kAudioSampleDurationSeconds);
+}
+
 void ChannelReceive::SetSourceTracker(SourceTracker* source_tracker) {
   source_tracker_ = source_tracker;
 }
@@ -530,7 +583,8 @@ ChannelReceive::ChannelReceive(
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
     const webrtc::CryptoOptions& crypto_options,
-    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer)
+    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+    EncodedAudioFrameObserver* encoded_frame_observer)
     : worker_thread_(TaskQueueBase::Current()),
       event_log_(rtc_event_log),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock)),
@@ -553,7 +607,8 @@ ChannelReceive::ChannelReceive(
       associated_send_channel_(nullptr),
       frame_decryptor_(frame_decryptor),
       crypto_options_(crypto_options),
-      absolute_capture_time_interpolator_(clock) {
+      absolute_capture_time_interpolator_(clock),
+      encoded_frame_observer_(encoded_frame_observer) {
   RTC_DCHECK(audio_device_module);
 
   network_thread_checker_.Detach();
@@ -1129,14 +1184,15 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
     const webrtc::CryptoOptions& crypto_options,
-    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer) {
+    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+    EncodedAudioFrameObserver* encoded_frame_observer) {
   return std::make_unique<ChannelReceive>(
       clock, neteq_factory, audio_device_module, rtcp_send_transport,
       rtc_event_log, local_ssrc, remote_ssrc, jitter_buffer_max_packets,
       jitter_buffer_fast_playout, jitter_buffer_min_delay_ms,
       jitter_buffer_enable_rtx_handling, enable_non_sender_rtt, decoder_factory,
       codec_pair_id, std::move(frame_decryptor), crypto_options,
-      std::move(frame_transformer));
+      std::move(frame_transformer), encoded_frame_observer);
 }
 
 }  // namespace voe
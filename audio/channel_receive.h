@@ -25,6 +25,7 @@
 #include "api/frame_transformer_interface.h"
 #include "api/neteq/neteq_factory.h"
 #include "api/transport/rtp/rtp_source.h"
+#include "call/audio_receive_stream.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "modules/audio_coding/include/audio_coding_module_typedefs.h"
@@ -149,6 +150,10 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   virtual int PreferredSampleRate() const = 0;
 
+  // See AudioMixer::Source.
+  virtual absl::optional<int> LatestAudioLevel() const = 0;
+  virtual void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) = 0;
+
   // Sets the source tracker to notify about "delivered" packets when output is
   // muted.
   virtual void SetSourceTracker(SourceTracker* source_tracker) = 0;
@@ -188,7 +193,8 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     absl::optional<AudioCodecPairId> codec_pair_id,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor,
     const webrtc::CryptoOptions& crypto_options,
-    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer);
+    rtc::scoped_refptr<FrameTransformerInterface> frame_transformer,
+    EncodedAudioFrameObserver* encoded_frame_observer = nullptr);
 
 }  // namespace voe
 }  // namespace webrtc
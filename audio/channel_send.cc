@@ -53,6 +53,9 @@ namespace {
 
 constexpr int64_t kMaxRetransmissionWindowMs = 1000;
 constexpr int64_t kMinRetransmissionWindowMs = 30;
+// 10 ms frames of silence after which the encoder is skipped, if enabled.
+// Long enough for Opus to have gone into DTX and sent its first DTX packet.
+constexpr int kSilentFramesBeforeSkippingEncoding = 50;
 
 class RtpPacketSenderProxy;
 class TransportSequenceNumberProxy;
@@ -207,6 +210,8 @@ class ChannelSend : public ChannelSendInterface,
   RmsLevel rms_level_ RTC_GUARDED_BY(encoder_queue_);
   bool input_mute_ RTC_GUARDED_BY(volume_settings_mutex_);
   bool previous_frame_muted_ RTC_GUARDED_BY(encoder_queue_);
+  // Number of silent frames in a row, counted when `skip_silent_encoding_`.
+  int consecutive_silent_frames_ RTC_GUARDED_BY(encoder_queue_) = 0;
   // VoeRTP_RTCP
   // TODO(henrika): can today be accessed on the main thread and on the
   // task queue; hence potential race.
@@ -242,6 +247,8 @@ class ChannelSend : public ChannelSendInterface,
   rtc::TaskQueue encoder_queue_;
 
   const bool fixing_timestamp_stall_;
+  // Stops feeding the encoder once the input has been silent for a while.
+  const bool skip_silent_encoding_;
 
   mutable Mutex rtcp_counter_mutex_;
   RtcpPacketTypeCounter rtcp_packet_type_counter_
@@ -477,7 +484,9 @@ ChannelSend::ChannelSend(
           "AudioEncoder",
           TaskQueueFactory::Priority::NORMAL)),
       fixing_timestamp_stall_(
-          !field_trial::IsDisabled("WebRTC-Audio-FixTimestampStall")) {
+          !field_trial::IsDisabled("WebRTC-Audio-FixTimestampStall")),
+      skip_silent_encoding_(
+          field_trial::IsEnabled("WebRTC-Audio-SkipSilentEncoding")) {
   audio_coding_.reset(AudioCodingModule::Create(AudioCodingModule::Config()));
 
   RtpRtcpInterface::Configuration configuration;
@@ -845,6 +854,21 @@ void ChannelSend::ProcessAndEncodeAudio(
         }
         previous_frame_muted_ = is_muted;
 
+        // Once the input has been muted or digitally silent for long enough
+        // for the encoder to have gone into DTX, the encoder is skipped until
+        // there is sound again. It would only be fed zeros in the meantime,
+        // and the ACM picks up the timestamp jump when it's fed again.
+        if (skip_silent_encoding_) {
+          if (!audio_frame->muted()) {
+            consecutive_silent_frames_ = 0;
+          } else if (++consecutive_silent_frames_ >
+                     kSilentFramesBeforeSkippingEncoding) {
+            _timeStamp +=
+                static_cast<uint32_t>(audio_frame->samples_per_channel_);
+            return;
+          }
+        }
+
         // Add 10ms of raw (PCM) audio data to the encoder @ 32kHz.
 
         // The ACM resamples internally.
@@ -17,8 +17,8 @@
 #include <utility>
 
 #include "common_audio/include/audio_util.h"
+#include "common_audio/mixing_kernels.h"
 #include "rtc_base/checks.h"
-#include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
 namespace {
@@ -63,11 +63,7 @@ void AudioFrameOperations::Add(const AudioFrame& frame_to_add,
     if (no_previous_data) {
       std::copy(in_data, in_data + length, out_data);
     } else {
-      for (size_t i = 0; i < length; i++) {
-        const int32_t wrap_guard = static_cast<int32_t>(out_data[i]) +
-                                   static_cast<int32_t>(in_data[i]);
-        out_data[i] = rtc::saturated_cast<int16_t>(wrap_guard);
-      }
+      GetMixingKernels().add_s16_with_saturation(in_data, length, out_data);
     }
   }
 }
@@ -122,7 +118,11 @@ void AudioFrameOperations::DownmixChannels(const int16_t* src_audio,
                                            size_t samples_per_channel,
                                            size_t dst_channels,
                                            int16_t* dst_audio) {
-  if (src_channels > 1 && dst_channels == 1) {
+  if (src_channels == 2 && dst_channels == 1) {
+    GetMixingKernels().downmix_stereo_to_mono(src_audio, samples_per_channel,
+                                              dst_audio);
+    return;
+  } else if (src_channels > 1 && dst_channels == 1) {
     DownmixInterleavedToMono(src_audio, samples_per_channel, src_channels,
                              dst_audio);
     return;
@@ -140,7 +140,10 @@ void AudioFrameOperations::DownmixChannels(size_t dst_channels,
   RTC_DCHECK_LE(frame->samples_per_channel_ * frame->num_channels_,
                 AudioFrame::kMaxDataSizeSamples);
   if (frame->num_channels_ > 1 && dst_channels == 1) {
-    if (!frame->muted()) {
+    if (!frame->muted() && frame->num_channels_ == 2) {
+      GetMixingKernels().downmix_stereo_to_mono(
+          frame->data(), frame->samples_per_channel_, frame->mutable_data());
+    } else if (!frame->muted()) {
       DownmixInterleavedToMono(frame->data(), frame->samples_per_channel_,
                                frame->num_channels_, frame->mutable_data());
     }
@@ -166,7 +169,10 @@ void AudioFrameOperations::UpmixChannels(size_t target_number_of_channels,
     return;
   }
 
-  if (!frame->muted()) {
+  if (!frame->muted() && target_number_of_channels == 2) {
+    GetMixingKernels().upmix_mono_to_stereo(frame->samples_per_channel_,
+                                            frame->mutable_data());
+  } else if (!frame->muted()) {
     // Up-mixing done in place. Going backwards through the frame ensure nothing
     // is irrevocably overwritten.
     int16_t* frame_data = frame->mutable_data();
@@ -284,11 +290,9 @@ int AudioFrameOperations::ScaleWithSat(float scale, AudioFrame* frame) {
     return 0;
   }
 
-  int16_t* frame_data = frame->mutable_data();
-  for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
-       i++) {
-    frame_data[i] = rtc::saturated_cast<int16_t>(scale * frame_data[i]);
-  }
+  GetMixingKernels().scale_s16_with_saturation(
+      scale, frame->samples_per_channel_ * frame->num_channels_,
+      frame->mutable_data());
   return 0;
 }
 }  // namespace webrtc
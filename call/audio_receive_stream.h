@@ -17,9 +17,11 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/audio_codecs/audio_decoder_factory.h"
 #include "api/call/transport.h"
 #include "api/crypto/crypto_options.h"
+#include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
 #include "call/receive_stream.h"
 #include "call/rtp_config.h"
@@ -27,6 +29,20 @@
 namespace webrtc {
 class AudioSinkInterface;
 
+// Receives the encoded frames of an AudioReceiveStream that forwards them
+// instead of decoding them, e.g. in an SFU. See
+// AudioReceiveStream::Config::encoded_frame_observer.
+class EncodedAudioFrameObserver {
+ public:
+  virtual ~EncodedAudioFrameObserver() = default;
+
+  // Called on the worker thread with the payload of each received packet,
+  // after decryption and any frame transformer. `header` has its RTP
+  // timestamp, sequence number, audio level and absolute capture time.
+  virtual void OnEncodedAudioFrame(rtc::ArrayView<const uint8_t> payload,
+                                   const RTPHeader& header) = 0;
+};
+
 class AudioReceiveStream : public MediaReceiveStream {
  public:
   struct Stats {
@@ -158,6 +174,11 @@ class AudioReceiveStream : public MediaReceiveStream {
     // a part of the AudioReceiveStream state but rather a pass through
     // variable.
     rtc::scoped_refptr<webrtc::FrameTransformerInterface> frame_transformer;
+
+    // If set, received frames are given to this observer instead of being
+    // inserted into NetEq, so nothing is decoded, and the stream isn't mixed
+    // for playout. Must outlive the stream.
+    EncodedAudioFrameObserver* encoded_frame_observer = nullptr;
   };
 
   // Methods that support reconfiguring the stream post initialization.
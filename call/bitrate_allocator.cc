@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -30,6 +31,7 @@ namespace webrtc {
 
 namespace {
 using bitrate_allocator_impl::AllocatableTrack;
+using bitrate_allocator_impl::AllocationCache;
 
 // Allow packets to be transmitted in up to 2 times max video bitrate if the
 // bandwidth estimate allows it.
@@ -70,6 +72,31 @@ bool EnoughBitrateForAllObservers(
   return true;
 }
 
+// Updates the parts of `cache` that only depend on the configs of the tracks.
+void UpdateTracks(const std::vector<AllocatableTrack>& allocatable_tracks,
+                  AllocationCache* cache) {
+  if (cache->tracks_valid)
+    return;
+  cache->sum_min_bitrates = 0;
+  cache->sum_max_bitrates = 0;
+  for (const auto& observer_config : allocatable_tracks) {
+    cache->sum_min_bitrates += observer_config.config.min_bitrate_bps;
+    cache->sum_max_bitrates += observer_config.config.max_bitrate_bps;
+  }
+  cache->by_max_bitrate.resize(allocatable_tracks.size());
+  std::iota(cache->by_max_bitrate.begin(), cache->by_max_bitrate.end(), 0);
+  absl::c_stable_sort(cache->by_max_bitrate, [&](size_t a, size_t b) {
+    return allocatable_tracks[a].config.max_bitrate_bps <
+           allocatable_tracks[b].config.max_bitrate_bps;
+  });
+  cache->by_relative_capacity.resize(allocatable_tracks.size());
+  std::iota(cache->by_relative_capacity.begin(),
+            cache->by_relative_capacity.end(), 0);
+  cache->capacities.resize(allocatable_tracks.size());
+  cache->evenly_distributed.reserve(allocatable_tracks.size());
+  cache->tracks_valid = true;
+}
+
 // Splits `bitrate` evenly to observers already in `allocation`.
 // `include_zero_allocations` decides if zero allocations should be part of
 // the distribution or not. The allowed max bitrate is `max_multiplier` x
@@ -79,34 +106,34 @@ void DistributeBitrateEvenly(
     uint32_t bitrate,
     bool include_zero_allocations,
     int max_multiplier,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    AllocationCache* cache,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
 
-  std::multimap<uint32_t, const AllocatableTrack*> list_max_bitrates;
-  for (const auto& observer_config : allocatable_tracks) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(
-          {observer_config.config.max_bitrate_bps, &observer_config});
-    }
+  // In order of max bitrate.
+  std::vector<size_t>& observers = cache->evenly_distributed;
+  observers.clear();
+  for (size_t i : cache->by_max_bitrate) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      observers.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  size_t num_remaining = observers.size();
+  for (size_t i : observers) {
     RTC_DCHECK_GT(bitrate, 0);
+    uint32_t max_bitrate =
+        max_multiplier * allocatable_tracks[i].config.max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(num_remaining--);
+    uint32_t total_allocation = extra_allocation + (*allocation)[i];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_bitrate;
+      total_allocation = max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[i] = total_allocation;
   }
 }
 
@@ -115,31 +142,19 @@ void DistributeBitrateEvenly(
 // more than the observer's capacity, it will be allocated its capacity, and
 // the excess bitrate is still allocated proportionally to other observers.
 // Allocating the proportional amount means an observer with twice the
-// bitrate_priority of another will be allocated twice the bitrate.
+// bitrate_priority of another will be allocated twice the bitrate. The
+// capacities are taken from `cache`.
 void DistributeBitrateRelatively(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t remaining_bitrate,
-    const std::map<BitrateAllocatorObserver*, int>& observers_capacities,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    AllocationCache* cache,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
-  RTC_DCHECK_EQ(observers_capacities.size(), allocatable_tracks.size());
-
-  struct PriorityRateObserverConfig {
-    BitrateAllocatorObserver* allocation_key;
-    // The amount of bitrate bps that can be allocated to this observer.
-    int capacity_bps;
-    double bitrate_priority;
-  };
+  RTC_DCHECK_EQ(cache->capacities.size(), allocatable_tracks.size());
 
   double bitrate_priority_sum = 0;
-  std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : allocatable_tracks) {
-    priority_rate_observers.push_back(PriorityRateObserverConfig{
-        observer_config.observer,
-        observers_capacities.at(observer_config.observer),
-        observer_config.config.bitrate_priority});
+  for (const auto& observer_config : allocatable_tracks)
     bitrate_priority_sum += observer_config.config.bitrate_priority;
-  }
 
   // Iterate in the order observers can be allocated their full capacity.
 
@@ -149,69 +164,82 @@ void DistributeBitrateRelatively(
   // filled. This is because the amount allocated is based upon bitrate
   // priority. We allocate twice as much bitrate to an observer with twice the
   // bitrate priority of another.
-  absl::c_sort(priority_rate_observers, [](const auto& a, const auto& b) {
-    return a.capacity_bps / a.bitrate_priority <
-           b.capacity_bps / b.bitrate_priority;
-  });
+  const std::vector<int>& capacities = cache->capacities;
+  auto normalized_capacity = [&](size_t i) {
+    return capacities[i] / allocatable_tracks[i].config.bitrate_priority;
+  };
+  // The order of the previous estimate is kept, and as it mostly still
+  // holds, an insertion sort is close to linear.
+  std::vector<size_t>& order = cache->by_relative_capacity;
+  for (size_t j = 1; j < order.size(); ++j) {
+    const size_t index = order[j];
+    const double capacity = normalized_capacity(index);
+    size_t k = j;
+    for (; k > 0 && capacity < normalized_capacity(order[k - 1]); --k)
+      order[k] = order[k - 1];
+    order[k] = index;
+  }
+
   size_t i;
-  for (i = 0; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (i = 0; i < order.size(); ++i) {
+    const AllocatableTrack& observer_config = allocatable_tracks[order[i]];
     // We allocate the full capacity to an observer only if its relative
     // portion from the remaining bitrate is sufficient to allocate its full
     // capacity. This means we aren't greedily allocating the full capacity, but
     // that it is only done when there is also enough bitrate to allocate the
     // proportional amounts to all other observers.
     double observer_share =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
+        observer_config.config.bitrate_priority / bitrate_priority_sum;
     double allocation_bps = observer_share * remaining_bitrate;
-    bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
+    bool enough_bitrate = allocation_bps >= capacities[order[i]];
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        priority_rate_observer.capacity_bps;
-    remaining_bitrate -= priority_rate_observer.capacity_bps;
-    bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
+    (*allocation)[order[i]] += capacities[order[i]];
+    remaining_bitrate -= capacities[order[i]];
+    bitrate_priority_sum -= observer_config.config.bitrate_priority;
   }
 
   // From the remaining bitrate, allocate the proportional amounts to the
   // observers that aren't allocated their max capacity.
-  for (; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (; i < order.size(); ++i) {
     double fraction_allocated =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        fraction_allocated * remaining_bitrate;
+        allocatable_tracks[order[i]].config.bitrate_priority /
+        bitrate_priority_sum;
+    (*allocation)[order[i]] += fraction_allocated * remaining_bitrate;
   }
 }
 
 // Allocates bitrate to observers when there isn't enough to allocate the
 // minimum to all observers.
-std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
+void LowRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       AllocationCache* cache,
+                       std::vector<int>* allocation) {
+  allocation->assign(allocatable_tracks.size(), 0);
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : allocatable_tracks) {
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const AllocatableTrack& observer_config = allocatable_tracks[i];
     int32_t allocated_bitrate = 0;
     if (observer_config.config.enforce_min_bitrate)
       allocated_bitrate = observer_config.config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    (*allocation)[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -219,14 +247,15 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -235,10 +264,7 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
   // Split a possible remainder evenly on all streams with an allocation.
   if (remaining_bitrate > 0)
     DistributeBitrateEvenly(allocatable_tracks, remaining_bitrate, false, 1,
-                            &allocation);
-
-  RTC_DCHECK_EQ(allocation.size(), allocatable_tracks.size());
-  return allocation;
+                            cache, allocation);
 }
 
 // Allocates bitrate to all observers when the available bandwidth is enough
@@ -252,32 +278,31 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 // bitrate_priority = 2.0, the expected behavior is that observer 2 will be
 // allocated twice the bitrate as observer 1 above the each observer's
 // min_bitrate_bps values, until one of the observers hits its max_bitrate_bps.
-std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
+void NormalRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  std::map<BitrateAllocatorObserver*, int> observers_capacities;
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.config.max_bitrate_bps -
-        observer_config.config.min_bitrate_bps;
+    AllocationCache* cache,
+    std::vector<int>* allocation) {
+  allocation->resize(allocatable_tracks.size());
+  std::vector<int>& observers_capacities = cache->capacities;
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const AllocatableTrack& observer_config = allocatable_tracks[i];
+    (*allocation)[i] = observer_config.config.min_bitrate_bps;
+    observers_capacities[i] = observer_config.config.max_bitrate_bps -
+                              observer_config.config.min_bitrate_bps;
   }
 
-  bitrate -= sum_min_bitrates;
+  bitrate -= cache->sum_min_bitrates;
 
   // TODO(srte): Implement fair sharing between prioritized streams, currently
   // they are treated on a first come first serve basis.
-  for (const auto& observer_config : allocatable_tracks) {
-    int64_t priority_margin = observer_config.config.priority_bitrate_bps -
-                              allocation[observer_config.observer];
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    int64_t priority_margin =
+        allocatable_tracks[i].config.priority_bitrate_bps - (*allocation)[i];
     if (priority_margin > 0 && bitrate > 0) {
       int64_t extra_bitrate = std::min<int64_t>(priority_margin, bitrate);
-      allocation[observer_config.observer] +=
-          rtc::dchecked_cast<int>(extra_bitrate);
-      observers_capacities[observer_config.observer] -= extra_bitrate;
+      (*allocation)[i] += rtc::dchecked_cast<int>(extra_bitrate);
+      observers_capacities[i] -= extra_bitrate;
       bitrate -= extra_bitrate;
     }
   }
@@ -285,69 +310,69 @@ std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
   // From the remaining bitrate, allocate a proportional amount to each observer
   // above the min bitrate already allocated.
   if (bitrate > 0)
-    DistributeBitrateRelatively(allocatable_tracks, bitrate,
-                                observers_capacities, &allocation);
-
-  return allocation;
+    DistributeBitrateRelatively(allocatable_tracks, bitrate, cache, allocation);
 }
 
 // Allocates bitrate to observers when there is enough available bandwidth
 // for all observers to be allocated their max bitrate.
-std::map<BitrateAllocatorObserver*, int> MaxRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate,
-    uint32_t sum_max_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.max_bitrate_bps;
-    bitrate -= observer_config.config.max_bitrate_bps;
+void MaxRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       AllocationCache* cache,
+                       std::vector<int>* allocation) {
+  allocation->resize(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    (*allocation)[i] = allocatable_tracks[i].config.max_bitrate_bps;
+    bitrate -= allocatable_tracks[i].config.max_bitrate_bps;
   }
   DistributeBitrateEvenly(allocatable_tracks, bitrate, true,
-                          kTransmissionMaxBitrateMultiplier, &allocation);
-  return allocation;
-}
-
-// Allocates zero bitrate to all observers.
-std::map<BitrateAllocatorObserver*, int> ZeroRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  for (const auto& observer_config : allocatable_tracks)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+                          kTransmissionMaxBitrateMultiplier, cache, allocation);
 }
 
-std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  if (allocatable_tracks.empty())
-    return std::map<BitrateAllocatorObserver*, int>();
-
-  if (bitrate == 0)
-    return ZeroRateAllocation(allocatable_tracks);
+// Allocates `bitrate` to the tracks, into `allocation`. Allocating the same
+// bitrate as last time only has to be redone if the result depends on the
+// previous allocations of the tracks, which is the case when there isn't
+// enough bitrate to allocate the min bitrate to all of them.
+void AllocateBitrates(const std::vector<AllocatableTrack>& allocatable_tracks,
+                      uint32_t bitrate,
+                      AllocationCache* cache,
+                      AllocationCache::Allocation* allocation) {
+  UpdateTracks(allocatable_tracks, cache);
+  const bool enough_bitrate =
+      bitrate == 0 || allocatable_tracks.empty() ||
+      EnoughBitrateForAllObservers(allocatable_tracks, bitrate,
+                                   cache->sum_min_bitrates);
+  if (allocation->valid && allocation->config_only &&
+      allocation->bitrate_bps == bitrate && enough_bitrate) {
+    return;
+  }
+  allocation->valid = true;
+  allocation->bitrate_bps = bitrate;
+  allocation->config_only = enough_bitrate;
 
-  uint32_t sum_min_bitrates = 0;
-  uint32_t sum_max_bitrates = 0;
-  for (const auto& observer_config : allocatable_tracks) {
-    sum_min_bitrates += observer_config.config.min_bitrate_bps;
-    sum_max_bitrates += observer_config.config.max_bitrate_bps;
+  if (allocatable_tracks.empty() || bitrate == 0) {
+    allocation->bitrates.assign(allocatable_tracks.size(), 0);
+    return;
   }
 
   // Not enough for all observers to get an allocation, allocate according to:
   // enforced min bitrate -> allocated bitrate previous round -> restart paused
   // streams.
-  if (!EnoughBitrateForAllObservers(allocatable_tracks, bitrate,
-                                    sum_min_bitrates))
-    return LowRateAllocation(allocatable_tracks, bitrate);
+  if (!enough_bitrate) {
+    LowRateAllocation(allocatable_tracks, bitrate, cache,
+                      &allocation->bitrates);
+    return;
+  }
 
   // All observers will get their min bitrate plus a share of the rest. This
   // share is allocated to each observer based on its bitrate_priority.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(allocatable_tracks, bitrate, sum_min_bitrates);
+  if (bitrate <= cache->sum_max_bitrates) {
+    NormalRateAllocation(allocatable_tracks, bitrate, cache,
+                         &allocation->bitrates);
+    return;
+  }
 
   // All observers will get up to transmission_max_bitrate_multiplier_ x max.
-  return MaxRateAllocation(allocatable_tracks, bitrate, sum_max_bitrates);
+  MaxRateAllocation(allocatable_tracks, bitrate, cache, &allocation->bitrates);
 }
 
 }  // namespace
@@ -395,14 +420,12 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     last_bwe_log_time_ = now;
   }
 
-  auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-  auto stable_bitrate_allocation =
-      AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-
-  for (auto& config : allocatable_tracks_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
+  AllocateLastTargets();
+  for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+    AllocatableTrack& config = allocatable_tracks_[i];
+    uint32_t allocated_bitrate = allocation_cache_.target.bitrates[i];
     uint32_t allocated_stable_target_rate =
-        stable_bitrate_allocation[config.observer];
+        allocation_cache_.stable.bitrates[i];
     BitrateAllocationUpdate update;
     update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
     update.stable_target_bitrate =
@@ -458,17 +481,15 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   } else {
     allocatable_tracks_.push_back(AllocatableTrack(observer, config));
   }
+  allocation_cache_.Invalidate();
 
   if (last_target_bps_ > 0) {
     // Calculate a new allocation and update all observers.
-
-    auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-    auto stable_bitrate_allocation =
-        AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-    for (auto& config : allocatable_tracks_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
-      uint32_t allocated_stable_bitrate =
-          stable_bitrate_allocation[config.observer];
+    AllocateLastTargets();
+    for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+      AllocatableTrack& config = allocatable_tracks_[i];
+      uint32_t allocated_bitrate = allocation_cache_.target.bitrates[i];
+      uint32_t allocated_stable_bitrate = allocation_cache_.stable.bitrates[i];
       BitrateAllocationUpdate update;
       update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
       update.stable_target_bitrate =
@@ -497,6 +518,19 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   UpdateAllocationLimits();
 }
 
+void BitrateAllocator::AllocateLastTargets() {
+  AllocateBitrates(allocatable_tracks_, last_target_bps_, &allocation_cache_,
+                   &allocation_cache_.target);
+  if (last_stable_target_bps_ == last_target_bps_) {
+    // Both are allocated before any track is updated, so the result is the
+    // same.
+    allocation_cache_.stable = allocation_cache_.target;
+  } else {
+    AllocateBitrates(allocatable_tracks_, last_stable_target_bps_,
+                     &allocation_cache_, &allocation_cache_.stable);
+  }
+}
+
 void BitrateAllocator::UpdateAllocationLimits() {
   BitrateAllocationLimits limits;
   for (const auto& config : allocatable_tracks_) {
@@ -536,6 +570,7 @@ void BitrateAllocator::RemoveObserver(BitrateAllocatorObserver* observer) {
        ++it) {
     if (it->observer == observer) {
       allocatable_tracks_.erase(it);
+      allocation_cache_.Invalidate();
       break;
     }
   }
@@ -93,6 +93,43 @@ struct AllocatableTrack {
   // enable-hysteresis if the observer is in a paused state.
   uint32_t MinBitrateWithHysteresis() const;
 };
+
+// The allocations of the last estimate, and storage reused between
+// estimates, so that a new estimate neither allocates memory nor sorts the
+// tracks again unless they changed.
+struct AllocationCache {
+  struct Allocation {
+    bool valid = false;
+    // Set if the allocation depends only on the bitrate and the configs of
+    // the tracks, and not on their previous allocations.
+    bool config_only = false;
+    uint32_t bitrate_bps = 0;
+    // Indexed like the tracks.
+    std::vector<int> bitrates;
+  };
+
+  // To be called when tracks are added, removed or reconfigured.
+  void Invalidate() {
+    tracks_valid = false;
+    target.valid = false;
+    stable.valid = false;
+  }
+
+  // Set if the members below describe the current tracks.
+  bool tracks_valid = false;
+  uint32_t sum_min_bitrates = 0;
+  uint32_t sum_max_bitrates = 0;
+  // Track indices sorted by max bitrate, ties in insertion order.
+  std::vector<size_t> by_max_bitrate;
+  // Track indices in the order of the last relative distribution. The order
+  // rarely changes between estimates.
+  std::vector<size_t> by_relative_capacity;
+  std::vector<int> capacities;
+  std::vector<size_t> evenly_distributed;
+
+  Allocation target;
+  Allocation stable;
+};
 }  // namespace bitrate_allocator_impl
 
 // Usage: this class will register multiple RtcpBitrateObserver's one at each
@@ -139,6 +176,9 @@ class BitrateAllocator : public BitrateAllocatorInterface {
  private:
   using AllocatableTrack = bitrate_allocator_impl::AllocatableTrack;
 
+  // Allocates the last target and stable target rates to the tracks.
+  void AllocateLastTargets() RTC_RUN_ON(&sequenced_checker_);
+
   // Calculates the minimum requested send bitrate and max padding bitrate and
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
@@ -164,6 +204,8 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   int num_pause_events_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_log_time_ RTC_GUARDED_BY(&sequenced_checker_);
   BitrateAllocationLimits current_limits_ RTC_GUARDED_BY(&sequenced_checker_);
+  bitrate_allocator_impl::AllocationCache allocation_cache_
+      RTC_GUARDED_BY(&sequenced_checker_);
 };
 
 }  // namespace webrtc
@@ -175,6 +175,48 @@ TEST_F(BitrateAllocatorTest, RespectsPriorityBitrate) {
   EXPECT_EQ(stream_b.last_bitrate_bps_, 300000u);
 }
 
+TEST_F(BitrateAllocatorTest, ReallocatesSameEstimateAfterReconfiguration) {
+  TestBitrateObserver stream_a;
+  auto config_a = DefaultConfig();
+  config_a.min_bitrate_bps = 100000;
+  config_a.max_bitrate_bps = 300000;
+  allocator_->AddObserver(&stream_a, config_a);
+
+  TestBitrateObserver stream_b;
+  auto config_b = DefaultConfig();
+  config_b.min_bitrate_bps = 100000;
+  config_b.max_bitrate_bps = 1000000;
+  allocator_->AddObserver(&stream_b, config_b);
+
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(600000, 0, 0, 0));
+  EXPECT_EQ(stream_a.last_bitrate_bps_, 300000u);
+  EXPECT_EQ(stream_b.last_bitrate_bps_, 300000u);
+
+  // Only the RTT changes, which gives the same allocation.
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(600000, 0, 50, 0));
+  EXPECT_EQ(stream_a.last_bitrate_bps_, 300000u);
+  EXPECT_EQ(stream_b.last_bitrate_bps_, 300000u);
+  EXPECT_EQ(stream_b.last_rtt_ms_, 50);
+
+  // The order in which the streams are capped changes.
+  config_a.max_bitrate_bps = 1000000;
+  allocator_->AddObserver(&stream_a, config_a);
+  config_b.max_bitrate_bps = 200000;
+  allocator_->AddObserver(&stream_b, config_b);
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(600000, 0, 50, 0));
+  EXPECT_EQ(stream_a.last_bitrate_bps_, 400000u);
+  EXPECT_EQ(stream_b.last_bitrate_bps_, 200000u);
+
+  allocator_->RemoveObserver(&stream_b);
+  allocator_->OnNetworkEstimateChanged(
+      CreateTargetRateMessage(600000, 0, 50, 0));
+  EXPECT_EQ(stream_a.last_bitrate_bps_, 600000u);
+  allocator_->RemoveObserver(&stream_a);
+}
+
 TEST_F(BitrateAllocatorTest, UpdatingBitrateObserver) {
   TestBitrateObserver bitrate_observer;
   const uint32_t kMinSendBitrateBps = 100000;
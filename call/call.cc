@@ -51,10 +51,12 @@
 #include "modules/utility/include/process_thread.h"
 #include "modules/video_coding/fec_controller_default.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/uint32_hash_map.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
@@ -257,6 +259,8 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverPacket(MediaType media_type,
                                rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) override;
+  size_t DeliverPackets(MediaType media_type,
+                        rtc::ArrayView<IncomingPacket> packets) override;
 
   // Implements RecoveredPacketReceiver.
   void OnRecoveredPacket(const uint8_t* packet, size_t length) override;
@@ -346,6 +350,11 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverRtp(MediaType media_type,
                             rtc::CopyOnWriteBuffer packet,
                             int64_t packet_time_us) RTC_RUN_ON(worker_thread_);
+  // Delivers a packet whose header extensions are identified.
+  DeliveryStatus DeliverIdentifiedRtp(MediaType media_type,
+                                      RtpPacketReceived& packet,
+                                      bool use_send_side_bwe)
+      RTC_RUN_ON(worker_thread_);
 
   AudioReceiveStream* FindAudioStreamForSyncGroup(const std::string& sync_group)
       RTC_RUN_ON(worker_thread_);
@@ -372,6 +381,9 @@ class Call final : public webrtc::Call,
   TaskQueueBase* const worker_thread_;
   TaskQueueBase* const network_thread_;
   const std::unique_ptr<DecodeSynchronizer> decode_sync_;
+  // Coalesces the receive side timers onto the metronome ticks, if there is a
+  // metronome.
+  const std::unique_ptr<MetronomeTaskScheduler> tick_scheduler_;
   RTC_NO_UNIQUE_ADDRESS SequenceChecker send_transport_sequence_checker_;
 
   const int num_cpu_cores_;
@@ -413,7 +425,7 @@ class Call final : public webrtc::Call,
 
   // TODO(bugs.webrtc.org/11993): Move receive_rtp_config_ over to the
   // network thread.
-  std::map<uint32_t, ReceiveStream*> receive_rtp_config_
+  Uint32HashMap<ReceiveStream*> receive_rtp_config_
       RTC_GUARDED_BY(&receive_11993_checker_);
 
   // Audio and Video send streams are owned by the client that creates them.
@@ -806,15 +818,24 @@ Call::Call(Clock* clock,
                                                               config.metronome,
                                                               worker_thread_)
                        : nullptr),
+      tick_scheduler_(config.metronome
+                          ? std::make_unique<MetronomeTaskScheduler>(
+                                clock_,
+                                config.metronome,
+                                worker_thread_)
+                          : nullptr),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
       module_process_thread_(std::move(module_process_thread)),
-      call_stats_(new CallStats(clock_, worker_thread_)),
+      call_stats_(
+          new CallStats(clock_, worker_thread_, tick_scheduler_.get())),
       bitrate_allocator_(new BitrateAllocator(this)),
       config_(config),
       trials_(*config.trials),
       audio_network_state_(kNetworkDown),
       video_network_state_(kNetworkDown),
       aggregate_network_up_(false),
+      nack_periodic_processor_(NackPeriodicProcessor::kUpdateInterval,
+                               tick_scheduler_.get()),
       event_log_(config.event_log),
       receive_stats_(clock_),
       send_stats_(clock_),
@@ -1154,7 +1175,8 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
       task_queue_factory_, this, num_cpu_cores_,
       transport_send_->packet_router(), std::move(configuration),
       call_stats_.get(), clock_, new VCMTiming(clock_),
-      &nack_periodic_processor_, decode_sync_.get());
+      &nack_periodic_processor_, decode_sync_.get(), tick_scheduler_.get(),
+      config_.decode_thread_pool);
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
   receive_stream->RegisterWithTransport(&video_receiver_controller_);
@@ -1575,6 +1597,18 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
     parsed_packet.set_arrival_time(clock_->CurrentTime());
   }
 
+  bool use_send_side_bwe = false;
+  if (!IdentifyReceivedPacket(parsed_packet, &use_send_side_bwe))
+    return DELIVERY_UNKNOWN_SSRC;
+
+  return DeliverIdentifiedRtp(media_type, parsed_packet, use_send_side_bwe);
+}
+
+// RTC_RUN_ON(worker_thread_)
+PacketReceiver::DeliveryStatus Call::DeliverIdentifiedRtp(
+    MediaType media_type,
+    RtpPacketReceived& parsed_packet,
+    bool use_send_side_bwe) {
   // We might get RTP keep-alive packets in accordance with RFC6263 section 4.6.
   // These are empty (zero length payload) RTP packets with an unsignaled
   // payload type.
@@ -1583,10 +1617,6 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   RTC_DCHECK(media_type == MediaType::AUDIO || media_type == MediaType::VIDEO ||
              is_keep_alive_packet);
 
-  bool use_send_side_bwe = false;
-  if (!IdentifyReceivedPacket(parsed_packet, &use_send_side_bwe))
-    return DELIVERY_UNKNOWN_SSRC;
-
   NotifyBweOfReceivedPacket(parsed_packet, media_type, use_send_side_bwe);
 
   // RateCounters expect input parameter as int, save it as int,
@@ -1627,6 +1657,70 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
   return DeliverRtp(media_type, std::move(packet), packet_time_us);
 }
 
+size_t Call::DeliverPackets(MediaType media_type,
+                            rtc::ArrayView<IncomingPacket> packets) {
+  TRACE_EVENT1("webrtc", "Call::DeliverPackets", "packets", packets.size());
+  // The packets of a batch were received at about the same time, so that the
+  // clocks are read once for all of them.
+  const Timestamp now = clock_->CurrentTime();
+  absl::optional<int64_t> system_time_us;
+  // Bursts usually consist of packets of the same SSRC, so that the receive
+  // configuration of the SSRC of the previous packet is kept.
+  absl::optional<uint32_t> cached_ssrc;
+  RtpHeaderExtensionMap cached_extensions;
+  bool cached_use_send_side_bwe = false;
+
+  size_t delivered = 0;
+  for (IncomingPacket& packet : packets) {
+    if (IsRtcpPacket(packet.packet)) {
+      RTC_DCHECK_RUN_ON(network_thread_);
+      DeliverRtcp(media_type, std::move(packet.packet));
+      ++delivered;
+      continue;
+    }
+
+    RTC_DCHECK_RUN_ON(worker_thread_);
+    RtpPacketReceived parsed_packet;
+    if (!parsed_packet.Parse(std::move(packet.packet)))
+      continue;
+
+    if (packet.packet_time_us != -1) {
+      int64_t packet_time_us = packet.packet_time_us;
+      if (receive_time_calculator_) {
+        if (!system_time_us)
+          system_time_us = rtc::TimeUTCMicros();
+        packet_time_us = receive_time_calculator_->ReconcileReceiveTimes(
+            packet_time_us, *system_time_us, now.us());
+      }
+      parsed_packet.set_arrival_time(Timestamp::Micros(packet_time_us));
+    } else {
+      parsed_packet.set_arrival_time(now);
+    }
+
+    if (parsed_packet.Ssrc() != cached_ssrc) {
+      RTC_DCHECK_RUN_ON(&receive_11993_checker_);
+      auto it = receive_rtp_config_.find(parsed_packet.Ssrc());
+      if (it == receive_rtp_config_.end()) {
+        RTC_DLOG(LS_WARNING) << "receive_rtp_config_ lookup failed for ssrc "
+                             << parsed_packet.Ssrc();
+        cached_ssrc = absl::nullopt;
+        continue;
+      }
+      cached_ssrc = parsed_packet.Ssrc();
+      cached_extensions =
+          RtpHeaderExtensionMap(it->second->rtp_config().extensions);
+      cached_use_send_side_bwe = UseSendSideBwe(it->second->rtp_config());
+    }
+    parsed_packet.IdentifyExtensions(cached_extensions);
+
+    if (DeliverIdentifiedRtp(media_type, parsed_packet,
+                             cached_use_send_side_bwe) == DELIVERY_OK) {
+      ++delivered;
+    }
+  }
+  return delivered;
+}
+
 void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
   // TODO(bugs.webrtc.org/11993): Expect to be called on the network thread.
   // This method is called synchronously via `OnRtpPacket()` (see DeliverRtp)
@@ -26,6 +26,7 @@
 namespace webrtc {
 
 class AudioProcessing;
+class DecodeThreadPool;
 class RtcEventLog;
 
 struct CallConfig {
@@ -78,6 +79,10 @@ struct CallConfig {
       rtp_transport_controller_send_factory = nullptr;
 
   Metronome* metronome = nullptr;
+
+  // If set, the decoding of all video receive streams runs on this pool's
+  // threads instead of on one thread per stream. Must outlive the call.
+  DecodeThreadPool* decode_thread_pool = nullptr;
 };
 
 }  // namespace webrtc
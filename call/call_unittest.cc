@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
@@ -31,6 +32,7 @@
 #include "modules/audio_device/include/mock_audio_device.h"
 #include "modules/audio_processing/include/mock_audio_processing.h"
 #include "modules/include/module.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "test/fake_encoder.h"
 #include "test/gtest.h"
@@ -349,6 +351,34 @@ TEST(CallTest, RecreatingAudioStreamWithSameSsrcReusesRtpState) {
   }
 }
 
+TEST(CallTest, DeliversBatchOfPackets) {
+  constexpr uint32_t kSsrc = 42;
+  constexpr uint32_t kUnknownSsrc = 43;
+  CallHelper call(/*use_null_audio_processing=*/true);
+  AudioReceiveStream::Config config;
+  MockTransport rtcp_send_transport;
+  config.rtp.remote_ssrc = kSsrc;
+  config.rtcp_send_transport = &rtcp_send_transport;
+  config.decoder_factory =
+      rtc::make_ref_counted<webrtc::MockAudioDecoderFactory>();
+  AudioReceiveStream* stream = call->CreateAudioReceiveStream(config);
+
+  auto make_packet = [](uint32_t ssrc, uint16_t sequence_number) {
+    RtpPacket packet;
+    packet.SetPayloadType(111);
+    packet.SetSsrc(ssrc);
+    packet.SetSequenceNumber(sequence_number);
+    packet.AllocatePayload(10);
+    return PacketReceiver::IncomingPacket{packet.Buffer(), -1};
+  };
+  std::vector<PacketReceiver::IncomingPacket> packets = {
+      make_packet(kSsrc, 1), make_packet(kSsrc, 2),
+      make_packet(kUnknownSsrc, 1), make_packet(kSsrc, 3)};
+  EXPECT_EQ(call->Receiver()->DeliverPackets(MediaType::AUDIO, packets), 3u);
+
+  call->DestroyAudioReceiveStream(stream);
+}
+
 TEST(CallTest, AddAdaptationResourceAfterCreatingVideoSendStream) {
   CallHelper call(true);
   // Create a VideoSendStream.
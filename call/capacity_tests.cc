@@ -0,0 +1,447 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/numerics/samples_stats_counter.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/test/create_frame_generator.h"
+#include "api/test/simulated_network.h"
+#include "api/test/video/function_video_decoder_factory.h"
+#include "api/test/video/function_video_encoder_factory.h"
+#include "api/transport/field_trial_based_config.h"
+#include "api/video/builtin_video_bitrate_allocator_factory.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "call/call.h"
+#include "call/fake_network_pipe.h"
+#include "call/simulated_network.h"
+#include "modules/audio_device/include/test_audio_device.h"
+#include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+#include "test/call_test.h"
+#include "test/direct_transport.h"
+#include "test/encoder_settings.h"
+#include "test/fake_decoder.h"
+#include "test/fake_encoder.h"
+#include "test/field_trial.h"
+#include "test/frame_generator_capturer.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kMaxStreams = 128;
+// The 95th percentile of the capture to render latency of video frames that
+// a number of streams must stay within.
+constexpr double kLatencySloMs = 150;
+constexpr int kWarmUpMs = 3000;
+constexpr int kMeasurementMs = 5000;
+constexpr int kTransportSequenceNumberExtensionId = 1;
+constexpr uint32_t kFirstVideoSsrc = 0x10000;
+constexpr uint32_t kFirstAudioSsrc = 0x20000;
+constexpr uint8_t kVideoPayloadType = test::CallTest::kFakeVideoSendPayloadType;
+constexpr uint8_t kAudioPayloadType = test::CallTest::kAudioSendPayloadType;
+
+// Groups the task queues by the thread they stand for. There is no separate
+// network thread with DirectTransport: received RTP has to be delivered on
+// the worker thread, and the pacer is what sends packets to the network.
+const char* ThreadOfTaskQueue(const std::string& name) {
+  static const std::map<std::string, const char*>* const kThreads =
+      new std::map<std::string, const char*>({
+          {"Worker", "worker"},
+          {"TaskQueuePacedSender", "network"},
+          {"EncoderQueue", "encoder"},
+          {"AudioEncoder", "encoder"},
+          {"DecodingQueue", "decoder"},
+          // Mixes and decodes the received audio, besides capturing.
+          {"TestAudioDeviceModuleImpl", "audio_device"},
+          {"FrameGenCapQ", "capturer"},
+      });
+  auto it = kThreads->find(name);
+  return it != kThreads->end() ? it->second : "other";
+}
+
+// Runs the tasks of another task queue, and adds the CPU time they take to
+// `cpu_time_ns`.
+class CpuMeasuringTaskQueue : public TaskQueueBase {
+ public:
+  CpuMeasuringTaskQueue(
+      std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue,
+      std::atomic<int64_t>* cpu_time_ns)
+      : task_queue_(std::move(task_queue)), cpu_time_ns_(cpu_time_ns) {}
+
+  void Delete() override {
+    // Returns once the tasks that are running are done.
+    task_queue_.reset();
+    delete this;
+  }
+
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    task_queue_->PostTask(Measure(std::move(task)));
+  }
+
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    task_queue_->PostDelayedTask(Measure(std::move(task)), milliseconds);
+  }
+
+  void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                    uint32_t milliseconds) override {
+    task_queue_->PostDelayedHighPrecisionTask(Measure(std::move(task)),
+                                              milliseconds);
+  }
+
+ private:
+  std::unique_ptr<QueuedTask> Measure(std::unique_ptr<QueuedTask> task) {
+    return ToQueuedTask([this, task = std::move(task)]() mutable {
+      // The code under test checks that it runs on this queue.
+      CurrentTaskQueueSetter set_current(this);
+      int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+      if (!task->Run()) {
+        // The task has taken ownership of itself, e.g. to post itself again.
+        task.release();
+      }
+      *cpu_time_ns_ += rtc::GetThreadCpuTimeNanos() - start_ns;
+    });
+  }
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+  std::atomic<int64_t>* const cpu_time_ns_;
+};
+
+class CpuMeasuringTaskQueueFactory : public TaskQueueFactory {
+ public:
+  CpuMeasuringTaskQueueFactory()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new CpuMeasuringTaskQueue(
+            task_queue_factory_->CreateTaskQueue(name, priority),
+            CpuTimeOfThread(ThreadOfTaskQueue(std::string(name)))));
+  }
+
+  // CPU time of the tasks run so far, by thread.
+  std::map<std::string, int64_t> CpuTimeNanos() const {
+    MutexLock lock(&mutex_);
+    std::map<std::string, int64_t> cpu_time_ns;
+    for (const auto& [thread, time_ns] : cpu_time_ns_)
+      cpu_time_ns[thread] = time_ns->load();
+    return cpu_time_ns;
+  }
+
+ private:
+  std::atomic<int64_t>* CpuTimeOfThread(const std::string& thread) const {
+    MutexLock lock(&mutex_);
+    std::unique_ptr<std::atomic<int64_t>>& time_ns = cpu_time_ns_[thread];
+    if (!time_ns)
+      time_ns = std::make_unique<std::atomic<int64_t>>(0);
+    return time_ns.get();
+  }
+
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  mutable Mutex mutex_;
+  // Entries are never removed, so that task queues can keep pointers to them.
+  mutable std::map<std::string, std::unique_ptr<std::atomic<int64_t>>>
+      cpu_time_ns_ RTC_GUARDED_BY(mutex_);
+};
+
+// Collects the capture to render latency of the frames of all video streams.
+// The capture time of a frame is estimated from RTCP sender reports, so
+// frames aren't counted until a stream has received a couple of them.
+class LatencyRenderer : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  explicit LatencyRenderer(Clock* clock) : clock_(clock) {}
+
+  void OnFrame(const VideoFrame& frame) override {
+    if (frame.ntp_time_ms() <= 0)
+      return;
+    int64_t now_ms = clock_->CurrentNtpInMilliseconds();
+    MutexLock lock(&mutex_);
+    latency_ms_.AddSample(now_ms - frame.ntp_time_ms());
+  }
+
+  SamplesStatsCounter TakeLatencies() {
+    MutexLock lock(&mutex_);
+    return std::exchange(latency_ms_, SamplesStatsCounter());
+  }
+
+ private:
+  Clock* const clock_;
+  Mutex mutex_;
+  SamplesStatsCounter latency_ms_ RTC_GUARDED_BY(mutex_);
+};
+
+// Sends audio and video streams with fake video codecs from one Call to
+// another, adding streams until the latency of video goes beyond
+// `kLatencySloMs`, and reports how much CPU each stream takes on each thread.
+class CallCapacityTest : public ::testing::Test {
+ protected:
+  CallCapacityTest()
+      : clock_(Clock::GetRealTimeClock()),
+        worker_queue_(task_queue_factory_.CreateTaskQueue(
+            "Worker",
+            TaskQueueFactory::Priority::NORMAL)),
+        renderer_(clock_),
+        encoder_factory_(
+            [this] { return std::make_unique<test::FakeEncoder>(clock_); }),
+        decoder_factory_([] { return std::make_unique<test::FakeDecoder>(); }),
+        bitrate_allocator_factory_(
+            CreateBuiltinVideoBitrateAllocatorFactory()) {
+    SendTask(RTC_FROM_HERE, worker_queue_.get(), [this] { CreateCalls(); });
+  }
+
+  ~CallCapacityTest() override {
+    SendTask(RTC_FROM_HERE, worker_queue_.get(), [this] {
+      for (Stream& stream : streams_) {
+        stream.capturer->Stop();
+        stream.audio_send->Stop();
+        sender_call_->DestroyVideoSendStream(stream.video_send);
+        sender_call_->DestroyAudioSendStream(stream.audio_send);
+        receiver_call_->DestroyVideoReceiveStream(stream.video_receive);
+        receiver_call_->DestroyAudioReceiveStream(stream.audio_receive);
+      }
+      streams_.clear();
+      sender_call_.reset();
+      receiver_call_.reset();
+      send_transport_.reset();
+      receive_transport_.reset();
+    });
+  }
+
+  void AddStreams(int num_streams) {
+    SendTask(RTC_FROM_HERE, worker_queue_.get(), [this, num_streams] {
+      while (static_cast<int>(streams_.size()) < num_streams)
+        AddStream();
+    });
+  }
+
+  LatencyRenderer& renderer() { return renderer_; }
+  const CpuMeasuringTaskQueueFactory& task_queue_factory() const {
+    return task_queue_factory_;
+  }
+
+ private:
+  struct Stream {
+    std::unique_ptr<test::FrameGeneratorCapturer> capturer;
+    VideoSendStream* video_send = nullptr;
+    VideoReceiveStream* video_receive = nullptr;
+    AudioSendStream* audio_send = nullptr;
+    AudioReceiveStream* audio_receive = nullptr;
+  };
+
+  std::unique_ptr<test::DirectTransport> CreateTransport(Call* call) {
+    return std::make_unique<test::DirectTransport>(
+        worker_queue_.get(),
+        std::make_unique<FakeNetworkPipe>(
+            clock_, std::make_unique<SimulatedNetwork>(
+                        BuiltInNetworkBehaviorConfig())),
+        call, test::CallTest::payload_type_map_);
+  }
+
+  void CreateCalls() {
+    audio_device_ = TestAudioDeviceModule::Create(
+        &task_queue_factory_,
+        TestAudioDeviceModule::CreatePulsedNoiseCapturer(256, 48000),
+        TestAudioDeviceModule::CreateDiscardRenderer(48000));
+    EXPECT_EQ(0, audio_device_->Init());
+    AudioState::Config audio_state_config;
+    audio_state_config.audio_mixer = AudioMixerImpl::Create();
+    audio_state_config.audio_processing = AudioProcessingBuilder().Create();
+    audio_state_config.audio_device_module = audio_device_;
+    rtc::scoped_refptr<AudioState> audio_state =
+        AudioState::Create(audio_state_config);
+    audio_device_->RegisterAudioCallback(audio_state->audio_transport());
+
+    Call::Config config(&event_log_);
+    config.trials = &field_trials_;
+    config.task_queue_factory = &task_queue_factory_;
+    config.audio_state = audio_state;
+    sender_call_.reset(Call::Create(config));
+    receiver_call_.reset(Call::Create(config));
+    send_transport_ = CreateTransport(sender_call_.get());
+    receive_transport_ = CreateTransport(receiver_call_.get());
+    send_transport_->SetReceiver(receiver_call_->Receiver());
+    receive_transport_->SetReceiver(sender_call_->Receiver());
+  }
+
+  void AddStream() {
+    const uint32_t video_ssrc = kFirstVideoSsrc + streams_.size();
+    const uint32_t audio_ssrc = kFirstAudioSsrc + streams_.size();
+    Stream stream;
+
+    VideoSendStream::Config video_send_config(send_transport_.get());
+    video_send_config.rtp.ssrcs.push_back(video_ssrc);
+    video_send_config.rtp.payload_name = "FAKE";
+    video_send_config.rtp.payload_type = kVideoPayloadType;
+    video_send_config.rtp.extensions.emplace_back(
+        RtpExtension::kTransportSequenceNumberUri,
+        kTransportSequenceNumberExtensionId);
+    video_send_config.encoder_settings.encoder_factory = &encoder_factory_;
+    video_send_config.encoder_settings.bitrate_allocator_factory =
+        bitrate_allocator_factory_.get();
+    VideoEncoderConfig encoder_config;
+    test::FillEncoderConfiguration(kVideoCodecGeneric, 1, &encoder_config);
+    stream.video_send = sender_call_->CreateVideoSendStream(
+        video_send_config.Copy(), encoder_config.Copy());
+
+    VideoReceiveStream::Config video_receive_config(receive_transport_.get());
+    video_receive_config.rtp.remote_ssrc = video_ssrc;
+    video_receive_config.rtp.local_ssrc =
+        test::CallTest::kReceiverLocalVideoSsrc;
+    video_receive_config.rtp.transport_cc = true;
+    video_receive_config.rtp.extensions = video_send_config.rtp.extensions;
+    // The receiver needs the RTT to estimate the capture time of frames.
+    video_receive_config.rtp.rtcp_xr.receiver_reference_time_report = true;
+    video_receive_config.renderer = &renderer_;
+    video_receive_config.decoder_factory = &decoder_factory_;
+    video_receive_config.decoders.push_back(
+        test::CreateMatchingDecoder(video_send_config));
+    stream.video_receive = receiver_call_->CreateVideoReceiveStream(
+        std::move(video_receive_config));
+
+    AudioSendStream::Config audio_send_config(send_transport_.get());
+    audio_send_config.rtp.ssrc = audio_ssrc;
+    audio_send_config.send_codec_spec = AudioSendStream::Config::SendCodecSpec(
+        kAudioPayloadType, {"opus", 48000, 2});
+    audio_send_config.encoder_factory = audio_encoder_factory_;
+    stream.audio_send = sender_call_->CreateAudioSendStream(audio_send_config);
+
+    AudioReceiveStream::Config audio_receive_config;
+    audio_receive_config.rtp.remote_ssrc = audio_ssrc;
+    audio_receive_config.rtp.local_ssrc =
+        test::CallTest::kReceiverLocalAudioSsrc;
+    audio_receive_config.rtcp_send_transport = receive_transport_.get();
+    audio_receive_config.decoder_factory = audio_decoder_factory_;
+    audio_receive_config.decoder_map = {
+        {kAudioPayloadType, {"opus", 48000, 2}}};
+    stream.audio_receive =
+        receiver_call_->CreateAudioReceiveStream(audio_receive_config);
+
+    stream.capturer = std::make_unique<test::FrameGeneratorCapturer>(
+        clock_,
+        test::CreateSquareFrameGenerator(test::CallTest::kDefaultWidth,
+                                         test::CallTest::kDefaultHeight,
+                                         absl::nullopt, absl::nullopt),
+        test::CallTest::kDefaultFramerate, task_queue_factory_);
+    stream.capturer->Init();
+    stream.video_send->SetSource(stream.capturer.get(),
+                                 DegradationPreference::MAINTAIN_FRAMERATE);
+
+    stream.video_receive->Start();
+    stream.audio_receive->Start();
+    stream.video_send->Start();
+    stream.audio_send->Start();
+    stream.capturer->Start();
+    streams_.push_back(std::move(stream));
+  }
+
+  Clock* const clock_;
+  CpuMeasuringTaskQueueFactory task_queue_factory_;
+  RtcEventLogNull event_log_;
+  FieldTrialBasedConfig field_trials_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> worker_queue_;
+  LatencyRenderer renderer_;
+  test::FunctionVideoEncoderFactory encoder_factory_;
+  test::FunctionVideoDecoderFactory decoder_factory_;
+  const std::unique_ptr<VideoBitrateAllocatorFactory>
+      bitrate_allocator_factory_;
+  const rtc::scoped_refptr<AudioEncoderFactory> audio_encoder_factory_ =
+      CreateBuiltinAudioEncoderFactory();
+  const rtc::scoped_refptr<AudioDecoderFactory> audio_decoder_factory_ =
+      CreateBuiltinAudioDecoderFactory();
+
+  rtc::scoped_refptr<TestAudioDeviceModule> audio_device_;
+  std::unique_ptr<Call> sender_call_;
+  std::unique_ptr<Call> receiver_call_;
+  std::unique_ptr<test::DirectTransport> send_transport_;
+  std::unique_ptr<test::DirectTransport> receive_transport_;
+  std::vector<Stream> streams_;
+};
+
+TEST_F(CallCapacityTest, StreamsPerCore) {
+  // In quick mode, only checks that the test runs.
+  const bool quick_perf_test = field_trial::IsEnabled("WebRTC-QuickPerfTest");
+  const int max_streams = quick_perf_test ? 2 : kMaxStreams;
+  const int measurement_ms = quick_perf_test ? 1000 : kMeasurementMs;
+
+  int max_streams_within_slo = 0;
+  for (int streams = 1; streams <= max_streams; streams *= 2) {
+    AddStreams(streams);
+    rtc::Thread::SleepMs(kWarmUpMs);
+
+    std::map<std::string, int64_t> start_ns =
+        task_queue_factory().CpuTimeNanos();
+    int64_t process_start_ns = rtc::GetProcessCpuTimeNanos();
+    renderer().TakeLatencies();
+    rtc::Thread::SleepMs(measurement_ms);
+    SamplesStatsCounter latency_ms = renderer().TakeLatencies();
+    int64_t process_ns = rtc::GetProcessCpuTimeNanos() - process_start_ns;
+    std::map<std::string, int64_t> end_ns = task_queue_factory().CpuTimeNanos();
+
+    // In percent of a core, per audio and video stream.
+    auto cpu_per_stream = [&](int64_t cpu_time_ns) {
+      return 100.0 * cpu_time_ns / (measurement_ms * 1000000.0) / streams;
+    };
+    const std::string modifier = "_" + std::to_string(streams) + "_streams";
+    int64_t measured_ns = 0;
+    for (const auto& [thread, time_ns] : end_ns) {
+      int64_t thread_ns = time_ns - start_ns[thread];
+      measured_ns += thread_ns;
+      test::PrintResult("cpu_per_stream_" + thread, modifier, "call_capacity",
+                        cpu_per_stream(thread_ns), "%", false);
+    }
+    // Threads that aren't task queues, such as the module process thread.
+    test::PrintResult("cpu_per_stream_unaccounted", modifier, "call_capacity",
+                      cpu_per_stream(process_ns - measured_ns), "%", false);
+    test::PrintResult("cpu_per_stream_total", modifier, "call_capacity",
+                      cpu_per_stream(process_ns), "%", false);
+
+    if (latency_ms.IsEmpty()) {
+      ADD_FAILURE() << "No video frames were rendered with " << streams
+                    << " streams.";
+      break;
+    }
+    double p95_latency_ms = latency_ms.GetPercentile(0.95);
+    test::PrintResult("latency_p95", modifier, "call_capacity", p95_latency_ms,
+                      "ms", false);
+    if (p95_latency_ms > kLatencySloMs)
+      break;
+    max_streams_within_slo = streams;
+  }
+  test::PrintResult("max_streams", "", "call_capacity", max_streams_within_slo,
+                    "count", true);
+}
+
+}  // namespace
+}  // namespace webrtc
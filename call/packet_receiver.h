@@ -10,6 +10,9 @@
 #ifndef CALL_PACKET_RECEIVER_H_
 #define CALL_PACKET_RECEIVER_H_
 
+#include <utility>
+
+#include "api/array_view.h"
 #include "api/media_types.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -23,10 +26,31 @@ class PacketReceiver {
     DELIVERY_PACKET_ERROR,
   };
 
+  struct IncomingPacket {
+    rtc::CopyOnWriteBuffer packet;
+    int64_t packet_time_us = -1;
+  };
+
   virtual DeliveryStatus DeliverPacket(MediaType media_type,
                                        rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) = 0;
 
+  // Delivers, in order, packets that were received together, e.g. by one
+  // batched socket read. The packet buffers are moved from. Returns the number
+  // of packets delivered with DELIVERY_OK. The default implementation calls
+  // DeliverPacket() for each of them.
+  virtual size_t DeliverPackets(MediaType media_type,
+                                rtc::ArrayView<IncomingPacket> packets) {
+    size_t delivered = 0;
+    for (IncomingPacket& packet : packets) {
+      if (DeliverPacket(media_type, std::move(packet.packet),
+                        packet.packet_time_us) == DELIVERY_OK) {
+        ++delivered;
+      }
+    }
+    return delivered;
+  }
+
  protected:
   virtual ~PacketReceiver() {}
 };
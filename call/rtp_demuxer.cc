@@ -158,6 +158,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  resolved_sink_by_ssrc_.clear();
 
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
@@ -252,6 +253,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  resolved_sink_by_ssrc_.clear();
   return num_removed > 0;
 }
 
@@ -266,6 +268,34 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  const uint32_t ssrc = packet.Ssrc();
+  const bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                       packet.HasExtension<RtpStreamId>() ||
+                       packet.HasExtension<RepairedRtpStreamId>();
+  if (!has_ids) {
+    const auto it = resolved_sink_by_ssrc_.find(ssrc);
+    if (it != resolved_sink_by_ssrc_.end()) {
+      return it->second;
+    }
+  }
+
+  RtpPacketSinkInterface* sink = ResolveSinkUncached(packet);
+  if (has_ids) {
+    // The latched IDs of the SSRC may have changed.
+    resolved_sink_by_ssrc_.erase(ssrc);
+  } else if (sink != nullptr) {
+    // The sink is bound to the SSRC now, unless the limit of bindings has been
+    // reached, in which case the algorithm may take another turn next time.
+    const auto it = sink_by_ssrc_.find(ssrc);
+    if (it != sink_by_ssrc_.end() && it->second == sink) {
+      resolved_sink_by_ssrc_.emplace(ssrc, sink);
+    }
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkUncached(
+    const RtpPacketReceived& packet) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
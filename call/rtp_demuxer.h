@@ -164,7 +164,10 @@ class RtpDemuxer {
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
+  // Packets without MID or RSID header extensions are demuxed by an SSRC
+  // lookup alone, once a packet of their SSRC went through the algorithm.
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  RtpPacketSinkInterface* ResolveSinkUncached(const RtpPacketReceived& packet);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(const std::string& mid,
@@ -207,6 +210,13 @@ class RtpDemuxer {
   flat_map<uint32_t, std::string> mid_by_ssrc_;
   flat_map<uint32_t, std::string> rsid_by_ssrc_;
 
+  // The sinks resolved for packets without MID or RSID header extensions, by
+  // SSRC. The algorithm resolves such packets to the same sink as long as the
+  // sinks and the latched IDs of the SSRC do not change, so the entry of an
+  // SSRC is dropped when a packet with IDs is received, and all entries are
+  // dropped when sinks are added or removed.
+  flat_map<uint32_t, RtpPacketSinkInterface*> resolved_sink_by_ssrc_;
+
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
@@ -611,6 +611,51 @@ TEST_F(RtpDemuxerTest, NoCallbackOnMidRsidSinkRemovedAfterFirstPacket) {
 // The RSID to SSRC mapping should be one-to-one. If we end up receiving
 // two (or more) packets with the same SSRC, but different RSIDs, we guarantee
 // delivery to one of them but not both.
+
+TEST_F(RtpDemuxerTest, PacketsWithOnlySsrcFollowChangedMidSink) {
+  const std::string mid = "v";
+  constexpr uint32_t ssrc = 10;
+
+  NiceMock<MockRtpPacketSink> old_sink;
+  AddSinkOnlyMid(mid, &old_sink);
+  auto packet_with_mid = CreatePacketWithSsrcMid(ssrc, mid);
+  demuxer_.OnRtpPacket(*packet_with_mid);
+  auto packet_ssrc_only = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(old_sink, OnRtpPacket(SamePacketAs(*packet_ssrc_only)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_ssrc_only));
+
+  // The SSRC stays latched to the MID, whose sink is replaced.
+  RemoveSink(&old_sink);
+  MockRtpPacketSink new_sink;
+  AddSinkOnlyMid(mid, &new_sink);
+  packet_ssrc_only = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(old_sink, OnRtpPacket(_)).Times(0);
+  EXPECT_CALL(new_sink, OnRtpPacket(SamePacketAs(*packet_ssrc_only)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_ssrc_only));
+}
+
+TEST_F(RtpDemuxerTest, PacketsWithOnlySsrcFollowRelatchedMid) {
+  const std::string mid1 = "v1";
+  const std::string mid2 = "v2";
+  constexpr uint32_t ssrc = 10;
+
+  NiceMock<MockRtpPacketSink> sink1;
+  AddSinkOnlyMid(mid1, &sink1);
+  MockRtpPacketSink sink2;
+  AddSinkOnlyMid(mid2, &sink2);
+
+  auto packet_with_mid1 = CreatePacketWithSsrcMid(ssrc, mid1);
+  demuxer_.OnRtpPacket(*packet_with_mid1);
+  auto packet_ssrc_only = CreatePacketWithSsrc(ssrc);
+  demuxer_.OnRtpPacket(*packet_ssrc_only);
+
+  auto packet_with_mid2 = CreatePacketWithSsrcMid(ssrc, mid2);
+  packet_ssrc_only = CreatePacketWithSsrc(ssrc);
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*packet_with_mid2)));
+  EXPECT_CALL(sink2, OnRtpPacket(SamePacketAs(*packet_ssrc_only)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_with_mid2));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_ssrc_only));
+}
 TEST_F(RtpDemuxerTest, FirstSsrcAssociatedWithAnRsidIsNotForgotten) {
   // Each sink has a distinct RSID.
   MockRtpPacketSink sink_a;
@@ -79,9 +79,11 @@ RtpTransportControllerSend::PacerSettings::PacerSettings(
     const WebRtcKeyValueConfig* trials)
     : tq_disabled("Disabled"),
       holdback_window("holdback_window", PacingController::kMinSleepTime),
-      holdback_packets("holdback_packets", -1) {
-  ParseFieldTrial({&tq_disabled, &holdback_window, &holdback_packets},
-                  trials->Lookup("WebRTC-TaskQueuePacer"));
+      holdback_packets("holdback_packets", -1),
+      burst_interval("burst_interval", TimeDelta::Zero()) {
+  ParseFieldTrial(
+      {&tq_disabled, &holdback_window, &holdback_packets, &burst_interval},
+      trials->Lookup("WebRTC-TaskQueuePacer"));
 }
 
 RtpTransportControllerSend::RtpTransportControllerSend(
@@ -114,7 +116,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
                                          trials,
                                          task_queue_factory,
                                          pacer_settings_.holdback_window.Get(),
-                                         pacer_settings_.holdback_packets.Get())
+                                         pacer_settings_.holdback_packets.Get(),
+                                         pacer_settings_.burst_interval.Get())
               : nullptr),
       observer_(nullptr),
       controller_factory_override_(controller_factory),
@@ -139,6 +139,7 @@ class RtpTransportControllerSend final
     FieldTrialFlag tq_disabled;  // Kill-switch not normally used.
     FieldTrialParameter<TimeDelta> holdback_window;
     FieldTrialParameter<int> holdback_packets;
+    FieldTrialParameter<TimeDelta> burst_interval;
   };
 
   void MaybeCreateControllers() RTC_RUN_ON(task_queue_);
@@ -58,6 +58,7 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "key: " << frame_counts.key_frames << ", ";
   ss << "delta: " << frame_counts.delta_frames << ", ";
   ss << "frames_dropped: " << frames_dropped << ", ";
+  ss << "frames_skipped_late: " << frames_skipped_late << ", ";
   ss << "network_fps: " << network_frame_rate << ", ";
   ss << "decode_fps: " << decode_frame_rate << ", ";
   ss << "render_fps: " << render_frame_rate << ", ";
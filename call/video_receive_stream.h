@@ -36,6 +36,8 @@
 
 namespace webrtc {
 
+class KeyFrameRequestAggregator;
+class RtcpTransceiver;
 class RtpPacketSinkInterface;
 class VideoDecoderFactory;
 
@@ -103,6 +105,9 @@ class VideoReceiveStream : public MediaReceiveStream {
     // Frames dropped due to decoding failures or if the system is too slow.
     // https://www.w3.org/TR/webrtc-stats/#dom-rtcvideoreceiverstats-framesdropped
     uint32_t frames_dropped = 0;
+    // Discardable frames that were not decoded because they would have been
+    // rendered late. Included in `frames_dropped`.
+    uint32_t frames_skipped_late = 0;
     uint32_t frames_decoded = 0;
     // https://w3c.github.io/webrtc-stats/#dom-rtcinboundrtpstreamstats-totaldecodetime
     uint64_t total_decode_time_ms = 0;
@@ -143,6 +148,9 @@ class VideoReceiveStream : public MediaReceiveStream {
     // Timing frame info: all important timestamps for a full lifetime of a
     // single 'timing frame'.
     absl::optional<webrtc::TimingFrameInfo> timing_frame_info;
+    // Percentiles of the delay of each pipeline stage of all timing frames,
+    // see TimingFrameStageDelays.
+    std::map<std::string, double> timing_frame_stage_delays_ms;
   };
 
   struct Config {
@@ -195,6 +203,19 @@ class VideoReceiveStream : public MediaReceiveStream {
       // disabled.
       KeyFrameReqMethod keyframe_method = KeyFrameReqMethod::kPliRtcp;
 
+      // Optional, may be shared between receive streams. If set, key frame
+      // requests for the remote SSRC are dropped while an earlier request is
+      // outstanding, e.g. in an SFU where every receiver of a broken stream
+      // would otherwise request a key frame.
+      KeyFrameRequestAggregator* keyframe_request_aggregator = nullptr;
+
+      // Optional, shared between the receive streams of a transport, e.g. on
+      // a server receiving many streams. If set, it sends the RTCP reports
+      // and feedback for this stream together with those of the other
+      // streams, instead of an RTCP module per stream. Its owner registers it
+      // with the PacketRouter and sets its network state.
+      RtcpTransceiver* rtcp_transceiver = nullptr;
+
       // See LntfConfig for description.
       LntfConfig lntf;
 
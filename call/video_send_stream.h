@@ -91,6 +91,10 @@ class VideoSendStream {
     uint64_t total_encode_time_ms = 0;
     uint64_t total_encoded_bytes_target = 0;
     uint32_t huge_frames_sent = 0;
+    // Speed setting of an encoder that adapts it to the encode time, and the
+    // number of times it has changed.
+    absl::optional<int> encoder_speed;
+    uint32_t encoder_speed_changes = 0;
   };
 
   struct Stats {
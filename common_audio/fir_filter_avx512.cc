@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/fir_filter_avx512.h"
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+namespace webrtc {
+
+FIRFilterAVX512::FIRFilterAVX512(const float* unaligned_coefficients,
+                                 size_t unaligned_coefficients_length,
+                                 size_t max_input_length)
+    :  // Closest higher multiple of sixteen.
+      coefficients_length_((unaligned_coefficients_length + 15) & ~0x0F),
+      state_length_(coefficients_length_ - 1),
+      coefficients_(static_cast<float*>(
+          AlignedMalloc(sizeof(float) * coefficients_length_, 64))),
+      state_(static_cast<float*>(
+          AlignedMalloc(sizeof(float) * (max_input_length + state_length_),
+                        64))) {
+  // Add zeros at the end of the coefficients.
+  RTC_DCHECK_GE(coefficients_length_, unaligned_coefficients_length);
+  size_t padding = coefficients_length_ - unaligned_coefficients_length;
+  memset(coefficients_.get(), 0, padding * sizeof(coefficients_[0]));
+  // The coefficients are reversed to compensate for the order in which the
+  // input samples are acquired (most recent last).
+  for (size_t i = 0; i < unaligned_coefficients_length; ++i) {
+    coefficients_[i + padding] =
+        unaligned_coefficients[unaligned_coefficients_length - i - 1];
+  }
+  memset(state_.get(), 0,
+         (max_input_length + state_length_) * sizeof(state_[0]));
+}
+
+FIRFilterAVX512::~FIRFilterAVX512() = default;
+
+void FIRFilterAVX512::Filter(const float* in, size_t length, float* out) {
+  RTC_DCHECK_GT(length, 0);
+
+  memcpy(&state_[state_length_], in, length * sizeof(*in));
+
+  // Convolves the input signal `in` with the filter kernel `coefficients_`
+  // taking into account the previous state.
+  for (size_t i = 0; i < length; ++i) {
+    float* in_ptr = &state_[i];
+    float* coef_ptr = coefficients_.get();
+
+    __m512 m_sum = _mm512_setzero_ps();
+    __m512 m_in;
+
+    // Depending on if the pointer is aligned with 64 bytes or not it is loaded
+    // differently.
+    if (reinterpret_cast<uintptr_t>(in_ptr) & 0x3F) {
+      for (size_t j = 0; j < coefficients_length_; j += 16) {
+        m_in = _mm512_loadu_ps(in_ptr + j);
+        m_sum = _mm512_fmadd_ps(m_in, _mm512_load_ps(coef_ptr + j), m_sum);
+      }
+    } else {
+      for (size_t j = 0; j < coefficients_length_; j += 16) {
+        m_in = _mm512_load_ps(in_ptr + j);
+        m_sum = _mm512_fmadd_ps(m_in, _mm512_load_ps(coef_ptr + j), m_sum);
+      }
+    }
+    out[i] = _mm512_reduce_add_ps(m_sum);
+  }
+
+  // Update current state.
+  memmove(state_.get(), &state_[length], state_length_ * sizeof(state_[0]));
+}
+
+}  // namespace webrtc
@@ -18,6 +18,7 @@
 #include "common_audio/fir_filter_neon.h"
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
 #include "common_audio/fir_filter_avx2.h"
+#include "common_audio/fir_filter_avx512.h"
 #include "common_audio/fir_filter_sse.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
 #endif
@@ -36,7 +37,10 @@ FIRFilter* CreateFirFilter(const float* coefficients,
 // If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
   // x86 CPU detection required.
-  if (GetCPUInfo(kAVX2)) {
+  if (GetCPUInfo(kAVX512)) {
+    filter = new FIRFilterAVX512(coefficients, coefficients_length,
+                                 max_input_length);
+  } else if (GetCPUInfo(kAVX2)) {
     filter =
         new FIRFilterAVX2(coefficients, coefficients_length, max_input_length);
   } else if (GetCPUInfo(kSSE2)) {
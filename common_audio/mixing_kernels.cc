@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/mixing_kernels.h"
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/numerics/safe_minmax.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+void AccumulateS16ToFloat(const int16_t* src,
+                          size_t src_stride,
+                          size_t size,
+                          float* dst) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i] += src[i * src_stride];
+  }
+}
+
+void FloatS16ToS16WithStride(const float* src,
+                             size_t size,
+                             size_t dst_stride,
+                             int16_t* dst) {
+  for (size_t i = 0; i < size; ++i) {
+    dst[i * dst_stride] = FloatS16ToS16(src[i]);
+  }
+}
+
+void ApplyGainsAndClamp(const float* gains,
+                        float min_value,
+                        float max_value,
+                        size_t size,
+                        float* x) {
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = rtc::SafeClamp(x[i] * gains[i], min_value, max_value);
+  }
+}
+
+void AddS16WithSaturation(const int16_t* src, size_t size, int16_t* dst) {
+  for (size_t i = 0; i < size; ++i) {
+    const int32_t wrap_guard =
+        static_cast<int32_t>(dst[i]) + static_cast<int32_t>(src[i]);
+    dst[i] = rtc::saturated_cast<int16_t>(wrap_guard);
+  }
+}
+
+void ScaleS16WithSaturation(float scale, size_t size, int16_t* x) {
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = rtc::saturated_cast<int16_t>(scale * x[i]);
+  }
+}
+
+void UpmixMonoToStereo(size_t samples_per_channel, int16_t* x) {
+  // Going backwards through the frame ensures nothing is irrevocably
+  // overwritten.
+  for (size_t i = samples_per_channel; i > 0; --i) {
+    x[2 * i - 2] = x[i - 1];
+    x[2 * i - 1] = x[i - 1];
+  }
+}
+
+void DownmixStereoToMono(const int16_t* src,
+                         size_t samples_per_channel,
+                         int16_t* dst) {
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    const int32_t sum =
+        static_cast<int32_t>(src[2 * i]) + static_cast<int32_t>(src[2 * i + 1]);
+    dst[i] = sum / 2;
+  }
+}
+
+const MixingKernels& SelectMixingKernels() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required.
+  if (GetCPUInfo(kAVX2)) {
+    return kMixingKernelsAVX2;
+  }
+  return kMixingKernelsC;
+#elif defined(WEBRTC_HAS_NEON)
+  return kMixingKernelsNEON;
+#else
+  return kMixingKernelsC;
+#endif
+}
+
+}  // namespace
+
+const MixingKernels kMixingKernelsC = {
+    AccumulateS16ToFloat, FloatS16ToS16WithStride, ApplyGainsAndClamp,
+    AddS16WithSaturation, ScaleS16WithSaturation,  UpmixMonoToStereo,
+    DownmixStereoToMono};
+
+const MixingKernels& GetMixingKernels() {
+  static const MixingKernels& kernels = SelectMixingKernels();
+  return kernels;
+}
+
+}  // namespace webrtc
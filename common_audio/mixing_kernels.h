@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_MIXING_KERNELS_H_
+#define COMMON_AUDIO_MIXING_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// The inner loops of audio mixing, channel remixing and gain application on
+// interleaved int16 frames and on deinterleaved FloatS16 channels. All
+// implementations produce bit-exact the same output as the C implementation.
+// Buffers may have any alignment. Strided access is limited to the elements
+// it addresses, so other channels of an interleaved buffer are not touched.
+struct MixingKernels {
+  // dst[i] += src[i * src_stride], for i in [0, size).
+  void (*accumulate_s16_to_float)(const int16_t* src,
+                                  size_t src_stride,
+                                  size_t size,
+                                  float* dst);
+
+  // dst[i * dst_stride] = FloatS16ToS16(src[i]), for i in [0, size).
+  void (*float_s16_to_s16)(const float* src,
+                           size_t size,
+                           size_t dst_stride,
+                           int16_t* dst);
+
+  // x[i] = SafeClamp(x[i] * gains[i], min_value, max_value).
+  void (*apply_gains_and_clamp)(const float* gains,
+                                float min_value,
+                                float max_value,
+                                size_t size,
+                                float* x);
+
+  // dst[i] = saturated_cast<int16_t>(dst[i] + src[i]).
+  void (*add_s16_with_saturation)(const int16_t* src,
+                                  size_t size,
+                                  int16_t* dst);
+
+  // x[i] = saturated_cast<int16_t>(scale * x[i]).
+  void (*scale_s16_with_saturation)(float scale, size_t size, int16_t* x);
+
+  // In place: copies the `samples_per_channel` mono samples at the start of
+  // `x` to both channels of an interleaved stereo frame.
+  void (*upmix_mono_to_stereo)(size_t samples_per_channel, int16_t* x);
+
+  // dst[i] = (src[2 * i] + src[2 * i + 1]) / 2, rounded towards zero as
+  // DownmixInterleavedToMono() does. `dst` may be equal to `src`.
+  void (*downmix_stereo_to_mono)(const int16_t* src,
+                                 size_t samples_per_channel,
+                                 int16_t* dst);
+};
+
+// Returns the implementation for the widest SIMD instruction set that the CPU
+// supports, picked on first use.
+const MixingKernels& GetMixingKernels();
+
+// Individual implementations, exposed for testing.
+extern const MixingKernels kMixingKernelsC;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+extern const MixingKernels kMixingKernelsAVX2;
+#elif defined(WEBRTC_HAS_NEON)
+extern const MixingKernels kMixingKernelsNEON;
+#endif
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_MIXING_KERNELS_H_
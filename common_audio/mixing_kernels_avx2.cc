@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/mixing_kernels.h"
+
+namespace webrtc {
+namespace {
+
+// Sign-extends the int16 values in the low halves of the int32 lanes, i.e. the
+// even int16 elements, to int32.
+__m256i EvenS16ToS32(__m256i x) {
+  return _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+}
+
+// Clamps to the int16 range and rounds half away from zero, like
+// FloatS16ToS16().
+__m256i FloatS16ToS32(__m256 x) {
+  x = _mm256_min_ps(x, _mm256_set1_ps(32767.f));
+  x = _mm256_max_ps(x, _mm256_set1_ps(-32768.f));
+  const __m256 half_with_sign = _mm256_or_ps(
+      _mm256_and_ps(x, _mm256_set1_ps(-0.f)), _mm256_set1_ps(0.5f));
+  return _mm256_cvttps_epi32(_mm256_add_ps(x, half_with_sign));
+}
+
+// Packs two vectors of int32 lanes to one vector of int16, keeping the order.
+__m256i PackS32ToS16(__m256i a, __m256i b) {
+  return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+}
+
+__m256i LoadS16(const int16_t* src) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+
+void StoreS16(__m256i x, int16_t* dst) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), x);
+}
+
+void AccumulateS16ToFloat(const int16_t* src,
+                          size_t src_stride,
+                          size_t size,
+                          float* dst) {
+  size_t i = 0;
+  if (src_stride == 1) {
+    for (; i + 8 <= size; i += 8) {
+      const __m128i s =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      const __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s));
+      _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), f));
+    }
+  } else if (src_stride == 2) {
+    // Each load covers the other channel too, and must not read past the last
+    // addressed element.
+    for (; i + 8 < size; i += 8) {
+      const __m256 f = _mm256_cvtepi32_ps(EvenS16ToS32(LoadS16(src + 2 * i)));
+      _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), f));
+    }
+  }
+  kMixingKernelsC.accumulate_s16_to_float(src + i * src_stride, src_stride,
+                                          size - i, dst + i);
+}
+
+void FloatS16ToS16WithStride(const float* src,
+                             size_t size,
+                             size_t dst_stride,
+                             int16_t* dst) {
+  size_t i = 0;
+  if (dst_stride == 1) {
+    for (; i + 16 <= size; i += 16) {
+      StoreS16(PackS32ToS16(FloatS16ToS32(_mm256_loadu_ps(src + i)),
+                            FloatS16ToS32(_mm256_loadu_ps(src + i + 8))),
+               dst + i);
+    }
+  } else if (dst_stride == 2) {
+    // Write the even elements back together with the untouched odd ones.
+    for (; i + 8 < size; i += 8) {
+      const __m256i s = FloatS16ToS32(_mm256_loadu_ps(src + i));
+      StoreS16(_mm256_blend_epi16(LoadS16(dst + 2 * i), s, 0x55), dst + 2 * i);
+    }
+  }
+  kMixingKernelsC.float_s16_to_s16(src + i, size - i, dst_stride,
+                                   dst + i * dst_stride);
+}
+
+void ApplyGainsAndClamp(const float* gains,
+                        float min_value,
+                        float max_value,
+                        size_t size,
+                        float* x) {
+  const __m256 min_values = _mm256_set1_ps(min_value);
+  const __m256 max_values = _mm256_set1_ps(max_value);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256 v =
+        _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(gains + i));
+    v = _mm256_min_ps(_mm256_max_ps(v, min_values), max_values);
+    _mm256_storeu_ps(x + i, v);
+  }
+  kMixingKernelsC.apply_gains_and_clamp(gains + i, min_value, max_value,
+                                        size - i, x + i);
+}
+
+void AddS16WithSaturation(const int16_t* src, size_t size, int16_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    StoreS16(_mm256_adds_epi16(LoadS16(dst + i), LoadS16(src + i)), dst + i);
+  }
+  kMixingKernelsC.add_s16_with_saturation(src + i, size - i, dst + i);
+}
+
+void ScaleS16WithSaturation(float scale, size_t size, int16_t* x) {
+  const __m256 scales = _mm256_set1_ps(scale);
+  const __m256 min_values = _mm256_set1_ps(-32768.f);
+  const __m256 max_values = _mm256_set1_ps(32767.f);
+  auto scale_s32 = [&](__m128i s) {
+    __m256 f =
+        _mm256_mul_ps(scales, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s)));
+    f = _mm256_min_ps(_mm256_max_ps(f, min_values), max_values);
+    return _mm256_cvttps_epi32(f);
+  };
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256i s = LoadS16(x + i);
+    StoreS16(PackS32ToS16(scale_s32(_mm256_castsi256_si128(s)),
+                          scale_s32(_mm256_extracti128_si256(s, 1))),
+             x + i);
+  }
+  kMixingKernelsC.scale_s16_with_saturation(scale, size - i, x + i);
+}
+
+void UpmixMonoToStereo(size_t samples_per_channel, int16_t* x) {
+  // Going backwards, each block is written beyond the samples not yet read.
+  size_t n = samples_per_channel;
+  for (; n >= 16; n -= 16) {
+    const __m256i s = LoadS16(x + n - 16);
+    const __m256i lo = _mm256_unpacklo_epi16(s, s);
+    const __m256i hi = _mm256_unpackhi_epi16(s, s);
+    StoreS16(_mm256_permute2x128_si256(lo, hi, 0x20), x + 2 * n - 32);
+    StoreS16(_mm256_permute2x128_si256(lo, hi, 0x31), x + 2 * n - 16);
+  }
+  kMixingKernelsC.upmix_mono_to_stereo(n, x);
+}
+
+void DownmixStereoToMono(const int16_t* src,
+                         size_t samples_per_channel,
+                         int16_t* dst) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  // Sums the channels and divides by two, rounding towards zero.
+  auto average_s32 = [&](__m256i s) {
+    const __m256i sum = _mm256_madd_epi16(s, ones);
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_srli_epi32(sum, 31)),
+                             1);
+  };
+  size_t i = 0;
+  for (; i + 16 <= samples_per_channel; i += 16) {
+    // Both loads precede the store, which keeps this correct in place.
+    const __m256i a = LoadS16(src + 2 * i);
+    const __m256i b = LoadS16(src + 2 * i + 16);
+    StoreS16(PackS32ToS16(average_s32(a), average_s32(b)), dst + i);
+  }
+  kMixingKernelsC.downmix_stereo_to_mono(src + 2 * i, samples_per_channel - i,
+                                         dst + i);
+}
+
+}  // namespace
+
+const MixingKernels kMixingKernelsAVX2 = {
+    AccumulateS16ToFloat, FloatS16ToS16WithStride, ApplyGainsAndClamp,
+    AddS16WithSaturation, ScaleS16WithSaturation,  UpmixMonoToStereo,
+    DownmixStereoToMono};
+
+}  // namespace webrtc
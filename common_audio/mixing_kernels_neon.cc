@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/mixing_kernels.h"
+
+namespace webrtc {
+namespace {
+
+// Clamps to the int16 range and rounds half away from zero, like
+// FloatS16ToS16().
+int32x4_t FloatS16ToS32(float32x4_t x) {
+  x = vminq_f32(x, vdupq_n_f32(32767.f));
+  x = vmaxq_f32(x, vdupq_n_f32(-32768.f));
+  const uint32x4_t half_with_sign =
+      vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000)),
+                vreinterpretq_u32_f32(vdupq_n_f32(0.5f)));
+  return vcvtq_s32_f32(vaddq_f32(x, vreinterpretq_f32_u32(half_with_sign)));
+}
+
+int16x8_t FloatS16ToS16x8(const float* src) {
+  return vcombine_s16(vqmovn_s32(FloatS16ToS32(vld1q_f32(src))),
+                      vqmovn_s32(FloatS16ToS32(vld1q_f32(src + 4))));
+}
+
+void AccumulateS16ToFloat(const int16_t* src,
+                          size_t src_stride,
+                          size_t size,
+                          float* dst) {
+  size_t i = 0;
+  if (src_stride == 1 || src_stride == 2) {
+    // With a stride of two, each load covers the other channel too, and must
+    // not read past the last addressed element.
+    for (; i + 8 + (src_stride - 1) <= size; i += 8) {
+      const int16x8_t s = src_stride == 1 ? vld1q_s16(src + i)
+                                          : vld2q_s16(src + 2 * i).val[0];
+      vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i),
+                                   vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)))));
+      vst1q_f32(dst + i + 4,
+                vaddq_f32(vld1q_f32(dst + i + 4),
+                          vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)))));
+    }
+  }
+  kMixingKernelsC.accumulate_s16_to_float(src + i * src_stride, src_stride,
+                                          size - i, dst + i);
+}
+
+void FloatS16ToS16WithStride(const float* src,
+                             size_t size,
+                             size_t dst_stride,
+                             int16_t* dst) {
+  size_t i = 0;
+  if (dst_stride == 1) {
+    for (; i + 8 <= size; i += 8) {
+      vst1q_s16(dst + i, FloatS16ToS16x8(src + i));
+    }
+  } else if (dst_stride == 2) {
+    // Write the even elements back together with the untouched odd ones.
+    for (; i + 8 < size; i += 8) {
+      int16x8x2_t d = vld2q_s16(dst + 2 * i);
+      d.val[0] = FloatS16ToS16x8(src + i);
+      vst2q_s16(dst + 2 * i, d);
+    }
+  }
+  kMixingKernelsC.float_s16_to_s16(src + i, size - i, dst_stride,
+                                   dst + i * dst_stride);
+}
+
+void ApplyGainsAndClamp(const float* gains,
+                        float min_value,
+                        float max_value,
+                        size_t size,
+                        float* x) {
+  const float32x4_t min_values = vdupq_n_f32(min_value);
+  const float32x4_t max_values = vdupq_n_f32(max_value);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t v = vmulq_f32(vld1q_f32(x + i), vld1q_f32(gains + i));
+    v = vminq_f32(vmaxq_f32(v, min_values), max_values);
+    vst1q_f32(x + i, v);
+  }
+  kMixingKernelsC.apply_gains_and_clamp(gains + i, min_value, max_value,
+                                        size - i, x + i);
+}
+
+void AddS16WithSaturation(const int16_t* src, size_t size, int16_t* dst) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), vld1q_s16(src + i)));
+  }
+  kMixingKernelsC.add_s16_with_saturation(src + i, size - i, dst + i);
+}
+
+void ScaleS16WithSaturation(float scale, size_t size, int16_t* x) {
+  const float32x4_t min_values = vdupq_n_f32(-32768.f);
+  const float32x4_t max_values = vdupq_n_f32(32767.f);
+  auto scale_s32 = [&](int16x4_t s) {
+    float32x4_t f = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(s)), scale);
+    f = vminq_f32(vmaxq_f32(f, min_values), max_values);
+    return vcvtq_s32_f32(f);
+  };
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t s = vld1q_s16(x + i);
+    vst1q_s16(x + i, vcombine_s16(vqmovn_s32(scale_s32(vget_low_s16(s))),
+                                  vqmovn_s32(scale_s32(vget_high_s16(s)))));
+  }
+  kMixingKernelsC.scale_s16_with_saturation(scale, size - i, x + i);
+}
+
+void UpmixMonoToStereo(size_t samples_per_channel, int16_t* x) {
+  // Going backwards, each block is written beyond the samples not yet read.
+  size_t n = samples_per_channel;
+  for (; n >= 8; n -= 8) {
+    const int16x8_t s = vld1q_s16(x + n - 8);
+    int16x8x2_t stereo;
+    stereo.val[0] = s;
+    stereo.val[1] = s;
+    vst2q_s16(x + 2 * n - 16, stereo);
+  }
+  kMixingKernelsC.upmix_mono_to_stereo(n, x);
+}
+
+void DownmixStereoToMono(const int16_t* src,
+                         size_t samples_per_channel,
+                         int16_t* dst) {
+  // Sums the channels and divides by two, rounding towards zero.
+  auto average_s32 = [](int16x4_t left, int16x4_t right) {
+    const int32x4_t sum = vaddl_s16(left, right);
+    return vshrq_n_s32(
+        vaddq_s32(sum, vreinterpretq_s32_u32(
+                           vshrq_n_u32(vreinterpretq_u32_s32(sum), 31))),
+        1);
+  };
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    // The load precedes the store, which keeps this correct in place.
+    const int16x8x2_t s = vld2q_s16(src + 2 * i);
+    vst1q_s16(dst + i,
+              vcombine_s16(vmovn_s32(average_s32(vget_low_s16(s.val[0]),
+                                                 vget_low_s16(s.val[1]))),
+                           vmovn_s32(average_s32(vget_high_s16(s.val[0]),
+                                                 vget_high_s16(s.val[1])))));
+  }
+  kMixingKernelsC.downmix_stereo_to_mono(src + 2 * i, samples_per_channel - i,
+                                         dst + i);
+}
+
+}  // namespace
+
+const MixingKernels kMixingKernelsNEON = {
+    AccumulateS16ToFloat, FloatS16ToS16WithStride, ApplyGainsAndClamp,
+    AddS16WithSaturation, ScaleS16WithSaturation,  UpmixMonoToStereo,
+    DownmixStereoToMono};
+
+}  // namespace webrtc
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/mixing_kernels.h"
+
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+// Sizes around the vector widths, and 10 ms at 48 kHz.
+constexpr size_t kSizes[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 480};
+constexpr size_t kStrides[] = {1, 2, 3};
+
+std::vector<int16_t> RandomS16(Random& random, size_t size) {
+  std::vector<int16_t> x(size);
+  for (auto& sample : x) {
+    // Favor the extremes, where saturation happens.
+    sample = random.Rand(0, 3) == 0
+                 ? (random.Rand<bool>() ? 32767 : -32768)
+                 : static_cast<int16_t>(random.Rand(-32768, 32767));
+  }
+  return x;
+}
+
+std::vector<float> RandomFloatS16(Random& random, size_t size) {
+  std::vector<float> x(size);
+  for (auto& sample : x) {
+    switch (random.Rand(0, 3)) {
+      case 0:
+        // Exactly halfway between two integers.
+        sample = random.Rand(-33000, 33000) + 0.5f;
+        break;
+      case 1:
+        sample = random.Rand<bool>() ? 1e6f : -1e6f;
+        break;
+      default:
+        sample = (random.Rand<float>() - 0.5f) * 70000.f;
+    }
+  }
+  return x;
+}
+
+class MixingKernelsTest
+    : public ::testing::TestWithParam<const MixingKernels*> {
+ protected:
+  const MixingKernels& kernels() const { return *GetParam(); }
+  const MixingKernels& reference() const { return kMixingKernelsC; }
+  Random random_{42};
+};
+
+TEST_P(MixingKernelsTest, AccumulateS16ToFloat) {
+  for (size_t stride : kStrides) {
+    for (size_t size : kSizes) {
+      const std::vector<int16_t> src = RandomS16(random_, size * stride);
+      std::vector<float> expected = RandomFloatS16(random_, size);
+      std::vector<float> actual = expected;
+      for (size_t channel = 0; channel < stride; ++channel) {
+        reference().accumulate_s16_to_float(src.data() + channel, stride,
+                                            size, expected.data());
+        kernels().accumulate_s16_to_float(src.data() + channel, stride, size,
+                                          actual.data());
+      }
+      EXPECT_EQ(expected, actual) << "Stride " << stride << ", size " << size;
+    }
+  }
+}
+
+TEST_P(MixingKernelsTest, FloatS16ToS16) {
+  for (size_t stride : kStrides) {
+    for (size_t size : kSizes) {
+      const std::vector<float> src = RandomFloatS16(random_, size);
+      // The elements in between the strided ones must be left untouched.
+      std::vector<int16_t> expected = RandomS16(random_, size * stride);
+      std::vector<int16_t> actual = expected;
+      for (size_t channel = 0; channel < stride; ++channel) {
+        reference().float_s16_to_s16(src.data(), size, stride,
+                                     expected.data() + channel);
+        kernels().float_s16_to_s16(src.data(), size, stride,
+                                   actual.data() + channel);
+      }
+      EXPECT_EQ(expected, actual) << "Stride " << stride << ", size " << size;
+    }
+  }
+}
+
+TEST_P(MixingKernelsTest, ApplyGainsAndClamp) {
+  for (size_t size : kSizes) {
+    std::vector<float> gains(size);
+    for (auto& gain : gains) {
+      gain = random_.Rand<float>() * 2.f;
+    }
+    std::vector<float> expected = RandomFloatS16(random_, size);
+    std::vector<float> actual = expected;
+    reference().apply_gains_and_clamp(gains.data(), -32768.f, 32767.f, size,
+                                      expected.data());
+    kernels().apply_gains_and_clamp(gains.data(), -32768.f, 32767.f, size,
+                                    actual.data());
+    EXPECT_EQ(expected, actual) << "Size " << size;
+  }
+}
+
+TEST_P(MixingKernelsTest, AddS16WithSaturation) {
+  for (size_t size : kSizes) {
+    const std::vector<int16_t> src = RandomS16(random_, size);
+    std::vector<int16_t> expected = RandomS16(random_, size);
+    std::vector<int16_t> actual = expected;
+    reference().add_s16_with_saturation(src.data(), size, expected.data());
+    kernels().add_s16_with_saturation(src.data(), size, actual.data());
+    EXPECT_EQ(expected, actual) << "Size " << size;
+  }
+}
+
+TEST_P(MixingKernelsTest, ScaleS16WithSaturation) {
+  for (float scale : {0.f, 0.3f, 1.f, 1.7f, 3.14f, -0.5f}) {
+    for (size_t size : kSizes) {
+      std::vector<int16_t> expected = RandomS16(random_, size);
+      std::vector<int16_t> actual = expected;
+      reference().scale_s16_with_saturation(scale, size, expected.data());
+      kernels().scale_s16_with_saturation(scale, size, actual.data());
+      EXPECT_EQ(expected, actual) << "Scale " << scale << ", size " << size;
+    }
+  }
+}
+
+TEST_P(MixingKernelsTest, UpmixMonoToStereo) {
+  for (size_t size : kSizes) {
+    std::vector<int16_t> expected = RandomS16(random_, 2 * size);
+    std::vector<int16_t> actual = expected;
+    reference().upmix_mono_to_stereo(size, expected.data());
+    kernels().upmix_mono_to_stereo(size, actual.data());
+    EXPECT_EQ(expected, actual) << "Size " << size;
+  }
+}
+
+TEST_P(MixingKernelsTest, DownmixStereoToMono) {
+  for (size_t size : kSizes) {
+    const std::vector<int16_t> src = RandomS16(random_, 2 * size);
+    std::vector<int16_t> expected(size);
+    std::vector<int16_t> actual(size);
+    reference().downmix_stereo_to_mono(src.data(), size, expected.data());
+    kernels().downmix_stereo_to_mono(src.data(), size, actual.data());
+    EXPECT_EQ(expected, actual) << "Size " << size;
+
+    // In place.
+    std::vector<int16_t> in_place = src;
+    kernels().downmix_stereo_to_mono(in_place.data(), size, in_place.data());
+    in_place.resize(size);
+    EXPECT_EQ(expected, in_place) << "Size " << size;
+  }
+}
+
+std::vector<const MixingKernels*> MixingKernelsToTest() {
+  std::vector<const MixingKernels*> kernels = {&kMixingKernelsC};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    kernels.push_back(&kMixingKernelsAVX2);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  kernels.push_back(&kMixingKernelsNEON);
+#endif
+  return kernels;
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations,
+                         MixingKernelsTest,
+                         ::testing::ValuesIn(MixingKernelsToTest()));
+
+TEST(MixingKernels, CImplementationMatchesAudioUtil) {
+  Random random(17);
+  const std::vector<int16_t> stereo = RandomS16(random, 2 * 480);
+  std::vector<int16_t> expected(480);
+  std::vector<int16_t> actual(480);
+  DownmixInterleavedToMono(stereo.data(), 480, 2, expected.data());
+  kMixingKernelsC.downmix_stereo_to_mono(stereo.data(), 480, actual.data());
+  EXPECT_EQ(expected, actual);
+
+  const std::vector<float> src = RandomFloatS16(random, 480);
+  kMixingKernelsC.float_s16_to_s16(src.data(), 480, 1, actual.data());
+  for (size_t i = 0; i < 480; ++i) {
+    EXPECT_EQ(FloatS16ToS16(src[i]), actual[i]);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
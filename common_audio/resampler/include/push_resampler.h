@@ -16,9 +16,11 @@
 
 namespace webrtc {
 
+class PolyphaseResampler;
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
+// Wraps PushSincResampler, or PolyphaseResampler for integer ratios, to provide
+// stereo support.
 // TODO(ajm): add support for an arbitrary number of channels.
 template <typename T>
 class PushResampler {
@@ -47,6 +49,8 @@ class PushResampler {
   std::vector<T*> channel_data_array_;
 
   struct ChannelResampler {
+    // Only one of the resamplers is set.
+    std::unique_ptr<PolyphaseResampler> polyphase_resampler;
     std::unique_ptr<PushSincResampler> resampler;
     std::vector<T> source;
     std::vector<T> destination;
@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "common_audio/include/audio_util.h"
+#include "common_audio/resampler/sinc_resampler.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kKernelSize = SincResampler::kKernelSize;
+
+// Computes the kernel the way SincResampler::InitializeKernel() does for
+// `subsample_offset`, with the cutoff that SincResampler uses for
+// `io_sample_rate_ratio`.
+void InitializeKernel(double io_sample_rate_ratio,
+                      float subsample_offset,
+                      float* kernel) {
+  // Blackman window parameters.
+  static const double kAlpha = 0.16;
+  static const double kA0 = 0.5 * (1.0 - kAlpha);
+  static const double kA1 = 0.5;
+  static const double kA2 = 0.5 * kAlpha;
+
+  // The normalized cutoff frequency, adjusted slightly downward since the
+  // windowing widens the transition band.
+  const double sinc_scale_factor =
+      (io_sample_rate_ratio > 1.0 ? 1.0 / io_sample_rate_ratio : 1.0) * 0.9;
+
+  for (size_t i = 0; i < kKernelSize; ++i) {
+    const float pre_sinc = static_cast<float>(
+        M_PI * (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
+                subsample_offset));
+    const float x = (i - subsample_offset) / kKernelSize;
+    const float window = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
+                                            kA2 * cos(4.0 * M_PI * x));
+    kernel[i] = static_cast<float>(
+        window * ((pre_sinc == 0)
+                      ? sinc_scale_factor
+                      : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+  }
+}
+
+float DotProduct(const float* input, const float* kernel) {
+  static_assert(kKernelSize % 4 == 0, "kKernelSize must be a multiple of 4");
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  __m128 sums = _mm_setzero_ps();
+  for (size_t i = 0; i < kKernelSize; i += 4) {
+    sums = _mm_add_ps(
+        sums, _mm_mul_ps(_mm_loadu_ps(input + i), _mm_loadu_ps(kernel + i)));
+  }
+  sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+  sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+  return _mm_cvtss_f32(sums);
+#elif defined(WEBRTC_HAS_NEON)
+  float32x4_t sums = vdupq_n_f32(0.f);
+  for (size_t i = 0; i < kKernelSize; i += 4) {
+    sums = vmlaq_f32(sums, vld1q_f32(input + i), vld1q_f32(kernel + i));
+  }
+  float32x2_t sums2 = vadd_f32(vget_low_f32(sums), vget_high_f32(sums));
+  sums2 = vpadd_f32(sums2, sums2);
+  return vget_lane_f32(sums2, 0);
+#else
+  float sum = 0.f;
+  for (size_t i = 0; i < kKernelSize; ++i) {
+    sum += input[i] * kernel[i];
+  }
+  return sum;
+#endif
+}
+
+}  // namespace
+
+bool PolyphaseResampler::IsSupported(size_t source_frames,
+                                     size_t destination_frames) {
+  if (source_frames == 0 || destination_frames == 0 ||
+      source_frames == destination_frames) {
+    return false;
+  }
+  return source_frames > destination_frames
+             ? source_frames % destination_frames == 0
+             : destination_frames % source_frames == 0;
+}
+
+PolyphaseResampler::PolyphaseResampler(size_t source_frames,
+                                       size_t destination_frames)
+    : source_frames_(source_frames),
+      destination_frames_(destination_frames),
+      factor_(source_frames > destination_frames
+                  ? source_frames / destination_frames
+                  : destination_frames / source_frames),
+      upsampling_(destination_frames > source_frames),
+      input_buffer_(kKernelSize + source_frames, 0.f) {
+  RTC_DCHECK(IsSupported(source_frames, destination_frames));
+  const double io_sample_rate_ratio =
+      static_cast<double>(source_frames) / destination_frames;
+  if (upsampling_) {
+    // Output sample `factor_ * i + phase` lies `phase / factor_` input
+    // samples after input sample `i`.
+    kernels_.resize(factor_ * kKernelSize);
+    for (size_t phase = 0; phase < factor_; ++phase) {
+      InitializeKernel(io_sample_rate_ratio,
+                       static_cast<float>(phase) / factor_,
+                       &kernels_[phase * kKernelSize]);
+    }
+  } else {
+    kernels_.resize(kKernelSize);
+    InitializeKernel(io_sample_rate_ratio, 0.f, kernels_.data());
+  }
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+size_t PolyphaseResampler::Resample(const int16_t* source,
+                                    size_t source_frames,
+                                    int16_t* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  if (float_buffer_.empty())
+    float_buffer_.resize(destination_frames_);
+
+  float* input = &input_buffer_[kKernelSize];
+  for (size_t i = 0; i < source_frames; ++i)
+    input[i] = static_cast<float>(source[i]);
+  Filter(float_buffer_.data());
+  FloatS16ToS16(float_buffer_.data(), destination_frames_, destination);
+  return destination_frames_;
+}
+
+size_t PolyphaseResampler::Resample(const float* source,
+                                    size_t source_frames,
+                                    float* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  memcpy(&input_buffer_[kKernelSize], source,
+         source_frames * sizeof(*source));
+  Filter(destination);
+  return destination_frames_;
+}
+
+void PolyphaseResampler::Filter(float* destination) {
+  float* input = input_buffer_.data();
+  if (upsampling_) {
+    for (size_t i = 0; i < source_frames_; ++i) {
+      for (size_t phase = 0; phase < factor_; ++phase) {
+        *destination++ = DotProduct(input + i, &kernels_[phase * kKernelSize]);
+      }
+    }
+  } else {
+    for (size_t i = 0; i < destination_frames_; ++i) {
+      destination[i] = DotProduct(input + i * factor_, kernels_.data());
+    }
+  }
+
+  // Keep the last input samples as the history of the next call.
+  memmove(input, input + source_frames_, kKernelSize * sizeof(*input));
+}
+
+}  // namespace webrtc
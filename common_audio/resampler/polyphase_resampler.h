@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// A push-based resampler for integer ratios, e.g. 48 kHz <-> 16 kHz. It uses
+// the windowed sinc() kernels of SincResampler, so the quality and the delay
+// (half the kernel size at the source rate) are those of PushSincResampler,
+// but every output sample is a single dot product with a precomputed phase of
+// the kernel instead of the interpolation of two dot products.
+class PolyphaseResampler {
+ public:
+  // Returns true if the ratio of `source_frames` and `destination_frames` is
+  // an integer other than one, in either direction.
+  static bool IsSupported(size_t source_frames, size_t destination_frames);
+
+  // Provide the size of the source and destination blocks in samples. These
+  // must correspond to the same time duration (typically 10 ms) and
+  // IsSupported() must be true for them.
+  PolyphaseResampler(size_t source_frames, size_t destination_frames);
+  ~PolyphaseResampler();
+
+  PolyphaseResampler(const PolyphaseResampler&) = delete;
+  PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+  // Perform the resampling. `source_frames` must always equal the
+  // `source_frames` provided at construction. `destination_capacity` must be
+  // at least as large as `destination_frames`. Returns the number of samples
+  // provided in destination.
+  size_t Resample(const int16_t* source,
+                  size_t source_frames,
+                  int16_t* destination,
+                  size_t destination_capacity);
+  size_t Resample(const float* source,
+                  size_t source_frames,
+                  float* destination,
+                  size_t destination_capacity);
+
+ private:
+  void Filter(float* destination);
+
+  const size_t source_frames_;
+  const size_t destination_frames_;
+  // Ratio of the higher and the lower sample rate.
+  const size_t factor_;
+  const bool upsampling_;
+  // One kernel of SincResampler::kKernelSize taps when downsampling, and one
+  // per output phase when upsampling.
+  std::vector<float> kernels_;
+  // The last SincResampler::kKernelSize input samples of the previous call,
+  // followed by the current input.
+  std::vector<float> input_buffer_;
+  std::vector<float> float_buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
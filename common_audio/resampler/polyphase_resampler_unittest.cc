@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "common_audio/resampler/push_sinc_resampler.h"
+#include "common_audio/resampler/sinc_resampler.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumChunks = 20;
+
+std::vector<float> RandomChunk(Random& random, size_t length) {
+  std::vector<float> chunk(length);
+  for (float& sample : chunk) {
+    sample = 65535.f * random.Rand<float>() - 32768.f;
+  }
+  return chunk;
+}
+
+}  // namespace
+
+TEST(PolyphaseResamplerTest, SupportsIntegerRatiosOnly) {
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(480, 160));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(160, 480));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(480, 80));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(320, 160));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 480));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 441));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 320));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(0, 160));
+}
+
+// Where the sampling instants of PushSincResampler are those of the polyphase
+// resampler, the outputs match up to the interpolation between kernel offsets
+// that the former does when upsampling.
+TEST(PolyphaseResamplerTest, MatchesPushSincResampler) {
+  const std::pair<size_t, size_t> kFrames[] = {
+      {320, 160}, {960, 480}, {160, 320}, {160, 480}, {80, 480}};
+  for (const auto& frames : kFrames) {
+    SCOPED_TRACE(::testing::Message()
+                 << frames.first << " -> " << frames.second << " samples");
+    const size_t input_frames = frames.first;
+    const size_t output_frames = frames.second;
+    const float tolerance = input_frames > output_frames ? 0.05f : 20.f;
+    PolyphaseResampler polyphase_resampler(input_frames, output_frames);
+    PushSincResampler sinc_resampler(input_frames, output_frames);
+    Random random(42);
+    std::vector<float> polyphase_output(output_frames);
+    std::vector<float> sinc_output(output_frames);
+    for (int i = 0; i < kNumChunks; ++i) {
+      const std::vector<float> input = RandomChunk(random, input_frames);
+      polyphase_resampler.Resample(input.data(), input_frames,
+                                   polyphase_output.data(), output_frames);
+      sinc_resampler.Resample(input.data(), input_frames, sinc_output.data(),
+                              output_frames);
+      for (size_t j = 0; j < output_frames; ++j) {
+        ASSERT_NEAR(sinc_output[j], polyphase_output[j], tolerance)
+            << "chunk " << i << ", sample " << j;
+      }
+    }
+  }
+}
+
+class PolyphaseResamplerTest
+    : public ::testing::TestWithParam<::testing::tuple<int, int>> {};
+
+// The delay is PushSincResampler::AlgorithmicDelaySeconds(), i.e. half the
+// kernel size at the source rate.
+TEST_P(PolyphaseResamplerTest, DelaysByHalfTheKernelSize) {
+  const int input_rate = ::testing::get<0>(GetParam());
+  const int output_rate = ::testing::get<1>(GetParam());
+  const size_t input_frames = input_rate / 100;
+  const size_t output_frames = output_rate / 100;
+  // An impulse whose delayed position is on the output sampling grid.
+  constexpr size_t kImpulseIndex = 56;
+  const size_t delayed_index = kImpulseIndex + SincResampler::kKernelSize / 2;
+  ASSERT_EQ(0u, delayed_index * output_rate % input_rate);
+  const size_t expected_peak = delayed_index * output_rate / input_rate;
+
+  PolyphaseResampler resampler(input_frames, output_frames);
+  std::vector<float> input(input_frames, 0.f);
+  input[kImpulseIndex] = 10000.f;
+  std::vector<float> output(2 * output_frames);
+  resampler.Resample(input.data(), input_frames, output.data(), output_frames);
+  input[kImpulseIndex] = 0.f;
+  resampler.Resample(input.data(), input_frames, &output[output_frames],
+                     output_frames);
+
+  size_t peak = 0;
+  for (size_t i = 1; i < output.size(); ++i) {
+    if (std::fabs(output[i]) > std::fabs(output[peak]))
+      peak = i;
+  }
+  EXPECT_EQ(expected_peak, peak);
+}
+
+TEST_P(PolyphaseResamplerTest, Int16MatchesFloat) {
+  const size_t input_frames = ::testing::get<0>(GetParam()) / 100;
+  const size_t output_frames = ::testing::get<1>(GetParam()) / 100;
+  PolyphaseResampler float_resampler(input_frames, output_frames);
+  PolyphaseResampler int16_resampler(input_frames, output_frames);
+  Random random(42);
+  std::vector<float> float_input(input_frames);
+  std::vector<int16_t> int16_input(input_frames);
+  std::vector<float> float_output(output_frames);
+  std::vector<int16_t> int16_output(output_frames);
+  for (int i = 0; i < kNumChunks; ++i) {
+    for (size_t j = 0; j < input_frames; ++j) {
+      int16_input[j] = random.Rand(-10000, 10000);
+      float_input[j] = int16_input[j];
+    }
+    float_resampler.Resample(float_input.data(), input_frames,
+                             float_output.data(), output_frames);
+    int16_resampler.Resample(int16_input.data(), input_frames,
+                             int16_output.data(), output_frames);
+    for (size_t j = 0; j < output_frames; ++j) {
+      ASSERT_NEAR(float_output[j], int16_output[j], 0.5f);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(PolyphaseResamplerTest,
+                         PolyphaseResamplerTest,
+                         ::testing::Values(::testing::make_tuple(48000, 16000),
+                                           ::testing::make_tuple(16000, 48000),
+                                           ::testing::make_tuple(48000, 8000),
+                                           ::testing::make_tuple(8000, 48000),
+                                           ::testing::make_tuple(32000, 16000),
+                                           ::testing::make_tuple(16000, 32000),
+                                           ::testing::make_tuple(96000, 48000),
+                                           ::testing::make_tuple(48000,
+                                                                 96000)));
+
+}  // namespace webrtc
@@ -126,8 +126,10 @@ void SincResampler::InitializeCPUSpecificFeatures() {
 #if defined(WEBRTC_HAS_NEON)
   convolve_proc_ = Convolve_NEON;
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
-  // Using AVX2 instead of SSE2 when AVX2 supported.
-  if (GetCPUInfo(kAVX2))
+  // Using AVX-512 or AVX2 instead of SSE2 when supported.
+  if (GetCPUInfo(kAVX512))
+    convolve_proc_ = Convolve_AVX512;
+  else if (GetCPUInfo(kAVX2))
     convolve_proc_ = Convolve_AVX2;
   else if (GetCPUInfo(kSSE2))
     convolve_proc_ = Convolve_SSE;
@@ -146,15 +148,15 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
-      // Create input buffers with a 32-byte alignment for SIMD optimizations.
+      // Create input buffers with a 64-byte alignment for SIMD optimizations.
       kernel_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
+          AlignedMalloc(sizeof(float) * kKernelStorageSize, 64))),
       kernel_pre_sinc_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
+          AlignedMalloc(sizeof(float) * kKernelStorageSize, 64))),
       kernel_window_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
+          AlignedMalloc(sizeof(float) * kKernelStorageSize, 64))),
       input_buffer_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * input_buffer_size_, 32))),
+          AlignedMalloc(sizeof(float) * input_buffer_size_, 64))),
       convolve_proc_(nullptr),
       r1_(input_buffer_.get()),
       r2_(input_buffer_.get() + kKernelSize / 2) {
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/resampler/sinc_resampler.h"
+
+namespace webrtc {
+
+float SincResampler::Convolve_AVX512(const float* input_ptr,
+                                     const float* k1,
+                                     const float* k2,
+                                     double kernel_interpolation_factor) {
+  static_assert(kKernelSize % 16 == 0, "kKernelSize must be a multiple of 16");
+  __m512 m_input;
+  __m512 m_sums1 = _mm512_setzero_ps();
+  __m512 m_sums2 = _mm512_setzero_ps();
+
+  // Based on `input_ptr` alignment, we need to use loadu or load.
+  bool aligned_input = (reinterpret_cast<uintptr_t>(input_ptr) & 0x3F) == 0;
+  if (!aligned_input) {
+    for (size_t i = 0; i < kKernelSize; i += 16) {
+      m_input = _mm512_loadu_ps(input_ptr + i);
+      m_sums1 = _mm512_fmadd_ps(m_input, _mm512_load_ps(k1 + i), m_sums1);
+      m_sums2 = _mm512_fmadd_ps(m_input, _mm512_load_ps(k2 + i), m_sums2);
+    }
+  } else {
+    for (size_t i = 0; i < kKernelSize; i += 16) {
+      m_input = _mm512_load_ps(input_ptr + i);
+      m_sums1 = _mm512_fmadd_ps(m_input, _mm512_load_ps(k1 + i), m_sums1);
+      m_sums2 = _mm512_fmadd_ps(m_input, _mm512_load_ps(k2 + i), m_sums2);
+    }
+  }
+
+  // Linearly interpolate the two "convolutions" and sum the components
+  // together.
+  m_sums1 = _mm512_mul_ps(
+      m_sums1,
+      _mm512_set1_ps(static_cast<float>(1.0 - kernel_interpolation_factor)));
+  m_sums1 = _mm512_fmadd_ps(
+      m_sums2, _mm512_set1_ps(static_cast<float>(kernel_interpolation_factor)),
+      m_sums1);
+  return _mm512_reduce_add_ps(m_sums1);
+}
+
+}  // namespace webrtc
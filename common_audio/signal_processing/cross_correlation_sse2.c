@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of (seq1[j] * seq2[j]) >> right_shifts. Every product is
+// shifted before it is added, and the sum is kept in 32 bits, like in
+// WebRtcSpl_CrossCorrelationC(), so the result is bit-exact with it.
+static int32_t DotProductWithShiftSse2(const int16_t* seq1,
+                                       const int16_t* seq2,
+                                       size_t dim_seq,
+                                       int right_shifts) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  __m128i sum = _mm_setzero_si128();
+  size_t j = 0;
+
+  for (; j + 8 <= dim_seq; j += 8) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)(seq1 + j));
+    const __m128i b = _mm_loadu_si128((const __m128i*)(seq2 + j));
+    const __m128i low = _mm_mullo_epi16(a, b);
+    const __m128i high = _mm_mulhi_epi16(a, b);
+    // Interleaving the low and high halves gives the full 32-bit products.
+    const __m128i products_0 =
+        _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift);
+    const __m128i products_1 =
+        _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift);
+    sum = _mm_add_epi32(sum, _mm_add_epi32(products_0, products_1));
+  }
+
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  int32_t corr = _mm_cvtsi128_si32(sum);
+
+  for (; j < dim_seq; j++)
+    corr += (seq1[j] * seq2[j]) >> right_shifts;
+
+  return corr;
+}
+
+/* SSE2 version of WebRtcSpl_CrossCorrelation() for x86 platforms. */
+void WebRtcSpl_CrossCorrelationSse2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShiftSse2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -539,18 +539,54 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(SplTest, CrossCorrelationSse2IsBitExact) {
+  // Long enough for the vectorized loop and a remainder, with one extreme
+  // product that needs all 32 bits. The other samples are small enough for
+  // the sums not to overflow.
+  const size_t kSeqDimension = 83;
+  const size_t kCrossCorrelationDimension = 20;
+  int16_t seq1[kSeqDimension];
+  int16_t seq2[kSeqDimension + 2 * kCrossCorrelationDimension];
+  int16_t value = 1;
+  for (int16_t& sample : seq1) {
+    sample = value / 16;
+    value = static_cast<int16_t>(value * 31 + 12345);
+  }
+  for (int16_t& sample : seq2) {
+    sample = value / 16;
+    value = static_cast<int16_t>(value * 31 + 12345);
+  }
+  seq1[5] = WEBRTC_SPL_WORD16_MIN;
+  seq2[kCrossCorrelationDimension + 5] = WEBRTC_SPL_WORD16_MIN;
+
+  for (int step : {1, -1}) {
+    for (int shift : {0, 3, 9}) {
+      int32_t expected[kCrossCorrelationDimension];
+      int32_t actual[kCrossCorrelationDimension];
+      const int16_t* seq2_start = seq2 + kCrossCorrelationDimension;
+      WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, kSeqDimension,
+                                  kCrossCorrelationDimension, shift, step);
+      WebRtcSpl_CrossCorrelationSse2(actual, seq1, seq2_start, kSeqDimension,
+                                     kCrossCorrelationDimension, shift, step);
+      for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+      }
+    }
+  }
+}
+#endif
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
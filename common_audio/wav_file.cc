@@ -11,15 +11,26 @@
 #include "common_audio/wav_file.h"
 
 #include <errno.h>
+#include <string.h>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <algorithm>
 #include <array>
 #include <cstdio>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -61,32 +72,228 @@ class WavHeaderFileReader : public WavHeaderReader {
   int64_t pos_ = 0;
 };
 
+// Reads the header of a memory mapped file.
+class WavHeaderMemoryReader : public WavHeaderReader {
+ public:
+  WavHeaderMemoryReader(const uint8_t* data, size_t size)
+      : data_(data), size_(size) {}
+
+  WavHeaderMemoryReader(const WavHeaderMemoryReader&) = delete;
+  WavHeaderMemoryReader& operator=(const WavHeaderMemoryReader&) = delete;
+
+  size_t Read(void* buf, size_t num_bytes) override {
+    const size_t count = std::min(num_bytes, size_ - pos_);
+    memcpy(buf, data_ + pos_, count);
+    pos_ += count;
+    return count;
+  }
+  bool SeekForward(uint32_t num_bytes) override {
+    if (num_bytes > size_ - pos_) {
+      return false;
+    }
+    pos_ += num_bytes;
+    return true;
+  }
+  int64_t GetPosition() override { return pos_; }
+
+ private:
+  const uint8_t* const data_;
+  const size_t size_;
+  size_t pos_ = 0;
+};
+
 constexpr size_t kMaxChunksize = 4096;
 
+// Size of each of the two buffers of an asynchronous WavWriter.
+constexpr size_t kBackgroundWriterBufferSize = 1 << 18;
+
 }  // namespace
 
+// Writes the buffered samples of a WavWriter on a separate thread. One buffer
+// is filled while the other one is written.
+class WavWriter::BackgroundWriter {
+ public:
+  explicit BackgroundWriter(FileWrapper* file)
+      : file_(file),
+        idle_(/*manual_reset=*/false, /*initially_signaled=*/true) {
+    filling_.reserve(kBackgroundWriterBufferSize);
+    writing_.reserve(kBackgroundWriterBufferSize);
+    thread_ = rtc::PlatformThread::SpawnJoinable([this] { Run(); },
+                                                 "WavWriterThread");
+  }
+
+  // Writes the remaining samples and stops the thread.
+  ~BackgroundWriter() {
+    HandOver(/*stop=*/true);
+    thread_.Finalize();
+  }
+
+  void Write(const void* data, size_t num_bytes) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (num_bytes > 0) {
+      const size_t count =
+          std::min(num_bytes, kBackgroundWriterBufferSize - filling_.size());
+      filling_.insert(filling_.end(), bytes, bytes + count);
+      bytes += count;
+      num_bytes -= count;
+      if (filling_.size() == kBackgroundWriterBufferSize) {
+        HandOver(/*stop=*/false);
+      }
+    }
+  }
+
+ private:
+  // Waits until the thread has written the previous buffer, then passes it
+  // the one that has been filled.
+  void HandOver(bool stop) {
+    idle_.Wait(rtc::Event::kForever);
+    std::swap(filling_, writing_);
+    filling_.clear();
+    stop_ = stop;
+    ready_.Set();
+  }
+
+  void Run() {
+    bool stop = false;
+    while (!stop) {
+      ready_.Wait(rtc::Event::kForever);
+      stop = stop_;
+      if (!writing_.empty()) {
+        RTC_CHECK(file_->Write(writing_.data(), writing_.size()));
+      }
+      idle_.Set();
+    }
+  }
+
+  FileWrapper* const file_;
+  std::vector<uint8_t> filling_;
+  // Only accessed by the thread between `ready_` and `idle_` being set.
+  std::vector<uint8_t> writing_;
+  bool stop_ = false;
+  rtc::Event ready_;
+  rtc::Event idle_;
+  rtc::PlatformThread thread_;
+};
+
 WavReader::WavReader(const std::string& filename)
     : WavReader(FileWrapper::OpenReadOnly(filename)) {}
 
 WavReader::WavReader(FileWrapper file) : file_(std::move(file)) {
   RTC_CHECK(file_.is_open())
       << "Invalid file. Could not create file handle for wav file.";
+  ReadHeader();
+}
 
-  WavHeaderFileReader readable(&file_);
+WavReader::WavReader(const std::string& filename, bool memory_map) {
+#if defined(WEBRTC_POSIX)
+  if (memory_map) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    RTC_CHECK_GE(fd, 0)
+        << "Invalid file. Could not create file handle for wav file.";
+    struct stat file_stat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data != MAP_FAILED) {
+      madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+      mapped_data_ = static_cast<const uint8_t*>(data);
+      mapped_size_ = file_stat.st_size;
+      ReadHeader();
+      return;
+    }
+    // Empty files can't be mapped, and neither can some special files.
+  }
+#endif
+  file_ = FileWrapper::OpenReadOnly(filename);
+  RTC_CHECK(file_.is_open())
+      << "Invalid file. Could not create file handle for wav file.";
+  ReadHeader();
+}
+
+void WavReader::ReadHeader() {
+  WavHeaderFileReader file_reader(&file_);
+  WavHeaderMemoryReader memory_reader(mapped_data_, mapped_size_);
+  WavHeaderReader* readable =
+      memory_mapped() ? static_cast<WavHeaderReader*>(&memory_reader)
+                      : &file_reader;
   size_t bytes_per_sample;
-  RTC_CHECK(ReadWavHeader(&readable, &num_channels_, &sample_rate_, &format_,
+  RTC_CHECK(ReadWavHeader(readable, &num_channels_, &sample_rate_, &format_,
                           &bytes_per_sample, &num_samples_in_file_,
                           &data_start_pos_));
   num_unread_samples_ = num_samples_in_file_;
+  mapped_position_ = data_start_pos_;
   RTC_CHECK(FormatSupported(format_)) << "Non-implemented wav-format";
 }
 
 void WavReader::Reset() {
-  RTC_CHECK(file_.SeekTo(data_start_pos_))
-      << "Failed to set position in the file to WAV data start position";
+  if (memory_mapped()) {
+    mapped_position_ = data_start_pos_;
+  } else {
+    RTC_CHECK(file_.SeekTo(data_start_pos_))
+        << "Failed to set position in the file to WAV data start position";
+  }
   num_unread_samples_ = num_samples_in_file_;
 }
 
+size_t WavReader::ReadBytes(void* buf, size_t num_bytes) {
+  if (!memory_mapped()) {
+    return file_.Read(buf, num_bytes);
+  }
+  const size_t count = std::min(num_bytes, mapped_size_ - mapped_position_);
+  memcpy(buf, mapped_data_ + mapped_position_, count);
+  mapped_position_ += count;
+  return count;
+}
+
+bool WavReader::ReadEof() const {
+  return memory_mapped() ? mapped_position_ == mapped_size_
+                         : file_.ReadEof();
+}
+
+const uint8_t* WavReader::ReadMappedSamples(size_t bytes_per_sample,
+                                            size_t* num_samples) {
+  RTC_CHECK(memory_mapped()) << "Only memory mapped files can be read in place";
+  const uint8_t* samples = mapped_data_ + mapped_position_;
+  *num_samples =
+      std::min({*num_samples, num_unread_samples_,
+                (mapped_size_ - mapped_position_) / bytes_per_sample});
+  mapped_position_ += *num_samples * bytes_per_sample;
+  num_unread_samples_ -= *num_samples;
+  return samples;
+}
+
+rtc::ArrayView<const int16_t> WavReader::ReadInt16SamplesInPlace(
+    size_t num_samples) {
+#ifndef WEBRTC_ARCH_LITTLE_ENDIAN
+#error "Need to convert samples to big-endian when reading from WAV file"
+#endif
+  RTC_CHECK_EQ(format_, WavFormat::kWavFormatPcm);
+  const uint8_t* samples = ReadMappedSamples(sizeof(int16_t), &num_samples);
+  // The data chunk starts at an even offset in valid files.
+  RTC_CHECK_EQ(reinterpret_cast<uintptr_t>(samples) % sizeof(int16_t), 0)
+      << "Unaligned WAV data";
+  return rtc::ArrayView<const int16_t>(
+      reinterpret_cast<const int16_t*>(samples), num_samples);
+}
+
+rtc::ArrayView<const float> WavReader::ReadFloatSamplesInPlace(
+    size_t num_samples) {
+#ifndef WEBRTC_ARCH_LITTLE_ENDIAN
+#error "Need to convert samples to big-endian when reading from WAV file"
+#endif
+  RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
+  const uint8_t* samples = ReadMappedSamples(sizeof(float), &num_samples);
+  if (reinterpret_cast<uintptr_t>(samples) % alignof(float) != 0) {
+    aligned_samples_.resize(num_samples);
+    memcpy(aligned_samples_.data(), samples, num_samples * sizeof(float));
+    return rtc::ArrayView<const float>(aligned_samples_.data(), num_samples);
+  }
+  return rtc::ArrayView<const float>(reinterpret_cast<const float*>(samples),
+                                     num_samples);
+}
+
 size_t WavReader::ReadSamples(const size_t num_samples,
                               int16_t* const samples) {
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
@@ -102,8 +309,8 @@ size_t WavReader::ReadSamples(const size_t num_samples,
     size_t num_samples_read;
     if (format_ == WavFormat::kWavFormatIeeeFloat) {
       std::array<float, kMaxChunksize> samples_to_convert;
-      num_bytes_read = file_.Read(samples_to_convert.data(),
-                                  chunk_size * sizeof(samples_to_convert[0]));
+      num_bytes_read = ReadBytes(samples_to_convert.data(),
+                                 chunk_size * sizeof(samples_to_convert[0]));
       num_samples_read = num_bytes_read / sizeof(samples_to_convert[0]);
 
       for (size_t j = 0; j < num_samples_read; ++j) {
@@ -111,13 +318,13 @@ size_t WavReader::ReadSamples(const size_t num_samples,
       }
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatPcm);
-      num_bytes_read = file_.Read(&samples[next_chunk_start],
-                                  chunk_size * sizeof(samples[0]));
+      num_bytes_read = ReadBytes(&samples[next_chunk_start],
+                                 chunk_size * sizeof(samples[0]));
       num_samples_read = num_bytes_read / sizeof(samples[0]);
     }
     RTC_CHECK(num_samples_read == 0 || (num_bytes_read % num_samples_read) == 0)
         << "Corrupt file: file ended in the middle of a sample.";
-    RTC_CHECK(num_samples_read == chunk_size || file_.ReadEof())
+    RTC_CHECK(num_samples_read == chunk_size || ReadEof())
         << "Corrupt file: payload size does not match header.";
 
     next_chunk_start += num_samples_read;
@@ -142,8 +349,8 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
     size_t num_samples_read;
     if (format_ == WavFormat::kWavFormatPcm) {
       std::array<int16_t, kMaxChunksize> samples_to_convert;
-      num_bytes_read = file_.Read(samples_to_convert.data(),
-                                  chunk_size * sizeof(samples_to_convert[0]));
+      num_bytes_read = ReadBytes(samples_to_convert.data(),
+                                 chunk_size * sizeof(samples_to_convert[0]));
       num_samples_read = num_bytes_read / sizeof(samples_to_convert[0]);
 
       for (size_t j = 0; j < num_samples_read; ++j) {
@@ -152,8 +359,8 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
       }
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
-      num_bytes_read = file_.Read(&samples[next_chunk_start],
-                                  chunk_size * sizeof(samples[0]));
+      num_bytes_read = ReadBytes(&samples[next_chunk_start],
+                                 chunk_size * sizeof(samples[0]));
       num_samples_read = num_bytes_read / sizeof(samples[0]);
 
       for (size_t j = 0; j < num_samples_read; ++j) {
@@ -163,7 +370,7 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
     }
     RTC_CHECK(num_samples_read == 0 || (num_bytes_read % num_samples_read) == 0)
         << "Corrupt file: file ended in the middle of a sample.";
-    RTC_CHECK(num_samples_read == chunk_size || file_.ReadEof())
+    RTC_CHECK(num_samples_read == chunk_size || ReadEof())
         << "Corrupt file: payload size does not match header.";
 
     next_chunk_start += num_samples_read;
@@ -175,6 +382,12 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
 }
 
 void WavReader::Close() {
+#if defined(WEBRTC_POSIX)
+  if (memory_mapped()) {
+    munmap(const_cast<uint8_t*>(mapped_data_), mapped_size_);
+    mapped_data_ = nullptr;
+  }
+#endif
   file_.Close();
 }
 
@@ -212,6 +425,29 @@ WavWriter::WavWriter(FileWrapper file,
   RTC_CHECK(file_.Write(blank_header, WavHeaderSize(format_)));
 }
 
+WavWriter::WavWriter(const std::string& filename,
+                     int sample_rate,
+                     size_t num_channels,
+                     SampleFormat sample_format,
+                     bool asynchronous)
+    : WavWriter(filename, sample_rate, num_channels, sample_format) {
+  if (asynchronous) {
+    background_writer_ = std::make_unique<BackgroundWriter>(&file_);
+  }
+}
+
+WavWriter::~WavWriter() {
+  Close();
+}
+
+void WavWriter::Write(const void* data, size_t num_bytes) {
+  if (background_writer_) {
+    background_writer_->Write(data, num_bytes);
+  } else {
+    RTC_CHECK(file_.Write(data, num_bytes));
+  }
+}
+
 void WavWriter::WriteSamples(const int16_t* samples, size_t num_samples) {
 #ifndef WEBRTC_ARCH_LITTLE_ENDIAN
 #error "Need to convert samples to little-endian when writing to WAV file"
@@ -223,17 +459,15 @@ void WavWriter::WriteSamples(const int16_t* samples, size_t num_samples) {
         std::min(kMaxChunksize, num_remaining_samples);
 
     if (format_ == WavFormat::kWavFormatPcm) {
-      RTC_CHECK(
-          file_.Write(&samples[i], num_samples_to_write * sizeof(samples[0])));
+      Write(&samples[i], num_samples_to_write * sizeof(samples[0]));
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
       std::array<float, kMaxChunksize> converted_samples;
       for (size_t j = 0; j < num_samples_to_write; ++j) {
         converted_samples[j] = S16ToFloat(samples[i + j]);
       }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      Write(converted_samples.data(),
+            num_samples_to_write * sizeof(converted_samples[0]));
     }
 
     num_samples_written_ += num_samples_to_write;
@@ -257,18 +491,16 @@ void WavWriter::WriteSamples(const float* samples, size_t num_samples) {
       for (size_t j = 0; j < num_samples_to_write; ++j) {
         converted_samples[j] = FloatS16ToS16(samples[i + j]);
       }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      Write(converted_samples.data(),
+            num_samples_to_write * sizeof(converted_samples[0]));
     } else {
       RTC_CHECK_EQ(format_, WavFormat::kWavFormatIeeeFloat);
       std::array<float, kMaxChunksize> converted_samples;
       for (size_t j = 0; j < num_samples_to_write; ++j) {
         converted_samples[j] = FloatS16ToFloat(samples[i + j]);
       }
-      RTC_CHECK(
-          file_.Write(converted_samples.data(),
-                      num_samples_to_write * sizeof(converted_samples[0])));
+      Write(converted_samples.data(),
+            num_samples_to_write * sizeof(converted_samples[0]));
     }
 
     num_samples_written_ += num_samples_to_write;
@@ -278,6 +510,8 @@ void WavWriter::WriteSamples(const float* samples, size_t num_samples) {
 }
 
 void WavWriter::Close() {
+  // Waits for the buffered samples to be written.
+  background_writer_ = nullptr;
   RTC_CHECK(file_.Rewind());
   std::array<uint8_t, MaxWavHeaderSize()> header;
   size_t header_size;
@@ -14,8 +14,11 @@
 #include <stdint.h>
 
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "api/array_view.h"
 #include "common_audio/wav_header.h"
 #include "rtc_base/system/file_wrapper.h"
 
@@ -47,9 +50,17 @@ class WavWriter final : public WavFile {
             int sample_rate,
             size_t num_channels,
             SampleFormat sample_format = SampleFormat::kInt16);
+  // With `asynchronous`, the samples are written to the file on a separate
+  // thread, through two large buffers that take turns being filled by
+  // WriteSamples() and being written.
+  WavWriter(const std::string& filename,
+            int sample_rate,
+            size_t num_channels,
+            SampleFormat sample_format,
+            bool asynchronous);
 
   // Closes the WAV file, after writing its header.
-  ~WavWriter() { Close(); }
+  ~WavWriter();
 
   WavWriter(const WavWriter&) = delete;
   WavWriter& operator=(const WavWriter&) = delete;
@@ -65,12 +76,16 @@ class WavWriter final : public WavFile {
   size_t num_samples() const override { return num_samples_written_; }
 
  private:
+  class BackgroundWriter;
+
+  void Write(const void* data, size_t num_bytes);
   void Close();
   const int sample_rate_;
   const size_t num_channels_;
   size_t num_samples_written_;
   WavFormat format_;
   FileWrapper file_;
+  std::unique_ptr<BackgroundWriter> background_writer_;
 };
 
 // Follows the conventions of WavWriter.
@@ -79,6 +94,10 @@ class WavReader final : public WavFile {
   // Opens an existing WAV file for reading.
   explicit WavReader(const std::string& filename);
   explicit WavReader(FileWrapper file);
+  // With `memory_map`, the file is mapped into memory, where the platform
+  // supports it, and read without any system calls. Otherwise it is read
+  // through `FileWrapper` as usual.
+  WavReader(const std::string& filename, bool memory_map);
 
   // Close the WAV file.
   ~WavReader() { Close(); }
@@ -94,11 +113,34 @@ class WavReader final : public WavFile {
   size_t ReadSamples(size_t num_samples, float* samples);
   size_t ReadSamples(size_t num_samples, int16_t* samples);
 
+  // Zero-copy reading of memory mapped files. Returns a view of up to
+  // `num_samples` of the next samples, as they are stored in the file, and
+  // advances past them. The view is valid until the next call. The samples of
+  // SampleFormat::kInt16 files can only be read with ReadInt16SamplesInPlace()
+  // and those of SampleFormat::kFloat files, which are in [-1, 1], with
+  // ReadFloatSamplesInPlace(). Float samples that aren't aligned in the file,
+  // as in the files of WavWriter, are copied to an internal buffer.
+  rtc::ArrayView<const int16_t> ReadInt16SamplesInPlace(size_t num_samples);
+  rtc::ArrayView<const float> ReadFloatSamplesInPlace(size_t num_samples);
+
   int sample_rate() const override { return sample_rate_; }
   size_t num_channels() const override { return num_channels_; }
   size_t num_samples() const override { return num_samples_in_file_; }
+  SampleFormat sample_format() const {
+    return format_ == WavFormat::kWavFormatPcm ? SampleFormat::kInt16
+                                               : SampleFormat::kFloat;
+  }
+  bool memory_mapped() const { return mapped_data_ != nullptr; }
 
  private:
+  void ReadHeader();
+  // Reads from the file or from its mapping.
+  size_t ReadBytes(void* buf, size_t num_bytes);
+  bool ReadEof() const;
+  // Returns the mapped bytes of up to `num_samples` samples of
+  // `bytes_per_sample` bytes, and advances past them.
+  const uint8_t* ReadMappedSamples(size_t bytes_per_sample,
+                                   size_t* num_samples);
   void Close();
   int sample_rate_;
   size_t num_channels_;
@@ -108,6 +150,10 @@ class WavReader final : public WavFile {
   FileWrapper file_;
   int64_t
       data_start_pos_;  // Position in the file immediately after WAV header.
+  const uint8_t* mapped_data_ = nullptr;
+  size_t mapped_size_ = 0;
+  size_t mapped_position_ = 0;
+  std::vector<float> aligned_samples_;
 };
 
 }  // namespace webrtc
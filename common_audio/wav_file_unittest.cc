@@ -13,8 +13,12 @@
 
 #include "common_audio/wav_file.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "common_audio/wav_header.h"
 #include "test/gtest.h"
@@ -248,4 +252,83 @@ TEST(WavReaderTest, MAYBE_CPPReset) {
   }
 }
 
+// Writes a file asynchronously, in more samples than fit in one buffer, and
+// reads it back, memory mapped or not.
+TEST(WavWriterTest, AsynchronousWriterAndMemoryMappedReader) {
+  constexpr size_t kNumSamples = 300000;
+  std::vector<int16_t> samples(kNumSamples);
+  for (size_t i = 0; i < kNumSamples; ++i) {
+    samples[i] = static_cast<int16_t>(i * 7);
+  }
+  for (WavFile::SampleFormat format :
+       {WavFile::SampleFormat::kInt16, WavFile::SampleFormat::kFloat}) {
+    const std::string outfile = test::OutputPath() + "wavtest5.wav";
+    {
+      WavWriter w(outfile, 48000, 2, format, /*asynchronous=*/true);
+      for (size_t i = 0; i < kNumSamples; i += 960) {
+        w.WriteSamples(&samples[i], std::min<size_t>(960, kNumSamples - i));
+      }
+      EXPECT_EQ(kNumSamples, w.num_samples());
+    }
+
+    for (bool memory_map : {false, true}) {
+      WavReader r(outfile, memory_map);
+      EXPECT_EQ(48000, r.sample_rate());
+      EXPECT_EQ(2u, r.num_channels());
+      EXPECT_EQ(kNumSamples, r.num_samples());
+      EXPECT_EQ(format, r.sample_format());
+      std::vector<int16_t> read_samples(kNumSamples);
+      EXPECT_EQ(kNumSamples, r.ReadSamples(kNumSamples, read_samples.data()));
+      EXPECT_EQ(samples, read_samples);
+      EXPECT_EQ(0u, r.ReadSamples(kNumSamples, read_samples.data()));
+
+      r.Reset();
+      std::vector<float> float_samples(kNumSamples);
+      EXPECT_EQ(kNumSamples,
+                r.ReadSamples(kNumSamples, float_samples.data()));
+      for (size_t i = 0; i < kNumSamples; ++i) {
+        EXPECT_NEAR(samples[i], float_samples[i], 1);
+      }
+    }
+  }
+}
+
+#if defined(WEBRTC_POSIX)
+TEST(WavReaderTest, ReadsMemoryMappedSamplesInPlace) {
+  const std::string outfile = test::OutputPath() + "wavtest6.wav";
+  static const int16_t kInt16Samples[] = {0, 10, -10, 32767, -32768};
+  constexpr size_t kNumSamples = 5;
+  {
+    WavWriter w(outfile, 8000, 1);
+    w.WriteSamples(kInt16Samples, kNumSamples);
+  }
+  {
+    WavReader r(outfile, /*memory_map=*/true);
+    EXPECT_TRUE(r.memory_mapped());
+    rtc::ArrayView<const int16_t> samples = r.ReadInt16SamplesInPlace(3);
+    ASSERT_EQ(3u, samples.size());
+    EXPECT_EQ(0, memcmp(kInt16Samples, samples.data(), 3 * sizeof(int16_t)));
+    samples = r.ReadInt16SamplesInPlace(kNumSamples);
+    ASSERT_EQ(2u, samples.size());
+    EXPECT_EQ(0, memcmp(&kInt16Samples[3], samples.data(),
+                        2 * sizeof(int16_t)));
+    EXPECT_TRUE(r.ReadInt16SamplesInPlace(kNumSamples).empty());
+  }
+
+  {
+    WavWriter w(outfile, 8000, 1, WavFile::SampleFormat::kFloat);
+    w.WriteSamples(kInt16Samples, kNumSamples);
+  }
+  {
+    WavReader r(outfile, /*memory_map=*/true);
+    rtc::ArrayView<const float> samples =
+        r.ReadFloatSamplesInPlace(kNumSamples);
+    ASSERT_EQ(kNumSamples, samples.size());
+    for (size_t i = 0; i < kNumSamples; ++i) {
+      EXPECT_FLOAT_EQ(kInt16Samples[i] / 32768.f, samples[i]);
+    }
+  }
+}
+#endif
+
 }  // namespace webrtc
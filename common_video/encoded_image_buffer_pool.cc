@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Capacities are rounded up to a multiple of this, so that buffers allocated
+// for slightly different sizes can be used interchangeably.
+constexpr size_t kCapacityAlignment = 4096;
+// The peak decays by 1/kPeakDecay per request, i.e. it takes a few seconds of
+// 30 fps video to forget a keyframe.
+constexpr size_t kPeakDecay = 128;
+// Free buffers with more than kMaxCapacityToPeakRatio times the capacity
+// needed for the peak are purged.
+constexpr size_t kMaxCapacityToPeakRatio = 2;
+
+size_t AlignedCapacity(size_t size) {
+  return std::max<size_t>(
+      (size + kCapacityAlignment - 1) / kCapacityAlignment * kCapacityAlignment,
+      kCapacityAlignment);
+}
+
+}  // namespace
+
+EncodedImageBufferPool::PooledBuffer::PooledBuffer(size_t capacity)
+    : data_(new uint8_t[capacity]), capacity_(capacity) {}
+
+void EncodedImageBufferPool::PooledBuffer::set_size(size_t size) {
+  RTC_DCHECK_LE(size, capacity_);
+  size_ = size;
+}
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(std::numeric_limits<size_t>::max()) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBufferInterface>
+EncodedImageBufferPool::CreateBuffer(size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  size_peak_ = std::max(size, size_peak_ - size_peak_ / kPeakDecay);
+  const size_t max_free_capacity =
+      kMaxCapacityToPeakRatio * AlignedCapacity(size_peak_);
+
+  // Pick the smallest free buffer that fits, so that the large ones stay
+  // available for keyframes.
+  rtc::scoped_refptr<rtc::RefCountedObject<PooledBuffer>> best;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    // The pool holds one reference, so the buffer is free if nobody else does.
+    if (!(*it)->HasOneRef()) {
+      ++it;
+      continue;
+    }
+    if ((*it)->capacity() > max_free_capacity) {
+      it = buffers_.erase(it);
+      continue;
+    }
+    if ((*it)->capacity() >= size &&
+        (!best || (*it)->capacity() < best->capacity())) {
+      best = *it;
+    }
+    ++it;
+  }
+
+  if (!best) {
+    if (buffers_.size() >= max_number_of_buffers_)
+      return EncodedImageBuffer::Create(size);
+    best = new rtc::RefCountedObject<PooledBuffer>(
+        AlignedCapacity(std::max(size, size_peak_)));
+    buffers_.push_back(best);
+  }
+  best->set_size(size);
+  return best;
+}
+
+rtc::scoped_refptr<EncodedImageBufferInterface>
+EncodedImageBufferPool::CreateBuffer(const uint8_t* data, size_t size) {
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer = CreateBuffer(size);
+  if (size > 0)
+    memcpy(buffer->data(), data, size);
+  return buffer;
+}
+
+void EncodedImageBufferPool::Release() {
+  buffers_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include "api/scoped_refptr.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, ReusesReleasedBuffers) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.CreateBuffer(1000);
+  const uint8_t* data = buffer->data();
+  EXPECT_EQ(1000u, buffer->size());
+  buffer = nullptr;
+
+  buffer = pool.CreateBuffer(1200);
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_EQ(1200u, buffer->size());
+  EXPECT_EQ(1u, pool.number_of_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, DoesNotReusePendingBuffers) {
+  EncodedImageBufferPool pool;
+  auto first = pool.CreateBuffer(1000);
+  auto second = pool.CreateBuffer(1000);
+  EXPECT_NE(first->data(), second->data());
+  EXPECT_EQ(2u, pool.number_of_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, CopiesData) {
+  EncodedImageBufferPool pool;
+  const uint8_t kData[] = {1, 2, 3, 4, 5};
+  auto buffer = pool.CreateBuffer(kData, sizeof(kData));
+  ASSERT_EQ(sizeof(kData), buffer->size());
+  EXPECT_EQ(0, memcmp(kData, buffer->data(), sizeof(kData)));
+}
+
+TEST(TestEncodedImageBufferPool, SizesNewBuffersForRecentPeak) {
+  EncodedImageBufferPool pool;
+  // A keyframe followed by a delta frame, pending at the same time.
+  auto keyframe = pool.CreateBuffer(100000);
+  auto delta = pool.CreateBuffer(5000);
+  keyframe = nullptr;
+  delta = nullptr;
+
+  // The buffer allocated for the delta frame is large enough for a keyframe
+  // too, so the next pair of frames does not allocate.
+  keyframe = pool.CreateBuffer(100000);
+  delta = pool.CreateBuffer(5000);
+  EXPECT_EQ(2u, pool.number_of_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, PurgesOversizedFreeBuffers) {
+  EncodedImageBufferPool pool;
+  pool.CreateBuffer(1000000);
+  // Let the peak decay far below the size of the first buffer.
+  for (int i = 0; i < 1000; ++i)
+    pool.CreateBuffer(1000);
+  EXPECT_EQ(1u, pool.number_of_buffers());
+  auto buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(1000u, buffer->size());
+}
+
+TEST(TestEncodedImageBufferPool, FallsBackToUnpooledBuffersWhenFull) {
+  EncodedImageBufferPool pool(/*max_number_of_buffers=*/1);
+  auto first = pool.CreateBuffer(1000);
+  auto second = pool.CreateBuffer(1000);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(1000u, second->size());
+  EXPECT_NE(first->data(), second->data());
+  EXPECT_EQ(1u, pool.number_of_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, PendingBuffersOutliveThePool) {
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer;
+  {
+    EncodedImageBufferPool pool;
+    buffer = pool.CreateBuffer(1000);
+  }
+  memset(buffer->data(), 0, buffer->size());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// Buffer pool for the bitstream of encoded frames, so that encoders do not hit
+// the allocator for every frame, and in particular not for every keyframe. The
+// memory of the buffers returned from CreateBuffer is returned to the pool
+// when the last reference to them, typically held by the packetizer or the
+// frame transformer, is dropped.
+//
+// New buffers are sized for the peak of the recently requested sizes, which
+// decays over time, and free buffers much larger than that are purged. Once
+// `max_number_of_buffers` are pending, CreateBuffer falls back to buffers that
+// are not pooled.
+class EncodedImageBufferPool {
+ public:
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of `size` bytes, with unspecified content.
+  rtc::scoped_refptr<EncodedImageBufferInterface> CreateBuffer(size_t size);
+  // Returns a buffer holding a copy of `data`.
+  rtc::scoped_refptr<EncodedImageBufferInterface> CreateBuffer(
+      const uint8_t* data,
+      size_t size);
+
+  // Clears the pool and detaches the race checker so that it can be reused
+  // later from another thread. Pending buffers stay valid.
+  void Release();
+
+  // The number of buffers owned by the pool, pending or free.
+  size_t number_of_buffers() const { return buffers_.size(); }
+
+ private:
+  class PooledBuffer : public EncodedImageBufferInterface {
+   public:
+    explicit PooledBuffer(size_t capacity);
+
+    const uint8_t* data() const override { return data_.get(); }
+    uint8_t* data() override { return data_.get(); }
+    size_t size() const override { return size_; }
+
+    size_t capacity() const { return capacity_; }
+    void set_size(size_t size);
+
+   private:
+    const std::unique_ptr<uint8_t[]> data_;
+    const size_t capacity_;
+    size_t size_ = 0;
+  };
+
+  rtc::RaceChecker race_checker_;
+  std::list<rtc::scoped_refptr<rtc::RefCountedObject<PooledBuffer>>> buffers_;
+  const size_t max_number_of_buffers_;
+  // Peak of the requested sizes, decaying with every request.
+  size_t size_peak_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
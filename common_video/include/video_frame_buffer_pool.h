@@ -12,8 +12,12 @@
 #define COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_POOL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <list>
+#include <map>
+#include <vector>
 
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
@@ -21,15 +25,74 @@
 #include "api/video/nv12_buffer.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+class VideoFrameBufferPool;
+
+// Caps the memory held by the VideoFrameBufferPools sharing the budget, and
+// counts how often they recycle buffers. The pools of the built-in decoders
+// share the default budget, which has no cap unless one is set. Thread safe.
+class RTC_EXPORT VideoFrameBufferPoolBudget {
+ public:
+  struct Stats {
+    // Memory of all buffers owned by the pools, pending or free.
+    size_t bytes = 0;
+    // Buffer requests served with a recycled buffer and with a new one.
+    int64_t hits = 0;
+    int64_t misses = 0;
+    // Buffer requests that failed because of the cap.
+    int64_t failures = 0;
+  };
+
+  VideoFrameBufferPoolBudget();
+  ~VideoFrameBufferPoolBudget();
+
+  VideoFrameBufferPoolBudget(const VideoFrameBufferPoolBudget&) = delete;
+  VideoFrameBufferPoolBudget& operator=(const VideoFrameBufferPoolBudget&) =
+      delete;
+
+  static VideoFrameBufferPoolBudget& Default();
+
+  // Sets the maximum memory of all pools, or 0 for no limit, which is the
+  // default. Applies to the buffers allocated after the call.
+  void SetMaxBytes(size_t max_bytes);
+
+  // Drops the free buffers of all pools, e.g. under memory pressure. This is
+  // also done when a pool would exceed the cap otherwise.
+  void TrimFreeBuffers();
+
+  Stats GetStats() const;
+
+ private:
+  friend class VideoFrameBufferPool;
+
+  void AddPool(VideoFrameBufferPool* pool);
+  void RemovePool(VideoFrameBufferPool* pool);
+  bool TryAcquireBytes(size_t bytes);
+  void ReleaseBytes(size_t bytes);
+
+  Mutex mutex_;
+  std::vector<VideoFrameBufferPool*> pools_ RTC_GUARDED_BY(mutex_);
+  std::atomic<size_t> max_bytes_{0};
+  std::atomic<size_t> bytes_{0};
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+  std::atomic<int64_t> failures_{0};
+};
+
 // Simple buffer pool to avoid unnecessary allocations of video frame buffers.
 // The pool manages the memory of the I420Buffer/NV12Buffer returned from
 // Create(I420|NV12)Buffer. When the buffer is destructed, the memory is
 // returned to the pool for use by subsequent calls to Create(I420|NV12)Buffer.
-// If the resolution passed to Create(I420|NV12)Buffer changes or requested
-// pixel format changes, old buffers will be purged from the pool.
+// Buffers are kept per pixel format and resolution, so that switching between
+// a few resolutions, e.g. simulcast layers, does not reallocate them. Free
+// buffers of a resolution or pixel format that was not requested for a while
+// are purged, as are free buffers of other resolutions when the pool would
+// exceed `max_number_of_buffers` or its budget otherwise.
 // Note that Create(I420|NV12)Buffer will crash if more than
 // kMaxNumberOfFramesBeforeCrash are created. This is to prevent memory leaks
 // where frames are not returned.
@@ -38,11 +101,14 @@ class VideoFrameBufferPool {
   VideoFrameBufferPool();
   explicit VideoFrameBufferPool(bool zero_initialize);
   VideoFrameBufferPool(bool zero_initialize, size_t max_number_of_buffers);
+  VideoFrameBufferPool(bool zero_initialize,
+                       size_t max_number_of_buffers,
+                       VideoFrameBufferPoolBudget* budget);
   ~VideoFrameBufferPool();
 
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
   // and there are less than `max_number_of_buffers` pending, a buffer is
-  // created. Returns null otherwise.
+  // created, unless that would exceed the budget. Returns null otherwise.
   rtc::scoped_refptr<I420Buffer> CreateI420Buffer(int width, int height);
   rtc::scoped_refptr<I444Buffer> CreateI444Buffer(int width, int height);
   rtc::scoped_refptr<NV12Buffer> CreateNV12Buffer(int width, int height);
@@ -57,11 +123,43 @@ class VideoFrameBufferPool {
   void Release();
 
  private:
-  rtc::scoped_refptr<VideoFrameBuffer>
-  GetExistingBuffer(int width, int height, VideoFrameBuffer::Type type);
+  friend class VideoFrameBufferPoolBudget;
+
+  struct SizeClass {
+    VideoFrameBuffer::Type type;
+    int width;
+    int height;
+    bool operator<(const SizeClass& other) const;
+  };
+  struct SizeClassBuffers {
+    std::list<rtc::scoped_refptr<VideoFrameBuffer>> buffers;
+    size_t buffer_bytes = 0;
+    // Value of `num_requests_` when the size class was last requested.
+    int64_t last_request = 0;
+  };
+
+  template <typename BufferType>
+  rtc::scoped_refptr<BufferType> CreateBuffer(VideoFrameBuffer::Type type,
+                                              int width,
+                                              int height);
+  // Drops buffers of other size classes than `size_class`: the pending ones,
+  // which the pool no longer tracks, and the free ones if `all` is set or the
+  // size class was not requested for a while.
+  void PurgeOtherSizeClasses(const SizeClass& size_class, bool all)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Drops the free buffers of all size classes, for the budget.
+  void TrimFreeBuffers();
+  void Erase(SizeClassBuffers* size_class_buffers,
+             std::list<rtc::scoped_refptr<VideoFrameBuffer>>::iterator* it)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   rtc::RaceChecker race_checker_;
-  std::list<rtc::scoped_refptr<VideoFrameBuffer>> buffers_;
+  // Guards the buffers against the budget, which may trim them from any
+  // thread.
+  Mutex mutex_;
+  std::map<SizeClass, SizeClassBuffers> buffers_ RTC_GUARDED_BY(mutex_);
+  size_t num_buffers_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t num_requests_ = 0;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
@@ -69,7 +167,8 @@ class VideoFrameBufferPool {
   // has to do with "Use-of-uninitialized-value" on "Linux_msan_chrome".
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
-  size_t max_number_of_buffers_;
+  size_t max_number_of_buffers_ RTC_GUARDED_BY(mutex_);
+  VideoFrameBufferPoolBudget* const budget_;
 };
 
 }  // namespace webrtc
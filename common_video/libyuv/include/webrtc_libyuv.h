@@ -88,10 +88,18 @@ double I420SSE(const I420BufferInterface& ref_buffer,
 
 // Compute PSNR for an I420 frame (all planes).
 // Returns the PSNR in decibel, to a maximum of kInfinitePSNR.
+// NV12 frames of the same size are compared without conversion to I420.
 double I420PSNR(const VideoFrame* ref_frame, const VideoFrame* test_frame);
 double I420PSNR(const I420BufferInterface& ref_buffer,
                 const I420BufferInterface& test_buffer);
 
+// Same as I420SSE() and I420PSNR(), for NV12 buffers of the same size. They
+// neither convert nor allocate.
+double NV12SSE(const NV12BufferInterface& ref_buffer,
+               const NV12BufferInterface& test_buffer);
+double NV12PSNR(const NV12BufferInterface& ref_buffer,
+                const NV12BufferInterface& test_buffer);
+
 // Compute SSIM for an I420 frame (all planes).
 double I420SSIM(const VideoFrame* ref_frame, const VideoFrame* test_frame);
 double I420SSIM(const I420BufferInterface& ref_buffer,
@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_frame.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "test/frame_utils.h"
@@ -323,6 +324,32 @@ TEST_F(TestLibYuv, ConvertAlignedFrame) {
   EXPECT_EQ(48.0, psnr);
 }
 
+TEST_F(TestLibYuv, NV12QualityMetricsMatchI420) {
+  const I420BufferInterface& ref_i420 =
+      *orig_frame_->video_frame_buffer()->GetI420();
+  rtc::scoped_refptr<I420Buffer> test_i420 = I420Buffer::Copy(ref_i420);
+  for (int i = 0; i < size_y_; i += 3)
+    test_i420->MutableDataY()[i] ^= 0x10;
+  for (int i = 0; i < size_uv_; i += 5) {
+    test_i420->MutableDataU()[i] ^= 0x08;
+    test_i420->MutableDataV()[i] ^= 0x04;
+  }
+  rtc::scoped_refptr<NV12Buffer> ref_nv12 = NV12Buffer::Copy(ref_i420);
+  rtc::scoped_refptr<NV12Buffer> test_nv12 = NV12Buffer::Copy(*test_i420);
+
+  const double psnr = I420PSNR(ref_i420, *test_i420);
+  EXPECT_LT(psnr, kPerfectPSNR);
+  EXPECT_DOUBLE_EQ(psnr, NV12PSNR(*ref_nv12, *test_nv12));
+  EXPECT_DOUBLE_EQ(I420SSE(ref_i420, *test_i420),
+                   NV12SSE(*ref_nv12, *test_nv12));
+
+  const VideoFrame ref_frame =
+      VideoFrame::Builder().set_video_frame_buffer(ref_nv12).build();
+  const VideoFrame test_frame =
+      VideoFrame::Builder().set_video_frame_buffer(test_nv12).build();
+  EXPECT_DOUBLE_EQ(psnr, I420PSNR(&ref_frame, &test_frame));
+}
+
 static uint8_t Average(int a, int b, int c, int d) {
   return (a + b + c + d + 2) / 4;
 }
@@ -156,6 +156,34 @@ rtc::scoped_refptr<I420BufferInterface> ScaleVideoFrameBuffer(
   return scaled_buffer;
 }
 
+namespace {
+
+struct SumSquareError {
+  uint64_t sse = 0;
+  uint64_t samples = 0;
+};
+
+SumSquareError NV12SumSquareError(const NV12BufferInterface& ref_buffer,
+                                  const NV12BufferInterface& test_buffer) {
+  RTC_DCHECK_EQ(ref_buffer.width(), test_buffer.width());
+  RTC_DCHECK_EQ(ref_buffer.height(), test_buffer.height());
+  const uint64_t width = test_buffer.width();
+  const uint64_t height = test_buffer.height();
+  const uint64_t sse_y = libyuv::ComputeSumSquareErrorPlane(
+      ref_buffer.DataY(), ref_buffer.StrideY(), test_buffer.DataY(),
+      test_buffer.StrideY(), width, height);
+  // The interleaved UV plane is compared as a single plane of twice the
+  // chroma width.
+  const uint64_t width_uv = test_buffer.ChromaWidth();
+  const uint64_t height_uv = test_buffer.ChromaHeight();
+  const uint64_t sse_uv = libyuv::ComputeSumSquareErrorPlane(
+      ref_buffer.DataUV(), ref_buffer.StrideUV(), test_buffer.DataUV(),
+      test_buffer.StrideUV(), 2 * width_uv, height_uv);
+  return {sse_y + sse_uv, width * height + 2 * width_uv * height_uv};
+}
+
+}  // namespace
+
 double I420SSE(const I420BufferInterface& ref_buffer,
                const I420BufferInterface& test_buffer) {
   RTC_DCHECK_EQ(ref_buffer.width(), test_buffer.width());
@@ -251,10 +279,31 @@ double I420PSNR(const I420BufferInterface& ref_buffer,
 double I420PSNR(const VideoFrame* ref_frame, const VideoFrame* test_frame) {
   if (!ref_frame || !test_frame)
     return -1;
+  const VideoFrameBuffer& ref_buffer = *ref_frame->video_frame_buffer();
+  const VideoFrameBuffer& test_buffer = *test_frame->video_frame_buffer();
+  if (ref_buffer.type() == VideoFrameBuffer::Type::kNV12 &&
+      test_buffer.type() == VideoFrameBuffer::Type::kNV12 &&
+      ref_buffer.width() == test_buffer.width() &&
+      ref_buffer.height() == test_buffer.height()) {
+    return NV12PSNR(*ref_buffer.GetNV12(), *test_buffer.GetNV12());
+  }
   return I420PSNR(*ref_frame->video_frame_buffer()->ToI420(),
                   *test_frame->video_frame_buffer()->ToI420());
 }
 
+double NV12SSE(const NV12BufferInterface& ref_buffer,
+               const NV12BufferInterface& test_buffer) {
+  const SumSquareError error = NV12SumSquareError(ref_buffer, test_buffer);
+  return error.sse / (error.samples * 255.0 * 255.0);
+}
+
+double NV12PSNR(const NV12BufferInterface& ref_buffer,
+                const NV12BufferInterface& test_buffer) {
+  const SumSquareError error = NV12SumSquareError(ref_buffer, test_buffer);
+  const double psnr = libyuv::SumSquareErrorToPsnr(error.sse, error.samples);
+  return (psnr > kPerfectPSNR) ? kPerfectPSNR : psnr;
+}
+
 // Compute SSIM for an I420A frame (all planes). Can upscale test frame.
 double I420ASSIM(const I420ABufferInterface& ref_buffer,
                  const I420ABufferInterface& test_buffer) {
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/simulcast_frame_scaler.h"
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaleBuffer(VideoFrameBuffer& source,
+                                                 int width,
+                                                 int height,
+                                                 VideoFrameBufferPool& pool) {
+  switch (source.type()) {
+    case VideoFrameBuffer::Type::kI420: {
+      rtc::scoped_refptr<I420Buffer> buffer =
+          pool.CreateI420Buffer(width, height);
+      if (!buffer)
+        break;
+      buffer->ScaleFrom(*source.GetI420());
+      return buffer;
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      rtc::scoped_refptr<NV12Buffer> buffer =
+          pool.CreateNV12Buffer(width, height);
+      if (!buffer)
+        break;
+      buffer->CropAndScaleFrom(*source.GetNV12(), 0, 0, source.width(),
+                               source.height());
+      return buffer;
+    }
+    default:
+      break;
+  }
+  return source.Scale(width, height);
+}
+
+}  // namespace
+
+SimulcastFrameScaler::SimulcastFrameScaler() = default;
+
+SimulcastFrameScaler::~SimulcastFrameScaler() = default;
+
+void SimulcastFrameScaler::SetInput(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    rtc::ArrayView<const Resolution> resolutions) {
+  input_ = std::move(buffer);
+  layers_.resize(resolutions.size());
+  for (size_t i = 0; i < resolutions.size(); ++i) {
+    layers_[i].resolution = resolutions[i];
+    layers_[i].buffer = nullptr;
+    if (!layers_[i].pool)
+      layers_[i].pool = std::make_unique<VideoFrameBufferPool>();
+  }
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> SimulcastFrameScaler::Scale(
+    size_t layer_index) {
+  RTC_DCHECK(input_);
+  RTC_DCHECK_LT(layer_index, layers_.size());
+  Layer& layer = layers_[layer_index];
+  if (layer.buffer)
+    return layer.buffer;
+
+  const int width = layer.resolution.width;
+  const int height = layer.resolution.height;
+  if (width == input_->width() && height == input_->height()) {
+    layer.buffer = input_;
+    return layer.buffer;
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> source = input_;
+  if (input_->type() != VideoFrameBuffer::Type::kNative) {
+    const size_t source_index = FindSourceLayer(layer_index);
+    if (source_index < layers_.size()) {
+      rtc::scoped_refptr<VideoFrameBuffer> source_layer = Scale(source_index);
+      if (source_layer)
+        source = std::move(source_layer);
+    }
+  }
+  layer.buffer = ScaleBuffer(*source, width, height, *layer.pool);
+  return layer.buffer;
+}
+
+void SimulcastFrameScaler::Clear() {
+  input_ = nullptr;
+  for (Layer& layer : layers_)
+    layer.buffer = nullptr;
+}
+
+size_t SimulcastFrameScaler::FindSourceLayer(size_t layer_index) const {
+  const Resolution& target = layers_[layer_index].resolution;
+  size_t source_index = layers_.size();
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    const Resolution& candidate = layers_[i].resolution;
+    if (candidate.width < target.width || candidate.height < target.height ||
+        (candidate.width == target.width &&
+         candidate.height == target.height) ||
+        candidate.width > input_->width() ||
+        candidate.height > input_->height()) {
+      continue;
+    }
+    if (source_index == layers_.size() ||
+        candidate.width * candidate.height <
+            layers_[source_index].resolution.width *
+                layers_[source_index].resolution.height) {
+      source_index = i;
+    }
+  }
+  return source_index;
+}
+
+}  // namespace webrtc
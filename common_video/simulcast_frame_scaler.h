@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_SIMULCAST_FRAME_SCALER_H_
+#define COMMON_VIDEO_SIMULCAST_FRAME_SCALER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+
+namespace webrtc {
+
+// Scales an input frame to the resolutions of the simulcast layers. Rather
+// than scaling every layer from the input, a layer is scaled from the
+// smallest larger layer, e.g. 1080p -> 540p -> 270p, so that only the first
+// layer reads the full resolution frame. Layers are scaled on demand, and the
+// I420 and NV12 buffers are taken from a pool per layer. Native input buffers
+// are scaled by the buffer itself, as their implementations are expected to
+// be optimized for it.
+class SimulcastFrameScaler {
+ public:
+  struct Resolution {
+    int width;
+    int height;
+  };
+
+  SimulcastFrameScaler();
+  ~SimulcastFrameScaler();
+
+  SimulcastFrameScaler(const SimulcastFrameScaler&) = delete;
+  SimulcastFrameScaler& operator=(const SimulcastFrameScaler&) = delete;
+
+  // Starts scaling `buffer` to the layers of `resolutions`. Releases the
+  // buffers of the previous input.
+  void SetInput(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                rtc::ArrayView<const Resolution> resolutions);
+
+  // Returns the input scaled to the resolution of layer `layer_index`, or
+  // the input itself if it already has that resolution. Returns null if the
+  // input could not be scaled.
+  rtc::scoped_refptr<VideoFrameBuffer> Scale(size_t layer_index);
+
+  // Releases the input and the scaled buffers of it. Buffers returned by
+  // Scale() stay valid as long as references to them are held.
+  void Clear();
+
+ private:
+  struct Layer {
+    Resolution resolution;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer;
+    std::unique_ptr<VideoFrameBufferPool> pool;
+  };
+
+  // Returns the index of the smallest layer that is at least as large as
+  // `layer_index` in both dimensions, and larger in one of them, or
+  // `layers_.size()` if there is none.
+  size_t FindSourceLayer(size_t layer_index) const;
+
+  rtc::scoped_refptr<VideoFrameBuffer> input_;
+  std::vector<Layer> layers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_SIMULCAST_FRAME_SCALER_H_
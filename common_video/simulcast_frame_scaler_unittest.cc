@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/simulcast_frame_scaler.h"
+
+#include <string>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Resolution = SimulcastFrameScaler::Resolution;
+
+// Records the resolutions it is scaled to, by the buffers it returns too.
+class RecordingBuffer : public VideoFrameBuffer {
+ public:
+  RecordingBuffer(Type type,
+                  int width,
+                  int height,
+                  std::vector<std::string>* log,
+                  std::string name)
+      : type_(type), width_(width), height_(height), log_(log), name_(name) {}
+
+  Type type() const override { return type_; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    return I420Buffer::Create(width_, height_);
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height) override {
+    std::string scaled_name =
+        std::to_string(scaled_width) + "x" + std::to_string(scaled_height);
+    log_->push_back(name_ + " -> " + scaled_name);
+    return rtc::make_ref_counted<RecordingBuffer>(type_, scaled_width,
+                                                  scaled_height, log_,
+                                                  scaled_name);
+  }
+
+ private:
+  const Type type_;
+  const int width_;
+  const int height_;
+  std::vector<std::string>* const log_;
+  const std::string name_;
+};
+
+const Resolution kResolutions[] = {{320, 180}, {640, 360}, {1280, 720}};
+
+}  // namespace
+
+TEST(SimulcastFrameScalerTest, ScalesToTheLayerResolutions) {
+  SimulcastFrameScaler scaler;
+  for (auto type : {VideoFrameBuffer::Type::kI420,
+                    VideoFrameBuffer::Type::kNV12}) {
+    rtc::scoped_refptr<VideoFrameBuffer> input =
+        type == VideoFrameBuffer::Type::kI420
+            ? rtc::scoped_refptr<VideoFrameBuffer>(
+                  I420Buffer::Create(1280, 720))
+            : rtc::scoped_refptr<VideoFrameBuffer>(
+                  NV12Buffer::Create(1280, 720));
+    scaler.SetInput(input, kResolutions);
+    for (size_t i = 0; i < 3; ++i) {
+      rtc::scoped_refptr<VideoFrameBuffer> scaled = scaler.Scale(i);
+      ASSERT_TRUE(scaled);
+      EXPECT_EQ(type, scaled->type());
+      EXPECT_EQ(kResolutions[i].width, scaled->width());
+      EXPECT_EQ(kResolutions[i].height, scaled->height());
+    }
+    EXPECT_EQ(input, scaler.Scale(2));
+  }
+}
+
+TEST(SimulcastFrameScalerTest, ScalesFromTheNextLargerLayer) {
+  std::vector<std::string> log;
+  SimulcastFrameScaler scaler;
+  const Resolution kLayers[] = {{320, 180}, {640, 360}, {960, 540}};
+  scaler.SetInput(rtc::make_ref_counted<RecordingBuffer>(
+                      VideoFrameBuffer::Type::kI444, 1920, 1080, &log, "input"),
+                  kLayers);
+  ASSERT_TRUE(scaler.Scale(0));
+  ASSERT_TRUE(scaler.Scale(1));
+  ASSERT_TRUE(scaler.Scale(2));
+  EXPECT_EQ(log, (std::vector<std::string>{"input -> 960x540",
+                                           "960x540 -> 640x360",
+                                           "640x360 -> 320x180"}));
+}
+
+TEST(SimulcastFrameScalerTest, ScalesNativeBuffersFromTheInput) {
+  std::vector<std::string> log;
+  SimulcastFrameScaler scaler;
+  scaler.SetInput(
+      rtc::make_ref_counted<RecordingBuffer>(VideoFrameBuffer::Type::kNative,
+                                             1280, 720, &log, "input"),
+      kResolutions);
+  ASSERT_TRUE(scaler.Scale(0));
+  ASSERT_TRUE(scaler.Scale(1));
+  ASSERT_TRUE(scaler.Scale(2));
+  EXPECT_EQ(log, (std::vector<std::string>{"input -> 320x180",
+                                           "input -> 640x360"}));
+}
+
+TEST(SimulcastFrameScalerTest, ScalesEachLayerOncePerInput) {
+  std::vector<std::string> log;
+  SimulcastFrameScaler scaler;
+  scaler.SetInput(rtc::make_ref_counted<RecordingBuffer>(
+                      VideoFrameBuffer::Type::kI444, 1280, 720, &log, "input"),
+                  kResolutions);
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = scaler.Scale(1);
+  EXPECT_EQ(scaled, scaler.Scale(1));
+  EXPECT_EQ(1u, log.size());
+
+  scaler.SetInput(rtc::make_ref_counted<RecordingBuffer>(
+                      VideoFrameBuffer::Type::kI444, 1280, 720, &log, "input"),
+                  kResolutions);
+  EXPECT_NE(scaled, scaler.Scale(1));
+  EXPECT_EQ(2u, log.size());
+}
+
+TEST(SimulcastFrameScalerTest, ReusesReleasedBuffers) {
+  SimulcastFrameScaler scaler;
+  scaler.SetInput(I420Buffer::Create(1280, 720), kResolutions);
+  const uint8_t* data_y = scaler.Scale(0)->GetI420()->DataY();
+  scaler.Clear();
+
+  scaler.SetInput(I420Buffer::Create(1280, 720), kResolutions);
+  EXPECT_EQ(data_y, scaler.Scale(0)->GetI420()->DataY());
+}
+
+}  // namespace webrtc
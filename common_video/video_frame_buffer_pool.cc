@@ -10,13 +10,20 @@
 
 #include "common_video/include/video_frame_buffer_pool.h"
 
+#include <algorithm>
 #include <limits>
+#include <tuple>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
 namespace {
+
+// Free buffers of a size class that was not requested for this many requests,
+// i.e. about three seconds of 30 fps video, are purged.
+constexpr int64_t kMaxIdleRequests = 90;
+
 bool HasOneRef(const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   // Cast to rtc::RefCountedObject is safe because this function is only called
   // on locally created VideoFrameBuffers, which are either
@@ -41,8 +48,92 @@ bool HasOneRef(const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   return false;
 }
 
+// The memory of a buffer created with the default strides.
+size_t BufferBytes(VideoFrameBuffer::Type type, int width, int height) {
+  const size_t luma = static_cast<size_t>(width) * height;
+  const size_t chroma =
+      static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+  switch (type) {
+    case VideoFrameBuffer::Type::kI444:
+      return 3 * luma;
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kNV12:
+      return luma + 2 * chroma;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+  return 0;
+}
+
 }  // namespace
 
+VideoFrameBufferPoolBudget::VideoFrameBufferPoolBudget() = default;
+
+VideoFrameBufferPoolBudget::~VideoFrameBufferPoolBudget() {
+  RTC_DCHECK(pools_.empty());
+}
+
+VideoFrameBufferPoolBudget& VideoFrameBufferPoolBudget::Default() {
+  static VideoFrameBufferPoolBudget* const budget =
+      new VideoFrameBufferPoolBudget();
+  return *budget;
+}
+
+void VideoFrameBufferPoolBudget::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+}
+
+void VideoFrameBufferPoolBudget::TrimFreeBuffers() {
+  MutexLock lock(&mutex_);
+  for (VideoFrameBufferPool* pool : pools_)
+    pool->TrimFreeBuffers();
+}
+
+VideoFrameBufferPoolBudget::Stats VideoFrameBufferPoolBudget::GetStats()
+    const {
+  Stats stats;
+  stats.bytes = bytes_;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.failures = failures_;
+  return stats;
+}
+
+void VideoFrameBufferPoolBudget::AddPool(VideoFrameBufferPool* pool) {
+  MutexLock lock(&mutex_);
+  pools_.push_back(pool);
+}
+
+void VideoFrameBufferPoolBudget::RemovePool(VideoFrameBufferPool* pool) {
+  MutexLock lock(&mutex_);
+  pools_.erase(std::find(pools_.begin(), pools_.end(), pool));
+}
+
+bool VideoFrameBufferPoolBudget::TryAcquireBytes(size_t bytes) {
+  const size_t max_bytes = max_bytes_;
+  if (max_bytes == 0) {
+    bytes_ += bytes;
+    return true;
+  }
+  size_t acquired_bytes = bytes_;
+  do {
+    if (acquired_bytes + bytes > max_bytes)
+      return false;
+  } while (!bytes_.compare_exchange_weak(acquired_bytes,
+                                         acquired_bytes + bytes));
+  return true;
+}
+
+void VideoFrameBufferPoolBudget::ReleaseBytes(size_t bytes) {
+  const size_t previous_bytes = bytes_.fetch_sub(bytes);
+  RTC_DCHECK_GE(previous_bytes, bytes);
+}
+
+bool VideoFrameBufferPool::SizeClass::operator<(const SizeClass& other) const {
+  return std::tie(type, width, height) <
+         std::tie(other.type, other.width, other.height);
+}
+
 VideoFrameBufferPool::VideoFrameBufferPool() : VideoFrameBufferPool(false) {}
 
 VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize)
@@ -51,25 +142,51 @@ VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize)
 
 VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize,
                                            size_t max_number_of_buffers)
+    : VideoFrameBufferPool(zero_initialize,
+                           max_number_of_buffers,
+                           &VideoFrameBufferPoolBudget::Default()) {}
+
+VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize,
+                                           size_t max_number_of_buffers,
+                                           VideoFrameBufferPoolBudget* budget)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      budget_(budget) {
+  RTC_DCHECK(budget_);
+  budget_->AddPool(this);
+}
 
-VideoFrameBufferPool::~VideoFrameBufferPool() = default;
+VideoFrameBufferPool::~VideoFrameBufferPool() {
+  budget_->RemovePool(this);
+  Release();
+}
 
 void VideoFrameBufferPool::Release() {
+  MutexLock lock(&mutex_);
+  for (auto& size_class : buffers_) {
+    SizeClassBuffers& size_class_buffers = size_class.second;
+    for (auto it = size_class_buffers.buffers.begin();
+         it != size_class_buffers.buffers.end();) {
+      Erase(&size_class_buffers, &it);
+    }
+  }
   buffers_.clear();
 }
 
 bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  MutexLock lock(&mutex_);
   size_t used_buffers_count = 0;
-  for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
-    // If the buffer is in use, the ref count will be >= 2, one from the list we
-    // are looping over and one from the application. If the ref count is 1,
-    // then the list we are looping over holds the only reference and it's safe
-    // to reuse.
-    if (!HasOneRef(buffer)) {
-      used_buffers_count++;
+  for (const auto& size_class : buffers_) {
+    for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer :
+         size_class.second.buffers) {
+      // If the buffer is in use, the ref count will be >= 2, one from the list
+      // we are looping over and one from the application. If the ref count is
+      // 1, then the list we are looping over holds the only reference and it's
+      // safe to reuse.
+      if (!HasOneRef(buffer)) {
+        used_buffers_count++;
+      }
     }
   }
   if (used_buffers_count > max_number_of_buffers) {
@@ -77,14 +194,16 @@ bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
   }
   max_number_of_buffers_ = max_number_of_buffers;
 
-  size_t buffers_to_purge = buffers_.size() - max_number_of_buffers_;
-  auto iter = buffers_.begin();
-  while (iter != buffers_.end() && buffers_to_purge > 0) {
-    if (HasOneRef(*iter)) {
-      iter = buffers_.erase(iter);
-      buffers_to_purge--;
-    } else {
-      ++iter;
+  for (auto& size_class : buffers_) {
+    SizeClassBuffers& size_class_buffers = size_class.second;
+    auto it = size_class_buffers.buffers.begin();
+    while (it != size_class_buffers.buffers.end() &&
+           num_buffers_ > max_number_of_buffers_) {
+      if (HasOneRef(*it)) {
+        Erase(&size_class_buffers, &it);
+      } else {
+        ++it;
+      }
     }
   }
   return true;
@@ -93,122 +212,140 @@ bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
 rtc::scoped_refptr<I420Buffer> VideoFrameBufferPool::CreateI420Buffer(
     int width,
     int height) {
-  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-
-  rtc::scoped_refptr<VideoFrameBuffer> existing_buffer =
-      GetExistingBuffer(width, height, VideoFrameBuffer::Type::kI420);
-  if (existing_buffer) {
-    // Cast is safe because the only way kI420 buffer is created is
-    // in the same function below, where `RefCountedObject<I420Buffer>` is
-    // created.
-    rtc::RefCountedObject<I420Buffer>* raw_buffer =
-        static_cast<rtc::RefCountedObject<I420Buffer>*>(existing_buffer.get());
-    // Creates a new scoped_refptr, which is also pointing to the same
-    // RefCountedObject as buffer, increasing ref count.
-    return rtc::scoped_refptr<I420Buffer>(raw_buffer);
-  }
-
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
-  // Allocate new buffer.
-  rtc::scoped_refptr<I420Buffer> buffer =
-      rtc::make_ref_counted<I420Buffer>(width, height);
-
-  if (zero_initialize_)
-    buffer->InitializeData();
-
-  buffers_.push_back(buffer);
-  return buffer;
+  return CreateBuffer<I420Buffer>(VideoFrameBuffer::Type::kI420, width,
+                                  height);
 }
 
 rtc::scoped_refptr<I444Buffer> VideoFrameBufferPool::CreateI444Buffer(
     int width,
     int height) {
-  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-
-  rtc::scoped_refptr<VideoFrameBuffer> existing_buffer =
-      GetExistingBuffer(width, height, VideoFrameBuffer::Type::kI444);
-  if (existing_buffer) {
-    // Cast is safe because the only way kI444 buffer is created is
-    // in the same function below, where |RefCountedObject<I444Buffer>|
-    // is created.
-    rtc::RefCountedObject<I444Buffer>* raw_buffer =
-        static_cast<rtc::RefCountedObject<I444Buffer>*>(existing_buffer.get());
-    // Creates a new scoped_refptr, which is also pointing to the same
-    // RefCountedObject as buffer, increasing ref count.
-    return rtc::scoped_refptr<I444Buffer>(raw_buffer);
-  }
-
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
-  // Allocate new buffer.
-  rtc::scoped_refptr<I444Buffer> buffer =
-      rtc::make_ref_counted<I444Buffer>(width, height);
-
-  if (zero_initialize_)
-    buffer->InitializeData();
-
-  buffers_.push_back(buffer);
-  return buffer;
+  return CreateBuffer<I444Buffer>(VideoFrameBuffer::Type::kI444, width,
+                                  height);
 }
 
 rtc::scoped_refptr<NV12Buffer> VideoFrameBufferPool::CreateNV12Buffer(
     int width,
     int height) {
+  return CreateBuffer<NV12Buffer>(VideoFrameBuffer::Type::kNV12, width,
+                                  height);
+}
+
+template <typename BufferType>
+rtc::scoped_refptr<BufferType> VideoFrameBufferPool::CreateBuffer(
+    VideoFrameBuffer::Type type,
+    int width,
+    int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  const SizeClass size_class = {type, width, height};
+  const size_t buffer_bytes = BufferBytes(type, width, height);
+  {
+    MutexLock lock(&mutex_);
+    ++num_requests_;
+    PurgeOtherSizeClasses(size_class, /*all=*/false);
+    SizeClassBuffers& size_class_buffers = buffers_[size_class];
+    size_class_buffers.buffer_bytes = buffer_bytes;
+    size_class_buffers.last_request = num_requests_;
+    // Look for a free buffer.
+    for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer :
+         size_class_buffers.buffers) {
+      // If the buffer is in use, the ref count will be >= 2, one from the list
+      // we are looping over and one from the application. If the ref count is
+      // 1, then the list we are looping over holds the only reference and it's
+      // safe to reuse.
+      if (HasOneRef(buffer)) {
+        ++budget_->hits_;
+        // Cast is safe because the buffers of a size class are only created
+        // below, where `RefCountedObject<BufferType>` is created.
+        return rtc::scoped_refptr<BufferType>(
+            static_cast<rtc::RefCountedObject<BufferType>*>(buffer.get()));
+      }
+    }
+    if (num_buffers_ >= max_number_of_buffers_)
+      PurgeOtherSizeClasses(size_class, /*all=*/true);
+    if (num_buffers_ >= max_number_of_buffers_)
+      return nullptr;
+  }
 
-  rtc::scoped_refptr<VideoFrameBuffer> existing_buffer =
-      GetExistingBuffer(width, height, VideoFrameBuffer::Type::kNV12);
-  if (existing_buffer) {
-    // Cast is safe because the only way kI420 buffer is created is
-    // in the same function below, where `RefCountedObject<I420Buffer>` is
-    // created.
-    rtc::RefCountedObject<NV12Buffer>* raw_buffer =
-        static_cast<rtc::RefCountedObject<NV12Buffer>*>(existing_buffer.get());
-    // Creates a new scoped_refptr, which is also pointing to the same
-    // RefCountedObject as buffer, increasing ref count.
-    return rtc::scoped_refptr<NV12Buffer>(raw_buffer);
+  if (!budget_->TryAcquireBytes(buffer_bytes)) {
+    // Make room by dropping the free buffers of this pool first, and then
+    // those of the other pools sharing the budget.
+    {
+      MutexLock lock(&mutex_);
+      PurgeOtherSizeClasses(size_class, /*all=*/true);
+    }
+    if (!budget_->TryAcquireBytes(buffer_bytes)) {
+      budget_->TrimFreeBuffers();
+      if (!budget_->TryAcquireBytes(buffer_bytes)) {
+        ++budget_->failures_;
+        return nullptr;
+      }
+    }
   }
+  ++budget_->misses_;
 
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
   // Allocate new buffer.
-  rtc::scoped_refptr<NV12Buffer> buffer =
-      rtc::make_ref_counted<NV12Buffer>(width, height);
+  rtc::scoped_refptr<BufferType> buffer =
+      rtc::make_ref_counted<BufferType>(width, height);
 
   if (zero_initialize_)
     buffer->InitializeData();
 
-  buffers_.push_back(buffer);
+  MutexLock lock(&mutex_);
+  SizeClassBuffers& size_class_buffers = buffers_[size_class];
+  size_class_buffers.buffer_bytes = buffer_bytes;
+  size_class_buffers.last_request = num_requests_;
+  size_class_buffers.buffers.push_back(buffer);
+  ++num_buffers_;
   return buffer;
 }
 
-rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferPool::GetExistingBuffer(
-    int width,
-    int height,
-    VideoFrameBuffer::Type type) {
-  // Release buffers with wrong resolution or different type.
+void VideoFrameBufferPool::PurgeOtherSizeClasses(const SizeClass& size_class,
+                                                 bool all) {
   for (auto it = buffers_.begin(); it != buffers_.end();) {
-    const auto& buffer = *it;
-    if (buffer->width() != width || buffer->height() != height ||
-        buffer->type() != type) {
+    SizeClassBuffers& size_class_buffers = it->second;
+    if (!(it->first < size_class) && !(size_class < it->first)) {
+      ++it;
+      continue;
+    }
+    const bool idle =
+        num_requests_ - size_class_buffers.last_request > kMaxIdleRequests;
+    for (auto buffer_it = size_class_buffers.buffers.begin();
+         buffer_it != size_class_buffers.buffers.end();) {
+      if (all || idle || !HasOneRef(*buffer_it)) {
+        Erase(&size_class_buffers, &buffer_it);
+      } else {
+        ++buffer_it;
+      }
+    }
+    if (size_class_buffers.buffers.empty()) {
       it = buffers_.erase(it);
     } else {
       ++it;
     }
   }
-  // Look for a free buffer.
-  for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
-    // If the buffer is in use, the ref count will be >= 2, one from the list we
-    // are looping over and one from the application. If the ref count is 1,
-    // then the list we are looping over holds the only reference and it's safe
-    // to reuse.
-    if (HasOneRef(buffer)) {
-      RTC_CHECK(buffer->type() == type);
-      return buffer;
+}
+
+void VideoFrameBufferPool::TrimFreeBuffers() {
+  MutexLock lock(&mutex_);
+  for (auto& size_class : buffers_) {
+    SizeClassBuffers& size_class_buffers = size_class.second;
+    for (auto it = size_class_buffers.buffers.begin();
+         it != size_class_buffers.buffers.end();) {
+      if (HasOneRef(*it)) {
+        Erase(&size_class_buffers, &it);
+      } else {
+        ++it;
+      }
     }
   }
-  return nullptr;
+}
+
+void VideoFrameBufferPool::Erase(
+    SizeClassBuffers* size_class_buffers,
+    std::list<rtc::scoped_refptr<VideoFrameBuffer>>::iterator* it) {
+  budget_->ReleaseBytes(size_class_buffers->buffer_bytes);
+  --num_buffers_;
+  *it = size_class_buffers->buffers.erase(*it);
 }
 
 }  // namespace webrtc
@@ -19,6 +19,12 @@
 #include "test/gtest.h"
 
 namespace webrtc {
+namespace {
+
+// The memory of a 16x16 I420 buffer.
+constexpr size_t kI420Bytes16x16 = 16 * 16 + 2 * 8 * 8;
+
+}  // namespace
 
 TEST(TestVideoFrameBufferPool, SimpleFrameReuse) {
   VideoFrameBufferPool pool;
@@ -88,4 +94,74 @@ TEST(TestVideoFrameBufferPool, SwitchingPixelFormat) {
   EXPECT_EQ(nullptr, pool.CreateI420Buffer(16, 16).get());
 }
 
+TEST(TestVideoFrameBufferPool, ReusesBuffersAcrossResolutionSwitches) {
+  VideoFrameBufferPool pool;
+  auto buffer = pool.CreateI420Buffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  // E.g. a simulcast layer switch and back.
+  pool.CreateI420Buffer(32, 32);
+  buffer = pool.CreateI420Buffer(16, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+}
+
+TEST(TestVideoFrameBufferPool, PurgesIdleResolutions) {
+  VideoFrameBufferPoolBudget budget;
+  VideoFrameBufferPool pool(/*zero_initialize=*/false,
+                            /*max_number_of_buffers=*/10, &budget);
+  pool.CreateI420Buffer(32, 32);
+  for (int i = 0; i < 100; ++i)
+    pool.CreateI420Buffer(16, 16);
+  EXPECT_EQ(kI420Bytes16x16, budget.GetStats().bytes);
+}
+
+TEST(TestVideoFrameBufferPool, CountsHitsAndMisses) {
+  VideoFrameBufferPoolBudget budget;
+  VideoFrameBufferPool pool(/*zero_initialize=*/false,
+                            /*max_number_of_buffers=*/10, &budget);
+  auto first = pool.CreateI420Buffer(16, 16);
+  auto second = pool.CreateI420Buffer(16, 16);
+  first = nullptr;
+  first = pool.CreateI420Buffer(16, 16);
+  VideoFrameBufferPoolBudget::Stats stats = budget.GetStats();
+  EXPECT_EQ(2 * kI420Bytes16x16, stats.bytes);
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(0, stats.failures);
+}
+
+TEST(TestVideoFrameBufferPool, TrimsFreeBuffersOfAllPools) {
+  VideoFrameBufferPoolBudget budget;
+  VideoFrameBufferPool pool1(/*zero_initialize=*/false,
+                             /*max_number_of_buffers=*/10, &budget);
+  VideoFrameBufferPool pool2(/*zero_initialize=*/false,
+                             /*max_number_of_buffers=*/10, &budget);
+  auto pending = pool1.CreateI420Buffer(16, 16);
+  pool1.CreateI420Buffer(16, 16);
+  pool2.CreateI420Buffer(16, 16);
+  EXPECT_EQ(3 * kI420Bytes16x16, budget.GetStats().bytes);
+
+  budget.TrimFreeBuffers();
+  EXPECT_EQ(kI420Bytes16x16, budget.GetStats().bytes);
+}
+
+TEST(TestVideoFrameBufferPool, SharesMemoryCapBetweenPools) {
+  VideoFrameBufferPoolBudget budget;
+  budget.SetMaxBytes(2 * kI420Bytes16x16);
+  VideoFrameBufferPool pool1(/*zero_initialize=*/false,
+                             /*max_number_of_buffers=*/10, &budget);
+  VideoFrameBufferPool pool2(/*zero_initialize=*/false,
+                             /*max_number_of_buffers=*/10, &budget);
+  auto pending1 = pool1.CreateI420Buffer(16, 16);
+  pool1.CreateI420Buffer(16, 16);
+
+  // The free buffer of the first pool is dropped to make room.
+  auto pending2 = pool2.CreateI420Buffer(16, 16);
+  EXPECT_TRUE(pending2);
+  EXPECT_EQ(2 * kI420Bytes16x16, budget.GetStats().bytes);
+
+  EXPECT_FALSE(pool2.CreateI420Buffer(16, 16));
+  EXPECT_EQ(1, budget.GetStats().failures);
+}
+
 }  // namespace webrtc
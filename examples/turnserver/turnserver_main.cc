@@ -11,17 +11,23 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/types/optional.h"
 #include "examples/turnserver/read_auth_file.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "p2p/base/port_interface.h"
 #include "p2p/base/turn_server.h"
 #include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/string_to_number.h"
 #include "rtc_base/thread.h"
 
 namespace {
@@ -48,11 +54,46 @@ class TurnFileAuth : public cricket::TurnAuthInterface {
   const std::map<std::string, std::string> name_to_key_;
 };
 
+// Starts a TURN server on `thread`, listening on a UDP socket bound to
+// `int_addr`. Must be called on `thread`. With `reuse_port`, several servers
+// can listen on the same address, and the kernel spreads the clients over
+// them.
+std::unique_ptr<cricket::TurnServer> StartTurnServer(
+    rtc::Thread* thread,
+    const rtc::SocketAddress& int_addr,
+    const rtc::IPAddress& ext_addr,
+    const std::string& realm,
+    cricket::TurnAuthInterface* auth,
+    bool reuse_port) {
+  RTC_DCHECK(thread->IsCurrent());
+  rtc::SocketServer* socket_server = thread->socketserver();
+  std::unique_ptr<rtc::Socket> socket(
+      socket_server->CreateSocket(int_addr.family(), SOCK_DGRAM));
+  if (!socket ||
+      (reuse_port && socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) ||
+      socket->Bind(int_addr) != 0) {
+    std::cerr << "Failed to create a UDP socket bound at "
+              << int_addr.ToString() << std::endl;
+    return nullptr;
+  }
+
+  auto server = std::make_unique<cricket::TurnServer>(thread);
+  server->set_realm(realm);
+  server->set_software(kSoftware);
+  server->set_auth_hook(auth);
+  server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                            cricket::PROTO_UDP);
+  server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(socket_server),
+      rtc::SocketAddress(ext_addr, 0));
+  return server;
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
-  if (argc != 5) {
-    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file"
+  if (argc != 5 && argc != 6) {
+    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file [shards]"
               << std::endl;
     return 1;
   }
@@ -69,32 +110,58 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  rtc::PhysicalSocketServer socket_server;
-  rtc::AutoSocketServerThread main(&socket_server);
-  rtc::AsyncUDPSocket* int_socket =
-      rtc::AsyncUDPSocket::Create(&socket_server, int_addr);
-  if (!int_socket) {
-    std::cerr << "Failed to create a UDP socket bound at" << int_addr.ToString()
-              << std::endl;
-    return 1;
+  // Every shard is a TurnServer of its own, on a thread of its own. Each
+  // client sticks to one shard, which the kernel picks by hashing its address.
+  int num_shards = 1;
+  if (argc == 6) {
+    absl::optional<int> shards = rtc::StringToNumber<int>(argv[5]);
+    if (!shards || *shards < 1) {
+      std::cerr << "Invalid number of shards: " << argv[5] << std::endl;
+      return 1;
+    }
+    num_shards = *shards;
   }
 
-  cricket::TurnServer server(&main);
+  rtc::PhysicalSocketServer socket_server;
+  rtc::AutoSocketServerThread main(&socket_server);
   std::fstream auth_file(argv[4], std::fstream::in);
 
   TurnFileAuth auth(auth_file.is_open()
                         ? webrtc_examples::ReadAuthFile(&auth_file)
                         : std::map<std::string, std::string>());
-  server.set_realm(argv[3]);
-  server.set_software(kSoftware);
-  server.set_auth_hook(&auth);
-  server.AddInternalSocket(int_socket, cricket::PROTO_UDP);
-  server.SetExternalSocketFactory(
-      new rtc::BasicPacketSocketFactory(&socket_server),
-      rtc::SocketAddress(ext_addr, 0));
+  const std::string realm = argv[3];
+
+  std::vector<std::unique_ptr<rtc::Thread>> threads;
+  std::vector<std::unique_ptr<cricket::TurnServer>> servers;
+  if (num_shards == 1) {
+    servers.push_back(StartTurnServer(&main, int_addr, ext_addr, realm, &auth,
+                                      /*reuse_port=*/false));
+  } else {
+    for (int i = 0; i < num_shards; ++i) {
+      threads.push_back(rtc::Thread::CreateWithSocketServer());
+      rtc::Thread* thread = threads.back().get();
+      thread->SetName("TurnServerShard", nullptr);
+      thread->Start();
+      servers.push_back(thread->Invoke<std::unique_ptr<cricket::TurnServer>>(
+          RTC_FROM_HERE, [&] {
+            return StartTurnServer(thread, int_addr, ext_addr, realm, &auth,
+                                   /*reuse_port=*/true);
+          }));
+    }
+  }
+  for (const auto& server : servers) {
+    if (!server) {
+      return 1;
+    }
+  }
 
-  std::cout << "Listening internally at " << int_addr.ToString() << std::endl;
+  std::cout << "Listening internally at " << int_addr.ToString() << " with "
+            << num_shards << " shard(s)" << std::endl;
 
   main.Run();
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i]->Invoke<void>(RTC_FROM_HERE, [&] { servers[i].reset(); });
+  }
   return 0;
 }
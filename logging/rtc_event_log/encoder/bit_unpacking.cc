@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/bit_unpacking.h"
+
+#include <string.h>
+
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Loads the 8 bytes at `data` as a big-endian word, padding with zeros past
+// the `size` bytes that are available.
+uint64_t LoadBigEndian64(const uint8_t* data, size_t size) {
+  uint64_t word = 0;
+  if (size >= 8) {
+    memcpy(&word, data, sizeof(word));
+    return rtc::NetworkToHost64(word);
+  }
+  for (size_t i = 0; i < 8; ++i) {
+    word = (word << 8) | (i < size ? data[i] : 0);
+  }
+  return word;
+}
+
+// Reads the `bit_width` bits at `bit_position`, for `bit_width` up to 57 so
+// that they fit in one word together with the bits that precede them in their
+// first byte.
+uint64_t ReadField(const uint8_t* data,
+                   size_t size,
+                   size_t bit_position,
+                   size_t bit_width) {
+  const size_t byte_index = bit_position / 8;
+  const uint64_t word =
+      LoadBigEndian64(data + byte_index, size - byte_index);
+  return (word << (bit_position % 8)) >> (64 - bit_width);
+}
+
+}  // namespace
+
+bool UnpackBits(absl::string_view input,
+                size_t bit_offset,
+                size_t bit_width,
+                rtc::ArrayView<uint64_t> values) {
+  RTC_DCHECK_LE(bit_width, 64);
+  const size_t available_bits = input.size() * 8;
+  if (bit_offset > available_bits ||
+      (bit_width > 0 &&
+       values.size() > (available_bits - bit_offset) / bit_width)) {
+    return false;
+  }
+
+  if (bit_width == 0) {
+    for (uint64_t& value : values) {
+      value = 0;
+    }
+    return true;
+  }
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+  size_t bit_position = bit_offset;
+  if (bit_width <= 57) {
+    for (uint64_t& value : values) {
+      value = ReadField(data, input.size(), bit_position, bit_width);
+      bit_position += bit_width;
+    }
+  } else {
+    const size_t low_width = 32;
+    const size_t high_width = bit_width - low_width;
+    for (uint64_t& value : values) {
+      const uint64_t high =
+          ReadField(data, input.size(), bit_position, high_width);
+      const uint64_t low = ReadField(data, input.size(),
+                                     bit_position + high_width, low_width);
+      value = (high << low_width) | low;
+      bit_position += bit_width;
+    }
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_ENCODER_BIT_UNPACKING_H_
+#define LOGGING_RTC_EVENT_LOG_ENCODER_BIT_UNPACKING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Reads `values.size()` consecutive fields of `bit_width` bits each, MSB-first
+// as written by BitWriter, starting `bit_offset` bits into `input`. Each field
+// is extracted from a single 64-bit load where possible, instead of byte by
+// byte as BitstreamReader::ReadBits() does.
+// Returns false, leaving `values` unspecified, if `input` is too short.
+bool UnpackBits(absl::string_view input,
+                size_t bit_offset,
+                size_t bit_width,
+                rtc::ArrayView<uint64_t> values);
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_ENCODER_BIT_UNPACKING_H_
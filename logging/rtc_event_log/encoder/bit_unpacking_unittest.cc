@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/bit_unpacking.h"
+
+#include <string>
+#include <vector>
+
+#include "logging/rtc_event_log/encoder/bit_writer.h"
+#include "rtc_base/bitstream_reader.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+uint64_t RandomValue(Random& random, size_t bit_width) {
+  uint64_t value = (static_cast<uint64_t>(random.Rand<uint32_t>()) << 32) |
+                   random.Rand<uint32_t>();
+  return bit_width == 64 ? value : value & ((uint64_t{1} << bit_width) - 1);
+}
+
+TEST(BitUnpackingTest, UnpacksWhatBitWriterWrote) {
+  Random random(42);
+  for (size_t bit_width = 0; bit_width <= 64; ++bit_width) {
+    // An odd header puts the fields at every offset within a byte.
+    constexpr size_t kHeaderBits = 3;
+    constexpr size_t kNumValues = 21;
+    std::vector<uint64_t> expected(kNumValues);
+    BitWriter writer((kHeaderBits + kNumValues * bit_width + 7) / 8 + 1);
+    writer.WriteBits(5, kHeaderBits);
+    for (uint64_t& value : expected) {
+      value = RandomValue(random, bit_width);
+      writer.WriteBits(value, bit_width);
+    }
+    std::string encoded = writer.GetString();
+    ASSERT_EQ(encoded.size(), (kHeaderBits + kNumValues * bit_width + 7) / 8);
+
+    std::vector<uint64_t> values(kNumValues);
+    ASSERT_TRUE(UnpackBits(encoded, kHeaderBits, bit_width, values));
+    EXPECT_EQ(values, expected) << bit_width;
+
+    // Matches reading the fields one at a time.
+    BitstreamReader reader(encoded);
+    EXPECT_EQ(reader.ReadBits(kHeaderBits), 5u);
+    for (size_t i = 0; i < kNumValues; ++i) {
+      EXPECT_EQ(reader.ReadBits(bit_width), expected[i]) << bit_width;
+    }
+    EXPECT_TRUE(reader.Ok());
+  }
+}
+
+TEST(BitUnpackingTest, CopiesAlignedStrings) {
+  BitWriter writer(6);
+  writer.WriteBits(0xab, 8);
+  writer.WriteBits("cde");
+  writer.WriteBits(1, 1);
+  writer.WriteBits("f");
+  EXPECT_EQ(writer.GetString(), std::string("\xab" "cde" "\xb3\x00", 6));
+}
+
+TEST(BitUnpackingTest, FailsOnShortInput) {
+  const std::string input = "\xff\xff\xff";
+  std::vector<uint64_t> values(3);
+  EXPECT_TRUE(UnpackBits(input, 0, 8, values));
+  EXPECT_FALSE(UnpackBits(input, 1, 8, values));
+  EXPECT_FALSE(UnpackBits(input, 25, 0, values));
+  EXPECT_TRUE(UnpackBits(input, 24, 0, values));
+  EXPECT_EQ(values, std::vector<uint64_t>(3, 0));
+  EXPECT_TRUE(UnpackBits(input, 20, 1, values));
+  EXPECT_EQ(values, std::vector<uint64_t>(3, 1));
+}
+
+}  // namespace
+}  // namespace webrtc
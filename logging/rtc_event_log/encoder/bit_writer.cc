@@ -10,6 +10,8 @@
 
 #include "logging/rtc_event_log/encoder/bit_writer.h"
 
+#include <limits.h>
+
 namespace webrtc {
 
 namespace {
@@ -20,16 +22,49 @@ size_t BitsToBytes(size_t bits) {
 
 void BitWriter::WriteBits(uint64_t val, size_t bit_count) {
   RTC_DCHECK(valid_);
-  const bool success = bit_writer_.WriteBits(val, bit_count);
-  RTC_DCHECK(success);
+  RTC_DCHECK_LE(bit_count, 64);
+  if (bit_count > 56) {
+    // The accumulator may already hold up to 7 bits.
+    WriteBits(val >> 32, bit_count - 32);
+    WriteBits(val & 0xffffffff, 32);
+    return;
+  }
+  if (written_bits_ + bit_count > buffer_.size() * CHAR_BIT) {
+    RTC_DCHECK_NOTREACHED();
+    return;
+  }
+
+  const uint64_t mask = (uint64_t{1} << bit_count) - 1;
+  accumulator_ = (accumulator_ << bit_count) | (val & mask);
+  accumulated_bits_ += bit_count;
   written_bits_ += bit_count;
+  FlushWholeBytes();
 }
 
 void BitWriter::WriteBits(absl::string_view input) {
   RTC_DCHECK(valid_);
-  for (char c : input) {
-    WriteBits(static_cast<unsigned char>(c), CHAR_BIT);
+  if (accumulated_bits_ > 0) {
+    for (char c : input) {
+      WriteBits(static_cast<unsigned char>(c), CHAR_BIT);
+    }
+    return;
+  }
+  if (written_bits_ + input.size() * CHAR_BIT > buffer_.size() * CHAR_BIT) {
+    RTC_DCHECK_NOTREACHED();
+    return;
   }
+  // Byte aligned; copy the bytes over in one go.
+  input.copy(&buffer_[written_bits_ / CHAR_BIT], input.size());
+  written_bits_ += input.size() * CHAR_BIT;
+}
+
+void BitWriter::FlushWholeBytes() {
+  size_t index = (written_bits_ - accumulated_bits_) / CHAR_BIT;
+  while (accumulated_bits_ >= CHAR_BIT) {
+    accumulated_bits_ -= CHAR_BIT;
+    buffer_[index++] = static_cast<char>(accumulator_ >> accumulated_bits_);
+  }
+  accumulator_ &= (uint64_t{1} << accumulated_bits_) - 1;
 }
 
 // Returns everything that was written so far.
@@ -38,6 +73,13 @@ std::string BitWriter::GetString() {
   RTC_DCHECK(valid_);
   valid_ = false;
 
+  if (accumulated_bits_ > 0) {
+    // Pads the last byte with zeros.
+    buffer_[written_bits_ / CHAR_BIT] =
+        static_cast<char>(accumulator_ << (CHAR_BIT - accumulated_bits_));
+    accumulator_ = 0;
+    accumulated_bits_ = 0;
+  }
   buffer_.resize(BitsToBytes(written_bits_));
   written_bits_ = 0;
 
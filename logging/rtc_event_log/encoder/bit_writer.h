@@ -18,18 +18,19 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
-#include "rtc_base/bit_buffer.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-// Wrap BitBufferWriter and extend its functionality by (1) keeping track of
-// the number of bits written and (2) owning its buffer.
+// Writes bits MSB-first into a buffer it owns, keeping track of the number of
+// bits written. Bits are gathered in a 64-bit accumulator and flushed to the
+// buffer a whole byte at a time, rather than one bit field at a time.
 class BitWriter final {
  public:
   explicit BitWriter(size_t byte_count)
       : buffer_(byte_count, '\0'),
-        bit_writer_(reinterpret_cast<uint8_t*>(&buffer_[0]), buffer_.size()),
+        accumulator_(0),
+        accumulated_bits_(0),
         written_bits_(0),
         valid_(true) {
     RTC_DCHECK_GT(byte_count, 0);
@@ -47,8 +48,15 @@ class BitWriter final {
   std::string GetString();
 
  private:
+  // Appends the `accumulated_bits_` lowest bits of `accumulator_` that form
+  // whole bytes to `buffer_`.
+  void FlushWholeBytes();
+
   std::string buffer_;
-  rtc::BitBufferWriter bit_writer_;
+  // Bits that were written but are not yet in `buffer_`, in the
+  // `accumulated_bits_` lowest bits. Fewer than 8 between calls to WriteBits().
+  uint64_t accumulator_;
+  size_t accumulated_bits_;
   // Note: Counting bits instead of bytes wraps around earlier than it has to,
   // which means the maximum length is lower than it could be. We don't expect
   // to go anywhere near the limit, though, so this is good enough.
@@ -16,6 +16,8 @@
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "logging/rtc_event_log/encoder/bit_unpacking.h"
 #include "logging/rtc_event_log/encoder/bit_writer.h"
 #include "logging/rtc_event_log/encoder/var_int.h"
 #include "rtc_base/bit_buffer.h"
@@ -588,8 +590,9 @@ class FixedLengthDeltaDecoder final {
   // avoid having to pass a lot of state between different functions.
   // Therefore, it was deemed acceptable that `reader` does not own the buffer
   // it reads, meaning the lifetime of `this` must not exceed the lifetime
-  // of `reader`'s underlying buffer.
-  FixedLengthDeltaDecoder(BitstreamReader reader,
+  // of `reader`'s underlying buffer, which is `input`.
+  FixedLengthDeltaDecoder(absl::string_view input,
+                          BitstreamReader reader,
                           const FixedLengthEncodingParameters& params,
                           absl::optional<uint64_t> base,
                           size_t num_of_deltas);
@@ -607,8 +610,14 @@ class FixedLengthDeltaDecoder final {
   uint64_t ApplyUnsignedDelta(uint64_t base, uint64_t delta) const;
   uint64_t ApplySignedDelta(uint64_t base, uint64_t delta) const;
 
-  // Reader of the input stream to be decoded. Does not own that buffer.
-  // See comment above ctor for details.
+  // The number of bits of `input_` that `reader_` has read.
+  size_t BitsRead() const;
+
+  // The input stream to be decoded, and a reader of it. Neither owns that
+  // buffer. See comment above ctor for details.
+  // Fixed width fields are unpacked in bulk from `input_`, after the position
+  // of `reader_`, which reads the header and the varints.
+  const absl::string_view input_;
   BitstreamReader reader_;
 
   // The parameters according to which encoding will be done (width of
@@ -706,15 +715,17 @@ std::unique_ptr<FixedLengthDeltaDecoder> FixedLengthDeltaDecoder::Create(
   FixedLengthEncodingParameters params(delta_width_bits, signed_deltas,
                                        values_optional, value_width_bits);
   return absl::WrapUnique(
-      new FixedLengthDeltaDecoder(reader, params, base, num_of_deltas));
+      new FixedLengthDeltaDecoder(input, reader, params, base, num_of_deltas));
 }
 
 FixedLengthDeltaDecoder::FixedLengthDeltaDecoder(
+    absl::string_view input,
     BitstreamReader reader,
     const FixedLengthEncodingParameters& params,
     absl::optional<uint64_t> base,
     size_t num_of_deltas)
-    : reader_(reader),
+    : input_(input),
+      reader_(reader),
       params_(params),
       base_(base),
       num_of_deltas_(num_of_deltas) {
@@ -723,44 +734,61 @@ FixedLengthDeltaDecoder::FixedLengthDeltaDecoder(
 
 std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
   RTC_DCHECK(reader_.Ok());
-  std::vector<bool> existing_values(num_of_deltas_);
+  // Every value takes at least a bit, be it its existence bit or its delta.
+  if (num_of_deltas_ > static_cast<size_t>(reader_.RemainingBitCount())) {
+    return {};
+  }
+  std::vector<uint64_t> existing_values(num_of_deltas_, 1);
   if (params_.values_optional()) {
-    for (size_t i = 0; i < num_of_deltas_; ++i) {
-      existing_values[i] = reader_.Read<bool>();
+    if (!UnpackBits(input_, BitsRead(), 1, existing_values)) {
+      return {};
     }
-  } else {
-    std::fill(existing_values.begin(), existing_values.end(), true);
+    reader_.ConsumeBits(num_of_deltas_);
   }
 
   absl::optional<uint64_t> previous = base_;
   std::vector<absl::optional<uint64_t>> values(num_of_deltas_);
 
-  for (size_t i = 0; i < num_of_deltas_; ++i) {
-    if (!existing_values[i]) {
-      RTC_DCHECK(params_.values_optional());
-      continue;
+  size_t i = 0;
+  if (!previous) {
+    // If the base is non-existent, the first existent value is encoded as
+    // a varint, rather than as a delta.
+    while (i < num_of_deltas_ && !existing_values[i]) {
+      ++i;
     }
-
-    if (!previous) {
-      // If the base is non-existent, the first existent value is encoded as
-      // a varint, rather than as a delta.
-      RTC_DCHECK(!base_.has_value());
+    if (i < num_of_deltas_) {
       values[i] = DecodeVarInt(reader_);
-    } else {
-      uint64_t delta = reader_.ReadBits(params_.delta_width_bits());
-      values[i] = ApplyDelta(*previous, delta);
+      if (!reader_.Ok()) {
+        return {};
+      }
+      previous = values[i];
+      ++i;
     }
+  }
 
-    previous = values[i];
+  std::vector<uint64_t> deltas(
+      std::count(existing_values.begin() + i, existing_values.end(), 1));
+  if (!UnpackBits(input_, BitsRead(), params_.delta_width_bits(), deltas)) {
+    return {};
   }
 
-  if (!reader_.Ok()) {
-    values = {};
+  auto delta = deltas.begin();
+  for (; i < num_of_deltas_; ++i) {
+    if (!existing_values[i]) {
+      RTC_DCHECK(params_.values_optional());
+      continue;
+    }
+    values[i] = ApplyDelta(*previous, *delta++);
+    previous = values[i];
   }
 
   return values;
 }
 
+size_t FixedLengthDeltaDecoder::BitsRead() const {
+  return input_.size() * 8 - reader_.RemainingBitCount();
+}
+
 uint64_t FixedLengthDeltaDecoder::ApplyDelta(uint64_t base,
                                              uint64_t delta) const {
   RTC_DCHECK_LE(base, MaxUnsignedValueOfBitWidth(params_.value_width_bits()));
@@ -11,8 +11,11 @@
 
 #include "logging/rtc_event_log/events/rtc_event_field_encoding_parser.h"
 
+#include <vector>
+
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "logging/rtc_event_log/encoder/bit_unpacking.h"
 #include "logging/rtc_event_log/encoder/var_int.h"
 #include "logging/rtc_event_log/events/rtc_event_field_encoding.h"
 #include "rtc_base/bitstream_reader.h"
@@ -131,13 +134,17 @@ void EventParser::ReadDeltasAndPopulateValues(
     return;
   }
 
-  BitstreamReader reader(pending_data_);
+  std::vector<uint64_t> deltas(num_deltas);
+  if (!UnpackBits(pending_data_, 0, params.delta_bit_width(), deltas)) {
+    SetError();
+    return;
+  }
+
   const uint64_t top_bit = static_cast<uint64_t>(1)
                            << (params.delta_bit_width() - 1);
 
   uint64_t value = base;
-  for (uint64_t i = 0; i < num_deltas; ++i) {
-    uint64_t delta = reader.ReadBits(params.delta_bit_width());
+  for (uint64_t delta : deltas) {
     RTC_DCHECK_LE(value, webrtc_event_logging::MaxUnsignedValueOfBitWidth(
                              params.value_bit_width()));
     RTC_DCHECK_LE(delta, webrtc_event_logging::MaxUnsignedValueOfBitWidth(
@@ -152,11 +159,6 @@ void EventParser::ReadDeltasAndPopulateValues(
     values_.push_back(value);
   }
 
-  if (!reader.Ok()) {
-    SetError();
-    return;
-  }
-
   pending_data_ =
       pending_data_.substr((num_deltas * params.delta_bit_width() + 7) / 8);
 }
@@ -10,8 +10,11 @@
 
 #include "logging/rtc_event_log/rtc_event_log_impl.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -23,10 +26,13 @@
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_new_format.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -34,6 +40,17 @@ constexpr size_t kMaxEventsInHistory = 10000;
 // The config-history is supposed to be unbounded, but needs to have some bound
 // to prevent an attack via unreasonable memory use.
 constexpr size_t kMaxEventsInConfigHistory = 1000;
+// Smaller batches are encoded on the event log's task queue, as handing them
+// to an encoder queue would cost about as much as encoding them.
+constexpr size_t kMinEventsPerEncoderTask = 100;
+
+int NumEncoderQueuesFromFieldTrial() {
+  FieldTrialParameter<int> encoder_queues("encoder_queues", 0);
+  ParseFieldTrial(
+      {&encoder_queues},
+      field_trial::FindFullName("WebRTC-RtcEventLogParallelEncoding"));
+  return encoder_queues.Get();
+}
 
 std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
     RtcEventLog::EncodingType type) {
@@ -55,15 +72,32 @@ std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
 
 RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
                                  TaskQueueFactory* task_queue_factory)
+    : RtcEventLogImpl(encoding_type,
+                      task_queue_factory,
+                      NumEncoderQueuesFromFieldTrial()) {}
+
+RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
+                                 TaskQueueFactory* task_queue_factory,
+                                 int num_encoder_queues)
     : event_encoder_(CreateEncoder(encoding_type)),
       num_config_events_written_(0),
       last_output_ms_(rtc::TimeMillis()),
       output_scheduled_(false),
+      next_encoder_queue_(0),
       logging_state_started_(false),
       task_queue_(
           std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
               "rtc_event_log",
-              TaskQueueFactory::Priority::NORMAL))) {}
+              TaskQueueFactory::Priority::NORMAL))) {
+  for (int i = 0; i < num_encoder_queues; ++i) {
+    EncoderQueue queue;
+    queue.encoder = CreateEncoder(encoding_type);
+    queue.task_queue =
+        std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
+            "rtc_event_log_encoder", TaskQueueFactory::Priority::NORMAL));
+    encoder_queues_.push_back(std::move(queue));
+  }
+}
 
 RtcEventLogImpl::~RtcEventLogImpl() {
   // If we're logging to the output, this will stop that. Blocking function.
@@ -72,6 +106,10 @@ RtcEventLogImpl::~RtcEventLogImpl() {
     StopLogging();
   }
 
+  // Blocks on the tasks still encoding chunks that were dropped, and on the
+  // ones posting to `task_queue_` after their chunk was written.
+  encoder_queues_.clear();
+
   // We want to block on any executing task by invoking ~TaskQueue() before
   // we set unique_ptr's internal pointer to null.
   rtc::TaskQueue* tq = task_queue_.get();
@@ -222,6 +260,12 @@ void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
   // log is started immediately after the first one becomes full, then one
   // cannot rely on the second log to contain everything that isn't in the first
   // log; one batch of events might be missing.
+  if (!encoder_queues_.empty() && history_.size() >= kMinEventsPerEncoderTask) {
+    if (!encoded_configs.empty())
+      WriteToOutputInOrder(std::move(encoded_configs));
+    EncodeHistoryOnEncoderQueues();
+    return;
+  }
   std::string encoded_history =
       event_encoder_->EncodeBatch(history_.begin(), history_.end());
   history_.clear();
@@ -229,6 +273,68 @@ void RtcEventLogImpl::LogEventsFromMemoryToOutput() {
   WriteConfigsAndHistoryToOutput(encoded_configs, encoded_history);
 }
 
+void RtcEventLogImpl::EncodeHistoryOnEncoderQueues() {
+  // The encoders batch events by type and group key, so splitting the history
+  // along these groups doesn't cost any compression.
+  std::map<std::pair<RtcEvent::Type, uint32_t>,
+           std::deque<std::unique_ptr<RtcEvent>>>
+      groups;
+  const size_t num_events = history_.size();
+  for (std::unique_ptr<RtcEvent>& event : history_) {
+    groups[{event->GetType(), event->GetGroupKey()}].push_back(
+        std::move(event));
+  }
+  history_.clear();
+
+  // Balances the batches by handing out the largest groups first, each to the
+  // smallest batch.
+  std::vector<std::deque<std::unique_ptr<RtcEvent>>*> sorted_groups;
+  for (auto& kv : groups) {
+    sorted_groups.push_back(&kv.second);
+  }
+  std::stable_sort(sorted_groups.begin(), sorted_groups.end(),
+                   [](const auto* a, const auto* b) {
+                     return a->size() > b->size();
+                   });
+  const size_t num_batches = std::min(
+      encoder_queues_.size(), num_events / kMinEventsPerEncoderTask);
+  std::vector<std::deque<std::unique_ptr<RtcEvent>>> batches(num_batches);
+  for (std::deque<std::unique_ptr<RtcEvent>>* group : sorted_groups) {
+    auto& batch = *std::min_element(
+        batches.begin(), batches.end(),
+        [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    std::move(group->begin(), group->end(), std::back_inserter(batch));
+  }
+
+  for (std::deque<std::unique_ptr<RtcEvent>>& batch : batches) {
+    if (batch.empty())
+      continue;
+    auto chunk = rtc::make_ref_counted<PendingChunk>();
+    pending_chunks_.push_back(chunk);
+    EncoderQueue& queue =
+        encoder_queues_[next_encoder_queue_++ % encoder_queues_.size()];
+    // Binding to `this` is safe because `this` outlives the encoder queues.
+    queue.task_queue->PostTask([this, encoder = queue.encoder.get(), chunk,
+                                batch = std::move(batch)] {
+      chunk->encoded = encoder->EncodeBatch(batch.begin(), batch.end());
+      chunk->ready.Set();
+      task_queue_->PostTask([this] {
+        RTC_DCHECK_RUN_ON(task_queue_.get());
+        WriteReadyChunksToOutput();
+      });
+    });
+  }
+}
+
+void RtcEventLogImpl::WriteReadyChunksToOutput() {
+  while (event_output_ && !pending_chunks_.empty() &&
+         pending_chunks_.front()->ready.Wait(0)) {
+    rtc::scoped_refptr<PendingChunk> chunk = std::move(pending_chunks_.front());
+    pending_chunks_.pop_front();
+    WriteToOutput(chunk->encoded);
+  }
+}
+
 void RtcEventLogImpl::WriteConfigsAndHistoryToOutput(
     const std::string& encoded_configs,
     const std::string& encoded_history) {
@@ -236,19 +342,28 @@ void RtcEventLogImpl::WriteConfigsAndHistoryToOutput(
   // object twice with small strings. The function also avoids copying any
   // strings in the typical case where there are no config events.
   if (encoded_configs.empty()) {
-    WriteToOutput(encoded_history);  // Typical case.
+    WriteToOutputInOrder(encoded_history);  // Typical case.
   } else if (encoded_history.empty()) {
-    WriteToOutput(encoded_configs);  // Very unusual case.
+    WriteToOutputInOrder(encoded_configs);  // Very unusual case.
   } else {
-    WriteToOutput(encoded_configs + encoded_history);
+    WriteToOutputInOrder(encoded_configs + encoded_history);
   }
 }
 
 void RtcEventLogImpl::StopOutput() {
   event_output_.reset();
+  // The chunks being encoded for the output are dropped once encoded.
+  pending_chunks_.clear();
 }
 
 void RtcEventLogImpl::StopLoggingInternal() {
+  // Waiting for the encoder queues doesn't block on `task_queue_`.
+  while (event_output_ && !pending_chunks_.empty()) {
+    rtc::scoped_refptr<PendingChunk> chunk = std::move(pending_chunks_.front());
+    pending_chunks_.pop_front();
+    chunk->ready.Wait(rtc::Event::kForever);
+    WriteToOutput(chunk->encoded);
+  }
   if (event_output_) {
     RTC_DCHECK(event_output_->IsActive());
     const int64_t timestamp_us = rtc::TimeMillis() * 1000;
@@ -268,4 +383,15 @@ void RtcEventLogImpl::WriteToOutput(const std::string& output_string) {
   }
 }
 
+void RtcEventLogImpl::WriteToOutputInOrder(std::string output_string) {
+  if (pending_chunks_.empty()) {
+    WriteToOutput(output_string);
+    return;
+  }
+  auto chunk = rtc::make_ref_counted<PendingChunk>();
+  chunk->encoded = std::move(output_string);
+  chunk->ready.Set();
+  pending_chunks_.push_back(std::move(chunk));
+}
+
 }  // namespace webrtc
@@ -16,14 +16,18 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/rtc_event_log/rtc_event.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/rtc_event_log_output.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder.h"
+#include "rtc_base/event.h"
+#include "rtc_base/ref_count.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
@@ -32,8 +36,17 @@ namespace webrtc {
 
 class RtcEventLogImpl final : public RtcEventLog {
  public:
+  // Takes the number of encoder queues from the
+  // "WebRTC-RtcEventLogParallelEncoding" field trial, see below.
   RtcEventLogImpl(EncodingType encoding_type,
                   TaskQueueFactory* task_queue_factory);
+  // With `num_encoder_queues` > 0, large batches of events are split by event
+  // type and group key, and encoded on that many task queues of their own
+  // rather than on the event log's task queue. The encoded chunks are written
+  // to the output as they become ready, in the order they were logged in.
+  RtcEventLogImpl(EncodingType encoding_type,
+                  TaskQueueFactory* task_queue_factory,
+                  int num_encoder_queues);
   RtcEventLogImpl(const RtcEventLogImpl&) = delete;
   RtcEventLogImpl& operator=(const RtcEventLogImpl&) = delete;
 
@@ -58,11 +71,29 @@ class RtcEventLogImpl final : public RtcEventLog {
                                       const std::string& encoded_history)
       RTC_RUN_ON(task_queue_);
   void WriteToOutput(const std::string& output_string) RTC_RUN_ON(task_queue_);
+  // Writes `output_string` after the pending chunks.
+  void WriteToOutputInOrder(std::string output_string) RTC_RUN_ON(task_queue_);
+
+  void EncodeHistoryOnEncoderQueues() RTC_RUN_ON(task_queue_);
+  void WriteReadyChunksToOutput() RTC_RUN_ON(task_queue_);
 
   void StopLoggingInternal() RTC_RUN_ON(task_queue_);
 
   void ScheduleOutput() RTC_RUN_ON(task_queue_);
 
+  // Part of the output encoded on one of the `encoder_queues_`.
+  struct PendingChunk : public rtc::RefCountInterface {
+    // Set once `encoded` is.
+    rtc::Event ready{/*manual_reset=*/true, /*initially_signaled=*/false};
+    std::string encoded;
+  };
+
+  struct EncoderQueue {
+    // Only used on `task_queue`.
+    std::unique_ptr<RtcEventLogEncoder> encoder;
+    std::unique_ptr<rtc::TaskQueue> task_queue;
+  };
+
   // History containing all past configuration events.
   std::deque<std::unique_ptr<RtcEvent>> config_history_
       RTC_GUARDED_BY(*task_queue_);
@@ -79,9 +110,18 @@ class RtcEventLogImpl final : public RtcEventLog {
   int64_t last_output_ms_ RTC_GUARDED_BY(*task_queue_);
   bool output_scheduled_ RTC_GUARDED_BY(*task_queue_);
 
+  // Chunks that haven't been written to `event_output_` yet, in output order.
+  std::deque<rtc::scoped_refptr<PendingChunk>> pending_chunks_
+      RTC_GUARDED_BY(*task_queue_);
+  size_t next_encoder_queue_ RTC_GUARDED_BY(*task_queue_);
+
   RTC_NO_UNIQUE_ADDRESS SequenceChecker logging_state_checker_;
   bool logging_state_started_ RTC_GUARDED_BY(logging_state_checker_);
 
+  // Empty unless encoding on separate task queues. Cleared by the destructor
+  // before `task_queue_` is destroyed, as their tasks post to it.
+  std::vector<EncoderQueue> encoder_queues_;
+
   // Since we are posting tasks bound to `this`,  it is critical that the event
   // log and its members outlive `task_queue_`. Keep the `task_queue_`
   // last to ensure it destructs first, or else tasks living on the queue might
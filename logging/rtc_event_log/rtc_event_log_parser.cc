@@ -13,9 +13,20 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <tuple>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -760,6 +771,218 @@ ParsedRtcEventLog::ParseStatus StoreRtcpBlocks(
   return ParsedRtcEventLog::ParseStatus::Success();
 }
 
+// Returns the size of the longest prefix of `data` that is made of whole top
+// level messages and at most `chunk_size` bytes long, or of the first message
+// if it is longer. Returns 0 if `data` doesn't start with a whole message.
+size_t WholeMessagesSize(absl::string_view data, size_t chunk_size) {
+  size_t size = 0;
+  while (size < data.size()) {
+    absl::string_view message = data.substr(size);
+    uint64_t tag = 0;
+    uint64_t length = 0;
+    bool success = false;
+    std::tie(success, message) = DecodeVarInt(message, &tag);
+    if (!success)
+      break;
+    std::tie(success, message) = DecodeVarInt(message, &length);
+    if (!success || length > message.size())
+      break;
+    const size_t message_size = data.size() - size - message.size() + length;
+    if (size > 0 && size + message_size > chunk_size)
+      break;
+    size += message_size;
+  }
+  return size;
+}
+
+// Reads an RtcEventLog file a chunk of whole top level messages at a time.
+class LogFileReader {
+ public:
+  virtual ~LogFileReader() = default;
+
+  // Returns null if the file can't be opened.
+  static std::unique_ptr<LogFileReader> Open(const std::string& file_name,
+                                             bool memory_map);
+
+  // Returns the next chunk, as sized by WholeMessagesSize(). If the rest of
+  // the file isn't made of whole messages, then the last chunk is the rest of
+  // the file. Returns an empty chunk once the file has been read. The chunk is
+  // valid until the next call.
+  virtual absl::string_view ReadChunk(size_t chunk_size) = 0;
+};
+
+class BufferedLogFileReader : public LogFileReader {
+ public:
+  explicit BufferedLogFileReader(FileWrapper file) : file_(std::move(file)) {}
+
+  absl::string_view ReadChunk(size_t chunk_size) override {
+    buffer_.erase(0, chunk_end_);
+    chunk_end_ = 0;
+    size_t size = 0;
+    do {
+      if (buffer_.size() < chunk_size)
+        Read(chunk_size - buffer_.size());
+      size = WholeMessagesSize(buffer_, chunk_size);
+      // Reads on if the next message is larger than the chunk.
+      if (size == 0 && !end_of_file_)
+        Read(chunk_size);
+    } while (size == 0 && !end_of_file_ && buffer_.size() <= kMaxMessageSize);
+    chunk_end_ = size > 0 ? size : buffer_.size();
+    if (size == 0) {
+      // The parser rejects, or warns about, the rest of the file.
+      end_of_file_ = true;
+      file_.Close();
+    }
+    return absl::string_view(buffer_).substr(0, chunk_end_);
+  }
+
+ private:
+  // Larger messages are rejected by the parser.
+  static constexpr size_t kMaxMessageSize = 10000020;
+
+  void Read(size_t size) {
+    if (end_of_file_)
+      return;
+    const size_t old_size = buffer_.size();
+    buffer_.resize(old_size + size);
+    const size_t bytes_read = file_.Read(&buffer_[old_size], size);
+    buffer_.resize(old_size + bytes_read);
+    end_of_file_ = bytes_read < size;
+  }
+
+  FileWrapper file_;
+  std::string buffer_;
+  size_t chunk_end_ = 0;
+  bool end_of_file_ = false;
+};
+
+#if defined(WEBRTC_POSIX)
+class MappedLogFileReader : public LogFileReader {
+ public:
+  MappedLogFileReader(void* data, size_t size) : data_(data), size_(size) {
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+  ~MappedLogFileReader() override { munmap(data_, size_); }
+
+  absl::string_view ReadChunk(size_t chunk_size) override {
+    // The parsed events are copied out of the file, so the pages of the
+    // previous chunk needn't count towards the resident memory anymore.
+    static const size_t kPageSize = sysconf(_SC_PAGESIZE);
+    const size_t release_end = position_ / kPageSize * kPageSize;
+    if (release_end > released_) {
+      madvise(static_cast<char*>(data_) + released_, release_end - released_,
+              MADV_DONTNEED);
+      released_ = release_end;
+    }
+    absl::string_view rest(static_cast<const char*>(data_) + position_,
+                           size_ - position_);
+    size_t size = WholeMessagesSize(rest, chunk_size);
+    if (size == 0)
+      size = rest.size();
+    position_ += size;
+    return rest.substr(0, size);
+  }
+
+ private:
+  void* const data_;
+  const size_t size_;
+  size_t position_ = 0;
+  size_t released_ = 0;
+};
+#endif
+
+std::unique_ptr<LogFileReader> LogFileReader::Open(const std::string& file_name,
+                                                   bool memory_map) {
+#if defined(WEBRTC_POSIX)
+  if (memory_map) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+      return nullptr;
+    struct stat file_stat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data != MAP_FAILED) {
+      return std::make_unique<MappedLogFileReader>(data, file_stat.st_size);
+    }
+    // Empty files can't be mapped, and neither can some special files.
+  }
+#endif
+  FileWrapper file = FileWrapper::OpenReadOnly(file_name);
+  if (!file.is_open())
+    return nullptr;
+  return std::make_unique<BufferedLogFileReader>(std::move(file));
+}
+
+// Splits the events logged at or after `end_us` off `events`, and returns
+// them.
+template <typename T>
+std::shared_ptr<std::vector<T>> SplitOffEventsFrom(int64_t end_us,
+                                                   std::vector<T>* events) {
+  auto held_back_begin =
+      std::stable_partition(events->begin(), events->end(),
+                            [end_us](const T& event) {
+                              return event.log_time_us() < end_us;
+                            });
+  auto held_back = std::make_shared<std::vector<T>>(
+      std::make_move_iterator(held_back_begin),
+      std::make_move_iterator(events->end()));
+  events->erase(held_back_begin, events->end());
+  return held_back;
+}
+
+// Leaves the events logged before `end_us` in `events`, and adds a function
+// to `restore_functions` that puts the other events back in their place.
+template <typename T>
+void HoldBackEventsFrom(int64_t end_us,
+                        std::vector<T>* events,
+                        size_t* num_handed_out,
+                        std::vector<std::function<void()>>* restore_functions) {
+  std::shared_ptr<std::vector<T>> held_back =
+      SplitOffEventsFrom(end_us, events);
+  *num_handed_out += events->size();
+  restore_functions->push_back(
+      [events, held_back] { *events = std::move(*held_back); });
+}
+
+template <typename T>
+void HoldBackEventsFrom(int64_t end_us,
+                        std::map<uint32_t, std::vector<T>>* events_by_ssrc,
+                        size_t* num_handed_out,
+                        std::vector<std::function<void()>>* restore_functions) {
+  for (auto& kv : *events_by_ssrc) {
+    std::shared_ptr<std::vector<T>> held_back =
+        SplitOffEventsFrom(end_us, &kv.second);
+    *num_handed_out += kv.second.size();
+    // The map entries of the handed out events might be gone by then.
+    restore_functions->push_back(
+        [events_by_ssrc, ssrc = kv.first, held_back] {
+          if (held_back->empty()) {
+            events_by_ssrc->erase(ssrc);
+          } else {
+            (*events_by_ssrc)[ssrc] = std::move(*held_back);
+          }
+        });
+  }
+}
+
+template <typename T>
+void UpdateLastLogTime(const std::vector<T>* events, int64_t* last_time_us) {
+  for (const T& event : *events) {
+    *last_time_us = std::max(*last_time_us, event.log_time_us());
+  }
+}
+
+template <typename T>
+void UpdateLastLogTime(const std::map<uint32_t, std::vector<T>>* events_by_ssrc,
+                       int64_t* last_time_us) {
+  for (const auto& kv : *events_by_ssrc) {
+    UpdateLastLogTime(&kv.second, last_time_us);
+  }
+}
+
 }  // namespace
 
 // Conversion functions for version 2 of the wire format.
@@ -1067,26 +1290,9 @@ void ParsedRtcEventLog::Clear() {
 
   incoming_rtp_packets_map_.clear();
   outgoing_rtp_packets_map_.clear();
-  incoming_rtp_packets_by_ssrc_.clear();
-  outgoing_rtp_packets_by_ssrc_.clear();
-  incoming_rtp_packet_views_by_ssrc_.clear();
-  outgoing_rtp_packet_views_by_ssrc_.clear();
-
   incoming_rtcp_packets_.clear();
   outgoing_rtcp_packets_.clear();
-
-  incoming_rr_.clear();
-  outgoing_rr_.clear();
-  incoming_sr_.clear();
-  outgoing_sr_.clear();
-  incoming_nack_.clear();
-  outgoing_nack_.clear();
-  incoming_remb_.clear();
-  outgoing_remb_.clear();
-  incoming_transport_feedback_.clear();
-  outgoing_transport_feedback_.clear();
-  incoming_loss_notification_.clear();
-  outgoing_loss_notification_.clear();
+  ClearProcessedEvents();
 
   start_log_events_.clear();
   stop_log_events_.clear();
@@ -1107,6 +1313,11 @@ void ParsedRtcEventLog::Clear() {
   audio_send_configs_.clear();
   video_recv_configs_.clear();
   video_send_configs_.clear();
+  generic_packets_received_.clear();
+  generic_packets_sent_.clear();
+  generic_acks_received_.clear();
+  route_change_events_.clear();
+  remote_estimate_events_.clear();
 
   last_incoming_rtcp_packet_.clear();
 
@@ -1153,7 +1364,123 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     const std::string& s) {
   Clear();
   ParseStatus status = ParseStreamInternal(s);
+  RTC_RETURN_IF_ERROR(ProcessParsedEvents());
+  return status;
+}
 
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFileIncrementally(
+    const std::string& file_name,
+    const IncrementalParseOptions& options,
+    rtc::FunctionView<void(const ParsedRtcEventLog&)> on_events) {
+  Clear();
+  std::unique_ptr<LogFileReader> reader =
+      LogFileReader::Open(file_name, options.memory_map);
+  if (!reader) {
+    RTC_LOG(LS_WARNING) << "Could not open file " << file_name
+                        << " for reading.";
+    return ParseStatus::Error("Could not open file", __FILE__, __LINE__);
+  }
+
+  absl::string_view chunk = reader->ReadChunk(options.chunk_size);
+  uint64_t tag = 0;
+  if (DecodeVarInt(chunk, &tag).first &&
+      tag >> 1 == static_cast<uint64_t>(RtcEvent::Type::BeginV3Log)) {
+    return ParseStatus::Error("Can't parse the v3 format incrementally",
+                              __FILE__, __LINE__);
+  }
+  while (!chunk.empty()) {
+    ParseStatus status = ParseStreamInternal(chunk);
+    if (!status.ok()) {
+      // Hands out the events parsed before the error, like ParseStream().
+      RTC_RETURN_IF_ERROR(
+          HandOutEvents(std::numeric_limits<int64_t>::max(), on_events));
+      return status;
+    }
+    int64_t last_time_us = std::numeric_limits<int64_t>::min();
+    ForEachEventList([&last_time_us](const auto* events) {
+      UpdateLastLogTime(events, &last_time_us);
+    });
+    if (last_time_us != std::numeric_limits<int64_t>::min()) {
+      RTC_RETURN_IF_ERROR(HandOutEvents(
+          last_time_us - options.max_reordering.us(), on_events));
+    }
+    chunk = reader->ReadChunk(options.chunk_size);
+  }
+  return HandOutEvents(std::numeric_limits<int64_t>::max(), on_events);
+}
+
+template <typename F>
+void ParsedRtcEventLog::ForEachEventList(F f) {
+  f(&incoming_rtp_packets_map_);
+  f(&outgoing_rtp_packets_map_);
+  f(&incoming_rtcp_packets_);
+  f(&outgoing_rtcp_packets_);
+  f(&alr_state_events_);
+  f(&audio_playout_events_);
+  f(&audio_network_adaptation_events_);
+  f(&bwe_probe_cluster_created_events_);
+  f(&bwe_probe_failure_events_);
+  f(&bwe_probe_success_events_);
+  f(&bwe_delay_updates_);
+  f(&bwe_loss_updates_);
+  f(&dtls_transport_states_);
+  f(&dtls_writable_states_);
+  f(&decoded_frames_);
+  f(&ice_candidate_pair_configs_);
+  f(&ice_candidate_pair_events_);
+  f(&generic_packets_received_);
+  f(&generic_packets_sent_);
+  f(&generic_acks_received_);
+  f(&route_change_events_);
+  f(&remote_estimate_events_);
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::HandOutEvents(
+    int64_t end_us,
+    rtc::FunctionView<void(const ParsedRtcEventLog&)> on_events) {
+  size_t num_handed_out = 0;
+  std::vector<std::function<void()>> restore_functions;
+  ForEachEventList([&](auto* events) {
+    HoldBackEventsFrom(end_us, events, &num_handed_out, &restore_functions);
+  });
+  ParseStatus status = ProcessParsedEvents();
+  if (status.ok() && num_handed_out > 0)
+    on_events(*this);
+  ClearProcessedEvents();
+  for (const auto& restore : restore_functions)
+    restore();
+  return status;
+}
+
+void ParsedRtcEventLog::ClearProcessedEvents() {
+  incoming_rtp_packets_by_ssrc_.clear();
+  outgoing_rtp_packets_by_ssrc_.clear();
+  incoming_rtp_packet_views_by_ssrc_.clear();
+  outgoing_rtp_packet_views_by_ssrc_.clear();
+
+  incoming_rr_.clear();
+  outgoing_rr_.clear();
+  incoming_sr_.clear();
+  outgoing_sr_.clear();
+  incoming_xr_.clear();
+  outgoing_xr_.clear();
+  incoming_nack_.clear();
+  outgoing_nack_.clear();
+  incoming_remb_.clear();
+  outgoing_remb_.clear();
+  incoming_fir_.clear();
+  outgoing_fir_.clear();
+  incoming_pli_.clear();
+  outgoing_pli_.clear();
+  incoming_bye_.clear();
+  outgoing_bye_.clear();
+  incoming_transport_feedback_.clear();
+  outgoing_transport_feedback_.clear();
+  incoming_loss_notification_.clear();
+  outgoing_loss_notification_.clear();
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ProcessParsedEvents() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1174,9 +1501,12 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
 
   // ParseStreamInternal stores the RTP packets in a map indexed by SSRC.
   // Since we dont need rapid lookup based on SSRC after parsing, we move the
-  // packets_streams from map to vector.
+  // packets_streams from map to vector. When parsing incrementally, the
+  // packets of some streams might all be held back.
   incoming_rtp_packets_by_ssrc_.reserve(incoming_rtp_packets_map_.size());
   for (auto& kv : incoming_rtp_packets_map_) {
+    if (kv.second.empty())
+      continue;
     incoming_rtp_packets_by_ssrc_.emplace_back(LoggedRtpStreamIncoming());
     incoming_rtp_packets_by_ssrc_.back().ssrc = kv.first;
     incoming_rtp_packets_by_ssrc_.back().incoming_packets =
@@ -1185,6 +1515,8 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
   incoming_rtp_packets_map_.clear();
   outgoing_rtp_packets_by_ssrc_.reserve(outgoing_rtp_packets_map_.size());
   for (auto& kv : outgoing_rtp_packets_map_) {
+    if (kv.second.empty())
+      continue;
     outgoing_rtp_packets_by_ssrc_.emplace_back(LoggedRtpStreamOutgoing());
     outgoing_rtp_packets_by_ssrc_.back().ssrc = kv.first;
     outgoing_rtp_packets_by_ssrc_.back().outgoing_packets =
@@ -1297,7 +1629,7 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     first_timestamp_ = last_timestamp_ = Timestamp::Zero();
   }
 
-  return status;
+  return ParseStatus::Success();
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
@@ -18,7 +18,9 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "api/function_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
+#include "api/units/time_delta.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
 #include "logging/rtc_event_log/events/logged_rtp_rtcp.h"
@@ -365,6 +367,17 @@ class ParsedRtcEventLog {
     int64_t stop_time_us_;
   };
 
+  struct IncrementalParseOptions {
+    // An event is handed out once an event logged this much later has been
+    // parsed. RtcEventLog writes the events of each output period grouped by
+    // type, so this should be longer than the longest output period.
+    TimeDelta max_reordering = TimeDelta::Seconds(10);
+    // The number of bytes of the file parsed at a time.
+    size_t chunk_size = 1 << 20;
+    // Maps the file into memory instead of reading it, where supported.
+    bool memory_map = false;
+  };
+
   static webrtc::RtpHeaderExtensionMap GetDefaultHeaderExtensionMap();
 
   explicit ParsedRtcEventLog(
@@ -387,6 +400,20 @@ class ParsedRtcEventLog {
   // Reads an RtcEventLog from an string and returns success if successful.
   ParseStatus ParseStream(const std::string& s);
 
+  // Reads an RtcEventLog file incrementally, for logs whose events don't fit
+  // in memory all at once. The events are handed out in consecutive windows of
+  // time: `on_events` is called with the events of each window, which are
+  // discarded when it returns, so that only the events logged within about
+  // `options.max_reordering` are held in memory. The stream configurations
+  // and the start and stop events are kept for the whole log. Within a window,
+  // the events can be processed in timestamp order with RtcEventProcessor, so
+  // processing the windows in turn processes the whole log in order. Logs in
+  // the v3 format aren't supported.
+  ParseStatus ParseFileIncrementally(
+      const std::string& file_name,
+      const IncrementalParseOptions& options,
+      rtc::FunctionView<void(const ParsedRtcEventLog&)> on_events);
+
   MediaType GetMediaType(uint32_t ssrc, PacketDirection direction) const;
 
   // Configured SSRCs.
@@ -664,6 +691,23 @@ class ParsedRtcEventLog {
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternal(absl::string_view s);
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternalV3(absl::string_view s);
 
+  // Caches the configured SSRCs, groups the RTP packets by SSRC, splits the
+  // RTCP packets into blocks, and finds the first and last timestamp and the
+  // first log segment of the parsed events.
+  ABSL_MUST_USE_RESULT ParseStatus ProcessParsedEvents();
+  // Clears the lists of events that ProcessParsedEvents() derives from the
+  // parsed events.
+  void ClearProcessedEvents();
+
+  // Calls `f` with a pointer to each list of parsed events that
+  // ParseFileIncrementally() hands out in windows.
+  template <typename F>
+  void ForEachEventList(F f);
+  // Hands out the parsed events logged before `end_us` to `on_events`.
+  ABSL_MUST_USE_RESULT ParseStatus HandOutEvents(
+      int64_t end_us,
+      rtc::FunctionView<void(const ParsedRtcEventLog&)> on_events);
+
   ABSL_MUST_USE_RESULT ParseStatus
   StoreParsedLegacyEvent(const rtclog::Event& event);
 
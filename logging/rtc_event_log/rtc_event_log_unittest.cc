@@ -43,12 +43,15 @@
 #include "logging/rtc_event_log/events/rtc_event_video_send_stream_config.h"
 #include "logging/rtc_event_log/rtc_event_log_parser.h"
 #include "logging/rtc_event_log/rtc_event_log_unittest_helper.h"
+#include "logging/rtc_event_log/rtc_event_processor.h"
 #include "logging/rtc_event_log/rtc_stream_config.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/random.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/logging/memory_log_writer.h"
 #include "test/testsupport/file_utils.h"
@@ -873,6 +876,57 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(RtcEventLog::EncodingType::Legacy,
                           RtcEventLog::EncodingType::NewFormat)));
 
+class RtcEventLogParallelEncodingSession : public RtcEventLogSession {
+ private:
+  test::ScopedFieldTrials field_trials_{
+      "WebRTC-RtcEventLogParallelEncoding/encoder_queues:3/"};
+};
+
+TEST_P(RtcEventLogParallelEncodingSession, StartLoggingInTheMiddle) {
+  EventCounts count;
+  count.audio_send_streams = 3;
+  count.audio_recv_streams = 4;
+  count.video_send_streams = 5;
+  count.video_recv_streams = 6;
+  count.alr_states = 10;
+  count.audio_playouts = 500;
+  count.ana_configs = 10;
+  count.bwe_loss_events = 50;
+  count.bwe_delay_events = 50;
+  count.probe_creations = 10;
+  count.probe_successes = 5;
+  count.probe_failures = 5;
+  count.ice_configs = 10;
+  count.ice_events = 20;
+  count.incoming_rtp_packets = 1000;
+  count.outgoing_rtp_packets = 1000;
+  count.incoming_rtcp_packets = 50;
+  count.outgoing_rtcp_packets = 50;
+  if (IsNewFormat()) {
+    count.dtls_transport_states = 4;
+    count.dtls_writable_states = 5;
+    count.frame_decoded_events = 250;
+    count.generic_packets_sent = 500;
+    count.generic_packets_received = 500;
+    count.generic_acks_received = 50;
+    count.route_changes = 10;
+  }
+
+  // The events logged before the start are encoded in several chunks, and so
+  // are the later ones unless output immediately.
+  WriteLog(count, 1000);
+  ReadAndVerifyLog();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RtcEventLogTest,
+    RtcEventLogParallelEncodingSession,
+    ::testing::Combine(
+        ::testing::Values(1234567),
+        ::testing::Values(RtcEventLog::kImmediateOutput, 5),
+        ::testing::Values(RtcEventLog::EncodingType::Legacy,
+                          RtcEventLog::EncodingType::NewFormat)));
+
 class RtcEventLogCircularBufferTest
     : public ::testing::TestWithParam<RtcEventLog::EncodingType> {
  public:
@@ -976,6 +1030,108 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(RtcEventLog::EncodingType::Legacy,
                       RtcEventLog::EncodingType::NewFormat));
 
+class RtcEventLogIncrementalParseTest
+    : public ::testing::TestWithParam<
+          std::tuple<RtcEventLog::EncodingType, bool>> {
+ public:
+  RtcEventLogIncrementalParseTest()
+      : encoding_type_(std::get<0>(GetParam())),
+        memory_map_(std::get<1>(GetParam())),
+        log_output_factory_(log_storage_.CreateFactory()) {}
+  const RtcEventLog::EncodingType encoding_type_;
+  const bool memory_map_;
+  MemoryLogStorage log_storage_;
+  std::unique_ptr<LogWriterFactoryInterface> log_output_factory_;
+};
+
+TEST_P(RtcEventLogIncrementalParseTest, HandsOutEventsInOrder) {
+  constexpr size_t kNumEvents = 3000;
+  auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string test_name =
+      std::string(test_info->test_case_name()) + "_" + test_info->name();
+  std::replace(test_name.begin(), test_name.end(), '/', '_');
+  const std::string temp_filename = test::OutputPath() + test_name;
+
+  {
+    rtc::ScopedFakeClock fake_clock;
+    fake_clock.SetTime(Timestamp::Seconds(1));
+    test::EventGenerator gen(1234567);
+    auto task_queue_factory = CreateDefaultTaskQueueFactory();
+    RtcEventLogFactory rtc_event_log_factory(task_queue_factory.get());
+    std::unique_ptr<RtcEventLog> log =
+        rtc_event_log_factory.CreateRtcEventLog(encoding_type_);
+    // Output immediately, so that the events are written in timestamp order.
+    log->StartLogging(log_output_factory_->Create(temp_filename),
+                      RtcEventLog::kImmediateOutput);
+    log->Log(gen.NewAudioReceiveStreamConfig(/*ssrc=*/1,
+                                             gen.NewRtpHeaderExtensionMap()));
+    for (size_t i = 0; i < kNumEvents; ++i) {
+      fake_clock.AdvanceTime(TimeDelta::Millis(10));
+      switch (i % 3) {
+        case 0:
+          log->Log(gen.NewAlrState());
+          break;
+        case 1:
+          log->Log(gen.NewBweUpdateDelayBased());
+          break;
+        case 2:
+          log->Log(gen.NewProbeResultSuccess());
+          break;
+      }
+    }
+    log->StopLogging();
+  }
+  auto it = log_storage_.logs().find(temp_filename);
+  ASSERT_TRUE(it != log_storage_.logs().end());
+  FileWrapper file = FileWrapper::OpenWriteOnly(temp_filename);
+  ASSERT_TRUE(file.is_open());
+  ASSERT_TRUE(file.Write(it->second.data(), it->second.size()));
+  file.Close();
+
+  ParsedRtcEventLog::IncrementalParseOptions options;
+  options.max_reordering = TimeDelta::Seconds(1);
+  options.chunk_size = 1000;
+  options.memory_map = memory_map_;
+  ParsedRtcEventLog parsed_log;
+  int num_windows = 0;
+  size_t num_events = 0;
+  size_t max_events_in_window = 0;
+  int64_t last_time_us = std::numeric_limits<int64_t>::min();
+  auto on_event = [&](const auto& event) {
+    EXPECT_GE(event.log_time_us(), last_time_us);
+    last_time_us = event.log_time_us();
+    ++num_events;
+  };
+  auto on_window = [&](const ParsedRtcEventLog& window) {
+    ++num_windows;
+    EXPECT_EQ(window.audio_recv_configs().size(), 1u);
+    EXPECT_EQ(window.start_log_events().size(), 1u);
+    const size_t num_events_before = num_events;
+    RtcEventProcessor processor;
+    processor.AddEvents(window.alr_state_events(), on_event);
+    processor.AddEvents(window.bwe_delay_updates(), on_event);
+    processor.AddEvents(window.bwe_probe_success_events(), on_event);
+    processor.ProcessEventsInOrder();
+    max_events_in_window =
+        std::max(max_events_in_window, num_events - num_events_before);
+  };
+  ASSERT_TRUE(
+      parsed_log.ParseFileIncrementally(temp_filename, options, on_window)
+          .ok());
+  EXPECT_EQ(num_events, kNumEvents);
+  EXPECT_GT(num_windows, 1);
+  // The events are held for about a second, during which 100 are logged.
+  EXPECT_LT(max_events_in_window, kNumEvents / 4);
+  test::RemoveFile(temp_filename);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RtcEventLogTest,
+    RtcEventLogIncrementalParseTest,
+    ::testing::Combine(::testing::Values(RtcEventLog::EncodingType::Legacy,
+                                         RtcEventLog::EncodingType::NewFormat),
+                       ::testing::Bool()));
+
 // TODO(terelius): Verify parser behavior if the timestamps are not
 // monotonically increasing in the log.
 
@@ -10,10 +10,13 @@
 
 #include "media/base/media_channel.h"
 
+#include <utility>
+
 #include "media/base/rtp_utils.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 
 namespace cricket {
+
 using webrtc::FrameDecryptorInterface;
 using webrtc::FrameEncryptorInterface;
 using webrtc::FrameTransformerInterface;
@@ -22,6 +25,14 @@ using webrtc::TaskQueueBase;
 using webrtc::ToQueuedTask;
 using webrtc::VideoTrackInterface;
 
+namespace {
+
+// Large enough for the authentication tag of every supported SRTP crypto
+// suite (AES-GCM uses the largest, 16 bytes).
+constexpr size_t kMaxSrtpTrailerSize = 16;
+
+}  // namespace
+
 VideoOptions::VideoOptions()
     : content_hint(VideoTrackInterface::ContentHint::kNone) {}
 VideoOptions::~VideoOptions() = default;
@@ -166,11 +177,22 @@ bool MediaChannel::DoSendPacket(rtc::CopyOnWriteBuffer* packet,
 void MediaChannel::SendRtp(const uint8_t* data,
                            size_t len,
                            const webrtc::PacketOptions& options) {
+  SendRtp(rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen), options);
+}
+
+void MediaChannel::SendRtp(rtc::CopyOnWriteBuffer packet,
+                           const webrtc::PacketOptions& options) {
+  if (packet.capacity() < packet.size() + kMaxSrtpTrailerSize) {
+    // Reallocate now rather than have SRTP fail for lack of room.
+    packet.EnsureCapacity(kMaxRtpPacketLen);
+  }
   auto send =
       [this, packet_id = options.packet_id,
        included_in_feedback = options.included_in_feedback,
        included_in_allocation = options.included_in_allocation,
-       packet = rtc::CopyOnWriteBuffer(data, len, kMaxRtpPacketLen)]() mutable {
+       batchable = options.batchable,
+       last_packet_in_batch = options.last_packet_in_batch,
+       packet = std::move(packet)]() mutable {
         rtc::PacketOptions rtc_options;
         rtc_options.packet_id = packet_id;
         if (DscpEnabled()) {
@@ -180,6 +202,8 @@ void MediaChannel::SendRtp(const uint8_t* data,
             included_in_feedback;
         rtc_options.info_signaled_after_sent.included_in_allocation =
             included_in_allocation;
+        rtc_options.batchable = batchable;
+        rtc_options.last_packet_in_batch = last_packet_in_batch;
         SendPacket(&packet, rtc_options);
       };
 
@@ -295,6 +295,10 @@ class MediaChannel {
   void SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options);
+  // Same as above, but avoids copying `packet` when it has enough spare
+  // capacity for SRTP to protect it in place.
+  void SendRtp(rtc::CopyOnWriteBuffer packet,
+               const webrtc::PacketOptions& options);
 
   void SendRtcp(const uint8_t* data, size_t len);
 
@@ -654,6 +658,9 @@ struct VideoReceiverInfo : public MediaReceiverInfo {
   // Timing frame info: all important timestamps for a full lifetime of a
   // single 'timing frame'.
   absl::optional<webrtc::TimingFrameInfo> timing_frame_info;
+  // Percentiles of the delay of each pipeline stage of all timing frames,
+  // keyed by "<stage>.p50", "<stage>.p95" and "<stage>.p99".
+  std::map<std::string, double> timing_frame_stage_delays_ms;
 };
 
 struct BandwidthEstimationInfo {
@@ -116,6 +116,11 @@ class VideoEngineInterface : public RtpHeaderExtensionQueryInterface {
 
   virtual std::vector<VideoCodec> send_codecs() const = 0;
   virtual std::vector<VideoCodec> recv_codecs() const = 0;
+
+  // Drops whatever the engine remembers of the capabilities of its codec
+  // factories, so that they are queried again, e.g. after a hardware codec was
+  // added or removed.
+  virtual void ResetCodecCache() {}
 };
 
 // MediaEngineInterface is an abstraction of a media engine which can be
@@ -217,9 +217,23 @@ bool VideoAdapter::AdaptFrameResolution(int in_width,
     *cropped_height =
         std::min(in_height, static_cast<int>(in_width / requested_aspect));
   }
+  if (!cached_scale_ || cached_scale_->input_width != *cropped_width ||
+      cached_scale_->input_height != *cropped_height ||
+      cached_scale_->target_pixel_count != target_pixel_count ||
+      cached_scale_->max_pixel_count != max_pixel_count) {
+    const Fraction found_scale =
+        FindScale(*cropped_width, *cropped_height, target_pixel_count,
+                  max_pixel_count, variable_start_scale_factor_);
+    cached_scale_.emplace();
+    cached_scale_->input_width = *cropped_width;
+    cached_scale_->input_height = *cropped_height;
+    cached_scale_->target_pixel_count = target_pixel_count;
+    cached_scale_->max_pixel_count = max_pixel_count;
+    cached_scale_->numerator = found_scale.numerator;
+    cached_scale_->denominator = found_scale.denominator;
+  }
   const Fraction scale =
-      FindScale(*cropped_width, *cropped_height, target_pixel_count,
-                max_pixel_count, variable_start_scale_factor_);
+      Fraction{cached_scale_->numerator, cached_scale_->denominator};
   // Adjust cropping slightly to get correctly aligned output size and a perfect
   // scale factor.
   *cropped_width = roundUp(*cropped_width,
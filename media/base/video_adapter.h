@@ -146,6 +146,19 @@ class RTC_EXPORT VideoAdapter {
 
   webrtc::FramerateController framerate_controller_ RTC_GUARDED_BY(mutex_);
 
+  // The scale factor of the last adapted frame. The input size and the
+  // requests rarely change between frames, so that it can usually be reused
+  // without searching for a scale factor again.
+  struct CachedScale {
+    int input_width;
+    int input_height;
+    int target_pixel_count;
+    int max_pixel_count;
+    int numerator;
+    int denominator;
+  };
+  absl::optional<CachedScale> cached_scale_ RTC_GUARDED_BY(mutex_);
+
   // The critical section to protect the above variables.
   mutable webrtc::Mutex mutex_;
 };
@@ -10,6 +10,9 @@
 
 #include "media/base/video_broadcaster.h"
 
+#include <algorithm>
+#include <atomic>
+#include <string>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -17,7 +20,9 @@
 #include "api/video/video_rotation.h"
 #include "media/base/video_common.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/task_queue_work_stealing.h"
 
 namespace rtc {
 
@@ -31,7 +36,7 @@ void VideoBroadcaster::AddOrUpdateSink(
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
   if (!FindSinkPair(sink)) {
     // `Sink` is a new sink, which didn't receive previous frame.
-    previous_frame_sent_to_all_sinks_ = false;
+    sink_added_ = true;
 
     if (last_constraints_.has_value()) {
       RTC_LOG(LS_INFO) << __func__ << " forwarding stored constraints min_fps "
@@ -41,15 +46,22 @@ void VideoBroadcaster::AddOrUpdateSink(
     }
   }
   VideoSourceBase::AddOrUpdateSink(sink, wants);
+  ++sinks_version_;
   UpdateWants();
 }
 
 void VideoBroadcaster::RemoveSink(
     VideoSinkInterface<webrtc::VideoFrame>* sink) {
   RTC_DCHECK(sink != nullptr);
-  webrtc::MutexLock lock(&sinks_and_wants_lock_);
-  VideoSourceBase::RemoveSink(sink);
-  UpdateWants();
+  {
+    webrtc::MutexLock lock(&sinks_and_wants_lock_);
+    VideoSourceBase::RemoveSink(sink);
+    ++sinks_version_;
+    UpdateWants();
+  }
+  // Wait for the delivery of a frame in progress, which may still involve
+  // `sink`. Later frames go to the updated sinks.
+  webrtc::MutexLock lock(&delivery_lock_);
 }
 
 bool VideoBroadcaster::frame_wanted() const {
@@ -63,50 +75,72 @@ VideoSinkWants VideoBroadcaster::wants() const {
 }
 
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
-  webrtc::MutexLock lock(&sinks_and_wants_lock_);
-  bool current_frame_was_discarded = false;
-  for (auto& sink_pair : sink_pairs()) {
-    if (sink_pair.wants.rotation_applied &&
-        frame.rotation() != webrtc::kVideoRotation_0) {
-      // Calls to OnFrame are not synchronized with changes to the sink wants.
-      // When rotation_applied is set to true, one or a few frames may get here
-      // with rotation still pending. Protect sinks that don't expect any
-      // pending rotation.
-      RTC_LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
-      sink_pair.sink->OnDiscardedFrame();
-      current_frame_was_discarded = true;
-      continue;
-    }
-    if (sink_pair.wants.black_frames) {
-      webrtc::VideoFrame black_frame =
-          webrtc::VideoFrame::Builder()
-              .set_video_frame_buffer(
-                  GetBlackFrameBuffer(frame.width(), frame.height()))
-              .set_rotation(frame.rotation())
-              .set_timestamp_us(frame.timestamp_us())
-              .set_id(frame.id())
-              .build();
-      sink_pair.sink->OnFrame(black_frame);
-    } else if (!previous_frame_sent_to_all_sinks_ && frame.has_update_rect()) {
-      // Since last frame was not sent to some sinks, no reliable update
-      // information is available, so we need to clear the update rect.
-      webrtc::VideoFrame copy = frame;
-      copy.clear_update_rect();
-      sink_pair.sink->OnFrame(copy);
-    } else {
-      sink_pair.sink->OnFrame(frame);
-    }
+  webrtc::MutexLock lock(&delivery_lock_);
+  UpdateDeliverySinks();
+  const std::vector<SinkPair>& sinks = delivery_sinks_;
+  const bool clear_update_rect =
+      !previous_frame_sent_to_all_sinks_ && frame.has_update_rect();
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer;
+  if (std::any_of(sinks.begin(), sinks.end(), [](const SinkPair& sink_pair) {
+        return sink_pair.wants.black_frames;
+      })) {
+    black_frame_buffer = GetBlackFrameBuffer(frame.width(), frame.height());
+  }
+
+  if (delivery_queues_.empty() || sinks.size() < 2) {
+    previous_frame_sent_to_all_sinks_ = DeliverFrame(
+        frame, clear_update_rect, black_frame_buffer, sinks, 0, sinks.size());
+    return;
   }
-  previous_frame_sent_to_all_sinks_ = !current_frame_was_discarded;
+
+  // Split the sinks into contiguous chunks, one per queue plus one for the
+  // calling thread, and wait for all of them.
+  const size_t num_chunks = std::min(delivery_queues_.size() + 1, sinks.size());
+  std::atomic<size_t> pending_chunks(num_chunks - 1);
+  std::atomic<bool> delivered_to_all_sinks(true);
+  rtc::Event done;
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const size_t begin = i * sinks.size() / num_chunks;
+    const size_t end = (i + 1) * sinks.size() / num_chunks;
+    delivery_queues_[i - 1]->PostTask([&, begin, end] {
+      if (!DeliverFrame(frame, clear_update_rect, black_frame_buffer, sinks,
+                        begin, end)) {
+        delivered_to_all_sinks = false;
+      }
+      if (pending_chunks.fetch_sub(1) == 1)
+        done.Set();
+    });
+  }
+  if (!DeliverFrame(frame, clear_update_rect, black_frame_buffer, sinks, 0,
+                    sinks.size() / num_chunks)) {
+    delivered_to_all_sinks = false;
+  }
+  done.Wait(rtc::Event::kForever);
+  previous_frame_sent_to_all_sinks_ = delivered_to_all_sinks;
 }
 
 void VideoBroadcaster::OnDiscardedFrame() {
-  webrtc::MutexLock lock(&sinks_and_wants_lock_);
-  for (auto& sink_pair : sink_pairs()) {
+  webrtc::MutexLock lock(&delivery_lock_);
+  UpdateDeliverySinks();
+  for (auto& sink_pair : delivery_sinks_) {
     sink_pair.sink->OnDiscardedFrame();
   }
 }
 
+void VideoBroadcaster::EnableParallelDelivery(int num_queues) {
+  RTC_DCHECK_GT(num_queues, 0);
+  webrtc::MutexLock lock(&delivery_lock_);
+  RTC_DCHECK(delivery_queues_.empty());
+  delivery_queue_factory_ =
+      webrtc::CreateTaskQueueWorkStealingFactory(num_queues);
+  for (int i = 0; i < num_queues; ++i) {
+    delivery_queues_.push_back(std::make_unique<rtc::TaskQueue>(
+        delivery_queue_factory_->CreateTaskQueue(
+            "VideoBroadcaster" + std::to_string(i),
+            webrtc::TaskQueueFactory::Priority::HIGH)));
+  }
+}
+
 void VideoBroadcaster::ProcessConstraints(
     const webrtc::VideoTrackSourceConstraints& constraints) {
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
@@ -156,6 +190,61 @@ void VideoBroadcaster::UpdateWants() {
   current_wants_ = wants;
 }
 
+void VideoBroadcaster::UpdateDeliverySinks() {
+  webrtc::MutexLock lock(&sinks_and_wants_lock_);
+  if (sink_added_) {
+    sink_added_ = false;
+    previous_frame_sent_to_all_sinks_ = false;
+  }
+  if (delivery_sinks_version_ == sinks_version_)
+    return;
+  delivery_sinks_ = sink_pairs();
+  delivery_sinks_version_ = sinks_version_;
+}
+
+bool VideoBroadcaster::DeliverFrame(
+    const webrtc::VideoFrame& frame,
+    bool clear_update_rect,
+    const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& black_frame_buffer,
+    const std::vector<SinkPair>& sinks,
+    size_t begin,
+    size_t end) {
+  bool delivered_to_all_sinks = true;
+  for (size_t i = begin; i < end; ++i) {
+    const SinkPair& sink_pair = sinks[i];
+    if (sink_pair.wants.rotation_applied &&
+        frame.rotation() != webrtc::kVideoRotation_0) {
+      // Calls to OnFrame are not synchronized with changes to the sink wants.
+      // When rotation_applied is set to true, one or a few frames may get here
+      // with rotation still pending. Protect sinks that don't expect any
+      // pending rotation.
+      RTC_LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
+      sink_pair.sink->OnDiscardedFrame();
+      delivered_to_all_sinks = false;
+      continue;
+    }
+    if (sink_pair.wants.black_frames) {
+      webrtc::VideoFrame black_frame =
+          webrtc::VideoFrame::Builder()
+              .set_video_frame_buffer(black_frame_buffer)
+              .set_rotation(frame.rotation())
+              .set_timestamp_us(frame.timestamp_us())
+              .set_id(frame.id())
+              .build();
+      sink_pair.sink->OnFrame(black_frame);
+    } else if (clear_update_rect) {
+      // Since last frame was not sent to some sinks, no reliable update
+      // information is available, so we need to clear the update rect.
+      webrtc::VideoFrame copy = frame;
+      copy.clear_update_rect();
+      sink_pair.sink->OnFrame(copy);
+    } else {
+      sink_pair.sink->OnFrame(frame);
+    }
+  }
+  return delivered_to_all_sinks;
+}
+
 const rtc::scoped_refptr<webrtc::VideoFrameBuffer>&
 VideoBroadcaster::GetBlackFrameBuffer(int width, int height) {
   if (!black_frame_buffer_ || black_frame_buffer_->width() != width ||
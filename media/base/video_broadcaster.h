@@ -11,13 +11,18 @@
 #ifndef MEDIA_BASE_VIDEO_BROADCASTER_H_
 #define MEDIA_BASE_VIDEO_BROADCASTER_H_
 
+#include <memory>
+#include <vector>
+
 #include "api/media_stream_interface.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_source_interface.h"
 #include "media/base/video_source_base.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace rtc {
@@ -27,6 +32,11 @@ namespace rtc {
 // rtc::VideoSinkInterface. The class is threadsafe; methods may be called on
 // any thread. This is needed because VideoStreamEncoder calls AddOrUpdateSink
 // both on the worker thread and on the encoder task queue.
+//
+// Frames are delivered to a copy of the sink list that is only refreshed when
+// sinks change, so that AddOrUpdateSink, wants() and frame_wanted() do not wait
+// for the delivery of a frame. RemoveSink does, so that a removed sink gets no
+// more frames once it returns.
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<webrtc::VideoFrame> {
  public:
@@ -56,6 +66,13 @@ class VideoBroadcaster : public VideoSourceBase,
 
   void OnDiscardedFrame() override;
 
+  // Delivers each frame to the sinks concurrently, on `num_queues` task queues
+  // sharing as many threads, as well as on the calling thread. OnFrame still
+  // returns once all sinks got the frame, so every sink gets the frames in
+  // order and never concurrently, but not necessarily on the same thread.
+  // Suits sources with many sinks, none of which may block on another.
+  void EnableParallelDelivery(int num_queues);
+
   // Called on the network thread when constraints change. Forwards the
   // constraints to sinks added with AddOrUpdateSink via OnConstraintsChanged.
   void ProcessConstraints(
@@ -65,16 +82,41 @@ class VideoBroadcaster : public VideoSourceBase,
   void UpdateWants() RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
   const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& GetBlackFrameBuffer(
       int width,
-      int height) RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+      int height) RTC_EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
 
+  // Refreshes `delivery_sinks_` if the sinks changed since the last call.
+  void UpdateDeliverySinks() RTC_EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
+  // Delivers `frame` to `sinks[begin, end)`. Returns false if the frame was
+  // discarded for any of them.
+  static bool DeliverFrame(
+      const webrtc::VideoFrame& frame,
+      bool clear_update_rect,
+      const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& black_frame_buffer,
+      const std::vector<SinkPair>& sinks,
+      size_t begin,
+      size_t end);
+
+  // Serializes frame delivery. Taken before `sinks_and_wants_lock_`.
+  webrtc::Mutex delivery_lock_;
   mutable webrtc::Mutex sinks_and_wants_lock_;
 
   VideoSinkWants current_wants_ RTC_GUARDED_BY(sinks_and_wants_lock_);
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
-  bool previous_frame_sent_to_all_sinks_ RTC_GUARDED_BY(sinks_and_wants_lock_) =
-      true;
+  // Incremented whenever the sinks or their wants change.
+  int sinks_version_ RTC_GUARDED_BY(sinks_and_wants_lock_) = 0;
+  // Set when a sink is added, which did not receive the previous frame.
+  bool sink_added_ RTC_GUARDED_BY(sinks_and_wants_lock_) = false;
   absl::optional<webrtc::VideoTrackSourceConstraints> last_constraints_
       RTC_GUARDED_BY(sinks_and_wants_lock_);
+
+  std::vector<SinkPair> delivery_sinks_ RTC_GUARDED_BY(delivery_lock_);
+  int delivery_sinks_version_ RTC_GUARDED_BY(delivery_lock_) = 0;
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_
+      RTC_GUARDED_BY(delivery_lock_);
+  bool previous_frame_sent_to_all_sinks_ RTC_GUARDED_BY(delivery_lock_) = true;
+  std::unique_ptr<webrtc::TaskQueueFactory> delivery_queue_factory_
+      RTC_GUARDED_BY(delivery_lock_);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> delivery_queues_
+      RTC_GUARDED_BY(delivery_lock_);
 };
 
 }  // namespace rtc
@@ -251,6 +251,82 @@ TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   EXPECT_EQ(30, sink2.timestamp_us());
 }
 
+TEST(VideoBroadcasterTest, DeliversInParallelToAllSinks) {
+  VideoBroadcaster broadcaster;
+  broadcaster.EnableParallelDelivery(/*num_queues=*/2);
+
+  FakeVideoRenderer sinks[5];
+  for (FakeVideoRenderer& sink : sinks)
+    broadcaster.AddOrUpdateSink(&sink, VideoSinkWants());
+  VideoSinkWants black_wants;
+  black_wants.black_frames = true;
+  broadcaster.AddOrUpdateSink(&sinks[3], black_wants);
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 200));
+  // Makes it not all black.
+  buffer->InitializeData();
+  for (int64_t timestamp_us = 10; timestamp_us <= 30; timestamp_us += 10) {
+    broadcaster.OnFrame(webrtc::VideoFrame::Builder()
+                            .set_video_frame_buffer(buffer)
+                            .set_rotation(webrtc::kVideoRotation_0)
+                            .set_timestamp_us(timestamp_us)
+                            .build());
+  }
+
+  // OnFrame returns once all sinks got the frame.
+  for (const FakeVideoRenderer& sink : sinks) {
+    EXPECT_EQ(3, sink.num_rendered_frames());
+    EXPECT_EQ(30, sink.timestamp_us());
+    EXPECT_EQ(&sink == &sinks[3], sink.black_frame());
+  }
+
+  broadcaster.RemoveSink(&sinks[0]);
+  broadcaster.OnFrame(webrtc::VideoFrame::Builder()
+                          .set_video_frame_buffer(buffer)
+                          .set_rotation(webrtc::kVideoRotation_0)
+                          .set_timestamp_us(40)
+                          .build());
+  EXPECT_EQ(3, sinks[0].num_rendered_frames());
+  EXPECT_EQ(4, sinks[1].num_rendered_frames());
+}
+
+TEST(VideoBroadcasterTest, SinkMayUpdateItsWantsWhileGettingAFrame) {
+  class WantsBlackFramesSink : public FakeVideoRenderer {
+   public:
+    explicit WantsBlackFramesSink(VideoBroadcaster* broadcaster)
+        : broadcaster_(broadcaster) {}
+
+    void OnFrame(const webrtc::VideoFrame& frame) override {
+      FakeVideoRenderer::OnFrame(frame);
+      VideoSinkWants wants;
+      wants.black_frames = true;
+      broadcaster_->AddOrUpdateSink(this, wants);
+    }
+
+   private:
+    VideoBroadcaster* const broadcaster_;
+  };
+
+  VideoBroadcaster broadcaster;
+  WantsBlackFramesSink sink(&broadcaster);
+  broadcaster.AddOrUpdateSink(&sink, VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 200));
+  // Makes it not all black.
+  buffer->InitializeData();
+  webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
+                                 .set_video_frame_buffer(buffer)
+                                 .set_rotation(webrtc::kVideoRotation_0)
+                                 .set_timestamp_us(10)
+                                 .build();
+  broadcaster.OnFrame(frame);
+  EXPECT_FALSE(sink.black_frame());
+  broadcaster.OnFrame(frame);
+  EXPECT_TRUE(sink.black_frame());
+}
+
 TEST(VideoBroadcasterTest, ConstraintsChangedNotCalledOnSinkAddition) {
   MockSink sink;
   VideoBroadcaster broadcaster;
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/caching_video_codec_factory.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+CachingVideoEncoderFactory::CachingVideoEncoderFactory(
+    std::unique_ptr<VideoEncoderFactory> factory)
+    : factory_(std::move(factory)) {
+  RTC_DCHECK(factory_);
+}
+
+std::vector<SdpVideoFormat> CachingVideoEncoderFactory::GetSupportedFormats()
+    const {
+  MutexLock lock(&mutex_);
+  if (!supported_formats_)
+    supported_formats_ = factory_->GetSupportedFormats();
+  return *supported_formats_;
+}
+
+std::vector<SdpVideoFormat> CachingVideoEncoderFactory::GetImplementations()
+    const {
+  MutexLock lock(&mutex_);
+  if (!implementations_)
+    implementations_ = factory_->GetImplementations();
+  return *implementations_;
+}
+
+VideoEncoderFactory::CodecSupport CachingVideoEncoderFactory::QueryCodecSupport(
+    const SdpVideoFormat& format,
+    absl::optional<std::string> scalability_mode) const {
+  return factory_->QueryCodecSupport(format, std::move(scalability_mode));
+}
+
+std::unique_ptr<VideoEncoder> CachingVideoEncoderFactory::CreateVideoEncoder(
+    const SdpVideoFormat& format) {
+  return factory_->CreateVideoEncoder(format);
+}
+
+std::unique_ptr<VideoEncoderFactory::EncoderSelectorInterface>
+CachingVideoEncoderFactory::GetEncoderSelector() const {
+  return factory_->GetEncoderSelector();
+}
+
+void CachingVideoEncoderFactory::Invalidate() {
+  MutexLock lock(&mutex_);
+  supported_formats_ = absl::nullopt;
+  implementations_ = absl::nullopt;
+}
+
+CachingVideoDecoderFactory::CachingVideoDecoderFactory(
+    std::unique_ptr<VideoDecoderFactory> factory)
+    : factory_(std::move(factory)) {
+  RTC_DCHECK(factory_);
+}
+
+std::vector<SdpVideoFormat> CachingVideoDecoderFactory::GetSupportedFormats()
+    const {
+  MutexLock lock(&mutex_);
+  if (!supported_formats_)
+    supported_formats_ = factory_->GetSupportedFormats();
+  return *supported_formats_;
+}
+
+VideoDecoderFactory::CodecSupport CachingVideoDecoderFactory::QueryCodecSupport(
+    const SdpVideoFormat& format,
+    bool reference_scaling) const {
+  return factory_->QueryCodecSupport(format, reference_scaling);
+}
+
+std::unique_ptr<VideoDecoder> CachingVideoDecoderFactory::CreateVideoDecoder(
+    const SdpVideoFormat& format) {
+  return factory_->CreateVideoDecoder(format);
+}
+
+void CachingVideoDecoderFactory::Invalidate() {
+  MutexLock lock(&mutex_);
+  supported_formats_ = absl::nullopt;
+}
+
+}  // namespace webrtc
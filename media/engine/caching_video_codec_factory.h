@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_CACHING_VIDEO_CODEC_FACTORY_H_
+#define MEDIA_ENGINE_CACHING_VIDEO_CODEC_FACTORY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "api/video_codecs/video_encoder.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Wraps a VideoEncoderFactory and remembers the formats it returned the first
+// time they were asked for. Factories of hardware codecs may probe the device
+// every time, while the engine asks for the formats on every offer/answer.
+// Invalidate() makes the next call query the wrapped factory again, e.g.
+// after a device was plugged in. Everything else is forwarded as is.
+class RTC_EXPORT CachingVideoEncoderFactory : public VideoEncoderFactory {
+ public:
+  explicit CachingVideoEncoderFactory(
+      std::unique_ptr<VideoEncoderFactory> factory);
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  std::vector<SdpVideoFormat> GetImplementations() const override;
+  CodecSupport QueryCodecSupport(
+      const SdpVideoFormat& format,
+      absl::optional<std::string> scalability_mode) const override;
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override;
+  std::unique_ptr<EncoderSelectorInterface> GetEncoderSelector()
+      const override;
+
+  void Invalidate();
+
+ private:
+  const std::unique_ptr<VideoEncoderFactory> factory_;
+  mutable Mutex mutex_;
+  mutable absl::optional<std::vector<SdpVideoFormat>> supported_formats_
+      RTC_GUARDED_BY(mutex_);
+  mutable absl::optional<std::vector<SdpVideoFormat>> implementations_
+      RTC_GUARDED_BY(mutex_);
+};
+
+// Same as above, for decoders.
+class RTC_EXPORT CachingVideoDecoderFactory : public VideoDecoderFactory {
+ public:
+  explicit CachingVideoDecoderFactory(
+      std::unique_ptr<VideoDecoderFactory> factory);
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  CodecSupport QueryCodecSupport(const SdpVideoFormat& format,
+                                 bool reference_scaling) const override;
+  std::unique_ptr<VideoDecoder> CreateVideoDecoder(
+      const SdpVideoFormat& format) override;
+
+  void Invalidate();
+
+ private:
+  const std::unique_ptr<VideoDecoderFactory> factory_;
+  mutable Mutex mutex_;
+  mutable absl::optional<std::vector<SdpVideoFormat>> supported_formats_
+      RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_CACHING_VIDEO_CODEC_FACTORY_H_
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/caching_video_codec_factory.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/test/mock_video_decoder_factory.h"
+#include "api/test/mock_video_encoder_factory.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+TEST(CachingVideoEncoderFactory, QueriesFormatsOnceUntilInvalidated) {
+  auto mock_factory = std::make_unique<MockVideoEncoderFactory>();
+  MockVideoEncoderFactory* mock = mock_factory.get();
+  CachingVideoEncoderFactory factory(std::move(mock_factory));
+
+  // The default GetImplementations() of the wrapped factory asks for the
+  // supported formats as well.
+  EXPECT_CALL(*mock, GetSupportedFormats())
+      .Times(2)
+      .WillRepeatedly(
+          Return(std::vector<SdpVideoFormat>{SdpVideoFormat("VP8")}));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("VP8")));
+  EXPECT_THAT(factory.GetImplementations(), ElementsAre(SdpVideoFormat("VP8")));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("VP8")));
+  EXPECT_THAT(factory.GetImplementations(), ElementsAre(SdpVideoFormat("VP8")));
+  ::testing::Mock::VerifyAndClearExpectations(mock);
+
+  factory.Invalidate();
+  EXPECT_CALL(*mock, GetSupportedFormats())
+      .WillOnce(Return(std::vector<SdpVideoFormat>{SdpVideoFormat("VP9")}));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("VP9")));
+  EXPECT_CALL(*mock, Die);
+}
+
+TEST(CachingVideoDecoderFactory, QueriesFormatsOnceUntilInvalidated) {
+  auto mock_factory = std::make_unique<MockVideoDecoderFactory>();
+  MockVideoDecoderFactory* mock = mock_factory.get();
+  CachingVideoDecoderFactory factory(std::move(mock_factory));
+
+  EXPECT_CALL(*mock, GetSupportedFormats())
+      .WillOnce(Return(std::vector<SdpVideoFormat>{SdpVideoFormat("VP8")}));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("VP8")));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("VP8")));
+  ::testing::Mock::VerifyAndClearExpectations(mock);
+
+  factory.Invalidate();
+  EXPECT_CALL(*mock, GetSupportedFormats())
+      .WillOnce(Return(std::vector<SdpVideoFormat>{SdpVideoFormat("H264")}));
+  EXPECT_THAT(factory.GetSupportedFormats(),
+              ElementsAre(SdpVideoFormat("H264")));
+  EXPECT_CALL(*mock, Die);
+}
+
+TEST(CachingVideoDecoderFactory, ForwardsDecoderCreation) {
+  auto mock_factory = std::make_unique<MockVideoDecoderFactory>();
+  MockVideoDecoderFactory* mock = mock_factory.get();
+  CachingVideoDecoderFactory factory(std::move(mock_factory));
+
+  EXPECT_CALL(*mock, CreateVideoDecoder(SdpVideoFormat("VP8")));
+  factory.CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_CALL(*mock, Die);
+}
+
+}  // namespace
+}  // namespace webrtc
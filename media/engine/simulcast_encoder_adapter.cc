@@ -14,11 +14,14 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/cleanup/cleanup.h"
+#include "absl/container/inlined_vector.h"
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_codec_constants.h"
@@ -32,8 +35,10 @@
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/task_queue_work_stealing.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace {
@@ -87,6 +92,28 @@ int CountActiveStreams(const webrtc::VideoCodec& codec) {
   return active_streams_count;
 }
 
+using PixelFormats = absl::InlinedVector<webrtc::VideoFrameBuffer::Type,
+                                         webrtc::kMaxPreferredPixelFormats>;
+
+// An empty list of preferred pixel formats means I420.
+PixelFormats PreferredPixelFormats(
+    const webrtc::VideoEncoder::EncoderInfo& info) {
+  if (info.preferred_pixel_formats.empty())
+    return {webrtc::VideoFrameBuffer::Type::kI420};
+  return info.preferred_pixel_formats;
+}
+
+// Removes the formats of `formats` that are not preferred by `info`.
+void IntersectPixelFormats(const webrtc::VideoEncoder::EncoderInfo& info,
+                           PixelFormats* formats) {
+  const PixelFormats other = PreferredPixelFormats(info);
+  formats->erase(std::remove_if(formats->begin(), formats->end(),
+                                [&](webrtc::VideoFrameBuffer::Type type) {
+                                  return !absl::c_linear_search(other, type);
+                                }),
+                 formats->end());
+}
+
 int VerifyCodec(const webrtc::VideoCodec* inst) {
   if (inst == nullptr) {
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
@@ -193,7 +220,9 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(StreamContext&& rhs)
       width_(rhs.width_),
       height_(rhs.height_),
       is_keyframe_needed_(rhs.is_keyframe_needed_),
-      is_paused_(rhs.is_paused_) {
+      is_paused_(rhs.is_paused_),
+      encode_queue_(std::move(rhs.encode_queue_)) {
+  RTC_DCHECK(!rhs.defer_callbacks_);
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -226,11 +255,31 @@ bool SimulcastEncoderAdapter::StreamContext::ShouldDropFrame(
   return framerate_controller_->ShouldDropFrame(timestamp.us() * 1000);
 }
 
+void SimulcastEncoderAdapter::StreamContext::DeferCallbacks() {
+  RTC_DCHECK(parent_);
+  defer_callbacks_ = true;
+}
+
+void SimulcastEncoderAdapter::StreamContext::ReleaseDeferredCallbacks() {
+  defer_callbacks_ = false;
+  for (const auto& image : deferred_images_) {
+    parent_->OnEncodedImage(stream_idx_, image.first, &image.second);
+  }
+  deferred_images_.clear();
+  for (; deferred_dropped_frames_ > 0; --deferred_dropped_frames_) {
+    parent_->OnDroppedFrame(stream_idx_);
+  }
+}
+
 EncodedImageCallback::Result
 SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (defer_callbacks_) {
+    deferred_images_.emplace_back(encoded_image, *codec_specific_info);
+    return Result(Result::OK, encoded_image.Timestamp());
+  }
   return parent_->OnEncodedImage(stream_idx_, encoded_image,
                                  codec_specific_info);
 }
@@ -238,6 +287,10 @@ SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
 void SimulcastEncoderAdapter::StreamContext::OnDroppedFrame(
     DropReason /*reason*/) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (defer_callbacks_) {
+    ++deferred_dropped_frames_;
+    return;
+  }
   parent_->OnDroppedFrame(stream_idx_);
 }
 
@@ -260,7 +313,9 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
                                     .Vp8BoostBaseLayerQuality()),
       prefer_temporal_support_on_base_layer_(field_trial::IsEnabled(
-          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")) {
+          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")),
+      parallel_encoding_enabled_(
+          field_trial::IsEnabled("WebRTC-Video-ParallelSimulcastEncoding")) {
   RTC_DCHECK(primary_factory);
 
   // The adapter is typically created on the worker thread, but operated on
@@ -290,6 +345,7 @@ int SimulcastEncoderAdapter::Release() {
   }
 
   bypass_mode_ = false;
+  encode_in_parallel_ = false;
 
   // It's legal to move the encoder to another queue now.
   encoder_queue_.Detach();
@@ -421,6 +477,27 @@ int SimulcastEncoderAdapter::InitEncode(
         stream_idx, stream_codec.width, stream_codec.height, is_paused);
   }
 
+  // Software encoders deliver their encoded images from within Encode(), so
+  // the layers can be encoded concurrently, each on a queue of its own.
+  encode_in_parallel_ =
+      parallel_encoding_enabled_ && settings.number_of_cores > 1 &&
+      stream_contexts_.size() > 1 &&
+      absl::c_none_of(stream_contexts_, [](const StreamContext& layer) {
+        return layer.encoder().GetEncoderInfo().is_hardware_accelerated;
+      });
+  if (encode_in_parallel_) {
+    if (!encode_queue_factory_) {
+      encode_queue_factory_ =
+          CreateTaskQueueWorkStealingFactory(kMaxSimulcastStreams - 1);
+    }
+    // The first layer of a frame is encoded on the calling thread.
+    for (size_t i = 1; i < stream_contexts_.size(); ++i) {
+      stream_contexts_[i].set_encode_queue(std::make_unique<rtc::TaskQueue>(
+          encode_queue_factory_->CreateTaskQueue(
+              "SimulcastLayerEncoder", TaskQueueFactory::Priority::HIGH)));
+    }
+  }
+
   // To save memory, don't store encoders that we don't use.
   DestroyStoredEncoders();
 
@@ -483,12 +560,51 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
   int src_width = input_image.width();
   int src_height = input_image.height();
 
-  for (auto& layer : stream_contexts_) {
+  // Layers that need scaling are scaled from the next larger layer rather
+  // than from the input.
+  std::vector<SimulcastFrameScaler::Resolution> layer_resolutions;
+  layer_resolutions.reserve(stream_contexts_.size());
+  for (const auto& layer : stream_contexts_) {
+    layer_resolutions.push_back({layer.width(), layer.height()});
+  }
+  // Native frames are mapped once to a format that the layers without native
+  // support prefer, so that these layers are scaled in that format, rather
+  // than by the native buffer, which may convert to I420.
+  rtc::scoped_refptr<VideoFrameBuffer> scaler_input =
+      input_image.video_frame_buffer();
+  bool input_mapped = false;
+  if (scaler_input->type() == VideoFrameBuffer::Type::kNative) {
+    absl::optional<PixelFormats> formats;
+    for (const auto& layer : stream_contexts_) {
+      const EncoderInfo info = layer.encoder().GetEncoderInfo();
+      if (layer.is_paused() || info.supports_native_handle)
+        continue;
+      if (!formats)
+        formats = PreferredPixelFormats(info);
+      else
+        IntersectPixelFormats(info, &*formats);
+    }
+    if (formats && !formats->empty()) {
+      rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+          scaler_input->GetMappedFrameBuffer(*formats);
+      if (mapped_buffer) {
+        scaler_input = std::move(mapped_buffer);
+        input_mapped = true;
+      }
+    }
+  }
+  frame_scaler_.SetInput(scaler_input, layer_resolutions);
+  absl::Cleanup release_scaled_buffers = [this] { frame_scaler_.Clear(); };
+
+  // In parallel mode, the layers are encoded after the loop.
+  std::vector<LayerEncode> layer_encodes;
+
+  for (size_t layer_index = 0; layer_index < stream_contexts_.size();
+       ++layer_index) {
+    StreamContext& layer = stream_contexts_[layer_index];
     // Don't encode frames in resolutions that we don't intend to send.
     if (layer.is_paused()) {
       continue;
@@ -525,40 +641,87 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
-      }
+    // A mapped input is passed on instead of the native one to the layers
+    // that it was mapped for.
+    VideoFrame frame(input_image);
+    const bool needs_scaling =
+        layer.width() != src_width || layer.height() != src_height;
+    const bool uses_native_input =
+        input_image.video_frame_buffer()->type() ==
+            VideoFrameBuffer::Type::kNative &&
+        layer.encoder().GetEncoderInfo().supports_native_handle;
+    if ((needs_scaling || input_mapped) && !uses_native_input) {
       rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
+          frame_scaler_.Scale(layer_index);
       if (!dst_buffer) {
         RTC_LOG(LS_ERROR) << "Failed to scale video frame";
         return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
       }
 
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
       frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
+      if (needs_scaling) {
+        // UpdateRect is not propagated to lower simulcast layers currently.
+        // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+        frame.set_rotation(webrtc::kVideoRotation_0);
+        frame.set_update_rect(
+            VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
       }
     }
+
+    if (encode_in_parallel_) {
+      layer_encodes.push_back(
+          {&layer, std::move(frame), std::move(stream_frame_types)});
+      continue;
+    }
+    int ret = layer.encoder().Encode(frame, &stream_frame_types);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
   }
 
-  return WEBRTC_VIDEO_CODEC_OK;
+  return EncodeInParallel(layer_encodes);
+}
+
+int SimulcastEncoderAdapter::EncodeInParallel(
+    std::vector<LayerEncode>& layer_encodes) {
+  if (layer_encodes.empty()) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // The first layer is encoded on this thread, and its encoded images are
+  // delivered right away. The other layers are encoded on their own queues,
+  // holding back their encoded images until all layers are done, so that the
+  // images are still delivered in layer order.
+  std::vector<int> results(layer_encodes.size(), WEBRTC_VIDEO_CODEC_OK);
+  std::atomic<size_t> pending_encodes(layer_encodes.size() - 1);
+  rtc::Event encodes_done;
+  for (size_t i = 1; i < layer_encodes.size(); ++i) {
+    layer_encodes[i].layer->DeferCallbacks();
+    layer_encodes[i].layer->encode_queue()->PostTask([&, i] {
+      LayerEncode& layer_encode = layer_encodes[i];
+      results[i] = layer_encode.layer->encoder().Encode(
+          layer_encode.frame, &layer_encode.frame_types);
+      if (--pending_encodes == 0) {
+        encodes_done.Set();
+      }
+    });
+  }
+  results[0] = layer_encodes[0].layer->encoder().Encode(
+      layer_encodes[0].frame, &layer_encodes[0].frame_types);
+  if (layer_encodes.size() > 1) {
+    encodes_done.Wait(rtc::Event::kForever);
+  }
+
+  int ret = WEBRTC_VIDEO_CODEC_OK;
+  for (size_t i = 0; i < layer_encodes.size(); ++i) {
+    if (i > 0) {
+      layer_encodes[i].layer->ReleaseDeferredCallbacks();
+    }
+    if (ret == WEBRTC_VIDEO_CODEC_OK) {
+      ret = results[i];
+    }
+  }
+  return ret;
 }
 
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -897,6 +1060,8 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_hardware_accelerated =
           encoder_impl_info.is_hardware_accelerated;
       encoder_info.is_qp_trusted = encoder_impl_info.is_qp_trusted;
+      encoder_info.preferred_pixel_formats =
+          PreferredPixelFormats(encoder_impl_info);
     } else {
       encoder_info.implementation_name += ", ";
       encoder_info.implementation_name += encoder_impl_info.implementation_name;
@@ -921,6 +1086,11 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_qp_trusted =
           encoder_info.is_qp_trusted.value_or(true) &&
           encoder_impl_info.is_qp_trusted.value_or(true);
+
+      // Pixel formats preferred by all encoders, so that none of them has to
+      // convert the frame.
+      IntersectPixelFormats(encoder_impl_info,
+                            &encoder_info.preferred_pixel_formats);
     }
     encoder_info.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
     encoder_info.requested_resolution_alignment = cricket::LeastCommonMultiple(
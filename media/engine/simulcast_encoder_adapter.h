@@ -22,15 +22,20 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "common_video/framerate_controller.h"
+#include "common_video/simulcast_frame_scaler.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -131,6 +136,16 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     void OnKeyframe(Timestamp timestamp);
     bool ShouldDropFrame(Timestamp timestamp);
 
+    // The queue that the encoder runs on when layers are encoded in parallel.
+    rtc::TaskQueue* encode_queue() { return encode_queue_.get(); }
+    void set_encode_queue(std::unique_ptr<rtc::TaskQueue> encode_queue) {
+      encode_queue_ = std::move(encode_queue);
+    }
+    // Holds back the encoded images and dropped frames reported by the encoder
+    // until ReleaseDeferredCallbacks() passes them on to the parent.
+    void DeferCallbacks();
+    void ReleaseDeferredCallbacks();
+
    private:
     SimulcastEncoderAdapter* const parent_;
     std::unique_ptr<EncoderContext> encoder_context_;
@@ -140,6 +155,17 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    bool defer_callbacks_ = false;
+    std::vector<std::pair<EncodedImage, CodecSpecificInfo>> deferred_images_;
+    int deferred_dropped_frames_ = 0;
+    // Destroyed first, so that no encode is running while the encoder is.
+    std::unique_ptr<rtc::TaskQueue> encode_queue_;
+  };
+
+  struct LayerEncode {
+    StreamContext* layer;
+    VideoFrame frame;
+    std::vector<VideoFrameType> frame_types;
   };
 
   bool Initialized() const;
@@ -165,6 +191,10 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void OnDroppedFrame(size_t stream_idx);
 
+  // Encodes the frames of `layer_encodes` concurrently, and returns the first
+  // error of them in layer order.
+  int EncodeInParallel(std::vector<LayerEncode>& layer_encodes);
+
   void OverrideFromFieldTrial(VideoEncoder::EncoderInfo* info) const;
 
   volatile int inited_;  // Accessed atomically.
@@ -174,8 +204,13 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   VideoCodec codec_;
   int total_streams_count_;
   bool bypass_mode_;
+  // Set when the layers are encoded concurrently, on the queues of
+  // `encode_queue_factory_`.
+  bool encode_in_parallel_ = false;
+  std::unique_ptr<TaskQueueFactory> encode_queue_factory_;
   std::vector<StreamContext> stream_contexts_;
   EncodedImageCallback* encoded_complete_callback_;
+  SimulcastFrameScaler frame_scaler_;
 
   // Used for checking the single-threaded access of the encoder interface.
   RTC_NO_UNIQUE_ADDRESS SequenceChecker encoder_queue_;
@@ -189,6 +224,7 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
   const bool boost_base_layer_quality_;
   const bool prefer_temporal_support_on_base_layer_;
+  const bool parallel_encoding_enabled_;
 
   const SimulcastEncoderAdapterEncoderInfoSettings encoder_info_override_;
 };
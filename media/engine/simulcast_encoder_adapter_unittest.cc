@@ -29,9 +29,12 @@
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/mappable_native_buffer.h"
 
 using ::testing::_;
 using ::testing::Return;
@@ -245,6 +248,7 @@ class MockVideoEncoder : public VideoEncoder {
     info.fps_allocation[0] = fps_allocation_;
     info.supports_simulcast = supports_simulcast_;
     info.is_qp_trusted = is_qp_trusted_;
+    info.preferred_pixel_formats = preferred_pixel_formats_;
     return info;
   }
 
@@ -312,6 +316,12 @@ class MockVideoEncoder : public VideoEncoder {
     is_qp_trusted_ = is_qp_trusted;
   }
 
+  void set_preferred_pixel_formats(
+      std::vector<VideoFrameBuffer::Type> preferred_pixel_formats) {
+    preferred_pixel_formats_.assign(preferred_pixel_formats.begin(),
+                                    preferred_pixel_formats.end());
+  }
+
   bool supports_simulcast() const { return supports_simulcast_; }
 
   SdpVideoFormat video_format() const { return video_format_; }
@@ -330,6 +340,8 @@ class MockVideoEncoder : public VideoEncoder {
   FramerateFractions fps_allocation_;
   bool supports_simulcast_ = false;
   absl::optional<bool> is_qp_trusted_;
+  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+      preferred_pixel_formats_;
   SdpVideoFormat video_format_;
 
   VideoCodec codec_;
@@ -454,6 +466,8 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
     last_encoded_image_height_ = encoded_image._encodedHeight;
     last_encoded_image_simulcast_index_ =
         encoded_image.SpatialIndex().value_or(-1);
+    encoded_image_simulcast_indices_.push_back(
+        last_encoded_image_simulcast_index_);
 
     return Result(Result::OK, encoded_image.Timestamp());
   }
@@ -569,6 +583,7 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
   int last_encoded_image_width_;
   int last_encoded_image_height_;
   int last_encoded_image_simulcast_index_;
+  std::vector<int> encoded_image_simulcast_indices_;
   std::unique_ptr<SimulcastRateAllocator> rate_allocator_;
   bool use_fallback_factory_;
   SdpVideoFormat::Parameters sdp_video_parameters_;
@@ -1077,6 +1092,68 @@ TEST_F(TestSimulcastEncoderAdapterFake, NativeHandleForwardingOnlyIfSupported) {
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake, ReportsPixelFormatsPreferredByAll) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  auto& encoders = helper_->factory()->encoders();
+  encoders[0]->set_preferred_pixel_formats(
+      {VideoFrameBuffer::Type::kI420, VideoFrameBuffer::Type::kNV12});
+  encoders[1]->set_preferred_pixel_formats(
+      {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  encoders[2]->set_preferred_pixel_formats({VideoFrameBuffer::Type::kNV12});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ::testing::ElementsAre(VideoFrameBuffer::Type::kNV12));
+
+  // No preferred formats means I420.
+  encoders[2]->set_preferred_pixel_formats({});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ::testing::ElementsAre(VideoFrameBuffer::Type::kI420));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       MapsNativeFramesOnceForLayersWithoutNativeSupport) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    encoder->set_preferred_pixel_formats({VideoFrameBuffer::Type::kNV12});
+  }
+
+  VideoFrame input_frame = test::CreateMappableNativeFrame(
+      1000, VideoFrameBuffer::Type::kNV12, 1280, 720);
+  std::vector<int> encoded_widths;
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    EXPECT_CALL(*encoder, Encode)
+        .WillOnce([&](const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+          EXPECT_EQ(frame.video_frame_buffer()->type(),
+                    VideoFrameBuffer::Type::kNV12);
+          encoded_widths.push_back(frame.width());
+          return 0;
+        });
+  }
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_THAT(encoded_widths, ::testing::ElementsAre(320, 640, 1280));
+
+  // The lower layers are scaled from the mapped frame.
+  rtc::scoped_refptr<test::MappableNativeBuffer> native_buffer =
+      test::GetMappableNativeBufferFromVideoFrame(input_frame);
+  EXPECT_EQ(1u, native_buffer->GetMappedFramedBuffers().size());
+  EXPECT_FALSE(native_buffer->DidConvertToI420());
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1104,6 +1181,73 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       EncodesLayersInParallelAndDeliversImagesInLayerOrder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-ParallelSimulcastEncoding/Enabled/");
+  ReSetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  const VideoEncoder::Settings settings(kCapabilities, /*number_of_cores=*/4,
+                                        /*max_payload_size=*/1200);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(
+          VideoBitrateAllocationParameters(10000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // The middle layer finishes only after the top layer, which it could not
+  // if the layers were encoded one after the other.
+  const rtc::PlatformThreadRef test_thread = rtc::CurrentThreadRef();
+  rtc::Event top_layer_encoded;
+  EXPECT_CALL(*encoders[0], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_TRUE(
+            rtc::IsThreadRefEqual(test_thread, rtc::CurrentThreadRef()));
+        encoders[0]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[1], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_FALSE(
+            rtc::IsThreadRefEqual(test_thread, rtc::CurrentThreadRef()));
+        EXPECT_TRUE(top_layer_encoded.Wait(/*give_up_after_ms=*/5000));
+        encoders[1]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[2], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_FALSE(
+            rtc::IsThreadRefEqual(test_thread, rtc::CurrentThreadRef()));
+        encoders[2]->SendEncodedImage(frame.width(), frame.height());
+        top_layer_encoded.Set();
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  // The lowest layer is not intercepted and has no simulcast index.
+  EXPECT_THAT(encoded_image_simulcast_indices_,
+              ::testing::ElementsAre(-1, 1, 2));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
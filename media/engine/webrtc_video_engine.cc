@@ -39,6 +39,7 @@
 #include "rtc_base/experiments/normalize_simulcast_size_experiment.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -457,6 +458,24 @@ MergeInfoAboutOutboundRtpSubstreams(
   return rtp_substreams;
 }
 
+std::unique_ptr<webrtc::VideoEncoderFactory> MaybeCacheFormats(
+    std::unique_ptr<webrtc::VideoEncoderFactory> factory,
+    bool cache) {
+  if (!cache || !factory)
+    return factory;
+  return std::make_unique<webrtc::CachingVideoEncoderFactory>(
+      std::move(factory));
+}
+
+std::unique_ptr<webrtc::VideoDecoderFactory> MaybeCacheFormats(
+    std::unique_ptr<webrtc::VideoDecoderFactory> factory,
+    bool cache) {
+  if (!cache || !factory)
+    return factory;
+  return std::make_unique<webrtc::CachingVideoDecoderFactory>(
+      std::move(factory));
+}
+
 }  // namespace
 
 // This constant is really an on/off, lower-level configurable NACK history
@@ -613,9 +632,16 @@ WebRtcVideoEngine::WebRtcVideoEngine(
     std::unique_ptr<webrtc::VideoEncoderFactory> video_encoder_factory,
     std::unique_ptr<webrtc::VideoDecoderFactory> video_decoder_factory,
     const webrtc::WebRtcKeyValueConfig& trials)
-    : decoder_factory_(std::move(video_decoder_factory)),
-      encoder_factory_(std::move(video_encoder_factory)),
-      trials_(trials) {
+    : cache_codec_formats_(IsEnabled(trials, "WebRTC-Video-CacheCodecFormats")),
+      decoder_factory_(MaybeCacheFormats(std::move(video_decoder_factory),
+                                         cache_codec_formats_)),
+      encoder_factory_(MaybeCacheFormats(std::move(video_encoder_factory),
+                                         cache_codec_formats_)),
+      trials_(trials),
+      scaled_frame_buffer_cache_(
+          IsEnabled(trials, "WebRTC-Video-SharedFrameScaling")
+              ? rtc::make_ref_counted<webrtc::ScaledFrameBufferCache>()
+              : nullptr) {
   RTC_DLOG(LS_INFO) << "WebRtcVideoEngine::WebRtcVideoEngine()";
 }
 
@@ -632,16 +658,50 @@ VideoMediaChannel* WebRtcVideoEngine::CreateMediaChannel(
   RTC_LOG(LS_INFO) << "CreateMediaChannel. Options: " << options.ToString();
   return new WebRtcVideoChannel(call, config, options, crypto_options,
                                 encoder_factory_.get(), decoder_factory_.get(),
-                                video_bitrate_allocator_factory);
+                                video_bitrate_allocator_factory,
+                                scaled_frame_buffer_cache_);
 }
 std::vector<VideoCodec> WebRtcVideoEngine::send_codecs() const {
-  return GetPayloadTypesAndDefaultCodecs(encoder_factory_.get(),
-                                         /*is_decoder_factory=*/false, trials_);
+  if (!cache_codec_formats_) {
+    return GetPayloadTypesAndDefaultCodecs(
+        encoder_factory_.get(), /*is_decoder_factory=*/false, trials_);
+  }
+  webrtc::MutexLock lock(&codecs_mutex_);
+  if (!send_codecs_) {
+    send_codecs_ = GetPayloadTypesAndDefaultCodecs(
+        encoder_factory_.get(), /*is_decoder_factory=*/false, trials_);
+  }
+  return *send_codecs_;
 }
 
 std::vector<VideoCodec> WebRtcVideoEngine::recv_codecs() const {
-  return GetPayloadTypesAndDefaultCodecs(decoder_factory_.get(),
-                                         /*is_decoder_factory=*/true, trials_);
+  if (!cache_codec_formats_) {
+    return GetPayloadTypesAndDefaultCodecs(
+        decoder_factory_.get(), /*is_decoder_factory=*/true, trials_);
+  }
+  webrtc::MutexLock lock(&codecs_mutex_);
+  if (!recv_codecs_) {
+    recv_codecs_ = GetPayloadTypesAndDefaultCodecs(
+        decoder_factory_.get(), /*is_decoder_factory=*/true, trials_);
+  }
+  return *recv_codecs_;
+}
+
+void WebRtcVideoEngine::ResetCodecCache() {
+  if (!cache_codec_formats_)
+    return;
+  // The factories are only wrapped if caching is enabled, see the constructor.
+  webrtc::MutexLock lock(&codecs_mutex_);
+  if (encoder_factory_) {
+    static_cast<webrtc::CachingVideoEncoderFactory*>(encoder_factory_.get())
+        ->Invalidate();
+  }
+  if (decoder_factory_) {
+    static_cast<webrtc::CachingVideoDecoderFactory*>(decoder_factory_.get())
+        ->Invalidate();
+  }
+  send_codecs_ = absl::nullopt;
+  recv_codecs_ = absl::nullopt;
 }
 
 std::vector<webrtc::RtpHeaderExtensionCapability>
@@ -692,7 +752,9 @@ WebRtcVideoChannel::WebRtcVideoChannel(
     const webrtc::CryptoOptions& crypto_options,
     webrtc::VideoEncoderFactory* encoder_factory,
     webrtc::VideoDecoderFactory* decoder_factory,
-    webrtc::VideoBitrateAllocatorFactory* bitrate_allocator_factory)
+    webrtc::VideoBitrateAllocatorFactory* bitrate_allocator_factory,
+    rtc::scoped_refptr<webrtc::ScaledFrameBufferCache>
+        scaled_frame_buffer_cache)
     : VideoMediaChannel(call->network_thread(), config.enable_dscp),
       worker_thread_(call->worker_thread()),
       call_(call),
@@ -701,6 +763,7 @@ WebRtcVideoChannel::WebRtcVideoChannel(
       encoder_factory_(encoder_factory),
       decoder_factory_(decoder_factory),
       bitrate_allocator_factory_(bitrate_allocator_factory),
+      scaled_frame_buffer_cache_(std::move(scaled_frame_buffer_cache)),
       default_send_options_(options),
       last_stats_log_ms_(-1),
       discard_unknown_ssrc_packets_(
@@ -1339,6 +1402,8 @@ bool WebRtcVideoChannel::AddSendStream(const StreamParams& sp) {
   config.encoder_settings.encoder_factory = encoder_factory_;
   config.encoder_settings.bitrate_allocator_factory =
       bitrate_allocator_factory_;
+  config.encoder_settings.scaled_frame_buffer_cache =
+      scaled_frame_buffer_cache_;
   config.encoder_settings.encoder_switch_request_callback = this;
   config.crypto_options = crypto_options_;
   config.rtp.extmap_allow_mixed = ExtmapAllowMixed();
@@ -2006,6 +2071,12 @@ bool WebRtcVideoChannel::SendRtp(const uint8_t* data,
   return true;
 }
 
+bool WebRtcVideoChannel::SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                                       const webrtc::PacketOptions& options) {
+  MediaChannel::SendRtp(std::move(packet), options);
+  return true;
+}
+
 bool WebRtcVideoChannel::SendRtcp(const uint8_t* data, size_t len) {
   MediaChannel::SendRtcp(data, len);
   return true;
@@ -3192,6 +3263,7 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::GetVideoReceiverInfo(
   // TODO(bugs.webrtc.org/10662): Add stats for LNTF.
 
   info.timing_frame_info = stats.timing_frame_info;
+  info.timing_frame_stage_delays_ms = stats.timing_frame_stage_delays_ms;
 
   if (log_stats)
     RTC_LOG(LS_INFO) << stats.ToString(rtc::TimeMillis());
@@ -21,6 +21,7 @@
 #include "api/call/transport.h"
 #include "api/sequence_checker.h"
 #include "api/transport/field_trial_based_config.h"
+#include "api/video/scaled_frame_buffer_cache.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -31,6 +32,7 @@
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
 #include "media/base/media_engine.h"
+#include "media/engine/caching_video_codec_factory.h"
 #include "media/engine/unhandled_packets_buffer.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -108,15 +110,30 @@ class WebRtcVideoEngine : public VideoEngineInterface {
 
   std::vector<VideoCodec> send_codecs() const override;
   std::vector<VideoCodec> recv_codecs() const override;
+  void ResetCodecCache() override;
   std::vector<webrtc::RtpHeaderExtensionCapability> GetRtpHeaderExtensions()
       const override;
 
  private:
+  // If set by the WebRTC-Video-CacheCodecFormats field trial, the factories
+  // are wrapped by Caching*Factory and the codec lists built from their
+  // formats are kept until ResetCodecCache().
+  const bool cache_codec_formats_;
   const std::unique_ptr<webrtc::VideoDecoderFactory> decoder_factory_;
   const std::unique_ptr<webrtc::VideoEncoderFactory> encoder_factory_;
   const std::unique_ptr<webrtc::VideoBitrateAllocatorFactory>
       bitrate_allocator_factory_;
   const webrtc::WebRtcKeyValueConfig& trials_;
+  // Shared by the send streams of all channels, so that encoders of the same
+  // source at the same resolution scale its frames once. Null unless the
+  // WebRTC-Video-SharedFrameScaling field trial is enabled.
+  const rtc::scoped_refptr<webrtc::ScaledFrameBufferCache>
+      scaled_frame_buffer_cache_;
+  mutable webrtc::Mutex codecs_mutex_;
+  mutable absl::optional<std::vector<VideoCodec>> send_codecs_
+      RTC_GUARDED_BY(codecs_mutex_);
+  mutable absl::optional<std::vector<VideoCodec>> recv_codecs_
+      RTC_GUARDED_BY(codecs_mutex_);
 };
 
 class WebRtcVideoChannel : public VideoMediaChannel,
@@ -130,7 +147,9 @@ class WebRtcVideoChannel : public VideoMediaChannel,
       const webrtc::CryptoOptions& crypto_options,
       webrtc::VideoEncoderFactory* encoder_factory,
       webrtc::VideoDecoderFactory* decoder_factory,
-      webrtc::VideoBitrateAllocatorFactory* bitrate_allocator_factory);
+      webrtc::VideoBitrateAllocatorFactory* bitrate_allocator_factory,
+      rtc::scoped_refptr<webrtc::ScaledFrameBufferCache>
+          scaled_frame_buffer_cache = nullptr);
   ~WebRtcVideoChannel() override;
 
   // VideoMediaChannel implementation
@@ -518,6 +537,8 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override;
+  bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                     const webrtc::PacketOptions& options) override;
   bool SendRtcp(const uint8_t* data, size_t len) override;
 
   // Generate the list of codec parameters to pass down based on the negotiated
@@ -604,6 +625,8 @@ class WebRtcVideoChannel : public VideoMediaChannel,
       RTC_GUARDED_BY(thread_checker_);
   webrtc::VideoBitrateAllocatorFactory* const bitrate_allocator_factory_
       RTC_GUARDED_BY(thread_checker_);
+  const rtc::scoped_refptr<webrtc::ScaledFrameBufferCache>
+      scaled_frame_buffer_cache_;
   std::vector<VideoCodecSettings> recv_codecs_ RTC_GUARDED_BY(thread_checker_);
   std::vector<webrtc::RtpExtension> recv_rtp_extensions_
       RTC_GUARDED_BY(thread_checker_);
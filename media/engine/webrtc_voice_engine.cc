@@ -2529,6 +2529,13 @@ bool WebRtcVoiceMediaChannel::SendRtp(const uint8_t* data,
   return true;
 }
 
+bool WebRtcVoiceMediaChannel::SendRtpBuffer(
+    rtc::CopyOnWriteBuffer packet,
+    const webrtc::PacketOptions& options) {
+  MediaChannel::SendRtp(std::move(packet), options);
+  return true;
+}
+
 bool WebRtcVoiceMediaChannel::SendRtcp(const uint8_t* data, size_t len) {
   MediaChannel::SendRtcp(data, len);
   return true;
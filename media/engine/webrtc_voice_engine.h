@@ -234,6 +234,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override;
+  bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                     const webrtc::PacketOptions& options) override;
 
   bool SendRtcp(const uint8_t* data, size_t len) override;
 
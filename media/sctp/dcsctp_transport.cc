@@ -19,6 +19,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/priority.h"
 #include "media/base/media_channel.h"
 #include "net/dcsctp/public/dcsctp_socket_factory.h"
 #include "net/dcsctp/public/packet_observer.h"
@@ -111,6 +112,22 @@ bool IsEmptyPPID(dcsctp::PPID ppid) {
   return webrtc_ppid == WebrtcPPID::kStringEmpty ||
          webrtc_ppid == WebrtcPPID::kBinaryEmpty;
 }
+
+// The relative weights of the data channel priorities, as defined by
+// https://w3c.github.io/webrtc-priority/#rtc-priority-type.
+dcsctp::StreamPriority ToStreamPriority(Priority priority) {
+  switch (priority) {
+    case Priority::kVeryLow:
+      return dcsctp::StreamPriority(128);
+    case Priority::kLow:
+      return dcsctp::StreamPriority(256);
+    case Priority::kMedium:
+      return dcsctp::StreamPriority(512);
+    case Priority::kHigh:
+      return dcsctp::StreamPriority(1024);
+  }
+  RTC_CHECK_NOTREACHED();
+}
 }  // namespace
 
 DcSctpTransport::DcSctpTransport(rtc::Thread* network_thread,
@@ -164,6 +181,10 @@ bool DcSctpTransport::Start(int local_sctp_port,
     options.local_port = local_sctp_port;
     options.remote_port = remote_sctp_port;
     options.max_message_size = max_message_size;
+    // https://www.rfc-editor.org/rfc/rfc8831.html#section-6.4 asks for the
+    // weighted fair queueing scheduler, with the data channel priorities.
+    options.stream_scheduler = dcsctp::StreamScheduler::kWeightedFairQueueing;
+    options.default_stream_priority = ToStreamPriority(webrtc::Priority::kLow);
     options.max_timer_backoff_duration = kMaxTimerBackoffDuration;
     // Don't close the connection automatically on too many retransmissions.
     options.max_retransmissions = absl::nullopt;
@@ -205,6 +226,18 @@ bool DcSctpTransport::OpenStream(int sid) {
   return true;
 }
 
+void DcSctpTransport::SetStreamPriority(int sid, webrtc::Priority priority) {
+  RTC_LOG(LS_INFO) << debug_name_ << "->SetStreamPriority(sid=" << sid
+                   << ", priority=" << static_cast<int>(priority) << ").";
+  if (!socket_) {
+    RTC_LOG(LS_ERROR) << debug_name_ << "->SetStreamPriority(sid=" << sid
+                      << "): Transport is not started.";
+    return;
+  }
+  socket_->SetStreamPriority(dcsctp::StreamID(static_cast<uint16_t>(sid)),
+                             ToStreamPriority(priority));
+}
+
 bool DcSctpTransport::ResetStream(int sid) {
   RTC_LOG(LS_INFO) << debug_name_ << "->ResetStream(" << sid << ").";
   if (!socket_) {
@@ -385,7 +418,7 @@ void DcSctpTransport::OnMessageReceived(dcsctp::DcSctpMessage message) {
   RTC_LOG(LS_VERBOSE) << debug_name_ << "->OnMessageReceived(sid="
                       << message.stream_id().value()
                       << ", ppid=" << message.ppid().value()
-                      << ", length=" << message.payload().size() << ").";
+                      << ", length=" << message.payload_size() << ").";
   cricket::ReceiveDataParams receive_data_params;
   receive_data_params.sid = message.stream_id().value();
   auto type = ToDataMessageType(message.ppid());
@@ -399,9 +432,13 @@ void DcSctpTransport::OnMessageReceived(dcsctp::DcSctpMessage message) {
   // No seq_num available from dcSCTP
   receive_data_params.seq_num = 0;
   receive_buffer_.Clear();
-  if (!IsEmptyPPID(message.ppid()))
-    receive_buffer_.AppendData(message.payload().data(),
-                               message.payload().size());
+  if (!IsEmptyPPID(message.ppid())) {
+    // Append the fragments as they are, to not have the message concatenate
+    // them first.
+    receive_buffer_.EnsureCapacity(message.payload_size());
+    for (const std::vector<uint8_t>& fragment : message.fragments())
+      receive_buffer_.AppendData(fragment.data(), fragment.size());
+  }
 
   SignalDataReceived(receive_data_params, receive_buffer_);
 }
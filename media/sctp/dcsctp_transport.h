@@ -47,6 +47,7 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
              int remote_sctp_port,
              int max_message_size) override;
   bool OpenStream(int sid) override;
+  void SetStreamPriority(int sid, webrtc::Priority priority) override;
   bool ResetStream(int sid) override;
   bool SendData(int sid,
                 const SendDataParams& params,
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "api/priority.h"
 #include "api/transport/data_channel_transport_interface.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/thread.h"
@@ -111,6 +112,10 @@ class SctpTransportInternal {
   // used" part. See:
   // https://bugs.chromium.org/p/chromium/issues/detail?id=619849
   virtual bool OpenStream(int sid) = 0;
+  // Sets the priority of `sid`, as defined by
+  // https://www.rfc-editor.org/rfc/rfc8831.html#section-6.4. Transports that
+  // don't support stream schedulers ignore it.
+  virtual void SetStreamPriority(int sid, webrtc::Priority priority) {}
   // The inverse of OpenStream. Begins the closing procedure, which will
   // eventually result in SignalClosingProcedureComplete on the side that
   // initiates it, and both SignalClosingProcedureStartedRemotely and
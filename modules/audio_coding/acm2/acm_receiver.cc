@@ -210,6 +210,23 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   return 0;
 }
 
+int AcmReceiver::GetAudioWithoutDecoding(AudioFrame* audio_frame) {
+  if (neteq_->GetAudioWithoutDecoding(audio_frame) != NetEq::kOK) {
+    RTC_LOG(LS_ERROR) << "AcmReceiver::GetAudioWithoutDecoding - NetEq Failed.";
+    return -1;
+  }
+
+  // The skipped audio is silence as far as the resampler is concerned.
+  MutexLock lock(&mutex_);
+  resampled_last_output_frame_ = false;
+  memset(last_audio_buffer_.get(), 0,
+         sizeof(int16_t) * audio_frame->samples_per_channel_ *
+             audio_frame->num_channels_);
+
+  call_stats_.DecodedByNetEq(audio_frame->speech_type_, /*muted=*/true);
+  return 0;
+}
+
 void AcmReceiver::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   neteq_->SetCodecs(codecs);
 }
@@ -81,6 +81,16 @@ class AcmReceiver {
   //
   int GetAudio(int desired_freq_hz, AudioFrame* audio_frame, bool* muted);
 
+  //
+  // Advances playout by 10 ms like GetAudio(), but without decoding the audio,
+  // see NetEq::GetAudioWithoutDecoding(). `audio_frame` is muted, and is at the
+  // sampling rate of the decoder.
+  //
+  // Return value             : 0 if OK.
+  //                           -1 if NetEq returned an error.
+  //
+  int GetAudioWithoutDecoding(AudioFrame* audio_frame);
+
   // Replace the current set of decoders with the specified set.
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs);
 
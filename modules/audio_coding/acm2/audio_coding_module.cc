@@ -145,12 +145,15 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // ptr_out: pointer to output audio_frame. If no preprocessing is required
   //          `ptr_out` will be pointing to `in_frame`, otherwise pointing to
   //          `preprocess_frame_`.
+  // timestamp_out: the timestamp of the output audio, which differs from that
+  //          of `in_frame` once the input has been resampled.
   //
   // Return value:
   //   -1: if encountering an error.
   //    0: otherwise.
   int PreprocessToAddData(const AudioFrame& in_frame,
-                          const AudioFrame** ptr_out)
+                          const AudioFrame** ptr_out,
+                          uint32_t* timestamp_out)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_mutex_);
 
   // Change required states after starting to receive the codec corresponding
@@ -376,11 +379,12 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
   }
 
   const AudioFrame* ptr_frame;
+  uint32_t timestamp;
   // Perform a resampling, also down-mix if it is required and can be
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, &ptr_frame, &timestamp) < 0) {
     return -1;
   }
 
@@ -390,7 +394,7 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
       ptr_frame->num_channels_ == current_num_channels;
 
   // TODO(yujo): Skip encode of muted frames.
-  input_data->input_timestamp = ptr_frame->timestamp_;
+  input_data->input_timestamp = timestamp;
   input_data->length_per_channel = ptr_frame->samples_per_channel_;
   input_data->audio_channel = current_num_channels;
 
@@ -419,7 +423,8 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
 // is required, |*ptr_out| points to `in_frame`.
 // TODO(yujo): Make this more efficient for muted frames.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
-                                               const AudioFrame** ptr_out) {
+                                               const AudioFrame** ptr_out,
+                                               uint32_t* timestamp_out) {
   const bool resample =
       in_frame.sample_rate_hz_ != encoder_stack_->SampleRateHz();
 
@@ -446,17 +451,11 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
   }
 
   if (!down_mix && !resample) {
-    // No pre-processing is required.
-    if (expected_in_ts_ == expected_codec_ts_) {
-      // If we've never resampled, we can use the input frame as-is
-      *ptr_out = &in_frame;
-    } else {
-      // Otherwise we'll need to alter the timestamp. Since in_frame is const,
-      // we'll have to make a copy of it.
-      preprocess_frame_.CopyFrom(in_frame);
-      preprocess_frame_.timestamp_ = expected_codec_ts_;
-      *ptr_out = &preprocess_frame_;
-    }
+    // No pre-processing is required. The input frame is encoded as-is, with
+    // the codec timestamp, which only differs from the input timestamp if
+    // we've resampled before.
+    *ptr_out = &in_frame;
+    *timestamp_out = expected_codec_ts_;
 
     expected_in_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
     expected_codec_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
@@ -488,6 +487,7 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
   }
 
   preprocess_frame_.timestamp_ = expected_codec_ts_;
+  *timestamp_out = expected_codec_ts_;
   preprocess_frame_.sample_rate_hz_ = in_frame.sample_rate_hz_;
   // If it is required, we have to do a resampling.
   if (resample) {
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the send side overhead of AudioCodingModule::Add10MsData(), with a
+// PCM16B encoder so that encoding itself is cheap. When the input has the
+// format of the encoder, the frame is given to the encoder as-is; otherwise it
+// is down-mixed and/or resampled first.
+
+#include <memory>
+
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "modules/audio_coding/include/audio_coding_module.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kEncoderSampleRateHz = 48000;
+
+class CountingPacketizationCallback : public AudioPacketizationCallback {
+ public:
+  int32_t SendData(AudioFrameType frame_type,
+                   uint8_t payload_type,
+                   uint32_t timestamp,
+                   const uint8_t* payload_data,
+                   size_t payload_len_bytes) override {
+    ++num_packets_;
+    return 0;
+  }
+
+  int num_packets() const { return num_packets_; }
+
+ private:
+  int num_packets_ = 0;
+};
+
+// Arguments: the input sample rate and number of channels. The encoder is
+// mono at 48 kHz, with 20 ms packets.
+void BM_Add10MsData(benchmark::State& state) {
+  const int input_sample_rate_hz = state.range(0);
+  const size_t input_channels = state.range(1);
+
+  std::unique_ptr<AudioCodingModule> acm(AudioCodingModule::Create(
+      AudioCodingModule::Config(CreateBuiltinAudioDecoderFactory())));
+  AudioEncoderPcm16B::Config config;
+  config.sample_rate_hz = kEncoderSampleRateHz;
+  config.frame_size_ms = 20;
+  acm->SetEncoder(std::make_unique<AudioEncoderPcm16B>(config));
+  CountingPacketizationCallback callback;
+  acm->RegisterTransportCallback(&callback);
+
+  AudioFrame frame;
+  frame.sample_rate_hz_ = input_sample_rate_hz;
+  frame.samples_per_channel_ = input_sample_rate_hz / 100;
+  frame.num_channels_ = input_channels;
+  int16_t* data = frame.mutable_data();
+  for (size_t i = 0; i < frame.samples_per_channel_ * input_channels; ++i) {
+    data[i] = static_cast<int16_t>(i * 31);
+  }
+
+  for (auto s : state) {
+    RTC_CHECK_GE(acm->Add10MsData(frame), 0);
+    frame.timestamp_ += frame.samples_per_channel_;
+  }
+  RTC_CHECK_GT(callback.num_packets(), 0);
+}
+BENCHMARK(BM_Add10MsData)
+    ->ArgNames({"rate", "channels"})
+    ->Args({48000, 1})
+    ->Args({48000, 2})
+    ->Args({44100, 1})
+    ->Args({16000, 1});
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_batch_scheduler.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+namespace {
+
+// Returns the jobs of batch `index` out of `num_batches` equally sized ones.
+template <typename Job>
+rtc::ArrayView<Job> GetBatch(rtc::ArrayView<Job> jobs,
+                             size_t index,
+                             size_t num_batches) {
+  size_t begin = jobs.size() * index / num_batches;
+  size_t end = jobs.size() * (index + 1) / num_batches;
+  return jobs.subview(begin, end - begin);
+}
+
+void ProcessBatch(rtc::ArrayView<WebRtcOpusEncodeJob> encode_jobs,
+                  rtc::ArrayView<WebRtcOpusDecodeJob> decode_jobs) {
+  WebRtcOpus_EncodeBatch(encode_jobs.data(), encode_jobs.size());
+  WebRtcOpus_DecodeBatch(decode_jobs.data(), decode_jobs.size());
+}
+
+}  // namespace
+
+OpusBatchScheduler::OpusBatchScheduler(TaskQueueFactory* task_queue_factory,
+                                       int num_workers) {
+  RTC_DCHECK_GE(num_workers, 1);
+  for (int i = 1; i < num_workers; ++i) {
+    workers_.push_back(task_queue_factory->CreateTaskQueue(
+        "OpusBatch" + std::to_string(i), TaskQueueFactory::Priority::HIGH));
+  }
+}
+
+OpusBatchScheduler::~OpusBatchScheduler() = default;
+
+void OpusBatchScheduler::Process(
+    rtc::ArrayView<WebRtcOpusEncodeJob> encode_jobs,
+    rtc::ArrayView<WebRtcOpusDecodeJob> decode_jobs) {
+  const size_t num_batches = num_workers();
+  struct Batch {
+    TaskQueueBase* worker;
+    rtc::ArrayView<WebRtcOpusEncodeJob> encode_jobs;
+    rtc::ArrayView<WebRtcOpusDecodeJob> decode_jobs;
+  };
+  std::vector<Batch> batches;
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    Batch batch = {workers_[i].get(), GetBatch(encode_jobs, i + 1, num_batches),
+                   GetBatch(decode_jobs, i + 1, num_batches)};
+    if (!batch.encode_jobs.empty() || !batch.decode_jobs.empty()) {
+      batches.push_back(batch);
+    }
+  }
+
+  rtc::Event done;
+  std::atomic<size_t> remaining(batches.size());
+  for (const Batch& batch : batches) {
+    batch.worker->PostTask(ToQueuedTask([batch, &remaining, &done] {
+      ProcessBatch(batch.encode_jobs, batch.decode_jobs);
+      if (--remaining == 0) {
+        done.Set();
+      }
+    }));
+  }
+  ProcessBatch(GetBatch(encode_jobs, 0, num_batches),
+               GetBatch(decode_jobs, 0, num_batches));
+  if (!batches.empty()) {
+    done.Wait(rtc::Event::kForever);
+  }
+}
+
+}  // namespace webrtc
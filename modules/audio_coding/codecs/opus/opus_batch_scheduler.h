@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_BATCH_SCHEDULER_H_
+#define MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_BATCH_SCHEDULER_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/audio_coding/codecs/opus/opus_interface.h"
+
+namespace webrtc {
+
+// Encodes and decodes the frames of many Opus streams in batches on a few
+// worker task queues, for servers that transcode thousands of streams without
+// an AudioCodingModule per stream.
+//
+// Process() is called once per tick, e.g. every 20 ms, with one job per
+// stream. The jobs are split into one contiguous batch per worker, so each
+// worker makes one pass over its streams instead of being woken up per frame,
+// and a stream whose job keeps its position in the job lists stays on the
+// same worker, where its codec state is likely to still be cached. The
+// calling thread processes the first batch itself.
+//
+// Not thread safe. Each encoder and decoder may be used by at most one job
+// per call.
+class OpusBatchScheduler {
+ public:
+  OpusBatchScheduler(TaskQueueFactory* task_queue_factory, int num_workers);
+  ~OpusBatchScheduler();
+
+  OpusBatchScheduler(const OpusBatchScheduler&) = delete;
+  OpusBatchScheduler& operator=(const OpusBatchScheduler&) = delete;
+
+  // Runs all jobs, and returns when they are done. See
+  // WebRtcOpus_EncodeBatch() and WebRtcOpus_DecodeBatch() for their results.
+  void Process(rtc::ArrayView<WebRtcOpusEncodeJob> encode_jobs,
+               rtc::ArrayView<WebRtcOpusDecodeJob> decode_jobs);
+
+  int num_workers() const { return static_cast<int>(workers_.size()) + 1; }
+
+ private:
+  // The workers besides the calling thread.
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_BATCH_SCHEDULER_H_
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_batch_scheduler.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/audio_coding/codecs/opus/opus_interface.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPer20Ms = 960;
+constexpr size_t kMaxBytes = 1000;
+constexpr int kNumStreams = 10;
+
+class OpusBatchSchedulerTest : public ::testing::TestWithParam<int> {
+ protected:
+  OpusBatchSchedulerTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        audio_(kSamplesPer20Ms),
+        encoded_(kNumStreams, std::vector<uint8_t>(kMaxBytes)),
+        decoded_(kNumStreams, std::vector<int16_t>(kSamplesPer20Ms)) {
+    for (size_t i = 0; i < audio_.size(); ++i) {
+      audio_[i] = static_cast<int16_t>((i * 97) % 2000 - 1000);
+    }
+    for (int i = 0; i < kNumStreams; ++i) {
+      OpusEncInst* encoder;
+      OpusDecInst* decoder;
+      EXPECT_EQ(0, WebRtcOpus_EncoderCreate(&encoder, 1, 0, kSampleRateHz));
+      EXPECT_EQ(0, WebRtcOpus_DecoderCreate(&decoder, 1, kSampleRateHz));
+      WebRtcOpus_DecoderInit(decoder);
+      encoders_.push_back(encoder);
+      decoders_.push_back(decoder);
+    }
+  }
+
+  ~OpusBatchSchedulerTest() override {
+    for (OpusEncInst* encoder : encoders_) {
+      WebRtcOpus_EncoderFree(encoder);
+    }
+    for (OpusDecInst* decoder : decoders_) {
+      WebRtcOpus_DecoderFree(decoder);
+    }
+  }
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  std::vector<int16_t> audio_;
+  std::vector<std::vector<uint8_t>> encoded_;
+  std::vector<std::vector<int16_t>> decoded_;
+  std::vector<OpusEncInst*> encoders_;
+  std::vector<OpusDecInst*> decoders_;
+};
+
+TEST_P(OpusBatchSchedulerTest, EncodesAndDecodesAllStreams) {
+  OpusBatchScheduler scheduler(task_queue_factory_.get(), GetParam());
+  EXPECT_EQ(GetParam(), scheduler.num_workers());
+
+  std::vector<WebRtcOpusEncodeJob> encode_jobs(kNumStreams);
+  for (int i = 0; i < kNumStreams; ++i) {
+    encode_jobs[i] = {encoders_[i],       audio_.data(),      kSamplesPer20Ms,
+                      encoded_[i].size(), encoded_[i].data(), -1};
+  }
+  scheduler.Process(encode_jobs, {});
+
+  std::vector<WebRtcOpusDecodeJob> decode_jobs(kNumStreams);
+  for (int i = 0; i < kNumStreams; ++i) {
+    ASSERT_GT(encode_jobs[i].result, 0);
+    // All encoders got the same input, so they should agree.
+    EXPECT_EQ(encode_jobs[0].result, encode_jobs[i].result);
+    decode_jobs[i] = {decoders_[i],
+                      encoded_[i].data(),
+                      static_cast<size_t>(encode_jobs[i].result),
+                      decoded_[i].data(),
+                      0,
+                      -1};
+  }
+  scheduler.Process({}, decode_jobs);
+
+  for (int i = 0; i < kNumStreams; ++i) {
+    EXPECT_EQ(static_cast<int>(kSamplesPer20Ms), decode_jobs[i].result);
+    EXPECT_EQ(1, decode_jobs[i].audio_type);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllWorkerCounts,
+                         OpusBatchSchedulerTest,
+                         ::testing::Values(1, 3, 16));
+
+}  // namespace
+}  // namespace webrtc
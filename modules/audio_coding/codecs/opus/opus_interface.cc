@@ -678,6 +678,22 @@ int WebRtcOpus_Decode(OpusDecInst* inst,
   return decoded_samples;
 }
 
+void WebRtcOpus_EncodeBatch(WebRtcOpusEncodeJob* jobs, size_t num_jobs) {
+  for (size_t i = 0; i < num_jobs; ++i) {
+    WebRtcOpusEncodeJob& job = jobs[i];
+    job.result = WebRtcOpus_Encode(job.inst, job.audio_in, job.samples,
+                                   job.length_encoded_buffer, job.encoded);
+  }
+}
+
+void WebRtcOpus_DecodeBatch(WebRtcOpusDecodeJob* jobs, size_t num_jobs) {
+  for (size_t i = 0; i < num_jobs; ++i) {
+    WebRtcOpusDecodeJob& job = jobs[i];
+    job.result = WebRtcOpus_Decode(job.inst, job.encoded, job.encoded_bytes,
+                                   job.decoded, &job.audio_type);
+  }
+}
+
 int WebRtcOpus_DecodeFec(OpusDecInst* inst,
                          const uint8_t* encoded,
                          size_t encoded_bytes,
@@ -540,6 +540,60 @@ int WebRtcOpus_PacketHasFec(const uint8_t* payload,
 int WebRtcOpus_PacketHasVoiceActivity(const uint8_t* payload,
                                       size_t payload_length_bytes);
 
+/****************************************************************************
+ * WebRtcOpus_EncodeBatch(...)
+ *
+ * This function encodes one frame for each of a number of encoders, as if
+ * WebRtcOpus_Encode() was called for each job in order. Each encoder may be
+ * used by at most one of the jobs.
+ *
+ * Input:
+ *      - jobs               : The frames to encode
+ *      - num_jobs           : Number of jobs
+ *
+ * Output:
+ *      - jobs[i].result     : >=0 - Length (in bytes) of coded data
+ *                             -1 - Error
+ */
+typedef struct {
+  OpusEncInst* inst;
+  const int16_t* audio_in;
+  size_t samples;
+  size_t length_encoded_buffer;
+  uint8_t* encoded;
+  int result;
+} WebRtcOpusEncodeJob;
+
+void WebRtcOpus_EncodeBatch(WebRtcOpusEncodeJob* jobs, size_t num_jobs);
+
+/****************************************************************************
+ * WebRtcOpus_DecodeBatch(...)
+ *
+ * This function decodes one packet for each of a number of decoders, as if
+ * WebRtcOpus_Decode() was called for each job in order. Each decoder may be
+ * used by at most one of the jobs.
+ *
+ * Input:
+ *      - jobs               : The packets to decode
+ *      - num_jobs           : Number of jobs
+ *
+ * Output:
+ *      - jobs[i].decoded    : The decoded vector
+ *      - jobs[i].audio_type : 1 normal, 2 CNG
+ *      - jobs[i].result     : >0 - Samples per channel in decoded vector
+ *                             -1 - Error
+ */
+typedef struct {
+  OpusDecInst* inst;
+  const uint8_t* encoded;
+  size_t encoded_bytes;
+  int16_t* decoded;
+  int16_t audio_type;
+  int result;
+} WebRtcOpusDecodeJob;
+
+void WebRtcOpus_DecodeBatch(WebRtcOpusDecodeJob* jobs, size_t num_jobs);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
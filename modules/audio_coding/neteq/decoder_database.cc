@@ -258,6 +258,13 @@ ComfortNoiseDecoder* DecoderDatabase::GetActiveCngDecoder() const {
   return active_cng_decoder_.get();
 }
 
+void DecoderDatabase::DropDecoders() {
+  for (const auto& kv : decoders_) {
+    kv.second.DropDecoder();
+  }
+  active_cng_decoder_.reset();
+}
+
 AudioDecoder* DecoderDatabase::GetDecoder(uint8_t rtp_payload_type) const {
   const DecoderInfo* info = GetDecoderInfo(rtp_payload_type);
   return info ? info->GetDecoder() : nullptr;
@@ -173,6 +173,10 @@ class DecoderDatabase {
   // comfort noise decoder exists.
   virtual ComfortNoiseDecoder* GetActiveCngDecoder() const;
 
+  // Deletes all AudioDecoder objects and the comfort noise decoder, to save
+  // memory. They are created again when they are next used.
+  void DropDecoders();
+
   // The following are utility methods: they will look up DecoderInfo through
   // GetDecoderInfo and call the respective method on that info object, if it
   // exists.
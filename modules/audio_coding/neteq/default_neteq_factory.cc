@@ -13,19 +13,27 @@
 #include <utility>
 
 #include "modules/audio_coding/neteq/neteq_impl.h"
+#include "modules/audio_coding/neteq/ring_packet_buffer.h"
 
 namespace webrtc {
 
-DefaultNetEqFactory::DefaultNetEqFactory() = default;
+DefaultNetEqFactory::DefaultNetEqFactory()
+    : DefaultNetEqFactory(/*use_ring_packet_buffer=*/false) {}
+DefaultNetEqFactory::DefaultNetEqFactory(bool use_ring_packet_buffer)
+    : use_ring_packet_buffer_(use_ring_packet_buffer) {}
 DefaultNetEqFactory::~DefaultNetEqFactory() = default;
 
 std::unique_ptr<NetEq> DefaultNetEqFactory::CreateNetEq(
     const NetEq::Config& config,
     const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory,
     Clock* clock) const {
-  return std::make_unique<NetEqImpl>(
-      config, NetEqImpl::Dependencies(config, clock, decoder_factory,
-                                      controller_factory_));
+  NetEqImpl::Dependencies deps(config, clock, decoder_factory,
+                               controller_factory_);
+  if (use_ring_packet_buffer_) {
+    deps.packet_buffer = std::make_unique<RingPacketBuffer>(
+        config.max_packets_in_buffer, deps.tick_timer.get());
+  }
+  return std::make_unique<NetEqImpl>(config, std::move(deps));
 }
 
 }  // namespace webrtc
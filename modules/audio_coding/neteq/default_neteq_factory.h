@@ -24,6 +24,9 @@ namespace webrtc {
 class DefaultNetEqFactory : public NetEqFactory {
  public:
   DefaultNetEqFactory();
+  // If `use_ring_packet_buffer` is true, the created NetEq instances store
+  // their packets in a RingPacketBuffer, which does not allocate per packet.
+  explicit DefaultNetEqFactory(bool use_ring_packet_buffer);
   ~DefaultNetEqFactory() override;
   DefaultNetEqFactory(const DefaultNetEqFactory&) = delete;
   DefaultNetEqFactory& operator=(const DefaultNetEqFactory&) = delete;
@@ -35,6 +38,7 @@ class DefaultNetEqFactory : public NetEqFactory {
 
  private:
   const DefaultNetEqControllerFactory controller_factory_;
+  const bool use_ring_packet_buffer_;
 };
 
 }  // namespace webrtc
@@ -129,6 +129,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
       enable_muted_state_(config.enable_muted_state),
+      hibernate_after_ms_(config.hibernate_after_ms),
       expand_uma_logger_("WebRTC.Audio.ExpandRatePercent",
                          10,  // Report once every 10 s.
                          tick_timer_.get()),
@@ -236,6 +237,27 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
                         absl::optional<Operation> action_override) {
   TRACE_EVENT0("webrtc", "NetEqImpl::GetAudio");
   MutexLock lock(&mutex_);
+  return GetAudioLocked(audio_frame, muted, current_sample_rate_hz,
+                        action_override);
+}
+
+int NetEqImpl::GetAudioWithoutDecoding(AudioFrame* audio_frame,
+                                       int* current_sample_rate_hz) {
+  TRACE_EVENT0("webrtc", "NetEqImpl::GetAudioWithoutDecoding");
+  MutexLock lock(&mutex_);
+  skip_decoding_ = true;
+  bool muted;
+  const int result = GetAudioLocked(audio_frame, &muted, current_sample_rate_hz,
+                                    absl::nullopt);
+  skip_decoding_ = false;
+  audio_frame->Mute();
+  return result;
+}
+
+int NetEqImpl::GetAudioLocked(AudioFrame* audio_frame,
+                              bool* muted,
+                              int* current_sample_rate_hz,
+                              absl::optional<Operation> action_override) {
   if (GetAudioInternal(audio_frame, muted, action_override) != 0) {
     return kFail;
   }
@@ -441,6 +463,9 @@ absl::optional<NetEq::DecoderFormat> NetEqImpl::GetDecoderFormat(
 void NetEqImpl::FlushBuffers() {
   MutexLock lock(&mutex_);
   RTC_LOG(LS_VERBOSE) << "FlushBuffers";
+  if (hibernating_) {
+    WakeUp();
+  }
   packet_buffer_->Flush(stats_.get());
   RTC_DCHECK(sync_buffer_.get());
   RTC_DCHECK(expand_.get());
@@ -506,6 +531,11 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
     return kInvalidPointer;
   }
 
+  const bool waking_up = hibernating_;
+  if (waking_up) {
+    WakeUp();
+  }
+
   Timestamp receive_time = clock_->CurrentTime();
   stats_->ReceivedPacket();
 
@@ -707,9 +737,10 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
     return kOtherError;
   }
 
-  if (first_packet_) {
+  if (first_packet_ || waking_up) {
     first_packet_ = false;
-    // Update the codec on the next GetAudio call.
+    // Update the codec on the next GetAudio call. After hibernation, this also
+    // resynchronizes the sync buffer to the new packet.
     new_codec_ = true;
   }
 
@@ -792,7 +823,8 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
       fs_hz_);
 
   // Check for muted state.
-  if (enable_muted_state_ && expand_->Muted() && packet_buffer_->Empty()) {
+  if (enable_muted_state_ && (hibernating_ || expand_->Muted()) &&
+      packet_buffer_->Empty()) {
     RTC_DCHECK_EQ(last_mode_, Mode::kExpand);
     audio_frame->Reset();
     RTC_DCHECK(audio_frame->muted());  // Reset() should mute the frame.
@@ -813,8 +845,14 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
     stats_->ExpandedNoiseSamples(output_size_samples_, false);
     controller_->NotifyMutedState();
     *muted = true;
+    muted_ms_ += kOutputSizeMs;
+    if (hibernate_after_ms_ > 0 && muted_ms_ >= hibernate_after_ms_ &&
+        !hibernating_) {
+      Hibernate();
+    }
     return 0;
   }
+  muted_ms_ = 0;
   int return_value = GetDecision(&operation, &packet_list, &dtmf_event,
                                  &play_dtmf, action_override);
   if (return_value != 0) {
@@ -1480,9 +1518,31 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
                operation == Operation::kMerge ||
                operation == Operation::kPreemptiveExpand);
 
-    auto opt_result = packet_list->front().frame->Decode(
-        rtc::ArrayView<int16_t>(&decoded_buffer_[*decoded_length],
-                                decoded_buffer_length_ - *decoded_length));
+    absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> opt_result;
+    if (skip_decoding_) {
+      // Stand in for the decoded audio with silence of the same duration, which
+      // keeps the timing of everything downstream of the decoder.
+      size_t duration = packet_list->front().frame->Duration();
+      if (duration == 0) {
+        duration = decoder_frame_length_;
+      }
+      const size_t num_samples =
+          std::min(duration * decoder->Channels(),
+                   decoded_buffer_length_ - *decoded_length);
+      std::fill_n(&decoded_buffer_[*decoded_length], num_samples, 0);
+      opt_result = AudioDecoder::EncodedAudioFrame::DecodeResult{
+          num_samples, AudioDecoder::kSpeech};
+      reset_decoder_before_decoding_ = true;
+    } else {
+      if (reset_decoder_before_decoding_) {
+        // The decoder state is stale after the skipped packets.
+        decoder->Reset();
+        reset_decoder_before_decoding_ = false;
+      }
+      opt_result = packet_list->front().frame->Decode(
+          rtc::ArrayView<int16_t>(&decoded_buffer_[*decoded_length],
+                                  decoded_buffer_length_ - *decoded_length));
+    }
     last_decoded_timestamps_.push_back(packet_list->front().timestamp);
     last_decoded_packet_infos_.push_back(
         std::move(packet_list->front().packet_info));
@@ -2125,13 +2185,43 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
   controller_->SetSampleRate(fs_hz_, output_size_samples_);
 }
 
+void NetEqImpl::Hibernate() {
+  RTC_DCHECK(!hibernating_);
+  RTC_LOG(LS_VERBOSE) << "Hibernate";
+  const size_t channels = sync_buffer_->Channels();
+  const uint32_t end_timestamp = sync_buffer_->end_timestamp();
+  // An empty sync buffer keeps the channel count and timestamp that the muted
+  // output and the statistics need.
+  sync_buffer_.reset(new SyncBuffer(channels, 0));
+  sync_buffer_->set_end_timestamp(end_timestamp);
+  algorithm_buffer_.reset(new AudioMultiVector(channels));
+  decoded_buffer_.reset();
+  decoded_buffer_length_ = 0;
+  // Expand, Merge and ComfortNoise point to the sync buffer.
+  UpdatePlcComponents(fs_hz_, channels);
+  comfort_noise_.reset(
+      new ComfortNoise(fs_hz_, decoder_database_.get(), sync_buffer_.get()));
+  decoder_database_->DropDecoders();
+  hibernating_ = true;
+}
+
+void NetEqImpl::WakeUp() {
+  RTC_DCHECK(hibernating_);
+  RTC_LOG(LS_VERBOSE) << "WakeUp";
+  const uint32_t end_timestamp = sync_buffer_->end_timestamp();
+  hibernating_ = false;
+  SetSampleRateAndChannels(fs_hz_, sync_buffer_->Channels());
+  sync_buffer_->set_end_timestamp(end_timestamp);
+}
+
 NetEqImpl::OutputType NetEqImpl::LastOutputType() {
   RTC_DCHECK(vad_.get());
   RTC_DCHECK(expand_.get());
   if (last_mode_ == Mode::kCodecInternalCng ||
       last_mode_ == Mode::kRfc3389Cng) {
     return OutputType::kCNG;
-  } else if (last_mode_ == Mode::kExpand && expand_->MuteFactor(0) == 0) {
+  } else if (last_mode_ == Mode::kExpand &&
+             (hibernating_ || expand_->MuteFactor(0) == 0)) {
     // Expand mode has faded down to background noise only (very long expand).
     return OutputType::kPLCCNG;
   } else if (last_mode_ == Mode::kExpand) {
@@ -138,6 +138,9 @@ class NetEqImpl : public webrtc::NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) override;
 
+  int GetAudioWithoutDecoding(AudioFrame* audio_frame,
+                              int* current_sample_rate_hz = nullptr) override;
+
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) override;
 
   bool RegisterPayloadType(int rtp_payload_type,
@@ -217,6 +220,13 @@ class NetEqImpl : public webrtc::NetEq {
                            rtc::ArrayView<const uint8_t> payload)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Implements GetAudio() and GetAudioWithoutDecoding().
+  int GetAudioLocked(AudioFrame* audio_frame,
+                     bool* muted,
+                     int* current_sample_rate_hz,
+                     absl::optional<Operation> action_override)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // Delivers 10 ms of audio data. The data is written to `audio_frame`.
   // Returns 0 on success, otherwise an error code.
   int GetAudioInternal(AudioFrame* audio_frame,
@@ -335,6 +345,13 @@ class NetEqImpl : public webrtc::NetEq {
   virtual void UpdatePlcComponents(int fs_hz, size_t channels)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Releases the sync buffer, the decoders and the other large buffers of a
+  // muted NetEq, keeping only the state that the muted output needs.
+  void Hibernate() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Rebuilds what Hibernate() released.
+  void WakeUp() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   NetEqNetworkStatistics CurrentNetworkStatisticsInternal() const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
@@ -391,6 +408,10 @@ class NetEqImpl : public webrtc::NetEq {
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(mutex_);
   bool nack_enabled_ RTC_GUARDED_BY(mutex_);
   const bool enable_muted_state_ RTC_GUARDED_BY(mutex_);
+  const int hibernate_after_ms_ RTC_GUARDED_BY(mutex_);
+  // How long the output has been muted.
+  int muted_ms_ RTC_GUARDED_BY(mutex_) = 0;
+  bool hibernating_ RTC_GUARDED_BY(mutex_) = false;
   AudioFrame::VADActivity last_vad_activity_ RTC_GUARDED_BY(mutex_) =
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
@@ -401,6 +422,10 @@ class NetEqImpl : public webrtc::NetEq {
   ExpandUmaLogger speech_expand_uma_logger_ RTC_GUARDED_BY(mutex_);
   bool no_time_stretching_ RTC_GUARDED_BY(mutex_);  // Only used for test.
   rtc::BufferT<int16_t> concealment_audio_ RTC_GUARDED_BY(mutex_);
+  // Set for the duration of GetAudioWithoutDecoding().
+  bool skip_decoding_ RTC_GUARDED_BY(mutex_) = false;
+  // True if packets have been skipped since the decoder last decoded.
+  bool reset_decoder_before_decoding_ RTC_GUARDED_BY(mutex_) = false;
 };
 
 }  // namespace webrtc
@@ -1272,6 +1272,70 @@ TEST_F(NetEqImplTest, DecodedPayloadTooShort) {
   EXPECT_CALL(mock_decoder, Die());
 }
 
+TEST_F(NetEqImplTest, GetAudioWithoutDecoding) {
+  UseNoMocks();
+  // Create a mock decoder object.
+  MockAudioDecoder mock_decoder;
+
+  CreateInstance(
+      rtc::make_ref_counted<test::AudioDecoderProxyFactory>(&mock_decoder));
+
+  const uint8_t kPayloadType = 17;   // Just an arbitrary number.
+  const int kSampleRateHz = 8000;
+  const size_t kPayloadLengthSamples =
+      static_cast<size_t>(10 * kSampleRateHz / 1000);  // 10 ms.
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+
+  EXPECT_CALL(mock_decoder, SampleRateHz())
+      .WillRepeatedly(Return(kSampleRateHz));
+  EXPECT_CALL(mock_decoder, Channels()).WillRepeatedly(Return(1));
+  EXPECT_CALL(mock_decoder, PacketDuration(_, _))
+      .WillRepeatedly(Return(rtc::checked_cast<int>(kPayloadLengthSamples)));
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("L16", 8000, 1)));
+
+  // The first packet is consumed without being decoded.
+  EXPECT_CALL(mock_decoder, Reset()).Times(0);
+  EXPECT_CALL(mock_decoder, DecodeInternal(_, _, _, _, _)).Times(0);
+  EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+  AudioFrame output;
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudioWithoutDecoding(&output));
+  ASSERT_EQ(kPayloadLengthSamples, output.samples_per_channel_);
+  EXPECT_EQ(1u, output.num_channels_);
+  EXPECT_TRUE(output.muted());
+  EXPECT_THAT(output.packet_infos_, SizeIs(1));
+
+  // The decoder is reset before decoding the next packet.
+  int16_t dummy_output[kPayloadLengthSamples] = {0};
+  {
+    InSequence sequence;
+    EXPECT_CALL(mock_decoder, Reset());
+    EXPECT_CALL(mock_decoder,
+                DecodeInternal(_, kPayloadLengthBytes, kSampleRateHz, _, _))
+        .WillOnce(DoAll(
+            SetArrayArgument<3>(dummy_output,
+                                dummy_output + kPayloadLengthSamples),
+            SetArgPointee<4>(AudioDecoder::kSpeech),
+            Return(rtc::checked_cast<int>(kPayloadLengthSamples))));
+  }
+  rtp_header.sequenceNumber++;
+  rtp_header.timestamp += kPayloadLengthSamples;
+  EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+  bool muted;
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  EXPECT_FALSE(muted);
+  EXPECT_EQ(AudioFrame::kNormalSpeech, output.speech_type_);
+  EXPECT_THAT(output.packet_infos_, SizeIs(1));
+
+  EXPECT_CALL(mock_decoder, Die());
+}
+
 // This test checks the behavior of NetEq when audio decoder fails.
 TEST_F(NetEqImplTest, DecodingError) {
   UseNoMocks();
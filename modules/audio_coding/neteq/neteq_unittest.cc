@@ -741,6 +741,39 @@ TEST_F(NetEqDecodingTestWithMutedState, RecoverAfterExtendedCngWithoutPackets) {
   GetAudioUntilNormal();
 }
 
+class NetEqDecodingTestWithHibernation
+    : public NetEqDecodingTestWithMutedState {
+ public:
+  NetEqDecodingTestWithHibernation() : NetEqDecodingTestWithMutedState() {
+    config_.hibernate_after_ms = 100;
+  }
+};
+
+// Verifies that NetEq stays muted while hibernating, and goes back to normal
+// when a packet arrives.
+TEST_F(NetEqDecodingTestWithHibernation, HibernateAndWakeUp) {
+  InsertPacket(0);
+  EXPECT_FALSE(GetAudioReturnMuted());
+  GetAudioUntilMuted();
+  AudioFrame muted_frame;
+  muted_frame.CopyFrom(out_frame_);
+
+  // Pull 1 second of audio, well past the hibernation delay.
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(GetAudioReturnMuted());
+    ++counter_;
+  }
+  EXPECT_EQ(muted_frame.timestamp_ + 100 * muted_frame.samples_per_channel_,
+            out_frame_.timestamp_);
+  EXPECT_EQ(muted_frame.samples_per_channel_, out_frame_.samples_per_channel_);
+  EXPECT_EQ(muted_frame.num_channels_, out_frame_.num_channels_);
+  EXPECT_EQ(muted_frame.speech_type_, out_frame_.speech_type_);
+
+  InsertPacket(kSamples * counter_);
+  GetAudioUntilNormal();
+  EXPECT_FALSE(out_frame_.muted());
+}
+
 namespace {
 ::testing::AssertionResult AudioFramesEqualExceptData(const AudioFrame& a,
                                                       const AudioFrame& b) {
@@ -10,14 +10,40 @@
 
 #include "modules/audio_coding/neteq/packet.h"
 
+#include <utility>
+
 namespace webrtc {
 
 Packet::Packet() = default;
-Packet::Packet(Packet&& b) = default;
+
+Packet::Packet(Packet&& b)
+    : timestamp(b.timestamp),
+      sequence_number(b.sequence_number),
+      payload_type(b.payload_type),
+      payload(std::move(b.payload)),
+      priority(b.priority),
+      packet_info(std::move(b.packet_info)),
+      waiting_time(std::move(b.waiting_time)),
+      frame(std::move(b.frame)),
+      live_object_(std::move(b.live_object_)) {
+  live_object_.SetBytes(payload.capacity());
+}
 
 Packet::~Packet() = default;
 
-Packet& Packet::operator=(Packet&& b) = default;
+Packet& Packet::operator=(Packet&& b) {
+  timestamp = b.timestamp;
+  sequence_number = b.sequence_number;
+  payload_type = b.payload_type;
+  payload = std::move(b.payload);
+  priority = b.priority;
+  packet_info = std::move(b.packet_info);
+  waiting_time = std::move(b.waiting_time);
+  frame = std::move(b.frame);
+  live_object_ = std::move(b.live_object_);
+  live_object_.SetBytes(payload.capacity());
+  return *this;
+}
 
 Packet Packet::Clone() const {
   RTC_CHECK(!frame);
@@ -33,4 +59,11 @@ Packet Packet::Clone() const {
   return clone;
 }
 
+// static
+rtc::LiveObjectCounter& Packet::LiveObjects() {
+  static rtc::LiveObjectCounter* const counter =
+      new rtc::LiveObjectCounter("NetEqPacket");
+  return *counter;
+}
+
 }  // namespace webrtc
@@ -21,6 +21,8 @@
 #include "api/rtp_packet_info.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/system/no_unique_address.h"
 
 namespace webrtc {
 
@@ -119,6 +121,13 @@ struct Packet {
   bool operator>=(const Packet& rhs) const { return !operator<(rhs); }
 
   bool empty() const { return !frame && payload.empty(); }
+
+ private:
+  static rtc::LiveObjectCounter& LiveObjects();
+
+  // Counts the payload capacity as of the last move, since that is how
+  // packets enter the packet buffer.
+  RTC_NO_UNIQUE_ADDRESS rtc::LiveObject live_object_{LiveObjects()};
 };
 
 // A list of packets.
@@ -54,15 +54,6 @@ bool EqualSampleRates(uint8_t pt1,
   return di1 && di2 && di1->SampleRateHz() == di2->SampleRateHz();
 }
 
-void LogPacketDiscarded(int codec_level, StatisticsCalculator* stats) {
-  RTC_CHECK(stats);
-  if (codec_level > 0) {
-    stats->SecondaryPacketsDiscarded(1);
-  } else {
-    stats->PacketsDiscarded(1);
-  }
-}
-
 absl::optional<SmartFlushingConfig> GetSmartflushingConfig() {
   absl::optional<SmartFlushingConfig> result;
   std::string field_trial_string =
@@ -121,9 +112,8 @@ void PacketBuffer::PartialFlush(int target_level_ms,
       target_level_samples, smart_flushing_config_->target_level_threshold_ms);
   while (GetSpanSamples(last_decoded_length, sample_rate, true) >
              static_cast<size_t>(target_level_samples) ||
-         buffer_.size() > max_number_of_packets_ / 2) {
-    LogPacketDiscarded(PeekNextPacket()->priority.codec_level, stats);
-    buffer_.pop_front();
+         NumPacketsInBuffer() > max_number_of_packets_ / 2) {
+    DiscardNextPacket(stats);
   }
 }
 
@@ -145,37 +135,10 @@ int PacketBuffer::InsertPacket(Packet&& packet,
   RTC_DCHECK_GE(packet.priority.codec_level, 0);
   RTC_DCHECK_GE(packet.priority.red_level, 0);
 
-  int return_val = kOK;
-
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  // Perform a smart flush if the buffer size exceeds a multiple of the target
-  // level.
-  const size_t span_threshold =
-      smart_flushing_config_
-          ? smart_flushing_config_->target_level_multiplier *
-                std::max(smart_flushing_config_->target_level_threshold_ms,
-                         target_level_ms) *
-                sample_rate / 1000
-          : 0;
-  const bool smart_flush =
-      smart_flushing_config_.has_value() &&
-      GetSpanSamples(last_decoded_length, sample_rate, true) >= span_threshold;
-  if (buffer_.size() >= max_number_of_packets_ || smart_flush) {
-    size_t buffer_size_before_flush = buffer_.size();
-    if (smart_flushing_config_.has_value()) {
-      // Flush down to the target level.
-      PartialFlush(target_level_ms, sample_rate, last_decoded_length, stats);
-      return_val = kPartialFlush;
-    } else {
-      // Buffer is full.
-      Flush(stats);
-      return_val = kFlushed;
-    }
-    RTC_LOG(LS_WARNING) << "Packet buffer flushed, "
-                        << (buffer_size_before_flush - buffer_.size())
-                        << " packets discarded.";
-  }
+  int return_val =
+      FlushIfNeeded(stats, last_decoded_length, sample_rate, target_level_ms);
 
   // Get an iterator pointing to the place in the buffer where the new packet
   // should be inserted. The list is searched from the back, since the most
@@ -402,4 +365,50 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+int PacketBuffer::FlushIfNeeded(StatisticsCalculator* stats,
+                                size_t last_decoded_length,
+                                size_t sample_rate,
+                                int target_level_ms) {
+  // Perform a smart flush if the buffer size exceeds a multiple of the target
+  // level.
+  const size_t span_threshold =
+      smart_flushing_config_
+          ? smart_flushing_config_->target_level_multiplier *
+                std::max(smart_flushing_config_->target_level_threshold_ms,
+                         target_level_ms) *
+                sample_rate / 1000
+          : 0;
+  const bool smart_flush =
+      smart_flushing_config_.has_value() &&
+      GetSpanSamples(last_decoded_length, sample_rate, true) >= span_threshold;
+  if (NumPacketsInBuffer() < max_number_of_packets_ && !smart_flush) {
+    return kOK;
+  }
+  int return_val;
+  size_t buffer_size_before_flush = NumPacketsInBuffer();
+  if (smart_flushing_config_.has_value()) {
+    // Flush down to the target level.
+    PartialFlush(target_level_ms, sample_rate, last_decoded_length, stats);
+    return_val = kPartialFlush;
+  } else {
+    // Buffer is full.
+    Flush(stats);
+    return_val = kFlushed;
+  }
+  RTC_LOG(LS_WARNING) << "Packet buffer flushed, "
+                      << (buffer_size_before_flush - NumPacketsInBuffer())
+                      << " packets discarded.";
+  return return_val;
+}
+
+void PacketBuffer::LogPacketDiscarded(int codec_level,
+                                      StatisticsCalculator* stats) {
+  RTC_CHECK(stats);
+  if (codec_level > 0) {
+    stats->SecondaryPacketsDiscarded(1);
+  } else {
+    stats->PacketsDiscarded(1);
+  }
+}
+
 }  // namespace webrtc
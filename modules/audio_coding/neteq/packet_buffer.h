@@ -170,6 +170,19 @@ class PacketBuffer {
             IsNewerTimestamp(timestamp, timestamp_limit - horizon_samples));
   }
 
+ protected:
+  // Flushes the buffer, fully or down to the target level if smart flushing is
+  // enabled, when it is full or spans more than a multiple of the target level.
+  // Shared by implementations that store the packets differently. Returns
+  // kFlushed or kPartialFlush if packets were flushed, kOK otherwise.
+  int FlushIfNeeded(StatisticsCalculator* stats,
+                    size_t last_decoded_length,
+                    size_t sample_rate,
+                    int target_level_ms);
+
+  // Updates the discard statistics for a packet with `codec_level`.
+  static void LogPacketDiscarded(int codec_level, StatisticsCalculator* stats);
+
  private:
   absl::optional<SmartFlushingConfig> smart_flushing_config_;
   size_t max_number_of_packets_;
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/neteq/tick_timer.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/neteq/decoder_database.h"
+#include "modules/audio_coding/neteq/packet.h"
+#include "modules/audio_coding/neteq/packet_buffer.h"
+#include "modules/audio_coding/neteq/ring_packet_buffer.h"
+#include "modules/audio_coding/neteq/statistics_calculator.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// 20 ms packets at 48 kHz, of which every eighth pair arrives reordered.
+constexpr size_t kMaxPacketsInBuffer = 200;
+constexpr int kSampleRateHz = 48000;
+constexpr uint32_t kFrameSizeSamples = kSampleRateHz / 50;
+constexpr size_t kPayloadSize = 120;
+constexpr int kTargetLevelMs = 100;
+constexpr uint32_t kHorizonSamples = 5 * kSampleRateHz;
+
+std::unique_ptr<PacketBuffer> CreatePacketBuffer(bool ring,
+                                                 const TickTimer* tick_timer) {
+  if (ring) {
+    return std::make_unique<RingPacketBuffer>(kMaxPacketsInBuffer, tick_timer);
+  }
+  return std::make_unique<PacketBuffer>(kMaxPacketsInBuffer, tick_timer);
+}
+
+// Returns the index of the packet that arrives as the `i`th packet.
+uint32_t ArrivalOrder(uint32_t i) {
+  switch (i % 8) {
+    case 6:
+      return i + 1;
+    case 7:
+      return i - 1;
+    default:
+      return i;
+  }
+}
+
+// A packet buffer, fed as by a NetEq instance in steady state: for every
+// packet that arrives, one packet is extracted for decoding and stale packets
+// are discarded. Extracted packets are recycled, so that only the buffer
+// itself, and not the payload, is measured.
+class Channel {
+ public:
+  Channel(bool ring, uint32_t packets_in_buffer, const TickTimer* tick_timer)
+      : decoder_database_(nullptr, absl::nullopt),
+        buffer_(CreatePacketBuffer(ring, tick_timer)) {
+    for (uint32_t i = 0; i < packets_in_buffer; ++i) {
+      Packet packet;
+      packet.payload.SetSize(kPayloadSize);
+      Insert(std::move(packet));
+    }
+  }
+
+  void Process() {
+    absl::optional<Packet> packet = buffer_->GetNextPacket();
+    RTC_DCHECK(packet);
+    buffer_->DiscardOldPackets(packet->timestamp, kHorizonSamples, &stats_);
+    Insert(*std::move(packet));
+  }
+
+ private:
+  void Insert(Packet packet) {
+    uint32_t index = ArrivalOrder(next_packet_++);
+    packet.timestamp = index * kFrameSizeSamples;
+    packet.sequence_number = static_cast<uint16_t>(index);
+    int ret = buffer_->InsertPacket(std::move(packet), &stats_,
+                                    kFrameSizeSamples, kSampleRateHz,
+                                    kTargetLevelMs, decoder_database_);
+    RTC_DCHECK_EQ(ret, PacketBuffer::kOK);
+  }
+
+  StatisticsCalculator stats_;
+  DecoderDatabase decoder_database_;
+  std::unique_ptr<PacketBuffer> buffer_;
+  uint32_t next_packet_ = 0;
+};
+
+void BM_PacketBufferInsertAndExtract(benchmark::State& state) {
+  TickTimer tick_timer;
+  Channel channel(state.range(0), state.range(1), &tick_timer);
+  for (auto _ : state) {
+    channel.Process();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Like an audio bridge, where each buffer is touched once per 10 ms and has
+// most likely been evicted from the cache in between.
+void BM_PacketBufferManyChannels(benchmark::State& state) {
+  constexpr int kNumChannels = 500;
+  TickTimer tick_timer;
+  std::vector<std::unique_ptr<Channel>> channels;
+  for (int i = 0; i < kNumChannels; ++i) {
+    channels.push_back(
+        std::make_unique<Channel>(state.range(0), state.range(1), &tick_timer));
+  }
+  for (auto _ : state) {
+    for (auto& channel : channels) {
+      channel->Process();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumChannels);
+}
+
+// Args: whether the ring buffer is used, and the number of buffered packets.
+BENCHMARK(BM_PacketBufferInsertAndExtract)
+    ->Args({0, 5})
+    ->Args({1, 5})
+    ->Args({0, 50})
+    ->Args({1, 50})
+    ->Args({0, 150})
+    ->Args({1, 150});
+BENCHMARK(BM_PacketBufferManyChannels)
+    ->Args({0, 5})
+    ->Args({1, 5})
+    ->Args({0, 50})
+    ->Args({1, 50});
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+Results (single core VM, medians of 5 repetitions):
+
+Benchmark                                      Time             CPU
+BM_PacketBufferInsertAndExtract/0/5         79.4 ns         78.9 ns
+BM_PacketBufferInsertAndExtract/1/5         63.3 ns         62.8 ns
+BM_PacketBufferInsertAndExtract/0/50         147 ns          146 ns
+BM_PacketBufferInsertAndExtract/1/50         115 ns          114 ns
+BM_PacketBufferInsertAndExtract/0/150        347 ns          345 ns
+BM_PacketBufferInsertAndExtract/1/150        235 ns          232 ns
+BM_PacketBufferManyChannels/0/5            40316 ns        40059 ns
+BM_PacketBufferManyChannels/1/5            32870 ns        32532 ns
+BM_PacketBufferManyChannels/0/50          722243 ns       716226 ns
+BM_PacketBufferManyChannels/1/50          157942 ns       156655 ns
+*/
@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/ring_packet_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/audio_codecs/audio_decoder.h"
+#include "api/neteq/tick_timer.h"
+#include "modules/audio_coding/neteq/decoder_database.h"
+#include "modules/audio_coding/neteq/statistics_calculator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace {
+
+// The packets are stored in few slots which are reused as long as the buffer
+// is shallow, which is what keeps the buffer cache friendly.
+constexpr size_t kInitialCapacity = 16;
+
+}  // namespace
+
+RingPacketBuffer::RingPacketBuffer(size_t max_number_of_packets,
+                                   const TickTimer* tick_timer)
+    : PacketBuffer(max_number_of_packets, tick_timer),
+      tick_timer_(tick_timer),
+      // A buffer that can hold no packets still holds the packet inserted
+      // right after flushing, just like PacketBuffer.
+      max_capacity_(std::max<size_t>(max_number_of_packets, 1)),
+      slots_(std::min(kInitialCapacity, max_capacity_)) {}
+
+RingPacketBuffer::~RingPacketBuffer() = default;
+
+void RingPacketBuffer::Flush(StatisticsCalculator* stats) {
+  for (size_t i = 0; i < size_; ++i) {
+    LogPacketDiscarded(At(i).priority.codec_level, stats);
+    At(i) = Packet();
+  }
+  begin_ = 0;
+  size_ = 0;
+  stats->FlushedPacketBuffer();
+}
+
+bool RingPacketBuffer::Empty() const {
+  return size_ == 0;
+}
+
+int RingPacketBuffer::InsertPacket(Packet&& packet,
+                                   StatisticsCalculator* stats,
+                                   size_t last_decoded_length,
+                                   size_t sample_rate,
+                                   int target_level_ms,
+                                   const DecoderDatabase& decoder_database) {
+  if (packet.empty()) {
+    RTC_LOG(LS_WARNING) << "InsertPacket invalid packet";
+    return kInvalidPacket;
+  }
+
+  RTC_DCHECK_GE(packet.priority.codec_level, 0);
+  RTC_DCHECK_GE(packet.priority.red_level, 0);
+
+  packet.waiting_time = tick_timer_->GetNewStopwatch();
+
+  int return_val =
+      FlushIfNeeded(stats, last_decoded_length, sample_rate, target_level_ms);
+  RTC_DCHECK_LT(size_, max_capacity_);
+
+  // Find the position where the new packet should be inserted. The buffer is
+  // searched from the back, since the most likely case is that the new packet
+  // should be near the end of the buffer.
+  size_t index = size_;
+  while (index > 0 && packet < At(index - 1)) {
+    --index;
+  }
+
+  // The new packet is to be inserted after the packet at `index - 1`. If it
+  // has the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet.
+  if (index > 0 && packet.timestamp == At(index - 1).timestamp) {
+    LogPacketDiscarded(packet.priority.codec_level, stats);
+    return return_val;
+  }
+
+  // If the new packet has the same timestamp as the packet at `index`, which
+  // has a lower priority, replace that packet with the new packet.
+  if (index < size_ && packet.timestamp == At(index).timestamp) {
+    LogPacketDiscarded(At(index).priority.codec_level, stats);
+    At(index) = std::move(packet);
+    return return_val;
+  }
+
+  InsertAt(index, std::move(packet));
+  return return_val;
+}
+
+int RingPacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
+  if (Empty()) {
+    return kBufferEmpty;
+  }
+  if (!next_timestamp) {
+    return kInvalidPointer;
+  }
+  *next_timestamp = At(0).timestamp;
+  return kOK;
+}
+
+int RingPacketBuffer::NextHigherTimestamp(uint32_t timestamp,
+                                          uint32_t* next_timestamp) const {
+  if (Empty()) {
+    return kBufferEmpty;
+  }
+  if (!next_timestamp) {
+    return kInvalidPointer;
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    if (At(i).timestamp >= timestamp) {
+      // Found a packet matching the search.
+      *next_timestamp = At(i).timestamp;
+      return kOK;
+    }
+  }
+  return kNotFound;
+}
+
+const Packet* RingPacketBuffer::PeekNextPacket() const {
+  return Empty() ? nullptr : &At(0);
+}
+
+absl::optional<Packet> RingPacketBuffer::GetNextPacket() {
+  if (Empty()) {
+    return absl::nullopt;
+  }
+
+  absl::optional<Packet> packet(std::move(At(0)));
+  // Assert that the packet sanity checks in InsertPacket method works.
+  RTC_DCHECK(!packet->empty());
+  // The moved-from slot holds no memory, so there is no need to reset it.
+  begin_ = begin_ + 1 < slots_.size() ? begin_ + 1 : 0;
+  --size_;
+
+  return packet;
+}
+
+int RingPacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
+  if (Empty()) {
+    return kBufferEmpty;
+  }
+  // Assert that the packet sanity checks in InsertPacket method works.
+  RTC_DCHECK(!At(0).empty());
+  LogPacketDiscarded(At(0).priority.codec_level, stats);
+  PopFront();
+  return kOK;
+}
+
+void RingPacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
+                                         uint32_t horizon_samples,
+                                         StatisticsCalculator* stats) {
+  RemoveIf([timestamp_limit, horizon_samples, stats](const Packet& p) {
+    if (timestamp_limit == p.timestamp ||
+        !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
+      return false;
+    }
+    LogPacketDiscarded(p.priority.codec_level, stats);
+    return true;
+  });
+}
+
+void RingPacketBuffer::DiscardPacketsWithPayloadType(
+    uint8_t payload_type,
+    StatisticsCalculator* stats) {
+  RemoveIf([payload_type, stats](const Packet& p) {
+    if (p.payload_type != payload_type) {
+      return false;
+    }
+    LogPacketDiscarded(p.priority.codec_level, stats);
+    return true;
+  });
+}
+
+size_t RingPacketBuffer::NumPacketsInBuffer() const {
+  return size_;
+}
+
+size_t RingPacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
+  size_t num_samples = 0;
+  size_t last_duration = last_decoded_length;
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
+    if (packet.frame) {
+      if (packet.priority != Packet::Priority(0, 0)) {
+        continue;
+      }
+      size_t duration = packet.frame->Duration();
+      if (duration > 0) {
+        last_duration = duration;  // Save the most up-to-date (valid) duration.
+      }
+    }
+    num_samples += last_duration;
+  }
+  return num_samples;
+}
+
+size_t RingPacketBuffer::GetSpanSamples(size_t last_decoded_length,
+                                        size_t sample_rate,
+                                        bool count_dtx_waiting_time) const {
+  if (Empty()) {
+    return 0;
+  }
+
+  const Packet& back = At(size_ - 1);
+  size_t span = back.timestamp - At(0).timestamp;
+  if (back.frame && back.frame->Duration() > 0) {
+    size_t duration = back.frame->Duration();
+    if (count_dtx_waiting_time && back.frame->IsDtxPacket()) {
+      size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
+          back.waiting_time->ElapsedMs() * (sample_rate / 1000));
+      duration = std::max(duration, waiting_time_samples);
+    }
+    span += duration;
+  } else {
+    span += last_decoded_length;
+  }
+  return span;
+}
+
+bool RingPacketBuffer::ContainsDtxOrCngPacket(
+    const DecoderDatabase* decoder_database) const {
+  RTC_DCHECK(decoder_database);
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
+    if ((packet.frame && packet.frame->IsDtxPacket()) ||
+        decoder_database->IsComfortNoise(packet.payload_type)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Packet& RingPacketBuffer::At(size_t index) {
+  RTC_DCHECK_LT(index, slots_.size());
+  size_t slot = begin_ + index;
+  return slots_[slot < slots_.size() ? slot : slot - slots_.size()];
+}
+
+const Packet& RingPacketBuffer::At(size_t index) const {
+  RTC_DCHECK_LT(index, slots_.size());
+  size_t slot = begin_ + index;
+  return slots_[slot < slots_.size() ? slot : slot - slots_.size()];
+}
+
+void RingPacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  if (size_ == slots_.size()) {
+    Grow();
+  }
+  if (index >= size_ / 2) {
+    // Move the packets after `index` one step towards the back.
+    for (size_t i = size_; i > index; --i) {
+      At(i) = std::move(At(i - 1));
+    }
+  } else {
+    // Move the packets before `index` one step towards the front.
+    begin_ = begin_ > 0 ? begin_ - 1 : slots_.size() - 1;
+    for (size_t i = 0; i < index; ++i) {
+      At(i) = std::move(At(i + 1));
+    }
+  }
+  At(index) = std::move(packet);
+  ++size_;
+}
+
+void RingPacketBuffer::Grow() {
+  RTC_DCHECK_LT(slots_.size(), max_capacity_);
+  std::vector<Packet> slots(std::min(2 * slots_.size(), max_capacity_));
+  for (size_t i = 0; i < size_; ++i) {
+    slots[i] = std::move(At(i));
+  }
+  slots_ = std::move(slots);
+  begin_ = 0;
+}
+
+void RingPacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  At(0) = Packet();
+  begin_ = begin_ + 1 < slots_.size() ? begin_ + 1 : 0;
+  --size_;
+}
+
+template <typename Predicate>
+void RingPacketBuffer::RemoveIf(Predicate pred) {
+  // Nothing has to be moved until the first packet is removed, which in most
+  // calls never happens.
+  size_t kept = 0;
+  while (kept < size_ && !pred(At(kept))) {
+    ++kept;
+  }
+  for (size_t i = kept + 1; i < size_; ++i) {
+    if (!pred(At(i))) {
+      At(kept++) = std::move(At(i));
+    }
+  }
+  for (size_t i = kept; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  size_ = kept;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_RING_PACKET_BUFFER_H_
+#define MODULES_AUDIO_CODING_NETEQ_RING_PACKET_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/neteq/packet.h"
+#include "modules/audio_coding/neteq/packet_buffer.h"
+
+namespace webrtc {
+
+// A PacketBuffer that keeps the packets sorted in a ring buffer instead of a
+// list. The ring grows, up to `max_number_of_packets` packets, when it is
+// full; apart from that, inserting and extracting packets does not allocate.
+// Since packets are nearly always inserted close to the end and extracted from
+// the front, few packets have to be moved. Behaves exactly like PacketBuffer.
+class RingPacketBuffer : public PacketBuffer {
+ public:
+  RingPacketBuffer(size_t max_number_of_packets, const TickTimer* tick_timer);
+  ~RingPacketBuffer() override;
+
+  void Flush(StatisticsCalculator* stats) override;
+  bool Empty() const override;
+  int InsertPacket(Packet&& packet,
+                   StatisticsCalculator* stats,
+                   size_t last_decoded_length,
+                   size_t sample_rate,
+                   int target_level_ms,
+                   const DecoderDatabase& decoder_database) override;
+  int NextTimestamp(uint32_t* next_timestamp) const override;
+  int NextHigherTimestamp(uint32_t timestamp,
+                          uint32_t* next_timestamp) const override;
+  const Packet* PeekNextPacket() const override;
+  absl::optional<Packet> GetNextPacket() override;
+  int DiscardNextPacket(StatisticsCalculator* stats) override;
+  void DiscardOldPackets(uint32_t timestamp_limit,
+                         uint32_t horizon_samples,
+                         StatisticsCalculator* stats) override;
+  void DiscardPacketsWithPayloadType(uint8_t payload_type,
+                                     StatisticsCalculator* stats) override;
+  size_t NumPacketsInBuffer() const override;
+  size_t NumSamplesInBuffer(size_t last_decoded_length) const override;
+  size_t GetSpanSamples(size_t last_decoded_length,
+                        size_t sample_rate,
+                        bool count_dtx_waiting_time) const override;
+  bool ContainsDtxOrCngPacket(
+      const DecoderDatabase* decoder_database) const override;
+
+ private:
+  // Returns the packet at `index`, counted from the front of the buffer.
+  Packet& At(size_t index);
+  const Packet& At(size_t index) const;
+
+  // Inserts `packet` before the packet at `index`, moving the packets on the
+  // shorter side of `index` one step.
+  void InsertAt(size_t index, Packet&& packet);
+
+  // Doubles the number of slots, keeping the packets in order.
+  void Grow();
+
+  // Removes the first packet in the buffer.
+  void PopFront();
+
+  // Removes all packets for which `pred` returns true, keeping the order of
+  // the remaining packets.
+  template <typename Predicate>
+  void RemoveIf(Predicate pred);
+
+  const TickTimer* const tick_timer_;
+  const size_t max_capacity_;
+  // The `size_` packets in the buffer are stored in order starting at index
+  // `begin_`, wrapping around at the end. The other slots hold no data.
+  std::vector<Packet> slots_;
+  size_t begin_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_RING_PACKET_BUFFER_H_
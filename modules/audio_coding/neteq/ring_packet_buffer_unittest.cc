@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/ring_packet_buffer.h"
+
+#include <utility>
+
+#include "api/neteq/tick_timer.h"
+#include "modules/audio_coding/neteq/mock/mock_decoder_database.h"
+#include "modules/audio_coding/neteq/mock/mock_statistics_calculator.h"
+#include "modules/audio_coding/neteq/packet.h"
+#include "modules/audio_coding/neteq/packet_buffer.h"
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::NiceMock;
+using ::testing::StrictMock;
+
+constexpr int kFrameSize = 10;
+constexpr size_t kPayloadLength = 10;
+constexpr size_t kSampleRate = 1000;
+constexpr int kTargetLevelMs = 60;
+
+Packet CreatePacket(uint32_t timestamp,
+                    uint16_t sequence_number,
+                    int codec_level = 0,
+                    uint8_t payload_type = 0) {
+  Packet packet;
+  packet.timestamp = timestamp;
+  packet.sequence_number = sequence_number;
+  packet.payload_type = payload_type;
+  packet.priority = Packet::Priority(codec_level, 0);
+  packet.payload.SetSize(kPayloadLength);
+  return packet;
+}
+
+int Insert(PacketBuffer& buffer,
+           Packet packet,
+           StatisticsCalculator& stats,
+           const DecoderDatabase& decoder_database) {
+  return buffer.InsertPacket(std::move(packet), &stats, kPayloadLength,
+                             kSampleRate, kTargetLevelMs, decoder_database);
+}
+
+TEST(RingPacketBufferTest, ExtractsPacketsInTimestampOrder) {
+  TickTimer tick_timer;
+  RingPacketBuffer buffer(10, &tick_timer);
+  StrictMock<MockStatisticsCalculator> stats;
+  MockDecoderDatabase decoder_database;
+
+  const uint32_t kInsertOrder[] = {3, 4, 0, 1, 7, 2, 5, 6};
+  for (uint32_t i : kInsertOrder) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              Insert(buffer, CreatePacket(i * kFrameSize, i), stats,
+                     decoder_database));
+  }
+  EXPECT_EQ(8u, buffer.NumPacketsInBuffer());
+  EXPECT_EQ(8u * kFrameSize,
+            buffer.GetSpanSamples(kFrameSize, kSampleRate, false));
+
+  for (uint32_t i = 0; i < 8; ++i) {
+    absl::optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(i * kFrameSize, packet->timestamp);
+  }
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_CALL(decoder_database, Die());
+}
+
+TEST(RingPacketBufferTest, KeepsHighestPriorityPacketForEachTimestamp) {
+  TickTimer tick_timer;
+  RingPacketBuffer buffer(10, &tick_timer);
+  StrictMock<MockStatisticsCalculator> stats;
+  MockDecoderDatabase decoder_database;
+
+  // A redundant copy of a packet that is already buffered is discarded.
+  Insert(buffer, CreatePacket(100, 1, /*codec_level=*/0), stats,
+         decoder_database);
+  EXPECT_CALL(stats, SecondaryPacketsDiscarded(1));
+  Insert(buffer, CreatePacket(100, 1, /*codec_level=*/1), stats,
+         decoder_database);
+
+  // A primary packet replaces the redundant copy received before it.
+  Insert(buffer, CreatePacket(110, 2, /*codec_level=*/1), stats,
+         decoder_database);
+  EXPECT_CALL(stats, SecondaryPacketsDiscarded(1));
+  Insert(buffer, CreatePacket(110, 2, /*codec_level=*/0), stats,
+         decoder_database);
+
+  ASSERT_EQ(2u, buffer.NumPacketsInBuffer());
+  EXPECT_EQ(Packet::Priority(0, 0), buffer.GetNextPacket()->priority);
+  EXPECT_EQ(Packet::Priority(0, 0), buffer.GetNextPacket()->priority);
+  EXPECT_CALL(decoder_database, Die());
+}
+
+TEST(RingPacketBufferTest, FlushesWhenFull) {
+  TickTimer tick_timer;
+  RingPacketBuffer buffer(10, &tick_timer);
+  StrictMock<MockStatisticsCalculator> stats;
+  MockDecoderDatabase decoder_database;
+
+  for (uint16_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              Insert(buffer, CreatePacket(i * kFrameSize, i), stats,
+                     decoder_database));
+  }
+  EXPECT_CALL(stats, PacketsDiscarded(1)).Times(10);
+  EXPECT_EQ(PacketBuffer::kFlushed,
+            Insert(buffer, CreatePacket(10 * kFrameSize, 10), stats,
+                   decoder_database));
+  EXPECT_EQ(1u, buffer.NumPacketsInBuffer());
+  uint32_t next_timestamp;
+  EXPECT_EQ(PacketBuffer::kOK, buffer.NextTimestamp(&next_timestamp));
+  EXPECT_EQ(10u * kFrameSize, next_timestamp);
+  EXPECT_CALL(decoder_database, Die());
+}
+
+// Runs a random sequence of operations on a RingPacketBuffer and a
+// PacketBuffer and verifies that they behave identically, also when the ring
+// wraps around and when the timestamps wrap around.
+TEST(RingPacketBufferTest, BehavesLikePacketBuffer) {
+  constexpr size_t kMaxPackets = 20;
+  TickTimer tick_timer;
+  RingPacketBuffer ring_buffer(kMaxPackets, &tick_timer);
+  PacketBuffer list_buffer(kMaxPackets, &tick_timer);
+  NiceMock<MockStatisticsCalculator> stats;
+  MockDecoderDatabase decoder_database;
+  Random random(4711);
+
+  uint32_t timestamp = 0xFFFFFFFF - 1000 * kFrameSize;
+  uint16_t sequence_number = 0xFFFF - 1000;
+  for (int i = 0; i < 10000; ++i) {
+    const uint32_t operation = random.Rand(0, 99);
+    if (operation < 70) {
+      // Insert a packet, possibly reordered, duplicated, or redundant.
+      int offset = random.Rand(0, 6) - 3;
+      int codec_level = random.Rand(0, 1);
+      uint8_t payload_type = random.Rand(0, 1);
+      Packet packet =
+          CreatePacket(timestamp + offset * kFrameSize,
+                       sequence_number + offset, codec_level, payload_type);
+      int list_result =
+          Insert(list_buffer, packet.Clone(), stats, decoder_database);
+      int ring_result =
+          Insert(ring_buffer, std::move(packet), stats, decoder_database);
+      EXPECT_EQ(list_result, ring_result);
+      timestamp += kFrameSize;
+      ++sequence_number;
+    } else if (operation < 90) {
+      absl::optional<Packet> list_packet = list_buffer.GetNextPacket();
+      absl::optional<Packet> ring_packet = ring_buffer.GetNextPacket();
+      ASSERT_EQ(list_packet.has_value(), ring_packet.has_value());
+      if (list_packet) {
+        EXPECT_EQ(*list_packet, *ring_packet);
+      }
+    } else if (operation < 95) {
+      uint32_t timestamp_limit =
+          timestamp - random.Rand(0, 2 * kMaxPackets) * kFrameSize;
+      list_buffer.DiscardOldPackets(timestamp_limit, 0, &stats);
+      ring_buffer.DiscardOldPackets(timestamp_limit, 0, &stats);
+    } else {
+      uint8_t payload_type = random.Rand(0, 1);
+      list_buffer.DiscardPacketsWithPayloadType(payload_type, &stats);
+      ring_buffer.DiscardPacketsWithPayloadType(payload_type, &stats);
+    }
+
+    ASSERT_EQ(list_buffer.NumPacketsInBuffer(),
+              ring_buffer.NumPacketsInBuffer());
+    EXPECT_EQ(list_buffer.GetSpanSamples(kFrameSize, kSampleRate, false),
+              ring_buffer.GetSpanSamples(kFrameSize, kSampleRate, false));
+    EXPECT_EQ(list_buffer.NumSamplesInBuffer(kFrameSize),
+              ring_buffer.NumSamplesInBuffer(kFrameSize));
+    uint32_t list_next_timestamp = 0;
+    uint32_t ring_next_timestamp = 0;
+    EXPECT_EQ(list_buffer.NextTimestamp(&list_next_timestamp),
+              ring_buffer.NextTimestamp(&ring_next_timestamp));
+    EXPECT_EQ(list_next_timestamp, ring_next_timestamp);
+  }
+  EXPECT_CALL(decoder_database, Die());
+}
+
+}  // namespace
+}  // namespace webrtc
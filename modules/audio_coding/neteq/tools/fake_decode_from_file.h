@@ -25,7 +25,8 @@ namespace test {
 // encoding represents, and how many samples the decoder should produce for that
 // encoding. A helper method PrepareEncoded is provided to prepare such
 // encodings. If packets are missing, as determined from the timestamps, the
-// file reading will skip forward to match the loss.
+// file reading will skip forward to match the loss. Without an input file,
+// silence is produced, which is enough when only NetEq's statistics matter.
 class FakeDecodeFromFile : public AudioDecoder {
  public:
   FakeDecodeFromFile(std::unique_ptr<InputAudioFile> input,
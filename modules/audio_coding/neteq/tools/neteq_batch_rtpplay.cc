@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulator.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
+
+using TestConfig = webrtc::test::NetEqTestFactory::Config;
+
+ABSL_FLAG(int, threads, 4, "Number of simulations to run in parallel");
+ABSL_FLAG(bool,
+          stats_only,
+          true,
+          "Replaces the audio payloads with fake ones that aren't decoded. "
+          "Only NetEq's statistics are valid then.");
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+          " will assign the group Enable to field trial WebRTC-FooFeature.");
+ABSL_FLAG(int,
+          max_nr_packets_in_buffer,
+          TestConfig::default_max_nr_packets_in_buffer(),
+          "Maximum allowed number of packets in the buffer");
+ABSL_FLAG(bool,
+          enable_fast_accelerate,
+          false,
+          "Enables jitter buffer fast accelerate");
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() < 2) {
+    printf(
+        "Tool for simulating many RTP dump files using NetEq in parallel, "
+        "which prints the statistics of each simulation as CSV.\n"
+        "Example usage:\n"
+        "./neteq_batch_rtpplay --threads=8 input1.rtp input2.rtp ...\n");
+    return 0;
+  }
+
+  // Make force_fieldtrials persistent string during entire program live as
+  // absl::GetFlag creates temporary string and c_str() will point to
+  // deallocated string.
+  const std::string force_fieldtrials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(force_fieldtrials.c_str());
+
+  TestConfig config;
+  config.stats_only = absl::GetFlag(FLAGS_stats_only);
+  config.max_nr_packets_in_buffer =
+      absl::GetFlag(FLAGS_max_nr_packets_in_buffer);
+  config.enable_fast_accelerate = absl::GetFlag(FLAGS_enable_fast_accelerate);
+
+  std::vector<webrtc::test::NetEqBatchSimulator::Job> jobs;
+  for (size_t i = 1; i < args.size(); ++i) {
+    jobs.push_back({args[i], config});
+  }
+  const std::vector<webrtc::test::NetEqBatchSimulator::Result> results =
+      webrtc::test::NetEqBatchSimulator::Run(jobs,
+                                             absl::GetFlag(FLAGS_threads));
+
+  printf(
+      "input,output_duration_ms,expand_rate,speech_expand_rate,"
+      "preemptive_rate,accelerate_rate,mean_waiting_time_ms,"
+      "current_buffer_size_ms,preferred_buffer_size_ms,concealed_samples,"
+      "total_samples_received\n");
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    const auto& result = results[i];
+    if (!result.ok) {
+      printf("%s,error\n", jobs[i].input_filename.c_str());
+      continue;
+    }
+    const auto& stats = result.average_stats;
+    printf("%s,%lld,%f,%f,%f,%f,%f,%f,%f,%llu,%llu\n",
+           jobs[i].input_filename.c_str(),
+           static_cast<long long>(result.output_duration_ms),  // NOLINT
+           stats.expand_rate, stats.speech_expand_rate, stats.preemptive_rate,
+           stats.accelerate_rate, stats.mean_waiting_time_ms,
+           stats.current_buffer_size_ms, stats.preferred_buffer_size_ms,
+           static_cast<unsigned long long>(  // NOLINT
+               result.lifetime_stats.concealed_samples),
+           static_cast<unsigned long long>(  // NOLINT
+               result.lifetime_stats.total_samples_received));
+  }
+  return 0;
+}
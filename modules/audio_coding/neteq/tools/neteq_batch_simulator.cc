@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+NetEqBatchSimulator::Result RunJob(const NetEqBatchSimulator::Job& job) {
+  NetEqBatchSimulator::Result result;
+  NetEqTestFactory factory;
+  std::unique_ptr<NetEqTest> test = factory.InitializeTestFromFile(
+      job.input_filename, /*neteq_factory=*/nullptr, job.config);
+  if (!test) {
+    return result;
+  }
+  result.ok = true;
+  result.output_duration_ms = test->Run();
+  result.average_stats = factory.stats_getter()->AverageStats();
+  result.lifetime_stats = test->LifetimeStats();
+  return result;
+}
+
+}  // namespace
+
+std::vector<NetEqBatchSimulator::Result> NetEqBatchSimulator::Run(
+    const std::vector<Job>& jobs,
+    int num_threads) {
+  RTC_CHECK_GT(num_threads, 0);
+  for (const Job& job : jobs) {
+    RTC_CHECK(job.config.field_trial_string.empty())
+        << "Field trials can't be set per job.";
+  }
+
+  std::vector<Result> results(jobs.size());
+  // Each thread takes the next job that no other thread has taken yet, and
+  // writes only its result.
+  std::atomic<size_t> next_job(0);
+  auto run_jobs = [&] {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      results[i] = RunJob(jobs[i]);
+    }
+  };
+
+  std::vector<rtc::PlatformThread> threads;
+  const size_t num_spawned_threads =
+      std::min(jobs.size(), static_cast<size_t>(num_threads));
+  for (size_t i = 0; i < num_spawned_threads; ++i) {
+    threads.push_back(
+        rtc::PlatformThread::SpawnJoinable(run_jobs, "NetEqBatchSimulator"));
+  }
+  // Destroying the threads joins them.
+  threads.clear();
+  return results;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "api/neteq/neteq.h"
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+#include "modules/audio_coding/neteq/tools/neteq_test_factory.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs many NetEq simulations, e.g. of a corpus of dumps or of one dump with
+// different parameters, in parallel on a number of threads. Each simulation
+// has its own NetEq and is independent of the others, so the results are the
+// same as when running them one by one with neteq_rtpplay.
+class NetEqBatchSimulator {
+ public:
+  struct Job {
+    std::string input_filename;
+    // Field trials are global, so `config.field_trial_string` must be empty.
+    // Set them for the whole process instead.
+    NetEqTestFactory::Config config;
+  };
+
+  struct Result {
+    // False if the simulation couldn't be set up, e.g. because the input
+    // couldn't be read.
+    bool ok = false;
+    int64_t output_duration_ms = 0;
+    // NetEq's network statistics, averaged over the simulation.
+    NetEqStatsGetter::Stats average_stats;
+    NetEqLifetimeStatistics lifetime_stats;
+  };
+
+  // Returns the results of `jobs`, in the same order, after running them on
+  // `num_threads` threads.
+  static std::vector<Result> Run(const std::vector<Job>& jobs,
+                                 int num_threads);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATOR_H_
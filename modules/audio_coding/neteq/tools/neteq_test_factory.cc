@@ -151,6 +151,11 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTestFromFile(
   return InitializeTest(std::move(input), factory, config);
 }
 
+NetEqStatsGetter* NetEqTestFactory::stats_getter() {
+  RTC_DCHECK(stats_plotter_);
+  return stats_plotter_->stats_getter();
+}
+
 std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     std::unique_ptr<NetEqInput> input,
     NetEqFactory* factory,
@@ -231,7 +236,7 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
 
   // If an output file is requested, open it.
   std::unique_ptr<AudioSink> output;
-  if (!config.output_audio_filename.has_value()) {
+  if (!config.output_audio_filename.has_value() || config.stats_only) {
     output = std::make_unique<VoidAudioSink>();
     std::cout << "No output audio file" << std::endl;
   } else if (config.output_audio_filename->size() >= 4 &&
@@ -255,7 +260,7 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
       CreateBuiltinAudioDecoderFactory();
 
   // Check if a replacement audio file was provided.
-  if (config.replacement_audio_file.size() > 0) {
+  if (config.replacement_audio_file.size() > 0 || config.stats_only) {
     // Find largest unused payload type.
     int replacement_pt = 127;
     while (codecs.find(replacement_pt) != codecs.end()) {
@@ -293,7 +298,9 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
               decoder_factory->MakeAudioDecoder(format, codec_pair_id);
           if (!decoder && format.name == "replacement") {
             decoder = std::make_unique<FakeDecodeFromFile>(
-                std::make_unique<InputAudioFile>(config.replacement_audio_file),
+                config.stats_only ? nullptr
+                                  : std::make_unique<InputAudioFile>(
+                                        config.replacement_audio_file),
                 format.clockrate_hz, format.num_channels > 1);
           }
           return decoder;
@@ -328,7 +335,9 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
       new SsrcSwitchDetector(stats_plotter_->stats_getter()->delay_analyzer()));
   callbacks.post_insert_packet = ssrc_switch_detector_.get();
   callbacks.get_audio_callback = stats_plotter_->stats_getter();
-  callbacks.simulation_ended_callback = stats_plotter_.get();
+  if (!config.stats_only) {
+    callbacks.simulation_ended_callback = stats_plotter_.get();
+  }
   NetEq::Config neteq_config;
   neteq_config.sample_rate_hz = *sample_rate_hz;
   neteq_config.max_packets_in_buffer = config.max_nr_packets_in_buffer;
@@ -143,6 +143,13 @@ class NetEqTestFactory {
     absl::optional<std::string> output_audio_filename;
     // Field trials to use during the simulation.
     std::string field_trial_string;
+    // Replaces all audio payloads with fake ones that decode to silence, and
+    // doesn't print the statistics when the simulation ends. This is much
+    // faster when only NetEq's statistics are of interest, e.g. when tuning
+    // parameters over many dumps. `replacement_audio_file` and
+    // `output_audio_filename` are ignored, and dumps with G.722, RED or DTMF
+    // packets can't be simulated.
+    bool stats_only = false;
   };
 
   std::unique_ptr<NetEqTest> InitializeTestFromFile(
@@ -154,6 +161,10 @@ class NetEqTestFactory {
       NetEqFactory* neteq_factory,
       const Config& config);
 
+  // The statistics collected during the simulation of the last initialized
+  // test.
+  NetEqStatsGetter* stats_getter();
+
  private:
   std::unique_ptr<NetEqTest> InitializeTest(std::unique_ptr<NetEqInput> input,
                                             NetEqFactory* neteq_factory,
@@ -26,7 +26,11 @@ class OutputWavFile : public AudioSink {
   OutputWavFile(const std::string& file_name,
                 int sample_rate_hz,
                 int num_channels = 1)
-      : wav_writer_(file_name, sample_rate_hz, num_channels) {}
+      : wav_writer_(file_name,
+                    sample_rate_hz,
+                    num_channels,
+                    WavFile::SampleFormat::kInt16,
+                    /*asynchronous=*/true) {}
 
   OutputWavFile(const OutputWavFile&) = delete;
   OutputWavFile& operator=(const OutputWavFile&) = delete;
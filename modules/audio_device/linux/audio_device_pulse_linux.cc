@@ -14,8 +14,11 @@
 
 #include "modules/audio_device/linux/latebindingsymboltable_linux.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/field_trial.h"
 
 WebRTCPulseSymbolTable* GetPulseSymbolTable() {
   static WebRTCPulseSymbolTable* pulse_symbol_table =
@@ -31,6 +34,14 @@ WebRTCPulseSymbolTable* GetPulseSymbolTable() {
               GetPulseSymbolTable(), sym)
 
 namespace webrtc {
+namespace {
+
+// Lets the capture fragment size and the playout buffer latency be tuned
+// below the defaults, e.g. on dedicated hardware where the CPU spent on
+// smaller transfers is not a concern.
+constexpr char kLowLatencyFieldTrial[] = "WebRTC-Audio-PulseLowLatency";
+
+}  // namespace
 
 AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
     : _ptrAudioBuffer(NULL),
@@ -81,6 +92,26 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
       _playStreamFlags(0) {
   RTC_DLOG(LS_INFO) << __FUNCTION__ << " created";
 
+  FieldTrialParameter<int> capture_fragment_ms(
+      "capture_fragment_ms", WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS);
+  FieldTrialParameter<int> playout_latency_ms(
+      "playout_latency_ms", WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS);
+  FieldTrialParameter<int> playout_latency_increment_ms(
+      "playout_latency_increment_ms",
+      WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS);
+  ParseFieldTrial(
+      {&capture_fragment_ms, &playout_latency_ms,
+       &playout_latency_increment_ms},
+      field_trial::FindFullName(kLowLatencyFieldTrial));
+  // Only ever lower the latencies, see the comments on the constants.
+  capture_fragment_ms_ = rtc::SafeClamp<int>(
+      capture_fragment_ms.Get(), 1, WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS);
+  playout_latency_ms_ = rtc::SafeClamp<int>(
+      playout_latency_ms.Get(), 1, WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS);
+  playout_latency_increment_ms_ =
+      rtc::SafeClamp<int>(playout_latency_increment_ms.Get(), 1,
+                          WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS);
+
   memset(_paServerVersion, 0, sizeof(_paServerVersion));
   memset(&_playBufferAttr, 0, sizeof(_playBufferAttr));
   memset(&_recBufferAttr, 0, sizeof(_recBufferAttr));
@@ -912,8 +943,8 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    uint32_t latency =
+        bytesPerSec * playout_latency_ms_ / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the play buffer attributes
     _playBufferAttr.maxlength = latency;  // num bytes stored in the buffer
@@ -1013,8 +1044,8 @@ int32_t AudioDeviceLinuxPulse::InitRecording() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    uint32_t latency =
+        bytesPerSec * capture_fragment_ms_ / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the rec buffer attributes
     // Note: fragsize specifies a maximum transfer size, not a minimum, so
@@ -1778,9 +1809,8 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler() {
 
   size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
   uint32_t newLatency =
-      _configuredLatencyPlay + bytesPerSec *
-                                   WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
-                                   WEBRTC_PA_MSECS_PER_SEC;
+      _configuredLatencyPlay +
+      bytesPerSec * playout_latency_increment_ms_ / WEBRTC_PA_MSECS_PER_SEC;
 
   // Set the play buffer attributes
   _playBufferAttr.maxlength = newLatency;
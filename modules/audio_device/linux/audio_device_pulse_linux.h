@@ -62,7 +62,8 @@ const uint32_t WEBRTC_PA_ADJUST_LATENCY_PROTOCOL_VERSION = 13;
 // automatically increase the latency if a buffer underflow does occur, but we
 // also enforce a sane minimum at start-up time. Anything lower would be
 // virtually guaranteed to underflow at least once, so there's no point in
-// allowing lower latencies.
+// allowing lower latencies, unless the "WebRTC-Audio-PulseLowLatency" field
+// trial asks for one on hardware known to keep up.
 const uint32_t WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS = 20;
 
 // Every time a playback stream underflows, we will reconfigure it with target
@@ -322,6 +323,11 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   size_t _tempSampleDataSize;
   int32_t _configuredLatencyPlay;
   int32_t _configuredLatencyRec;
+  // Defaults to the WEBRTC_PA_* constants above, and can be lowered through
+  // the "WebRTC-Audio-PulseLowLatency" field trial.
+  uint32_t capture_fragment_ms_;
+  uint32_t playout_latency_ms_;
+  uint32_t playout_latency_increment_ms_;
 
   // PulseAudio
   uint16_t _paDeviceIndex;
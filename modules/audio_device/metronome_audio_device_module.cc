@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/metronome_audio_device_module.h"
+
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kFrameLength = TimeDelta::Millis(10);
+
+}  // namespace
+
+MetronomeAudioDeviceModule::MetronomeAudioDeviceModule(
+    Metronome* metronome,
+    TaskQueueBase* tick_task_queue,
+    int sample_rate_hz,
+    size_t num_channels,
+    RenderCallback render_callback)
+    : metronome_(metronome),
+      tick_task_queue_(tick_task_queue),
+      sample_rate_hz_(sample_rate_hz),
+      num_channels_(num_channels),
+      render_callback_(std::move(render_callback)) {
+  RTC_DCHECK(metronome_);
+  RTC_DCHECK(tick_task_queue_);
+  RTC_DCHECK_EQ(sample_rate_hz_ % 100, 0);
+  RTC_DCHECK_GE(num_channels_, 1);
+  RTC_DCHECK_LE(num_channels_, 2);
+  RTC_DCHECK(render_callback_);
+}
+
+MetronomeAudioDeviceModule::~MetronomeAudioDeviceModule() {
+  StopPlayout();
+}
+
+int32_t MetronomeAudioDeviceModule::RegisterAudioCallback(
+    AudioTransport* audio_callback) {
+  MutexLock lock(&lock_);
+  audio_callback_ = audio_callback;
+  return 0;
+}
+
+int32_t MetronomeAudioDeviceModule::StartPlayout() {
+  {
+    MutexLock lock(&lock_);
+    if (playing_)
+      return 0;
+    playing_ = true;
+    pending_playout_ = TimeDelta::Zero();
+  }
+  metronome_->AddListener(this);
+  return 0;
+}
+
+int32_t MetronomeAudioDeviceModule::StopPlayout() {
+  {
+    MutexLock lock(&lock_);
+    if (!playing_)
+      return 0;
+    playing_ = false;
+  }
+  // Not holding `lock_`, which the metronome may be waiting for in OnTick().
+  metronome_->RemoveListener(this);
+  return 0;
+}
+
+bool MetronomeAudioDeviceModule::Playing() const {
+  MutexLock lock(&lock_);
+  return playing_;
+}
+
+int32_t MetronomeAudioDeviceModule::StereoPlayoutIsAvailable(
+    bool* available) const {
+  *available = num_channels_ == 2;
+  return 0;
+}
+
+int32_t MetronomeAudioDeviceModule::StereoPlayout(bool* enabled) const {
+  *enabled = num_channels_ == 2;
+  return 0;
+}
+
+void MetronomeAudioDeviceModule::OnTick() {
+  RTC_DCHECK_RUN_ON(tick_task_queue_);
+  MutexLock lock(&lock_);
+  if (!playing_ || !audio_callback_)
+    return;
+
+  pending_playout_ += metronome_->TickPeriod();
+  const int64_t num_frames = pending_playout_.us() / kFrameLength.us();
+  if (num_frames == 0)
+    return;
+  pending_playout_ -= num_frames * kFrameLength;
+
+  const size_t samples_per_channel = num_frames * sample_rate_hz_ / 100;
+  playout_buffer_.SetSize(samples_per_channel * num_channels_);
+  size_t samples_out = 0;
+  int64_t elapsed_time_ms = -1;
+  int64_t ntp_time_ms = -1;
+  audio_callback_->NeedMorePlayData(
+      samples_per_channel, sizeof(int16_t) * num_channels_, num_channels_,
+      sample_rate_hz_, playout_buffer_.data(), samples_out, &elapsed_time_ms,
+      &ntp_time_ms);
+  RTC_DCHECK_LE(samples_out, playout_buffer_.size());
+  render_callback_(
+      rtc::ArrayView<const int16_t>(playout_buffer_.data(), samples_out),
+      sample_rate_hz_, num_channels_);
+}
+
+TaskQueueBase* MetronomeAudioDeviceModule::OnTickTaskQueue() {
+  return tick_task_queue_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_DEVICE_METRONOME_AUDIO_DEVICE_MODULE_H_
+#define MODULES_AUDIO_DEVICE_METRONOME_AUDIO_DEVICE_MODULE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "api/array_view.h"
+#include "api/metronome/metronome.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "modules/audio_device/include/audio_device.h"
+#include "modules/audio_device/include/audio_device_default.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Headless AudioDeviceModule for servers, which pulls playout audio on the
+// ticks of a Metronome instead of on a thread of its own, and hands it to
+// `render_callback`. Modules of many AudioStates can share a metronome and a
+// tick task queue, so that all of them are served by a single wake-up.
+//
+// Each tick pulls the audio of a whole tick period in one
+// NeedMorePlayData() call, rounded down to 10 ms with the remainder carried
+// over to the next tick. The AudioTransport must accept such requests, as
+// AudioTransportImpl does. The audio is mixed straight into a buffer that is
+// then passed to `render_callback` as is.
+//
+// Recording is not supported. Create with rtc::make_ref_counted().
+class MetronomeAudioDeviceModule
+    : public webrtc_impl::AudioDeviceModuleDefault<AudioDeviceModule>,
+      public Metronome::TickListener {
+ public:
+  // Receives the interleaved audio pulled on a tick. `audio` is only valid
+  // during the call.
+  using RenderCallback = std::function<void(rtc::ArrayView<const int16_t> audio,
+                                            int sample_rate_hz,
+                                            size_t num_channels)>;
+
+  // `metronome` and `tick_task_queue` must outlive the module.
+  MetronomeAudioDeviceModule(Metronome* metronome,
+                             TaskQueueBase* tick_task_queue,
+                             int sample_rate_hz,
+                             size_t num_channels,
+                             RenderCallback render_callback);
+  ~MetronomeAudioDeviceModule() override;
+
+  // AudioDeviceModule implementation.
+  int32_t RegisterAudioCallback(AudioTransport* audio_callback) override;
+  int32_t StartPlayout() override;
+  int32_t StopPlayout() override;
+  bool Playing() const override;
+  int32_t StereoPlayoutIsAvailable(bool* available) const override;
+  int32_t StereoPlayout(bool* enabled) const override;
+
+  // Metronome::TickListener implementation.
+  void OnTick() override;
+  TaskQueueBase* OnTickTaskQueue() override;
+
+ private:
+  Metronome* const metronome_;
+  TaskQueueBase* const tick_task_queue_;
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+  const RenderCallback render_callback_;
+
+  mutable Mutex lock_;
+  AudioTransport* audio_callback_ RTC_GUARDED_BY(lock_) = nullptr;
+  bool playing_ RTC_GUARDED_BY(lock_) = false;
+  // Playout time accumulated on ticks but not pulled yet, because it is less
+  // than 10 ms.
+  TimeDelta pending_playout_ RTC_GUARDED_BY(lock_) = TimeDelta::Zero();
+  rtc::BufferT<int16_t> playout_buffer_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_METRONOME_AUDIO_DEVICE_MODULE_H_
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/metronome_audio_device_module.h"
+
+#include <vector>
+
+#include "api/metronome/test/fake_metronome.h"
+#include "modules/audio_device/include/mock_audio_transport.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+using ::testing::SetArgReferee;
+
+constexpr int kSampleRate = 48000;
+constexpr size_t kNumChannels = 2;
+constexpr size_t kSamplesPer10ms = kSampleRate / 100;
+
+class MetronomeAudioDeviceModuleTest : public ::testing::Test {
+ protected:
+  explicit MetronomeAudioDeviceModuleTest(
+      TimeDelta tick_period = TimeDelta::Millis(20))
+      : metronome_(tick_period),
+        adm_(rtc::make_ref_counted<MetronomeAudioDeviceModule>(
+            &metronome_,
+            queue_.Get(),
+            kSampleRate,
+            kNumChannels,
+            [this](rtc::ArrayView<const int16_t> audio,
+                   int sample_rate_hz,
+                   size_t num_channels) {
+              EXPECT_EQ(sample_rate_hz, kSampleRate);
+              EXPECT_EQ(num_channels, kNumChannels);
+              rendered_sizes_.push_back(audio.size());
+            })) {
+    adm_->RegisterAudioCallback(&transport_);
+  }
+
+  void Tick() {
+    metronome_.Tick();
+    queue_.WaitForPreviouslyPostedTasks();
+  }
+
+  TaskQueueForTest queue_;
+  test::ForcedTickMetronome metronome_;
+  ::testing::NiceMock<test::MockAudioTransport> transport_;
+  rtc::scoped_refptr<MetronomeAudioDeviceModule> adm_;
+  std::vector<size_t> rendered_sizes_;
+};
+
+TEST_F(MetronomeAudioDeviceModuleTest, PullsWholeTickPeriodOnEachTick) {
+  EXPECT_CALL(transport_, NeedMorePlayData(2 * kSamplesPer10ms,
+                                           2 * kNumChannels, kNumChannels,
+                                           kSampleRate, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(
+          SetArgReferee<5>(2 * kSamplesPer10ms * kNumChannels), Return(0)));
+
+  adm_->StartPlayout();
+  EXPECT_TRUE(adm_->Playing());
+  Tick();
+  Tick();
+  EXPECT_EQ(rendered_sizes_, std::vector<size_t>(
+                                 2, 2 * kSamplesPer10ms * kNumChannels));
+
+  adm_->StopPlayout();
+  EXPECT_FALSE(adm_->Playing());
+  EXPECT_EQ(metronome_.NumListeners(), 0u);
+}
+
+class ShortTickMetronomeAudioDeviceModuleTest
+    : public MetronomeAudioDeviceModuleTest {
+ protected:
+  ShortTickMetronomeAudioDeviceModuleTest()
+      : MetronomeAudioDeviceModuleTest(TimeDelta::Millis(15)) {}
+};
+
+TEST_F(ShortTickMetronomeAudioDeviceModuleTest, CarriesOverPartialFrames) {
+  // 15 ms ticks pull 10 ms and 20 ms of audio in turns.
+  EXPECT_CALL(transport_,
+              NeedMorePlayData(kSamplesPer10ms, _, _, _, _, _, _, _))
+      .Times(2);
+  EXPECT_CALL(transport_,
+              NeedMorePlayData(2 * kSamplesPer10ms, _, _, _, _, _, _, _))
+      .Times(2);
+
+  adm_->StartPlayout();
+  for (int i = 0; i < 4; ++i)
+    Tick();
+  EXPECT_EQ(rendered_sizes_.size(), 4u);
+  adm_->StopPlayout();
+}
+
+TEST_F(MetronomeAudioDeviceModuleTest, DoesNotPullWhenNotPlaying) {
+  EXPECT_CALL(transport_, NeedMorePlayData).Times(0);
+  EXPECT_EQ(metronome_.NumListeners(), 0u);
+
+  adm_->StartPlayout();
+  adm_->StopPlayout();
+  Tick();
+  EXPECT_TRUE(rendered_sizes_.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
@@ -31,9 +32,14 @@ struct AudioMixerImpl::SourceStatus {
   Source* audio_source = nullptr;
   bool is_mixed = false;
   float gain = 0.0f;
+  // Whether the audio is skipped rather than pulled in this round.
+  bool skip_audio = false;
 
-  // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
+  // A frame that will be passed to audio_source->GetAudioFrameWithInfo, what
+  // that call returned and the energy of the frame, if not muted.
   AudioFrame audio_frame;
+  Source::AudioFrameInfo audio_frame_info = Source::AudioFrameInfo::kError;
+  uint32_t energy = 0;
 };
 
 namespace {
@@ -87,14 +93,10 @@ bool ShouldMixBefore(const SourceFrame& a, const SourceFrame& b) {
   return a.energy > b.energy;
 }
 
-void RampAndUpdateGain(
-    rtc::ArrayView<const SourceFrame> mixed_sources_and_frames) {
-  for (const auto& source_frame : mixed_sources_and_frames) {
-    float target_gain = source_frame.source_status->is_mixed ? 1.0f : 0.0f;
-    Ramp(source_frame.source_status->gain, target_gain,
-         source_frame.audio_frame);
-    source_frame.source_status->gain = target_gain;
-  }
+void RampAndUpdateGain(const SourceFrame& source_frame) {
+  float target_gain = source_frame.source_status->is_mixed ? 1.0f : 0.0f;
+  Ramp(source_frame.source_status->gain, target_gain, source_frame.audio_frame);
+  source_frame.source_status->gain = target_gain;
 }
 
 std::vector<std::unique_ptr<AudioMixerImpl::SourceStatus>>::const_iterator
@@ -116,23 +118,30 @@ struct AudioMixerImpl::HelperContainers {
     audio_source_mixing_data_list.resize(size);
     ramp_list.resize(size);
     preferred_rates.resize(size);
+    audio_levels.reserve(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
   std::vector<int> preferred_rates;
+  // Audio levels and indices of the sources that report a level.
+  std::vector<std::pair<int, size_t>> audio_levels;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix)
+    int max_sources_to_mix,
+    int num_worker_threads,
+    bool select_sources_by_audio_level)
     : max_sources_to_mix_(max_sources_to_mix),
+      select_sources_by_audio_level_(select_sources_by_audio_level),
       output_rate_calculator_(std::move(output_rate_calculator)),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
-      frame_combiner_(use_limiter) {
+      frame_combiner_(use_limiter),
+      worker_pool_(num_worker_threads, "AudioMixerWorker") {
   RTC_CHECK_GE(max_sources_to_mix, 1) << "At least one source must be mixed";
   audio_source_list_.reserve(max_sources_to_mix);
   helper_containers_->resize(max_sources_to_mix);
@@ -155,6 +164,17 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
       std::move(output_rate_calculator), use_limiter, max_sources_to_mix);
 }
 
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    int max_sources_to_mix,
+    int num_worker_threads,
+    bool select_sources_by_audio_level) {
+  return rtc::make_ref_counted<AudioMixerImpl>(
+      std::move(output_rate_calculator), use_limiter, max_sources_to_mix,
+      num_worker_threads, select_sources_by_audio_level);
+}
+
 void AudioMixerImpl::Mix(size_t number_of_channels,
                          AudioFrame* audio_frame_for_mixing) {
   RTC_DCHECK(number_of_channels >= 1);
@@ -172,7 +192,8 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
       rtc::ArrayView<const int>(helper_containers_->preferred_rates.data(),
                                 number_of_streams));
 
-  frame_combiner_.Combine(GetAudioFromSources(output_frequency),
+  frame_combiner_.Combine(GetAudioFromSources(output_frequency,
+                                              number_of_channels),
                           number_of_channels, output_frequency,
                           number_of_streams, audio_frame_for_mixing);
 }
@@ -197,13 +218,40 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
 }
 
 rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
-    int output_frequency) {
-  // Get audio from the audio sources and put it in the SourceFrame vector.
+    int output_frequency,
+    size_t number_of_channels) {
+  if (select_sources_by_audio_level_) {
+    SelectSourcesByAudioLevel();
+  }
+
+  // Get audio from the audio sources, straight into their frames. The
+  // sources are independent, so this is spread over the worker threads.
+  const auto& sources = audio_source_list_;
+  worker_pool_.ParallelFor(
+      sources.size(), [&sources, output_frequency](size_t i) {
+        SourceStatus& source_status = *sources[i];
+        if (source_status.skip_audio) {
+          source_status.audio_source->SkipAudioFrame(
+              output_frequency, &source_status.audio_frame);
+          source_status.audio_frame_info = Source::AudioFrameInfo::kMuted;
+          // The audio continues from a gap once it is pulled again.
+          source_status.gain = 0.0f;
+          return;
+        }
+        source_status.audio_frame_info =
+            source_status.audio_source->GetAudioFrameWithInfo(
+                output_frequency, &source_status.audio_frame);
+        if (source_status.audio_frame_info ==
+            Source::AudioFrameInfo::kNormal) {
+          source_status.energy =
+              AudioMixerCalculateEnergy(source_status.audio_frame);
+        }
+      });
+
+  // Put the audio in the SourceFrame vector.
   int audio_source_mixing_data_count = 0;
   for (auto& source_and_status : audio_source_list_) {
-    const auto audio_frame_info =
-        source_and_status->audio_source->GetAudioFrameWithInfo(
-            output_frequency, &source_and_status->audio_frame);
+    const auto audio_frame_info = source_and_status->audio_frame_info;
 
     if (audio_frame_info == Source::AudioFrameInfo::kError) {
       RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
@@ -212,7 +260,8 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     helper_containers_
         ->audio_source_mixing_data_list[audio_source_mixing_data_count++] =
         SourceFrame(source_and_status.get(), &source_and_status->audio_frame,
-                    audio_frame_info == Source::AudioFrameInfo::kMuted);
+                    audio_frame_info == Source::AudioFrameInfo::kMuted,
+                    source_and_status->energy);
   }
   rtc::ArrayView<SourceFrame> audio_source_mixing_data_view(
       helper_containers_->audio_source_mixing_data_list.data(),
@@ -244,12 +293,48 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     }
     p.source_status->is_mixed = is_mixed;
   }
-  RampAndUpdateGain(rtc::ArrayView<SourceFrame>(
-      helper_containers_->ramp_list.data(), ramp_list_lengh));
+
+  // Ramp the mixed frames and remix them to the output number of channels,
+  // which leaves only the summation to the frame combiner. This is done per
+  // frame, so it can be spread over the worker threads too.
+  const SourceFrame* ramp_list = helper_containers_->ramp_list.data();
+  worker_pool_.ParallelFor(
+      ramp_list_lengh, [ramp_list, number_of_channels](size_t i) {
+        RampAndUpdateGain(ramp_list[i]);
+        RemixFrame(number_of_channels, ramp_list[i].audio_frame);
+      });
   return rtc::ArrayView<AudioFrame* const>(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+void AudioMixerImpl::SelectSourcesByAudioLevel() {
+  auto& audio_levels = helper_containers_->audio_levels;
+  audio_levels.clear();
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    SourceStatus& source_status = *audio_source_list_[i];
+    source_status.skip_audio = false;
+    absl::optional<int> audio_level =
+        source_status.audio_source->LatestAudioLevel();
+    if (audio_level) {
+      audio_levels.emplace_back(*audio_level, i);
+    }
+  }
+
+  const size_t max_sources_to_mix = max_sources_to_mix_;
+  if (audio_levels.size() <= max_sources_to_mix) {
+    return;
+  }
+  // The level is in -dBov, so the loudest sources come first. Ties are broken
+  // by the order in which the sources were added.
+  std::nth_element(audio_levels.begin(),
+                   audio_levels.begin() + max_sources_to_mix,
+                   audio_levels.end());
+  for (auto it = audio_levels.begin() + max_sources_to_mix;
+       it != audio_levels.end(); ++it) {
+    audio_source_list_[it->second]->skip_audio = true;
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   MutexLock lock(&mutex_);
@@ -22,6 +22,7 @@
 #include "api/scoped_refptr.h"
 #include "modules/audio_mixer/frame_combiner.h"
 #include "modules/audio_mixer/output_rate_calculator.h"
+#include "rtc_base/worker_pool.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
@@ -45,6 +46,28 @@ class AudioMixerImpl : public AudioMixer {
       bool use_limiter,
       int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
 
+  // Pulls audio from the sources, and ramps and remixes the mixed frames, on
+  // `num_worker_threads` threads in addition to the mixing thread. Meant for
+  // mixers with many sources, such as conference servers, where getting the
+  // audio (i.e. running NetEq for each source) dominates the time spent in
+  // Mix(). Which sources are mixed, and the mix itself, do not depend on the
+  // number of threads. The sources must allow GetAudioFrameWithInfo() to be
+  // called on any thread.
+  //
+  // With `select_sources_by_audio_level`, the sources that report their
+  // LatestAudioLevel() are ranked by it before any audio is pulled, and only
+  // the `max_sources_to_mix` loudest of them are asked for their audio. The
+  // others are only advanced with SkipAudioFrame(), which for a receive stream
+  // means that no decoding is done. So for a conference, decoding costs scale
+  // with the number of active speakers rather than with the number of
+  // participants. Sources that do not report a level are always pulled.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      int max_sources_to_mix,
+      int num_worker_threads,
+      bool select_sources_by_audio_level = false);
+
   ~AudioMixerImpl() override;
 
   AudioMixerImpl(const AudioMixerImpl&) = delete;
@@ -66,16 +89,23 @@ class AudioMixerImpl : public AudioMixer {
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
                  bool use_limiter,
-                 int max_sources_to_mix);
+                 int max_sources_to_mix,
+                 int num_worker_threads = 0,
+                 bool select_sources_by_audio_level = false);
 
  private:
   struct HelperContainers;
 
   // Compute what audio sources to mix from audio_source_list_. Ramp
-  // in and out. Update mixed status. Mixes up to
-  // kMaximumAmountOfMixedAudioSources audio sources.
-  rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // in and out, and remix to `number_of_channels`. Update mixed status. Mixes
+  // up to kMaximumAmountOfMixedAudioSources audio sources.
+  rtc::ArrayView<AudioFrame* const> GetAudioFromSources(
+      int output_frequency,
+      size_t number_of_channels) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Marks all but the `max_sources_to_mix_` loudest sources that report an
+  // audio level to be skipped this round.
+  void SelectSourcesByAudioLevel() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
@@ -83,6 +113,7 @@ class AudioMixerImpl : public AudioMixer {
   mutable Mutex mutex_;
 
   const int max_sources_to_mix_;
+  const bool select_sources_by_audio_level_;
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
 
@@ -94,6 +125,9 @@ class AudioMixerImpl : public AudioMixer {
 
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_;
+
+  // Threads that help pulling audio from the sources.
+  WorkerPool worker_pool_ RTC_GUARDED_BY(mutex_);
 };
 }  // namespace webrtc
 
@@ -87,6 +87,11 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
 
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
   MOCK_METHOD(int, Ssrc, (), (const, override));
+  MOCK_METHOD(absl::optional<int>, LatestAudioLevel, (), (const, override));
+  MOCK_METHOD(void,
+              SkipAudioFrame,
+              (int sample_rate_hz, AudioFrame* audio_frame),
+              (override));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -510,6 +515,133 @@ TEST(AudioMixer, ShouldMixUpToSpecifiedNumberOfSourcesToMix) {
   }
 }
 
+TEST(AudioMixer, ShouldPullAudioFromAllSourcesWithWorkerThreads) {
+  constexpr int kAudioSources = 20;
+  constexpr int kSourcesToMix = 2;
+  constexpr int kActiveSources[] = {7, 13};
+
+  std::vector<MockMixerAudioSource> participants(kAudioSources);
+  for (auto& participant : participants) {
+    ResetFrame(participant.fake_frame());
+    participant.fake_frame()->vad_activity_ = AudioFrame::kVadPassive;
+  }
+  for (int i : kActiveSources) {
+    participants[i].fake_frame()->vad_activity_ = AudioFrame::kVadActive;
+  }
+
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kSourcesToMix, /*num_worker_threads=*/3);
+  for (auto& participant : participants) {
+    EXPECT_TRUE(mixer->AddSource(&participant));
+    EXPECT_CALL(participant, GetAudioFrameWithInfo(kDefaultSampleRateHz, _))
+        .Times(Exactly(1));
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    bool expected_status = i == kActiveSources[0] || i == kActiveSources[1];
+    EXPECT_EQ(expected_status,
+              mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+        << "Wrong mix status for source #" << i;
+  }
+}
+
+TEST(AudioMixer, MixIsIndependentOfNumberOfWorkerThreads) {
+  constexpr int kAudioSources = 30;
+  constexpr int kSourcesToMix = 5;
+  constexpr size_t kNumberOfChannels = 2;
+
+  const auto serial_mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kSourcesToMix, /*num_worker_threads=*/0);
+  const auto parallel_mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kSourcesToMix, /*num_worker_threads=*/3);
+  std::vector<MockMixerAudioSource> serial_sources(kAudioSources);
+  std::vector<MockMixerAudioSource> parallel_sources(kAudioSources);
+  for (int i = 0; i < kAudioSources; ++i) {
+    serial_mixer->AddSource(&serial_sources[i]);
+    parallel_mixer->AddSource(&parallel_sources[i]);
+  }
+
+  AudioFrame serial_mix;
+  AudioFrame parallel_mix;
+  for (int round = 0; round < 5; ++round) {
+    // Change the loudest sources every round, so that sources are ramped in
+    // and out, and mix mono and stereo sources.
+    for (int i = 0; i < kAudioSources; ++i) {
+      for (auto* sources : {&serial_sources, &parallel_sources}) {
+        AudioFrame* frame = (*sources)[i].fake_frame();
+        ResetFrame(frame);
+        frame->num_channels_ = 1 + i % 2;
+        const size_t num_samples =
+            frame->samples_per_channel_ * frame->num_channels_;
+        const int level = (i * 7 + round * 11) % kAudioSources;
+        int16_t* data = frame->mutable_data();
+        for (size_t j = 0; j < num_samples; ++j) {
+          data[j] = static_cast<int16_t>(level * (j % 50));
+        }
+      }
+    }
+
+    serial_mixer->Mix(kNumberOfChannels, &serial_mix);
+    parallel_mixer->Mix(kNumberOfChannels, &parallel_mix);
+
+    ASSERT_EQ(serial_mix.num_channels_, parallel_mix.num_channels_);
+    ASSERT_EQ(serial_mix.samples_per_channel_,
+              parallel_mix.samples_per_channel_);
+    for (size_t j = 0;
+         j < serial_mix.samples_per_channel_ * serial_mix.num_channels_; ++j) {
+      ASSERT_EQ(serial_mix.data()[j], parallel_mix.data()[j])
+          << "Round " << round << ", sample " << j;
+    }
+    for (int i = 0; i < kAudioSources; ++i) {
+      EXPECT_EQ(serial_mixer->GetAudioSourceMixabilityStatusForTest(
+                    &serial_sources[i]),
+                parallel_mixer->GetAudioSourceMixabilityStatusForTest(
+                    &parallel_sources[i]));
+    }
+  }
+}
+
+TEST(AudioMixer, ShouldOnlyPullLoudestSourcesWhenSelectingByAudioLevel) {
+  constexpr int kSourcesToMix = 2;
+  // Levels in -dBov; the sources without a level are always pulled.
+  const absl::optional<int> kAudioLevels[] = {50, 10, absl::nullopt, 127,
+                                              30, 10, absl::nullopt, 90};
+  constexpr bool kExpectPulled[] = {false, true, true, false,
+                                    false, true, true, false};
+  constexpr int kAudioSources = sizeof(kExpectPulled) / sizeof(bool);
+
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kSourcesToMix, /*num_worker_threads=*/0,
+      /*select_sources_by_audio_level=*/true);
+  std::vector<MockMixerAudioSource> participants(kAudioSources);
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+    EXPECT_CALL(participants[i], LatestAudioLevel())
+        .WillRepeatedly(Return(kAudioLevels[i]));
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _))
+        .Times(kExpectPulled[i] ? 1 : 0);
+    EXPECT_CALL(participants[i], SkipAudioFrame(kDefaultSampleRateHz, _))
+        .Times(kExpectPulled[i] ? 0 : 1);
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    if (!kExpectPulled[i]) {
+      EXPECT_FALSE(
+          mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+          << "Skipped source #" << i << " was mixed";
+    }
+  }
+}
+
 TEST(AudioMixer, UnmutedShouldMixBeforeLoud) {
   constexpr int kAudioSources =
       AudioMixerImpl::kDefaultNumberOfMixedAudioSources + 1;
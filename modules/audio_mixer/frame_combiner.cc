@@ -23,6 +23,7 @@
 #include "api/rtp_packet_info.h"
 #include "api/rtp_packet_infos.h"
 #include "common_audio/include/audio_util.h"
+#include "common_audio/mixing_kernels.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
@@ -103,17 +104,17 @@ void MixToFloatFrame(rtc::ArrayView<const AudioFrame* const> mix_list,
   }
 
   // Convert to FloatS16 and mix.
+  const MixingKernels& kernels = GetMixingKernels();
   for (size_t i = 0; i < mix_list.size(); ++i) {
     const AudioFrame* const frame = mix_list[i];
     const int16_t* const frame_data = frame->data();
     for (size_t j = 0; j < std::min(number_of_channels,
                                     FrameCombiner::kMaximumNumberOfChannels);
          ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame_data[number_of_channels * k + j];
-      }
+      kernels.accumulate_s16_to_float(
+          frame_data + j, number_of_channels,
+          std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize),
+          (*mixing_buffer)[j].data());
     }
   }
 }
@@ -133,11 +134,11 @@ void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
   int16_t* const mixing_data = audio_frame_for_mixing->mutable_data();
   // Put data in the result frame.
+  const MixingKernels& kernels = GetMixingKernels();
   for (size_t i = 0; i < number_of_channels; ++i) {
-    for (size_t j = 0; j < samples_per_channel; ++j) {
-      mixing_data[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
-    }
+    kernels.float_s16_to_s16(mixing_buffer_view.channel(i).data(),
+                             samples_per_channel, number_of_channels,
+                             mixing_data + i);
   }
 }
 }  // namespace
@@ -14,6 +14,9 @@
 // Defines WEBRTC_ARCH_X86_FAMILY, used below.
 #include "rtc_base/system/arch.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #include <emmintrin.h>
 #endif
@@ -66,6 +69,21 @@ struct FftData {
       case Aec3Optimization::kAvx2:
         SpectrumAVX2(power_spectrum);
         break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        // Multiplies and adds separately, as the reference does, to be
+        // bitexact.
+        for (size_t k = 0; k < kFftLengthBy2; k += 4) {
+          const float32x4_t r = vld1q_f32(&re[k]);
+          const float32x4_t i = vld1q_f32(&im[k]);
+          const float32x4_t ii = vmulq_f32(i, i);
+          const float32x4_t rr = vmulq_f32(r, r);
+          vst1q_f32(&power_spectrum[k], vaddq_f32(rr, ii));
+        }
+        power_spectrum[kFftLengthBy2] = re[kFftLengthBy2] * re[kFftLengthBy2] +
+                                        im[kFftLengthBy2] * im[kFftLengthBy2];
+      } break;
 #endif
       default:
         std::transform(re.begin(), re.end(), im.begin(), power_spectrum.begin(),
@@ -30,6 +30,15 @@ bool UseCoarseFilterResetHangover() {
       "WebRTC-Aec3CoarseFilterResetHangoverKillSwitch");
 }
 
+// Threads beyond one per capture channel, besides the calling thread, would
+// have no channel to process.
+int NumWorkerThreads(const EchoCanceller3Config& config,
+                     size_t num_capture_channels) {
+  return std::max(std::min(config.filter.num_worker_threads,
+                           static_cast<int>(num_capture_channels) - 1),
+                  0);
+}
+
 void PredictionError(const Aec3Fft& fft,
                      const FftData& S,
                      rtc::ArrayView<const float> y,
@@ -92,7 +101,9 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                                  config_.filter.refined_initial.length_blocks,
                                  config_.filter.refined.length_blocks)),
                              0.f)),
-      coarse_impulse_responses_(0) {
+      coarse_impulse_responses_(0),
+      worker_pool_(NumWorkerThreads(config, num_capture_channels),
+                   "Aec3Worker") {
   // Set up the storing of coarse impulse responses if data dumping is
   // available.
   if (ApmDataDumper::IsAvailable()) {
@@ -202,126 +213,141 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_coarse);
   }
 
-  // Process all capture channels
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
-    SubtractorOutput& output = outputs[ch];
-    rtc::ArrayView<const float> y = capture[ch];
-    FftData& E_refined = output.E_refined;
-    FftData E_coarse;
-    std::array<float, kBlockSize>& e_refined = output.e_refined;
-    std::array<float, kBlockSize>& e_coarse = output.e_coarse;
-
-    FftData S;
-    FftData& G = S;
-
-    // Form the outputs of the refined and coarse filters.
-    refined_filters_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_refined, &output.s_refined);
-
-    coarse_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
-
-    // Compute the signal powers in the subtractor output.
-    output.ComputeMetrics(y);
-
-    // Adjust the filter if needed.
-    bool refined_filters_adjusted = false;
-    filter_misadjustment_estimators_[ch].Update(output);
-    if (filter_misadjustment_estimators_[ch].IsAdjustmentNeeded()) {
-      float scale = filter_misadjustment_estimators_[ch].GetMisadjustment();
-      refined_filters_[ch]->ScaleFilter(scale);
-      for (auto& h_k : refined_impulse_responses_[ch]) {
-        h_k *= scale;
-      }
-      ScaleFilterOutput(y, scale, e_refined, output.s_refined);
-      filter_misadjustment_estimators_[ch].Reset();
-      refined_filters_adjusted = true;
-    }
+  // Process all capture channels. Besides the render powers, the channels only
+  // share the render buffer and the analyses of the render and capture signals,
+  // which are all read-only here, so the channels can be processed in parallel.
+  worker_pool_.ParallelFor(num_capture_channels_, [&](size_t ch) {
+    ProcessChannel(ch, render_buffer, capture, render_signal_analyzer, aec_state,
+                   X2_refined, X2_coarse, outputs);
+  });
+}
 
-    // Compute the FFts of the refined and coarse filter outputs.
-    fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
-    fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
-
-    // Compute spectra for future use.
-    E_coarse.Spectrum(optimization_, output.E2_coarse);
-    E_refined.Spectrum(optimization_, output.E2_refined);
-
-    // Update the refined filter.
-    if (!refined_filters_adjusted) {
-      // Do not allow the performance of the coarse filter to affect the
-      // adaptation speed of the refined filter just after the coarse filter has
-      // been reset.
-      const bool disallow_leakage_diverged =
-          coarse_filter_reset_hangover_[ch] > 0 &&
-          use_coarse_filter_reset_hangover_;
-
-      std::array<float, kFftLengthBy2Plus1> erl;
-      ComputeErl(optimization_, refined_frequency_responses_[ch], erl);
-      refined_gains_[ch]->Compute(X2_refined, render_signal_analyzer, output,
-                                  erl, refined_filters_[ch]->SizePartitions(),
-                                  aec_state.SaturatedCapture(),
-                                  disallow_leakage_diverged, &G);
-    } else {
-      G.re.fill(0.f);
-      G.im.fill(0.f);
-    }
-    refined_filters_[ch]->Adapt(render_buffer, G,
-                                &refined_impulse_responses_[ch]);
-    refined_filters_[ch]->ComputeFrequencyResponse(
-        &refined_frequency_responses_[ch]);
-
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
+void Subtractor::ProcessChannel(
+    size_t ch,
+    const RenderBuffer& render_buffer,
+    const std::vector<std::vector<float>>& capture,
+    const RenderSignalAnalyzer& render_signal_analyzer,
+    const AecState& aec_state,
+    const std::array<float, kFftLengthBy2Plus1>& X2_refined,
+    const std::array<float, kFftLengthBy2Plus1>& X2_coarse,
+    rtc::ArrayView<SubtractorOutput> outputs) {
+  RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
+  SubtractorOutput& output = outputs[ch];
+  rtc::ArrayView<const float> y = capture[ch];
+  FftData& E_refined = output.E_refined;
+  FftData E_coarse;
+  std::array<float, kBlockSize>& e_refined = output.e_refined;
+  std::array<float, kBlockSize>& e_coarse = output.e_coarse;
+
+  FftData S;
+  FftData& G = S;
+
+  // Form the outputs of the refined and coarse filters.
+  refined_filters_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft_, S, y, &e_refined, &output.s_refined);
+
+  coarse_filter_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+
+  // Compute the signal powers in the subtractor output.
+  output.ComputeMetrics(y);
+
+  // Adjust the filter if needed.
+  bool refined_filters_adjusted = false;
+  filter_misadjustment_estimators_[ch].Update(output);
+  if (filter_misadjustment_estimators_[ch].IsAdjustmentNeeded()) {
+    float scale = filter_misadjustment_estimators_[ch].GetMisadjustment();
+    refined_filters_[ch]->ScaleFilter(scale);
+    for (auto& h_k : refined_impulse_responses_[ch]) {
+      h_k *= scale;
     }
+    ScaleFilterOutput(y, scale, e_refined, output.s_refined);
+    filter_misadjustment_estimators_[ch].Reset();
+    refined_filters_adjusted = true;
+  }
 
-    // Update the coarse filter.
-    poor_coarse_filter_counters_[ch] =
-        output.e2_refined < output.e2_coarse
-            ? poor_coarse_filter_counters_[ch] + 1
-            : 0;
-    if (poor_coarse_filter_counters_[ch] < 5) {
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
-      coarse_filter_reset_hangover_[ch] =
-          std::max(coarse_filter_reset_hangover_[ch] - 1, 0);
-    } else {
-      poor_coarse_filter_counters_[ch] = 0;
-      coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
-                                    refined_filters_[ch]->GetFilter());
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_refined,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
-      coarse_filter_reset_hangover_[ch] =
-          config_.filter.coarse_reset_hangover_blocks;
-    }
+  // Compute the FFts of the refined and coarse filter outputs.
+  fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
+  fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
+
+  // Compute spectra for future use.
+  E_coarse.Spectrum(optimization_, output.E2_coarse);
+  E_refined.Spectrum(optimization_, output.E2_refined);
+
+  // Update the refined filter.
+  if (!refined_filters_adjusted) {
+    // Do not allow the performance of the coarse filter to affect the
+    // adaptation speed of the refined filter just after the coarse filter has
+    // been reset.
+    const bool disallow_leakage_diverged =
+        coarse_filter_reset_hangover_[ch] > 0 &&
+        use_coarse_filter_reset_hangover_;
+
+    std::array<float, kFftLengthBy2Plus1> erl;
+    ComputeErl(optimization_, refined_frequency_responses_[ch], erl);
+    refined_gains_[ch]->Compute(X2_refined, render_signal_analyzer, output,
+                                erl, refined_filters_[ch]->SizePartitions(),
+                                aec_state.SaturatedCapture(),
+                                disallow_leakage_diverged, &G);
+  } else {
+    G.re.fill(0.f);
+    G.im.fill(0.f);
+  }
+  refined_filters_[ch]->Adapt(render_buffer, G,
+                              &refined_impulse_responses_[ch]);
+  refined_filters_[ch]->ComputeFrequencyResponse(
+      &refined_frequency_responses_[ch]);
+
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
+  }
 
-    if (ApmDataDumper::IsAvailable()) {
-      RTC_DCHECK_LT(ch, coarse_impulse_responses_.size());
-      coarse_filter_[ch]->Adapt(render_buffer, G,
-                                &coarse_impulse_responses_[ch]);
-    } else {
-      coarse_filter_[ch]->Adapt(render_buffer, G);
-    }
+  // Update the coarse filter.
+  poor_coarse_filter_counters_[ch] =
+      output.e2_refined < output.e2_coarse
+          ? poor_coarse_filter_counters_[ch] + 1
+          : 0;
+  if (poor_coarse_filter_counters_[ch] < 5) {
+    coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
+                               coarse_filter_[ch]->SizePartitions(),
+                               aec_state.SaturatedCapture(), &G);
+    coarse_filter_reset_hangover_[ch] =
+        std::max(coarse_filter_reset_hangover_[ch] - 1, 0);
+  } else {
+    poor_coarse_filter_counters_[ch] = 0;
+    coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
+                                  refined_filters_[ch]->GetFilter());
+    coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_refined,
+                               coarse_filter_[ch]->SizePartitions(),
+                               aec_state.SaturatedCapture(), &G);
+    coarse_filter_reset_hangover_[ch] =
+        config_.filter.coarse_reset_hangover_blocks;
+  }
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
-      filter_misadjustment_estimators_[ch].Dump(data_dumper_);
-      DumpFilters();
-    }
+  if (ApmDataDumper::IsAvailable()) {
+    RTC_DCHECK_LT(ch, coarse_impulse_responses_.size());
+    coarse_filter_[ch]->Adapt(render_buffer, G,
+                              &coarse_impulse_responses_[ch]);
+  } else {
+    coarse_filter_[ch]->Adapt(render_buffer, G);
+  }
 
-    std::for_each(e_refined.begin(), e_refined.end(),
-                  [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
+    filter_misadjustment_estimators_[ch].Dump(data_dumper_);
+    DumpFilters();
+  }
 
-    if (ch == 0) {
-      data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
-                            &e_refined[0], 16000, 1);
-      data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
-                            &e_coarse[0], 16000, 1);
-    }
+  std::for_each(e_refined.begin(), e_refined.end(),
+                [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+
+  if (ch == 0) {
+    data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
+                          &e_refined[0], 16000, 1);
+    data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
+                          &e_coarse[0], 16000, 1);
   }
 }
 
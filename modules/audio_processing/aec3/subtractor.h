@@ -31,6 +31,7 @@
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/worker_pool.h"
 
 namespace webrtc {
 
@@ -124,6 +125,17 @@ class Subtractor {
     int overhang_ = 0.f;
   };
 
+  // Subtracts the echo from, and adapts the filters of, capture channel `ch`.
+  // Does not touch the state of the other channels.
+  void ProcessChannel(size_t ch,
+                      const RenderBuffer& render_buffer,
+                      const std::vector<std::vector<float>>& capture,
+                      const RenderSignalAnalyzer& render_signal_analyzer,
+                      const AecState& aec_state,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_refined,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_coarse,
+                      rtc::ArrayView<SubtractorOutput> outputs);
+
   const Aec3Fft fft_;
   ApmDataDumper* data_dumper_;
   const Aec3Optimization optimization_;
@@ -142,6 +154,8 @@ class Subtractor {
       refined_frequency_responses_;
   std::vector<std::vector<float>> refined_impulse_responses_;
   std::vector<std::vector<float>> coarse_impulse_responses_;
+  // Processes the capture channels in parallel if there are worker threads.
+  WorkerPool worker_pool_;
 };
 
 }  // namespace webrtc
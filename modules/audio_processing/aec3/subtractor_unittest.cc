@@ -34,13 +34,15 @@ std::vector<float> RunSubtractorTest(
     int refined_filter_length_blocks,
     int coarse_filter_length_blocks,
     bool uncorrelated_inputs,
-    const std::vector<int>& blocks_with_echo_path_changes) {
+    const std::vector<int>& blocks_with_echo_path_changes,
+    int num_worker_threads = 0) {
   ApmDataDumper data_dumper(42);
   constexpr int kSampleRateHz = 48000;
   constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
   EchoCanceller3Config config;
   config.filter.refined.length_blocks = refined_filter_length_blocks;
   config.filter.coarse.length_blocks = coarse_filter_length_blocks;
+  config.filter.num_worker_threads = num_worker_threads;
 
   Subtractor subtractor(config, num_render_channels, num_capture_channels,
                         &data_dumper, DetectOptimization());
@@ -270,6 +272,21 @@ TEST(Subtractor, NonConvergenceOnUncorrelatedSignals) {
   }
 }
 
+// Verifies that processing the capture channels in parallel gives the same
+// output as processing them one at a time.
+TEST(Subtractor, SameOutputWithWorkerThreads) {
+  std::vector<int> blocks_with_echo_path_changes = {300};
+  const std::vector<float> echo_to_nearend_powers = RunSubtractorTest(
+      2, 4, 600, 64, 20, 15, false, blocks_with_echo_path_changes);
+  for (int num_worker_threads : {1, 3}) {
+    SCOPED_TRACE(num_worker_threads);
+    EXPECT_EQ(echo_to_nearend_powers,
+              RunSubtractorTest(2, 4, 600, 64, 20, 15, false,
+                                blocks_with_echo_path_changes,
+                                num_worker_threads));
+  }
+}
+
 class SubtractorMultiChannelUpToEightRender
     : public ::testing::Test,
       public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
@@ -10,7 +10,10 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+#include <map>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "third_party/rnnoise/src/rnn_vad_weights.h"
 
 namespace webrtc {
@@ -37,29 +40,61 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 
 }  // namespace
 
-RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
-    : input_(kInputLayerInputSize,
-             kInputLayerOutputSize,
-             kInputDenseBias,
-             kInputDenseWeights,
-             ActivationFunction::kTansigApproximated,
-             cpu_features,
-             /*layer_name=*/"FC1"),
-      hidden_(kInputLayerOutputSize,
-              kHiddenLayerOutputSize,
-              kHiddenGruBias,
-              kHiddenGruWeights,
-              kHiddenGruRecurrentWeights,
+struct RnnVad::Layers {
+  explicit Layers(const AvailableCpuFeatures& cpu_features)
+      : input(kInputLayerInputSize,
+              kInputLayerOutputSize,
+              kInputDenseBias,
+              kInputDenseWeights,
+              ActivationFunction::kTansigApproximated,
               cpu_features,
-              /*layer_name=*/"GRU1"),
-      output_(kHiddenLayerOutputSize,
-              kOutputLayerOutputSize,
-              kOutputDenseBias,
-              kOutputDenseWeights,
-              ActivationFunction::kSigmoidApproximated,
-              // The output layer is just 24x1. The unoptimized code is faster.
-              NoAvailableCpuFeatures(),
-              /*layer_name=*/"FC2") {
+              /*layer_name=*/"FC1"),
+        hidden(kInputLayerOutputSize,
+               kHiddenLayerOutputSize,
+               kHiddenGruBias,
+               kHiddenGruWeights,
+               kHiddenGruRecurrentWeights,
+               cpu_features,
+               /*layer_name=*/"GRU1"),
+        output(kHiddenLayerOutputSize,
+               kOutputLayerOutputSize,
+               kOutputDenseBias,
+               kOutputDenseWeights,
+               ActivationFunction::kSigmoidApproximated,
+               // The output layer is just 24x1. The unoptimized code is faster.
+               NoAvailableCpuFeatures(),
+               /*layer_name=*/"FC2") {}
+
+  // Returns the layers for `cpu_features`, created if no other instance using
+  // them is alive.
+  static std::shared_ptr<const Layers> GetShared(
+      const AvailableCpuFeatures& cpu_features) {
+    static Mutex& mutex = *new Mutex();
+    static auto& shared_layers =
+        *new std::map<int, std::weak_ptr<const Layers>>();
+    const int key = (cpu_features.sse2 ? 1 : 0) |
+                    (cpu_features.avx2 ? 2 : 0) | (cpu_features.neon ? 4 : 0);
+    MutexLock lock(&mutex);
+    std::shared_ptr<const Layers> layers = shared_layers[key].lock();
+    if (!layers) {
+      layers = std::make_shared<const Layers>(cpu_features);
+      shared_layers[key] = layers;
+    }
+    return layers;
+  }
+
+  const FullyConnectedLayer input;
+  const GatedRecurrentLayer hidden;
+  const FullyConnectedLayer output;
+};
+
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features, int num_streams)
+    : layers_(Layers::GetShared(cpu_features)),
+      input_(layers_->input),
+      hidden_(layers_->hidden),
+      output_(layers_->output),
+      hidden_states_(num_streams) {
+  RTC_DCHECK_GT(num_streams, 0);
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_.size(), hidden_.input_size())
       << "The input and the hidden layers sizes do not match.";
@@ -70,21 +105,57 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
 RnnVad::~RnnVad() = default;
 
 void RnnVad::Reset() {
-  hidden_.Reset();
+  for (int stream = 0; stream < num_streams(); ++stream) {
+    Reset(stream);
+  }
+}
+
+void RnnVad::Reset(int stream) {
+  RTC_DCHECK_GE(stream, 0);
+  RTC_DCHECK_LT(stream, num_streams());
+  hidden_states_[stream].fill(0.f);
+}
+
+float RnnVad::ComputeVadProbability(
+    rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
+    bool is_silence) {
+  return ComputeVadProbability(/*stream=*/0, feature_vector, is_silence);
+}
+
+void RnnVad::ComputeVadProbabilities(
+    rtc::ArrayView<const std::array<float, kFeatureVectorSize>>
+        feature_vectors,
+    rtc::ArrayView<const bool> is_silence,
+    rtc::ArrayView<float> vad_probabilities) {
+  RTC_DCHECK_EQ(feature_vectors.size(), num_streams());
+  RTC_DCHECK_EQ(is_silence.size(), num_streams());
+  RTC_DCHECK_EQ(vad_probabilities.size(), num_streams());
+  // The streams are evaluated one after the other so that the weights of each
+  // layer stay in cache.
+  for (int stream = 0; stream < num_streams(); ++stream) {
+    vad_probabilities[stream] = ComputeVadProbability(
+        stream, feature_vectors[stream], is_silence[stream]);
+  }
 }
 
 float RnnVad::ComputeVadProbability(
+    int stream,
     rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
     bool is_silence) {
   if (is_silence) {
-    Reset();
+    Reset(stream);
     return 0.f;
   }
-  input_.ComputeOutput(feature_vector);
-  hidden_.ComputeOutput(input_);
-  output_.ComputeOutput(hidden_);
+  std::array<float, kFullyConnectedLayerMaxUnits> input_output;
+  input_.ComputeOutput(feature_vector, input_output);
+  rtc::ArrayView<float> hidden_state(hidden_states_[stream].data(),
+                                     hidden_.size());
+  hidden_.ComputeOutput(
+      {input_output.data(), static_cast<size_t>(input_.size())}, hidden_state);
+  std::array<float, kFullyConnectedLayerMaxUnits> output;
+  output_.ComputeOutput(hidden_state, output);
   RTC_DCHECK_EQ(output_.size(), 1);
-  return output_.data()[0];
+  return output[0];
 }
 
 }  // namespace rnn_vad
@@ -15,6 +15,7 @@
 #include <sys/types.h>
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
@@ -27,24 +28,48 @@ namespace webrtc {
 namespace rnn_vad {
 
 // Recurrent network with hard-coded architecture and weights for voice activity
-// detection.
+// detection. Can evaluate `num_streams` independent streams, each with its own
+// recurrent state, which share the layers and their weights. The layers are
+// also shared with the other instances using the same CPU features.
 class RnnVad {
  public:
-  explicit RnnVad(const AvailableCpuFeatures& cpu_features);
+  explicit RnnVad(const AvailableCpuFeatures& cpu_features,
+                  int num_streams = 1);
   RnnVad(const RnnVad&) = delete;
   RnnVad& operator=(const RnnVad&) = delete;
   ~RnnVad();
+  int num_streams() const { return static_cast<int>(hidden_states_.size()); }
+  // Resets the state of all the streams.
   void Reset();
+  // Resets the state of `stream`.
+  void Reset(int stream);
   // Observes `feature_vector` and `is_silence`, updates the RNN and returns the
-  // current voice probability.
+  // current voice probability of the first stream.
   float ComputeVadProbability(
       rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
       bool is_silence);
+  // Observes the feature vectors and the silence flags of all the streams,
+  // updates the RNN and writes the current voice probability of each stream
+  // into `vad_probabilities`. All the views must have `num_streams()` elements.
+  void ComputeVadProbabilities(
+      rtc::ArrayView<const std::array<float, kFeatureVectorSize>>
+          feature_vectors,
+      rtc::ArrayView<const bool> is_silence,
+      rtc::ArrayView<float> vad_probabilities);
 
  private:
-  FullyConnectedLayer input_;
-  GatedRecurrentLayer hidden_;
-  FullyConnectedLayer output_;
+  float ComputeVadProbability(
+      int stream,
+      rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
+      bool is_silence);
+
+  struct Layers;
+
+  const std::shared_ptr<const Layers> layers_;
+  const FullyConnectedLayer& input_;
+  const GatedRecurrentLayer& hidden_;
+  const FullyConnectedLayer& output_;
+  std::vector<std::array<float, kGruLayerMaxUnits>> hidden_states_;
 };
 
 }  // namespace rnn_vad
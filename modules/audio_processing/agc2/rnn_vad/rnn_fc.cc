@@ -90,10 +90,16 @@ FullyConnectedLayer::FullyConnectedLayer(
 FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
+  ComputeOutput(input, output_);
+}
+
+void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input,
+                                        rtc::ArrayView<float> output) const {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  RTC_DCHECK_GE(output.size(), output_size_);
   rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
-    output_[o] = activation_function_(
+    output[o] = activation_function_(
         bias_[o] + vector_math_.DotProduct(
                        input, weights.subview(o * input_size_, input_size_)));
   }
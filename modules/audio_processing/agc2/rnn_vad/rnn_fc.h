@@ -54,6 +54,10 @@ class FullyConnectedLayer {
 
   // Computes the fully-connected layer output.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Computes the fully-connected layer output into `output`, whose size must
+  // be equal to or greater than `size()`. Does not change the output buffer.
+  void ComputeOutput(rtc::ArrayView<const float> input,
+                     rtc::ArrayView<float> output) const;
 
  private:
   const int input_size_;
@@ -158,7 +158,13 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
+  ComputeOutput(input, {state_.data(), static_cast<size_t>(output_size_)});
+}
+
+void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input,
+                                        rtc::ArrayView<float> state) const {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  RTC_DCHECK_EQ(state.size(), output_size_);
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
@@ -169,8 +175,6 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   const int stride_weights = input_size_ * output_size_;
   const int stride_recurrent_weights = output_size_ * output_size_;
 
-  rtc::ArrayView<float> state(state_.data(), output_size_);
-
   // Update gate.
   std::array<float, kGruLayerMaxUnits> update;
   ComputeUpdateResetGate(
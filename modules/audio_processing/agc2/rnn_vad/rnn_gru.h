@@ -52,6 +52,10 @@ class GatedRecurrentLayer {
   void Reset();
   // Computes the recurrent layer output and updates the status.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Computes the recurrent layer output for an externally owned `state` of size
+  // `size()` and updates it. Allows to share the layer among several streams.
+  void ComputeOutput(rtc::ArrayView<const float> input,
+                     rtc::ArrayView<float> state) const;
 
  private:
   const int input_size_;
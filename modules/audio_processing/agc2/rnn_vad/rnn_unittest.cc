@@ -10,6 +10,9 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+#include <array>
+#include <memory>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
@@ -65,6 +68,36 @@ TEST(RnnVadTest, CheckRnnVadSilence) {
   EXPECT_EQ(pre, post);
 }
 
+// Checks that evaluating several streams in one call gives the same output as
+// evaluating each stream with its own RNN.
+TEST(RnnVadTest, CheckMultipleStreamsMatchSingleStreams) {
+  constexpr int kNumStreams = 3;
+  RnnVad rnn_vad(GetAvailableCpuFeatures(), kNumStreams);
+  ASSERT_EQ(rnn_vad.num_streams(), kNumStreams);
+  std::array<std::unique_ptr<RnnVad>, kNumStreams> single_stream_rnn_vads;
+  for (auto& single_stream_rnn_vad : single_stream_rnn_vads) {
+    single_stream_rnn_vad = std::make_unique<RnnVad>(GetAvailableCpuFeatures());
+  }
+  std::array<std::array<float, kFeatureVectorSize>, kNumStreams> features;
+  for (int frame = 0; frame < 20; ++frame) {
+    std::array<bool, kNumStreams> is_silence;
+    for (int stream = 0; stream < kNumStreams; ++stream) {
+      for (int i = 0; i < kFeatureVectorSize; ++i) {
+        features[stream][i] =
+            kFeatures[(i + frame * stream) % kFeatureVectorSize];
+      }
+      is_silence[stream] = frame % 7 == stream;
+    }
+    std::array<float, kNumStreams> probabilities;
+    rnn_vad.ComputeVadProbabilities(features, is_silence, probabilities);
+    for (int stream = 0; stream < kNumStreams; ++stream) {
+      EXPECT_EQ(probabilities[stream],
+                single_stream_rnn_vads[stream]->ComputeVadProbability(
+                    features[stream], is_silence[stream]));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -73,7 +73,7 @@ class VectorMath {
       }
       return dot_product;
     }
-#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#elif defined(WEBRTC_HAS_NEON)
     if (cpu_features_.neon) {
       float32x4_t accumulator = vdupq_n_f32(0.f);
       constexpr int kBlockSizeLog2 = 2;
@@ -84,7 +84,12 @@ class VectorMath {
         RTC_DCHECK_LE(i + kBlockSize, x.size());
         const float32x4_t x_i = vld1q_f32(&x[i]);
         const float32x4_t y_i = vld1q_f32(&y[i]);
+#if defined(WEBRTC_ARCH_ARM64)
         accumulator = vfmaq_f32(accumulator, x_i, y_i);
+#else
+        // Fused multiply-add needs VFPv4, which 32-bit NEON builds may lack.
+        accumulator = vmlaq_f32(accumulator, x_i, y_i);
+#endif
       }
       // Reduce `accumulator` by addition.
       const float32x2_t tmp =
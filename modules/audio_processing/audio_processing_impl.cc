@@ -1415,6 +1415,7 @@ int AudioProcessingImpl::AnalyzeReverseStreamLocked(
   }
   render_.render_audio->CopyFrom(src,
                                  formats_.api_format.reverse_input_stream());
+  HandleRenderRuntimeSettings();
   return ProcessRenderStreamLocked();
 }
 
@@ -1423,12 +1424,34 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
                                               const StreamConfig& output_config,
                                               int16_t* const dest) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessReverseStream_AudioFrame");
+  MutexLock lock(&mutex_render_);
+  return ProcessReverseStreamFramesLocked(src, /*num_frames=*/1, input_config,
+                                          output_config, dest);
+}
+
+int AudioProcessingImpl::ProcessReverseStreamFrames(
+    const int16_t* const src,
+    size_t num_frames,
+    const StreamConfig& input_config,
+    const StreamConfig& output_config,
+    int16_t* const dest) {
+  TRACE_EVENT1("webrtc", "AudioProcessing::ProcessReverseStreamFrames",
+               "num_frames", num_frames);
+  MutexLock lock(&mutex_render_);
+  return ProcessReverseStreamFramesLocked(src, num_frames, input_config,
+                                          output_config, dest);
+}
 
+int AudioProcessingImpl::ProcessReverseStreamFramesLocked(
+    const int16_t* const src,
+    size_t num_frames,
+    const StreamConfig& input_config,
+    const StreamConfig& output_config,
+    int16_t* const dest) {
   if (input_config.num_channels() <= 0) {
     return AudioProcessing::Error::kBadNumberChannelsError;
   }
 
-  MutexLock lock(&mutex_render_);
   DenormalDisabler denormal_disabler(use_denormal_disabler_);
 
   ProcessingConfig processing_config = formats_.api_format;
@@ -1447,16 +1470,23 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
     return kBadDataLengthError;
   }
 
-  if (aec_dump_) {
-    aec_dump_->WriteRenderStreamMessage(src, input_config.num_frames(),
-                                        input_config.num_channels());
-  }
+  // The settings queued while the frames were buffered by the caller all take
+  // effect from the first frame.
+  HandleRenderRuntimeSettings();
+  for (size_t i = 0; i < num_frames; ++i) {
+    const int16_t* const frame_src = src + i * input_config.num_samples();
+    if (aec_dump_) {
+      aec_dump_->WriteRenderStreamMessage(
+          frame_src, input_config.num_frames(), input_config.num_channels());
+    }
 
-  render_.render_audio->CopyFrom(src, input_config);
-  RETURN_ON_ERR(ProcessRenderStreamLocked());
-  if (submodule_states_.RenderMultiBandProcessingActive() ||
-      submodule_states_.RenderFullBandProcessingActive()) {
-    render_.render_audio->CopyTo(output_config, dest);
+    render_.render_audio->CopyFrom(frame_src, input_config);
+    RETURN_ON_ERR(ProcessRenderStreamLocked());
+    if (submodule_states_.RenderMultiBandProcessingActive() ||
+        submodule_states_.RenderFullBandProcessingActive()) {
+      render_.render_audio->CopyTo(output_config,
+                                   dest + i * output_config.num_samples());
+    }
   }
   return kNoError;
 }
@@ -1464,9 +1494,6 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
 int AudioProcessingImpl::ProcessRenderStreamLocked() {
   AudioBuffer* render_buffer = render_.render_audio.get();  // For brevity.
 
-  HandleRenderRuntimeSettings();
-  DenormalDisabler denormal_disabler(use_denormal_disabler_);
-
   if (submodules_.render_pre_processor) {
     submodules_.render_pre_processor->Process(render_buffer);
   }
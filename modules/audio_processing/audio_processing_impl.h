@@ -108,6 +108,11 @@ class AudioProcessingImpl : public AudioProcessing {
                            const StreamConfig& input_config,
                            const StreamConfig& output_config,
                            int16_t* const dest) override;
+  int ProcessReverseStreamFrames(const int16_t* const src,
+                                 size_t num_frames,
+                                 const StreamConfig& input_config,
+                                 const StreamConfig& output_config,
+                                 int16_t* const dest) override;
   int AnalyzeReverseStream(const float* const* data,
                            const StreamConfig& reverse_config) override;
   int ProcessReverseStream(const float* const* src,
@@ -312,6 +317,15 @@ class AudioProcessingImpl : public AudioProcessing {
                                  const StreamConfig& input_config,
                                  const StreamConfig& output_config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
+  // Processes consecutive frames of interleaved 16 bit integer render audio.
+  int ProcessReverseStreamFramesLocked(const int16_t* const src,
+                                       size_t num_frames,
+                                       const StreamConfig& input_config,
+                                       const StreamConfig& output_config,
+                                       int16_t* const dest)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
+  // Processes the frame in `render_.render_audio`. The render runtime settings
+  // are expected to have been handled.
   int ProcessRenderStreamLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
   // Collects configuration settings from public and private
@@ -594,6 +594,53 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, ProcessReverseStreamFramesProcessesEachFrame) {
+  // Tests that a batch of render frames is processed as if each frame was
+  // passed to ProcessReverseStream() in turn.
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const auto* echo_control_factory_ptr = echo_control_factory.get();
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting()
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .SetRenderPreProcessing(std::make_unique<TestRenderPreProcessor>())
+          .Create();
+
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumChannels = 2;
+  constexpr size_t kNumFrames = 4;
+  constexpr size_t kFrameSize = kNumChannels * kSampleRateHz / 100;
+  const ProcessingConfig processing_config = {{
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+  }};
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(testing::_))
+      .Times(kNumFrames);
+  apm->Initialize(processing_config);
+  StreamConfig stream_config(kSampleRateHz, kNumChannels);
+
+  std::array<int16_t, kNumFrames * kFrameSize> frames;
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    std::fill(frames.begin() + i * kFrameSize,
+              frames.begin() + (i + 1) * kFrameSize,
+              static_cast<int16_t>(1000 * (i + 1)));
+  }
+
+  ASSERT_EQ(AudioProcessing::Error::kNoError,
+            apm->ProcessReverseStreamFrames(frames.data(), kNumFrames,
+                                            stream_config, stream_config,
+                                            frames.data()));
+
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    const int16_t expected_level = static_cast<int16_t>(
+        TestRenderPreProcessor::ProcessSample(1000.f * (i + 1)));
+    EXPECT_EQ(expected_level, frames[i * kFrameSize]);
+    EXPECT_EQ(expected_level, frames[(i + 1) * kFrameSize - 1]);
+  }
+}
+
 // Disabling build-optional submodules and trying to enable them via the APM
 // config should be bit-exact with running APM with said submodules disabled.
 // This mainly tests that SetCreateOptionalSubmodulesForTesting has an effect.
@@ -43,7 +43,8 @@ enum class SettingsType {
   kDefaultApmMobile,
   kAllSubmodulesTurnedOff,
   kDefaultApmDesktopWithoutDelayAgnostic,
-  kDefaultApmDesktopWithoutExtendedFilter
+  kDefaultApmDesktopWithoutExtendedFilter,
+  kNoiseSuppressionOnly
 };
 
 // Variables related to the audio data and formats.
@@ -81,7 +82,8 @@ struct SimulationConfig {
     const SettingsType desktop_settings[] = {
         SettingsType::kDefaultApmDesktop, SettingsType::kAllSubmodulesTurnedOff,
         SettingsType::kDefaultApmDesktopWithoutDelayAgnostic,
-        SettingsType::kDefaultApmDesktopWithoutExtendedFilter};
+        SettingsType::kDefaultApmDesktopWithoutExtendedFilter,
+        SettingsType::kNoiseSuppressionOnly};
 
     const int desktop_sample_rates[] = {8000, 16000, 32000, 48000};
 
@@ -123,6 +125,9 @@ struct SimulationConfig {
       case SettingsType::kDefaultApmDesktopWithoutExtendedFilter:
         description = "DefaultApmDesktopWithoutExtendedFilter";
         break;
+      case SettingsType::kNoiseSuppressionOnly:
+        description = "NoiseSuppressionOnly";
+        break;
     }
     return description;
   }
@@ -465,6 +470,17 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
       apm->ApplyConfig(apm_config);
     };
 
+    // Lambda function for turning on only the noise suppressor, to time it in
+    // isolation.
+    auto set_noise_suppression_only_apm_runtime_settings =
+        [](AudioProcessing* apm) {
+          AudioProcessing::Config apm_config = apm->GetConfig();
+          apm_config.echo_canceller.enabled = false;
+          apm_config.gain_controller1.enabled = false;
+          apm_config.noise_suppression.enabled = true;
+          apm->ApplyConfig(apm_config);
+        };
+
     int num_capture_channels = 1;
     switch (simulation_config_.simulation_settings) {
       case SettingsType::kDefaultApmMobile: {
@@ -497,6 +513,12 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         set_default_desktop_apm_runtime_settings(apm_.get());
         break;
       }
+      case SettingsType::kNoiseSuppressionOnly: {
+        apm_ = AudioProcessingBuilderForTesting().Create();
+        ASSERT_TRUE(!!apm_);
+        set_noise_suppression_only_apm_runtime_settings(apm_.get());
+        break;
+      }
     }
 
     render_thread_state_.reset(new TimedThreadApiProcessor(
@@ -50,6 +50,23 @@ std::string GainController1ModeToString(const Agc1Config::Mode& mode) {
 
 constexpr int AudioProcessing::kNativeSampleRatesHz[];
 
+int AudioProcessing::ProcessReverseStreamFrames(
+    const int16_t* const src,
+    size_t num_frames,
+    const StreamConfig& input_config,
+    const StreamConfig& output_config,
+    int16_t* const dest) {
+  for (size_t i = 0; i < num_frames; ++i) {
+    const int error = ProcessReverseStream(
+        src + i * input_config.num_samples(), input_config, output_config,
+        dest + i * output_config.num_samples());
+    if (error != kNoError) {
+      return error;
+    }
+  }
+  return kNoError;
+}
+
 void CustomProcessing::SetRuntimeSetting(
     AudioProcessing::RuntimeSetting setting) {}
 
@@ -567,6 +567,20 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
                                    const StreamConfig& output_config,
                                    int16_t* const dest) = 0;
 
+  // Accepts and produces `num_frames` consecutive 10 ms frames of interleaved
+  // 16 bit integer audio for the reverse direction audio stream, as if
+  // `ProcessReverseStream()` were called for each of them in turn. Frame `i`
+  // starts at `src + i * input_config.num_samples()` and is written to
+  // `dest + i * output_config.num_samples()`. Meant for playout devices that
+  // deliver more than 10 ms at a time; the implementation may take its locks
+  // and validate the stream configs once for all frames. Stops at the first
+  // frame that fails.
+  virtual int ProcessReverseStreamFrames(const int16_t* const src,
+                                         size_t num_frames,
+                                         const StreamConfig& input_config,
+                                         const StreamConfig& output_config,
+                                         int16_t* const dest);
+
   // Accepts deinterleaved float audio with the range [-1, 1]. Each element of
   // `data` points to a channel buffer, arranged according to `reverse_config`.
   virtual int ProcessReverseStream(const float* const* src,
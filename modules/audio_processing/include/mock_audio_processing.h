@@ -130,6 +130,14 @@ class MockAudioProcessing : public AudioProcessing {
                const StreamConfig& output_config,
                int16_t* const dest),
               (override));
+  MOCK_METHOD(int,
+              ProcessReverseStreamFrames,
+              (const int16_t* const src,
+               size_t num_frames,
+               const StreamConfig& input_config,
+               const StreamConfig& output_config,
+               int16_t* const dest),
+              (override));
   MOCK_METHOD(int,
               AnalyzeReverseStream,
               (const float* const* data, const StreamConfig& reverse_config),
@@ -14,6 +14,14 @@
 #include <stdint.h>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 
@@ -58,7 +66,34 @@ float LogApproximation(float x) {
 }
 
 void LogApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y) {
-  for (size_t k = 0; k < x.size(); ++k) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  constexpr float kLogOf2 = 0.69314718056f;
+  size_t k = 0;
+  // Same operations as FastLog2f(), four values at a time.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The bits of the positive inputs fit in a signed integer, so converting them
+  // as signed gives the same floats as converting them as unsigned.
+  const __m128 scale = _mm_set1_ps(1.1920929e-7f);
+  const __m128 bias = _mm_set1_ps(126.942695f);
+  const __m128 log_of_2 = _mm_set1_ps(kLogOf2);
+  for (; k + 4 <= x.size(); k += 4) {
+    const __m128 x_k = _mm_loadu_ps(&x[k]);
+    __m128 log2_x = _mm_cvtepi32_ps(_mm_castps_si128(x_k));
+    log2_x = _mm_sub_ps(_mm_mul_ps(log2_x, scale), bias);
+    _mm_storeu_ps(&y[k], _mm_mul_ps(log2_x, log_of_2));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  const float32x4_t scale = vdupq_n_f32(1.1920929e-7f);
+  const float32x4_t bias = vdupq_n_f32(126.942695f);
+  const float32x4_t log_of_2 = vdupq_n_f32(kLogOf2);
+  for (; k + 4 <= x.size(); k += 4) {
+    const float32x4_t x_k = vld1q_f32(&x[k]);
+    float32x4_t log2_x = vcvtq_f32_u32(vreinterpretq_u32_f32(x_k));
+    log2_x = vsubq_f32(vmulq_f32(log2_x, scale), bias);
+    vst1q_f32(&y[k], vmulq_f32(log2_x, log_of_2));
+  }
+#endif
+  for (; k < x.size(); ++k) {
     y[k] = LogApproximation(x[k]);
   }
 }
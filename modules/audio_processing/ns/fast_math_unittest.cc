@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/fast_math.h"
+
+#include <array>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that the vectorized log approximation of an array, including its
+// scalar tail, matches the approximation of the individual values.
+TEST(NsFastMath, ArrayLogApproximationMatchesScalarVersion) {
+  constexpr size_t kSize = 131;
+  std::array<float, kSize> x;
+  for (size_t i = 0; i < kSize; ++i) {
+    x[i] = 1e-3f + i * i * 37.5f;
+  }
+  std::array<float, kSize> y;
+  LogApproximation(x, y);
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(LogApproximation(x[i]), y[i]) << "i: " << i;
+  }
+}
+
+}  // namespace webrtc
@@ -17,6 +17,14 @@
 
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 
@@ -152,7 +160,25 @@ void ComputeMagnitudeSpectrum(
   signal_spectrum[kFftSizeBy2Plus1 - 1] =
       fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
 
-  for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
+  size_t i = 1;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  for (; i + 4 <= kFftSizeBy2Plus1 - 1; i += 4) {
+    const __m128 re = _mm_loadu_ps(&real[i]);
+    const __m128 im = _mm_loadu_ps(&imag[i]);
+    const __m128 power = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    _mm_storeu_ps(&signal_spectrum[i],
+                  _mm_add_ps(_mm_sqrt_ps(power), _mm_set1_ps(1.f)));
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  for (; i + 4 <= kFftSizeBy2Plus1 - 1; i += 4) {
+    const float32x4_t re = vld1q_f32(&real[i]);
+    const float32x4_t im = vld1q_f32(&imag[i]);
+    const float32x4_t power = vaddq_f32(vmulq_f32(re, re), vmulq_f32(im, im));
+    vst1q_f32(&signal_spectrum[i],
+              vaddq_f32(vsqrtq_f32(power), vdupq_n_f32(1.f)));
+  }
+#endif
+  for (; i < kFftSizeBy2Plus1 - 1; ++i) {
     signal_spectrum[i] =
         SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
   }
@@ -166,7 +192,48 @@ void ComputeSnr(rtc::ArrayView<const float, kFftSizeBy2Plus1> filter,
                 rtc::ArrayView<const float> noise_spectrum,
                 rtc::ArrayView<float> prior_snr,
                 rtc::ArrayView<float> post_snr) {
-  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The same computations as below, four bins at a time.
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 epsilon = _mm_set1_ps(0.0001f);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const __m128 noise = _mm_loadu_ps(&noise_spectrum[i]);
+    const __m128 signal = _mm_loadu_ps(&signal_spectrum[i]);
+    const __m128 prev_estimate = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&prev_signal_spectrum[i]),
+                   _mm_add_ps(_mm_loadu_ps(&prev_noise_spectrum[i]), epsilon)),
+        _mm_loadu_ps(&filter[i]));
+    const __m128 post_snr_i = _mm_and_ps(
+        _mm_cmpgt_ps(signal, noise),
+        _mm_sub_ps(_mm_div_ps(signal, _mm_add_ps(noise, epsilon)), one));
+    _mm_storeu_ps(&post_snr[i], post_snr_i);
+    _mm_storeu_ps(&prior_snr[i],
+                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.98f), prev_estimate),
+                             _mm_mul_ps(_mm_set1_ps(1.f - 0.98f), post_snr_i)));
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  // The same computations as below, four bins at a time.
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t epsilon = vdupq_n_f32(0.0001f);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const float32x4_t noise = vld1q_f32(&noise_spectrum[i]);
+    const float32x4_t signal = vld1q_f32(&signal_spectrum[i]);
+    const float32x4_t prev_estimate = vmulq_f32(
+        vdivq_f32(vld1q_f32(&prev_signal_spectrum[i]),
+                  vaddq_f32(vld1q_f32(&prev_noise_spectrum[i]), epsilon)),
+        vld1q_f32(&filter[i]));
+    const float32x4_t post_snr_i = vbslq_f32(
+        vcgtq_f32(signal, noise),
+        vsubq_f32(vdivq_f32(signal, vaddq_f32(noise, epsilon)), one),
+        vdupq_n_f32(0.f));
+    vst1q_f32(&post_snr[i], post_snr_i);
+    vst1q_f32(&prior_snr[i],
+              vaddq_f32(vmulq_f32(vdupq_n_f32(0.98f), prev_estimate),
+                        vmulq_f32(vdupq_n_f32(1.f - 0.98f), post_snr_i)));
+  }
+#endif
+  for (; i < kFftSizeBy2Plus1; ++i) {
     // Previous post SNR.
     // Previous estimate: based on previous frame with gain filter.
     float prev_estimate = prev_signal_spectrum[i] /
@@ -13,22 +13,48 @@
 #include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
 
 namespace webrtc {
+namespace {
 
-NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
-  // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
-  // initialization)
-  bit_reversal_state_[0] = 0.f;
-  std::array<float, kFftSize> tmp_buffer;
-  tmp_buffer.fill(0.f);
-  WebRtc_rdft(kFftSize, 1, tmp_buffer.data(), bit_reversal_state_.data(),
-              tables_.data());
+// Initialized state and tables of WebRtc_rdft(). Once initialized, the tables
+// are only read, but the bit reversal state is also used as work area and is
+// therefore copied by each instance.
+struct RdftTables {
+  RdftTables() : bit_reversal_state(kFftSize / 2), tables(kFftSize / 2) {
+    // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
+    // initialization)
+    bit_reversal_state[0] = 0.f;
+    std::array<float, kFftSize> tmp_buffer;
+    tmp_buffer.fill(0.f);
+    WebRtc_rdft(kFftSize, 1, tmp_buffer.data(), bit_reversal_state.data(),
+                tables.data());
+  }
+
+  std::vector<size_t> bit_reversal_state;
+  std::vector<float> tables;
+};
+
+const RdftTables& GetRdftTables() {
+  static const RdftTables* const rdft_tables = new RdftTables();
+  return *rdft_tables;
 }
 
+// WebRtc_rdft() takes the tables as non-const but does not write them once
+// initialized.
+float* Tables(rtc::ArrayView<const float> tables) {
+  return const_cast<float*>(tables.data());
+}
+
+}  // namespace
+
+NrFft::NrFft()
+    : bit_reversal_state_(GetRdftTables().bit_reversal_state),
+      tables_(GetRdftTables().tables) {}
+
 void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
                 rtc::ArrayView<float, kFftSize> real,
                 rtc::ArrayView<float, kFftSize> imag) {
   WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
-              tables_.data());
+              Tables(tables_));
 
   imag[0] = 0;
   real[0] = time_data[0];
@@ -52,7 +78,7 @@ void NrFft::Ifft(rtc::ArrayView<const float> real,
     time_data[2 * i + 1] = imag[i];
   }
   WebRtc_rdft(kFftSize, -1, time_data.data(), bit_reversal_state_.data(),
-              tables_.data());
+              Tables(tables_));
 
   // Scale the output
   constexpr float kScaling = 2.f / kFftSize;
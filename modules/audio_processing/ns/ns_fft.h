@@ -37,7 +37,8 @@ class NrFft {
 
  private:
   std::vector<size_t> bit_reversal_state_;
-  std::vector<float> tables_;
+  // Read-only tables shared by all the instances.
+  const rtc::ArrayView<const float> tables_;
 };
 
 }  // namespace webrtc
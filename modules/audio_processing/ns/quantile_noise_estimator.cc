@@ -13,9 +13,28 @@
 #include <algorithm>
 
 #include "modules/audio_processing/ns/fast_math.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// Returns the lanes of `a` where `mask` is set and those of `b` elsewhere.
+__m128 Select(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+}  // namespace
+#endif
+
 QuantileNoiseEstimator::QuantileNoiseEstimator() {
   quantile_.fill(0.f);
   density_.fill(0.3f);
@@ -38,7 +57,74 @@ void QuantileNoiseEstimator::Estimate(
   for (int s = 0, k = 0; s < kSimult;
        ++s, k += static_cast<int>(kFftSizeBy2Plus1)) {
     const float one_by_counter_plus_1 = 1.f / (counter_[s] + 1.f);
-    for (int i = 0, j = k; i < static_cast<int>(kFftSizeBy2Plus1); ++i, ++j) {
+    constexpr float kWidth = 0.01f;
+    constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+    int i = 0;
+    int j = k;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    // The same updates as below, with the branches replaced by selections.
+    const __m128 counter = _mm_set1_ps(static_cast<float>(counter_[s]));
+    const __m128 one_by_counter_plus_1_v = _mm_set1_ps(one_by_counter_plus_1);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    for (; i + 4 <= static_cast<int>(kFftSizeBy2Plus1); i += 4, j += 4) {
+      const __m128 log_spectrum_i = _mm_loadu_ps(&log_spectrum[i]);
+      __m128 log_quantile = _mm_loadu_ps(&log_quantile_[j]);
+      const __m128 density = _mm_loadu_ps(&density_[j]);
+
+      const __m128 forty = _mm_set1_ps(40.f);
+      const __m128 delta =
+          Select(_mm_cmpgt_ps(density, _mm_set1_ps(1.f)),
+                 _mm_div_ps(forty, density), forty);
+      const __m128 multiplier = _mm_mul_ps(delta, one_by_counter_plus_1_v);
+      log_quantile = Select(
+          _mm_cmpgt_ps(log_spectrum_i, log_quantile),
+          _mm_add_ps(log_quantile, _mm_mul_ps(_mm_set1_ps(0.25f), multiplier)),
+          _mm_sub_ps(log_quantile,
+                     _mm_mul_ps(_mm_set1_ps(0.75f), multiplier)));
+      _mm_storeu_ps(&log_quantile_[j], log_quantile);
+
+      const __m128 distance =
+          _mm_and_ps(_mm_sub_ps(log_spectrum_i, log_quantile), abs_mask);
+      const __m128 updated_density = _mm_mul_ps(
+          _mm_add_ps(_mm_mul_ps(counter, density),
+                     _mm_set1_ps(kOneByWidthPlus2)),
+          one_by_counter_plus_1_v);
+      _mm_storeu_ps(&density_[j],
+                    Select(_mm_cmplt_ps(distance, _mm_set1_ps(kWidth)),
+                           updated_density, density));
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    // The same updates as below, with the branches replaced by selections.
+    const float32x4_t counter = vdupq_n_f32(static_cast<float>(counter_[s]));
+    const float32x4_t one_by_counter_plus_1_v =
+        vdupq_n_f32(one_by_counter_plus_1);
+    for (; i + 4 <= static_cast<int>(kFftSizeBy2Plus1); i += 4, j += 4) {
+      const float32x4_t log_spectrum_i = vld1q_f32(&log_spectrum[i]);
+      float32x4_t log_quantile = vld1q_f32(&log_quantile_[j]);
+      const float32x4_t density = vld1q_f32(&density_[j]);
+
+      const float32x4_t forty = vdupq_n_f32(40.f);
+      const float32x4_t delta =
+          vbslq_f32(vcgtq_f32(density, vdupq_n_f32(1.f)),
+                    vdivq_f32(forty, density), forty);
+      const float32x4_t multiplier = vmulq_f32(delta, one_by_counter_plus_1_v);
+      log_quantile = vbslq_f32(
+          vcgtq_f32(log_spectrum_i, log_quantile),
+          vaddq_f32(log_quantile, vmulq_f32(vdupq_n_f32(0.25f), multiplier)),
+          vsubq_f32(log_quantile, vmulq_f32(vdupq_n_f32(0.75f), multiplier)));
+      vst1q_f32(&log_quantile_[j], log_quantile);
+
+      const float32x4_t distance =
+          vabsq_f32(vsubq_f32(log_spectrum_i, log_quantile));
+      const float32x4_t updated_density = vmulq_f32(
+          vaddq_f32(vmulq_f32(counter, density), vdupq_n_f32(kOneByWidthPlus2)),
+          one_by_counter_plus_1_v);
+      vst1q_f32(&density_[j],
+                vbslq_f32(vcltq_f32(distance, vdupq_n_f32(kWidth)),
+                          updated_density, density));
+    }
+#endif
+    for (; i < static_cast<int>(kFftSizeBy2Plus1); ++i, ++j) {
       // Update log quantile estimate.
       const float delta = density_[j] > 1.f ? 40.f / density_[j] : 40.f;
 
@@ -50,8 +136,6 @@ void QuantileNoiseEstimator::Estimate(
       }
 
       // Update density estimate.
-      constexpr float kWidth = 0.01f;
-      constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
       if (fabs(log_spectrum[i] - log_quantile_[j]) < kWidth) {
         density_[j] = (counter_[s] * density_[j] + kOneByWidthPlus2) *
                       one_by_counter_plus_1;
@@ -17,6 +17,14 @@
 
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 
@@ -33,7 +41,62 @@ void WienerFilter::Update(
     rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> parametric_noise_spectrum,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
-  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The same computations as below, four bins at a time.
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 epsilon = _mm_set1_ps(0.0001f);
+  const __m128 over_subtraction_factor =
+      _mm_set1_ps(suppression_params_.over_subtraction_factor);
+  const __m128 minimum_attenuating_gain =
+      _mm_set1_ps(suppression_params_.minimum_attenuating_gain);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const __m128 noise = _mm_loadu_ps(&noise_spectrum[i]);
+    const __m128 signal = _mm_loadu_ps(&signal_spectrum[i]);
+    const __m128 prev_tsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&spectrum_prev_process_[i]),
+                   _mm_add_ps(_mm_loadu_ps(&prev_noise_spectrum[i]), epsilon)),
+        _mm_loadu_ps(&filter_[i]));
+    const __m128 current_tsa = _mm_and_ps(
+        _mm_cmpgt_ps(signal, noise),
+        _mm_sub_ps(_mm_div_ps(signal, _mm_add_ps(noise, epsilon)), one));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.98f), prev_tsa),
+                   _mm_mul_ps(_mm_set1_ps(1.f - 0.98f), current_tsa));
+    const __m128 filter = _mm_div_ps(
+        snr_prior, _mm_add_ps(over_subtraction_factor, snr_prior));
+    _mm_storeu_ps(&filter_[i], _mm_max_ps(_mm_min_ps(filter, one),
+                                          minimum_attenuating_gain));
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  // The same computations as below, four bins at a time.
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t epsilon = vdupq_n_f32(0.0001f);
+  const float32x4_t over_subtraction_factor =
+      vdupq_n_f32(suppression_params_.over_subtraction_factor);
+  const float32x4_t minimum_attenuating_gain =
+      vdupq_n_f32(suppression_params_.minimum_attenuating_gain);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const float32x4_t noise = vld1q_f32(&noise_spectrum[i]);
+    const float32x4_t signal = vld1q_f32(&signal_spectrum[i]);
+    const float32x4_t prev_tsa = vmulq_f32(
+        vdivq_f32(vld1q_f32(&spectrum_prev_process_[i]),
+                  vaddq_f32(vld1q_f32(&prev_noise_spectrum[i]), epsilon)),
+        vld1q_f32(&filter_[i]));
+    const float32x4_t current_tsa = vbslq_f32(
+        vcgtq_f32(signal, noise),
+        vsubq_f32(vdivq_f32(signal, vaddq_f32(noise, epsilon)), one),
+        vdupq_n_f32(0.f));
+    const float32x4_t snr_prior =
+        vaddq_f32(vmulq_f32(vdupq_n_f32(0.98f), prev_tsa),
+                  vmulq_f32(vdupq_n_f32(1.f - 0.98f), current_tsa));
+    const float32x4_t filter =
+        vdivq_f32(snr_prior, vaddq_f32(over_subtraction_factor, snr_prior));
+    vst1q_f32(&filter_[i],
+              vmaxq_f32(vminq_f32(filter, one), minimum_attenuating_gain));
+  }
+#endif
+  for (; i < kFftSizeBy2Plus1; ++i) {
     // Previous estimate based on previous frame with gain filter.
     float prev_tsa = spectrum_prev_process_[i] /
                      (prev_noise_spectrum[i] + 0.0001f) * filter_[i];
@@ -158,7 +158,7 @@ bool WavBasedSimulator::HandleProcessReverseStreamCall() {
 
 void WavBasedSimulator::Initialize() {
   std::unique_ptr<WavReader> in_file(
-      new WavReader(settings_.input_filename->c_str()));
+      new WavReader(*settings_.input_filename, /*memory_map=*/true));
   int input_sample_rate_hz = in_file->sample_rate();
   int input_num_channels = in_file->num_channels();
   buffer_reader_.reset(new ChannelBufferWavReader(std::move(in_file)));
@@ -176,7 +176,7 @@ void WavBasedSimulator::Initialize() {
   int reverse_output_num_channels = 1;
   if (settings_.reverse_input_filename) {
     std::unique_ptr<WavReader> reverse_in_file(
-        new WavReader(settings_.reverse_input_filename->c_str()));
+        new WavReader(*settings_.reverse_input_filename, /*memory_map=*/true));
     reverse_sample_rate_hz = reverse_in_file->sample_rate();
     reverse_num_channels = reverse_in_file->num_channels();
     reverse_buffer_reader_.reset(
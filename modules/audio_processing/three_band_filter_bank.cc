@@ -35,6 +35,14 @@
 #include <array>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -132,18 +140,68 @@ void FilterCore(
     }
   }
 
+  // The SIMD versions compute the same accumulations as the scalar one, for
+  // four outputs at a time.
+  static_assert(
+      (ThreeBandFilterBank::kSplitBandSize - kFilterSize * kStride) % 4 == 0,
+      "");
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
+       k < ThreeBandFilterBank::kSplitBandSize; k += 4, shift += 4) {
+    __m128 out_k = _mm_setzero_ps();
+    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
+      out_k = _mm_add_ps(
+          out_k, _mm_mul_ps(_mm_loadu_ps(&in[j]), _mm_set1_ps(filter[i])));
+    }
+    _mm_storeu_ps(&out[k], out_k);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
+       k < ThreeBandFilterBank::kSplitBandSize; k += 4, shift += 4) {
+    float32x4_t out_k = vdupq_n_f32(0.f);
+    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
+      out_k = vaddq_f32(out_k, vmulq_n_f32(vld1q_f32(&in[j]), filter[i]));
+    }
+    vst1q_f32(&out[k], out_k);
+  }
+#else
   for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
        k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
     for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
       out[k] += in[j] * filter[i];
     }
   }
+#endif
 
   // Update current state.
   std::copy(in.begin() + ThreeBandFilterBank::kSplitBandSize - kMemorySize,
             in.end(), state.begin());
 }
 
+// Computes `y` += `a` * `x`.
+void MultiplyAccumulate(
+    float a,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> x,
+    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> y) {
+  static_assert(ThreeBandFilterBank::kSplitBandSize % 4 == 0, "");
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128 a_v = _mm_set1_ps(a);
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    _mm_storeu_ps(&y[n], _mm_add_ps(_mm_loadu_ps(&y[n]),
+                                    _mm_mul_ps(a_v, _mm_loadu_ps(&x[n]))));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    vst1q_f32(&y[n],
+              vaddq_f32(vld1q_f32(&y[n]), vmulq_n_f32(vld1q_f32(&x[n]), a)));
+  }
+#else
+  for (int n = 0; n < ThreeBandFilterBank::kSplitBandSize; ++n) {
+    y[n] += a * x[n];
+  }
+#endif
+}
+
 }  // namespace
 
 // Because the low-pass filter prototype has half bandwidth it is possible to
@@ -211,10 +269,10 @@ void ThreeBandFilterBank::Analysis(
 
       // Band and modulate the output.
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        float* out_band = out[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          out_band[n] += dct_modulation[band] * out_subsampled[n];
-        }
+        MultiplyAccumulate(
+            dct_modulation[band], out_subsampled,
+            rtc::ArrayView<float, kSplitBandSize>(out[band].data(),
+                                                  kSplitBandSize));
       }
     }
   }
@@ -230,9 +288,12 @@ void ThreeBandFilterBank::Synthesis(
     rtc::ArrayView<const rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
         in,
     rtc::ArrayView<float, kFullBandSize> out) {
-  std::fill(out.begin(), out.end(), 0);
   for (int upsampling_index = 0; upsampling_index < kSubSampling;
        ++upsampling_index) {
+    // Every output sample is written once after accumulating the outputs of
+    // the filters for `upsampling_index`.
+    std::array<float, kSplitBandSize> out_upsampled;
+    out_upsampled.fill(0.f);
     for (int in_shift = 0; in_shift < kStride; ++in_shift) {
       // Choose filter, skip zero filters.
       const int index = upsampling_index + in_shift * kSubSampling;
@@ -255,22 +316,24 @@ void ThreeBandFilterBank::Synthesis(
       std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
         RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
-        const float* in_band = in[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          in_subsampled[n] += dct_modulation[band] * in_band[n];
-        }
+        MultiplyAccumulate(dct_modulation[band],
+                           rtc::ArrayView<const float, kSplitBandSize>(
+                               in[band].data(), kSplitBandSize),
+                           in_subsampled);
       }
 
       // Filter.
       std::array<float, kSplitBandSize> out_subsampled;
       FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
 
-      // Upsample.
+      // Accumulate the filter outputs to upsample.
       constexpr float kUpsamplingScaling = kSubSampling;
-      for (int k = 0; k < kSplitBandSize; ++k) {
-        out[upsampling_index + kSubSampling * k] +=
-            kUpsamplingScaling * out_subsampled[k];
-      }
+      MultiplyAccumulate(kUpsamplingScaling, out_subsampled, out_upsampled);
+    }
+
+    // Upsample.
+    for (int k = 0; k < kSplitBandSize; ++k) {
+      out[upsampling_index + kSubSampling * k] = out_upsampled[k];
     }
   }
 }
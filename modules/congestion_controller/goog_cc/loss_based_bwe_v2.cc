@@ -123,6 +123,7 @@ LossBasedBweV2::LossBasedBweV2(const WebRtcKeyValueConfig* key_value_config)
 
   current_estimate_.inherent_loss = config_->initial_inherent_loss_estimate;
   observations_.resize(config_->observation_window_size);
+  observation_terms_.reserve(config_->observation_window_size);
   temporal_weights_.resize(config_->observation_window_size);
   instant_upper_bound_temporal_weights_.resize(
       config_->observation_window_size);
@@ -556,27 +557,35 @@ LossBasedBweV2::Derivatives LossBasedBweV2::GetDerivatives(
     const ChannelParameters& channel_parameters) const {
   Derivatives derivatives;
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
+  const size_t num_at_or_below = NumObservationTermsAtOrBelow(
+      channel_parameters.loss_limited_bandwidth);
+  if (num_at_or_below > 0) {
+    const ObservationTerm& last = observation_terms_[num_at_or_below - 1];
+    const double loss_probability = GetLossProbability(
+        channel_parameters.inherent_loss,
+        channel_parameters.loss_limited_bandwidth, DataRate::Zero());
+    derivatives.first +=
+        (last.cumulative_lost_packets / loss_probability) -
+        (last.cumulative_received_packets / (1.0 - loss_probability));
+    derivatives.second -=
+        (last.cumulative_lost_packets / (loss_probability * loss_probability)) +
+        (last.cumulative_received_packets /
+         ((1.0 - loss_probability) * (1.0 - loss_probability)));
+  }
 
+  for (size_t i = num_at_or_below; i < observation_terms_.size(); ++i) {
+    const ObservationTerm& term = observation_terms_[i];
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
-
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
+        channel_parameters.loss_limited_bandwidth, term.sending_rate);
 
     derivatives.first +=
-        temporal_weight *
-        ((observation.num_lost_packets / loss_probability) -
-         (observation.num_received_packets / (1.0 - loss_probability)));
+        (term.weighted_lost_packets / loss_probability) -
+        (term.weighted_received_packets / (1.0 - loss_probability));
     derivatives.second -=
-        temporal_weight *
-        ((observation.num_lost_packets / std::pow(loss_probability, 2)) +
-         (observation.num_received_packets /
-          std::pow(1.0 - loss_probability, 2)));
+        (term.weighted_lost_packets / (loss_probability * loss_probability)) +
+        (term.weighted_received_packets /
+         ((1.0 - loss_probability) * (1.0 - loss_probability)));
   }
 
   if (derivatives.second >= 0.0) {
@@ -621,29 +630,33 @@ double LossBasedBweV2::GetObjective(
     const ChannelParameters& channel_parameters) const {
   double objective = 0.0;
 
-  const double high_bandwidth_bias =
-      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth);
-
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
+  const size_t num_at_or_below = NumObservationTermsAtOrBelow(
+      channel_parameters.loss_limited_bandwidth);
+  if (num_at_or_below > 0) {
+    const ObservationTerm& last = observation_terms_[num_at_or_below - 1];
+    const double loss_probability = GetLossProbability(
+        channel_parameters.inherent_loss,
+        channel_parameters.loss_limited_bandwidth, DataRate::Zero());
+    objective +=
+        (last.cumulative_lost_packets * std::log(loss_probability)) +
+        (last.cumulative_received_packets * std::log(1.0 - loss_probability));
+  }
 
+  for (size_t i = num_at_or_below; i < observation_terms_.size(); ++i) {
+    const ObservationTerm& term = observation_terms_[i];
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
+        channel_parameters.loss_limited_bandwidth, term.sending_rate);
 
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-
-    objective +=
-        temporal_weight *
-        ((observation.num_lost_packets * std::log(loss_probability)) +
-         (observation.num_received_packets * std::log(1.0 - loss_probability)));
     objective +=
-        temporal_weight * high_bandwidth_bias * observation.num_packets;
+        (term.weighted_lost_packets * std::log(loss_probability)) +
+        (term.weighted_received_packets * std::log(1.0 - loss_probability));
   }
 
+  objective +=
+      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth) *
+      weighted_num_packets_;
+
   return objective;
 }
 
@@ -689,6 +702,64 @@ void LossBasedBweV2::CalculateTemporalWeights() {
   }
 }
 
+void LossBasedBweV2::CalculateObservationTerms(
+    const Observation& observation) {
+  // The terms are already sorted, so only the replaced observation is removed
+  // and the new one inserted, instead of sorting them all again.
+  const int replaced_id = observation.id - config_->observation_window_size;
+  if (replaced_id >= 0) {
+    observation_terms_.erase(absl::c_find_if(
+        observation_terms_, [replaced_id](const ObservationTerm& term) {
+          return term.observation_id == replaced_id;
+        }));
+  }
+  ObservationTerm new_term;
+  new_term.observation_id = observation.id;
+  new_term.sending_rate = observation.sending_rate;
+  observation_terms_.insert(
+      std::upper_bound(observation_terms_.begin(), observation_terms_.end(),
+                       new_term,
+                       [](const ObservationTerm& a, const ObservationTerm& b) {
+                         return a.sending_rate < b.sending_rate;
+                       }),
+      new_term);
+
+  // All temporal weights change when an observation is added.
+  weighted_num_packets_ = 0.0;
+  double cumulative_lost_packets = 0.0;
+  double cumulative_received_packets = 0.0;
+  for (ObservationTerm& term : observation_terms_) {
+    const Observation& term_observation =
+        observations_[term.observation_id % config_->observation_window_size];
+    double temporal_weight =
+        temporal_weights_[(num_observations_ - 1) - term.observation_id];
+
+    term.weighted_lost_packets =
+        temporal_weight * term_observation.num_lost_packets;
+    term.weighted_received_packets =
+        temporal_weight * term_observation.num_received_packets;
+    cumulative_lost_packets += term.weighted_lost_packets;
+    cumulative_received_packets += term.weighted_received_packets;
+    term.cumulative_lost_packets = cumulative_lost_packets;
+    term.cumulative_received_packets = cumulative_received_packets;
+    weighted_num_packets_ += temporal_weight * term_observation.num_packets;
+  }
+}
+
+size_t LossBasedBweV2::NumObservationTermsAtOrBelow(DataRate bandwidth) const {
+  // If the bandwidth isn't finite, all observations are handled one by one so
+  // that GetLossProbability() can warn about it.
+  if (!IsValid(bandwidth)) {
+    return 0;
+  }
+  auto it = std::upper_bound(
+      observation_terms_.begin(), observation_terms_.end(), bandwidth,
+      [](DataRate bandwidth, const ObservationTerm& term) {
+        return bandwidth < term.sending_rate;
+      });
+  return it - observation_terms_.begin();
+}
+
 void LossBasedBweV2::NewtonsMethodUpdate(
     ChannelParameters& channel_parameters) const {
   if (num_observations_ <= 0) {
@@ -748,6 +819,7 @@ bool LossBasedBweV2::PushBackObservation(
 
   partial_observation_ = PartialObservation();
 
+  CalculateObservationTerms(observation);
   CalculateInstantUpperBound();
   return true;
 }
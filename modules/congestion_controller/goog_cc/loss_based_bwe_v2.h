@@ -103,6 +103,21 @@ class LossBasedBweV2 {
     DataSize size = DataSize::Zero();
   };
 
+  // The temporally weighted packet counts of an observation. The terms are
+  // kept sorted by sending rate, with sums over all terms up to and including
+  // each one. All observations sent at or below a candidate bandwidth have the
+  // same loss probability, so their contribution to the objective and its
+  // derivatives is computed from the sums at once, and only the observations
+  // sent faster than the candidate are visited one by one.
+  struct ObservationTerm {
+    int observation_id = -1;
+    DataRate sending_rate = DataRate::MinusInfinity();
+    double weighted_lost_packets = 0.0;
+    double weighted_received_packets = 0.0;
+    double cumulative_lost_packets = 0.0;
+    double cumulative_received_packets = 0.0;
+  };
+
   static absl::optional<Config> CreateConfig(
       const WebRtcKeyValueConfig* key_value_config);
   bool IsConfigValid() const;
@@ -123,6 +138,11 @@ class LossBasedBweV2 {
   void CalculateInstantUpperBound();
 
   void CalculateTemporalWeights();
+  // Updates `observation_terms_` after `observation` has been added, replacing
+  // the observation that fell out of the window.
+  void CalculateObservationTerms(const Observation& observation);
+  // Returns the number of observation terms sent at or below `bandwidth`.
+  size_t NumObservationTermsAtOrBelow(DataRate bandwidth) const;
   void NewtonsMethodUpdate(ChannelParameters& channel_parameters) const;
 
   // Returns false if no observation was created.
@@ -139,6 +159,9 @@ class LossBasedBweV2 {
   absl::optional<DataRate> cached_instant_upper_bound_;
   std::vector<double> instant_upper_bound_temporal_weights_;
   std::vector<double> temporal_weights_;
+  std::vector<ObservationTerm> observation_terms_;
+  // Sum of the temporally weighted number of packets of all observations.
+  double weighted_num_packets_ = 0.0;
 };
 
 }  // namespace webrtc
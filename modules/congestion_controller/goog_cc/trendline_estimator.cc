@@ -51,34 +51,8 @@ size_t ReadTrendlineFilterWindowSize(
   return TrendlineEstimatorSettings::kDefaultTrendlineWindowSize;
 }
 
-absl::optional<double> LinearFitSlope(
-    const std::deque<TrendlineEstimator::PacketTiming>& packets) {
-  RTC_DCHECK(packets.size() >= 2);
-  // Compute the "center of mass".
-  double sum_x = 0;
-  double sum_y = 0;
-  for (const auto& packet : packets) {
-    sum_x += packet.arrival_time_ms;
-    sum_y += packet.smoothed_delay_ms;
-  }
-  double x_avg = sum_x / packets.size();
-  double y_avg = sum_y / packets.size();
-  // Compute the slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2
-  double numerator = 0;
-  double denominator = 0;
-  for (const auto& packet : packets) {
-    double x = packet.arrival_time_ms;
-    double y = packet.smoothed_delay_ms;
-    numerator += (x - x_avg) * (y - y_avg);
-    denominator += (x - x_avg) * (x - x_avg);
-  }
-  if (denominator == 0)
-    return absl::nullopt;
-  return numerator / denominator;
-}
-
 absl::optional<double> ComputeSlopeCap(
-    const std::deque<TrendlineEstimator::PacketTiming>& packets,
+    const TrendlineEstimator::PacketWindow& packets,
     const TrendlineEstimatorSettings& settings) {
   RTC_DCHECK(1 <= settings.beginning_packets &&
              settings.beginning_packets < packets.size());
@@ -114,6 +88,92 @@ constexpr int kDeltaCounterMax = 1000;
 
 constexpr char TrendlineEstimatorSettings::kKey[];
 
+TrendlineEstimator::PacketWindow::PacketWindow(size_t window_size)
+    : packets_(window_size + 1, PacketTiming(0, 0, 0)),
+      window_size_(window_size) {
+  RTC_DCHECK_GE(window_size, 2);
+}
+
+TrendlineEstimator::PacketWindow::~PacketWindow() = default;
+
+void TrendlineEstimator::PacketWindow::Add(const PacketTiming& packet,
+                                           bool sort) {
+  if (size_ == 0) {
+    origin_x_ = packet.arrival_time_ms;
+    origin_y_ = packet.smoothed_delay_ms;
+  }
+  At(size_) = packet;
+  ++size_;
+  double x = packet.arrival_time_ms - origin_x_;
+  double y = packet.smoothed_delay_ms - origin_y_;
+  sum_x_ += x;
+  sum_y_ += y;
+  sum_xx_ += x * x;
+  sum_xy_ += x * y;
+
+  if (sort) {
+    // The sums don't depend on the order.
+    for (size_t i = size_ - 1;
+         i > 0 && At(i).arrival_time_ms < At(i - 1).arrival_time_ms; --i) {
+      std::swap(At(i), At(i - 1));
+    }
+  }
+  if (size_ > window_size_) {
+    const PacketTiming& oldest = At(0);
+    x = oldest.arrival_time_ms - origin_x_;
+    y = oldest.smoothed_delay_ms - origin_y_;
+    sum_x_ -= x;
+    sum_y_ -= y;
+    sum_xx_ -= x * x;
+    sum_xy_ -= x * y;
+    begin_ = (begin_ + 1) % packets_.size();
+    --size_;
+  }
+  if (++adds_since_recompute_ >= window_size_)
+    RecomputeSums();
+}
+
+const TrendlineEstimator::PacketTiming&
+TrendlineEstimator::PacketWindow::operator[](size_t index) const {
+  RTC_DCHECK_LT(index, size_);
+  return packets_[(begin_ + index) % packets_.size()];
+}
+
+TrendlineEstimator::PacketTiming& TrendlineEstimator::PacketWindow::At(
+    size_t index) {
+  return packets_[(begin_ + index) % packets_.size()];
+}
+
+absl::optional<double> TrendlineEstimator::PacketWindow::LinearFitSlope()
+    const {
+  RTC_DCHECK_GE(size_, 2);
+  // The slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2, with both
+  // sums multiplied by n.
+  const double n = size_;
+  const double denominator = n * sum_xx_ - sum_x_ * sum_x_;
+  if (denominator == 0)
+    return absl::nullopt;
+  return (n * sum_xy_ - sum_x_ * sum_y_) / denominator;
+}
+
+void TrendlineEstimator::PacketWindow::RecomputeSums() {
+  adds_since_recompute_ = 0;
+  sum_x_ = sum_y_ = sum_xx_ = sum_xy_ = 0;
+  if (size_ == 0)
+    return;
+  // Moving the origin along keeps the coordinates small.
+  origin_x_ = At(0).arrival_time_ms;
+  origin_y_ = At(0).smoothed_delay_ms;
+  for (size_t i = 0; i < size_; ++i) {
+    const double x = At(i).arrival_time_ms - origin_x_;
+    const double y = At(i).smoothed_delay_ms - origin_y_;
+    sum_x_ += x;
+    sum_y_ += y;
+    sum_xx_ += x * x;
+    sum_xy_ += x * y;
+  }
+}
+
 TrendlineEstimatorSettings::TrendlineEstimatorSettings(
     const WebRtcKeyValueConfig* key_value_config) {
   if (absl::StartsWith(
@@ -169,7 +229,7 @@ TrendlineEstimator::TrendlineEstimator(
       first_arrival_time_ms_(-1),
       accumulated_delay_(0),
       smoothed_delay_(0),
-      delay_hist_(),
+      delay_hist_(settings_.window_size),
       k_up_(0.0087),
       k_down_(0.039),
       overusing_time_threshold_(kOverUsingTimeThreshold),
@@ -212,19 +272,10 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
                         smoothed_delay_);
 
   // Maintain packet window
-  delay_hist_.emplace_back(
-      static_cast<double>(arrival_time_ms - first_arrival_time_ms_),
-      smoothed_delay_, accumulated_delay_);
-  if (settings_.enable_sort) {
-    for (size_t i = delay_hist_.size() - 1;
-         i > 0 &&
-         delay_hist_[i].arrival_time_ms < delay_hist_[i - 1].arrival_time_ms;
-         --i) {
-      std::swap(delay_hist_[i], delay_hist_[i - 1]);
-    }
-  }
-  if (delay_hist_.size() > settings_.window_size)
-    delay_hist_.pop_front();
+  delay_hist_.Add(PacketTiming(static_cast<double>(arrival_time_ms -
+                                                   first_arrival_time_ms_),
+                               smoothed_delay_, accumulated_delay_),
+                  settings_.enable_sort);
 
   // Simple linear regression.
   double trend = prev_trend_;
@@ -234,7 +285,7 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
     // 0 < trend < 1   ->  the delay increases, queues are filling up
     //   trend == 0    ->  the delay does not change
     //   trend < 0     ->  the delay decreases, queues are being emptied
-    trend = LinearFitSlope(delay_hist_).value_or(trend);
+    trend = delay_hist_.LinearFitSlope().value_or(trend);
     if (settings_.enable_cap) {
       absl::optional<double> cap = ComputeSlopeCap(delay_hist_, settings_);
       // We only use the cap to filter out overuse detections, not
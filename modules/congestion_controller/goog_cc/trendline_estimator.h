@@ -13,10 +13,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <deque>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/types/optional.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/congestion_controller/goog_cc/delay_increase_detector_interface.h"
@@ -88,6 +89,51 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
     double raw_delay_ms;
   };
 
+  // The last `window_size` packets, in a ring buffer with running sums for the
+  // linear least squares regression, so that adding a packet and fitting a
+  // line are O(1) instead of O(window_size).
+  class PacketWindow {
+   public:
+    explicit PacketWindow(size_t window_size);
+    ~PacketWindow();
+
+    // Adds `packet` and removes the oldest packet if the window was full. If
+    // `sort` is set, `packet` is first moved back past packets with a later
+    // arrival time, and the packet with the earliest arrival time is removed.
+    void Add(const PacketTiming& packet, bool sort);
+
+    size_t size() const { return size_; }
+    // Packet `index` counted from the oldest one.
+    const PacketTiming& operator[](size_t index) const;
+
+    // Slope of the line fitted to the smoothed delays, or nullopt if all
+    // packets have the same arrival time. Requires at least two packets.
+    absl::optional<double> LinearFitSlope() const;
+
+   private:
+    PacketTiming& At(size_t index);
+    // Recomputes the sums from the packets in the window, relative to the
+    // oldest packet.
+    void RecomputeSums();
+
+    // Has room for one packet more than the window, which is added before
+    // the oldest one is removed.
+    std::vector<PacketTiming> packets_;
+    const size_t window_size_;
+    size_t begin_ = 0;
+    size_t size_ = 0;
+    // Sums of the coordinates relative to the origin. Arrival times are whole
+    // milliseconds, so the sums of x and x*x are exact. The sums involving y
+    // are recomputed once per window so rounding errors don't build up.
+    double origin_x_ = 0;
+    double origin_y_ = 0;
+    double sum_x_ = 0;
+    double sum_y_ = 0;
+    double sum_xx_ = 0;
+    double sum_xy_ = 0;
+    size_t adds_since_recompute_ = 0;
+  };
+
  private:
   friend class GoogCcStatePrinter;
   void Detect(double trend, double ts_delta, int64_t now_ms);
@@ -106,7 +152,7 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   double accumulated_delay_;
   double smoothed_delay_;
   // Linear least squares regression.
-  std::deque<PacketTiming> delay_hist_;
+  PacketWindow delay_hist_;
 
   const double k_up_;
   const double k_down_;
@@ -11,6 +11,7 @@
 #include "modules/congestion_controller/goog_cc/trendline_estimator.h"
 
 #include <algorithm>
+#include <deque>
 #include <numeric>
 #include <vector>
 
@@ -21,6 +22,30 @@
 namespace webrtc {
 namespace {
 
+// The two pass regression that the estimator used before it kept running sums.
+absl::optional<double> ReferenceLinearFitSlope(
+    const std::deque<TrendlineEstimator::PacketTiming>& packets) {
+  double sum_x = 0;
+  double sum_y = 0;
+  for (const auto& packet : packets) {
+    sum_x += packet.arrival_time_ms;
+    sum_y += packet.smoothed_delay_ms;
+  }
+  double x_avg = sum_x / packets.size();
+  double y_avg = sum_y / packets.size();
+  double numerator = 0;
+  double denominator = 0;
+  for (const auto& packet : packets) {
+    double x = packet.arrival_time_ms;
+    double y = packet.smoothed_delay_ms;
+    numerator += (x - x_avg) * (y - y_avg);
+    denominator += (x - x_avg) * (x - x_avg);
+  }
+  if (denominator == 0)
+    return absl::nullopt;
+  return numerator / denominator;
+}
+
 class PacketTimeGenerator {
  public:
   PacketTimeGenerator(int64_t initial_clock, double time_between_packets)
@@ -148,4 +173,57 @@ TEST_F(TrendlineEstimatorTest, IncludesSmallPacketsByDefault) {
   EXPECT_EQ(count, kPacketCount);  // All packets processed
 }
 
+TEST(TrendlinePacketWindowTest, MatchesTwoPassRegression) {
+  constexpr size_t kWindowSize = 20;
+  Random random(0x5eed);
+  for (bool sort : {false, true}) {
+    TrendlineEstimator::PacketWindow window(kWindowSize);
+    std::deque<TrendlineEstimator::PacketTiming> reference;
+    // Arrival times far from zero, like in a long call.
+    int64_t arrival_time_ms = 3600 * 1000;
+    double smoothed_delay_ms = 0;
+    for (int i = 0; i < 10000; ++i) {
+      // Mostly increasing arrival times, with some reordering and bursts that
+      // arrive in the same millisecond.
+      arrival_time_ms += random.Rand(-2, 10);
+      smoothed_delay_ms += random.Gaussian(0, 5);
+      TrendlineEstimator::PacketTiming packet(arrival_time_ms,
+                                              smoothed_delay_ms, 0);
+      window.Add(packet, sort);
+      reference.push_back(packet);
+      if (sort) {
+        for (size_t j = reference.size() - 1;
+             j > 0 &&
+             reference[j].arrival_time_ms < reference[j - 1].arrival_time_ms;
+             --j) {
+          std::swap(reference[j], reference[j - 1]);
+        }
+      }
+      if (reference.size() > kWindowSize)
+        reference.pop_front();
+
+      ASSERT_EQ(window.size(), reference.size());
+      for (size_t j = 0; j < reference.size(); ++j) {
+        ASSERT_EQ(window[j].arrival_time_ms, reference[j].arrival_time_ms);
+      }
+      if (reference.size() < 2)
+        continue;
+      absl::optional<double> expected = ReferenceLinearFitSlope(reference);
+      absl::optional<double> slope = window.LinearFitSlope();
+      ASSERT_EQ(slope.has_value(), expected.has_value()) << i;
+      if (expected) {
+        EXPECT_NEAR(*slope, *expected, 1e-9 * std::max(1.0, fabs(*expected)))
+            << i;
+      }
+    }
+  }
+}
+
+TEST(TrendlinePacketWindowTest, NoSlopeForEqualArrivalTimes) {
+  TrendlineEstimator::PacketWindow window(10);
+  for (int i = 0; i < 10; ++i)
+    window.Add(TrendlineEstimator::PacketTiming(1000, i, i), false);
+  EXPECT_FALSE(window.LinearFitSlope());
+}
+
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_control.h"
 #include "api/units/data_rate.h"
@@ -46,6 +47,10 @@ class ReceiveSideCongestionController : public CallStatsObserver,
   virtual void OnReceivedPacket(int64_t arrival_time_ms,
                                 size_t payload_size,
                                 const RTPHeader& header);
+  // Same as OnReceivedPacket() for each of `packets`, e.g. for the packets
+  // of one socket read, with a single lock of the feedback generator.
+  void OnReceivedPackets(
+      rtc::ArrayView<const RemoteEstimatorProxy::Packet> packets);
 
   void SetSendPeriodicFeedback(bool send_periodic_feedback);
   // TODO(nisse): Delete these methods, design a more specific interface.
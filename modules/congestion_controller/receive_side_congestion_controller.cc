@@ -143,6 +143,18 @@ void ReceiveSideCongestionController::OnReceivedPacket(
   }
 }
 
+void ReceiveSideCongestionController::OnReceivedPackets(
+    rtc::ArrayView<const RemoteEstimatorProxy::Packet> packets) {
+  remote_estimator_proxy_.IncomingPackets(packets);
+  for (const RemoteEstimatorProxy::Packet& packet : packets) {
+    if (!packet.header->extension.hasTransportSequenceNumber) {
+      // Receive-side BWE.
+      remote_bitrate_estimator_.IncomingPacket(
+          packet.arrival_time_ms, packet.payload_size, *packet.header);
+    }
+  }
+}
+
 void ReceiveSideCongestionController::SetSendPeriodicFeedback(
     bool send_periodic_feedback) {
   remote_estimator_proxy_.SetSendPeriodicFeedback(send_periodic_feedback);
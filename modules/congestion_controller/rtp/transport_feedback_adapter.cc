@@ -84,8 +84,88 @@ bool InFlightBytesTracker::NetworkRouteComparator::operator()(
   return a.connected < b.connected;
 }
 
-TransportFeedbackAdapter::TransportFeedbackAdapter() = default;
+SentPacketHistory::SentPacketHistory() = default;
+SentPacketHistory::~SentPacketHistory() = default;
+
+const PacketFeedback& SentPacketHistory::front() const {
+  RTC_DCHECK(!empty());
+  return EntryAt(begin_).packet;
+}
+
+void SentPacketHistory::pop_front() {
+  Erase(begin_);
+}
+
+void SentPacketHistory::Insert(const PacketFeedback& packet) {
+  const int64_t sequence_number = packet.sent.sequence_number;
+  if (empty()) {
+    Reserve(1);
+    begin_ = sequence_number;
+    span_ = 1;
+  } else if (sequence_number >= end_sequence_number()) {
+    Reserve(sequence_number - begin_ + 1);
+    span_ = sequence_number - begin_ + 1;
+  } else if (sequence_number < begin_) {
+    Reserve(end_sequence_number() - sequence_number);
+    span_ = end_sequence_number() - sequence_number;
+    begin_ = sequence_number;
+  } else if (EntryAt(sequence_number).valid) {
+    return;
+  }
+  Entry& entry = EntryAt(sequence_number);
+  entry.valid = true;
+  entry.packet = packet;
+}
+
+PacketFeedback* SentPacketHistory::Find(int64_t sequence_number) {
+  if (sequence_number < begin_ || sequence_number >= end_sequence_number())
+    return nullptr;
+  Entry& entry = EntryAt(sequence_number);
+  return entry.valid ? &entry.packet : nullptr;
+}
 
+void SentPacketHistory::Erase(int64_t sequence_number) {
+  if (sequence_number < begin_ || sequence_number >= end_sequence_number())
+    return;
+  EntryAt(sequence_number).valid = false;
+  while (span_ > 0 && !EntryAt(begin_).valid) {
+    ++begin_;
+    --span_;
+  }
+  while (span_ > 0 && !EntryAt(begin_ + span_ - 1).valid) {
+    --span_;
+  }
+}
+
+SentPacketHistory::Entry& SentPacketHistory::EntryAt(int64_t sequence_number) {
+  // The capacity is a power of two, so this also works for negative numbers.
+  return entries_[static_cast<uint64_t>(sequence_number) &
+                  (entries_.size() - 1)];
+}
+
+const SentPacketHistory::Entry& SentPacketHistory::EntryAt(
+    int64_t sequence_number) const {
+  return entries_[static_cast<uint64_t>(sequence_number) &
+                  (entries_.size() - 1)];
+}
+
+void SentPacketHistory::Reserve(int64_t min_capacity) {
+  constexpr int64_t kMinCapacity = 64;
+  int64_t capacity = std::max<int64_t>(entries_.size(), kMinCapacity);
+  while (capacity < min_capacity)
+    capacity *= 2;
+  if (capacity == static_cast<int64_t>(entries_.size()))
+    return;
+  std::vector<Entry> entries(capacity);
+  for (int64_t seq = begin_; seq < end_sequence_number(); ++seq) {
+    Entry& entry = EntryAt(seq);
+    if (entry.valid)
+      entries[static_cast<uint64_t>(seq) & (capacity - 1)] = std::move(entry);
+  }
+  entries_ = std::move(entries);
+}
+
+TransportFeedbackAdapter::TransportFeedbackAdapter() = default;
 
 void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
                                          size_t overhead_bytes,
@@ -100,14 +180,16 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
   packet.sent.pacing_info = packet_info.pacing_info;
 
   while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
-             kSendTimeHistoryWindow) {
+         (creation_time - history_.front().creation_time >
+              kSendTimeHistoryWindow ||
+          packet.sent.sequence_number - history_.begin_sequence_number() >=
+              SentPacketHistory::kMaxSequenceNumberSpan)) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    if (history_.front().sent.sequence_number > last_ack_seq_num_)
+      in_flight_.RemoveInFlightPacketBytes(history_.front());
+    history_.pop_front();
   }
-  history_.insert(std::make_pair(packet.sent.sequence_number, packet));
+  history_.Insert(packet);
 }
 
 absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
@@ -117,10 +199,10 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    PacketFeedback* packet = history_.Find(unwrapped_seq_num);
+    if (packet) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -128,14 +210,14 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -167,9 +249,8 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   if (msg.packet_feedbacks.empty())
     return absl::nullopt;
 
-  auto it = history_.find(last_ack_seq_num_);
-  if (it != history_.end()) {
-    msg.first_unacked_send_time = it->second.sent.send_time;
+  if (const PacketFeedback* packet = history_.Find(last_ack_seq_num_)) {
+    msg.first_unacked_send_time = packet->sent.send_time;
   }
   msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
 
@@ -218,22 +299,24 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number());
 
     if (seq_num > last_ack_seq_num_) {
-      // Starts at history_.begin() if last_ack_seq_num_ < 0, since any valid
-      // sequence number is >= 0.
-      for (auto it = history_.upper_bound(last_ack_seq_num_);
-           it != history_.upper_bound(seq_num); ++it) {
-        in_flight_.RemoveInFlightPacketBytes(it->second);
+      const int64_t end_seq_num =
+          std::min(seq_num + 1, history_.end_sequence_number());
+      for (int64_t seq = std::max(last_ack_seq_num_ + 1,
+                                  history_.begin_sequence_number());
+           seq < end_seq_num; ++seq) {
+        if (const PacketFeedback* acked = history_.Find(seq))
+          in_flight_.RemoveInFlightPacketBytes(*acked);
       }
       last_ack_seq_num_ = seq_num;
     }
 
-    auto it = history_.find(seq_num);
-    if (it == history_.end()) {
+    const PacketFeedback* packet_feedback = history_.Find(seq_num);
+    if (!packet_feedback) {
       ++failed_lookups;
       continue;
     }
 
-    if (it->second.sent.send_time.IsInfinite()) {
+    if (packet_feedback->sent.send_time.IsInfinite()) {
       // TODO(srte): Fix the tests that makes this happen and make this a
       // DCHECK.
       RTC_DLOG(LS_ERROR)
@@ -241,23 +324,25 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
       continue;
     }
 
-    PacketFeedback packet_feedback = it->second;
+    Timestamp receive_time = packet_feedback->receive_time;
     if (packet.received()) {
       packet_offset += packet.delta();
-      packet_feedback.receive_time =
+      receive_time =
           current_offset_ + packet_offset.RoundDownTo(TimeDelta::Millis(1));
-      // Note: Lost packets are not removed from history because they might be
-      // reported as received by a later feedback.
-      history_.erase(it);
     }
-    if (packet_feedback.network_route == network_route_) {
+    if (packet_feedback->network_route == network_route_) {
       PacketResult result;
-      result.sent_packet = packet_feedback.sent;
-      result.receive_time = packet_feedback.receive_time;
+      result.sent_packet = packet_feedback->sent;
+      result.receive_time = receive_time;
       packet_result_vector.push_back(result);
     } else {
       ++ignored;
     }
+    if (packet.received()) {
+      // Note: Lost packets are not removed from history because they might be
+      // reported as received by a later feedback.
+      history_.Erase(seq_num);
+    }
   }
 
   if (failed_lookups > 0) {
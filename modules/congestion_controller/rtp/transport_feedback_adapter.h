@@ -54,6 +54,52 @@ class InFlightBytesTracker {
   std::map<rtc::NetworkRoute, DataSize, NetworkRouteComparator> in_flight_data_;
 };
 
+// Sent packets that are waiting for feedback, by unwrapped transport sequence
+// number. They are kept in a power-of-two ring buffer that covers the sequence
+// numbers from the oldest to the newest packet, so that a lookup is an offset
+// from the oldest packet.
+class SentPacketHistory {
+ public:
+  // Feedback never refers further back than this, as the receiver's
+  // PacketArrivalTimeMap doesn't hold more packets.
+  static constexpr int64_t kMaxSequenceNumberSpan = 1 << 15;
+
+  SentPacketHistory();
+  ~SentPacketHistory();
+
+  bool empty() const { return span_ == 0; }
+  // Sequence numbers of the oldest packet and one past the newest packet.
+  int64_t begin_sequence_number() const { return begin_; }
+  int64_t end_sequence_number() const { return begin_ + span_; }
+
+  // Oldest packet. The history must not be empty.
+  const PacketFeedback& front() const;
+  void pop_front();
+
+  // Adds `packet` unless a packet with the same sequence number exists.
+  void Insert(const PacketFeedback& packet);
+  // Returns null if there is no packet with `sequence_number`.
+  PacketFeedback* Find(int64_t sequence_number);
+  void Erase(int64_t sequence_number);
+
+ private:
+  struct Entry {
+    bool valid = false;
+    PacketFeedback packet;
+  };
+
+  Entry& EntryAt(int64_t sequence_number);
+  const Entry& EntryAt(int64_t sequence_number) const;
+  // Reallocates the ring buffer to hold at least `min_capacity` entries.
+  void Reserve(int64_t min_capacity);
+
+  // Entries outside of [begin_, begin_ + span_) are never valid, and the
+  // first and last entry inside are always valid.
+  std::vector<Entry> entries_;
+  int64_t begin_ = 0;
+  int64_t span_ = 0;
+};
+
 class TransportFeedbackAdapter {
  public:
   TransportFeedbackAdapter();
@@ -83,7 +129,7 @@ class TransportFeedbackAdapter {
   Timestamp last_send_time_ = Timestamp::MinusInfinity();
   Timestamp last_untracked_send_time_ = Timestamp::MinusInfinity();
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  SentPacketHistory history_;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
@@ -408,4 +408,39 @@ TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   EXPECT_FALSE(duplicate_packet.has_value());
 }
 
+TEST(SentPacketHistoryTest, FindsPacketsAcrossGrowthAndWrap) {
+  SentPacketHistory history;
+  auto make_packet = [](int64_t sequence_number) {
+    PacketFeedback packet;
+    packet.sent.sequence_number = sequence_number;
+    packet.sent.size = DataSize::Bytes(sequence_number);
+    return packet;
+  };
+  for (int64_t seq = 1000; seq < 1200; seq += 2)
+    history.Insert(make_packet(seq));
+  EXPECT_EQ(history.begin_sequence_number(), 1000);
+  EXPECT_EQ(history.end_sequence_number(), 1199);
+  EXPECT_EQ(history.Find(1001), nullptr);
+  ASSERT_NE(history.Find(1100), nullptr);
+  EXPECT_EQ(history.Find(1100)->sent.size, DataSize::Bytes(1100));
+
+  // Duplicates are ignored.
+  PacketFeedback duplicate = make_packet(1100);
+  duplicate.sent.size = DataSize::Zero();
+  history.Insert(duplicate);
+  EXPECT_EQ(history.Find(1100)->sent.size, DataSize::Bytes(1100));
+
+  // Erasing the oldest and newest packets trims the range to valid packets.
+  history.Erase(1000);
+  history.Erase(1198);
+  EXPECT_EQ(history.begin_sequence_number(), 1002);
+  EXPECT_EQ(history.end_sequence_number(), 1197);
+
+  while (!history.empty() && history.front().sent.sequence_number < 1150)
+    history.pop_front();
+  EXPECT_EQ(history.begin_sequence_number(), 1150);
+  for (int64_t seq = 1150; seq < 1197; seq += 2)
+    EXPECT_EQ(history.Find(seq)->sent.size, DataSize::Bytes(seq)) << seq;
+}
+
 }  // namespace webrtc
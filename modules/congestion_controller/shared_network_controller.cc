@@ -0,0 +1,209 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/congestion_controller/shared_network_controller.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+class SharedNetworkControllerFactory::Controller
+    : public NetworkControllerInterface {
+ public:
+  Controller(SharedNetworkControllerFactory* shared,
+             std::unique_ptr<NetworkControllerInterface> controller)
+      : shared_(shared),
+        controller_(std::move(controller)),
+        id_(shared_->AddMember()) {}
+  ~Controller() override { shared_->RemoveMember(id_); }
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    return Apply(controller_->OnNetworkAvailability(msg));
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    return Apply(controller_->OnNetworkRouteChange(msg));
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    NetworkControlUpdate update = controller_->OnProcessInterval(msg);
+    // The other transports may have changed the split since the last target
+    // rate of this one, so repeat it to pick up the new allocation.
+    if (!update.target_rate && last_target_rate_ &&
+        shared_->Allocation(id_) != applied_allocation_) {
+      update.target_rate = last_target_rate_;
+      update.target_rate->at_time = msg.at_time;
+    }
+    return Apply(std::move(update));
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override {
+    return Apply(controller_->OnRemoteBitrateReport(msg));
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override {
+    return Apply(controller_->OnRoundTripTimeUpdate(msg));
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    return Apply(controller_->OnSentPacket(msg));
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override {
+    return Apply(controller_->OnReceivedPacket(msg));
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    shared_->UpdateDemand(id_, msg.max_total_allocated_bitrate.value_or(
+                                   DataRate::PlusInfinity()));
+    return Apply(controller_->OnStreamsConfig(msg));
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    return Apply(controller_->OnTargetRateConstraints(msg));
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override {
+    return Apply(controller_->OnTransportLossReport(msg));
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    return Apply(controller_->OnTransportPacketsFeedback(msg));
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override {
+    return Apply(controller_->OnNetworkStateEstimate(msg));
+  }
+
+ private:
+  NetworkControlUpdate Apply(NetworkControlUpdate update) {
+    if (!update.probe_cluster_configs.empty() && !shared_->MayProbe(id_))
+      update.probe_cluster_configs.clear();
+    if (update.pacer_config)
+      last_pacer_config_ = update.pacer_config;
+
+    if (update.target_rate) {
+      last_target_rate_ = update.target_rate;
+      const DataRate estimate = update.target_rate->target_rate;
+      applied_allocation_ = shared_->UpdateEstimate(id_, estimate);
+      const double ratio =
+          estimate.IsZero() ? 1.0 : applied_allocation_ / estimate;
+      update.target_rate->target_rate = applied_allocation_;
+      update.target_rate->stable_target_rate =
+          std::min(update.target_rate->stable_target_rate * ratio,
+                   applied_allocation_);
+      if (ratio != pacing_ratio_) {
+        pacing_ratio_ = ratio;
+        // Pace at the new allocation even if the controller didn't change its
+        // pacing rate.
+        if (!update.pacer_config)
+          update.pacer_config = last_pacer_config_;
+      }
+    }
+    if (update.pacer_config) {
+      update.pacer_config->data_window =
+          update.pacer_config->data_window * pacing_ratio_;
+      update.pacer_config->pad_window =
+          update.pacer_config->pad_window * pacing_ratio_;
+    }
+    return update;
+  }
+
+  SharedNetworkControllerFactory* const shared_;
+  const std::unique_ptr<NetworkControllerInterface> controller_;
+  const int id_;
+  // As produced by `controller_`, before the split.
+  absl::optional<TargetTransferRate> last_target_rate_;
+  absl::optional<PacerConfig> last_pacer_config_;
+  DataRate applied_allocation_ = DataRate::Zero();
+  // Ratio between the allocation and the estimate of `controller_`.
+  double pacing_ratio_ = 1.0;
+};
+
+SharedNetworkControllerFactory::SharedNetworkControllerFactory(
+    std::unique_ptr<NetworkControllerFactoryInterface> factory)
+    : factory_(std::move(factory)) {
+  RTC_DCHECK(factory_);
+}
+
+SharedNetworkControllerFactory::~SharedNetworkControllerFactory() {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(members_.empty());
+}
+
+std::unique_ptr<NetworkControllerInterface>
+SharedNetworkControllerFactory::Create(NetworkControllerConfig config) {
+  return std::make_unique<Controller>(this, factory_->Create(config));
+}
+
+TimeDelta SharedNetworkControllerFactory::GetProcessInterval() const {
+  return factory_->GetProcessInterval();
+}
+
+int SharedNetworkControllerFactory::AddMember() {
+  MutexLock lock(&mutex_);
+  int id = next_id_++;
+  members_[id] = Member();
+  return id;
+}
+
+void SharedNetworkControllerFactory::RemoveMember(int id) {
+  MutexLock lock(&mutex_);
+  members_.erase(id);
+  Reallocate();
+}
+
+DataRate SharedNetworkControllerFactory::UpdateEstimate(int id,
+                                                        DataRate estimate) {
+  MutexLock lock(&mutex_);
+  Member& member = members_[id];
+  member.estimate = estimate;
+  Reallocate();
+  return member.allocation;
+}
+
+void SharedNetworkControllerFactory::UpdateDemand(int id, DataRate demand) {
+  MutexLock lock(&mutex_);
+  members_[id].demand = demand.IsZero() ? DataRate::PlusInfinity() : demand;
+  Reallocate();
+}
+
+DataRate SharedNetworkControllerFactory::Allocation(int id) {
+  MutexLock lock(&mutex_);
+  return members_[id].allocation;
+}
+
+bool SharedNetworkControllerFactory::MayProbe(int id) {
+  MutexLock lock(&mutex_);
+  // Ids increase, so the oldest member is first.
+  return !members_.empty() && members_.begin()->first == id;
+}
+
+void SharedNetworkControllerFactory::Reallocate() {
+  DataRate remaining = DataRate::Zero();
+  std::vector<Member*> sharing;
+  for (auto& id_and_member : members_) {
+    Member& member = id_and_member.second;
+    if (member.estimate.IsFinite()) {
+      remaining += member.estimate;
+      sharing.push_back(&member);
+    }
+  }
+  // Members that ask for less than an equal share get what they ask for, the
+  // others split what is left.
+  std::sort(sharing.begin(), sharing.end(),
+            [](const Member* a, const Member* b) {
+              return a->demand < b->demand;
+            });
+  for (size_t i = 0; i < sharing.size(); ++i) {
+    const DataRate equal_share =
+        remaining / static_cast<int64_t>(sharing.size() - i);
+    sharing[i]->allocation = std::min(sharing[i]->demand, equal_share);
+    remaining -= sharing[i]->allocation;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_CONGESTION_CONTROLLER_SHARED_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_SHARED_NETWORK_CONTROLLER_H_
+
+#include <map>
+#include <memory>
+
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// SharedNetworkControllerFactory couples the network controllers it creates,
+// for transports that send over the same network path, e.g. several
+// PeerConnections created from the same PeerConnectionFactory. Without it,
+// each RtpTransportControllerSend probes and paces as if it were alone on the
+// path, and the transports push each other into queueing delay.
+//
+// Each transport still runs its own controller created by the wrapped
+// factory, but the target rates they produce are combined into an estimate
+// for the whole path, which is then split between the transports. Transports
+// whose configured max allocated bitrate is below an equal share get what they
+// ask for, and the rest is split equally among the others. This way a
+// congestion signal seen by one transport also lowers the rate of the others.
+// Only the oldest transport is allowed to send probes.
+//
+// The factory must outlive the controllers it creates. The controllers may be
+// used on different task queues.
+class SharedNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  explicit SharedNetworkControllerFactory(
+      std::unique_ptr<NetworkControllerFactoryInterface> factory);
+  ~SharedNetworkControllerFactory() override;
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override;
+  TimeDelta GetProcessInterval() const override;
+
+ private:
+  class Controller;
+  struct Member {
+    // Latest target rate of the member's own controller, or minus infinity
+    // before the first one. Members without one don't take part in the split.
+    DataRate estimate = DataRate::MinusInfinity();
+    DataRate demand = DataRate::PlusInfinity();
+    DataRate allocation = DataRate::Zero();
+  };
+
+  int AddMember();
+  void RemoveMember(int id);
+  // Returns the share of the path estimate allocated to `id`.
+  DataRate UpdateEstimate(int id, DataRate estimate);
+  void UpdateDemand(int id, DataRate demand);
+  DataRate Allocation(int id);
+  bool MayProbe(int id);
+  void Reallocate() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const std::unique_ptr<NetworkControllerFactoryInterface> factory_;
+  Mutex mutex_;
+  int next_id_ RTC_GUARDED_BY(mutex_) = 0;
+  std::map<int, Member> members_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_SHARED_NETWORK_CONTROLLER_H_
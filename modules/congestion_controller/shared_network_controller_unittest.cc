@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/congestion_controller/shared_network_controller.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Returns `next_update` from every call.
+class FakeNetworkController : public NetworkControllerInterface {
+ public:
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback) override {
+    return next_update;
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(NetworkStateEstimate) override {
+    return next_update;
+  }
+
+  NetworkControlUpdate next_update;
+};
+
+class FakeNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  explicit FakeNetworkControllerFactory(
+      std::vector<FakeNetworkController*>* controllers)
+      : controllers_(controllers) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    auto controller = std::make_unique<FakeNetworkController>();
+    controllers_->push_back(controller.get());
+    return controller;
+  }
+  TimeDelta GetProcessInterval() const override {
+    return TimeDelta::Millis(25);
+  }
+
+ private:
+  std::vector<FakeNetworkController*>* const controllers_;
+};
+
+NetworkControlUpdate TargetRateUpdate(DataRate target_rate) {
+  NetworkControlUpdate update;
+  update.target_rate = TargetTransferRate();
+  update.target_rate->target_rate = target_rate;
+  update.target_rate->stable_target_rate = target_rate;
+  update.pacer_config = PacerConfig();
+  update.pacer_config->time_window = TimeDelta::Seconds(1);
+  update.pacer_config->data_window = target_rate * TimeDelta::Seconds(1);
+  update.probe_cluster_configs.push_back(ProbeClusterConfig());
+  return update;
+}
+
+class SharedNetworkControllerTest : public ::testing::Test {
+ protected:
+  SharedNetworkControllerTest()
+      : factory_(std::make_unique<FakeNetworkControllerFactory>(&fakes_)) {}
+
+  // Makes controller `index` produce `target_rate` and returns the update
+  // after the split.
+  NetworkControlUpdate SetTargetRate(size_t index, DataRate target_rate) {
+    fakes_[index]->next_update = TargetRateUpdate(target_rate);
+    NetworkControlUpdate update =
+        controllers_[index]->OnTransportPacketsFeedback(
+            TransportPacketsFeedback());
+    fakes_[index]->next_update = NetworkControlUpdate();
+    return update;
+  }
+
+  std::vector<FakeNetworkController*> fakes_;
+  SharedNetworkControllerFactory factory_;
+  std::vector<std::unique_ptr<NetworkControllerInterface>> controllers_;
+};
+
+TEST_F(SharedNetworkControllerTest, SingleControllerIsUnchanged) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  NetworkControlUpdate update =
+      SetTargetRate(0, DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+}
+
+TEST_F(SharedNetworkControllerTest, SplitsCombinedEstimateAndProbesOnce) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  SetTargetRate(0, DataRate::KilobitsPerSec(600));
+  NetworkControlUpdate update =
+      SetTargetRate(1, DataRate::KilobitsPerSec(200));
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+  EXPECT_EQ(update.target_rate->stable_target_rate,
+            DataRate::KilobitsPerSec(400));
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(400));
+  // Only the first transport may probe.
+  EXPECT_TRUE(update.probe_cluster_configs.empty());
+
+  // The first transport picks up its new share on the next process interval.
+  update = controllers_[0]->OnProcessInterval(ProcessInterval());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(400));
+  EXPECT_EQ(update.pacer_config->data_rate(), DataRate::KilobitsPerSec(400));
+
+  // A drop in one estimate lowers the share of both.
+  update = SetTargetRate(0, DataRate::KilobitsPerSec(200));
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(200));
+  EXPECT_EQ(update.probe_cluster_configs.size(), 1u);
+}
+
+TEST_F(SharedNetworkControllerTest, GivesUnusedShareToOthers) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  StreamsConfig streams_config;
+  streams_config.max_total_allocated_bitrate = DataRate::KilobitsPerSec(100);
+  (void)controllers_[1]->OnStreamsConfig(streams_config);
+
+  SetTargetRate(1, DataRate::KilobitsPerSec(500));
+  NetworkControlUpdate update =
+      SetTargetRate(0, DataRate::KilobitsPerSec(500));
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(900));
+
+  // When the other transport goes away, the whole estimate is its own again.
+  controllers_.pop_back();
+  update = controllers_[0]->OnProcessInterval(ProcessInterval());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, DataRate::KilobitsPerSec(500));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -318,7 +318,8 @@ std::unique_ptr<DesktopCapturer> CroppingWindowCapturer::CreateCapturer(
   std::unique_ptr<DesktopCapturer> capturer(
       new CroppingWindowCapturerWin(options));
   if (capturer && options.detect_updated_region()) {
-    capturer.reset(new DesktopCapturerDifferWrapper(std::move(capturer)));
+    capturer.reset(new DesktopCapturerDifferWrapper(
+        std::move(capturer), options.detect_updated_region_coarse_to_fine()));
   }
 
   return capturer;
@@ -105,6 +105,17 @@ class RTC_EXPORT DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Flag that should be set along with detect_updated_region() to compare each
+  // row of blocks as a whole before comparing its blocks one by one. This
+  // reduces the CPU usage of detecting the updated region when most of the
+  // screen is static, e.g. for high resolution displays.
+  bool detect_updated_region_coarse_to_fine() const {
+    return detect_updated_region_coarse_to_fine_;
+  }
+  void set_detect_updated_region_coarse_to_fine(bool coarse_to_fine) {
+    detect_updated_region_coarse_to_fine_ = coarse_to_fine;
+  }
+
 #if defined(WEBRTC_WIN)
   // Enumerating windows owned by the current process on Windows has some
   // complications due to |GetWindowText*()| APIs potentially causing a
@@ -212,6 +223,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  bool detect_updated_region_coarse_to_fine_ = false;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
 #endif
@@ -109,11 +109,49 @@ void CompareRow(const uint8_t* old_buffer,
   }
 }
 
+// Returns true if any of the `height` rows of `width` pixels starting from
+// `old_buffer` and `new_buffer` differ. A whole row is compared at once, which
+// is cheaper than comparing it block by block when it hasn't changed.
+bool RowsDifference(const uint8_t* old_buffer,
+                    const uint8_t* new_buffer,
+                    int width,
+                    int height,
+                    int stride) {
+  const int width_bytes = width * DesktopFrame::kBytesPerPixel;
+  for (int i = 0; i < height; i++) {
+    if (memcmp(old_buffer, new_buffer, width_bytes) != 0) {
+      return true;
+    }
+    old_buffer += stride;
+    new_buffer += stride;
+  }
+  return false;
+}
+
+// Compares a row of blocks like CompareRow(), but if `coarse_to_fine` is true,
+// first checks whether the row has changed at all.
+void CompareRowCoarseToFine(const uint8_t* old_buffer,
+                            const uint8_t* new_buffer,
+                            const int left,
+                            const int right,
+                            const int top,
+                            const int bottom,
+                            const int stride,
+                            const bool coarse_to_fine,
+                            DesktopRegion* const output) {
+  if (coarse_to_fine && !RowsDifference(old_buffer, new_buffer, right - left,
+                                        bottom - top, stride)) {
+    return;
+  }
+  CompareRow(old_buffer, new_buffer, left, right, top, bottom, stride, output);
+}
+
 // Compares `rect` area in `old_frame` and `new_frame`, and outputs dirty
 // regions into `output`.
 void CompareFrames(const DesktopFrame& old_frame,
                    const DesktopFrame& new_frame,
                    DesktopRect rect,
+                   bool coarse_to_fine,
                    DesktopRegion* const output) {
   RTC_DCHECK(old_frame.size().equals(new_frame.size()));
   RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
@@ -131,22 +169,31 @@ void CompareFrames(const DesktopFrame& old_frame,
   int top = rect.top();
   // The last row may have a different height, so we handle it separately.
   for (int y = 0; y < y_block_count; y++) {
-    CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-               rect.right(), top, top + kBlockSize, old_frame.stride(), output);
+    CompareRowCoarseToFine(prev_block_row_start, curr_block_row_start,
+                           rect.left(), rect.right(), top, top + kBlockSize,
+                           old_frame.stride(), coarse_to_fine, output);
     top += kBlockSize;
     prev_block_row_start += block_y_stride;
     curr_block_row_start += block_y_stride;
   }
-  CompareRow(prev_block_row_start, curr_block_row_start, rect.left(),
-             rect.right(), top, top + last_y_block_height, old_frame.stride(),
-             output);
+  CompareRowCoarseToFine(prev_block_row_start, curr_block_row_start,
+                         rect.left(), rect.right(), top,
+                         top + last_y_block_height, old_frame.stride(),
+                         coarse_to_fine, output);
 }
 
 }  // namespace
 
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
     std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    : DesktopCapturerDifferWrapper(std::move(base_capturer),
+                                   /*coarse_to_fine=*/false) {}
+
+DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    bool coarse_to_fine)
+    : base_capturer_(std::move(base_capturer)),
+      coarse_to_fine_(coarse_to_fine) {
   RTC_DCHECK(base_capturer_);
 }
 
@@ -208,7 +255,7 @@ void DesktopCapturerDifferWrapper::OnCaptureResult(
     DesktopRegion hints;
     hints.Swap(frame->mutable_updated_region());
     for (DesktopRegion::Iterator it(hints); !it.IsAtEnd(); it.Advance()) {
-      CompareFrames(*last_frame_, *frame, it.rect(),
+      CompareFrames(*last_frame_, *frame, it.rect(), coarse_to_fine_,
                     frame->mutable_updated_region());
     }
   } else {
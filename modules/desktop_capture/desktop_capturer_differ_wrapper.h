@@ -40,6 +40,12 @@ class RTC_EXPORT DesktopCapturerDifferWrapper
   explicit DesktopCapturerDifferWrapper(
       std::unique_ptr<DesktopCapturer> base_capturer);
 
+  // If `coarse_to_fine` is true, each row of blocks is first compared as a
+  // whole, and only the rows that have changed are compared block by block.
+  // This is cheaper when most of a large frame is static.
+  DesktopCapturerDifferWrapper(std::unique_ptr<DesktopCapturer> base_capturer,
+                               bool coarse_to_fine);
+
   ~DesktopCapturerDifferWrapper() override;
 
   // DesktopCapturer interface.
@@ -59,6 +65,7 @@ class RTC_EXPORT DesktopCapturerDifferWrapper
                        std::unique_ptr<DesktopFrame> frame) override;
 
   const std::unique_ptr<DesktopCapturer> base_capturer_;
+  const bool coarse_to_fine_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
 };
@@ -153,7 +153,8 @@ void ExecuteCapturer(DesktopCapturerDifferWrapper* capturer,
 void ExecuteDifferWrapperTest(bool with_hints,
                               bool enlarge_updated_region,
                               bool random_updated_region,
-                              bool check_result) {
+                              bool check_result,
+                              bool coarse_to_fine = false) {
   const bool updated_region_should_exactly_match =
       with_hints && !enlarge_updated_region && !random_updated_region;
   BlackWhiteDesktopFramePainter frame_painter;
@@ -161,7 +162,7 @@ void ExecuteDifferWrapperTest(bool with_hints,
   frame_generator.set_desktop_frame_painter(&frame_painter);
   std::unique_ptr<FakeDesktopCapturer> fake(new FakeDesktopCapturer());
   fake->set_frame_generator(&frame_generator);
-  DesktopCapturerDifferWrapper capturer(std::move(fake));
+  DesktopCapturerDifferWrapper capturer(std::move(fake), coarse_to_fine);
   MockDesktopCapturerCallback callback;
   frame_generator.set_provide_updated_region_hints(with_hints);
   frame_generator.set_enlarge_updated_region(enlarge_updated_region);
@@ -244,6 +245,14 @@ TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
   ExecuteDifferWrapperTest(true, true, true, true);
 }
 
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHintsCoarseToFine) {
+  ExecuteDifferWrapperTest(false, false, false, true, true);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithHintsCoarseToFine) {
+  ExecuteDifferWrapperTest(true, false, false, true, true);
+}
+
 // When hints are provided, DesktopCapturerDifferWrapper has a slightly better
 // performance in current configuration, but not so significant. Following is
 // one run result.
@@ -288,4 +297,11 @@ TEST(DesktopCapturerDifferWrapperTest,
   ASSERT_LE(rtc::TimeMillis() - started, 15000);
 }
 
+TEST(DesktopCapturerDifferWrapperTest,
+     DISABLED_CaptureWithoutHintsCoarseToFinePerf) {
+  int64_t started = rtc::TimeMillis();
+  ExecuteDifferWrapperTest(false, false, false, false, true);
+  ASSERT_LE(rtc::TimeMillis() - started, 15000);
+}
+
 }  // namespace webrtc
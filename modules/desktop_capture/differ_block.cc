@@ -12,6 +12,8 @@
 
 #include <string.h>
 
+#include "modules/desktop_capture/differ_vector_avx2.h"
+#include "modules/desktop_capture/differ_vector_neon.h"
 #include "modules/desktop_capture/differ_vector_sse2.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
@@ -30,14 +32,27 @@ bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
   static bool (*diff_proc)(const uint8_t*, const uint8_t*) = nullptr;
 
   if (!diff_proc) {
-#if defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
-    // For ARM and MIPS processors, always use C version.
-    // TODO(hclam): Implement a NEON version.
+#if defined(WEBRTC_HAS_NEON)
+    if (kBlockSize == 32) {
+      diff_proc = &VectorDifference_NEON_W32;
+    } else if (kBlockSize == 16) {
+      diff_proc = &VectorDifference_NEON_W16;
+    } else {
+      diff_proc = &VectorDifference_C;
+    }
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
+    // For ARM processors without NEON and MIPS processors, always use C
+    // version.
     diff_proc = &VectorDifference_C;
 #else
+    bool have_avx2 = GetCPUInfo(kAVX2) != 0;
     bool have_sse2 = GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
+    // For x86 processors, check if AVX2 or SSE2 is supported.
+    if (have_avx2 && kBlockSize == 32) {
+      diff_proc = &VectorDifference_AVX2_W32;
+    } else if (have_avx2 && kBlockSize == 16) {
+      diff_proc = &VectorDifference_AVX2_W16;
+    } else if (have_sse2 && kBlockSize == 32) {
       diff_proc = &VectorDifference_SSE2_W32;
     } else if (have_sse2 && kBlockSize == 16) {
       diff_proc = &VectorDifference_SSE2_W16;
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_neon.h"
+
+#include <arm_neon.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+namespace {
+
+// Or:s the xor of `num_vectors` 16 byte vectors of `image1` and `image2`.
+uint8x16_t XorOr(const uint8_t* image1,
+                 const uint8_t* image2,
+                 int num_vectors) {
+  uint8x16_t acc = veorq_u8(vld1q_u8(image1), vld1q_u8(image2));
+  for (int i = 1; i < num_vectors; ++i) {
+    acc = vorrq_u8(acc, veorq_u8(vld1q_u8(image1 + 16 * i),
+                                 vld1q_u8(image2 + 16 * i)));
+  }
+  return acc;
+}
+
+bool IsNonZero(uint8x16_t acc) {
+#if defined(WEBRTC_ARCH_ARM64)
+  return vmaxvq_u8(acc) != 0;
+#else
+  uint32x2_t folded = vreinterpret_u32_u8(
+      vorr_u8(vget_low_u8(acc), vget_high_u8(acc)));
+  return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+#endif
+}
+
+}  // namespace
+
+extern bool VectorDifference_NEON_W16(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  return IsNonZero(XorOr(image1, image2, 4));
+}
+
+extern bool VectorDifference_NEON_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  return IsNonZero(XorOr(image1, image2, 8));
+}
+
+}  // namespace webrtc
@@ -106,6 +106,7 @@ typedef void (*glGetTexImage_func)(GLenum target,
                                    GLenum format,
                                    GLenum type,
                                    void* pixels);
+typedef void (*glPixelStorei_func)(GLenum pname, GLint param);
 typedef void (*glTexParameteri_func)(GLenum target, GLenum pname, GLint param);
 typedef void* (*glXGetProcAddressARB_func)(const char*);
 
@@ -119,6 +120,7 @@ glGenTextures_func GlGenTextures = nullptr;
 glGetError_func GlGetError = nullptr;
 glGetString_func GlGetString = nullptr;
 glGetTexImage_func GlGetTexImage = nullptr;
+glPixelStorei_func GlPixelStorei = nullptr;
 glTexParameteri_func GlTexParameteri = nullptr;
 glXGetProcAddressARB_func GlXGetProcAddressARB = nullptr;
 
@@ -280,11 +282,12 @@ static bool LoadGL() {
     GlGenTextures = (glGenTextures_func)GlXGetProcAddressARB("glGenTextures");
     GlGetError = (glGetError_func)GlXGetProcAddressARB("glGetError");
     GlGetTexImage = (glGetTexImage_func)GlXGetProcAddressARB("glGetTexImage");
+    GlPixelStorei = (glPixelStorei_func)GlXGetProcAddressARB("glPixelStorei");
     GlTexParameteri =
         (glTexParameteri_func)GlXGetProcAddressARB("glTexParameteri");
 
     return GlBindTexture && GlDeleteTextures && GlGenTextures && GlGetError &&
-           GlGetTexImage && GlTexParameteri;
+           GlGetTexImage && GlPixelStorei && GlTexParameteri;
   }
 
   return false;
@@ -466,20 +469,24 @@ bool EglDmaBuf::GetClientExtensions(EGLDisplay dpy, EGLint name) {
 }
 
 RTC_NO_SANITIZE("cfi-icall")
-std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
-    const DesktopSize& size,
-    uint32_t format,
-    const std::vector<PlaneData>& plane_datas,
-    uint64_t modifier) {
-  std::unique_ptr<uint8_t[]> src;
-
+bool EglDmaBuf::ImageFromDmaBuf(const DesktopSize& size,
+                                uint32_t format,
+                                const std::vector<PlaneData>& plane_datas,
+                                uint64_t modifier,
+                                uint8_t* data,
+                                int stride) {
   if (!egl_initialized_) {
-    return src;
+    return false;
   }
 
   if (plane_datas.size() <= 0) {
     RTC_LOG(LS_ERROR) << "Failed to process buffer: invalid number of planes";
-    return src;
+    return false;
+  }
+
+  if (stride % 4 != 0 || stride / 4 < size.width()) {
+    RTC_LOG(LS_ERROR) << "Failed to process buffer: invalid stride " << stride;
+    return false;
   }
 
   EGLint attribs[47];
@@ -568,7 +575,7 @@ std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
   if (image == EGL_NO_IMAGE) {
     RTC_LOG(LS_ERROR) << "Failed to record frame: Error creating EGLImage - "
                       << FormatEGLError(EglGetError());
-    return src;
+    return false;
   }
 
   // create GL 2D texture for framebuffer
@@ -581,34 +588,22 @@ std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
   GlBindTexture(GL_TEXTURE_2D, texture);
   GlEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
 
-  src = std::make_unique<uint8_t[]>(plane_datas[0].stride * size.height());
-
-  GLenum gl_format = GL_BGRA;
-  switch (format) {
-    case SPA_VIDEO_FORMAT_RGBx:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_RGBA:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_BGRx:
-      gl_format = GL_BGRA;
-      break;
-    default:
-      gl_format = GL_BGRA;
-      break;
-  }
-  GlGetTexImage(GL_TEXTURE_2D, 0, gl_format, GL_UNSIGNED_BYTE, src.get());
-
-  if (GlGetError()) {
+  // Reading back as BGRA makes the GL implementation swap the channels of
+  // RGB formats, so they don't need to be converted on the CPU afterwards. The
+  // pack row length lets the rows be written with the stride of the frame.
+  GlPixelStorei(GL_PACK_ALIGNMENT, 4);
+  GlPixelStorei(GL_PACK_ROW_LENGTH, stride / 4);
+  GlGetTexImage(GL_TEXTURE_2D, 0, GL_BGRA, GL_UNSIGNED_BYTE, data);
+  const bool success = GlGetError() == GL_NO_ERROR;
+  GlPixelStorei(GL_PACK_ROW_LENGTH, 0);
+  if (!success) {
     RTC_LOG(LS_ERROR) << "Failed to get image from DMA buffer.";
-    return src;
   }
 
   GlDeleteTextures(1, &texture);
   EglDestroyImageKHR(egl_.display, image);
 
-  return src;
+  return success;
 }
 
 RTC_NO_SANITIZE("cfi-icall")
@@ -58,6 +58,9 @@ const char kDrmLib[] = "libdrm.so.2";
 #endif
 
 constexpr int kCursorBpp = 4;
+// One frame being filled from PipeWire, the last one returned by CaptureFrame()
+// and one the consumer may still hold while converting or encoding it.
+constexpr int kFrameQueueLength = 3;
 constexpr int CursorMetaSize(int w, int h) {
   return (sizeof(struct spa_meta_cursor) + sizeof(struct spa_meta_bitmap) +
           w * h * kCursorBpp);
@@ -207,6 +210,8 @@ class SharedScreenCastStreamPrivate {
 
   int64_t modifier_;
   std::unique_ptr<EglDmaBuf> egl_dmabuf_;
+  // Full size DMA-BUF read back, used only when the stream is cropped.
+  std::unique_ptr<DesktopFrame> dmabuf_frame_;
   // List of modifiers we query as supported by the graphics card/driver
   std::vector<uint64_t> modifiers_;
 
@@ -466,7 +471,8 @@ void SharedScreenCastStreamPrivate::OnRenegotiateFormat(void* data, uint64_t) {
   }
 }
 
-SharedScreenCastStreamPrivate::SharedScreenCastStreamPrivate() {}
+SharedScreenCastStreamPrivate::SharedScreenCastStreamPrivate()
+    : queue_(kFrameQueueLength) {}
 
 SharedScreenCastStreamPrivate::~SharedScreenCastStreamPrivate() {
   if (pw_main_loop_) {
@@ -641,8 +647,10 @@ DesktopVector SharedScreenCastStreamPrivate::CaptureCursorPosition() {
 void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
   spa_buffer* spa_buffer = buffer->buffer;
   ScopedBuf map;
-  std::unique_ptr<uint8_t[]> src_unique_ptr;
   uint8_t* src = nullptr;
+  // DMA-BUF planes are read back from the GPU directly into the frame once it
+  // is known where the frame goes.
+  std::vector<EglDmaBuf::PlaneData> plane_datas;
 
   // Try to update the mouse cursor first, because it can be the only
   // information carried by the buffer
@@ -699,7 +707,6 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
       return;
     }
 
-    std::vector<EglDmaBuf::PlaneData> plane_datas;
     for (uint32_t i = 0; i < n_planes; ++i) {
       EglDmaBuf::PlaneData data = {
           static_cast<int32_t>(spa_buffer->datas[i].fd),
@@ -707,32 +714,11 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
           static_cast<uint32_t>(spa_buffer->datas[i].chunk->offset)};
       plane_datas.push_back(data);
     }
-
-    src_unique_ptr = egl_dmabuf_->ImageFromDmaBuf(
-        desktop_size_, spa_video_format_.format, plane_datas, modifier_);
-    if (src_unique_ptr) {
-      src = src_unique_ptr.get();
-    } else {
-      RTC_LOG(LS_ERROR) << "Dropping DMA-BUF modifier: " << modifier_
-                        << " and trying to renegotiate stream parameters";
-
-      if (pw_client_version_ >= kDropSingleModifierMinVersion) {
-        modifiers_.erase(
-            std::remove(modifiers_.begin(), modifiers_.end(), modifier_),
-            modifiers_.end());
-      } else {
-        modifiers_.clear();
-      }
-
-      pw_loop_signal_event(pw_thread_loop_get_loop(pw_main_loop_),
-                           renegotiate_);
-      return;
-    }
   } else if (spa_buffer->datas[0].type == SPA_DATA_MemPtr) {
     src = static_cast<uint8_t*>(spa_buffer->datas[0].data);
   }
 
-  if (!src) {
+  if (!src && plane_datas.empty()) {
     return;
   }
   struct spa_meta_region* video_metadata =
@@ -782,19 +768,18 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
                           ? video_metadata->region.position.x
                           : 0;
 
-  uint8_t* updated_src = src + (spa_buffer->datas[0].chunk->stride * y_offset) +
-                         (kBytesPerPixel * x_offset);
-
   webrtc::MutexLock lock(&queue_lock_);
 
-  // Move to the next frame if the current one is being used and shared
-  if (queue_.current_frame() && queue_.current_frame()->IsShared()) {
-    queue_.MoveToNextFrame();
-    if (queue_.current_frame() && queue_.current_frame()->IsShared()) {
+  // Move to the next frame that is not being used, if the current one is
+  // shared.
+  for (int i = 1; queue_.current_frame() && queue_.current_frame()->IsShared();
+       ++i) {
+    if (i == queue_.queue_length()) {
       RTC_LOG(LS_WARNING)
           << "Failed to process PipeWire buffer: no available frame";
       return;
     }
+    queue_.MoveToNextFrame();
   }
 
   if (!queue_.current_frame() ||
@@ -804,6 +789,44 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
     queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(std::move(frame)));
   }
 
+  if (!plane_datas.empty()) {
+    // The GPU converts the pixels to BGRx while reading them back, so there
+    // is nothing left to do on the CPU unless the frame is cropped.
+    DesktopFrame* target = queue_.current_frame();
+    if (video_metadata_use) {
+      if (!dmabuf_frame_ || !dmabuf_frame_->size().equals(desktop_size_)) {
+        dmabuf_frame_ = std::make_unique<BasicDesktopFrame>(desktop_size_);
+      }
+      target = dmabuf_frame_.get();
+    }
+    if (!egl_dmabuf_->ImageFromDmaBuf(desktop_size_, spa_video_format_.format,
+                                      plane_datas, modifier_, target->data(),
+                                      target->stride())) {
+      RTC_LOG(LS_ERROR) << "Dropping DMA-BUF modifier: " << modifier_
+                        << " and trying to renegotiate stream parameters";
+
+      if (pw_client_version_ >= kDropSingleModifierMinVersion) {
+        modifiers_.erase(
+            std::remove(modifiers_.begin(), modifiers_.end(), modifier_),
+            modifiers_.end());
+      } else {
+        modifiers_.clear();
+      }
+
+      pw_loop_signal_event(pw_thread_loop_get_loop(pw_main_loop_),
+                           renegotiate_);
+      return;
+    }
+    if (video_metadata_use) {
+      queue_.current_frame()->CopyPixelsFrom(
+          *dmabuf_frame_, DesktopVector(x_offset, y_offset),
+          DesktopRect::MakeSize(video_size_));
+    }
+    return;
+  }
+
+  uint8_t* updated_src = src + (spa_buffer->datas[0].chunk->stride * y_offset) +
+                         (kBytesPerPixel * x_offset);
   queue_.current_frame()->CopyPixelsFrom(
       updated_src,
       (spa_buffer->datas[0].chunk->stride - (kBytesPerPixel * x_offset)),
@@ -12,11 +12,13 @@
 #define MODULES_DESKTOP_CAPTURE_SCREEN_CAPTURE_FRAME_QUEUE_H_
 
 #include <memory>
+#include <vector>
 
 // TODO(zijiehe): These headers are not used in this file, but to avoid build
 // break in remoting/host. We should add headers in each individual files.
 #include "modules/desktop_capture/desktop_frame.h"         // Remove
 #include "modules/desktop_capture/shared_desktop_frame.h"  // Remove
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
@@ -30,13 +32,23 @@ namespace webrtc {
 // say, frame dimensions change). The queue records which frames need updating
 // which the caller can query.
 //
-// Frame consumer is expected to never hold more than kQueueLength frames
-// created by this function and it should release the earliest one before trying
-// to capture a new frame (i.e. before MoveToNextFrame() is called).
+// The queue is a ring of `queue_length` frames, two by default. Frame consumer
+// is expected to never hold more than queue_length() frames created by this
+// function and it should release the earliest one before trying to capture a
+// new frame (i.e. before MoveToNextFrame() is called). Capturers whose
+// consumers keep frames for longer, e.g. until they are converted and encoded
+// on another thread, can use a longer queue to keep reusing the frames instead
+// of dropping or reallocating them.
 template <typename FrameType>
 class ScreenCaptureFrameQueue {
  public:
-  ScreenCaptureFrameQueue() : current_(0) {}
+  static constexpr int kDefaultQueueLength = 2;
+
+  ScreenCaptureFrameQueue() : ScreenCaptureFrameQueue(kDefaultQueueLength) {}
+  explicit ScreenCaptureFrameQueue(int queue_length)
+      : current_(0), frames_(queue_length) {
+    RTC_DCHECK_GE(queue_length, 1);
+  }
   ~ScreenCaptureFrameQueue() = default;
 
   ScreenCaptureFrameQueue(const ScreenCaptureFrameQueue&) = delete;
@@ -44,7 +56,7 @@ class ScreenCaptureFrameQueue {
 
   // Moves to the next frame in the queue, moving the 'current' frame to become
   // the 'previous' one.
-  void MoveToNextFrame() { current_ = (current_ + 1) % kQueueLength; }
+  void MoveToNextFrame() { current_ = (current_ + 1) % queue_length(); }
 
   // Replaces the current frame with a new one allocated by the caller. The
   // existing frame (if any) is destroyed. Takes ownership of `frame`.
@@ -55,8 +67,8 @@ class ScreenCaptureFrameQueue {
   // Marks all frames obsolete and resets the previous frame pointer. No
   // frames are freed though as the caller can still access them.
   void Reset() {
-    for (int i = 0; i < kQueueLength; i++) {
-      frames_[i].reset();
+    for (std::unique_ptr<FrameType>& frame : frames_) {
+      frame.reset();
     }
     current_ = 0;
   }
@@ -64,15 +76,16 @@ class ScreenCaptureFrameQueue {
   FrameType* current_frame() const { return frames_[current_].get(); }
 
   FrameType* previous_frame() const {
-    return frames_[(current_ + kQueueLength - 1) % kQueueLength].get();
+    return frames_[(current_ + queue_length() - 1) % queue_length()].get();
   }
 
+  int queue_length() const { return static_cast<int>(frames_.size()); }
+
  private:
   // Index of the current frame.
   int current_;
 
-  static const int kQueueLength = 2;
-  std::unique_ptr<FrameType> frames_[kQueueLength];
+  std::vector<std::unique_ptr<FrameType>> frames_;
 };
 
 }  // namespace webrtc
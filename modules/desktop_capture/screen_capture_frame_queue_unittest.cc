@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/screen_capture_frame_queue.h"
+
+#include <memory>
+#include <utility>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+std::unique_ptr<SharedDesktopFrame> CreateFrame() {
+  return SharedDesktopFrame::Wrap(
+      std::make_unique<BasicDesktopFrame>(DesktopSize(16, 16)));
+}
+
+}  // namespace
+
+TEST(ScreenCaptureFrameQueueTest, DefaultQueueHasTwoFrames) {
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue;
+  EXPECT_EQ(queue.queue_length(), 2);
+
+  queue.ReplaceCurrentFrame(CreateFrame());
+  SharedDesktopFrame* first = queue.current_frame();
+  queue.MoveToNextFrame();
+  EXPECT_EQ(queue.current_frame(), nullptr);
+  EXPECT_EQ(queue.previous_frame(), first);
+  queue.ReplaceCurrentFrame(CreateFrame());
+  SharedDesktopFrame* second = queue.current_frame();
+  queue.MoveToNextFrame();
+  EXPECT_EQ(queue.current_frame(), first);
+  EXPECT_EQ(queue.previous_frame(), second);
+}
+
+TEST(ScreenCaptureFrameQueueTest, ReusesFramesOfLongerQueue) {
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue(3);
+  EXPECT_EQ(queue.queue_length(), 3);
+
+  SharedDesktopFrame* frames[3];
+  for (SharedDesktopFrame*& frame : frames) {
+    queue.ReplaceCurrentFrame(CreateFrame());
+    frame = queue.current_frame();
+    queue.MoveToNextFrame();
+  }
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(queue.current_frame(), frames[i]);
+      EXPECT_EQ(queue.previous_frame(), frames[(i + 2) % 3]);
+      queue.MoveToNextFrame();
+    }
+  }
+}
+
+TEST(ScreenCaptureFrameQueueTest, ResetDropsAllFrames) {
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue(3);
+  for (int i = 0; i < 3; ++i) {
+    queue.ReplaceCurrentFrame(CreateFrame());
+    queue.MoveToNextFrame();
+  }
+  queue.MoveToNextFrame();
+  queue.Reset();
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(queue.current_frame(), nullptr);
+    queue.MoveToNextFrame();
+  }
+}
+
+}  // namespace webrtc
@@ -177,7 +177,8 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
   if (error.Error() == S_OK && frame_info.AccumulatedFrames > 0 && resource) {
     DetectUpdatedRegion(frame_info, &context->updated_region);
     SpreadContextChange(context);
-    if (!texture_->CopyFrom(frame_info, resource.Get())) {
+    if (!texture_->CopyFrom(frame_info, resource.Get(),
+                            GetUnrotatedRegion(context->updated_region))) {
       return false;
     }
     updated_region.AddRegion(context->updated_region);
@@ -247,6 +248,19 @@ DesktopRect DxgiOutputDuplicator::GetUntranslatedDesktopRect() const {
   return DesktopRect::MakeSize(desktop_size());
 }
 
+DesktopRegion DxgiOutputDuplicator::GetUnrotatedRegion(
+    const DesktopRegion& region) const {
+  if (rotation_ == Rotation::CLOCK_WISE_0) {
+    return region;
+  }
+  DesktopRegion result;
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    result.AddRect(
+        RotateRect(it.rect(), desktop_size(), ReverseRotation(rotation_)));
+  }
+  return result;
+}
+
 void DxgiOutputDuplicator::DetectUpdatedRegion(
     const DXGI_OUTDUPL_FRAME_INFO& frame_info,
     DesktopRegion* updated_region) {
@@ -92,6 +92,10 @@ class DxgiOutputDuplicator {
   bool DoDetectUpdatedRegion(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
                              DesktopRegion* updated_region);
 
+  // Rotates `region`, which is in the coordinates of the desktop, back to the
+  // coordinates of the texture returned by Windows APIs.
+  DesktopRegion GetUnrotatedRegion(const DesktopRegion& region) const;
+
   bool ReleaseFrame();
 
   // Initializes duplication_ instance. Expects duplication_ is in empty status.
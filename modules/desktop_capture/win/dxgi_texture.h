@@ -18,11 +18,10 @@
 
 #include "modules/desktop_capture/desktop_frame.h"
 #include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
 
 namespace webrtc {
 
-class DesktopRegion;
-
 // A texture copied or mapped from a DXGI_OUTDUPL_FRAME_INFO and IDXGIResource.
 class DxgiTexture {
  public:
@@ -33,9 +32,13 @@ class DxgiTexture {
   virtual ~DxgiTexture();
 
   // Copies selected regions of a frame represented by frame_info and resource.
-  // Returns false if anything wrong.
+  // `updated_region` is the region of the texture that has changed since the
+  // last CopyFrom() call, in the coordinates of the texture, i.e. before
+  // rotation. Implementations may copy only this region if they still hold the
+  // rest of the previous frame. Returns false if anything wrong.
   bool CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                IDXGIResource* resource);
+                IDXGIResource* resource,
+                const DesktopRegion& updated_region);
 
   const DesktopSize& desktop_size() const { return desktop_size_; }
 
@@ -58,7 +61,8 @@ class DxgiTexture {
   DXGI_MAPPED_RECT* rect();
 
   virtual bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                               ID3D11Texture2D* texture) = 0;
+                               ID3D11Texture2D* texture,
+                               const DesktopRegion& updated_region) = 0;
 
   virtual bool DoRelease() = 0;
 
@@ -58,6 +58,7 @@ bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture) {
     // ID3D11Texture2D instance.
     stage_.Reset();
     surface_.Reset();
+    stage_has_frame_ = false;
   } else {
     RTC_DCHECK(!surface_);
   }
@@ -92,7 +93,8 @@ void DxgiTextureStaging::AssertStageAndSurfaceAreSameObject() {
 
 bool DxgiTextureStaging::CopyFromTexture(
     const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-    ID3D11Texture2D* texture) {
+    ID3D11Texture2D* texture,
+    const DesktopRegion& updated_region) {
   RTC_DCHECK_GT(frame_info.AccumulatedFrames, 0);
   RTC_DCHECK(texture);
 
@@ -102,8 +104,33 @@ bool DxgiTextureStaging::CopyFromTexture(
     return false;
   }
 
-  device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
-                                  static_cast<ID3D11Resource*>(texture));
+  if (stage_has_frame_) {
+    // The rest of stage_ is unchanged since the last frame, so only the
+    // updated region needs to be read back from the GPU.
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      DesktopRect updated_rect = it.rect();
+      updated_rect.IntersectWith(DesktopRect::MakeSize(desktop_size()));
+      if (updated_rect.is_empty()) {
+        continue;
+      }
+      D3D11_BOX box;
+      box.left = updated_rect.left();
+      box.top = updated_rect.top();
+      box.front = 0;
+      box.right = updated_rect.right();
+      box.bottom = updated_rect.bottom();
+      box.back = 1;
+      device_.context()->CopySubresourceRegion(
+          static_cast<ID3D11Resource*>(stage_.Get()), 0, updated_rect.left(),
+          updated_rect.top(), 0, static_cast<ID3D11Resource*>(texture), 0,
+          &box);
+    }
+  } else {
+    device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
+                                    static_cast<ID3D11Resource*>(texture));
+    stage_has_frame_ = true;
+  }
 
   *rect() = {0};
   _com_error error = surface_->Map(rect(), DXGI_MAP_READ);
@@ -122,6 +149,7 @@ bool DxgiTextureStaging::DoRelease() {
   if (error.Error() != S_OK) {
     stage_.Reset();
     surface_.Reset();
+    stage_has_frame_ = false;
   }
   // If using staging mode, we only need to recreate ID3D11Texture2D instance.
   // This will happen during next CopyFrom call. So this function always returns
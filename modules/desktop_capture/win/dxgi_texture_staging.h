@@ -39,9 +39,11 @@ class DxgiTextureStaging : public DxgiTexture {
 
  protected:
   // Copies selected regions of a frame represented by frame_info and texture.
-  // Returns false if anything wrong.
+  // Once stage_ holds a complete frame, only `updated_region` is copied from
+  // the GPU. Returns false if anything wrong.
   bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                       ID3D11Texture2D* texture) override;
+                       ID3D11Texture2D* texture,
+                       const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -61,6 +63,9 @@ class DxgiTextureStaging : public DxgiTexture {
   const D3dDevice device_;
   Microsoft::WRL::ComPtr<ID3D11Texture2D> stage_;
   Microsoft::WRL::ComPtr<IDXGISurface> surface_;
+  // Whether stage_ holds the complete previous frame, so that only the updated
+  // region needs to be copied into it.
+  bool stage_has_frame_ = false;
 };
 
 }  // namespace webrtc
@@ -26,7 +26,7 @@
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
-#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/pacing/packet_queue_interface.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -59,6 +59,9 @@ class PacingController {
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() = 0;
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
         DataSize size) = 0;
+    // Called after the last packet of a burst of packets has been passed to
+    // SendPacket(), allowing the sender to flush batched packets.
+    virtual void OnBatchComplete() {}
   };
 
   // Expected max pacer delay. If ExpectedQueueTime() is higher than
@@ -133,6 +136,16 @@ class PacingController {
 
   void SetQueueTimeLimit(TimeDelta limit);
 
+  // Sets the burst interval used in dynamic mode. Once the media debt has
+  // been drained, a ProcessPackets() call sends every packet that the pacing
+  // rate allows within the next `burst_interval` in one go, and
+  // NextSendTime() then returns the time at which that burst has been paid
+  // off, rather than the send time of the next packet. This trades a slightly burstier output for one wake-up per burst
+  // instead of one per packet. Zero, the default, paces every packet on its
+  // own. Has no effect on probes or on unpaced audio.
+  void SetSendBurstInterval(TimeDelta burst_interval);
+  TimeDelta send_burst_interval() const { return send_burst_interval_; }
+
   // Enable bitrate probing. Enabled by default, mostly here to simplify
   // testing. Must be called before any packets are being sent to have an
   // effect.
@@ -188,6 +201,7 @@ class PacingController {
   const TimeDelta padding_target_duration_;
 
   TimeDelta min_packet_limit_;
+  TimeDelta send_burst_interval_;
 
   DataSize transport_overhead_per_packet_;
 
@@ -223,7 +237,7 @@ class PacingController {
   Timestamp last_send_time_;
   absl::optional<Timestamp> first_sent_packet_time_;
 
-  RoundRobinPacketQueue packet_queue_;
+  const std::unique_ptr<PacketQueueInterface> packet_queue_;
   uint64_t packet_counter_;
 
   DataSize congestion_window_size_;
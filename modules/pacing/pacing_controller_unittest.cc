@@ -122,6 +122,7 @@ class MockPacketSender : public PacingController::PacketSender {
               GeneratePadding,
               (DataSize target_size),
               (override));
+  MOCK_METHOD(void, OnBatchComplete, (), (override));
 };
 
 class PacingControllerPadding : public PacingController::PacketSender {
@@ -1737,6 +1738,28 @@ TEST_P(PacingControllerTest, OwnedPacketPrioritizedOnType) {
   }
 }
 
+TEST_P(PacingControllerTest, SignalsBatchCompleteAfterSendingPackets) {
+  ::testing::NiceMock<MockPacketSender> callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  Init();
+
+  // Nothing to send, so no batch either.
+  EXPECT_CALL(callback, OnBatchComplete).Times(0);
+  pacer_->ProcessPackets();
+  ::testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // Audio is not paced, so both packets go out in the same process call in
+  // both processing modes.
+  pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketMediaType::kAudio));
+  pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketMediaType::kVideo));
+
+  ::testing::InSequence seq;
+  EXPECT_CALL(callback, SendPacket).Times(2);
+  EXPECT_CALL(callback, OnBatchComplete).Times(1);
+  pacer_->ProcessPackets();
+}
+
 TEST_P(PacingControllerTest, SmallFirstProbePacket) {
   MockPacketSender callback;
   pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
@@ -2167,6 +2190,59 @@ TEST_P(PacingControllerTest, GapInPacingDoesntAccumulateBudget) {
   pacer_->ProcessPackets();
 }
 
+TEST_P(PacingControllerTest, SendsInBurstsAtPacingRate) {
+  if (PeriodicProcess()) {
+    // This test checks behavior when not using interval budget.
+    return;
+  }
+
+  ::testing::NiceMock<MockPacketSender> callback;
+  pacer_ = std::make_unique<PacingController>(&clock_, &callback, nullptr,
+                                              nullptr, GetParam());
+  Init();
+
+  // One packet per ms, so a 10 ms burst interval allows 11 packets per burst.
+  const DataSize kPacketSize = DataSize::Bytes(1000);
+  const DataRate kPacingRate = kPacketSize / TimeDelta::Millis(1);
+  const TimeDelta kBurstInterval = TimeDelta::Millis(10);
+  const TimeDelta kDuration = TimeDelta::Seconds(1);
+  pacer_->SetPacingRates(kPacingRate, DataRate::Zero());
+  pacer_->SetSendBurstInterval(kBurstInterval);
+
+  // Queue more than can be sent in `kDuration`, so that the queue never runs
+  // empty.
+  const int kNumPackets = 1.5 * (kPacingRate * kDuration / kPacketSize);
+  for (int i = 0; i < kNumPackets; ++i) {
+    pacer_->EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kVideoSsrc,
+                                      i, clock_.TimeInMilliseconds(),
+                                      kPacketSize.bytes()));
+  }
+
+  int packets_sent = 0;
+  int batches = 0;
+  EXPECT_CALL(callback, SendPacket)
+      .WillRepeatedly(::testing::InvokeWithoutArgs([&] { ++packets_sent; }));
+  EXPECT_CALL(callback, OnBatchComplete)
+      .WillRepeatedly(::testing::InvokeWithoutArgs([&] { ++batches; }));
+
+  const Timestamp start_time = clock_.CurrentTime();
+  int process_calls = 0;
+  while (clock_.CurrentTime() - start_time < kDuration) {
+    AdvanceTimeAndProcess();
+    ++process_calls;
+  }
+
+  // Bursting must not change the average rate by more than one burst.
+  const DataSize data_sent = packets_sent * kPacketSize;
+  const TimeDelta elapsed_time = clock_.CurrentTime() - start_time;
+  EXPECT_NEAR(data_sent.bytes(), (kPacingRate * elapsed_time).bytes(),
+              (kPacingRate * kBurstInterval + kPacketSize).bytes());
+  // Each process call sends one burst, handed over as one batch, instead of
+  // one call per packet.
+  EXPECT_LE(process_calls, kDuration / kBurstInterval + 1);
+  EXPECT_EQ(batches, process_calls);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WithAndWithoutIntervalBudget,
     PacingControllerTest,
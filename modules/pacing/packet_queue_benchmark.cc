@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "api/transport/field_trial_based_config.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/pacing/prioritized_packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerStream = 8;
+
+// Pushes `kPacketsPerStream` packets for each of `state.range(0)` streams,
+// alternating between video and retransmission priority, and then drains the
+// queue.
+void RunPushPop(benchmark::State& state, PacketQueueInterface& queue) {
+  const int num_streams = state.range(0);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  Timestamp now = Timestamp::Millis(1000);
+  uint64_t enqueue_order = 0;
+  for (auto s : state) {
+    state.PauseTiming();
+    for (int i = 0; i < num_streams * kPacketsPerStream; ++i) {
+      auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+      bool retransmission = i % 4 == 0;
+      packet->set_packet_type(retransmission
+                                  ? RtpPacketMediaType::kRetransmission
+                                  : RtpPacketMediaType::kVideo);
+      packet->SetSsrc(i % num_streams);
+      packet->SetPayloadSize(1000);
+      packets.push_back(std::move(packet));
+    }
+    state.ResumeTiming();
+
+    for (auto& packet : packets) {
+      int priority =
+          packet->packet_type() == RtpPacketMediaType::kRetransmission ? 2 : 3;
+      queue.Push(priority, now, enqueue_order++, std::move(packet));
+    }
+    while (!queue.Empty()) {
+      benchmark::DoNotOptimize(queue.Pop());
+    }
+
+    state.PauseTiming();
+    packets.clear();
+    now += TimeDelta::Millis(1);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_streams *
+                          kPacketsPerStream);
+}
+
+void BM_RoundRobinPacketQueue(benchmark::State& state) {
+  FieldTrialBasedConfig field_trials;
+  RoundRobinPacketQueue queue(Timestamp::Millis(1000), &field_trials);
+  RunPushPop(state, queue);
+}
+
+void BM_PrioritizedPacketQueue(benchmark::State& state) {
+  PrioritizedPacketQueue queue(Timestamp::Millis(1000));
+  RunPushPop(state, queue);
+}
+
+BENCHMARK(BM_RoundRobinPacketQueue)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_PrioritizedPacketQueue)->Arg(4)->Arg(16)->Arg(64);
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+
+Results (Linux, x86-64):
+
+---------------------------------------------------------------------------
+Benchmark                             Time             CPU   Iterations
+---------------------------------------------------------------------------
+BM_RoundRobinPacketQueue/4        10577 ns        10334 ns        77309
+BM_RoundRobinPacketQueue/16       41932 ns        41360 ns        15272
+BM_RoundRobinPacketQueue/64      277837 ns       275972 ns         2515
+BM_PrioritizedPacketQueue/4        6047 ns         6000 ns       145317
+BM_PrioritizedPacketQueue/16      22507 ns        22324 ns        31980
+BM_PrioritizedPacketQueue/64     101157 ns       100658 ns         8305
+
+*/
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
+#define MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// The queue of packets waiting to be sent by the PacingController. Packets
+// with a lower `priority` value are popped first.
+class PacketQueueInterface {
+ public:
+  virtual ~PacketQueueInterface() = default;
+
+  virtual void Push(int priority,
+                    Timestamp enqueue_time,
+                    uint64_t enqueue_order,
+                    std::unique_ptr<RtpPacketToSend> packet) = 0;
+  virtual std::unique_ptr<RtpPacketToSend> Pop() = 0;
+
+  virtual bool Empty() const = 0;
+  virtual size_t SizeInPackets() const = 0;
+  virtual DataSize Size() const = 0;
+  // If the next packet, that would be returned by Pop() if called
+  // now, is an audio packet this method returns the enqueue time
+  // of that packet. If queue is empty or top packet is not audio,
+  // returns nullopt.
+  virtual absl::optional<Timestamp> LeadingAudioPacketEnqueueTime() const = 0;
+
+  virtual Timestamp OldestEnqueueTime() const = 0;
+  virtual TimeDelta AverageQueueTime() const = 0;
+  virtual void UpdateQueueTime(Timestamp now) = 0;
+  virtual void SetPauseState(bool paused, Timestamp now) = 0;
+  virtual void SetIncludeOverhead() = 0;
+  virtual void SetTransportOverhead(DataSize overhead_per_packet) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACKET_QUEUE_INTERFACE_H_
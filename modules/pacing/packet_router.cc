@@ -16,6 +16,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
@@ -106,6 +107,11 @@ void PacketRouter::RemoveSendRtpModule(RtpRtcpInterface* rtp_module) {
   if (last_send_module_ == rtp_module) {
     last_send_module_ = nullptr;
   }
+  auto batch_it = absl::c_find(modules_used_in_current_batch_, rtp_module);
+  if (batch_it != modules_used_in_current_batch_.end()) {
+    modules_used_in_current_batch_.erase(batch_it);
+    rtp_module->OnBatchComplete();
+  }
   rtp_module->OnPacketSendingThreadSwitched();
 }
 
@@ -168,6 +174,10 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
     last_send_module_ = rtp_module;
   }
 
+  if (!absl::c_linear_search(modules_used_in_current_batch_, rtp_module)) {
+    modules_used_in_current_batch_.push_back(rtp_module);
+  }
+
   for (auto& packet : rtp_module->FetchFecPackets()) {
     pending_fec_packets_.push_back(std::move(packet));
   }
@@ -181,6 +191,14 @@ std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::FetchFec() {
   return fec_packets;
 }
 
+void PacketRouter::OnBatchComplete() {
+  MutexLock lock(&modules_mutex_);
+  for (RtpRtcpInterface* rtp_module : modules_used_in_current_batch_) {
+    rtp_module->OnBatchComplete();
+  }
+  modules_used_in_current_batch_.clear();
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::GeneratePadding(
     DataSize size) {
   TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("webrtc"),
@@ -16,7 +16,6 @@
 
 #include <list>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -25,6 +24,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/containers/uint32_hash_map.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -58,6 +58,7 @@ class PacketRouter : public PacingController::PacketSender {
   std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override;
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override;
+  void OnBatchComplete() override;
 
   uint16_t CurrentTransportSequenceNumber() const;
 
@@ -84,12 +85,15 @@ class PacketRouter : public PacingController::PacketSender {
 
   mutable Mutex modules_mutex_;
   // Ssrc to RtpRtcpInterface module;
-  std::unordered_map<uint32_t, RtpRtcpInterface*> send_modules_map_
+  Uint32HashMap<RtpRtcpInterface*> send_modules_map_
       RTC_GUARDED_BY(modules_mutex_);
   std::list<RtpRtcpInterface*> send_modules_list_
       RTC_GUARDED_BY(modules_mutex_);
   // The last module used to send media.
   RtpRtcpInterface* last_send_module_ RTC_GUARDED_BY(modules_mutex_);
+  // Modules that have sent packets since the last OnBatchComplete().
+  std::vector<RtpRtcpInterface*> modules_used_in_current_batch_
+      RTC_GUARDED_BY(modules_mutex_);
   // Rtcp modules of the rtp receivers.
   std::vector<RtcpFeedbackSenderInterface*> rtcp_feedback_senders_
       RTC_GUARDED_BY(modules_mutex_);
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/packet_router.h"
+#include "modules/rtp_rtcp/mocks/mock_rtp_rtcp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gmock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPacketsPerBatch = 10;
+
+// Overrides the methods used per packet without gmock, whose bookkeeping
+// would otherwise dominate the measurement.
+class FakeRtpModule : public ::testing::NiceMock<MockRtpRtcpInterface> {
+ public:
+  explicit FakeRtpModule(uint32_t ssrc) : ssrc_(ssrc) {}
+
+  uint32_t SSRC() const override { return ssrc_; }
+  absl::optional<uint32_t> RtxSsrc() const override { return absl::nullopt; }
+  absl::optional<uint32_t> FlexfecSsrc() const override {
+    return absl::nullopt;
+  }
+  bool IsAudioConfigured() const override { return false; }
+  bool SupportsRtxPayloadPadding() const override { return true; }
+  bool TrySendPacket(RtpPacketToSend* packet,
+                     const PacedPacketInfo& pacing_info) override {
+    benchmark::DoNotOptimize(packet);
+    return true;
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> FetchFecPackets() override {
+    return {};
+  }
+  void OnBatchComplete() override {}
+  void OnPacketSendingThreadSwitched() override {}
+
+ private:
+  const uint32_t ssrc_;
+};
+
+// Routes packets of `state.range(0)` send modules, one SSRC each, in batches
+// of `kPacketsPerBatch` packets of different SSRCs, as a pacer with many
+// streams does.
+void BM_PacketRouterSendPacket(benchmark::State& state) {
+  const int num_ssrcs = state.range(0);
+  std::vector<std::unique_ptr<FakeRtpModule>> modules;
+  PacketRouter packet_router;
+  for (int i = 0; i < num_ssrcs; ++i) {
+    // Spread out like random SSRCs.
+    modules.push_back(std::make_unique<FakeRtpModule>(0x9E3779B9u * (i + 1)));
+    packet_router.AddSendRtpModule(modules.back().get(),
+                                   /*remb_candidate=*/false);
+  }
+
+  // Includes the cost of creating the packets, which SendPacket() destroys.
+  int next_module = 0;
+  for (auto s : state) {
+    for (int i = 0; i < kPacketsPerBatch; ++i) {
+      auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+      packet->SetSsrc(modules[next_module]->SSRC());
+      next_module = (next_module + 1) % num_ssrcs;
+      packet_router.SendPacket(std::move(packet), PacedPacketInfo());
+    }
+    packet_router.OnBatchComplete();
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerBatch);
+
+  for (const std::unique_ptr<FakeRtpModule>& module : modules)
+    packet_router.RemoveSendRtpModule(module.get());
+}
+
+BENCHMARK(BM_PacketRouterSendPacket)->Arg(1)->Arg(100);
+
+}  // namespace
+}  // namespace webrtc
+
+/*
+
+Results:
+
+Medians of 5 repetitions, time per batch of 10 packets, including creating
+and destroying the packets.
+---------------------------------------------------------------------
+Benchmark                             Locked       Unlocked (reference)
+---------------------------------------------------------------------
+BM_PacketRouterSendPacket/1           869 ns       717 ns
+BM_PacketRouterSendPacket/100         862 ns       728 ns
+
+The SSRC lookup costs the same for 1 and for 100 SSRCs. "Unlocked" removes
+the MutexLock from SendPacket() and is not a valid configuration: the mutex
+also guarantees that no packet is sent on a module after
+RemoveSendRtpModule() has returned, and protects the batch, FEC and padding
+state that SendPacket() updates. The uncontended lock costs about 15 ns per
+packet.
+
+*/
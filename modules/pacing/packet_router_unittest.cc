@@ -183,6 +183,37 @@ TEST_F(PacketRouterTest, GeneratePaddingPrioritizesVideo) {
   packet_router_.RemoveSendRtpModule(&audio_module);
 }
 
+TEST_F(PacketRouterTest, OnBatchCompleteSignalsModulesUsedInBatch) {
+  const uint32_t kSsrc1 = 1234;
+  const uint32_t kSsrc2 = 4567;
+
+  NiceMock<MockRtpRtcpInterface> rtp_1;
+  EXPECT_CALL(rtp_1, SSRC()).WillRepeatedly(Return(kSsrc1));
+  EXPECT_CALL(rtp_1, TrySendPacket).WillRepeatedly(Return(true));
+  NiceMock<MockRtpRtcpInterface> rtp_2;
+  EXPECT_CALL(rtp_2, SSRC()).WillRepeatedly(Return(kSsrc2));
+  EXPECT_CALL(rtp_2, TrySendPacket).WillRepeatedly(Return(true));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+
+  // Only the module that sent packets is told the batch is complete, once.
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(1);
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+  ::testing::Mock::VerifyAndClearExpectations(&rtp_1);
+  ::testing::Mock::VerifyAndClearExpectations(&rtp_2);
+
+  // A new batch starts empty.
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(0);
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+}
+
 TEST_F(PacketRouterTest, PadsOnLastActiveMediaStream) {
   const uint16_t kSsrc1 = 1234;
   const uint16_t kSsrc2 = 4567;
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/prioritized_packet_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+PrioritizedPacketQueue::PrioritizedPacketQueue(Timestamp start_time)
+    : transport_overhead_per_packet_(DataSize::Zero()),
+      time_last_updated_(start_time),
+      paused_(false),
+      include_overhead_(false),
+      queue_time_sum_(TimeDelta::Zero()),
+      pause_time_sum_(TimeDelta::Zero()),
+      size_packets_(0),
+      payload_size_(DataSize::Zero()),
+      headers_size_(DataSize::Zero()) {}
+
+PrioritizedPacketQueue::~PrioritizedPacketQueue() = default;
+
+void PrioritizedPacketQueue::Push(int priority,
+                                  Timestamp enqueue_time,
+                                  uint64_t enqueue_order,
+                                  std::unique_ptr<RtpPacketToSend> packet) {
+  RTC_DCHECK(packet->packet_type().has_value());
+  RTC_DCHECK_GE(priority, 0);
+  RTC_DCHECK_LT(priority, kNumPriorityLevels);
+  priority = std::min(std::max(priority, 0), kNumPriorityLevels - 1);
+
+  std::unique_ptr<StreamQueue>& stream = streams_[packet->Ssrc()];
+  if (!stream) {
+    stream = std::make_unique<StreamQueue>();
+  }
+  std::deque<QueuedPacket>& fifo = stream->packets[priority];
+  if (fifo.empty()) {
+    streams_by_priority_[priority].push_back(stream.get());
+  }
+
+  // In order to figure out how much time a packet has spent in the queue
+  // while not in a paused state, we subtract the total amount of time the
+  // queue has been paused so far, and when the packet is popped we subtract
+  // the total amount of time the queue has been paused at that moment.
+  UpdateQueueTime(enqueue_time);
+  payload_size_ +=
+      DataSize::Bytes(packet->payload_size() + packet->padding_size());
+  headers_size_ += DataSize::Bytes(packet->headers_size());
+  ++size_packets_;
+
+  // Enqueue times are normally increasing, so this is an append.
+  enqueue_times_.insert(
+      std::upper_bound(enqueue_times_.begin(), enqueue_times_.end(),
+                       enqueue_time),
+      enqueue_time);
+  fifo.push_back(QueuedPacket{std::move(packet), enqueue_time,
+                              enqueue_time - pause_time_sum_});
+}
+
+std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::Pop() {
+  int level = TopPriorityLevel();
+  if (level < 0) {
+    return nullptr;
+  }
+
+  std::deque<StreamQueue*>& streams = streams_by_priority_[level];
+  StreamQueue* stream = streams.front();
+  streams.pop_front();
+  std::deque<QueuedPacket>& fifo = stream->packets[level];
+  QueuedPacket queued_packet = std::move(fifo.front());
+  fifo.pop_front();
+  if (!fifo.empty()) {
+    // Let the other streams at this level go first.
+    streams.push_back(stream);
+  }
+
+  TimeDelta time_in_non_paused_state =
+      time_last_updated_ - queued_packet.adjusted_enqueue_time -
+      pause_time_sum_;
+  queue_time_sum_ -= time_in_non_paused_state;
+
+  auto time_it =
+      std::lower_bound(enqueue_times_.begin(), enqueue_times_.end(),
+                       queued_packet.enqueue_time);
+  RTC_CHECK(time_it != enqueue_times_.end());
+  enqueue_times_.erase(time_it);
+
+  const RtpPacketToSend& packet = *queued_packet.packet;
+  payload_size_ -=
+      DataSize::Bytes(packet.payload_size() + packet.padding_size());
+  headers_size_ -= DataSize::Bytes(packet.headers_size());
+  --size_packets_;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
+
+  return std::move(queued_packet.packet);
+}
+
+bool PrioritizedPacketQueue::Empty() const {
+  return size_packets_ == 0;
+}
+
+size_t PrioritizedPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+DataSize PrioritizedPacketQueue::Size() const {
+  if (!include_overhead_) {
+    return payload_size_;
+  }
+  return payload_size_ + headers_size_ +
+         static_cast<int64_t>(size_packets_) * transport_overhead_per_packet_;
+}
+
+absl::optional<Timestamp>
+PrioritizedPacketQueue::LeadingAudioPacketEnqueueTime() const {
+  int level = TopPriorityLevel();
+  if (level < 0) {
+    return absl::nullopt;
+  }
+  const QueuedPacket& top_packet =
+      streams_by_priority_[level].front()->packets[level].front();
+  if (top_packet.packet->packet_type() == RtpPacketMediaType::kAudio) {
+    return top_packet.adjusted_enqueue_time;
+  }
+  return absl::nullopt;
+}
+
+Timestamp PrioritizedPacketQueue::OldestEnqueueTime() const {
+  if (Empty()) {
+    return Timestamp::MinusInfinity();
+  }
+  RTC_CHECK(!enqueue_times_.empty());
+  return enqueue_times_.front();
+}
+
+TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
+  if (Empty()) {
+    return TimeDelta::Zero();
+  }
+  return queue_time_sum_ / size_packets_;
+}
+
+void PrioritizedPacketQueue::UpdateQueueTime(Timestamp now) {
+  RTC_CHECK_GE(now, time_last_updated_);
+  if (now == time_last_updated_) {
+    return;
+  }
+
+  TimeDelta delta = now - time_last_updated_;
+  if (paused_) {
+    pause_time_sum_ += delta;
+  } else {
+    queue_time_sum_ += TimeDelta::Micros(delta.us() * size_packets_);
+  }
+  time_last_updated_ = now;
+}
+
+void PrioritizedPacketQueue::SetPauseState(bool paused, Timestamp now) {
+  if (paused_ == paused) {
+    return;
+  }
+  UpdateQueueTime(now);
+  paused_ = paused;
+}
+
+void PrioritizedPacketQueue::SetIncludeOverhead() {
+  include_overhead_ = true;
+}
+
+void PrioritizedPacketQueue::SetTransportOverhead(
+    DataSize overhead_per_packet) {
+  transport_overhead_per_packet_ = overhead_per_packet;
+}
+
+int PrioritizedPacketQueue::TopPriorityLevel() const {
+  for (int level = 0; level < kNumPriorityLevels; ++level) {
+    if (!streams_by_priority_[level].empty()) {
+      return level;
+    }
+  }
+  return -1;
+}
+
+}  // namespace webrtc
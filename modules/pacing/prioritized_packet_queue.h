@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PRIORITIZED_PACKET_QUEUE_H_
+#define MODULES_PACING_PRIORITIZED_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "absl/types/optional.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Packet queue with a fixed number of priority levels. Each SSRC has one FIFO
+// per priority level, and the SSRCs with packets at a given level are served
+// round-robin, one packet at a time. Apart from a binary search in the
+// enqueue time index, Push() and Pop() are constant time, and they only
+// allocate when a FIFO needs another block of storage.
+class PrioritizedPacketQueue : public PacketQueueInterface {
+ public:
+  // Priorities passed to Push() must be in [0, kNumPriorityLevels).
+  static constexpr int kNumPriorityLevels = 5;
+
+  explicit PrioritizedPacketQueue(Timestamp start_time);
+  ~PrioritizedPacketQueue() override;
+
+  PrioritizedPacketQueue(const PrioritizedPacketQueue&) = delete;
+  PrioritizedPacketQueue& operator=(const PrioritizedPacketQueue&) = delete;
+
+  void Push(int priority,
+            Timestamp enqueue_time,
+            uint64_t enqueue_order,
+            std::unique_ptr<RtpPacketToSend> packet) override;
+  std::unique_ptr<RtpPacketToSend> Pop() override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  DataSize Size() const override;
+  absl::optional<Timestamp> LeadingAudioPacketEnqueueTime() const override;
+
+  Timestamp OldestEnqueueTime() const override;
+  TimeDelta AverageQueueTime() const override;
+  void UpdateQueueTime(Timestamp now) override;
+  void SetPauseState(bool paused, Timestamp now) override;
+  void SetIncludeOverhead() override;
+  void SetTransportOverhead(DataSize overhead_per_packet) override;
+
+ private:
+  struct QueuedPacket {
+    std::unique_ptr<RtpPacketToSend> packet;
+    Timestamp enqueue_time;
+    // `enqueue_time` minus the total pause time at the time of enqueuing.
+    Timestamp adjusted_enqueue_time;
+  };
+
+  struct StreamQueue {
+    std::deque<QueuedPacket> packets[kNumPriorityLevels];
+  };
+
+  int TopPriorityLevel() const;
+
+  DataSize transport_overhead_per_packet_;
+  Timestamp time_last_updated_;
+  bool paused_;
+  bool include_overhead_;
+  TimeDelta queue_time_sum_;
+  TimeDelta pause_time_sum_;
+
+  size_t size_packets_;
+  // Sums of payload plus padding, and of header sizes, for all packets.
+  DataSize payload_size_;
+  DataSize headers_size_;
+
+  // Streams are never removed, so pointers into this map stay valid.
+  std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
+  // For each priority level, the streams with at least one packet at that
+  // level, in the order they will be served.
+  std::deque<StreamQueue*> streams_by_priority_[kNumPriorityLevels];
+
+  // The enqueue time of every packet currently in the queue, in increasing
+  // order. Used to figure out the age of the oldest packet in the queue.
+  std::deque<Timestamp> enqueue_times_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PRIORITIZED_PACKET_QUEUE_H_
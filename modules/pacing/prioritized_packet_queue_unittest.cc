@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/prioritized_packet_queue.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kAudioSsrc = 1;
+constexpr uint32_t kVideoSsrc1 = 2;
+constexpr uint32_t kVideoSsrc2 = 3;
+constexpr int kAudioPriority = 1;
+constexpr int kVideoPriority = 3;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(RtpPacketMediaType type,
+                                              uint32_t ssrc,
+                                              uint16_t sequence_number,
+                                              size_t payload_size = 100) {
+  auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetPayloadSize(payload_size);
+  return packet;
+}
+
+}  // namespace
+
+TEST(PrioritizedPacketQueue, ReturnsPacketsInPriorityOrder) {
+  Timestamp now = Timestamp::Millis(1000);
+  PrioritizedPacketQueue queue(now);
+  queue.Push(kVideoPriority, now, 0,
+             CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc1, 1));
+  queue.Push(kAudioPriority, now, 1,
+             CreatePacket(RtpPacketMediaType::kAudio, kAudioSsrc, 2));
+
+  EXPECT_EQ(queue.SizeInPackets(), 2u);
+  EXPECT_EQ(queue.LeadingAudioPacketEnqueueTime(), now);
+  EXPECT_EQ(queue.Pop()->Ssrc(), kAudioSsrc);
+  EXPECT_FALSE(queue.LeadingAudioPacketEnqueueTime().has_value());
+  EXPECT_EQ(queue.Pop()->Ssrc(), kVideoSsrc1);
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Pop(), nullptr);
+}
+
+TEST(PrioritizedPacketQueue, KeepsPerStreamOrderAndRoundRobinsStreams) {
+  Timestamp now = Timestamp::Millis(1000);
+  PrioritizedPacketQueue queue(now);
+  queue.Push(kVideoPriority, now, 0,
+             CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc1, 1));
+  queue.Push(kVideoPriority, now, 1,
+             CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc1, 2));
+  queue.Push(kVideoPriority, now, 2,
+             CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc2, 1));
+
+  std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+  EXPECT_EQ(packet->Ssrc(), kVideoSsrc1);
+  EXPECT_EQ(packet->SequenceNumber(), 1);
+  packet = queue.Pop();
+  EXPECT_EQ(packet->Ssrc(), kVideoSsrc2);
+  packet = queue.Pop();
+  EXPECT_EQ(packet->Ssrc(), kVideoSsrc1);
+  EXPECT_EQ(packet->SequenceNumber(), 2);
+}
+
+TEST(PrioritizedPacketQueue, TracksSizeIncludingOverhead) {
+  Timestamp now = Timestamp::Millis(1000);
+  PrioritizedPacketQueue queue(now);
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc1, 1, 200);
+  const size_t headers_size = packet->headers_size();
+  queue.Push(kVideoPriority, now, 0, std::move(packet));
+  EXPECT_EQ(queue.Size(), DataSize::Bytes(200));
+
+  queue.SetIncludeOverhead();
+  queue.SetTransportOverhead(DataSize::Bytes(28));
+  EXPECT_EQ(queue.Size(), DataSize::Bytes(200 + headers_size + 28));
+
+  queue.Pop();
+  EXPECT_EQ(queue.Size(), DataSize::Zero());
+}
+
+TEST(PrioritizedPacketQueue, TracksQueueTimeExcludingPauses) {
+  Timestamp now = Timestamp::Millis(1000);
+  PrioritizedPacketQueue queue(now);
+  queue.Push(kVideoPriority, now, 0,
+             CreatePacket(RtpPacketMediaType::kVideo, kVideoSsrc1, 1));
+  EXPECT_EQ(queue.OldestEnqueueTime(), now);
+
+  now += TimeDelta::Millis(10);
+  queue.UpdateQueueTime(now);
+  queue.SetPauseState(true, now);
+  now += TimeDelta::Millis(50);
+  queue.SetPauseState(false, now);
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Millis(10));
+
+  queue.Pop();
+  EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Zero());
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+}
+
+}  // namespace webrtc
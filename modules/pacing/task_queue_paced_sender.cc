@@ -28,7 +28,8 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     const WebRtcKeyValueConfig* field_trials,
     TaskQueueFactory* task_queue_factory,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    TimeDelta burst_interval)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
@@ -45,6 +46,7 @@ TaskQueuePacedSender::TaskQueuePacedSender(
           "TaskQueuePacedSender",
           TaskQueueFactory::Priority::NORMAL)) {
   packet_size_.Apply(1, 0);
+  pacing_controller_.SetSendBurstInterval(burst_interval);
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
@@ -43,6 +43,11 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // there is currently a pacer queue and packets can't immediately be
   // processed. Increasing this reduces thread wakeups at the expense of higher
   // latency.
+  // The `burst_interval` parameter makes the pacer send all packets that are
+  // due within that interval in one pass, see
+  // PacingController::SetSendBurstInterval(). The packet sender is told about
+  // the end of each burst through OnBatchComplete(), so that it can hand the
+  // burst to the transport as one batch.
   // TODO(bugs.webrtc.org/10809): Remove default values.
   TaskQueuePacedSender(
       Clock* clock,
@@ -51,7 +56,8 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
       const WebRtcKeyValueConfig* field_trials,
       TaskQueueFactory* task_queue_factory,
       TimeDelta max_hold_back_window = PacingController::kMinSleepTime,
-      int max_hold_back_window_in_packets = -1);
+      int max_hold_back_window_in_packets = -1,
+      TimeDelta burst_interval = TimeDelta::Zero());
 
   ~TaskQueuePacedSender() override;
 
@@ -274,6 +274,43 @@ TEST(TaskQueuePacedSenderTest, SleepsDuringCoalscingWindow) {
   ::testing::Mock::VerifyAndClearExpectations(&packet_router);
 }
 
+TEST(TaskQueuePacedSenderTest, SendsPacketsDueWithinBurstIntervalAtOnce) {
+  const TimeDelta kBurstInterval = TimeDelta::Millis(5);
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  MockPacketRouter packet_router;
+  TaskQueuePacedSender pacer(time_controller.GetClock(), &packet_router,
+                             /*event_log=*/nullptr,
+                             /*field_trials=*/nullptr,
+                             time_controller.GetTaskQueueFactory(),
+                             PacingController::kMinSleepTime,
+                             kNoPacketHoldback, kBurstInterval);
+
+  // Set rates so one packet adds one ms of buffer level.
+  const DataSize kPacketSize = DataSize::Bytes(kDefaultPacketSize);
+  const TimeDelta kPacketPacingTime = TimeDelta::Millis(1);
+  const DataRate kPacingDataRate = kPacketSize / kPacketPacingTime;
+
+  pacer.SetPacingRates(kPacingDataRate, DataRate::Zero());
+  pacer.EnsureStarted();
+
+  // Add 20 packets. The buffers are clear, so a full burst is sent right away:
+  // packets are sent until the buffer level exceeds the burst interval.
+  EXPECT_CALL(packet_router, SendPacket).Times(6);
+  pacer.EnqueuePackets(GeneratePackets(RtpPacketMediaType::kVideo, 20));
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+
+  // Nothing is sent until the buffer level of the first burst is drained.
+  EXPECT_CALL(packet_router, SendPacket).Times(0);
+  time_controller.AdvanceTime(6 * kPacketPacingTime - TimeDelta::Millis(1));
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+
+  // Then the next burst goes out in one pass.
+  EXPECT_CALL(packet_router, SendPacket).Times(6);
+  time_controller.AdvanceTime(TimeDelta::Millis(1));
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+}
+
 TEST(TaskQueuePacedSenderTest, ProbingOverridesCoalescingWindow) {
   const TimeDelta kCoalescingWindow = TimeDelta::Millis(5);
   GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
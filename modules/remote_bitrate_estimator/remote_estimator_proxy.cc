@@ -66,11 +66,26 @@ void RemoteEstimatorProxy::MaybeCullOldPackets(int64_t sequence_number,
 void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
                                           size_t payload_size,
                                           const RTPHeader& header) {
+  MutexLock lock(&lock_);
+  IncomingPacketLocked(arrival_time_ms, payload_size, header);
+}
+
+void RemoteEstimatorProxy::IncomingPackets(
+    rtc::ArrayView<const Packet> packets) {
+  MutexLock lock(&lock_);
+  for (const Packet& packet : packets) {
+    IncomingPacketLocked(packet.arrival_time_ms, packet.payload_size,
+                         *packet.header);
+  }
+}
+
+void RemoteEstimatorProxy::IncomingPacketLocked(int64_t arrival_time_ms,
+                                                size_t payload_size,
+                                                const RTPHeader& header) {
   if (arrival_time_ms < 0 || arrival_time_ms > kMaxTimeMs) {
     RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time_ms;
     return;
   }
-  MutexLock lock(&lock_);
   media_ssrc_ = header.ssrc;
   int64_t seq = 0;
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/transport/network_control.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
@@ -46,9 +47,18 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
                        NetworkStateEstimator* network_state_estimator);
   ~RemoteEstimatorProxy() override;
 
+  struct Packet {
+    int64_t arrival_time_ms;
+    size_t payload_size;
+    const RTPHeader* header;
+  };
+
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // Same as calling IncomingPacket() for each of `packets` in order, but only
+  // takes the lock once.
+  void IncomingPackets(rtc::ArrayView<const Packet> packets);
   void RemoveStream(uint32_t ssrc) override {}
   bool LatestEstimate(std::vector<unsigned int>* ssrcs,
                       unsigned int* bitrate_bps) const override;
@@ -76,6 +86,10 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
     }
   };
 
+  void IncomingPacketLocked(int64_t arrival_time_ms,
+                            size_t payload_size,
+                            const RTPHeader& header)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void MaybeCullOldPackets(int64_t sequence_number, int64_t arrival_time_ms)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
@@ -133,6 +133,36 @@ TEST_F(RemoteEstimatorProxyTest, SendsSinglePacketFeedback) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, SendsFeedbackForPacketBatch) {
+  const RTPHeader headers[] = {
+      CreateHeader(kBaseSeq, absl::nullopt, absl::nullopt),
+      CreateHeader(kBaseSeq + 2, absl::nullopt, absl::nullopt),
+      CreateHeader(kBaseSeq + 1, absl::nullopt, absl::nullopt),
+      CreateHeader(kBaseSeq + 2, absl::nullopt, absl::nullopt)};
+  const RemoteEstimatorProxy::Packet packets[] = {
+      {kBaseTimeMs, kDefaultPacketSize, &headers[0]},
+      {kBaseTimeMs + 2, kDefaultPacketSize, &headers[1]},
+      {kBaseTimeMs + 3, kDefaultPacketSize, &headers[2]},
+      {kBaseTimeMs + 4, kDefaultPacketSize, &headers[3]}};
+  proxy_.IncomingPackets(packets);
+
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce(Invoke(
+          [](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            rtcp::TransportFeedback* feedback_packet =
+                static_cast<rtcp::TransportFeedback*>(
+                    feedback_packets[0].get());
+            EXPECT_EQ(kBaseSeq, feedback_packet->GetBaseSequence());
+            EXPECT_THAT(SequenceNumbers(*feedback_packet),
+                        ElementsAre(kBaseSeq, kBaseSeq + 1, kBaseSeq + 2));
+            EXPECT_THAT(TimestampsMs(*feedback_packet),
+                        ElementsAre(kBaseTimeMs, kBaseTimeMs + 3,
+                                    kBaseTimeMs + 2));
+          }));
+
+  Process();
+}
+
 TEST_F(RemoteEstimatorProxyTest, DuplicatedPackets) {
   IncomingPacket(kBaseSeq, kBaseTimeMs);
   IncomingPacket(kBaseSeq, kBaseTimeMs + 1000);
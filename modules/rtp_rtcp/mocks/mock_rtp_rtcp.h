@@ -97,6 +97,7 @@ class MockRtpRtcpInterface : public RtpRtcpInterface {
               FetchFecPackets,
               (),
               (override));
+  MOCK_METHOD(void, OnBatchComplete, (), (override));
   MOCK_METHOD(void,
               OnPacketsAcknowledged,
               (rtc::ArrayView<const uint16_t>),
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+using FecXorFunction = void (*)(const uint8_t*, uint8_t*, size_t);
+
+FecXorFunction SelectFecXor() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required.
+  if (GetCPUInfo(kAVX2)) {
+    return FecXor_AVX2;
+  }
+  if (GetCPUInfo(kSSE2)) {
+    return FecXor_SSE2;
+  }
+  return FecXor_C;
+#elif defined(WEBRTC_HAS_NEON)
+  return FecXor_NEON;
+#else
+  return FecXor_C;
+#endif
+}
+
+}  // namespace
+
+void FecXor(const uint8_t* src, uint8_t* dst, size_t length) {
+  static const FecXorFunction fec_xor = SelectFecXor();
+  fec_xor(src, dst, length);
+}
+
+void FecXor_C(const uint8_t* src, uint8_t* dst, size_t length) {
+  size_t i = 0;
+  // Word at a time; memcpy keeps unaligned access well defined and compiles
+  // to plain loads and stores.
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t src_word;
+    uint64_t dst_word;
+    memcpy(&src_word, src + i, sizeof(src_word));
+    memcpy(&dst_word, dst + i, sizeof(dst_word));
+    dst_word ^= src_word;
+    memcpy(dst + i, &dst_word, sizeof(dst_word));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+}  // namespace webrtc
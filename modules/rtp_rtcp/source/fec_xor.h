@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// XORs `length` bytes of `src` into `dst`, i.e. dst[i] ^= src[i]. This is the
+// kernel of both ULPFEC and FlexFEC encoding and recovery. The widest SIMD
+// implementation supported by the CPU is picked on first use. The buffers may
+// have any alignment, but must not overlap.
+void FecXor(const uint8_t* src, uint8_t* dst, size_t length);
+
+// Individual implementations, exposed for testing.
+void FecXor_C(const uint8_t* src, uint8_t* dst, size_t length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void FecXor_SSE2(const uint8_t* src, uint8_t* dst, size_t length);
+void FecXor_AVX2(const uint8_t* src, uint8_t* dst, size_t length);
+#elif defined(WEBRTC_HAS_NEON)
+void FecXor_NEON(const uint8_t* src, uint8_t* dst, size_t length);
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
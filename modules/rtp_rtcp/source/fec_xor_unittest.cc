@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+using FecXorFunction = void (*)(const uint8_t*, uint8_t*, size_t);
+
+// Covers all tail lengths of the widest kernel, plus a full size packet.
+constexpr size_t kLengths[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 1188};
+
+void ExpectMatchesReference(FecXorFunction fec_xor) {
+  Random random(0x1234);
+  for (size_t length : kLengths) {
+    // Misalign the buffers in all combinations.
+    for (size_t src_offset = 0; src_offset < 4; ++src_offset) {
+      for (size_t dst_offset = 0; dst_offset < 4; ++dst_offset) {
+        std::vector<uint8_t> src(src_offset + length + 1);
+        std::vector<uint8_t> dst(dst_offset + length + 1);
+        for (uint8_t& byte : src) {
+          byte = random.Rand<uint8_t>();
+        }
+        for (uint8_t& byte : dst) {
+          byte = random.Rand<uint8_t>();
+        }
+        std::vector<uint8_t> expected = dst;
+        for (size_t i = 0; i < length; ++i) {
+          expected[dst_offset + i] ^= src[src_offset + i];
+        }
+
+        fec_xor(src.data() + src_offset, dst.data() + dst_offset, length);
+        // Includes the bytes around the XORed range, which must be intact.
+        EXPECT_EQ(dst, expected) << "length " << length << ", src offset "
+                                 << src_offset << ", dst offset "
+                                 << dst_offset;
+      }
+    }
+  }
+}
+
+TEST(FecXorTest, Default) {
+  ExpectMatchesReference(FecXor);
+}
+
+TEST(FecXorTest, C) {
+  ExpectMatchesReference(FecXor_C);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(FecXorTest, SSE2) {
+  if (!GetCPUInfo(kSSE2)) {
+    return;
+  }
+  ExpectMatchesReference(FecXor_SSE2);
+}
+
+TEST(FecXorTest, AVX2) {
+  if (!GetCPUInfo(kAVX2)) {
+    return;
+  }
+  ExpectMatchesReference(FecXor_AVX2);
+}
+#elif defined(WEBRTC_HAS_NEON)
+TEST(FecXorTest, NEON) {
+  ExpectMatchesReference(FecXor_NEON);
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
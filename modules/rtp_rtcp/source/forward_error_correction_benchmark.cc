@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <iterator>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr uint16_t kStartSeqNum = 1000;
+constexpr uint8_t kProtectionFactor = 85;  // A third, in Q8.
+
+ForwardErrorCorrection::PacketList CreateMediaPackets(int num_packets) {
+  Random random(0x7357);
+  test::fec::MediaPacketGenerator generator(/*min_packet_size=*/1000,
+                                            /*max_packet_size=*/1200, kSsrc,
+                                            &random);
+  return generator.ConstructMediaPackets(num_packets, kStartSeqNum);
+}
+
+// Protects a frame of `state.range(0)` media packets with ULPFEC.
+void BM_UlpfecEncode(benchmark::State& state) {
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets(state.range(0));
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  for (auto s : state) {
+    fec_packets.clear();
+    if (fec->EncodeFec(media_packets, kProtectionFactor,
+                       /*num_important_packets=*/0,
+                       /*use_unequal_protection=*/false, kFecMaskRandom,
+                       &fec_packets) != 0) {
+      state.SkipWithError("Failed to encode FEC.");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * media_packets.size());
+}
+
+BENCHMARK(BM_UlpfecEncode)->Arg(4)->Arg(12)->Arg(48);
+
+ForwardErrorCorrection::ReceivedPacket CreateReceivedPacket(
+    uint16_t seq_num,
+    bool is_fec,
+    const rtc::CopyOnWriteBuffer& data) {
+  ForwardErrorCorrection::ReceivedPacket received;
+  received.ssrc = kSsrc;
+  received.seq_num = seq_num;
+  received.is_fec = is_fec;
+  received.is_recovered = false;
+  received.pkt = new ForwardErrorCorrection::Packet();
+  received.pkt->data = data;
+  return received;
+}
+
+// Recovers the first media packet of a frame of `state.range(0)` packets from
+// the rest of the frame and its FEC packets.
+void BM_UlpfecDecode(benchmark::State& state) {
+  const ForwardErrorCorrection::PacketList media_packets =
+      CreateMediaPackets(state.range(0));
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  fec->EncodeFec(media_packets, kProtectionFactor,
+                 /*num_important_packets=*/0,
+                 /*use_unequal_protection=*/false, kFecMaskRandom,
+                 &fec_packets);
+  // ULPFEC packets follow the media packets of the frame in sequence number.
+  std::vector<std::pair<uint16_t, rtc::CopyOnWriteBuffer>> fec_payloads;
+  uint16_t fec_seq_num = kStartSeqNum + media_packets.size();
+  for (const ForwardErrorCorrection::Packet* packet : fec_packets)
+    fec_payloads.emplace_back(fec_seq_num++, packet->data);
+
+  ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+  for (auto s : state) {
+    // Decoding rewrites the FEC headers in place, so each iteration receives
+    // packets of its own, as the receiver does.
+    for (auto it = std::next(media_packets.begin());
+         it != media_packets.end(); ++it) {
+      fec->DecodeFec(
+          CreateReceivedPacket(
+              ByteReader<uint16_t>::ReadBigEndian((*it)->data.data() + 2),
+              /*is_fec=*/false, (*it)->data),
+          &recovered_packets);
+    }
+    for (const auto& [seq_num, data] : fec_payloads) {
+      fec->DecodeFec(CreateReceivedPacket(seq_num, /*is_fec=*/true, data),
+                     &recovered_packets);
+    }
+    if (recovered_packets.size() != media_packets.size()) {
+      state.SkipWithError("Failed to recover the lost packet.");
+      break;
+    }
+    fec->ResetState(&recovered_packets);
+  }
+  state.SetItemsProcessed(state.iterations() * media_packets.size());
+}
+
+BENCHMARK(BM_UlpfecDecode)->Arg(4)->Arg(12)->Arg(48);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/key_frame_request_aggregator.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr TimeDelta KeyFrameRequestAggregator::kDefaultMinInterval;
+
+KeyFrameRequestAggregator::KeyFrameRequestAggregator(Clock* clock,
+                                                     TimeDelta min_interval)
+    : clock_(clock), min_interval_(min_interval) {
+  RTC_DCHECK(clock_);
+  RTC_DCHECK_GE(min_interval_, TimeDelta::Zero());
+}
+
+KeyFrameRequestAggregator::~KeyFrameRequestAggregator() = default;
+
+bool KeyFrameRequestAggregator::OnKeyFrameRequest(uint32_t ssrc) {
+  Timestamp now = clock_->CurrentTime();
+  MutexLock lock(&mutex_);
+  auto inserted = last_request_.emplace(ssrc, now);
+  if (inserted.second)
+    return true;
+  Timestamp& last_request = inserted.first->second;
+  if (now - last_request < min_interval_)
+    return false;
+  last_request = now;
+  return true;
+}
+
+void KeyFrameRequestAggregator::OnKeyFrameReceived(uint32_t ssrc) {
+  MutexLock lock(&mutex_);
+  last_request_.erase(ssrc);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_KEY_FRAME_REQUEST_AGGREGATOR_H_
+#define MODULES_RTP_RTCP_SOURCE_KEY_FRAME_REQUEST_AGGREGATOR_H_
+
+#include <stdint.h>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/containers/uint32_hash_map.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Deduplicates key frame requests (PLI or FIR) for the same media SSRC that
+// are issued independently, e.g. by all the receivers of a stream forwarded
+// by an SFU when the stream breaks. Once a request has been sent for an SSRC,
+// the requests that follow are dropped, since the key frame sent in response
+// serves them all, until either a key frame is received or `min_interval` has
+// passed without one, in which case the next request is sent as a retry.
+//
+// May be shared by receivers on different threads.
+class KeyFrameRequestAggregator {
+ public:
+  static constexpr TimeDelta kDefaultMinInterval = TimeDelta::Millis(300);
+
+  explicit KeyFrameRequestAggregator(
+      Clock* clock,
+      TimeDelta min_interval = kDefaultMinInterval);
+  KeyFrameRequestAggregator(const KeyFrameRequestAggregator&) = delete;
+  KeyFrameRequestAggregator& operator=(const KeyFrameRequestAggregator&) =
+      delete;
+  ~KeyFrameRequestAggregator();
+
+  // Returns true if a key frame request for `ssrc` should be sent now.
+  bool OnKeyFrameRequest(uint32_t ssrc);
+
+  // Lets the next key frame request for `ssrc` through immediately.
+  void OnKeyFrameReceived(uint32_t ssrc);
+
+ private:
+  Clock* const clock_;
+  const TimeDelta min_interval_;
+
+  Mutex mutex_;
+  // Send time of the outstanding request per SSRC.
+  Uint32HashMap<Timestamp> last_request_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_KEY_FRAME_REQUEST_AGGREGATOR_H_
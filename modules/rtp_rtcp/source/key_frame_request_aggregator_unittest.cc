@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/key_frame_request_aggregator.h"
+
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 1234;
+constexpr uint32_t kOtherSsrc = 5678;
+constexpr TimeDelta kMinInterval = TimeDelta::Millis(300);
+
+TEST(KeyFrameRequestAggregatorTest, DropsRequestsUntilMinIntervalPassed) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  KeyFrameRequestAggregator aggregator(&clock, kMinInterval);
+
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kSsrc));
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+  clock.AdvanceTime(kMinInterval - TimeDelta::Millis(1));
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+
+  // No key frame arrived in time, so the request is retried.
+  clock.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kSsrc));
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+}
+
+TEST(KeyFrameRequestAggregatorTest, KeyFrameLetsNextRequestThrough) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  KeyFrameRequestAggregator aggregator(&clock, kMinInterval);
+
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kSsrc));
+  aggregator.OnKeyFrameReceived(kSsrc);
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kSsrc));
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+}
+
+TEST(KeyFrameRequestAggregatorTest, AggregatesPerSsrc) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  KeyFrameRequestAggregator aggregator(&clock, kMinInterval);
+
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kSsrc));
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kOtherSsrc));
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+
+  aggregator.OnKeyFrameReceived(kOtherSsrc);
+  EXPECT_FALSE(aggregator.OnKeyFrameRequest(kSsrc));
+  EXPECT_TRUE(aggregator.OnKeyFrameRequest(kOtherSsrc));
+}
+
+}  // namespace
+}  // namespace webrtc
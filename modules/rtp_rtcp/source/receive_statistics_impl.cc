@@ -22,6 +22,7 @@
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/rate_statistics.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 
@@ -29,6 +30,7 @@ namespace webrtc {
 namespace {
 constexpr int64_t kStatisticsTimeoutMs = 8000;
 constexpr int64_t kStatisticsProcessIntervalMs = 1000;
+constexpr int64_t kBitrateBucketMs = 10;
 }  // namespace
 
 StreamStatistician::~StreamStatistician() {}
@@ -42,7 +44,8 @@ StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
                                     clock_->TimeInMilliseconds() -
                                     rtc::kNtpJan1970Millisecs),
       incoming_bitrate_(kStatisticsProcessIntervalMs,
-                        RateStatistics::kBpsScale),
+                        RateStatistics::kBpsScale,
+                        kBitrateBucketMs),
       max_reordering_threshold_(max_reordering_threshold),
       enable_retransmit_detection_(false),
       cumulative_loss_is_capped_(false),
@@ -387,4 +390,119 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
   return result;
 }
 
+struct StatisticianLookupTable::Table {
+  struct Slot {
+    std::atomic<uint32_t> ssrc{0};
+    // Written after `ssrc`, so that a reader that sees the statistician also
+    // sees the ssrc. nullptr if the slot is free.
+    std::atomic<StreamStatisticianImplInterface*> statistician{nullptr};
+  };
+
+  explicit Table(size_t capacity) : slots(capacity) {
+    RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+    for (size_t c = capacity; c > 1; c /= 2)
+      --shift;
+  }
+
+  size_t FirstSlot(uint32_t ssrc) const {
+    // Fibonacci hashing, as in Uint32HashMap.
+    return static_cast<uint32_t>(ssrc * 0x9E3779B9u) >> shift;
+  }
+
+  // The size is a power of two, and at most half of the slots are used.
+  std::vector<Slot> slots;
+  // 32 - log2(slots.size()).
+  int shift = 32;
+};
+
+StatisticianLookupTable::~StatisticianLookupTable() {
+  delete table_.load(std::memory_order_relaxed);
+}
+
+StreamStatisticianImplInterface* StatisticianLookupTable::Find(
+    uint32_t ssrc) const {
+  const Table* table = table_.load(std::memory_order_acquire);
+  if (table == nullptr)
+    return nullptr;
+  const size_t mask = table->slots.size() - 1;
+  for (size_t i = table->FirstSlot(ssrc);; i = (i + 1) & mask) {
+    const Table::Slot& slot = table->slots[i];
+    StreamStatisticianImplInterface* statistician =
+        slot.statistician.load(std::memory_order_acquire);
+    if (statistician == nullptr)
+      return nullptr;
+    if (slot.ssrc.load(std::memory_order_relaxed) == ssrc)
+      return statistician;
+  }
+}
+
+void StatisticianLookupTable::Add(
+    uint32_t ssrc,
+    StreamStatisticianImplInterface* statistician) {
+  RTC_DCHECK(statistician);
+  if (Find(ssrc) != nullptr)
+    return;
+  Table* table = table_.load(std::memory_order_relaxed);
+  if (table == nullptr || 2 * (size_ + 1) > table->slots.size()) {
+    // Readers may still use the current table, so the entries are copied to
+    // a new one, and the current one is kept until destruction.
+    auto new_table =
+        std::make_unique<Table>(table == nullptr ? 8 : 2 * table->slots.size());
+    if (table != nullptr) {
+      for (const Table::Slot& slot : table->slots) {
+        StreamStatisticianImplInterface* entry =
+            slot.statistician.load(std::memory_order_relaxed);
+        if (entry != nullptr) {
+          AddToTable(*new_table, slot.ssrc.load(std::memory_order_relaxed),
+                     entry);
+        }
+      }
+      old_tables_.emplace_back(table);
+    }
+    table = new_table.release();
+    AddToTable(*table, ssrc, statistician);
+    table_.store(table, std::memory_order_release);
+  } else {
+    AddToTable(*table, ssrc, statistician);
+  }
+  ++size_;
+}
+
+void StatisticianLookupTable::AddToTable(
+    Table& table,
+    uint32_t ssrc,
+    StreamStatisticianImplInterface* statistician) {
+  const size_t mask = table.slots.size() - 1;
+  size_t i = table.FirstSlot(ssrc);
+  while (table.slots[i].statistician.load(std::memory_order_relaxed) !=
+         nullptr) {
+    i = (i + 1) & mask;
+  }
+  table.slots[i].ssrc.store(ssrc, std::memory_order_relaxed);
+  table.slots[i].statistician.store(statistician, std::memory_order_release);
+}
+
+void ReceiveStatisticsLocked::OnRtpPacket(const RtpPacketReceived& packet) {
+  StreamStatisticianImplInterface* statistician =
+      statisticians_.Find(packet.Ssrc());
+  if (statistician == nullptr) {
+    MutexLock lock(&receive_statistics_lock_);
+    statistician = impl_.GetOrCreateStatistician(packet.Ssrc());
+    statisticians_.Add(packet.Ssrc(), statistician);
+  }
+  // The statistician has its own lock.
+  statistician->UpdateCounters(packet);
+}
+
+StreamStatistician* ReceiveStatisticsLocked::GetStatistician(
+    uint32_t ssrc) const {
+  StreamStatistician* statistician = statisticians_.Find(ssrc);
+  if (statistician != nullptr)
+    return statistician;
+  // Statisticians created by the other methods are added to the lookup table
+  // on the first received packet.
+  MutexLock lock(&receive_statistics_lock_);
+  return impl_.GetStatistician(ssrc);
+}
+
 }  // namespace webrtc
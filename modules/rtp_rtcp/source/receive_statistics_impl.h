@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -21,8 +22,8 @@
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
-#include "rtc_base/containers/flat_map.h"
-#include "rtc_base/rate_statistics.h"
+#include "rtc_base/bucketed_rate_statistics.h"
+#include "rtc_base/containers/uint32_hash_map.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -77,7 +78,7 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   Clock* const clock_;
   // Delta used to map internal timestamps to Unix epoch ones.
   const int64_t delta_internal_unix_epoch_ms_;
-  RateStatistics incoming_bitrate_;
+  BucketedRateStatistics incoming_bitrate_;
   // In number of packets or sequence numbers.
   int max_reordering_threshold_;
   bool enable_retransmit_detection_;
@@ -182,9 +183,10 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
                                  int max_reordering_threshold) override;
   void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
- private:
+  // The returned statistician lives as long as this object.
   StreamStatisticianImplInterface* GetOrCreateStatistician(uint32_t ssrc);
 
+ private:
   Clock* const clock_;
   std::function<std::unique_ptr<StreamStatisticianImplInterface>(
       uint32_t ssrc,
@@ -195,12 +197,46 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   size_t last_returned_ssrc_idx_;
   std::vector<uint32_t> all_ssrcs_;
   int max_reordering_threshold_;
-  flat_map<uint32_t /*ssrc*/, std::unique_ptr<StreamStatisticianImplInterface>>
+  Uint32HashMap<std::unique_ptr<StreamStatisticianImplInterface>>
       statisticians_;
 };
 
+// Maps SSRCs to statisticians, and can be read without locking while one
+// thread at a time adds entries. Entries are never removed, so the
+// statisticians must outlive the table.
+class StatisticianLookupTable {
+ public:
+  StatisticianLookupTable() = default;
+  StatisticianLookupTable(const StatisticianLookupTable&) = delete;
+  StatisticianLookupTable& operator=(const StatisticianLookupTable&) = delete;
+  ~StatisticianLookupTable();
+
+  // Returns nullptr if `ssrc` hasn't been added. May miss an entry that is
+  // being added concurrently.
+  StreamStatisticianImplInterface* Find(uint32_t ssrc) const;
+  // Adds `statistician` for `ssrc` unless there already is an entry for it.
+  // Must not be called concurrently with itself.
+  void Add(uint32_t ssrc, StreamStatisticianImplInterface* statistician);
+
+ private:
+  struct Table;
+
+  static void AddToTable(Table& table,
+                         uint32_t ssrc,
+                         StreamStatisticianImplInterface* statistician);
+
+  std::atomic<Table*> table_{nullptr};
+  // Tables that have been replaced by larger ones, and may still be read.
+  // Since every table is twice the size of the previous one, they use no more
+  // memory than the current one.
+  std::vector<std::unique_ptr<Table>> old_tables_;
+  size_t size_ = 0;
+};
+
 // Thread-safe implementation wrapping access to ReceiveStatisticsImpl with a
-// mutex.
+// mutex. Received packets take the mutex only for the first packet of every
+// SSRC, so that they don't contend with each other or with the creation of
+// RTCP reports.
 class ReceiveStatisticsLocked : public ReceiveStatistics {
  public:
   explicit ReceiveStatisticsLocked(
@@ -215,14 +251,8 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
     MutexLock lock(&receive_statistics_lock_);
     return impl_.RtcpReportBlocks(max_blocks);
   }
-  void OnRtpPacket(const RtpPacketReceived& packet) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.OnRtpPacket(packet);
-  }
-  StreamStatistician* GetStatistician(uint32_t ssrc) const override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.GetStatistician(ssrc);
-  }
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+  StreamStatistician* GetStatistician(uint32_t ssrc) const override;
   void SetMaxReorderingThreshold(int max_reordering_threshold) override {
     MutexLock lock(&receive_statistics_lock_);
     return impl_.SetMaxReorderingThreshold(max_reordering_threshold);
@@ -240,6 +270,8 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
  private:
   mutable Mutex receive_statistics_lock_;
   ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
+  // Statisticians of `impl_`, added while holding `receive_statistics_lock_`.
+  StatisticianLookupTable statisticians_;
 };
 
 }  // namespace webrtc
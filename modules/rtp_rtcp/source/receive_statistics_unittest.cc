@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -563,6 +564,64 @@ TEST_P(ReceiveStatisticsTest, StreamDataCounters) {
   EXPECT_EQ(counters.retransmitted.packets, 1u);
 }
 
+TEST_P(ReceiveStatisticsTest, KeepsStatisticsOfManySsrcs) {
+  constexpr int kNumSsrcs = 100;
+  for (int round = 0; round < 2; ++round) {
+    for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+      RtpPacketReceived packet = CreateRtpPacket(ssrc, kPacketSize1);
+      IncrementSequenceNumber(&packet, round);
+      receive_statistics_->OnRtpPacket(packet);
+    }
+  }
+
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_TRUE(statistician);
+    EXPECT_EQ(statistician->GetReceiveStreamDataCounters().transmitted.packets,
+              2u);
+  }
+  EXPECT_EQ(receive_statistics_->GetStatistician(kNumSsrcs + 1), nullptr);
+  EXPECT_THAT(receive_statistics_->RtcpReportBlocks(kNumSsrcs),
+              SizeIs(kNumSsrcs));
+}
+
+TEST(ReceiveStatisticsLockedTest, ReceivesPacketsWhileCreatingReports) {
+  constexpr int kNumThreads = 4;
+  constexpr int kSsrcsPerThread = 10;
+  constexpr int kPacketsPerSsrc = 100;
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> receive_statistics =
+      ReceiveStatistics::Create(&clock);
+
+  std::vector<rtc::PlatformThread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&receive_statistics, t] {
+          for (int i = 0; i < kPacketsPerSsrc; ++i) {
+            for (int s = 0; s < kSsrcsPerThread; ++s) {
+              RtpPacketReceived packet =
+                  CreateRtpPacket(t * kSsrcsPerThread + s, kPacketSize1);
+              IncrementSequenceNumber(&packet, i);
+              receive_statistics->OnRtpPacket(packet);
+            }
+          }
+        },
+        "Receiver"));
+  }
+  for (int i = 0; i < kPacketsPerSsrc; ++i)
+    receive_statistics->RtcpReportBlocks(kNumThreads * kSsrcsPerThread);
+  threads.clear();
+
+  for (uint32_t ssrc = 0; ssrc < kNumThreads * kSsrcsPerThread; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics->GetStatistician(ssrc);
+    ASSERT_TRUE(statistician);
+    EXPECT_EQ(statistician->GetReceiveStreamDataCounters().transmitted.packets,
+              static_cast<uint32_t>(kPacketsPerSsrc));
+  }
+}
+
 TEST_P(ReceiveStatisticsTest, LastPacketReceivedTimestamp) {
   clock_.AdvanceTimeMilliseconds(42);
   receive_statistics_->OnRtpPacket(packet1_);
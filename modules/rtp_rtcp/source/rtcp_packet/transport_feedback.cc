@@ -117,6 +117,17 @@ void TransportFeedback::LastChunk::Add(DeltaSize delta_size) {
   has_large_delta_ = has_large_delta_ || delta_size == kLarge;
 }
 
+size_t TransportFeedback::LastChunk::AddMissingRun(size_t max_count) {
+  if (!all_same_ || (size_ > 0 && delta_sizes_[0] != 0))
+    return 0;
+  size_t count = std::min(max_count, kMaxRunLengthCapacity - size_);
+  // Keep `delta_sizes_` populated, as Add() does.
+  for (size_t i = size_; i < std::min(size_ + count, kMaxVectorCapacity); ++i)
+    delta_sizes_[i] = 0;
+  size_ += count;
+  return count;
+}
+
 uint16_t TransportFeedback::LastChunk::Emit() {
   RTC_DCHECK(!CanAdd(0) || !CanAdd(1) || !CanAdd(2));
   if (all_same_) {
@@ -337,12 +348,14 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
     uint16_t last_seq_no = next_seq_no - 1;
     if (!IsNewerSequenceNumber(sequence_number, last_seq_no))
       return false;
-    for (; next_seq_no != sequence_number; ++next_seq_no) {
-      if (!AddDeltaSize(0))
-        return false;
-      if (include_lost_)
-        all_packets_.emplace_back(next_seq_no);
+    const uint16_t num_missing = sequence_number - next_seq_no;
+    const size_t num_added = AddMissingPackets(num_missing);
+    if (include_lost_) {
+      for (size_t i = 0; i < num_added; ++i)
+        all_packets_.emplace_back(next_seq_no++);
     }
+    if (num_added < num_missing)
+      return false;
   }
 
   DeltaSize delta_size = (delta >= 0 && delta <= 0xff) ? 1 : 2;
@@ -450,6 +463,9 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
 
   uint16_t seq_no = base_seq_no_;
   size_t recv_delta_size = absl::c_accumulate(delta_sizes, 0);
+  received_packets_.reserve(status_count - absl::c_count(delta_sizes, 0));
+  if (include_lost_)
+    all_packets_.reserve(status_count);
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
@@ -697,5 +713,31 @@ bool TransportFeedback::AddDeltaSize(DeltaSize delta_size) {
   return true;
 }
 
+size_t TransportFeedback::AddMissingPackets(size_t num_missing) {
+  size_t num_added = 0;
+  while (num_added < num_missing) {
+    const size_t max_count =
+        std::min(num_missing - num_added, kMaxReportedPackets - num_seq_no_);
+    if (max_count == 0)
+      break;
+    const size_t add_chunk_size = last_chunk_.Empty() ? kChunkSizeBytes : 0;
+    size_t count = 0;
+    if (size_bytes_ + add_chunk_size <= kMaxSizeBytes)
+      count = last_chunk_.AddMissingRun(max_count);
+    if (count > 0) {
+      size_bytes_ += add_chunk_size;
+      num_seq_no_ += count;
+      num_added += count;
+      continue;
+    }
+    // The last chunk has other delta sizes or is a full run, so it must be
+    // emitted first.
+    if (!AddDeltaSize(0))
+      break;
+    ++num_added;
+  }
+  return num_added;
+}
+
 }  // namespace rtcp
 }  // namespace webrtc
@@ -120,6 +120,9 @@ class TransportFeedback : public Rtpfb {
     bool CanAdd(DeltaSize delta_size) const;
     // Add `delta_size`, assumes `CanAdd(delta_size)`,
     void Add(DeltaSize delta_size);
+    // Adds up to `max_count` delta sizes of 0 in one step if the chunk is
+    // empty or holds only zeros. Returns how many were added.
+    size_t AddMissingRun(size_t max_count);
 
     // Encode chunk as large as possible removing encoded delta sizes.
     // Assume CanAdd() == false for some valid delta_size.
@@ -158,6 +161,9 @@ class TransportFeedback : public Rtpfb {
   void Clear();
 
   bool AddDeltaSize(DeltaSize delta_size);
+  // Adds `num_missing` not received packets, extending a run length chunk at
+  // once where possible. Returns the number of packets that were added.
+  size_t AddMissingPackets(size_t num_missing);
 
   const bool include_lost_;
   uint16_t base_seq_no_;
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/buffer.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kBaseTimeUs = 123456789;
+// Packets arrive every millisecond, except every `kLossPeriod`th that is lost.
+constexpr int64_t kArrivalDeltaUs = 1000;
+constexpr int kLossPeriod = 20;
+
+// Adds `state.range(0)` packets to a feedback message and builds it.
+void BM_TransportFeedbackBuild(benchmark::State& state) {
+  const int num_packets = state.range(0);
+  for (auto s : state) {
+    rtcp::TransportFeedback feedback;
+    feedback.SetSenderSsrc(1);
+    feedback.SetMediaSsrc(2);
+    feedback.SetBase(0, kBaseTimeUs);
+    for (int i = 0; i < num_packets; ++i) {
+      if (i % kLossPeriod != kLossPeriod - 1)
+        feedback.AddReceivedPacket(i, kBaseTimeUs + i * kArrivalDeltaUs);
+    }
+    benchmark::DoNotOptimize(feedback.Build());
+  }
+  state.SetItemsProcessed(state.iterations() * num_packets);
+}
+
+BENCHMARK(BM_TransportFeedbackBuild)->Arg(20)->Arg(100)->Arg(1000);
+
+void BM_TransportFeedbackParse(benchmark::State& state) {
+  const int num_packets = state.range(0);
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, kBaseTimeUs);
+  for (int i = 0; i < num_packets; ++i) {
+    if (i % kLossPeriod != kLossPeriod - 1)
+      feedback.AddReceivedPacket(i, kBaseTimeUs + i * kArrivalDeltaUs);
+  }
+  const rtc::Buffer packet = feedback.Build();
+
+  for (auto s : state) {
+    std::unique_ptr<rtcp::TransportFeedback> parsed =
+        rtcp::TransportFeedback::ParseFrom(packet.data(), packet.size());
+    if (!parsed) {
+      state.SkipWithError("Failed to parse the feedback.");
+      break;
+    }
+    benchmark::DoNotOptimize(parsed->GetReceivedPackets().size());
+  }
+  state.SetItemsProcessed(state.iterations() * num_packets);
+}
+
+BENCHMARK(BM_TransportFeedbackParse)->Arg(20)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace webrtc
@@ -293,6 +293,26 @@ TEST(RtcpPacketTest, TransportFeedbackMinRle) {
   test.VerifyPacket();
 }
 
+TEST(RtcpPacketTest, TransportFeedbackSeveralMaxRle) {
+  // Expected chunks created:
+  // * 1-bit vector chunk (1xreceived + 13xdropped)
+  // * 3 RLE chunks of max length for dropped symbol
+  // * RLE chunk of length 86 for dropped symbol
+  // * 1-bit vector chunk (1xreceived)
+
+  const size_t kPacketCount = 3 * ((1 << 13) - 1) + 100;
+  const uint16_t kReceived[] = {0, kPacketCount};
+  const int64_t kReceiveTimes[] = {1000, 2000};
+  const size_t kLength = sizeof(kReceived) / sizeof(uint16_t);
+  const size_t kExpectedSizeBytes =
+      kHeaderSize + (6 * kStatusChunkSize) + (kLength * kSmallDeltaSize);
+
+  FeedbackTester test;
+  test.WithExpectedSize(kExpectedSizeBytes);
+  test.WithInput(kReceived, kReceiveTimes, kLength);
+  test.VerifyPacket();
+}
+
 TEST(RtcpPacketTest, TransportFeedbackOneToTwoBitVector) {
   const size_t kTwoBitVectorCapacity = 7;
   const uint16_t kReceived[] = {0, kTwoBitVectorCapacity - 1};
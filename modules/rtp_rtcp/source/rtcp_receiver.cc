@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_bitrate_allocator.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
@@ -441,9 +442,48 @@ std::vector<ReportBlockData> RTCPReceiver::GetLatestReportBlockData() const {
 
 bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
                                        PacketInformation* packet_information) {
+  // Split the compound packet into blocks, and handle the blocks that don't
+  // depend on receiver state before taking the lock. Transport feedback in
+  // particular is both frequent and comparatively expensive to parse.
+  absl::InlinedVector<CommonHeader, 8> stateful_blocks;
+  size_t num_skipped_blocks = 0;
+  {
+    CommonHeader rtcp_block;
+    for (const uint8_t* next_block = packet.begin(); next_block != packet.end();
+         next_block = rtcp_block.NextPacket()) {
+      ptrdiff_t remaining_blocks_size = packet.end() - next_block;
+      RTC_DCHECK_GT(remaining_blocks_size, 0);
+      if (!rtcp_block.Parse(next_block, remaining_blocks_size)) {
+        if (next_block == packet.begin()) {
+          // Failed to parse 1st header, nothing was extracted from this packet.
+          RTC_LOG(LS_WARNING) << "Incoming invalid RTCP packet";
+          return false;
+        }
+        ++num_skipped_blocks;
+        break;
+      }
+
+      bool handled = true;
+      if (rtcp_block.type() == rtcp::Rtpfb::kPacketType &&
+          rtcp_block.fmt() == rtcp::TransportFeedback::kFeedbackMessageType) {
+        handled = HandleTransportFeedback(rtcp_block, packet_information);
+      } else if (rtcp_block.type() == rtcp::Psfb::kPacketType &&
+                 rtcp_block.fmt() == rtcp::Psfb::kAfbMessageType) {
+        handled = HandlePsfbApp(rtcp_block, packet_information);
+      } else {
+        stateful_blocks.push_back(rtcp_block);
+      }
+      if (!handled) {
+        ++num_skipped_blocks;
+      }
+    }
+  }
+
   MutexLock lock(&rtcp_receiver_lock_);
+  num_skipped_packets_ += num_skipped_blocks;
+  if (packet_type_counter_.first_packet_time_ms == -1)
+    packet_type_counter_.first_packet_time_ms = clock_->TimeInMilliseconds();
 
-  CommonHeader rtcp_block;
   // If a sender report is received but no DLRR, we need to reset the
   // roundTripTime stat according to the standard, see
   // https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
@@ -454,23 +494,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
   // For each remote SSRC we store if we've received a sender report or a DLRR
   // block.
   flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
-  for (const uint8_t* next_block = packet.begin(); next_block != packet.end();
-       next_block = rtcp_block.NextPacket()) {
-    ptrdiff_t remaining_blocks_size = packet.end() - next_block;
-    RTC_DCHECK_GT(remaining_blocks_size, 0);
-    if (!rtcp_block.Parse(next_block, remaining_blocks_size)) {
-      if (next_block == packet.begin()) {
-        // Failed to parse 1st header, nothing was extracted from this packet.
-        RTC_LOG(LS_WARNING) << "Incoming invalid RTCP packet";
-        return false;
-      }
-      ++num_skipped_packets_;
-      break;
-    }
-
-    if (packet_type_counter_.first_packet_time_ms == -1)
-      packet_type_counter_.first_packet_time_ms = clock_->TimeInMilliseconds();
-
+  for (const CommonHeader& rtcp_block : stateful_blocks) {
     switch (rtcp_block.type()) {
       case rtcp::SenderReport::kPacketType:
         HandleSenderReport(rtcp_block, packet_information);
@@ -511,9 +535,6 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
           case rtcp::RapidResyncRequest::kFeedbackMessageType:
             HandleSrReq(rtcp_block, packet_information);
             break;
-          case rtcp::TransportFeedback::kFeedbackMessageType:
-            HandleTransportFeedback(rtcp_block, packet_information);
-            break;
           default:
             ++num_skipped_packets_;
             break;
@@ -527,9 +548,6 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
           case rtcp::Fir::kFeedbackMessageType:
             HandleFir(rtcp_block, packet_information);
             break;
-          case rtcp::Psfb::kAfbMessageType:
-            HandlePsfbApp(rtcp_block, packet_information);
-            break;
           default:
             ++num_skipped_packets_;
             break;
@@ -1043,7 +1061,7 @@ void RTCPReceiver::HandleSrReq(const CommonHeader& rtcp_block,
   packet_information->packet_type_flags |= kRtcpSrReq;
 }
 
-void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
+bool RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
                                  PacketInformation* packet_information) {
   {
     rtcp::Remb remb;
@@ -1051,7 +1069,7 @@ void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
       packet_information->packet_type_flags |= kRtcpRemb;
       packet_information->receiver_estimated_max_bitrate_bps =
           remb.bitrate_bps();
-      return;
+      return true;
     }
   }
 
@@ -1060,13 +1078,12 @@ void RTCPReceiver::HandlePsfbApp(const CommonHeader& rtcp_block,
     if (loss_notification->Parse(rtcp_block)) {
       packet_information->packet_type_flags |= kRtcpLossNotification;
       packet_information->loss_notification = std::move(loss_notification);
-      return;
+      return true;
     }
   }
 
   RTC_LOG(LS_WARNING) << "Unknown PSFB-APP packet.";
-
-  ++num_skipped_packets_;
+  return false;
 }
 
 void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
@@ -1109,18 +1126,18 @@ void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
   }
 }
 
-void RTCPReceiver::HandleTransportFeedback(
+bool RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
   std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
       new rtcp::TransportFeedback());
   if (!transport_feedback->Parse(rtcp_block)) {
-    ++num_skipped_packets_;
-    return;
+    return false;
   }
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
   packet_information->transport_feedback = std::move(transport_feedback);
+  return true;
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
@@ -343,9 +343,6 @@ class RTCPReceiver final {
                  PacketInformation* packet_information)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
-  void HandlePsfbApp(const rtcp::CommonHeader& rtcp_block,
-                     PacketInformation* packet_information)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
   void HandleTmmbr(const rtcp::CommonHeader& rtcp_block,
                    PacketInformation* packet_information)
@@ -363,9 +360,12 @@ class RTCPReceiver final {
                  PacketInformation* packet_information)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
-  void HandleTransportFeedback(const rtcp::CommonHeader& rtcp_block,
-                               PacketInformation* packet_information)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+  // Handlers for blocks that don't touch receiver state; these run before
+  // `rtcp_receiver_lock_` is taken. Return false if the block is malformed.
+  static bool HandlePsfbApp(const rtcp::CommonHeader& rtcp_block,
+                            PacketInformation* packet_information);
+  static bool HandleTransportFeedback(const rtcp::CommonHeader& rtcp_block,
+                                      PacketInformation* packet_information);
 
   bool RtcpRrTimeoutLocked(Timestamp now)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
@@ -74,6 +74,35 @@ void RtcpTransceiver::RemoveMediaReceiverRtcpObserver(
   task_queue_->PostTask(ToQueuedTask(std::move(remove), std::move(on_removed)));
 }
 
+void RtcpTransceiver::AddReceiveStatistics(
+    ReceiveStatisticsProvider* receive_statistics) {
+  RTC_CHECK(rtcp_transceiver_);
+  RtcpTransceiverImpl* ptr = rtcp_transceiver_.get();
+  if (task_queue_->IsCurrent()) {
+    ptr->AddReceiveStatistics(receive_statistics);
+    return;
+  }
+  task_queue_->PostTask(ToQueuedTask([ptr, receive_statistics] {
+    ptr->AddReceiveStatistics(receive_statistics);
+  }));
+}
+
+void RtcpTransceiver::RemoveReceiveStatistics(
+    ReceiveStatisticsProvider* receive_statistics,
+    std::function<void()> on_removed) {
+  RTC_CHECK(rtcp_transceiver_);
+  RtcpTransceiverImpl* ptr = rtcp_transceiver_.get();
+  if (task_queue_->IsCurrent()) {
+    ptr->RemoveReceiveStatistics(receive_statistics);
+    on_removed();
+    return;
+  }
+  auto remove = [ptr, receive_statistics] {
+    ptr->RemoveReceiveStatistics(receive_statistics);
+  };
+  task_queue_->PostTask(ToQueuedTask(std::move(remove), std::move(on_removed)));
+}
+
 void RtcpTransceiver::SetReadyToSend(bool ready) {
   RTC_CHECK(rtcp_transceiver_);
   RtcpTransceiverImpl* ptr = rtcp_transceiver_.get();
@@ -56,6 +56,16 @@ class RtcpTransceiver : public RtcpFeedbackSenderInterface {
                                        MediaReceiverRtcpObserver* observer,
                                        std::function<void()> on_removed);
 
+  // Registers statistics to send report blocks for, e.g. of a receive stream.
+  // Called on the `config.task_queue`, registration takes effect immediately;
+  // elsewhere it is posted there. Add and remove should be called on the same
+  // task queue.
+  void AddReceiveStatistics(ReceiveStatisticsProvider* receive_statistics);
+  // Runs `on_removed` when `receive_statistics` is no longer used, right away
+  // if called on the `config.task_queue`.
+  void RemoveReceiveStatistics(ReceiveStatisticsProvider* receive_statistics,
+                               std::function<void()> on_removed);
+
   // Enables/disables sending rtcp packets eventually.
   // Packets may be sent after the SetReadyToSend(false) returns, but no new
   // packets will be scheduled.
@@ -27,6 +27,7 @@
 #include "system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
+class KeyFrameRequestAggregator;
 class ReceiveStatisticsProvider;
 class Transport;
 
@@ -131,6 +132,12 @@ struct RtcpTransceiverConfig {
   // Queue for scheduling delayed tasks, e.g. sending periodic compound packets.
   TaskQueueBase* task_queue = nullptr;
 
+  // Optional, may be shared between transceivers. If set, key frame requests
+  // for an SSRC with a request already outstanding are dropped. Key frames
+  // are not observed by the transceiver, so the owner should report them to
+  // the aggregator.
+  KeyFrameRequestAggregator* key_frame_request_aggregator = nullptr;
+
   // Rtcp report block generator for outgoing receiver reports.
   ReceiveStatisticsProvider* receive_statistics = nullptr;
 
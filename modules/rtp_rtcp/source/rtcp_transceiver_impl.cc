@@ -19,6 +19,7 @@
 #include "api/video/video_bitrate_allocation.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/key_frame_request_aggregator.h"
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
@@ -127,6 +128,23 @@ void RtcpTransceiverImpl::RemoveMediaReceiverRtcpObserver(
   stored.erase(it);
 }
 
+void RtcpTransceiverImpl::AddReceiveStatistics(
+    ReceiveStatisticsProvider* receive_statistics) {
+  RTC_DCHECK(receive_statistics);
+  RTC_DCHECK(!absl::c_linear_search(receive_statistics_, receive_statistics));
+  receive_statistics_.push_back(receive_statistics);
+}
+
+void RtcpTransceiverImpl::RemoveReceiveStatistics(
+    ReceiveStatisticsProvider* receive_statistics) {
+  auto it = absl::c_find(receive_statistics_, receive_statistics);
+  if (it == receive_statistics_.end())
+    return;
+  receive_statistics_.erase(it);
+  if (next_receive_statistics_ >= receive_statistics_.size())
+    next_receive_statistics_ = 0;
+}
+
 bool RtcpTransceiverImpl::AddMediaSender(uint32_t local_ssrc,
                                          RtpStreamRtcpHandler* handler) {
   RTC_DCHECK(handler != nullptr);
@@ -241,6 +259,10 @@ void RtcpTransceiverImpl::SendNack(uint32_t ssrc,
 void RtcpTransceiverImpl::SendPictureLossIndication(uint32_t ssrc) {
   if (!ready_to_send_)
     return;
+  if (config_.key_frame_request_aggregator &&
+      !config_.key_frame_request_aggregator->OnKeyFrameRequest(ssrc)) {
+    return;
+  }
   rtcp::Pli pli;
   pli.SetSenderSsrc(config_.feedback_ssrc);
   pli.SetMediaSsrc(ssrc);
@@ -256,11 +278,19 @@ void RtcpTransceiverImpl::SendFullIntraRequest(
   rtcp::Fir fir;
   fir.SetSenderSsrc(config_.feedback_ssrc);
   for (uint32_t media_ssrc : ssrcs) {
+    // Repeated requests are retransmissions of an earlier request, which
+    // already went through the aggregator.
+    if (new_request && config_.key_frame_request_aggregator &&
+        !config_.key_frame_request_aggregator->OnKeyFrameRequest(media_ssrc)) {
+      continue;
+    }
     uint8_t& command_seq_num = remote_senders_[media_ssrc].fir_sequence_number;
     if (new_request)
       command_seq_num += 1;
     fir.AddRequestTo(media_ssrc, command_seq_num);
   }
+  if (fir.requests().empty())
+    return;
   SendImmediateFeedback(fir);
 }
 
@@ -727,10 +757,26 @@ void RtcpTransceiverImpl::SendImmediateFeedback(
 std::vector<rtcp::ReportBlock> RtcpTransceiverImpl::CreateReportBlocks(
     Timestamp now,
     size_t num_max_blocks) {
-  if (!config_.receive_statistics)
-    return {};
-  std::vector<rtcp::ReportBlock> report_blocks =
-      config_.receive_statistics->RtcpReportBlocks(num_max_blocks);
+  std::vector<rtcp::ReportBlock> report_blocks;
+  if (config_.receive_statistics) {
+    report_blocks =
+        config_.receive_statistics->RtcpReportBlocks(num_max_blocks);
+  }
+  for (size_t i = 0; i < receive_statistics_.size() &&
+                     report_blocks.size() < num_max_blocks;
+       ++i) {
+    ReceiveStatisticsProvider* receive_statistics =
+        receive_statistics_[(next_receive_statistics_ + i) %
+                            receive_statistics_.size()];
+    std::vector<rtcp::ReportBlock> blocks =
+        receive_statistics->RtcpReportBlocks(num_max_blocks -
+                                             report_blocks.size());
+    report_blocks.insert(report_blocks.end(), blocks.begin(), blocks.end());
+  }
+  if (!receive_statistics_.empty()) {
+    next_receive_statistics_ =
+        (next_receive_statistics_ + 1) % receive_statistics_.size();
+  }
   uint32_t last_sr = 0;
   uint32_t last_delay = 0;
   for (rtcp::ReportBlock& report_block : report_blocks) {
@@ -48,6 +48,12 @@ class RtcpTransceiverImpl {
   void RemoveMediaReceiverRtcpObserver(uint32_t remote_ssrc,
                                        MediaReceiverRtcpObserver* observer);
 
+  // Report blocks for the registered providers are sent in addition to those
+  // for `config.receive_statistics`, e.g. for receive streams that keep their
+  // own statistics.
+  void AddReceiveStatistics(ReceiveStatisticsProvider* receive_statistics);
+  void RemoveReceiveStatistics(ReceiveStatisticsProvider* receive_statistics);
+
   // Returns false on failure, e.g. when there is already an handler for the
   // `local_ssrc`.
   bool AddMediaSender(uint32_t local_ssrc, RtpStreamRtcpHandler* handler);
@@ -152,6 +158,10 @@ class RtcpTransceiverImpl {
   flat_map<uint32_t, std::list<LocalSenderState>::iterator>
       local_senders_by_ssrc_;
   flat_map<uint32_t, RrtrTimes> received_rrtrs_;
+  std::vector<ReceiveStatisticsProvider*> receive_statistics_;
+  // Provider to ask first for report blocks, rotated so that all of them get
+  // reported when not all report blocks fit in one compound packet.
+  size_t next_receive_statistics_ = 0;
   RepeatingTaskHandle periodic_task_handle_;
 };
 
@@ -22,6 +22,7 @@
 #include "api/video/video_bitrate_allocation.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/mocks/mock_rtcp_rtt_stats.h"
+#include "modules/rtp_rtcp/source/key_frame_request_aggregator.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
@@ -675,6 +676,47 @@ TEST(RtcpTransceiverImplTest, ReceiverReportUsesReceiveStatistics) {
             kMediaSsrc);
 }
 
+TEST(RtcpTransceiverImplTest, ReceiverReportUsesAddedReceiveStatistics) {
+  const uint32_t kMediaSsrc1 = 54321;
+  const uint32_t kMediaSsrc2 = 54322;
+  MockReceiveStatisticsProvider receive_statistics1;
+  MockReceiveStatisticsProvider receive_statistics2;
+  std::vector<ReportBlock> report_blocks1(1);
+  report_blocks1[0].SetMediaSsrc(kMediaSsrc1);
+  std::vector<ReportBlock> report_blocks2(1);
+  report_blocks2[0].SetMediaSsrc(kMediaSsrc2);
+  EXPECT_CALL(receive_statistics1, RtcpReportBlocks(_))
+      .WillRepeatedly(Return(report_blocks1));
+  EXPECT_CALL(receive_statistics2, RtcpReportBlocks(_))
+      .Times(1)
+      .WillRepeatedly(Return(report_blocks2));
+
+  SimulatedClock clock(0);
+  RtcpTransceiverConfig config;
+  config.clock = &clock;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.schedule_periodic_compound_packets = false;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+  rtcp_transceiver.AddReceiveStatistics(&receive_statistics1);
+  rtcp_transceiver.AddReceiveStatistics(&receive_statistics2);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  ASSERT_EQ(rtcp_parser.receiver_report()->num_packets(), 1);
+  ASSERT_THAT(rtcp_parser.receiver_report()->report_blocks(), SizeIs(2));
+
+  // A removed provider is no longer asked for report blocks.
+  rtcp_transceiver.RemoveReceiveStatistics(&receive_statistics2);
+  rtcp_transceiver.SendCompoundPacket();
+
+  ASSERT_EQ(rtcp_parser.receiver_report()->num_packets(), 2);
+  ASSERT_THAT(rtcp_parser.receiver_report()->report_blocks(), SizeIs(1));
+  EXPECT_EQ(rtcp_parser.receiver_report()->report_blocks()[0].source_ssrc(),
+            kMediaSsrc1);
+}
+
 TEST(RtcpTransceiverImplTest, MultipleObserversOnSameSsrc) {
   const uint32_t kRemoteSsrc = 12345;
   SimulatedClock clock(0);
@@ -1065,6 +1107,33 @@ TEST(RtcpTransceiverImplTest, RequestKeyFrameWithPictureLossIndication) {
   EXPECT_EQ(rtcp_parser.pli()->media_ssrc(), kRemoteSsrc);
 }
 
+TEST(RtcpTransceiverImplTest, AggregatesKeyFrameRequestsAcrossTransceivers) {
+  const uint32_t kRemoteSsrc = 4321;
+  const uint32_t kRemoteSsrcs[] = {kRemoteSsrc};
+  SimulatedClock clock(0);
+  KeyFrameRequestAggregator aggregator(&clock);
+  RtcpTransceiverConfig config;
+  config.clock = &clock;
+  config.schedule_periodic_compound_packets = false;
+  config.key_frame_request_aggregator = &aggregator;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  RtcpTransceiverImpl rtcp_transceiver1(config);
+  RtcpTransceiverImpl rtcp_transceiver2(config);
+
+  rtcp_transceiver1.SendPictureLossIndication(kRemoteSsrc);
+  rtcp_transceiver2.SendPictureLossIndication(kRemoteSsrc);
+  rtcp_transceiver2.SendFullIntraRequest(kRemoteSsrcs, true);
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.pli()->num_packets(), 1);
+
+  aggregator.OnKeyFrameReceived(kRemoteSsrc);
+  rtcp_transceiver2.SendFullIntraRequest(kRemoteSsrcs, true);
+  EXPECT_EQ(transport.num_packets(), 2);
+  EXPECT_EQ(rtcp_parser.fir()->num_packets(), 1);
+}
+
 TEST(RtcpTransceiverImplTest, RequestKeyFrameWithFullIntraRequest) {
   const uint32_t kSenderSsrc = 1234;
   const uint32_t kRemoteSsrcs[] = {4321, 5321};
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/video/video_codec_type.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/create_video_rtp_depacketizer.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer.h"
+#include "modules/video_coding/codecs/h264/include/h264_globals.h"
+#include "modules/video_coding/codecs/vp8/include/vp8_globals.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxPacketSize = 1200;
+
+// Returns a key frame of `size` bytes that the packetizer of `codec` accepts:
+// a single IDR NAL unit with its start code for H.264, a single frame OBU for
+// AV1, and opaque bytes for the other codecs.
+std::vector<uint8_t> CreateFrame(VideoCodecType codec, size_t size) {
+  std::vector<uint8_t> frame(size, 0x5a);
+  if (codec == kVideoCodecH264) {
+    const uint8_t kIdrStartCode[] = {0x00, 0x00, 0x00, 0x01, 0x65};
+    std::copy(std::begin(kIdrStartCode), std::end(kIdrStartCode),
+              frame.begin());
+  } else if (codec == kVideoCodecAV1) {
+    // OBU header of a frame OBU with the size field present, followed by the
+    // size in leb128.
+    size_t i = 0;
+    frame[i++] = 0x32;
+    size_t obu_size = size - 4;
+    for (int j = 0; j < 3; ++j) {
+      frame[i++] = (obu_size & 0x7f) | (j < 2 ? 0x80 : 0x00);
+      obu_size >>= 7;
+    }
+  }
+  return frame;
+}
+
+RTPVideoHeader CreateVideoHeader(VideoCodecType codec) {
+  RTPVideoHeader video_header;
+  video_header.codec = codec;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  video_header.width = 1280;
+  video_header.height = 720;
+  switch (codec) {
+    case kVideoCodecVP8:
+      video_header.video_type_header.emplace<RTPVideoHeaderVP8>()
+          .InitRTPVideoHeaderVP8();
+      break;
+    case kVideoCodecVP9: {
+      auto& vp9 = video_header.video_type_header.emplace<RTPVideoHeaderVP9>();
+      vp9.InitRTPVideoHeaderVP9();
+      vp9.inter_pic_predicted = false;
+      break;
+    }
+    case kVideoCodecH264:
+      video_header.video_type_header.emplace<RTPVideoHeaderH264>()
+          .packetization_mode = H264PacketizationMode::NonInterleaved;
+      break;
+    default:
+      break;
+  }
+  return video_header;
+}
+
+// Packetizes a key frame of `state.range(0)` bytes.
+void BM_Packetize(benchmark::State& state, VideoCodecType codec) {
+  const std::vector<uint8_t> frame = CreateFrame(codec, state.range(0));
+  const RTPVideoHeader video_header = CreateVideoHeader(codec);
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPacketSize;
+  RtpPacketToSend packet(/*extensions=*/nullptr);
+
+  size_t num_packets = 0;
+  for (auto s : state) {
+    std::unique_ptr<RtpPacketizer> packetizer =
+        RtpPacketizer::Create(codec, frame, limits, video_header);
+    while (packetizer->NextPacket(&packet))
+      ++num_packets;
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+  state.counters["packets_per_frame"] =
+      static_cast<double>(num_packets) / state.iterations();
+}
+
+// Parses the packets of a key frame of `state.range(0)` bytes and assembles
+// the frame from them.
+void BM_Depacketize(benchmark::State& state, VideoCodecType codec) {
+  const std::vector<uint8_t> frame = CreateFrame(codec, state.range(0));
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPacketSize;
+  std::unique_ptr<RtpPacketizer> packetizer =
+      RtpPacketizer::Create(codec, frame, limits, CreateVideoHeader(codec));
+  std::vector<rtc::CopyOnWriteBuffer> rtp_payloads;
+  RtpPacketToSend packet(/*extensions=*/nullptr);
+  while (packetizer->NextPacket(&packet))
+    rtp_payloads.push_back(packet.PayloadBuffer());
+
+  std::unique_ptr<VideoRtpDepacketizer> depacketizer =
+      CreateVideoRtpDepacketizer(codec);
+  std::vector<rtc::ArrayView<const uint8_t>> video_payloads;
+  for (auto s : state) {
+    std::vector<VideoRtpDepacketizer::ParsedRtpPayload> parsed;
+    parsed.reserve(rtp_payloads.size());
+    video_payloads.clear();
+    for (const rtc::CopyOnWriteBuffer& rtp_payload : rtp_payloads) {
+      absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed_payload =
+          depacketizer->Parse(rtp_payload);
+      if (!parsed_payload) {
+        state.SkipWithError("Failed to parse a packet.");
+        return;
+      }
+      parsed.push_back(*std::move(parsed_payload));
+      video_payloads.push_back(parsed.back().video_payload);
+    }
+    benchmark::DoNotOptimize(depacketizer->AssembleFrame(video_payloads));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+
+BENCHMARK_CAPTURE(BM_Packetize, generic, kVideoCodecGeneric)
+    ->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Packetize, vp8, kVideoCodecVP8)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Packetize, vp9, kVideoCodecVP9)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Packetize, h264, kVideoCodecH264)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Packetize, av1, kVideoCodecAV1)->Range(1000, 100000);
+
+BENCHMARK_CAPTURE(BM_Depacketize, generic, kVideoCodecGeneric)
+    ->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Depacketize, vp8, kVideoCodecVP8)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Depacketize, vp9, kVideoCodecVP9)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Depacketize, h264, kVideoCodecH264)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_Depacketize, av1, kVideoCodecAV1)->Range(1000, 100000);
+
+}  // namespace
+}  // namespace webrtc
@@ -69,7 +69,22 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   Clear();
 }
 
-RtpPacket::~RtpPacket() {}
+RtpPacket::RtpPacket(const ExtensionManager* extensions,
+                     size_t capacity,
+                     rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool)
+    : extensions_(extensions ? *extensions : ExtensionManager()),
+      buffer_(buffer_pool ? buffer_pool->Acquire(capacity, capacity)
+                          : rtc::CopyOnWriteBuffer(capacity)),
+      buffer_pool_(std::move(buffer_pool)) {
+  RTC_DCHECK_GE(capacity, kFixedHeaderSize);
+  Clear();
+}
+
+RtpPacket::~RtpPacket() {
+  if (buffer_pool_) {
+    buffer_pool_->Recycle(std::move(buffer_));
+  }
+}
 
 void RtpPacket::IdentifyExtensions(ExtensionManager extensions) {
   extensions_ = std::move(extensions);
@@ -95,6 +110,9 @@ bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
     return false;
   }
   size_t buffer_size = buffer.size();
+  if (buffer_pool_) {
+    buffer_pool_->Recycle(std::move(buffer_));
+  }
   buffer_ = std::move(buffer);
   RTC_DCHECK_EQ(size(), buffer_size);
   return true;
@@ -112,6 +130,16 @@ std::vector<uint32_t> RtpPacket::Csrcs() const {
 }
 
 void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
+  CopyHeaderFieldsFrom(packet);
+  buffer_ = packet.buffer_.Slice(0, packet.headers_size());
+}
+
+void RtpPacket::WriteHeaderFrom(const RtpPacket& packet) {
+  CopyHeaderFieldsFrom(packet);
+  buffer_.SetData(packet.data(), packet.headers_size());
+}
+
+void RtpPacket::CopyHeaderFieldsFrom(const RtpPacket& packet) {
   marker_ = packet.marker_;
   payload_type_ = packet.payload_type_;
   sequence_number_ = packet.sequence_number_;
@@ -120,8 +148,9 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  memcpy(extension_entry_index_by_id_, packet.extension_entry_index_by_id_,
+         sizeof(extension_entry_index_by_id_));
   extensions_size_ = packet.extensions_size_;
-  buffer_ = packet.buffer_.Slice(0, packet.headers_size());
   // Reset payload and padding.
   payload_size_ = 0;
   padding_size_ = 0;
@@ -324,8 +353,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint16_t extension_info_offset = rtc::dchecked_cast<uint16_t>(
       extensions_offset + extensions_size_ + extension_header_size);
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
-  extension_entries_.emplace_back(id, extension_info_length,
-                                  extension_info_offset);
+  AddExtensionInfo(id, extension_info_length, extension_info_offset);
 
   extensions_size_ = new_extensions_size;
 
@@ -437,7 +465,7 @@ void RtpPacket::Clear() {
   payload_size_ = 0;
   padding_size_ = 0;
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
@@ -467,7 +495,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   payload_offset_ = kFixedHeaderSize + number_of_crcs * 4;
 
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
   if (has_extension) {
     /* RTP header extension, RFC 3550.
      0                   1                   2                   3
@@ -563,25 +591,49 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
-const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
-  for (const ExtensionInfo& extension : extension_entries_) {
-    if (extension.id == id) {
-      return &extension;
+int RtpPacket::FindExtensionIndex(int id) const {
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    return extension_entry_index_by_id_[id] - 1;
+  }
+  for (size_t i = 0; i < extension_entries_.size(); ++i) {
+    if (extension_entries_[i].id == id) {
+      return i;
     }
   }
-  return nullptr;
+  return -1;
+}
+
+const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
+  const int index = FindExtensionIndex(id);
+  return index < 0 ? nullptr : &extension_entries_[index];
 }
 
 RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
-  for (ExtensionInfo& extension : extension_entries_) {
-    if (extension.id == id) {
-      return extension;
-    }
+  const int index = FindExtensionIndex(id);
+  if (index >= 0) {
+    return extension_entries_[index];
+  }
+  return AddExtensionInfo(rtc::dchecked_cast<uint8_t>(id), 0, 0);
+}
+
+RtpPacket::ExtensionInfo& RtpPacket::AddExtensionInfo(uint8_t id,
+                                                      uint8_t length,
+                                                      uint16_t offset) {
+  RTC_DCHECK(FindExtensionInfo(id) == nullptr);
+  extension_entries_.emplace_back(id, length, offset);
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    // There are at most 255 distinct ids.
+    extension_entry_index_by_id_[id] =
+        rtc::dchecked_cast<uint8_t>(extension_entries_.size());
   }
-  extension_entries_.emplace_back(id);
   return extension_entries_.back();
 }
 
+void RtpPacket::ClearExtensionInfos() {
+  extension_entries_.clear();
+  memset(extension_entry_index_by_id_, 0, sizeof(extension_entry_index_by_id_));
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
   uint8_t id = extensions_.GetId(type);
@@ -15,8 +15,11 @@
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/rtp_parameters.h"
+#include "api/scoped_refptr.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
@@ -36,6 +39,11 @@ class RtpPacket {
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const RtpPacket&);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
+  // Takes the packet buffer from `buffer_pool` and returns it there on
+  // destruction, or when the buffer is replaced by Parse().
+  RtpPacket(const ExtensionManager* extensions,
+            size_t capacity,
+            rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool);
   ~RtpPacket();
 
   RtpPacket& operator=(const RtpPacket&) = default;
@@ -89,6 +97,10 @@ class RtpPacket {
 
   // Header setters.
   void CopyHeaderFrom(const RtpPacket& packet);
+  // Same as CopyHeaderFrom(), but copies the header into the buffer of this
+  // packet instead of sharing the buffer of `packet`, so that the capacity and
+  // the buffer pool of this packet are kept.
+  void WriteHeaderFrom(const RtpPacket& packet);
   void SetMarker(bool marker_bit);
   void SetPayloadType(uint8_t payload_type);
   void SetSequenceNumber(uint16_t seq_no);
@@ -156,7 +168,6 @@ class RtpPacket {
 
  private:
   struct ExtensionInfo {
-    explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
     ExtensionInfo(uint8_t id, uint8_t length, uint16_t offset)
         : id(id), length(length), offset(offset) {}
     uint8_t id;
@@ -168,6 +179,10 @@ class RtpPacket {
   // but does not touch packet own buffer, leaving packet in invalid state.
   bool ParseBuffer(const uint8_t* buffer, size_t size);
 
+  // Returns the index in `extension_entries_` of the entry for a given id, or
+  // -1 if not found.
+  int FindExtensionIndex(int id) const;
+
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
   const ExtensionInfo* FindExtensionInfo(int id) const;
@@ -176,6 +191,14 @@ class RtpPacket {
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Appends an entry for the id, which must not have one yet.
+  ExtensionInfo& AddExtensionInfo(uint8_t id, uint8_t length, uint16_t offset);
+  // Drops all entries.
+  void ClearExtensionInfos();
+
+  // Copies the parsed header fields, but not the buffer, of `packet`.
+  void CopyHeaderFieldsFrom(const RtpPacket& packet);
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -204,8 +227,14 @@ class RtpPacket {
 
   ExtensionManager extensions_;
   std::vector<ExtensionInfo> extension_entries_;
+  // One plus the index in `extension_entries_` of the entry for each id of the
+  // one-byte header range, or 0 if there is none, so that the extensions
+  // commonly used are found without a search.
+  uint8_t extension_entry_index_by_id_
+      [RtpExtension::kOneByteHeaderExtensionMaxId + 1] = {};
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
+  rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool_;
 };
 
 template <typename Extension>
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "api/video/video_rotation.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kPayloadSize = 1100;
+constexpr uint32_t kSsrc = 0x12345678;
+
+// The extensions a typical video packet carries.
+RtpHeaderExtensionMap VideoExtensions() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransmissionOffset>(1);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<VideoOrientation>(4);
+  extensions.Register<RtpMid>(5);
+  return extensions;
+}
+
+void BuildPacket(uint16_t sequence_number, RtpPacketToSend* packet) {
+  packet->SetPayloadType(96);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetTimestamp(sequence_number * 3000);
+  packet->SetSsrc(kSsrc);
+  packet->SetExtension<TransmissionOffset>(sequence_number);
+  packet->SetExtension<AbsoluteSendTime>(sequence_number << 8);
+  packet->SetExtension<TransportSequenceNumber>(sequence_number);
+  packet->SetExtension<VideoOrientation>(kVideoRotation_0);
+  packet->SetExtension<RtpMid>("video");
+  memset(packet->AllocatePayload(kPayloadSize), 0x5a, kPayloadSize);
+}
+
+void BM_RtpPacketBuild(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  uint16_t sequence_number = 0;
+  for (auto s : state) {
+    RtpPacketToSend packet(&extensions);
+    BuildPacket(++sequence_number, &packet);
+    benchmark::DoNotOptimize(packet.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RtpPacketBuild);
+
+// Parses a packet that is shared with, rather than copied from, the receive
+// buffer, as packets coming from the network are.
+void BM_RtpPacketParse(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  RtpPacketToSend packet(&extensions);
+  BuildPacket(1, &packet);
+  const rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+
+  RtpPacketReceived received(&extensions);
+  for (auto s : state) {
+    if (!received.Parse(buffer)) {
+      state.SkipWithError("Failed to parse the packet.");
+      break;
+    }
+    benchmark::DoNotOptimize(received.payload().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RtpPacketParse);
+
+void BM_RtpPacketGetExtensions(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  RtpPacketToSend packet(&extensions);
+  BuildPacket(1, &packet);
+  RtpPacketReceived received(&extensions);
+  received.Parse(packet.Buffer());
+
+  for (auto s : state) {
+    int32_t transmission_offset;
+    uint32_t send_time;
+    uint16_t transport_sequence_number;
+    benchmark::DoNotOptimize(
+        received.GetExtension<TransmissionOffset>(&transmission_offset));
+    benchmark::DoNotOptimize(
+        received.GetExtension<AbsoluteSendTime>(&send_time));
+    benchmark::DoNotOptimize(received.GetExtension<TransportSequenceNumber>(
+        &transport_sequence_number));
+    benchmark::DoNotOptimize(received.GetExtension<RtpMid>());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RtpPacketGetExtensions);
+
+// Rewrites an extension in place, as the pacer does with the transport
+// sequence number of every packet it sends.
+void BM_RtpPacketSetExtension(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  RtpPacketToSend packet(&extensions);
+  BuildPacket(1, &packet);
+  uint16_t transport_sequence_number = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(packet.SetExtension<TransportSequenceNumber>(
+        ++transport_sequence_number));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RtpPacketSetExtension);
+
+}  // namespace
+}  // namespace webrtc
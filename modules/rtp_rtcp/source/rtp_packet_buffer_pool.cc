@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RtpPacketBufferPool::RtpPacketBufferPool(size_t max_pooled_buffers)
+    : max_pooled_buffers_(max_pooled_buffers) {}
+
+RtpPacketBufferPool::~RtpPacketBufferPool() = default;
+
+rtc::CopyOnWriteBuffer RtpPacketBufferPool::Acquire(size_t size,
+                                                    size_t capacity) {
+  RTC_DCHECK_LE(size, capacity);
+  rtc::CopyOnWriteBuffer buffer;
+  {
+    MutexLock lock(&mutex_);
+    // Newest buffers are at the back; they are the most likely to still be
+    // in cache.
+    for (auto it = free_buffers_.rbegin(); it != free_buffers_.rend(); ++it) {
+      if (it->capacity() >= capacity) {
+        buffer = std::move(*it);
+        free_buffers_.erase(std::next(it).base());
+        break;
+      }
+    }
+  }
+  if (buffer.capacity() == 0) {
+    return rtc::CopyOnWriteBuffer(size, capacity);
+  }
+  buffer.SetSize(size);
+  return buffer;
+}
+
+void RtpPacketBufferPool::Recycle(rtc::CopyOnWriteBuffer buffer) {
+  if (!buffer.IsUniquelyOwned()) {
+    return;
+  }
+  buffer.Clear();
+  MutexLock lock(&mutex_);
+  if (free_buffers_.size() < max_pooled_buffers_) {
+    free_buffers_.push_back(std::move(buffer));
+  }
+}
+
+size_t RtpPacketBufferPool::pooled_buffers() const {
+  MutexLock lock(&mutex_);
+  return free_buffers_.size();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/ref_counted_base.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Recycles the storage of RTP packet buffers so that a steady stream of
+// packets does not hit the heap for every packet. Packets constructed with a
+// pool take their buffer from it, and hand the buffer back when they are
+// destroyed, provided nothing else still references the buffer's storage.
+//
+// The pool is reference counted so that packets may outlive the object that
+// created it (e.g. while queued in the pacer). It is thread safe; buffers are
+// typically acquired on one thread and released on another.
+class RtpPacketBufferPool : public rtc::RefCountedBase {
+ public:
+  static constexpr size_t kDefaultMaxPooledBuffers = 32;
+
+  explicit RtpPacketBufferPool(
+      size_t max_pooled_buffers = kDefaultMaxPooledBuffers);
+
+  // Returns a buffer of `size` bytes, with capacity of at least `capacity`
+  // bytes. The content of the buffer is unspecified.
+  rtc::CopyOnWriteBuffer Acquire(size_t size, size_t capacity);
+
+  // Offers `buffer` for reuse. Buffers whose storage is shared with other
+  // CopyOnWriteBuffer instances, and buffers exceeding the pool size limit,
+  // are simply dropped.
+  void Recycle(rtc::CopyOnWriteBuffer buffer);
+
+  size_t pooled_buffers() const;
+
+ protected:
+  ~RtpPacketBufferPool() override;
+
+ private:
+  const size_t max_pooled_buffers_;
+  mutable Mutex mutex_;
+  std::vector<rtc::CopyOnWriteBuffer> free_buffers_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
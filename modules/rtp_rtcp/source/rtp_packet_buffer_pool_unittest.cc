@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kCapacity = 1200;
+constexpr uint8_t kPacket[] = {0x80, 0x60, 0x12, 0x34, 0x00, 0x00,
+                               0x00, 0x01, 0x11, 0x22, 0x33, 0x44,
+                               0xab, 0xcd, 0xef, 0x01};
+
+TEST(RtpPacketBufferPoolTest, ReusesReleasedBuffer) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  rtc::CopyOnWriteBuffer buffer = pool->Acquire(100, kCapacity);
+  EXPECT_EQ(buffer.size(), 100u);
+  EXPECT_GE(buffer.capacity(), kCapacity);
+  const uint8_t* storage = buffer.cdata();
+
+  pool->Recycle(std::move(buffer));
+  EXPECT_EQ(pool->pooled_buffers(), 1u);
+
+  rtc::CopyOnWriteBuffer reused = pool->Acquire(200, kCapacity);
+  EXPECT_EQ(reused.cdata(), storage);
+  EXPECT_EQ(reused.size(), 200u);
+  EXPECT_EQ(pool->pooled_buffers(), 0u);
+}
+
+TEST(RtpPacketBufferPoolTest, DoesNotReuseTooSmallBuffer) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  pool->Recycle(pool->Acquire(10, 100));
+  EXPECT_EQ(pool->pooled_buffers(), 1u);
+
+  rtc::CopyOnWriteBuffer buffer = pool->Acquire(10, kCapacity);
+  EXPECT_GE(buffer.capacity(), kCapacity);
+  EXPECT_EQ(pool->pooled_buffers(), 1u);
+}
+
+TEST(RtpPacketBufferPoolTest, DropsSharedBuffers) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  rtc::CopyOnWriteBuffer buffer = pool->Acquire(100, kCapacity);
+  rtc::CopyOnWriteBuffer slice = buffer.Slice(10, 20);
+  pool->Recycle(std::move(buffer));
+  EXPECT_EQ(pool->pooled_buffers(), 0u);
+
+  pool->Recycle(std::move(slice));
+  EXPECT_EQ(pool->pooled_buffers(), 1u);
+}
+
+TEST(RtpPacketBufferPoolTest, RespectsMaxPooledBuffers) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>(2);
+  rtc::CopyOnWriteBuffer buffers[3] = {pool->Acquire(10, kCapacity),
+                                       pool->Acquire(10, kCapacity),
+                                       pool->Acquire(10, kCapacity)};
+  for (auto& buffer : buffers) {
+    pool->Recycle(std::move(buffer));
+  }
+  EXPECT_EQ(pool->pooled_buffers(), 2u);
+}
+
+TEST(RtpPacketBufferPoolTest, PacketToSendReturnsBufferOnDestruction) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr, kCapacity, pool);
+  const uint8_t* storage = packet->data();
+  packet->SetPayloadSize(500);
+
+  // A copy, e.g. kept in the packet history, keeps the buffer alive.
+  auto copy = std::make_unique<RtpPacketToSend>(*packet);
+  packet.reset();
+  EXPECT_EQ(pool->pooled_buffers(), 0u);
+  copy.reset();
+  EXPECT_EQ(pool->pooled_buffers(), 1u);
+
+  RtpPacketToSend reused(nullptr, kCapacity, pool);
+  EXPECT_EQ(reused.data(), storage);
+  EXPECT_EQ(reused.size(), 12u);
+  EXPECT_EQ(reused.payload_size(), 0u);
+  EXPECT_EQ(reused.Ssrc(), 0u);
+}
+
+TEST(RtpPacketBufferPoolTest, ReceivedPacketRecyclesBothBuffers) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  rtc::CopyOnWriteBuffer incoming = pool->Acquire(sizeof(kPacket), kCapacity);
+  memcpy(incoming.MutableData(), kPacket, sizeof(kPacket));
+  {
+    RtpPacketReceived packet(nullptr, Timestamp::Millis(1), pool);
+    ASSERT_TRUE(packet.Parse(std::move(incoming)));
+    EXPECT_EQ(packet.Ssrc(), 0x11223344u);
+    EXPECT_EQ(packet.payload_size(), 4u);
+    // The buffer allocated on construction is returned once replaced.
+    EXPECT_EQ(pool->pooled_buffers(), 1u);
+  }
+  EXPECT_EQ(pool->pooled_buffers(), 2u);
+}
+
+TEST(RtpPacketBufferPoolTest, PacketsMayOutliveCreator) {
+  auto pool = rtc::make_ref_counted<RtpPacketBufferPool>();
+  RtpPacketToSend packet(nullptr, kCapacity, pool);
+  pool = nullptr;
+  packet.SetPayloadSize(100);
+  EXPECT_EQ(packet.payload_size(), 100u);
+}
+
+}  // namespace
+}  // namespace webrtc
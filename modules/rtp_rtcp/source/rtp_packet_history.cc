@@ -22,6 +22,12 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+
+// Smallest ring buffer allocated once packets are stored.
+constexpr size_t kMinHistoryCapacity = 16;
+
+}  // namespace
 
 RtpPacketHistory::StoredPacket::StoredPacket(
     std::unique_ptr<RtpPacketToSend> packet,
@@ -38,27 +44,8 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
-    PacketPrioritySet* priority_set) {
-  // Check if this StoredPacket is in the priority set. If so, we need to remove
-  // it before updating `times_retransmitted_` since that is used in sorting,
-  // and then add it back.
-  const bool in_priority_set = priority_set && priority_set->erase(this) > 0;
-  ++times_retransmitted_;
-  if (in_priority_set) {
-    auto it = priority_set->insert(this);
-    RTC_DCHECK(it.second)
-        << "ERROR: Priority set already contains matching packet! In set: "
-           "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
-        << ". Trying to add: insert order = " << insert_order_
-        << ", times retransmitted = " << times_retransmitted_;
-  }
-}
-
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
+bool RtpPacketHistory::MoreUseful::operator()(const StoredPacket* lhs,
+                                              const StoredPacket* rhs) const {
   // Prefer to send packets we haven't already sent as padding.
   if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
     return lhs->times_retransmitted() < rhs->times_retransmitted();
@@ -73,7 +60,11 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
-      packets_inserted_(0) {}
+      history_start_(0),
+      history_size_(0),
+      packets_inserted_(0) {
+  padding_priority_.reserve(kMaxPaddingHistory);
+}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -87,6 +78,13 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  // Size the ring buffer for the new configuration up front, so that storing
+  // packets doesn't need to reallocate in the common case.
+  packet_history_.clear();
+  packet_history_.shrink_to_fit();
+  if (mode_ != StorageMode::kDisabled) {
+    Reserve(number_to_store_);
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -121,8 +119,8 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
   if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+      static_cast<size_t>(packet_index) < history_size_ &&
+      PacketAt(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
@@ -131,26 +129,29 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Packet to be inserted ahead of first packet, expand front.
   for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
+    ExpandFront();
   }
   // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  while (static_cast<int>(history_size_) <= packet_index) {
+    ExpandBack();
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, history_size_);
+  StoredPacket& stored_packet = PacketAt(packet_index);
+  RTC_DCHECK(stored_packet.packet_ == nullptr);
 
-  packet_history_[packet_index] =
+  stored_packet =
       StoredPacket(std::move(packet), send_time, packets_inserted_++);
 
   if (enable_padding_prio_) {
     if (padding_priority_.size() >= kMaxPaddingHistory - 1) {
-      padding_priority_.erase(std::prev(padding_priority_.end()));
+      padding_priority_.pop_back();
     }
-    auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
-    RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
+    padding_priority_.insert(
+        std::upper_bound(padding_priority_.begin(), padding_priority_.end(),
+                         &stored_packet, MoreUseful()),
+        &stored_packet);
   }
 }
 
@@ -211,8 +212,7 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->set_send_time(clock_->CurrentTime());
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(enable_padding_prio_ ? &padding_priority_
-                                                           : nullptr);
+  IncrementTimesRetransmitted(packet);
 }
 
 bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
@@ -222,11 +222,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= history_size_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = PacketAt(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -268,14 +267,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
 
   StoredPacket* best_packet = nullptr;
   if (enable_padding_prio_ && !padding_priority_.empty()) {
-    auto best_packet_it = padding_priority_.begin();
-    best_packet = *best_packet_it;
-  } else if (!enable_padding_prio_ && !packet_history_.empty()) {
+    best_packet = padding_priority_.front();
+  } else if (!enable_padding_prio_) {
     // Prioritization not available, pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
+    for (size_t i = history_size_; i > 0; --i) {
+      if (PacketAt(i - 1).packet_ != nullptr) {
+        best_packet = &PacketAt(i - 1);
         break;
       }
     }
@@ -299,8 +296,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   best_packet->set_send_time(clock_->CurrentTime());
-  best_packet->IncrementTimesRetransmitted(
-      enable_padding_prio_ ? &padding_priority_ : nullptr);
+  IncrementTimesRetransmitted(best_packet);
 
   return padding_packet;
 }
@@ -311,7 +307,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+        static_cast<size_t>(packet_index) >= history_size_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -324,7 +320,11 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < history_size_; ++i) {
+    PacketAt(i) = StoredPacket();
+  }
+  history_start_ = 0;
+  history_size_ = 0;
   padding_priority_.clear();
 }
 
@@ -334,15 +334,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (history_size_ > 0) {
+    if (history_size_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = PacketAt(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -353,7 +353,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (history_size_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -370,18 +370,23 @@ void RtpPacketHistory::CullOldPackets() {
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
   // Move the packet out from the StoredPacket container.
+  StoredPacket& stored_packet = PacketAt(packet_index);
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+      std::move(stored_packet.packet_);
 
   // Erase from padding priority set, if eligible.
   if (enable_padding_prio_) {
-    padding_priority_.erase(&packet_history_[packet_index]);
+    auto it = std::find(padding_priority_.begin(), padding_priority_.end(),
+                        &stored_packet);
+    if (it != padding_priority_.end()) {
+      padding_priority_.erase(it);
+    }
   }
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (history_size_ > 0 && PacketAt(0).packet_ == nullptr) {
+      history_start_ = (history_start_ + 1) & (packet_history_.size() - 1);
+      --history_size_;
     }
   }
 
@@ -389,12 +394,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (history_size_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(PacketAt(0).packet_ != nullptr);
+  int first_seq = PacketAt(0).packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -418,11 +423,76 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= history_size_ ||
+      PacketAt(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &PacketAt(index);
+}
+
+void RtpPacketHistory::IncrementTimesRetransmitted(StoredPacket* packet) {
+  auto it = enable_padding_prio_
+                ? std::find(padding_priority_.begin(), padding_priority_.end(),
+                            packet)
+                : padding_priority_.end();
+  packet->IncrementTimesRetransmitted();
+  if (it != padding_priority_.end()) {
+    // The packet just became less useful, move it back to its new position.
+    auto new_position =
+        std::upper_bound(it + 1, padding_priority_.end(), packet, MoreUseful());
+    std::rotate(it, it + 1, new_position);
+  }
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(size_t index) {
+  RTC_DCHECK_LT(index, history_size_);
+  return packet_history_[(history_start_ + index) &
+                         (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(
+    size_t index) const {
+  RTC_DCHECK_LT(index, history_size_);
+  return packet_history_[(history_start_ + index) &
+                         (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::ExpandFront() {
+  if (history_size_ == packet_history_.size()) {
+    Reserve(history_size_ + 1);
+  }
+  history_start_ = (history_start_ - 1) & (packet_history_.size() - 1);
+  ++history_size_;
+}
+
+void RtpPacketHistory::ExpandBack() {
+  if (history_size_ == packet_history_.size()) {
+    Reserve(history_size_ + 1);
+  }
+  ++history_size_;
+}
+
+void RtpPacketHistory::Reserve(size_t min_capacity) {
+  size_t capacity = std::max(packet_history_.size(), kMinHistoryCapacity);
+  while (capacity < min_capacity) {
+    capacity *= 2;
+  }
+  if (capacity == packet_history_.size()) {
+    return;
+  }
+
+  std::vector<StoredPacket> packet_history(capacity);
+  for (size_t i = 0; i < history_size_; ++i) {
+    packet_history[i] = std::move(PacketAt(i));
+  }
+  // Entries in the padding priority set point into the old buffer.
+  for (StoredPacket*& entry : padding_priority_) {
+    size_t slot = entry - packet_history_.data();
+    entry = &packet_history[(slot - history_start_) &
+                            (packet_history_.size() - 1)];
+  }
+  packet_history_ = std::move(packet_history);
+  history_start_ = 0;
 }
 
 }  // namespace webrtc
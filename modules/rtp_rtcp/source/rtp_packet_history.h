@@ -11,10 +11,8 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -125,10 +123,6 @@ class RtpPacketHistory {
   void Clear();
 
  private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
-
   class StoredPacket {
    public:
     StoredPacket() = default;
@@ -141,7 +135,7 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
+    void IncrementTimesRetransmitted() { ++times_retransmitted_; }
 
     // The time of last transmission, including retransmissions.
     Timestamp send_time() const { return send_time_; }
@@ -151,20 +145,20 @@ class RtpPacketHistory {
     std::unique_ptr<RtpPacketToSend> packet_;
 
     // True if the packet is currently in the pacer queue pending transmission.
-    bool pending_transmission_;
+    bool pending_transmission_ = false;
 
    private:
     Timestamp send_time_ = Timestamp::Zero();
 
     // Unique number per StoredPacket, incremented by one for each added
     // packet. Used to sort on insert order.
-    uint64_t insert_order_;
+    uint64_t insert_order_ = 0;
 
     // Number of times RE-transmitted, ie excluding the first transmission.
-    size_t times_retransmitted_;
+    size_t times_retransmitted_ = 0;
   };
   struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
+    bool operator()(const StoredPacket* lhs, const StoredPacket* rhs) const;
   };
 
   // Helper method to check if packet has too recently been sent.
@@ -180,6 +174,20 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Increments the retransmission counter of `packet`, keeping
+  // `padding_priority_` sorted.
+  void IncrementTimesRetransmitted(StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Ring buffer helpers. `index` is relative to the oldest entry.
+  StoredPacket& PacketAt(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& PacketAt(size_t index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Adds an empty entry ahead of the oldest, or after the newest, entry.
+  void ExpandFront() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ExpandBack() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Reallocates the ring buffer to hold at least `min_capacity` entries.
+  void Reserve(size_t min_capacity) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const bool enable_padding_prio_;
@@ -188,19 +196,25 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
+  // Ring buffer of stored packets, ordered by sequence number, with older
+  // packets in the front and new packets being added to the back. Note that
+  // there may be wrap-arounds so the back may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
   // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // entry will however always be populated.
+  // The buffer is sized by the number of packets to store, its size is always
+  // a power of two, and it is only grown if the history outlives that number.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Slot of the oldest entry, and the number of entries in use.
+  size_t history_start_ RTC_GUARDED_BY(lock_);
+  size_t history_size_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
   // Objects from `packet_history_` ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
-  PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // in GetPayloadPaddingPacket(). At most kMaxPaddingHistory entries are kept,
+  // so a sorted array is cheaper to maintain than a tree.
+  std::vector<StoredPacket*> padding_priority_ RTC_GUARDED_BY(lock_);
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
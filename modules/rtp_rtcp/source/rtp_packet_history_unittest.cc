@@ -675,6 +675,37 @@ TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   EXPECT_EQ(hist_.GetPayloadPaddingPacket(), nullptr);
 }
 
+TEST_P(RtpPacketHistoryTest, GrowsBeyondConfiguredSize) {
+  const size_t kHistorySize = 10;
+  const size_t kNumPackets = 100;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kHistorySize);
+
+  // Packets are not culled before kMinPacketDuration, so the history has to
+  // grow. Insert one packet ahead of the first one to grow at the front too.
+  for (size_t i = 1; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+    fake_clock_.AdvanceTimeMilliseconds(1);
+  }
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)));
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 1)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + kNumPackets)));
+
+  // The padding candidates still refer to the right packets.
+  EXPECT_EQ(hist_.GetPayloadPaddingPacket()->SequenceNumber(),
+            GetParam() ? kStartSeqNum : To16u(kStartSeqNum + kNumPackets - 1));
+  hist_.CullAcknowledgedPackets(
+      std::vector<uint16_t>{kStartSeqNum, To16u(kStartSeqNum + 1)});
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+  EXPECT_EQ(hist_.GetPayloadPaddingPacket()->SequenceNumber(),
+            To16u(kStartSeqNum + kNumPackets - 1));
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutPaddingPrio,
                          RtpPacketHistoryTest,
                          ::testing::Bool());
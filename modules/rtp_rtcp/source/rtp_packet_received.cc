@@ -13,18 +13,29 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
+namespace {
+// Same as the default capacity of RtpPacket.
+constexpr size_t kDefaultPacketSize = 1500;
+}  // namespace
 
 RtpPacketReceived::RtpPacketReceived() = default;
 RtpPacketReceived::RtpPacketReceived(
     const ExtensionManager* extensions,
     webrtc::Timestamp arrival_time /*= webrtc::Timestamp::MinusInfinity()*/)
     : RtpPacket(extensions), arrival_time_(arrival_time) {}
+RtpPacketReceived::RtpPacketReceived(
+    const ExtensionManager* extensions,
+    webrtc::Timestamp arrival_time,
+    rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool)
+    : RtpPacket(extensions, kDefaultPacketSize, std::move(buffer_pool)),
+      arrival_time_(arrival_time) {}
 RtpPacketReceived::RtpPacketReceived(const RtpPacketReceived& packet) = default;
 RtpPacketReceived::RtpPacketReceived(RtpPacketReceived&& packet) = default;
 
@@ -31,6 +31,9 @@ class RtpPacketReceived : public RtpPacket {
   explicit RtpPacketReceived(
       const ExtensionManager* extensions,
       webrtc::Timestamp arrival_time = webrtc::Timestamp::MinusInfinity());
+  RtpPacketReceived(const ExtensionManager* extensions,
+                    webrtc::Timestamp arrival_time,
+                    rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool);
   RtpPacketReceived(const RtpPacketReceived& packet);
   RtpPacketReceived(RtpPacketReceived&& packet);
 
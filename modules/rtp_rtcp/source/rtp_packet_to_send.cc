@@ -11,14 +11,26 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
 #include <cstdint>
+#include <utility>
 
 namespace webrtc {
 
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions)
-    : RtpPacket(extensions) {}
+    : RtpPacket(extensions) {
+  live_object_.SetBytes(capacity());
+}
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions,
                                  size_t capacity)
-    : RtpPacket(extensions, capacity) {}
+    : RtpPacket(extensions, capacity) {
+  live_object_.SetBytes(capacity);
+}
+RtpPacketToSend::RtpPacketToSend(
+    const ExtensionManager* extensions,
+    size_t capacity,
+    rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool)
+    : RtpPacket(extensions, capacity, std::move(buffer_pool)) {
+  live_object_.SetBytes(capacity);
+}
 RtpPacketToSend::RtpPacketToSend(const RtpPacketToSend& packet) = default;
 RtpPacketToSend::RtpPacketToSend(RtpPacketToSend&& packet) = default;
 
@@ -28,4 +40,11 @@ RtpPacketToSend& RtpPacketToSend::operator=(RtpPacketToSend&& packet) = default;
 
 RtpPacketToSend::~RtpPacketToSend() = default;
 
+// static
+rtc::LiveObjectCounter& RtpPacketToSend::LiveObjects() {
+  static rtc::LiveObjectCounter* const counter =
+      new rtc::LiveObjectCounter("RtpPacketToSend");
+  return *counter;
+}
+
 }  // namespace webrtc
@@ -24,6 +24,8 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/system/no_unique_address.h"
 
 namespace webrtc {
 // Class to hold rtp packet with metadata for sender side.
@@ -36,6 +38,9 @@ class RtpPacketToSend : public RtpPacket {
 
   explicit RtpPacketToSend(const ExtensionManager* extensions);
   RtpPacketToSend(const ExtensionManager* extensions, size_t capacity);
+  RtpPacketToSend(const ExtensionManager* extensions,
+                  size_t capacity,
+                  rtc::scoped_refptr<RtpPacketBufferPool> buffer_pool);
   RtpPacketToSend(const RtpPacketToSend& packet);
   RtpPacketToSend(RtpPacketToSend&& packet);
 
@@ -121,6 +126,8 @@ class RtpPacketToSend : public RtpPacket {
   bool is_red() const { return is_red_; }
 
  private:
+  static rtc::LiveObjectCounter& LiveObjects();
+
   webrtc::Timestamp capture_time_ = webrtc::Timestamp::Zero();
   absl::optional<RtpPacketMediaType> packet_type_;
   bool allow_retransmission_ = false;
@@ -130,6 +137,7 @@ class RtpPacketToSend : public RtpPacket {
   bool is_key_frame_ = false;
   bool fec_protect_packet_ = false;
   bool is_red_ = false;
+  RTC_NO_UNIQUE_ADDRESS rtc::LiveObject live_object_{LiveObjects()};
 };
 
 }  // namespace webrtc
@@ -238,6 +238,34 @@ TEST(RtpPacketTest, CreateWith2Extensions) {
               ElementsAreArray(packet.data(), packet.size()));
 }
 
+TEST(RtpPacketTest, WriteHeaderFromKeepsOwnBuffer) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketToSend packet(&extensions);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(kSeqNum);
+  packet.SetTimestamp(kTimestamp);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(kTimeOffset);
+  packet.SetExtension<AudioLevel>(kVoiceActive, kAudioLevel);
+  uint8_t* payload = packet.AllocatePayload(sizeof(kPayload));
+  memcpy(payload, kPayload, sizeof(kPayload));
+
+  constexpr size_t kCapacity = 2000;
+  RtpPacketToSend copy(&extensions, kCapacity);
+  copy.WriteHeaderFrom(packet);
+  EXPECT_EQ(copy.capacity(), kCapacity);
+  EXPECT_EQ(copy.payload_size(), 0u);
+  EXPECT_THAT(kPacketWithTOAndAL, ElementsAreArray(copy.data(), copy.size()));
+  EXPECT_EQ(copy.GetExtension<TransmissionOffset>(), kTimeOffset);
+
+  // Writing to the copy doesn't affect the original packet.
+  copy.SetSsrc(kSsrc + 1);
+  EXPECT_EQ(packet.Ssrc(), kSsrc);
+  EXPECT_NE(copy.AllocatePayload(kCapacity - copy.headers_size()), nullptr);
+}
+
 TEST(RtpPacketTest, CreateWithTwoByteHeaderExtensionFirst) {
   RtpPacketToSend::ExtensionManager extensions(true);
   extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
@@ -504,6 +532,22 @@ TEST(RtpPacketTest, ParseWithExtension) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, ParseDropsExtensionsOfPreviousPacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+  EXPECT_TRUE(packet.HasExtension<AudioLevel>());
+
+  EXPECT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+  int32_t time_offset;
+  EXPECT_TRUE(packet.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset, time_offset);
+}
+
 TEST(RtpPacketTest, ParseHeaderOnly) {
   // clang-format off
   constexpr uint8_t kPaddingHeader[] = {
@@ -76,6 +76,7 @@ ModuleRtpRtcpImpl2::RtpSenderContext::RtpSenderContext(
 
 ModuleRtpRtcpImpl2::ModuleRtpRtcpImpl2(const Configuration& configuration)
     : worker_queue_(TaskQueueBase::Current()),
+      tick_scheduler_(configuration.tick_scheduler),
       rtcp_sender_(AddRtcpSendEvaluationCallback(
           RTCPSender::Configuration::FromRtpRtcpConfiguration(configuration),
           [this](TimeDelta duration) {
@@ -90,6 +91,7 @@ ModuleRtpRtcpImpl2::ModuleRtpRtcpImpl2(const Configuration& configuration)
       rtt_stats_(configuration.rtt_stats),
       rtt_ms_(0) {
   RTC_DCHECK(worker_queue_);
+  RTC_DCHECK(!tick_scheduler_ || tick_scheduler_->task_queue() == worker_queue_);
   rtcp_thread_checker_.Detach();
   if (!configuration.receiver_only) {
     rtp_sender_ = std::make_unique<RtpSenderContext>(configuration);
@@ -104,11 +106,17 @@ ModuleRtpRtcpImpl2::ModuleRtpRtcpImpl2(const Configuration& configuration)
   // webrtc::VideoSendStream::Config::Rtp::kDefaultMaxPacketSize.
   const size_t kTcpOverIpv4HeaderSize = 40;
   SetMaxRtpPacketSize(IP_PACKET_SIZE - kTcpOverIpv4HeaderSize);
-  rtt_update_task_ = RepeatingTaskHandle::DelayedStart(
-      worker_queue_, kRttUpdateInterval, [this]() {
-        PeriodicUpdate();
-        return kRttUpdateInterval;
-      });
+  auto periodic_update = [this]() {
+    PeriodicUpdate();
+    return kRttUpdateInterval;
+  };
+  if (tick_scheduler_) {
+    rtt_update_task_ = RepeatingTaskHandle::DelayedStart(
+        tick_scheduler_, kRttUpdateInterval, std::move(periodic_update));
+  } else {
+    rtt_update_task_ = RepeatingTaskHandle::DelayedStart(
+        worker_queue_, kRttUpdateInterval, std::move(periodic_update));
+  }
 }
 
 ModuleRtpRtcpImpl2::~ModuleRtpRtcpImpl2() {
@@ -392,6 +400,12 @@ ModuleRtpRtcpImpl2::FetchFecPackets() {
   return rtp_sender_->packet_sender.FetchFecPackets();
 }
 
+void ModuleRtpRtcpImpl2::OnBatchComplete() {
+  RTC_DCHECK(rtp_sender_);
+  RTC_DCHECK_RUN_ON(&rtp_sender_->sequencing_checker);
+  rtp_sender_->packet_sender.OnBatchComplete();
+}
+
 void ModuleRtpRtcpImpl2::OnPacketsAcknowledged(
     rtc::ArrayView<const uint16_t> sequence_numbers) {
   RTC_DCHECK(rtp_sender_);
@@ -828,6 +842,26 @@ void ModuleRtpRtcpImpl2::ScheduleMaybeSendRtcpAtOrAfterTimestamp(
   // the RTCPSender lock is held.
   // See note in ScheduleRtcpSendEvaluation about why `worker_queue_` can be
   // accessed.
+  if (tick_scheduler_) {
+    // The scheduler can only be used on the worker queue.
+    auto schedule = [this, execution_time] {
+      RTC_DCHECK_RUN_ON(worker_queue_);
+      tick_scheduler_->PostDelayedTask(
+          ToQueuedTask(task_safety_,
+                       [this, execution_time] {
+                         RTC_DCHECK_RUN_ON(worker_queue_);
+                         MaybeSendRtcpAtOrAfterTimestamp(execution_time);
+                       }),
+          std::max(execution_time - clock_->CurrentTime(), TimeDelta::Zero()));
+    };
+    if (worker_queue_->IsCurrent()) {
+      schedule();
+    } else {
+      worker_queue_->PostTask(ToQueuedTask(task_safety_, std::move(schedule)));
+    }
+    return;
+  }
+
   worker_queue_->PostDelayedTask(
       ToQueuedTask(task_safety_,
                    [this, execution_time] {
@@ -39,6 +39,7 @@
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/task_utils/to_queued_task.h"
@@ -157,6 +158,8 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
 
   std::vector<std::unique_ptr<RtpPacketToSend>> FetchFecPackets() override;
 
+  void OnBatchComplete() override;
+
   void OnPacketsAcknowledged(
       rtc::ArrayView<const uint16_t> sequence_numbers) override;
 
@@ -309,6 +312,8 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
                                                TimeDelta duration);
 
   TaskQueueBase* const worker_queue_;
+  // Optional, runs on `worker_queue_`.
+  MetronomeTaskScheduler* const tick_scheduler_;
   RTC_NO_UNIQUE_ADDRESS SequenceChecker rtcp_thread_checker_;
 
   std::unique_ptr<RtpSenderContext> rtp_sender_;
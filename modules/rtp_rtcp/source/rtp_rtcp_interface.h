@@ -33,6 +33,7 @@ namespace webrtc {
 
 // Forward declarations.
 class FrameEncryptorInterface;
+class MetronomeTaskScheduler;
 class RateLimiter;
 class RemoteBitrateEstimator;
 class RtcEventLog;
@@ -106,6 +107,12 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
 
     int rtcp_report_interval_ms = 0;
 
+    // If set, the delayed RTCP report evaluations and the periodic RTT update
+    // run on the metronome ticks of `tick_scheduler`, coalesced with the other
+    // timers on its task queue. Only used by ModuleRtpRtcpImpl2, which must
+    // then be created on the scheduler's task queue.
+    MetronomeTaskScheduler* tick_scheduler = nullptr;
+
     // Update network2 instead of pacer_exit field of video timing extension.
     bool populate_network2_timestamp = false;
 
@@ -147,6 +154,10 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
     // Estimate RTT as non-sender as described in
     // https://tools.ietf.org/html/rfc3611#section-4.4 and #section-4.5
     bool non_sender_rtt_measurement = false;
+
+    // If true, packets sent by TrySendPacket() are held and handed to the
+    // transport as one batch when OnBatchComplete() is called.
+    bool enable_send_packet_batching = false;
   };
 
   // Stats for RTCP sender reports (SR) for a specific SSRC.
@@ -335,6 +346,10 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
   // returned from the FEC generator.
   virtual std::vector<std::unique_ptr<RtpPacketToSend>> FetchFecPackets() = 0;
 
+  // Called by the pacer when a burst of packets sent by TrySendPacket() is
+  // complete. Only has an effect if `enable_send_packet_batching` is set.
+  virtual void OnBatchComplete() {}
+
   virtual void OnPacketsAcknowledged(
       rtc::ArrayView<const uint16_t> sequence_numbers) = 0;
 
@@ -32,6 +32,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/rate_limiter.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -153,6 +154,24 @@ double GetMaxPaddingSizeFactor(const WebRtcKeyValueConfig* field_trials) {
   return factor.Value();
 }
 
+// TODO(danilchap): Find better motivator and value for extra capacity.
+// RtpPacketizer might slightly miscalulate needed size.
+// While sending slightly oversized packet increase chance of dropped packet,
+// it is better than crash on drop packet without trying to send it.
+// The extra space also fits the SRTP authentication tag, letting SRTP encrypt
+// the packet in place instead of copying it into a larger buffer.
+constexpr size_t kExtraCapacity = 16;
+
+rtc::scoped_refptr<RtpPacketBufferPool> MaybeCreatePacketBufferPool(
+    const WebRtcKeyValueConfig* field_trials) {
+  if (field_trials &&
+      absl::StartsWith(field_trials->Lookup("WebRTC-RtpPacketBufferPool"),
+                       "Enabled")) {
+    return rtc::make_ref_counted<RtpPacketBufferPool>();
+  }
+  return nullptr;
+}
+
 }  // namespace
 
 RTPSender::RTPSender(const RtpRtcpInterface::Configuration& config,
@@ -174,6 +193,7 @@ RTPSender::RTPSender(const RtpRtcpInterface::Configuration& config,
       max_padding_size_factor_(GetMaxPaddingSizeFactor(config.field_trials)),
       packet_history_(packet_history),
       paced_sender_(packet_sender),
+      packet_buffer_pool_(MaybeCreatePacketBufferPool(config.field_trials)),
       sending_media_(true),                   // Default to sending media.
       max_packet_size_(IP_PACKET_SIZE - 28),  // Default is IP-v4/UDP.
       rtp_header_extension_map_(config.extmap_allow_mixed),
@@ -436,43 +456,29 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     padding_bytes_in_packet = rtc::SafeMin(max_payload_size, kMaxPaddingLength);
   }
 
-  while (bytes_left > 0) {
-    auto padding_packet =
-        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
-    padding_packet->set_packet_type(RtpPacketMediaType::kPadding);
-    padding_packet->SetMarker(false);
-    if (rtx_ == kRtxOff) {
-      if (!can_send_padding_on_media_ssrc) {
-        break;
-      }
-      padding_packet->SetSsrc(ssrc_);
-    } else {
-      // Without abs-send-time or transport sequence number a media packet
-      // must be sent before padding so that the timestamps used for
-      // estimation are correct.
-      if (!media_has_been_sent &&
-          !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
-            rtp_header_extension_map_.IsRegistered(
-                TransportSequenceNumber::kId))) {
-        break;
-      }
-
-      RTC_DCHECK(rtx_ssrc_);
-      RTC_DCHECK(!rtx_payload_type_map_.empty());
-      padding_packet->SetSsrc(*rtx_ssrc_);
-      padding_packet->SetPayloadType(rtx_payload_type_map_.begin()->second);
-    }
-
-    if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
-      padding_packet->ReserveExtension<TransportSequenceNumber>();
-    }
-    if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
-      padding_packet->ReserveExtension<TransmissionOffset>();
+  if (rtx_ == kRtxOff) {
+    if (!can_send_padding_on_media_ssrc) {
+      return padding_packets;
     }
-    if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
-      padding_packet->ReserveExtension<AbsoluteSendTime>();
+  } else {
+    // Without abs-send-time or transport sequence number a media packet
+    // must be sent before padding so that the timestamps used for
+    // estimation are correct.
+    if (!media_has_been_sent &&
+        !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
+          rtp_header_extension_map_.IsRegistered(
+              TransportSequenceNumber::kId))) {
+      return padding_packets;
     }
+  }
 
+  const RtpPacketToSend& padding_template = PaddingTemplate();
+  while (bytes_left > 0) {
+    auto padding_packet = std::make_unique<RtpPacketToSend>(
+        &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity,
+        packet_buffer_pool_);
+    padding_packet->WriteHeaderFrom(padding_template);
+    padding_packet->set_packet_type(RtpPacketMediaType::kPadding);
     padding_packet->SetPadding(padding_bytes_in_packet);
     bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
     padding_packets.push_back(std::move(padding_packet));
@@ -525,15 +531,9 @@ size_t RTPSender::ExpectedPerPacketOverhead() const {
 
 std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket() const {
   MutexLock lock(&send_mutex_);
-  // TODO(danilchap): Find better motivator and value for extra capacity.
-  // RtpPacketizer might slightly miscalulate needed size,
-  // SRTP may benefit from extra space in the buffer and do encryption in place
-  // saving reallocation.
-  // While sending slightly oversized packet increase chance of dropped packet,
-  // it is better than crash on drop packet without trying to send it.
-  static constexpr int kExtraCapacity = 16;
   auto packet = std::make_unique<RtpPacketToSend>(
-      &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity);
+      &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity,
+      packet_buffer_pool_);
   packet->SetSsrc(ssrc_);
   packet->SetCsrcs(csrcs_);
   // Reserve extensions, if registered, RtpSender set in SendToNetwork.
@@ -677,15 +677,29 @@ std::unique_ptr<RtpPacketToSend> RTPSender::BuildRtxPacket(
     if (kv == rtx_payload_type_map_.end())
       return nullptr;
 
-    rtx_packet = std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_,
-                                                   max_packet_size_);
+    rtx_packet = std::make_unique<RtpPacketToSend>(
+        &rtp_header_extension_map_, max_packet_size_ + kExtraCapacity,
+        packet_buffer_pool_);
+
+    // Unless stream ID header extensions need to be removed, the header of
+    // the original packet is copied as a whole, rather than extension by
+    // extension.
+    const bool copy_whole_header = packet.padding_size() == 0 &&
+                                   !packet.HasExtension<RtpMid>() &&
+                                   !packet.HasExtension<RtpStreamId>();
+    if (copy_whole_header) {
+      rtx_packet->WriteHeaderFrom(packet);
+      // RTX has a separate sequence numbering.
+      rtx_packet->SetSequenceNumber(0);
+    }
 
     rtx_packet->SetPayloadType(kv->second);
 
     // Replace SSRC.
     rtx_packet->SetSsrc(*rtx_ssrc_);
 
-    CopyHeaderAndExtensionsToRtxPacket(packet, rtx_packet.get());
+    if (!copy_whole_header)
+      CopyHeaderAndExtensionsToRtxPacket(packet, rtx_packet.get());
 
     // RTX packets are sent on an SSRC different from the main media, so the
     // decision to attach MID and/or RRID header extensions is completely
@@ -760,7 +774,39 @@ RtpState RTPSender::GetRtxRtpState() const {
   return state;
 }
 
+// RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_)
+const RtpPacketToSend& RTPSender::PaddingTemplate() {
+  absl::optional<RtpPacketToSend>& padding_template =
+      rtx_ == kRtxOff ? media_padding_template_ : rtx_padding_template_;
+  int payload_type = 0;
+  if (rtx_ != kRtxOff) {
+    RTC_DCHECK(rtx_ssrc_);
+    RTC_DCHECK(!rtx_payload_type_map_.empty());
+    payload_type = rtx_payload_type_map_.begin()->second;
+  }
+  if (padding_template && padding_template->PayloadType() == payload_type)
+    return *padding_template;
+
+  padding_template.emplace(&rtp_header_extension_map_);
+  padding_template->SetMarker(false);
+  padding_template->SetSsrc(rtx_ == kRtxOff ? ssrc_ : *rtx_ssrc_);
+  padding_template->SetPayloadType(payload_type);
+  if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
+    padding_template->ReserveExtension<TransportSequenceNumber>();
+  }
+  if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
+    padding_template->ReserveExtension<TransmissionOffset>();
+  }
+  if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
+    padding_template->ReserveExtension<AbsoluteSendTime>();
+  }
+  return *padding_template;
+}
+
 void RTPSender::UpdateHeaderSizes() {
+  media_padding_template_.reset();
+  rtx_padding_template_.reset();
+
   const size_t rtp_header_length =
       kRtpHeaderLength + sizeof(uint32_t) * csrcs_.size();
 
@@ -21,12 +21,14 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/call/transport.h"
+#include "api/scoped_refptr.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/rtp_rtcp/include/flexfec_sender.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/packet_sequencer.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
@@ -175,6 +177,10 @@ class RTPSender {
 
   void UpdateHeaderSizes() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
 
+  // Returns the header of plain padding packets on the current padding SSRC.
+  const RtpPacketToSend& PaddingTemplate()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
+
   void UpdateLastPacketState(const RtpPacketToSend& packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
 
@@ -192,6 +198,9 @@ class RTPSender {
 
   RtpPacketHistory* const packet_history_;
   RtpPacketSender* const paced_sender_;
+  // Recycles media and RTX packet buffers once the packets have been sent.
+  // Null unless the "WebRTC-RtpPacketBufferPool" field trial is enabled.
+  const rtc::scoped_refptr<RtpPacketBufferPool> packet_buffer_pool_;
 
   mutable Mutex send_mutex_;
 
@@ -201,6 +210,13 @@ class RTPSender {
   RtpHeaderExtensionMap rtp_header_extension_map_ RTC_GUARDED_BY(send_mutex_);
   size_t max_media_packet_header_ RTC_GUARDED_BY(send_mutex_);
   size_t max_padding_fec_packet_header_ RTC_GUARDED_BY(send_mutex_);
+  // Headers of plain padding packets on the media and the RTX SSRC, with the
+  // extensions that are written at send time reserved. Each padding packet
+  // starts as a copy of one of them. Reset when the header extensions change.
+  absl::optional<RtpPacketToSend> media_padding_template_
+      RTC_GUARDED_BY(send_mutex_);
+  absl::optional<RtpPacketToSend> rtx_padding_template_
+      RTC_GUARDED_BY(send_mutex_);
 
   // RTP variables
   uint32_t timestamp_offset_ RTC_GUARDED_BY(send_mutex_);
@@ -19,6 +19,7 @@
 #include "api/transport/field_trial_based_config.h"
 #include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/rate_statistics.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 
 namespace webrtc {
@@ -26,6 +27,7 @@ namespace {
 constexpr uint32_t kTimestampTicksPerMs = 90;
 constexpr int kSendSideDelayWindowMs = 1000;
 constexpr int kBitrateStatisticsWindowMs = 1000;
+constexpr int kBitrateStatisticsBucketMs = 10;
 constexpr size_t kRtpSequenceNumberMapMaxEntries = 1 << 13;
 constexpr TimeDelta kUpdateInterval =
     TimeDelta::Millis(kBitrateStatisticsWindowMs);
@@ -53,6 +55,7 @@ void RtpSenderEgress::NonPacedPacketSender::EnqueuePackets(
     PrepareForSend(packet.get());
     sender_->SendPacket(packet.get(), PacedPacketInfo());
   }
+  sender_->OnBatchComplete();
   auto fec_packets = sender_->FetchFecPackets();
   if (!fec_packets.empty()) {
     EnqueuePackets(std::move(fec_packets));
@@ -94,6 +97,10 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcpInterface::Configuration& config,
       is_audio_(config.audio),
 #endif
       need_rtp_packet_infos_(config.need_rtp_packet_infos),
+      enable_send_packet_batching_(config.enable_send_packet_batching),
+      generate_fec_after_send_(IsTrialSetTo(config.field_trials,
+                                            "WebRTC-GenerateFecAfterSend",
+                                            "Enabled")),
       fec_generator_(config.fec_generator),
       transport_feedback_observer_(config.transport_feedback_callback),
       send_side_delay_observer_(config.send_side_delay_observer),
@@ -107,7 +114,8 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcpInterface::Configuration& config,
       sum_delays_ms_(0),
       total_packet_send_delay_ms_(0),
       send_rates_(kNumMediaTypes,
-                  {kBitrateStatisticsWindowMs, RateStatistics::kBpsScale}),
+                  {kBitrateStatisticsWindowMs, RateStatistics::kBpsScale,
+                   kBitrateStatisticsBucketMs}),
       rtp_sequence_number_map_(need_rtp_packet_infos_
                                    ? std::make_unique<RtpSequenceNumberMap>(
                                          kRtpSequenceNumberMapMaxEntries)
@@ -182,39 +190,10 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
         }));
   }
 
-  if (fec_generator_ && packet->fec_protect_packet()) {
+  if (fec_generator_ && packet->fec_protect_packet() &&
+      !generate_fec_after_send_) {
     // This packet should be protected by FEC, add it to packet generator.
-    RTC_DCHECK(fec_generator_);
-    RTC_DCHECK(packet->packet_type() == RtpPacketMediaType::kVideo);
-    absl::optional<std::pair<FecProtectionParams, FecProtectionParams>>
-        new_fec_params;
-    {
-      MutexLock lock(&lock_);
-      new_fec_params.swap(pending_fec_params_);
-    }
-    if (new_fec_params) {
-      fec_generator_->SetProtectionParameters(new_fec_params->first,
-                                              new_fec_params->second);
-    }
-    if (packet->is_red()) {
-      RtpPacketToSend unpacked_packet(*packet);
-
-      const rtc::CopyOnWriteBuffer buffer = packet->Buffer();
-      // Grab media payload type from RED header.
-      const size_t headers_size = packet->headers_size();
-      unpacked_packet.SetPayloadType(buffer[headers_size]);
-
-      // Copy the media payload into the unpacked buffer.
-      uint8_t* payload_buffer =
-          unpacked_packet.SetPayloadSize(packet->payload_size() - 1);
-      std::copy(&packet->payload()[0] + 1,
-                &packet->payload()[0] + packet->payload_size(), payload_buffer);
-
-      fec_generator_->AddPacketAndGenerateFec(unpacked_packet);
-    } else {
-      // If not RED encapsulated - we can just insert packet directly.
-      fec_generator_->AddPacketAndGenerateFec(*packet);
-    }
+    AddPacketToFecGenerator(*packet);
   }
 
   // Bug webrtc:7859. While FEC is invoked from rtp_sender_video, and not after
@@ -270,7 +249,25 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
                        packet_ssrc);
   }
 
-  const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
+  bool send_success;
+  if (enable_send_packet_batching_) {
+    // The packet is accounted for as sent now; only the hand-off to the
+    // transport is deferred until the pacer signals the end of the burst.
+    options.batchable = true;
+    packets_to_send_.push_back(
+        PendingNetworkPacket{*packet, std::move(options), pacing_info});
+    send_success = true;
+  } else {
+    send_success = SendPacketToNetwork(*packet, options, pacing_info);
+  }
+
+  if (fec_generator_ && packet->fec_protect_packet() &&
+      generate_fec_after_send_) {
+    // The FEC packets are generated once the last packet of a frame has been
+    // added, so doing it only now keeps FEC encoding from delaying that packet.
+    // It also makes the FEC packets protect the header extensions as sent.
+    AddPacketToFecGenerator(*packet);
+  }
 
   // Put packet in retransmission history or update pending status even if
   // actual sending fails.
@@ -383,6 +380,40 @@ void RtpSenderEgress::SetFecProtectionParameters(
   pending_fec_params_.emplace(delta_params, key_params);
 }
 
+void RtpSenderEgress::AddPacketToFecGenerator(const RtpPacketToSend& packet) {
+  RTC_DCHECK(fec_generator_);
+  RTC_DCHECK(packet.packet_type() == RtpPacketMediaType::kVideo);
+  absl::optional<std::pair<FecProtectionParams, FecProtectionParams>>
+      new_fec_params;
+  {
+    MutexLock lock(&lock_);
+    new_fec_params.swap(pending_fec_params_);
+  }
+  if (new_fec_params) {
+    fec_generator_->SetProtectionParameters(new_fec_params->first,
+                                            new_fec_params->second);
+  }
+  if (packet.is_red()) {
+    RtpPacketToSend unpacked_packet(packet);
+
+    const rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+    // Grab media payload type from RED header.
+    const size_t headers_size = packet.headers_size();
+    unpacked_packet.SetPayloadType(buffer[headers_size]);
+
+    // Copy the media payload into the unpacked buffer.
+    uint8_t* payload_buffer =
+        unpacked_packet.SetPayloadSize(packet.payload_size() - 1);
+    std::copy(&packet.payload()[0] + 1,
+              &packet.payload()[0] + packet.payload_size(), payload_buffer);
+
+    fec_generator_->AddPacketAndGenerateFec(unpacked_packet);
+  } else {
+    // If not RED encapsulated - we can just insert packet directly.
+    fec_generator_->AddPacketAndGenerateFec(packet);
+  }
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>>
 RtpSenderEgress::FetchFecPackets() {
   RTC_DCHECK_RUN_ON(&pacer_checker_);
@@ -545,12 +576,24 @@ void RtpSenderEgress::UpdateOnSendPacket(int packet_id,
   send_packet_observer_->OnSendPacket(packet_id, capture_time_ms, ssrc);
 }
 
+void RtpSenderEgress::OnBatchComplete() {
+  RTC_DCHECK_RUN_ON(&pacer_checker_);
+  if (packets_to_send_.empty()) {
+    return;
+  }
+  packets_to_send_.back().options.last_packet_in_batch = true;
+  for (const PendingNetworkPacket& pending : packets_to_send_) {
+    SendPacketToNetwork(pending.packet, pending.options, pending.pacing_info);
+  }
+  packets_to_send_.clear();
+}
+
 bool RtpSenderEgress::SendPacketToNetwork(const RtpPacketToSend& packet,
                                           const PacketOptions& options,
                                           const PacedPacketInfo& pacing_info) {
   int bytes_sent = -1;
   if (transport_) {
-    bytes_sent = transport_->SendRtp(packet.data(), packet.size(), options)
+    bytes_sent = transport_->SendRtpBuffer(packet.Buffer(), options)
                      ? static_cast<int>(packet.size())
                      : -1;
     if (event_log_ && bytes_sent > 0) {
@@ -29,7 +29,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
-#include "rtc_base/rate_statistics.h"
+#include "rtc_base/bucketed_rate_statistics.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
@@ -91,6 +91,10 @@ class RtpSenderEgress {
                                   const FecProtectionParams& key_params);
   std::vector<std::unique_ptr<RtpPacketToSend>> FetchFecPackets();
 
+  // Hands packets held back since the last call to the transport, marking the
+  // last one as the end of the batch. No-op unless packet batching is enabled.
+  void OnBatchComplete();
+
  private:
   // Maps capture time in milliseconds to send-side delay in milliseconds.
   // Send-side delay is the difference between transmission time and capture
@@ -110,6 +114,14 @@ class RtpSenderEgress {
   void UpdateOnSendPacket(int packet_id,
                           int64_t capture_time_ms,
                           uint32_t ssrc);
+  void AddPacketToFecGenerator(const RtpPacketToSend& packet)
+      RTC_RUN_ON(pacer_checker_);
+  struct PendingNetworkPacket {
+    RtpPacketToSend packet;
+    PacketOptions options;
+    PacedPacketInfo pacing_info;
+  };
+
   // Sends packet on to `transport_`, leaving the RTP module.
   bool SendPacketToNetwork(const RtpPacketToSend& packet,
                            const PacketOptions& options,
@@ -142,9 +154,16 @@ class RtpSenderEgress {
   const bool is_audio_;
 #endif
   const bool need_rtp_packet_infos_;
+  const bool enable_send_packet_batching_;
+  // If set, media packets are added to `fec_generator_` after being sent
+  // instead of before.
+  const bool generate_fec_after_send_;
   VideoFecGenerator* const fec_generator_ RTC_GUARDED_BY(pacer_checker_);
   absl::optional<uint16_t> last_sent_seq_ RTC_GUARDED_BY(pacer_checker_);
   absl::optional<uint16_t> last_sent_rtx_seq_ RTC_GUARDED_BY(pacer_checker_);
+  // Packets waiting for OnBatchComplete() when batching is enabled.
+  std::vector<PendingNetworkPacket> packets_to_send_
+      RTC_GUARDED_BY(pacer_checker_);
 
   TransportFeedbackObserver* const transport_feedback_observer_;
   SendSideDelayObserver* const send_side_delay_observer_;
@@ -165,7 +184,7 @@ class RtpSenderEgress {
   StreamDataCounters rtp_stats_ RTC_GUARDED_BY(lock_);
   StreamDataCounters rtx_rtp_stats_ RTC_GUARDED_BY(lock_);
   // One element per value in RtpPacketMediaType, with index matching value.
-  std::vector<RateStatistics> send_rates_ RTC_GUARDED_BY(lock_);
+  std::vector<BucketedRateStatistics> send_rates_ RTC_GUARDED_BY(lock_);
   absl::optional<std::pair<FecProtectionParams, FecProtectionParams>>
       pending_fec_params_ RTC_GUARDED_BY(lock_);
 
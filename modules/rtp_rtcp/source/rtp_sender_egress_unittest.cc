@@ -261,6 +261,61 @@ TEST_P(RtpSenderEgressTest, DoesnSetIncludedInAllocationByDefault) {
   EXPECT_FALSE(transport_.last_packet()->options.included_in_allocation);
 }
 
+TEST_P(RtpSenderEgressTest, HoldsPacketsUntilBatchCompleteWhenBatching) {
+  RtpRtcp::Configuration config = DefaultConfig();
+  config.enable_send_packet_batching = true;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+
+  std::unique_ptr<RtpPacketToSend> first_packet = BuildRtpPacket();
+  std::unique_ptr<RtpPacketToSend> second_packet = BuildRtpPacket();
+  sender->SendPacket(first_packet.get(), PacedPacketInfo());
+  sender->SendPacket(second_packet.get(), PacedPacketInfo());
+  EXPECT_FALSE(transport_.last_packet().has_value());
+
+  sender->OnBatchComplete();
+  ASSERT_TRUE(transport_.last_packet().has_value());
+  EXPECT_EQ(transport_.last_packet()->packet.SequenceNumber(),
+            second_packet->SequenceNumber());
+  EXPECT_TRUE(transport_.last_packet()->options.batchable);
+  EXPECT_TRUE(transport_.last_packet()->options.last_packet_in_batch);
+}
+
+TEST_P(RtpSenderEgressTest, DoesNotMarkPacketsBatchableByDefault) {
+  std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
+
+  std::unique_ptr<RtpPacketToSend> packet = BuildRtpPacket();
+  sender->SendPacket(packet.get(), PacedPacketInfo());
+  EXPECT_FALSE(transport_.last_packet()->options.batchable);
+  EXPECT_FALSE(transport_.last_packet()->options.last_packet_in_batch);
+}
+
+TEST_P(RtpSenderEgressTest, SharesPacketBufferWithTransport) {
+  class BufferTransport : public Transport {
+   public:
+    bool SendRtp(const uint8_t*, size_t, const PacketOptions&) override {
+      ADD_FAILURE() << "Packet was not sent as a buffer.";
+      return false;
+    }
+    bool SendRtpBuffer(rtc::CopyOnWriteBuffer packet,
+                       const PacketOptions&) override {
+      last_buffer = std::move(packet);
+      return true;
+    }
+    bool SendRtcp(const uint8_t*, size_t) override { return false; }
+
+    rtc::CopyOnWriteBuffer last_buffer;
+  } transport;
+  RtpRtcp::Configuration config = DefaultConfig();
+  config.outgoing_transport = &transport;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+
+  std::unique_ptr<RtpPacketToSend> packet = BuildRtpPacket();
+  sender->SendPacket(packet.get(), PacedPacketInfo());
+  // No copy is made on the way to the transport, so SRTP may protect the
+  // buffer in place once the egress drops its reference.
+  EXPECT_EQ(transport.last_buffer.cdata(), packet->data());
+}
+
 TEST_P(RtpSenderEgressTest,
        SetsIncludedInFeedbackWhenTransportSequenceNumberExtensionIsRegistered) {
   std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
@@ -963,6 +1018,53 @@ TEST_P(RtpSenderEgressTest, TransportFeedbackObserverFec) {
   sender->SendPacket(fec_packet.get(), PacedPacketInfo());
 }
 
+TEST_P(RtpSenderEgressTest, GeneratesFecAfterSendingMediaPacket) {
+  class GenerateFecAfterSendTrials : public WebRtcKeyValueConfig {
+   public:
+    std::string Lookup(absl::string_view key) const override {
+      return key == "WebRTC-GenerateFecAfterSend" ? "Enabled" : "";
+    }
+  } trials;
+  const rtc::ArrayView<const RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+  FlexfecSender flexfec(kFlexfectPayloadType, kFlexFecSsrc, kSsrc, /*mid=*/"",
+                        /*header_extensions=*/{}, kNoRtpHeaderExtensionSizes,
+                        /*rtp_state=*/nullptr, time_controller_.GetClock());
+
+  class FecCheckingTransport : public Transport {
+   public:
+    explicit FecCheckingTransport(FlexfecSender* flexfec) : flexfec_(flexfec) {}
+    bool SendRtp(const uint8_t*, size_t, const PacketOptions&) override {
+      fec_packets_before_send = flexfec_->GetFecPackets().size();
+      return true;
+    }
+    bool SendRtcp(const uint8_t*, size_t) override { return false; }
+
+    size_t fec_packets_before_send = 0;
+
+   private:
+    FlexfecSender* const flexfec_;
+  } transport(&flexfec);
+
+  RtpRtcpInterface::Configuration config = DefaultConfig();
+  config.outgoing_transport = &transport;
+  config.fec_generator = &flexfec;
+  config.field_trials = &trials;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+  FecProtectionParams params;
+  params.fec_rate = 255;
+  params.max_fec_frames = 1;
+  sender->SetFecProtectionParameters(params, params);
+
+  std::unique_ptr<RtpPacketToSend> packet = BuildRtpPacket();
+  packet->SetPayloadSize(100);
+  packet->set_fec_protect_packet(true);
+  sender->SendPacket(packet.get(), PacedPacketInfo());
+
+  // The packet completes a frame, but it was sent before FEC was generated.
+  EXPECT_EQ(transport.fec_packets_before_send, 0u);
+  EXPECT_EQ(sender->FetchFecPackets().size(), 1u);
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutOverhead,
                          RtpSenderEgressTest,
                          ::testing::Values(TestConfig(false),
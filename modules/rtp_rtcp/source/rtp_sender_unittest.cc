@@ -1216,6 +1216,36 @@ TEST_F(RtpSenderTest, GeneratePaddingCreatesPurePaddingWithoutRtx) {
             kExpectedNumPaddingPackets * kMaxPaddingSize);
 }
 
+TEST_F(RtpSenderTest, PaddingFollowsHeaderExtensionChanges) {
+  auto generate_padding = [&] {
+    return rtp_sender_->GeneratePadding(
+        /*target_size_bytes=*/1, /*media_has_been_sent=*/true,
+        /*can_send_padding_on_media_ssrc=*/true);
+  };
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      TransportSequenceNumber::Uri(), kTransportSequenceNumberExtensionId));
+  std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
+      generate_padding();
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_TRUE(padding_packets[0]->HasExtension<TransportSequenceNumber>());
+  EXPECT_FALSE(padding_packets[0]->HasExtension<AbsoluteSendTime>());
+
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      AbsoluteSendTime::Uri(), kAbsoluteSendTimeExtensionId));
+  padding_packets = generate_padding();
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_TRUE(padding_packets[0]->HasExtension<TransportSequenceNumber>());
+  EXPECT_TRUE(padding_packets[0]->HasExtension<AbsoluteSendTime>());
+
+  // Switching to RTX moves the padding to the RTX SSRC.
+  EnableRtx();
+  padding_packets = generate_padding();
+  ASSERT_THAT(padding_packets, SizeIs(1));
+  EXPECT_EQ(padding_packets[0]->Ssrc(), kRtxSsrc);
+  EXPECT_EQ(padding_packets[0]->PayloadType(), kRtxPayload);
+  EXPECT_TRUE(padding_packets[0]->HasExtension<AbsoluteSendTime>());
+}
+
 TEST_F(RtpSenderTest, SupportsPadding) {
   bool kSendingMediaStats[] = {true, false};
   bool kEnableRedundantPayloads[] = {true, false};
@@ -49,16 +49,20 @@ constexpr int64_t kMaxUnretransmittableFrameIntervalMs = 33 * 4;
 constexpr char kIncludeCaptureClockOffset[] =
     "WebRTC-IncludeCaptureClockOffset";
 
-void BuildRedPayload(const RtpPacketToSend& media_packet,
-                     RtpPacketToSend* red_packet) {
-  uint8_t* red_payload = red_packet->AllocatePayload(
-      kRedForFecHeaderLength + media_packet.payload_size());
+// Wraps the payload of `packet` in a RED header in place. The packet capacity
+// accounts for the header, see FecPacketOverhead(), so this neither allocates
+// nor copies the packet into a new buffer.
+void EncapsulateRed(int red_payload_type, RtpPacketToSend* packet) {
+  const uint8_t media_payload_type = packet->PayloadType();
+  const size_t media_payload_size = packet->payload_size();
+  uint8_t* red_payload =
+      packet->SetPayloadSize(kRedForFecHeaderLength + media_payload_size);
   RTC_DCHECK(red_payload);
-  red_payload[0] = media_packet.PayloadType();
-
-  auto media_payload = media_packet.payload();
-  memcpy(&red_payload[kRedForFecHeaderLength], media_payload.data(),
-         media_payload.size());
+  memmove(&red_payload[kRedForFecHeaderLength], red_payload,
+          media_payload_size);
+  red_payload[0] = media_payload_type;
+  packet->SetPayloadType(red_payload_type);
+  packet->set_is_red(true);
 }
 
 bool MinimizeDescriptor(RTPVideoHeader* video_header) {
@@ -315,7 +319,56 @@ void RTPSenderVideo::SetVideoLayersAllocationInternal(
   allocation_ = std::move(allocation);
 }
 
+RTPSenderVideo::FrameDescriptors RTPSenderVideo::BuildFrameDescriptors(
+    const RTPVideoHeader& video_header) const {
+  FrameDescriptors descriptors;
+  if (!video_header.generic)
+    return descriptors;
+
+  if (video_structure_ != nullptr) {
+    DependencyDescriptor& descriptor =
+        descriptors.dependency_descriptor.emplace();
+    descriptor.frame_number = video_header.generic->frame_id & 0xFFFF;
+    descriptor.frame_dependencies.spatial_id =
+        video_header.generic->spatial_index;
+    descriptor.frame_dependencies.temporal_id =
+        video_header.generic->temporal_index;
+    for (int64_t dep : video_header.generic->dependencies) {
+      descriptor.frame_dependencies.frame_diffs.push_back(
+          video_header.generic->frame_id - dep);
+    }
+    descriptor.frame_dependencies.chain_diffs =
+        video_header.generic->chain_diffs;
+    descriptor.frame_dependencies.decode_target_indications =
+        video_header.generic->decode_target_indications;
+    RTC_DCHECK_EQ(
+        descriptor.frame_dependencies.decode_target_indications.size(),
+        video_structure_->num_decode_targets);
+  }
+
+  RtpGenericFrameDescriptor& generic_descriptor =
+      descriptors.generic_descriptor.emplace();
+  generic_descriptor.SetFirstPacketInSubFrame(true);
+  generic_descriptor.SetFrameId(
+      static_cast<uint16_t>(video_header.generic->frame_id));
+  for (int64_t dep : video_header.generic->dependencies) {
+    generic_descriptor.AddFrameDependencyDiff(video_header.generic->frame_id -
+                                              dep);
+  }
+
+  uint8_t spatial_bimask = 1 << video_header.generic->spatial_index;
+  generic_descriptor.SetSpatialLayersBitmask(spatial_bimask);
+
+  generic_descriptor.SetTemporalLayer(video_header.generic->temporal_index);
+
+  if (video_header.frame_type == VideoFrameType::kVideoFrameKey) {
+    generic_descriptor.SetResolution(video_header.width, video_header.height);
+  }
+  return descriptors;
+}
+
 void RTPSenderVideo::AddRtpHeaderExtensions(const RTPVideoHeader& video_header,
+                                            FrameDescriptors& descriptors,
                                             bool first_packet,
                                             bool last_packet,
                                             RtpPacketToSend* packet) const {
@@ -376,30 +429,14 @@ void RTPSenderVideo::AddRtpHeaderExtensions(const RTPVideoHeader& video_header,
     bool extension_is_set = false;
     if (packet->IsRegistered<RtpDependencyDescriptorExtension>() &&
         video_structure_ != nullptr) {
-      DependencyDescriptor descriptor;
+      RTC_DCHECK(descriptors.dependency_descriptor);
+      DependencyDescriptor& descriptor = *descriptors.dependency_descriptor;
       descriptor.first_packet_in_frame = first_packet;
       descriptor.last_packet_in_frame = last_packet;
-      descriptor.frame_number = video_header.generic->frame_id & 0xFFFF;
-      descriptor.frame_dependencies.spatial_id =
-          video_header.generic->spatial_index;
-      descriptor.frame_dependencies.temporal_id =
-          video_header.generic->temporal_index;
-      for (int64_t dep : video_header.generic->dependencies) {
-        descriptor.frame_dependencies.frame_diffs.push_back(
-            video_header.generic->frame_id - dep);
-      }
-      descriptor.frame_dependencies.chain_diffs =
-          video_header.generic->chain_diffs;
-      descriptor.frame_dependencies.decode_target_indications =
-          video_header.generic->decode_target_indications;
-      RTC_DCHECK_EQ(
-          descriptor.frame_dependencies.decode_target_indications.size(),
-          video_structure_->num_decode_targets);
-
-      if (first_packet) {
-        descriptor.active_decode_targets_bitmask =
-            active_decode_targets_tracker_.ActiveDecodeTargetsBitmask();
-      }
+      descriptor.active_decode_targets_bitmask =
+          first_packet
+              ? active_decode_targets_tracker_.ActiveDecodeTargetsBitmask()
+              : absl::nullopt;
       // VP9 mark all layer frames of the first picture as kVideoFrameKey,
       // Structure should be attached to the descriptor to lowest spatial layer
       // when inter layer dependency is used, i.e. L structures; or to all
@@ -423,30 +460,13 @@ void RTPSenderVideo::AddRtpHeaderExtensions(const RTPVideoHeader& video_header,
     // Do not use generic frame descriptor when dependency descriptor is stored.
     if (packet->IsRegistered<RtpGenericFrameDescriptorExtension00>() &&
         !extension_is_set) {
-      RtpGenericFrameDescriptor generic_descriptor;
+      RTC_DCHECK(descriptors.generic_descriptor);
+      RtpGenericFrameDescriptor non_first_descriptor;
+      RtpGenericFrameDescriptor& generic_descriptor =
+          first_packet ? *descriptors.generic_descriptor
+                       : non_first_descriptor;
       generic_descriptor.SetFirstPacketInSubFrame(first_packet);
       generic_descriptor.SetLastPacketInSubFrame(last_packet);
-
-      if (first_packet) {
-        generic_descriptor.SetFrameId(
-            static_cast<uint16_t>(video_header.generic->frame_id));
-        for (int64_t dep : video_header.generic->dependencies) {
-          generic_descriptor.AddFrameDependencyDiff(
-              video_header.generic->frame_id - dep);
-        }
-
-        uint8_t spatial_bimask = 1 << video_header.generic->spatial_index;
-        generic_descriptor.SetSpatialLayersBitmask(spatial_bimask);
-
-        generic_descriptor.SetTemporalLayer(
-            video_header.generic->temporal_index);
-
-        if (video_header.frame_type == VideoFrameType::kVideoFrameKey) {
-          generic_descriptor.SetResolution(video_header.width,
-                                           video_header.height);
-        }
-      }
-
       packet->SetExtension<RtpGenericFrameDescriptorExtension00>(
           generic_descriptor);
     }
@@ -559,8 +579,12 @@ bool RTPSenderVideo::SendVideo(
   auto first_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   auto middle_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   auto last_packet = std::make_unique<RtpPacketToSend>(*single_packet);
+  // The packets of the frame are stamped from these four templates, so that
+  // the header extensions are serialized once per template rather than once
+  // per packet. The frame descriptors are built once for all templates.
+  FrameDescriptors descriptors = BuildFrameDescriptors(video_header);
   // Simplest way to estimate how much extensions would occupy is to set them.
-  AddRtpHeaderExtensions(video_header,
+  AddRtpHeaderExtensions(video_header, descriptors,
                          /*first_packet=*/true, /*last_packet=*/true,
                          single_packet.get());
   if (video_structure_ != nullptr &&
@@ -575,13 +599,13 @@ bool RTPSenderVideo::SendVideo(
     video_structure_ = nullptr;
   }
 
-  AddRtpHeaderExtensions(video_header,
+  AddRtpHeaderExtensions(video_header, descriptors,
                          /*first_packet=*/true, /*last_packet=*/false,
                          first_packet.get());
-  AddRtpHeaderExtensions(video_header,
+  AddRtpHeaderExtensions(video_header, descriptors,
                          /*first_packet=*/false, /*last_packet=*/false,
                          middle_packet.get());
-  AddRtpHeaderExtensions(video_header,
+  AddRtpHeaderExtensions(video_header, descriptors,
                          /*first_packet=*/false, /*last_packet=*/true,
                          last_packet.get());
 
@@ -679,7 +703,10 @@ bool RTPSenderVideo::SendVideo(
       expected_payload_capacity =
           limits.max_payload_len - limits.last_packet_reduction_len;
     } else {
-      packet = std::make_unique<RtpPacketToSend>(*middle_packet);
+      // The template isn't needed after the last middle packet.
+      packet = i == num_packets - 2
+                   ? std::move(middle_packet)
+                   : std::make_unique<RtpPacketToSend>(*middle_packet);
       expected_payload_capacity = limits.max_payload_len;
     }
 
@@ -700,22 +727,10 @@ bool RTPSenderVideo::SendVideo(
 
     packet->set_fec_protect_packet(use_fec);
 
-    if (red_enabled()) {
-      // TODO(sprang): Consider packetizing directly into packets with the RED
-      // header already in place, to avoid this copy.
-      std::unique_ptr<RtpPacketToSend> red_packet(new RtpPacketToSend(*packet));
-      BuildRedPayload(*packet, red_packet.get());
-      red_packet->SetPayloadType(*red_payload_type_);
-      red_packet->set_is_red(true);
-
-      // Append `red_packet` instead of `packet` to output.
-      red_packet->set_packet_type(RtpPacketMediaType::kVideo);
-      red_packet->set_allow_retransmission(packet->allow_retransmission());
-      rtp_packets.emplace_back(std::move(red_packet));
-    } else {
-      packet->set_packet_type(RtpPacketMediaType::kVideo);
-      rtp_packets.emplace_back(std::move(packet));
-    }
+    if (red_enabled())
+      EncapsulateRed(*red_payload_type_, packet.get());
+    packet->set_packet_type(RtpPacketMediaType::kVideo);
+    rtp_packets.emplace_back(std::move(packet));
 
     if (first_frame) {
       if (i == 0) {
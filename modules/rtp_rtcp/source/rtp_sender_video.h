@@ -29,6 +29,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/absolute_capture_time_sender.h"
 #include "modules/rtp_rtcp/source/active_decode_targets_helper.h"
+#include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
@@ -164,7 +165,21 @@ class RTPSenderVideo {
       const FrameDependencyStructure* video_structure);
   void SetVideoLayersAllocationInternal(VideoLayersAllocation allocation);
 
+  // Frame descriptors that are the same in all packets of a frame, apart
+  // from the fields that AddRtpHeaderExtensions() patches per packet.
+  struct FrameDescriptors {
+    absl::optional<DependencyDescriptor> dependency_descriptor;
+    // Descriptor of the first packet. The other packets carry only the
+    // first/last packet flags.
+    absl::optional<RtpGenericFrameDescriptor> generic_descriptor;
+  };
+
+  FrameDescriptors BuildFrameDescriptors(
+      const RTPVideoHeader& video_header) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_checker_);
+
   void AddRtpHeaderExtensions(const RTPVideoHeader& video_header,
+                              FrameDescriptors& descriptors,
                               bool first_packet,
                               bool last_packet,
                               RtpPacketToSend* packet) const
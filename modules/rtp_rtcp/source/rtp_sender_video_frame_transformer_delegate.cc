@@ -101,6 +101,7 @@ RTPSenderVideoFrameTransformerDelegate::RTPSenderVideoFrameTransformerDelegate(
     TaskQueueBase* send_transport_queue)
     : sender_(sender),
       frame_transformer_(std::move(frame_transformer)),
+      transformer_is_synchronous_(frame_transformer_->IsSynchronous()),
       ssrc_(ssrc),
       send_transport_queue_(send_transport_queue) {}
 
@@ -132,18 +133,27 @@ bool RTPSenderVideoFrameTransformerDelegate::TransformFrame(
 
 void RTPSenderVideoFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
-  MutexLock lock(&sender_lock_);
+  {
+    MutexLock lock(&sender_lock_);
 
-  // The encoder queue normally gets destroyed after the sender;
-  // however, it might still be null by the time a previously queued frame
-  // arrives.
-  if (!sender_ || !encoder_queue_)
-    return;
-  rtc::scoped_refptr<RTPSenderVideoFrameTransformerDelegate> delegate(this);
-  encoder_queue_->PostTask(ToQueuedTask(
-      [delegate = std::move(delegate), frame = std::move(frame)]() mutable {
-        delegate->SendVideo(std::move(frame));
-      }));
+    // The encoder queue normally gets destroyed after the sender;
+    // however, it might still be null by the time a previously queued frame
+    // arrives.
+    if (!sender_ || !encoder_queue_)
+      return;
+    if (!transformer_is_synchronous_ || !encoder_queue_->IsCurrent()) {
+      rtc::scoped_refptr<RTPSenderVideoFrameTransformerDelegate> delegate(
+          this);
+      encoder_queue_->PostTask(ToQueuedTask(
+          [delegate = std::move(delegate), frame = std::move(frame)]() mutable {
+            delegate->SendVideo(std::move(frame));
+          }));
+      return;
+    }
+  }
+  // A synchronous transformer hands the frame back from within Transform(),
+  // so no frame can be queued ahead of it.
+  SendVideo(std::move(frame));
 }
 
 void RTPSenderVideoFrameTransformerDelegate::SendVideo(
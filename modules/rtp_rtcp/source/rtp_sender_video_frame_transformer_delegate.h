@@ -45,7 +45,8 @@ class RTPSenderVideoFrameTransformerDelegate : public TransformedFrameCallback {
                       absl::optional<int64_t> expected_retransmission_time_ms);
 
   // Implements TransformedFrameCallback. Can be called on any thread. Posts
-  // the transformed frame to be sent on the `encoder_queue_`.
+  // the transformed frame to be sent on the `encoder_queue_`, or sends it
+  // right away if a synchronous transformer calls back on that queue.
   void OnTransformedFrame(
       std::unique_ptr<TransformableFrameInterface> frame) override;
 
@@ -74,6 +75,7 @@ class RTPSenderVideoFrameTransformerDelegate : public TransformedFrameCallback {
   mutable Mutex sender_lock_;
   RTPSenderVideo* sender_ RTC_GUARDED_BY(sender_lock_);
   rtc::scoped_refptr<FrameTransformerInterface> frame_transformer_;
+  const bool transformer_is_synchronous_;
   const uint32_t ssrc_;
   TaskQueueBase* encoder_queue_ = nullptr;
   TaskQueueBase* send_transport_queue_;
@@ -811,6 +811,36 @@ TEST_P(RtpSenderVideoTest,
                   .HasExtension<RtpDependencyDescriptorExtension>());
 }
 
+TEST_P(RtpSenderVideoTest, WrapsPacketsInRedHeader) {
+  constexpr int kRedPayloadType = 120;
+  uint8_t kFrame[3 * kMaxPacketLength];
+  for (size_t i = 0; i < sizeof(kFrame); ++i)
+    kFrame[i] = static_cast<uint8_t>(i);
+  RTPSenderVideo::Config config;
+  config.clock = &fake_clock_;
+  config.rtp_sender = rtp_module_->RtpSender();
+  config.field_trials = &field_trials_;
+  config.red_payload_type = kRedPayloadType;
+  RTPSenderVideo rtp_sender_video(config);
+
+  RTPVideoHeader hdr;
+  hdr.frame_type = VideoFrameType::kVideoFrameKey;
+  rtp_sender_video.SendVideo(kPayload, kType, kTimestamp, 0, kFrame, hdr,
+                             kDefaultExpectedRetransmissionTimeMs);
+
+  ASSERT_GT(transport_.packets_sent(), 1);
+  std::vector<uint8_t> media_payload;
+  for (const RtpPacketReceived& packet : transport_.sent_packets()) {
+    EXPECT_EQ(kRedPayloadType, packet.PayloadType());
+    ASSERT_GT(packet.payload_size(), 2u);
+    EXPECT_EQ(kPayload, packet.payload()[0]);
+    // Skip the RED header and the generic payload header.
+    media_payload.insert(media_payload.end(), packet.payload().begin() + 2,
+                         packet.payload().end());
+  }
+  EXPECT_THAT(media_payload, ElementsAreArray(kFrame));
+}
+
 TEST_P(RtpSenderVideoTest, PopulateGenericFrameDescriptor) {
   const int64_t kFrameId = 100000;
   uint8_t kFrame[100];
@@ -1523,6 +1553,38 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest, OnTransformedFrameSendsVideo) {
   EXPECT_EQ(transport_.packets_sent(), 1);
 }
 
+TEST_F(RtpSenderVideoWithFrameTransformerTest,
+       SynchronousTransformerSendsVideoWithoutPosting) {
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  ON_CALL(*mock_frame_transformer, IsSynchronous).WillByDefault(Return(true));
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithFrameTransformer(mock_frame_transformer);
+  ASSERT_TRUE(callback);
+
+  auto encoded_image = CreateDefaultEncodedImage();
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault(
+          [&callback](std::unique_ptr<TransformableFrameInterface> frame) {
+            callback->OnTransformedFrame(std::move(frame));
+          });
+  TaskQueueForTest encoder_queue;
+  encoder_queue.SendTask(
+      [&] {
+        rtp_sender_video->SendEncodedImage(
+            kPayload, kType, kTimestamp, *encoded_image, video_header,
+            kDefaultExpectedRetransmissionTimeMs);
+        // Sent before SendEncodedImage() returned.
+        EXPECT_EQ(transport_.packets_sent(), 1);
+      },
+      RTC_FROM_HERE);
+}
+
 TEST_F(RtpSenderVideoWithFrameTransformerTest,
        TransformableFrameMetadataHasCorrectValue) {
   auto mock_frame_transformer =
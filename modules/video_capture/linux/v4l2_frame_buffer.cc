@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <errno.h>
+#include <linux/videodev2.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+namespace {
+
+// Reads the NV12 image of a V4L2FrameBuffer in place.
+class MappedNV12Buffer : public NV12BufferInterface {
+ public:
+  explicit MappedNV12Buffer(rtc::scoped_refptr<V4L2FrameBuffer> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  int width() const override { return buffer_->width(); }
+  int height() const override { return buffer_->height(); }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    return buffer_->ToI420();
+  }
+
+  const uint8_t* DataY() const override { return buffer_->data(); }
+  const uint8_t* DataUV() const override {
+    return buffer_->data() + buffer_->stride() * buffer_->height();
+  }
+  int StrideY() const override { return buffer_->stride(); }
+  int StrideUV() const override { return buffer_->stride(); }
+
+ private:
+  const rtc::scoped_refptr<V4L2FrameBuffer> buffer_;
+};
+
+}  // namespace
+
+V4L2BufferPool::V4L2BufferPool(int device_fd, std::vector<Buffer> buffers)
+    : buffers_(std::move(buffers)),
+      device_fd_(device_fd),
+      num_queued_(buffers_.size()) {}
+
+V4L2BufferPool::~V4L2BufferPool() {
+  for (const Buffer& buffer : buffers_) {
+    munmap(buffer.start, buffer.length);
+    if (buffer.dmabuf_fd != -1)
+      close(buffer.dmabuf_fd);
+  }
+}
+
+size_t V4L2BufferPool::num_queued() const {
+  MutexLock lock(&lock_);
+  return num_queued_;
+}
+
+void V4L2BufferPool::OnDequeued(size_t index) {
+  RTC_DCHECK_LT(index, buffers_.size());
+  MutexLock lock(&lock_);
+  RTC_DCHECK_GT(num_queued_, 0);
+  --num_queued_;
+}
+
+void V4L2BufferPool::Return(size_t index) {
+  RTC_DCHECK_LT(index, buffers_.size());
+  MutexLock lock(&lock_);
+  if (device_fd_ == -1)
+    return;
+  struct v4l2_buffer buf;
+  memset(&buf, 0, sizeof(buf));
+  buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.index = index;
+  if (ioctl(device_fd_, VIDIOC_QBUF, &buf) == -1) {
+    RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer, errno = " << errno;
+    return;
+  }
+  ++num_queued_;
+}
+
+void V4L2BufferPool::Stop() {
+  MutexLock lock(&lock_);
+  device_fd_ = -1;
+}
+
+V4L2FrameBuffer::V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                                 size_t index,
+                                 uint32_t fourcc,
+                                 int width,
+                                 int height,
+                                 int stride,
+                                 size_t bytes_used)
+    : pool_(std::move(pool)),
+      index_(index),
+      fourcc_(fourcc),
+      width_(width),
+      height_(height),
+      stride_(stride),
+      bytes_used_(bytes_used) {
+  RTC_DCHECK(fourcc_ == V4L2_PIX_FMT_NV12 || fourcc_ == V4L2_PIX_FMT_YUYV ||
+             fourcc_ == V4L2_PIX_FMT_UYVY);
+}
+
+V4L2FrameBuffer::~V4L2FrameBuffer() {
+  pool_->Return(index_);
+}
+
+VideoFrameBuffer::Type V4L2FrameBuffer::type() const {
+  return Type::kNative;
+}
+
+const uint8_t* V4L2FrameBuffer::data() const {
+  return static_cast<const uint8_t*>(pool_->buffer(index_).start);
+}
+
+int V4L2FrameBuffer::dmabuf_fd() const {
+  return pool_->buffer(index_).dmabuf_fd;
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4L2FrameBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> i420 = I420Buffer::Create(width_, height_);
+  int result = -1;
+  switch (fourcc_) {
+    case V4L2_PIX_FMT_NV12:
+      result = libyuv::NV12ToI420(
+          data(), stride_, data() + stride_ * height_, stride_,
+          i420->MutableDataY(), i420->StrideY(), i420->MutableDataU(),
+          i420->StrideU(), i420->MutableDataV(), i420->StrideV(), width_,
+          height_);
+      break;
+    case V4L2_PIX_FMT_YUYV:
+      result = libyuv::YUY2ToI420(
+          data(), stride_, i420->MutableDataY(), i420->StrideY(),
+          i420->MutableDataU(), i420->StrideU(), i420->MutableDataV(),
+          i420->StrideV(), width_, height_);
+      break;
+    case V4L2_PIX_FMT_UYVY:
+      result = libyuv::UYVYToI420(
+          data(), stride_, i420->MutableDataY(), i420->StrideY(),
+          i420->MutableDataU(), i420->StrideU(), i420->MutableDataV(),
+          i420->StrideV(), width_, height_);
+      break;
+  }
+  if (result != 0) {
+    RTC_LOG(LS_ERROR) << "Failed to convert V4L2 buffer to I420.";
+    return nullptr;
+  }
+  return i420;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> V4L2FrameBuffer::GetMappedFrameBuffer(
+    rtc::ArrayView<Type> types) {
+  if (fourcc_ != V4L2_PIX_FMT_NV12 ||
+      !absl::c_linear_search(types, Type::kNV12)) {
+    return nullptr;
+  }
+  return rtc::make_ref_counted<MappedNV12Buffer>(
+      rtc::scoped_refptr<V4L2FrameBuffer>(this));
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// The memory mapped buffers of a V4L2 capture device that is streaming. A
+// buffer that has been dequeued is handed out wrapped in a VideoFrameBuffer,
+// and queued to the device again when the last reference to that is
+// released, on whatever thread that happens.
+class V4L2BufferPool : public rtc::RefCountedBase {
+ public:
+  struct Buffer {
+    void* start;
+    size_t length;
+    // DMABUF file descriptor exported for the buffer, or -1.
+    int dmabuf_fd;
+  };
+
+  // Takes ownership of the mappings and of the DMABUF file descriptors.
+  // `device_fd` must stay open until Stop() is called.
+  V4L2BufferPool(int device_fd, std::vector<Buffer> buffers);
+
+  V4L2BufferPool(const V4L2BufferPool&) = delete;
+  V4L2BufferPool& operator=(const V4L2BufferPool&) = delete;
+
+  const Buffer& buffer(size_t index) const { return buffers_[index]; }
+  size_t num_buffers() const { return buffers_.size(); }
+  // Number of buffers that the device can currently fill.
+  size_t num_queued() const;
+
+  // To be called after the buffer has been dequeued from the device.
+  void OnDequeued(size_t index);
+  // Queues the buffer to the device again, unless stopped.
+  void Return(size_t index);
+  // Stops queueing buffers to the device. Buffers that are still out are
+  // unmapped once released.
+  void Stop();
+
+ protected:
+  // Unmaps the buffers.
+  ~V4L2BufferPool() override;
+
+ private:
+  const std::vector<Buffer> buffers_;
+  mutable Mutex lock_;
+  int device_fd_ RTC_GUARDED_BY(lock_);
+  size_t num_queued_ RTC_GUARDED_BY(lock_);
+};
+
+// A dequeued buffer of a V4L2BufferPool, holding an NV12, YUYV or UYVY
+// image, that returns the buffer to the pool when destroyed. It is a native
+// buffer so that it can carry the DMABUF of the V4L2 buffer, which e.g. a
+// hardware encoder can import instead of reading the frame. An NV12 image can
+// be read without a copy through GetMappedFrameBuffer(). Applications that
+// enable zero-copy capture know that native frames from the capturer are of
+// this type.
+class V4L2FrameBuffer : public VideoFrameBuffer {
+ public:
+  V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                  size_t index,
+                  uint32_t fourcc,
+                  int width,
+                  int height,
+                  int stride,
+                  size_t bytes_used);
+
+  Type type() const override;
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override;
+
+  // The V4L2_PIX_FMT_* of the image.
+  uint32_t fourcc() const { return fourcc_; }
+  const uint8_t* data() const;
+  size_t size() const { return bytes_used_; }
+  // Bytes per line, of the Y plane for NV12.
+  int stride() const { return stride_; }
+  // DMABUF file descriptor of the V4L2 buffer, or -1 if the driver can't
+  // export it. Owned by the pool.
+  int dmabuf_fd() const;
+
+ protected:
+  ~V4L2FrameBuffer() override;
+
+ private:
+  const rtc::scoped_refptr<V4L2BufferPool> pool_;
+  const size_t index_;
+  const uint32_t fourcc_;
+  const int width_;
+  const int height_;
+  const int stride_;
+  const size_t bytes_used_;
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
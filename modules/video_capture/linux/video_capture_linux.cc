@@ -23,15 +23,31 @@
 
 #include <new>
 #include <string>
+#include <vector>
 
 #include "api/scoped_refptr.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+
+// A zero-copy frame is copied instead when delivering it would leave fewer
+// buffers than this to the device, so that capture doesn't stall when frames
+// are held downstream.
+constexpr size_t kMinQueuedBuffers = 1;
+
+bool CanWrapPixelFormat(uint32_t pixel_format) {
+  return pixel_format == V4L2_PIX_FMT_NV12 ||
+         pixel_format == V4L2_PIX_FMT_YUYV || pixel_format == V4L2_PIX_FMT_UYVY;
+}
+
+}  // namespace
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   auto implementation = rtc::make_ref_counted<VideoCaptureModuleV4L2>();
@@ -44,6 +60,7 @@ rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
 
 VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
+      zero_copy_(field_trial::IsEnabled("WebRTC-Video-V4L2ZeroCopy")),
       _deviceId(-1),
       _deviceFd(-1),
       _buffersAllocatedByDevice(-1),
@@ -52,7 +69,8 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
       _currentFrameRate(-1),
       _captureStarted(false),
       _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _capturePixelFormat(0),
+      _currentStride(0) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -125,23 +143,22 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   }
 
   // Supported video formats in preferred order.
-  // If the requested resolution is larger than VGA, we prefer MJPEG. Go for
-  // I420 otherwise.
-  const int nFormats = 5;
-  unsigned int fmts[nFormats];
+  // With zero-copy capture, NV12 is preferred since it can be used without
+  // converting it. Otherwise, if the requested resolution is larger than VGA,
+  // we prefer MJPEG. Go for I420 otherwise.
+  std::vector<unsigned int> fmts;
+  if (zero_copy_)
+    fmts.push_back(V4L2_PIX_FMT_NV12);
   if (capability.width > 640 || capability.height > 480) {
-    fmts[0] = V4L2_PIX_FMT_MJPEG;
-    fmts[1] = V4L2_PIX_FMT_YUV420;
-    fmts[2] = V4L2_PIX_FMT_YUYV;
-    fmts[3] = V4L2_PIX_FMT_UYVY;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts.insert(fmts.end(),
+                {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUV420, V4L2_PIX_FMT_YUYV,
+                 V4L2_PIX_FMT_UYVY, V4L2_PIX_FMT_JPEG});
   } else {
-    fmts[0] = V4L2_PIX_FMT_YUV420;
-    fmts[1] = V4L2_PIX_FMT_YUYV;
-    fmts[2] = V4L2_PIX_FMT_UYVY;
-    fmts[3] = V4L2_PIX_FMT_MJPEG;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts.insert(fmts.end(),
+                {V4L2_PIX_FMT_YUV420, V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_UYVY,
+                 V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_JPEG});
   }
+  const int nFormats = fmts.size();
 
   // Enumerate image formats.
   struct v4l2_fmtdesc fmt;
@@ -188,6 +205,10 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG ||
            video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_JPEG)
     _captureVideoType = VideoType::kMJPEG;
+  // There is no VideoType for NV12, which is only captured with zero-copy
+  // capture.
+  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_NV12)
+    _captureVideoType = VideoType::kUnknown;
 
   // set format and frame size now
   if (ioctl(_deviceFd, VIDIOC_S_FMT, &video_fmt) < 0) {
@@ -198,6 +219,13 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   // initialize current width and height
   _currentWidth = video_fmt.fmt.pix.width;
   _currentHeight = video_fmt.fmt.pix.height;
+  _capturePixelFormat = video_fmt.fmt.pix.pixelformat;
+  _currentStride = video_fmt.fmt.pix.bytesperline;
+  if (_currentStride == 0) {
+    _currentStride = _capturePixelFormat == V4L2_PIX_FMT_NV12
+                         ? _currentWidth
+                         : _currentWidth * 2;
+  }
 
   // Trying to set frame rate, before check driver capability.
   bool driver_framerate_support = true;
@@ -293,20 +321,29 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
 
   rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
   rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
+  const unsigned int num_buffers =
+      zero_copy_ ? kNoOfZeroCopyV4L2Buffers : kNoOfV4L2Bufffers;
+  rbuffer.count = num_buffers;
 
   if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
     RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
     return false;
   }
 
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
+  if (rbuffer.count > num_buffers)
+    rbuffer.count = num_buffers;
 
   _buffersAllocatedByDevice = rbuffer.count;
 
   // Map the buffers
-  _pool = new Buffer[rbuffer.count];
+  std::vector<V4L2BufferPool::Buffer> buffers(rbuffer.count);
+  auto unmap = [&buffers](unsigned int count) {
+    for (unsigned int j = 0; j < count; j++) {
+      munmap(buffers[j].start, buffers[j].length);
+      if (buffers[j].dmabuf_fd != -1)
+        close(buffers[j].dmabuf_fd);
+    }
+  };
 
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
@@ -316,33 +353,48 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
     buffer.index = i;
 
     if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
+      unmap(i);
       return false;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
+    buffers[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, _deviceFd, buffer.m.offset);
 
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
+    if (MAP_FAILED == buffers[i].start) {
+      unmap(i);
       return false;
     }
 
-    _pool[i].length = buffer.length;
+    buffers[i].length = buffer.length;
+    buffers[i].dmabuf_fd = -1;
+
+    // Export the buffer so that a zero-copy frame can be imported by e.g. a
+    // hardware encoder. Drivers that can't do it still capture.
+    if (zero_copy_) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(expbuf));
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = i;
+      expbuf.flags = O_RDONLY | O_CLOEXEC;
+      if (ioctl(_deviceFd, VIDIOC_EXPBUF, &expbuf) == 0)
+        buffers[i].dmabuf_fd = expbuf.fd;
+    }
 
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
+      unmap(i + 1);
       return false;
     }
   }
+  _pool = rtc::make_ref_counted<V4L2BufferPool>(_deviceFd, std::move(buffers));
   return true;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // The buffers are unmapped once the frames still using them are released.
+  if (_pool) {
+    _pool->Stop();
+    _pool = nullptr;
+  }
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -402,17 +454,30 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
           return true;
         }
       }
-      VideoCaptureCapability frameInfo;
-      frameInfo.width = _currentWidth;
-      frameInfo.height = _currentHeight;
-      frameInfo.videoType = _captureVideoType;
-
-      // convert to to I420 if needed
-      IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                    frameInfo);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      _pool->OnDequeued(buf.index);
+
+      if (zero_copy_ && CanWrapPixelFormat(_capturePixelFormat)) {
+        // The buffer is enqueued again when the frame is released.
+        rtc::scoped_refptr<VideoFrameBuffer> buffer =
+            rtc::make_ref_counted<V4L2FrameBuffer>(
+                _pool, buf.index, _capturePixelFormat, _currentWidth,
+                _currentHeight, _currentStride, buf.bytesused);
+        if (_pool->num_queued() < kMinQueuedBuffers)
+          buffer = buffer->ToI420();
+        if (buffer)
+          IncomingVideoFrameBuffer(std::move(buffer));
+      } else {
+        VideoCaptureCapability frameInfo;
+        frameInfo.width = _currentWidth;
+        frameInfo.height = _currentHeight;
+        frameInfo.videoType = _captureVideoType;
+
+        // convert to to I420 if needed
+        IncomingFrame(static_cast<unsigned char*>(
+                          _pool->buffer(buf.index).start),
+                      buf.bytesused, frameInfo);
+        // enqueue the buffer again
+        _pool->Return(buf.index);
       }
     }
   }
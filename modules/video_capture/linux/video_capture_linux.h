@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/platform_thread.h"
@@ -35,12 +37,18 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // With zero-copy capture, frames hold on to their buffer until they have
+  // been encoded and rendered, so more are needed to keep the device busy.
+  enum { kNoOfZeroCopyV4L2Buffers = 8 };
 
   static void CaptureThread(void*);
   bool CaptureProcess();
   bool AllocateVideoBuffers();
   bool DeAllocateVideoBuffers();
 
+  // Whether NV12, YUYV and UYVY frames are delivered in the V4L2 buffers
+  // they were captured to, as V4L2FrameBuffers, instead of as I420 copies.
+  const bool zero_copy_;
   rtc::PlatformThread _captureThread;
   Mutex capture_lock_;
   bool quit_ RTC_GUARDED_BY(capture_lock_);
@@ -53,11 +61,9 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  uint32_t _capturePixelFormat;
+  int32_t _currentStride;
+  rtc::scoped_refptr<V4L2BufferPool> _pool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
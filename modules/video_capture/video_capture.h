@@ -11,6 +11,13 @@
 #ifndef MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_H_
 #define MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_H_
 
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/video_capture/video_capture_defines.h"
@@ -71,6 +78,21 @@ class VideoCaptureModule : public rtc::RefCountInterface {
     virtual ~DeviceInfo() {}
   };
 
+  // Decodes MJPEG frames from the capture device, e.g. with a hardware JPEG
+  // decoder, instead of libyuv doing it in software.
+  class MjpegDecoder {
+   public:
+    virtual ~MjpegDecoder() = default;
+
+    // Called on the capture thread. Returns nullptr if the frame couldn't be
+    // decoded, in which case libyuv decodes it. The returned buffer may be
+    // of any type and is delivered as is.
+    virtual rtc::scoped_refptr<VideoFrameBuffer> Decode(
+        rtc::ArrayView<const uint8_t> data,
+        int width,
+        int height) = 0;
+  };
+
   //   Register capture data callback
   virtual void RegisterCaptureDataCallback(
       rtc::VideoSinkInterface<VideoFrame>* dataCallback) = 0;
@@ -107,6 +129,10 @@ class VideoCaptureModule : public rtc::RefCountInterface {
   // Return whether the rotation is applied or left pending.
   virtual bool GetApplyRotation() = 0;
 
+  // Sets the decoder for MJPEG frames, if the module captures any. Passing
+  // nullptr goes back to decoding with libyuv.
+  virtual void SetMjpegDecoder(std::unique_ptr<MjpegDecoder> decoder) {}
+
  protected:
   ~VideoCaptureModule() override {}
 };
@@ -13,6 +13,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <utility>
+
+#include "api/array_view.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -125,6 +128,14 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
 
   TRACE_EVENT1("webrtc", "VC::IncomingFrame", "capture_time", captureTime);
 
+  if (frameInfo.videoType == VideoType::kMJPEG && mjpeg_decoder_) {
+    rtc::scoped_refptr<VideoFrameBuffer> decoded = mjpeg_decoder_->Decode(
+        rtc::ArrayView<const uint8_t>(videoFrame, videoFrameLength), width,
+        abs(height));
+    if (decoded)
+      return DeliverFrameBuffer(std::move(decoded), captureTime);
+  }
+
   // Not encoded, convert to I420.
   if (frameInfo.videoType != VideoType::kMJPEG &&
       CalcBufferSize(frameInfo.videoType, width, abs(height)) !=
@@ -203,6 +214,44 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingVideoFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime /*=0*/) {
+  MutexLock lock(&api_lock_);
+  TRACE_EVENT1("webrtc", "VC::IncomingVideoFrameBuffer", "capture_time",
+               captureTime);
+  return DeliverFrameBuffer(std::move(buffer), captureTime);
+}
+
+int32_t VideoCaptureImpl::DeliverFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime) {
+  // SetApplyRotation doesn't take any lock. Make a local copy here.
+  bool apply_rotation = apply_rotation_;
+  VideoRotation rotation = _rotateFrame;
+  if (apply_rotation && rotation != kVideoRotation_0) {
+    rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+    if (!i420) {
+      RTC_LOG(LS_ERROR) << "Failed to convert capture frame to I420.";
+      return -1;
+    }
+    buffer = I420Buffer::Rotate(*i420, rotation);
+    rotation = kVideoRotation_0;
+  }
+
+  VideoFrame captureFrame = VideoFrame::Builder()
+                                .set_video_frame_buffer(std::move(buffer))
+                                .set_timestamp_rtp(0)
+                                .set_timestamp_ms(rtc::TimeMillis())
+                                .set_rotation(rotation)
+                                .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   _requestedCapability = capability;
@@ -240,6 +289,11 @@ bool VideoCaptureImpl::GetApplyRotation() {
   return apply_rotation_;
 }
 
+void VideoCaptureImpl::SetMjpegDecoder(std::unique_ptr<MjpegDecoder> decoder) {
+  MutexLock lock(&api_lock_);
+  mjpeg_decoder_ = std::move(decoder);
+}
+
 void VideoCaptureImpl::UpdateFrameCount() {
   if (_incomingFrameTimesNanos[0] / rtc::kNumNanosecsPerMicrosec == 0) {
     // first no shift
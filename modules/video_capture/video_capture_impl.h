@@ -18,14 +18,18 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/video_capture/video_capture.h"
 #include "modules/video_capture/video_capture_config.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -58,6 +62,7 @@ class VideoCaptureImpl : public VideoCaptureModule {
   int32_t SetCaptureRotation(VideoRotation rotation) override;
   bool SetApplyRotation(bool enable) override;
   bool GetApplyRotation() override;
+  void SetMjpegDecoder(std::unique_ptr<MjpegDecoder> decoder) override;
 
   const char* CurrentDeviceName() const override;
 
@@ -77,6 +82,11 @@ class VideoCaptureImpl : public VideoCaptureModule {
   VideoCaptureImpl();
   ~VideoCaptureImpl() override;
 
+  // Delivers a frame that is already in a VideoFrameBuffer, applying the
+  // capture rotation like IncomingFrame() does.
+  int32_t IncomingVideoFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                                   int64_t captureTime = 0);
+
   char* _deviceUniqueId;  // current Device unique name;
   Mutex api_lock_;
   VideoCaptureCapability _requestedCapability;  // Should be set by platform
@@ -86,6 +96,9 @@ class VideoCaptureImpl : public VideoCaptureModule {
   void UpdateFrameCount();
   uint32_t CalculateFrameRate(int64_t now_ns);
   int32_t DeliverCapturedFrame(VideoFrame& captureFrame);
+  int32_t DeliverFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                             int64_t captureTime)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(api_lock_);
 
   // last time the module process function was called.
   int64_t _lastProcessTimeNanos;
@@ -102,6 +115,8 @@ class VideoCaptureImpl : public VideoCaptureModule {
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_;
+
+  std::unique_ptr<MjpegDecoder> mjpeg_decoder_ RTC_GUARDED_BY(api_lock_);
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
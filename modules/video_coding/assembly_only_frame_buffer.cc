@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/assembly_only_frame_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/video/video_codec_type.h"
+#include "api/video/video_frame_type.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+AssemblyOnlyFrameBuffer::AssemblyOnlyFrameBuffer(size_t start_buffer_size,
+                                                 size_t max_buffer_size,
+                                                 int max_history)
+    : max_history_(max_history),
+      packet_buffer_(start_buffer_size, max_buffer_size) {
+  RTC_DCHECK_GT(max_history_, 0);
+}
+
+AssemblyOnlyFrameBuffer::~AssemblyOnlyFrameBuffer() = default;
+
+AssemblyOnlyFrameBuffer::InsertResult AssemblyOnlyFrameBuffer::InsertPacket(
+    const RtpPacketReceived& rtp_packet) {
+  InsertResult result;
+  if (!rtp_packet.HasExtension<RtpDependencyDescriptorExtension>()) {
+    // Without a descriptor the packet can't be part of a frame, so treat it
+    // like padding to not stall the frames that follow it.
+    return InsertPadding(rtp_packet.SequenceNumber());
+  }
+
+  DependencyDescriptor dependency_descriptor;
+  if (!rtp_packet.GetExtension<RtpDependencyDescriptorExtension>(
+          structure_.get(), &dependency_descriptor)) {
+    // The descriptor is invalid, or was written with a structure other than
+    // the latest one received.
+    RTC_LOG(LS_WARNING) << "ssrc: " << rtp_packet.Ssrc()
+                        << " Failed to parse dependency descriptor.";
+    result.keyframe_needed = true;
+    return result;
+  }
+  if (dependency_descriptor.attached_structure != nullptr &&
+      !dependency_descriptor.first_packet_in_frame) {
+    RTC_LOG(LS_WARNING) << "ssrc: " << rtp_packet.Ssrc()
+                        << " Invalid dependency descriptor: structure "
+                           "attached to non first packet of a frame.";
+    return result;
+  }
+
+  int64_t frame_id =
+      frame_id_unwrapper_.Unwrap(dependency_descriptor.frame_number);
+  if (dependency_descriptor.attached_structure) {
+    if (structure_frame_id_ > frame_id) {
+      // Key frame older than the latest one received.
+      return result;
+    }
+    structure_ = std::move(dependency_descriptor.attached_structure);
+    structure_frame_id_ = frame_id;
+  }
+
+  // Only the fields the PacketBuffer needs to assemble frames are filled in,
+  // the payload is not copied.
+  auto packet = std::make_unique<video_coding::PacketBuffer::Packet>();
+  packet->marker_bit = rtp_packet.Marker();
+  packet->payload_type = rtp_packet.PayloadType();
+  packet->seq_num = rtp_packet.SequenceNumber();
+  packet->timestamp = rtp_packet.Timestamp();
+
+  RTPVideoHeader& video_header = packet->video_header;
+  video_header.codec = kVideoCodecGeneric;
+  video_header.is_first_packet_in_frame =
+      dependency_descriptor.first_packet_in_frame;
+  video_header.is_last_packet_in_frame =
+      dependency_descriptor.last_packet_in_frame;
+  video_header.frame_type = structure_frame_id_ == frame_id
+                                ? VideoFrameType::kVideoFrameKey
+                                : VideoFrameType::kVideoFrameDelta;
+  auto& generic_descriptor_info = video_header.generic.emplace();
+  generic_descriptor_info.frame_id = frame_id;
+  generic_descriptor_info.spatial_index =
+      dependency_descriptor.frame_dependencies.spatial_id;
+  generic_descriptor_info.temporal_index =
+      dependency_descriptor.frame_dependencies.temporal_id;
+  for (int fdiff : dependency_descriptor.frame_dependencies.frame_diffs) {
+    generic_descriptor_info.dependencies.push_back(frame_id - fdiff);
+  }
+  generic_descriptor_info.decode_target_indications =
+      dependency_descriptor.frame_dependencies.decode_target_indications;
+
+  OnPacketBufferResult(packet_buffer_.InsertPacket(std::move(packet)),
+                       &result);
+  return result;
+}
+
+AssemblyOnlyFrameBuffer::InsertResult AssemblyOnlyFrameBuffer::InsertPadding(
+    uint16_t seq_num) {
+  InsertResult result;
+  OnPacketBufferResult(packet_buffer_.InsertPadding(seq_num), &result);
+  return result;
+}
+
+void AssemblyOnlyFrameBuffer::OnPacketBufferResult(
+    video_coding::PacketBuffer::InsertResult result,
+    InsertResult* insert_result) {
+  if (result.buffer_cleared) {
+    insert_result->keyframe_needed = true;
+  }
+
+  video_coding::PacketBuffer::Packet* first_packet = nullptr;
+  for (const auto& packet : result.packets) {
+    if (packet->is_first_packet_in_frame()) {
+      first_packet = packet.get();
+    }
+    if (!packet->is_last_packet_in_frame()) {
+      continue;
+    }
+    RTC_DCHECK(first_packet);
+    const RTPVideoHeader& video_header = first_packet->video_header;
+    RTC_DCHECK(video_header.generic);
+
+    AssembledFrame assembled_frame;
+    Frame& frame = assembled_frame.frame;
+    frame.frame_id = video_header.generic->frame_id;
+    frame.rtp_timestamp = first_packet->timestamp;
+    frame.first_seq_num = first_packet->seq_num;
+    frame.last_seq_num = packet->seq_num;
+    frame.spatial_id = video_header.generic->spatial_index;
+    frame.temporal_id = video_header.generic->temporal_index;
+    frame.is_keyframe =
+        video_header.frame_type == VideoFrameType::kVideoFrameKey;
+    assembled_frame.references = video_header.generic->dependencies;
+    const auto& dtis = video_header.generic->decode_target_indications;
+    for (size_t i = 0; i < dtis.size(); ++i) {
+      assembled_frame.present_targets[i] =
+          dtis[i] != DecodeTargetIndication::kNotPresent;
+    }
+    if (frame.is_keyframe) {
+      // Nothing before a key frame is needed to decode what follows it.
+      packet_buffer_.ClearTo(static_cast<uint16_t>(frame.first_seq_num - 1));
+    }
+    OnAssembledFrame(std::move(assembled_frame), insert_result);
+    first_packet = nullptr;
+  }
+}
+
+void AssemblyOnlyFrameBuffer::OnAssembledFrame(AssembledFrame assembled_frame,
+                                               InsertResult* insert_result) {
+  const int64_t frame_id = assembled_frame.frame.frame_id;
+  if (history_.count(frame_id) > 0 || pending_frames_.count(frame_id) > 0) {
+    // Assembled again from a retransmitted packet.
+    return;
+  }
+
+  newest_frame_id_ = std::max(newest_frame_id_.value_or(frame_id), frame_id);
+  const int64_t oldest_frame_id = *newest_frame_id_ - max_history_;
+  if (frame_id < oldest_frame_id) {
+    RTC_LOG(LS_WARNING) << "Frame with id " << frame_id
+                        << " is older than the history, dropping it.";
+    return;
+  }
+  history_.erase(history_.begin(), history_.lower_bound(oldest_frame_id));
+
+  if (TryResolve(assembled_frame)) {
+    AddToHistory(assembled_frame.frame, insert_result);
+  } else {
+    pending_frames_.emplace(frame_id, std::move(assembled_frame));
+  }
+  // A new frame may both be referenced by pending frames and have moved the
+  // history past the missing references of others.
+  ResolvePendingFrames(insert_result);
+}
+
+bool AssemblyOnlyFrameBuffer::TryResolve(
+    AssembledFrame& assembled_frame) const {
+  DecodeTargetSet decodable_targets = assembled_frame.present_targets;
+  const int64_t oldest_frame_id = *newest_frame_id_ - max_history_;
+  for (int64_t reference : assembled_frame.references) {
+    auto it = history_.find(reference);
+    if (it != history_.end()) {
+      decodable_targets &= it->second;
+    } else if (reference < oldest_frame_id) {
+      // The reference was never assembled and never will be.
+      decodable_targets.reset();
+    } else {
+      return false;
+    }
+  }
+  assembled_frame.frame.decodable_targets = decodable_targets;
+  return true;
+}
+
+void AssemblyOnlyFrameBuffer::AddToHistory(const Frame& frame,
+                                           InsertResult* insert_result) {
+  history_[frame.frame_id] = frame.decodable_targets;
+  insert_result->frames.push_back(frame);
+}
+
+void AssemblyOnlyFrameBuffer::ResolvePendingFrames(
+    InsertResult* insert_result) {
+  // Frames only reference older frames, so resolving in frame id order
+  // resolves a chain of pending frames in a single pass.
+  for (auto it = pending_frames_.begin(); it != pending_frames_.end();) {
+    if (TryResolve(it->second)) {
+      AddToHistory(it->second.frame, insert_result);
+      it = pending_frames_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace webrtc
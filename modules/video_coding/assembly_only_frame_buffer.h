@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_ASSEMBLY_ONLY_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CODING_ASSEMBLY_ONLY_FRAME_BUFFER_H_
+
+#include <bitset>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// The AssemblyOnlyFrameBuffer is meant for selective forwarding, where frames
+// are relayed rather than decoded. It assembles frames from RTP packets that
+// carry the dependency descriptor and reports, per decode target, which frames
+// are decodable, i.e. would be decodable by a receiver that is forwarded that
+// decode target. Payloads are neither copied, depacketized nor decoded, so the
+// caller forwards its own copies of the packets, identified by the sequence
+// number range of each reported frame.
+//
+// A frame is decodable for a decode target if the frame is part of that decode
+// target and all the frames it references are decodable for it. A frame is
+// reported once all the frames it references have been assembled, or have
+// fallen out of the history, even if it turns out not to be decodable for any
+// decode target.
+//
+// The dependency descriptor extension must be registered in the extension map
+// of the inserted packets. The AssemblyOnlyFrameBuffer is thread-unsafe.
+class AssemblyOnlyFrameBuffer {
+ public:
+  using DecodeTargetSet =
+      std::bitset<DependencyDescriptor::kMaxDecodeTargets>;
+
+  struct Frame {
+    int64_t frame_id = 0;
+    uint32_t rtp_timestamp = 0;
+    // Both first and last are inclusive.
+    uint16_t first_seq_num = 0;
+    uint16_t last_seq_num = 0;
+    int spatial_id = 0;
+    int temporal_id = 0;
+    bool is_keyframe = false;
+    // Bit `i` is set if the frame is decodable for decode target `i`.
+    DecodeTargetSet decodable_targets;
+  };
+
+  struct InsertResult {
+    // Frames whose decodability became known, each one after the frames it
+    // references.
+    std::vector<Frame> frames;
+    // Indicates that a key frame should be requested, either because the
+    // packet buffer was cleared or because a dependency descriptor could not
+    // be parsed for lack of a matching structure.
+    bool keyframe_needed = false;
+  };
+
+  // `start_buffer_size` and `max_buffer_size` are passed on to the
+  // PacketBuffer. `max_history` is how many frame ids the decodability of
+  // frames is remembered for, which bounds how far back references can reach.
+  AssemblyOnlyFrameBuffer(size_t start_buffer_size,
+                          size_t max_buffer_size,
+                          int max_history);
+  AssemblyOnlyFrameBuffer(const AssemblyOnlyFrameBuffer&) = delete;
+  AssemblyOnlyFrameBuffer& operator=(const AssemblyOnlyFrameBuffer&) = delete;
+  ~AssemblyOnlyFrameBuffer();
+
+  InsertResult InsertPacket(const RtpPacketReceived& rtp_packet);
+  InsertResult InsertPadding(uint16_t seq_num);
+
+  // The structure attached to the latest key frame, or nullptr before the
+  // first key frame.
+  const FrameDependencyStructure* structure() const { return structure_.get(); }
+
+ private:
+  struct AssembledFrame {
+    Frame frame;
+    absl::InlinedVector<int64_t, 5> references;
+    // Decode targets the frame is part of.
+    DecodeTargetSet present_targets;
+  };
+
+  void OnPacketBufferResult(video_coding::PacketBuffer::InsertResult result,
+                            InsertResult* insert_result);
+  void OnAssembledFrame(AssembledFrame assembled_frame,
+                        InsertResult* insert_result);
+  // Returns false if a reference has neither been resolved nor fallen out of
+  // the history yet.
+  bool TryResolve(AssembledFrame& assembled_frame) const;
+  void AddToHistory(const Frame& frame, InsertResult* insert_result);
+  void ResolvePendingFrames(InsertResult* insert_result);
+
+  const int max_history_;
+  video_coding::PacketBuffer packet_buffer_;
+  SeqNumUnwrapper<uint16_t> frame_id_unwrapper_;
+  std::unique_ptr<FrameDependencyStructure> structure_;
+  absl::optional<int64_t> structure_frame_id_;
+
+  // Decodable decode targets of recently resolved frames, by frame id.
+  std::map<int64_t, DecodeTargetSet> history_;
+  // Assembled frames waiting for the frames they reference, by frame id.
+  std::map<int64_t, AssembledFrame> pending_frames_;
+  absl::optional<int64_t> newest_frame_id_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_ASSEMBLY_ONLY_FRAME_BUFFER_H_
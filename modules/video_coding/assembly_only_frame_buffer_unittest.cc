@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/assembly_only_frame_buffer.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr int kMaxHistory = 8;
+
+// Decode target 0 is the base temporal layer, decode target 1 is both
+// temporal layers.
+constexpr int kKeyFrame = 0;
+constexpr int kDeltaT0 = 1;
+constexpr int kDeltaT1 = 2;
+constexpr uint32_t kBothTargets = 0b11;
+constexpr uint32_t kUpperTarget = 0b10;
+
+FrameDependencyStructure CreateL1T2Structure() {
+  FrameDependencyStructure structure;
+  structure.num_decode_targets = 2;
+  structure.templates = {
+      FrameDependencyTemplate().T(0).Dtis("SS"),
+      FrameDependencyTemplate().T(0).Dtis("SS").FrameDiffs({2}),
+      FrameDependencyTemplate().T(1).Dtis("-D").FrameDiffs({1}),
+  };
+  return structure;
+}
+
+std::vector<int64_t> FrameIds(
+    const AssemblyOnlyFrameBuffer::InsertResult& result) {
+  std::vector<int64_t> ids;
+  for (const auto& frame : result.frames)
+    ids.push_back(frame.frame_id);
+  return ids;
+}
+
+std::vector<uint32_t> DecodableTargets(
+    const AssemblyOnlyFrameBuffer::InsertResult& result) {
+  std::vector<uint32_t> targets;
+  for (const auto& frame : result.frames)
+    targets.push_back(frame.decodable_targets.to_ulong());
+  return targets;
+}
+
+class AssemblyOnlyFrameBufferTest : public ::testing::Test {
+ protected:
+  AssemblyOnlyFrameBufferTest()
+      : structure_(CreateL1T2Structure()),
+        buffer_(/*start_buffer_size=*/16, /*max_buffer_size=*/64, kMaxHistory) {
+    extension_map_.Register<RtpDependencyDescriptorExtension>(7);
+  }
+
+  RtpPacketReceived CreatePacket(int frame_number,
+                                 int template_index,
+                                 bool first_packet_in_frame,
+                                 bool last_packet_in_frame,
+                                 uint16_t seq_num) {
+    DependencyDescriptor descriptor;
+    descriptor.first_packet_in_frame = first_packet_in_frame;
+    descriptor.last_packet_in_frame = last_packet_in_frame;
+    descriptor.frame_number = frame_number;
+    descriptor.frame_dependencies = structure_.templates[template_index];
+    if (template_index == kKeyFrame && first_packet_in_frame) {
+      descriptor.attached_structure =
+          std::make_unique<FrameDependencyStructure>(structure_);
+    }
+    RtpPacketReceived rtp_packet(&extension_map_);
+    EXPECT_TRUE(rtp_packet.SetExtension<RtpDependencyDescriptorExtension>(
+        structure_, descriptor));
+    rtp_packet.SetSequenceNumber(seq_num);
+    rtp_packet.SetTimestamp(frame_number * 3000);
+    rtp_packet.SetMarker(last_packet_in_frame);
+    rtp_packet.SetPayloadSize(100);
+    return rtp_packet;
+  }
+
+  // Inserts the `num_packets` packets of a frame, and returns the result of
+  // inserting the last one.
+  AssemblyOnlyFrameBuffer::InsertResult InsertFrame(int frame_number,
+                                                    int template_index,
+                                                    int num_packets = 1) {
+    AssemblyOnlyFrameBuffer::InsertResult result;
+    for (int i = 0; i < num_packets; ++i) {
+      result = buffer_.InsertPacket(
+          CreatePacket(frame_number, template_index, i == 0,
+                       i == num_packets - 1, SeqNumForFrame(frame_number) + i));
+    }
+    return result;
+  }
+
+  // Frames get consecutive sequence numbers, with room for two packets each.
+  static uint16_t SeqNumForFrame(int frame_number) {
+    return 1000 + 2 * frame_number;
+  }
+
+  const FrameDependencyStructure structure_;
+  RtpHeaderExtensionMap extension_map_;
+  AssemblyOnlyFrameBuffer buffer_;
+};
+
+TEST_F(AssemblyOnlyFrameBufferTest, ReportsFrameOnceAllPacketsArrived) {
+  auto result = buffer_.InsertPacket(CreatePacket(
+      0, kKeyFrame, /*first_packet_in_frame=*/true,
+      /*last_packet_in_frame=*/false, SeqNumForFrame(0)));
+  EXPECT_THAT(result.frames, IsEmpty());
+  EXPECT_NE(buffer_.structure(), nullptr);
+
+  result = buffer_.InsertPacket(CreatePacket(
+      0, kKeyFrame, /*first_packet_in_frame=*/false,
+      /*last_packet_in_frame=*/true, SeqNumForFrame(0) + 1));
+  ASSERT_EQ(result.frames.size(), 1u);
+  const AssemblyOnlyFrameBuffer::Frame& frame = result.frames[0];
+  EXPECT_TRUE(frame.is_keyframe);
+  EXPECT_EQ(frame.first_seq_num, SeqNumForFrame(0));
+  EXPECT_EQ(frame.last_seq_num, SeqNumForFrame(0) + 1);
+  EXPECT_EQ(frame.rtp_timestamp, 0u);
+  EXPECT_EQ(frame.decodable_targets.to_ulong(), kBothTargets);
+  EXPECT_FALSE(result.keyframe_needed);
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, ReportsDecodableTargetsPerFrame) {
+  EXPECT_THAT(DecodableTargets(InsertFrame(0, kKeyFrame)),
+              ElementsAre(kBothTargets));
+  EXPECT_THAT(DecodableTargets(InsertFrame(1, kDeltaT1)),
+              ElementsAre(kUpperTarget));
+  EXPECT_THAT(DecodableTargets(InsertFrame(2, kDeltaT0)),
+              ElementsAre(kBothTargets));
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, LostUpperLayerFrameKeepsBaseDecodable) {
+  InsertFrame(0, kKeyFrame);
+  // Frame 1 is lost, nothing references it.
+  EXPECT_THAT(DecodableTargets(InsertFrame(2, kDeltaT0)),
+              ElementsAre(kBothTargets));
+  EXPECT_THAT(DecodableTargets(InsertFrame(3, kDeltaT1)),
+              ElementsAre(kUpperTarget));
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, WaitsForReferencedFrame) {
+  InsertFrame(0, kKeyFrame);
+  EXPECT_THAT(InsertFrame(3, kDeltaT1).frames, IsEmpty());
+  EXPECT_THAT(InsertFrame(4, kDeltaT0).frames, IsEmpty());
+
+  auto result = InsertFrame(2, kDeltaT0);
+  EXPECT_THAT(FrameIds(result), ElementsAre(2, 3, 4));
+  EXPECT_THAT(DecodableTargets(result),
+              ElementsAre(kBothTargets, kUpperTarget, kBothTargets));
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, ReportsFrameWithLostReferenceAsUndecodable) {
+  InsertFrame(0, kKeyFrame);
+  // Frame 2 is lost, so frame 3 waits for it until it leaves the history.
+  EXPECT_THAT(InsertFrame(3, kDeltaT1).frames, IsEmpty());
+
+  auto result = InsertFrame(2 + kMaxHistory + 1, kKeyFrame);
+  EXPECT_THAT(FrameIds(result), ElementsAre(2 + kMaxHistory + 1, 3));
+  EXPECT_THAT(DecodableTargets(result), ElementsAre(kBothTargets, 0u));
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, IgnoresFrameAssembledTwice) {
+  EXPECT_THAT(FrameIds(InsertFrame(0, kKeyFrame)), ElementsAre(0));
+  EXPECT_THAT(FrameIds(InsertFrame(2, kDeltaT0)), ElementsAre(2));
+  EXPECT_THAT(InsertFrame(2, kDeltaT0).frames, IsEmpty());
+}
+
+TEST_F(AssemblyOnlyFrameBufferTest, RequestsKeyFrameWithoutStructure) {
+  auto result = InsertFrame(1, kDeltaT0);
+  EXPECT_TRUE(result.keyframe_needed);
+  EXPECT_THAT(result.frames, IsEmpty());
+}
+
+}  // namespace
+}  // namespace webrtc
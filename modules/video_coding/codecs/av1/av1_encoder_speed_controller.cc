@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/av1/av1_encoder_speed_controller.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+Av1EncoderSpeedController::Av1EncoderSpeedController(const Config& config)
+    : config_(config), speed_(config.min_speed) {
+  RTC_DCHECK_LE(config_.min_speed, config_.max_speed);
+  RTC_DCHECK_LT(config_.min_load, config_.max_load);
+  RTC_DCHECK_GT(config_.window_frames, 0);
+}
+
+absl::optional<int> Av1EncoderSpeedController::OnFrameEncoded(
+    TimeDelta encode_time,
+    TimeDelta frame_interval) {
+  if (frame_interval <= TimeDelta::Zero())
+    return absl::nullopt;
+  load_sum_ += encode_time / frame_interval;
+  if (++frames_in_window_ < config_.window_frames)
+    return absl::nullopt;
+
+  double load = load_sum_ / frames_in_window_;
+  frames_in_window_ = 0;
+  load_sum_ = 0.0;
+  if (load > config_.max_load && speed_ < config_.max_speed) {
+    return ++speed_;
+  }
+  if (load < config_.min_load && speed_ > config_.min_speed) {
+    return --speed_;
+  }
+  return absl::nullopt;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_AV1_AV1_ENCODER_SPEED_CONTROLLER_H_
+#define MODULES_VIDEO_CODING_CODECS_AV1_AV1_ENCODER_SPEED_CONTROLLER_H_
+
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// Picks the encoder speed setting (cpu-used) from the measured encode time,
+// so that a device too slow for the configured speed falls back to faster,
+// lower quality encoding instead of dropping frames.
+class Av1EncoderSpeedController {
+ public:
+  struct Config {
+    // The configured speed, which is never decreased below.
+    int min_speed = 10;
+    int max_speed = 10;
+    // The speed is increased when the average encode time exceeds
+    // `max_load` of the frame interval, and decreased when it is below
+    // `min_load`.
+    double max_load = 0.8;
+    double min_load = 0.4;
+    // Number of frames to average the encode time over between changes.
+    int window_frames = 30;
+  };
+
+  explicit Av1EncoderSpeedController(const Config& config);
+
+  int speed() const { return speed_; }
+
+  // Reports the time it took to encode a frame. Returns the new speed if it
+  // should be changed.
+  absl::optional<int> OnFrameEncoded(TimeDelta encode_time,
+                                     TimeDelta frame_interval);
+
+ private:
+  const Config config_;
+  int speed_;
+  int frames_in_window_ = 0;
+  double load_sum_ = 0.0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_AV1_AV1_ENCODER_SPEED_CONTROLLER_H_
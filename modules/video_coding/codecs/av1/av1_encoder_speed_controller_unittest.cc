@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/av1/av1_encoder_speed_controller.h"
+
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kFrameInterval = TimeDelta::Millis(30);
+
+Av1EncoderSpeedController::Config TestConfig() {
+  Av1EncoderSpeedController::Config config;
+  config.min_speed = 7;
+  config.max_speed = 9;
+  config.window_frames = 10;
+  return config;
+}
+
+// Encodes a window of frames and returns the last result.
+absl::optional<int> EncodeWindow(Av1EncoderSpeedController& controller,
+                                 TimeDelta encode_time) {
+  absl::optional<int> new_speed;
+  for (int i = 0; i < TestConfig().window_frames; ++i) {
+    EXPECT_FALSE(new_speed.has_value());
+    new_speed = controller.OnFrameEncoded(encode_time, kFrameInterval);
+  }
+  return new_speed;
+}
+
+TEST(Av1EncoderSpeedControllerTest, StartsAtMinSpeed) {
+  Av1EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(controller.speed(), 7);
+}
+
+TEST(Av1EncoderSpeedControllerTest, KeepsSpeedWhenLoadIsModerate) {
+  Av1EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(18)), absl::nullopt);
+  EXPECT_EQ(controller.speed(), 7);
+}
+
+TEST(Av1EncoderSpeedControllerTest, IncreasesSpeedUpToMaxWhenOverloaded) {
+  Av1EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(28)), 8);
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(28)), 9);
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(28)), absl::nullopt);
+  EXPECT_EQ(controller.speed(), 9);
+}
+
+TEST(Av1EncoderSpeedControllerTest, DecreasesSpeedDownToMinWhenUnderloaded) {
+  Av1EncoderSpeedController controller(TestConfig());
+  EncodeWindow(controller, TimeDelta::Millis(28));
+  EncodeWindow(controller, TimeDelta::Millis(28));
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(5)), 8);
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(5)), 7);
+  EXPECT_EQ(EncodeWindow(controller, TimeDelta::Millis(5)), absl::nullopt);
+  EXPECT_EQ(controller.speed(), 7);
+}
+
+TEST(Av1EncoderSpeedControllerTest, AveragesEncodeTimeOverWindow) {
+  Av1EncoderSpeedController controller(TestConfig());
+  // A single slow key frame doesn't make the average exceed the limit.
+  controller.OnFrameEncoded(TimeDelta::Millis(60), kFrameInterval);
+  for (int i = 1; i < TestConfig().window_frames; ++i) {
+    EXPECT_EQ(controller.OnFrameEncoded(TimeDelta::Millis(15), kFrameInterval),
+              absl::nullopt);
+  }
+  EXPECT_EQ(controller.speed(), 7);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -11,15 +11,20 @@
 #include "modules/video_coding/codecs/av1/dav1d_decoder.h"
 
 #include <algorithm>
+#include <deque>
 
+#include "absl/types/optional.h"
+#include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
+#include "api/video/color_space.h"
 #include "api/video/encoded_image.h"
-#include "api/video/i420_buffer.h"
-#include "common_video/include/video_frame_buffer_pool.h"
+#include "api/video/video_frame.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/dav1d/libdav1d/include/dav1d/dav1d.h"
-#include "third_party/libyuv/include/libyuv/convert.h"
 
 namespace webrtc {
 namespace {
@@ -43,9 +48,22 @@ class Dav1dDecoder : public VideoDecoder {
   const char* ImplementationName() const override;
 
  private:
-  VideoFrameBufferPool buffer_pool_;
+  // Metadata of a frame that is passed to dav1d, to be attached to the
+  // decoded picture.
+  struct PendingFrame {
+    uint32_t rtp_timestamp;
+    int64_t ntp_time_ms;
+    absl::optional<ColorSpace> color_space;
+  };
+
+  // Delivers the pictures dav1d has finished decoding. Returns the number of
+  // delivered pictures, or a negative error code.
+  int DeliverDecodedPictures();
+
   Dav1dContext* context_ = nullptr;
   DecodedImageCallback* decode_complete_callback_ = nullptr;
+  int max_frame_delay_ = 1;
+  std::deque<PendingFrame> pending_frames_;
 };
 
 class ScopedDav1dData {
@@ -58,7 +76,11 @@ class ScopedDav1dData {
   Dav1dData data_ = {};
 };
 
-class ScopedDav1dPicture {
+// Reference counted, so that the decoded frame can wrap the picture buffers
+// of dav1d instead of copying them. dav1d doesn't reuse the buffers until
+// the last reference is released.
+class ScopedDav1dPicture
+    : public rtc::RefCountedNonVirtual<ScopedDav1dPicture> {
  public:
   ~ScopedDav1dPicture() { dav1d_picture_unref(&picture_); }
 
@@ -69,12 +91,35 @@ class ScopedDav1dPicture {
 };
 
 constexpr char kDav1dName[] = "dav1d";
+// Every frame of delay adds a frame interval of latency.
+constexpr int kMaxFrameDelay = 3;
+
+struct ThreadingSettings {
+  // Maximum number of threads dav1d uses for frame and tile threading.
+  absl::optional<int> max_threads;
+  // Number of frames dav1d may decode in parallel before it outputs the
+  // first of them.
+  int max_frame_delay = 1;
+};
+
+ThreadingSettings ParseThreadingSettings() {
+  ThreadingSettings settings;
+  FieldTrialOptional<int> max_threads("max_threads");
+  FieldTrialParameter<int> max_frame_delay("max_frame_delay",
+                                           settings.max_frame_delay);
+  ParseFieldTrial({&max_threads, &max_frame_delay},
+                  field_trial::FindFullName("WebRTC-Dav1dDecoder-Threading"));
+  if (max_threads && *max_threads >= 1)
+    settings.max_threads = *max_threads;
+  settings.max_frame_delay =
+      std::min(std::max(max_frame_delay.Get(), 1), kMaxFrameDelay);
+  return settings;
+}
 
 // Calling `dav1d_data_wrap` requires a `free_callback` to be registered.
 void NullFreeCallback(const uint8_t* buffer, void* opaque) {}
 
-Dav1dDecoder::Dav1dDecoder()
-    : buffer_pool_(/*zero_initialize=*/false, /*max_number_of_buffers=*/150) {}
+Dav1dDecoder::Dav1dDecoder() = default;
 
 Dav1dDecoder::~Dav1dDecoder() {
   Release();
@@ -84,8 +129,13 @@ bool Dav1dDecoder::Configure(const Settings& settings) {
   Dav1dSettings s;
   dav1d_default_settings(&s);
 
+  const ThreadingSettings threading = ParseThreadingSettings();
   s.n_threads = std::max(2, settings.number_of_cores());
-  s.max_frame_delay = 1;   // For low latency decoding.
+  if (threading.max_threads)
+    s.n_threads = std::min(s.n_threads, *threading.max_threads);
+  // Low by default, for low latency decoding.
+  max_frame_delay_ = std::min(threading.max_frame_delay, s.n_threads);
+  s.max_frame_delay = max_frame_delay_;
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   s.operating_point = 31;  // Decode all operating points.
 
@@ -103,7 +153,7 @@ int32_t Dav1dDecoder::Release() {
   if (context_ != nullptr) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
-  buffer_pool_.Release();
+  pending_frames_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -130,62 +180,100 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
   dav1d_data_wrap(&dav1d_data, encoded_image.data(), encoded_image.size(),
                   /*free_callback=*/&NullFreeCallback,
                   /*user_data=*/nullptr);
-
-  if (int decode_res = dav1d_send_data(context_, &dav1d_data)) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode decoding failed with error code "
-        << decode_res;
-    return WEBRTC_VIDEO_CODEC_ERROR;
+  dav1d_data.m.timestamp = encoded_image.Timestamp();
+  PendingFrame& pending_frame = pending_frames_.emplace_back();
+  pending_frame.rtp_timestamp = encoded_image.Timestamp();
+  pending_frame.ntp_time_ms = encoded_image.ntp_time_ms_;
+  if (const ColorSpace* color_space = encoded_image.ColorSpace())
+    pending_frame.color_space = *color_space;
+
+  int delivered = 0;
+  while (dav1d_data.sz > 0) {
+    int decode_res = dav1d_send_data(context_, &dav1d_data);
+    if (decode_res == DAV1D_ERR(EAGAIN)) {
+      // dav1d accepts more data once decoded pictures have been taken out.
+      int res = DeliverDecodedPictures();
+      if (res < 0)
+        return WEBRTC_VIDEO_CODEC_ERROR;
+      delivered += res;
+      continue;
+    }
+    if (decode_res != 0) {
+      RTC_LOG(LS_WARNING)
+          << "Dav1dDecoder::Decode decoding failed with error code "
+          << decode_res;
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
   }
 
-  ScopedDav1dPicture scoped_dav1d_picture;
-  Dav1dPicture& dav1d_picture = scoped_dav1d_picture.Picture();
-  if (int get_picture_res = dav1d_get_picture(context_, &dav1d_picture)) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode getting picture failed with error code "
-        << get_picture_res;
+  int res = DeliverDecodedPictures();
+  if (res < 0)
     return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-
-  // Only accept I420 pixel format and 8 bit depth.
-  if (dav1d_picture.p.layout != DAV1D_PIXEL_LAYOUT_I420 ||
-      dav1d_picture.p.bpc != 8) {
+  delivered += res;
+  // Without frame delay every frame must result in a picture.
+  if (delivered == 0 && max_frame_delay_ == 1) {
+    RTC_LOG(LS_WARNING) << "Dav1dDecoder::Decode got no picture.";
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
 
-  rtc::scoped_refptr<I420Buffer> buffer =
-      buffer_pool_.CreateI420Buffer(dav1d_picture.p.w, dav1d_picture.p.h);
-  if (!buffer.get()) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode failed to get frame from the buffer pool.";
-    return WEBRTC_VIDEO_CODEC_ERROR;
+int Dav1dDecoder::DeliverDecodedPictures() {
+  int delivered = 0;
+  while (true) {
+    rtc::scoped_refptr<ScopedDav1dPicture> scoped_dav1d_picture(
+        new ScopedDav1dPicture());
+    Dav1dPicture& dav1d_picture = scoped_dav1d_picture->Picture();
+    int get_picture_res = dav1d_get_picture(context_, &dav1d_picture);
+    if (get_picture_res == DAV1D_ERR(EAGAIN)) {
+      return delivered;
+    }
+    if (get_picture_res != 0) {
+      RTC_LOG(LS_WARNING)
+          << "Dav1dDecoder::Decode getting picture failed with error code "
+          << get_picture_res;
+      return get_picture_res;
+    }
+
+    // Only accept I420 pixel format and 8 bit depth.
+    if (dav1d_picture.p.layout != DAV1D_PIXEL_LAYOUT_I420 ||
+        dav1d_picture.p.bpc != 8) {
+      return -1;
+    }
+
+    // Pictures are output in decode order, so the metadata of frames that
+    // weren't output, e.g. because they failed to decode, is dropped.
+    const uint32_t rtp_timestamp =
+        static_cast<uint32_t>(dav1d_picture.m.timestamp);
+    while (!pending_frames_.empty() &&
+           pending_frames_.front().rtp_timestamp != rtp_timestamp) {
+      pending_frames_.pop_front();
+    }
+    PendingFrame frame = {rtp_timestamp, -1, absl::nullopt};
+    if (!pending_frames_.empty()) {
+      frame = std::move(pending_frames_.front());
+      pending_frames_.pop_front();
+    }
+
+    // The frame holds a reference to the picture until it is no longer used.
+    rtc::scoped_refptr<I420BufferInterface> buffer = WrapI420Buffer(
+        dav1d_picture.p.w, dav1d_picture.p.h,
+        static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
+        static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
+        static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
+        [scoped_dav1d_picture] {});
+
+    VideoFrame decoded_frame = VideoFrame::Builder()
+                                   .set_video_frame_buffer(buffer)
+                                   .set_timestamp_rtp(frame.rtp_timestamp)
+                                   .set_ntp_time_ms(frame.ntp_time_ms)
+                                   .set_color_space(frame.color_space)
+                                   .build();
+
+    decode_complete_callback_->Decoded(decoded_frame, absl::nullopt,
+                                       absl::nullopt);
+    ++delivered;
   }
-
-  uint8_t* y_data = static_cast<uint8_t*>(dav1d_picture.data[0]);
-  uint8_t* u_data = static_cast<uint8_t*>(dav1d_picture.data[1]);
-  uint8_t* v_data = static_cast<uint8_t*>(dav1d_picture.data[2]);
-  int y_stride = dav1d_picture.stride[0];
-  int uv_stride = dav1d_picture.stride[1];
-  libyuv::I420Copy(y_data, y_stride,                           //
-                   u_data, uv_stride,                          //
-                   v_data, uv_stride,                          //
-                   buffer->MutableDataY(), buffer->StrideY(),  //
-                   buffer->MutableDataU(), buffer->StrideU(),  //
-                   buffer->MutableDataV(), buffer->StrideV(),  //
-                   dav1d_picture.p.w,                          //
-                   dav1d_picture.p.h);                         //
-
-  VideoFrame decoded_frame = VideoFrame::Builder()
-                                 .set_video_frame_buffer(buffer)
-                                 .set_timestamp_rtp(encoded_image.Timestamp())
-                                 .set_ntp_time_ms(encoded_image.ntp_time_ms_)
-                                 .set_color_space(encoded_image.ColorSpace())
-                                 .build();
-
-  decode_complete_callback_->Decoded(decoded_frame, absl::nullopt,
-                                     absl::nullopt);
-
-  return WEBRTC_VIDEO_CODEC_OK;
 }
 
 }  // namespace
@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -20,18 +21,26 @@
 #include "absl/base/macros.h"
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
+#include "api/video_codecs/encoder_resource_broker.h"
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "modules/video_coding/codecs/av1/av1_encoder_speed_controller.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/svc/create_scalability_structure.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/svc/scalable_video_controller_no_layering.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/libaom/source/libaom/aom/aom_codec.h"
 #include "third_party/libaom/source/libaom/aom/aom_encoder.h"
 #include "third_party/libaom/source/libaom/aom/aomcx.h"
@@ -48,6 +57,57 @@ constexpr int kBitDepth = 8;
 constexpr int kLagInFrames = 0;  // No look ahead.
 constexpr int kRtpTicksPerSecond = 90000;
 constexpr float kMinimumFrameRate = 1.0;
+constexpr int kMaxCpuSpeed = 10;
+
+// Overrides of the threading and speed heuristics below, to tune the encoder
+// for the devices it runs on.
+struct SpeedSettings {
+  // Lets the threads encode rows of the same tile in parallel.
+  bool row_mt = true;
+  // Maximum number of encoder threads.
+  absl::optional<int> threads;
+  // Log2 of the number of tile columns and rows.
+  absl::optional<int> tile_columns;
+  absl::optional<int> tile_rows;
+  // cpu-used value to use instead of the one derived from the complexity.
+  absl::optional<int> cpu_speed;
+  // Increases cpu-used when the encode time doesn't leave enough headroom
+  // for real-time encoding, and decreases it back when it does.
+  bool adaptive_speed = false;
+  double max_load = 0.8;
+  double min_load = 0.4;
+};
+
+SpeedSettings ParseSpeedSettings() {
+  SpeedSettings settings;
+  FieldTrialParameter<bool> row_mt("row_mt", settings.row_mt);
+  FieldTrialOptional<int> threads("threads");
+  FieldTrialOptional<int> tile_columns("tile_columns");
+  FieldTrialOptional<int> tile_rows("tile_rows");
+  FieldTrialOptional<int> cpu_speed("cpu_speed");
+  FieldTrialFlag adaptive_speed("adaptive_speed");
+  FieldTrialParameter<double> max_load("max_load", settings.max_load);
+  FieldTrialParameter<double> min_load("min_load", settings.min_load);
+  ParseFieldTrial({&row_mt, &threads, &tile_columns, &tile_rows, &cpu_speed,
+                   &adaptive_speed, &max_load, &min_load},
+                  field_trial::FindFullName(
+                      "WebRTC-LibaomAv1Encoder-SpeedSettings"));
+  settings.row_mt = row_mt.Get();
+  if (threads && *threads >= 1)
+    settings.threads = *threads;
+  if (tile_columns && *tile_columns >= 0)
+    settings.tile_columns = *tile_columns;
+  if (tile_rows && *tile_rows >= 0)
+    settings.tile_rows = *tile_rows;
+  if (cpu_speed)
+    settings.cpu_speed = rtc::SafeClamp(*cpu_speed, 0, kMaxCpuSpeed);
+  if (max_load.Get() > min_load.Get()) {
+    settings.adaptive_speed = adaptive_speed.Get();
+    settings.max_load = max_load.Get();
+    settings.min_load = min_load.Get();
+  }
+  return settings;
+}
 
 aom_superblock_size_t GetSuperblockSize(int width, int height, int threads) {
   int resolution = width * height;
@@ -94,7 +154,9 @@ class LibaomAv1Encoder final : public VideoEncoder {
   void SetSvcRefFrameConfig(
       const ScalableVideoController::LayerFrameConfig& layer_frame);
 
+  const SpeedSettings speed_settings_;
   std::unique_ptr<ScalableVideoController> svc_controller_;
+  absl::optional<Av1EncoderSpeedController> speed_controller_;
   bool inited_;
   bool rates_configured_;
   absl::optional<aom_svc_params_t> svc_params_;
@@ -102,6 +164,8 @@ class LibaomAv1Encoder final : public VideoEncoder {
   aom_image_t* frame_for_encode_;
   aom_codec_ctx_t ctx_;
   aom_codec_enc_cfg_t cfg_;
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> thread_quota_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   EncodedImageCallback* encoded_image_callback_;
 };
 
@@ -131,7 +195,8 @@ int32_t VerifyCodecSettings(const VideoCodec& codec_settings) {
 }
 
 LibaomAv1Encoder::LibaomAv1Encoder()
-    : inited_(false),
+    : speed_settings_(ParseSpeedSettings()),
+      inited_(false),
       rates_configured_(false),
       frame_for_encode_(nullptr),
       encoded_image_callback_(nullptr) {}
@@ -195,8 +260,17 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   // Overwrite default config with input encoder settings & RTC-relevant values.
   cfg_.g_w = encoder_settings_.width;
   cfg_.g_h = encoder_settings_.height;
-  cfg_.g_threads =
-      NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+  const int max_threads =
+      speed_settings_.threads
+          ? std::min(*speed_settings_.threads, settings.number_of_cores)
+          : NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+  thread_quota_ = EncoderResourceBroker::Default().RequestThreads(
+      {max_threads,
+       encoder_settings_.width * encoder_settings_.height,
+       encoder_settings_.mode == VideoCodecMode::kScreensharing
+           ? EncoderResourceBroker::Priority::kLow
+           : EncoderResourceBroker::Priority::kNormal});
+  cfg_.g_threads = thread_quota_->threads();
   cfg_.g_timebase.num = 1;
   cfg_.g_timebase.den = kRtpTicksPerSecond;
   cfg_.rc_target_bitrate = encoder_settings_.maxBitrate;  // kilobits/sec.
@@ -235,8 +309,19 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   inited_ = true;
 
   // Set control parameters
-  ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED,
-                          GetCpuSpeed(cfg_.g_w, cfg_.g_h));
+  const int cpu_speed =
+      speed_settings_.cpu_speed.value_or(GetCpuSpeed(cfg_.g_w, cfg_.g_h));
+  if (speed_settings_.adaptive_speed) {
+    Av1EncoderSpeedController::Config speed_config;
+    speed_config.min_speed = cpu_speed;
+    speed_config.max_speed = kMaxCpuSpeed;
+    speed_config.max_load = speed_settings_.max_load;
+    speed_config.min_load = speed_settings_.min_load;
+    speed_controller_.emplace(speed_config);
+  } else {
+    speed_controller_.reset();
+  }
+  ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, cpu_speed);
   if (ret != AOM_CODEC_OK) {
     RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
                         << " on control AV1E_SET_CPUUSED.";
@@ -297,8 +382,23 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  if (cfg_.g_threads == 4 && cfg_.g_w == 640 &&
-      (cfg_.g_h == 360 || cfg_.g_h == 480)) {
+  if (speed_settings_.tile_columns || speed_settings_.tile_rows) {
+    ret = aom_codec_control(&ctx_, AV1E_SET_TILE_COLUMNS,
+                            speed_settings_.tile_columns.value_or(0));
+    if (ret != AOM_CODEC_OK) {
+      RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
+                          << " on control AV1E_SET_TILE_COLUMNS.";
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    ret = aom_codec_control(&ctx_, AV1E_SET_TILE_ROWS,
+                            speed_settings_.tile_rows.value_or(0));
+    if (ret != AOM_CODEC_OK) {
+      RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
+                          << " on control AV1E_SET_TILE_ROWS.";
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+  } else if (cfg_.g_threads == 4 && cfg_.g_w == 640 &&
+             (cfg_.g_h == 360 || cfg_.g_h == 480)) {
     ret = aom_codec_control(&ctx_, AV1E_SET_TILE_ROWS,
                             static_cast<int>(log2(cfg_.g_threads)));
     if (ret != AOM_CODEC_OK) {
@@ -316,7 +416,8 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     }
   }
 
-  ret = aom_codec_control(&ctx_, AV1E_SET_ROW_MT, 1);
+  ret = aom_codec_control(&ctx_, AV1E_SET_ROW_MT,
+                          speed_settings_.row_mt ? 1 : 0);
   if (ret != AOM_CODEC_OK) {
     RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
                         << " on control AV1E_SET_ROW_MT.";
@@ -574,6 +675,8 @@ int32_t LibaomAv1Encoder::Release() {
     }
     inited_ = false;
   }
+  encoded_image_buffer_pool_.Release();
+  thread_quota_.reset();
   rates_configured_ = false;
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -635,6 +738,7 @@ int32_t LibaomAv1Encoder::Encode(
 
   const size_t num_spatial_layers =
       svc_params_ ? svc_params_->number_spatial_layers : 1;
+  const int64_t encode_start_us = rtc::TimeMicros();
   auto next_layer_frame = layer_frames.begin();
   for (size_t i = 0; i < num_spatial_layers; ++i) {
     // The libaom AV1 encoder requires that `aom_codec_encode` is called for
@@ -696,7 +800,7 @@ int32_t LibaomAv1Encoder::Encode(
                                  "one data packet for an input video frame.";
           Release();
         }
-        encoded_image.SetEncodedData(EncodedImageBuffer::Create(
+        encoded_image.SetEncodedData(encoded_image_buffer_pool_.CreateBuffer(
             /*data=*/static_cast<const uint8_t*>(pkt->data.frame.buf),
             /*size=*/pkt->data.frame.sz));
 
@@ -766,6 +870,22 @@ int32_t LibaomAv1Encoder::Encode(
     }
   }
 
+  if (speed_controller_) {
+    absl::optional<int> new_speed = speed_controller_->OnFrameEncoded(
+        TimeDelta::Micros(rtc::TimeMicros() - encode_start_us),
+        TimeDelta::Seconds(1) / encoder_settings_.maxFramerate);
+    if (new_speed) {
+      RTC_LOG(LS_INFO) << "LibaomAv1Encoder changes cpu speed to "
+                       << *new_speed << ".";
+      aom_codec_err_t ret =
+          aom_codec_control(&ctx_, AOME_SET_CPUUSED, *new_speed);
+      if (ret != AOM_CODEC_OK) {
+        RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
+                            << " on control AOME_SET_CPUUSED.";
+      }
+    }
+  }
+
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
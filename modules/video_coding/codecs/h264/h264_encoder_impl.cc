@@ -88,15 +88,16 @@ VideoFrameType ConvertToVideoFrameType(EVideoFrameType type) {
 }  // namespace
 
 // Helper method used by H264EncoderImpl::Encode.
-// Copies the encoded bytes from `info` to `encoded_image`. The
-// `encoded_image->_buffer` may be deleted and reallocated if a bigger buffer is
-// required.
+// Copies the encoded bytes from `info` to `encoded_image`, into a buffer from
+// `buffer_pool`.
 //
 // After OpenH264 encoding, the encoded bytes are stored in `info` spread out
 // over a number of layers and "NAL units". Each NAL unit is a fragment starting
 // with the four-byte start code {0,0,0,1}. All of this data (including the
 // start codes) is copied to the `encoded_image->_buffer`.
-static void RtpFragmentize(EncodedImage* encoded_image, SFrameBSInfo* info) {
+static void RtpFragmentize(EncodedImage* encoded_image,
+                           SFrameBSInfo* info,
+                           EncodedImageBufferPool* buffer_pool) {
   // Calculate minimum buffer size required to hold encoded data.
   size_t required_capacity = 0;
   size_t fragments_count = 0;
@@ -110,8 +111,8 @@ static void RtpFragmentize(EncodedImage* encoded_image, SFrameBSInfo* info) {
       required_capacity += layerInfo.pNalLengthInByte[nal];
     }
   }
-  // TODO(nisse): Use a cache or buffer pool to avoid allocation?
-  auto buffer = EncodedImageBuffer::Create(required_capacity);
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer =
+      buffer_pool->CreateBuffer(required_capacity);
   encoded_image->SetEncodedData(buffer);
 
   // Iterate layers and NAL units, note each NAL unit as a fragment and copy
@@ -198,6 +199,7 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
   encoders_.resize(number_of_streams);
   pictures_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
+  thread_quotas_.resize(number_of_streams);
   tl0sync_limit_.resize(number_of_streams);
 
   number_of_cores_ = settings.number_of_cores;
@@ -257,6 +259,14 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
     configurations_[i].max_bps = codec_.maxBitrate * 1000;
     configurations_[i].target_bps = codec_.startBitrate * 1000;
 
+    thread_quotas_[i] = EncoderResourceBroker::Default().RequestThreads(
+        {NumberOfThreads(configurations_[i].width, configurations_[i].height,
+                         number_of_cores_),
+         configurations_[i].width * configurations_[i].height,
+         codec_.mode == VideoCodecMode::kScreensharing
+             ? EncoderResourceBroker::Priority::kLow
+             : EncoderResourceBroker::Priority::kNormal});
+
     // Create encoder parameters based on the layer configuration.
     SEncParamExt encoder_params = CreateEncoderParams(i);
 
@@ -303,7 +313,9 @@ int32_t H264EncoderImpl::Release() {
   }
   downscaled_buffers_.clear();
   configurations_.clear();
+  thread_quotas_.clear();
   encoded_images_.clear();
+  encoded_image_buffer_pool_.Release();
   pictures_.clear();
   tl0sync_limit_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
@@ -486,7 +498,7 @@ int32_t H264EncoderImpl::Encode(
 
     // Split encoded image up into fragments. This also updates
     // `encoded_image_`.
-    RtpFragmentize(&encoded_images_[i], &info);
+    RtpFragmentize(&encoded_images_[i], &info, &encoded_image_buffer_pool_);
 
     // Encoder can skip frames to save bandwidth in which case
     // `encoded_images_[i]._length` == 0.
@@ -566,8 +578,7 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
   //  0: auto (dynamic imp. internal encoder)
   //  1: single thread (default value)
   // >1: number of threads
-  encoder_params.iMultipleThreadIdc = NumberOfThreads(
-      encoder_params.iPicWidth, encoder_params.iPicHeight, number_of_cores_);
+  encoder_params.iMultipleThreadIdc = thread_quotas_[i]->threads();
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
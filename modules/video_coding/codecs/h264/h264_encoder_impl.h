@@ -25,8 +25,10 @@
 #include <vector>
 
 #include "api/video/i420_buffer.h"
+#include "api/video_codecs/encoder_resource_broker.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_video/h264/h264_bitstream_parser.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/utility/quality_scaler.h"
 #include "third_party/openh264/src/codec/api/svc/codec_app_def.h"
@@ -96,7 +98,11 @@ class H264EncoderImpl : public H264Encoder {
   std::vector<SSourcePicture> pictures_;
   std::vector<rtc::scoped_refptr<I420Buffer>> downscaled_buffers_;
   std::vector<LayerConfig> configurations_;
+  std::vector<std::unique_ptr<EncoderResourceBroker::ThreadQuota>>
+      thread_quotas_;
   std::vector<EncodedImage> encoded_images_;
+  // Holds the bitstream of `encoded_images_`, for all streams.
+  EncodedImageBufferPool encoded_image_buffer_pool_;
 
   VideoCodec codec_;
   H264PacketizationMode packetization_mode_;
@@ -15,10 +15,14 @@
 #include <memory>
 #include <vector>
 
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_decoder.h"
 #include "api/video_codecs/video_decoder_factory.h"
 #include "modules/video_coding/codecs/multiplex/include/multiplex_encoder_adapter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -69,10 +73,20 @@ class MultiplexDecoderAdapter : public VideoDecoder {
   std::vector<std::unique_ptr<AdapterDecodedImageCallback>> adapter_callbacks_;
   DecodedImageCallback* decoded_complete_callback_;
 
+  // The components of a frame are decoded on different threads, and may be
+  // delivered on either.
+  Mutex lock_;
   // Holds YUV or AXX decode output of a frame that is identified by timestamp.
-  std::map<uint32_t /* timestamp */, DecodedImageData> decoded_data_;
-  std::map<uint32_t /* timestamp */, AugmentingData> decoded_augmenting_data_;
+  std::map<uint32_t /* timestamp */, DecodedImageData> decoded_data_
+      RTC_GUARDED_BY(lock_);
+  std::map<uint32_t /* timestamp */, AugmentingData> decoded_augmenting_data_
+      RTC_GUARDED_BY(lock_);
   const bool supports_augmenting_data_;
+
+  // Decodes the alpha component while the YUV component is decoded on the
+  // calling thread. Null if parallel decoding is disabled.
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  std::unique_ptr<rtc::TaskQueue> alpha_decode_queue_;
 };
 
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "modules/video_coding/codecs/multiplex/include/multiplex_decoder_adapter.h"
 
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
@@ -17,7 +18,9 @@
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/codecs/multiplex/include/augmented_video_frame_buffer.h"
 #include "modules/video_coding/codecs/multiplex/multiplex_encoded_image_packer.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -98,7 +101,11 @@ MultiplexDecoderAdapter::MultiplexDecoderAdapter(
     bool supports_augmenting_data)
     : factory_(factory),
       associated_format_(associated_format),
-      supports_augmenting_data_(supports_augmenting_data) {}
+      supports_augmenting_data_(supports_augmenting_data),
+      task_queue_factory_(
+          field_trial::IsDisabled("WebRTC-MultiplexParallelDecoding")
+              ? nullptr
+              : CreateDefaultTaskQueueFactory()) {}
 
 MultiplexDecoderAdapter::~MultiplexDecoderAdapter() {
   Release();
@@ -121,6 +128,11 @@ bool MultiplexDecoderAdapter::Configure(const Settings& settings) {
     decoder->RegisterDecodeCompleteCallback(adapter_callbacks_.back().get());
     decoders_.emplace_back(std::move(decoder));
   }
+  if (task_queue_factory_ && !alpha_decode_queue_) {
+    alpha_decode_queue_ = std::make_unique<rtc::TaskQueue>(
+        task_queue_factory_->CreateTaskQueue(
+            "MultiplexAlphaDecode", TaskQueueFactory::Priority::HIGH));
+  }
   return true;
 }
 
@@ -129,23 +141,47 @@ int32_t MultiplexDecoderAdapter::Decode(const EncodedImage& input_image,
                                         int64_t render_time_ms) {
   MultiplexImage image = MultiplexEncodedImagePacker::Unpack(input_image);
 
-  if (supports_augmenting_data_) {
-    RTC_DCHECK(decoded_augmenting_data_.find(input_image.Timestamp()) ==
-               decoded_augmenting_data_.end());
-    decoded_augmenting_data_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(input_image.Timestamp()),
-        std::forward_as_tuple(std::move(image.augmenting_data),
-                              image.augmenting_data_size));
+  {
+    MutexLock lock(&lock_);
+    if (supports_augmenting_data_) {
+      RTC_DCHECK(decoded_augmenting_data_.find(input_image.Timestamp()) ==
+                 decoded_augmenting_data_.end());
+      decoded_augmenting_data_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(input_image.Timestamp()),
+          std::forward_as_tuple(std::move(image.augmenting_data),
+                                image.augmenting_data_size));
+    }
+
+    if (image.component_count == 1) {
+      RTC_DCHECK(decoded_data_.find(input_image.Timestamp()) ==
+                 decoded_data_.end());
+      decoded_data_.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(input_image.Timestamp()),
+                            std::forward_as_tuple(kAXXStream));
+    }
   }
 
-  if (image.component_count == 1) {
-    RTC_DCHECK(decoded_data_.find(input_image.Timestamp()) ==
-               decoded_data_.end());
-    decoded_data_.emplace(std::piecewise_construct,
-                          std::forward_as_tuple(input_image.Timestamp()),
-                          std::forward_as_tuple(kAXXStream));
+  if (alpha_decode_queue_ && image.image_components.size() == 2) {
+    // The components are independent, decode the second one on
+    // `alpha_decode_queue_` meanwhile.
+    const MultiplexImageComponent& queued_component =
+        image.image_components[1];
+    int32_t queued_rv = WEBRTC_VIDEO_CODEC_OK;
+    rtc::Event queued_done;
+    alpha_decode_queue_->PostTask([&] {
+      queued_rv = decoders_[queued_component.component_index]->Decode(
+          queued_component.encoded_image, missing_frames, render_time_ms);
+      queued_done.Set();
+    });
+    const int32_t rv =
+        decoders_[image.image_components[0].component_index]->Decode(
+            image.image_components[0].encoded_image, missing_frames,
+            render_time_ms);
+    queued_done.Wait(rtc::Event::kForever);
+    return rv != WEBRTC_VIDEO_CODEC_OK ? rv : queued_rv;
   }
+
   int32_t rv = 0;
   for (size_t i = 0; i < image.image_components.size(); i++) {
     rv = decoders_[image.image_components[i].component_index]->Decode(
@@ -178,46 +214,52 @@ void MultiplexDecoderAdapter::Decoded(AlphaCodecStream stream_idx,
                                       VideoFrame* decoded_image,
                                       absl::optional<int32_t> decode_time_ms,
                                       absl::optional<uint8_t> qp) {
-  const auto& other_decoded_data_it =
-      decoded_data_.find(decoded_image->timestamp());
-  const auto& augmenting_data_it =
-      decoded_augmenting_data_.find(decoded_image->timestamp());
-  const bool has_augmenting_data =
-      augmenting_data_it != decoded_augmenting_data_.end();
-  if (other_decoded_data_it != decoded_data_.end()) {
-    uint16_t augmenting_data_size =
-        has_augmenting_data ? augmenting_data_it->second.size_ : 0;
-    std::unique_ptr<uint8_t[]> augmenting_data =
-        has_augmenting_data ? std::move(augmenting_data_it->second.data_)
-                            : nullptr;
-    auto& other_image_data = other_decoded_data_it->second;
-    if (stream_idx == kYUVStream) {
-      RTC_DCHECK_EQ(kAXXStream, other_image_data.stream_idx_);
-      MergeAlphaImages(decoded_image, decode_time_ms, qp,
-                       &other_image_data.decoded_image_,
-                       other_image_data.decode_time_ms_, other_image_data.qp_,
-                       std::move(augmenting_data), augmenting_data_size);
-    } else {
-      RTC_DCHECK_EQ(kYUVStream, other_image_data.stream_idx_);
-      RTC_DCHECK_EQ(kAXXStream, stream_idx);
-      MergeAlphaImages(&other_image_data.decoded_image_,
-                       other_image_data.decode_time_ms_, other_image_data.qp_,
-                       decoded_image, decode_time_ms, qp,
-                       std::move(augmenting_data), augmenting_data_size);
+  absl::optional<VideoFrame> other_image;
+  absl::optional<int32_t> other_decode_time_ms;
+  absl::optional<uint8_t> other_qp;
+  std::unique_ptr<uint8_t[]> augmenting_data;
+  uint16_t augmenting_data_size = 0;
+  {
+    MutexLock lock(&lock_);
+    const auto& other_decoded_data_it =
+        decoded_data_.find(decoded_image->timestamp());
+    if (other_decoded_data_it == decoded_data_.end()) {
+      decoded_data_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(decoded_image->timestamp()),
+          std::forward_as_tuple(stream_idx, *decoded_image, decode_time_ms,
+                                qp));
+      return;
     }
-    decoded_data_.erase(decoded_data_.begin(), other_decoded_data_it);
-    if (has_augmenting_data) {
+    auto& other_image_data = other_decoded_data_it->second;
+    RTC_DCHECK_NE(stream_idx, other_image_data.stream_idx_);
+    other_image = other_image_data.decoded_image_;
+    other_decode_time_ms = other_image_data.decode_time_ms_;
+    other_qp = other_image_data.qp_;
+    const auto& augmenting_data_it =
+        decoded_augmenting_data_.find(decoded_image->timestamp());
+    if (augmenting_data_it != decoded_augmenting_data_.end()) {
+      augmenting_data_size = augmenting_data_it->second.size_;
+      augmenting_data = std::move(augmenting_data_it->second.data_);
       decoded_augmenting_data_.erase(decoded_augmenting_data_.begin(),
-                                     augmenting_data_it);
+                                     std::next(augmenting_data_it));
     }
-    return;
+    decoded_data_.erase(decoded_data_.begin(),
+                        std::next(other_decoded_data_it));
+  }
+
+  // Merge and deliver outside of the lock, so that the other component of
+  // the next frame can be stored meanwhile.
+  if (stream_idx == kYUVStream) {
+    MergeAlphaImages(decoded_image, decode_time_ms, qp, &*other_image,
+                     other_decode_time_ms, other_qp, std::move(augmenting_data),
+                     augmenting_data_size);
+  } else {
+    RTC_DCHECK_EQ(kAXXStream, stream_idx);
+    MergeAlphaImages(&*other_image, other_decode_time_ms, other_qp,
+                     decoded_image, decode_time_ms, qp,
+                     std::move(augmenting_data), augmenting_data_size);
   }
-  RTC_DCHECK(decoded_data_.find(decoded_image->timestamp()) ==
-             decoded_data_.end());
-  decoded_data_.emplace(
-      std::piecewise_construct,
-      std::forward_as_tuple(decoded_image->timestamp()),
-      std::forward_as_tuple(stream_idx, *decoded_image, decode_time_ms, qp));
 }
 
 void MultiplexDecoderAdapter::MergeAlphaImages(
@@ -235,15 +277,29 @@ void MultiplexDecoderAdapter::MergeAlphaImages(
   } else {
     rtc::scoped_refptr<webrtc::I420BufferInterface> yuv_buffer =
         decoded_image->video_frame_buffer()->ToI420();
-    rtc::scoped_refptr<webrtc::I420BufferInterface> alpha_buffer =
-        alpha_decoded_image->video_frame_buffer()->ToI420();
+    // Only the luma plane of the alpha image is used. NV12 buffers, as output
+    // by many hardware decoders, have the same one, so that they are used
+    // without a conversion.
+    rtc::scoped_refptr<VideoFrameBuffer> alpha_buffer =
+        alpha_decoded_image->video_frame_buffer();
+    const uint8_t* alpha_data;
+    int alpha_stride;
+    if (alpha_buffer->type() == VideoFrameBuffer::Type::kNV12) {
+      alpha_data = alpha_buffer->GetNV12()->DataY();
+      alpha_stride = alpha_buffer->GetNV12()->StrideY();
+    } else {
+      rtc::scoped_refptr<I420BufferInterface> alpha_i420 =
+          alpha_buffer->ToI420();
+      alpha_data = alpha_i420->DataY();
+      alpha_stride = alpha_i420->StrideY();
+      alpha_buffer = alpha_i420;
+    }
     RTC_DCHECK_EQ(yuv_buffer->width(), alpha_buffer->width());
     RTC_DCHECK_EQ(yuv_buffer->height(), alpha_buffer->height());
     merged_buffer = WrapI420ABuffer(
         yuv_buffer->width(), yuv_buffer->height(), yuv_buffer->DataY(),
         yuv_buffer->StrideY(), yuv_buffer->DataU(), yuv_buffer->StrideU(),
-        yuv_buffer->DataV(), yuv_buffer->StrideV(), alpha_buffer->DataY(),
-        alpha_buffer->StrideY(),
+        yuv_buffer->DataV(), yuv_buffer->StrideV(), alpha_data, alpha_stride,
         // To keep references alive.
         [yuv_buffer, alpha_buffer] {});
   }
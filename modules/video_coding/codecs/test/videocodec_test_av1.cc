@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/test/create_videocodec_test_fixture.h"
@@ -104,6 +105,35 @@ TEST_P(VideoCodecTestAv1, Hd) {
 
   fixture->RunTest(rate_profiles, &rc_thresholds, &quality_thresholds, nullptr);
 }
+
+// Measures the encode speed and quality of the HD clip on multiple cores for
+// each real-time cpu-used preset, to compare the presets on a given device.
+class VideoCodecTestAv1SpeedPreset : public ::testing::TestWithParam<int> {
+ public:
+  VideoCodecTestAv1SpeedPreset()
+      : scoped_field_trial_("WebRTC-LibaomAv1Encoder-SpeedSettings/cpu_speed:" +
+                            std::to_string(GetParam()) + "/") {}
+
+ private:
+  ScopedFieldTrials scoped_field_trial_;
+};
+
+TEST_P(VideoCodecTestAv1SpeedPreset, Hd) {
+  auto config = CreateConfig("ConferenceMotion_1280_720_50");
+  config.SetCodecSettings(cricket::kAv1CodecName, 1, 1, 1, false, true, true,
+                          kHdWidth, kHdHeight);
+  config.codec_settings.SetScalabilityMode("NONE");
+  config.use_single_core = false;
+  auto fixture = CreateVideoCodecTestFixture(config);
+
+  std::vector<RateProfile> rate_profiles = {{1000, 50, 0}};
+
+  fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(CpuSpeed,
+                         VideoCodecTestAv1SpeedPreset,
+                         ::testing::Values(7, 8, 9, 10));
 #endif
 
 std::vector<std::string> GetTestValues() {
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "api/test/videocodec_test_fixture.h"
+#include "media/base/media_constants.h"
+#include "modules/video_coding/codecs/test/videocodec_throughput.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kCifWidth = 352;
+constexpr int kCifHeight = 288;
+
+VideoCodecTestFixture::Config CreateVp8Config(size_t num_frames) {
+  VideoCodecTestFixture::Config config;
+  config.filename = "foreman_cif";
+  config.filepath = ResourcePath(config.filename, "yuv");
+  config.num_frames = num_frames;
+  // One core per instance, as a server hosting many streams would configure.
+  config.use_single_core = true;
+  config.SetCodecSettings(cricket::kVp8CodecName, 1, 1, 1, false, true, false,
+                          kCifWidth, kCifHeight);
+  return config;
+}
+
+TEST(VideoCodecThroughputTest, AggregatesStatisticsOfAllInstances) {
+  std::vector<VideoCodecTestFixture::Config> configs(
+      2, CreateVp8Config(/*num_frames=*/30));
+
+  VideoCodecThroughputStats stats =
+      RunVideoCodecThroughputTest(configs, {{500, 30, 0}});
+
+  EXPECT_EQ(stats.num_instances, 2u);
+  EXPECT_EQ(stats.num_encoded_frames, 60u);
+  EXPECT_EQ(stats.num_decoded_frames, 60u);
+  EXPECT_GT(stats.duration_sec, 0.0);
+  EXPECT_GT(stats.encoded_fps, 0.0);
+  EXPECT_LE(stats.encode_time_p50_ms, stats.encode_time_p99_ms);
+  EXPECT_LE(stats.encode_time_p99_ms, stats.encode_time_max_ms);
+  EXPECT_LE(stats.decode_time_p50_ms, stats.decode_time_p99_ms);
+  EXPECT_LE(stats.decode_time_p99_ms, stats.decode_time_max_ms);
+}
+
+// Measures how the aggregate frame rate and the tail latency scale with the
+// number of concurrent streams, for capacity planning. Run manually.
+class VideoCodecThroughputPerfTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(VideoCodecThroughputPerfTest, DISABLED_Vp8Cif) {
+  std::vector<VideoCodecTestFixture::Config> configs(
+      GetParam(), CreateVp8Config(/*num_frames=*/300));
+
+  VideoCodecThroughputStats stats =
+      RunVideoCodecThroughputTest(configs, {{500, 30, 0}});
+
+  RTC_LOG(LS_INFO) << "Throughput of " << GetParam() << " VP8 CIF streams:\n"
+                   << stats.ToString();
+  EXPECT_EQ(stats.num_encoded_frames, 300u * GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(NumInstances,
+                         VideoCodecThroughputPerfTest,
+                         ::testing::Values(1, 4, 16, 64));
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_throughput.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "api/test/videocodec_test_stats.h"
+#include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using FrameStatistics = VideoCodecTestStats::FrameStatistics;
+
+// Returns the `percentile` of the sorted `values_us`, in milliseconds.
+double PercentileMs(const std::vector<size_t>& values_us, double percentile) {
+  if (values_us.empty())
+    return 0.0;
+  size_t index = static_cast<size_t>(
+      std::ceil(percentile * values_us.size() / 100.0));
+  index = std::min(std::max<size_t>(index, 1), values_us.size()) - 1;
+  return values_us[index] / 1000.0;
+}
+
+}  // namespace
+
+std::string VideoCodecThroughputStats::ToString() const {
+  rtc::StringBuilder ss;
+  ss << "num_instances: " << num_instances;
+  ss << "\nnum_cores: " << num_cores;
+  ss << "\nnum_encoded_frames: " << num_encoded_frames;
+  ss << "\nnum_decoded_frames: " << num_decoded_frames;
+  ss << "\nduration_sec: " << duration_sec;
+  ss << "\nencoded_fps: " << encoded_fps;
+  ss << "\ndecoded_fps: " << decoded_fps;
+  ss << "\nencoded_fps_per_core: " << encoded_fps_per_core;
+  ss << "\nencode_time_ms p50/p95/p99/max: " << encode_time_p50_ms << "/"
+     << encode_time_p95_ms << "/" << encode_time_p99_ms << "/"
+     << encode_time_max_ms;
+  ss << "\ndecode_time_ms p50/p95/p99/max: " << decode_time_p50_ms << "/"
+     << decode_time_p95_ms << "/" << decode_time_p99_ms << "/"
+     << decode_time_max_ms;
+  return ss.Release();
+}
+
+VideoCodecThroughputStats RunVideoCodecThroughputTest(
+    const std::vector<VideoCodecTestFixture::Config>& configs,
+    const std::vector<RateProfile>& rate_profiles) {
+  RTC_DCHECK(!configs.empty());
+  std::vector<std::unique_ptr<VideoCodecTestFixture>> fixtures;
+  for (const VideoCodecTestFixture::Config& config : configs)
+    fixtures.push_back(std::make_unique<VideoCodecTestFixtureImpl>(config));
+
+  {
+    std::vector<rtc::PlatformThread> threads;
+    for (size_t i = 0; i < fixtures.size(); ++i) {
+      VideoCodecTestFixture* fixture = fixtures[i].get();
+      threads.push_back(rtc::PlatformThread::SpawnJoinable(
+          [fixture, &rate_profiles] {
+            fixture->RunTest(rate_profiles, /*rc_thresholds=*/nullptr,
+                             /*quality_thresholds=*/nullptr,
+                             /*bs_thresholds=*/nullptr);
+          },
+          "CodecInstance" + std::to_string(i)));
+    }
+    // Destroying the threads waits for all instances to finish.
+  }
+
+  VideoCodecThroughputStats stats;
+  stats.num_instances = fixtures.size();
+  stats.num_cores = CpuInfo::DetectNumberOfCores();
+  std::vector<size_t> encode_times_us;
+  std::vector<size_t> decode_times_us;
+  int64_t first_start_ns = std::numeric_limits<int64_t>::max();
+  int64_t last_stop_ns = std::numeric_limits<int64_t>::min();
+  for (const std::unique_ptr<VideoCodecTestFixture>& fixture : fixtures) {
+    for (const FrameStatistics& frame :
+         fixture->GetStats().GetFrameStatistics()) {
+      if (frame.encoding_successful) {
+        encode_times_us.push_back(frame.encode_time_us);
+        int64_t encode_stop_ns =
+            frame.encode_start_ns +
+            frame.encode_time_us * rtc::kNumNanosecsPerMicrosec;
+        first_start_ns = std::min(first_start_ns, frame.encode_start_ns);
+        last_stop_ns = std::max(last_stop_ns, encode_stop_ns);
+      }
+      if (frame.decoding_successful) {
+        decode_times_us.push_back(frame.decode_time_us);
+        int64_t decode_stop_ns =
+            frame.decode_start_ns +
+            frame.decode_time_us * rtc::kNumNanosecsPerMicrosec;
+        last_stop_ns = std::max(last_stop_ns, decode_stop_ns);
+      }
+    }
+  }
+
+  stats.num_encoded_frames = encode_times_us.size();
+  stats.num_decoded_frames = decode_times_us.size();
+  if (last_stop_ns > first_start_ns) {
+    stats.duration_sec = static_cast<double>(last_stop_ns - first_start_ns) /
+                         rtc::kNumNanosecsPerSec;
+    stats.encoded_fps = stats.num_encoded_frames / stats.duration_sec;
+    stats.decoded_fps = stats.num_decoded_frames / stats.duration_sec;
+    stats.encoded_fps_per_core = stats.encoded_fps / stats.num_cores;
+  }
+
+  std::sort(encode_times_us.begin(), encode_times_us.end());
+  std::sort(decode_times_us.begin(), decode_times_us.end());
+  stats.encode_time_p50_ms = PercentileMs(encode_times_us, 50);
+  stats.encode_time_p95_ms = PercentileMs(encode_times_us, 95);
+  stats.encode_time_p99_ms = PercentileMs(encode_times_us, 99);
+  stats.encode_time_max_ms = PercentileMs(encode_times_us, 100);
+  stats.decode_time_p50_ms = PercentileMs(decode_times_us, 50);
+  stats.decode_time_p95_ms = PercentileMs(decode_times_us, 95);
+  stats.decode_time_p99_ms = PercentileMs(decode_times_us, 99);
+  stats.decode_time_max_ms = PercentileMs(decode_times_us, 100);
+  return stats;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_THROUGHPUT_H_
+#define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_THROUGHPUT_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "api/test/videocodec_test_fixture.h"
+
+namespace webrtc {
+namespace test {
+
+// Aggregate statistics of codec instances that ran concurrently.
+struct VideoCodecThroughputStats {
+  std::string ToString() const;
+
+  size_t num_instances = 0;
+  size_t num_cores = 0;
+  size_t num_encoded_frames = 0;
+  size_t num_decoded_frames = 0;
+  // From the first encode until the last decode finished, of any instance.
+  double duration_sec = 0.0;
+
+  double encoded_fps = 0.0;
+  double decoded_fps = 0.0;
+  double encoded_fps_per_core = 0.0;
+
+  // Distribution of the per frame encode and decode times.
+  double encode_time_p50_ms = 0.0;
+  double encode_time_p95_ms = 0.0;
+  double encode_time_p99_ms = 0.0;
+  double encode_time_max_ms = 0.0;
+  double decode_time_p50_ms = 0.0;
+  double decode_time_p95_ms = 0.0;
+  double decode_time_p99_ms = 0.0;
+  double decode_time_max_ms = 0.0;
+};
+
+// Runs the encode and decode chain of VideoCodecTestFixture for each of
+// `configs` at the same time, each on its own task queue as with one
+// VideoStreamEncoder per stream, to measure how many streams a machine can
+// process and the latency the load causes. Frames are fed as fast as the
+// instances process them unless the configs ask for real-time encoding.
+VideoCodecThroughputStats RunVideoCodecThroughputTest(
+    const std::vector<VideoCodecTestFixture::Config>& configs,
+    const std::vector<RateProfile>& rate_profiles);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_THROUGHPUT_H_
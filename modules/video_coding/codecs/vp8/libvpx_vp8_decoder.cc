@@ -318,7 +318,10 @@ int LibvpxVp8Decoder::ReturnFrame(
   }
   last_frame_width_ = img->d_w;
   last_frame_height_ = img->d_h;
-  // Allocate memory for decoded image.
+  // Allocate memory for decoded image. Unlike the VP9 decoder (see
+  // Vp9FrameBufferPool), the libvpx VP8 decoder doesn't support external
+  // frame buffers and reuses the memory of `img` for the next frame, so the
+  // decoded image can't wrap it and has to be copied.
   rtc::scoped_refptr<VideoFrameBuffer> buffer;
 
   if (preferred_output_format_ == VideoFrameBuffer::Type::kNV12) {
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/cleanup/cleanup.h"
 #include "api/scoped_refptr.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame_buffer.h"
@@ -36,6 +37,8 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -54,6 +57,9 @@ constexpr absl::string_view kSupportedScalabilityModes[] = {"L1T2", "L1T3"};
 constexpr char kVp8ForcePartitionResilience[] =
     "WebRTC-VP8-ForcePartitionResilience";
 
+constexpr char kLibvpxScreenshareActiveMap[] =
+    "WebRTC-LibvpxScreenshareActiveMap";
+
 // QP is obtained from VP8-bitstream for HW, so the QP corresponds to the
 // bitstream range of [0, 127] and not the user-level range of [0,63].
 constexpr int kLowVp8QpThreshold = 29;
@@ -280,7 +286,8 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(std::unique_ptr<LibvpxInterface> interface,
       key_frame_request_(kMaxSimulcastStreams, false),
       variable_framerate_experiment_(ParseVariableFramerateConfig(
           "WebRTC-VP8VariableFramerateScreenshare")),
-      framerate_controller_(variable_framerate_experiment_.framerate_limit) {
+      framerate_controller_(variable_framerate_experiment_.framerate_limit),
+      use_active_map_(field_trial::IsEnabled(kLibvpxScreenshareActiveMap)) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
   raw_images_.reserve(kMaxSimulcastStreams);
@@ -301,6 +308,7 @@ int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
   encoded_images_.clear();
+  encoded_image_buffer_pool_.Release();
 
   if (inited_) {
     for (auto it = encoders_.rbegin(); it != encoders_.rend(); ++it) {
@@ -315,6 +323,8 @@ int LibvpxVp8Encoder::Release() {
   config_overrides_.clear();
   send_stream_.clear();
   cpu_speed_.clear();
+  base_cpu_speed_.clear();
+  speed_controller_.reset();
 
   for (auto it = raw_images_.rbegin(); it != raw_images_.rend(); ++it) {
     libvpx_->img_free(&*it);
@@ -322,6 +332,9 @@ int LibvpxVp8Encoder::Release() {
   raw_images_.clear();
 
   frame_buffer_controller_.reset();
+  thread_quota_.reset();
+  updated_blocks_.reset();
+  active_map_set_ = false;
   inited_ = false;
   return ret_val;
 }
@@ -506,6 +519,11 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     codec_.simulcastStream[0].height = codec_.height;
   }
 
+  if (use_active_map_ && codec_.mode == VideoCodecMode::kScreensharing &&
+      number_of_streams == 1) {
+    updated_blocks_.emplace(codec_.width, codec_.height);
+  }
+
   encoded_images_.resize(number_of_streams);
   encoders_.resize(number_of_streams);
   vpx_configs_.resize(number_of_streams);
@@ -613,13 +631,28 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
         GetCpuSpeed(inst->simulcastStream[number_of_streams - 1 - i].width,
                     inst->simulcastStream[number_of_streams - 1 - i].height);
   }
+  base_cpu_speed_ = cpu_speed_;
+  absl::optional<EncoderSpeedController::Config> speed_controller_config =
+      EncoderSpeedController::Config::Parse(
+          field_trial::FindFullName(EncoderSpeedController::kFieldTrialName),
+          kLowVp8QpThreshold);
+  if (speed_controller_config) {
+    speed_controller_ =
+        std::make_unique<EncoderSpeedController>(*speed_controller_config);
+  }
   vpx_configs_[0].g_w = inst->width;
   vpx_configs_[0].g_h = inst->height;
 
   // Determine number of threads based on the image size and #cores.
   // TODO(fbarchard): Consider number of Simulcast layers.
-  vpx_configs_[0].g_threads = NumberOfThreads(
-      vpx_configs_[0].g_w, vpx_configs_[0].g_h, settings.number_of_cores);
+  thread_quota_ = EncoderResourceBroker::Default().RequestThreads(
+      {NumberOfThreads(vpx_configs_[0].g_w, vpx_configs_[0].g_h,
+                       settings.number_of_cores),
+       inst->width * inst->height,
+       inst->mode == VideoCodecMode::kScreensharing
+           ? EncoderResourceBroker::Priority::kLow
+           : EncoderResourceBroker::Priority::kNormal});
+  vpx_configs_[0].g_threads = thread_quota_->threads();
 
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
@@ -730,6 +763,16 @@ int LibvpxVp8Encoder::GetCpuSpeed(int width, int height) {
 #endif
 }
 
+void LibvpxVp8Encoder::UpdateCpuSpeed() {
+  RTC_DCHECK(speed_controller_);
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    // More negative values are faster.
+    cpu_speed_[i] = rtc::SafeClamp(
+        base_cpu_speed_[i] - speed_controller_->speed_offset(), -16, -1);
+    libvpx_->codec_control(&(encoders_[i]), VP8E_SET_CPUUSED, cpu_speed_[i]);
+  }
+}
+
 int LibvpxVp8Encoder::NumberOfThreads(int width, int height, int cpus) {
 #if defined(WEBRTC_ANDROID)
   if (width * height >= 320 * 180) {
@@ -939,6 +982,10 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   if (encoded_complete_callback_ == NULL)
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
 
+  // Frames dropped below are still part of the change since the last buffer.
+  if (updated_blocks_)
+    updated_blocks_->AddUpdate(frame.update_rect());
+
   bool key_frame_requested = false;
   for (size_t i = 0; i < key_frame_request_.size() && i < send_stream_.size();
        ++i) {
@@ -1028,6 +1075,26 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
   }
 
+  if (updated_blocks_) {
+    // Inactive blocks are copied from the last buffer, so the map can only be
+    // used if the frame references it. Without a partial update, either all
+    // blocks changed or the frame is a repeat that should refine all of them.
+    const bool use_active_map = !send_key_frame &&
+                                (flags[0] & VP8_EFLAG_NO_REF_LAST) == 0 &&
+                                updated_blocks_->IsPartial();
+    if (use_active_map || active_map_set_) {
+      vpx_active_map_t active_map;
+      active_map.active_map =
+          use_active_map ? updated_blocks_->data() : nullptr;
+      active_map.rows = updated_blocks_->rows();
+      active_map.cols = updated_blocks_->cols();
+      if (libvpx_->codec_control(&encoders_[0], VP8E_SET_ACTIVEMAP,
+                                 &active_map) == VPX_CODEC_OK) {
+        active_map_set_ = use_active_map;
+      }
+    }
+  }
+
   // Set the encoder frame flags and temporal layer_id for each spatial stream.
   // Note that streams are defined starting from lowest resolution at
   // position 0 to highest resolution at position |encoders_.size() - 1|,
@@ -1053,6 +1120,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   RTC_DCHECK_GT(codec_.maxFramerate, 0);
   uint32_t duration = kRtpTicksPerSecond / codec_.maxFramerate;
 
+  TimeDelta encode_time = TimeDelta::Zero();
   int error = WEBRTC_VIDEO_CODEC_OK;
   int num_tries = 0;
   // If the first try returns WEBRTC_VIDEO_CODEC_TARGET_BITRATE_OVERSHOOT
@@ -1065,8 +1133,10 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Note we must pass 0 for `flags` field in encode call below since they are
     // set above in `libvpx_interface_->vpx_codec_control_` function for each
     // encoder/spatial layer.
+    const int64_t encode_start_us = rtc::TimeMicros();
     error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
                                   duration, 0, VPX_DL_REALTIME);
+    encode_time += TimeDelta::Micros(rtc::TimeMicros() - encode_start_us);
     // Reset specific intra frame thresholds, following the key frame.
     if (send_key_frame) {
       libvpx_->codec_control(&(encoders_[0]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
@@ -1077,6 +1147,18 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Examines frame timestamps only.
     error = GetEncodedPartitions(frame, retransmission_allowed);
   }
+  if (updated_blocks_ && error == WEBRTC_VIDEO_CODEC_OK &&
+      encoded_images_[0].size() > 0 &&
+      (send_key_frame || (flags[0] & VP8_EFLAG_NO_UPD_LAST) == 0)) {
+    // The last buffer now holds this frame.
+    updated_blocks_->Reset();
+  }
+  if (speed_controller_ && error == WEBRTC_VIDEO_CODEC_OK &&
+      speed_controller_->OnFrameEncoded(
+          encode_time, TimeDelta::Seconds(1) / codec_.maxFramerate,
+          encoded_images_[0].qp_)) {
+    UpdateCpuSpeed();
+  }
   // TODO(sprang): Shouldn't we use the frame timestamp instead?
   timestamp_ += duration;
   return error;
@@ -1137,9 +1219,8 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
       }
     }
 
-    // TODO(nisse): Introduce some buffer cache or buffer pool, to reduce
-    // allocations and/or copy operations.
-    auto buffer = EncodedImageBuffer::Create(encoded_size);
+    rtc::scoped_refptr<EncodedImageBufferInterface> buffer =
+        encoded_image_buffer_pool_.CreateBuffer(encoded_size);
 
     iter = NULL;
     size_t encoded_pos = 0;
@@ -1189,6 +1270,8 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
         encoded_images_[encoder_idx].qp_ = qp_128;
         encoded_images_[encoder_idx].SetAtTargetQuality(
             qp_128 <= variable_framerate_experiment_.steady_state_qp);
+        if (speed_controller_)
+          encoded_images_[encoder_idx].SetEncoderSpeed(cpu_speed_[encoder_idx]);
         encoded_complete_callback_->OnEncodedImage(encoded_images_[encoder_idx],
                                                    &codec_specific);
         const size_t steady_state_size = SteadyStateSize(
@@ -1369,17 +1452,30 @@ LibvpxVp8Encoder::PrepareBuffers(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
   std::vector<rtc::scoped_refptr<VideoFrameBuffer>> prepared_buffers;
   SetRawImagePlanes(&raw_images_[0], mapped_buffer);
   prepared_buffers.push_back(mapped_buffer);
+  if (encoders_.size() == 1) {
+    return prepared_buffers;
+  }
+
+  // Native buffers should implement optimized scaling and is the preferred
+  // buffer to scale. But if the buffer isn't native, it is cheaper to scale
+  // each stream from the next larger one, in pooled buffers.
+  std::vector<SimulcastFrameScaler::Resolution> resolutions;
+  resolutions.reserve(encoders_.size());
+  for (const vpx_image_t& raw_image : raw_images_) {
+    resolutions.push_back({static_cast<int>(raw_image.d_w),
+                           static_cast<int>(raw_image.d_h)});
+  }
+  frame_scaler_.SetInput(buffer, resolutions);
+  absl::Cleanup release_scaled_buffers = [this] { frame_scaler_.Clear(); };
   for (size_t i = 1; i < encoders_.size(); ++i) {
-    // Native buffers should implement optimized scaling and is the preferred
-    // buffer to scale. But if the buffer isn't native, it should be cheaper to
-    // scale from the previously prepared buffer which is smaller than `buffer`.
-    VideoFrameBuffer* buffer_to_scale =
-        buffer->type() == VideoFrameBuffer::Type::kNative
-            ? buffer.get()
-            : prepared_buffers.back().get();
-
-    auto scaled_buffer =
-        buffer_to_scale->Scale(raw_images_[i].d_w, raw_images_[i].d_h);
+    rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer =
+        frame_scaler_.Scale(i);
+    if (!scaled_buffer) {
+      RTC_LOG(LS_ERROR) << "Failed to scale "
+                        << VideoFrameBufferTypeToString(buffer->type())
+                        << " image. Can't encode frame.";
+      return {};
+    }
     if (scaled_buffer->type() == VideoFrameBuffer::Type::kNative) {
       auto mapped_scaled_buffer =
           scaled_buffer->GetMappedFrameBuffer(mapped_type);
@@ -1397,7 +1493,7 @@ LibvpxVp8Encoder::PrepareBuffers(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
     if (!IsCompatibleVideoFrameBufferType(scaled_buffer->type(),
                                           mapped_buffer->type())) {
       RTC_LOG(LS_ERROR) << "When scaling "
-                        << VideoFrameBufferTypeToString(buffer_to_scale->type())
+                        << VideoFrameBufferTypeToString(buffer->type())
                         << ", the image was unexpectedly converted to "
                         << VideoFrameBufferTypeToString(scaled_buffer->type())
                         << " instead of "
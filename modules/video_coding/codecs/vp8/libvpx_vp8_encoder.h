@@ -15,16 +15,22 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_frame.h"
+#include "api/video_codecs/encoder_resource_broker.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_frame_buffer_controller.h"
 #include "api/video_codecs/vp8_frame_config.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "common_video/simulcast_frame_scaler.h"
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/encoder_speed_controller.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
+#include "modules/video_coding/utility/updated_block_map.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/experiments/rate_control_settings.h"
@@ -67,6 +73,8 @@ class LibvpxVp8Encoder : public VideoEncoder {
  private:
   // Get the cpu_speed setting for encoder based on resolution and/or platform.
   int GetCpuSpeed(int width, int height);
+  // Applies the offset of `speed_controller_` to `base_cpu_speed_`.
+  void UpdateCpuSpeed();
 
   // Determine number of encoder threads to use.
   int NumberOfThreads(int width, int height, int number_of_cores);
@@ -125,8 +133,18 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<bool> key_frame_request_;
   std::vector<bool> send_stream_;
   std::vector<int> cpu_speed_;
+  // `cpu_speed_` as chosen on InitEncode(), before any runtime adjustment.
+  std::vector<int> base_cpu_speed_;
+  // Set if the speed is adjusted to the encode time.
+  std::unique_ptr<EncoderSpeedController> speed_controller_;
   std::vector<vpx_image_t> raw_images_;
+  // Scales the input to the resolutions of `raw_images_`.
+  SimulcastFrameScaler frame_scaler_;
+  // Threads of the first encoder, the others are single threaded.
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> thread_quota_;
   std::vector<EncodedImage> encoded_images_;
+  // Holds the bitstream of `encoded_images_`, for all streams.
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> vpx_configs_;
   std::vector<Vp8EncoderConfig> config_overrides_;
@@ -148,6 +166,14 @@ class LibvpxVp8Encoder : public VideoEncoder {
   FramerateControllerDeprecated framerate_controller_;
   int num_steady_state_frames_ = 0;
 
+  // Screenshare with a single stream marks the blocks that did not change
+  // since the content of the last buffer as inactive, so that libvpx codes
+  // them as skipped without searching for motion.
+  const bool use_active_map_;
+  // Set if the active map is used with the current configuration.
+  absl::optional<UpdatedBlockMap> updated_blocks_;
+  bool active_map_set_ = false;
+
   FecControllerOverride* fec_controller_override_ = nullptr;
 
   const LibvpxVp8EncoderInfoSettings encoder_info_override_;
@@ -33,11 +33,13 @@
 namespace webrtc {
 
 using ::testing::_;
+using ::testing::A;
 using ::testing::AllOf;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Field;
 using ::testing::Invoke;
+using ::testing::Mock;
 using ::testing::NiceMock;
 using ::testing::Return;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
@@ -507,6 +509,61 @@ TEST_F(TestVp8Impl, KeepsTimestampOnReencode) {
   encoder.Encode(NextInputFrame(), &delta_frame);
 }
 
+TEST_F(TestVp8Impl, SetsActiveMapForPartialScreenshareUpdates) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-LibvpxScreenshareActiveMap/Enabled/");
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
+                           VP8Encoder::Settings());
+  codec_settings_.mode = VideoCodecMode::kScreensharing;
+  codec_settings_.VP8()->numberOfTemporalLayers = 1;
+
+  EXPECT_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillOnce(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt, unsigned int d_w,
+                          unsigned int d_h, unsigned int stride_align,
+                          unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // No active map for key frames. The mock produces no output, so the update
+  // of the key frame stays part of the change since the last buffer.
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map*>()))
+      .Times(0);
+  VideoFrame frame = NextInputFrame();
+  frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 16, 16});
+  auto key_frame = std::vector<VideoFrameType>{VideoFrameType::kVideoFrameKey};
+  encoder.Encode(frame, &key_frame);
+  Mock::VerifyAndClearExpectations(vpx);
+
+  const int cols = (kWidth + 15) / 16;
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map*>()))
+      .WillOnce(Invoke([&](vpx_codec_ctx_t*, vp8e_enc_control_id,
+                           vpx_active_map* active_map) {
+        EXPECT_EQ(active_map->rows, (kHeight + 15) / 16u);
+        EXPECT_EQ(active_map->cols, static_cast<unsigned int>(cols));
+        EXPECT_NE(active_map->active_map, nullptr);
+        if (active_map->active_map) {
+          EXPECT_EQ(active_map->active_map[0], 1);
+          EXPECT_EQ(active_map->active_map[1], 0);
+          EXPECT_EQ(active_map->active_map[cols + 2], 1);
+        }
+        return VPX_CODEC_OK;
+      }));
+  frame = NextInputFrame();
+  frame.set_update_rect(VideoFrame::UpdateRect{32, 16, 16, 16});
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  encoder.Encode(frame, &delta_frame);
+}
+
 TEST(LibvpxVp8EncoderTest, GetEncoderInfoReturnsStaticInformation) {
   auto* const vpx = new NiceMock<MockLibvpxInterface>();
   LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
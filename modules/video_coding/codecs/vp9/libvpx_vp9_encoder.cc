@@ -14,6 +14,7 @@
 #include "modules/video_coding/codecs/vp9/libvpx_vp9_encoder.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -36,6 +37,7 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -236,8 +238,16 @@ LibvpxVp9Encoder::LibvpxVp9Encoder(const cricket::VideoCodec& codec,
           !absl::StartsWith(trials.Lookup("WebRTC-Vp9ExternalRefCtrl"),
                             "Disabled")),
       performance_flags_(ParsePerformanceFlagsFromTrials(trials)),
+      threading_settings_(ParseThreadingSettingsFromTrials(trials)),
+      tile_columns_log2_(0),
+      speed_controller_config_(EncoderSpeedController::Config::Parse(
+          trials.Lookup(EncoderSpeedController::kFieldTrialName),
+          kLowVp9QpThreshold)),
       num_steady_state_frames_(0),
-      config_changed_(true) {
+      config_changed_(true),
+      use_active_map_(absl::StartsWith(
+          trials.Lookup("WebRTC-LibvpxScreenshareActiveMap"),
+          "Enabled")) {
   codec_ = {};
   memset(&svc_params_, 0, sizeof(vpx_svc_extra_cfg_t));
 }
@@ -270,6 +280,11 @@ int LibvpxVp9Encoder::Release() {
     libvpx_->img_free(raw_);
     raw_ = nullptr;
   }
+  encoded_image_buffer_pool_.Release();
+  thread_quota_.reset();
+  speed_controller_.reset();
+  updated_blocks_.reset();
+  active_map_set_ = false;
   inited_ = false;
   return ret_val;
 }
@@ -628,8 +643,7 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
     config_->rc_resize_allowed = inst->VP9().automaticResizeOn ? 1 : 0;
   }
   // Determine number of threads based on the image size and #cores.
-  config_->g_threads =
-      NumberOfThreads(config_->g_w, config_->g_h, settings.number_of_cores);
+  AcquireThreads(settings.number_of_cores);
 
   is_flexible_mode_ = inst->VP9().flexibleMode;
 
@@ -692,6 +706,13 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   }
   ref_buf_.clear();
 
+  // With a single layer, every encoded frame references and replaces the
+  // previous one.
+  if (use_active_map_ && codec_.mode == VideoCodecMode::kScreensharing &&
+      num_spatial_layers_ == 1 && num_temporal_layers_ == 1) {
+    updated_blocks_.emplace(codec_.width, codec_.height);
+  }
+
   return InitAndSetControlSettings(inst);
 }
 
@@ -717,6 +738,39 @@ int LibvpxVp9Encoder::NumberOfThreads(int width,
   }
 }
 
+void LibvpxVp9Encoder::AcquireThreads(int number_of_cores) {
+  RTC_DCHECK(!thread_quota_);
+  const int pixels = config_->g_w * config_->g_h;
+  int threads;
+  int tile_columns_log2 = -1;
+  if (threading_settings_.settings_by_resolution.empty()) {
+    threads = NumberOfThreads(config_->g_w, config_->g_h, number_of_cores);
+  } else {
+    auto it = threading_settings_.settings_by_resolution.upper_bound(pixels);
+    if (it == threading_settings_.settings_by_resolution.begin()) {
+      threads = 1;
+    } else {
+      const ThreadingSettings::ParameterSet& settings = std::prev(it)->second;
+      threads = std::min(settings.threads, number_of_cores);
+      tile_columns_log2 = settings.tile_columns_log2;
+    }
+  }
+
+  // Screenshare runs at low frame rates, so its pixel count overstates the
+  // threads it needs.
+  thread_quota_ = EncoderResourceBroker::Default().RequestThreads(
+      {threads, pixels,
+       codec_.mode == VideoCodecMode::kScreensharing
+           ? EncoderResourceBroker::Priority::kLow
+           : EncoderResourceBroker::Priority::kNormal});
+  config_->g_threads = thread_quota_->threads();
+  // Keep the number of tile columns equal to the number of threads, unless
+  // configured otherwise. See comments below for VP9E_SET_TILE_COLUMNS.
+  tile_columns_log2_ = tile_columns_log2 >= 0
+                           ? tile_columns_log2
+                           : static_cast<int>(config_->g_threads >> 1);
+}
+
 int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   // Set QP-min/max per spatial and temporal layer.
   int tot_num_layers = num_spatial_layers_ * num_temporal_layers_;
@@ -794,6 +848,10 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   UpdatePerformanceFlags();
   RTC_DCHECK_EQ(performance_flags_by_spatial_index_.size(),
                 static_cast<size_t>(num_spatial_layers_));
+  if (speed_controller_config_) {
+    speed_controller_ =
+        std::make_unique<EncoderSpeedController>(*speed_controller_config_);
+  }
   if (performance_flags_.use_per_layer_speed) {
     for (int si = 0; si < num_spatial_layers_; ++si) {
       svc_params_.speed_per_layer[si] =
@@ -816,9 +874,8 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
     libvpx_->codec_control(encoder_, VP9E_SET_SVC_PARAMETERS, &svc_params_);
   }
   if (!is_svc_ || !performance_flags_.use_per_layer_speed) {
-    libvpx_->codec_control(
-        encoder_, VP8E_SET_CPUUSED,
-        performance_flags_by_spatial_index_.rbegin()->base_layer_speed);
+    cpu_speed_ = performance_flags_by_spatial_index_.rbegin()->base_layer_speed;
+    libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, cpu_speed_);
   }
 
   if (num_spatial_layers_ > 1) {
@@ -882,11 +939,11 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
-                         static_cast<int>((config_->g_threads >> 1)));
+  libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS, tile_columns_log2_);
 
   // Turn on row-based multithreading.
-  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT, 1);
+  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT,
+                         threading_settings_.row_mt ? 1 : 0);
 
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
     !defined(ANDROID)
@@ -930,6 +987,11 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
   if (encoded_complete_callback_ == nullptr) {
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
+  // Frames dropped below are still part of the change since the previous
+  // encoded frame.
+  if (updated_blocks_) {
+    updated_blocks_->AddUpdate(input_image.update_rect());
+  }
   if (num_active_spatial_layers_ == 0) {
     // All spatial layers are disabled, return without encoding anything.
     return WEBRTC_VIDEO_CODEC_OK;
@@ -1039,10 +1101,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
     // Update speed settings that might depend on temporal index.
     bool speed_updated = false;
     for (int sl_idx = 0; sl_idx < num_spatial_layers_; ++sl_idx) {
-      const int target_speed =
+      const int target_speed = AdjustedSpeed(
           layer_id.temporal_layer_id_per_spatial[sl_idx] == 0
               ? performance_flags_by_spatial_index_[sl_idx].base_layer_speed
-              : performance_flags_by_spatial_index_[sl_idx].high_layer_speed;
+              : performance_flags_by_spatial_index_[sl_idx].high_layer_speed);
       if (svc_params_.speed_per_layer[sl_idx] != target_speed) {
         svc_params_.speed_per_layer[sl_idx] = target_speed;
         speed_updated = true;
@@ -1075,11 +1137,11 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                       svc_params_.scaling_factor_den[i];
           int height = (svc_params_.scaling_factor_num[i] * config_->g_h) /
                        svc_params_.scaling_factor_den[i];
-          int speed =
+          cpu_speed_ = AdjustedSpeed(
               std::prev(performance_flags_.settings_by_resolution.lower_bound(
                             width * height))
-                  ->second.base_layer_speed;
-          libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, speed);
+                  ->second.base_layer_speed);
+          libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, cpu_speed_);
           break;
         }
       }
@@ -1173,6 +1235,24 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                            &ref_config);
   }
 
+  if (updated_blocks_) {
+    // Without a partial update, either all blocks changed or the frame is a
+    // repeat that should refine all of them.
+    const bool use_active_map =
+        !force_key_frame_ && updated_blocks_->IsPartial();
+    if (use_active_map || active_map_set_) {
+      vpx_active_map_t active_map;
+      active_map.active_map =
+          use_active_map ? updated_blocks_->data() : nullptr;
+      active_map.rows = updated_blocks_->rows();
+      active_map.cols = updated_blocks_->cols();
+      if (libvpx_->codec_control(encoder_, VP8E_SET_ACTIVEMAP, &active_map) ==
+          VPX_CODEC_OK) {
+        active_map_set_ = use_active_map;
+      }
+    }
+  }
+
   first_frame_in_picture_ = true;
 
   // TODO(ssilkin): Frame duration should be specified per spatial layer
@@ -1190,6 +1270,7 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                          .GetTargetRate())
           : codec_.maxFramerate;
   uint32_t duration = static_cast<uint32_t>(90000 / target_framerate_fps);
+  const int64_t encode_start_us = rtc::TimeMicros();
   const vpx_codec_err_t rv = libvpx_->codec_encode(
       encoder_, raw_, timestamp_, duration, flags, VPX_DL_REALTIME);
   if (rv != VPX_CODEC_OK) {
@@ -1202,6 +1283,13 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
   }
   timestamp_ += duration;
 
+  if (speed_controller_ &&
+      speed_controller_->OnFrameEncoded(
+          TimeDelta::Micros(rtc::TimeMicros() - encode_start_us),
+          TimeDelta::Seconds(1) / target_framerate_fps, encoded_image_.qp_)) {
+    OnSpeedOffsetChanged();
+  }
+
   if (layer_buffering_) {
     const bool end_of_picture = true;
     DeliverBufferedFrame(end_of_picture);
@@ -1638,6 +1726,12 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     return;
   }
 
+  if (updated_blocks_) {
+    // The frame replaced the reference of the next one, even if it ends up
+    // not being sent.
+    updated_blocks_->Reset();
+  }
+
   vpx_svc_layer_id_t layer_id = {0};
   libvpx_->codec_control(encoder_, VP9E_GET_SVC_LAYER_ID, &layer_id);
 
@@ -1647,9 +1741,7 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     DeliverBufferedFrame(end_of_picture);
   }
 
-  // TODO(nisse): Introduce some buffer cache or buffer pool, to reduce
-  // allocations and/or copy operations.
-  encoded_image_.SetEncodedData(EncodedImageBuffer::Create(
+  encoded_image_.SetEncodedData(encoded_image_buffer_pool_.CreateBuffer(
       static_cast<const uint8_t*>(pkt->data.frame.buf), pkt->data.frame.sz));
 
   codec_specific_ = {};
@@ -1660,6 +1752,12 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     return;
   }
   encoded_image_.SetSpatialIndex(spatial_index);
+  if (speed_controller_) {
+    encoded_image_.SetEncoderSpeed(
+        is_svc_ && performance_flags_.use_per_layer_speed
+            ? svc_params_.speed_per_layer[spatial_index.value_or(0)]
+            : cpu_speed_);
+  }
 
   const bool is_key_frame =
       ((pkt->data.frame.flags & VPX_FRAME_IS_KEY) ? true : false) &&
@@ -1870,6 +1968,24 @@ void LibvpxVp9Encoder::UpdatePerformanceFlags() {
   }
 }
 
+int LibvpxVp9Encoder::AdjustedSpeed(int speed) const {
+  if (!speed_controller_)
+    return speed;
+  return rtc::SafeClamp(speed + speed_controller_->speed_offset(), 0, 9);
+}
+
+void LibvpxVp9Encoder::OnSpeedOffsetChanged() {
+  if (!performance_flags_.use_per_layer_speed) {
+    // The speed of the highest active resolution is set with the config.
+    config_changed_ = true;
+  } else if (!is_svc_) {
+    cpu_speed_ = AdjustedSpeed(
+        performance_flags_by_spatial_index_.rbegin()->base_layer_speed);
+    libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, cpu_speed_);
+  }
+  // With SVC the per layer speeds are updated before the next frame.
+}
+
 // static
 LibvpxVp9Encoder::PerformanceFlags
 LibvpxVp9Encoder::ParsePerformanceFlagsFromTrials(
@@ -1920,6 +2036,48 @@ LibvpxVp9Encoder::ParsePerformanceFlagsFromTrials(
   return flags;
 }
 
+// static
+LibvpxVp9Encoder::ThreadingSettings
+LibvpxVp9Encoder::ParseThreadingSettingsFromTrials(
+    const WebRtcKeyValueConfig& trials) {
+  struct Params : public ThreadingSettings::ParameterSet {
+    int min_pixel_count = 0;
+  };
+
+  FieldTrialStructList<Params> trials_list(
+      {FieldTrialStructMember("min_pixel_count",
+                              [](Params* p) { return &p->min_pixel_count; }),
+       FieldTrialStructMember("threads",
+                              [](Params* p) { return &p->threads; }),
+       FieldTrialStructMember("tile_columns",
+                              [](Params* p) { return &p->tile_columns_log2; })},
+      {});
+  FieldTrialParameter<bool> row_mt("row_mt", true);
+
+  ParseFieldTrial({&trials_list, &row_mt},
+                  trials.Lookup("WebRTC-VP9-Threading"));
+
+  ThreadingSettings settings;
+  settings.row_mt = row_mt.Get();
+
+  // libvpx supports up to 64 threads and 2^6 tile columns.
+  constexpr int kMaxThreads = 64;
+  constexpr int kMaxTileColumnsLog2 = 6;
+  for (auto& p : trials_list.Get()) {
+    if (p.threads < 1 || p.threads > kMaxThreads || p.tile_columns_log2 < -1 ||
+        p.tile_columns_log2 > kMaxTileColumnsLog2) {
+      RTC_LOG(LS_WARNING) << "Ignoring invalid threading settings: "
+                          << "min_pixel_count = " << p.min_pixel_count
+                          << ", threads = " << p.threads
+                          << ", tile_columns = " << p.tile_columns_log2;
+      continue;
+    }
+    settings.settings_by_resolution[p.min_pixel_count] = p;
+  }
+
+  return settings;
+}
+
 // static
 LibvpxVp9Encoder::PerformanceFlags
 LibvpxVp9Encoder::GetDefaultPerformanceFlags() {
@@ -18,16 +18,21 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/transport/webrtc_key_value_config.h"
+#include "api/video_codecs/encoder_resource_broker.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp9_profile.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "common_video/include/video_frame_buffer_pool.h"
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
+#include "modules/video_coding/utility/encoder_speed_controller.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
+#include "modules/video_coding/utility/updated_block_map.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "vpx/vp8cx.h"
 
@@ -61,6 +66,9 @@ class LibvpxVp9Encoder : public VP9Encoder {
  private:
   // Determine number of encoder threads to use.
   int NumberOfThreads(int width, int height, int number_of_cores);
+  // Requests the encoder threads from the EncoderResourceBroker, and sets
+  // `config_->g_threads` and `tile_columns_log2_` accordingly.
+  void AcquireThreads(int number_of_cores);
 
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings(const VideoCodec* inst);
@@ -116,6 +124,7 @@ class LibvpxVp9Encoder : public VP9Encoder {
 
   const std::unique_ptr<LibvpxInterface> libvpx_;
   EncodedImage encoded_image_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   CodecSpecificInfo codec_specific_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
@@ -233,14 +242,55 @@ class LibvpxVp9Encoder : public VP9Encoder {
   std::vector<PerformanceFlags::ParameterSet>
       performance_flags_by_spatial_index_;
   void UpdatePerformanceFlags();
+  // Applies the offset of `speed_controller_` to a speed setting.
+  int AdjustedSpeed(int speed) const;
+  void OnSpeedOffsetChanged();
   static PerformanceFlags ParsePerformanceFlagsFromTrials(
       const WebRtcKeyValueConfig& trials);
   static PerformanceFlags GetDefaultPerformanceFlags();
 
+  // Multithreading policy, configurable per resolution range like the
+  // performance flags.
+  struct ThreadingSettings {
+    // Row-based multithreading on top of the tile columns.
+    bool row_mt = true;
+
+    struct ParameterSet {
+      // Number of threads, capped by the number of cores.
+      int threads = 1;
+      // Tile columns in log2 units, or -1 to derive them from `threads`.
+      int tile_columns_log2 = -1;
+    };
+    // Map from min pixel count of the top spatial layer to settings for that
+    // resolution and above. If empty, NumberOfThreads() decides.
+    std::map<int, ParameterSet> settings_by_resolution;
+  };
+  const ThreadingSettings threading_settings_;
+  static ThreadingSettings ParseThreadingSettingsFromTrials(
+      const WebRtcKeyValueConfig& trials);
+  std::unique_ptr<EncoderResourceBroker::ThreadQuota> thread_quota_;
+  int tile_columns_log2_;
+
+  // Set if the encoder adapts its speed to the encode time, see
+  // EncoderSpeedController.
+  const absl::optional<EncoderSpeedController::Config>
+      speed_controller_config_;
+  std::unique_ptr<EncoderSpeedController> speed_controller_;
+  // Last speed set with VP8E_SET_CPUUSED.
+  int cpu_speed_ = 0;
+
   int num_steady_state_frames_;
   // Only set config when this flag is set.
   bool config_changed_;
 
+  // Screenshare without spatial and temporal layers marks the blocks that did
+  // not change since the previous encoded frame as inactive, so that libvpx
+  // codes them as skipped without searching for motion.
+  const bool use_active_map_;
+  // Set if the active map is used with the current configuration.
+  absl::optional<UpdatedBlockMap> updated_blocks_;
+  bool active_map_set_ = false;
+
   const LibvpxVp9EncoderInfoSettings encoder_info_override_;
 };
 
@@ -14,6 +14,7 @@
 #include "api/test/mock_video_encoder.h"
 #include "api/video/color_space.h"
 #include "api/video/i420_buffer.h"
+#include "api/video_codecs/encoder_resource_broker.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp9_profile.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -2443,4 +2444,102 @@ TEST(Vp9SpeedSettingsTrialsTest, DefaultPerLayerFlagsWithSvc) {
   }
 }
 
+
+TEST(Vp9ThreadingTrialsTest, UsesThreadsAndTileColumnsForResolution) {
+  // 2 threads and 1 tile column below 640x360, 4 threads and 4 tile columns
+  // at and above that.
+  test::ExplicitKeyValueConfig trials(
+      "WebRTC-VP9-Threading/"
+      "min_pixel_count:0|230400,"
+      "threads:2|4,"
+      "tile_columns:0|2,"
+      "row_mt:false/");
+
+  // Keep a raw pointer for EXPECT calls and the like. Ownership is otherwise
+  // passed on to LibvpxVp9Encoder.
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp9Encoder encoder(cricket::VideoCodec(),
+                           absl::WrapUnique<LibvpxInterface>(vpx), trials);
+
+  VideoCodec settings = DefaultCodecSettings();
+  settings.width = 960;
+  settings.height = 540;
+  vpx_image_t img;
+  unsigned int threads = 0;
+
+  ON_CALL(*vpx, img_wrap).WillByDefault(GetWrapImageFunction(&img));
+  ON_CALL(*vpx, codec_enc_config_default)
+      .WillByDefault(DoAll(WithArg<1>([](vpx_codec_enc_cfg_t* cfg) {
+                             memset(cfg, 0, sizeof(vpx_codec_enc_cfg_t));
+                           }),
+                           Return(VPX_CODEC_OK)));
+  ON_CALL(*vpx, codec_enc_init)
+      .WillByDefault(WithArg<2>([&](const vpx_codec_enc_cfg_t* cfg) {
+        threads = cfg->g_threads;
+        return VPX_CODEC_OK;
+      }));
+  EXPECT_CALL(*vpx, codec_control(_, _, An<int>())).Times(AnyNumber());
+
+  const VideoEncoder::Settings kEightCores(kCapabilities, /*number_of_cores=*/8,
+                                           /*max_payload_size=*/0);
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_TILE_COLUMNS, TypedEq<int>(2)));
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_ROW_MT, TypedEq<int>(0)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.InitEncode(&settings, kEightCores));
+  EXPECT_EQ(4u, threads);
+
+  encoder.Release();
+  settings.width = 480;
+  settings.height = 270;
+
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_TILE_COLUMNS, TypedEq<int>(0)));
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_ROW_MT, TypedEq<int>(0)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.InitEncode(&settings, kEightCores));
+  EXPECT_EQ(2u, threads);
+}
+
+TEST(Vp9ThreadingTrialsTest, SharesThreadsThroughResourceBroker) {
+  test::ExplicitKeyValueConfig trials(
+      "WebRTC-VP9-Threading/"
+      "min_pixel_count:0,"
+      "threads:4/");
+  EncoderResourceBroker::Default().SetMaxTotalThreads(6);
+
+  std::vector<unsigned int> threads;
+  auto create_encoder = [&](vpx_image_t* img) {
+    auto* const vpx = new NiceMock<MockLibvpxInterface>();
+    ON_CALL(*vpx, img_wrap).WillByDefault(GetWrapImageFunction(img));
+    ON_CALL(*vpx, codec_enc_config_default)
+        .WillByDefault(DoAll(WithArg<1>([](vpx_codec_enc_cfg_t* cfg) {
+                               memset(cfg, 0, sizeof(vpx_codec_enc_cfg_t));
+                             }),
+                             Return(VPX_CODEC_OK)));
+    ON_CALL(*vpx, codec_enc_init)
+        .WillByDefault(WithArg<2>([&](const vpx_codec_enc_cfg_t* cfg) {
+          threads.push_back(cfg->g_threads);
+          return VPX_CODEC_OK;
+        }));
+    return std::make_unique<LibvpxVp9Encoder>(
+        cricket::VideoCodec(), absl::WrapUnique<LibvpxInterface>(vpx), trials);
+  };
+
+  VideoCodec settings = DefaultCodecSettings();
+  const VideoEncoder::Settings kEightCores(kCapabilities, /*number_of_cores=*/8,
+                                           /*max_payload_size=*/0);
+  vpx_image_t first_img;
+  vpx_image_t second_img;
+  std::unique_ptr<LibvpxVp9Encoder> first = create_encoder(&first_img);
+  std::unique_ptr<LibvpxVp9Encoder> second = create_encoder(&second_img);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, first->InitEncode(&settings, kEightCores));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, second->InitEncode(&settings, kEightCores));
+  // The first encoder gives up the threads beyond its share when it is
+  // initialized again.
+  first->Release();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, first->InitEncode(&settings, kEightCores));
+  second->Release();
+  first->Release();
+  EncoderResourceBroker::Default().SetMaxTotalThreads(0);
+
+  EXPECT_THAT(threads, ElementsAre(4u, 3u, 3u));
+}
+
 }  // namespace webrtc
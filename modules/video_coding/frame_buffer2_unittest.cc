@@ -119,6 +119,7 @@ class VCMReceiveStatisticsCallbackMock : public VCMReceiveStatisticsCallback {
                VideoContentType content_type),
               (override));
   MOCK_METHOD(void, OnDroppedFrames, (uint32_t frames_dropped), (override));
+  MOCK_METHOD(void, OnLateFramesSkipped, (uint32_t frames_skipped), (override));
   MOCK_METHOD(void,
               OnFrameBufferTimingsUpdated,
               (int max_decode,
@@ -149,6 +149,44 @@ void FrameBuffer::DropNextDecodableTemporalUnit() {
   FindNextAndLastDecodableTemporalUnit();
 }
 
+bool FrameBuffer::IsNextDecodableTemporalUnitDiscardable() const {
+  if (!next_decodable_temporal_unit_) {
+    return false;
+  }
+
+  auto end_it = std::next(next_decodable_temporal_unit_->last_frame);
+  // Without later frames there is nothing to tell whether the unit is used as
+  // a reference.
+  if (end_it == frames_.end()) {
+    return false;
+  }
+
+  for (auto it = next_decodable_temporal_unit_->first_frame; it != end_it;
+       ++it) {
+    const EncodedFrame& frame = *it->second.encoded_frame;
+    if (frame.is_keyframe()) {
+      return false;
+    }
+    if (frame.CodecSpecific()->codecType == kVideoCodecVP8 &&
+        !frame.CodecSpecific()->codecSpecific.VP8.nonReference) {
+      return false;
+    }
+  }
+
+  const int64_t first_id =
+      GetFrameId(next_decodable_temporal_unit_->first_frame);
+  const int64_t last_id = GetFrameId(next_decodable_temporal_unit_->last_frame);
+  for (auto it = end_it; it != frames_.end(); ++it) {
+    for (int64_t reference : GetReferences(it)) {
+      if (reference >= first_id && reference <= last_id) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 absl::optional<int64_t> FrameBuffer::LastContinuousFrameId() const {
   return last_continuous_frame_id_;
 }
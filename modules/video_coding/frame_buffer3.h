@@ -50,6 +50,12 @@ class FrameBuffer {
   // Drop all frames in the next decodable unit.
   void DropNextDecodableTemporalUnit();
 
+  // Returns true if no other frame is expected to reference the next decodable
+  // temporal unit, so that it can be dropped without breaking the stream. This
+  // is the case if it is not a keyframe, if frames after it have been inserted
+  // and none of them reference it, and if the codec does not say otherwise.
+  bool IsNextDecodableTemporalUnitDiscardable() const;
+
   absl::optional<int64_t> LastContinuousFrameId() const;
   absl::optional<int64_t> LastContinuousTemporalUnitFrameId() const;
   absl::optional<uint32_t> NextDecodableTemporalUnitRtpTimestamp() const;
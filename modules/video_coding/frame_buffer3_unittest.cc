@@ -215,6 +215,39 @@ TEST(FrameBuffer3Test, DropNextDecodableTemporalUnit) {
               ElementsAre(FrameWithId(3)));
 }
 
+TEST(FrameBuffer3Test, UnreferencedTemporalUnitIsDiscardable) {
+  FrameBuffer buffer(/*max_frame_slots=*/10, /*max_decode_history=*/100);
+  buffer.InsertFrame(Builder().Time(10).Id(1).AsLast().Build());
+  buffer.InsertFrame(Builder().Time(20).Id(2).Refs({1}).AsLast().Build());
+  // A keyframe is never discardable.
+  EXPECT_FALSE(buffer.IsNextDecodableTemporalUnitDiscardable());
+
+  buffer.ExtractNextDecodableTemporalUnit();
+  // Nothing tells yet whether frame 2 is a reference.
+  EXPECT_FALSE(buffer.IsNextDecodableTemporalUnitDiscardable());
+
+  buffer.InsertFrame(Builder().Time(30).Id(3).Refs({1}).AsLast().Build());
+  EXPECT_TRUE(buffer.IsNextDecodableTemporalUnitDiscardable());
+
+  buffer.InsertFrame(Builder().Time(40).Id(4).Refs({2, 3}).AsLast().Build());
+  EXPECT_FALSE(buffer.IsNextDecodableTemporalUnitDiscardable());
+}
+
+TEST(FrameBuffer3Test, Vp8ReferenceFrameIsNotDiscardable) {
+  FrameBuffer buffer(/*max_frame_slots=*/10, /*max_decode_history=*/100);
+  buffer.InsertFrame(Builder().Time(10).Id(1).AsLast().Build());
+  buffer.ExtractNextDecodableTemporalUnit();
+
+  CodecSpecificInfo codec_specific;
+  codec_specific.codecType = kVideoCodecVP8;
+  codec_specific.codecSpecific.VP8.nonReference = false;
+  auto frame = Builder().Time(20).Id(2).Refs({1}).AsLast().Build();
+  frame->SetCodecSpecific(&codec_specific);
+  buffer.InsertFrame(std::move(frame));
+  buffer.InsertFrame(Builder().Time(30).Id(3).Refs({1}).AsLast().Build());
+  EXPECT_FALSE(buffer.IsNextDecodableTemporalUnitDiscardable());
+}
+
 TEST(FrameBuffer3Test, OldFramesAreIgnored) {
   FrameBuffer buffer(/*max_frame_slots=*/10, /*max_decode_history=*/100);
   buffer.InsertFrame(Builder().Time(10).Id(1).AsLast().Build());
@@ -87,11 +87,19 @@ RtpFrameObject::RtpFrameObject(
   timing_.receive_finish_ms = last_packet_received_time;
   timing_.flags = timing.flags;
   is_last_spatial_layer = markerBit;
+  live_object_.SetBytes(image_buffer_ ? image_buffer_->size() : 0);
 }
 
 RtpFrameObject::~RtpFrameObject() {
 }
 
+// static
+rtc::LiveObjectCounter& RtpFrameObject::LiveObjects() {
+  static rtc::LiveObjectCounter* const counter =
+      new rtc::LiveObjectCounter("RtpFrameObject");
+  return *counter;
+}
+
 uint16_t RtpFrameObject::first_seq_num() const {
   return first_seq_num_;
 }
@@ -13,6 +13,8 @@
 
 #include "absl/types/optional.h"
 #include "api/video/encoded_frame.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/system/no_unique_address.h"
 
 namespace webrtc {
 
@@ -50,6 +52,8 @@ class RtpFrameObject : public EncodedFrame {
   uint8_t* mutable_data() { return image_buffer_->data(); }
 
  private:
+  static rtc::LiveObjectCounter& LiveObjects();
+
   // Reference for mutable access.
   rtc::scoped_refptr<EncodedImageBuffer> image_buffer_;
   RTPVideoHeader rtp_video_header_;
@@ -61,6 +65,7 @@ class RtpFrameObject : public EncodedFrame {
   // Equal to times nacked of the packet with the highet times nacked
   // belonging to this frame.
   int times_nacked_;
+  RTC_NO_UNIQUE_ADDRESS rtc::LiveObject live_object_{LiveObjects()};
 };
 
 }  // namespace webrtc
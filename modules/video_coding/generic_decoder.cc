@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #include "api/video/video_timing.h"
 #include "modules/video_coding/include/video_error_codes.h"
@@ -119,7 +120,7 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
   }
 
   decodedImage.set_ntp_time_ms(frameInfo->ntp_time_ms);
-  decodedImage.set_packet_infos(frameInfo->packet_infos);
+  decodedImage.set_packet_infos(std::move(frameInfo->packet_infos));
   decodedImage.set_rotation(frameInfo->rotation);
 
   if (low_latency_renderer_enabled_) {
@@ -208,12 +209,12 @@ void VCMDecodedFrameCallback::OnDecoderImplementationName(
 }
 
 void VCMDecodedFrameCallback::Map(uint32_t timestamp,
-                                  const VCMFrameInformation& frameInfo) {
+                                  VCMFrameInformation frameInfo) {
   int dropped_frames = 0;
   {
     MutexLock lock(&lock_);
     int initial_size = _timestampMap.Size();
-    _timestampMap.Add(timestamp, frameInfo);
+    _timestampMap.Add(timestamp, std::move(frameInfo));
     // If no frame is dropped, the new size should be `initial_size` + 1
     dropped_frames = (initial_size + 1) - _timestampMap.Size();
   }
@@ -278,7 +279,7 @@ int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, Timestamp now) {
   } else {
     frame_info.content_type = _last_keyframe_content_type;
   }
-  _callback->Map(frame.Timestamp(), frame_info);
+  _callback->Map(frame.Timestamp(), std::move(frame_info));
 
   int32_t ret = decoder_->Decode(frame.EncodedImage(), frame.MissingFrame(),
                                  frame.RenderTimeMs());
@@ -44,7 +44,7 @@ class VCMDecodedFrameCallback : public DecodedImageCallback {
 
   void OnDecoderImplementationName(const char* implementation_name);
 
-  void Map(uint32_t timestamp, const VCMFrameInformation& frameInfo);
+  void Map(uint32_t timestamp, VCMFrameInformation frameInfo);
   void ClearTimestampMap();
 
  private:
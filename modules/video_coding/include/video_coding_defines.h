@@ -74,6 +74,10 @@ class VCMReceiveStatisticsCallback {
 
   virtual void OnDroppedFrames(uint32_t frames_dropped) = 0;
 
+  // Called for discardable frames that were not decoded because they would
+  // have been rendered late. These are also reported by OnDroppedFrames().
+  virtual void OnLateFramesSkipped(uint32_t frames_skipped) = 0;
+
   virtual void OnFrameBufferTimingsUpdated(int max_decode_ms,
                                            int current_delay_ms,
                                            int target_delay_ms,
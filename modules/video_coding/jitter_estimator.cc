@@ -50,9 +50,7 @@ constexpr double kNoiseStdDevOffset = 30.0;
 }  // namespace
 
 VCMJitterEstimator::VCMJitterEstimator(Clock* clock)
-    : fps_counter_(30),  // TODO(sprang): Use an estimator with limit based on
-                         // time, rather than number of samples.
-      time_deviation_upper_bound_(
+    : time_deviation_upper_bound_(
           JitterUpperBoundExperiment::GetUpperBoundSigmas().value_or(
               kDefaultMaxTimestampDeviationInSigmas)),
       enable_reduced_delay_(
@@ -90,7 +88,9 @@ void VCMJitterEstimator::Reset() {
   frame_size_count_ = 0;
   startup_count_ = 0;
   rtt_filter_.Reset();
-  fps_counter_.Reset();
+  num_frame_periods_ = 0;
+  next_frame_period_ = 0;
+  frame_periods_sum_us_ = 0;
 }
 
 // Updates the estimates with the new measurements.
@@ -276,7 +276,15 @@ void VCMJitterEstimator::EstimateRandomJitter(double d_dT,
                                               bool incomplete_frame) {
   Timestamp now = clock_->CurrentTime();
   if (last_update_time_.has_value()) {
-    fps_counter_.AddSample((now - *last_update_time_).us());
+    int64_t frame_period_us = (now - *last_update_time_).us();
+    if (num_frame_periods_ == kNumFramePeriods) {
+      frame_periods_sum_us_ -= frame_periods_us_[next_frame_period_];
+    } else {
+      ++num_frame_periods_;
+    }
+    frame_periods_us_[next_frame_period_] = frame_period_us;
+    frame_periods_sum_us_ += frame_period_us;
+    next_frame_period_ = (next_frame_period_ + 1) % kNumFramePeriods;
   }
   last_update_time_ = now;
 
@@ -408,7 +416,11 @@ TimeDelta VCMJitterEstimator::GetJitterEstimate(
 }
 
 Frequency VCMJitterEstimator::GetFrameRate() const {
-  TimeDelta mean_frame_period = TimeDelta::Micros(fps_counter_.ComputeMean());
+  if (num_frame_periods_ == 0)
+    return Frequency::Zero();
+  TimeDelta mean_frame_period =
+      TimeDelta::Micros(static_cast<double>(frame_periods_sum_us_) /
+                        num_frame_periods_);
   if (mean_frame_period <= TimeDelta::Zero())
     return Frequency::Zero();
 
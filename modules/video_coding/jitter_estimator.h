@@ -11,13 +11,17 @@
 #ifndef MODULES_VIDEO_CODING_JITTER_ESTIMATOR_H_
 #define MODULES_VIDEO_CODING_JITTER_ESTIMATOR_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
 #include "absl/types/optional.h"
 #include "api/units/data_size.h"
 #include "api/units/frequency.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/video_coding/rtt_filter.h"
-#include "rtc_base/rolling_accumulator.h"
 
 namespace webrtc {
 
@@ -152,8 +156,14 @@ class VCMJitterEstimator {
   uint32_t nack_count_;
   VCMRttFilter rtt_filter_;
 
-  // Tracks frame rates in microseconds.
-  rtc::RollingAccumulator<uint64_t> fps_counter_;
+  // The last `kNumFramePeriods` frame periods, in microseconds, and their
+  // sum, which the frame rate is estimated from. TODO(sprang): Use an
+  // estimator with limit based on time, rather than number of samples.
+  static constexpr size_t kNumFramePeriods = 30;
+  std::array<int64_t, kNumFramePeriods> frame_periods_us_;
+  size_t num_frame_periods_;
+  size_t next_frame_period_;
+  int64_t frame_periods_sum_us_;
   const double time_deviation_upper_bound_;
   const bool enable_reduced_delay_;
   Clock* clock_;
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "api/sequence_checker.h"
 #include "api/task_queue/task_queue_base.h"
@@ -47,8 +48,10 @@ int64_t GetSendNackDelay() {
 
 constexpr TimeDelta NackPeriodicProcessor::kUpdateInterval;
 
-NackPeriodicProcessor::NackPeriodicProcessor(TimeDelta update_interval)
-    : update_interval_(update_interval) {}
+NackPeriodicProcessor::NackPeriodicProcessor(
+    TimeDelta update_interval,
+    MetronomeTaskScheduler* tick_scheduler)
+    : update_interval_(update_interval), tick_scheduler_(tick_scheduler) {}
 
 NackPeriodicProcessor::~NackPeriodicProcessor() {}
 
@@ -57,12 +60,18 @@ void NackPeriodicProcessor::RegisterNackModule(NackRequesterBase* module) {
   modules_.push_back(module);
   if (modules_.size() != 1)
     return;
-  repeating_task_ = RepeatingTaskHandle::DelayedStart(
-      TaskQueueBase::Current(), update_interval_, [this] {
-        RTC_DCHECK_RUN_ON(&sequence_);
-        ProcessNackModules();
-        return update_interval_;
-      });
+  auto process = [this] {
+    RTC_DCHECK_RUN_ON(&sequence_);
+    ProcessNackModules();
+    return update_interval_;
+  };
+  if (tick_scheduler_) {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        tick_scheduler_, update_interval_, std::move(process));
+  } else {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        TaskQueueBase::Current(), update_interval_, std::move(process));
+  }
 }
 
 void NackPeriodicProcessor::UnregisterNackModule(NackRequesterBase* module) {
@@ -93,7 +102,11 @@ ScopedNackPeriodicProcessorRegistration::
 }
 
 NackRequester::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : seq_num(0),
+      send_at_seq_num(0),
+      sent_at_time(-1),
+      retries(0),
+      removed(false) {}
 
 NackRequester::NackInfo::NackInfo(uint16_t seq_num,
                                   uint16_t send_at_seq_num,
@@ -102,7 +115,57 @@ NackRequester::NackInfo::NackInfo(uint16_t seq_num,
       send_at_seq_num(send_at_seq_num),
       created_at_time(created_at_time),
       sent_at_time(-1),
-      retries(0) {}
+      retries(0),
+      removed(false) {}
+
+NackRequester::NackList::NackList() = default;
+NackRequester::NackList::~NackList() = default;
+
+void NackRequester::NackList::PushBack(const NackInfo& info) {
+  RTC_DCHECK(entries_.empty() ||
+             AheadOf(info.seq_num, entries_.back().seq_num));
+  entries_.push_back(info);
+  ++size_;
+}
+
+NackRequester::NackInfo* NackRequester::NackList::Find(uint16_t seq_num) {
+  auto it = std::lower_bound(entries_.begin(), entries_.end(), seq_num,
+                             [](const NackInfo& info, uint16_t seq_num) {
+                               return AheadOf(seq_num, info.seq_num);
+                             });
+  if (it == entries_.end() || it->seq_num != seq_num || it->removed)
+    return nullptr;
+  return &*it;
+}
+
+void NackRequester::NackList::Remove(NackInfo& info) {
+  RTC_DCHECK(!info.removed);
+  info.removed = true;
+  --size_;
+  PopRemovedFront();
+}
+
+size_t NackRequester::NackList::RemoveOlderThan(uint16_t seq_num) {
+  size_t num_removed = 0;
+  while (!entries_.empty() && AheadOf(seq_num, entries_.front().seq_num)) {
+    if (!entries_.front().removed)
+      ++num_removed;
+    entries_.pop_front();
+  }
+  size_ -= num_removed;
+  PopRemovedFront();
+  return num_removed;
+}
+
+void NackRequester::NackList::Clear() {
+  entries_.clear();
+  size_ = 0;
+}
+
+void NackRequester::NackList::PopRemovedFront() {
+  while (!entries_.empty() && entries_.front().removed)
+    entries_.pop_front();
+}
 
 NackRequester::BackoffSettings::BackoffSettings(TimeDelta min_retry,
                                                 TimeDelta max_rtt,
@@ -202,11 +265,11 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    NackInfo* nack_info = nack_list_.Find(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (nack_info != nullptr) {
+      nacks_sent_for_packet = nack_info->retries;
+      nack_list_.Remove(*nack_info);
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -252,7 +315,7 @@ void NackRequester::ClearUpTo(uint16_t seq_num) {
   // Called via RtpVideoStreamReceiver2::FrameContinuous on the network thread.
   worker_thread_->PostTask(ToQueuedTask(task_safety_, [seq_num, this]() {
     RTC_DCHECK_RUN_ON(worker_thread_);
-    nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
+    nack_list_.RemoveOlderThan(seq_num);
     keyframe_list_.erase(keyframe_list_.begin(),
                          keyframe_list_.lower_bound(seq_num));
     recovered_list_.erase(recovered_list_.begin(),
@@ -268,12 +331,9 @@ void NackRequester::UpdateRtt(int64_t rtt_ms) {
 bool NackRequester::RemovePacketsUntilKeyFrame() {
   // Called on worker_thread_.
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
+    if (nack_list_.RemoveOlderThan(*keyframe_list_.begin()) > 0) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      nack_list_.erase(nack_list_.begin(), it);
       return true;
     }
 
@@ -288,8 +348,7 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
                                      uint16_t seq_num_end) {
   // Called on worker_thread_.
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  nack_list_.RemoveOlderThan(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -301,7 +360,7 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
     }
 
     if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
-      nack_list_.clear();
+      nack_list_.Clear();
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -313,10 +372,8 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
     // Do not send nack for packets that are already recovered by FEC or RTX
     if (recovered_list_.find(seq_num) != recovered_list_.end())
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    nack_list_.PushBack(NackInfo(seq_num, seq_num + WaitNumberOfPackets(0.5),
+                                 clock_->TimeInMilliseconds()));
   }
 }
 
@@ -327,43 +384,42 @@ std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   Timestamp now = clock_->CurrentTime();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
+  std::vector<NackInfo*> max_retries_reached;
+  nack_list_.ForEach([&](NackInfo& info) {
     TimeDelta resend_delay = TimeDelta::Millis(rtt_ms_);
     if (backoff_settings_) {
       resend_delay =
           std::max(resend_delay, backoff_settings_->min_retry_interval);
-      if (it->second.retries > 1) {
+      if (info.retries > 1) {
         TimeDelta exponential_backoff =
             std::min(TimeDelta::Millis(rtt_ms_), backoff_settings_->max_rtt) *
-            std::pow(backoff_settings_->base, it->second.retries - 1);
+            std::pow(backoff_settings_->base, info.retries - 1);
         resend_delay = std::max(resend_delay, exponential_backoff);
       }
     }
 
     bool delay_timed_out =
-        now.ms() - it->second.created_at_time >= send_nack_delay_ms_;
+        now.ms() - info.created_at_time >= send_nack_delay_ms_;
     bool nack_on_rtt_passed =
-        now.ms() - it->second.sent_at_time >= resend_delay.ms();
+        now.ms() - info.sent_at_time >= resend_delay.ms();
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        info.sent_at_time == -1 &&
+        AheadOrAt(newest_seq_num_, info.send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now.ms();
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(info.seq_num);
+      ++info.retries;
+      info.sent_at_time = now.ms();
+      if (info.retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << info.seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        max_retries_reached.push_back(&info);
       }
-      continue;
     }
-    ++it;
-  }
+  });
+  // Removed after the scan, since removing may pop entries off the list.
+  for (NackInfo* info : max_retries_reached)
+    nack_list_.Remove(*info);
   return nack_batch;
 }
 
@@ -13,7 +13,7 @@
 
 #include <stdint.h>
 
-#include <map>
+#include <deque>
 #include <set>
 #include <vector>
 
@@ -23,6 +23,7 @@
 #include "modules/video_coding/histogram.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -39,7 +40,12 @@ class NackRequesterBase {
 class NackPeriodicProcessor {
  public:
   static constexpr TimeDelta kUpdateInterval = TimeDelta::Millis(20);
-  explicit NackPeriodicProcessor(TimeDelta update_interval = kUpdateInterval);
+  // If `tick_scheduler` is set, the NACK modules are processed on its
+  // metronome ticks instead of on a timer of their own. The modules must then
+  // be registered on the scheduler's task queue.
+  explicit NackPeriodicProcessor(
+      TimeDelta update_interval = kUpdateInterval,
+      MetronomeTaskScheduler* tick_scheduler = nullptr);
   ~NackPeriodicProcessor();
   void RegisterNackModule(NackRequesterBase* module);
   void UnregisterNackModule(NackRequesterBase* module);
@@ -48,6 +54,7 @@ class NackPeriodicProcessor {
   void ProcessNackModules() RTC_RUN_ON(sequence_);
 
   const TimeDelta update_interval_;
+  MetronomeTaskScheduler* const tick_scheduler_;
   RepeatingTaskHandle repeating_task_ RTC_GUARDED_BY(sequence_);
   std::vector<NackRequesterBase*> modules_ RTC_GUARDED_BY(sequence_);
   RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_;
@@ -100,6 +107,50 @@ class NackRequester final : public NackRequesterBase {
     int64_t created_at_time;
     int64_t sent_at_time;
     int retries;
+    // Set when the packet no longer needs to be nacked, until the entry
+    // reaches the front of the NackList.
+    bool removed;
+  };
+
+  // The packets to nack, in sequence number order. Both the received packets
+  // and the periodic processing scan the list, which grows to thousands of
+  // packets under burst loss, so the packets are kept in a contiguous
+  // container. Packets are only added after all others and mostly removed
+  // from the front; packets removed elsewhere are marked and dropped once they
+  // reach the front.
+  class NackList {
+   public:
+    NackList();
+    ~NackList();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // `info.seq_num` must be newer than the packets in the list.
+    void PushBack(const NackInfo& info);
+    // Returns nullptr if `seq_num` isn't in the list.
+    NackInfo* Find(uint16_t seq_num);
+    void Remove(NackInfo& info);
+    // Removes the packets older than `seq_num`. Returns the number of
+    // removed packets.
+    size_t RemoveOlderThan(uint16_t seq_num);
+    void Clear();
+
+    // Calls `f` with each packet in order.
+    template <typename F>
+    void ForEach(F f) {
+      for (NackInfo& info : entries_) {
+        if (!info.removed)
+          f(info);
+      }
+      PopRemovedFront();
+    }
+
+   private:
+    void PopRemovedFront();
+
+    std::deque<NackInfo> entries_;
+    size_t size_ = 0;
   };
 
   struct BackoffSettings {
@@ -141,8 +192,7 @@ class NackRequester final : public NackRequesterBase {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see `initialized_`). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(worker_thread_);
+  NackList nack_list_ RTC_GUARDED_BY(worker_thread_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
       RTC_GUARDED_BY(worker_thread_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
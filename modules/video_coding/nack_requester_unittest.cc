@@ -340,6 +340,27 @@ TEST_P(TestNackRequester, PacketNackCount) {
   EXPECT_EQ(0, nack_module.OnReceivedPacket(4, false, false));
 }
 
+TEST_P(TestNackRequester, ResendsOnlyMissingPacketsAfterBurstLoss) {
+  NackRequester& nack_module = CreateNackModule(TimeDelta::Millis(1));
+  nack_module.OnReceivedPacket(0xff00, false, false);
+  nack_module.OnReceivedPacket(0x0200, false, false);
+  EXPECT_EQ(767u, sent_nacks_.size());
+  // Every other retransmission arrives, out of order.
+  for (uint16_t seq_num = 0x01fe; seq_num != 0xff00; seq_num -= 2) {
+    EXPECT_EQ(1, nack_module.OnReceivedPacket(seq_num, false, false));
+  }
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  WaitForSendNack();
+  ASSERT_EQ(384u, sent_nacks_.size());
+  uint16_t expected_seq_num = 0xff01;
+  for (uint16_t seq_num : sent_nacks_) {
+    EXPECT_EQ(seq_num, expected_seq_num);
+    expected_seq_num += 2;
+  }
+}
+
 TEST_P(TestNackRequester, NackListFullAndNoOverlapWithKeyframes) {
   NackRequester& nack_module = CreateNackModule();
   const int kMaxNackPackets = 1000;
@@ -180,14 +180,15 @@ bool PacketBuffer::ExpandBufferSize() {
     return false;
   }
 
-  size_t new_size = std::min(max_size_, 2 * buffer_.size());
-  std::vector<std::unique_ptr<Packet>> new_buffer(new_size);
-  for (std::unique_ptr<Packet>& entry : buffer_) {
-    if (entry != nullptr) {
-      new_buffer[entry->seq_num % new_size] = std::move(entry);
-    }
+  size_t old_size = buffer_.size();
+  size_t new_size = std::min(max_size_, 2 * old_size);
+  buffer_.resize(new_size);
+  // Since the sizes are powers of two, a packet either stays at its index or
+  // moves up by `old_size`.
+  for (size_t i = 0; i < old_size; ++i) {
+    if (buffer_[i] != nullptr && buffer_[i]->seq_num % new_size != i)
+      buffer_[i + old_size] = std::move(buffer_[i]);
   }
-  buffer_ = std::move(new_buffer);
   RTC_LOG(LS_INFO) << "PacketBuffer size expanded to " << new_size;
   return true;
 }
@@ -221,15 +222,24 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
   std::vector<std::unique_ptr<PacketBuffer::Packet>> found_frames;
   for (size_t i = 0; i < buffer_.size() && PotentialNewFrame(seq_num); ++i) {
     size_t index = seq_num % buffer_.size();
-    buffer_[index]->continuous = true;
+    Packet& packet = *buffer_[index];
+    packet.continuous = true;
+    // Continuity is only propagated within a frame, so the start of the frame
+    // is carried along instead of being searched for once the frame is
+    // complete.
+    if (packet.is_first_packet_in_frame()) {
+      packet.frame_start_seq_num = seq_num;
+    } else {
+      size_t prev_index = index > 0 ? index - 1 : buffer_.size() - 1;
+      packet.frame_start_seq_num = buffer_[prev_index]->frame_start_seq_num;
+    }
 
     // If all packets of the frame is continuous, find the first packet of the
     // frame and add all packets of the frame to the returned packets.
-    if (buffer_[index]->is_last_packet_in_frame()) {
+    if (packet.is_last_packet_in_frame()) {
       uint16_t start_seq_num = seq_num;
 
-      // Find the start index by searching backward until the packet with
-      // the `frame_begin` flag is set.
+      // For H.264 the start index is found by searching backward, see below.
       int start_index = index;
       size_t tested_packets = 0;
       int64_t frame_timestamp = buffer_[start_index]->timestamp;
@@ -242,40 +252,39 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       bool is_h264_keyframe = false;
       int idr_width = -1;
       int idr_height = -1;
-      while (true) {
+      // Other codecs set the `frame_begin` flag, so the start of the frame is
+      // already known.
+      if (!is_h264)
+        start_seq_num = packet.frame_start_seq_num;
+      while (is_h264) {
         ++tested_packets;
 
-        if (!is_h264 && buffer_[start_index]->is_first_packet_in_frame())
-          break;
+        const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
+            &buffer_[start_index]->video_header.video_type_header);
+        if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
+          return found_frames;
 
-        if (is_h264) {
-          const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
-              &buffer_[start_index]->video_header.video_type_header);
-          if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
-            return found_frames;
-
-          for (size_t j = 0; j < h264_header->nalus_length; ++j) {
-            if (h264_header->nalus[j].type == H264::NaluType::kSps) {
-              has_h264_sps = true;
-            } else if (h264_header->nalus[j].type == H264::NaluType::kPps) {
-              has_h264_pps = true;
-            } else if (h264_header->nalus[j].type == H264::NaluType::kIdr) {
-              has_h264_idr = true;
-            }
+        for (size_t j = 0; j < h264_header->nalus_length; ++j) {
+          if (h264_header->nalus[j].type == H264::NaluType::kSps) {
+            has_h264_sps = true;
+          } else if (h264_header->nalus[j].type == H264::NaluType::kPps) {
+            has_h264_pps = true;
+          } else if (h264_header->nalus[j].type == H264::NaluType::kIdr) {
+            has_h264_idr = true;
           }
-          if ((sps_pps_idr_is_h264_keyframe_ && has_h264_idr && has_h264_sps &&
-               has_h264_pps) ||
-              (!sps_pps_idr_is_h264_keyframe_ && has_h264_idr)) {
-            is_h264_keyframe = true;
-            // Store the resolution of key frame which is the packet with
-            // smallest index and valid resolution; typically its IDR or SPS
-            // packet; there may be packet preceeding this packet, IDR's
-            // resolution will be applied to them.
-            if (buffer_[start_index]->width() > 0 &&
-                buffer_[start_index]->height() > 0) {
-              idr_width = buffer_[start_index]->width();
-              idr_height = buffer_[start_index]->height();
-            }
+        }
+        if ((sps_pps_idr_is_h264_keyframe_ && has_h264_idr && has_h264_sps &&
+             has_h264_pps) ||
+            (!sps_pps_idr_is_h264_keyframe_ && has_h264_idr)) {
+          is_h264_keyframe = true;
+          // Store the resolution of key frame which is the packet with
+          // smallest index and valid resolution; typically its IDR or SPS
+          // packet; there may be packet preceeding this packet, IDR's
+          // resolution will be applied to them.
+          if (buffer_[start_index]->width() > 0 &&
+              buffer_[start_index]->height() > 0) {
+            idr_width = buffer_[start_index]->width();
+            idr_height = buffer_[start_index]->height();
           }
         }
 
@@ -290,8 +299,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // the timestamp of that packet is the same as this one. This may cause
         // the PacketBuffer to hand out incomplete frames.
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
-        if (is_h264 && (buffer_[start_index] == nullptr ||
-                        buffer_[start_index]->timestamp != frame_timestamp)) {
+        if (buffer_[start_index] == nullptr ||
+            buffer_[start_index]->timestamp != frame_timestamp) {
           break;
         }
 
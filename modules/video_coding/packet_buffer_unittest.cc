@@ -220,6 +220,24 @@ TEST_F(PacketBufferTest, SingleFrameExpandsBuffer) {
               StartSeqNumsAre(seq_num));
 }
 
+TEST_F(PacketBufferTest, ReorderedFrameExpandsBuffer) {
+  const uint16_t seq_num = Rand();
+  const int kNumPackets = kMaxSize - 1;
+
+  // The first packet arrives last, after the buffer has been expanded twice.
+  for (int i = kNumPackets - 1; i > 0; --i) {
+    EXPECT_THAT(Insert(seq_num + i, kKeyFrame, kNotFirst,
+                       i == kNumPackets - 1 ? kLast : kNotLast)
+                    .packets,
+                IsEmpty());
+  }
+  auto packets = Insert(seq_num, kKeyFrame, kFirst, kNotLast).packets;
+  ASSERT_THAT(packets, SizeIs(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i)
+    EXPECT_EQ(packets[i]->seq_num, static_cast<uint16_t>(seq_num + i));
+  EXPECT_THAT(StartSeqNums(packets), ElementsAre(seq_num));
+}
+
 TEST_F(PacketBufferTest, ExpandBufferOverflow) {
   const uint16_t seq_num = Rand();
 
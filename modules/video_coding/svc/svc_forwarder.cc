@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/svc/svc_forwarder.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Dropped packets older than this, relative to the newest packet, are only
+// counted. Reordered packets that are forwarded are assumed to be newer.
+constexpr int64_t kMaxReorderingDistance = 1 << 13;
+
+}  // namespace
+
+SvcForwarder::SvcForwarder() = default;
+SvcForwarder::~SvcForwarder() = default;
+
+void SvcForwarder::SetDecodeTarget(int decode_target) {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  requested_decode_target_ = decode_target;
+}
+
+void SvcForwarder::SetStructure(const FrameDependencyStructure& structure) {
+  structure_ = std::make_unique<FrameDependencyStructure>(structure);
+  max_spatial_ids_.assign(structure.num_decode_targets, 0);
+  for (const FrameDependencyTemplate& frame_template : structure.templates) {
+    for (size_t dt = 0; dt < frame_template.decode_target_indications.size() &&
+                        dt < max_spatial_ids_.size();
+         ++dt) {
+      if (frame_template.decode_target_indications[dt] !=
+          DecodeTargetIndication::kNotPresent) {
+        max_spatial_ids_[dt] =
+            std::max(max_spatial_ids_[dt], frame_template.spatial_id);
+      }
+    }
+  }
+  // Decode targets may have changed meaning, select one again.
+  decode_target_ = absl::nullopt;
+}
+
+SvcForwarder::Result SvcForwarder::OnRtpPacket(
+    uint16_t sequence_number,
+    bool marker,
+    const DependencyDescriptor& descriptor) {
+  if (descriptor.attached_structure != nullptr &&
+      (structure_ == nullptr ||
+       !(*descriptor.attached_structure == *structure_))) {
+    SetStructure(*descriptor.attached_structure);
+  }
+
+  const auto& dtis = descriptor.frame_dependencies.decode_target_indications;
+  if (structure_ != nullptr && descriptor.first_packet_in_frame &&
+      static_cast<int>(dtis.size()) == structure_->num_decode_targets) {
+    int target = std::min(
+        requested_decode_target_.value_or(structure_->num_decode_targets - 1),
+        structure_->num_decode_targets - 1);
+    if (target != decode_target_ &&
+        dtis[target] == DecodeTargetIndication::kSwitch) {
+      decode_target_ = target;
+    }
+  }
+
+  Result result;
+  result.forward = decode_target_.has_value() &&
+                   *decode_target_ < static_cast<int>(dtis.size()) &&
+                   dtis[*decode_target_] != DecodeTargetIndication::kNotPresent;
+
+  int64_t unwrapped = sequence_number_unwrapper_.Unwrap(sequence_number);
+  const bool newest =
+      !highest_sequence_number_ || unwrapped > *highest_sequence_number_;
+  if (newest) {
+    highest_sequence_number_ = unwrapped;
+    while (!dropped_sequence_numbers_.empty() &&
+           dropped_sequence_numbers_.front() <
+               unwrapped - kMaxReorderingDistance) {
+      dropped_sequence_numbers_.pop_front();
+      ++num_dropped_before_;
+    }
+  }
+
+  if (!result.forward) {
+    // A reordered packet that is dropped already left a gap in the forwarded
+    // sequence numbers, which can't be closed any more.
+    if (newest)
+      dropped_sequence_numbers_.push_back(unwrapped);
+    return result;
+  }
+
+  result.sequence_number =
+      static_cast<uint16_t>(unwrapped - NumDroppedBefore(unwrapped));
+  // The packets of the higher spatial layers that would end the temporal
+  // unit may be dropped.
+  result.marker = marker || (descriptor.last_packet_in_frame &&
+                             descriptor.frame_dependencies.spatial_id >=
+                                 max_spatial_ids_[*decode_target_]);
+  return result;
+}
+
+int64_t SvcForwarder::NumDroppedBefore(
+    int64_t unwrapped_sequence_number) const {
+  return num_dropped_before_ +
+         (std::lower_bound(dropped_sequence_numbers_.begin(),
+                           dropped_sequence_numbers_.end(),
+                           unwrapped_sequence_number) -
+          dropped_sequence_numbers_.begin());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SVC_SVC_FORWARDER_H_
+#define MODULES_VIDEO_CODING_SVC_SVC_FORWARDER_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// Decides for an SFU which RTP packets of a video stream with the dependency
+// descriptor to forward to a receiver that decodes a single decode target,
+// using only the dependency descriptor, and rewrites the sequence numbers of
+// the forwarded packets so that the dropped packets don't look lost.
+// Frame numbers in the dependency descriptor aren't rewritten: receivers
+// expect gaps in them when decode targets are dropped.
+// One instance is used per receiver and stream.
+class SvcForwarder {
+ public:
+  struct Result {
+    bool forward = false;
+    // Set when the packet is forwarded.
+    uint16_t sequence_number = 0;
+    // Marks the last forwarded packet of a temporal unit.
+    bool marker = false;
+  };
+
+  SvcForwarder();
+  SvcForwarder(const SvcForwarder&) = delete;
+  SvcForwarder& operator=(const SvcForwarder&) = delete;
+  ~SvcForwarder();
+
+  // Requests to forward `decode_target`. The forwarder switches to it at the
+  // next frame that is a switch point for it, e.g. a key frame. By default
+  // the highest decode target is forwarded.
+  void SetDecodeTarget(int decode_target);
+
+  // Decode target currently forwarded, if any.
+  absl::optional<int> decode_target() const { return decode_target_; }
+
+  // Structure to parse the dependency descriptors of the following packets
+  // with, nullptr until a packet with an attached structure is received.
+  const FrameDependencyStructure* structure() const { return structure_.get(); }
+
+  // Decides for a packet of the stream with the given dependency descriptor.
+  // The decision costs O(1), except when a new structure is attached.
+  Result OnRtpPacket(uint16_t sequence_number,
+                     bool marker,
+                     const DependencyDescriptor& descriptor);
+
+ private:
+  void SetStructure(const FrameDependencyStructure& structure);
+  // Returns the number of dropped packets with a lower sequence number.
+  int64_t NumDroppedBefore(int64_t unwrapped_sequence_number) const;
+
+  std::unique_ptr<FrameDependencyStructure> structure_;
+  // Highest spatial id of the frames of each decode target.
+  absl::InlinedVector<int, 10> max_spatial_ids_;
+  absl::optional<int> requested_decode_target_;
+  absl::optional<int> decode_target_;
+
+  SeqNumUnwrapper<uint16_t> sequence_number_unwrapper_;
+  absl::optional<int64_t> highest_sequence_number_;
+  // Sequence numbers of the recently dropped packets, in increasing order.
+  std::deque<int64_t> dropped_sequence_numbers_;
+  // Number of dropped packets before `dropped_sequence_numbers_`.
+  int64_t num_dropped_before_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SVC_SVC_FORWARDER_H_
@@ -0,0 +1,212 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/svc/svc_forwarder.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "modules/video_coding/svc/create_scalability_structure.h"
+#include "modules/video_coding/svc/scalability_structure_test_helpers.h"
+#include "modules/video_coding/svc/scalable_video_controller.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::IsEmpty;
+
+constexpr int kPacketsPerFrame = 2;
+
+struct Packet {
+  uint16_t sequence_number;
+  bool marker;
+  DependencyDescriptor descriptor;
+};
+
+// Packetizes the frames of a scalability structure into `kPacketsPerFrame`
+// packets each, starting with a key frame that carries the structure.
+class PacketGenerator {
+ public:
+  explicit PacketGenerator(absl::string_view scalability_mode,
+                           uint16_t first_sequence_number = 0)
+      : structure_(CreateScalabilityStructure(scalability_mode)),
+        wrapper_(*structure_),
+        sequence_number_(first_sequence_number) {}
+
+  std::vector<Packet> Generate(int num_temporal_units) {
+    std::vector<GenericFrameInfo> frames =
+        wrapper_.GenerateFrames(num_temporal_units);
+    std::vector<Packet> packets;
+    for (size_t i = 0; i < frames.size(); ++i) {
+      bool end_of_temporal_unit = i + 1 == frames.size() ||
+                                  frames[i + 1].spatial_id <=
+                                      frames[i].spatial_id;
+      for (int p = 0; p < kPacketsPerFrame; ++p) {
+        Packet packet;
+        packet.sequence_number = sequence_number_++;
+        packet.descriptor.first_packet_in_frame = p == 0;
+        packet.descriptor.last_packet_in_frame = p == kPacketsPerFrame - 1;
+        packet.descriptor.frame_number = frame_number_ & 0xFFFF;
+        packet.descriptor.frame_dependencies = frames[i];
+        packet.marker =
+            packet.descriptor.last_packet_in_frame && end_of_temporal_unit;
+        if (!structure_sent_) {
+          packet.descriptor.attached_structure =
+              std::make_unique<FrameDependencyStructure>(
+                  structure_->DependencyStructure());
+          structure_sent_ = true;
+        }
+        packets.push_back(std::move(packet));
+      }
+      ++frame_number_;
+    }
+    return packets;
+  }
+
+ private:
+  std::unique_ptr<ScalableVideoController> structure_;
+  ScalabilityStructureWrapper wrapper_;
+  uint16_t sequence_number_;
+  int frame_number_ = 0;
+  bool structure_sent_ = false;
+};
+
+struct Forwarded {
+  uint16_t sequence_number;
+  bool marker;
+  int spatial_id;
+  int temporal_id;
+};
+
+std::vector<Forwarded> Forward(SvcForwarder& forwarder,
+                               const std::vector<Packet>& packets) {
+  std::vector<Forwarded> forwarded;
+  for (const Packet& packet : packets) {
+    SvcForwarder::Result result = forwarder.OnRtpPacket(
+        packet.sequence_number, packet.marker, packet.descriptor);
+    if (result.forward) {
+      forwarded.push_back({result.sequence_number, result.marker,
+                           packet.descriptor.frame_dependencies.spatial_id,
+                           packet.descriptor.frame_dependencies.temporal_id});
+    }
+  }
+  return forwarded;
+}
+
+std::vector<uint16_t> SequenceNumbers(const std::vector<Forwarded>& packets) {
+  std::vector<uint16_t> sequence_numbers;
+  for (const Forwarded& packet : packets)
+    sequence_numbers.push_back(packet.sequence_number);
+  return sequence_numbers;
+}
+
+TEST(SvcForwarderTest, DropsPacketsUntilStructureIsReceived) {
+  PacketGenerator generator("L1T3");
+  std::vector<Packet> packets = generator.Generate(2);
+  packets[0].descriptor.attached_structure = nullptr;
+  SvcForwarder forwarder;
+
+  EXPECT_THAT(Forward(forwarder, packets), IsEmpty());
+  EXPECT_EQ(forwarder.structure(), nullptr);
+  EXPECT_EQ(forwarder.decode_target(), absl::nullopt);
+}
+
+TEST(SvcForwarderTest, ForwardsAllPacketsOfHighestDecodeTargetByDefault) {
+  PacketGenerator generator("L1T3");
+  SvcForwarder forwarder;
+
+  std::vector<Forwarded> forwarded = Forward(forwarder, generator.Generate(4));
+
+  EXPECT_EQ(forwarder.decode_target(), 2);
+  EXPECT_THAT(SequenceNumbers(forwarded),
+              ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
+  for (size_t i = 0; i < forwarded.size(); ++i)
+    EXPECT_EQ(forwarded[i].marker, i % kPacketsPerFrame == 1);
+  EXPECT_NE(forwarder.structure(), nullptr);
+}
+
+TEST(SvcForwarderTest, ForwardsLowestTemporalLayerWithConsecutiveNumbers) {
+  PacketGenerator generator("L1T3");
+  SvcForwarder forwarder;
+  forwarder.SetDecodeTarget(0);
+
+  // Temporal pattern T0 T2 T1 T2 T0 T2 T1 T2.
+  std::vector<Forwarded> forwarded = Forward(forwarder, generator.Generate(8));
+
+  EXPECT_EQ(forwarder.decode_target(), 0);
+  EXPECT_THAT(forwarded, Each(Field(&Forwarded::temporal_id, 0)));
+  EXPECT_THAT(SequenceNumbers(forwarded), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(SvcForwarderTest, SwitchesDecodeTargetAtSwitchPoint) {
+  PacketGenerator generator("L1T3");
+  SvcForwarder forwarder;
+  Forward(forwarder, generator.Generate(3));
+  ASSERT_EQ(forwarder.decode_target(), 2);
+
+  forwarder.SetDecodeTarget(0);
+  // The T2 frame isn't a switch point for the lowest decode target, so it is
+  // still forwarded.
+  std::vector<Forwarded> forwarded = Forward(forwarder, generator.Generate(1));
+  EXPECT_EQ(forwarder.decode_target(), 2);
+  EXPECT_THAT(forwarded, ElementsAre(Field(&Forwarded::temporal_id, 2),
+                                     Field(&Forwarded::temporal_id, 2)));
+
+  forwarded = Forward(forwarder, generator.Generate(4));
+  EXPECT_EQ(forwarder.decode_target(), 0);
+  EXPECT_THAT(forwarded, Each(Field(&Forwarded::temporal_id, 0)));
+  EXPECT_THAT(SequenceNumbers(forwarded), ElementsAre(8, 9));
+}
+
+TEST(SvcForwarderTest, SetsMarkerOnLastForwardedSpatialLayer) {
+  PacketGenerator generator("L2T1");
+  SvcForwarder forwarder;
+  forwarder.SetDecodeTarget(0);
+
+  std::vector<Forwarded> forwarded = Forward(forwarder, generator.Generate(2));
+
+  EXPECT_THAT(forwarded, Each(Field(&Forwarded::spatial_id, 0)));
+  EXPECT_THAT(SequenceNumbers(forwarded), ElementsAre(0, 1, 2, 3));
+  ASSERT_EQ(forwarded.size(), 4u);
+  EXPECT_FALSE(forwarded[0].marker);
+  EXPECT_TRUE(forwarded[1].marker);
+  EXPECT_FALSE(forwarded[2].marker);
+  EXPECT_TRUE(forwarded[3].marker);
+}
+
+TEST(SvcForwarderTest, RewritesSequenceNumbersOfReorderedPackets) {
+  PacketGenerator generator("L1T3", /*first_sequence_number=*/0xFFFC);
+  SvcForwarder forwarder;
+  forwarder.SetDecodeTarget(0);
+  // Sequence numbers 0xFFFC to 0x0005, with the T0 frames in packets 0xFFFC,
+  // 0xFFFD, 0x0004 and 0x0005.
+  std::vector<Packet> packets = generator.Generate(5);
+  ASSERT_EQ(packets.size(), 10u);
+  std::vector<Packet> reordered;
+  for (int i : {0, 2, 1, 3, 4, 5, 6, 7, 9, 8})
+    reordered.push_back(std::move(packets[i]));
+
+  EXPECT_THAT(SequenceNumbers(Forward(forwarder, reordered)),
+              ElementsAre(0xFFFC, 0xFFFD, 0xFFFF, 0xFFFE));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -12,6 +12,8 @@
 
 #include <stdlib.h>
 
+#include <utility>
+
 #include "modules/include/module_common_types_public.h"
 
 namespace webrtc {
@@ -24,9 +26,9 @@ VCMTimestampMap::VCMTimestampMap(size_t capacity)
 
 VCMTimestampMap::~VCMTimestampMap() {}
 
-void VCMTimestampMap::Add(uint32_t timestamp, const VCMFrameInformation& data) {
+void VCMTimestampMap::Add(uint32_t timestamp, VCMFrameInformation data) {
   ring_buffer_[next_add_idx_].timestamp = timestamp;
-  ring_buffer_[next_add_idx_].data = data;
+  ring_buffer_[next_add_idx_].data = std::move(data);
   next_add_idx_ = (next_add_idx_ + 1) % capacity_;
 
   if (next_add_idx_ == next_pop_idx_) {
@@ -38,8 +40,9 @@ void VCMTimestampMap::Add(uint32_t timestamp, const VCMFrameInformation& data) {
 absl::optional<VCMFrameInformation> VCMTimestampMap::Pop(uint32_t timestamp) {
   while (!IsEmpty()) {
     if (ring_buffer_[next_pop_idx_].timestamp == timestamp) {
-      // Found start time for this timestamp.
-      const VCMFrameInformation& data = ring_buffer_[next_pop_idx_].data;
+      // Found start time for this timestamp. The entry is moved out, so that
+      // e.g. the packet infos aren't copied under the caller's lock.
+      VCMFrameInformation data = std::move(ring_buffer_[next_pop_idx_].data);
       ring_buffer_[next_pop_idx_].timestamp = 0;
       next_pop_idx_ = (next_pop_idx_ + 1) % capacity_;
       return data;
@@ -40,7 +40,9 @@ class VCMTimestampMap {
   explicit VCMTimestampMap(size_t capacity);
   ~VCMTimestampMap();
 
-  void Add(uint32_t timestamp, const VCMFrameInformation& data);
+  void Add(uint32_t timestamp, VCMFrameInformation data);
+  // Returns the frame information for `timestamp`, moved out of the map, and
+  // forgets all older entries.
   absl::optional<VCMFrameInformation> Pop(uint32_t timestamp);
   size_t Size() const;
   void Clear();
@@ -10,6 +10,8 @@
 
 #include "modules/video_coding/timestamp_map.h"
 
+#include <utility>
+
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -117,5 +119,20 @@ TEST_F(VcmTimestampMapTest, LastAddedIsDiscardedIfMapGetsFull) {
   EXPECT_EQ(_timestampMap.Size(), 0u);
 }
 
+TEST_F(VcmTimestampMapTest, PopReturnsPacketInfosOfFrame) {
+  VCMFrameInformation frame_info({kRenderTime5});
+  frame_info.packet_infos = RtpPacketInfos({RtpPacketInfo(
+      /*ssrc=*/123, /*csrcs=*/{}, /*rtp_timestamp=*/kTimestamp5,
+      /*audio_level=*/absl::nullopt, /*absolute_capture_time=*/absl::nullopt,
+      /*receive_time=*/Timestamp::Millis(kRenderTime5))});
+  _timestampMap.Add(kTimestamp5, std::move(frame_info));
+
+  absl::optional<VCMFrameInformation> popped = _timestampMap.Pop(kTimestamp5);
+  ASSERT_TRUE(popped);
+  EXPECT_EQ(popped->renderTimeMs, kRenderTime5);
+  ASSERT_EQ(popped->packet_infos.size(), 1u);
+  EXPECT_EQ(popped->packet_infos[0].ssrc(), 123u);
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
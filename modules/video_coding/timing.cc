@@ -45,6 +45,8 @@ VCMTiming::VCMTiming(Clock* clock)
                   field_trial::FindFullName("WebRTC-LowLatencyRenderer"));
   ParseFieldTrial({&zero_playout_delay_min_pacing_},
                   field_trial::FindFullName("WebRTC-ZeroPlayoutDelay"));
+  MutexLock lock(&mutex_);
+  PublishSnapshot();
 }
 
 void VCMTiming::Reset() {
@@ -56,31 +58,33 @@ void VCMTiming::Reset() {
   jitter_delay_ = TimeDelta::Zero();
   current_delay_ = TimeDelta::Zero();
   prev_frame_timestamp_ = 0;
+  PublishSnapshot();
 }
 
 void VCMTiming::set_render_delay(TimeDelta render_delay) {
   MutexLock lock(&mutex_);
   render_delay_ = render_delay;
+  PublishSnapshot();
 }
 
 void VCMTiming::set_min_playout_delay(TimeDelta min_playout_delay) {
   MutexLock lock(&mutex_);
   min_playout_delay_ = min_playout_delay;
+  PublishSnapshot();
 }
 
 TimeDelta VCMTiming::min_playout_delay() {
-  MutexLock lock(&mutex_);
-  return min_playout_delay_;
+  return snapshot_.Load().min_playout_delay;
 }
 
 void VCMTiming::set_max_playout_delay(TimeDelta max_playout_delay) {
   MutexLock lock(&mutex_);
   max_playout_delay_ = max_playout_delay;
+  PublishSnapshot();
 }
 
 TimeDelta VCMTiming::max_playout_delay() {
-  MutexLock lock(&mutex_);
-  return max_playout_delay_;
+  return snapshot_.Load().max_playout_delay;
 }
 
 void VCMTiming::SetJitterDelay(TimeDelta jitter_delay) {
@@ -91,6 +95,7 @@ void VCMTiming::SetJitterDelay(TimeDelta jitter_delay) {
     if (current_delay_.IsZero()) {
       current_delay_ = jitter_delay_;
     }
+    PublishSnapshot();
   }
 }
 
@@ -133,6 +138,7 @@ void VCMTiming::UpdateCurrentDelay(uint32_t frame_timestamp) {
     current_delay_ = current_delay_ + delay_diff;
   }
   prev_frame_timestamp_ = frame_timestamp;
+  PublishSnapshot();
 }
 
 void VCMTiming::UpdateCurrentDelay(Timestamp render_time,
@@ -149,6 +155,7 @@ void VCMTiming::UpdateCurrentDelay(Timestamp render_time,
   } else {
     current_delay_ = target_delay;
   }
+  PublishSnapshot();
 }
 
 void VCMTiming::StopDecodeTimer(TimeDelta decode_time, Timestamp now) {
@@ -156,6 +163,7 @@ void VCMTiming::StopDecodeTimer(TimeDelta decode_time, Timestamp now) {
   codec_timer_->AddTiming(decode_time.ms(), now.ms());
   RTC_DCHECK_GE(decode_time, TimeDelta::Zero());
   ++num_decoded_frames_;
+  PublishSnapshot();
 }
 
 void VCMTiming::IncomingTimestamp(uint32_t rtp_timestamp, Timestamp now) {
@@ -229,8 +237,7 @@ TimeDelta VCMTiming::MaxWaitingTime(Timestamp render_time,
 }
 
 TimeDelta VCMTiming::TargetVideoDelay() const {
-  MutexLock lock(&mutex_);
-  return TargetDelayInternal();
+  return snapshot_.Load().target_delay;
 }
 
 TimeDelta VCMTiming::TargetDelayInternal() const {
@@ -244,14 +251,14 @@ bool VCMTiming::GetTimings(TimeDelta* max_decode,
                            TimeDelta* jitter_buffer,
                            TimeDelta* min_playout_delay,
                            TimeDelta* render_delay) const {
-  MutexLock lock(&mutex_);
-  *max_decode = RequiredDecodeTime();
-  *current_delay = current_delay_;
-  *target_delay = TargetDelayInternal();
-  *jitter_buffer = jitter_delay_;
-  *min_playout_delay = min_playout_delay_;
-  *render_delay = render_delay_;
-  return (num_decoded_frames_ > 0);
+  Snapshot snapshot = snapshot_.Load();
+  *max_decode = snapshot.max_decode;
+  *current_delay = snapshot.current_delay;
+  *target_delay = snapshot.target_delay;
+  *jitter_buffer = snapshot.jitter_delay;
+  *min_playout_delay = snapshot.min_playout_delay;
+  *render_delay = snapshot.render_delay;
+  return snapshot.has_decoded_frames;
 }
 
 void VCMTiming::SetTimingFrameInfo(const TimingFrameInfo& info) {
@@ -268,11 +275,31 @@ void VCMTiming::SetMaxCompositionDelayInFrames(
     absl::optional<int> max_composition_delay_in_frames) {
   MutexLock lock(&mutex_);
   max_composition_delay_in_frames_ = max_composition_delay_in_frames;
+  PublishSnapshot();
 }
 
 absl::optional<int> VCMTiming::MaxCompositionDelayInFrames() const {
-  MutexLock lock(&mutex_);
-  return max_composition_delay_in_frames_;
+  Snapshot snapshot = snapshot_.Load();
+  if (!snapshot.has_max_composition_delay_in_frames)
+    return absl::nullopt;
+  return snapshot.max_composition_delay_in_frames;
+}
+
+void VCMTiming::PublishSnapshot() {
+  Snapshot snapshot;
+  snapshot.max_decode = RequiredDecodeTime();
+  snapshot.current_delay = current_delay_;
+  snapshot.target_delay = TargetDelayInternal();
+  snapshot.jitter_delay = jitter_delay_;
+  snapshot.min_playout_delay = min_playout_delay_;
+  snapshot.max_playout_delay = max_playout_delay_;
+  snapshot.render_delay = render_delay_;
+  snapshot.has_decoded_frames = num_decoded_frames_ > 0;
+  snapshot.has_max_composition_delay_in_frames =
+      max_composition_delay_in_frames_.has_value();
+  snapshot.max_composition_delay_in_frames =
+      max_composition_delay_in_frames_.value_or(0);
+  snapshot_.Store(snapshot);
 }
 
 }  // namespace webrtc
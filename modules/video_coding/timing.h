@@ -19,6 +19,7 @@
 #include "modules/video_coding/codec_timer.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/synchronization/seqlock.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time/timestamp_extrapolator.h"
 
@@ -118,6 +119,24 @@ class VCMTiming {
   TimeDelta TargetDelayInternal() const RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
  private:
+  // The delays that are read once or more per frame, on the decode and stats
+  // threads, and change less often than they are read. They are published
+  // whenever they may have changed, so that readers don't take `mutex_`.
+  struct Snapshot {
+    TimeDelta max_decode = TimeDelta::Zero();
+    TimeDelta current_delay = TimeDelta::Zero();
+    TimeDelta target_delay = TimeDelta::Zero();
+    TimeDelta jitter_delay = TimeDelta::Zero();
+    TimeDelta min_playout_delay = TimeDelta::Zero();
+    TimeDelta max_playout_delay = TimeDelta::Zero();
+    TimeDelta render_delay = TimeDelta::Zero();
+    bool has_decoded_frames = false;
+    bool has_max_composition_delay_in_frames = false;
+    int max_composition_delay_in_frames = 0;
+  };
+
+  void PublishSnapshot() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   mutable Mutex mutex_;
   Clock* const clock_;
   const std::unique_ptr<TimestampExtrapolator> ts_extrapolator_
@@ -152,6 +171,8 @@ class VCMTiming {
   // Used only when the RTP header extension playout delay is set to min=0 ms
   // which is indicated by a render time set to 0.
   Timestamp last_decode_scheduled_ RTC_GUARDED_BY(mutex_);
+  // Stored with `mutex_` held.
+  SeqLock<Snapshot> snapshot_;
 };
 }  // namespace webrtc
 
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_speed_controller.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr float kFilterAlpha = 0.9f;
+
+}  // namespace
+
+// static
+absl::optional<EncoderSpeedController::Config>
+EncoderSpeedController::Config::Parse(absl::string_view field_trial,
+                                      int low_qp) {
+  Config config;
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<double> low_utilization("low_utilization",
+                                              config.low_utilization);
+  FieldTrialParameter<double> high_utilization("high_utilization",
+                                               config.high_utilization);
+  FieldTrialParameter<int> low_qp_param("low_qp", low_qp);
+  FieldTrialParameter<int> min_frames("min_frames",
+                                      config.min_frames_between_changes);
+  FieldTrialParameter<int> max_speed_up("max_speed_up", config.max_speed_up);
+  FieldTrialParameter<int> max_slow_down("max_slow_down",
+                                         config.max_slow_down);
+  ParseFieldTrial({&enabled, &low_utilization, &high_utilization,
+                   &low_qp_param, &min_frames, &max_speed_up, &max_slow_down},
+                  field_trial);
+  if (!enabled)
+    return absl::nullopt;
+
+  if (low_utilization.Get() <= 0 ||
+      low_utilization.Get() >= high_utilization.Get() ||
+      min_frames.Get() <= 0 || max_speed_up.Get() < 0 ||
+      max_slow_down.Get() < 0) {
+    RTC_LOG(LS_WARNING) << "Invalid " << kFieldTrialName << " parameters.";
+    return absl::nullopt;
+  }
+  config.low_utilization = low_utilization.Get();
+  config.high_utilization = high_utilization.Get();
+  config.low_qp = low_qp_param.Get();
+  config.min_frames_between_changes = min_frames.Get();
+  config.max_speed_up = max_speed_up.Get();
+  config.max_slow_down = max_slow_down.Get();
+  return config;
+}
+
+EncoderSpeedController::EncoderSpeedController(const Config& config)
+    : config_(config), utilization_(kFilterAlpha), qp_(kFilterAlpha) {
+  RTC_DCHECK_LT(config_.low_utilization, config_.high_utilization);
+  RTC_DCHECK_GT(config_.min_frames_between_changes, 0);
+}
+
+bool EncoderSpeedController::OnFrameEncoded(TimeDelta encode_time,
+                                            TimeDelta frame_interval,
+                                            int qp) {
+  if (frame_interval <= TimeDelta::Zero())
+    return false;
+  utilization_.Apply(1.0f, encode_time / frame_interval);
+  if (qp >= 0)
+    qp_.Apply(1.0f, qp);
+
+  if (++frames_since_change_ < config_.min_frames_between_changes)
+    return false;
+
+  const float utilization = utilization_.filtered();
+  if (utilization > config_.high_utilization &&
+      speed_offset_ < config_.max_speed_up) {
+    ++speed_offset_;
+  } else if (utilization < config_.low_utilization &&
+             speed_offset_ > -config_.max_slow_down &&
+             (qp_.filtered() == rtc::ExpFilter::kValueUndefined ||
+              qp_.filtered() > config_.low_qp)) {
+    --speed_offset_;
+  } else {
+    return false;
+  }
+
+  RTC_LOG(LS_INFO) << "Encoding takes " << utilization
+                   << " of the frame interval, speed offset changed to "
+                   << speed_offset_;
+  ++num_changes_;
+  // Measurements at the previous speed setting no longer apply.
+  frames_since_change_ = 0;
+  ResetFilters();
+  return true;
+}
+
+void EncoderSpeedController::ResetFilters() {
+  utilization_.Reset(kFilterAlpha);
+  qp_.Reset(kFilterAlpha);
+}
+
+}  // namespace webrtc
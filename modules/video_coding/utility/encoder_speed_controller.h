@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ENCODER_SPEED_CONTROLLER_H_
+#define MODULES_VIDEO_CODING_UTILITY_ENCODER_SPEED_CONTROLLER_H_
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/numerics/exp_filter.h"
+
+namespace webrtc {
+
+// Adjusts the speed setting of a software encoder to the time it takes to
+// encode frames, so that it encodes at as high quality as the CPU allows
+// without falling behind the frame rate. The static speed settings of an
+// encoder, based on resolution and number of cores, are the starting point,
+// and the controller decides on an offset to them.
+//
+// When encoding takes more than `high_utilization` of the frame interval,
+// the encoder is sped up one step. When it takes less than `low_utilization`
+// and the QP is above `low_qp`, it is slowed down one step. With a QP below
+// `low_qp` the frames already are of high quality, so that a slower setting
+// wouldn't make a visible difference.
+class EncoderSpeedController {
+ public:
+  static constexpr char kFieldTrialName[] = "WebRTC-Video-EncoderSpeedControl";
+
+  struct Config {
+    // Parses the group of the `kFieldTrialName` field trial, e.g.
+    // "Enabled,low_utilization:0.3,high_utilization:0.7". Returns nullopt if
+    // the controller isn't enabled. `low_qp` is on the QP scale of the codec.
+    static absl::optional<Config> Parse(absl::string_view field_trial,
+                                        int low_qp);
+
+    // Fractions of the frame interval.
+    double low_utilization = 0.4;
+    double high_utilization = 0.8;
+    int low_qp = 0;
+    // Frames to encode with a speed setting before changing it again.
+    int min_frames_between_changes = 30;
+    // Bounds of the offset, in speed steps.
+    int max_speed_up = 4;
+    int max_slow_down = 2;
+  };
+
+  explicit EncoderSpeedController(const Config& config);
+
+  // Called for every encoded frame, with the time the encoder took for it,
+  // the interval between frames at the current frame rate and the QP of the
+  // frame, or -1 if unknown. Returns true if the speed offset changed.
+  bool OnFrameEncoded(TimeDelta encode_time, TimeDelta frame_interval, int qp);
+
+  // Offset to the speed setting of the encoder, in steps. Positive values
+  // mean faster encoding at lower quality.
+  int speed_offset() const { return speed_offset_; }
+  // Number of times the speed offset has changed.
+  int num_changes() const { return num_changes_; }
+
+ private:
+  void ResetFilters();
+
+  const Config config_;
+  rtc::ExpFilter utilization_;
+  rtc::ExpFilter qp_;
+  int frames_since_change_ = 0;
+  int speed_offset_ = 0;
+  int num_changes_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ENCODER_SPEED_CONTROLLER_H_
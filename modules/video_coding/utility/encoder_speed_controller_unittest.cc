@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encoder_speed_controller.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kFrameInterval = TimeDelta::Millis(33);
+constexpr int kLowQp = 30;
+
+EncoderSpeedController::Config TestConfig() {
+  EncoderSpeedController::Config config;
+  config.low_qp = kLowQp;
+  config.min_frames_between_changes = 10;
+  config.max_speed_up = 2;
+  config.max_slow_down = 1;
+  return config;
+}
+
+// Encodes frames until the speed offset changes, or `max_frames` frames.
+int FramesUntilChange(EncoderSpeedController& controller,
+                      double utilization,
+                      int qp,
+                      int max_frames = 100) {
+  for (int i = 1; i <= max_frames; ++i) {
+    if (controller.OnFrameEncoded(kFrameInterval * utilization,
+                                  kFrameInterval, qp)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+TEST(EncoderSpeedControllerTest, KeepsSpeedWithinUtilizationBounds) {
+  EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(FramesUntilChange(controller, 0.6, kLowQp + 10), -1);
+  EXPECT_EQ(controller.speed_offset(), 0);
+  EXPECT_EQ(controller.num_changes(), 0);
+}
+
+TEST(EncoderSpeedControllerTest, SpeedsUpWhenEncodingTakesTooLong) {
+  EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(FramesUntilChange(controller, 0.9, kLowQp + 10), 10);
+  EXPECT_EQ(controller.speed_offset(), 1);
+  EXPECT_EQ(FramesUntilChange(controller, 0.9, kLowQp + 10), 10);
+  EXPECT_EQ(controller.speed_offset(), 2);
+  // Capped at `max_speed_up`.
+  EXPECT_EQ(FramesUntilChange(controller, 0.9, kLowQp + 10), -1);
+  EXPECT_EQ(controller.speed_offset(), 2);
+  EXPECT_EQ(controller.num_changes(), 2);
+}
+
+TEST(EncoderSpeedControllerTest, SlowsDownWhenThereIsTimeToSpare) {
+  EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(FramesUntilChange(controller, 0.2, kLowQp + 10), 10);
+  EXPECT_EQ(controller.speed_offset(), -1);
+  // Capped at `max_slow_down`.
+  EXPECT_EQ(FramesUntilChange(controller, 0.2, kLowQp + 10), -1);
+  EXPECT_EQ(controller.speed_offset(), -1);
+}
+
+TEST(EncoderSpeedControllerTest, DoesNotSlowDownWhenQpIsLow) {
+  EncoderSpeedController controller(TestConfig());
+  EXPECT_EQ(FramesUntilChange(controller, 0.2, kLowQp - 10), -1);
+  EXPECT_EQ(controller.speed_offset(), 0);
+}
+
+TEST(EncoderSpeedControllerTest, ParsesFieldTrial) {
+  EXPECT_FALSE(EncoderSpeedController::Config::Parse("", kLowQp));
+  EXPECT_FALSE(EncoderSpeedController::Config::Parse(
+      "Enabled,low_utilization:0.9,high_utilization:0.7", kLowQp));
+
+  absl::optional<EncoderSpeedController::Config> config =
+      EncoderSpeedController::Config::Parse(
+          "Enabled,low_utilization:0.3,high_utilization:0.7,low_qp:20",
+          kLowQp);
+  ASSERT_TRUE(config);
+  EXPECT_EQ(config->low_utilization, 0.3);
+  EXPECT_EQ(config->high_utilization, 0.7);
+  EXPECT_EQ(config->low_qp, 20);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/updated_block_map.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+UpdatedBlockMap::UpdatedBlockMap(int width, int height)
+    : width_(width),
+      height_(height),
+      rows_((height + kBlockSize - 1) / kBlockSize),
+      cols_((width + kBlockSize - 1) / kBlockSize),
+      map_(rows_ * cols_, 0) {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+}
+
+void UpdatedBlockMap::AddUpdate(const VideoFrame::UpdateRect& update_rect) {
+  const int left = std::max(update_rect.offset_x, 0);
+  const int top = std::max(update_rect.offset_y, 0);
+  const int right = std::min(update_rect.offset_x + update_rect.width, width_);
+  const int bottom =
+      std::min(update_rect.offset_y + update_rect.height, height_);
+  if (left >= right || top >= bottom)
+    return;
+  for (int row = top / kBlockSize; row <= (bottom - 1) / kBlockSize; ++row) {
+    uint8_t* block = &map_[row * cols_ + left / kBlockSize];
+    for (int col = left / kBlockSize; col <= (right - 1) / kBlockSize;
+         ++col, ++block) {
+      num_updated_blocks_ += 1 - *block;
+      *block = 1;
+    }
+  }
+}
+
+void UpdatedBlockMap::Reset() {
+  std::fill(map_.begin(), map_.end(), 0);
+  num_updated_blocks_ = 0;
+}
+
+bool UpdatedBlockMap::IsPartial() const {
+  return num_updated_blocks_ > 0 &&
+         num_updated_blocks_ < static_cast<int>(map_.size());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_UPDATED_BLOCK_MAP_H_
+#define MODULES_VIDEO_CODING_UTILITY_UPDATED_BLOCK_MAP_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/video/video_frame.h"
+
+namespace webrtc {
+
+// Keeps track of which blocks of a frame were updated since the reference
+// frame, based on the update rects of the frames that came after it. Used to
+// build the active map of libvpx encoders, where blocks that are not active
+// are coded as skipped without any motion search.
+class UpdatedBlockMap {
+ public:
+  // Size of the square blocks in pixels, matching the 16x16 macroblocks used
+  // by the libvpx active map.
+  static constexpr int kBlockSize = 16;
+
+  UpdatedBlockMap(int width, int height);
+
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+
+  // Marks the blocks covered by `update_rect` as updated.
+  void AddUpdate(const VideoFrame::UpdateRect& update_rect);
+
+  // Call when the frame encoded last became the reference frame. All blocks
+  // are considered unchanged after this call.
+  void Reset();
+
+  // Returns true if some, but not all, blocks were updated. Only then the
+  // map is worth passing to the encoder: with no updated blocks, the frame is
+  // a repeat meant to refine quality, so all blocks should be encoded.
+  bool IsPartial() const;
+
+  // One byte per block in raster order, 1 for updated blocks and 0 for
+  // unchanged ones.
+  uint8_t* data() { return map_.data(); }
+
+ private:
+  const int width_;
+  const int height_;
+  const int rows_;
+  const int cols_;
+  int num_updated_blocks_ = 0;
+  std::vector<uint8_t> map_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_UPDATED_BLOCK_MAP_H_
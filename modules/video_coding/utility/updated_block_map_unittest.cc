@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/updated_block_map.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<uint8_t> Blocks(UpdatedBlockMap& map) {
+  return std::vector<uint8_t>(map.data(),
+                              map.data() + map.rows() * map.cols());
+}
+
+TEST(UpdatedBlockMapTest, RoundsSizeUpToBlocks) {
+  UpdatedBlockMap map(/*width=*/33, /*height=*/16);
+  EXPECT_EQ(map.rows(), 1);
+  EXPECT_EQ(map.cols(), 3);
+  EXPECT_THAT(Blocks(map), ElementsAre(0, 0, 0));
+  EXPECT_FALSE(map.IsPartial());
+}
+
+TEST(UpdatedBlockMapTest, MarksBlocksTouchedByUpdate) {
+  UpdatedBlockMap map(/*width=*/64, /*height=*/32);
+  map.AddUpdate({/*offset_x=*/15, /*offset_y=*/16, /*width=*/2,
+                 /*height=*/1});
+  EXPECT_THAT(Blocks(map), ElementsAre(0, 0, 0, 0,  //
+                                       1, 1, 0, 0));
+  EXPECT_TRUE(map.IsPartial());
+}
+
+TEST(UpdatedBlockMapTest, AccumulatesUpdatesUntilReset) {
+  UpdatedBlockMap map(/*width=*/32, /*height=*/32);
+  map.AddUpdate({0, 0, 16, 16});
+  map.AddUpdate({16, 16, 16, 16});
+  EXPECT_THAT(Blocks(map), ElementsAre(1, 0, 0, 1));
+  EXPECT_TRUE(map.IsPartial());
+
+  map.AddUpdate({0, 0, 32, 32});
+  EXPECT_FALSE(map.IsPartial());
+
+  map.Reset();
+  EXPECT_THAT(Blocks(map), ElementsAre(0, 0, 0, 0));
+  EXPECT_FALSE(map.IsPartial());
+}
+
+TEST(UpdatedBlockMapTest, IgnoresEmptyUpdates) {
+  UpdatedBlockMap map(/*width=*/32, /*height=*/32);
+  VideoFrame::UpdateRect empty_update_rect;
+  empty_update_rect.MakeEmptyUpdate();
+  map.AddUpdate(empty_update_rect);
+  EXPECT_THAT(Blocks(map), ElementsAre(0, 0, 0, 0));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -11,13 +11,12 @@
 
 #include <cstdint>
 
+#include "rtc_base/checks.h"
 #include "third_party/crc32c/src/include/crc32c/crc32c.h"
 
 namespace dcsctp {
-
-uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
-  uint32_t crc32c = crc32c_value(data.data(), data.size());
-
+namespace {
+uint32_t ByteSwap(uint32_t crc32c) {
   // Byte swapping for little endian byte order:
   uint8_t byte0 = crc32c;
   uint8_t byte1 = crc32c >> 8;
@@ -26,4 +25,22 @@ uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
   crc32c = ((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
   return crc32c;
 }
+}  // namespace
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
+  return ByteSwap(crc32c_value(data.data(), data.size()));
+}
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data,
+                        size_t zeroed_offset) {
+  static constexpr uint8_t kZeroes[4] = {0, 0, 0, 0};
+  RTC_DCHECK_LE(zeroed_offset + sizeof(kZeroes), data.size());
+  const size_t tail_offset = zeroed_offset + sizeof(kZeroes);
+
+  uint32_t crc32c = crc32c_value(data.data(), zeroed_offset);
+  crc32c = crc32c_extend(crc32c, kZeroes, sizeof(kZeroes));
+  crc32c = crc32c_extend(crc32c, data.data() + tail_offset,
+                         data.size() - tail_offset);
+  return ByteSwap(crc32c);
+}
 }  // namespace dcsctp
@@ -10,6 +10,8 @@
 #ifndef NET_DCSCTP_PACKET_CRC32C_H_
 #define NET_DCSCTP_PACKET_CRC32C_H_
 
+#include <stddef.h>
+
 #include <cstdint>
 
 #include "api/array_view.h"
@@ -19,6 +21,12 @@ namespace dcsctp {
 // Generates the CRC32C checksum of `data`.
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data);
 
+// Generates the CRC32C checksum of `data` as if the four bytes at
+// `zeroed_offset` were zero, which is how the checksum field of a received
+// packet is handled when verifying it, without having to copy the packet.
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data,
+                        size_t zeroed_offset);
+
 }  // namespace dcsctp
 
 #endif  // NET_DCSCTP_PACKET_CRC32C_H_
@@ -9,6 +9,9 @@
  */
 #include "net/dcsctp/packet/crc32c.h"
 
+#include <algorithm>
+#include <array>
+
 #include "test/gmock.h"
 
 namespace dcsctp {
@@ -54,5 +57,14 @@ TEST(Crc32Test, TestVectors) {
   EXPECT_EQ(GenerateCrc32C(kISCSICommandPDU), 0x563a96d9U);
 }
 
+TEST(Crc32Test, TreatsZeroedFieldAsZeroes) {
+  for (size_t offset = 0; offset + 4 <= k32Incrementing.size(); ++offset) {
+    std::array<uint8_t, 32> zeroed;
+    std::copy(k32Incrementing.begin(), k32Incrementing.end(), zeroed.begin());
+    std::fill_n(zeroed.begin() + offset, 4, 0);
+    EXPECT_EQ(GenerateCrc32C(k32Incrementing, offset), GenerateCrc32C(zeroed));
+  }
+}
+
 }  // namespace
 }  // namespace dcsctp
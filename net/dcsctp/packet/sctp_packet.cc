@@ -108,6 +108,21 @@ std::vector<uint8_t> SctpPacket::Builder::Build() {
 absl::optional<SctpPacket> SctpPacket::Parse(
     rtc::ArrayView<const uint8_t> data,
     bool disable_checksum_verification) {
+  return ParseInternal(data, disable_checksum_verification,
+                       /*copy_data=*/true);
+}
+
+absl::optional<SctpPacket> SctpPacket::ParseView(
+    rtc::ArrayView<const uint8_t> data,
+    bool disable_checksum_verification) {
+  return ParseInternal(data, disable_checksum_verification,
+                       /*copy_data=*/false);
+}
+
+absl::optional<SctpPacket> SctpPacket::ParseInternal(
+    rtc::ArrayView<const uint8_t> data,
+    bool disable_checksum_verification,
+    bool copy_data) {
   if (data.size() < kHeaderSize + kChunkTlvHeaderSize ||
       data.size() > kMaxUdpPacketSize) {
     RTC_DLOG(LS_WARNING) << "Invalid packet size";
@@ -122,23 +137,26 @@ absl::optional<SctpPacket> SctpPacket::Parse(
   common_header.verification_tag = VerificationTag(reader.Load32<4>());
   common_header.checksum = reader.Load32<8>();
 
-  // Create a copy of the packet, which will be held by this object.
-  std::vector<uint8_t> data_copy =
-      std::vector<uint8_t>(data.begin(), data.end());
-
-  // Verify the checksum. The checksum field must be zero when that's done.
-  BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(0);
-  uint32_t calculated_checksum = GenerateCrc32C(data_copy);
-  if (!disable_checksum_verification &&
-      calculated_checksum != common_header.checksum) {
-    RTC_DLOG(LS_WARNING) << rtc::StringFormat(
-        "Invalid packet checksum, packet_checksum=0x%08x, "
-        "calculated_checksum=0x%08x",
-        common_header.checksum, calculated_checksum);
-    return absl::nullopt;
+  // Verify the checksum. The checksum field must be zero when that's done,
+  // which it's treated as without writing to the packet.
+  if (!disable_checksum_verification) {
+    uint32_t calculated_checksum = GenerateCrc32C(data, /*zeroed_offset=*/8);
+    if (calculated_checksum != common_header.checksum) {
+      RTC_DLOG(LS_WARNING) << rtc::StringFormat(
+          "Invalid packet checksum, packet_checksum=0x%08x, "
+          "calculated_checksum=0x%08x",
+          common_header.checksum, calculated_checksum);
+      return absl::nullopt;
+    }
+  }
+
+  // Create a copy of the packet, which will be held by this object, unless
+  // the packet is only a view.
+  std::vector<uint8_t> data_copy;
+  if (copy_data) {
+    data_copy.assign(data.begin(), data.end());
+    data = data_copy;
   }
-  // Restore the checksum in the header.
-  BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(common_header.checksum);
 
   // Validate and parse the chunk headers in the message.
   /*
@@ -151,8 +169,7 @@ absl::optional<SctpPacket> SctpPacket::Parse(
 
   std::vector<ChunkDescriptor> descriptors;
   descriptors.reserve(kExpectedDescriptorCount);
-  rtc::ArrayView<const uint8_t> descriptor_data =
-      rtc::ArrayView<const uint8_t>(data_copy).subview(kHeaderSize);
+  rtc::ArrayView<const uint8_t> descriptor_data = data.subview(kHeaderSize);
   while (!descriptor_data.empty()) {
     if (descriptor_data.size() < kChunkTlvHeaderSize) {
       RTC_DLOG(LS_WARNING) << "Too small chunk";
@@ -177,7 +194,8 @@ absl::optional<SctpPacket> SctpPacket::Parse(
   }
 
   // Note that iterators (and pointer) are guaranteed to be stable when moving a
-  // std::vector, and `descriptors` have pointers to within `data_copy`.
+  // std::vector, and `descriptors` have pointers to within `data_copy`, unless
+  // it's empty.
   return SctpPacket(common_header, std::move(data_copy),
                     std::move(descriptors));
 }
@@ -91,6 +91,13 @@ class SctpPacket {
       rtc::ArrayView<const uint8_t> data,
       bool disable_checksum_verification = false);
 
+  // Like Parse, but the returned packet refers to `data` instead of holding a
+  // copy of it, which means that `data` must outlive the returned packet. This
+  // is meant for packets that are processed as soon as they are received.
+  static absl::optional<SctpPacket> ParseView(
+      rtc::ArrayView<const uint8_t> data,
+      bool disable_checksum_verification = false);
+
   // Returns the SCTP common header.
   const CommonHeader& common_header() const { return common_header_; }
 
@@ -107,13 +114,21 @@ class SctpPacket {
         data_(std::move(data)),
         descriptors_(std::move(descriptors)) {}
 
+  static absl::optional<SctpPacket> ParseInternal(
+      rtc::ArrayView<const uint8_t> data,
+      bool disable_checksum_verification,
+      bool copy_data);
+
   CommonHeader common_header_;
 
   // As the `descriptors_` refer to offset within data, and since SctpPacket is
   // movable, `data` needs to be pointer stable, which it is according to
   // http://www.open-std.org/JTC1/SC22/WG21/docs/lwg-active.html#2321
+  //
+  // Empty if the packet was parsed by ParseView.
   std::vector<uint8_t> data_;
-  // The chunks and their offsets within `data_ `.
+  // The chunks and their offsets within `data_ `, or within the parsed data if
+  // the packet was parsed by ParseView.
   std::vector<ChunkDescriptor> descriptors_;
 };
 }  // namespace dcsctp
@@ -236,6 +236,24 @@ TEST(SctpPacketTest, SerializeAndDeserializeSingleChunk) {
   EXPECT_EQ(deserialized.initial_tsn(), TSN(789));
 }
 
+TEST(SctpPacketTest, ParseViewRefersToParsedData) {
+  SctpPacket::Builder b(kVerificationTag, {});
+  b.Add(CookieAckChunk());
+  std::vector<uint8_t> serialized = b.Build();
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SctpPacket packet,
+                              SctpPacket::ParseView(serialized));
+  EXPECT_EQ(packet.common_header().verification_tag, kVerificationTag);
+  ASSERT_THAT(packet.descriptors(), SizeIs(1));
+  EXPECT_EQ(packet.descriptors()[0].type, CookieAckChunk::kType);
+  EXPECT_EQ(packet.descriptors()[0].data.data(),
+            serialized.data() + SctpPacket::kHeaderSize);
+
+  // The checksum is still verified.
+  serialized.back() ^= 1;
+  EXPECT_FALSE(SctpPacket::ParseView(serialized).has_value());
+}
+
 TEST(SctpPacketTest, SerializeAndDeserializeThreeChunks) {
   SctpPacket::Builder b(kVerificationTag, {});
   b.Add(SackChunk(/*cumulative_tsn_ack=*/TSN(999), /*a_rwnd=*/456,
@@ -48,6 +48,7 @@ struct DcSctpSocketHandoverState {
     uint32_t next_ssn = 0;
     uint32_t next_unordered_mid = 0;
     uint32_t next_ordered_mid = 0;
+    uint32_t priority = 0;
   };
   struct Transmission {
     uint32_t next_tsn = 0;
@@ -22,10 +22,34 @@ namespace dcsctp {
 // An SCTP message is a group of bytes sent and received as a whole on a
 // specified stream identifier (`stream_id`), and with a payload protocol
 // identifier (`ppid`).
+//
+// A received message may be made up of several fragments, which are then kept
+// as they were received to avoid copying them when reassembling the message.
+// Use `fragments()` to read them without copying, or `payload()` to have them
+// concatenated on first access.
 class DcSctpMessage {
  public:
   DcSctpMessage(StreamID stream_id, PPID ppid, std::vector<uint8_t> payload)
-      : stream_id_(stream_id), ppid_(ppid), payload_(std::move(payload)) {}
+      : stream_id_(stream_id),
+        ppid_(ppid),
+        payload_size_(payload.size()),
+        payload_(std::move(payload)) {}
+
+  // Creates a message whose payload is the concatenation of `fragments`.
+  DcSctpMessage(StreamID stream_id,
+                PPID ppid,
+                std::vector<std::vector<uint8_t>> fragments)
+      : stream_id_(stream_id), ppid_(ppid) {
+    if (fragments.size() == 1) {
+      payload_ = std::move(fragments[0]);
+      payload_size_ = payload_.size();
+    } else {
+      for (const std::vector<uint8_t>& fragment : fragments) {
+        payload_size_ += fragment.size();
+      }
+      fragments_ = std::move(fragments);
+    }
+  }
 
   DcSctpMessage(DcSctpMessage&& other) = default;
   DcSctpMessage& operator=(DcSctpMessage&& other) = default;
@@ -38,16 +62,48 @@ class DcSctpMessage {
   // The payload protocol identifier (ppid) associated with the message.
   PPID ppid() const { return ppid_; }
 
-  // The payload of the message.
-  rtc::ArrayView<const uint8_t> payload() const { return payload_; }
+  // The size of the payload of the message, in bytes.
+  size_t payload_size() const { return payload_size_; }
+
+  // The payload of the message, as one or more fragments that together form
+  // the payload. A message that isn't fragmented has a single fragment.
+  rtc::ArrayView<const std::vector<uint8_t>> fragments() const {
+    if (fragments_.empty()) {
+      return rtc::ArrayView<const std::vector<uint8_t>>(&payload_, 1);
+    }
+    return fragments_;
+  }
+
+  // The payload of the message. If the message is fragmented, the fragments
+  // will be concatenated (once) before returning.
+  rtc::ArrayView<const uint8_t> payload() const {
+    Concatenate();
+    return payload_;
+  }
 
   // When destructing the message, extracts the payload.
-  std::vector<uint8_t> ReleasePayload() && { return std::move(payload_); }
+  std::vector<uint8_t> ReleasePayload() && {
+    Concatenate();
+    return std::move(payload_);
+  }
 
  private:
+  void Concatenate() const {
+    if (!fragments_.empty() && payload_.size() != payload_size_) {
+      payload_.reserve(payload_size_);
+      for (const std::vector<uint8_t>& fragment : fragments_) {
+        payload_.insert(payload_.end(), fragment.begin(), fragment.end());
+      }
+    }
+  }
+
   StreamID stream_id_;
   PPID ppid_;
-  std::vector<uint8_t> payload_;
+  size_t payload_size_ = 0;
+  // The contiguous payload. For fragmented messages, it's lazily populated
+  // from `fragments_`, which is otherwise empty.
+  mutable std::vector<uint8_t> payload_;
+  std::vector<std::vector<uint8_t>> fragments_;
 };
 }  // namespace dcsctp
 
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/public/dcsctp_message.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(DcSctpMessageTest, HasSingleFragmentWhenCreatedFromPayload) {
+  DcSctpMessage message(StreamID(1), PPID(53), {1, 2, 3});
+  EXPECT_EQ(message.payload_size(), 3u);
+  ASSERT_EQ(message.fragments().size(), 1u);
+  EXPECT_THAT(message.fragments()[0], ElementsAre(1, 2, 3));
+  EXPECT_EQ(message.fragments()[0].data(), message.payload().data());
+}
+
+TEST(DcSctpMessageTest, KeepsFragmentsUntilPayloadIsAccessed) {
+  std::vector<std::vector<uint8_t>> fragments = {{1, 2}, {}, {3, 4, 5}};
+  const uint8_t* first_data = fragments[0].data();
+  DcSctpMessage message(StreamID(1), PPID(53), std::move(fragments));
+
+  EXPECT_EQ(message.payload_size(), 5u);
+  ASSERT_EQ(message.fragments().size(), 3u);
+  EXPECT_EQ(message.fragments()[0].data(), first_data);
+
+  EXPECT_THAT(message.payload(), ElementsAre(1, 2, 3, 4, 5));
+  // The fragments are still available.
+  EXPECT_THAT(message.fragments()[2], ElementsAre(3, 4, 5));
+  EXPECT_THAT(std::move(message).ReleasePayload(),
+              ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(DcSctpMessageTest, ReleasesConcatenatedFragments) {
+  std::vector<std::vector<uint8_t>> fragments = {{1}, {2, 3}};
+  DcSctpMessage message(StreamID(1), PPID(53), std::move(fragments));
+  EXPECT_THAT(std::move(message).ReleasePayload(), ElementsAre(1, 2, 3));
+}
+
+TEST(DcSctpMessageTest, CanHaveEmptyFragmentedPayload) {
+  std::vector<std::vector<uint8_t>> fragments = {{}, {}};
+  DcSctpMessage message(StreamID(1), PPID(53), std::move(fragments));
+  EXPECT_EQ(message.payload_size(), 0u);
+  EXPECT_THAT(message.payload(), IsEmpty());
+}
+
+}  // namespace
+}  // namespace dcsctp
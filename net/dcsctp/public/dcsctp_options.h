@@ -17,6 +17,21 @@
 #include "net/dcsctp/public/types.h"
 
 namespace dcsctp {
+
+// The stream scheduler decides from which stream the next message is sent, when
+// several streams have messages to send. See
+// https://datatracker.ietf.org/doc/html/rfc8260#section-3.
+enum class StreamScheduler {
+  // Cycles between streams, sending one message from each (RFC 8260, 3.2).
+  kRoundRobin,
+  // Always sends from the stream with the highest priority, and cycles between
+  // streams having the same priority (RFC 8260, 3.4).
+  kStrictPriority,
+  // Shares the bandwidth between streams in proportion to their priority, by
+  // the number of bytes sent on each (RFC 8260, 3.6).
+  kWeightedFairQueueing,
+};
+
 struct DcSctpOptions {
   // The largest safe SCTP packet. Starting from the minimum guaranteed MTU
   // value of 1280 for IPv6 (which may not support fragmentation), take off 85
@@ -88,6 +103,13 @@ struct DcSctpOptions {
   // this value, will trigger `DcSctpCallbacks::OnTotalBufferedAmountLow`.
   size_t total_buffered_amount_low_threshold = 1'800'000;
 
+  // The stream scheduler to use when several streams have messages to send.
+  // The priority of a stream is set with `DcSctpSocket::SetStreamPriority`.
+  StreamScheduler stream_scheduler = StreamScheduler::kRoundRobin;
+
+  // The priority that streams have, until set with `SetStreamPriority`.
+  StreamPriority default_stream_priority = StreamPriority(256);
+
   // Max allowed RTT value. When the RTT is measured and it's found to be larger
   // than this value, it will be discarded and not used for e.g. any RTO
   // calculation. The default value is an extreme maximum but can be adapted
@@ -190,6 +212,15 @@ struct DcSctpOptions {
 
   // Disables SCTP packet crc32 verification. Useful when running with fuzzers.
   bool disable_checksum_verification = false;
+
+  // If set, the packets that are generated while handling a single call into
+  // the socket are not sent one by one, but handed to the client in a single
+  // call to `DcSctpSocketCallbacks::SendPackets`, which lets the client pass
+  // them to its transport in one go. As the socket doesn't learn if a packet
+  // was sent until the batch is sent, a burst of packets isn't cut short when
+  // sending temporarily fails; Such packets are retransmitted like any other
+  // lost packet.
+  bool send_packets_in_batches = false;
 };
 }  // namespace dcsctp
 
@@ -262,6 +262,20 @@ class DcSctpSocketCallbacks {
     return SendPacketStatus::kSuccess;
   }
 
+  // Called when the library wants the packets serialized as `packets` to be
+  // sent, which it only does if `DcSctpOptions::send_packets_in_batches` is
+  // set. The result of sending `packets[i]` must be stored in `statuses[i]`.
+  //
+  // Note that it's NOT ALLOWED to call into this library from within this
+  // callback.
+  virtual void SendPackets(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+      rtc::ArrayView<SendPacketStatus> statuses) {
+    for (size_t i = 0; i < packets.size(); ++i) {
+      statuses[i] = SendPacketWithStatus(packets[i]);
+    }
+  }
+
   // Called when the library wants to create a Timeout. The callback must return
   // an object that implements that interface.
   //
@@ -467,6 +481,15 @@ class DcSctpSocketInterface {
   virtual void SetBufferedAmountLowThreshold(StreamID stream_id,
                                              size_t bytes) = 0;
 
+  // Sets the priority of an outgoing stream, which is used by the stream
+  // scheduler selected in `DcSctpOptions::stream_scheduler` to decide which
+  // stream to send from next. The priority must be greater than zero.
+  virtual void SetStreamPriority(StreamID stream_id,
+                                 StreamPriority priority) = 0;
+
+  // Returns the priority of an outgoing stream. See `SetStreamPriority`.
+  virtual StreamPriority GetStreamPriority(StreamID stream_id) const = 0;
+
   // Retrieves the latest metrics.
   virtual Metrics GetMetrics() const = 0;
 
@@ -31,6 +31,11 @@ using TimeoutID = webrtc::StrongAlias<class TimeoutTag, uint64_t>;
 // other messages on the same stream.
 using IsUnordered = webrtc::StrongAlias<class IsUnorderedTag, bool>;
 
+// Stream priority, which is relative to the priority of other streams. A higher
+// value means a higher priority, and zero (0) is not allowed. See
+// `DcSctpOptions::stream_scheduler`.
+using StreamPriority = webrtc::StrongAlias<class StreamPriorityTag, uint16_t>;
+
 // Duration, as milliseconds. Overflows after 24 days.
 class DurationMs : public webrtc::StrongAlias<class DurationMsTag, int32_t> {
  public:
@@ -207,7 +207,7 @@ void ReassemblyQueue::AddReassembledMessage(
                                   })
                        << "], message; stream_id=" << *message.stream_id()
                        << ", ppid=" << *message.ppid()
-                       << ", payload=" << message.payload().size() << " bytes";
+                       << ", payload=" << message.payload_size() << " bytes";
 
   for (const UnwrappedTSN tsn : tsns) {
     // Update watermark, or insert into delivered_tsns_
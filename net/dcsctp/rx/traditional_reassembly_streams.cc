@@ -142,7 +142,7 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
 
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = start->second;
+    Data& data = start->second;
     size_t payload_size = start->second.size();
     UnwrappedTSN tsns[1] = {start->first};
     DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
@@ -150,24 +150,23 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
     return payload_size;
   }
 
-  // Slow path - will need to concatenate the payload.
+  // Slow path - the fragments are moved as-is into the message, which will
+  // only concatenate them if the receiver asks for a contiguous payload.
   std::vector<UnwrappedTSN> tsns;
-  std::vector<uint8_t> payload;
-
-  size_t payload_size = std::accumulate(
-      start, end, 0,
-      [](size_t v, const auto& p) { return v + p.second.size(); });
+  std::vector<std::vector<uint8_t>> fragments;
+  size_t payload_size = 0;
 
   tsns.reserve(count);
-  payload.reserve(payload_size);
+  fragments.reserve(count);
   for (auto it = start; it != end; ++it) {
-    const Data& data = it->second;
+    Data& data = it->second;
     tsns.push_back(it->first);
-    payload.insert(payload.end(), data.payload.begin(), data.payload.end());
+    payload_size += data.size();
+    fragments.push_back(std::move(data.payload));
   }
 
   DcSctpMessage message(start->second.stream_id, start->second.ppid,
-                        std::move(payload));
+                        std::move(fragments));
   parent_.on_assembled_message_(tsns, std::move(message));
 
   return payload_size;
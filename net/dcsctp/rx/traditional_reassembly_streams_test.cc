@@ -13,11 +13,13 @@
 #include <memory>
 #include <utility>
 
+#include "api/array_view.h"
 #include "net/dcsctp/common/handover_testing.h"
 #include "net/dcsctp/common/sequence_numbers.h"
 #include "net/dcsctp/packet/chunk/forward_tsn_chunk.h"
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/dcsctp_message.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
 #include "net/dcsctp/testing/data_generator.h"
 #include "rtc_base/gunit.h"
@@ -25,6 +27,8 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
 
@@ -62,6 +66,28 @@ TEST_F(TraditionalReassemblyStreamsTest,
   EXPECT_EQ(streams.Add(tsn(4), gen_.Ordered({7}, "E")), -6);
 }
 
+TEST_F(TraditionalReassemblyStreamsTest, AssemblesMessageWithoutCopying) {
+  Data first = gen_.Ordered({1, 2}, "B");
+  Data last = gen_.Ordered({3}, "E");
+  const uint8_t* first_data = first.payload.data();
+  const uint8_t* last_data = last.payload.data();
+
+  MockFunction<ReassemblyStreams::OnAssembledMessage> on_assembled;
+  EXPECT_CALL(on_assembled, Call(ElementsAre(tsn(1), tsn(2)), _))
+      .WillOnce([&](rtc::ArrayView<const UnwrappedTSN> tsns,
+                    DcSctpMessage message) {
+        EXPECT_EQ(message.payload_size(), 3u);
+        ASSERT_EQ(message.fragments().size(), 2u);
+        EXPECT_EQ(message.fragments()[0].data(), first_data);
+        EXPECT_EQ(message.fragments()[1].data(), last_data);
+        EXPECT_THAT(message.payload(), ElementsAre(1, 2, 3));
+      });
+
+  TraditionalReassemblyStreams streams("", on_assembled.AsStdFunction());
+  streams.Add(tsn(1), std::move(first));
+  streams.Add(tsn(2), std::move(last));
+}
+
 TEST_F(TraditionalReassemblyStreamsTest,
        AddMoreComplexOrderedMessageReturnsCorrectSize) {
   NiceMock<MockFunction<ReassemblyStreams::OnAssembledMessage>> on_assembled;
@@ -61,6 +61,13 @@ SendPacketStatus CallbackDeferrer::SendPacketWithStatus(
   return underlying_.SendPacketWithStatus(data);
 }
 
+void CallbackDeferrer::SendPackets(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    rtc::ArrayView<SendPacketStatus> statuses) {
+  // Will not be deferred - call directly.
+  underlying_.SendPackets(packets, statuses);
+}
+
 std::unique_ptr<Timeout> CallbackDeferrer::CreateTimeout(
     webrtc::TaskQueueBase::DelayPrecision precision) {
   // Will not be deferred - call directly.
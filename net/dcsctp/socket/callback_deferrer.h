@@ -63,6 +63,8 @@ class CallbackDeferrer : public DcSctpSocketCallbacks {
   // Implementation of DcSctpSocketCallbacks
   SendPacketStatus SendPacketWithStatus(
       rtc::ArrayView<const uint8_t> data) override;
+  void SendPackets(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                   rtc::ArrayView<SendPacketStatus> statuses) override;
   std::unique_ptr<Timeout> CreateTimeout(
       webrtc::TaskQueueBase::DelayPrecision precision) override;
   TimeMs TimeMillis() override;
@@ -185,7 +185,8 @@ DcSctpSocket::DcSctpSocket(absl::string_view log_prefix,
                        TimerBackoffAlgorithm::kExponential,
                        options.max_retransmissions))),
       packet_sender_(callbacks_,
-                     absl::bind_front(&DcSctpSocket::OnSentPacket, this)),
+                     absl::bind_front(&DcSctpSocket::OnSentPacket, this),
+                     options.send_packets_in_batches),
       send_queue_(
           log_prefix_,
           options_.max_send_buffer_size,
@@ -193,7 +194,9 @@ DcSctpSocket::DcSctpSocket(absl::string_view log_prefix,
             callbacks_.OnBufferedAmountLow(stream_id);
           },
           options_.total_buffered_amount_low_threshold,
-          [this]() { callbacks_.OnTotalBufferedAmountLow(); }) {}
+          [this]() { callbacks_.OnTotalBufferedAmountLow(); },
+          options_.stream_scheduler,
+          options_.default_stream_priority) {}
 
 std::string DcSctpSocket::log_prefix() const {
   return log_prefix_ + "[" + std::string(ToString(state_)) + "] ";
@@ -286,6 +289,7 @@ void DcSctpSocket::MakeConnectionParameters() {
 void DcSctpSocket::Connect() {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (state_ == State::kClosed) {
     MakeConnectionParameters();
@@ -307,6 +311,7 @@ void DcSctpSocket::Connect() {
 void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (state_ != State::kClosed) {
     callbacks_.OnError(ErrorKind::kUnsupportedOperation,
@@ -347,6 +352,7 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
 void DcSctpSocket::Shutdown() {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (tcb_ != nullptr) {
     // https://tools.ietf.org/html/rfc4960#section-9.2
@@ -376,6 +382,7 @@ void DcSctpSocket::Shutdown() {
 void DcSctpSocket::Close() {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (state_ != State::kClosed) {
     if (tcb_ != nullptr) {
@@ -424,6 +431,7 @@ SendStatus DcSctpSocket::Send(DcSctpMessage message,
                               const SendOptions& send_options) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (message.payload().empty()) {
     callbacks_.OnError(ErrorKind::kProtocolViolation,
@@ -466,6 +474,7 @@ ResetStreamsStatus DcSctpSocket::ResetStreams(
     rtc::ArrayView<const StreamID> outgoing_streams) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (tcb_ == nullptr) {
     callbacks_.OnError(ErrorKind::kWrongSequence,
@@ -530,6 +539,17 @@ void DcSctpSocket::SetBufferedAmountLowThreshold(StreamID stream_id,
   send_queue_.SetBufferedAmountLowThreshold(stream_id, bytes);
 }
 
+void DcSctpSocket::SetStreamPriority(StreamID stream_id,
+                                     StreamPriority priority) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  send_queue_.SetStreamPriority(stream_id, priority);
+}
+
+StreamPriority DcSctpSocket::GetStreamPriority(StreamID stream_id) const {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  return send_queue_.GetStreamPriority(stream_id);
+}
+
 Metrics DcSctpSocket::GetMetrics() const {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   Metrics metrics = metrics_;
@@ -673,6 +693,7 @@ bool DcSctpSocket::ValidatePacket(const SctpPacket& packet) {
 void DcSctpSocket::HandleTimeout(TimeoutID timeout_id) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   timer_manager_.HandleTimeout(timeout_id);
 
@@ -687,6 +708,7 @@ void DcSctpSocket::HandleTimeout(TimeoutID timeout_id) {
 void DcSctpSocket::ReceivePacket(rtc::ArrayView<const uint8_t> data) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   ++metrics_.rx_packets_count;
 
@@ -695,7 +717,7 @@ void DcSctpSocket::ReceivePacket(rtc::ArrayView<const uint8_t> data) {
   }
 
   absl::optional<SctpPacket> packet =
-      SctpPacket::Parse(data, options_.disable_checksum_verification);
+      SctpPacket::ParseView(data, options_.disable_checksum_verification);
   if (!packet.has_value()) {
     // https://tools.ietf.org/html/rfc4960#section-6.8
     // "The default procedure for handling invalid SCTP packets is to
@@ -737,7 +759,7 @@ void DcSctpSocket::ReceivePacket(rtc::ArrayView<const uint8_t> data) {
 }
 
 void DcSctpSocket::DebugPrintOutgoing(rtc::ArrayView<const uint8_t> payload) {
-  auto packet = SctpPacket::Parse(payload);
+  auto packet = SctpPacket::ParseView(payload);
   RTC_DCHECK(packet.has_value());
 
   for (const auto& desc : packet->descriptors()) {
@@ -1668,6 +1690,7 @@ absl::optional<DcSctpSocketHandoverState>
 DcSctpSocket::GetHandoverStateAndClose() {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   CallbackDeferrer::ScopedDeferrer deferrer(callbacks_);
+  PacketSender::ScopedBatch batch(packet_sender_);
 
   if (!GetHandoverReadiness().IsReady()) {
     return absl::nullopt;
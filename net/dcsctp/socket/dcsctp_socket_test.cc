@@ -1973,6 +1973,30 @@ TEST_P(DcSctpSocketParametrizedTest, DoesntSendMoreThanMaxBurstPackets) {
   MaybeHandoverSocketAndSendMessage(a, std::move(z));
 }
 
+TEST(DcSctpSocketTest, SendsBurstOfPacketsInOneBatch) {
+  DcSctpOptions options;
+  options.send_packets_in_batches = true;
+  SocketUnderTest a("A", options);
+  SocketUnderTest z("Z");
+
+  ConnectSockets(a, z);
+
+  EXPECT_CALL(a.cb, SendPackets(SizeIs(kMaxBurstPackets), _));
+  a.socket.Send(DcSctpMessage(StreamID(1), PPID(53),
+                              std::vector<uint8_t>(kLargeMessageSize)),
+                kSendOptions);
+  testing::Mock::VerifyAndClearExpectations(&a.cb);
+
+  for (int i = 0; i < kMaxBurstPackets; ++i) {
+    std::vector<uint8_t> packet = a.cb.ConsumeSentPacket();
+    EXPECT_THAT(packet, Not(IsEmpty()));
+    z.socket.ReceivePacket(std::move(packet));  // DATA
+  }
+  EXPECT_THAT(a.cb.ConsumeSentPacket(), IsEmpty());
+  // INIT, COOKIE_ECHO and the batch.
+  EXPECT_EQ(a.socket.GetMetrics().tx_packets_count, 2u + kMaxBurstPackets);
+}
+
 TEST_P(DcSctpSocketParametrizedTest, SendsOnlyLargePackets) {
   SocketUnderTest a("A");
   auto z = std::make_unique<SocketUnderTest>("Z");
@@ -2179,5 +2203,20 @@ TEST(DcSctpSocketTest, BothCanDetectDcsctpImplementation) {
   EXPECT_EQ(a.socket.peer_implementation(), SctpImplementation::kDcsctp);
   EXPECT_EQ(z.socket.peer_implementation(), SctpImplementation::kDcsctp);
 }
+
+TEST_P(DcSctpSocketParametrizedTest, StreamPriorityIsKeptOverHandover) {
+  SocketUnderTest a("A");
+  auto z = std::make_unique<SocketUnderTest>("Z");
+
+  ConnectSockets(a, *z);
+
+  EXPECT_EQ(z->socket.GetStreamPriority(StreamID(1)),
+            z->options.default_stream_priority);
+  z->socket.SetStreamPriority(StreamID(1), StreamPriority(42));
+
+  z = MaybeHandoverSocket(std::move(z));
+
+  EXPECT_EQ(z->socket.GetStreamPriority(StreamID(1)), StreamPriority(42));
+}
 }  // namespace
 }  // namespace dcsctp
@@ -63,6 +63,12 @@ class MockDcSctpSocketCallbacks : public DcSctpSocketCallbacks {
               std::vector<uint8_t>(data.begin(), data.end()));
           return SendPacketStatus::kSuccess;
         });
+    ON_CALL(*this, SendPackets)
+        .WillByDefault(
+            [this](rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                   rtc::ArrayView<SendPacketStatus> statuses) {
+              DcSctpSocketCallbacks::SendPackets(packets, statuses);
+            });
     ON_CALL(*this, OnMessageReceived)
         .WillByDefault([this](DcSctpMessage message) {
           received_messages_.emplace_back(std::move(message));
@@ -88,6 +94,12 @@ class MockDcSctpSocketCallbacks : public DcSctpSocketCallbacks {
               (rtc::ArrayView<const uint8_t> data),
               (override));
 
+  MOCK_METHOD(void,
+              SendPackets,
+              (rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+               rtc::ArrayView<SendPacketStatus> statuses),
+              (override));
+
   std::unique_ptr<Timeout> CreateTimeout(
       webrtc::TaskQueueBase::DelayPrecision precision) override {
     // The fake timeout manager does not implement |precision|.
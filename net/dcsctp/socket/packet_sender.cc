@@ -13,13 +13,17 @@
 #include <vector>
 
 #include "net/dcsctp/public/types.h"
+#include "rtc_base/checks.h"
 
 namespace dcsctp {
 
 PacketSender::PacketSender(DcSctpSocketCallbacks& callbacks,
                            std::function<void(rtc::ArrayView<const uint8_t>,
-                                              SendPacketStatus)> on_sent_packet)
-    : callbacks_(callbacks), on_sent_packet_(std::move(on_sent_packet)) {}
+                                              SendPacketStatus)> on_sent_packet,
+                           bool send_in_batches)
+    : callbacks_(callbacks),
+      on_sent_packet_(std::move(on_sent_packet)),
+      send_in_batches_(send_in_batches) {}
 
 bool PacketSender::Send(SctpPacket::Builder& builder) {
   if (builder.empty()) {
@@ -28,6 +32,11 @@ bool PacketSender::Send(SctpPacket::Builder& builder) {
 
   std::vector<uint8_t> payload = builder.Build();
 
+  if (in_batch_) {
+    batch_.push_back(std::move(payload));
+    return true;
+  }
+
   SendPacketStatus status = callbacks_.SendPacketWithStatus(payload);
   on_sent_packet_(payload, status);
   switch (status) {
@@ -45,4 +54,27 @@ bool PacketSender::Send(SctpPacket::Builder& builder) {
     }
   }
 }
+
+void PacketSender::BeginBatch() {
+  // Public methods of the socket don't call each other, and any callback that
+  // may call into the library is deferred until the batch has been sent.
+  RTC_DCHECK(!in_batch_);
+  in_batch_ = send_in_batches_;
+}
+
+void PacketSender::EndBatch() {
+  in_batch_ = false;
+  if (batch_.empty()) {
+    return;
+  }
+
+  batch_views_.assign(batch_.begin(), batch_.end());
+  batch_statuses_.assign(batch_.size(), SendPacketStatus::kError);
+  callbacks_.SendPackets(batch_views_, batch_statuses_);
+  for (size_t i = 0; i < batch_.size(); ++i) {
+    on_sent_packet_(batch_[i], batch_statuses_[i]);
+  }
+  batch_.clear();
+  batch_views_.clear();
+}
 }  // namespace dcsctp
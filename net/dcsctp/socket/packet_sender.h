@@ -10,6 +10,12 @@
 #ifndef NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 #define NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include "api/array_view.h"
 #include "net/dcsctp/packet/sctp_packet.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 
@@ -18,22 +24,51 @@ namespace dcsctp {
 // The PacketSender sends packets to the network using the provided callback
 // interface. When an attempt to send a packet is made, the `on_sent_packet`
 // callback will be triggered.
+//
+// If `send_in_batches` is set, the packets that are sent while a
+// `ScopedBatch` is alive are held back, and sent all together using
+// `DcSctpSocketCallbacks::SendPackets` when it goes out of scope.
 class PacketSender {
  public:
+  class ScopedBatch {
+   public:
+    explicit ScopedBatch(PacketSender& packet_sender)
+        : packet_sender_(packet_sender) {
+      packet_sender_.BeginBatch();
+    }
+
+    ~ScopedBatch() { packet_sender_.EndBatch(); }
+
+   private:
+    PacketSender& packet_sender_;
+  };
+
   PacketSender(DcSctpSocketCallbacks& callbacks,
                std::function<void(rtc::ArrayView<const uint8_t>,
-                                  SendPacketStatus)> on_sent_packet);
+                                  SendPacketStatus)> on_sent_packet,
+               bool send_in_batches = false);
 
-  // Sends the packet, and returns true if it was sent successfully.
+  // Sends the packet, and returns true if it was sent successfully. A packet
+  // that is added to a batch is considered to be sent successfully.
   bool Send(SctpPacket::Builder& builder);
 
  private:
+  void BeginBatch();
+  void EndBatch();
+
   DcSctpSocketCallbacks& callbacks_;
 
   // Callback that will be triggered for every send attempt, indicating the
   // status of the operation.
   std::function<void(rtc::ArrayView<const uint8_t>, SendPacketStatus)>
       on_sent_packet_;
+
+  const bool send_in_batches_;
+  bool in_batch_ = false;
+  // The packets of the current batch, and scratch space for sending them.
+  std::vector<std::vector<uint8_t>> batch_;
+  std::vector<rtc::ArrayView<const uint8_t>> batch_views_;
+  std::vector<SendPacketStatus> batch_statuses_;
 };
 }  // namespace dcsctp
 
@@ -46,5 +46,51 @@ TEST_F(PacketSenderTest, SendPacketCallsCallback) {
   EXPECT_FALSE(sender_.Send(PacketBuilder().Add(CookieAckChunk())));
 }
 
+TEST_F(PacketSenderTest, SendsImmediatelyInBatchIfBatchingIsDisabled) {
+  PacketSender::ScopedBatch batch(sender_);
+  EXPECT_CALL(callbacks_, SendPacketWithStatus);
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess));
+  EXPECT_TRUE(sender_.Send(PacketBuilder().Add(CookieAckChunk())));
+}
+
+TEST_F(PacketSenderTest, SendsBatchWhenGoingOutOfScope) {
+  PacketSender sender(callbacks_, on_send_fn_.AsStdFunction(),
+                      /*send_in_batches=*/true);
+  {
+    PacketSender::ScopedBatch batch(sender);
+    EXPECT_CALL(callbacks_, SendPacketWithStatus).Times(0);
+    EXPECT_CALL(on_send_fn_, Call).Times(0);
+    EXPECT_TRUE(sender.Send(PacketBuilder().Add(CookieAckChunk())));
+    EXPECT_TRUE(sender.Send(PacketBuilder().Add(CookieAckChunk())));
+    testing::Mock::VerifyAndClearExpectations(&callbacks_);
+    testing::Mock::VerifyAndClearExpectations(&on_send_fn_);
+
+    EXPECT_CALL(callbacks_, SendPacketWithStatus).Times(2);
+    EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess)).Times(2);
+  }
+  testing::Mock::VerifyAndClearExpectations(&callbacks_);
+  testing::Mock::VerifyAndClearExpectations(&on_send_fn_);
+
+  // Outside of a batch, packets are sent immediately.
+  EXPECT_CALL(callbacks_, SendPacketWithStatus);
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess));
+  EXPECT_TRUE(sender.Send(PacketBuilder().Add(CookieAckChunk())));
+}
+
+TEST_F(PacketSenderTest, ReportsStatusOfEachPacketInBatch) {
+  PacketSender sender(callbacks_, on_send_fn_.AsStdFunction(),
+                      /*send_in_batches=*/true);
+  testing::InSequence s;
+  EXPECT_CALL(callbacks_, SendPacketWithStatus)
+      .WillOnce(testing::Return(SendPacketStatus::kSuccess))
+      .WillOnce(testing::Return(SendPacketStatus::kTemporaryFailure));
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess));
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kTemporaryFailure));
+
+  PacketSender::ScopedBatch batch(sender);
+  EXPECT_TRUE(sender.Send(PacketBuilder().Add(CookieAckChunk())));
+  EXPECT_TRUE(sender.Send(PacketBuilder().Add(CookieAckChunk())));
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -10,7 +10,7 @@
 #ifndef NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 #define NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 
-#include <map>
+#include <deque>
 #include <set>
 #include <utility>
 #include <vector>
@@ -21,6 +21,7 @@
 #include "net/dcsctp/packet/chunk/iforward_tsn_chunk.h"
 #include "net/dcsctp/packet/chunk/sack_chunk.h"
 #include "net/dcsctp/packet/data.h"
+#include "rtc_base/checks.h"
 
 namespace dcsctp {
 
@@ -246,9 +247,22 @@ class OutstandingData {
       bool is_in_fast_recovery,
       OutstandingData::AckInfo& ack_info);
 
-  // Acks the chunk referenced by `iter` and updates state in `ack_info` and the
-  // object's state.
-  void AckChunk(AckInfo& ack_info, std::map<UnwrappedTSN, Item>::iterator iter);
+  // Returns the TSN of the item at `index` in `outstanding_data_`.
+  UnwrappedTSN GetTsn(size_t index) const {
+    return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                               static_cast<int>(index + 1));
+  }
+
+  // Returns the index in `outstanding_data_` of `tsn`, which must be greater
+  // than `last_cumulative_tsn_ack_`.
+  size_t GetIndex(UnwrappedTSN tsn) const {
+    RTC_DCHECK(tsn > last_cumulative_tsn_ack_);
+    return UnwrappedTSN::Difference(tsn, last_cumulative_tsn_ack_) - 1;
+  }
+
+  // Acks the chunk `item`, having TSN `tsn`, and updates state in `ack_info`
+  // and the object's state.
+  void AckChunk(AckInfo& ack_info, UnwrappedTSN tsn, Item& item);
 
   // Helper method to nack an item and perform the correct operations given the
   // action indicated when nacking an item (e.g. retransmitting or abandoning).
@@ -272,7 +286,11 @@ class OutstandingData {
   // Callback when to discard items from the send queue.
   std::function<bool(IsUnordered, StreamID, MID)> discard_from_send_queue_;
 
-  std::map<UnwrappedTSN, Item> outstanding_data_;
+  // All chunks after `last_cumulative_tsn_ack_`, indexed by their TSN. As TSNs
+  // are assigned consecutively and only removed when cumulatively acked, the
+  // item at index `i` has TSN `last_cumulative_tsn_ack_ + 1 + i`, which lets
+  // SACKs be processed without any lookups.
+  std::deque<Item> outstanding_data_;
   // The number of bytes that are in-flight (sent but not yet acked or nacked).
   size_t outstanding_bytes_ = 0;
   // The number of DATA chunks that are in-flight (sent but not yet acked or
@@ -381,6 +381,56 @@ TEST_F(OutstandingDataTest, AckWithGapBlocksFromRFC4960Section334) {
                           Pair(TSN(17), State::kAcked)));
 }
 
+TEST_F(OutstandingDataTest, AcksEveryOtherChunkInLargeWindow) {
+  constexpr int kNumChunks = 1000;
+  for (int i = 0; i < kNumChunks; ++i) {
+    buf_.Insert(gen_.Ordered({1}, i == 0 ? "B" : ""), MaxRetransmits::NoLimit(),
+                kNow, TimeMs::InfiniteFuture());
+  }
+
+  // Ack TSN 10, and then every other chunk from TSN 12.
+  std::vector<SackChunk::GapAckBlock> gab;
+  for (int offset = 2; offset < kNumChunks; offset += 2) {
+    gab.emplace_back(offset, offset);
+  }
+  OutstandingData::AckInfo ack =
+      buf_.HandleSack(unwrapper_.Unwrap(TSN(10)), gab, false);
+
+  EXPECT_EQ(ack.bytes_acked,
+            (1 + gab.size()) * (DataChunk::kHeaderSize + RoundUpTo4(1)));
+  EXPECT_EQ(ack.highest_tsn_acked.Wrap(), TSN(10 + kNumChunks - 2));
+  EXPECT_EQ(buf_.last_cumulative_tsn_ack().Wrap(), TSN(10));
+
+  // The last chunk is above the highest acked TSN, so it's not nacked.
+  EXPECT_EQ(buf_.outstanding_items(), 1u);
+  std::vector<std::pair<TSN, State>> states = buf_.GetChunkStatesForTesting();
+  ASSERT_EQ(states.size(), static_cast<size_t>(kNumChunks));
+  for (size_t i = 1; i + 1 < states.size(); ++i) {
+    EXPECT_EQ(states[i].first, TSN(10 + i));
+    EXPECT_EQ(states[i].second, i % 2 == 0 ? State::kAcked : State::kNacked);
+  }
+  EXPECT_EQ(states.back().second, State::kInFlight);
+}
+
+TEST_F(OutstandingDataTest, IgnoresGapAckBlocksBeyondOutstandingData) {
+  buf_.Insert(gen_.Ordered({1}, "B"), MaxRetransmits::NoLimit(), kNow,
+              TimeMs::InfiniteFuture());
+  buf_.Insert(gen_.Ordered({1}, "E"), MaxRetransmits::NoLimit(), kNow,
+              TimeMs::InfiniteFuture());
+
+  std::vector<SackChunk::GapAckBlock> gab = {SackChunk::GapAckBlock(2, 5),
+                                             SackChunk::GapAckBlock(8, 9)};
+  OutstandingData::AckInfo ack =
+      buf_.HandleSack(unwrapper_.Unwrap(TSN(9)), gab, false);
+  EXPECT_EQ(ack.bytes_acked, DataChunk::kHeaderSize + RoundUpTo4(1));
+  EXPECT_EQ(ack.highest_tsn_acked.Wrap(), TSN(11));
+
+  EXPECT_THAT(buf_.GetChunkStatesForTesting(),
+              ElementsAre(Pair(TSN(9), State::kAcked),    //
+                          Pair(TSN(10), State::kNacked),  //
+                          Pair(TSN(11), State::kAcked)));
+}
+
 TEST_F(OutstandingDataTest, MeasureRTT) {
   buf_.Insert(gen_.Ordered({1}, "BE"), MaxRetransmits::NoLimit(), kNow,
               TimeMs::InfiniteFuture());
@@ -9,10 +9,12 @@
  */
 #include "net/dcsctp/tx/rr_send_queue.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <limits>
 #include <map>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -21,9 +23,11 @@
 #include "api/array_view.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/tx/send_queue.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
 namespace dcsctp {
@@ -33,9 +37,13 @@ RRSendQueue::RRSendQueue(absl::string_view log_prefix,
                          std::function<void(StreamID)> on_buffered_amount_low,
                          size_t total_buffered_amount_low_threshold,
                          std::function<void()> on_total_buffered_amount_low,
+                         StreamScheduler stream_scheduler,
+                         StreamPriority default_priority,
                          const DcSctpSocketHandoverState* handover_state)
     : log_prefix_(std::string(log_prefix) + "fcfs: "),
       buffer_size_(buffer_size),
+      stream_scheduler_(stream_scheduler),
+      default_priority_(default_priority),
       on_buffered_amount_low_(std::move(on_buffered_amount_low)),
       total_buffered_amount_(std::move(on_total_buffered_amount_low)) {
   total_buffered_amount_.SetLowThreshold(total_buffered_amount_low_threshold);
@@ -72,12 +80,21 @@ void RRSendQueue::OutgoingStream::AddHandoverState(
   state.next_ssn = next_ssn_.value();
   state.next_ordered_mid = next_ordered_mid_.value();
   state.next_unordered_mid = next_unordered_mid_.value();
+  state.priority = priority_.value();
 }
 
 bool RRSendQueue::IsConsistent() const {
   size_t total_buffered_amount = 0;
+  size_t num_scheduled_streams = 0;
   for (const auto& [unused, stream] : streams_) {
     total_buffered_amount += stream.buffered_amount().value();
+    if (stream.scheduled_as().has_value()) {
+      ++num_scheduled_streams;
+    }
+  }
+  if (num_scheduled_streams != scheduled_streams_.size()) {
+    RTC_DLOG(LS_ERROR) << "Scheduled streams are out of sync";
+    return false;
   }
 
   if (previous_message_has_ended_) {
@@ -293,8 +310,10 @@ void RRSendQueue::Add(TimeMs now,
     // lifetime (which may be zero).
     expires_at = now + *send_options.lifetime + DurationMs(1);
   }
-  GetOrCreateStreamInfo(message.stream_id())
-      .Add(std::move(message), expires_at, send_options);
+  StreamID stream_id = message.stream_id();
+  OutgoingStream& stream = GetOrCreateStreamInfo(stream_id);
+  stream.Add(std::move(message), expires_at, send_options);
+  ScheduleStream(stream_id, stream);
   RTC_DCHECK(IsConsistent());
 }
 
@@ -326,14 +345,66 @@ RRSendQueue::GetNextStream(TimeMs now) {
   return streams_.end();
 }
 
+std::map<StreamID, RRSendQueue::OutgoingStream>::iterator
+RRSendQueue::GetNextScheduledStream(TimeMs now) {
+  while (!scheduled_streams_.empty()) {
+    auto it = streams_.find(scheduled_streams_.begin()->stream_id);
+    RTC_DCHECK(it != streams_.end());
+    if (it->second.HasDataToSend(now)) {
+      current_stream_id_ = it->first;
+      return it;
+    }
+    // The stream is paused, or all its messages have expired. It will be
+    // scheduled again when resumed or when new messages are added.
+    UnscheduleStream(it->second);
+  }
+  return streams_.end();
+}
+
+void RRSendQueue::ScheduleStream(StreamID stream_id, OutgoingStream& stream) {
+  if (stream_scheduler_ == StreamScheduler::kRoundRobin ||
+      stream.scheduled_as().has_value() || !stream.has_messages() ||
+      (!previous_message_has_ended_ && stream_id == current_stream_id_)) {
+    return;
+  }
+
+  uint64_t rank;
+  if (stream_scheduler_ == StreamScheduler::kStrictPriority) {
+    rank = std::numeric_limits<StreamPriority::UnderlyingType>::max() -
+           *stream.priority();
+  } else {
+    // The message will have been sent after its size has been divided between
+    // the streams, in proportion to their priority, starting from when the
+    // message that is currently sent, or that was previously sent on this
+    // stream, will have been sent.
+    RTC_DCHECK_GT(*stream.priority(), 0);
+    rank = std::max(virtual_time_, stream.virtual_finish_time()) +
+           (static_cast<uint64_t>(stream.next_message_size()) << 16) /
+               *stream.priority();
+  }
+
+  ScheduledStream scheduled_as{rank, next_sequence_++, stream_id};
+  scheduled_streams_.insert(scheduled_as);
+  stream.set_scheduled_as(scheduled_as);
+}
+
+void RRSendQueue::UnscheduleStream(OutgoingStream& stream) {
+  if (stream.scheduled_as().has_value()) {
+    scheduled_streams_.erase(*stream.scheduled_as());
+    stream.set_scheduled_as(absl::nullopt);
+  }
+}
+
 absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
                                                            size_t max_size) {
   std::map<StreamID, RRSendQueue::OutgoingStream>::iterator stream_it;
 
   if (previous_message_has_ended_) {
-    // Previous message has ended. Round-robin to a different stream, if there
-    // even is one with data to send.
-    stream_it = GetNextStream(now);
+    // Previous message has ended. Select a different stream, if there even is
+    // one with data to send.
+    stream_it = stream_scheduler_ == StreamScheduler::kRoundRobin
+                    ? GetNextStream(now)
+                    : GetNextScheduledStream(now);
     if (stream_it == streams_.end()) {
       RTC_DLOG(LS_VERBOSE)
           << log_prefix_
@@ -360,7 +431,15 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
                          << ", ppid=" << *data->data.ppid
                          << ", length=" << data->data.payload.size();
 
+    OutgoingStream& stream = stream_it->second;
+    if (stream.scheduled_as().has_value()) {
+      // A new message is being sent from this stream.
+      virtual_time_ = stream.scheduled_as()->rank;
+      stream.set_virtual_finish_time(virtual_time_);
+      UnscheduleStream(stream);
+    }
     previous_message_has_ended_ = *data->data.is_end;
+    ScheduleStream(stream_it->first, stream);
   }
 
   RTC_DCHECK(IsConsistent());
@@ -370,12 +449,13 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
 bool RRSendQueue::Discard(IsUnordered unordered,
                           StreamID stream_id,
                           MID message_id) {
-  bool has_discarded =
-      GetOrCreateStreamInfo(stream_id).Discard(unordered, message_id);
+  OutgoingStream& stream = GetOrCreateStreamInfo(stream_id);
+  bool has_discarded = stream.Discard(unordered, message_id);
   if (has_discarded) {
     // Only partially sent messages are discarded, so if a message was
     // discarded, then it was the currently sent message.
     previous_message_has_ended_ = true;
+    ScheduleStream(stream_id, stream);
   }
 
   return has_discarded;
@@ -400,17 +480,19 @@ bool RRSendQueue::CanResetStreams() const {
 }
 
 void RRSendQueue::CommitResetStreams() {
-  for (auto& [unused, stream] : streams_) {
+  for (auto& [stream_id, stream] : streams_) {
     if (stream.is_paused()) {
       stream.Reset();
     }
+    ScheduleStream(stream_id, stream);
   }
   RTC_DCHECK(IsConsistent());
 }
 
 void RRSendQueue::RollbackResetStreams() {
-  for (auto& [unused, stream] : streams_) {
+  for (auto& [stream_id, stream] : streams_) {
     stream.Resume();
+    ScheduleStream(stream_id, stream);
   }
   RTC_DCHECK(IsConsistent());
 }
@@ -422,6 +504,9 @@ void RRSendQueue::Reset() {
     stream.Reset();
   }
   previous_message_has_ended_ = true;
+  for (auto& [stream_id, stream] : streams_) {
+    ScheduleStream(stream_id, stream);
+  }
 }
 
 size_t RRSendQueue::buffered_amount(StreamID stream_id) const {
@@ -445,6 +530,27 @@ void RRSendQueue::SetBufferedAmountLowThreshold(StreamID stream_id,
   GetOrCreateStreamInfo(stream_id).buffered_amount().SetLowThreshold(bytes);
 }
 
+void RRSendQueue::SetStreamPriority(StreamID stream_id,
+                                    StreamPriority priority) {
+  RTC_DCHECK_GT(*priority, 0);
+  OutgoingStream& stream = GetOrCreateStreamInfo(stream_id);
+  stream.set_priority(priority);
+  if (stream.scheduled_as().has_value()) {
+    // Re-schedule the stream, using its new priority.
+    UnscheduleStream(stream);
+    ScheduleStream(stream_id, stream);
+  }
+  RTC_DCHECK(IsConsistent());
+}
+
+StreamPriority RRSendQueue::GetStreamPriority(StreamID stream_id) const {
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    return default_priority_;
+  }
+  return it->second.priority();
+}
+
 RRSendQueue::OutgoingStream& RRSendQueue::GetOrCreateStreamInfo(
     StreamID stream_id) {
   auto it = streams_.find(stream_id);
@@ -456,7 +562,7 @@ RRSendQueue::OutgoingStream& RRSendQueue::GetOrCreateStreamInfo(
       .emplace(stream_id,
                OutgoingStream(
                    [this, stream_id]() { on_buffered_amount_low_(stream_id); },
-                   total_buffered_amount_))
+                   total_buffered_amount_, default_priority_))
       .first->second;
 }
 
@@ -481,11 +587,17 @@ void RRSendQueue::RestoreFromState(const DcSctpSocketHandoverState& state) {
   for (const DcSctpSocketHandoverState::OutgoingStream& state_stream :
        state.tx.streams) {
     StreamID stream_id(state_stream.id);
+    // States from before stream priorities were handed over have no priority.
+    StreamPriority priority =
+        state_stream.priority != 0
+            ? StreamPriority(static_cast<uint16_t>(state_stream.priority))
+            : default_priority_;
     streams_.emplace(stream_id, OutgoingStream(
                                     [this, stream_id]() {
                                       on_buffered_amount_low_(stream_id);
                                     },
-                                    total_buffered_amount_, &state_stream));
+                                    total_buffered_amount_, priority,
+                                    &state_stream));
   }
 }
 }  // namespace dcsctp
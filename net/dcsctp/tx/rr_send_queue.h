@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <deque>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -21,6 +22,7 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/tx/send_queue.h"
@@ -36,6 +38,10 @@ namespace dcsctp {
 // possibly a different stream, until support for message interleaving has been
 // implemented.
 //
+// Which stream to send from next is decided by the `StreamScheduler`. Apart
+// from round-robin, it can select streams by strict priority (RFC8260, 3.4)
+// or by weighted fair queuing (RFC8260, 3.6), using the stream priorities.
+//
 // As messages can be (requested to be) sent before the connection is properly
 // established, this send queue is always present - even for closed connections.
 class RRSendQueue : public SendQueue {
@@ -48,6 +54,8 @@ class RRSendQueue : public SendQueue {
               std::function<void(StreamID)> on_buffered_amount_low,
               size_t total_buffered_amount_low_threshold,
               std::function<void()> on_total_buffered_amount_low,
+              StreamScheduler stream_scheduler,
+              StreamPriority default_priority,
               const DcSctpSocketHandoverState* handover_state = nullptr);
 
   // Indicates if the buffer is full. Note that it's up to the caller to ensure
@@ -81,6 +89,11 @@ class RRSendQueue : public SendQueue {
   size_t buffered_amount_low_threshold(StreamID stream_id) const override;
   void SetBufferedAmountLowThreshold(StreamID stream_id, size_t bytes) override;
 
+  // Sets and returns the priority of a stream, which is used by the priority
+  // based stream schedulers.
+  void SetStreamPriority(StreamID stream_id, StreamPriority priority);
+  StreamPriority GetStreamPriority(StreamID stream_id) const;
+
   HandoverReadinessStatus GetHandoverReadiness() const;
   void AddHandoverState(DcSctpSocketHandoverState& state);
   void RestoreFromState(const DcSctpSocketHandoverState& state);
@@ -109,14 +122,33 @@ class RRSendQueue : public SendQueue {
     size_t low_threshold_ = 0;
   };
 
+  // A stream that is waiting to be sent from, when using a priority based
+  // stream scheduler. Streams are sent from in increasing order.
+  struct ScheduledStream {
+    // For weighted fair queuing, the virtual time when the stream's next
+    // message will have been sent. For strict priority, the inverted priority.
+    uint64_t rank;
+    // Breaks ties in `rank`, in the order streams were scheduled, which makes
+    // streams with the same rank take turns.
+    uint64_t sequence;
+    StreamID stream_id;
+
+    bool operator<(const ScheduledStream& other) const {
+      return rank < other.rank ||
+             (rank == other.rank && sequence < other.sequence);
+    }
+  };
+
   // Per-stream information.
   class OutgoingStream {
    public:
     explicit OutgoingStream(
         std::function<void()> on_buffered_amount_low,
         ThresholdWatcher& total_buffered_amount,
+        StreamPriority priority,
         const DcSctpSocketHandoverState::OutgoingStream* state = nullptr)
-        : next_unordered_mid_(MID(state ? state->next_unordered_mid : 0)),
+        : priority_(priority),
+          next_unordered_mid_(MID(state ? state->next_unordered_mid : 0)),
           next_ordered_mid_(MID(state ? state->next_ordered_mid : 0)),
           next_ssn_(SSN(state ? state->next_ssn : 0)),
           buffered_amount_(std::move(on_buffered_amount_low)),
@@ -150,6 +182,27 @@ class RRSendQueue : public SendQueue {
     // Indicates if this stream has a partially sent message in it.
     bool has_partially_sent_message() const;
 
+    // Indicates if this stream has any message in it, and the (remaining) size
+    // of the first one.
+    bool has_messages() const { return !items_.empty(); }
+    size_t next_message_size() const { return items_.front().remaining_size; }
+
+    StreamPriority priority() const { return priority_; }
+    void set_priority(StreamPriority priority) { priority_ = priority; }
+
+    // Where this stream is in `RRSendQueue::scheduled_streams_`, if in it.
+    const absl::optional<ScheduledStream>& scheduled_as() const {
+      return scheduled_as_;
+    }
+    void set_scheduled_as(absl::optional<ScheduledStream> scheduled_as) {
+      scheduled_as_ = scheduled_as;
+    }
+
+    // For weighted fair queuing, the virtual time when the message that was
+    // last started to be sent from this stream will have been sent.
+    uint64_t virtual_finish_time() const { return virtual_finish_time_; }
+    void set_virtual_finish_time(uint64_t time) { virtual_finish_time_ = time; }
+
     // Indicates if the stream has data to send. It will also try to remove any
     // expired non-partially sent message.
     bool HasDataToSend(TimeMs now);
@@ -185,6 +238,10 @@ class RRSendQueue : public SendQueue {
 
     bool IsConsistent() const;
 
+    StreamPriority priority_;
+    absl::optional<ScheduledStream> scheduled_as_;
+    uint64_t virtual_finish_time_ = 0;
+
     // Streams are pause when they are about to be reset.
     bool is_paused_ = false;
     // MIDs are different for unordered and ordered messages sent on a stream.
@@ -213,8 +270,22 @@ class RRSendQueue : public SendQueue {
   // Return the next stream, in round-robin fashion.
   std::map<StreamID, OutgoingStream>::iterator GetNextStream(TimeMs now);
 
+  // Return the next stream, as decided by the priority based stream
+  // schedulers. The stream remains scheduled until a message is produced from
+  // it.
+  std::map<StreamID, OutgoingStream>::iterator GetNextScheduledStream(
+      TimeMs now);
+
+  // Adds `stream` to `scheduled_streams_`, unless it's already in it, it has
+  // no messages, or it's sending a message. Only used by the priority based
+  // stream schedulers.
+  void ScheduleStream(StreamID stream_id, OutgoingStream& stream);
+  void UnscheduleStream(OutgoingStream& stream);
+
   const std::string log_prefix_;
   const size_t buffer_size_;
+  const StreamScheduler stream_scheduler_;
+  const StreamPriority default_priority_;
 
   // Called when the buffered amount is below what has been set using
   // `SetBufferedAmountLowThreshold`.
@@ -238,6 +309,15 @@ class RRSendQueue : public SendQueue {
 
   // All streams, and messages added to those.
   std::map<StreamID, OutgoingStream> streams_;
+
+  // Streams that have messages to send, in the order they will be sent from,
+  // when using a priority based stream scheduler.
+  std::set<ScheduledStream> scheduled_streams_;
+  // Incremented for each stream added to `scheduled_streams_`.
+  uint64_t next_sequence_ = 0;
+  // For weighted fair queuing, the virtual finish time of the message that was
+  // last started to be sent.
+  uint64_t virtual_time_ = 0;
 };
 }  // namespace dcsctp
 
@@ -13,7 +13,9 @@
 #include <type_traits>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "net/dcsctp/packet/data.h"
+#include "net/dcsctp/public/dcsctp_handover_state.h"
 #include "net/dcsctp/public/dcsctp_message.h"
 #include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
@@ -25,6 +27,7 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::ElementsAre;
 using ::testing::SizeIs;
 
 constexpr TimeMs kNow = TimeMs(0);
@@ -34,6 +37,7 @@ constexpr size_t kMaxQueueSize = 1000;
 constexpr size_t kBufferedAmountLowThreshold = 500;
 constexpr size_t kOneFragmentPacketSize = 100;
 constexpr size_t kTwoFragmentPacketSize = 101;
+constexpr size_t kSmallMessageSize = 10;
 
 class RRSendQueueTest : public testing::Test {
  protected:
@@ -42,7 +46,9 @@ class RRSendQueueTest : public testing::Test {
              kMaxQueueSize,
              on_buffered_amount_low_.AsStdFunction(),
              kBufferedAmountLowThreshold,
-             on_total_buffered_amount_low_.AsStdFunction()) {}
+             on_total_buffered_amount_low_.AsStdFunction(),
+             options_.stream_scheduler,
+             options_.default_stream_priority) {}
 
   const DcSctpOptions options_;
   testing::NiceMock<testing::MockFunction<void(StreamID)>>
@@ -779,5 +785,147 @@ TEST_F(RRSendQueueTest, WillStayInStreamWhenOnlySmallFragmentRemaining) {
 
   EXPECT_FALSE(buf_.Produce(kNow, 8).has_value());
 }
+
+TEST_F(RRSendQueueTest, StrictPrioritySendsFromHighestPriorityStreamFirst) {
+  RRSendQueue buf("log: ", kMaxQueueSize,
+                  on_buffered_amount_low_.AsStdFunction(),
+                  kBufferedAmountLowThreshold,
+                  on_total_buffered_amount_low_.AsStdFunction(),
+                  StreamScheduler::kStrictPriority, StreamPriority(256));
+  buf.SetStreamPriority(StreamID(1), StreamPriority(128));
+  buf.SetStreamPriority(StreamID(2), StreamPriority(512));
+  buf.SetStreamPriority(StreamID(3), StreamPriority(512));
+  for (int i = 0; i < 2; ++i) {
+    for (uint16_t stream_id : {1, 2, 3}) {
+      buf.Add(kNow, DcSctpMessage(StreamID(stream_id), kPPID,
+                                  std::vector<uint8_t>(kSmallMessageSize)));
+    }
+  }
+
+  // Streams with the same priority take turns.
+  std::vector<StreamID> sent;
+  while (absl::optional<SendQueue::DataToSend> chunk =
+             buf.Produce(kNow, kOneFragmentPacketSize)) {
+    sent.push_back(chunk->data.stream_id);
+  }
+  EXPECT_THAT(sent, ElementsAre(StreamID(2), StreamID(3), StreamID(2),
+                                StreamID(3), StreamID(1), StreamID(1)));
+}
+
+TEST_F(RRSendQueueTest, WeightedFairQueuingSharesBytesByPriority) {
+  RRSendQueue buf("log: ", kMaxQueueSize,
+                  on_buffered_amount_low_.AsStdFunction(),
+                  kBufferedAmountLowThreshold,
+                  on_total_buffered_amount_low_.AsStdFunction(),
+                  StreamScheduler::kWeightedFairQueueing, StreamPriority(256));
+  buf.SetStreamPriority(StreamID(1), StreamPriority(100));
+  buf.SetStreamPriority(StreamID(2), StreamPriority(300));
+  for (int i = 0; i < 8; ++i) {
+    for (uint16_t stream_id : {1, 2}) {
+      buf.Add(kNow, DcSctpMessage(StreamID(stream_id), kPPID,
+                                  std::vector<uint8_t>(kSmallMessageSize)));
+    }
+  }
+
+  std::vector<StreamID> sent;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk,
+                                buf.Produce(kNow, kOneFragmentPacketSize));
+    sent.push_back(chunk.data.stream_id);
+  }
+  EXPECT_THAT(sent, ElementsAre(StreamID(2), StreamID(2), StreamID(2),
+                                StreamID(1), StreamID(2), StreamID(2),
+                                StreamID(2), StreamID(1)));
+}
+
+TEST_F(RRSendQueueTest, WeightedFairQueuingLetsSmallMessagesOvertakeLarge) {
+  RRSendQueue buf("log: ", kMaxQueueSize,
+                  on_buffered_amount_low_.AsStdFunction(),
+                  kBufferedAmountLowThreshold,
+                  on_total_buffered_amount_low_.AsStdFunction(),
+                  StreamScheduler::kWeightedFairQueueing, StreamPriority(256));
+  // Stream 1 is a bulk transfer, and stream 2 sends small messages.
+  for (int i = 0; i < 3; ++i) {
+    buf.Add(kNow, DcSctpMessage(StreamID(1), kPPID,
+                                std::vector<uint8_t>(kOneFragmentPacketSize)));
+  }
+  for (int i = 0; i < 3; ++i) {
+    buf.Add(kNow, DcSctpMessage(StreamID(2), kPPID,
+                                std::vector<uint8_t>(kSmallMessageSize)));
+  }
+
+  // As the streams get the same share of bytes, all small messages are sent
+  // before the second large message.
+  std::vector<StreamID> sent;
+  while (absl::optional<SendQueue::DataToSend> chunk =
+             buf.Produce(kNow, kOneFragmentPacketSize)) {
+    sent.push_back(chunk->data.stream_id);
+  }
+  EXPECT_THAT(sent, ElementsAre(StreamID(2), StreamID(2), StreamID(2),
+                                StreamID(1), StreamID(1), StreamID(1)));
+}
+
+TEST_F(RRSendQueueTest, ChangingPriorityReschedulesStream) {
+  RRSendQueue buf("log: ", kMaxQueueSize,
+                  on_buffered_amount_low_.AsStdFunction(),
+                  kBufferedAmountLowThreshold,
+                  on_total_buffered_amount_low_.AsStdFunction(),
+                  StreamScheduler::kStrictPriority, StreamPriority(256));
+  buf.Add(kNow, DcSctpMessage(StreamID(1), kPPID,
+                              std::vector<uint8_t>(kSmallMessageSize)));
+  buf.Add(kNow, DcSctpMessage(StreamID(2), kPPID,
+                              std::vector<uint8_t>(kSmallMessageSize)));
+  buf.SetStreamPriority(StreamID(2), StreamPriority(512));
+  EXPECT_EQ(buf.GetStreamPriority(StreamID(2)), StreamPriority(512));
+  EXPECT_EQ(buf.GetStreamPriority(StreamID(3)), StreamPriority(256));
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk1,
+                              buf.Produce(kNow, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk1.data.stream_id, StreamID(2));
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk2,
+                              buf.Produce(kNow, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk2.data.stream_id, StreamID(1));
+}
+
+TEST_F(RRSendQueueTest, PriorityBasedSchedulersSkipPausedStreams) {
+  RRSendQueue buf("log: ", kMaxQueueSize,
+                  on_buffered_amount_low_.AsStdFunction(),
+                  kBufferedAmountLowThreshold,
+                  on_total_buffered_amount_low_.AsStdFunction(),
+                  StreamScheduler::kStrictPriority, StreamPriority(256));
+  buf.SetStreamPriority(StreamID(1), StreamPriority(512));
+  StreamID streams_to_reset[] = {StreamID(1)};
+  buf.PrepareResetStreams(streams_to_reset);
+
+  // Messages added while the stream is paused are sent when it's resumed.
+  buf.Add(kNow, DcSctpMessage(StreamID(1), kPPID,
+                              std::vector<uint8_t>(kSmallMessageSize)));
+  buf.Add(kNow, DcSctpMessage(StreamID(2), kPPID,
+                              std::vector<uint8_t>(kSmallMessageSize)));
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk1,
+                              buf.Produce(kNow, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk1.data.stream_id, StreamID(2));
+  EXPECT_FALSE(buf.Produce(kNow, kOneFragmentPacketSize).has_value());
+
+  buf.RollbackResetStreams();
+  ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk2,
+                              buf.Produce(kNow, kOneFragmentPacketSize));
+  EXPECT_EQ(chunk2.data.stream_id, StreamID(1));
+}
+
+TEST_F(RRSendQueueTest, HandsOverStreamPriorities) {
+  buf_.SetStreamPriority(StreamID(1), StreamPriority(42));
+
+  DcSctpSocketHandoverState state;
+  buf_.AddHandoverState(state);
+  RRSendQueue restored("log: ", kMaxQueueSize,
+                       on_buffered_amount_low_.AsStdFunction(),
+                       kBufferedAmountLowThreshold,
+                       on_total_buffered_amount_low_.AsStdFunction(),
+                       options_.stream_scheduler,
+                       options_.default_stream_priority);
+  restored.RestoreFromState(state);
+  EXPECT_EQ(restored.GetStreamPriority(StreamID(1)), StreamPriority(42));
+}
 }  // namespace
 }  // namespace dcsctp
@@ -102,26 +102,28 @@ void AsyncStunTCPSocket::ProcessInput(char* data, size_t* len) {
   // |         Channel Number        |            Length             |
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
-  while (true) {
-    // We need at least 4 bytes to read the STUN or ChannelData packet length.
-    if (*len < kPacketLenOffset + kPacketLenSize)
-      return;
-
+  // Packets are signaled straight out of `data`, and whatever is left of an
+  // incomplete packet is moved to the front once all complete ones are done.
+  size_t processed = 0;
+  // We need at least 4 bytes to read the STUN or ChannelData packet length.
+  while (*len - processed >= kPacketLenOffset + kPacketLenSize) {
     int pad_bytes;
-    size_t expected_pkt_len = GetExpectedLength(data, *len, &pad_bytes);
+    size_t expected_pkt_len =
+        GetExpectedLength(data + processed, *len - processed, &pad_bytes);
     size_t actual_length = expected_pkt_len + pad_bytes;
 
-    if (*len < actual_length) {
-      return;
+    if (*len - processed < actual_length) {
+      break;
     }
 
-    SignalReadPacket(this, data, expected_pkt_len, remote_addr,
+    SignalReadPacket(this, data + processed, expected_pkt_len, remote_addr,
                      rtc::TimeMicros());
+    processed += actual_length;
+  }
 
-    *len -= actual_length;
-    if (*len > 0) {
-      memmove(data, data + actual_length, *len);
-    }
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -164,6 +164,31 @@ TEST_F(AsyncStunTCPSocketTest, TestMultipleStunPackets) {
   EXPECT_EQ(4u, recv_packets_.size());
 }
 
+// Verify that packets which arrive together are all delivered, in order, and
+// that a padded ChannelData message between them doesn't break the framing.
+TEST_F(AsyncStunTCPSocketTest, TestPacketsReceivedInOneRead) {
+  rtc::PacketOptions options;
+  EXPECT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+            send_socket_->Send(kStunMessageWithZeroLength,
+                               sizeof(kStunMessageWithZeroLength), options));
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+            send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                               sizeof(kTurnChannelDataMessageWithOddLength),
+                               options));
+  EXPECT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessage)),
+            send_socket_->Send(kTurnChannelDataMessage,
+                               sizeof(kTurnChannelDataMessage), options));
+  vss_->ProcessMessagesUntilIdle();
+
+  EXPECT_EQ(3u, recv_packets_.size());
+  EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                        sizeof(kStunMessageWithZeroLength)));
+  EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                        sizeof(kTurnChannelDataMessageWithOddLength)));
+  EXPECT_TRUE(
+      CheckData(kTurnChannelDataMessage, sizeof(kTurnChannelDataMessage)));
+}
+
 // Verifying TURN channel data message with zero length.
 TEST_F(AsyncStunTCPSocketTest, TestTurnChannelDataWithZeroLength) {
   EXPECT_TRUE(Send(kTurnChannelDataMessageWithZeroLength,
@@ -53,6 +53,33 @@ int CompareCandidatePairsByNetworkPreference(
   return a_and_b_equal;
 }
 
+// Sorts `connections` like absl::c_stable_sort does, but with an insertion sort
+// while that is cheaper. As few connections change between two sorts, they are
+// mostly in order already, and then only the changed connections are moved,
+// with a linear number of comparisons. If too many connections have to be
+// moved, the remaining ones are sorted with absl::c_stable_sort. Since the
+// insertion sort is stable as well, the result is the same either way.
+template <typename Less>
+void IncrementalStableSort(std::vector<const cricket::Connection*>& connections,
+                           Less less) {
+  size_t moves_left = connections.size();
+  for (size_t i = 1; i < connections.size(); ++i) {
+    const cricket::Connection* connection = connections[i];
+    size_t j = i;
+    while (j > 0 && less(connection, connections[j - 1])) {
+      if (moves_left == 0) {
+        connections[j] = connection;
+        absl::c_stable_sort(connections, less);
+        return;
+      }
+      --moves_left;
+      connections[j] = connections[j - 1];
+      --j;
+    }
+    connections[j] = connection;
+  }
+}
+
 }  // namespace
 
 namespace cricket {
@@ -116,6 +143,23 @@ IceControllerInterface::PingResult BasicIceController::SelectConnectionToPing(
   return res;
 }
 
+std::vector<const Connection*> BasicIceController::FindConnectionsToPingWith(
+    const Connection* pinged,
+    int window_ms) const {
+  std::vector<const Connection*> connections;
+  // While the channel is weak the checks are paced one at a time.
+  if (weak()) {
+    return connections;
+  }
+  int64_t due = rtc::TimeMillis() + window_ms;
+  for (const Connection* conn : connections_) {
+    if (conn != pinged && conn->writable() && IsPingable(conn, due)) {
+      connections.push_back(conn);
+    }
+  }
+  return connections;
+}
+
 void BasicIceController::MarkConnectionPinged(const Connection* conn) {
   if (conn && pinged_connections_.insert(conn).second) {
     unpinged_connections_.erase(conn);
@@ -298,9 +342,15 @@ bool BasicIceController::IsPingable(const Connection* conn, int64_t now) const {
   // Always ping active connections regardless whether the channel is completed
   // or not, but backup connections are pinged at a slower rate.
   if (IsBackupConnection(conn)) {
-    return conn->rtt_samples() == 0 ||
-           (now >= conn->last_ping_response_received() +
-                       config_.backup_connection_ping_interval_or_default());
+    if (conn->rtt_samples() == 0) {
+      return true;
+    }
+    if (IsWarmBackupConnection(conn)) {
+      return now >=
+             conn->last_ping_sent() + *field_trials_->warm_backup_ping_interval;
+    }
+    return now >= conn->last_ping_response_received() +
+                      config_.backup_connection_ping_interval_or_default();
   }
   // Don't ping inactive non-backup connections.
   if (!conn->active()) {
@@ -324,6 +374,15 @@ bool BasicIceController::IsBackupConnection(const Connection* conn) const {
          conn != selected_connection_ && conn->active();
 }
 
+// A backup connection is kept warm if it is on a network interface other than
+// the one of the selected connection, e.g. cellular while on Wi-Fi, and would
+// take over if that interface went away.
+bool BasicIceController::IsWarmBackupConnection(const Connection* conn) const {
+  return field_trials_->warm_backup_ping_interval.has_value() &&
+         selected_connection_ &&
+         conn->network()->name() != selected_connection_->network()->name();
+}
+
 const Connection* BasicIceController::MorePingable(const Connection* conn1,
                                                    const Connection* conn2) {
   RTC_DCHECK(conn1 != conn2);
@@ -529,8 +588,7 @@ BasicIceController::SortAndSwitchConnection(IceControllerEvent reason) {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
+  IncrementalStableSort(
       connections_, [this](const Connection* a, const Connection* b) {
         int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
         if (cmp != 0) {
@@ -41,6 +41,9 @@ class BasicIceController : public IceControllerInterface {
   bool HasPingableConnection() const override;
 
   PingResult SelectConnectionToPing(int64_t last_ping_sent_ms) override;
+  std::vector<const Connection*> FindConnectionsToPingWith(
+      const Connection* pinged,
+      int window_ms) const override;
 
   bool GetUseCandidateAttr(const Connection* conn,
                            NominationMode mode,
@@ -93,6 +96,7 @@ class BasicIceController : public IceControllerInterface {
 
   bool IsPingable(const Connection* conn, int64_t now) const;
   bool IsBackupConnection(const Connection* conn) const;
+  bool IsWarmBackupConnection(const Connection* conn) const;
   // Whether a writable connection is past its ping interval and needs to be
   // pinged again.
   bool WritableConnectionPastPingInterval(const Connection* conn,
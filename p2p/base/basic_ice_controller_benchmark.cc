@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures how BasicIceController ranks many candidate pairs, as it does on
+// every state change of a connection.
+
+#include <memory>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/candidate.h"
+#include "benchmark/benchmark.h"
+#include "p2p/base/basic_ice_controller.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/connection.h"
+#include "p2p/base/ice_controller_factory_interface.h"
+#include "p2p/base/p2p_constants.h"
+#include "p2p/base/p2p_transport_channel_ice_field_trials.h"
+#include "p2p/base/port.h"
+#include "p2p/base/stun_port.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/network.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+
+namespace cricket {
+namespace {
+
+const rtc::SocketAddress kLocalAddr("11.11.11.11", 0);
+
+// A controlled ICE agent with `num_connections` candidate pairs, all from one
+// local port to remote candidates of different priorities.
+class IceControllerFixture {
+ public:
+  explicit IceControllerFixture(int num_connections)
+      : thread_(&vss_),
+        network_("unittest", "unittest", kLocalAddr.ipaddr(), 32),
+        socket_factory_(&vss_),
+        controller_(IceControllerFactoryArgs{
+            [] { return IceTransportState::STATE_CONNECTING; },
+            [] { return ICEROLE_CONTROLLED; },
+            [](const Connection*) { return false; }, &field_trials_, ""}) {
+    network_.AddIP(kLocalAddr.ipaddr());
+    port_ = UDPPort::Create(&thread_, &socket_factory_, &network_,
+                            /*min_port=*/0, /*max_port=*/0, "lfrag",
+                            "localpasswordlocalpassw",
+                            /*emit_local_for_anyaddress=*/false,
+                            /*stun_keepalive_interval=*/absl::nullopt);
+    RTC_CHECK(port_);
+    port_->SetIceRole(ICEROLE_CONTROLLED);
+    port_->PrepareAddress();
+    RTC_CHECK(!port_->Candidates().empty());
+
+    for (int i = 0; i < num_connections; ++i) {
+      Candidate remote(ICE_CANDIDATE_COMPONENT_RTP, UDP_PROTOCOL_NAME,
+                       rtc::SocketAddress("22.22.22.22", 1000 + i),
+                       /*priority=*/1000 + i, "rfrag",
+                       "remotepasswordremotepass", LOCAL_PORT_TYPE,
+                       /*generation=*/0, std::to_string(i));
+      Connection* connection =
+          port_->CreateConnection(remote, PortInterface::ORIGIN_MESSAGE);
+      RTC_CHECK(connection);
+      controller_.AddConnection(connection);
+    }
+  }
+
+  BasicIceController& controller() { return controller_; }
+
+ private:
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::Network network_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  IceFieldTrials field_trials_;
+  BasicIceController controller_;
+  std::unique_ptr<UDPPort> port_;
+};
+
+// Ranks connections whose states didn't change since they were last ranked.
+void BM_SortUnchangedConnections(benchmark::State& state) {
+  IceControllerFixture fixture(state.range(0));
+  BasicIceController& controller = fixture.controller();
+  controller.SortAndSwitchConnection(IceControllerEvent::CONNECT_STATE_CHANGE);
+  for (auto s : state) {
+    benchmark::DoNotOptimize(controller.SortAndSwitchConnection(
+        IceControllerEvent::CONNECT_STATE_CHANGE));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SortUnchangedConnections)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Complexity();
+
+// Ranks connections after the worst one has been nominated by the remote
+// controlling agent, which makes it the best one.
+void BM_SortAfterNomination(benchmark::State& state) {
+  IceControllerFixture fixture(state.range(0));
+  BasicIceController& controller = fixture.controller();
+  controller.SortAndSwitchConnection(IceControllerEvent::CONNECT_STATE_CHANGE);
+  uint32_t nomination = 0;
+  for (auto s : state) {
+    const Connection* worst = controller.connections().back();
+    const_cast<Connection*>(worst)->set_remote_nomination(++nomination);
+    benchmark::DoNotOptimize(controller.SortAndSwitchConnection(
+        IceControllerEvent::NOMINATION_ON_CONTROLLED_SIDE));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SortAfterNomination)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Complexity();
+
+}  // namespace
+}  // namespace cricket
@@ -251,9 +251,9 @@ void ConnectionRequest::Prepare(StunMessage* request) {
   if (connection_->ShouldSendGoogPing(request)) {
     request->SetType(GOOG_PING_REQUEST);
     request->ClearAttributes();
-    request->AddMessageIntegrity32(connection_->remote_candidate().password());
+    request->AddMessageIntegrity32(connection_->remote_integrity_key());
   } else {
-    request->AddMessageIntegrity(connection_->remote_candidate().password());
+    request->AddMessageIntegrity(connection_->remote_integrity_key());
     request->AddFingerprint();
   }
 }
@@ -505,6 +505,10 @@ void Connection::OnSendStunPacket(const void* data,
   rtc::PacketOptions options(port_->StunDscpValue());
   options.info_signaled_after_sent.packet_type =
       rtc::PacketType::kIceConnectivityCheck;
+  if (sending_batched_ping_) {
+    options.batchable = true;
+    options.last_packet_in_batch = sending_last_batched_ping_;
+  }
   auto err =
       port_->SendTo(data, size, remote_candidate_.address(), options, false);
   if (err < 0) {
@@ -547,7 +551,7 @@ void Connection::OnReadPacket(const char* data,
     // If this is a STUN response, then update the writable bit.
     // Log at LS_INFO if we receive a ping on an unwritable connection.
     rtc::LoggingSeverity sev = (!writable() ? rtc::LS_INFO : rtc::LS_VERBOSE);
-    msg->ValidateMessageIntegrity(remote_candidate().password());
+    msg->ValidateMessageIntegrity(remote_integrity_key());
     switch (msg->type()) {
       case STUN_BINDING_REQUEST:
         RTC_LOG_V(sev) << ToString() << ": Received "
@@ -752,7 +756,7 @@ void Connection::SendStunBindingResponse(const StunMessage* request) {
     }
   }
 
-  response.AddMessageIntegrity(local_candidate().password());
+  response.AddMessageIntegrity(local_integrity_key());
   response.AddFingerprint();
 
   SendResponseMessage(response);
@@ -766,7 +770,7 @@ void Connection::SendGoogPingResponse(const StunMessage* request) {
   StunMessage response;
   response.SetType(GOOG_PING_RESPONSE);
   response.SetTransactionID(request->transaction_id());
-  response.AddMessageIntegrity32(local_candidate().password());
+  response.AddMessageIntegrity32(local_integrity_key());
   SendResponseMessage(response);
 }
 
@@ -992,6 +996,16 @@ void Connection::Ping(int64_t now) {
   num_pings_sent_++;
 }
 
+void Connection::PingInBatch(int64_t now, bool last_in_batch) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  // The request is sent right away, see StunRequestManager::Send(), so only
+  // the first transmission is batched and retransmissions go out on their own.
+  sending_batched_ping_ = true;
+  sending_last_batched_ping_ = last_in_batch;
+  Ping(now);
+  sending_batched_ping_ = false;
+}
+
 int64_t Connection::last_ping_response_received() const {
   RTC_DCHECK_RUN_ON(network_thread_);
   return last_ping_response_received_;
@@ -1581,6 +1595,20 @@ bool Connection::ShouldSendGoogPing(const StunMessage* message) {
   return false;
 }
 
+// RTC_RUN_ON(network_thread_).
+const StunMessageIntegrityKey& Connection::local_integrity_key() {
+  local_integrity_key_.SetPassword(local_candidate().password());
+  return local_integrity_key_;
+}
+
+// RTC_RUN_ON(network_thread_).
+const StunMessageIntegrityKey& Connection::remote_integrity_key() {
+  // The remote password may be set after the connection is created, see
+  // MaybeSetRemoteIceParametersAndGeneration().
+  remote_integrity_key_.SetPassword(remote_candidate_.password());
+  return remote_integrity_key_;
+}
+
 void Connection::ForgetLearnedState() {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_LOG(LS_INFO) << ToString() << ": Connection forget learned state";
@@ -204,6 +204,9 @@ class Connection : public CandidatePairInterface, public sigslot::has_slots<> {
   // Called when this connection should try checking writability again.
   int64_t last_ping_sent() const;
   void Ping(int64_t now);
+  // Like Ping(), but lets the socket hold the ping back until one is sent with
+  // `last_in_batch` set, so that they go out in one batched send.
+  void PingInBatch(int64_t now, bool last_in_batch);
   void ReceivedPingResponse(
       int rtt,
       const std::string& request_id,
@@ -388,6 +391,13 @@ class Connection : public CandidatePairInterface, public sigslot::has_slots<> {
   bool ShouldSendGoogPing(const StunMessage* message)
       RTC_RUN_ON(network_thread_);
 
+  // Return the keys that sign and validate messages with the passwords of the
+  // local and the remote candidate.
+  const StunMessageIntegrityKey& local_integrity_key()
+      RTC_RUN_ON(network_thread_);
+  const StunMessageIntegrityKey& remote_integrity_key()
+      RTC_RUN_ON(network_thread_);
+
   WriteState write_state_ RTC_GUARDED_BY(network_thread_);
   bool receiving_ RTC_GUARDED_BY(network_thread_);
   bool connected_ RTC_GUARDED_BY(network_thread_);
@@ -421,6 +431,9 @@ class Connection : public CandidatePairInterface, public sigslot::has_slots<> {
       RTC_GUARDED_BY(network_thread_);
   int64_t last_ping_sent_ RTC_GUARDED_BY(
       network_thread_);  // last time we sent a ping to the other side
+  // Set while PingInBatch() sends its request.
+  bool sending_batched_ping_ RTC_GUARDED_BY(network_thread_) = false;
+  bool sending_last_batched_ping_ RTC_GUARDED_BY(network_thread_) = false;
   int64_t last_ping_received_
       RTC_GUARDED_BY(network_thread_);  // last time we received a ping from the
                                         // other side
@@ -458,6 +471,10 @@ class Connection : public CandidatePairInterface, public sigslot::has_slots<> {
   std::unique_ptr<StunMessage> cached_stun_binding_
       RTC_GUARDED_BY(network_thread_);
 
+  StunMessageIntegrityKey local_integrity_key_ RTC_GUARDED_BY(network_thread_);
+  StunMessageIntegrityKey remote_integrity_key_
+      RTC_GUARDED_BY(network_thread_);
+
   const IceFieldTrials* field_trials_;
   rtc::EventBasedExponentialMovingAverage rtt_estimate_
       RTC_GUARDED_BY(network_thread_);
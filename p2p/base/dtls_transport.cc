@@ -324,6 +324,19 @@ bool DtlsTransport::ExportKeyingMaterial(const std::string& label,
              : false;
 }
 
+void DtlsTransport::SetSessionCache(
+    rtc::scoped_refptr<rtc::SSLSessionCache> cache) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(!dtls_);
+  session_cache_ = std::move(cache);
+}
+
+void DtlsTransport::SetHandshakeTaskQueue(webrtc::TaskQueueBase* task_queue) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(!dtls_);
+  handshake_task_queue_ = task_queue;
+}
+
 bool DtlsTransport::SetupDtls() {
   RTC_DCHECK(dtls_role_);
   {
@@ -342,6 +355,12 @@ bool DtlsTransport::SetupDtls() {
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
   dtls_->SetServerRole(*dtls_role_);
+  if (session_cache_) {
+    dtls_->SetSessionCache(session_cache_);
+  }
+  if (handshake_task_queue_) {
+    dtls_->SetHandshakeTaskQueue(handshake_task_queue_);
+  }
   dtls_->SignalEvent.connect(this, &DtlsTransport::OnDtlsEvent);
   dtls_->SignalSSLHandshakeError.connect(this,
                                          &DtlsTransport::OnDtlsHandshakeError);
@@ -17,7 +17,9 @@
 
 #include "api/crypto/crypto_options.h"
 #include "api/dtls_transport_interface.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "rtc_base/buffer.h"
@@ -190,6 +192,15 @@ class DtlsTransport : public DtlsTransportInternal {
 
   int SetOption(rtc::Socket::Option opt, int value) override;
 
+  // Lets the DTLS handshakes of this and other transports that share `cache`
+  // resume each other's sessions, which skips the certificate signatures and
+  // key exchange. Must be called before DTLS is set up.
+  void SetSessionCache(rtc::scoped_refptr<rtc::SSLSessionCache> cache);
+  // Makes the handshake signatures with the local private key on `task_queue`
+  // instead of the network thread. `task_queue` must outlive this transport.
+  // Must be called before DTLS is set up.
+  void SetHandshakeTaskQueue(webrtc::TaskQueueBase* task_queue);
+
   std::string ToString() const {
     const absl::string_view RECEIVING_ABBREV[2] = {"_", "R"};
     const absl::string_view WRITABLE_ABBREV[2] = {"_", "W"};
@@ -239,6 +250,8 @@ class DtlsTransport : public DtlsTransportInternal {
   rtc::scoped_refptr<rtc::RTCCertificate> local_certificate_;
   absl::optional<rtc::SSLRole> dtls_role_;
   const rtc::SSLProtocolVersion ssl_max_version_;
+  rtc::scoped_refptr<rtc::SSLSessionCache> session_cache_;
+  webrtc::TaskQueueBase* handshake_task_queue_ = nullptr;
   rtc::Buffer remote_fingerprint_value_;
   std::string remote_fingerprint_algorithm_;
 
@@ -123,6 +123,15 @@ class IceControllerInterface {
   // Select a connection to Ping, or nullptr if none.
   virtual PingResult SelectConnectionToPing(int64_t last_ping_sent_ms) = 0;
 
+  // Returns the connections, other than `pinged`, that only need keepalive
+  // pings and are due for one within `window_ms`, so that they can be pinged
+  // in the same pass as `pinged`.
+  virtual std::vector<const Connection*> FindConnectionsToPingWith(
+      const Connection* pinged,
+      int window_ms) const {
+    return {};
+  }
+
   // Compute the "STUN_ATTR_USE_CANDIDATE" for `conn`.
   virtual bool GetUseCandidateAttr(const Connection* conn,
                                    NominationMode mode,
@@ -737,7 +737,11 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
       "dead_connection_timeout_ms", &field_trials_.dead_connection_timeout_ms,
       // Stop gathering on strongly connected.
       "stop_gather_on_strongly_connected",
-      &field_trials_.stop_gather_on_strongly_connected)
+      &field_trials_.stop_gather_on_strongly_connected,
+      // Keep backup connections on other interfaces verified.
+      "warm_backup_ping_interval", &field_trials_.warm_backup_ping_interval,
+      // Send keepalive pings that are due soon together.
+      "ping_batch_window_ms", &field_trials_.ping_batch_window_ms)
       ->Parse(webrtc::field_trial::FindFullName("WebRTC-IceFieldTrials"));
 
   if (field_trials_.dead_connection_timeout_ms < 30000) {
@@ -766,6 +770,16 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
                      << *field_trials_.initial_select_dampening_ping_received;
   }
 
+  if (field_trials_.warm_backup_ping_interval.has_value()) {
+    RTC_LOG(LS_INFO) << "Set warm_backup_ping_interval: "
+                     << *field_trials_.warm_backup_ping_interval;
+  }
+
+  if (field_trials_.ping_batch_window_ms.has_value()) {
+    RTC_LOG(LS_INFO) << "Set ping_batch_window_ms: "
+                     << *field_trials_.ping_batch_window_ms;
+  }
+
   webrtc::BasicRegatheringController::Config regathering_config;
   regathering_config.regather_on_failed_networks_interval =
       config_.regather_on_failed_networks_interval_or_default();
@@ -2059,8 +2073,20 @@ void P2PTransportChannel::CheckAndPing() {
 
   if (result.connection.value_or(nullptr)) {
     Connection* conn = FromIceController(*result.connection);
-    PingConnection(conn);
-    MarkConnectionPinged(conn);
+    std::vector<Connection*> batch;
+    if (field_trials_.ping_batch_window_ms.has_value()) {
+      for (const Connection* other : ice_controller_->FindConnectionsToPingWith(
+               conn, *field_trials_.ping_batch_window_ms)) {
+        batch.push_back(FromIceController(other));
+      }
+    }
+    if (batch.empty()) {
+      PingConnection(conn);
+      MarkConnectionPinged(conn);
+    } else {
+      batch.insert(batch.begin(), conn);
+      PingConnectionsInBatch(batch);
+    }
   }
 
   network_thread_->PostDelayedTask(
@@ -2089,6 +2115,25 @@ void P2PTransportChannel::MarkConnectionPinged(Connection* conn) {
 // `use_candidate_attr` and `nomination` flags. One of the flags is set to
 // nominate `conn` if this channel is in CONTROLLING.
 void P2PTransportChannel::PingConnection(Connection* conn) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  SetNominationForPing(conn);
+  last_ping_sent_ms_ = rtc::TimeMillis();
+  conn->Ping(last_ping_sent_ms_);
+}
+
+void P2PTransportChannel::PingConnectionsInBatch(
+    const std::vector<Connection*>& connections) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  last_ping_sent_ms_ = rtc::TimeMillis();
+  for (size_t i = 0; i < connections.size(); ++i) {
+    SetNominationForPing(connections[i]);
+    connections[i]->PingInBatch(last_ping_sent_ms_,
+                                /*last_in_batch=*/i + 1 == connections.size());
+    MarkConnectionPinged(connections[i]);
+  }
+}
+
+void P2PTransportChannel::SetNominationForPing(Connection* conn) {
   RTC_DCHECK_RUN_ON(network_thread_);
   bool use_candidate_attr = false;
   uint32_t nomination = 0;
@@ -2104,8 +2149,6 @@ void P2PTransportChannel::PingConnection(Connection* conn) {
   }
   conn->set_nomination(nomination);
   conn->set_use_candidate_attr(use_candidate_attr);
-  last_ping_sent_ms_ = rtc::TimeMillis();
-  conn->Ping(last_ping_sent_ms_);
 }
 
 uint32_t P2PTransportChannel::GetNominationAttr(Connection* conn) const {
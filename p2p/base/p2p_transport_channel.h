@@ -294,6 +294,9 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void RememberRemoteCandidate(const Candidate& remote_candidate,
                                PortInterface* origin_port);
   void PingConnection(Connection* conn);
+  // Pings `connections` in one pass, with their pings sent in a batch.
+  void PingConnectionsInBatch(const std::vector<Connection*>& connections);
+  void SetNominationForPing(Connection* conn);
   void AddAllocatorSession(std::unique_ptr<PortAllocatorSession> session);
   void AddConnection(Connection* connection);
 
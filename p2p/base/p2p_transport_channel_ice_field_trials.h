@@ -62,6 +62,16 @@ struct IceFieldTrials {
   // Stop gathering when having a strong connection.
   bool stop_gather_on_strongly_connected = true;
 
+  // Ping backup connections on a network interface other than the one of the
+  // selected connection every X ms, rather than every
+  // `backup_connection_ping_interval`, so that they stay verified and can take
+  // over without a round of checks when the selected network goes away.
+  absl::optional<int> warm_backup_ping_interval;
+
+  // Along with each ping, send the keepalive pings that are due within X ms,
+  // in one batched send, instead of one ping per pass.
+  absl::optional<int> ping_batch_window_ms;
+
   // DSCP taging.
   absl::optional<int> override_dscp;
 };
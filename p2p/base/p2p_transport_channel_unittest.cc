@@ -3029,6 +3029,90 @@ TEST_F(P2PTransportChannelMultihomedTest, TestPingBackupConnectionRate) {
   DestroyChannels();
 }
 
+// Test that with the field trial warm_backup_ping_interval, a backup
+// connection on a network interface other than the one of the selected
+// connection is pinged at that interval instead of the much longer backup
+// connection ping interval.
+TEST_F(P2PTransportChannelMultihomedTest, TestPingWarmBackupConnectionRate) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-IceFieldTrials/warm_backup_ping_interval:1000/");
+  rtc::ScopedFakeClock clock;
+  auto& wifi = kAlternateAddrs;
+  auto& cellular = kPublicAddrs;
+  AddAddress(0, wifi[0], "test_wifi0", rtc::ADAPTER_TYPE_WIFI);
+  AddAddress(0, cellular[0], "test_cell0", rtc::ADAPTER_TYPE_CELLULAR);
+  AddAddress(1, wifi[1], "test_wifi1", rtc::ADAPTER_TYPE_WIFI);
+  // Use only local ports for simplicity.
+  SetAllocatorFlags(0, kOnlyLocalPorts);
+  SetAllocatorFlags(1, kOnlyLocalPorts);
+
+  IceConfig config = CreateIceConfig(2000, GATHER_ONCE);
+  CreateChannels(config, config);
+  EXPECT_TRUE_SIMULATED_WAIT(
+      CheckCandidatePairAndConnected(ep1_ch1(), ep2_ch1(), wifi[0], wifi[1]),
+      kMediumTimeout, clock);
+  ASSERT_TRUE_SIMULATED_WAIT(
+      ep1_ch1()->GetState() == IceTransportState::STATE_COMPLETED,
+      kDefaultTimeout, clock);
+  const Connection* backup_conn =
+      GetConnectionWithLocalAddress(ep1_ch1(), cellular[0]);
+  ASSERT_TRUE(backup_conn != nullptr);
+  EXPECT_TRUE_SIMULATED_WAIT(
+      backup_conn->writable() && backup_conn->rtt_samples() > 0,
+      kMediumTimeout, clock);
+
+  for (int i = 0; i < 3; ++i) {
+    int64_t last_ping_sent_ms = backup_conn->last_ping_sent();
+    EXPECT_TRUE_SIMULATED_WAIT(
+        backup_conn->last_ping_sent() > last_ping_sent_ms, 2000, clock);
+    EXPECT_GE(backup_conn->last_ping_sent() - last_ping_sent_ms, 1000);
+  }
+  EXPECT_TRUE(backup_conn->writable());
+
+  DestroyChannels();
+}
+
+// Test that with the field trial ping_batch_window_ms, the keepalive pings of
+// connections that are due at about the same time are sent in the same pass.
+TEST_F(P2PTransportChannelMultihomedTest, TestPingKeepalivesInBatch) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-IceFieldTrials/ping_batch_window_ms:1000/");
+  rtc::ScopedFakeClock clock;
+  AddAddress(0, kPublicAddrs[0]);
+  // Adding alternate address will make sure `kPublicAddrs` has the higher
+  // priority than others. This is due to FakeNetwork::AddInterface method.
+  AddAddress(1, kAlternateAddrs[1]);
+  AddAddress(1, kPublicAddrs[1]);
+
+  // Use only local ports for simplicity.
+  SetAllocatorFlags(0, kOnlyLocalPorts);
+  SetAllocatorFlags(1, kOnlyLocalPorts);
+
+  CreateChannels();
+  EXPECT_TRUE_SIMULATED_WAIT(CheckConnected(ep1_ch1(), ep2_ch1()),
+                             kMediumTimeout, clock);
+  // The selected connection and the backup connection are pinged at the same
+  // interval, though not in phase.
+  int ping_interval_ms = 2500;
+  IceConfig config =
+      CreateIceConfig(2 * ping_interval_ms, GATHER_ONCE, ping_interval_ms);
+  config.stable_writable_connection_ping_interval = ping_interval_ms;
+  ep2_ch1()->SetIceConfig(config);
+  ASSERT_TRUE_SIMULATED_WAIT(
+      ep2_ch1()->GetState() == IceTransportState::STATE_COMPLETED,
+      kDefaultTimeout, clock);
+  auto connections = ep2_ch1()->connections();
+  ASSERT_EQ(2U, connections.size());
+
+  int64_t start_ms = rtc::TimeMillis();
+  EXPECT_TRUE_SIMULATED_WAIT(
+      connections[0]->last_ping_sent() > start_ms &&
+          connections[0]->last_ping_sent() == connections[1]->last_ping_sent(),
+      2 * ping_interval_ms, clock);
+
+  DestroyChannels();
+}
+
 // Test that the connection is pinged at a rate no faster than
 // what was configured when stable and writable.
 TEST_F(P2PTransportChannelMultihomedTest, TestStableWritableRate) {
@@ -488,7 +488,7 @@ bool Port::GetStunMessage(const char* data,
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (stun_msg->ValidateMessageIntegrity(integrity_key()) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -555,7 +555,7 @@ bool Port::GetStunMessage(const char* data,
     // No stun attributes will be verified, if it's stun indication message.
     // Returning from end of the this method.
   } else if (stun_msg->type() == GOOG_PING_REQUEST) {
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (stun_msg->ValidateMessageIntegrity(integrity_key()) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -764,9 +764,9 @@ void Port::SendBindingErrorResponse(StunMessage* request,
       error_code != STUN_ERROR_UNAUTHORIZED &&
       request->type() != GOOG_PING_REQUEST) {
     if (request->type() == STUN_BINDING_REQUEST) {
-      response.AddMessageIntegrity(password_);
+      response.AddMessageIntegrity(integrity_key());
     } else {
-      response.AddMessageIntegrity32(password_);
+      response.AddMessageIntegrity32(integrity_key());
     }
   }
 
@@ -810,7 +810,7 @@ void Port::SendUnknownAttributesErrorResponse(
   }
   response.AddAttribute(std::move(unknown_attr));
 
-  response.AddMessageIntegrity(password_);
+  response.AddMessageIntegrity(integrity_key());
   response.AddFingerprint();
 
   // Send the response message.
@@ -925,6 +925,12 @@ void Port::OnConnectionDestroyed(Connection* conn) {
   }
 }
 
+const StunMessageIntegrityKey& Port::integrity_key() {
+  // The password changes rarely, when the ICE parameters do.
+  integrity_key_.SetPassword(password_);
+  return integrity_key_;
+}
+
 void Port::Destroy() {
   RTC_DCHECK(connections_.empty());
   RTC_LOG(LS_INFO) << ToString() << ": Port deleted";
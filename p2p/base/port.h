@@ -451,6 +451,9 @@ class Port : public PortInterface,
   // Called when one of our connections deletes itself.
   void OnConnectionDestroyed(Connection* conn);
 
+  // Returns the key that signs and validates messages with `password_`.
+  const StunMessageIntegrityKey& integrity_key();
+
   void OnNetworkTypeChanged(const rtc::Network* network);
 
   rtc::Thread* const thread_;
@@ -473,6 +476,7 @@ class Port : public PortInterface,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  StunMessageIntegrityKey integrity_key_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
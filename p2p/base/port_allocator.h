@@ -88,6 +88,12 @@ enum {
   // Exclude link-local network interfaces
   // from considertaion after adapter enumeration.
   PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000,
+
+  // When specified along with PORTALLOCATOR_ENABLE_SHARED_SOCKET, the UDP
+  // ports of all sessions share one UDP socket per network, instead of one per
+  // session, and the packets received on it are demultiplexed to the sessions.
+  // TURN ports over UDP then use sockets of their own.
+  PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS = 0x20000,
 };
 
 // Defines various reasons that have caused ICE regathering.
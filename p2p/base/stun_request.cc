@@ -10,6 +10,8 @@
 
 #include "p2p/base/stun_request.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <vector>
@@ -18,13 +20,12 @@
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/time_utils.h"  // For TimeMillis
 #include "system_wrappers/include/field_trial.h"
 
 namespace cricket {
 
-const uint32_t MSG_STUN_SEND = 1;
-
 // RFC 5389 says SHOULD be 500ms.
 // For years, this was 100ms, but for networks that
 // experience moments of high RTT (such as 2G networks), this doesn't
@@ -57,25 +58,34 @@ void StunRequestManager::Send(StunRequest* request) {
 }
 
 void StunRequestManager::SendDelayed(StunRequest* request, int delay) {
+  RTC_DCHECK(thread_->IsCurrent());
   request->set_manager(this);
-  RTC_DCHECK(requests_.find(request->id()) == requests_.end());
+  absl::optional<TransactionId> id = ToTransactionId(request->id());
+  RTC_CHECK(id);
+  RTC_DCHECK(requests_.find(*id) == requests_.end());
   request->Construct();
-  requests_[request->id()] = request;
+  requests_[*id] = request;
   if (delay > 0) {
-    thread_->PostDelayed(RTC_FROM_HERE, delay, request, MSG_STUN_SEND, NULL);
+    request->PostSendTask(delay);
   } else {
-    thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
+    request->SendOrTimeout();
   }
 }
 
 void StunRequestManager::Flush(int msg_type) {
+  // Sending may time out and delete a request, so it can't be done while
+  // iterating over `requests_`.
+  std::vector<StunRequest*> requests;
   for (const auto& kv : requests_) {
     StunRequest* request = kv.second;
     if (msg_type == kAllRequests || msg_type == request->type()) {
-      thread_->Clear(request, MSG_STUN_SEND);
-      thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
+      requests.push_back(request);
     }
   }
+  for (StunRequest* request : requests) {
+    request->CancelSendTask();
+    request->SendOrTimeout();
+  }
 }
 
 bool StunRequestManager::HasRequest(int msg_type) {
@@ -90,11 +100,12 @@ bool StunRequestManager::HasRequest(int msg_type) {
 
 void StunRequestManager::Remove(StunRequest* request) {
   RTC_DCHECK(request->manager() == this);
-  RequestMap::iterator iter = requests_.find(request->id());
+  absl::optional<TransactionId> id = ToTransactionId(request->id());
+  RequestMap::iterator iter = id ? requests_.find(*id) : requests_.end();
   if (iter != requests_.end()) {
     RTC_DCHECK(iter->second == request);
     requests_.erase(iter);
-    thread_->Clear(request);
+    request->task_safety_->SetNotAlive();
   }
 }
 
@@ -111,7 +122,8 @@ void StunRequestManager::Clear() {
 }
 
 bool StunRequestManager::CheckResponse(StunMessage* msg) {
-  RequestMap::iterator iter = requests_.find(msg->transaction_id());
+  absl::optional<TransactionId> id = ToTransactionId(msg->transaction_id());
+  RequestMap::iterator iter = id ? requests_.find(*id) : requests_.end();
   if (iter == requests_.end()) {
     // TODO(pthatcher): Log unknown responses without being too spammy
     // in the logs.
@@ -164,8 +176,8 @@ bool StunRequestManager::CheckResponse(const char* data, size_t size) {
   if (size < 20)
     return false;
 
-  std::string id;
-  id.append(data + kStunTransactionIdOffset, kStunTransactionIdLength);
+  TransactionId id;
+  memcpy(id.data(), data + kStunTransactionIdOffset, kStunTransactionIdLength);
 
   RequestMap::iterator iter = requests_.find(id);
   if (iter == requests_.end()) {
@@ -180,24 +192,49 @@ bool StunRequestManager::CheckResponse(const char* data, size_t size) {
   std::unique_ptr<StunMessage> response(iter->second->msg_->CreateNew());
   if (!response->Read(&buf)) {
     RTC_LOG(LS_WARNING) << "Failed to read STUN response "
-                        << rtc::hex_encode(id);
+                        << rtc::hex_encode(id.data(), id.size());
     return false;
   }
 
   return CheckResponse(response.get());
 }
 
+size_t StunRequestManager::TransactionIdHash::operator()(
+    const TransactionId& id) const {
+  // The IDs are random, so any of their bytes make a good hash.
+  size_t hash;
+  memcpy(&hash, id.data(), std::min(sizeof(hash), id.size()));
+  return hash;
+}
+
+// static
+absl::optional<StunRequestManager::TransactionId>
+StunRequestManager::ToTransactionId(absl::string_view id) {
+  TransactionId transaction_id;
+  if (id.size() != transaction_id.size()) {
+    return absl::nullopt;
+  }
+  memcpy(transaction_id.data(), id.data(), id.size());
+  return transaction_id;
+}
+
 StunRequest::StunRequest()
     : count_(0),
       timeout_(false),
       manager_(0),
       msg_(new StunMessage()),
-      tstamp_(0) {
+      tstamp_(0),
+      task_safety_(webrtc::PendingTaskSafetyFlag::CreateDetached()) {
   msg_->SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
 }
 
 StunRequest::StunRequest(StunMessage* request)
-    : count_(0), timeout_(false), manager_(0), msg_(request), tstamp_(0) {
+    : count_(0),
+      timeout_(false),
+      manager_(0),
+      msg_(request),
+      tstamp_(0),
+      task_safety_(webrtc::PendingTaskSafetyFlag::CreateDetached()) {
   msg_->SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
 }
 
@@ -205,8 +242,8 @@ StunRequest::~StunRequest() {
   RTC_DCHECK(manager_ != NULL);
   if (manager_) {
     manager_->Remove(this);
-    manager_->thread_->Clear(this);
   }
+  task_safety_->SetNotAlive();
   delete msg_;
 }
 
@@ -239,9 +276,18 @@ void StunRequest::set_manager(StunRequestManager* manager) {
   manager_ = manager;
 }
 
-void StunRequest::OnMessage(rtc::Message* pmsg) {
+void StunRequest::PostSendTask(int delay) {
+  manager_->thread_->PostDelayedTask(
+      webrtc::ToQueuedTask(task_safety_, [this] { SendOrTimeout(); }), delay);
+}
+
+void StunRequest::CancelSendTask() {
+  task_safety_->SetNotAlive();
+  task_safety_ = webrtc::PendingTaskSafetyFlag::CreateDetached();
+}
+
+void StunRequest::SendOrTimeout() {
   RTC_DCHECK(manager_ != NULL);
-  RTC_DCHECK(pmsg->message_id == MSG_STUN_SEND);
 
   if (timeout_) {
     OnTimeout();
@@ -256,8 +302,7 @@ void StunRequest::OnMessage(rtc::Message* pmsg) {
   manager_->SignalSendPacket(buf.Data(), buf.Length(), this);
 
   OnSent();
-  manager_->thread_->PostDelayed(RTC_FROM_HERE, resend_delay(), this,
-                                 MSG_STUN_SEND, NULL);
+  PostSendTask(resend_delay());
 }
 
 void StunRequest::OnSent() {
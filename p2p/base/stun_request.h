@@ -14,11 +14,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <map>
+#include <array>
 #include <string>
+#include <unordered_map>
 
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
 #include "api/transport/stun.h"
-#include "rtc_base/message_handler.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
 
@@ -71,7 +75,18 @@ class StunRequestManager {
   sigslot::signal3<const void*, size_t, StunRequest*> SignalSendPacket;
 
  private:
-  typedef std::map<std::string, StunRequest*> RequestMap;
+  // The transaction IDs of requests are kStunTransactionIdLength random bytes,
+  // so they are used as they are for the key, and their first bytes for the
+  // hash, rather than making a std::string of the ID of every response.
+  using TransactionId = std::array<char, kStunTransactionIdLength>;
+  struct TransactionIdHash {
+    size_t operator()(const TransactionId& id) const;
+  };
+  using RequestMap =
+      std::unordered_map<TransactionId, StunRequest*, TransactionIdHash>;
+
+  // Returns nullopt if `id` doesn't have the length of the IDs of requests.
+  static absl::optional<TransactionId> ToTransactionId(absl::string_view id);
 
   rtc::Thread* const thread_;
   RequestMap requests_;
@@ -81,11 +96,11 @@ class StunRequestManager {
 
 // Represents an individual request to be sent.  The STUN message can either be
 // constructed beforehand or built on demand.
-class StunRequest : public rtc::MessageHandler {
+class StunRequest {
  public:
   StunRequest();
   explicit StunRequest(StunMessage* request);
-  ~StunRequest() override;
+  virtual ~StunRequest();
 
   // Causes our wrapped StunMessage to be Prepared
   void Construct();
@@ -133,12 +148,19 @@ class StunRequest : public rtc::MessageHandler {
  private:
   void set_manager(StunRequestManager* manager);
 
-  // Handles messages for sending and timeout.
-  void OnMessage(rtc::Message* pmsg) override;
+  // Posts a task that calls SendOrTimeout() after `delay` ms.
+  void PostSendTask(int delay);
+  // Cancels the task posted for the next transmission, if any.
+  void CancelSendTask();
+  // Sends the request and schedules the next transmission, or times out and
+  // deletes the request once it has been sent for the last time.
+  void SendOrTimeout();
 
   StunRequestManager* manager_;
   StunMessage* msg_;
   int64_t tstamp_;
+  // Guards the task of the next transmission.
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> task_safety_;
 
   friend class StunRequestManager;
 };
@@ -10,8 +10,10 @@
 
 #include "p2p/base/stun_request.h"
 
+#include <memory>
 #include <vector>
 
+#include "rtc_base/byte_buffer.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/logging.h"
@@ -216,4 +218,40 @@ TEST_F(StunRequestTest, TestUnrecognizedComprehensionRequiredAttribute) {
   delete res;
 }
 
+// Test that a response is matched to its request from the raw packet.
+TEST_F(StunRequestTest, TestSuccessFromPacket) {
+  StunMessage* req = CreateStunMessage(STUN_BINDING_REQUEST, NULL);
+
+  manager_.Send(new StunRequestThunker(req, this));
+  std::unique_ptr<StunMessage> res(
+      CreateStunMessage(STUN_BINDING_RESPONSE, req));
+  rtc::ByteBufferWriter buf;
+  res->Write(&buf);
+  EXPECT_TRUE(manager_.CheckResponse(buf.Data(), buf.Length()));
+
+  EXPECT_TRUE(success_);
+  EXPECT_FALSE(failure_);
+  EXPECT_FALSE(timeout_);
+}
+
+// Test that Flush() sends a delayed request right away, and that the delayed
+// send is cancelled.
+TEST_F(StunRequestTest, TestFlush) {
+  rtc::ScopedFakeClock fake_clock;
+  manager_.SendDelayed(
+      new StunRequestThunker(CreateStunMessage(STUN_BINDING_REQUEST, NULL),
+                             this),
+      100);
+  EXPECT_EQ(0, request_count_);
+  manager_.Flush(kAllRequests);
+  EXPECT_EQ(1, request_count_);
+
+  // The first retransmission follows 250 ms after the flush.
+  SIMULATED_WAIT(false, 240, fake_clock);
+  EXPECT_EQ(1, request_count_);
+  SIMULATED_WAIT(false, 20, fake_clock);
+  EXPECT_EQ(2, request_count_);
+  manager_.Clear();
+}
+
 }  // namespace cricket
@@ -10,16 +10,18 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <string.h>
+
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
 #include "api/packet_socket_factory.h"
 #include "api/transport/stun.h"
 #include "p2p/base/async_stun_tcp_socket.h"
 #include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -540,6 +542,24 @@ void TurnServer::Send(TurnServerConnection* conn,
   conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
 }
 
+void TurnServer::SendChannelData(TurnServerConnection* conn,
+                                 uint16_t channel_id,
+                                 const char* data,
+                                 size_t size) {
+  RTC_DCHECK_RUN_ON(thread_);
+  // Only the first packet, or a larger one than so far, grows the buffer.
+  channel_data_buffer_.SetData(
+      TURN_CHANNEL_HEADER_SIZE + size, [&](rtc::ArrayView<uint8_t> buffer) {
+        rtc::SetBE16(&buffer[0], channel_id);
+        rtc::SetBE16(&buffer[2], static_cast<uint16_t>(size));
+        memcpy(&buffer[TURN_CHANNEL_HEADER_SIZE], data, size);
+        return buffer.size();
+      });
+  rtc::PacketOptions options;
+  conn->socket()->SendTo(channel_data_buffer_.data(),
+                         channel_data_buffer_.size(), conn->src(), options);
+}
+
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
   // Removing the internal socket if the connection is not udp.
   rtc::AsyncPacketSocket* socket = allocation->conn()->socket();
@@ -587,6 +607,11 @@ bool TurnServerConnection::operator==(const TurnServerConnection& c) const {
   return src_ == c.src_ && dst_ == c.dst_ && proto_ == c.proto_;
 }
 
+size_t TurnServerConnection::Hash::operator()(
+    const TurnServerConnection& c) const {
+  return (c.src_.Hash() * 31 + c.dst_.Hash()) * 31 + c.proto_;
+}
+
 bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
@@ -614,12 +639,11 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin(); it != channels_.end();
-       ++it) {
-    delete *it;
+  for (const auto& kv : channels_) {
+    delete kv.second;
   }
-  for (PermissionList::iterator it = perms_.begin(); it != perms_.end(); ++it) {
-    delete *it;
+  for (const auto& kv : perms_) {
+    delete kv.second;
   }
   thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
@@ -795,7 +819,8 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    channels_[channel_id] = channel1;
+    channels_by_peer_[channel1->peer()] = channel1;
   } else {
     channel1->Refresh();
   }
@@ -837,11 +862,7 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    server_->SendChannelData(&conn_, channel->id(), data, size);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -880,7 +901,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(this,
                                   &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -888,32 +909,20 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin(); it != perms_.end();
-       ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  auto it = perms_.find(addr);
+  return it != perms_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  auto it = channels_.find(channel_id);
+  return it != channels_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  auto it = channels_by_peer_.find(addr);
+  return it != channels_by_peer_.end() ? it->second : nullptr;
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -946,15 +955,18 @@ void TurnServerAllocation::OnMessage(rtc::Message* msg) {
 }
 
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  auto it = absl::c_find(perms_, perm);
-  RTC_DCHECK(it != perms_.end());
+  auto it = perms_.find(perm->peer());
+  RTC_DCHECK(it != perms_.end() && it->second == perm);
   perms_.erase(it);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  auto it = absl::c_find(channels_, channel);
-  RTC_DCHECK(it != channels_.end());
+  auto it = channels_.find(channel->id());
+  RTC_DCHECK(it != channels_.end() && it->second == channel);
   channels_.erase(it);
+  auto peer_it = channels_by_peer_.find(channel->peer());
+  RTC_DCHECK(peer_it != channels_by_peer_.end() && peer_it->second == channel);
+  channels_by_peer_.erase(peer_it);
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
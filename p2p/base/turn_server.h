@@ -11,17 +11,19 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "api/sequence_checker.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -44,6 +46,10 @@ const int TURN_SERVER_PORT = 3478;
 // Encapsulates the client's connection to the server.
 class TurnServerConnection {
  public:
+  struct Hash {
+    size_t operator()(const TurnServerConnection& c) const;
+  };
+
   TurnServerConnection() : proto_(PROTO_UDP), socket_(NULL) {}
   TurnServerConnection(const rtc::SocketAddress& src,
                        ProtocolType proto,
@@ -93,8 +99,23 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+  struct SocketAddressHash {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  // Permissions and channels are looked up for every relayed packet, so they
+  // are indexed by peer, and channels by id as well.
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHash>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelIdMap;
+  typedef std::unordered_map<rtc::SocketAddress, Channel*, SocketAddressHash>
+      ChannelPeerMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -136,8 +157,10 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   std::string transaction_id_;
   std::string username_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  // The same channels, by id and by peer address.
+  ChannelIdMap channels_;
+  ChannelPeerMap channels_by_peer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -173,7 +196,9 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hash>
       AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
@@ -315,6 +340,12 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  // Sends `size` bytes of `data` to the client as a ChannelData message on
+  // `channel_id`.
+  void SendChannelData(TurnServerConnection* conn,
+                       uint16_t channel_id,
+                       const char* data,
+                       size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation)
       RTC_RUN_ON(thread_);
@@ -350,6 +381,10 @@ class TurnServer : public sigslot::has_slots<> {
 
   AllocationMap allocations_ RTC_GUARDED_BY(thread_);
 
+  // Reused by SendChannelData() for every relayed packet, so that framing a
+  // peer's packet for the client doesn't allocate.
+  rtc::Buffer channel_data_buffer_;
+
   // For testing only. If this is non-zero, the next NONCE will be generated
   // from this value, and it will be reset to 0 after generating the NONCE.
   int64_t ts_for_next_nonce_ RTC_GUARDED_BY(thread_) = 0;
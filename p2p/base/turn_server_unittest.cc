@@ -28,6 +28,7 @@ class TurnServerConnectionTest : public ::testing::Test {
     EXPECT_TRUE(a == b);
     EXPECT_FALSE(a < b);
     EXPECT_FALSE(b < a);
+    EXPECT_EQ(TurnServerConnection::Hash()(a), TurnServerConnection::Hash()(b));
   }
 
   void ExpectNotEqual(const TurnServerConnection& a,
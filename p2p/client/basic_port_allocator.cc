@@ -1234,6 +1234,20 @@ void BasicPortAllocator::SetVpnList(
   network_manager_->set_vpn_list(vpn_list);
 }
 
+void BasicPortAllocator::SetUdpSocketMultiplexer(
+    rtc::scoped_refptr<UdpSocketMultiplexer> udp_socket_multiplexer) {
+  CheckRunOnValidThreadIfInitialized();
+  udp_socket_multiplexer_ = std::move(udp_socket_multiplexer);
+}
+
+UdpSocketMultiplexer* BasicPortAllocator::udp_socket_multiplexer() {
+  CheckRunOnValidThreadIfInitialized();
+  if (!udp_socket_multiplexer_) {
+    udp_socket_multiplexer_ = rtc::make_ref_counted<UdpSocketMultiplexer>();
+  }
+  return udp_socket_multiplexer_.get();
+}
+
 // AllocationSequence
 
 AllocationSequence::AllocationSequence(
@@ -1253,8 +1267,22 @@ AllocationSequence::AllocationSequence(
       port_allocation_complete_callback_(
           std::move(port_allocation_complete_callback)) {}
 
+AllocationSequence::~AllocationSequence() {
+  if (multiplexed_udp_socket_) {
+    udp_socket_multiplexer_->RemoveReceiver(this, multiplexed_udp_socket_);
+  }
+}
+
 void AllocationSequence::Init() {
-  if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
+  if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) &&
+      IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS)) {
+    udp_socket_multiplexer_ = rtc::scoped_refptr<UdpSocketMultiplexer>(
+        session_->allocator()->udp_socket_multiplexer());
+    multiplexed_udp_socket_ = udp_socket_multiplexer_->AddReceiver(
+        this, session_->socket_factory(), network_->GetBestIP(),
+        session_->allocator()->min_port(), session_->allocator()->max_port());
+    // As for `udp_socket_` below, continuing if there is no socket.
+  } else if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
     udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
         rtc::SocketAddress(network_->GetBestIP(), 0),
         session_->allocator()->min_port(), session_->allocator()->max_port()));
@@ -1427,10 +1455,12 @@ void AllocationSequence::CreateUDPPorts() {
   std::unique_ptr<UDPPort> port;
   bool emit_local_candidate_for_anyaddress =
       !IsFlagSet(PORTALLOCATOR_DISABLE_DEFAULT_LOCAL_CANDIDATE);
-  if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) && udp_socket_) {
+  rtc::AsyncPacketSocket* shared_udp_socket =
+      udp_socket_ ? udp_socket_.get() : multiplexed_udp_socket_;
+  if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) && shared_udp_socket) {
     port = UDPPort::Create(
         session_->network_thread(), session_->socket_factory(), network_,
-        udp_socket_.get(), session_->username(), session_->password(),
+        shared_udp_socket, session_->username(), session_->password(),
         emit_local_candidate_for_anyaddress,
         session_->allocator()->stun_candidate_keepalive_interval());
   } else {
@@ -1571,6 +1601,8 @@ void AllocationSequence::CreateTurnPort(const RelayServerConfig& config) {
     // don't pass shared socket for ports which will create TCP sockets.
     // TODO(mallinath) - Enable shared socket mode for TURN ports. Disabled
     // due to webrtc bug https://code.google.com/p/webrtc/issues/detail?id=3537
+    // A socket shared across sessions is never used, as TURN servers tell
+    // allocations apart by the address they are requested from.
     if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) &&
         relay_port->proto == PROTO_UDP && udp_socket_) {
       port = session_->allocator()->relay_port_factory()->Create(
@@ -1658,6 +1690,33 @@ void AllocationSequence::OnPortDestroyed(PortInterface* port) {
   }
 }
 
+const std::string& AllocationSequence::ice_ufrag() const {
+  return session_->username();
+}
+
+bool AllocationSequence::CanHandleIncomingPacketsFrom(
+    const rtc::SocketAddress& remote_addr) const {
+  if (!udp_port_) {
+    return false;
+  }
+  return udp_port_->GetConnection(remote_addr) != nullptr ||
+         udp_port_->server_addresses().count(remote_addr) > 0;
+}
+
+void AllocationSequence::HandleIncomingPacket(
+    rtc::AsyncPacketSocket* socket,
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& remote_addr,
+    int64_t packet_time_us) {
+  RTC_DCHECK(socket == multiplexed_udp_socket_);
+  if (udp_port_) {
+    RTC_DCHECK(udp_port_->SharedSocket());
+    udp_port_->HandleIncomingPacket(socket, data, size, remote_addr,
+                                    packet_time_us);
+  }
+}
+
 // PortConfiguration
 PortConfiguration::PortConfiguration(const rtc::SocketAddress& stun_address,
                                      const std::string& username,
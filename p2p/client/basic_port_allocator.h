@@ -15,10 +15,12 @@
 #include <string>
 #include <vector>
 
+#include "api/scoped_refptr.h"
 #include "api/turn_customizer.h"
 #include "p2p/base/port_allocator.h"
 #include "p2p/client/relay_port_factory_interface.h"
 #include "p2p/client/turn_port_factory.h"
+#include "p2p/client/udp_socket_multiplexer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/network.h"
 #include "rtc_base/system/rtc_export.h"
@@ -80,6 +82,14 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   void SetVpnList(const std::vector<rtc::NetworkMask>& vpn_list) override;
 
+  // Sets what the UDP sockets are shared through, when
+  // PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS is set. Allocators that
+  // are given the same multiplexer share their sockets too, e.g. those of all
+  // PeerConnections on a server. If not set, the allocator creates its own.
+  void SetUdpSocketMultiplexer(
+      rtc::scoped_refptr<UdpSocketMultiplexer> udp_socket_multiplexer);
+  UdpSocketMultiplexer* udp_socket_multiplexer();
+
  private:
   void OnIceRegathering(PortAllocatorSession* session,
                         IceRegatheringReason reason);
@@ -98,6 +108,8 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   // This instance is created if caller does pass a factory.
   std::unique_ptr<RelayPortFactoryInterface> default_relay_port_factory_;
+
+  rtc::scoped_refptr<UdpSocketMultiplexer> udp_socket_multiplexer_;
 };
 
 struct PortConfiguration;
@@ -329,7 +341,8 @@ class TurnPort;
 // Performs the allocation of ports, in a sequenced (timed) manner, for a given
 // network and IP address.
 // This class is thread-compatible.
-class AllocationSequence : public sigslot::has_slots<> {
+class AllocationSequence : public UdpSocketMultiplexer::Receiver,
+                           public sigslot::has_slots<> {
  public:
   enum State {
     kInit,       // Initial state.
@@ -351,6 +364,7 @@ class AllocationSequence : public sigslot::has_slots<> {
                      PortConfiguration* config,
                      uint32_t flags,
                      std::function<void()> port_allocation_complete_callback);
+  ~AllocationSequence() override;
   void Init();
   void Clear();
   void OnNetworkFailed();
@@ -394,6 +408,16 @@ class AllocationSequence : public sigslot::has_slots<> {
 
   void OnPortDestroyed(PortInterface* port);
 
+  // UdpSocketMultiplexer::Receiver implementation.
+  const std::string& ice_ufrag() const override;
+  bool CanHandleIncomingPacketsFrom(
+      const rtc::SocketAddress& remote_addr) const override;
+  void HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
+                            const char* data,
+                            size_t size,
+                            const rtc::SocketAddress& remote_addr,
+                            int64_t packet_time_us) override;
+
   BasicPortAllocatorSession* session_;
   bool network_failed_ = false;
   rtc::Network* network_;
@@ -404,6 +428,10 @@ class AllocationSequence : public sigslot::has_slots<> {
   uint32_t flags_;
   ProtocolList protocols_;
   std::unique_ptr<rtc::AsyncPacketSocket> udp_socket_;
+  // The socket shared with other sessions, instead of `udp_socket_`, when
+  // PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS is set.
+  rtc::scoped_refptr<UdpSocketMultiplexer> udp_socket_multiplexer_;
+  rtc::AsyncPacketSocket* multiplexed_udp_socket_ = nullptr;
   // There will be only one udp port per AllocationSequence.
   UDPPort* udp_port_;
   std::vector<Port*> relay_ports_;
@@ -1611,6 +1611,39 @@ TEST_F(BasicPortAllocatorTest, TestSharedSocketWithoutNat) {
                              kDefaultAllocationTimeout, fake_clock);
 }
 
+// Test that when PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS is enabled
+// too, the UDP ports of different sessions share one socket, which is closed
+// with the last session.
+TEST_F(BasicPortAllocatorTest, TestSharedSocketAcrossSessions) {
+  AddInterface(kClientAddr);
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_SHARED_SOCKET |
+                        PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS |
+                        PORTALLOCATOR_DISABLE_TCP);
+  auto session1 = CreateSession("session1", kContentName,
+                                ICE_CANDIDATE_COMPONENT_RTP, "UF01", kIcePwd0);
+  auto session2 = CreateSession("session2", kContentName,
+                                ICE_CANDIDATE_COMPONENT_RTP, "UF02", kIcePwd0);
+  session1->StartGettingPorts();
+  session2->StartGettingPorts();
+  ASSERT_TRUE_SIMULATED_WAIT(session1->CandidatesAllocationDone() &&
+                                 session2->CandidatesAllocationDone(),
+                             kDefaultAllocationTimeout, fake_clock);
+
+  std::vector<Candidate> candidates1 = session1->ReadyCandidates();
+  std::vector<Candidate> candidates2 = session2->ReadyCandidates();
+  ASSERT_EQ(1U, candidates1.size());
+  ASSERT_EQ(1U, candidates2.size());
+  EXPECT_TRUE(HasCandidate(candidates1, "local", "udp", kClientAddr));
+  EXPECT_EQ(candidates1[0].address(), candidates2[0].address());
+  EXPECT_EQ(1U, allocator().udp_socket_multiplexer()->socket_count());
+
+  session1.reset();
+  EXPECT_EQ(1U, allocator().udp_socket_multiplexer()->socket_count());
+  session2.reset();
+  EXPECT_EQ(0U, allocator().udp_socket_multiplexer()->socket_count());
+}
+
 // Test that when PORTALLOCATOR_ENABLE_SHARED_SOCKET is enabled only one port
 // is allocated for udp and stun. In this test we should expect both stun and
 // local candidates as client behind a nat.
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/client/udp_socket_multiplexer.h"
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/string_view.h"
+#include "api/transport/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace cricket {
+
+UdpSocketMultiplexer::UdpSocketMultiplexer() {
+  sequence_checker_.Detach();
+}
+
+UdpSocketMultiplexer::~UdpSocketMultiplexer() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(sockets_.empty());
+}
+
+rtc::AsyncPacketSocket* UdpSocketMultiplexer::AddReceiver(
+    Receiver* receiver,
+    rtc::PacketSocketFactory* socket_factory,
+    const rtc::IPAddress& ip,
+    uint16_t min_port,
+    uint16_t max_port) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  SharedSocket& shared = sockets_[ip];
+  if (!shared.socket) {
+    shared.socket.reset(socket_factory->CreateUdpSocket(
+        rtc::SocketAddress(ip, 0), min_port, max_port));
+    if (!shared.socket) {
+      sockets_.erase(ip);
+      return nullptr;
+    }
+    shared.socket->SignalReadPacket.connect(
+        this, &UdpSocketMultiplexer::OnReadPacket);
+  }
+  shared.receivers.push_back(receiver);
+  return shared.socket.get();
+}
+
+void UdpSocketMultiplexer::RemoveReceiver(Receiver* receiver,
+                                          rtc::AsyncPacketSocket* socket) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = absl::c_find_if(sockets_, [socket](const auto& entry) {
+    return entry.second.socket.get() == socket;
+  });
+  if (it == sockets_.end()) {
+    RTC_DCHECK_NOTREACHED();
+    return;
+  }
+  SharedSocket& shared = it->second;
+  shared.receivers.erase(absl::c_find(shared.receivers, receiver));
+  for (auto remote_it = shared.receivers_by_remote_address.begin();
+       remote_it != shared.receivers_by_remote_address.end();) {
+    if (remote_it->second == receiver) {
+      remote_it = shared.receivers_by_remote_address.erase(remote_it);
+    } else {
+      ++remote_it;
+    }
+  }
+  if (shared.receivers.empty()) {
+    sockets_.erase(it);
+  }
+}
+
+size_t UdpSocketMultiplexer::socket_count() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return sockets_.size();
+}
+
+UdpSocketMultiplexer::SharedSocket* UdpSocketMultiplexer::FindSharedSocket(
+    rtc::AsyncPacketSocket* socket) {
+  for (auto& [unused, shared] : sockets_) {
+    if (shared.socket.get() == socket) {
+      return &shared;
+    }
+  }
+  return nullptr;
+}
+
+UdpSocketMultiplexer::Receiver*
+UdpSocketMultiplexer::FindBindingRequestReceiver(const SharedSocket& shared,
+                                                 const char* data,
+                                                 size_t size) const {
+  if (size < kStunHeaderSize || rtc::GetBE16(data) != STUN_BINDING_REQUEST) {
+    return nullptr;
+  }
+  IceMessage request;
+  rtc::ByteBufferReader buf(data, size);
+  if (!request.Read(&buf)) {
+    return nullptr;
+  }
+  const StunByteStringAttribute* username_attr =
+      request.GetByteString(STUN_ATTR_USERNAME);
+  if (!username_attr) {
+    return nullptr;
+  }
+  // The USERNAME is "<local ufrag>:<remote ufrag>", as seen from here.
+  absl::string_view username(username_attr->bytes(), username_attr->length());
+  absl::string_view local_ufrag = username.substr(0, username.find(':'));
+  for (Receiver* receiver : shared.receivers) {
+    if (receiver->ice_ufrag() == local_ufrag) {
+      return receiver;
+    }
+  }
+  return nullptr;
+}
+
+void UdpSocketMultiplexer::OnReadPacket(rtc::AsyncPacketSocket* socket,
+                                        const char* data,
+                                        size_t size,
+                                        const rtc::SocketAddress& remote_addr,
+                                        const int64_t& packet_time_us) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  SharedSocket* shared = FindSharedSocket(socket);
+  RTC_DCHECK(shared);
+
+  if (Receiver* receiver = FindBindingRequestReceiver(*shared, data, size)) {
+    shared->receivers_by_remote_address[remote_addr] = receiver;
+    receiver->HandleIncomingPacket(socket, data, size, remote_addr,
+                                   packet_time_us);
+    return;
+  }
+
+  auto it = shared->receivers_by_remote_address.find(remote_addr);
+  if (it != shared->receivers_by_remote_address.end()) {
+    it->second->HandleIncomingPacket(socket, data, size, remote_addr,
+                                     packet_time_us);
+    return;
+  }
+
+  // Responses from STUN servers, which several receivers may have sent
+  // requests to, are ignored by the receivers that don't know the transaction.
+  bool handled = false;
+  for (Receiver* receiver : shared->receivers) {
+    if (receiver->CanHandleIncomingPacketsFrom(remote_addr)) {
+      receiver->HandleIncomingPacket(socket, data, size, remote_addr,
+                                     packet_time_us);
+      handled = true;
+    }
+  }
+  if (!handled) {
+    RTC_LOG(LS_VERBOSE) << "Dropping packet from unknown address "
+                        << remote_addr.ToSensitiveString();
+  }
+}
+
+}  // namespace cricket
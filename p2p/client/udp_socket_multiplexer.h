@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_CLIENT_UDP_SOCKET_MULTIPLEXER_H_
+#define P2P_CLIENT_UDP_SOCKET_MULTIPLEXER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/packet_socket_factory.h"
+#include "api/sequence_checker.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace cricket {
+
+// Lets the UDP ports of many port allocator sessions share one UDP socket per
+// local IP address, instead of each opening its own. This is used with the
+// PORTALLOCATOR_ENABLE_SHARED_SOCKET_ACROSS_SESSIONS flag, which lets servers
+// with many ICE sessions use few sockets.
+//
+// Received packets are demultiplexed to the sessions' receivers: STUN binding
+// requests by the local ICE username fragment in their USERNAME attribute, and
+// other packets by the remote address that binding requests have been
+// received from. Packets from other remote addresses, like responses from
+// STUN servers, are given to all receivers that can handle them.
+//
+// This class must be created, used and destroyed on the network thread.
+class UdpSocketMultiplexer final
+    : public rtc::RefCountedBase,
+      public sigslot::has_slots<> {
+ public:
+  // Receives the packets for one session, from one shared socket.
+  class Receiver {
+   public:
+    virtual ~Receiver() = default;
+
+    // The local ICE username fragment of the session.
+    virtual const std::string& ice_ufrag() const = 0;
+    // Returns true if the receiver expects packets from `remote_addr`, e.g.
+    // because it has sent a request to it.
+    virtual bool CanHandleIncomingPacketsFrom(
+        const rtc::SocketAddress& remote_addr) const = 0;
+    virtual void HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
+                                      const char* data,
+                                      size_t size,
+                                      const rtc::SocketAddress& remote_addr,
+                                      int64_t packet_time_us) = 0;
+  };
+
+  UdpSocketMultiplexer();
+  UdpSocketMultiplexer(const UdpSocketMultiplexer&) = delete;
+  UdpSocketMultiplexer& operator=(const UdpSocketMultiplexer&) = delete;
+
+  // Adds `receiver` to the socket that is shared on `ip`, which is created
+  // with `socket_factory` if there isn't one yet. Returns the socket, or null
+  // if it couldn't be created.
+  rtc::AsyncPacketSocket* AddReceiver(Receiver* receiver,
+                                      rtc::PacketSocketFactory* socket_factory,
+                                      const rtc::IPAddress& ip,
+                                      uint16_t min_port,
+                                      uint16_t max_port);
+  // Removes `receiver` from `socket`, which is closed when it was the last
+  // receiver of it.
+  void RemoveReceiver(Receiver* receiver, rtc::AsyncPacketSocket* socket);
+
+  // The number of open sockets. Exposed for testing.
+  size_t socket_count() const;
+
+ protected:
+  friend class rtc::RefCountedBase;
+  ~UdpSocketMultiplexer() override;
+
+ private:
+  struct SharedSocket {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket;
+    std::vector<Receiver*> receivers;
+    // The receivers that binding requests from a remote address were for.
+    std::map<rtc::SocketAddress, Receiver*> receivers_by_remote_address;
+  };
+
+  SharedSocket* FindSharedSocket(rtc::AsyncPacketSocket* socket);
+  // Returns the receiver that a STUN binding request is for, if the packet is
+  // one.
+  Receiver* FindBindingRequestReceiver(const SharedSocket& shared,
+                                       const char* data,
+                                       size_t size) const;
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us);
+
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
+  std::map<rtc::IPAddress, SharedSocket> sockets_
+      RTC_GUARDED_BY(sequence_checker_);
+};
+
+}  // namespace cricket
+
+#endif  // P2P_CLIENT_UDP_SOCKET_MULTIPLEXER_H_
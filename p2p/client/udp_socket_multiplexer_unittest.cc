@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/client/udp_socket_multiplexer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/stun.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+const rtc::SocketAddress kLocalAddr("11.11.11.11", 0);
+const rtc::SocketAddress kRemoteAddr("22.22.22.22", 0);
+const rtc::SocketAddress kStunServerAddr("33.33.33.33", 0);
+constexpr int kTimeoutMs = 1000;
+
+class FakeReceiver : public UdpSocketMultiplexer::Receiver {
+ public:
+  explicit FakeReceiver(const std::string& ice_ufrag) : ice_ufrag_(ice_ufrag) {}
+
+  const std::string& ice_ufrag() const override { return ice_ufrag_; }
+  bool CanHandleIncomingPacketsFrom(
+      const rtc::SocketAddress& remote_addr) const override {
+    return remote_addr.ipaddr() == kStunServerAddr.ipaddr();
+  }
+  void HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
+                            const char* data,
+                            size_t size,
+                            const rtc::SocketAddress& remote_addr,
+                            int64_t packet_time_us) override {
+    ++received_packets_;
+  }
+
+  int received_packets() const { return received_packets_; }
+
+ private:
+  const std::string ice_ufrag_;
+  int received_packets_ = 0;
+};
+
+std::string CreateBindingRequest(const std::string& username) {
+  IceMessage request;
+  request.SetType(STUN_BINDING_REQUEST);
+  request.SetTransactionID("0123456789ab");
+  request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+      STUN_ATTR_USERNAME, username));
+  rtc::ByteBufferWriter buf;
+  request.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+class UdpSocketMultiplexerTest : public ::testing::Test {
+ protected:
+  UdpSocketMultiplexerTest()
+      : thread_(&vss_),
+        socket_factory_(&vss_),
+        multiplexer_(rtc::make_ref_counted<UdpSocketMultiplexer>()) {}
+
+  // Sends `data` from a new socket on `from` to `socket`.
+  void SendTo(rtc::AsyncPacketSocket* socket,
+              const rtc::SocketAddress& from,
+              const std::string& data) {
+    remote_sockets_.emplace_back(
+        socket_factory_.CreateUdpSocket(from, /*min_port=*/0, /*max_port=*/0));
+    remote_sockets_.back()->SendTo(data.data(), data.size(),
+                                   socket->GetLocalAddress(),
+                                   rtc::PacketOptions());
+  }
+
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  rtc::scoped_refptr<UdpSocketMultiplexer> multiplexer_;
+  std::vector<std::unique_ptr<rtc::AsyncPacketSocket>> remote_sockets_;
+};
+
+TEST_F(UdpSocketMultiplexerTest, SharesOneSocketPerAddress) {
+  FakeReceiver receiver1("ufrag1");
+  FakeReceiver receiver2("ufrag2");
+  rtc::AsyncPacketSocket* socket1 = multiplexer_->AddReceiver(
+      &receiver1, &socket_factory_, kLocalAddr.ipaddr(), 0, 0);
+  rtc::AsyncPacketSocket* socket2 = multiplexer_->AddReceiver(
+      &receiver2, &socket_factory_, kLocalAddr.ipaddr(), 0, 0);
+  ASSERT_TRUE(socket1);
+  EXPECT_EQ(socket1, socket2);
+  EXPECT_EQ(1U, multiplexer_->socket_count());
+
+  multiplexer_->RemoveReceiver(&receiver1, socket1);
+  EXPECT_EQ(1U, multiplexer_->socket_count());
+  multiplexer_->RemoveReceiver(&receiver2, socket2);
+  EXPECT_EQ(0U, multiplexer_->socket_count());
+}
+
+TEST_F(UdpSocketMultiplexerTest, DemultiplexesByUsernameThenRemoteAddress) {
+  FakeReceiver receiver1("ufrag1");
+  FakeReceiver receiver2("ufrag2");
+  rtc::AsyncPacketSocket* socket = multiplexer_->AddReceiver(
+      &receiver1, &socket_factory_, kLocalAddr.ipaddr(), 0, 0);
+  multiplexer_->AddReceiver(&receiver2, &socket_factory_, kLocalAddr.ipaddr(),
+                            0, 0);
+
+  SendTo(socket, kRemoteAddr, CreateBindingRequest("ufrag2:remote"));
+  EXPECT_EQ_WAIT(1, receiver2.received_packets(), kTimeoutMs);
+  EXPECT_EQ(0, receiver1.received_packets());
+
+  // Packets from the same remote address, like DTLS, go to the same receiver.
+  remote_sockets_.back()->SendTo("dtls", 4, socket->GetLocalAddress(),
+                                 rtc::PacketOptions());
+  EXPECT_EQ_WAIT(2, receiver2.received_packets(), kTimeoutMs);
+  EXPECT_EQ(0, receiver1.received_packets());
+
+  multiplexer_->RemoveReceiver(&receiver1, socket);
+  multiplexer_->RemoveReceiver(&receiver2, socket);
+}
+
+TEST_F(UdpSocketMultiplexerTest, GivesPacketsFromServersToAllReceivers) {
+  FakeReceiver receiver1("ufrag1");
+  FakeReceiver receiver2("ufrag2");
+  rtc::AsyncPacketSocket* socket = multiplexer_->AddReceiver(
+      &receiver1, &socket_factory_, kLocalAddr.ipaddr(), 0, 0);
+  multiplexer_->AddReceiver(&receiver2, &socket_factory_, kLocalAddr.ipaddr(),
+                            0, 0);
+
+  SendTo(socket, kStunServerAddr, "response");
+  EXPECT_EQ_WAIT(1, receiver1.received_packets(), kTimeoutMs);
+  EXPECT_EQ_WAIT(1, receiver2.received_packets(), kTimeoutMs);
+
+  // Packets from unknown addresses are dropped.
+  SendTo(socket, kRemoteAddr, "unknown");
+  SendTo(socket, kStunServerAddr, "response");
+  EXPECT_EQ_WAIT(2, receiver1.received_packets(), kTimeoutMs);
+  EXPECT_EQ(2, receiver2.received_packets());
+
+  multiplexer_->RemoveReceiver(&receiver1, socket);
+  multiplexer_->RemoveReceiver(&receiver2, socket);
+}
+
+}  // namespace
+}  // namespace cricket
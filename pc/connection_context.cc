@@ -45,16 +45,41 @@ rtc::Thread* MaybeStartNetworkThread(
 
 rtc::Thread* MaybeStartWorkerThread(
     rtc::Thread* old_thread,
+    rtc::Thread* network_thread,
+    bool has_media_engine,
     std::unique_ptr<rtc::Thread>& thread_holder) {
   if (old_thread) {
     return old_thread;
   }
+  if (!has_media_engine) {
+    // Without a media engine, the worker thread has no media to process, so
+    // data channel only factories don't need a thread of their own for it.
+    return network_thread;
+  }
   thread_holder = rtc::Thread::Create();
   thread_holder->SetName("pc_worker_thread", nullptr);
   thread_holder->Start();
   return thread_holder.get();
 }
 
+// Fills in the threads of `dependencies` from its thread pool, if it has one
+// and no threads of its own.
+rtc::scoped_refptr<PeerConnectionThreadPool> MaybeTakeThreadsFromPool(
+    PeerConnectionFactoryDependencies* dependencies) {
+  if (!dependencies->thread_pool || dependencies->network_thread ||
+      dependencies->worker_thread) {
+    return nullptr;
+  }
+  PeerConnectionThreadPool::ThreadPair threads =
+      dependencies->thread_pool_shard
+          ? dependencies->thread_pool->GetThreadPair(
+                *dependencies->thread_pool_shard)
+          : dependencies->thread_pool->NextThreadPair();
+  dependencies->network_thread = threads.network_thread;
+  dependencies->worker_thread = threads.worker_thread;
+  return std::move(dependencies->thread_pool);
+}
+
 rtc::Thread* MaybeWrapThread(rtc::Thread* signaling_thread,
                              bool& wraps_current_thread) {
   wraps_current_thread = false;
@@ -95,11 +120,14 @@ rtc::scoped_refptr<ConnectionContext> ConnectionContext::Create(
 
 ConnectionContext::ConnectionContext(
     PeerConnectionFactoryDependencies* dependencies)
-    : network_thread_(MaybeStartNetworkThread(dependencies->network_thread,
+    : thread_pool_(MaybeTakeThreadsFromPool(dependencies)),
+      network_thread_(MaybeStartNetworkThread(dependencies->network_thread,
                                               owned_socket_factory_,
                                               owned_network_thread_)),
-      worker_thread_(MaybeStartWorkerThread(dependencies->worker_thread,
-                                            owned_worker_thread_)),
+      worker_thread_(
+          MaybeStartWorkerThread(dependencies->worker_thread, network_thread_,
+                                 dependencies->media_engine != nullptr,
+                                 owned_worker_thread_)),
       signaling_thread_(MaybeWrapThread(dependencies->signaling_thread,
                                         wraps_current_thread_)),
       network_monitor_factory_(
@@ -17,6 +17,7 @@
 #include "api/call/call_factory_interface.h"
 #include "api/media_stream_interface.h"
 #include "api/peer_connection_interface.h"
+#include "api/peer_connection_thread_pool.h"
 #include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -98,6 +99,9 @@ class ConnectionContext final
   ~ConnectionContext();
 
  private:
+  // Keeps the threads taken from the pool, if any, alive. Declared first, so
+  // that it is initialized before and destroyed after the members below.
+  const rtc::scoped_refptr<PeerConnectionThreadPool> thread_pool_;
   // The following three variables are used to communicate between the
   // constructor and the destructor, and are never exposed externally.
   bool wraps_current_thread_;
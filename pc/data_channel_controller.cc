@@ -71,11 +71,12 @@ void DataChannelController::DisconnectDataChannel(
   SignalDataChannelTransportChannelClosed_s.disconnect(webrtc_data_channel);
 }
 
-void DataChannelController::AddSctpDataStream(int sid) {
+void DataChannelController::AddSctpDataStream(int sid, Priority priority) {
   if (data_channel_transport()) {
-    network_thread()->Invoke<void>(RTC_FROM_HERE, [this, sid] {
+    network_thread()->Invoke<void>(RTC_FROM_HERE, [this, sid, priority] {
       if (data_channel_transport()) {
         data_channel_transport()->OpenChannel(sid);
+        data_channel_transport()->SetChannelPriority(sid, priority);
       }
     });
   }
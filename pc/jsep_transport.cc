@@ -34,6 +34,35 @@ using webrtc::SdpType;
 
 namespace cricket {
 
+namespace {
+
+// SDES crypto parameters are never considered the same, since transports that
+// use them are always updated.
+bool IsSameDescription(const JsepTransportDescription& a,
+                       const JsepTransportDescription& b) {
+  const TransportDescription& transport_a = a.transport_desc;
+  const TransportDescription& transport_b = b.transport_desc;
+  bool same_fingerprint =
+      transport_a.identity_fingerprint && transport_b.identity_fingerprint
+          ? *transport_a.identity_fingerprint ==
+                *transport_b.identity_fingerprint
+          : !transport_a.identity_fingerprint &&
+                !transport_b.identity_fingerprint;
+  return a.rtcp_mux_enabled == b.rtcp_mux_enabled && a.cryptos.empty() &&
+         b.cryptos.empty() &&
+         a.encrypted_header_extension_ids ==
+             b.encrypted_header_extension_ids &&
+         a.rtp_abs_sendtime_extn_id == b.rtp_abs_sendtime_extn_id &&
+         transport_a.transport_options == transport_b.transport_options &&
+         transport_a.ice_ufrag == transport_b.ice_ufrag &&
+         transport_a.ice_pwd == transport_b.ice_pwd &&
+         transport_a.ice_mode == transport_b.ice_mode &&
+         transport_a.connection_role == transport_b.connection_role &&
+         same_fingerprint;
+}
+
+}  // namespace
+
 JsepTransportDescription::JsepTransportDescription() {}
 
 JsepTransportDescription::JsepTransportDescription(
@@ -189,6 +218,10 @@ webrtc::RTCError JsepTransport::SetLocalJsepTransportDescription(
     dtls_srtp_transport_->UpdateRecvEncryptedHeaderExtensionIds(
         jsep_description.encrypted_header_extension_ids);
   }
+  if (!local_description_ ||
+      !IsSameDescription(*local_description_, jsep_description)) {
+    descriptions_changed_since_negotiation_ = true;
+  }
   bool ice_restarting =
       local_description_ != nullptr &&
       IceCredentialsChanged(local_description_->transport_desc.ice_ufrag,
@@ -225,6 +258,9 @@ webrtc::RTCError JsepTransport::SetLocalJsepTransportDescription(
     local_description_.reset();
     return error;
   }
+  if (type == SdpType::kAnswer) {
+    descriptions_changed_since_negotiation_ = false;
+  }
 
   if (needs_ice_restart_ && ice_restarting) {
     needs_ice_restart_ = false;
@@ -281,6 +317,10 @@ webrtc::RTCError JsepTransport::SetRemoteJsepTransportDescription(
         jsep_description.rtp_abs_sendtime_extn_id);
   }
 
+  if (!remote_description_ ||
+      !IsSameDescription(*remote_description_, jsep_description)) {
+    descriptions_changed_since_negotiation_ = true;
+  }
   remote_description_.reset(new JsepTransportDescription(jsep_description));
   RTC_DCHECK(rtp_dtls_transport());
   SetRemoteIceParameters(ice_parameters, rtp_dtls_transport()->ice_transport());
@@ -298,9 +338,34 @@ webrtc::RTCError JsepTransport::SetRemoteJsepTransportDescription(
     remote_description_.reset();
     return error;
   }
+  if (type == SdpType::kAnswer) {
+    descriptions_changed_since_negotiation_ = false;
+  }
   return webrtc::RTCError::OK();
 }
 
+bool JsepTransport::IsDescriptionApplied(
+    ContentSource source,
+    const JsepTransportDescription& jsep_description,
+    webrtc::SdpType type) const {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  // SDES and RTCP mux negotiation keep offer/answer state of their own, which
+  // would get out of step if a description was skipped.
+  if (sdes_transport_ || !rtcp_mux_negotiator_.IsFullyActive()) {
+    return false;
+  }
+  const JsepTransportDescription* current = source == CS_LOCAL
+                                                ? local_description_.get()
+                                                : remote_description_.get();
+  if (!current || !IsSameDescription(*current, jsep_description)) {
+    return false;
+  }
+  // Answers negotiate DTLS again, which is only redundant if neither
+  // description has changed since the last final answer.
+  return type == SdpType::kOffer || (type == SdpType::kAnswer &&
+                                     !descriptions_changed_since_negotiation_);
+}
+
 webrtc::RTCError JsepTransport::AddRemoteCandidates(
     const Candidates& candidates) {
   RTC_DCHECK_RUN_ON(network_thread_);
@@ -134,6 +134,15 @@ class JsepTransport {
   webrtc::RTCError SetRemoteJsepTransportDescription(
       const JsepTransportDescription& jsep_description,
       webrtc::SdpType type);
+
+  // Returns true if applying `jsep_description` as the local (`source` is
+  // CS_LOCAL) or remote description of type `type` would leave this transport
+  // as it is, because the same description has already been applied and
+  // negotiated. Such descriptions don't need to be applied again.
+  bool IsDescriptionApplied(ContentSource source,
+                            const JsepTransportDescription& jsep_description,
+                            webrtc::SdpType type) const;
+
   webrtc::RTCError AddRemoteCandidates(const Candidates& candidates);
 
   // Set the "needs-ice-restart" flag as described in JSEP. After the flag is
@@ -293,6 +302,10 @@ class JsepTransport {
       RTC_GUARDED_BY(network_thread_);
   std::unique_ptr<JsepTransportDescription> remote_description_
       RTC_GUARDED_BY(network_thread_);
+  // Whether a description has changed since DTLS was last negotiated with a
+  // final answer.
+  bool descriptions_changed_since_negotiation_
+      RTC_GUARDED_BY(network_thread_) = true;
 
   // Ice transport which may be used by any of upper-layer transports (below).
   // Owned by JsepTransport and guaranteed to outlive the transports below.
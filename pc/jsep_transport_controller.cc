@@ -33,11 +33,19 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 
 using webrtc::SdpType;
 
 namespace webrtc {
 
+namespace {
+
+constexpr char kIncrementalDescriptionsFieldTrial[] =
+    "WebRTC-IncrementalTransportDescriptions";
+
+}  // namespace
+
 JsepTransportController::JsepTransportController(
     rtc::Thread* network_thread,
     cricket::PortAllocator* port_allocator,
@@ -56,6 +64,8 @@ JsepTransportController::JsepTransportController(
           }),
       config_(config),
       active_reset_srtp_params_(config.active_reset_srtp_params),
+      incremental_descriptions_(
+          !field_trial::IsDisabled(kIncrementalDescriptionsFieldTrial)),
       bundles_(config.bundle_policy) {
   // The `transport_observer` is assumed to be non-null.
   RTC_DCHECK(config_.transport_observer);
@@ -639,11 +649,25 @@ RTCError JsepTransportController::ApplyDescription_n(
         GetJsepTransportForMid(content_info.name);
     RTC_DCHECK(transport);
 
-    SetIceRole_n(DetermineIceRole(transport, transport_info, type, local));
+    // Every ICE transport takes on `ice_role_` when it is created, so they
+    // only need updating when the role changes.
+    cricket::IceRole ice_role =
+        DetermineIceRole(transport, transport_info, type, local);
+    if (!incremental_descriptions_ || ice_role != ice_role_) {
+      SetIceRole_n(ice_role);
+    }
 
     cricket::JsepTransportDescription jsep_description =
         CreateJsepTransportDescription(content_info, transport_info,
                                        extension_ids, rtp_abs_sendtime_extn_id);
+    // In calls with many transports, most m= sections are usually unchanged
+    // when renegotiating.
+    if (incremental_descriptions_ &&
+        transport->IsDescriptionApplied(
+            local ? cricket::CS_LOCAL : cricket::CS_REMOTE, jsep_description,
+            type)) {
+      continue;
+    }
     if (local) {
       error =
           transport->SetLocalJsepTransportDescription(jsep_description, type);
@@ -470,6 +470,9 @@ class JsepTransportController : public sigslot::has_slots<> {
 
   const Config config_;
   bool active_reset_srtp_params_ RTC_GUARDED_BY(network_thread_);
+  // Whether descriptions that leave a transport as it is are skipped when
+  // renegotiating, rather than applied to every transport again.
+  const bool incremental_descriptions_;
 
   const cricket::SessionDescription* local_desc_ = nullptr;
   const cricket::SessionDescription* remote_desc_ = nullptr;
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures how long the network thread is busy applying the renegotiations of
+// a large conference, in which only one transport changes at a time.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "p2p/base/dtls_transport_factory.h"
+#include "p2p/base/fake_dtls_transport.h"
+#include "p2p/base/fake_ice_transport.h"
+#include "p2p/base/transport_info.h"
+#include "pc/jsep_transport_controller.h"
+#include "pc/session_description.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/ssl_fingerprint.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/thread.h"
+#include "test/field_trial.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kIcePwd[] = "TESTICEPWD00000000000001";
+
+class FakeIceTransportFactory : public IceTransportFactory {
+ public:
+  rtc::scoped_refptr<IceTransportInterface> CreateIceTransport(
+      const std::string& transport_name,
+      int component,
+      IceTransportInit init) override {
+    return rtc::make_ref_counted<cricket::FakeIceTransportWrapper>(
+        std::make_unique<cricket::FakeIceTransport>(transport_name, component));
+  }
+};
+
+class FakeDtlsTransportFactory : public cricket::DtlsTransportFactory {
+ public:
+  std::unique_ptr<cricket::DtlsTransportInternal> CreateDtlsTransport(
+      cricket::IceTransportInternal* ice,
+      const CryptoOptions& crypto_options,
+      rtc::SSLProtocolVersion max_version) override {
+    return std::make_unique<cricket::FakeDtlsTransport>(
+        static_cast<cricket::FakeIceTransport*>(ice));
+  }
+};
+
+class TransportObserver : public JsepTransportController::Observer {
+ public:
+  bool OnTransportChanged(
+      const std::string& mid,
+      RtpTransportInternal* rtp_transport,
+      rtc::scoped_refptr<DtlsTransport> dtls_transport,
+      DataChannelTransportInterface* data_channel_transport) override {
+    return true;
+  }
+};
+
+// Returns a description with `num_transceivers` video m= sections, split into
+// BUNDLE groups of `group_size`. The first m= section, and so the first
+// transport, gets the ICE ufrag `first_ufrag`.
+std::unique_ptr<cricket::SessionDescription> CreateDescription(
+    int num_transceivers,
+    int group_size,
+    const std::string& ufrag_prefix,
+    const std::string& first_ufrag,
+    cricket::ConnectionRole role,
+    const rtc::RTCCertificate& certificate) {
+  auto description = std::make_unique<cricket::SessionDescription>();
+  std::unique_ptr<rtc::SSLFingerprint> fingerprint =
+      rtc::SSLFingerprint::CreateFromCertificate(certificate);
+  cricket::ContentGroup bundle_group(cricket::GROUP_TYPE_BUNDLE);
+  for (int i = 0; i < num_transceivers; ++i) {
+    std::string mid = std::to_string(i);
+    auto video = std::make_unique<cricket::VideoContentDescription>();
+    video->set_rtcp_mux(true);
+    description->AddContent(mid, cricket::MediaProtocolType::kRtp,
+                            /*rejected=*/false, std::move(video));
+    std::string ufrag = i == 0 ? first_ufrag : ufrag_prefix + mid;
+    description->AddTransportInfo(cricket::TransportInfo(
+        mid, cricket::TransportDescription(std::vector<std::string>(), ufrag,
+                                           kIcePwd, cricket::ICEMODE_FULL,
+                                           role, fingerprint.get())));
+    bundle_group.AddContentName(mid);
+    if (static_cast<int>(bundle_group.content_names().size()) == group_size ||
+        i == num_transceivers - 1) {
+      description->AddGroup(bundle_group);
+      bundle_group = cricket::ContentGroup(cricket::GROUP_TYPE_BUNDLE);
+    }
+  }
+  return description;
+}
+
+// Renegotiates a call with `state.range(0)` transceivers, which are bundled in
+// groups of `state.range(1)`, restarting ICE on the first transport each time.
+// `state.range(2)` turns on skipping the transports that are unchanged.
+void BM_RenegotiateLargeConference(benchmark::State& state) {
+  const int num_transceivers = state.range(0);
+  const int group_size = state.range(1);
+  test::ScopedFieldTrials field_trials(
+      state.range(2) != 0
+          ? ""
+          : "WebRTC-IncrementalTransportDescriptions/Disabled/");
+  rtc::AutoThread network_thread;
+  FakeIceTransportFactory ice_transport_factory;
+  FakeDtlsTransportFactory dtls_transport_factory;
+  TransportObserver transport_observer;
+  JsepTransportController::Config config;
+  config.transport_observer = &transport_observer;
+  config.rtcp_handler = [](const rtc::CopyOnWriteBuffer& packet,
+                           int64_t packet_time_us) {};
+  config.ice_transport_factory = &ice_transport_factory;
+  config.dtls_transport_factory = &dtls_transport_factory;
+  config.on_dtls_handshake_error_ = [](rtc::SSLHandshakeError error) {};
+  JsepTransportController controller(&network_thread,
+                                     /*port_allocator=*/nullptr,
+                                     /*async_dns_resolver_factory=*/nullptr,
+                                     config);
+
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+      rtc::RTCCertificate::Create(
+          rtc::SSLIdentity::Create("benchmark", rtc::KT_ECDSA));
+  RTC_CHECK(controller.SetLocalCertificate(certificate));
+  std::unique_ptr<cricket::SessionDescription> offers[] = {
+      CreateDescription(num_transceivers, group_size, "local", "restart0",
+                        cricket::CONNECTIONROLE_ACTPASS, *certificate),
+      CreateDescription(num_transceivers, group_size, "local", "restart1",
+                        cricket::CONNECTIONROLE_ACTPASS, *certificate)};
+  std::unique_ptr<cricket::SessionDescription> answer =
+      CreateDescription(num_transceivers, group_size, "remote", "remote0",
+                        cricket::CONNECTIONROLE_ACTIVE, *certificate);
+
+  size_t next_offer = 0;
+  for (auto s : state) {
+    RTC_CHECK(controller
+                  .SetLocalDescription(SdpType::kOffer,
+                                       offers[next_offer].get())
+                  .ok());
+    RTC_CHECK(
+        controller.SetRemoteDescription(SdpType::kAnswer, answer.get()).ok());
+    next_offer = 1 - next_offer;
+  }
+}
+
+BENCHMARK(BM_RenegotiateLargeConference)
+    ->ArgNames({"transceivers", "group_size", "incremental"})
+    ->Args({100, 100, 0})
+    ->Args({100, 100, 1})
+    ->Args({100, 10, 0})
+    ->Args({100, 10, 1})
+    ->Args({100, 1, 0})
+    ->Args({100, 1, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
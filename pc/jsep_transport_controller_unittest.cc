@@ -1103,6 +1103,60 @@ TEST_F(JsepTransportControllerTest,
 }
 
 // Tests that the SDP has more than one audio/video m= sections.
+// Tests that a renegotiation that restarts ICE on one of two transports is
+// applied to it, while the other keeps its parameters.
+TEST_F(JsepTransportControllerTest, RenegotiationUpdatesChangedTransport) {
+  CreateJsepTransportController(JsepTransportController::Config());
+  auto local_offer = CreateSessionDescriptionWithoutBundle();
+  auto remote_answer = std::make_unique<cricket::SessionDescription>();
+  AddAudioSection(remote_answer.get(), kAudioMid1, kIceUfrag2, kIcePwd2,
+                  cricket::ICEMODE_FULL, cricket::CONNECTIONROLE_PASSIVE,
+                  nullptr);
+  AddVideoSection(remote_answer.get(), kVideoMid1, kIceUfrag2, kIcePwd2,
+                  cricket::ICEMODE_FULL, cricket::CONNECTIONROLE_PASSIVE,
+                  nullptr);
+  EXPECT_TRUE(transport_controller_
+                  ->SetLocalDescription(SdpType::kOffer, local_offer.get())
+                  .ok());
+  EXPECT_TRUE(transport_controller_
+                  ->SetRemoteDescription(SdpType::kAnswer, remote_answer.get())
+                  .ok());
+
+  auto restart_local_offer = std::make_unique<cricket::SessionDescription>();
+  AddAudioSection(restart_local_offer.get(), kAudioMid1, kIceUfrag1, kIcePwd1,
+                  cricket::ICEMODE_FULL, cricket::CONNECTIONROLE_ACTPASS,
+                  nullptr);
+  AddVideoSection(restart_local_offer.get(), kVideoMid1, kIceUfrag3, kIcePwd3,
+                  cricket::ICEMODE_FULL, cricket::CONNECTIONROLE_ACTPASS,
+                  nullptr);
+  auto restart_remote_answer = std::make_unique<cricket::SessionDescription>();
+  AddAudioSection(restart_remote_answer.get(), kAudioMid1, kIceUfrag2,
+                  kIcePwd2, cricket::ICEMODE_FULL,
+                  cricket::CONNECTIONROLE_PASSIVE, nullptr);
+  AddVideoSection(restart_remote_answer.get(), kVideoMid1, kIceUfrag4,
+                  kIcePwd4, cricket::ICEMODE_FULL,
+                  cricket::CONNECTIONROLE_PASSIVE, nullptr);
+  EXPECT_TRUE(
+      transport_controller_
+          ->SetLocalDescription(SdpType::kOffer, restart_local_offer.get())
+          .ok());
+  EXPECT_TRUE(
+      transport_controller_
+          ->SetRemoteDescription(SdpType::kAnswer, restart_remote_answer.get())
+          .ok());
+
+  auto fake_audio_dtls = static_cast<FakeDtlsTransport*>(
+      transport_controller_->GetDtlsTransport(kAudioMid1));
+  auto fake_video_dtls = static_cast<FakeDtlsTransport*>(
+      transport_controller_->GetDtlsTransport(kVideoMid1));
+  EXPECT_EQ(kIceUfrag1, fake_audio_dtls->fake_ice_transport()->ice_ufrag());
+  EXPECT_EQ(kIceUfrag2,
+            fake_audio_dtls->fake_ice_transport()->remote_ice_ufrag());
+  EXPECT_EQ(kIceUfrag3, fake_video_dtls->fake_ice_transport()->ice_ufrag());
+  EXPECT_EQ(kIceUfrag4,
+            fake_video_dtls->fake_ice_transport()->remote_ice_ufrag());
+}
+
 TEST_F(JsepTransportControllerTest, MultipleMediaSectionsOfSameTypeWithBundle) {
   CreateJsepTransportController(JsepTransportController::Config());
   cricket::ContentGroup bundle_group(cricket::GROUP_TYPE_BUNDLE);
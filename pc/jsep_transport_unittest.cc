@@ -740,6 +740,84 @@ TEST_F(JsepTransport2Test, ValidDtlsReofferFromAnswerer) {
           .ok());
 }
 
+// Test that a renegotiation only needs to be applied when a description has
+// changed.
+TEST_F(JsepTransport2Test, IsDescriptionAppliedAfterNegotiation) {
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+      rtc::RTCCertificate::Create(
+          rtc::SSLIdentity::Create("testing", rtc::KT_ECDSA));
+  bool rtcp_mux_enabled = true;
+  jsep_transport_ = CreateJsepTransport2(rtcp_mux_enabled, SrtpMode::kDtlsSrtp);
+  jsep_transport_->SetLocalCertificate(certificate);
+
+  JsepTransportDescription local_offer =
+      MakeJsepTransportDescription(rtcp_mux_enabled, kIceUfrag1, kIcePwd1,
+                                   certificate, CONNECTIONROLE_ACTPASS);
+  JsepTransportDescription remote_answer =
+      MakeJsepTransportDescription(rtcp_mux_enabled, kIceUfrag2, kIcePwd2,
+                                   certificate, CONNECTIONROLE_ACTIVE);
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(CS_LOCAL, local_offer,
+                                                     SdpType::kOffer));
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetLocalJsepTransportDescription(local_offer, SdpType::kOffer)
+          .ok());
+  // RTCP mux isn't negotiated before the answer.
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(CS_LOCAL, local_offer,
+                                                     SdpType::kOffer));
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetRemoteJsepTransportDescription(remote_answer, SdpType::kAnswer)
+          .ok());
+
+  EXPECT_TRUE(jsep_transport_->IsDescriptionApplied(CS_LOCAL, local_offer,
+                                                    SdpType::kOffer));
+  EXPECT_TRUE(jsep_transport_->IsDescriptionApplied(CS_REMOTE, remote_answer,
+                                                    SdpType::kAnswer));
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(
+      CS_REMOTE, remote_answer, SdpType::kPrAnswer));
+
+  // An ICE restart in the next offer changes the local description.
+  JsepTransportDescription restart_offer =
+      MakeJsepTransportDescription(rtcp_mux_enabled, kIceUfrag2, kIcePwd2,
+                                   certificate, CONNECTIONROLE_ACTPASS);
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(CS_LOCAL, restart_offer,
+                                                     SdpType::kOffer));
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetLocalJsepTransportDescription(restart_offer, SdpType::kOffer)
+          .ok());
+  // DTLS has to be negotiated again for the new offer, even though the answer
+  // is unchanged.
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(CS_REMOTE, remote_answer,
+                                                     SdpType::kAnswer));
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetRemoteJsepTransportDescription(remote_answer, SdpType::kAnswer)
+          .ok());
+  EXPECT_TRUE(jsep_transport_->IsDescriptionApplied(CS_REMOTE, remote_answer,
+                                                    SdpType::kAnswer));
+}
+
+TEST_F(JsepTransport2Test, SdesDescriptionsAreAlwaysApplied) {
+  jsep_transport_ =
+      CreateJsepTransport2(/*rtcp_mux_enabled=*/true, SrtpMode::kSdes);
+  JsepTransportDescription offer_desc;
+  offer_desc.cryptos.push_back(cricket::CryptoParams(
+      1, rtc::kCsAesCm128HmacSha1_32, "inline:" + rtc::CreateRandomString(40),
+      std::string()));
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetLocalJsepTransportDescription(offer_desc, SdpType::kOffer)
+          .ok());
+  ASSERT_TRUE(
+      jsep_transport_
+          ->SetRemoteJsepTransportDescription(offer_desc, SdpType::kAnswer)
+          .ok());
+  EXPECT_FALSE(jsep_transport_->IsDescriptionApplied(CS_LOCAL, offer_desc,
+                                                     SdpType::kOffer));
+}
+
 // Test that a reoffer in the opposite direction fails if the role changes.
 // Inverse of test above.
 TEST_F(JsepTransport2Test, InvalidDtlsReofferFromAnswerer) {
@@ -514,6 +514,10 @@ PeerConnection::PeerConnection(
       ice_transport_factory_(std::move(dependencies.ice_transport_factory)),
       tls_cert_verifier_(std::move(dependencies.tls_cert_verifier)),
       call_(std::move(call)),
+      // Detached, so that creating it doesn't need a hop to the worker thread.
+      worker_thread_safety_(
+          call_ ? PendingTaskSafetyFlag::CreateDetached()
+                : PendingTaskSafetyFlag::CreateDetachedInactive()),
       call_ptr_(call_.get()),
       // RFC 3264: The numeric value of the session id and version in the
       // o line MUST be representable with a "64 bit signed integer".
@@ -523,14 +527,7 @@ PeerConnection::PeerConnection(
       dtls_enabled_(dtls_enabled),
       data_channel_controller_(this),
       message_handler_(signaling_thread()),
-      weak_factory_(this) {
-  worker_thread()->Invoke<void>(RTC_FROM_HERE, [this] {
-    RTC_DCHECK_RUN_ON(worker_thread());
-    worker_thread_safety_ = PendingTaskSafetyFlag::Create();
-    if (!call_)
-      worker_thread_safety_->SetNotAlive();
-  });
-}
+      weak_factory_(this) {}
 
 PeerConnection::~PeerConnection() {
   TRACE_EVENT0("webrtc", "PeerConnection::~PeerConnection");
@@ -1259,6 +1256,15 @@ void PeerConnection::GetStats(
   stats_collector_->GetStatsReport(internal_receiver, callback);
 }
 
+void PeerConnection::GetStatsDelta(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  TRACE_EVENT0("webrtc", "PeerConnection::GetStatsDelta");
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK(stats_collector_);
+  RTC_DCHECK(callback);
+  stats_collector_->GetStatsReportDelta(callback);
+}
+
 PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
   RTC_DCHECK_RUN_ON(signaling_thread());
   return sdp_handler_->signaling_state();
@@ -1266,25 +1272,21 @@ PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
 
 PeerConnectionInterface::IceConnectionState
 PeerConnection::ice_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return ice_connection_state_;
 }
 
 PeerConnectionInterface::IceConnectionState
 PeerConnection::standardized_ice_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return standardized_ice_connection_state_;
 }
 
 PeerConnectionInterface::PeerConnectionState
 PeerConnection::peer_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return connection_state_;
 }
 
 PeerConnectionInterface::IceGatheringState
 PeerConnection::ice_gathering_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return ice_gathering_state_;
 }
 
@@ -1623,7 +1625,11 @@ RTCError PeerConnection::SetBitrate(const BitrateSettings& bitrate) {
     }
   }
 
-  RTC_DCHECK(call_.get());
+  if (!call_) {
+    // Data channel only PeerConnections, and closed ones, have no `Call`.
+    LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_STATE,
+                         "No media to set the bitrate of");
+  }
   call_->SetClientBitratePreferences(bitrate);
 
   return RTCError::OK();
@@ -1845,8 +1851,8 @@ void PeerConnection::SetIceConnectionState(IceConnectionState new_state) {
     return;
   }
 
-  RTC_LOG(LS_INFO) << "Changing IceConnectionState " << ice_connection_state_
-                   << " => " << new_state;
+  RTC_LOG(LS_INFO) << "Changing IceConnectionState "
+                   << ice_connection_state_.load() << " => " << new_state;
   RTC_DCHECK(ice_connection_state_ !=
              PeerConnectionInterface::kIceConnectionClosed);
 
@@ -1865,7 +1871,8 @@ void PeerConnection::SetStandardizedIceConnectionState(
   }
 
   RTC_LOG(LS_INFO) << "Changing standardized IceConnectionState "
-                   << standardized_ice_connection_state_ << " => " << new_state;
+                   << standardized_ice_connection_state_.load() << " => "
+                   << new_state;
 
   standardized_ice_connection_state_ = new_state;
   Observer()->OnStandardizedIceConnectionChange(new_state);
@@ -2940,6 +2947,10 @@ PeerConnection::InitializeRtcpCallback() {
   RTC_DCHECK_RUN_ON(network_thread());
   return [this](const rtc::CopyOnWriteBuffer& packet, int64_t packet_time_us) {
     RTC_DCHECK_RUN_ON(network_thread());
+    if (!call_ptr_) {
+      // Without media, there is no RTCP to process.
+      return;
+    }
     call_ptr_->Receiver()->DeliverPacket(MediaType::ANY, packet,
                                          packet_time_us);
   };
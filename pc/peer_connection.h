@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
@@ -180,6 +181,8 @@ class PeerConnection : public PeerConnectionInternal,
   void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
+  void GetStatsDelta(
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
   void ClearStatsCache() override;
 
   SignalingState signaling_state() override;
@@ -370,6 +373,12 @@ class PeerConnection : public PeerConnectionInternal,
   Call* call_ptr() override { return call_ptr_; }
 
   ConnectionContext* context() { return context_.get(); }
+  // The collector behind GetStats(), for gathering the stats of several
+  // PeerConnections together.
+  rtc::scoped_refptr<RTCStatsCollector> rtc_stats_collector() {
+    RTC_DCHECK_RUN_ON(signaling_thread());
+    return stats_collector_;
+  }
   const PeerConnectionFactoryInterface::Options* options() const override {
     return &options_;
   }
@@ -622,15 +631,14 @@ class PeerConnection : public PeerConnectionInternal,
   // pointer (but not touch the object) from any thread.
   RtcEventLog* const event_log_ptr_ RTC_PT_GUARDED_BY(worker_thread());
 
-  IceConnectionState ice_connection_state_ RTC_GUARDED_BY(signaling_thread()) =
-      kIceConnectionNew;
-  PeerConnectionInterface::IceConnectionState standardized_ice_connection_state_
-      RTC_GUARDED_BY(signaling_thread()) = kIceConnectionNew;
-  PeerConnectionInterface::PeerConnectionState connection_state_
-      RTC_GUARDED_BY(signaling_thread()) = PeerConnectionState::kNew;
+  // Written on the signaling thread. Atomic, so that the getters can be
+  // called on any thread without a hop, see PeerConnectionProxy.
+  std::atomic<IceConnectionState> ice_connection_state_{kIceConnectionNew};
+  std::atomic<IceConnectionState> standardized_ice_connection_state_{
+      kIceConnectionNew};
+  std::atomic<PeerConnectionState> connection_state_{PeerConnectionState::kNew};
+  std::atomic<IceGatheringState> ice_gathering_state_{kIceGatheringNew};
 
-  IceGatheringState ice_gathering_state_ RTC_GUARDED_BY(signaling_thread()) =
-      kIceGatheringNew;
   PeerConnectionInterface::RTCConfiguration configuration_
       RTC_GUARDED_BY(signaling_thread());
 
@@ -653,7 +661,7 @@ class PeerConnection : public PeerConnectionInternal,
   std::unique_ptr<Call> call_ RTC_GUARDED_BY(worker_thread());
   ScopedTaskSafety signaling_thread_safety_;
   rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety_;
-  rtc::scoped_refptr<PendingTaskSafetyFlag> worker_thread_safety_;
+  const rtc::scoped_refptr<PendingTaskSafetyFlag> worker_thread_safety_;
 
   // Points to the same thing as `call_`. Since it's const, we may read the
   // pointer from any thread.
@@ -129,7 +129,14 @@ class PeerConnectionDataChannelBaseTest : public ::testing::Test {
   WrapperPtr CreatePeerConnection(
       const RTCConfiguration& config,
       const PeerConnectionFactoryInterface::Options factory_options) {
-    auto factory_deps = CreatePeerConnectionFactoryDependencies();
+    return CreatePeerConnection(config, factory_options,
+                                CreatePeerConnectionFactoryDependencies());
+  }
+
+  WrapperPtr CreatePeerConnection(
+      const RTCConfiguration& config,
+      const PeerConnectionFactoryInterface::Options factory_options,
+      PeerConnectionFactoryDependencies factory_deps) {
     FakeSctpTransportFactory* fake_sctp_transport_factory =
         static_cast<FakeSctpTransportFactory*>(factory_deps.sctp_factory.get());
     rtc::scoped_refptr<PeerConnectionFactoryInterface> pc_factory =
@@ -329,6 +336,34 @@ TEST_P(PeerConnectionDataChannelTest, ObsoleteSdpSyntaxIfSet) {
   EXPECT_THAT(sdp, HasSubstr("a=sctpmap:"));
 }
 
+TEST_P(PeerConnectionDataChannelTest, DataChannelOnlyFactoryNegotiatesData) {
+  auto create_data_channel_only_deps = [] {
+    auto factory_deps = CreatePeerConnectionFactoryDependencies();
+    factory_deps.media_engine = nullptr;
+    factory_deps.call_factory = nullptr;
+    return factory_deps;
+  };
+  auto caller =
+      CreatePeerConnection(RTCConfiguration(),
+                           PeerConnectionFactoryInterface::Options(),
+                           create_data_channel_only_deps());
+  auto callee =
+      CreatePeerConnection(RTCConfiguration(),
+                           PeerConnectionFactoryInterface::Options(),
+                           create_data_channel_only_deps());
+  ASSERT_TRUE(caller);
+  ASSERT_TRUE(callee);
+  EXPECT_TRUE(caller->pc()->CreateDataChannel("dc", nullptr));
+
+  ASSERT_TRUE(caller->ExchangeOfferAnswerWith(callee.get()));
+
+  EXPECT_TRUE(caller->sctp_transport_name());
+  EXPECT_TRUE(callee->sctp_transport_name());
+  // There is no `Call` to set the bitrate of.
+  EXPECT_EQ(caller->pc()->SetBitrate(BitrateSettings()).type(),
+            RTCErrorType::INVALID_STATE);
+}
+
 INSTANTIATE_TEST_SUITE_P(PeerConnectionDataChannelTest,
                          PeerConnectionDataChannelTest,
                          Values(SdpSemantics::kPlanB,
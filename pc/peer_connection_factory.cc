@@ -40,6 +40,7 @@
 #include "pc/peer_connection.h"
 #include "pc/peer_connection_factory_proxy.h"
 #include "pc/peer_connection_proxy.h"
+#include "pc/rtc_stats_collector.h"
 #include "pc/rtp_parameters_conversion.h"
 #include "pc/session_description.h"
 #include "pc/video_track.h"
@@ -52,6 +53,7 @@
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/trace_event.h"
 
 namespace webrtc {
 
@@ -120,6 +122,17 @@ PeerConnectionFactory::~PeerConnectionFactory() {
 void PeerConnectionFactory::SetOptions(const Options& options) {
   RTC_DCHECK_RUN_ON(signaling_thread());
   options_ = options;
+
+  const rtc::RTCCertificatePool::Config& pool_config = options.certificate_pool;
+  if (pool_config.size <= 0) {
+    certificate_pool_ = nullptr;
+  } else if (!certificate_pool_ ||
+             certificate_pool_->config().size != pool_config.size ||
+             certificate_pool_->config().key_params != pool_config.key_params ||
+             certificate_pool_->config().max_age_ms != pool_config.max_age_ms) {
+    certificate_pool_ = rtc::RTCCertificatePool::Create(
+        signaling_thread(), network_thread(), pool_config);
+  }
 }
 
 RtpCapabilities PeerConnectionFactory::GetRtpSenderCapabilities(
@@ -194,6 +207,27 @@ void PeerConnectionFactory::StopAecDump() {
   channel_manager()->StopAecDump();
 }
 
+void PeerConnectionFactory::GetPeerConnectionStats(
+    std::vector<rtc::scoped_refptr<PeerConnectionInterface>> peer_connections,
+    std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks) {
+  TRACE_EVENT0("webrtc", "PeerConnectionFactory::GetPeerConnectionStats");
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK_EQ(peer_connections.size(), callbacks.size());
+  std::vector<rtc::scoped_refptr<RTCStatsCollector>> collectors;
+  collectors.reserve(peer_connections.size());
+  for (const auto& peer_connection : peer_connections) {
+    // The factory hands out PeerConnections wrapped in a proxy, see
+    // CreatePeerConnectionOrError().
+    auto* internal = static_cast<PeerConnection*>(
+        static_cast<PeerConnectionProxyWithInternal<PeerConnectionInterface>*>(
+            peer_connection.get())
+            ->internal());
+    RTC_DCHECK_EQ(internal->context(), context_.get());
+    collectors.push_back(internal->rtc_stats_collector());
+  }
+  RTCStatsCollector::GetStatsReports(collectors, std::move(callbacks));
+}
+
 RTCErrorOr<rtc::scoped_refptr<PeerConnectionInterface>>
 PeerConnectionFactory::CreatePeerConnectionOrError(
     const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -206,8 +240,8 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
-        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
-                                                       network_thread());
+        std::make_unique<rtc::RTCCertificateGenerator>(
+            signaling_thread(), network_thread(), certificate_pool_);
   }
   if (!dependencies.allocator) {
     rtc::PacketSocketFactory* packet_socket_factory;
@@ -239,13 +273,17 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetNetworkIgnoreMask(options().network_ignore_mask);
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
-  std::unique_ptr<RtcEventLog> event_log =
-      worker_thread()->Invoke<std::unique_ptr<RtcEventLog>>(
-          RTC_FROM_HERE, [this] { return CreateRtcEventLog_w(); });
-
-  std::unique_ptr<Call> call = worker_thread()->Invoke<std::unique_ptr<Call>>(
-      RTC_FROM_HERE,
-      [this, &event_log] { return CreateCall_w(event_log.get()); });
+  // The event log and the `Call` are created in a single hop to the worker
+  // thread. Data channel only factories, which have no media engine, don't
+  // have a `Call`.
+  const bool create_call = channel_manager()->media_engine() != nullptr;
+  std::unique_ptr<RtcEventLog> event_log;
+  std::unique_ptr<Call> call;
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    event_log = CreateRtcEventLog_w();
+    if (create_call)
+      call = CreateCall_w(event_log.get());
+  });
 
   auto result = PeerConnection::Create(context_, options_, std::move(event_log),
                                        std::move(call), configuration,
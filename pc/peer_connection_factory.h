@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/audio_options.h"
@@ -33,6 +34,7 @@
 #include "api/rtp_parameters.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/stats/rtc_stats_collector_callback.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/transport/network_control.h"
 #include "api/transport/sctp_transport_factory_interface.h"
@@ -96,6 +98,11 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   bool StartAecDump(FILE* file, int64_t max_size_bytes) override;
   void StopAecDump() override;
 
+  void GetPeerConnectionStats(
+      std::vector<rtc::scoped_refptr<PeerConnectionInterface>> peer_connections,
+      std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks)
+      override;
+
   SctpTransportFactoryInterface* sctp_transport_factory() {
     return context_->sctp_transport_factory();
   }
@@ -143,6 +150,8 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   rtc::scoped_refptr<ConnectionContext> context_;
   PeerConnectionFactoryInterface::Options options_
       RTC_GUARDED_BY(signaling_thread());
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_
+      RTC_GUARDED_BY(signaling_thread());
   std::unique_ptr<TaskQueueFactory> task_queue_factory_;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
   std::unique_ptr<FecControllerFactoryInterface> fec_controller_factory_;
@@ -51,6 +51,10 @@ PROXY_METHOD2(rtc::scoped_refptr<AudioTrackInterface>,
               AudioSourceInterface*)
 PROXY_SECONDARY_METHOD2(bool, StartAecDump, FILE*, int64_t)
 PROXY_SECONDARY_METHOD0(void, StopAecDump)
+PROXY_METHOD2(void,
+              GetPeerConnectionStats,
+              std::vector<rtc::scoped_refptr<PeerConnectionInterface>>,
+              std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>>)
 END_PROXY_MAP(PeerConnectionFactory)
 
 }  // namespace webrtc
@@ -31,6 +31,8 @@
 #include "p2p/base/port_interface.h"
 #include "pc/test/fake_audio_capture_module.h"
 #include "pc/test/fake_video_track_source.h"
+#include "pc/test/rtc_stats_obtainer.h"
+#include "rtc_base/gunit.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/time_utils.h"
@@ -297,6 +299,34 @@ TEST_F(PeerConnectionFactoryTest, CreatePCUsingIceServers) {
   VerifyTurnServers(turn_servers);
 }
 
+TEST_F(PeerConnectionFactoryTest, GetPeerConnectionStats) {
+  PeerConnectionInterface::RTCConfiguration config;
+  config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 2; ++i) {
+    webrtc::PeerConnectionDependencies dependencies(&observer_);
+    dependencies.allocator = std::make_unique<cricket::FakePortAllocator>(
+        rtc::Thread::Current(), nullptr);
+    dependencies.cert_generator =
+        std::make_unique<FakeRTCCertificateGenerator>();
+    auto result =
+        factory_->CreatePeerConnectionOrError(config, std::move(dependencies));
+    ASSERT_TRUE(result.ok());
+    pcs.push_back(result.MoveValue());
+  }
+
+  rtc::scoped_refptr<const webrtc::RTCStatsReport> first_report,
+      second_report;
+  factory_->GetPeerConnectionStats(
+      pcs, {webrtc::RTCStatsObtainer::Create(&first_report),
+            webrtc::RTCStatsObtainer::Create(&second_report)});
+  EXPECT_TRUE_WAIT(first_report, 1000);
+  EXPECT_TRUE_WAIT(second_report, 1000);
+  EXPECT_NE(first_report.get(), second_report.get());
+  EXPECT_TRUE(first_report->Get("RTCPeerConnection"));
+  EXPECT_TRUE(second_report->Get("RTCPeerConnection"));
+}
+
 // This test verifies creation of PeerConnection with valid STUN and TURN
 // configuration. Also verifies the list of URL's parsed correctly as expected.
 TEST_F(PeerConnectionFactoryTest, CreatePCUsingIceServersUrls) {
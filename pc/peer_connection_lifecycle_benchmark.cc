@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures a participant joining and leaving a call: creating a pair of
+// PeerConnections, negotiating an audio and a video transceiver between them
+// and closing both. The network and worker threads are separate from the
+// signaling thread, so every blocking hop between the threads is part of the
+// measured time, as it is on a server. Media, certificate generation and
+// networking are faked, so that the hops aren't drowned out by them.
+
+#include <memory>
+#include <utility>
+
+#include "api/call/call_factory_interface.h"
+#include "api/peer_connection_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "benchmark/benchmark.h"
+#include "media/base/fake_media_engine.h"
+#include "p2p/base/fake_port_allocator.h"
+#include "pc/peer_connection_wrapper.h"
+#include "pc/test/fake_rtc_certificate_generator.h"
+#include "pc/test/mock_peer_connection_observers.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+namespace {
+
+class LifecycleFixture {
+ public:
+  LifecycleFixture()
+      : network_thread_(rtc::Thread::CreateWithSocketServer()),
+        worker_thread_(rtc::Thread::Create()) {
+    network_thread_->Start();
+    worker_thread_->Start();
+    PeerConnectionFactoryDependencies dependencies;
+    dependencies.network_thread = network_thread_.get();
+    dependencies.worker_thread = worker_thread_.get();
+    dependencies.signaling_thread = rtc::Thread::Current();
+    dependencies.task_queue_factory = CreateDefaultTaskQueueFactory();
+    dependencies.media_engine = std::make_unique<cricket::FakeMediaEngine>();
+    dependencies.call_factory = CreateCallFactory();
+    factory_ = CreateModularPeerConnectionFactory(std::move(dependencies));
+  }
+
+  std::unique_ptr<PeerConnectionWrapper> CreatePeerConnection() {
+    auto observer = std::make_unique<MockPeerConnectionObserver>();
+    PeerConnectionInterface::RTCConfiguration config;
+    config.sdp_semantics = SdpSemantics::kUnifiedPlan;
+    PeerConnectionDependencies dependencies(observer.get());
+    dependencies.allocator = std::make_unique<cricket::FakePortAllocator>(
+        network_thread_.get(), nullptr);
+    dependencies.cert_generator =
+        std::make_unique<FakeRTCCertificateGenerator>();
+    auto result =
+        factory_->CreatePeerConnectionOrError(config, std::move(dependencies));
+    RTC_CHECK(result.ok());
+    observer->SetPeerConnectionInterface(result.value());
+    return std::make_unique<PeerConnectionWrapper>(
+        factory_, result.MoveValue(), std::move(observer));
+  }
+
+ private:
+  const std::unique_ptr<rtc::Thread> network_thread_;
+  const std::unique_ptr<rtc::Thread> worker_thread_;
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory_;
+};
+
+void BM_CreateNegotiateClose(benchmark::State& state) {
+  rtc::AutoThread signaling_thread;
+  LifecycleFixture fixture;
+  for (auto _ : state) {
+    std::unique_ptr<PeerConnectionWrapper> caller =
+        fixture.CreatePeerConnection();
+    std::unique_ptr<PeerConnectionWrapper> callee =
+        fixture.CreatePeerConnection();
+    caller->AddTransceiver(cricket::MEDIA_TYPE_AUDIO);
+    caller->AddTransceiver(cricket::MEDIA_TYPE_VIDEO);
+    RTC_CHECK(caller->ExchangeOfferAnswerWith(callee.get()));
+    caller->pc()->Close();
+    callee->pc()->Close();
+  }
+}
+BENCHMARK(BM_CreateNegotiateClose)->Unit(benchmark::kMicrosecond);
+
+void BM_CreateClose(benchmark::State& state) {
+  rtc::AutoThread signaling_thread;
+  LifecycleFixture fixture;
+  for (auto _ : state) {
+    std::unique_ptr<PeerConnectionWrapper> pc = fixture.CreatePeerConnection();
+    pc->pc()->Close();
+  }
+}
+BENCHMARK(BM_CreateClose)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -68,13 +68,14 @@ PROXY_METHOD3(bool,
               MediaStreamTrackInterface*,
               StatsOutputLevel)
 PROXY_METHOD1(void, GetStats, RTCStatsCollectorCallback*)
-PROXY_METHOD2(void,
-              GetStats,
-              rtc::scoped_refptr<RtpSenderInterface>,
-              rtc::scoped_refptr<RTCStatsCollectorCallback>)
-PROXY_METHOD2(void,
-              GetStats,
-              rtc::scoped_refptr<RtpReceiverInterface>,
+PROXY_ASYNC_METHOD2(GetStats,
+                    rtc::scoped_refptr<RtpSenderInterface>,
+                    rtc::scoped_refptr<RTCStatsCollectorCallback>)
+PROXY_ASYNC_METHOD2(GetStats,
+                    rtc::scoped_refptr<RtpReceiverInterface>,
+                    rtc::scoped_refptr<RTCStatsCollectorCallback>)
+PROXY_METHOD1(void,
+              GetStatsDelta,
               rtc::scoped_refptr<RTCStatsCollectorCallback>)
 PROXY_METHOD0(void, ClearStatsCache)
 PROXY_METHOD2(RTCErrorOr<rtc::scoped_refptr<DataChannelInterface>>,
@@ -126,10 +127,9 @@ PROXY_METHOD1(RTCError,
               SetConfiguration,
               const PeerConnectionInterface::RTCConfiguration&)
 PROXY_METHOD1(bool, AddIceCandidate, const IceCandidateInterface*)
-PROXY_METHOD2(void,
-              AddIceCandidate,
-              std::unique_ptr<IceCandidateInterface>,
-              std::function<void(RTCError)>)
+PROXY_ASYNC_METHOD2(AddIceCandidate,
+                    std::unique_ptr<IceCandidateInterface>,
+                    std::function<void(RTCError)>)
 PROXY_METHOD1(bool, RemoveIceCandidates, const std::vector<cricket::Candidate>&)
 PROXY_METHOD1(RTCError, SetBitrate, const BitrateSettings&)
 PROXY_METHOD1(void, SetAudioPlayout, bool)
@@ -144,10 +144,10 @@ PROXY_SECONDARY_METHOD1(rtc::scoped_refptr<DtlsTransportInterface>,
 PROXY_SECONDARY_CONSTMETHOD0(rtc::scoped_refptr<SctpTransportInterface>,
                              GetSctpTransport)
 PROXY_METHOD0(SignalingState, signaling_state)
-PROXY_METHOD0(IceConnectionState, ice_connection_state)
-PROXY_METHOD0(IceConnectionState, standardized_ice_connection_state)
-PROXY_METHOD0(PeerConnectionState, peer_connection_state)
-PROXY_METHOD0(IceGatheringState, ice_gathering_state)
+BYPASS_PROXY_METHOD0(IceConnectionState, ice_connection_state)
+BYPASS_PROXY_METHOD0(IceConnectionState, standardized_ice_connection_state)
+BYPASS_PROXY_METHOD0(PeerConnectionState, peer_connection_state)
+BYPASS_PROXY_METHOD0(IceGatheringState, ice_gathering_state)
 PROXY_METHOD0(absl::optional<bool>, can_trickle_ice_candidates)
 PROXY_METHOD1(void, AddAdaptationResource, rtc::scoped_refptr<Resource>)
 PROXY_METHOD2(bool,
@@ -55,6 +55,11 @@
 //
 // The variant defined with BEGIN_OWNED_PROXY_MAP does not use
 // refcounting, and instead just takes ownership of the object being proxied.
+//
+// Void methods that report their results through callbacks can use
+// PROXY_ASYNC_METHOD*, so that callers on other threads don't block until the
+// call has been made on the primary thread. Calls from one thread are still
+// made in the order they were issued, also relative to blocking calls.
 
 #ifndef PC_PROXY_H_
 #define PC_PROXY_H_
@@ -201,6 +206,43 @@ class ConstMethodCall : public QueuedTask {
   rtc::Event event_;
 };
 
+// Posts a call to a void method without waiting for it to return. Results are
+// expected to be reported through callbacks taken by the method. The
+// arguments are copied or moved into the task, and the object is kept alive
+// until the call has been made, so only refcounted proxies can post calls.
+template <typename C, typename... Args>
+class AsyncMethodCall : public QueuedTask {
+ public:
+  typedef void (C::*Method)(Args...);
+  AsyncMethodCall(C* c, Method m, Args&&... args)
+      : c_(c), m_(m), args_(std::forward<Args>(args)...) {}
+
+  static void Post(rtc::Thread* t, C* c, Method m, Args&&... args) {
+    auto call =
+        std::make_unique<AsyncMethodCall>(c, m, std::forward<Args>(args)...);
+    if (t->IsCurrent()) {
+      call->Run();
+    } else {
+      t->PostTask(std::move(call));
+    }
+  }
+
+ private:
+  bool Run() override {
+    Invoke(std::index_sequence_for<Args...>());
+    return true;
+  }
+
+  template <size_t... Is>
+  void Invoke(std::index_sequence<Is...>) {
+    (c_.get()->*m_)(std::move(std::get<Is>(args_))...);
+  }
+
+  const rtc::scoped_refptr<C> c_;
+  Method m_;
+  std::tuple<std::decay_t<Args>...> args_;
+};
+
 #define PROXY_STRINGIZE_IMPL(x) #x
 #define PROXY_STRINGIZE(x) PROXY_STRINGIZE_IMPL(x)
 
@@ -411,6 +453,22 @@ class ConstMethodCall : public QueuedTask {
   }
 
 // Define methods which should be invoked on the secondary thread.
+// Calls on the primary thread are made inline; calls from other threads are
+// posted to it and return without waiting.
+#define PROXY_ASYNC_METHOD1(method, t1)                                      \
+  void method(t1 a1) override {                                              \
+    TRACE_BOILERPLATE(method);                                               \
+    AsyncMethodCall<C, t1>::Post(primary_thread_, c(), &C::method,           \
+                                 std::move(a1));                             \
+  }
+
+#define PROXY_ASYNC_METHOD2(method, t1, t2)                                  \
+  void method(t1 a1, t2 a2) override {                                       \
+    TRACE_BOILERPLATE(method);                                               \
+    AsyncMethodCall<C, t1, t2>::Post(primary_thread_, c(), &C::method,       \
+                                     std::move(a1), std::move(a2));          \
+  }
+
 #define PROXY_SECONDARY_METHOD0(r, method)                 \
   r method() override {                                    \
     TRACE_BOILERPLATE(method);                             \
@@ -480,6 +538,15 @@ class ConstMethodCall : public QueuedTask {
     return c_->method();                     \
   }
 
+// For methods that the implementation makes safe to call on any thread, e.g.
+// by returning an atomic snapshot of state owned by the primary thread. The
+// snapshot may be stale by the time the caller looks at it.
+#define BYPASS_PROXY_METHOD0(r, method) \
+  r method() override {                 \
+    TRACE_BOILERPLATE(method);          \
+    return c_->method();                \
+  }
+
 }  // namespace webrtc
 
 #endif  //  PC_PROXY_H_
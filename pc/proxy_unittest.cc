@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 
+#include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ref_count.h"
 #include "test/gmock.h"
@@ -34,6 +35,8 @@ class FakeInterface : public rtc::RefCountInterface {
   virtual std::string Method1(std::string s) = 0;
   virtual std::string ConstMethod1(std::string s) const = 0;
   virtual std::string Method2(std::string s1, std::string s2) = 0;
+  virtual void AsyncMethod1(std::string s) = 0;
+  virtual std::string ThreadSafeMethod0() = 0;
 
  protected:
   virtual ~FakeInterface() {}
@@ -56,6 +59,8 @@ class Fake : public FakeInterface {
   MOCK_METHOD(std::string, ConstMethod1, (std::string), (const, override));
 
   MOCK_METHOD(std::string, Method2, (std::string, std::string), (override));
+  MOCK_METHOD(void, AsyncMethod1, (std::string), (override));
+  MOCK_METHOD(std::string, ThreadSafeMethod0, (), (override));
 
  protected:
   Fake() {}
@@ -71,6 +76,8 @@ PROXY_CONSTMETHOD0(std::string, ConstMethod0)
 PROXY_SECONDARY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_SECONDARY_METHOD2(std::string, Method2, std::string, std::string)
+PROXY_ASYNC_METHOD1(AsyncMethod1, std::string)
+BYPASS_PROXY_METHOD0(std::string, ThreadSafeMethod0)
 END_PROXY_MAP(Fake)
 
 // Preprocessor hack to get a proxy class a name different than FakeProxy.
@@ -84,6 +91,8 @@ PROXY_CONSTMETHOD0(std::string, ConstMethod0)
 PROXY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_METHOD2(std::string, Method2, std::string, std::string)
+PROXY_ASYNC_METHOD1(AsyncMethod1, std::string)
+BYPASS_PROXY_METHOD0(std::string, ThreadSafeMethod0)
 END_PROXY_MAP(Fake)
 #undef FakeProxy
 
@@ -173,6 +182,45 @@ TEST_F(SignalingProxyTest, Method2) {
   EXPECT_EQ("Method2", fake_signaling_proxy_->Method2(arg1, arg2));
 }
 
+TEST_F(SignalingProxyTest, AsyncMethod1DoesNotWaitForTheCall) {
+  const std::string arg1 = "arg1";
+  rtc::Event proceed;
+  rtc::Event called;
+  EXPECT_CALL(*fake_, AsyncMethod1(arg1))
+      .Times(Exactly(1))
+      .WillOnce(InvokeWithoutArgs([&] {
+        CheckSignalingThread();
+        proceed.Wait(rtc::Event::kForever);
+        called.Set();
+      }));
+  fake_signaling_proxy_->AsyncMethod1(arg1);
+  // The call is blocked until here, so it must have been posted.
+  proceed.Set();
+  EXPECT_TRUE(called.Wait(rtc::Event::kForever));
+}
+
+TEST_F(SignalingProxyTest, AsyncMethod1IsOrderedWithBlockingCalls) {
+  ::testing::InSequence s;
+  EXPECT_CALL(*fake_, AsyncMethod1("first"));
+  EXPECT_CALL(*fake_, VoidMethod0());
+  EXPECT_CALL(*fake_, AsyncMethod1("second"));
+  EXPECT_CALL(*fake_, Method0()).WillOnce(Return("Method0"));
+  fake_signaling_proxy_->AsyncMethod1("first");
+  fake_signaling_proxy_->VoidMethod0();
+  fake_signaling_proxy_->AsyncMethod1("second");
+  EXPECT_EQ("Method0", fake_signaling_proxy_->Method0());
+}
+
+TEST_F(SignalingProxyTest, ThreadSafeMethod0BypassesTheSignalingThread) {
+  EXPECT_CALL(*fake_, ThreadSafeMethod0())
+      .Times(Exactly(1))
+      .WillOnce(DoAll(InvokeWithoutArgs([&] {
+                        EXPECT_FALSE(signaling_thread_->IsCurrent());
+                      }),
+                      Return("ThreadSafeMethod0")));
+  EXPECT_EQ("ThreadSafeMethod0", fake_signaling_proxy_->ThreadSafeMethod0());
+}
+
 class ProxyTest : public ::testing::Test {
  public:
   // Checks that the functions are called on the right thread.
@@ -543,6 +543,13 @@ void SetInboundRTPStreamStatsFromVideoReceiverInfo(
     inbound_video->decoder_implementation =
         video_receiver_info.decoder_implementation_name;
   }
+  if (!video_receiver_info.timing_frame_stage_delays_ms.empty()) {
+    std::map<std::string, double> stage_delays;
+    for (const auto& it : video_receiver_info.timing_frame_stage_delays_ms) {
+      stage_delays[it.first] = it.second / rtc::kNumMillisecsPerSec;
+    }
+    inbound_video->timing_frame_stage_delays = std::move(stage_delays);
+  }
 }
 
 // Provides the media independent counters (both audio and video).
@@ -1158,12 +1165,45 @@ rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredBySelector(
   return TakeReferencedStats(report->Copy(), rtpstream_ids);
 }
 
+std::unique_ptr<rtc::SSLCertificateStats> CopyCertificateStats(
+    const rtc::SSLCertificateStats& stats) {
+  std::string fingerprint = stats.fingerprint;
+  std::string fingerprint_algorithm = stats.fingerprint_algorithm;
+  std::string base64_certificate = stats.base64_certificate;
+  return std::make_unique<rtc::SSLCertificateStats>(
+      std::move(fingerprint), std::move(fingerprint_algorithm),
+      std::move(base64_certificate),
+      stats.issuer ? CopyCertificateStats(*stats.issuer) : nullptr);
+}
+
+std::vector<rtc::Buffer> GetCertChainDers(const rtc::SSLCertChain& chain) {
+  std::vector<rtc::Buffer> ders(chain.GetSize());
+  for (size_t i = 0; i < chain.GetSize(); ++i) {
+    chain.Get(i).ToDER(&ders[i]);
+  }
+  return ders;
+}
+
 }  // namespace
 
+RTCStatsCollector::CertificateStatsPair
+RTCStatsCollector::CertificateStatsPair::Copy() const {
+  CertificateStatsPair copy;
+  copy.local = local ? CopyCertificateStats(*local) : nullptr;
+  copy.remote = remote ? CopyCertificateStats(*remote) : nullptr;
+  return copy;
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
     : RequestInfo(FilterMode::kAll, std::move(callback), nullptr, nullptr) {}
 
+RTCStatsCollector::RequestInfo RTCStatsCollector::RequestInfo::CreateDelta(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  return RequestInfo(FilterMode::kDelta, std::move(callback), nullptr,
+                     nullptr);
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     rtc::scoped_refptr<RtpSenderInternal> selector,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
@@ -1241,9 +1281,119 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReportDelta(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(RequestInfo::CreateDelta(std::move(callback)));
+}
+
+// static
+void RTCStatsCollector::GetStatsReports(
+    const std::vector<rtc::scoped_refptr<RTCStatsCollector>>& collectors,
+    std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks) {
+  RTC_DCHECK_EQ(collectors.size(), callbacks.size());
+  if (collectors.empty()) {
+    return;
+  }
+  rtc::Thread* const signaling_thread = collectors[0]->signaling_thread_;
+  rtc::Thread* const worker_thread = collectors[0]->worker_thread_;
+  rtc::Thread* const network_thread = collectors[0]->network_thread_;
+  RTC_DCHECK_RUN_ON(signaling_thread);
+
+  std::vector<rtc::scoped_refptr<RTCStatsCollector>> gathering;
+  for (size_t i = 0; i < collectors.size(); ++i) {
+    RTC_DCHECK_EQ(collectors[i]->signaling_thread_, signaling_thread);
+    RTC_DCHECK_EQ(collectors[i]->worker_thread_, worker_thread);
+    RTC_DCHECK_EQ(collectors[i]->network_thread_, network_thread);
+    if (collectors[i]->QueueRequest(RequestInfo(std::move(callbacks[i])))) {
+      gathering.push_back(collectors[i]);
+    }
+  }
+  if (gathering.empty()) {
+    return;
+  }
+
+  // The same steps as GetStatsReportInternal() takes for a single collector,
+  // with each thread hop made once for all collectors.
+  int64_t timestamp_us = rtc::TimeUTCMicros();
+  std::vector<std::vector<
+      rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>>
+      transceivers(gathering.size());
+  std::vector<MediaChannelStats> media_channel_stats(gathering.size());
+  std::vector<absl::optional<std::string>> sctp_transport_names;
+  for (size_t i = 0; i < gathering.size(); ++i) {
+    gathering[i]->BeginGathering_s(timestamp_us);
+    gathering[i]->transceiver_stats_infos_.clear();
+    transceivers[i] = gathering[i]->pc_->GetTransceiversInternal();
+    sctp_transport_names.push_back(gathering[i]->pc_->sctp_transport_name());
+  }
+  network_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (size_t i = 0; i < gathering.size(); ++i) {
+      gathering[i]->PrepareTransceiverStatsInfos_n(transceivers[i],
+                                                   &media_channel_stats[i]);
+    }
+  });
+  worker_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (size_t i = 0; i < gathering.size(); ++i) {
+      gathering[i]->PrepareTrackMediaInfoMapsAndCallStats_w(
+          &media_channel_stats[i]);
+    }
+  });
+
+  for (const auto& collector : gathering) {
+    collector->network_report_event_.Reset();
+  }
+  network_thread->PostTask([gathering, signaling_thread, timestamp_us,
+                            sctp_transport_names =
+                                std::move(sctp_transport_names)]() mutable {
+    TRACE_EVENT0("webrtc", "RTCStatsCollector::GetStatsReports");
+    for (size_t i = 0; i < gathering.size(); ++i) {
+      gathering[i]->ProduceNetworkReport_n(timestamp_us,
+                                           std::move(sctp_transport_names[i]));
+    }
+    signaling_thread->PostTask([gathering = std::move(gathering)] {
+      for (const auto& collector : gathering) {
+        collector->MergeNetworkReport_s();
+      }
+    });
+  });
+  for (const auto& collector : gathering) {
+    collector->ProducePartialResultsOnSignalingThread(timestamp_us);
+  }
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK_RUN_ON(signaling_thread_);
+  if (!QueueRequest(std::move(request))) {
+    return;
+  }
+
+  // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
+  // UTC), in microseconds. The system clock could be modified and is not
+  // necessarily monotonically increasing.
+  int64_t timestamp_us = rtc::TimeUTCMicros();
+
+  BeginGathering_s(timestamp_us);
+  // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
+  // `ProducePartialResultsOnNetworkThread` and
+  // `ProducePartialResultsOnSignalingThread`.
+  PrepareTransceiverStatsInfosAndCallStats_s_w_n();
+  // Don't touch `network_report_` on the signaling thread until
+  // ProducePartialResultsOnNetworkThread() has signaled the
+  // `network_report_event_`.
+  network_report_event_.Reset();
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  network_thread_->PostTask(
+      [collector, sctp_transport_name = pc_->sctp_transport_name(),
+       timestamp_us]() mutable {
+        collector->ProducePartialResultsOnNetworkThread(
+            timestamp_us, std::move(sctp_transport_name));
+      });
+  ProducePartialResultsOnSignalingThread(timestamp_us);
+}
+
+bool RTCStatsCollector::QueueRequest(RTCStatsCollector::RequestInfo request) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
   requests_.push_back(std::move(request));
 
   // "Now" using a monotonically increasing timer.
@@ -1280,36 +1430,20 @@ void RTCStatsCollector::GetStatsReportInternal(
     signaling_thread_->PostTask(std::make_unique<DeliveryTask>(
         rtc::scoped_refptr<RTCStatsCollector>(this), cached_report_,
         std::move(requests)));
-  } else if (!num_pending_partial_reports_) {
-    // Only start gathering stats if we're not already gathering stats. In the
-    // case of already gathering stats, `callback_` will be invoked when there
-    // are no more pending partial reports.
-
-    // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
-    // UTC), in microseconds. The system clock could be modified and is not
-    // necessarily monotonically increasing.
-    int64_t timestamp_us = rtc::TimeUTCMicros();
-
-    num_pending_partial_reports_ = 2;
-    partial_report_timestamp_us_ = cache_now_us;
-
-    // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
-    // `ProducePartialResultsOnNetworkThread` and
-    // `ProducePartialResultsOnSignalingThread`.
-    PrepareTransceiverStatsInfosAndCallStats_s_w_n();
-    // Don't touch `network_report_` on the signaling thread until
-    // ProducePartialResultsOnNetworkThread() has signaled the
-    // `network_report_event_`.
-    network_report_event_.Reset();
-    rtc::scoped_refptr<RTCStatsCollector> collector(this);
-    network_thread_->PostTask(
-        [collector, sctp_transport_name = pc_->sctp_transport_name(),
-         timestamp_us]() mutable {
-          collector->ProducePartialResultsOnNetworkThread(
-              timestamp_us, std::move(sctp_transport_name));
-        });
-    ProducePartialResultsOnSignalingThread(timestamp_us);
+    return false;
   }
+  // Only start gathering stats if we're not already gathering stats. In the
+  // case of already gathering stats, `callback_` will be invoked when there
+  // are no more pending partial reports.
+  return !num_pending_partial_reports_;
+}
+
+void RTCStatsCollector::BeginGathering_s(int64_t timestamp_us) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
+  num_pending_partial_reports_ = 2;
+  // "Now" using a monotonically increasing timer, for the cache.
+  partial_report_timestamp_us_ = rtc::TimeMicros();
 }
 
 void RTCStatsCollector::ClearCachedStatsReport() {
@@ -1361,6 +1495,18 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
   TRACE_EVENT0("webrtc",
                "RTCStatsCollector::ProducePartialResultsOnNetworkThread");
   RTC_DCHECK_RUN_ON(network_thread_);
+
+  ProduceNetworkReport_n(timestamp_us, std::move(sctp_transport_name));
+
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  signaling_thread_->PostTask(
+      [collector] { collector->MergeNetworkReport_s(); });
+}
+
+void RTCStatsCollector::ProduceNetworkReport_n(
+    int64_t timestamp_us,
+    absl::optional<std::string> sctp_transport_name) {
+  RTC_DCHECK_RUN_ON(network_thread_);
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
   // Touching `network_report_` on this thread is safe by this method because
@@ -1387,11 +1533,8 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
       network_report_.get());
 
   // Signal that it is now safe to touch `network_report_` on the signaling
-  // thread, and post a task to merge it into the final results.
+  // thread.
   network_report_event_.Set();
-  rtc::scoped_refptr<RTCStatsCollector> collector(this);
-  signaling_thread_->PostTask(
-      [collector] { collector->MergeNetworkReport_s(); });
 }
 
 void RTCStatsCollector::ProducePartialResultsOnNetworkThreadImpl(
@@ -1461,9 +1604,14 @@ void RTCStatsCollector::DeliverCachedReport(
   RTC_DCHECK(!requests.empty());
   RTC_DCHECK(cached_report);
 
+  bool delivered_delta = false;
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() == RequestInfo::FilterMode::kDelta) {
+      // All delta requests delivered together get the same delta.
+      request.callback()->OnStatsDelivered(CreateDeltaReport(*cached_report));
+      delivered_delta = true;
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -1482,6 +1630,30 @@ void RTCStatsCollector::DeliverCachedReport(
           receiver_selector));
     }
   }
+  if (delivered_delta) {
+    delta_baseline_report_ = cached_report;
+  }
+}
+
+rtc::scoped_refptr<const RTCStatsReport> RTCStatsCollector::CreateDeltaReport(
+    const RTCStatsReport& report) const {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  if (!delta_baseline_report_) {
+    return report.Copy();
+  }
+  rtc::scoped_refptr<RTCStatsReport> delta =
+      RTCStatsReport::Create(report.timestamp_us());
+  if (delta_baseline_report_.get() == &report) {
+    // A cached report was delivered again, nothing has changed.
+    return delta;
+  }
+  for (const RTCStats& stats : report) {
+    const RTCStats* baseline_stats = delta_baseline_report_->Get(stats.id());
+    if (!baseline_stats || *baseline_stats != stats) {
+      delta->AddStats(stats.copy());
+    }
+  }
+  return delta;
 }
 
 void RTCStatsCollector::ProduceCertificateStats_n(
@@ -2137,149 +2309,188 @@ void RTCStatsCollector::ProduceTransportStats_n(
 std::map<std::string, RTCStatsCollector::CertificateStatsPair>
 RTCStatsCollector::PrepareTransportCertificateStats_n(
     const std::map<std::string, cricket::TransportStats>&
-        transport_stats_by_name) const {
+        transport_stats_by_name) {
   RTC_DCHECK_RUN_ON(network_thread_);
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
   std::map<std::string, CertificateStatsPair> transport_cert_stats;
+  std::map<std::string, CachedCertificateStats> cached_certificate_stats;
   for (const auto& entry : transport_stats_by_name) {
     const std::string& transport_name = entry.first;
 
-    CertificateStatsPair certificate_stats_pair;
-    rtc::scoped_refptr<rtc::RTCCertificate> local_certificate;
-    if (pc_->GetLocalCertificate(transport_name, &local_certificate)) {
-      certificate_stats_pair.local =
-          local_certificate->GetSSLCertificateChain().GetStats();
+    CachedCertificateStats certificate_stats;
+    if (!pc_->GetLocalCertificate(transport_name,
+                                  &certificate_stats.local_certificate)) {
+      certificate_stats.local_certificate = nullptr;
     }
-
     std::unique_ptr<rtc::SSLCertChain> remote_cert_chain =
         pc_->GetRemoteSSLCertChain(transport_name);
     if (remote_cert_chain) {
-      certificate_stats_pair.remote = remote_cert_chain->GetStats();
+      certificate_stats.remote_certificate_ders =
+          GetCertChainDers(*remote_cert_chain);
+    }
+
+    auto it = cached_certificate_stats_.find(transport_name);
+    if (it != cached_certificate_stats_.end() &&
+        it->second.local_certificate == certificate_stats.local_certificate &&
+        it->second.remote_certificate_ders ==
+            certificate_stats.remote_certificate_ders) {
+      certificate_stats.stats = std::move(it->second.stats);
+    } else {
+      if (certificate_stats.local_certificate) {
+        certificate_stats.stats.local =
+            certificate_stats.local_certificate->GetSSLCertificateChain()
+                .GetStats();
+      }
+      if (remote_cert_chain) {
+        certificate_stats.stats.remote = remote_cert_chain->GetStats();
+      }
     }
 
     transport_cert_stats.insert(
-        std::make_pair(transport_name, std::move(certificate_stats_pair)));
+        std::make_pair(transport_name, certificate_stats.stats.Copy()));
+    cached_certificate_stats.insert(
+        std::make_pair(transport_name, std::move(certificate_stats)));
   }
+  // Transports that are gone are dropped from the cache.
+  cached_certificate_stats_.swap(cached_certificate_stats);
   return transport_cert_stats;
 }
 
+RTCStatsCollector::MediaChannelStats::MediaChannelStats() = default;
+
+RTCStatsCollector::MediaChannelStats::~MediaChannelStats() = default;
+
 void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
 
   transceiver_stats_infos_.clear();
   // These are used to invoke GetStats for all the media channels together in
   // one worker thread hop.
-  std::map<cricket::VoiceMediaChannel*,
-           std::unique_ptr<cricket::VoiceMediaInfo>>
-      voice_stats;
-  std::map<cricket::VideoMediaChannel*,
-           std::unique_ptr<cricket::VideoMediaInfo>>
-      video_stats;
+  MediaChannelStats media_channel_stats;
 
   auto transceivers = pc_->GetTransceiversInternal();
 
   // TODO(tommi): See if we can avoid synchronously blocking the signaling
   // thread while we do this (or avoid the Invoke at all).
-  network_thread_->Invoke<void>(RTC_FROM_HERE, [this, &transceivers,
-                                                &voice_stats, &video_stats] {
-    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+  network_thread_->Invoke<void>(
+      RTC_FROM_HERE, [this, &transceivers, &media_channel_stats] {
+        PrepareTransceiverStatsInfos_n(transceivers, &media_channel_stats);
+      });
 
-    for (const auto& transceiver_proxy : transceivers) {
-      RtpTransceiver* transceiver = transceiver_proxy->internal();
-      cricket::MediaType media_type = transceiver->media_type();
-
-      // Prepare stats entry. The TrackMediaInfoMap will be filled in after the
-      // stats have been fetched on the worker thread.
-      transceiver_stats_infos_.emplace_back();
-      RtpTransceiverStatsInfo& stats = transceiver_stats_infos_.back();
-      stats.transceiver = transceiver;
-      stats.media_type = media_type;
+  // We jump to the worker thread and call GetStats() on each media channel as
+  // well as GetCallStats(). At the same time we construct the
+  // TrackMediaInfoMaps, which also needs info from the worker thread. This
+  // minimizes the number of thread jumps.
+  worker_thread_->Invoke<void>(RTC_FROM_HERE, [this, &media_channel_stats] {
+    PrepareTrackMediaInfoMapsAndCallStats_w(&media_channel_stats);
+  });
+}
 
-      cricket::ChannelInterface* channel = transceiver->channel();
-      if (!channel) {
-        // The remaining fields require a BaseChannel.
-        continue;
-      }
+void RTCStatsCollector::PrepareTransceiverStatsInfos_n(
+    const std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+        transceivers,
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
-      stats.mid = channel->mid();
-      stats.transport_name = std::string(channel->transport_name());
+  auto& voice_stats = media_channel_stats->voice_stats;
+  auto& video_stats = media_channel_stats->video_stats;
+  for (const auto& transceiver_proxy : transceivers) {
+    RtpTransceiver* transceiver = transceiver_proxy->internal();
+    cricket::MediaType media_type = transceiver->media_type();
+
+    // Prepare stats entry. The TrackMediaInfoMap will be filled in after the
+    // stats have been fetched on the worker thread.
+    transceiver_stats_infos_.emplace_back();
+    RtpTransceiverStatsInfo& stats = transceiver_stats_infos_.back();
+    stats.transceiver = transceiver;
+    stats.media_type = media_type;
+
+    cricket::ChannelInterface* channel = transceiver->channel();
+    if (!channel) {
+      // The remaining fields require a BaseChannel.
+      continue;
+    }
 
-      if (media_type == cricket::MEDIA_TYPE_AUDIO) {
-        auto* voice_channel = static_cast<cricket::VoiceChannel*>(channel);
-        RTC_DCHECK(voice_stats.find(voice_channel->media_channel()) ==
-                   voice_stats.end());
-        voice_stats[voice_channel->media_channel()] =
-            std::make_unique<cricket::VoiceMediaInfo>();
-      } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
-        auto* video_channel = static_cast<cricket::VideoChannel*>(channel);
-        RTC_DCHECK(video_stats.find(video_channel->media_channel()) ==
-                   video_stats.end());
-        video_stats[video_channel->media_channel()] =
-            std::make_unique<cricket::VideoMediaInfo>();
-      } else {
-        RTC_DCHECK_NOTREACHED();
-      }
+    stats.mid = channel->mid();
+    stats.transport_name = std::string(channel->transport_name());
+
+    if (media_type == cricket::MEDIA_TYPE_AUDIO) {
+      auto* voice_channel = static_cast<cricket::VoiceChannel*>(channel);
+      RTC_DCHECK(voice_stats.find(voice_channel->media_channel()) ==
+                 voice_stats.end());
+      voice_stats[voice_channel->media_channel()] =
+          std::make_unique<cricket::VoiceMediaInfo>();
+    } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
+      auto* video_channel = static_cast<cricket::VideoChannel*>(channel);
+      RTC_DCHECK(video_stats.find(video_channel->media_channel()) ==
+                 video_stats.end());
+      video_stats[video_channel->media_channel()] =
+          std::make_unique<cricket::VideoMediaInfo>();
+    } else {
+      RTC_DCHECK_NOTREACHED();
     }
-  });
+  }
+}
 
-  // We jump to the worker thread and call GetStats() on each media channel as
-  // well as GetCallStats(). At the same time we construct the
-  // TrackMediaInfoMaps, which also needs info from the worker thread. This
-  // minimizes the number of thread jumps.
-  worker_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
-    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+void RTCStatsCollector::PrepareTrackMediaInfoMapsAndCallStats_w(
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
-    for (const auto& entry : voice_stats) {
-      if (!entry.first->GetStats(entry.second.get(),
-                                 /*get_and_clear_legacy_stats=*/false)) {
-        RTC_LOG(LS_WARNING) << "Failed to get voice stats.";
-      }
+  auto& voice_stats = media_channel_stats->voice_stats;
+  auto& video_stats = media_channel_stats->video_stats;
+  for (const auto& entry : voice_stats) {
+    if (!entry.first->GetStats(entry.second.get(),
+                               /*get_and_clear_legacy_stats=*/false)) {
+      RTC_LOG(LS_WARNING) << "Failed to get voice stats.";
     }
-    for (const auto& entry : video_stats) {
-      if (!entry.first->GetStats(entry.second.get())) {
-        RTC_LOG(LS_WARNING) << "Failed to get video stats.";
-      }
+  }
+  for (const auto& entry : video_stats) {
+    if (!entry.first->GetStats(entry.second.get())) {
+      RTC_LOG(LS_WARNING) << "Failed to get video stats.";
     }
+  }
 
-    // Create the TrackMediaInfoMap for each transceiver stats object.
-    for (auto& stats : transceiver_stats_infos_) {
-      auto transceiver = stats.transceiver;
-      std::unique_ptr<cricket::VoiceMediaInfo> voice_media_info;
-      std::unique_ptr<cricket::VideoMediaInfo> video_media_info;
-      if (transceiver->channel()) {
-        cricket::MediaType media_type = transceiver->media_type();
-        if (media_type == cricket::MEDIA_TYPE_AUDIO) {
-          auto* voice_channel =
-              static_cast<cricket::VoiceChannel*>(transceiver->channel());
-          RTC_DCHECK(voice_stats[voice_channel->media_channel()]);
-          voice_media_info =
-              std::move(voice_stats[voice_channel->media_channel()]);
-        } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
-          auto* video_channel =
-              static_cast<cricket::VideoChannel*>(transceiver->channel());
-          RTC_DCHECK(video_stats[video_channel->media_channel()]);
-          video_media_info =
-              std::move(video_stats[video_channel->media_channel()]);
-        }
-      }
-      std::vector<rtc::scoped_refptr<RtpSenderInternal>> senders;
-      for (const auto& sender : transceiver->senders()) {
-        senders.push_back(
-            rtc::scoped_refptr<RtpSenderInternal>(sender->internal()));
-      }
-      std::vector<rtc::scoped_refptr<RtpReceiverInternal>> receivers;
-      for (const auto& receiver : transceiver->receivers()) {
-        receivers.push_back(
-            rtc::scoped_refptr<RtpReceiverInternal>(receiver->internal()));
+  // Create the TrackMediaInfoMap for each transceiver stats object.
+  for (auto& stats : transceiver_stats_infos_) {
+    auto transceiver = stats.transceiver;
+    std::unique_ptr<cricket::VoiceMediaInfo> voice_media_info;
+    std::unique_ptr<cricket::VideoMediaInfo> video_media_info;
+    if (transceiver->channel()) {
+      cricket::MediaType media_type = transceiver->media_type();
+      if (media_type == cricket::MEDIA_TYPE_AUDIO) {
+        auto* voice_channel =
+            static_cast<cricket::VoiceChannel*>(transceiver->channel());
+        RTC_DCHECK(voice_stats[voice_channel->media_channel()]);
+        voice_media_info =
+            std::move(voice_stats[voice_channel->media_channel()]);
+      } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
+        auto* video_channel =
+            static_cast<cricket::VideoChannel*>(transceiver->channel());
+        RTC_DCHECK(video_stats[video_channel->media_channel()]);
+        video_media_info =
+            std::move(video_stats[video_channel->media_channel()]);
       }
-      stats.track_media_info_map = std::make_unique<TrackMediaInfoMap>(
-          std::move(voice_media_info), std::move(video_media_info), senders,
-          receivers);
     }
+    std::vector<rtc::scoped_refptr<RtpSenderInternal>> senders;
+    for (const auto& sender : transceiver->senders()) {
+      senders.push_back(
+          rtc::scoped_refptr<RtpSenderInternal>(sender->internal()));
+    }
+    std::vector<rtc::scoped_refptr<RtpReceiverInternal>> receivers;
+    for (const auto& receiver : transceiver->receivers()) {
+      receivers.push_back(
+          rtc::scoped_refptr<RtpReceiverInternal>(receiver->internal()));
+    }
+    stats.track_media_info_map = std::make_unique<TrackMediaInfoMap>(
+        std::move(voice_media_info), std::move(video_media_info), senders,
+        receivers);
+  }
 
-    call_stats_ = pc_->GetCallStats();
-  });
+  call_stats_ = pc_->GetCallStats();
 }
 
 void RTCStatsCollector::OnSctpDataChannelCreated(SctpDataChannel* channel) {
@@ -37,9 +37,11 @@
 #include "pc/sctp_data_channel.h"
 #include "pc/track_media_info_map.h"
 #include "pc/transport_stats.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -78,6 +80,22 @@ class RTCStatsCollector : public rtc::RefCountInterface,
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Like `GetStatsReport` without a selector, but the delivered report only
+  // contains the stats objects that are new or have any member that differs
+  // from the report delivered by the previous `GetStatsReportDelta` call. The
+  // first call delivers a full report. Removed stats objects are not signaled,
+  // a stats object that reappears is delivered as new.
+  void GetStatsReportDelta(
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Like `GetStatsReport` without a selector for each of `collectors`, with
+  // `callbacks[i]` receiving the report of `collectors[i]`. The stats of all
+  // collectors that need fresh stats are gathered together, with a single hop
+  // to each of the worker and network threads. All collectors must use the
+  // same threads, which is the case for PeerConnections created by the same
+  // factory. Must be called on the signaling thread.
+  static void GetStatsReports(
+      const std::vector<rtc::scoped_refptr<RTCStatsCollector>>& collectors,
+      std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling `GetStatsReport` guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -93,6 +111,8 @@ class RTCStatsCollector : public rtc::RefCountInterface,
   struct CertificateStatsPair {
     std::unique_ptr<rtc::SSLCertificateStats> local;
     std::unique_ptr<rtc::SSLCertificateStats> remote;
+
+    CertificateStatsPair Copy() const;
   };
 
   // Stats gathering on a particular thread. Virtual for the sake of testing.
@@ -109,11 +129,19 @@ class RTCStatsCollector : public rtc::RefCountInterface,
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kDelta
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
         rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kDelta.
+    static RequestInfo CreateDelta(
+        rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
     // Constructs with FilterMode::kSenderSelector. The selection algorithm is
     // applied even if `selector` is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpSenderInternal> selector,
@@ -149,6 +177,13 @@ class RTCStatsCollector : public rtc::RefCountInterface,
   };
 
   void GetStatsReportInternal(RequestInfo request);
+  // Queues `request`, delivering a fresh cached report if there is one.
+  // Returns true if stats need to be gathered for the request, in which case
+  // the caller must call BeginGathering_s() and continue from there.
+  bool QueueRequest(RequestInfo request);
+  // Begins gathering stats on the signaling thread, with a timestamp of
+  // `timestamp_us` for the resulting report.
+  void BeginGathering_s(int64_t timestamp_us);
 
   // Structure for tracking stats about each RtpTransceiver managed by the
   // PeerConnection. This can either by a Plan B style or Unified Plan style
@@ -168,6 +203,10 @@ class RTCStatsCollector : public rtc::RefCountInterface,
   void DeliverCachedReport(
       rtc::scoped_refptr<const RTCStatsReport> cached_report,
       std::vector<RequestInfo> requests);
+  // Creates a report with the stats objects of `report` that are not in
+  // `delta_baseline_report_` or differ from it.
+  rtc::scoped_refptr<const RTCStatsReport> CreateDeltaReport(
+      const RTCStatsReport& report) const;
 
   // Produces `RTCCertificateStats`.
   void ProduceCertificateStats_n(
@@ -223,19 +262,46 @@ class RTCStatsCollector : public rtc::RefCountInterface,
       const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
       RTCStatsReport* report) const;
 
-  // Helper function to stats-producing functions.
+  // Media channels that GetStats() is invoked for on the worker thread.
+  struct MediaChannelStats {
+    MediaChannelStats();
+    ~MediaChannelStats();
+
+    std::map<cricket::VoiceMediaChannel*,
+             std::unique_ptr<cricket::VoiceMediaInfo>>
+        voice_stats;
+    std::map<cricket::VideoMediaChannel*,
+             std::unique_ptr<cricket::VideoMediaInfo>>
+        video_stats;
+  };
+
+  // Helper function to stats-producing functions. Certificate stats are cached
+  // per transport and are only recomputed when a certificate changes, since
+  // computing fingerprints and base64 encodings is expensive.
   std::map<std::string, CertificateStatsPair>
   PrepareTransportCertificateStats_n(
       const std::map<std::string, cricket::TransportStats>&
-          transport_stats_by_name) const;
+          transport_stats_by_name);
   // The results are stored in `transceiver_stats_infos_` and `call_stats_`.
   void PrepareTransceiverStatsInfosAndCallStats_s_w_n();
+  // The steps of PrepareTransceiverStatsInfosAndCallStats_s_w_n() that run on
+  // the network and worker threads, respectively.
+  void PrepareTransceiverStatsInfos_n(
+      const std::vector<rtc::scoped_refptr<
+          RtpTransceiverProxyWithInternal<RtpTransceiver>>>& transceivers,
+      MediaChannelStats* media_channel_stats);
+  void PrepareTrackMediaInfoMapsAndCallStats_w(
+      MediaChannelStats* media_channel_stats);
 
   // Stats gathering on a particular thread.
   void ProducePartialResultsOnSignalingThread(int64_t timestamp_us);
   void ProducePartialResultsOnNetworkThread(
       int64_t timestamp_us,
       absl::optional<std::string> sctp_transport_name);
+  // Produces `network_report_` and signals `network_report_event_`. The caller
+  // is responsible for posting MergeNetworkReport_s() to the signaling thread.
+  void ProduceNetworkReport_n(int64_t timestamp_us,
+                              absl::optional<std::string> sctp_transport_name);
   // Merges `network_report_` into `partial_report_` and completes the request.
   // This is a NO-OP if `network_report_` is null.
   void MergeNetworkReport_s();
@@ -289,6 +355,18 @@ class RTCStatsCollector : public rtc::RefCountInterface,
   int64_t cache_timestamp_us_;
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
+  // The report that the previous `GetStatsReportDelta` call was a delta of.
+  rtc::scoped_refptr<const RTCStatsReport> delta_baseline_report_;
+
+  // The certificates that `stats` were computed from, by transport name. The
+  // remote certificate chain is compared by its DER encoding since a new copy
+  // of it is made every time it is queried. Only touched on the network thread.
+  struct CachedCertificateStats {
+    rtc::scoped_refptr<rtc::RTCCertificate> local_certificate;
+    std::vector<rtc::Buffer> remote_certificate_ders;
+    CertificateStatsPair stats;
+  };
+  std::map<std::string, CachedCertificateStats> cached_certificate_stats_;
 
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures polling stats of a PeerConnection with full reports versus delta
+// reports, including serializing the delivered report to JSON the way a
+// server uploading its stats would. Only one of the RTP streams changes
+// between two polls, which is typical for a call with many mostly idle
+// participants.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/stats/rtc_stats_collector_callback.h"
+#include "api/stats/rtc_stats_report.h"
+#include "benchmark/benchmark.h"
+#include "media/base/media_channel.h"
+#include "pc/rtc_stats_collector.h"
+#include "pc/test/fake_peer_connection_for_stats.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+namespace {
+
+class ReportConsumer : public RTCStatsCollectorCallback {
+ public:
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const RTCStatsReport>& report) override {
+    std::string json = report->ToJson();
+    benchmark::DoNotOptimize(json);
+    num_stats_ += report->size();
+    delivered_ = true;
+  }
+
+  bool TakeDelivered() {
+    bool delivered = delivered_;
+    delivered_ = false;
+    return delivered;
+  }
+  int64_t num_stats() const { return num_stats_; }
+
+ private:
+  bool delivered_ = false;
+  int64_t num_stats_ = 0;
+};
+
+cricket::VoiceMediaInfo CreateVoiceMediaInfo(uint32_t ssrc, int packets) {
+  cricket::VoiceMediaInfo info;
+  info.senders.push_back(cricket::VoiceSenderInfo());
+  info.senders[0].local_stats.push_back(cricket::SsrcSenderInfo());
+  info.senders[0].local_stats[0].ssrc = ssrc;
+  info.senders[0].packets_sent = packets;
+  info.receivers.push_back(cricket::VoiceReceiverInfo());
+  info.receivers[0].local_stats.push_back(cricket::SsrcReceiverInfo());
+  info.receivers[0].local_stats[0].ssrc = ssrc + 1;
+  info.receivers[0].packets_rcvd = packets;
+  return info;
+}
+
+// Polls the stats of a PeerConnection with `state.range(0)` audio transceivers,
+// each on its own DTLS transport, with full reports if `state.range(1)` is 0
+// and with delta reports otherwise.
+void BM_PollStats(benchmark::State& state) {
+  const int num_transceivers = state.range(0);
+  const bool delta = state.range(1) != 0;
+  rtc::AutoThread main_thread;
+  auto pc = rtc::make_ref_counted<FakePeerConnectionForStats>();
+  std::vector<FakeVoiceMediaChannelForStats*> channels;
+  for (int i = 0; i < num_transceivers; ++i) {
+    std::string transport_name = "transport" + std::to_string(i);
+    channels.push_back(pc->AddVoiceChannel(
+        "mid" + std::to_string(i), transport_name,
+        CreateVoiceMediaInfo(/*ssrc=*/2 * i + 1, /*packets=*/0)));
+    pc->SetLocalCertificate(
+        transport_name, rtc::RTCCertificate::Create(
+                            rtc::SSLIdentity::Create("local", rtc::KT_ECDSA)));
+    std::unique_ptr<rtc::SSLIdentity> remote_identity =
+        rtc::SSLIdentity::Create("remote", rtc::KT_ECDSA);
+    pc->SetRemoteCertChain(transport_name,
+                           remote_identity->cert_chain().Clone());
+  }
+  rtc::scoped_refptr<RTCStatsCollector> collector =
+      RTCStatsCollector::Create(pc, /*cache_lifetime_us=*/0);
+  auto consumer = rtc::make_ref_counted<ReportConsumer>();
+
+  int packets = 0;
+  for (auto s : state) {
+    // Traffic on one of the streams since the last poll.
+    ++packets;
+    channels[packets % num_transceivers]->SetStats(CreateVoiceMediaInfo(
+        /*ssrc=*/2 * (packets % num_transceivers) + 1, packets));
+
+    collector->ClearCachedStatsReport();
+    if (delta) {
+      collector->GetStatsReportDelta(consumer);
+    } else {
+      collector->GetStatsReport(consumer);
+    }
+    while (!consumer->TakeDelivered()) {
+      main_thread.ProcessMessages(0);
+    }
+  }
+  state.counters["stats"] = benchmark::Counter(
+      consumer->num_stats(), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_PollStats)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({16, 0})
+    ->Args({16, 1});
+
+}  // namespace
+}  // namespace webrtc
@@ -459,6 +459,13 @@ class RTCStatsCollectorWrapper {
     return GetStatsReport();
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReportDelta() {
+    stats_collector_->ClearCachedStatsReport();
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReportDelta(callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<MockRtpSenderInternal> SetupLocalTrackAndSender(
       cricket::MediaType media_type,
       const std::string& track_id,
@@ -952,6 +959,155 @@ TEST_F(RTCStatsCollectorTest, CachedStatsReports) {
   EXPECT_NE(c.get(), d.get());
 }
 
+TEST_F(RTCStatsCollectorTest, StatsReportDeltaOnlyContainsChangedStats) {
+  cricket::VoiceMediaInfo voice_media_info;
+  voice_media_info.receivers.push_back(cricket::VoiceReceiverInfo());
+  voice_media_info.receivers[0].local_stats.push_back(
+      cricket::SsrcReceiverInfo());
+  voice_media_info.receivers[0].local_stats[0].ssrc = 1;
+  voice_media_info.receivers[0].packets_rcvd = 2;
+  auto* voice_media_channel =
+      pc_->AddVoiceChannel("AudioMid", "TransportName", voice_media_info);
+  stats_->SetupRemoteTrackAndReceiver(
+      cricket::MEDIA_TYPE_AUDIO, "RemoteAudioTrackID", "RemoteStreamId", 1);
+
+  // The first delta is a full report.
+  rtc::scoped_refptr<const RTCStatsReport> full_report =
+      stats_->GetFreshStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> delta =
+      stats_->GetFreshStatsReportDelta();
+  EXPECT_EQ(delta->size(), full_report->size());
+  ASSERT_TRUE(delta->Get("RTCInboundRTPAudioStream_1"));
+
+  // Nothing has changed.
+  delta = stats_->GetFreshStatsReportDelta();
+  EXPECT_EQ(delta->size(), 0u);
+
+  voice_media_info.receivers[0].packets_rcvd = 3;
+  voice_media_channel->SetStats(voice_media_info);
+  delta = stats_->GetFreshStatsReportDelta();
+  ASSERT_EQ(delta->size(), 1u);
+  ASSERT_TRUE(delta->Get("RTCInboundRTPAudioStream_1"));
+  EXPECT_EQ(*delta->Get("RTCInboundRTPAudioStream_1")
+                 ->cast_to<RTCInboundRTPStreamStats>()
+                 .packets_received,
+            3u);
+
+  // Full reports do not move the baseline of the deltas.
+  voice_media_info.receivers[0].packets_rcvd = 4;
+  voice_media_channel->SetStats(voice_media_info);
+  stats_->GetFreshStatsReport();
+  delta = stats_->GetFreshStatsReportDelta();
+  EXPECT_EQ(delta->size(), 1u);
+}
+
+TEST_F(RTCStatsCollectorTest, CachedStatsReportDeltaIsEmpty) {
+  pc_->AddVoiceChannel("audio", "transport");
+  rtc::scoped_refptr<RTCStatsObtainer> first = RTCStatsObtainer::Create();
+  stats_->stats_collector()->GetStatsReportDelta(first);
+  EXPECT_TRUE_WAIT(first->report(), kGetStatsReportTimeoutMs);
+  EXPECT_GT(first->report()->size(), 0u);
+
+  // The cached report is delivered again, which is no change.
+  rtc::scoped_refptr<RTCStatsObtainer> second = RTCStatsObtainer::Create();
+  stats_->stats_collector()->GetStatsReportDelta(second);
+  EXPECT_TRUE_WAIT(second->report(), kGetStatsReportTimeoutMs);
+  EXPECT_EQ(second->report()->size(), 0u);
+}
+
+TEST_F(RTCStatsCollectorTest, StatsReportDeltaContainsChangedCertificate) {
+  const char kTransportName[] = "transport";
+  pc_->AddVoiceChannel("audio", kTransportName);
+  std::unique_ptr<CertificateInfo> local_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(local) certificate"});
+  pc_->SetLocalCertificate(kTransportName, local_certinfo->certificate);
+  std::unique_ptr<CertificateInfo> remote_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(remote) certificate"});
+  pc_->SetRemoteCertChain(
+      kTransportName,
+      remote_certinfo->certificate->GetSSLCertificateChain().Clone());
+
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetFreshStatsReportDelta();
+  ExpectReportContainsCertificateInfo(report, *local_certinfo);
+  ExpectReportContainsCertificateInfo(report, *remote_certinfo);
+  EXPECT_EQ(stats_->GetFreshStatsReportDelta()->size(), 0u);
+
+  // A new remote certificate is picked up even though the certificate stats
+  // of the transport are cached.
+  std::unique_ptr<CertificateInfo> new_remote_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(remote) new certificate"});
+  pc_->SetRemoteCertChain(
+      kTransportName,
+      new_remote_certinfo->certificate->GetSSLCertificateChain().Clone());
+  report = stats_->GetFreshStatsReportDelta();
+  ExpectReportContainsCertificateInfo(report, *new_remote_certinfo);
+  EXPECT_FALSE(report->Get(
+      "RTCCertificate_" + local_certinfo->fingerprints[0]));
+}
+
+TEST_F(RTCStatsCollectorTest, GetStatsReportsDeliversReportPerCollector) {
+  cricket::VoiceMediaInfo voice_media_info;
+  voice_media_info.receivers.push_back(cricket::VoiceReceiverInfo());
+  voice_media_info.receivers[0].local_stats.push_back(
+      cricket::SsrcReceiverInfo());
+  voice_media_info.receivers[0].local_stats[0].ssrc = 1;
+  voice_media_info.receivers[0].packets_rcvd = 2;
+  pc_->AddVoiceChannel("AudioMid", "TransportName", voice_media_info);
+
+  auto other_pc = rtc::make_ref_counted<FakePeerConnectionForStats>();
+  voice_media_info.receivers[0].local_stats[0].ssrc = 3;
+  voice_media_info.receivers[0].packets_rcvd = 4;
+  other_pc->AddVoiceChannel("AudioMid", "TransportName", voice_media_info);
+  RTCStatsCollectorWrapper other_stats(other_pc);
+
+  rtc::scoped_refptr<const RTCStatsReport> report, other_report;
+  RTCStatsCollector::GetStatsReports(
+      {stats_->stats_collector(), other_stats.stats_collector()},
+      {RTCStatsObtainer::Create(&report),
+       RTCStatsObtainer::Create(&other_report)});
+  EXPECT_TRUE_WAIT(report, kGetStatsReportTimeoutMs);
+  EXPECT_TRUE_WAIT(other_report, kGetStatsReportTimeoutMs);
+
+  ASSERT_TRUE(report->Get("RTCInboundRTPAudioStream_1"));
+  EXPECT_FALSE(report->Get("RTCInboundRTPAudioStream_3"));
+  EXPECT_EQ(*report->Get("RTCInboundRTPAudioStream_1")
+                 ->cast_to<RTCInboundRTPStreamStats>()
+                 .packets_received,
+            2u);
+  ASSERT_TRUE(other_report->Get("RTCInboundRTPAudioStream_3"));
+  EXPECT_FALSE(other_report->Get("RTCInboundRTPAudioStream_1"));
+  EXPECT_EQ(*other_report->Get("RTCInboundRTPAudioStream_3")
+                 ->cast_to<RTCInboundRTPStreamStats>()
+                 .packets_received,
+            4u);
+
+  // The reports are cached like those of GetStatsReport().
+  EXPECT_EQ(stats_->GetStatsReport().get(), report.get());
+  EXPECT_EQ(other_stats.GetStatsReport().get(), other_report.get());
+}
+
+TEST_F(RTCStatsCollectorTest, GetStatsReportsWithCachedAndPendingReports) {
+  auto other_pc = rtc::make_ref_counted<FakePeerConnectionForStats>();
+  RTCStatsCollectorWrapper other_stats(other_pc);
+  rtc::scoped_refptr<const RTCStatsReport> cached_report =
+      stats_->GetStatsReport();
+
+  // `other_stats` is already gathering stats, the batch joins that request.
+  rtc::scoped_refptr<const RTCStatsReport> pending_report;
+  other_stats.stats_collector()->GetStatsReport(
+      RTCStatsObtainer::Create(&pending_report));
+  rtc::scoped_refptr<const RTCStatsReport> report, other_report;
+  RTCStatsCollector::GetStatsReports(
+      {stats_->stats_collector(), other_stats.stats_collector()},
+      {RTCStatsObtainer::Create(&report),
+       RTCStatsObtainer::Create(&other_report)});
+  EXPECT_TRUE_WAIT(report, kGetStatsReportTimeoutMs);
+  EXPECT_TRUE_WAIT(other_report, kGetStatsReportTimeoutMs);
+  EXPECT_EQ(report.get(), cached_report.get());
+  EXPECT_EQ(other_report.get(), pending_report.get());
+}
+
 TEST_F(RTCStatsCollectorTest, MultipleCallbacksWithInvalidatedCacheInBetween) {
   rtc::scoped_refptr<const RTCStatsReport> a, b, c;
   stats_->stats_collector()->GetStatsReport(RTCStatsObtainer::Create(&a));
@@ -2192,6 +2348,7 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Video) {
   // `expected_video.last_packet_received_timestamp` should be undefined.
   // `expected_video.content_type` should be undefined.
   // `expected_video.decoder_implementation` should be undefined.
+  // `expected_video.timing_frame_stage_delays` should be undefined.
 
   ASSERT_TRUE(report->Get(expected_video.id()));
   EXPECT_EQ(
@@ -2209,6 +2366,10 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Video) {
   expected_video.estimated_playout_timestamp = 1234;
   video_media_info.receivers[0].decoder_implementation_name = "libfoodecoder";
   expected_video.decoder_implementation = "libfoodecoder";
+  video_media_info.receivers[0].timing_frame_stage_delays_ms = {
+      {"decode.p50", 5.0}, {"decode.p95", 20.0}};
+  expected_video.timing_frame_stage_delays = std::map<std::string, double>{
+      {"decode.p50", 0.005}, {"decode.p95", 0.02}};
   video_media_channel->SetStats(video_media_info);
 
   report = stats_->GetFreshStatsReport();
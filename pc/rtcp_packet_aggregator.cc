@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/rtcp_packet_aggregator.h"
+
+#include <utility>
+
+#include "api/task_queue/task_queue_base.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+namespace {
+
+// Returns true if `packet` is a valid compound RTCP packet made of reports
+// only, i.e. nothing the remote side should get without delay.
+bool HasOnlyReports(const rtc::CopyOnWriteBuffer& packet) {
+  const uint8_t* const end = packet.cdata() + packet.size();
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = packet.cdata(); next != end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, end - next))
+      return false;
+    switch (header.type()) {
+      case rtcp::SenderReport::kPacketType:
+      case rtcp::ReceiverReport::kPacketType:
+      case rtcp::Sdes::kPacketType:
+      case rtcp::ExtendedReports::kPacketType:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+RtcpPacketAggregator::RtcpPacketAggregator(size_t max_packet_size,
+                                           TimeDelta max_delay,
+                                           SendFunction send)
+    : max_packet_size_(max_packet_size),
+      max_delay_(max_delay),
+      send_(std::move(send)) {
+  RTC_DCHECK(send_);
+  sequence_checker_.Detach();
+}
+
+RtcpPacketAggregator::~RtcpPacketAggregator() = default;
+
+bool RtcpPacketAggregator::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                                          const rtc::PacketOptions& options,
+                                          int flags) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (pending_.size() != 0 &&
+      (pending_.size() + packet->size() > max_packet_size_ ||
+       options.dscp != pending_options_.dscp || flags != pending_flags_)) {
+    Flush();
+  }
+
+  bool send_now = !HasOnlyReports(*packet);
+  if (pending_.size() == 0) {
+    if (send_now || packet->size() >= max_packet_size_)
+      return send_(packet, options, flags);
+    pending_ = std::move(*packet);
+    pending_options_ = options;
+    pending_flags_ = flags;
+    RTC_DCHECK(TaskQueueBase::Current());
+    TaskQueueBase::Current()->PostDelayedTask(
+        ToQueuedTask(safety_,
+                     [this, num_flushes = num_flushes_] {
+                       RTC_DCHECK_RUN_ON(&sequence_checker_);
+                       if (num_flushes == num_flushes_)
+                         Flush();
+                     }),
+        max_delay_.ms());
+    return true;
+  }
+
+  pending_.AppendData(*packet);
+  return send_now ? Flush() : true;
+}
+
+bool RtcpPacketAggregator::Flush() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (pending_.size() == 0)
+    return true;
+  ++num_flushes_;
+  rtc::CopyOnWriteBuffer packet = std::move(pending_);
+  return send_(&packet, pending_options_, pending_flags_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_RTCP_PACKET_AGGREGATOR_H_
+#define PC_RTCP_PACKET_AGGREGATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "api/sequence_checker.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Merges the compound RTCP packets that the streams of a BUNDLE transport
+// send on their own timers into as few packets as `max_packet_size` allows,
+// so that each of them doesn't go through SRTCP and the socket on its own.
+//
+// Packets holding only reports (SR, RR, SDES and XR) are held back for at
+// most `max_delay`, which may inflate the RTT measured from them by as
+// much. Any other packet, e.g. feedback, is sent right away together with
+// the reports held back so far.
+//
+// Must be used on a single task queue.
+class RtcpPacketAggregator {
+ public:
+  using SendFunction =
+      std::function<bool(rtc::CopyOnWriteBuffer* packet,
+                         const rtc::PacketOptions& options,
+                         int flags)>;
+
+  RtcpPacketAggregator(size_t max_packet_size,
+                       TimeDelta max_delay,
+                       SendFunction send);
+  RtcpPacketAggregator(const RtcpPacketAggregator&) = delete;
+  RtcpPacketAggregator& operator=(const RtcpPacketAggregator&) = delete;
+  // Drops the reports held back.
+  ~RtcpPacketAggregator();
+
+  // Returns the result of `send` if `packet` was sent right away, and true
+  // if it was held back.
+  bool SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                      const rtc::PacketOptions& options,
+                      int flags);
+
+  // Sends the reports held back, if any.
+  bool Flush();
+
+ private:
+  const size_t max_packet_size_;
+  const TimeDelta max_delay_;
+  const SendFunction send_;
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  rtc::CopyOnWriteBuffer pending_ RTC_GUARDED_BY(sequence_checker_);
+  rtc::PacketOptions pending_options_ RTC_GUARDED_BY(sequence_checker_);
+  int pending_flags_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  // Incremented on every flush, so that a scheduled flush doesn't cut short
+  // the hold time of reports that came after the ones it was scheduled for.
+  uint64_t num_flushes_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_RTCP_PACKET_AGGREGATOR_H_
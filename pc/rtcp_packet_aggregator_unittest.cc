@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/rtcp_packet_aggregator.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kMaxDelay = TimeDelta::Millis(20);
+constexpr size_t kMaxPacketSize = 1200;
+
+rtc::CopyOnWriteBuffer ReceiverReport(uint32_t sender_ssrc) {
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(sender_ssrc);
+  rtc::Buffer packet = rr.Build();
+  return rtc::CopyOnWriteBuffer(packet.data(), packet.size());
+}
+
+rtc::CopyOnWriteBuffer Pli(uint32_t sender_ssrc) {
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(sender_ssrc);
+  pli.SetMediaSsrc(sender_ssrc + 1);
+  rtc::Buffer packet = pli.Build();
+  return rtc::CopyOnWriteBuffer(packet.data(), packet.size());
+}
+
+class RtcpPacketAggregatorTest : public ::testing::Test {
+ protected:
+  explicit RtcpPacketAggregatorTest(size_t max_packet_size = kMaxPacketSize)
+      : time_controller_(Timestamp::Seconds(1000)),
+        aggregator_(max_packet_size,
+                    kMaxDelay,
+                    [this](rtc::CopyOnWriteBuffer* packet,
+                           const rtc::PacketOptions& options,
+                           int flags) {
+                      sent_.push_back(*packet);
+                      return true;
+                    }) {}
+
+  bool Send(rtc::CopyOnWriteBuffer packet) {
+    return aggregator_.SendRtcpPacket(&packet, rtc::PacketOptions(),
+                                      /*flags=*/0);
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  std::vector<rtc::CopyOnWriteBuffer> sent_;
+  RtcpPacketAggregator aggregator_;
+};
+
+TEST_F(RtcpPacketAggregatorTest, MergesReportsForUpToMaxDelay) {
+  EXPECT_TRUE(Send(ReceiverReport(1)));
+  EXPECT_TRUE(Send(ReceiverReport(2)));
+  time_controller_.AdvanceTime(kMaxDelay - TimeDelta::Millis(1));
+  EXPECT_TRUE(sent_.empty());
+
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  ASSERT_EQ(sent_.size(), 1u);
+  test::RtcpPacketParser parser;
+  ASSERT_TRUE(parser.Parse(sent_[0].cdata(), sent_[0].size()));
+  EXPECT_EQ(parser.receiver_report()->num_packets(), 2);
+}
+
+TEST_F(RtcpPacketAggregatorTest, SendsFeedbackWithoutDelay) {
+  EXPECT_TRUE(Send(Pli(1)));
+  EXPECT_EQ(sent_.size(), 1u);
+
+  // Reports held back go out together with the feedback.
+  EXPECT_TRUE(Send(ReceiverReport(1)));
+  EXPECT_TRUE(Send(Pli(2)));
+  ASSERT_EQ(sent_.size(), 2u);
+  test::RtcpPacketParser parser;
+  ASSERT_TRUE(parser.Parse(sent_[1].cdata(), sent_[1].size()));
+  EXPECT_EQ(parser.receiver_report()->num_packets(), 1);
+  EXPECT_EQ(parser.pli()->num_packets(), 1);
+
+  time_controller_.AdvanceTime(kMaxDelay);
+  EXPECT_EQ(sent_.size(), 2u);
+}
+
+class SmallRtcpPacketAggregatorTest : public RtcpPacketAggregatorTest {
+ protected:
+  SmallRtcpPacketAggregatorTest()
+      : RtcpPacketAggregatorTest(2 * ReceiverReport(1).size()) {}
+};
+
+TEST_F(SmallRtcpPacketAggregatorTest, SendsWhenNextReportDoesNotFit) {
+  EXPECT_TRUE(Send(ReceiverReport(1)));
+  EXPECT_TRUE(Send(ReceiverReport(2)));
+  EXPECT_TRUE(sent_.empty());
+  EXPECT_TRUE(Send(ReceiverReport(3)));
+  ASSERT_EQ(sent_.size(), 1u);
+  EXPECT_EQ(sent_[0].size(), 2 * ReceiverReport(1).size());
+
+  time_controller_.AdvanceTime(kMaxDelay);
+  ASSERT_EQ(sent_.size(), 2u);
+  EXPECT_EQ(sent_[1].size(), ReceiverReport(1).size());
+}
+
+TEST_F(RtcpPacketAggregatorTest, FlushSendsHeldBackReports) {
+  EXPECT_TRUE(Send(ReceiverReport(1)));
+  EXPECT_TRUE(aggregator_.Flush());
+  EXPECT_EQ(sent_.size(), 1u);
+
+  // The flush scheduled for the first report doesn't cut short the delay of
+  // the next one.
+  time_controller_.AdvanceTime(kMaxDelay / 2);
+  EXPECT_TRUE(Send(ReceiverReport(2)));
+  time_controller_.AdvanceTime(kMaxDelay / 2);
+  EXPECT_EQ(sent_.size(), 1u);
+  time_controller_.AdvanceTime(kMaxDelay / 2);
+  EXPECT_EQ(sent_.size(), 2u);
+}
+
+}  // namespace
+}  // namespace webrtc
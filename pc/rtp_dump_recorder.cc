@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/rtp_dump_recorder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/file_rotating_stream.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+namespace {
+
+// See http://www.cs.columbia.edu/irt/software/rtptools/ for the format.
+constexpr char kFirstLine[] = "#!rtpplay1.0 0.0.0.0/0\n";
+// The first line is followed by the start time, source address and port,
+// which are left zero.
+constexpr size_t kFileHeaderSize = sizeof(kFirstLine) - 1 + 16;
+// Length of the record, length of the packet and time offset.
+constexpr size_t kRecordHeaderSize = 8;
+constexpr size_t kFixedRtpHeaderSize = 12;
+
+// Returns the size of the RTP header, including CSRCs and header extensions,
+// or of the whole packet if it's too short for the header it describes.
+size_t RtpHeaderSize(rtc::ArrayView<const uint8_t> packet) {
+  if (packet.size() < kFixedRtpHeaderSize)
+    return packet.size();
+  size_t size = kFixedRtpHeaderSize + 4 * (packet[0] & 0x0f);
+  if ((packet[0] & 0x10) != 0 && packet.size() >= size + 4) {
+    size += 4 + 4 * ByteReader<uint16_t>::ReadBigEndian(&packet[size + 2]);
+  }
+  return std::min(size, packet.size());
+}
+
+}  // namespace
+
+// A set of rotating files with the records of one direction. Records are
+// never split across files, and each file starts with the file header.
+class RtpDumpRecorder::DumpFile : public rtc::FileRotatingStream {
+ public:
+  DumpFile(const Config& config, const std::string& file_prefix)
+      : rtc::FileRotatingStream(config.directory,
+                                file_prefix,
+                                MaxFileSize(config),
+                                config.num_files),
+        max_file_size_(MaxFileSize(config)),
+        max_bytes_per_second_(config.max_bytes_per_second),
+        buffer_(kRecordHeaderSize + config.snap_length) {}
+
+  // Returns false if the record was dropped to stay within the rate cap.
+  bool WriteRecord(const Record& record) {
+    size_t record_size = kRecordHeaderSize + record.size;
+    if (record.time_ms - window_start_ms_ >= 1000) {
+      window_start_ms_ = record.time_ms;
+      window_bytes_ = 0;
+    }
+    if (window_bytes_ + record_size > max_bytes_per_second_)
+      return false;
+    window_bytes_ += record_size;
+
+    if (needs_file_header_) {
+      uint8_t header[kFileHeaderSize] = {0};
+      memcpy(header, kFirstLine, sizeof(kFirstLine) - 1);
+      needs_file_header_ = false;
+      bytes_in_file_ = kFileHeaderSize;
+      Write(header, kFileHeaderSize);
+    }
+    if (bytes_in_file_ + record_size >= max_file_size_) {
+      // End the file with this record rather than splitting it across two.
+      SetMaxFileSize(bytes_in_file_ + record_size);
+    }
+
+    ByteWriter<uint16_t>::WriteBigEndian(&buffer_[0], record_size);
+    // An original length of zero marks RTCP packets.
+    ByteWriter<uint16_t>::WriteBigEndian(
+        &buffer_[2], record.rtcp ? 0 : record.original_length);
+    ByteWriter<uint32_t>::WriteBigEndian(&buffer_[4], record.time_ms);
+    memcpy(&buffer_[kRecordHeaderSize], record.data.data(), record.size);
+    bytes_in_file_ += record_size;
+    Write(buffer_.data(), record_size);
+    return true;
+  }
+
+ protected:
+  void OnRotation() override {
+    SetMaxFileSize(max_file_size_);
+    needs_file_header_ = true;
+    bytes_in_file_ = 0;
+  }
+
+ private:
+  // Leaves room for the file header and at least one record.
+  static size_t MaxFileSize(const Config& config) {
+    return std::max(config.max_file_size,
+                    kFileHeaderSize + kRecordHeaderSize + config.snap_length);
+  }
+
+  const size_t max_file_size_;
+  const size_t max_bytes_per_second_;
+  std::vector<uint8_t> buffer_;
+  bool needs_file_header_ = true;
+  size_t bytes_in_file_ = 0;
+  uint32_t window_start_ms_ = 0;
+  size_t window_bytes_ = 0;
+};
+
+// static
+std::unique_ptr<RtpDumpRecorder> RtpDumpRecorder::Create(
+    const Config& config,
+    TaskQueueFactory* task_queue_factory) {
+  RTC_DCHECK_GE(config.snap_length, kFixedRtpHeaderSize);
+  RTC_DCHECK_LE(config.snap_length,
+                std::numeric_limits<uint16_t>::max() - kRecordHeaderSize);
+  RTC_DCHECK_GT(config.num_files, 0);
+  RTC_DCHECK_GT(config.max_queued_packets, 0);
+  auto incoming =
+      std::make_unique<DumpFile>(config, config.file_prefix + "_in");
+  auto outgoing =
+      std::make_unique<DumpFile>(config, config.file_prefix + "_out");
+  if (!incoming->Open() || !outgoing->Open()) {
+    RTC_LOG(LS_ERROR) << "Failed to open RTP dump files in "
+                      << config.directory;
+    return nullptr;
+  }
+  return absl::WrapUnique(new RtpDumpRecorder(
+      config, std::move(incoming), std::move(outgoing), task_queue_factory));
+}
+
+RtpDumpRecorder::RtpDumpRecorder(const Config& config,
+                                 std::unique_ptr<DumpFile> incoming,
+                                 std::unique_ptr<DumpFile> outgoing,
+                                 TaskQueueFactory* task_queue_factory)
+    : config_(config),
+      start_time_ms_(rtc::TimeMillis()),
+      queue_(config.max_queued_packets, [&config] {
+        Record prototype;
+        prototype.data.resize(config.snap_length);
+        return prototype;
+      }()),
+      incoming_file_(std::move(incoming)),
+      outgoing_file_(std::move(outgoing)),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "RtpDumpRecorder",
+          TaskQueueFactory::Priority::LOW)) {
+  packet_sequence_checker_.Detach();
+  record_.data.resize(config_.snap_length);
+  write_record_.data.resize(config_.snap_length);
+  task_queue_.PostTask([this] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    write_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_.Get(), config_.write_interval, [this] {
+          RTC_DCHECK_RUN_ON(&task_queue_);
+          WriteQueuedRecords();
+          return config_.write_interval;
+        });
+  });
+}
+
+RtpDumpRecorder::~RtpDumpRecorder() {
+  rtc::Event done;
+  task_queue_.PostTask([this, &done] {
+    RTC_DCHECK_RUN_ON(&task_queue_);
+    write_task_.Stop();
+    WriteQueuedRecords();
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+}
+
+void RtpDumpRecorder::OnPacket(bool incoming,
+                               bool rtcp,
+                               rtc::ArrayView<const uint8_t> packet) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  size_t size = packet.size();
+  if (!rtcp)
+    size = std::min(size, RtpHeaderSize(packet) + config_.payload_prefix_bytes);
+  record_.size = std::min(size, record_.data.size());
+  record_.incoming = incoming;
+  record_.rtcp = rtcp;
+  record_.original_length = static_cast<uint16_t>(std::min<size_t>(
+      packet.size(), std::numeric_limits<uint16_t>::max()));
+  record_.time_ms = static_cast<uint32_t>(rtc::TimeMillis() - start_time_ms_);
+  memcpy(record_.data.data(), packet.data(), record_.size);
+  // On success `record_` is swapped with a free record of the queue.
+  if (!queue_.Insert(&record_))
+    ++num_dropped_packets_;
+}
+
+void RtpDumpRecorder::WriteQueuedRecords() {
+  // Writes at most a queue worth of records, so that packets that keep coming
+  // in can't hold up the task queue.
+  for (size_t i = 0;
+       i < config_.max_queued_packets && queue_.Remove(&write_record_); ++i) {
+    DumpFile* file = write_record_.incoming ? incoming_file_.get()
+                                            : outgoing_file_.get();
+    if (!file->WriteRecord(write_record_))
+      ++num_dropped_packets_;
+  }
+  incoming_file_->Flush();
+  outgoing_file_->Flush();
+}
+
+}  // namespace webrtc
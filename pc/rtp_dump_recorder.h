@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_RTP_DUMP_RECORDER_H_
+#define PC_RTP_DUMP_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/swap_queue.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Records the RTP and RTCP packets of a transport to rotating files in the
+// rtpdump format, which test/rtp_file_reader.h and rtptools can read. Each
+// direction goes to its own set of files, `<file_prefix>_in` and
+// `<file_prefix>_out`, and every file starts with the rtpdump file header, so
+// that it can be read on its own once older files have been rotated out.
+//
+// Only the RTP header and the first `payload_prefix_bytes` of the payload are
+// recorded, and RTCP packets are cut at `snap_length`. The cost on the
+// network thread is bounded by a copy of at most `snap_length` bytes into a
+// preallocated queue, which the files are written from on a task queue of
+// their own. Packets are dropped, rather than waiting or allocating, when the
+// queue is full or when writing them would exceed `max_bytes_per_second`.
+class RtpDumpRecorder {
+ public:
+  struct Config {
+    std::string directory;
+    std::string file_prefix = "rtpdump";
+    size_t max_file_size = 10 * 1024 * 1024;
+    size_t num_files = 5;
+    size_t payload_prefix_bytes = 0;
+    // Upper bound on the bytes recorded for any packet.
+    size_t snap_length = 256;
+    // Packets that may wait to be written.
+    size_t max_queued_packets = 4096;
+    // Upper bound on the bytes written to disk, per second and direction.
+    size_t max_bytes_per_second = 1024 * 1024;
+    TimeDelta write_interval = TimeDelta::Millis(200);
+  };
+
+  // Returns nullptr if the files can't be opened.
+  static std::unique_ptr<RtpDumpRecorder> Create(
+      const Config& config,
+      TaskQueueFactory* task_queue_factory);
+
+  RtpDumpRecorder(const RtpDumpRecorder&) = delete;
+  RtpDumpRecorder& operator=(const RtpDumpRecorder&) = delete;
+  // Writes the packets still in the queue and closes the files.
+  ~RtpDumpRecorder();
+
+  // Must be called on a single thread, for packets of either direction.
+  void OnPacket(bool incoming, bool rtcp, rtc::ArrayView<const uint8_t> packet);
+
+  // Packets that were dropped because of the caps on queue size and rate.
+  int64_t num_dropped_packets() const { return num_dropped_packets_.load(); }
+
+ private:
+  class DumpFile;
+  struct Record {
+    bool incoming = false;
+    bool rtcp = false;
+    // Size of the packet on the wire.
+    uint16_t original_length = 0;
+    // Milliseconds since the recorder was created.
+    uint32_t time_ms = 0;
+    // Sized to `snap_length` up front, so that records can be swapped in and
+    // out of the queue without allocating. Only `size` bytes are recorded.
+    std::vector<uint8_t> data;
+    size_t size = 0;
+  };
+
+  RtpDumpRecorder(const Config& config,
+                  std::unique_ptr<DumpFile> incoming,
+                  std::unique_ptr<DumpFile> outgoing,
+                  TaskQueueFactory* task_queue_factory);
+
+  void WriteQueuedRecords() RTC_RUN_ON(task_queue_);
+
+  const Config config_;
+  const int64_t start_time_ms_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_sequence_checker_;
+  Record record_ RTC_GUARDED_BY(packet_sequence_checker_);
+  SwapQueue<Record> queue_;
+  std::atomic<int64_t> num_dropped_packets_{0};
+
+  const std::unique_ptr<DumpFile> incoming_file_ RTC_GUARDED_BY(task_queue_);
+  const std::unique_ptr<DumpFile> outgoing_file_ RTC_GUARDED_BY(task_queue_);
+  Record write_record_ RTC_GUARDED_BY(task_queue_);
+  RepeatingTaskHandle write_task_ RTC_GUARDED_BY(task_queue_);
+  // Destroyed first, so that no write is running when the files are closed.
+  rtc::TaskQueue task_queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_RTP_DUMP_RECORDER_H_
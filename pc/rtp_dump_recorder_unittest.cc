@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/rtp_dump_recorder.h"
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/fake_clock.h"
+#include "test/gtest.h"
+#include "test/rtp_file_reader.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+// RTP packet with one CSRC, a header extension of one word and 8 bytes of
+// payload.
+const uint8_t kRtpPacket[] = {
+    0x91, 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0xbe, 0xde, 0x00, 0x01,
+    0x10, 0xff, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08};
+constexpr size_t kRtpHeaderSize = 24;
+// Receiver report without report blocks.
+const uint8_t kRtcpPacket[] = {0x80, 0xc9, 0x00, 0x01,
+                               0x00, 0x00, 0x00, 0x05};
+
+class RtpDumpRecorderTest : public ::testing::Test {
+ protected:
+  RtpDumpRecorderTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()) {
+    config_.directory =
+        test::OutputPath() + "rtp_dump_recorder" + test::kPathDelimiter;
+    EXPECT_TRUE(test::CreateDir(config_.directory));
+  }
+  ~RtpDumpRecorderTest() override {
+    for (const std::string& file : test::ReadDirectory(config_.directory)
+                                       .value_or(std::vector<std::string>())) {
+      test::RemoveFile(file);
+    }
+    test::RemoveDir(config_.directory);
+  }
+
+  std::string FilePath(const std::string& suffix, int index) {
+    return config_.directory + config_.file_prefix + suffix + "_" +
+           std::to_string(index);
+  }
+
+  std::vector<test::RtpPacket> ReadPackets(const std::string& path) {
+    std::vector<test::RtpPacket> packets;
+    std::unique_ptr<test::RtpFileReader> reader(
+        test::RtpFileReader::Create(test::RtpFileReader::kRtpDump, path));
+    EXPECT_TRUE(reader) << path;
+    test::RtpPacket packet;
+    while (reader && reader->NextPacket(&packet))
+      packets.push_back(packet);
+    return packets;
+  }
+
+  rtc::ScopedBaseFakeClock clock_;
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  RtpDumpRecorder::Config config_;
+};
+
+TEST_F(RtpDumpRecorderTest, RecordsHeadersAndPayloadPrefix) {
+  config_.payload_prefix_bytes = 2;
+  auto recorder = RtpDumpRecorder::Create(config_, task_queue_factory_.get());
+  ASSERT_TRUE(recorder);
+  clock_.AdvanceTime(TimeDelta::Millis(10));
+  recorder->OnPacket(/*incoming=*/true, /*rtcp=*/false, kRtpPacket);
+  recorder->OnPacket(/*incoming=*/false, /*rtcp=*/true, kRtcpPacket);
+  recorder.reset();
+
+  std::vector<test::RtpPacket> incoming = ReadPackets(FilePath("_in", 0));
+  ASSERT_EQ(incoming.size(), 1u);
+  EXPECT_EQ(incoming[0].length, kRtpHeaderSize + 2);
+  EXPECT_EQ(incoming[0].original_length, sizeof(kRtpPacket));
+  EXPECT_EQ(incoming[0].time_ms, 10u);
+  EXPECT_EQ(memcmp(incoming[0].data, kRtpPacket, kRtpHeaderSize + 2), 0);
+
+  std::vector<test::RtpPacket> outgoing = ReadPackets(FilePath("_out", 0));
+  ASSERT_EQ(outgoing.size(), 1u);
+  EXPECT_EQ(outgoing[0].length, sizeof(kRtcpPacket));
+  // RTCP packets are marked by an original length of zero.
+  EXPECT_EQ(outgoing[0].original_length, 0u);
+  EXPECT_EQ(memcmp(outgoing[0].data, kRtcpPacket, sizeof(kRtcpPacket)), 0);
+}
+
+TEST_F(RtpDumpRecorderTest, RotatedFilesCanBeReadOnTheirOwn) {
+  config_.snap_length = 64;
+  config_.max_file_size = 200;
+  config_.num_files = 3;
+  auto recorder = RtpDumpRecorder::Create(config_, task_queue_factory_.get());
+  ASSERT_TRUE(recorder);
+  for (int i = 0; i < 20; ++i)
+    recorder->OnPacket(/*incoming=*/true, /*rtcp=*/false, kRtpPacket);
+  recorder.reset();
+
+  for (int index = 0; index < 3; ++index) {
+    std::vector<test::RtpPacket> packets =
+        ReadPackets(FilePath("_in", index));
+    EXPECT_FALSE(packets.empty());
+    for (const test::RtpPacket& packet : packets)
+      EXPECT_EQ(packet.length, kRtpHeaderSize);
+  }
+}
+
+TEST_F(RtpDumpRecorderTest, DropsPacketsAboveRateCap) {
+  // Room for three RTCP packets and their record headers.
+  config_.max_bytes_per_second = 3 * (8 + sizeof(kRtcpPacket));
+  auto recorder = RtpDumpRecorder::Create(config_, task_queue_factory_.get());
+  ASSERT_TRUE(recorder);
+  for (int i = 0; i < 5; ++i)
+    recorder->OnPacket(/*incoming=*/false, /*rtcp=*/true, kRtcpPacket);
+  clock_.AdvanceTime(TimeDelta::Seconds(1));
+  recorder->OnPacket(/*incoming=*/false, /*rtcp=*/true, kRtcpPacket);
+  recorder.reset();
+
+  EXPECT_EQ(ReadPackets(FilePath("_out", 0)).size(), 4u);
+}
+
+TEST_F(RtpDumpRecorderTest, DropsPacketsWhenQueueIsFull) {
+  config_.max_queued_packets = 2;
+  // The clock doesn't advance, so nothing is written until the recorder is
+  // destroyed.
+  auto recorder = RtpDumpRecorder::Create(config_, task_queue_factory_.get());
+  ASSERT_TRUE(recorder);
+  for (int i = 0; i < 5; ++i)
+    recorder->OnPacket(/*incoming=*/true, /*rtcp=*/false, kRtpPacket);
+  EXPECT_EQ(recorder->num_dropped_packets(), 3);
+  recorder.reset();
+
+  EXPECT_EQ(ReadPackets(FilePath("_in", 0)).size(), 2u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -27,6 +27,7 @@
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/trace_event.h"
 
 namespace webrtc {
@@ -90,6 +91,21 @@ RtpParameters RestoreEncodingLayers(
   return result;
 }
 
+// Must be called on the worker thread.
+RTCError SetRtpSendParameters(cricket::MediaChannel* media_channel,
+                              uint32_t ssrc,
+                              const std::vector<std::string>& disabled_rids,
+                              const RtpParameters& parameters) {
+  RtpParameters rtp_parameters = parameters;
+  if (!disabled_rids.empty()) {
+    // Need to add the inactive layers.
+    RtpParameters old_parameters = media_channel->GetRtpSendParameters(ssrc);
+    rtp_parameters = RestoreEncodingLayers(parameters, disabled_rids,
+                                           old_parameters.encodings);
+  }
+  return media_channel->SetRtpSendParameters(ssrc, rtp_parameters);
+}
+
 }  // namespace
 
 // Returns true if any RtpParameters member that isn't implemented contains a
@@ -179,21 +195,14 @@ RTCError RtpSenderBase::SetParametersInternal(const RtpParameters& parameters) {
     return result;
   }
   return worker_thread_->Invoke<RTCError>(RTC_FROM_HERE, [&] {
-    RtpParameters rtp_parameters = parameters;
-    if (!disabled_rids_.empty()) {
-      // Need to add the inactive layers.
-      RtpParameters old_parameters =
-          media_channel_->GetRtpSendParameters(ssrc_);
-      rtp_parameters = RestoreEncodingLayers(parameters, disabled_rids_,
-                                             old_parameters.encodings);
-    }
-    return media_channel_->SetRtpSendParameters(ssrc_, rtp_parameters);
+    return SetRtpSendParameters(media_channel_, ssrc_, disabled_rids_,
+                                parameters);
   });
 }
 
-RTCError RtpSenderBase::SetParameters(const RtpParameters& parameters) {
+RTCError RtpSenderBase::CheckSetParameters(
+    const RtpParameters& parameters) const {
   RTC_DCHECK_RUN_ON(signaling_thread_);
-  TRACE_EVENT0("webrtc", "RtpSenderBase::SetParameters");
   if (is_transceiver_stopped_) {
     LOG_AND_RETURN_ERROR(
         RTCErrorType::INVALID_STATE,
@@ -203,10 +212,6 @@ RTCError RtpSenderBase::SetParameters(const RtpParameters& parameters) {
     LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_STATE,
                          "Cannot set parameters on a stopped sender.");
   }
-  if (stopped_) {
-    LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_STATE,
-                         "Cannot set parameters on a stopped sender.");
-  }
   if (!last_transaction_id_) {
     LOG_AND_RETURN_ERROR(
         RTCErrorType::INVALID_STATE,
@@ -219,12 +224,56 @@ RTCError RtpSenderBase::SetParameters(const RtpParameters& parameters) {
         "Failed to set parameters since the transaction_id doesn't match"
         " the last value returned from getParameters()");
   }
+  return RTCError::OK();
+}
 
-  RTCError result = SetParametersInternal(parameters);
+RTCError RtpSenderBase::SetParameters(const RtpParameters& parameters) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  TRACE_EVENT0("webrtc", "RtpSenderBase::SetParameters");
+  RTCError result = CheckSetParameters(parameters);
+  if (!result.ok())
+    return result;
+
+  result = SetParametersInternal(parameters);
   last_transaction_id_.reset();
   return result;
 }
 
+void RtpSenderBase::SetParametersAsync(
+    const RtpParameters& parameters,
+    std::function<void(RTCError)> callback) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  TRACE_EVENT0("webrtc", "RtpSenderBase::SetParametersAsync");
+  RTCError result = CheckSetParameters(parameters);
+  if (!result.ok()) {
+    callback(std::move(result));
+    return;
+  }
+  last_transaction_id_.reset();
+
+  if (!media_channel_ || !ssrc_ ||
+      UnimplementedRtpParameterHasValue(parameters)) {
+    // Doesn't need the worker thread.
+    callback(SetParametersInternal(parameters));
+    return;
+  }
+  // The media channel is destroyed by a blocking call to the worker thread
+  // after SetMediaChannel(nullptr), so it outlives this task.
+  worker_thread_->PostTask(ToQueuedTask(
+      [media_channel = media_channel_, ssrc = ssrc_,
+       disabled_rids = disabled_rids_, parameters,
+       signaling_thread = signaling_thread_,
+       callback = std::move(callback)]() mutable {
+        RTCError result = SetRtpSendParameters(media_channel, ssrc,
+                                               disabled_rids, parameters);
+        signaling_thread->PostTask(ToQueuedTask(
+            [callback = std::move(callback),
+             result = std::move(result)]() mutable {
+              callback(std::move(result));
+            }));
+      }));
+}
+
 void RtpSenderBase::SetStreams(const std::vector<std::string>& stream_ids) {
   set_stream_ids(stream_ids);
   if (set_streams_observer_)
@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -116,6 +117,8 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
 
   RtpParameters GetParameters() const override;
   RTCError SetParameters(const RtpParameters& parameters) override;
+  void SetParametersAsync(const RtpParameters& parameters,
+                          std::function<void(RTCError)> callback) override;
 
   // `GetParameters` and `SetParameters` operate with a transactional model.
   // Allow access to get/set parameters without invalidating transaction id.
@@ -201,6 +204,10 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
   // some other way to test if we have a valid SSRC.
   bool can_send_track() const { return track_ && ssrc_; }
 
+  // Checks that `parameters` may be passed to SetParametersInternal() on
+  // behalf of the application.
+  RTCError CheckSetParameters(const RtpParameters& parameters) const;
+
   virtual std::string track_kind() const = 0;
 
   // Enable sending on the media channel.
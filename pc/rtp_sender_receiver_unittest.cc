@@ -877,6 +877,34 @@ TEST_F(RtpSenderReceiverTest, AudioSenderCanSetParameters) {
   DestroyAudioRtpSender();
 }
 
+TEST_F(RtpSenderReceiverTest, AudioSenderCanSetParametersAsync) {
+  CreateAudioRtpSender();
+
+  RtpParameters params = audio_rtp_sender_->GetParameters();
+  ASSERT_EQ(1u, params.encodings.size());
+  params.encodings[0].max_bitrate_bps = 1000;
+  absl::optional<RTCError> result;
+  audio_rtp_sender_->SetParametersAsync(
+      params, [&](RTCError error) { result = std::move(error); });
+  // Applied on the worker thread, which is the current thread here.
+  EXPECT_FALSE(result);
+  run_loop_.Flush();
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->ok());
+  EXPECT_EQ(1000, voice_media_channel_->GetRtpSendParameters(kAudioSsrc)
+                      .encodings[0]
+                      .max_bitrate_bps);
+
+  // The transaction id is used up.
+  result = absl::nullopt;
+  audio_rtp_sender_->SetParametersAsync(
+      params, [&](RTCError error) { result = std::move(error); });
+  ASSERT_TRUE(result);
+  EXPECT_EQ(RTCErrorType::INVALID_STATE, result->type());
+
+  DestroyAudioRtpSender();
+}
+
 TEST_F(RtpSenderReceiverTest, AudioSenderCanSetParametersBeforeNegotiation) {
   audio_rtp_sender_ =
       AudioRtpSender::Create(worker_thread_, /*id=*/"", nullptr, nullptr);
@@ -32,6 +32,33 @@
 
 namespace webrtc {
 namespace {
+
+// Returns true if the channel would be configured the same way from `a` and
+// `b`.
+bool IsSameChannelContent(const cricket::MediaContentDescription& a,
+                          const cricket::MediaContentDescription& b) {
+  if (a.type() != b.type() || a.direction() != b.direction() ||
+      a.protocol() != b.protocol() || a.rtcp_mux() != b.rtcp_mux() ||
+      a.rtcp_reduced_size() != b.rtcp_reduced_size() ||
+      a.remote_estimate() != b.remote_estimate() ||
+      a.bandwidth() != b.bandwidth() ||
+      a.bandwidth_type() != b.bandwidth_type() ||
+      a.conference_mode() != b.conference_mode() ||
+      a.extmap_allow_mixed_enum() != b.extmap_allow_mixed_enum() ||
+      a.rtp_header_extensions_set() != b.rtp_header_extensions_set() ||
+      a.rtp_header_extensions() != b.rtp_header_extensions() ||
+      a.streams() != b.streams()) {
+    return false;
+  }
+  if (a.as_audio()) {
+    return a.as_audio()->codecs() == b.as_audio()->codecs();
+  }
+  if (a.as_video()) {
+    return a.as_video()->codecs() == b.as_video()->codecs();
+  }
+  return true;
+}
+
 template <class T>
 RTCError VerifyCodecPreferences(const std::vector<RtpCodecCapability>& codecs,
                                 const std::vector<T>& send_codecs,
@@ -216,6 +243,9 @@ void RtpTransceiver::SetChannel(
 
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(1);
 
+  // A new channel hasn't been given any content yet.
+  ResetChannelContentUpdates();
+
   if (!channel_) {
     for (const auto& receiver : receivers_)
       receiver->internal()->SetSourceEnded();
@@ -601,6 +631,56 @@ void RtpTransceiver::OnNegotiationUpdate(
     negotiated_header_extensions_ = content->rtp_header_extensions();
 }
 
+void RtpTransceiver::GetChannelContentUpdates(
+    cricket::ContentSource source,
+    SdpType type,
+    const cricket::MediaContentDescription* content,
+    std::vector<ContentUpdate>* updates) {
+  RTC_DCHECK_RUN_ON(thread_);
+  RTC_DCHECK(content);
+  absl::optional<PushedContent>& pushed = pushed_content_[source];
+  bool unchanged = pushed && pushed->type == type &&
+                   IsSameChannelContent(*pushed->content, *content);
+  if (unchanged) {
+    if (!deferred_source_ || *deferred_source_ == source) {
+      deferred_source_ = source;
+      return;
+    }
+    // The other source has been deferred too. If the channel was last given
+    // the other source's content and then this one, it is in the state that
+    // giving it both again would leave it in.
+    if (last_pushed_source_ == source && pushed_alternately_) {
+      deferred_source_ = absl::nullopt;
+      return;
+    }
+  }
+  if (deferred_source_) {
+    PushContent(*deferred_source_, updates);
+    deferred_source_ = absl::nullopt;
+  }
+  if (!unchanged) {
+    pushed = PushedContent{type, content->Clone()};
+  }
+  PushContent(source, updates);
+}
+
+void RtpTransceiver::ResetChannelContentUpdates() {
+  RTC_DCHECK_RUN_ON(thread_);
+  pushed_content_[cricket::CS_LOCAL] = absl::nullopt;
+  pushed_content_[cricket::CS_REMOTE] = absl::nullopt;
+  deferred_source_ = absl::nullopt;
+  last_pushed_source_ = absl::nullopt;
+  pushed_alternately_ = false;
+}
+
+void RtpTransceiver::PushContent(cricket::ContentSource source,
+                                 std::vector<ContentUpdate>* updates) {
+  const PushedContent& pushed = *pushed_content_[source];
+  updates->push_back(ContentUpdate{source, pushed.type, pushed.content});
+  pushed_alternately_ = last_pushed_source_ && *last_pushed_source_ != source;
+  last_pushed_source_ = source;
+}
+
 void RtpTransceiver::SetPeerConnectionClosed() {
   is_pc_closed_ = true;
 }
@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -276,7 +277,40 @@ class RtpTransceiver final
   void OnNegotiationUpdate(SdpType sdp_type,
                            const cricket::MediaContentDescription* content);
 
+  // A content description to give to the channel with SetLocalContent() or
+  // SetRemoteContent().
+  struct ContentUpdate {
+    cricket::ContentSource source;
+    SdpType type;
+    std::shared_ptr<const cricket::MediaContentDescription> content;
+  };
+
+  // Called on the signaling thread when `content` has been negotiated for
+  // `source`. Appends the updates that the channel needs to `updates`, in the
+  // order they must be applied.
+  //
+  // Renegotiating a session with many m-sections mostly leaves their contents
+  // unchanged, so an update with the same type and content as the last one
+  // from `source` is deferred. It is dropped when the other source also gives
+  // its last content again, since re-applying both wouldn't change the
+  // channel, and is applied before any update that differs otherwise.
+  void GetChannelContentUpdates(cricket::ContentSource source,
+                                SdpType type,
+                                const cricket::MediaContentDescription* content,
+                                std::vector<ContentUpdate>* updates);
+  // Called when the channel failed to apply an update given by
+  // GetChannelContentUpdates(), since its state is then unknown.
+  void ResetChannelContentUpdates();
+
  private:
+  struct PushedContent {
+    SdpType type;
+    std::shared_ptr<const cricket::MediaContentDescription> content;
+  };
+
+  void PushContent(cricket::ContentSource source,
+                   std::vector<ContentUpdate>* updates);
+
   void OnFirstPacketReceived();
   void StopSendingAndReceiving();
 
@@ -314,6 +348,18 @@ class RtpTransceiver final
   cricket::RtpHeaderExtensions negotiated_header_extensions_
       RTC_GUARDED_BY(thread_);
 
+  // The last content that has been given to the channel from each source,
+  // indexed by cricket::ContentSource.
+  absl::optional<PushedContent> pushed_content_[2] RTC_GUARDED_BY(thread_);
+  // The source whose last update was deferred, if any.
+  absl::optional<cricket::ContentSource> deferred_source_
+      RTC_GUARDED_BY(thread_);
+  absl::optional<cricket::ContentSource> last_pushed_source_
+      RTC_GUARDED_BY(thread_);
+  // True if the last two updates given to the channel were from different
+  // sources.
+  bool pushed_alternately_ RTC_GUARDED_BY(thread_) = false;
+
   const std::function<void()> on_negotiation_needed_;
 };
 
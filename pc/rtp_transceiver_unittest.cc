@@ -13,12 +13,17 @@
 #include "pc/rtp_transceiver.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/jsep.h"
 #include "api/rtp_parameters.h"
+#include "media/base/codec.h"
 #include "media/base/fake_media_engine.h"
 #include "media/base/media_engine.h"
+#include "pc/session_description.h"
 #include "pc/test/mock_channel_interface.h"
 #include "pc/test/mock_rtp_receiver_internal.h"
 #include "pc/test/mock_rtp_sender_internal.h"
@@ -400,4 +405,78 @@ TEST_F(RtpTransceiverTestForHeaderExtensions,
                               "uri5", 6, RtpTransceiverDirection::kSendRecv)));
 }
 
+namespace {
+// Returns the sources and types of `updates`, e.g. "local offer".
+std::vector<std::string> DescribeUpdates(
+    const std::vector<RtpTransceiver::ContentUpdate>& updates) {
+  std::vector<std::string> descriptions;
+  for (const RtpTransceiver::ContentUpdate& update : updates) {
+    descriptions.push_back(
+        std::string(update.source == cricket::CS_LOCAL ? "local " : "remote ") +
+        SdpTypeToString(update.type));
+  }
+  return descriptions;
+}
+}  // namespace
+
+TEST(RtpTransceiverTest, LeavesOutUnchangedContentUpdates) {
+  ChannelManagerForTest cm;
+  RtpTransceiver transceiver(cricket::MediaType::MEDIA_TYPE_AUDIO, &cm);
+  cricket::AudioContentDescription local;
+  local.AddCodec(cricket::AudioCodec(111, "opus", 48000, 0, 2));
+  cricket::AudioContentDescription remote = local;
+  std::vector<RtpTransceiver::ContentUpdate> updates;
+
+  // The first negotiation gives the channel both contents.
+  transceiver.GetChannelContentUpdates(cricket::CS_LOCAL, SdpType::kOffer,
+                                       &local, &updates);
+  transceiver.GetChannelContentUpdates(cricket::CS_REMOTE, SdpType::kAnswer,
+                                       &remote, &updates);
+  EXPECT_THAT(DescribeUpdates(updates),
+              ElementsAre("local offer", "remote answer"));
+
+  // Renegotiating the same contents doesn't update the channel.
+  updates.clear();
+  transceiver.GetChannelContentUpdates(cricket::CS_LOCAL, SdpType::kOffer,
+                                       &local, &updates);
+  transceiver.GetChannelContentUpdates(cricket::CS_REMOTE, SdpType::kAnswer,
+                                       &remote, &updates);
+  EXPECT_TRUE(updates.empty());
+
+  // When only the answer changes, the deferred offer is given first.
+  updates.clear();
+  remote.set_direction(RtpTransceiverDirection::kSendOnly);
+  transceiver.GetChannelContentUpdates(cricket::CS_LOCAL, SdpType::kOffer,
+                                       &local, &updates);
+  EXPECT_TRUE(updates.empty());
+  transceiver.GetChannelContentUpdates(cricket::CS_REMOTE, SdpType::kAnswer,
+                                       &remote, &updates);
+  EXPECT_THAT(DescribeUpdates(updates),
+              ElementsAre("local offer", "remote answer"));
+  ASSERT_EQ(2u, updates.size());
+  EXPECT_EQ(RtpTransceiverDirection::kSendOnly,
+            updates[1].content->direction());
+}
+
+TEST(RtpTransceiverTest, GivesAllContentUpdatesAfterReset) {
+  ChannelManagerForTest cm;
+  RtpTransceiver transceiver(cricket::MediaType::MEDIA_TYPE_AUDIO, &cm);
+  cricket::AudioContentDescription description;
+  std::vector<RtpTransceiver::ContentUpdate> updates;
+
+  transceiver.GetChannelContentUpdates(cricket::CS_REMOTE, SdpType::kOffer,
+                                       &description, &updates);
+  transceiver.GetChannelContentUpdates(cricket::CS_LOCAL, SdpType::kAnswer,
+                                       &description, &updates);
+  transceiver.ResetChannelContentUpdates();
+
+  updates.clear();
+  transceiver.GetChannelContentUpdates(cricket::CS_REMOTE, SdpType::kOffer,
+                                       &description, &updates);
+  transceiver.GetChannelContentUpdates(cricket::CS_LOCAL, SdpType::kAnswer,
+                                       &description, &updates);
+  EXPECT_THAT(DescribeUpdates(updates),
+              ElementsAre("remote offer", "local answer"));
+}
+
 }  // namespace webrtc
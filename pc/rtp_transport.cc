@@ -13,21 +13,52 @@
 #include <errno.h>
 
 #include <cstdint>
+#include <cstring>
 #include <utility>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
+rtc::scoped_refptr<RtpPacketBufferPool>
+RtpTransport::MaybeCreatePacketBufferPool() {
+  if (field_trial::IsEnabled("WebRTC-RtpPacketBufferPool")) {
+    return rtc::make_ref_counted<RtpPacketBufferPool>();
+  }
+  return nullptr;
+}
+
+std::unique_ptr<RtcpPacketAggregator>
+RtpTransport::MaybeCreateRtcpAggregator() {
+  constexpr char kRtcpAggregationFieldTrial[] = "WebRTC-RtcpAggregation";
+  if (!field_trial::IsEnabled(kRtcpAggregationFieldTrial))
+    return nullptr;
+  // Leaves room for the SRTCP trailer and the IP/UDP/TURN headers.
+  FieldTrialParameter<int> max_packet_size("max_packet_size", 1200);
+  FieldTrialParameter<TimeDelta> max_delay("max_delay",
+                                           TimeDelta::Millis(20));
+  ParseFieldTrial({&max_packet_size, &max_delay},
+                  field_trial::FindFullName(kRtcpAggregationFieldTrial));
+  return std::make_unique<RtcpPacketAggregator>(
+      max_packet_size.Get(), max_delay.Get(),
+      [this](rtc::CopyOnWriteBuffer* packet, const rtc::PacketOptions& options,
+             int flags) { return DoSendRtcpPacket(packet, options, flags); });
+}
+
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
   MaybeSignalReadyToSend();
@@ -136,6 +167,14 @@ bool RtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
 bool RtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                   const rtc::PacketOptions& options,
                                   int flags) {
+  if (rtcp_aggregator_)
+    return rtcp_aggregator_->SendRtcpPacket(packet, options, flags);
+  return DoSendRtcpPacket(packet, options, flags);
+}
+
+bool RtpTransport::DoSendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                                    const rtc::PacketOptions& options,
+                                    int flags) {
   return SendPacket(true, packet, options, flags);
 }
 
@@ -155,6 +194,11 @@ bool RtpTransport::SendPacket(bool rtcp,
     }
     return false;
   }
+  if (rtp_dump_recorder_) {
+    rtp_dump_recorder_->OnPacket(/*incoming=*/false, rtcp,
+                                 rtc::MakeArrayView(packet->cdata(),
+                                                    packet->size()));
+  }
   return true;
 }
 
@@ -184,9 +228,10 @@ bool RtpTransport::UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) {
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) {
   webrtc::RtpPacketReceived parsed_packet(
-      &header_extension_map_, packet_time_us == -1
-                                  ? Timestamp::MinusInfinity()
-                                  : Timestamp::Micros(packet_time_us));
+      &header_extension_map_,
+      packet_time_us == -1 ? Timestamp::MinusInfinity()
+                           : Timestamp::Micros(packet_time_us),
+      packet_buffer_pool_);
   if (!parsed_packet.Parse(std::move(packet))) {
     RTC_LOG(LS_ERROR)
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
@@ -262,8 +307,21 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
                       << " packet: wrong size=" << len;
     return;
   }
+  if (rtp_dump_recorder_) {
+    rtp_dump_recorder_->OnPacket(
+        /*incoming=*/true, packet_type == cricket::RtpPacketType::kRtcp,
+        rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(data), len));
+  }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet;
+  if (packet_buffer_pool_ && packet_type == cricket::RtpPacketType::kRtp) {
+    // Allocate for the largest valid packet so that any pooled buffer can be
+    // reused regardless of the size of the packet it held before.
+    packet = packet_buffer_pool_->Acquire(len, cricket::kMaxRtpPacketLen);
+    memcpy(packet.MutableData(), data, len);
+  } else {
+    packet.SetData(data, len);
+  }
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
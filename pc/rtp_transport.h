@@ -14,13 +14,18 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
 #include <string>
 
 #include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
 #include "call/rtp_demuxer.h"
 #include "call/video_receive_stream.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 #include "p2p/base/packet_transport_internal.h"
+#include "pc/rtcp_packet_aggregator.h"
+#include "pc/rtp_dump_recorder.h"
 #include "pc/rtp_transport_internal.h"
 #include "pc/session_description.h"
 #include "rtc_base/async_packet_socket.h"
@@ -46,7 +51,9 @@ class RtpTransport : public RtpTransportInternal {
   RtpTransport& operator=(const RtpTransport&) = delete;
 
   explicit RtpTransport(bool rtcp_mux_enabled)
-      : rtcp_mux_enabled_(rtcp_mux_enabled) {}
+      : rtcp_mux_enabled_(rtcp_mux_enabled),
+        packet_buffer_pool_(MaybeCreatePacketBufferPool()),
+        rtcp_aggregator_(MaybeCreateRtcpAggregator()) {}
 
   bool rtcp_mux_enabled() const override { return rtcp_mux_enabled_; }
   void SetRtcpMuxEnabled(bool enable) override;
@@ -88,6 +95,12 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  // Records the packets sent and received from now on, as they are on the
+  // wire, until it's called with null. `recorder` must outlive the recording.
+  void SetRtpDumpRecorder(RtpDumpRecorder* recorder) {
+    rtp_dump_recorder_ = recorder;
+  }
+
  protected:
   // These methods will be used in the subclasses.
   void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
@@ -97,6 +110,12 @@ class RtpTransport : public RtpTransportInternal {
                   const rtc::PacketOptions& options,
                   int flags);
 
+  // Sends `packet`, which may hold the RTCP of several streams when RTCP
+  // aggregation is enabled. Overridden by SrtpTransport.
+  virtual bool DoSendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                                const rtc::PacketOptions& options,
+                                int flags);
+
   // Overridden by SrtpTransport.
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
@@ -138,6 +157,20 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  static rtc::scoped_refptr<RtpPacketBufferPool> MaybeCreatePacketBufferPool();
+
+  // Recycles the buffers of received RTP packets. Null unless the
+  // "WebRTC-RtpPacketBufferPool" field trial is enabled.
+  const rtc::scoped_refptr<RtpPacketBufferPool> packet_buffer_pool_;
+
+  std::unique_ptr<RtcpPacketAggregator> MaybeCreateRtcpAggregator();
+
+  // Merges the RTCP packets of the streams sharing this transport. Null
+  // unless the "WebRTC-RtcpAggregation" field trial is enabled.
+  const std::unique_ptr<RtcpPacketAggregator> rtcp_aggregator_;
+
+  RtpDumpRecorder* rtp_dump_recorder_ = nullptr;
 };
 
 }  // namespace webrtc
@@ -333,7 +333,7 @@ void SctpDataChannel::SetSctpSid(int sid) {
   }
 
   const_cast<InternalDataChannelInit&>(config_).id = sid;
-  provider_->AddSctpDataStream(sid);
+  provider_->AddSctpDataStream(sid, priority());
 }
 
 void SctpDataChannel::OnClosingProcedureStartedRemotely(int sid) {
@@ -372,7 +372,7 @@ void SctpDataChannel::OnTransportChannelCreated() {
   // The sid may have been unassigned when provider_->ConnectDataChannel was
   // done. So always add the streams even if connected_to_provider_ is true.
   if (config_.id >= 0) {
-    provider_->AddSctpDataStream(config_.id);
+    provider_->AddSctpDataStream(config_.id, priority());
   }
 }
 
@@ -48,8 +48,9 @@ class SctpDataChannelProviderInterface {
   virtual bool ConnectDataChannel(SctpDataChannel* data_channel) = 0;
   // Disconnects from the transport signals.
   virtual void DisconnectDataChannel(SctpDataChannel* data_channel) = 0;
-  // Adds the data channel SID to the transport for SCTP.
-  virtual void AddSctpDataStream(int sid) = 0;
+  // Adds the data channel SID to the transport for SCTP, with the data
+  // channel's priority.
+  virtual void AddSctpDataStream(int sid, Priority priority) = 0;
   // Begins the closing procedure by sending an outgoing stream reset. Still
   // need to wait for callbacks to tell when this completes.
   virtual void RemoveSctpDataStream(int sid) = 0;
@@ -28,6 +28,7 @@ class SctpDataChannelTransport : public DataChannelTransportInterface,
       cricket::SctpTransportInternal* sctp_transport);
 
   RTCError OpenChannel(int channel_id) override;
+  void SetChannelPriority(int channel_id, Priority priority) override;
   RTCError SendData(int channel_id,
                     const SendDataParams& params,
                     const rtc::CopyOnWriteBuffer& buffer) override;
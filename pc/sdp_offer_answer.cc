@@ -4428,11 +4428,15 @@ RTCError SdpOfferAnswerHandler::PushdownMediaDescription(
                     "Failed to update payload type demuxing state.");
   }
 
-  // Push down the new SDP media section for each audio/video transceiver.
+  // Push down the new SDP media section for each audio/video transceiver. The
+  // transceivers leave out the sections that the channels already have, so
+  // that renegotiating a session with many m-sections only updates the
+  // channels whose sections changed.
   auto rtp_transceivers = transceivers()->ListInternal();
   std::vector<
-      std::pair<cricket::ChannelInterface*, const MediaContentDescription*>>
+      std::pair<cricket::ChannelInterface*, RtpTransceiver::ContentUpdate>>
       channels;
+  std::vector<RtpTransceiver::ContentUpdate> updates;
   for (const auto& transceiver : rtp_transceivers) {
     const ContentInfo* content_info =
         FindMediaSectionForTransceiver(transceiver, sdesc);
@@ -4447,29 +4451,60 @@ RTCError SdpOfferAnswerHandler::PushdownMediaDescription(
     }
 
     transceiver->OnNegotiationUpdate(type, content_desc);
-    channels.push_back(std::make_pair(channel, content_desc));
-  }
-
-  // This for-loop of invokes helps audio impairment during re-negotiations.
-  // One of the causes is that downstairs decoder creation is synchronous at the
-  // moment, and that a decoder is created for each codec listed in the SDP.
-  //
-  // TODO(bugs.webrtc.org/12840): consider merging the invokes again after
-  // these projects have shipped:
-  // - bugs.webrtc.org/12462
-  // - crbug.com/1157227
-  // - crbug.com/1187289
-  for (const auto& entry : channels) {
-    std::string error;
-    bool success =
-        context_->worker_thread()->Invoke<bool>(RTC_FROM_HERE, [&]() {
-          return (source == cricket::CS_LOCAL)
-                     ? entry.first->SetLocalContent(entry.second, type, error)
-                     : entry.first->SetRemoteContent(entry.second, type, error);
-        });
-    if (!success) {
-      return RTCError(RTCErrorType::INVALID_PARAMETER, error);
+    updates.clear();
+    transceiver->GetChannelContentUpdates(source, type, content_desc, &updates);
+    for (RtpTransceiver::ContentUpdate& update : updates) {
+      channels.push_back(std::make_pair(channel, std::move(update)));
+    }
+  }
+
+  auto apply_update = [](const auto& entry, std::string& error) {
+    const RtpTransceiver::ContentUpdate& update = entry.second;
+    return (update.source == cricket::CS_LOCAL)
+               ? entry.first->SetLocalContent(update.content.get(),
+                                              update.type, error)
+               : entry.first->SetRemoteContent(update.content.get(),
+                                               update.type, error);
+  };
+  std::string error;
+  bool success = true;
+  if (absl::StartsWith(
+          context_->trials().Lookup("WebRTC-BatchChannelContentUpdates"),
+          "Enabled")) {
+    // A single hop for all channels, so that the signaling thread doesn't
+    // queue up behind a busy worker thread once per channel.
+    success = context_->worker_thread()->Invoke<bool>(RTC_FROM_HERE, [&]() {
+      for (const auto& entry : channels) {
+        if (!apply_update(entry, error))
+          return false;
+      }
+      return true;
+    });
+  } else {
+    // This for-loop of invokes helps audio impairment during re-negotiations.
+    // One of the causes is that downstairs decoder creation is synchronous at
+    // the moment, and that a decoder is created for each codec listed in the
+    // SDP.
+    //
+    // TODO(bugs.webrtc.org/12840): consider merging the invokes again after
+    // these projects have shipped:
+    // - bugs.webrtc.org/12462
+    // - crbug.com/1157227
+    // - crbug.com/1187289
+    for (const auto& entry : channels) {
+      success = context_->worker_thread()->Invoke<bool>(
+          RTC_FROM_HERE, [&]() { return apply_update(entry, error); });
+      if (!success)
+        break;
+    }
+  }
+  if (!success) {
+    // The channels that haven't been updated must be given their contents
+    // by the next negotiation, as must the one that failed.
+    for (const auto& transceiver : rtp_transceivers) {
+      transceiver->ResetChannelContentUpdates();
     }
+    return RTCError(RTCErrorType::INVALID_PARAMETER, error);
   }
 
   // Need complete offer/answer with an SCTP m= section before starting SCTP,
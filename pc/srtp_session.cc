@@ -14,6 +14,8 @@
 
 #include <iomanip>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/base/const_init.h"
@@ -23,6 +25,7 @@
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/time_utils.h"
@@ -187,6 +190,40 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   return true;
 }
 
+size_t SrtpSession::ProtectRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  size_t protected_packets = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    int out_len = 0;
+    if (ProtectRtp(packet.MutableData(), rtc::checked_cast<int>(packet.size()),
+                   rtc::checked_cast<int>(packet.capacity()), &out_len)) {
+      packet.SetSize(out_len);
+      ++protected_packets;
+    } else {
+      packet.Clear();
+    }
+  }
+  return protected_packets;
+}
+
+size_t SrtpSession::UnprotectRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  size_t unprotected_packets = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    int out_len = 0;
+    if (UnprotectRtp(packet.MutableData(),
+                     rtc::checked_cast<int>(packet.size()), &out_len)) {
+      packet.SetSize(out_len);
+      ++unprotected_packets;
+    } else {
+      packet.Clear();
+    }
+  }
+  return unprotected_packets;
+}
+
 bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   if (!session_) {
@@ -249,6 +286,18 @@ bool SrtpSession::IsExternalAuthEnabled() const {
   return external_auth_enabled_;
 }
 
+void SrtpSession::SetReplayWindowSize(int window_size) {
+  RTC_DCHECK(!session_);
+  RTC_DCHECK_GE(window_size, 64);
+  RTC_DCHECK_LT(window_size, 0x8000);
+  replay_window_size_ = window_size;
+}
+
+void SrtpSession::SetKnownRecvSsrcs(std::vector<uint32_t> ssrcs) {
+  RTC_DCHECK(!session_);
+  known_recv_ssrcs_ = std::move(ssrcs);
+}
+
 bool SrtpSession::IsExternalAuthActive() const {
   return external_auth_active_;
 }
@@ -297,7 +346,7 @@ bool SrtpSession::DoSetKey(int type,
   policy.ssrc.value = 0;
   policy.key = const_cast<uint8_t*>(key);
   // TODO(astor) parse window size from WSH session-param
-  policy.window_size = 1024;
+  policy.window_size = replay_window_size_;
   policy.allow_repeat_tx = 1;
   // If external authentication option is enabled, supply custom auth module
   // id EXTERNAL_HMAC_SHA1 in the policy structure.
@@ -315,6 +364,22 @@ bool SrtpSession::DoSetKey(int type,
   }
   policy.next = nullptr;
 
+  // The streams of known SSRCs share the policy of the template, and are
+  // chained after it.
+  std::vector<srtp_policy_t> ssrc_policies;
+  if (type == ssrc_any_inbound) {
+    ssrc_policies.resize(known_recv_ssrcs_.size(), policy);
+    for (size_t i = 0; i < ssrc_policies.size(); ++i) {
+      ssrc_policies[i].ssrc.type = ssrc_specific;
+      ssrc_policies[i].ssrc.value = known_recv_ssrcs_[i];
+      ssrc_policies[i].next =
+          i + 1 < ssrc_policies.size() ? &ssrc_policies[i + 1] : nullptr;
+    }
+    if (!ssrc_policies.empty()) {
+      policy.next = &ssrc_policies[0];
+    }
+  }
+
   if (!session_) {
     int err = srtp_create(&session_, &policy);
     if (err != srtp_err_status_ok) {
@@ -16,8 +16,10 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/synchronization/mutex.h"
 
 // Forward declaration to avoid pulling in libsrtp headers here
@@ -77,6 +79,14 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Batch versions of ProtectRtp() and UnprotectRtp() for callers handling
+  // many packets at once, e.g. when forwarding. The packets are processed
+  // in place, back to back, so that the session's key schedule and replay
+  // state stay hot in cache. Packets that fail are cleared (left with zero
+  // size). Returns the number of packets processed successfully.
+  size_t ProtectRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+  size_t UnprotectRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -90,6 +100,19 @@ class SrtpSession {
   void EnableExternalAuth();
   bool IsExternalAuthEnabled() const;
 
+  // Sets the size, in packets, of the replay window of each stream. Larger
+  // windows let high-bitrate video through after more reordering. Must be
+  // between 64 and 32767 (libsrtp's limits). This method is only valid
+  // before the keys have been set.
+  void SetReplayWindowSize(int window_size);
+
+  // Sets the SSRCs that are expected on a receiving session. Their streams
+  // are created together with the session, rather than being cloned from the
+  // template by libsrtp on their first packet, and are kept across key
+  // updates. Packets with other SSRCs are still accepted. This method is
+  // only valid before the keys have been set.
+  void SetKnownRecvSsrcs(std::vector<uint32_t> ssrcs);
+
   // A SRTP session supports external creation of the auth tag if a non-GCM
   // cipher is used. This method is only valid after the RTP params have
   // been set.
@@ -144,6 +167,8 @@ class SrtpSession {
   int last_send_seq_num_ = -1;
   bool external_auth_active_ = false;
   bool external_auth_enabled_ = false;
+  int replay_window_size_ = 1024;
+  std::vector<uint32_t> known_recv_ssrcs_;
   int decryption_failure_count_ = 0;
   bool dump_plain_rtp_ = false;
 };
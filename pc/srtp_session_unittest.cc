@@ -13,6 +13,8 @@
 #include <string.h>
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
@@ -117,6 +119,37 @@ TEST_F(SrtpSessionTest, TestProtect_AES_CM_128_HMAC_SHA1_80) {
   TestUnprotectRtcp(kCsAesCm128HmacSha1_80);
 }
 
+// Test that a batch of RTP packets can be protected and unprotected, and that
+// a failing packet does not affect the rest of the batch.
+TEST_F(SrtpSessionTest, TestProtectAndUnprotectRtpPackets) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  const size_t tag_len = rtp_auth_tag_len(kCsAesCm128HmacSha1_80);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  for (uint16_t seq_num = 1; seq_num <= 4; ++seq_num) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  sizeof(kPcmuFrame) + tag_len);
+    SetBE16(packet.MutableData() + 2, seq_num);
+    packets.push_back(std::move(packet));
+  }
+  // No room for the auth tag.
+  packets[2] = rtc::CopyOnWriteBuffer(kPcmuFrame, sizeof(kPcmuFrame));
+
+  EXPECT_EQ(s1_.ProtectRtpPackets(packets), 3u);
+  EXPECT_EQ(packets[0].size(), sizeof(kPcmuFrame) + tag_len);
+  EXPECT_EQ(packets[2].size(), 0u);
+  packets.erase(packets.begin() + 2);
+
+  EXPECT_EQ(s2_.UnprotectRtpPackets(packets), 3u);
+  for (const rtc::CopyOnWriteBuffer& packet : packets) {
+    ASSERT_EQ(packet.size(), sizeof(kPcmuFrame));
+    EXPECT_EQ(0, memcmp(packet.cdata() + 4, kPcmuFrame + 4,
+                        sizeof(kPcmuFrame) - 4));
+  }
+}
+
 // Test that we can encrypt and decrypt RTP/RTCP using AES_CM_128_HMAC_SHA1_32.
 TEST_F(SrtpSessionTest, TestProtect_AES_CM_128_HMAC_SHA1_32) {
   EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_32, kTestKey1, kTestKeyLen,
@@ -247,4 +280,62 @@ TEST_F(SrtpSessionTest, TestReplay) {
       s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
 }
 
+
+// Test that streams of known SSRCs can be unprotected, across a key update,
+// and that packets of other SSRCs are still accepted.
+TEST_F(SrtpSessionTest, TestKnownRecvSsrcs) {
+  // The SSRC of `kPcmuFrame` is 1.
+  s2_.SetKnownRecvSsrcs({1, 2, 3});
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  TestProtectRtp(kCsAesCm128HmacSha1_80);
+  TestUnprotectRtp(kCsAesCm128HmacSha1_80);
+
+  EXPECT_TRUE(s1_.UpdateSend(kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen,
+                             kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.UpdateRecv(kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen,
+                             kEncryptedHeaderExtensionIds));
+  memcpy(rtp_packet_, kPcmuFrame, sizeof(kPcmuFrame));
+  rtp_len_ = sizeof(kPcmuFrame);
+  SetBE16(reinterpret_cast<uint8_t*>(rtp_packet_) + 2, 2);
+  int out_len = 0;
+  EXPECT_TRUE(
+      s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
+  EXPECT_TRUE(s2_.UnprotectRtp(rtp_packet_, out_len, &out_len));
+
+  memcpy(rtp_packet_, kPcmuFrame, sizeof(kPcmuFrame));
+  SetBE32(reinterpret_cast<uint8_t*>(rtp_packet_) + 8, 4);
+  EXPECT_TRUE(
+      s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
+  EXPECT_TRUE(s2_.UnprotectRtp(rtp_packet_, out_len, &out_len));
+}
+
+// Test that a larger replay window accepts packets that are further behind.
+TEST_F(SrtpSessionTest, TestLargerReplayWindow) {
+  static const uint16_t seqnum_big = 62275;
+  static const uint16_t replay_window = 4096;
+  int out_len;
+
+  s1_.SetReplayWindowSize(replay_window);
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+
+  SetBE16(reinterpret_cast<uint8_t*>(rtp_packet_) + 2, seqnum_big);
+  EXPECT_TRUE(
+      s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
+
+  // Outside of the default window of 1024, but within 4096.
+  SetBE16(reinterpret_cast<uint8_t*>(rtp_packet_) + 2,
+          seqnum_big - replay_window + 1);
+  EXPECT_TRUE(
+      s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
+
+  SetBE16(reinterpret_cast<uint8_t*>(rtp_packet_) + 2,
+          seqnum_big - replay_window - 1);
+  EXPECT_FALSE(
+      s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
+}
+
 }  // namespace rtc
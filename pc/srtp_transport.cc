@@ -173,9 +173,55 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
-bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
-                                   const rtc::PacketOptions& options,
-                                   int flags) {
+size_t SrtpTransport::SendRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+    const rtc::PacketOptions& options,
+    int flags) {
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR)
+        << "Failed to send the packets because SRTP transport is inactive.";
+    return 0;
+  }
+  size_t sent = 0;
+  if (IsExternalAuthActive()) {
+    // Every packet needs its own auth params; fall back to sending them one
+    // at a time.
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      if (SendRtpPacket(&packet, options, flags)) {
+        ++sent;
+      }
+    }
+    return sent;
+  }
+
+  {
+    TRACE_EVENT0("webrtc", "SRTP Encode");
+    if (send_session_->ProtectRtpPackets(packets) < packets.size()) {
+      RTC_LOG(LS_ERROR) << "Failed to protect some RTP packets in a batch.";
+    }
+  }
+  // Failed packets were cleared; find the last one left to send.
+  size_t last = packets.size();
+  while (last > 0 && packets[last - 1].size() == 0) {
+    --last;
+  }
+  rtc::PacketOptions batch_options = options;
+  batch_options.batchable = true;
+  for (size_t i = 0; i < last; ++i) {
+    if (packets[i].size() == 0) {
+      continue;
+    }
+    batch_options.last_packet_in_batch = i + 1 == last;
+    if (SendPacket(/*rtcp=*/false, &packets[i], batch_options, flags)) {
+      ++sent;
+    }
+  }
+  return sent;
+}
+
+bool SrtpTransport::DoSendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                                     const rtc::PacketOptions& options,
+                                     int flags) {
   if (!IsSrtpActive()) {
     RTC_LOG(LS_ERROR)
         << "Failed to send the packet because SRTP transport is inactive.";
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/crypto_params.h"
 #include "api/rtc_error.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -48,9 +49,13 @@ class SrtpTransport : public RtpTransport {
                      const rtc::PacketOptions& options,
                      int flags) override;
 
-  bool SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
-                      const rtc::PacketOptions& options,
-                      int flags) override;
+  // Protects `packets` back to back and then sends them as one batch, which
+  // lets the socket layer coalesce the sends. All packets share `options`.
+  // Packets that cannot be protected are dropped. Returns the number of
+  // packets sent.
+  size_t SendRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+                        const rtc::PacketOptions& options,
+                        int flags);
 
   // The transport becomes active if the send_session_ and recv_session_ are
   // created.
@@ -117,6 +122,9 @@ class SrtpTransport : public RtpTransport {
   void ConnectToRtpTransport();
   void CreateSrtpSessions();
 
+  bool DoSendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
+                        const rtc::PacketOptions& options,
+                        int flags) override;
   void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                            int64_t packet_time_us) override;
   void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -404,6 +404,34 @@ INSTANTIATE_TEST_SUITE_P(ExternalAuth,
                          SrtpTransportTestWithExternalAuth,
                          ::testing::Values(true, false));
 
+TEST_F(SrtpTransportTest, SendRtpPacketsProtectsAndSendsBatch) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  const size_t packet_size =
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  for (uint16_t seq_num = 1; seq_num <= 3; ++seq_num) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame), packet_size);
+    rtc::SetBE16(packet.MutableData() + 2, seq_num);
+    packets.push_back(std::move(packet));
+  }
+
+  EXPECT_EQ(srtp_transport1_->SendRtpPackets(packets, rtc::PacketOptions(),
+                                             cricket::PF_SRTP_BYPASS),
+            3u);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 3);
+  auto fake_rtp_packet_transport = static_cast<rtc::FakePacketTransport*>(
+      srtp_transport1_->rtp_packet_transport());
+  EXPECT_EQ(fake_rtp_packet_transport->last_sent_packet()->size(),
+            packet_size);
+}
+
 // Test directly setting the params with bogus keys.
 TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
   std::vector<int> extension_ids;
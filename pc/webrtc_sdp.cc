@@ -509,7 +509,8 @@ static bool GetLine(const std::string& message,
   if (line_end > 0 && (message.at(line_end - 1) == kReturnChar)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
+  // Reuse the capacity of `line`, which callers keep across lines.
+  line->assign(message, line_begin, line_end - line_begin);
   const char* cline = line->c_str();
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
@@ -603,6 +604,11 @@ static bool HasAttribute(const std::string& line,
   return false;
 }
 
+// Returns the <value> of a "<type>=<value>" line, without copying it.
+static absl::string_view GetLineValue(absl::string_view line) {
+  return line.substr(kLinePrefixLength);
+}
+
 static bool AddSsrcLine(uint32_t ssrc_id,
                         const std::string& attribute,
                         const std::string& value,
@@ -1271,10 +1277,10 @@ bool ParseSctpPort(const std::string& line,
   // a=sctp-port
   std::vector<std::string> fields;
   const size_t expected_min_fields = 2;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterColonChar, &fields);
   if (fields.size() < expected_min_fields) {
     fields.resize(0);
-    rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+    rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   }
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -1292,7 +1298,7 @@ bool ParseSctpMaxMessageSize(const std::string& line,
   // a=max-message-size:199999
   std::vector<std::string> fields;
   const size_t expected_min_fields = 2;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterColonChar, &fields);
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
   }
@@ -1308,7 +1314,7 @@ bool ParseExtmap(const std::string& line,
   // RFC 5285
   // a=extmap:<value>["/"<direction>] <URI> <extensionattributes>
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -2139,7 +2145,7 @@ bool ParseSessionDescription(const std::string& message,
                                  error);
   }
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_fields = 6;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2282,7 +2288,7 @@ bool ParseGroupAttribute(const std::string& line,
   // RFC 5888 and draft-holmberg-mmusic-sdp-bundle-negotiation-00
   // a=group:BUNDLE video voice
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   std::string semantics;
   if (!GetValue(fields[0], kAttributeGroup, &semantics, error)) {
     return false;
@@ -2300,7 +2306,7 @@ static bool ParseFingerprintAttribute(
     std::unique_ptr<rtc::SSLFingerprint>* fingerprint,
     SdpParseError* error) {
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_fields = 2;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2333,7 +2339,7 @@ static bool ParseDtlsSetup(const std::string& line,
   // setup-attr           =  "a=setup:" role
   // role                 =  "active" / "passive" / "actpass" / "holdconn"
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterColonChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterColonChar, &fields);
   const size_t expected_fields = 2;
   if (fields.size() != expected_fields) {
     return ParseFailedExpectFieldNum(line, expected_fields, error);
@@ -2357,8 +2363,8 @@ static bool ParseMsidAttribute(const std::string& line,
   std::string field1;
   std::string new_stream_id;
   std::string new_track_id;
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                           kSdpDelimiterSpaceChar, &field1, &new_track_id)) {
+  if (!rtc::tokenize_first(GetLineValue(line), kSdpDelimiterSpaceChar, &field1,
+                           &new_track_id)) {
     const size_t expected_fields = 2;
     return ParseFailedExpectFieldNum(line, expected_fields, error);
   }
@@ -2642,7 +2648,7 @@ bool ParseMediaDescription(
     ++mline_index;
 
     std::vector<std::string> fields;
-    rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+    rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
 
     const size_t expected_min_fields = 4;
     if (fields.size() < expected_min_fields) {
@@ -2871,22 +2877,9 @@ T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
 // Updates or creates a new codec entry in the audio description.
 template <class T, class U>
 void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-  for (U& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
-  }
-  desc->set_codecs(codecs);
+  // Replaces the codec in place, since copying all codecs for every rtpmap,
+  // fmtp and rtcp-fb line is costly for descriptions with many m-sections.
+  static_cast<T*>(content_desc)->AddOrReplaceCodec(codec);
 }
 
 // Adds or updates existing codec corresponding to `payload_type` according
@@ -3024,9 +3017,8 @@ bool ParseContent(const std::string& message,
     if (IsLineType(line, kLineTypeSessionBandwidth)) {
       std::string bandwidth;
       std::string bandwidth_type;
-      if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                               kSdpDelimiterColonChar, &bandwidth_type,
-                               &bandwidth)) {
+      if (!rtc::tokenize_first(GetLineValue(line), kSdpDelimiterColonChar,
+                               &bandwidth_type, &bandwidth)) {
         return ParseFailed(
             line,
             "b= syntax error, does not match b=<modifier>:<bandwidth-value>.",
@@ -3409,8 +3401,8 @@ bool ParseSsrcAttribute(const std::string& line,
   // a=ssrc:<ssrc-id> <attribute>
   // a=ssrc:<ssrc-id> <attribute>:<value>
   std::string field1, field2;
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                           kSdpDelimiterSpaceChar, &field1, &field2)) {
+  if (!rtc::tokenize_first(GetLineValue(line), kSdpDelimiterSpaceChar, &field1,
+                           &field2)) {
     const size_t expected_fields = 2;
     return ParseFailedExpectFieldNum(line, expected_fields, error);
   }
@@ -3487,7 +3479,7 @@ bool ParseSsrcGroupAttribute(const std::string& line,
   // RFC 5576
   // a=ssrc-group:<semantics> <ssrc-id> ...
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -3512,7 +3504,7 @@ bool ParseCryptoAttribute(const std::string& line,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   // RFC 4568
   // a=crypto:<tag> <crypto-suite> <key-params> [<session-params>]
   const size_t expected_min_fields = 3;
@@ -3578,7 +3570,7 @@ bool ParseRtpmapAttribute(const std::string& line,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
   std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  rtc::split(GetLineValue(line), kSdpDelimiterSpaceChar, &fields);
   // RFC 4566
   // a=rtpmap:<payload type> <encoding name>/<clock rate>[/<encodingparameters>]
   const size_t expected_min_fields = 2;
@@ -3673,9 +3665,8 @@ bool ParseFmtpAttributes(const std::string& line,
   // a=fmtp:<format> <format specific parameters>
   // At least two fields, whereas the second one is any of the optional
   // parameters.
-  if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
-                           kSdpDelimiterSpaceChar, &line_payload,
-                           &line_params)) {
+  if (!rtc::tokenize_first(GetLineValue(line), kSdpDelimiterSpaceChar,
+                           &line_payload, &line_params)) {
     ParseFailedExpectMinFieldNum(line, 2, error);
     return false;
   }
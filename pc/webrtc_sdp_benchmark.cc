@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures how long it takes to parse the kind of bundled offers that large
+// conferences send, with many simulcast video m-sections.
+
+#include <stdint.h>
+
+#include <string>
+
+#include "api/jsep.h"
+#include "api/jsep_session_description.h"
+#include "benchmark/benchmark.h"
+#include "pc/webrtc_sdp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kSessionSection[] =
+    "v=0\r\n"
+    "o=- 4131505339648218884 2 IN IP4 127.0.0.1\r\n"
+    "s=-\r\n"
+    "t=0 0\r\n"
+    "a=extmap-allow-mixed\r\n"
+    "a=msid-semantic: WMS\r\n";
+
+constexpr char kTransportLines[] =
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+    "a=ice-ufrag:ETEn\r\n"
+    "a=ice-pwd:OtSK0WpNtpUjkY4+86js7Z/l\r\n"
+    "a=ice-options:trickle\r\n"
+    "a=fingerprint:sha-256 "
+    "19:E2:1C:3B:4B:9F:81:E6:B8:5C:F4:A5:A8:D8:73:04:"
+    "BB:05:2F:70:9F:04:A9:0E:05:E9:26:33:E8:70:88:A2\r\n"
+    "a=setup:actpass\r\n";
+
+constexpr char kAudioCodecLines[] =
+    "a=extmap:1 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n"
+    "a=extmap:2 http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+    "a=extmap:4 urn:ietf:params:rtp-hdrext:sdes:mid\r\n"
+    "a=rtcp-mux\r\n"
+    "a=rtpmap:111 opus/48000/2\r\n"
+    "a=rtcp-fb:111 transport-cc\r\n"
+    "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+    "a=rtpmap:63 red/48000/2\r\n"
+    "a=fmtp:63 111/111\r\n"
+    "a=rtpmap:9 G722/8000\r\n"
+    "a=rtpmap:0 PCMU/8000\r\n"
+    "a=rtpmap:8 PCMA/8000\r\n"
+    "a=rtpmap:13 CN/8000\r\n"
+    "a=rtpmap:110 telephone-event/48000\r\n"
+    "a=rtpmap:126 telephone-event/8000\r\n";
+
+// Appends the rtpmap, rtcp-fb and fmtp lines of a video codec and its RTX.
+void AddVideoCodec(int payload_type,
+                   const char* name,
+                   const char* fmtp,
+                   rtc::StringBuilder* sdp) {
+  *sdp << "a=rtpmap:" << payload_type << " " << name << "/90000\r\n"
+       << "a=rtcp-fb:" << payload_type << " goog-remb\r\n"
+       << "a=rtcp-fb:" << payload_type << " transport-cc\r\n"
+       << "a=rtcp-fb:" << payload_type << " ccm fir\r\n"
+       << "a=rtcp-fb:" << payload_type << " nack\r\n"
+       << "a=rtcp-fb:" << payload_type << " nack pli\r\n";
+  if (fmtp[0] != '\0') {
+    *sdp << "a=fmtp:" << payload_type << " " << fmtp << "\r\n";
+  }
+  *sdp << "a=rtpmap:" << payload_type + 1 << " rtx/90000\r\n"
+       << "a=fmtp:" << payload_type + 1 << " apt=" << payload_type << "\r\n";
+}
+
+// Returns an offer with `num_sections` m-sections in one BUNDLE group. Every
+// fourth m-section is audio, the others are video with three simulcast layers
+// signaled with rids, as browsers do.
+std::string CreateLargeOffer(int num_sections) {
+  rtc::StringBuilder sdp;
+  sdp << kSessionSection << "a=group:BUNDLE";
+  for (int mid = 0; mid < num_sections; ++mid) {
+    sdp << " " << mid;
+  }
+  sdp << "\r\n";
+
+  uint32_t ssrc = 1000;
+  for (int mid = 0; mid < num_sections; ++mid) {
+    bool audio = mid % 4 == 0;
+    if (audio) {
+      sdp << "m=audio 9 UDP/TLS/RTP/SAVPF 111 63 9 0 8 13 110 126\r\n";
+    } else {
+      sdp << "m=video 9 UDP/TLS/RTP/SAVPF "
+             "96 97 98 99 100 101 102 103 104 105 106 107\r\n";
+    }
+    sdp << kTransportLines << "a=mid:" << mid << "\r\n"
+        << "a=sendrecv\r\n"
+        << "a=msid:stream" << mid << " track" << mid << "\r\n";
+    if (audio) {
+      sdp << kAudioCodecLines << "a=ssrc:" << ssrc++ << " cname:benchmark\r\n";
+      continue;
+    }
+    sdp << "a=extmap:2 "
+           "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+        << "a=extmap:3 http://www.ietf.org/id/"
+           "draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+        << "a=extmap:4 urn:ietf:params:rtp-hdrext:sdes:mid\r\n"
+        << "a=extmap:10 urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id\r\n"
+        << "a=extmap:11 "
+           "urn:ietf:params:rtp-hdrext:sdes:repaired-rtp-stream-id\r\n"
+        << "a=rtcp-mux\r\n"
+        << "a=rtcp-rsize\r\n";
+    AddVideoCodec(96, "VP8", "", &sdp);
+    AddVideoCodec(98, "VP9", "profile-id=0", &sdp);
+    AddVideoCodec(100, "VP9", "profile-id=2", &sdp);
+    AddVideoCodec(102, "H264",
+                  "level-asymmetry-allowed=1;packetization-mode=1;"
+                  "profile-level-id=42001f",
+                  &sdp);
+    AddVideoCodec(104, "H264",
+                  "level-asymmetry-allowed=1;packetization-mode=1;"
+                  "profile-level-id=42e01f",
+                  &sdp);
+    AddVideoCodec(106, "AV1", "", &sdp);
+    sdp << "a=rid:q send\r\n"
+        << "a=rid:h send\r\n"
+        << "a=rid:f send\r\n"
+        << "a=simulcast:send q;h;f\r\n";
+  }
+  return sdp.Release();
+}
+
+void BM_SdpDeserializeLargeOffer(benchmark::State& state) {
+  const std::string offer = CreateLargeOffer(state.range(0));
+  for (auto s : state) {
+    JsepSessionDescription description(SdpType::kOffer);
+    SdpParseError error;
+    RTC_CHECK(SdpDeserialize(offer, &description, &error)) << error.description;
+    benchmark::DoNotOptimize(description.description());
+  }
+  state.SetBytesProcessed(state.iterations() * offer.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SdpDeserializeLargeOffer)
+    ->RangeMultiplier(4)
+    ->Range(4, 64)
+    ->Complexity();
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,35 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_log_writer.h"
+
+#include "rtc_base/logging.h"
+
+namespace rtc {
+
+AsyncLogWriter::AsyncLogWriter(int dispatch_interval_ms)
+    : dispatch_interval_ms_(dispatch_interval_ms) {
+  LogMessage::SetAsyncDispatch(true);
+  thread_ = PlatformThread::SpawnJoinable(
+      [this] {
+        while (!stop_.Wait(dispatch_interval_ms_)) {
+          LogMessage::FlushAsyncDispatch();
+        }
+      },
+      "AsyncLogWriter", ThreadAttributes().SetPriority(ThreadPriority::kLow));
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+  stop_.Set();
+  thread_.Finalize();
+  LogMessage::SetAsyncDispatch(false);
+}
+
+}  // namespace rtc
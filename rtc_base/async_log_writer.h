@@ -0,0 +1,44 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_ASYNC_LOG_WRITER_H_
+#define RTC_BASE_ASYNC_LOG_WRITER_H_
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace rtc {
+
+// Enables asynchronous dispatch of log messages for its lifetime, see
+// LogMessage::SetAsyncDispatch(), and dispatches the buffered messages every
+// `dispatch_interval_ms` on a low priority thread of its own. Log sinks, e.g.
+// FileRotatingLogSink, are then only called on that thread, and the threads
+// that log never wait for them. Only one AsyncLogWriter may exist at a time.
+class AsyncLogWriter {
+ public:
+  static constexpr int kDefaultDispatchIntervalMs = 50;
+
+  explicit AsyncLogWriter(
+      int dispatch_interval_ms = kDefaultDispatchIntervalMs);
+  // Dispatches all buffered messages and disables asynchronous dispatch.
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+ private:
+  const int dispatch_interval_ms_;
+  Event stop_;
+  PlatformThread thread_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_ASYNC_LOG_WRITER_H_
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_log_writer.h"
+
+#include <string>
+
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread_types.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class ThreadCheckingLogSink : public LogSink {
+ public:
+  void OnLogMessage(const std::string& message) override {
+    if (message.find("async message") == std::string::npos)
+      return;
+    thread_ = CurrentThreadRef();
+    received_.Set();
+  }
+
+  bool WaitForMessage() { return received_.Wait(5000); }
+  PlatformThreadRef thread() const { return thread_; }
+
+ private:
+  PlatformThreadRef thread_;
+  Event received_;
+};
+
+TEST(AsyncLogWriterTest, DispatchesMessagesOnItsOwnThread) {
+  ThreadCheckingLogSink sink;
+  LogMessage::AddLogToStream(&sink, LS_INFO);
+  {
+    AsyncLogWriter writer(/*dispatch_interval_ms=*/1);
+    RTC_LOG(LS_INFO) << "async message";
+    ASSERT_TRUE(sink.WaitForMessage());
+    EXPECT_FALSE(IsThreadRefEqual(sink.thread(), CurrentThreadRef()));
+  }
+  LogMessage::RemoveLogToStream(&sink);
+}
+
+TEST(AsyncLogWriterTest, DispatchesRemainingMessagesWhenDestroyed) {
+  ThreadCheckingLogSink sink;
+  LogMessage::AddLogToStream(&sink, LS_INFO);
+  {
+    AsyncLogWriter writer(/*dispatch_interval_ms=*/60000);
+    RTC_LOG(LS_INFO) << "async message";
+  }
+  EXPECT_TRUE(sink.WaitForMessage());
+  LogMessage::RemoveLogToStream(&sink);
+}
+
+}  // namespace
+}  // namespace rtc
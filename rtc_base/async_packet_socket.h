@@ -51,6 +51,10 @@ struct RTC_EXPORT PacketOptions {
   PacketTimeUpdateParams packet_time_params;
   // PacketInfo is passed to SentPacket when signaling this packet is sent.
   PacketInfo info_signaled_after_sent;
+  // True if the socket may hold on to this packet and send it together with
+  // the following ones, until a packet with `last_packet_in_batch` set.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
 };
 
 // Provides the ability to receive packets asynchronously. Sends are not
@@ -17,12 +17,16 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/sent_packet.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Upper bound on the number of packets held for a batched send.
+static const size_t kMaxSendBatchSize = 64;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
@@ -52,6 +56,10 @@ AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
 }
 
 AsyncUDPSocket::~AsyncUDPSocket() {
+  FlushSendBatch();
+  if (destroyed_) {
+    *destroyed_ = true;
+  }
   delete[] buf_;
 }
 
@@ -66,6 +74,7 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  FlushSendBatch();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -78,6 +87,10 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  if (options.batchable) {
+    return EnqueueBatchedSend(pv, cb, addr, options);
+  }
+  FlushSendBatch();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
@@ -87,6 +100,7 @@ int AsyncUDPSocket::SendTo(const void* pv,
 }
 
 int AsyncUDPSocket::Close() {
+  FlushSendBatch();
   return socket_->Close();
 }
 
@@ -110,8 +124,92 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetMaxPacketsPerReadEvent(
+    size_t max_packets,
+    size_t max_batched_packet_size) {
+  RTC_DCHECK_GT(max_packets, 0);
+  RTC_DCHECK_GT(max_batched_packet_size, 0);
+  max_packets_per_read_ = max_packets;
+  max_batched_packet_size_ = max_batched_packet_size;
+  batch_entries_.clear();
+  batch_buf_.reset();
+  if (max_packets_per_read_ <= 1) {
+    return;
+  }
+  batch_buf_.reset(
+      new char[(max_packets_per_read_ - 1) * max_batched_packet_size_]);
+  batch_entries_.resize(max_packets_per_read_);
+  batch_entries_[0].buffer = buf_;
+  batch_entries_[0].capacity = size_;
+  for (size_t i = 1; i < max_packets_per_read_; ++i) {
+    batch_entries_[i].buffer =
+        batch_buf_.get() + (i - 1) * max_batched_packet_size_;
+    batch_entries_[i].capacity = max_batched_packet_size_;
+  }
+}
+
+int AsyncUDPSocket::EnqueueBatchedSend(const void* pv,
+                                       size_t cb,
+                                       const SocketAddress& addr,
+                                       const rtc::PacketOptions& options) {
+  if (send_batch_size_ == 0) {
+    // Make sure the packets are sent even if the last packet of the batch
+    // ends up on a different socket.
+    Thread* current = Thread::Current();
+    if (!current) {
+      rtc::PacketOptions unbatched_options(options);
+      unbatched_options.batchable = false;
+      return SendTo(pv, cb, addr, unbatched_options);
+    }
+    current->PostTask(webrtc::ToQueuedTask(task_safety_.flag(),
+                                           [this] { FlushSendBatch(); }));
+  }
+  if (send_batch_.size() == send_batch_size_) {
+    send_batch_.emplace_back();
+  }
+  PendingSend& pending = send_batch_[send_batch_size_++];
+  pending.data.SetData(static_cast<const uint8_t*>(pv), cb);
+  pending.destination = addr;
+  pending.options = options;
+  if (options.last_packet_in_batch || send_batch_size_ >= kMaxSendBatchSize) {
+    if (FlushSendBatch() < 0) {
+      return -1;
+    }
+  }
+  return static_cast<int>(cb);
+}
+
+int AsyncUDPSocket::FlushSendBatch() {
+  if (send_batch_size_ == 0) {
+    return 0;
+  }
+  send_batch_entries_.resize(send_batch_size_);
+  for (size_t i = 0; i < send_batch_size_; ++i) {
+    send_batch_entries_[i].data = send_batch_[i].data.data();
+    send_batch_entries_[i].size = send_batch_[i].data.size();
+    send_batch_entries_[i].destination = send_batch_[i].destination;
+  }
+  int64_t send_time_ms = rtc::TimeMillis();
+  int ret = socket_->SendToBatch(send_batch_entries_.data(), send_batch_size_);
+  size_t count = send_batch_size_;
+  send_batch_size_ = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const PendingSend& pending = send_batch_[i];
+    rtc::SentPacket sent_packet(pending.options.packet_id, send_time_ms,
+                                pending.options.info_signaled_after_sent);
+    CopySocketInformationToPacketInfo(pending.data.size(), *this, true,
+                                      &sent_packet.info);
+    SignalSentPacket(this, sent_packet);
+  }
+  return ret;
+}
+
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
+  if (max_packets_per_read_ > 1) {
+    ReadBatch();
+    return;
+  }
 
   SocketAddress remote_addr;
   int64_t timestamp;
@@ -133,6 +231,44 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                    (timestamp > -1 ? timestamp : TimeMicros()));
 }
 
+void AsyncUDPSocket::ReadBatch() {
+  int count =
+      socket_->RecvFromBatch(batch_entries_.data(), batch_entries_.size());
+  if (count < 0) {
+    // See OnReadEvent(); usually an ICMP error for an earlier send.
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  bool destroyed = false;
+  destroyed_ = &destroyed;
+  int64_t now_us = -1;
+  for (int i = 0; i < count; ++i) {
+    const Socket::RecvBatchEntry& entry = batch_entries_[i];
+    if (entry.truncated) {
+      RTC_LOG(LS_WARNING) << "AsyncUDPSocket dropping datagram larger than "
+                          << entry.capacity << " bytes in batched receive.";
+      continue;
+    }
+    int64_t timestamp = entry.timestamp;
+    if (timestamp < 0) {
+      if (now_us < 0) {
+        now_us = TimeMicros();
+      }
+      timestamp = now_us;
+    }
+    SignalReadPacket(this, static_cast<const char*>(entry.buffer),
+                     entry.length, entry.source, timestamp);
+    if (destroyed) {
+      return;
+    }
+  }
+  destroyed_ = nullptr;
+}
+
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
   SignalReadyToSend(this);
 }
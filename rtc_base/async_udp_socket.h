@@ -14,16 +14,22 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 
 namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
-// buffered since it is acceptable to drop packets under high load.
+// buffered since it is acceptable to drop packets under high load, except for
+// packets marked as batchable in PacketOptions: these are held until the last
+// packet of the batch and then sent together using Socket::SendToBatch().
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
@@ -55,15 +61,56 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Lets each read event drain up to `max_packets` datagrams from the
+  // underlying socket, using Socket::RecvFromBatch(). All but the first
+  // datagram of a batch are received into buffers of `max_batched_packet_size`
+  // bytes; larger datagrams in those positions are dropped. The default of 1
+  // keeps the behavior of one RecvFrom() per read event.
+  void SetMaxPacketsPerReadEvent(
+      size_t max_packets,
+      size_t max_batched_packet_size = kDefaultMaxBatchedPacketSize);
+
+  static constexpr size_t kDefaultMaxBatchedPacketSize = 2048;
+
  private:
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  void ReadBatch();
+  int EnqueueBatchedSend(const void* pv,
+                         size_t cb,
+                         const SocketAddress& addr,
+                         const rtc::PacketOptions& options);
+  // Sends all packets held by EnqueueBatchedSend(). Returns the result of
+  // Socket::SendToBatch(), or 0 if there was nothing to send.
+  int FlushSendBatch();
 
   std::unique_ptr<Socket> socket_;
   char* buf_;
   size_t size_;
+  size_t max_packets_per_read_ = 1;
+  size_t max_batched_packet_size_ = kDefaultMaxBatchedPacketSize;
+  // Storage for the second and later datagrams of a batch.
+  std::unique_ptr<char[]> batch_buf_;
+  std::vector<Socket::RecvBatchEntry> batch_entries_;
+  // Points to a flag on the stack of ReadBatch() while it is signaling
+  // packets, so that it can stop if a listener destroys this object.
+  bool* destroyed_ = nullptr;
+
+  struct PendingSend {
+    Buffer data;
+    SocketAddress destination;
+    PacketOptions options;
+  };
+  // Holds batchable packets until the end of the batch. Elements are reused
+  // across batches; only the first `send_batch_size_` are in use.
+  std::vector<PendingSend> send_batch_;
+  size_t send_batch_size_ = 0;
+  std::vector<Socket::SendBatchEntry> send_batch_entries_;
+  // Detached, since sockets may be created on another thread than the one
+  // that uses them.
+  webrtc::ScopedTaskSafetyDetached task_safety_;
 };
 
 }  // namespace rtc
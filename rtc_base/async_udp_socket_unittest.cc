@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/physical_socket_server.h"
@@ -47,4 +48,48 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+#if defined(WEBRTC_LINUX)
+class BatchReceiver : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets.emplace_back(data, size);
+    timestamps.push_back(packet_time_us);
+  }
+
+  std::vector<std::string> packets;
+  std::vector<int64_t> timestamps;
+};
+
+TEST(AsyncUdpSocketBatchTest, DrainsSeveralDatagramsPerReadEvent) {
+  PhysicalSocketServer pss;
+  Socket* receive_socket = pss.CreateSocket(AF_INET, SOCK_DGRAM);
+  ASSERT_TRUE(receive_socket);
+  ASSERT_EQ(0, receive_socket->Bind(SocketAddress("127.0.0.1", 0)));
+  AsyncUDPSocket udp_socket(receive_socket);
+  udp_socket.SetMaxPacketsPerReadEvent(8);
+  BatchReceiver receiver;
+  udp_socket.SignalReadPacket.connect(&receiver, &BatchReceiver::OnReadPacket);
+
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  const SocketAddress destination = udp_socket.GetLocalAddress();
+  for (const char* payload : {"one", "two", "three"}) {
+    ASSERT_GT(sender->SendTo(payload, strlen(payload), destination), 0);
+  }
+
+  receive_socket->SignalReadEvent(receive_socket);
+  ASSERT_EQ(receiver.packets.size(), 3u);
+  EXPECT_EQ(receiver.packets[0], "one");
+  EXPECT_EQ(receiver.packets[1], "two");
+  EXPECT_EQ(receiver.packets[2], "three");
+  for (int64_t timestamp : receiver.timestamps) {
+    EXPECT_GT(timestamp, 0);
+  }
+}
+#endif
+
 }  // namespace rtc
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/bucketed_rate_statistics.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+
+BucketedRateStatistics::BucketedRateStatistics(int64_t max_window_size_ms,
+                                               float scale,
+                                               int64_t bucket_size_ms)
+    : scale_(scale),
+      bucket_size_ms_(bucket_size_ms),
+      max_window_size_ms_(max_window_size_ms),
+      current_window_size_ms_(max_window_size_ms_),
+      // A window that isn't aligned to the buckets touches one extra bucket.
+      buckets_(max_window_size_ms / bucket_size_ms + 2),
+      oldest_index_(0),
+      newest_index_(-1),
+      accumulated_count_(0),
+      first_timestamp_(-1),
+      num_samples_(0) {
+  RTC_DCHECK_GT(bucket_size_ms, 0);
+  RTC_DCHECK_GT(max_window_size_ms, 0);
+}
+
+BucketedRateStatistics::BucketedRateStatistics(
+    const BucketedRateStatistics& other) = default;
+
+BucketedRateStatistics::BucketedRateStatistics(BucketedRateStatistics&& other) =
+    default;
+
+BucketedRateStatistics::~BucketedRateStatistics() = default;
+
+void BucketedRateStatistics::Reset() {
+  accumulated_count_ = 0;
+  overflow_ = false;
+  num_samples_ = 0;
+  first_timestamp_ = -1;
+  current_window_size_ms_ = max_window_size_ms_;
+  std::fill(buckets_.begin(), buckets_.end(), Bucket());
+  oldest_index_ = 0;
+  newest_index_ = -1;
+}
+
+void BucketedRateStatistics::Update(int64_t count, int64_t now_ms) {
+  RTC_DCHECK_GE(count, 0);
+
+  EraseOld(now_ms);
+  if (first_timestamp_ == -1 || num_samples_ == 0) {
+    first_timestamp_ = now_ms;
+  }
+
+  int64_t index = BucketIndex(now_ms);
+  if (oldest_index_ > newest_index_) {
+    oldest_index_ = index;
+    newest_index_ = index;
+  } else if (index < newest_index_) {
+    RTC_LOG(LS_WARNING) << "Timestamp " << now_ms
+                        << " is before the last bucket in the rate window, "
+                           "aligning to that.";
+    index = newest_index_;
+  } else {
+    newest_index_ = index;
+  }
+  Bucket& bucket = BucketAt(index);
+  bucket.sum += count;
+  ++bucket.num_samples;
+
+  if (std::numeric_limits<int64_t>::max() - accumulated_count_ > count) {
+    accumulated_count_ += count;
+  } else {
+    overflow_ = true;
+  }
+  ++num_samples_;
+}
+
+absl::optional<int64_t> BucketedRateStatistics::Rate(int64_t now_ms) const {
+  const_cast<BucketedRateStatistics*>(this)->EraseOld(now_ms);
+
+  int64_t active_window_size = 0;
+  if (first_timestamp_ != -1) {
+    // The window starts at the oldest bucket that is kept, or at the first
+    // data point if the data stream started later than that.
+    const int64_t window_start_ms =
+        BucketIndex(now_ms - current_window_size_ms_ + 1) * bucket_size_ms_;
+    active_window_size =
+        now_ms - std::max(first_timestamp_, window_start_ms) + 1;
+  }
+
+  // If window is a single bucket or there is only one sample in a data set that
+  // has not grown to the full window size, or if the accumulator has
+  // overflowed, treat this as rate unavailable.
+  if (num_samples_ == 0 || active_window_size <= 1 ||
+      (num_samples_ <= 1 && active_window_size < current_window_size_ms_) ||
+      overflow_) {
+    return absl::nullopt;
+  }
+
+  float scale = scale_ / active_window_size;
+  float result = accumulated_count_ * scale + 0.5f;
+
+  // Better return unavailable rate than garbage value (undefined behavior).
+  if (result > static_cast<float>(std::numeric_limits<int64_t>::max())) {
+    return absl::nullopt;
+  }
+  return rtc::dchecked_cast<int64_t>(result);
+}
+
+bool BucketedRateStatistics::SetWindowSize(int64_t window_size_ms,
+                                           int64_t now_ms) {
+  if (window_size_ms <= 0 || window_size_ms > max_window_size_ms_)
+    return false;
+  if (first_timestamp_ != -1) {
+    // Same as in RateStatistics, the first timestamp must not be before the
+    // new window or the window would cover a region of zeros.
+    first_timestamp_ = std::max(first_timestamp_, now_ms - window_size_ms + 1);
+  }
+  current_window_size_ms_ = window_size_ms;
+  EraseOld(now_ms);
+  return true;
+}
+
+int64_t BucketedRateStatistics::BucketIndex(int64_t time_ms) const {
+  // Rounds towards minus infinity, so that buckets are aligned also for
+  // negative timestamps.
+  return time_ms >= 0 ? time_ms / bucket_size_ms_
+                      : -((bucket_size_ms_ - 1 - time_ms) / bucket_size_ms_);
+}
+
+BucketedRateStatistics::Bucket& BucketedRateStatistics::BucketAt(
+    int64_t index) {
+  const int64_t size = buckets_.size();
+  return buckets_[((index % size) + size) % size];
+}
+
+void BucketedRateStatistics::EraseOld(int64_t now_ms) {
+  // Oldest bucket that has data inside the window.
+  const int64_t new_oldest_index =
+      BucketIndex(now_ms - current_window_size_ms_ + 1);
+
+  while (oldest_index_ <= newest_index_ && oldest_index_ < new_oldest_index) {
+    Bucket& oldest_bucket = BucketAt(oldest_index_);
+    RTC_DCHECK_GE(accumulated_count_, oldest_bucket.sum);
+    RTC_DCHECK_GE(num_samples_, oldest_bucket.num_samples);
+    accumulated_count_ -= oldest_bucket.sum;
+    num_samples_ -= oldest_bucket.num_samples;
+    oldest_bucket = Bucket();
+    ++oldest_index_;
+  }
+}
+
+}  // namespace webrtc
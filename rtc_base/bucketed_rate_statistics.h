@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_BUCKETED_RATE_STATISTICS_H_
+#define RTC_BASE_BUCKETED_RATE_STATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Like RateStatistics, but counts are accumulated in a fixed ring of buckets
+// of `bucket_size_ms` each instead of in a deque with one bucket per
+// millisecond. Memory use is fixed at construction and doesn't depend on how
+// many distinct timestamps are seen, and Update() never allocates.
+//
+// Buckets are aligned to multiples of `bucket_size_ms`, and the oldest bucket
+// is kept until it is entirely outside the window. Once the window is full, a
+// rate is therefore averaged over between `window_size_ms` and
+// `window_size_ms + bucket_size_ms - 1` milliseconds. With a bucket size of
+// 1ms the results are identical to RateStatistics.
+//
+// Note that timestamps used in Update(), Rate() and SetWindowSize() must never
+// decrease for two consecutive calls.
+class RTC_EXPORT BucketedRateStatistics {
+ public:
+  // max_window_size_ms = Maximum window size in ms for the rate estimation.
+  //                      Initial window size is set to this, but may be changed
+  //                      to something lower by calling SetWindowSize().
+  // scale = coefficient to convert counts/ms to desired unit
+  //         ex: RateStatistics::kBpsScale for bits/s if count is bytes.
+  // bucket_size_ms = granularity in ms of the buckets.
+  BucketedRateStatistics(int64_t max_window_size_ms,
+                         float scale,
+                         int64_t bucket_size_ms);
+
+  BucketedRateStatistics(const BucketedRateStatistics& other);
+  BucketedRateStatistics(BucketedRateStatistics&& other);
+  ~BucketedRateStatistics();
+
+  // Reset instance to original state.
+  void Reset();
+
+  // Update rate with a new data point, moving averaging window as needed.
+  void Update(int64_t count, int64_t now_ms);
+
+  // Like RateStatistics::Rate(), this may move the window but doesn't make any
+  // observable change.
+  absl::optional<int64_t> Rate(int64_t now_ms) const;
+
+  // Update the size of the averaging window. The maximum allowed value for
+  // window_size_ms is max_window_size_ms as supplied in the constructor.
+  bool SetWindowSize(int64_t window_size_ms, int64_t now_ms);
+
+ private:
+  struct Bucket {
+    int64_t sum = 0;      // Sum of all samples in this bucket.
+    int num_samples = 0;  // Number of samples in this bucket.
+  };
+
+  // Index of the bucket that contains `time_ms`.
+  int64_t BucketIndex(int64_t time_ms) const;
+  Bucket& BucketAt(int64_t index);
+  void EraseOld(int64_t now_ms);
+
+  // To convert counts/ms to desired units
+  const float scale_;
+  const int64_t bucket_size_ms_;
+  // The window sizes, in ms, over which the rate is calculated.
+  const int64_t max_window_size_ms_;
+  int64_t current_window_size_ms_;
+
+  // Ring of buckets, large enough for the maximum window. Buckets outside of
+  // [oldest_index_, newest_index_] are always empty.
+  std::vector<Bucket> buckets_;
+  // Indices of the oldest and newest bucket in the window. There is no data
+  // in the window if `oldest_index_ > newest_index_`.
+  int64_t oldest_index_;
+  int64_t newest_index_;
+
+  // Total count recorded in all buckets.
+  int64_t accumulated_count_;
+
+  // Timestamp of the first data point seen, or -1 of none seen.
+  int64_t first_timestamp_;
+
+  // True if accumulated_count_ has ever grown too large to be
+  // contained in its integer type.
+  bool overflow_ = false;
+
+  // The total number of samples in the buckets.
+  int num_samples_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_BUCKETED_RATE_STATISTICS_H_
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/bucketed_rate_statistics.h"
+
+#include "rtc_base/random.h"
+#include "rtc_base/rate_statistics.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kWindowMs = 500;
+constexpr float kBpsScale = RateStatistics::kBpsScale;
+
+TEST(BucketedRateStatisticsTest, MatchesRateStatisticsWithOneMsBuckets) {
+  BucketedRateStatistics bucketed(kWindowMs, kBpsScale, 1);
+  RateStatistics reference(kWindowMs, kBpsScale);
+  Random random(0x12345678);
+  int64_t now_ms = 0;
+  for (int i = 0; i < 5000; ++i) {
+    // Mix of packets in the same millisecond and gaps longer than the window.
+    now_ms +=
+        random.Rand(0, 20) == 0 ? random.Rand(0, 1000) : random.Rand(0, 3);
+    if (i % 1000 == 500) {
+      const int64_t window_ms = random.Rand(1, kWindowMs);
+      EXPECT_EQ(bucketed.SetWindowSize(window_ms, now_ms),
+                reference.SetWindowSize(window_ms, now_ms));
+    }
+    const int64_t count = random.Rand(0, 1500);
+    bucketed.Update(count, now_ms);
+    reference.Update(count, now_ms);
+    ASSERT_EQ(bucketed.Rate(now_ms), reference.Rate(now_ms)) << i;
+  }
+}
+
+TEST(BucketedRateStatisticsTest, RateUnavailableForSingleSample) {
+  BucketedRateStatistics stats(kWindowMs, kBpsScale, 10);
+  EXPECT_FALSE(stats.Rate(0));
+  stats.Update(1500, 0);
+  EXPECT_FALSE(stats.Rate(0));
+  // Two samples in the same bucket, 1ms apart: 3000 bytes in 2ms.
+  stats.Update(1500, 1);
+  EXPECT_EQ(stats.Rate(1), 3000 * 8000 / 2);
+}
+
+TEST(BucketedRateStatisticsTest, AveragesOverWholeBuckets) {
+  constexpr int64_t kBucketMs = 100;
+  BucketedRateStatistics stats(1000, kBpsScale, kBucketMs);
+  constexpr int64_t kPacketSize = 1000;
+  constexpr int64_t kIntervalMs = 10;
+  constexpr int64_t kExpectedRateBps = kPacketSize * 8 * 1000 / kIntervalMs;
+  for (int64_t now_ms = 0; now_ms < 5000; now_ms += kIntervalMs) {
+    stats.Update(kPacketSize, now_ms);
+    if (now_ms >= 1000) {
+      absl::optional<int64_t> rate = stats.Rate(now_ms);
+      ASSERT_TRUE(rate);
+      // The oldest bucket is partially outside the window, but the averaging
+      // window grows accordingly so that the rate is unbiased.
+      EXPECT_NEAR(*rate, kExpectedRateBps, kExpectedRateBps / 10);
+    }
+  }
+}
+
+TEST(BucketedRateStatisticsTest, RateUnavailableAfterDataLeavesWindow) {
+  BucketedRateStatistics stats(kWindowMs, kBpsScale, 10);
+  for (int64_t now_ms = 0; now_ms < 1000; now_ms += 10)
+    stats.Update(1000, now_ms);
+  EXPECT_GT(*stats.Rate(1000), 0);
+  EXPECT_FALSE(stats.Rate(1000 + kWindowMs + 10));
+
+  stats.Reset();
+  EXPECT_FALSE(stats.Rate(2000));
+  stats.Update(1000, 2000);
+  stats.Update(1000, 2001);
+  EXPECT_EQ(stats.Rate(2001), 2000 * 8000 / 2);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_CONTAINERS_UINT32_HASH_MAP_H_
+#define RTC_BASE_CONTAINERS_UINT32_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Uint32HashMap is a hash map with uint32_t keys, such as SSRCs, that keeps
+// its entries in a single contiguous array. It uses open addressing with
+// linear probing, so that a lookup usually touches one cache line, and does
+// no allocations as long as the number of entries doesn't grow.
+//
+// The interface is a subset of the one of std::unordered_map. Unlike
+// std::unordered_map:
+//  - Any insertion or removal invalidates all iterators and references.
+//  - erase(iterator) doesn't return an iterator, so entries can't be removed
+//    while iterating over the map.
+//  - The iteration order is unspecified and may change on any insertion or
+//    removal.
+template <typename Value>
+class Uint32HashMap {
+ public:
+  using key_type = uint32_t;
+  using mapped_type = Value;
+  using value_type = std::pair<uint32_t, Value>;
+  using size_type = size_t;
+
+ private:
+  using Slot = absl::optional<value_type>;
+
+  template <typename SlotT, typename T>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    IteratorImpl() = default;
+    // Allows conversion from iterator to const_iterator.
+    template <typename OtherSlotT,
+              typename OtherT,
+              typename = std::enable_if_t<
+                  std::is_convertible<OtherSlotT*, SlotT*>::value>>
+    IteratorImpl(const IteratorImpl<OtherSlotT, OtherT>& other)  // NOLINT
+        : slot_(other.slot_), end_(other.end_) {}
+
+    T& operator*() const { return **slot_; }
+    T* operator->() const { return &**slot_; }
+    IteratorImpl& operator++() {
+      ++slot_;
+      SkipEmpty();
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const IteratorImpl& lhs, const IteratorImpl& rhs) {
+      return lhs.slot_ == rhs.slot_;
+    }
+    friend bool operator!=(const IteratorImpl& lhs, const IteratorImpl& rhs) {
+      return lhs.slot_ != rhs.slot_;
+    }
+
+   private:
+    friend class Uint32HashMap;
+    template <typename, typename>
+    friend class IteratorImpl;
+
+    IteratorImpl(SlotT* slot, SlotT* end) : slot_(slot), end_(end) {}
+    void SkipEmpty() {
+      while (slot_ != end_ && !slot_->has_value())
+        ++slot_;
+    }
+
+    SlotT* slot_ = nullptr;
+    SlotT* end_ = nullptr;
+  };
+
+ public:
+  using iterator = IteratorImpl<Slot, value_type>;
+  using const_iterator = IteratorImpl<const Slot, const value_type>;
+
+  Uint32HashMap() = default;
+  Uint32HashMap(const Uint32HashMap&) = default;
+  Uint32HashMap(Uint32HashMap&& other) noexcept
+      : slots_(std::move(other.slots_)),
+        size_(std::exchange(other.size_, 0)),
+        shift_(other.shift_) {
+    other.slots_.clear();
+  }
+  Uint32HashMap& operator=(const Uint32HashMap&) = default;
+  Uint32HashMap& operator=(Uint32HashMap&& other) noexcept {
+    slots_ = std::move(other.slots_);
+    other.slots_.clear();
+    size_ = std::exchange(other.size_, 0);
+    shift_ = other.shift_;
+    return *this;
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  iterator begin() { return MakeIterator(0); }
+  const_iterator begin() const { return MakeIterator(0); }
+  iterator end() { return MakeIterator(slots_.size()); }
+  const_iterator end() const { return MakeIterator(slots_.size()); }
+
+  iterator find(uint32_t key) { return MakeIterator(FindSlot(key)); }
+  const_iterator find(uint32_t key) const {
+    return MakeIterator(FindSlot(key));
+  }
+  bool contains(uint32_t key) const { return FindSlot(key) != slots_.size(); }
+  size_t count(uint32_t key) const { return contains(key) ? 1 : 0; }
+
+  // Inserts an entry constructed from `args` unless `key` is already in the
+  // map. Returns the entry for `key` and whether it was inserted.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(uint32_t key, Args&&... args) {
+    size_t index = FindSlot(key);
+    if (index != slots_.size())
+      return {MakeIterator(index), false};
+    if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator)
+      Rehash(slots_.empty() ? kMinCapacity : 2 * slots_.size());
+    index = FindEmptySlot(key);
+    slots_[index].emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    ++size_;
+    return {MakeIterator(index), true};
+  }
+  std::pair<iterator, bool> insert(value_type value) {
+    return emplace(value.first, std::move(value.second));
+  }
+
+  Value& operator[](uint32_t key) { return emplace(key).first->second; }
+
+  size_t erase(uint32_t key) {
+    size_t index = FindSlot(key);
+    if (index == slots_.size())
+      return 0;
+    EraseSlot(index);
+    return 1;
+  }
+  void erase(const_iterator it) {
+    RTC_DCHECK(it.slot_ != nullptr && it.slot_->has_value());
+    EraseSlot(it.slot_ - slots_.data());
+  }
+
+  void clear() {
+    for (Slot& slot : slots_)
+      slot.reset();
+    size_ = 0;
+  }
+
+  // Makes room for `size` entries without further allocations.
+  void reserve(size_t size) {
+    size_t capacity = slots_.empty() ? kMinCapacity : slots_.size();
+    while (size * kMaxLoadDenominator > capacity * kMaxLoadNumerator)
+      capacity *= 2;
+    if (capacity > slots_.size())
+      Rehash(capacity);
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 8;
+  // The maximum fraction of the slots in use before the map grows.
+  static constexpr size_t kMaxLoadNumerator = 3;
+  static constexpr size_t kMaxLoadDenominator = 4;
+
+  iterator MakeIterator(size_t index) {
+    iterator it(slots_.data() + index, slots_.data() + slots_.size());
+    it.SkipEmpty();
+    return it;
+  }
+  const_iterator MakeIterator(size_t index) const {
+    const_iterator it(slots_.data() + index, slots_.data() + slots_.size());
+    it.SkipEmpty();
+    return it;
+  }
+
+  // Fibonacci hashing: the upper bits of the product are well distributed even
+  // when the keys are, e.g., consecutive or multiples of a power of two.
+  size_t IdealSlot(uint32_t key) const {
+    return static_cast<uint32_t>(key * 0x9E3779B9u) >> shift_;
+  }
+  size_t Mask() const { return slots_.size() - 1; }
+
+  // Returns the index of the entry for `key`, or slots_.size() if none.
+  size_t FindSlot(uint32_t key) const {
+    if (slots_.empty())
+      return 0;
+    for (size_t index = IdealSlot(key);; index = (index + 1) & Mask()) {
+      const Slot& slot = slots_[index];
+      if (!slot.has_value())
+        return slots_.size();
+      if (slot->first == key)
+        return index;
+    }
+  }
+
+  size_t FindEmptySlot(uint32_t key) const {
+    size_t index = IdealSlot(key);
+    while (slots_[index].has_value())
+      index = (index + 1) & Mask();
+    return index;
+  }
+
+  // Removes the entry at `index` and moves back the entries that follow it in
+  // the same probe sequence, so that lookups never need tombstones.
+  void EraseSlot(size_t index) {
+    slots_[index].reset();
+    --size_;
+    for (size_t next = (index + 1) & Mask(); slots_[next].has_value();
+         next = (next + 1) & Mask()) {
+      size_t ideal = IdealSlot(slots_[next]->first);
+      // The entry at `next` may move to the hole unless its ideal slot is
+      // between the hole and `next`.
+      if (((next - ideal) & Mask()) >= ((next - index) & Mask())) {
+        slots_[index] = std::move(slots_[next]);
+        slots_[next].reset();
+        index = next;
+      }
+    }
+  }
+
+  void Rehash(size_t capacity) {
+    RTC_DCHECK_GE(capacity, kMinCapacity);
+    RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+    std::vector<Slot> old_slots(capacity);
+    slots_.swap(old_slots);
+    shift_ = 32;
+    for (size_t c = capacity; c > 1; c /= 2)
+      --shift_;
+    for (Slot& slot : old_slots) {
+      if (slot.has_value())
+        slots_[FindEmptySlot(slot->first)] = std::move(slot);
+    }
+  }
+
+  // Either empty, or a power of two of at least kMinCapacity slots.
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  // 32 - log2(slots_.size()).
+  int shift_ = 32;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_CONTAINERS_UINT32_HASH_MAP_H_
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/containers/uint32_hash_map.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(Uint32HashMapTest, EmptyMap) {
+  Uint32HashMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0u);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(0), map.end());
+  EXPECT_FALSE(map.contains(0));
+  EXPECT_EQ(map.erase(0), 0u);
+}
+
+TEST(Uint32HashMapTest, EmplaceAndFind) {
+  Uint32HashMap<std::string> map;
+  auto inserted = map.emplace(0, "zero");
+  EXPECT_TRUE(inserted.second);
+  EXPECT_THAT(*inserted.first, Pair(0u, "zero"));
+  inserted = map.emplace(0xFFFFFFFF, "max");
+  EXPECT_TRUE(inserted.second);
+
+  inserted = map.emplace(0, "other");
+  EXPECT_FALSE(inserted.second);
+  EXPECT_EQ(inserted.first->second, "zero");
+
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.find(0)->second, "zero");
+  EXPECT_EQ(map.find(0xFFFFFFFF)->second, "max");
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.count(0xFFFFFFFF), 1u);
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(0u, "zero"),
+                                        Pair(0xFFFFFFFFu, "max")));
+}
+
+TEST(Uint32HashMapTest, SubscriptOperatorValueInitializes) {
+  Uint32HashMap<int*> map;
+  EXPECT_EQ(map[17], nullptr);
+  int value = 0;
+  map[17] = &value;
+  EXPECT_EQ(map[17], &value);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(Uint32HashMapTest, HoldsMoveOnlyValues) {
+  Uint32HashMap<std::unique_ptr<int>> map;
+  map.emplace(1, std::make_unique<int>(1));
+  map[2] = std::make_unique<int>(2);
+  Uint32HashMap<std::unique_ptr<int>> moved = std::move(map);
+  EXPECT_EQ(*moved.find(1)->second, 1);
+  EXPECT_EQ(*moved.find(2)->second, 2);
+}
+
+TEST(Uint32HashMapTest, EraseByIterator) {
+  Uint32HashMap<int> map;
+  map[1] = 1;
+  map[2] = 2;
+  map.erase(map.find(1));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(2u, 2)));
+}
+
+TEST(Uint32HashMapTest, ClearKeepsMapUsable) {
+  Uint32HashMap<int> map;
+  for (uint32_t key = 0; key < 100; ++key)
+    map[key] = key;
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  map[5] = 5;
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(5u, 5)));
+}
+
+// Keys that are multiples of a large power of two collide in the lower bits
+// and produce long probe sequences, which makes erase move entries around.
+TEST(Uint32HashMapTest, MatchesStdMapUnderRandomOperations) {
+  Random random(4711);
+  Uint32HashMap<uint32_t> map;
+  std::map<uint32_t, uint32_t> reference;
+  for (int i = 0; i < 20000; ++i) {
+    uint32_t key = random.Rand(0, 63) << (random.Rand(0, 1) ? 26 : 0);
+    switch (random.Rand(0, 2)) {
+      case 0:
+        EXPECT_EQ(map.emplace(key, i).second,
+                  reference.emplace(key, i).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), reference.erase(key));
+        break;
+      case 2:
+        map[key] = i;
+        reference[key] = i;
+        break;
+    }
+    ASSERT_EQ(map.size(), reference.size());
+  }
+  for (const auto& kv : reference) {
+    auto it = map.find(kv.first);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, kv.second);
+  }
+  size_t num_iterated = 0;
+  for (const auto& kv : map) {
+    EXPECT_EQ(reference[kv.first], kv.second);
+    ++num_iterated;
+  }
+  EXPECT_EQ(num_iterated, reference.size());
+}
+
+TEST(Uint32HashMapTest, ReserveKeepsEntries) {
+  Uint32HashMap<int> map;
+  map[3] = 3;
+  map.reserve(1000);
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(3u, 3)));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -12,8 +12,27 @@
 
 #include <stddef.h>
 
+#include <new>
+
 namespace rtc {
 
+scoped_refptr<CopyOnWriteBuffer::Storage> CopyOnWriteBuffer::Storage::Create(
+    size_t size,
+    size_t capacity) {
+  capacity = std::max(size, capacity);
+  void* memory = ::operator new(sizeof(Storage) + capacity);
+  return scoped_refptr<Storage>(new (memory) Storage(size, capacity));
+}
+
+RefCountReleaseStatus CopyOnWriteBuffer::Storage::Release() const {
+  const auto status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    this->~Storage();
+    ::operator delete(const_cast<Storage*>(this));
+  }
+  return status;
+}
+
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
 }
@@ -32,14 +51,14 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(const std::string& s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedBuffer(size) : nullptr),
+    : buffer_(size > 0 ? Storage::Create(size, size) : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
-    : buffer_(size > 0 || capacity > 0 ? new RefCountedBuffer(size, capacity)
+    : buffer_(size > 0 || capacity > 0 ? Storage::Create(size, capacity)
                                        : nullptr),
       offset_(0),
       size_(size) {
@@ -60,7 +79,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (size > 0) {
-      buffer_ = new RefCountedBuffer(size);
+      buffer_ = Storage::Create(size, size);
       offset_ = 0;
       size_ = size;
     }
@@ -74,7 +93,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   }
 
   UnshareAndEnsureCapacity(std::max(capacity(), size));
-  buffer_->SetSize(size + offset_);
+  buffer_->set_size(size + offset_);
   size_ = size;
   RTC_DCHECK(IsConsistent());
 }
@@ -83,7 +102,7 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (new_capacity > 0) {
-      buffer_ = new RefCountedBuffer(0, new_capacity);
+      buffer_ = Storage::Create(0, new_capacity);
       offset_ = 0;
       size_ = 0;
     }
@@ -102,9 +121,9 @@ void CopyOnWriteBuffer::Clear() {
     return;
 
   if (buffer_->HasOneRef()) {
-    buffer_->Clear();
+    buffer_->set_size(0);
   } else {
-    buffer_ = new RefCountedBuffer(0, capacity());
+    buffer_ = Storage::Create(0, capacity());
   }
   offset_ = 0;
   size_ = 0;
@@ -116,8 +135,7 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
-  buffer_ =
-      new RefCountedBuffer(buffer_->data() + offset_, size_, new_capacity);
+  buffer_ = Storage::Create(buffer_->data() + offset_, size_, new_capacity);
   offset_ = 0;
   RTC_DCHECK(IsConsistent());
 }
@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <type_traits>
@@ -22,7 +23,8 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
-#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counter.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/type_traits.h"
 
@@ -104,7 +106,7 @@ class RTC_EXPORT CopyOnWriteBuffer {
       return nullptr;
     }
     UnshareAndEnsureCapacity(capacity());
-    return buffer_->data<T>() + offset_;
+    return reinterpret_cast<T*>(buffer_->data() + offset_);
   }
 
   // Get const pointer to the data. This will not create a copy of the
@@ -117,7 +119,7 @@ class RTC_EXPORT CopyOnWriteBuffer {
     if (!buffer_) {
       return nullptr;
     }
-    return buffer_->data<T>() + offset_;
+    return reinterpret_cast<const T*>(buffer_->data() + offset_);
   }
 
   size_t size() const {
@@ -171,11 +173,17 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void SetData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = size > 0 ? new RefCountedBuffer(data, size) : nullptr;
+      buffer_ = size > 0 ? Storage::Create(data, size, size) : nullptr;
     } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedBuffer(data, size, capacity());
+      buffer_ = Storage::Create(data, size, capacity());
+    } else if (size > buffer_->capacity()) {
+      // Grow like rtc::Buffer does, to avoid quadratic behavior.
+      buffer_ = Storage::Create(
+          data, size, std::max(size, buffer_->capacity() * 3 / 2));
     } else {
-      buffer_->SetData(data, size);
+      if (size > 0)
+        std::memcpy(buffer_->data(), data, size);
+      buffer_->set_size(size);
     }
     offset_ = 0;
     size_ = size;
@@ -208,7 +216,7 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void AppendData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = new RefCountedBuffer(data, size);
+      buffer_ = Storage::Create(data, size, size);
       offset_ = 0;
       size_ = size;
       RTC_DCHECK(IsConsistent());
@@ -217,10 +225,11 @@ class RTC_EXPORT CopyOnWriteBuffer {
 
     UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
 
-    buffer_->SetSize(offset_ +
-                     size_);  // Remove data to the right of the slice.
-    buffer_->AppendData(data, size);
+    // Overwrites the data to the right of the slice.
+    if (size > 0)
+      std::memcpy(buffer_->data() + offset_ + size_, data, size);
     size_ += size;
+    buffer_->set_size(offset_ + size_);
 
     RTC_DCHECK(IsConsistent());
   }
@@ -258,6 +267,10 @@ class RTC_EXPORT CopyOnWriteBuffer {
   // buffer has been moved from.
   void Clear();
 
+  // Returns true if this buffer holds storage that no other CopyOnWriteBuffer
+  // references, i.e. writing to it will not trigger a copy.
+  bool IsUniquelyOwned() const { return buffer_ && buffer_->HasOneRef(); }
+
   // Swaps two buffers.
   friend void swap(CopyOnWriteBuffer& a, CopyOnWriteBuffer& b) {
     a.buffer_.swap(b.buffer_);
@@ -275,7 +288,54 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  // Reference counted bytes. The header and the bytes are allocated together,
+  // so that a buffer costs a single heap allocation.
+  class alignas(std::max_align_t) Storage {
+   public:
+    // Returns storage for `capacity` bytes, or for `size` bytes if `capacity`
+    // is smaller, of which the first `size` bytes are in use.
+    static scoped_refptr<Storage> Create(size_t size, size_t capacity);
+    // Same as above, with the first `size` bytes copied from `data`.
+    template <typename T>
+    static scoped_refptr<Storage> Create(const T* data,
+                                         size_t size,
+                                         size_t capacity) {
+      scoped_refptr<Storage> storage = Create(size, capacity);
+      if (size > 0)
+        std::memcpy(storage->data(), data, size);
+      return storage;
+    }
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+    // The bytes follow the header in the same allocation.
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+    const uint8_t* data() const {
+      return reinterpret_cast<const uint8_t*>(this + 1);
+    }
+    // The number of bytes written, i.e. the end of the longest slice.
+    size_t size() const { return size_; }
+    void set_size(size_t size) {
+      RTC_DCHECK_LE(size, capacity_);
+      size_ = size;
+    }
+    size_t capacity() const { return capacity_; }
+
+   private:
+    Storage(size_t size, size_t capacity)
+        : size_(size), capacity_(capacity) {}
+    ~Storage() = default;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    size_t size_;
+    const size_t capacity_;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -290,8 +350,8 @@ class RTC_EXPORT CopyOnWriteBuffer {
     }
   }
 
-  // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
-  scoped_refptr<RefCountedBuffer> buffer_;
+  // buffer_ is either null, or points to storage with capacity > 0.
+  scoped_refptr<Storage> buffer_;
   // This buffer may represent a slice of a original data.
   size_t offset_;  // Offset of a current slice in the original data in buffer_.
                    // Should be 0 if the buffer_ is empty.
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kNumBuffers = 1000;
+
+// Creates `kNumBuffers` buffers of `state.range(0)` bytes, e.g. one per
+// received RTP packet, and destroys them again.
+void BM_CopyOnWriteBufferCreate(benchmark::State& state) {
+  const std::vector<uint8_t> data(state.range(0), 0x17);
+  std::vector<CopyOnWriteBuffer> buffers(kNumBuffers);
+  for (auto s : state) {
+    for (CopyOnWriteBuffer& buffer : buffers)
+      buffer = CopyOnWriteBuffer(data.data(), data.size());
+    benchmark::DoNotOptimize(buffers.data());
+    for (CopyOnWriteBuffer& buffer : buffers)
+      buffer.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumBuffers);
+}
+
+// Copies a shared buffer of `state.range(0)` bytes and writes to each copy, so
+// that every copy allocates its own storage.
+void BM_CopyOnWriteBufferUnshare(benchmark::State& state) {
+  const CopyOnWriteBuffer original(state.range(0), state.range(0));
+  std::vector<CopyOnWriteBuffer> buffers(kNumBuffers);
+  for (auto s : state) {
+    for (CopyOnWriteBuffer& buffer : buffers) {
+      buffer = original;
+      buffer.MutableData()[0] = 1;
+    }
+    benchmark::DoNotOptimize(buffers.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumBuffers);
+}
+
+BENCHMARK(BM_CopyOnWriteBufferCreate)->Arg(16)->Arg(200)->Arg(1200);
+BENCHMARK(BM_CopyOnWriteBufferUnshare)->Arg(16)->Arg(200)->Arg(1200);
+
+}  // namespace
+}  // namespace rtc
+
+/*
+
+Results:
+
+Medians of 5 repetitions, time per 1000 buffers.
+---------------------------------------------------------------------
+Benchmark                               Before        After
+---------------------------------------------------------------------
+BM_CopyOnWriteBufferCreate/16           39300 ns      30316 ns
+BM_CopyOnWriteBufferCreate/200          45296 ns      35549 ns
+BM_CopyOnWriteBufferCreate/1200         75942 ns      62287 ns
+BM_CopyOnWriteBufferUnshare/16          48452 ns      43333 ns
+BM_CopyOnWriteBufferUnshare/200         59564 ns      47922 ns
+BM_CopyOnWriteBufferUnshare/1200        80192 ns      84451 ns
+
+"Before" allocates the rtc::Buffer object and its bytes separately, "After"
+allocates the reference count, the size and the bytes at once.
+
+*/
@@ -14,9 +14,13 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/base/attributes.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
@@ -82,10 +86,147 @@ namespace {
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
 
+// The trace event macros support at most two arguments per event.
+constexpr int kMaxTraceArgs = 2;
+// Each thread that adds trace events gets a buffer that holds this many
+// events. It is drained every `kLoggingIntervalMs`, events that don't fit are
+// dropped.
+constexpr size_t kEventsPerThread = 2048;
+// Number of distinct categories the tracer can track. The categories that
+// don't fit are never captured.
+constexpr int kMaxCategories = 128;
+
+static const char* const kDisabledTracePrefix = TRACE_DISABLED_BY_DEFAULT("");
+
+bool IsDisabledByDefault(const char* name) {
+  const char* prefix_ptr = &kDisabledTracePrefix[0];
+  const char* name_ptr = name;
+  // Check whether name contains the default-disabled prefix.
+  while (*prefix_ptr == *name_ptr && *prefix_ptr != '\0') {
+    ++prefix_ptr;
+    ++name_ptr;
+  }
+  return *prefix_ptr == '\0';
+}
+
+// Returns true if `name` is one of the comma separated `categories`.
+bool IsInList(const std::string& categories, const char* name) {
+  size_t name_length = strlen(name);
+  size_t start = 0;
+  while (start <= categories.size()) {
+    size_t end = categories.find(',', start);
+    if (end == std::string::npos)
+      end = categories.size();
+    if (end - start == name_length &&
+        categories.compare(start, name_length, name) == 0) {
+      return true;
+    }
+    start = end + 1;
+  }
+  return false;
+}
+
+// Categories handed out by InternalGetCategoryEnabled(). The trace event
+// macros cache the returned pointer per call site and check the byte it
+// points to before every event, so a category that isn't captured costs a
+// single load. The bytes are only non-zero while a capture is running, and
+// then only for the categories selected by SetInternalCaptureCategories().
+//
+// Entries are never removed, so the pointers stay valid for the lifetime of
+// the process. Lookups don't take the lock, since with
+// WEBRTC_NON_STATIC_TRACE_EVENT_HANDLERS they are done for every event.
+class CategoryTable {
+ public:
+  struct Category {
+    // Must be the first member, pointers to it are converted back to
+    // Category pointers.
+    unsigned char enabled;
+    const char* name;
+  };
+
+  static CategoryTable& Get() {
+    static CategoryTable& table = *new CategoryTable();
+    return table;
+  }
+
+  static const Category* FromEnabledPtr(const unsigned char* enabled) {
+    return reinterpret_cast<const Category*>(enabled);
+  }
+
+  const unsigned char* GetEnabledPtr(const char* name) {
+    int size = size_.load(std::memory_order_acquire);
+    if (Category* category = Find(name, 0, size))
+      return &category->enabled;
+    webrtc::MutexLock lock(&mutex_);
+    // Another thread may have added it in the meantime.
+    int new_size = size_.load(std::memory_order_relaxed);
+    if (Category* category = Find(name, size, new_size))
+      return &category->enabled;
+    if (new_size == kMaxCategories) {
+      RTC_LOG(LS_WARNING) << "Too many trace categories, '" << name
+                          << "' won't be captured.";
+      return &disabled_;
+    }
+    Category& category = categories_[new_size];
+    category.name = name;
+    category.enabled = IsCapturedLocked(name) ? 1 : 0;
+    size_.store(new_size + 1, std::memory_order_release);
+    return &category.enabled;
+  }
+
+  void SetCategories(const char* categories) {
+    webrtc::MutexLock lock(&mutex_);
+    categories_filter_ = categories ? categories : "";
+    UpdateEnabledLocked();
+  }
+
+  void SetCapturing(bool capturing) {
+    webrtc::MutexLock lock(&mutex_);
+    capturing_ = capturing;
+    UpdateEnabledLocked();
+  }
+
+ private:
+  Category* Find(const char* name, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      if (categories_[i].name == name || strcmp(categories_[i].name, name) == 0)
+        return &categories_[i];
+    }
+    return nullptr;
+  }
+
+  bool IsCapturedLocked(const char* name) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (!capturing_)
+      return false;
+    if (categories_filter_.empty())
+      return !IsDisabledByDefault(name);
+    return IsInList(categories_filter_, name);
+  }
+
+  void UpdateEnabledLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    int size = size_.load(std::memory_order_relaxed);
+    for (int i = 0; i < size; ++i) {
+      categories_[i].enabled = IsCapturedLocked(categories_[i].name) ? 1 : 0;
+    }
+  }
+
+  webrtc::Mutex mutex_;
+  Category categories_[kMaxCategories] = {};
+  std::atomic<int> size_{0};
+  const unsigned char disabled_ = 0;
+  bool capturing_ RTC_GUARDED_BY(mutex_) = false;
+  std::string categories_filter_ RTC_GUARDED_BY(mutex_);
+};
+
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
  public:
-  ~EventLogger() { RTC_DCHECK(thread_checker_.IsCurrent()); }
+  EventLogger() : id_(next_id_.fetch_add(1) + 1) {}
+  ~EventLogger() {
+    RTC_DCHECK(thread_checker_.IsCurrent());
+    for (auto& buffer : thread_buffers_)
+      buffer->Drain([](TraceEvent& e) { FreeCopiedStrings(e); });
+  }
 
   void AddTraceEvent(const char* name,
                      const unsigned char* category_enabled,
@@ -94,12 +235,16 @@ class EventLogger final {
                      const char** arg_names,
                      const unsigned char* arg_types,
                      const unsigned long long* arg_values,
-                     uint64_t timestamp,
-                     int pid,
-                     rtc::PlatformThreadId thread_id) {
-    std::vector<TraceArg> args(num_args);
-    for (int i = 0; i < num_args; ++i) {
-      TraceArg& arg = args[i];
+                     uint64_t timestamp) {
+    RTC_DCHECK_LE(num_args, kMaxTraceArgs);
+    TraceEvent event;
+    event.name = name;
+    event.category = CategoryTable::FromEnabledPtr(category_enabled);
+    event.phase = phase;
+    event.num_args = std::min(num_args, kMaxTraceArgs);
+    event.timestamp = timestamp;
+    for (int i = 0; i < event.num_args; ++i) {
+      TraceArg& arg = event.args[i];
       arg.name = arg_names[i];
       arg.type = arg_types[i];
       arg.value.as_uint = arg_values[i];
@@ -113,9 +258,8 @@ class EventLogger final {
         arg.value.as_string = str_copy;
       }
     }
-    webrtc::MutexLock lock(&mutex_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, args, timestamp, 1, thread_id});
+    if (!GetThreadBuffer()->Push(event))
+      FreeCopiedStrings(event);
   }
 
   // The TraceEvent format is documented here:
@@ -125,53 +269,54 @@ class EventLogger final {
     static const int kLoggingIntervalMs = 100;
     fprintf(output_file_, "{ \"traceEvents\": [\n");
     bool has_logged_event = false;
+    std::vector<ThreadBuffer*> buffers;
+    std::vector<TraceEvent> events;
+    std::string args_str;
+    args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
     while (true) {
       bool shutting_down = shutdown_event_.Wait(kLoggingIntervalMs);
-      std::vector<TraceEvent> events;
       {
+        // Buffers are only ever added while the logger is alive.
         webrtc::MutexLock lock(&mutex_);
-        trace_events_.swap(events);
+        for (size_t i = buffers.size(); i < thread_buffers_.size(); ++i)
+          buffers.push_back(thread_buffers_[i].get());
       }
-      std::string args_str;
-      args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
-      for (TraceEvent& e : events) {
-        args_str.clear();
-        if (!e.args.empty()) {
-          args_str += ", \"args\": {";
-          bool is_first_argument = true;
-          for (TraceArg& arg : e.args) {
-            if (!is_first_argument)
-              args_str += ",";
-            is_first_argument = false;
-            args_str += " \"";
-            args_str += arg.name;
-            args_str += "\": ";
-            args_str += TraceArgValueAsString(arg);
-
-            // Delete our copy of the string.
-            if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-              delete[] arg.value.as_string;
-              arg.value.as_string = nullptr;
+      for (ThreadBuffer* buffer : buffers) {
+        events.clear();
+        buffer->Drain([&events](TraceEvent& e) { events.push_back(e); });
+        for (TraceEvent& e : events) {
+          args_str.clear();
+          if (e.num_args > 0) {
+            args_str += ", \"args\": {";
+            for (int i = 0; i < e.num_args; ++i) {
+              if (i > 0)
+                args_str += ",";
+              args_str += " \"";
+              args_str += e.args[i].name;
+              args_str += "\": ";
+              args_str += TraceArgValueAsString(e.args[i]);
             }
+            args_str += " }";
           }
-          args_str += " }";
-        }
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
+          FreeCopiedStrings(e);
+          fprintf(output_file_,
+                  "%s{ \"name\": \"%s\""
+                  ", \"cat\": \"%s\""
+                  ", \"ph\": \"%c\""
+                  ", \"ts\": %" PRIu64
+                  ", \"pid\": %d"
 #if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
+                  ", \"tid\": %lu"
 #else
-                ", \"tid\": %d"
+                  ", \"tid\": %d"
 #endif  // defined(WEBRTC_WIN)
-                "%s"
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
-        has_logged_event = true;
+                  "%s"
+                  "}\n",
+                  has_logged_event ? "," : " ", e.name, e.category->name,
+                  e.phase, e.timestamp, 1, buffer->thread_id(),
+                  args_str.c_str());
+          has_logged_event = true;
+        }
       }
       if (shutting_down)
         break;
@@ -190,16 +335,21 @@ class EventLogger final {
     output_file_owned_ = owned;
     {
       webrtc::MutexLock lock(&mutex_);
-      // Since the atomic fast-path for adding events to the queue can be
-      // bypassed while the logging thread is shutting down there may be some
-      // stale events in the queue, hence the vector needs to be cleared to not
-      // log events from a previous logging session (which may be days old).
-      trace_events_.clear();
+      // Since the atomic fast-path for adding events can be bypassed while
+      // the logging thread is shutting down there may be some stale events
+      // in the buffers, hence they need to be cleared to not log events from
+      // a previous logging session (which may be days old). The logging
+      // thread isn't running, so this thread is the only reader.
+      for (auto& buffer : thread_buffers_) {
+        buffer->Drain([](TraceEvent& e) { FreeCopiedStrings(e); });
+        buffer->TakeDroppedCount();
+      }
     }
     // Enable event logging (fast-path). This should be disabled since starting
     // shouldn't be done twice.
     RTC_CHECK_EQ(0,
                  rtc::AtomicOps::CompareAndSwap(&g_event_logging_active, 0, 1));
+    CategoryTable::Get().SetCapturing(true);
 
     // Finally start, everything should be set up now.
     logging_thread_ =
@@ -213,11 +363,24 @@ class EventLogger final {
     // Try to stop. Abort if we're not currently logging.
     if (rtc::AtomicOps::CompareAndSwap(&g_event_logging_active, 1, 0) == 0)
       return;
+    CategoryTable::Get().SetCapturing(false);
 
     // Wake up logging thread to finish writing.
     shutdown_event_.Set();
     // Join the logging thread.
     logging_thread_.Finalize();
+
+    uint64_t dropped = 0;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      for (auto& buffer : thread_buffers_)
+        dropped += buffer->TakeDroppedCount();
+    }
+    if (dropped > 0) {
+      RTC_LOG(LS_WARNING) << "Dropped " << dropped
+                          << " trace events because the per thread buffers "
+                             "were full.";
+    }
   }
 
  private:
@@ -241,16 +404,88 @@ class EventLogger final {
                   "the uint field of that union.");
   };
 
+  // Fixed size, so that it can be stored in the per thread ring buffers
+  // without allocations.
   struct TraceEvent {
     const char* name;
-    const unsigned char* category_enabled;
-    char phase;
-    std::vector<TraceArg> args;
+    const CategoryTable::Category* category;
     uint64_t timestamp;
-    int pid;
-    rtc::PlatformThreadId tid;
+    char phase;
+    int num_args;
+    TraceArg args[kMaxTraceArgs];
+  };
+
+  // Single producer, single consumer ring buffer. Only the thread it belongs
+  // to adds events, only the logging thread (or Start() while that isn't
+  // running) removes them.
+  class ThreadBuffer {
+   public:
+    explicit ThreadBuffer(rtc::PlatformThreadId thread_id)
+        : thread_id_(thread_id) {}
+
+    rtc::PlatformThreadId thread_id() const { return thread_id_; }
+
+    // Returns false and drops `event` if the buffer is full.
+    bool Push(const TraceEvent& event) {
+      uint64_t write = write_index_.load(std::memory_order_relaxed);
+      if (write - read_index_.load(std::memory_order_acquire) ==
+          kEventsPerThread) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      events_[write % kEventsPerThread] = event;
+      write_index_.store(write + 1, std::memory_order_release);
+      return true;
+    }
+
+    template <typename Callback>
+    void Drain(Callback callback) {
+      uint64_t read = read_index_.load(std::memory_order_relaxed);
+      uint64_t write = write_index_.load(std::memory_order_acquire);
+      for (; read != write; ++read)
+        callback(events_[read % kEventsPerThread]);
+      read_index_.store(write, std::memory_order_release);
+    }
+
+    uint64_t TakeDroppedCount() {
+      return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+   private:
+    const rtc::PlatformThreadId thread_id_;
+    std::atomic<uint64_t> write_index_{0};
+    std::atomic<uint64_t> read_index_{0};
+    std::atomic<uint64_t> dropped_{0};
+    TraceEvent events_[kEventsPerThread];
   };
 
+  static void FreeCopiedStrings(TraceEvent& event) {
+    for (int i = 0; i < event.num_args; ++i) {
+      TraceArg& arg = event.args[i];
+      if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+        delete[] arg.value.as_string;
+        arg.value.as_string = nullptr;
+      }
+    }
+  }
+
+  ThreadBuffer* GetThreadBuffer() {
+    // Identifies the logger by id rather than by address, since a new logger
+    // may be allocated where a deleted one was.
+    struct CurrentBuffer {
+      int logger_id;
+      ThreadBuffer* buffer;
+    };
+    ABSL_CONST_INIT thread_local CurrentBuffer current = {0, nullptr};
+    if (current.logger_id != id_) {
+      auto buffer = std::make_unique<ThreadBuffer>(rtc::CurrentThreadId());
+      current = {id_, buffer.get()};
+      webrtc::MutexLock lock(&mutex_);
+      thread_buffers_.push_back(std::move(buffer));
+    }
+    return current.buffer;
+  }
+
   static std::string TraceArgValueAsString(TraceArg arg) {
     std::string output;
 
@@ -311,8 +546,12 @@ class EventLogger final {
     return output;
   }
 
+  static std::atomic<int> next_id_;
+
+  const int id_;
   webrtc::Mutex mutex_;
-  std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(mutex_);
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_
+      RTC_GUARDED_BY(mutex_);
   rtc::PlatformThread logging_thread_;
   rtc::Event shutdown_event_;
   webrtc::SequenceChecker thread_checker_;
@@ -320,18 +559,11 @@ class EventLogger final {
   bool output_file_owned_ = false;
 };
 
+std::atomic<int> EventLogger::next_id_{0};
+
 static EventLogger* volatile g_event_logger = nullptr;
-static const char* const kDisabledTracePrefix = TRACE_DISABLED_BY_DEFAULT("");
 const unsigned char* InternalGetCategoryEnabled(const char* name) {
-  const char* prefix_ptr = &kDisabledTracePrefix[0];
-  const char* name_ptr = name;
-  // Check whether name contains the default-disabled prefix.
-  while (*prefix_ptr == *name_ptr && *prefix_ptr != '\0') {
-    ++prefix_ptr;
-    ++name_ptr;
-  }
-  return reinterpret_cast<const unsigned char*>(*prefix_ptr == '\0' ? ""
-                                                                    : name);
+  return CategoryTable::Get().GetEnabledPtr(name);
 }
 
 void InternalAddTraceEvent(char phase,
@@ -349,7 +581,7 @@ void InternalAddTraceEvent(char phase,
 
   g_event_logger->AddTraceEvent(name, category_enabled, phase, num_args,
                                 arg_names, arg_types, arg_values,
-                                rtc::TimeMicros(), 1, rtc::CurrentThreadId());
+                                rtc::TimeMicros());
 }
 
 }  // namespace
@@ -361,6 +593,10 @@ void SetupInternalTracer() {
   webrtc::SetupEventTracer(InternalGetCategoryEnabled, InternalAddTraceEvent);
 }
 
+void SetInternalCaptureCategories(const char* categories) {
+  CategoryTable::Get().SetCategories(categories);
+}
+
 void StartInternalCaptureToFile(FILE* file) {
   if (g_event_logger) {
     g_event_logger->Start(file, false);
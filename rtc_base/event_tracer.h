@@ -73,6 +73,11 @@ namespace rtc {
 namespace tracing {
 // Set up internal event tracer.
 RTC_EXPORT void SetupInternalTracer();
+// Restricts the captured events to the categories in the comma separated list
+// `categories`. If the list is empty, which is the default, all categories
+// except the disabled by default ones are captured. Takes effect immediately,
+// also for a capture that is already running.
+RTC_EXPORT void SetInternalCaptureCategories(const char* categories);
 RTC_EXPORT bool StartInternalCapture(const char* filename);
 RTC_EXPORT void StartInternalCaptureToFile(FILE* file);
 RTC_EXPORT void StopInternalCapture();
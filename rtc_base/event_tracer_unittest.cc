@@ -10,6 +10,11 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/trace_event.h"
@@ -76,6 +81,48 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   EXPECT_EQ(2, TestStatistics::Get()->Count());
   TestStatistics::Get()->Reset();
 }
+
+TEST(EventTracerTest, InternalTracerCapturesSelectedCategoriesOfAllThreads) {
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file);
+  rtc::tracing::SetupInternalTracer();
+  rtc::tracing::SetInternalCaptureCategories("test_captured,test_other");
+  rtc::tracing::StartInternalCaptureToFile(file);
+  rtc::PlatformThread::SpawnJoinable(
+      [] {
+        TRACE_EVENT_INSTANT1("test_captured", "OtherThreadEvent", "value", 42);
+        TRACE_EVENT_INSTANT0("test_ignored", "IgnoredEvent");
+      },
+      "TraceThread")
+      .Finalize();
+  TRACE_EVENT_INSTANT0("test_other", "MainThreadEvent");
+  rtc::tracing::StopInternalCapture();
+  // Not captured, since the capture is stopped.
+  TRACE_EVENT_INSTANT0("test_captured", "EventAfterStop");
+  rtc::tracing::SetInternalCaptureCategories("");
+  rtc::tracing::ShutdownInternalTracer();
+
+  std::string trace;
+  rewind(file);
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    trace.append(buffer, read);
+  fclose(file);
+
+  EXPECT_NE(trace.find("\"name\": \"OtherThreadEvent\", "
+                       "\"cat\": \"test_captured\""),
+            std::string::npos)
+      << trace;
+  EXPECT_NE(trace.find("\"args\": { \"value\": 42 }"), std::string::npos)
+      << trace;
+  EXPECT_NE(trace.find("\"name\": \"MainThreadEvent\""), std::string::npos)
+      << trace;
+  EXPECT_EQ(trace.find("IgnoredEvent"), std::string::npos) << trace;
+  EXPECT_EQ(trace.find("EventAfterStop"), std::string::npos) << trace;
+  // The "webrtc" category isn't selected.
+  EXPECT_EQ(trace.find("EventLogger::Start"), std::string::npos) << trace;
+}
 #endif
 
 }  // namespace webrtc
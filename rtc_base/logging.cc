@@ -39,6 +39,9 @@ static const int kMaxLogLineSize = 1024 - 60;
 
 #include <algorithm>
 #include <cstdarg>
+#include <iterator>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/base/attributes.h"
@@ -80,6 +83,127 @@ webrtc::Mutex& GetLoggingLock() {
   return mutex;
 }
 
+// Messages a thread can buffer while asynchronous dispatch is enabled. Further
+// messages are dropped until the buffer is drained.
+constexpr size_t kMaxBufferedMessagesPerThread = 10000;
+
+using DispatchFunction = void (*)(const std::string& msg,
+                                  LoggingSeverity severity,
+                                  const char* tag);
+
+// Buffers the messages of all threads while asynchronous dispatch is enabled,
+// until they are drained to LogMessage::Dispatch. Each thread appends to a
+// buffer of its own, so logging threads only contend with the draining
+// thread, and only while it empties their buffer.
+class AsyncDispatcher {
+ public:
+  static AsyncDispatcher& Get() {
+    // Leaked, since threads may log while the process exits.
+    static AsyncDispatcher& dispatcher = *new AsyncDispatcher();
+    return dispatcher;
+  }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  void Append(LoggingSeverity severity, std::string msg, const char* tag) {
+    Buffer* buffer = GetThreadBuffer();
+    webrtc::MutexLock lock(&buffer->mutex);
+    if (buffer->entries.size() >= kMaxBufferedMessagesPerThread) {
+      ++buffer->dropped;
+      return;
+    }
+    buffer->entries.push_back(
+        {next_sequence_number_.fetch_add(1, std::memory_order_relaxed),
+         severity, tag, std::move(msg)});
+  }
+
+  // Dispatches all buffered messages, in the order they were logged.
+  void Drain(DispatchFunction dispatch) {
+    webrtc::MutexLock drain_lock(&drain_mutex_);
+    std::vector<Entry> entries;
+    size_t dropped = 0;
+    {
+      webrtc::MutexLock lock(&buffers_mutex_);
+      for (auto it = buffers_.begin(); it != buffers_.end();) {
+        Buffer& buffer = **it;
+        bool thread_exited;
+        {
+          webrtc::MutexLock buffer_lock(&buffer.mutex);
+          std::move(buffer.entries.begin(), buffer.entries.end(),
+                    std::back_inserter(entries));
+          buffer.entries.clear();
+          dropped += buffer.dropped;
+          buffer.dropped = 0;
+          thread_exited = buffer.thread_exited;
+        }
+        it = thread_exited ? buffers_.erase(it) : it + 1;
+      }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) {
+                return a.sequence_number < b.sequence_number;
+              });
+    for (const Entry& entry : entries)
+      dispatch(entry.msg, entry.severity, entry.tag);
+    if (dropped > 0) {
+      RTC_LOG(LS_WARNING) << "Dropped " << dropped
+                          << " log messages logged faster than they were "
+                             "dispatched.";
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t sequence_number;
+    LoggingSeverity severity;
+    const char* tag;
+    std::string msg;
+  };
+
+  struct Buffer {
+    webrtc::Mutex mutex;
+    std::vector<Entry> entries RTC_GUARDED_BY(mutex);
+    size_t dropped RTC_GUARDED_BY(mutex) = 0;
+    // Set when the thread owning the buffer exits, after which the buffer is
+    // deleted by the next Drain().
+    bool thread_exited RTC_GUARDED_BY(mutex) = false;
+  };
+
+  // Marks the buffer of a thread for deletion when the thread exits.
+  struct ThreadBufferHolder {
+    ~ThreadBufferHolder() {
+      if (buffer) {
+        webrtc::MutexLock lock(&buffer->mutex);
+        buffer->thread_exited = true;
+      }
+    }
+    Buffer* buffer = nullptr;
+  };
+
+  AsyncDispatcher() = default;
+
+  Buffer* GetThreadBuffer() {
+    static thread_local ThreadBufferHolder holder;
+    if (!holder.buffer) {
+      auto buffer = std::make_unique<Buffer>();
+      holder.buffer = buffer.get();
+      webrtc::MutexLock lock(&buffers_mutex_);
+      buffers_.push_back(std::move(buffer));
+    }
+    return holder.buffer;
+  }
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> next_sequence_number_{0};
+  // Keeps messages in order when two threads drain at the same time.
+  webrtc::Mutex drain_mutex_;
+  webrtc::Mutex buffers_mutex_;
+  std::vector<std::unique_ptr<Buffer>> buffers_ RTC_GUARDED_BY(buffers_mutex_);
+};
+
 }  // namespace
 
 /////////////////////////////////////////////////////////////////////////////
@@ -195,23 +319,39 @@ LogMessage::LogMessage(const char* file,
 LogMessage::~LogMessage() {
   FinishPrintStream();
 
-  const std::string str = print_stream_.Release();
+  std::string str = print_stream_.Release();
+#if defined(WEBRTC_ANDROID)
+  const char* tag = tag_;
+#else
+  const char* tag = nullptr;
+#endif
 
-  if (severity_ >= g_dbg_sev) {
+  AsyncDispatcher& async_dispatcher = AsyncDispatcher::Get();
+  if (async_dispatcher.enabled()) {
+    async_dispatcher.Append(severity_, std::move(str), tag);
+    return;
+  }
+  Dispatch(str, severity_, tag);
+}
+
+void LogMessage::Dispatch(const std::string& str,
+                          LoggingSeverity severity,
+                          const char* tag) {
+  if (severity >= g_dbg_sev) {
 #if defined(WEBRTC_ANDROID)
-    OutputToDebug(str, severity_, tag_);
+    OutputToDebug(str, severity, tag);
 #else
-    OutputToDebug(str, severity_);
+    OutputToDebug(str, severity);
 #endif
   }
 
   webrtc::MutexLock lock(&GetLoggingLock());
   for (LogSink* entry = streams_; entry != nullptr; entry = entry->next_) {
-    if (severity_ >= entry->min_severity_) {
+    if (severity >= entry->min_severity_) {
 #if defined(WEBRTC_ANDROID)
-      entry->OnLogMessage(str, severity_, tag_);
+      entry->OnLogMessage(str, severity, tag);
 #else
-      entry->OnLogMessage(str, severity_);
+      entry->OnLogMessage(str, severity);
 #endif
     }
   }
@@ -295,6 +435,16 @@ void LogMessage::RemoveLogToStream(LogSink* stream) {
   UpdateMinLogSeverity();
 }
 
+void LogMessage::SetAsyncDispatch(bool enabled) {
+  AsyncDispatcher::Get().set_enabled(enabled);
+  if (!enabled)
+    AsyncDispatcher::Get().Drain(&LogMessage::Dispatch);
+}
+
+void LogMessage::FlushAsyncDispatch() {
+  AsyncDispatcher::Get().Drain(&LogMessage::Dispatch);
+}
+
 void LogMessage::ConfigureLogging(const char* params) {
   LoggingSeverity current_level = LS_VERBOSE;
   LoggingSeverity debug_level = GetLogToDebug();
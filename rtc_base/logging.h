@@ -481,6 +481,19 @@ class LogMessage {
   // Parses the provided parameter stream to configure the options above.
   // Useful for configuring logging from the command line.
   static void ConfigureLogging(const char* params);
+  // Enables or disables asynchronous dispatch. When enabled, a logging thread
+  // only appends the formatted message to a buffer of its own and returns,
+  // and the buffered messages are handed to the debug output and to the
+  // streams, in logging order, by FlushAsyncDispatch(). So slow streams such
+  // as files don't block the logging threads. Messages logged while a
+  // thread's buffer is full are dropped; the number of dropped messages is
+  // logged. Disabling dispatches all buffered messages before it returns.
+  // Use AsyncLogWriter, which flushes periodically on a thread of its own,
+  // rather than calling this directly.
+  static void SetAsyncDispatch(bool enabled);
+  // Dispatches all buffered messages on the calling thread. Does nothing
+  // unless asynchronous dispatch is or was recently enabled.
+  static void FlushAsyncDispatch();
   // Checks the current global debug severity and if the `streams_` collection
   // is empty. If `severity` is smaller than the global severity and if the
   // `streams_` collection is empty, the LogMessage will be considered a noop
@@ -530,6 +543,8 @@ class LogMessage {
   inline static int GetLogToStream(LogSink* stream = nullptr) { return 0; }
   inline static int GetMinLogSeverity() { return 0; }
   inline static void ConfigureLogging(const char* params) {}
+  inline static void SetAsyncDispatch(bool enabled) {}
+  inline static void FlushAsyncDispatch() {}
   static constexpr bool IsNoop(LoggingSeverity severity) { return true; }
   template <LoggingSeverity S>
   static constexpr bool IsNoop() {
@@ -553,6 +568,12 @@ class LogMessage {
   static void OutputToDebug(const std::string& msg, LoggingSeverity severity);
 #endif  // defined(WEBRTC_ANDROID)
 
+  // Writes `msg` to the debug output and to the streams that accept
+  // `severity`. `tag` is only used on Android.
+  static void Dispatch(const std::string& msg,
+                       LoggingSeverity severity,
+                       const char* tag);
+
   // Called from the dtor (or from a test) to append optional extra error
   // information to the log stream and a newline character.
   void FinishPrintStream();
@@ -193,6 +193,76 @@ TEST(LogTest, MultipleThreads) {
   EXPECT_EQ(sev, LogMessage::GetLogToStream(nullptr));
 }
 
+TEST(LogTest, AsyncDispatchBuffersMessagesUntilFlushed) {
+  std::string str;
+  LogSinkImpl stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetAsyncDispatch(true);
+
+  RTC_LOG(LS_INFO) << "first";
+  RTC_LOG(LS_INFO) << "second";
+  RTC_LOG(LS_VERBOSE) << "VERBOSE";
+  EXPECT_TRUE(str.empty());
+
+  LogMessage::FlushAsyncDispatch();
+  size_t first = str.find("first");
+  size_t second = str.find("second");
+  ASSERT_NE(std::string::npos, first);
+  ASSERT_NE(std::string::npos, second);
+  EXPECT_LT(first, second);
+  EXPECT_EQ(std::string::npos, str.find("VERBOSE"));
+
+  RTC_LOG(LS_INFO) << "third";
+  // Disabling dispatches the remaining messages.
+  LogMessage::SetAsyncDispatch(false);
+  EXPECT_NE(std::string::npos, str.find("third"));
+  str.clear();
+  RTC_LOG(LS_INFO) << "fourth";
+  EXPECT_NE(std::string::npos, str.find("fourth"));
+
+  LogMessage::RemoveLogToStream(&stream);
+}
+
+TEST(LogTest, AsyncDispatchKeepsOrderOfMessagesOfAllThreads) {
+  std::string str;
+  LogSinkImpl stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetAsyncDispatch(true);
+
+  RTC_LOG(LS_INFO) << "main thread before";
+  PlatformThread::SpawnJoinable(
+      [] { RTC_LOG(LS_INFO) << "other thread"; }, "LogThread");
+  RTC_LOG(LS_INFO) << "main thread after";
+  LogMessage::SetAsyncDispatch(false);
+
+  size_t before = str.find("main thread before");
+  size_t other = str.find("other thread");
+  size_t after = str.find("main thread after");
+  ASSERT_NE(std::string::npos, before);
+  ASSERT_NE(std::string::npos, other);
+  ASSERT_NE(std::string::npos, after);
+  EXPECT_LT(before, other);
+  EXPECT_LT(other, after);
+
+  LogMessage::RemoveLogToStream(&stream);
+}
+
+TEST(LogTest, AsyncDispatchDropsMessagesOfThreadWithFullBuffer) {
+  std::string str;
+  LogSinkImpl stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetAsyncDispatch(true);
+
+  // A thread buffers up to 10000 messages.
+  for (int i = 0; i < 10005; ++i)
+    RTC_LOG(LS_INFO) << "message";
+  LogMessage::SetAsyncDispatch(false);
+
+  EXPECT_NE(std::string::npos, str.find("Dropped 5 log messages"));
+
+  LogMessage::RemoveLogToStream(&stream);
+}
+
 TEST(LogTest, WallClockStartTime) {
   uint32_t time = LogMessage::WallClockStartTime();
   // Expect the time to be in a sensible range, e.g. > 2012-01-01.
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/arena.h"
+
+#include <stdint.h>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+namespace {
+
+uintptr_t Align(void* pointer, size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(pointer) + alignment - 1) &
+         ~(alignment - 1);
+}
+
+}  // namespace
+
+struct Arena::Block {
+  Block* next;
+  size_t size;
+  // The memory of the block follows the header.
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+struct Arena::Destructor {
+  void* object;
+  void (*destroy)(void*);
+  Destructor* next;
+};
+
+Arena::Arena(size_t block_size) : block_size_(block_size) {
+  RTC_DCHECK_GT(block_size_, 0);
+}
+
+Arena::~Arena() {
+  for (Destructor* destructor = destructors_; destructor != nullptr;
+       destructor = destructor->next) {
+    destructor->destroy(destructor->object);
+  }
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  RTC_DCHECK_GT(alignment, 0);
+  RTC_DCHECK_EQ(alignment & (alignment - 1), 0)
+      << "Alignment must be a power of two.";
+  ++counters_.allocations;
+  counters_.bytes_allocated += size;
+
+  if (size > block_size_ / 4) {
+    // Large allocations get a block of their own, so that they don't waste
+    // the rest of the current block.
+    return reinterpret_cast<void*>(
+        Align(AddBlock(size + alignment - 1)->data(), alignment));
+  }
+
+  uintptr_t aligned = Align(free_begin_, alignment);
+  if (free_begin_ == nullptr ||
+      aligned + size > reinterpret_cast<uintptr_t>(free_end_)) {
+    Block* block = AddBlock(block_size_ + alignment - 1);
+    free_begin_ = block->data();
+    free_end_ = free_begin_ + block->size;
+    aligned = Align(free_begin_, alignment);
+  }
+  free_begin_ = reinterpret_cast<char*>(aligned + size);
+  return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::AddDestructor(void* object, void (*destroy)(void*)) {
+  Destructor* destructor = static_cast<Destructor*>(
+      Allocate(sizeof(Destructor), alignof(Destructor)));
+  *destructor = {object, destroy, destructors_};
+  destructors_ = destructor;
+}
+
+Arena::Block* Arena::AddBlock(size_t size) {
+  Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next = blocks_;
+  block->size = size;
+  blocks_ = block;
+  ++counters_.blocks;
+  counters_.bytes_reserved += sizeof(Block) + size;
+  return block;
+}
+
+}  // namespace rtc
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_ARENA_H_
+#define RTC_BASE_MEMORY_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rtc {
+
+// Monotonic allocator for objects that are created together and live until
+// their owner is destroyed, e.g. the long-lived parts of a call set up in one
+// go. Memory is carved out of large blocks and is only returned when the
+// arena is destroyed, which replaces many small heap allocations with a few
+// large ones. Objects created with Create() are destroyed, in reverse order of
+// creation, when the arena is destroyed.
+//
+// Not thread safe. Don't use it for objects that are created and destroyed
+// repeatedly during the lifetime of the arena, since their memory is never
+// reused.
+class Arena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  // Allocation counters, e.g. for profiling how much memory an owner puts in
+  // its arena.
+  struct Counters {
+    // Number of calls to Allocate().
+    size_t allocations = 0;
+    // Bytes requested by the calls to Allocate().
+    size_t bytes_allocated = 0;
+    // Bytes of all blocks allocated from the heap.
+    size_t bytes_reserved = 0;
+    // Number of blocks allocated from the heap.
+    size_t blocks = 0;
+  };
+
+  explicit Arena(size_t block_size = kDefaultBlockSize);
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns `size` bytes aligned to `alignment`, which must be a power of two.
+  // Allocations larger than a quarter of the block size get a block of their
+  // own.
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  // Constructs a T in the arena. The object is destroyed with the arena and
+  // must not be deleted.
+  template <typename T, typename... Args>
+  T* Create(Args&&... args) {
+    void* memory = Allocate(sizeof(T), alignof(T));
+    T* object = new (memory) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      AddDestructor(object,
+                    [](void* object) { static_cast<T*>(object)->~T(); });
+    }
+    return object;
+  }
+
+  const Counters& counters() const { return counters_; }
+
+ private:
+  struct Block;
+  struct Destructor;
+
+  void AddDestructor(void* object, void (*destroy)(void*));
+  // Allocates a block with `size` bytes of memory from the heap.
+  Block* AddBlock(size_t size);
+
+  const size_t block_size_;
+  Block* blocks_ = nullptr;
+  // The free space of the block that small allocations are carved out of.
+  char* free_begin_ = nullptr;
+  char* free_end_ = nullptr;
+  Destructor* destructors_ = nullptr;
+  Counters counters_;
+};
+
+// Standard allocator that allocates from an Arena, e.g. for the nodes of a
+// std::map that lives as long as the arena. Deallocation is a no-op.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* /* p */, size_t /* n */) {}
+
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+ private:
+  Arena* arena_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_MEMORY_ARENA_H_
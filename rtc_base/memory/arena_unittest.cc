@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/arena.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class DestructionRecorder {
+ public:
+  DestructionRecorder(std::vector<int>* destroyed, int id)
+      : destroyed_(destroyed), id_(id) {}
+  ~DestructionRecorder() { destroyed_->push_back(id_); }
+
+ private:
+  std::vector<int>* const destroyed_;
+  const int id_;
+};
+
+TEST(ArenaTest, AllocationsAreAlignedAndDoNotOverlap) {
+  Arena arena(/*block_size=*/256);
+  char* previous_end = nullptr;
+  for (size_t alignment : {1, 2, 4, 8, 16, 32}) {
+    char* memory = static_cast<char*>(arena.Allocate(24, alignment));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(memory) % alignment, 0u);
+    EXPECT_GE(memory, previous_end);
+    previous_end = memory + 24;
+  }
+  EXPECT_EQ(arena.counters().blocks, 1u);
+}
+
+TEST(ArenaTest, CountsAllocationsAndBlocks) {
+  Arena arena(/*block_size=*/1024);
+  EXPECT_EQ(arena.counters().allocations, 0u);
+  EXPECT_EQ(arena.counters().blocks, 0u);
+
+  for (int i = 0; i < 10; ++i)
+    arena.Allocate(16);
+  EXPECT_EQ(arena.counters().allocations, 10u);
+  EXPECT_EQ(arena.counters().bytes_allocated, 160u);
+  EXPECT_EQ(arena.counters().blocks, 1u);
+
+  // Too large to share a block.
+  arena.Allocate(512);
+  EXPECT_EQ(arena.counters().blocks, 2u);
+  // Still fits in the first block.
+  arena.Allocate(16);
+  EXPECT_EQ(arena.counters().blocks, 2u);
+  EXPECT_EQ(arena.counters().allocations, 12u);
+  EXPECT_GE(arena.counters().bytes_reserved, 1024u + 512u);
+}
+
+TEST(ArenaTest, StartsNewBlockWhenCurrentIsFull) {
+  Arena arena(/*block_size=*/256);
+  for (int i = 0; i < 5; ++i)
+    arena.Allocate(60, 1);
+  EXPECT_EQ(arena.counters().blocks, 2u);
+}
+
+TEST(ArenaTest, DestroysCreatedObjectsInReverseOrder) {
+  std::vector<int> destroyed;
+  {
+    Arena arena;
+    arena.Create<DestructionRecorder>(&destroyed, 1);
+    arena.Create<DestructionRecorder>(&destroyed, 2);
+    std::string* str = arena.Create<std::string>(100, 'x');
+    EXPECT_EQ(*str, std::string(100, 'x'));
+    EXPECT_TRUE(destroyed.empty());
+  }
+  EXPECT_EQ(destroyed, (std::vector<int>{2, 1}));
+}
+
+TEST(ArenaTest, AllocatorKeepsContainerNodesInArena) {
+  Arena arena;
+  using ArenaMap =
+      std::map<int, int, std::less<int>,
+               ArenaAllocator<std::pair<const int, int>>>;
+  ArenaMap map{ArenaAllocator<std::pair<const int, int>>(&arena)};
+  for (int i = 0; i < 100; ++i)
+    map[i] = i * i;
+
+  EXPECT_EQ(map.size(), 100u);
+  EXPECT_EQ(map[7], 49);
+  EXPECT_EQ(arena.counters().allocations, 100u);
+  EXPECT_EQ(arena.counters().blocks, 1u);
+}
+
+}  // namespace
+}  // namespace rtc
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/media_buffer_allocator.h"
+
+#include <atomic>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+std::atomic<MediaBufferAllocator*> g_allocator{nullptr};
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+// From <linux/mempolicy.h>, which isn't available everywhere.
+constexpr int kMpolPreferred = 1;
+constexpr int kMaxNumaNodes = 64;
+
+class MmapMediaBufferAllocator : public MediaBufferAllocator {
+ public:
+  explicit MmapMediaBufferAllocator(
+      const MmapMediaBufferAllocatorOptions& options)
+      : options_(options), page_size_(sysconf(_SC_PAGESIZE)) {}
+
+  void* Allocate(size_t size, size_t alignment) override {
+    if (size < options_.min_mapped_size)
+      return AlignedMalloc(size, alignment);
+    // Mappings are page aligned.
+    RTC_DCHECK_LE(alignment, page_size_);
+    size_t mapped_size = MappedSize(size);
+    void* ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+      return nullptr;
+#if defined(MADV_HUGEPAGE)
+    if (options_.huge_pages)
+      madvise(ptr, mapped_size, MADV_HUGEPAGE);
+#endif
+    int node = CurrentNumaNode();
+    if (options_.numa_local && node >= 0 && node < kMaxNumaNodes) {
+      // Pages are only placed once they are touched, so this binds them
+      // before anyone else can, without failing when the node is full.
+      unsigned long node_mask = 1ul << node;  // NOLINT(runtime/int)
+      syscall(SYS_mbind, ptr, mapped_size, kMpolPreferred, &node_mask,
+              kMaxNumaNodes + 1, 0);
+    }
+    return ptr;
+  }
+
+  void Free(void* ptr, size_t size) override {
+    if (size < options_.min_mapped_size) {
+      AlignedFree(ptr);
+      return;
+    }
+    munmap(ptr, MappedSize(size));
+  }
+
+ private:
+  size_t MappedSize(size_t size) const {
+    return (size + page_size_ - 1) / page_size_ * page_size_;
+  }
+
+  const MmapMediaBufferAllocatorOptions options_;
+  const size_t page_size_;
+};
+#endif
+
+}  // namespace
+
+void SetMediaBufferAllocator(MediaBufferAllocator* allocator) {
+  g_allocator.store(allocator, std::memory_order_release);
+}
+
+MediaBufferAllocator* GetMediaBufferAllocator() {
+  return g_allocator.load(std::memory_order_acquire);
+}
+
+void MediaBufferDeleter::operator()(uint8_t* ptr) const {
+  if (allocator_) {
+    allocator_->Free(ptr, size_);
+  } else {
+    AlignedFree(ptr);
+  }
+}
+
+std::unique_ptr<uint8_t, MediaBufferDeleter> AllocateMediaBuffer(
+    size_t size,
+    size_t alignment) {
+  MediaBufferAllocator* allocator = GetMediaBufferAllocator();
+  void* ptr = allocator ? allocator->Allocate(size, alignment)
+                        : AlignedMalloc(size, alignment);
+  RTC_CHECK(ptr || size == 0) << "Couldn't allocate a media buffer of " << size
+                              << " bytes";
+  return std::unique_ptr<uint8_t, MediaBufferDeleter>(
+      static_cast<uint8_t*>(ptr), MediaBufferDeleter(allocator, size));
+}
+
+int CurrentNumaNode() {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+    return node;
+#endif
+  return -1;
+}
+
+std::unique_ptr<MediaBufferAllocator> CreateMmapMediaBufferAllocator(
+    const MmapMediaBufferAllocatorOptions& options) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  return std::make_unique<MmapMediaBufferAllocator>(options);
+#else
+  return nullptr;
+#endif
+}
+
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_MEDIA_BUFFER_ALLOCATOR_H_
+#define RTC_BASE_MEMORY_MEDIA_BUFFER_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Allocates the memory of video frame buffers and encoded images. Without an
+// allocator installed they come from the heap, which on servers with several
+// NUMA nodes may place them on a node other than the one of the threads that
+// process them.
+class MediaBufferAllocator {
+ public:
+  virtual ~MediaBufferAllocator() = default;
+
+  // Returns `size` bytes aligned on `alignment`, a power of two, or nullptr.
+  virtual void* Allocate(size_t size, size_t alignment) = 0;
+  // `size` is the size `ptr` was allocated with.
+  virtual void Free(void* ptr, size_t size) = 0;
+};
+
+// Installs `allocator` for buffers allocated from now on, or restores the heap
+// if it is null. Buffers are freed by the allocator they were allocated with,
+// so it must outlive them; in practice it is installed once, at startup.
+RTC_EXPORT void SetMediaBufferAllocator(MediaBufferAllocator* allocator);
+RTC_EXPORT MediaBufferAllocator* GetMediaBufferAllocator();
+
+// Frees memory from AllocateMediaBuffer().
+class MediaBufferDeleter {
+ public:
+  MediaBufferDeleter() = default;
+  MediaBufferDeleter(MediaBufferAllocator* allocator, size_t size)
+      : allocator_(allocator), size_(size) {}
+
+  void operator()(uint8_t* ptr) const;
+
+ private:
+  MediaBufferAllocator* allocator_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Returns `size` bytes aligned on `alignment` from the installed allocator, or
+// from AlignedMalloc() if there is none. Crashes if the allocation fails.
+RTC_EXPORT std::unique_ptr<uint8_t, MediaBufferDeleter> AllocateMediaBuffer(
+    size_t size,
+    size_t alignment);
+
+// Returns the NUMA node of the CPU the calling thread runs on, or -1 if it
+// can't be told.
+RTC_EXPORT int CurrentNumaNode();
+
+struct MmapMediaBufferAllocatorOptions {
+  // Buffers smaller than this come from the heap, since mapping them would
+  // cost a system call each and round them up to a whole page.
+  size_t min_mapped_size = 256 * 1024;
+  // Advises the kernel to back buffers with transparent huge pages.
+  bool huge_pages = true;
+  // Prefers the NUMA node of the allocating thread, which is normally the
+  // thread that writes the buffer (a decoder, or a capturer), over the
+  // kernel's default policy.
+  bool numa_local = true;
+};
+
+// Returns an allocator that maps large buffers with mmap(), or nullptr on
+// platforms other than Linux and Android. Every mapped buffer costs an mmap()
+// and an munmap(), so it is best used with buffers that are pooled, like those
+// of VideoFrameBufferPool.
+RTC_EXPORT std::unique_ptr<MediaBufferAllocator> CreateMmapMediaBufferAllocator(
+    const MmapMediaBufferAllocatorOptions& options);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_MEMORY_MEDIA_BUFFER_ALLOCATOR_H_
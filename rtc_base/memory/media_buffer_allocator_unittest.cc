@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/media_buffer_allocator.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+
+#include "rtc_base/memory/aligned_malloc.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+bool IsAligned(const void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+class CountingAllocator : public MediaBufferAllocator {
+ public:
+  void* Allocate(size_t size, size_t alignment) override {
+    ++num_allocations_;
+    allocated_bytes_ += size;
+    return AlignedMalloc(size, alignment);
+  }
+  void Free(void* ptr, size_t size) override {
+    ++num_frees_;
+    allocated_bytes_ -= size;
+    AlignedFree(ptr);
+  }
+
+  int num_allocations_ = 0;
+  int num_frees_ = 0;
+  size_t allocated_bytes_ = 0;
+};
+
+TEST(MediaBufferAllocatorTest, AllocatesAlignedBuffersWithoutAllocator) {
+  ASSERT_EQ(GetMediaBufferAllocator(), nullptr);
+  auto buffer = AllocateMediaBuffer(100, 64);
+  ASSERT_TRUE(buffer);
+  EXPECT_TRUE(IsAligned(buffer.get(), 64));
+}
+
+TEST(MediaBufferAllocatorTest, BuffersAreFreedByTheirAllocator) {
+  CountingAllocator allocator;
+  SetMediaBufferAllocator(&allocator);
+  auto buffer = AllocateMediaBuffer(100, 64);
+  SetMediaBufferAllocator(nullptr);
+  EXPECT_TRUE(IsAligned(buffer.get(), 64));
+  EXPECT_EQ(allocator.num_allocations_, 1);
+  EXPECT_EQ(allocator.allocated_bytes_, 100u);
+
+  buffer.reset();
+  EXPECT_EQ(allocator.num_frees_, 1);
+  EXPECT_EQ(allocator.allocated_bytes_, 0u);
+}
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+TEST(MediaBufferAllocatorTest, MmapAllocatorMapsLargeBuffers) {
+  MmapMediaBufferAllocatorOptions options;
+  options.min_mapped_size = 4096;
+  std::unique_ptr<MediaBufferAllocator> allocator =
+      CreateMmapMediaBufferAllocator(options);
+  ASSERT_TRUE(allocator);
+  EXPECT_GE(CurrentNumaNode(), 0);
+
+  for (size_t size : {100, 4096, 3 * 1024 * 1024 + 1}) {
+    void* ptr = allocator->Allocate(size, 64);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(IsAligned(ptr, 64));
+    memset(ptr, 0xab, size);
+    allocator->Free(ptr, size);
+  }
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
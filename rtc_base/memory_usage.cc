@@ -24,9 +24,28 @@
 // clang-format on
 #endif
 
+#include <algorithm>
+
 #include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
+namespace {
+
+#if defined(WEBRTC_ENABLE_LIVE_OBJECT_COUNTERS)
+struct LiveObjectCounters {
+  webrtc::Mutex mutex;
+  std::vector<const LiveObjectCounter*> counters RTC_GUARDED_BY(mutex);
+};
+
+LiveObjectCounters& GetLiveObjectCounters() {
+  static LiveObjectCounters* const counters = new LiveObjectCounters();
+  return *counters;
+}
+#endif
+
+}  // namespace
 
 int64_t GetProcessResidentSizeBytes() {
 #if defined(WEBRTC_LINUX)
@@ -71,4 +90,41 @@ int64_t GetProcessResidentSizeBytes() {
 #endif
 }
 
+#if defined(WEBRTC_ENABLE_LIVE_OBJECT_COUNTERS)
+LiveObjectCounter::LiveObjectCounter(const char* name) : name_(name) {
+  LiveObjectCounters& counters = GetLiveObjectCounters();
+  webrtc::MutexLock lock(&counters.mutex);
+  counters.counters.push_back(this);
+}
+
+LiveObjectStats LiveObjectCounter::GetStats() const {
+  LiveObjectStats stats;
+  stats.name = name_;
+  stats.count = count_.load(std::memory_order_relaxed);
+  stats.bytes = bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+std::vector<LiveObjectStats> GetLiveObjectStats() {
+  std::vector<LiveObjectStats> stats;
+  LiveObjectCounters& counters = GetLiveObjectCounters();
+  {
+    webrtc::MutexLock lock(&counters.mutex);
+    for (const LiveObjectCounter* counter : counters.counters)
+      stats.push_back(counter->GetStats());
+  }
+  std::sort(stats.begin(), stats.end(),
+            [](const LiveObjectStats& a, const LiveObjectStats& b) {
+              return a.name < b.name;
+            });
+  return stats;
+}
+#else
+LiveObjectCounter::LiveObjectCounter(const char*) {}
+
+std::vector<LiveObjectStats> GetLiveObjectStats() {
+  return {};
+}
+#endif
+
 }  // namespace rtc
@@ -12,6 +12,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "rtc_base/system/rtc_export.h"
+
 namespace rtc {
 
 // Returns current memory used by the process in bytes (working set size on
@@ -19,6 +25,87 @@ namespace rtc {
 // Returns -1 on failure.
 int64_t GetProcessResidentSizeBytes();
 
+// Live objects of a type counted with LiveObject, and the bytes they hold.
+struct LiveObjectStats {
+  std::string name;
+  int64_t count = 0;
+  int64_t bytes = 0;
+};
+
+// Returns the stats of every LiveObjectCounter, ordered by name. Empty unless
+// the build sets rtc_enable_live_object_counters.
+RTC_EXPORT std::vector<LiveObjectStats> GetLiveObjectStats();
+
+// Counts the live objects of one type. Counters are never destroyed, so they
+// are meant to be created once per type, as a leaked function-local static.
+class RTC_EXPORT LiveObjectCounter {
+ public:
+  explicit LiveObjectCounter(const char* name);
+  LiveObjectCounter(const LiveObjectCounter&) = delete;
+  LiveObjectCounter& operator=(const LiveObjectCounter&) = delete;
+
+#if defined(WEBRTC_ENABLE_LIVE_OBJECT_COUNTERS)
+  void Add(int64_t count, int64_t bytes) {
+    count_.fetch_add(count, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  LiveObjectStats GetStats() const;
+
+ private:
+  const char* const name_;
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> bytes_{0};
+#endif
+};
+
+// A member that counts the object it is part of in `counter` while it lives,
+// along with the bytes last passed to SetBytes(). Copies count the same bytes
+// again, while moves take them over. Without
+// rtc_enable_live_object_counters it does nothing, and with
+// RTC_NO_UNIQUE_ADDRESS it takes no space.
+class LiveObject {
+ public:
+#if defined(WEBRTC_ENABLE_LIVE_OBJECT_COUNTERS)
+  explicit LiveObject(LiveObjectCounter& counter) : counter_(&counter) {
+    counter_->Add(1, 0);
+  }
+  LiveObject(const LiveObject& other)
+      : counter_(other.counter_), bytes_(other.bytes_) {
+    counter_->Add(1, bytes_);
+  }
+  LiveObject(LiveObject&& other)
+      : counter_(other.counter_), bytes_(other.bytes_) {
+    other.bytes_ = 0;
+    counter_->Add(1, 0);
+  }
+  LiveObject& operator=(const LiveObject& other) {
+    SetBytes(other.bytes_);
+    return *this;
+  }
+  LiveObject& operator=(LiveObject&& other) {
+    if (this != &other) {
+      counter_->Add(0, -bytes_);
+      bytes_ = other.bytes_;
+      other.bytes_ = 0;
+    }
+    return *this;
+  }
+  ~LiveObject() { counter_->Add(-1, -bytes_); }
+
+  void SetBytes(int64_t bytes) {
+    counter_->Add(0, bytes - bytes_);
+    bytes_ = bytes;
+  }
+
+ private:
+  LiveObjectCounter* counter_;
+  int64_t bytes_ = 0;
+#else
+  explicit LiveObject(LiveObjectCounter&) {}
+  void SetBytes(int64_t) {}
+#endif
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_MEMORY_USAGE_H_
@@ -10,13 +10,80 @@
 
 #include "rtc_base/memory_usage.h"
 
+#include <string>
+#include <utility>
+
 #include "test/gtest.h"
 
 namespace rtc {
+namespace {
+
+LiveObjectCounter& TestObjects() {
+  static LiveObjectCounter* const counter =
+      new LiveObjectCounter("MemoryUsageTestObject");
+  return *counter;
+}
+
+struct TestObject {
+  explicit TestObject(int64_t bytes) { live_object.SetBytes(bytes); }
+  LiveObject live_object{TestObjects()};
+};
+
+}  // namespace
 
 TEST(GetMemoryUsage, SimpleTest) {
   int64_t used_bytes = GetProcessResidentSizeBytes();
   EXPECT_GE(used_bytes, 0);
 }
 
+#if defined(WEBRTC_ENABLE_LIVE_OBJECT_COUNTERS)
+namespace {
+LiveObjectStats GetStats(const std::string& name) {
+  for (const LiveObjectStats& stats : GetLiveObjectStats()) {
+    if (stats.name == name)
+      return stats;
+  }
+  return LiveObjectStats();
+}
+}  // namespace
+
+TEST(LiveObjectStatsTest, CountsLiveObjectsAndBytes) {
+  {
+    TestObject a(100);
+    TestObject b(20);
+    LiveObjectStats stats = GetStats("MemoryUsageTestObject");
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.bytes, 120);
+
+    b.live_object.SetBytes(50);
+    EXPECT_EQ(GetStats("MemoryUsageTestObject").bytes, 150);
+  }
+  LiveObjectStats stats = GetStats("MemoryUsageTestObject");
+  EXPECT_EQ(stats.count, 0);
+  EXPECT_EQ(stats.bytes, 0);
+}
+
+TEST(LiveObjectStatsTest, CopiesCountBytesAgainAndMovesTakeThemOver) {
+  TestObject a(100);
+  TestObject copy = a;
+  EXPECT_EQ(GetStats("MemoryUsageTestObject").bytes, 200);
+
+  TestObject moved = std::move(a);
+  LiveObjectStats stats = GetStats("MemoryUsageTestObject");
+  EXPECT_EQ(stats.count, 3);
+  EXPECT_EQ(stats.bytes, 200);
+
+  TestObject assigned(10);
+  assigned = std::move(moved);
+  EXPECT_EQ(GetStats("MemoryUsageTestObject").bytes, 200);
+  assigned = copy;
+  EXPECT_EQ(GetStats("MemoryUsageTestObject").bytes, 200);
+}
+#else
+TEST(LiveObjectStatsTest, NoStatsUnlessEnabled) {
+  TestObject a(100);
+  EXPECT_TRUE(GetLiveObjectStats().empty());
+}
+#endif
+
 }  // namespace rtc
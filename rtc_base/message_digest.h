@@ -43,6 +43,13 @@ class MessageDigest {
 class MessageDigestFactory {
  public:
   static MessageDigest* Create(const std::string& alg);
+  // Creates a digest whose output is the HMAC of its input, keyed with the
+  // `key_len` bytes of `key`. The padded key is hashed once, here, and
+  // Finish() resets the digest to that keyed state, so computing many HMACs
+  // with the same key only hashes their inputs.
+  static MessageDigest* CreateHmac(const std::string& alg,
+                                   const void* key,
+                                   size_t key_len);
 };
 
 // A check that an algorithm is in a list of approved digest algorithms
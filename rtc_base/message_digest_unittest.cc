@@ -10,6 +10,8 @@
 
 #include "rtc_base/message_digest.h"
 
+#include <memory>
+
 #include "rtc_base/string_encode.h"
 #include "test/gtest.h"
 
@@ -152,4 +154,35 @@ TEST(MessageDigestTest, TestBadHmac) {
   EXPECT_EQ("", ComputeHmac("sha-9000", "key", "abc"));
 }
 
+// Test vectors from RFC 2202.
+TEST(MessageDigestTest, TestSha1KeyedHmac) {
+  std::string key(20, '\xaa');
+  std::unique_ptr<MessageDigest> hmac(
+      MessageDigestFactory::CreateHmac(DIGEST_SHA_1, key.data(), key.size()));
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ(20U, hmac->Size());
+  // Finish() keeps the key for the next HMAC.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("125d7342b9ac11cd91a39af48aa17b4f63f175d3",
+              ComputeDigest(hmac.get(), std::string(50, '\xdd')));
+  }
+  // The input may be hashed in pieces.
+  hmac->Update(std::string(20, '\xdd').data(), 20);
+  EXPECT_EQ("125d7342b9ac11cd91a39af48aa17b4f63f175d3",
+            ComputeDigest(hmac.get(), std::string(30, '\xdd')));
+
+  std::string long_key(80, '\xaa');
+  hmac.reset(MessageDigestFactory::CreateHmac(DIGEST_SHA_1, long_key.data(),
+                                              long_key.size()));
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+            ComputeDigest(
+                hmac.get(),
+                "Test Using Larger Than Block-Size Key - Hash Key First"));
+}
+
+TEST(MessageDigestTest, TestBadKeyedHmac) {
+  EXPECT_FALSE(MessageDigestFactory::CreateHmac("sha-9000", "key", 3));
+}
+
 }  // namespace rtc
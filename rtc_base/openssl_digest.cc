@@ -10,6 +10,13 @@
 
 #include "rtc_base/openssl_digest.h"
 
+#if defined(WEBRTC_WIN)
+// Must be included first before openssl headers.
+#include "rtc_base/win32.h"  // NOLINT
+#endif                       // WEBRTC_WIN
+
+#include <openssl/hmac.h>
+
 #include "rtc_base/checks.h"  // RTC_DCHECK, RTC_CHECK
 #include "rtc_base/openssl.h"
 
@@ -115,4 +122,48 @@ bool OpenSSLDigest::GetDigestSize(const std::string& algorithm,
   return true;
 }
 
+OpenSSLHmac::OpenSSLHmac(const std::string& algorithm,
+                         const void* key,
+                         size_t key_len) {
+  ctx_ = HMAC_CTX_new();
+  RTC_CHECK(ctx_ != nullptr);
+  // A null key would make HMAC_Init_ex() reuse the previous one.
+  static const char kEmptyKey[] = "";
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md_) ||
+      !HMAC_Init_ex(ctx_, key ? key : kEmptyKey, static_cast<int>(key_len),
+                    md_, nullptr)) {
+    md_ = nullptr;
+  }
+}
+
+OpenSSLHmac::~OpenSSLHmac() {
+  HMAC_CTX_free(ctx_);
+}
+
+size_t OpenSSLHmac::Size() const {
+  if (!md_) {
+    return 0;
+  }
+  return EVP_MD_size(md_);
+}
+
+void OpenSSLHmac::Update(const void* buf, size_t len) {
+  if (!md_) {
+    return;
+  }
+  HMAC_Update(ctx_, static_cast<const unsigned char*>(buf), len);
+}
+
+size_t OpenSSLHmac::Finish(void* buf, size_t len) {
+  if (!md_ || len < Size()) {
+    return 0;
+  }
+  unsigned int md_len;
+  HMAC_Final(ctx_, static_cast<unsigned char*>(buf), &md_len);
+  // Reuses the key for future Update()s.
+  HMAC_Init_ex(ctx_, nullptr, 0, nullptr, nullptr);
+  RTC_DCHECK(md_len == Size());
+  return md_len;
+}
+
 }  // namespace rtc
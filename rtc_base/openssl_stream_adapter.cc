@@ -16,10 +16,14 @@
 #include <openssl/rand.h>
 #include <openssl/tls1.h>
 #include <openssl/x509v3.h>
-#ifndef OPENSSL_IS_BORINGSSL
+#ifdef OPENSSL_IS_BORINGSSL
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#else
 #include <openssl/dtls1.h>
 #include <openssl/ssl.h>
 #endif
+#include <string.h>
 
 #include <atomic>
 #include <memory>
@@ -28,6 +32,7 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
@@ -152,6 +157,43 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+#ifdef OPENSSL_IS_BORINGSSL
+// Signs `input` with `key` the way that TLS does with `signature_algorithm`.
+// Returns nullopt on failure.
+absl::optional<Buffer> SignHandshakeMessage(EVP_PKEY* key,
+                                            uint16_t signature_algorithm,
+                                            const Buffer& input) {
+  if (EVP_PKEY_id(key) !=
+      SSL_get_signature_algorithm_key_type(signature_algorithm)) {
+    return absl::nullopt;
+  }
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pctx = nullptr;
+  const EVP_MD* digest =
+      SSL_get_signature_algorithm_digest(signature_algorithm);
+  if (!EVP_DigestSignInit(ctx.get(), &pctx, digest, nullptr, key)) {
+    return absl::nullopt;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1))) {
+    return absl::nullopt;
+  }
+  size_t length = 0;
+  if (!EVP_DigestSign(ctx.get(), nullptr, &length, input.data(),
+                      input.size())) {
+    return absl::nullopt;
+  }
+  Buffer signature(length);
+  if (!EVP_DigestSign(ctx.get(), signature.data(), &length, input.data(),
+                      input.size())) {
+    return absl::nullopt;
+  }
+  signature.SetSize(length);
+  return signature;
+}
+#endif
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -286,6 +328,54 @@ bool ShouldAllowLegacyTLSProtocols() {
              : webrtc::field_trial::IsEnabled("WebRTC-LegacyTlsProtocols");
 }
 
+OpenSSLStreamSessionCache::OpenSSLStreamSessionCache() {
+  RTC_CHECK(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)));
+}
+
+OpenSSLStreamSessionCache::~OpenSSLStreamSessionCache() {
+  for (const auto& it : sessions_) {
+    SSL_SESSION_free(it.second);
+  }
+}
+
+void OpenSSLStreamSessionCache::ConfigureServerContext(SSL_CTX* ctx) {
+  if (!SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_keys_,
+                                      sizeof(ticket_keys_))) {
+    RTC_LOG(LS_WARNING) << "Failed to set the session ticket keys.";
+  }
+}
+
+SSL_SESSION* OpenSSLStreamSessionCache::LookupSession(
+    const std::string& key) const {
+  webrtc::MutexLock lock(&mutex_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end()) {
+    return nullptr;
+  }
+  SSL_SESSION_up_ref(it->second);
+  return it->second;
+}
+
+void OpenSSLStreamSessionCache::AddSession(const std::string& key,
+                                          SSL_SESSION* session) {
+  RTC_DCHECK(session);
+  webrtc::MutexLock lock(&mutex_);
+  auto it = sessions_.find(key);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    it->second = session;
+    return;
+  }
+  if (sessions_.size() == kMaxSessions) {
+    auto oldest = sessions_.find(session_keys_.front());
+    SSL_SESSION_free(oldest->second);
+    sessions_.erase(oldest);
+    session_keys_.pop_front();
+  }
+  sessions_[key] = session;
+  session_keys_.push_back(key);
+}
+
 OpenSSLStreamAdapter::OpenSSLStreamAdapter(
     std::unique_ptr<StreamInterface> stream)
     : stream_(std::move(stream)),
@@ -550,6 +640,26 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetSessionCache(
+    scoped_refptr<SSLSessionCache> cache) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  // OpenSSLStreamSessionCache is the only implementation.
+  session_cache_ = static_cast<OpenSSLStreamSessionCache*>(cache.get());
+}
+
+void OpenSSLStreamAdapter::SetHandshakeTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+#ifdef OPENSSL_IS_BORINGSSL
+  handshake_task_queue_ = task_queue;
+#else
+  if (task_queue) {
+    RTC_LOG(LS_WARNING) << "Signing on a handshake task queue requires "
+                           "BoringSSL; signing on the current thread.";
+  }
+#endif
+}
+
 //
 // StreamInterface Implementation
 //
@@ -890,6 +1000,25 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  if (session_cache_ && role_ == SSL_CLIENT) {
+    std::string key = GetSessionCacheKey();
+    SSL_SESSION* session =
+        key.empty() ? nullptr : session_cache_->LookupSession(key);
+    if (session) {
+      RTC_DLOG(LS_INFO) << "Offering to resume a cached session.";
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
+#ifdef OPENSSL_IS_BORINGSSL
+  if (handshake_task_queue_) {
+    static const SSL_PRIVATE_KEY_METHOD kPrivateKeyMethod = {
+        &SignCallback, &DecryptCallback, &CompleteCallback};
+    SSL_set_private_key_method(ssl_, &kPrivateKeyMethod);
+  }
+#endif
+
   // Do the connect
   return ContinueSSL();
 }
@@ -907,10 +1036,25 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_DLOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) && !OnSessionResumed()) {
+        RTC_LOG(LS_WARNING) << "Rejected the peer certificate of a resumed "
+                               "session.";
+        return -1;
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
 
+      if (session_cache_ && role_ == SSL_CLIENT) {
+        std::string key = GetSessionCacheKey();
+        SSL_SESSION* session = SSL_get1_session(ssl_);
+        if (!key.empty() && session) {
+          session_cache_->AddSession(key, session);
+        } else {
+          SSL_SESSION_free(session);
+        }
+      }
+
       state_ = SSL_CONNECTED;
       if (!WaitingToVerifyPeerCertificate()) {
         // We have everything we need to start the connection, so signal
@@ -938,6 +1082,13 @@ int OpenSSLStreamAdapter::ContinueSSL() {
       RTC_DLOG(LS_VERBOSE) << " -- error want write";
       break;
 
+#ifdef OPENSSL_IS_BORINGSSL
+    case SSL_ERROR_WANT_PRIVATE_KEY_OPERATION:
+      // Continued by OnSignatureDone().
+      RTC_DLOG(LS_VERBOSE) << " -- waiting for signature";
+      break;
+#endif
+
     case SSL_ERROR_ZERO_RETURN:
     default:
       SSLHandshakeError ssl_handshake_err = SSLHandshakeError::UNKNOWN;
@@ -1005,6 +1156,9 @@ void OpenSSLStreamAdapter::Cleanup(uint8_t alert) {
   }
   identity_.reset();
   peer_cert_chain_.reset();
+  signature_pending_ = false;
+  signature_done_ = false;
+  signature_.reset();
 
   // Clear the DTLS timer
   timeout_task_.Stop();
@@ -1105,6 +1259,17 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     }
   }
 
+  if (session_cache_) {
+    // Sessions are only resumed between contexts with the same ID context.
+    static constexpr uint8_t kSessionIdContext[] = {'w', 'e', 'b', 'r',
+                                                    't', 'c'};
+    SSL_CTX_set_session_id_context(ctx, kSessionIdContext,
+                                   sizeof(kSessionIdContext));
+    if (role_ == SSL_SERVER) {
+      session_cache_->ConfigureServerContext(ctx);
+    }
+  }
+
   return ctx;
 }
 
@@ -1138,6 +1303,47 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   return true;
 }
 
+std::string OpenSSLStreamAdapter::GetSessionCacheKey() const {
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_length)) {
+    return std::string();
+  }
+  std::string key(reinterpret_cast<const char*>(digest), digest_length);
+  key += peer_certificate_digest_algorithm_;
+  key.append(peer_certificate_digest_value_.data<char>(),
+             peer_certificate_digest_value_.size());
+  return key;
+}
+
+bool OpenSSLStreamAdapter::OnSessionResumed() {
+#ifdef OPENSSL_IS_BORINGSSL
+  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl_);
+  if (!chain || sk_CRYPTO_BUFFER_num(chain) == 0) {
+    return false;
+  }
+  std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
+  for (CRYPTO_BUFFER* cert : chain) {
+    cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
+  }
+  peer_cert_chain_.reset(new SSLCertChain(std::move(cert_chain)));
+#else
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    return false;
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+  X509_free(cert);
+#endif
+  // If the digest isn't known yet, the certificate is verified when it is.
+  return !HasPeerCertificateDigest() || VerifyPeerCertificate();
+}
+
 std::unique_ptr<SSLCertChain> OpenSSLStreamAdapter::GetPeerSSLCertChain()
     const {
   return peer_cert_chain_ ? peer_cert_chain_->Clone() : nullptr;
@@ -1172,6 +1378,87 @@ enum ssl_verify_result_t OpenSSLStreamAdapter::SSLVerifyCallback(
 
   return ssl_verify_ok;
 }
+
+enum ssl_private_key_result_t OpenSSLStreamAdapter::SignCallback(
+    SSL* ssl,
+    uint8_t* out,
+    size_t* out_len,
+    size_t max_out,
+    uint16_t signature_algorithm,
+    const uint8_t* in,
+    size_t in_len) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  RTC_DCHECK(!stream->signature_pending_);
+  EVP_PKEY* key = SSL_get_privatekey(ssl);
+  if (!key) {
+    return ssl_private_key_failure;
+  }
+  stream->signature_pending_ = true;
+  stream->signature_done_ = false;
+  stream->handshake_task_queue_->PostTask(webrtc::ToQueuedTask(
+      [key = bssl::UpRef(key), signature_algorithm, input = Buffer(in, in_len),
+       owner = stream->owner_, safety = stream->task_safety_.flag(), stream] {
+        absl::optional<Buffer> signature =
+            SignHandshakeMessage(key.get(), signature_algorithm, input);
+        owner->PostTask(webrtc::ToQueuedTask(
+            safety, [stream, signature = std::move(signature)]() mutable {
+              stream->OnSignatureDone(std::move(signature));
+            }));
+      }));
+  return ssl_private_key_retry;
+}
+
+enum ssl_private_key_result_t OpenSSLStreamAdapter::DecryptCallback(
+    SSL* ssl,
+    uint8_t* out,
+    size_t* out_len,
+    size_t max_out,
+    const uint8_t* in,
+    size_t in_len) {
+  // Only used by the RSA key exchange, which is cheap enough to not offload.
+  RSA* rsa = EVP_PKEY_get0_RSA(SSL_get_privatekey(ssl));
+  if (!rsa ||
+      !RSA_decrypt(rsa, out_len, out, max_out, in, in_len, RSA_NO_PADDING)) {
+    return ssl_private_key_failure;
+  }
+  return ssl_private_key_success;
+}
+
+enum ssl_private_key_result_t OpenSSLStreamAdapter::CompleteCallback(
+    SSL* ssl,
+    uint8_t* out,
+    size_t* out_len,
+    size_t max_out) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  if (!stream->signature_done_) {
+    return ssl_private_key_retry;
+  }
+  stream->signature_done_ = false;
+  absl::optional<Buffer> signature = std::move(stream->signature_);
+  stream->signature_.reset();
+  if (!signature || signature->size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  memcpy(out, signature->data(), signature->size());
+  *out_len = signature->size();
+  return ssl_private_key_success;
+}
+
+void OpenSSLStreamAdapter::OnSignatureDone(absl::optional<Buffer> signature) {
+  if (!signature_pending_) {
+    return;
+  }
+  signature_pending_ = false;
+  signature_done_ = true;
+  signature_ = std::move(signature);
+  if (state_ == SSL_CONNECTING) {
+    if (int err = ContinueSSL()) {
+      Error("ContinueSSL", err, 0, true);
+    }
+  }
+}
 #else   // OPENSSL_IS_BORINGSSL
 int OpenSSLStreamAdapter::SSLVerifyCallback(X509_STORE_CTX* store, void* arg) {
   // Get our SSL structure and OpenSSLStreamAdapter from the store.
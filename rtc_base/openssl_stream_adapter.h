@@ -15,11 +15,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/buffer.h"
 #ifdef OPENSSL_IS_BORINGSSL
 #include "rtc_base/boringssl_identity.h"
@@ -29,9 +33,15 @@
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
 
 namespace rtc {
 
@@ -69,6 +79,42 @@ class SSLCertChain;
 // configuration is restored.
 RTC_EXPORT void SetAllowLegacyTLSProtocols(const absl::optional<bool>& allow);
 
+// The SSLSessionCache of OpenSSLStreamAdapters. Clients look up sessions by
+// the digests of both certificates, since a session can only be resumed
+// between the same certificates. Servers resume sessions from tickets, so
+// they keep no sessions here.
+class OpenSSLStreamSessionCache : public SSLSessionCache {
+ public:
+  OpenSSLStreamSessionCache();
+  ~OpenSSLStreamSessionCache() override;
+
+  OpenSSLStreamSessionCache(const OpenSSLStreamSessionCache&) = delete;
+  OpenSSLStreamSessionCache& operator=(const OpenSSLStreamSessionCache&) =
+      delete;
+
+  // Makes servers that use `ctx` encrypt tickets with the key of this cache,
+  // so that they resume sessions given out by the other servers using it.
+  void ConfigureServerContext(SSL_CTX* ctx);
+
+  // Looks up a session by `key`. The returned SSL_SESSION is up_refed, or
+  // null if there is none.
+  SSL_SESSION* LookupSession(const std::string& key) const;
+  // Adds a session to the cache, taking over the reference of the caller. Any
+  // existing session with the same key is replaced, and the oldest session
+  // is dropped when the cache is full.
+  void AddSession(const std::string& key, SSL_SESSION* session);
+
+ private:
+  static constexpr size_t kMaxSessions = 1000;
+  static constexpr size_t kTicketKeysSize = 48;
+
+  uint8_t ticket_keys_[kTicketKeysSize];
+  mutable webrtc::Mutex mutex_;
+  std::map<std::string, SSL_SESSION*> sessions_ RTC_GUARDED_BY(mutex_);
+  // The keys of `sessions_`, oldest first.
+  std::deque<std::string> session_keys_ RTC_GUARDED_BY(mutex_);
+};
+
 class OpenSSLStreamAdapter final : public SSLStreamAdapter {
  public:
   explicit OpenSSLStreamAdapter(std::unique_ptr<StreamInterface> stream);
@@ -93,6 +139,8 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetSessionCache(scoped_refptr<SSLSessionCache> cache) override;
+  void SetHandshakeTaskQueue(webrtc::TaskQueueBase* task_queue) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -183,6 +231,39 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // Verify the peer certificate matches the signaled digest.
   bool VerifyPeerCertificate();
 
+  // The key of the sessions between our certificate and the peer's in
+  // `session_cache_`, or empty if the peer's isn't known yet.
+  std::string GetSessionCacheKey() const;
+  // Takes the peer certificate from a resumed session, for which the
+  // certificate verification callback isn't called, and verifies it.
+  bool OnSessionResumed();
+
+#ifdef OPENSSL_IS_BORINGSSL
+  // Private key callbacks that sign on `handshake_task_queue_`. See
+  // SSL_PRIVATE_KEY_METHOD.
+  static enum ssl_private_key_result_t SignCallback(
+      SSL* ssl,
+      uint8_t* out,
+      size_t* out_len,
+      size_t max_out,
+      uint16_t signature_algorithm,
+      const uint8_t* in,
+      size_t in_len);
+  static enum ssl_private_key_result_t DecryptCallback(SSL* ssl,
+                                                       uint8_t* out,
+                                                       size_t* out_len,
+                                                       size_t max_out,
+                                                       const uint8_t* in,
+                                                       size_t in_len);
+  static enum ssl_private_key_result_t CompleteCallback(SSL* ssl,
+                                                        uint8_t* out,
+                                                        size_t* out_len,
+                                                        size_t max_out);
+  // Called on the owner thread with the signature, or nullopt if signing
+  // failed.
+  void OnSignatureDone(absl::optional<Buffer> signature);
+#endif
+
 #ifdef OPENSSL_IS_BORINGSSL
   // SSL certificate verification callback. See SSL_CTX_set_custom_verify.
   static enum ssl_verify_result_t SSLVerifyCallback(SSL* ssl,
@@ -246,6 +327,15 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // be too aggressive for low bandwidth links.
   int dtls_handshake_timeout_ms_ = 50;
 
+  scoped_refptr<OpenSSLStreamSessionCache> session_cache_;
+
+  // Where handshake signatures are made, if not on `owner_`.
+  webrtc::TaskQueueBase* handshake_task_queue_ = nullptr;
+  // The state of the signature that is made on `handshake_task_queue_`.
+  bool signature_pending_ = false;
+  bool signature_done_ = false;
+  absl::optional<Buffer> signature_;
+
   // TODO(https://bugs.webrtc.org/10261): Completely remove this option in M84.
   const bool support_legacy_tls_protocols_flag_;
 };
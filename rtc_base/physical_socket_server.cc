@@ -105,6 +105,14 @@ typedef char* SockOptArg;
 #endif
 
 namespace {
+
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+// Upper bound on the number of datagrams read by a single recvmmsg() call.
+constexpr size_t kMaxRecvBatchSize = 64;
+// Upper bound on the number of datagrams written by a single sendmmsg() call.
+constexpr size_t kMaxSendBatchSize = 64;
+#endif
+
 class ScopedSetTrue {
  public:
   ScopedSetTrue(bool* value) : value_(value) {
@@ -446,6 +454,114 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+int PhysicalSocket::RecvFromBatch(RecvBatchEntry* entries, size_t count) {
+  if (!udp_ || count <= 1) {
+    return Socket::RecvFromBatch(entries, count);
+  }
+  count = std::min(count, kMaxRecvBatchSize);
+  if (!batch_timestamps_enabled_) {
+    // SIOCGSTAMP only reports the timestamp of the last datagram, so ask the
+    // kernel to attach a timestamp to each one instead.
+    int value = 1;
+    if (::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value)) <
+        0) {
+      RTC_LOG(LS_WARNING) << "Failed to enable SO_TIMESTAMP, error = "
+                          << errno;
+    }
+    batch_timestamps_enabled_ = true;
+  }
+
+  mmsghdr messages[kMaxRecvBatchSize];
+  iovec iovecs[kMaxRecvBatchSize];
+  sockaddr_storage addrs[kMaxRecvBatchSize];
+  char control[kMaxRecvBatchSize][CMSG_SPACE(sizeof(timeval))];
+  memset(messages, 0, sizeof(messages[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = entries[i].buffer;
+    iovecs[i].iov_len = entries[i].capacity;
+    msghdr& hdr = messages[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = sizeof(addrs[i]);
+    hdr.msg_iov = &iovecs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control[i];
+    hdr.msg_controllen = sizeof(control[i]);
+  }
+
+  int received = ::recvmmsg(s_, messages, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  for (int i = 0; i < received; ++i) {
+    RecvBatchEntry& entry = entries[i];
+    msghdr& hdr = messages[i].msg_hdr;
+    entry.length = messages[i].msg_len;
+    entry.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+    SocketAddressFromSockAddrStorage(addrs[i], &entry.source);
+    entry.timestamp = -1;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+        timeval tv;
+        memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        entry.timestamp =
+            kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+            static_cast<int64_t>(tv.tv_usec);
+        break;
+      }
+    }
+  }
+  // Errors on UDP sockets are usually ICMP errors for earlier sends, so keep
+  // reading either way.
+  EnableEvents(DE_READ);
+  if (received < 0 && !IsBlockingError(GetError())) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << GetError();
+  }
+  return received;
+}
+#endif
+
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+int PhysicalSocket::SendToBatch(const SendBatchEntry* entries, size_t count) {
+  if (!udp_ || count <= 1) {
+    return Socket::SendToBatch(entries, count);
+  }
+  count = std::min(count, kMaxSendBatchSize);
+
+  mmsghdr messages[kMaxSendBatchSize];
+  iovec iovecs[kMaxSendBatchSize];
+  sockaddr_storage addrs[kMaxSendBatchSize];
+  memset(messages, 0, sizeof(messages[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = const_cast<void*>(entries[i].data);
+    iovecs[i].iov_len = entries[i].size;
+    msghdr& hdr = messages[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen =
+        static_cast<socklen_t>(entries[i].destination.ToSockAddrStorage(
+            &addrs[i]));
+    hdr.msg_iov = &iovecs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  int sent = ::sendmmsg(s_, messages, static_cast<unsigned int>(count),
+#if !defined(WEBRTC_ANDROID)
+                        // Suppress SIGPIPE. See Send() for explanation.
+                        MSG_NOSIGNAL
+#else
+                        0
+#endif
+  );
+  UpdateLastError();
+  MaybeRemapSendError();
+  if ((sent >= 0 && sent < static_cast<int>(count)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+}
+#endif
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -600,6 +716,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_DCHECK_NOTREACHED();
       return -1;
@@ -161,6 +161,12 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+  // Uses recvmmsg() to drain several datagrams with a single system call.
+  int RecvFromBatch(RecvBatchEntry* entries, size_t count) override;
+  // Uses sendmmsg() to send several datagrams with a single system call.
+  int SendToBatch(const SendBatchEntry* entries, size_t count) override;
+#endif
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -213,6 +219,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
  private:
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+  // Set once SO_TIMESTAMP has been enabled for per-datagram timestamps.
+  bool batch_timestamps_enabled_ = false;
+#endif
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -472,6 +472,20 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+TEST_F(PhysicalSocketTest, ReusePortAllowsBindingTheSamePort) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket1(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> socket2(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket1->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, socket2->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, socket1->Bind(SocketAddress(kIPv4Loopback, 0)));
+  EXPECT_EQ(0, socket2->Bind(socket1->GetLocalAddress()));
+
+  // A socket that doesn't set the option can't share the port.
+  std::unique_ptr<Socket> socket3(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  EXPECT_EQ(-1, socket3->Bind(socket1->GetLocalAddress()));
+}
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -21,6 +21,7 @@
 #include "rtc_base/message_handler.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
@@ -32,6 +33,95 @@ const uint64_t kYearInSeconds = 365 * 24 * 60 * 60;
 
 }  // namespace
 
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    const Config& config) {
+  auto pool = make_ref_counted<RTCCertificatePool>(signaling_thread,
+                                                   worker_thread, config);
+  signaling_thread->PostTask([pool] { pool->Refill(); });
+  return pool;
+}
+
+RTCCertificatePool::RTCCertificatePool(Thread* signaling_thread,
+                                       Thread* worker_thread,
+                                       const Config& config)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      config_(config) {
+  RTC_DCHECK(signaling_thread_);
+  RTC_DCHECK(worker_thread_);
+  RTC_DCHECK(config_.key_params.IsValid());
+}
+
+RTCCertificatePool::~RTCCertificatePool() = default;
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  if (key_params != config_.key_params) {
+    return nullptr;
+  }
+  DiscardExpiredCertificates();
+  scoped_refptr<RTCCertificate> certificate;
+  if (!certificates_.empty()) {
+    // Hand out the oldest, which would be the first to expire.
+    certificate = std::move(certificates_.front().certificate);
+    certificates_.pop_front();
+  }
+  Refill();
+  return certificate;
+}
+
+size_t RTCCertificatePool::ready_count() const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return certificates_.size();
+}
+
+void RTCCertificatePool::DiscardExpiredCertificates() {
+  int64_t now_ms = TimeMillis();
+  while (!certificates_.empty() &&
+         now_ms - certificates_.front().added_ms > config_.max_age_ms) {
+    certificates_.pop_front();
+  }
+}
+
+void RTCCertificatePool::Refill() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  DiscardExpiredCertificates();
+  // Certificates are generated one at a time, so that a burst of requests
+  // doesn't monopolize the worker thread.
+  if (pending_count_ > 0 ||
+      static_cast<int>(certificates_.size()) >= config_.size) {
+    return;
+  }
+  ++pending_count_;
+  worker_thread_->PostTask(
+      [pool = scoped_refptr<RTCCertificatePool>(this)]() mutable {
+        scoped_refptr<RTCCertificate> certificate =
+            RTCCertificateGenerator::GenerateCertificate(
+                pool->config_.key_params, absl::nullopt);
+        Thread* signaling_thread = pool->signaling_thread_;
+        signaling_thread->PostTask(
+            [pool = std::move(pool), certificate = std::move(certificate)] {
+              pool->OnCertificateGenerated(certificate);
+            });
+      });
+}
+
+void RTCCertificatePool::OnCertificateGenerated(
+    scoped_refptr<RTCCertificate> certificate) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  --pending_count_;
+  if (!certificate) {
+    // Don't retry, the key parameters are not going to work next time either.
+    return;
+  }
+  certificates_.push_back({std::move(certificate), TimeMillis()});
+  Refill();
+}
+
 // static
 scoped_refptr<RTCCertificate> RTCCertificateGenerator::GenerateCertificate(
     const KeyParams& key_params,
@@ -62,9 +152,13 @@ scoped_refptr<RTCCertificate> RTCCertificateGenerator::GenerateCertificate(
   return RTCCertificate::Create(std::move(identity));
 }
 
-RTCCertificateGenerator::RTCCertificateGenerator(Thread* signaling_thread,
-                                                 Thread* worker_thread)
-    : signaling_thread_(signaling_thread), worker_thread_(worker_thread) {
+RTCCertificateGenerator::RTCCertificateGenerator(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    scoped_refptr<RTCCertificatePool> pool)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      pool_(std::move(pool)) {
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
 }
@@ -76,6 +170,18 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   RTC_DCHECK(signaling_thread_->IsCurrent());
   RTC_DCHECK(callback);
 
+  if (pool_ && !expires_ms) {
+    scoped_refptr<RTCCertificate> certificate = pool_->Take(key_params);
+    if (certificate) {
+      // Still complete asynchronously, as callers expect.
+      signaling_thread_->PostTask(
+          [certificate = std::move(certificate), cb = callback]() {
+            cb->OnSuccess(certificate);
+          });
+      return;
+    }
+  }
+
   // Create a new `RTCCertificateGenerationTask` for this generation request. It
   // is reference counted and referenced by the message data, ensuring it lives
   // until the task has completed (independent of `RTCCertificateGenerator`).
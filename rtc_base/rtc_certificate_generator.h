@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#include <deque>
+
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/ref_count.h"
@@ -50,6 +52,64 @@ class RTCCertificateGeneratorInterface {
       const scoped_refptr<RTCCertificateGeneratorCallback>& callback) = 0;
 };
 
+// Keeps a number of certificates generated ahead of time on the worker thread,
+// so that `RTCCertificateGenerator`s using the pool can hand them out without
+// waiting for key generation. Each certificate is only handed out once, and a
+// replacement is generated for it in the background. Certificates that have
+// been in the pool for longer than `Config::max_age_ms` are discarded instead
+// of being handed out, so that no certificate gets close to its expiration
+// while waiting.
+//
+// Must be used on the signaling thread, but may be destroyed on any thread.
+class RTC_EXPORT RTCCertificatePool : public RefCountInterface {
+ public:
+  struct Config {
+    // The number of certificates to keep ready. The pool is disabled if zero.
+    int size = 0;
+    // The key parameters of the pooled certificates. Requests for other
+    // parameters are not served from the pool.
+    KeyParams key_params;
+    // For how long a certificate may stay in the pool.
+    int64_t max_age_ms = 24 * 60 * 60 * 1000;
+  };
+
+  // Starts filling the pool.
+  static scoped_refptr<RTCCertificatePool> Create(Thread* signaling_thread,
+                                                  Thread* worker_thread,
+                                                  const Config& config);
+
+  // Returns a pooled certificate with `key_params`, or null if there is none
+  // ready, and tops the pool up again.
+  scoped_refptr<RTCCertificate> Take(const KeyParams& key_params);
+
+  const Config& config() const { return config_; }
+  // The number of certificates that are ready. Exposed for testing.
+  size_t ready_count() const;
+
+ protected:
+  RTCCertificatePool(Thread* signaling_thread,
+                     Thread* worker_thread,
+                     const Config& config);
+  ~RTCCertificatePool() override;
+
+ private:
+  struct PooledCertificate {
+    scoped_refptr<RTCCertificate> certificate;
+    int64_t added_ms;
+  };
+
+  void DiscardExpiredCertificates();
+  void Refill();
+  void OnCertificateGenerated(scoped_refptr<RTCCertificate> certificate);
+
+  Thread* const signaling_thread_;
+  Thread* const worker_thread_;
+  const Config config_;
+  // Oldest first.
+  std::deque<PooledCertificate> certificates_;
+  int pending_count_ = 0;
+};
+
 // Standard implementation of `RTCCertificateGeneratorInterface`.
 // The static function `GenerateCertificate` generates a certificate on the
 // current thread. The `RTCCertificateGenerator` instance generates certificates
@@ -66,7 +126,12 @@ class RTC_EXPORT RTCCertificateGenerator
       const KeyParams& key_params,
       const absl::optional<uint64_t>& expires_ms);
 
-  RTCCertificateGenerator(Thread* signaling_thread, Thread* worker_thread);
+  // If `pool` is not null, requests for certificates with the pool's key
+  // parameters and the default expiration time are served from it when it has
+  // one ready.
+  RTCCertificateGenerator(Thread* signaling_thread,
+                          Thread* worker_thread,
+                          scoped_refptr<RTCCertificatePool> pool = nullptr);
   ~RTCCertificateGenerator() override {}
 
   // `RTCCertificateGeneratorInterface` overrides.
@@ -82,6 +147,7 @@ class RTC_EXPORT RTCCertificateGenerator
  private:
   Thread* const signaling_thread_;
   Thread* const worker_thread_;
+  const scoped_refptr<RTCCertificatePool> pool_;
 };
 
 }  // namespace rtc
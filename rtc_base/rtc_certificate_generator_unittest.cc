@@ -35,6 +35,7 @@ class RTCCertificateGeneratorFixture : public RTCCertificateGeneratorCallback {
   ~RTCCertificateGeneratorFixture() override {}
 
   RTCCertificateGenerator* generator() const { return generator_.get(); }
+  Thread* worker_thread() const { return worker_thread_.get(); }
   RTCCertificate* certificate() const { return certificate_.get(); }
 
   void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
@@ -141,4 +142,38 @@ TEST_F(RTCCertificateGeneratorTest, GenerateWithInvalidParamsShouldFail) {
   EXPECT_FALSE(fixture_->certificate());
 }
 
+TEST_F(RTCCertificateGeneratorTest, GenerateAsyncFromPool) {
+  RTCCertificatePool::Config config;
+  config.size = 2;
+  config.key_params = KeyParams::ECDSA();
+  scoped_refptr<RTCCertificatePool> pool = RTCCertificatePool::Create(
+      Thread::Current(), fixture_->worker_thread(), config);
+  EXPECT_EQ_WAIT(2u, pool->ready_count(), kGenerationTimeoutMs);
+
+  RTCCertificateGenerator generator(Thread::Current(),
+                                    fixture_->worker_thread(), pool);
+  generator.GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt,
+                                     fixture_);
+  EXPECT_EQ(1u, pool->ready_count());
+  // Even a pooled certificate is delivered asynchronously.
+  EXPECT_FALSE(fixture_->GenerateAsyncCompleted());
+  EXPECT_TRUE_WAIT(fixture_->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE(fixture_->certificate());
+  // The pool is topped up again.
+  EXPECT_EQ_WAIT(2u, pool->ready_count(), kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificateGeneratorTest, PoolOnlyServesItsKeyParams) {
+  RTCCertificatePool::Config config;
+  config.size = 1;
+  config.key_params = KeyParams::ECDSA();
+  scoped_refptr<RTCCertificatePool> pool = RTCCertificatePool::Create(
+      Thread::Current(), fixture_->worker_thread(), config);
+  EXPECT_EQ_WAIT(1u, pool->ready_count(), kGenerationTimeoutMs);
+
+  EXPECT_FALSE(pool->Take(KeyParams::RSA()));
+  EXPECT_EQ(1u, pool->ready_count());
+  EXPECT_TRUE(pool->Take(KeyParams::ECDSA()));
+}
+
 }  // namespace rtc
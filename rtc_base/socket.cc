@@ -10,4 +10,32 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::RecvFromBatch(RecvBatchEntry* entries, size_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  RecvBatchEntry& entry = entries[0];
+  int received =
+      RecvFrom(entry.buffer, entry.capacity, &entry.source, &entry.timestamp);
+  if (received < 0) {
+    return received;
+  }
+  entry.length = static_cast<size_t>(received);
+  entry.truncated = false;
+  return 1;
+}
+
+int Socket::SendToBatch(const SendBatchEntry* entries, size_t count) {
+  size_t sent = 0;
+  for (; sent < count; ++sent) {
+    const SendBatchEntry& entry = entries[sent];
+    if (SendTo(entry.data, entry.size, entry.destination) < 0) {
+      return sent == 0 ? SOCKET_ERROR : static_cast<int>(sent);
+    }
+  }
+  return static_cast<int>(sent);
+}
+
+}  // namespace rtc
@@ -12,6 +12,8 @@
 #define RTC_BASE_SOCKET_H_
 
 #include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #if defined(WEBRTC_POSIX)
 #include <arpa/inet.h>
@@ -103,6 +105,37 @@ class Socket {
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+
+  // Describes the destination for one datagram received by RecvFromBatch().
+  struct RecvBatchEntry {
+    void* buffer = nullptr;
+    size_t capacity = 0;
+    // The fields below are filled in for each received datagram.
+    size_t length = 0;
+    // True if the datagram did not fit in `capacity` bytes.
+    bool truncated = false;
+    SocketAddress source;
+    // In units of microseconds, -1 if not available.
+    int64_t timestamp = -1;
+  };
+  // Receives up to `count` datagrams into `entries`. Returns the number of
+  // entries filled in, or SOCKET_ERROR with the error available through
+  // GetError(), like RecvFrom(). The default implementation receives a single
+  // datagram using RecvFrom().
+  virtual int RecvFromBatch(RecvBatchEntry* entries, size_t count);
+
+  // Describes one datagram to be sent by SendToBatch().
+  struct SendBatchEntry {
+    const void* data = nullptr;
+    size_t size = 0;
+    SocketAddress destination;
+  };
+  // Sends the datagrams in `entries`, in order. Returns the number of
+  // datagrams sent, which may be less than `count` if the socket would block,
+  // or SOCKET_ERROR if the first datagram could not be sent. The default
+  // implementation calls SendTo() for each entry.
+  virtual int SendToBatch(const SendBatchEntry* entries, size_t count);
+
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -123,6 +156,9 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_REUSEPORT,             // Whether sockets may bind the same address and
+                               // port, and share out the packets to it. Must be
+                               // set before Bind().
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -161,6 +161,17 @@ ECCurve KeyParams::ec_curve() const {
   return params_.curve;
 }
 
+bool KeyParams::operator==(const KeyParams& other) const {
+  if (type_ != other.type_) {
+    return false;
+  }
+  if (type_ == KT_RSA) {
+    return params_.rsa.mod_size == other.params_.rsa.mod_size &&
+           params_.rsa.pub_exp == other.params_.rsa.pub_exp;
+  }
+  return params_.curve == other.params_.curve;
+}
+
 KeyType IntKeyTypeFamilyToKeyType(int key_type_family) {
   return static_cast<KeyType>(key_type_family);
 }
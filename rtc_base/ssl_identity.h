@@ -72,6 +72,9 @@ class RTC_EXPORT KeyParams {
 
   KeyType type() const { return type_; }
 
+  bool operator==(const KeyParams& other) const;
+  bool operator!=(const KeyParams& other) const { return !(*this == other); }
+
  private:
   KeyType type_;
   union {
@@ -12,6 +12,7 @@
 
 #include "absl/memory/memory.h"
 #include "rtc_base/openssl_stream_adapter.h"
+#include "rtc_base/ref_counted_object.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -89,6 +90,10 @@ bool IsGcmCryptoSuiteName(const std::string& crypto_suite) {
   return (crypto_suite == kCsAeadAes256Gcm || crypto_suite == kCsAeadAes128Gcm);
 }
 
+scoped_refptr<SSLSessionCache> SSLSessionCache::Create() {
+  return make_ref_counted<OpenSSLStreamSessionCache>();
+}
+
 std::unique_ptr<SSLStreamAdapter> SSLStreamAdapter::Create(
     std::unique_ptr<StreamInterface> stream) {
   return std::make_unique<OpenSSLStreamAdapter>(std::move(stream));
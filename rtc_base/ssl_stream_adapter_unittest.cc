@@ -26,6 +26,7 @@
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/task_queue_for_test.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "test/field_trial.h"
@@ -411,6 +412,26 @@ class SSLStreamAdapterTestBase : public ::testing::Test,
     server_ssl_->SetIdentity(std::move(server_identity));
   }
 
+  // Recreates the client/server streams with the identities they had, as if
+  // the same peers connected again.
+  void ResetStreamsWithSameIdentities() {
+    std::unique_ptr<rtc::SSLIdentity> client = client_identity()->Clone();
+    std::unique_ptr<rtc::SSLIdentity> server = server_identity()->Clone();
+    CreateStreams();
+
+    client_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(client_stream_));
+    server_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(server_stream_));
+
+    client_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_ssl_->SetIdentity(std::move(client));
+    server_ssl_->SetIdentity(std::move(server));
+    identities_set_ = false;
+  }
+
   virtual void OnEvent(rtc::StreamInterface* stream, int sig, int err) {
     RTC_LOG(LS_VERBOSE) << "SSLStreamAdapterTestBase::OnEvent sig=" << sig;
 
@@ -1194,6 +1215,36 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnect) {
 // Test that we can make a handshake work if the first packet in
 // each direction is lost. This gives us predictable loss
 // rather than having to tune random
+// Test that a client and server that share session caches with earlier
+// connections between the same peers connect again, verifying the peer
+// certificates of the resumed sessions.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnectWithSessionCache) {
+  rtc::scoped_refptr<rtc::SSLSessionCache> client_cache =
+      rtc::SSLSessionCache::Create();
+  rtc::scoped_refptr<rtc::SSLSessionCache> server_cache =
+      rtc::SSLSessionCache::Create();
+  for (int i = 0; i < 2; ++i) {
+    if (i > 0) {
+      ResetStreamsWithSameIdentities();
+    }
+    client_ssl_->SetSessionCache(client_cache);
+    server_ssl_->SetSessionCache(server_cache);
+    TestHandshake();
+    EXPECT_TRUE(GetPeerCertificate(/*client=*/true));
+    EXPECT_TRUE(GetPeerCertificate(/*client=*/false));
+  }
+}
+
+// Test that a connection is made when the handshake signatures are made on
+// another task queue.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnectWithHandshakeTaskQueue) {
+  webrtc::TaskQueueForTest handshake_queue("handshake");
+  client_ssl_->SetHandshakeTaskQueue(handshake_queue.Get());
+  server_ssl_->SetHandshakeTaskQueue(handshake_queue.Get());
+  TestHandshake();
+  TestTransfer(100);
+}
+
 TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnectWithLostFirstPacket) {
   SetLoseFirstPacket(true);
   TestHandshake();
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
+#define RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+namespace webrtc {
+
+// An unbounded FIFO queue that any number of threads can push to without
+// taking a lock, and that a single consumer pops from. Pushing costs one
+// allocation and one atomic exchange. T must be default constructible and
+// movable.
+//
+// The queue also tells producers when the consumer needs a wake-up, so that
+// a consumer that is busy anyway is not signaled for every element:
+//
+//   Producer:                       Consumer:
+//     if (queue.Push(x))              while (true) {
+//       event.Set();                    while (queue.Pop(&x)) Handle(x);
+//                                       if (queue.PrepareToWait()) {
+//                                         event.Wait(...);
+//                                         queue.FinishWait();
+//                                       }
+//                                     }
+//
+// Pop(), Peek(), PrepareToWait() and FinishWait() must not be called
+// concurrently with each other, either by always calling them on the same
+// thread or by holding a lock.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  ~MpscQueue() {
+    T value;
+    while (Pop(&value)) {
+    }
+    if (tail_ != &stub_)
+      delete tail_;
+  }
+
+  // Appends `value` to the queue. May be called on any thread. Returns true
+  // if the consumer has announced that it is going to wait, in which case the
+  // caller is responsible for waking it up. At most one producer is told so
+  // per PrepareToWait().
+  bool Push(T value) {
+    Node* node = new Node(std::move(value));
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    // Until this store, neither `node` nor any element pushed after it is
+    // visible to the consumer. The store and the load below pair with
+    // PrepareToWait(): either the consumer sees the element, or the producer
+    // sees that the consumer waits.
+    previous->next.store(node, std::memory_order_seq_cst);
+    return consumer_waiting_.load(std::memory_order_seq_cst) &&
+           consumer_waiting_.exchange(false, std::memory_order_seq_cst);
+  }
+
+  // Moves the oldest element to `value` and returns true, or returns false if
+  // the queue is empty. Consumer only.
+  bool Pop(T* value) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr)
+      return false;
+
+    // `next` becomes the new stub, its moved-from value is never read again.
+    *value = std::move(next->value);
+    tail_ = next;
+    if (tail != &stub_)
+      delete tail;
+    return true;
+  }
+
+  // Returns the oldest element, or nullptr if the queue is empty. Consumer
+  // only.
+  T* Peek() {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    return next != nullptr ? &next->value : nullptr;
+  }
+
+  // Announces that the consumer is about to wait for new elements. Returns
+  // false, and does not announce anything, if elements are available already.
+  // Consumer only.
+  bool PrepareToWait() {
+    consumer_waiting_.store(true, std::memory_order_seq_cst);
+    if (tail_->next.load(std::memory_order_seq_cst) == nullptr)
+      return true;
+
+    consumer_waiting_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Withdraws the announcement made by PrepareToWait(), for when the consumer
+  // stopped waiting for another reason than a producer's wake-up. Consumer
+  // only.
+  void FinishWait() {
+    consumer_waiting_.store(false, std::memory_order_relaxed);
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(T value) : value(std::move(value)) {}
+
+    std::atomic<Node*> next{nullptr};
+    T value;
+  };
+
+  // Written by the producers.
+  std::atomic<Node*> head_;
+  std::atomic<bool> consumer_waiting_{false};
+  // Used by the consumer. Always points at a node whose value has been
+  // consumed already, or at `stub_`.
+  Node* tail_;
+  Node stub_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_MPSC_QUEUE_H_
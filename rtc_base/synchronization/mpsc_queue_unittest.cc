@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/mpsc_queue.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue;
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(&value));
+  EXPECT_EQ(queue.Peek(), nullptr);
+
+  queue.Push(1);
+  queue.Push(2);
+  ASSERT_NE(queue.Peek(), nullptr);
+  EXPECT_EQ(*queue.Peek(), 1);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 1);
+  queue.Push(3);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+TEST(MpscQueueTest, DestroysRemainingElements) {
+  auto element = std::make_shared<int>(0);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.Push(element);
+    queue.Push(element);
+    std::shared_ptr<int> popped;
+    EXPECT_TRUE(queue.Pop(&popped));
+    popped = nullptr;
+    EXPECT_EQ(element.use_count(), 2);
+  }
+  EXPECT_EQ(element.use_count(), 1);
+}
+
+TEST(MpscQueueTest, OnlyFirstPushAfterPrepareToWaitRequestsWakeUp) {
+  MpscQueue<int> queue;
+  EXPECT_FALSE(queue.Push(1));
+
+  int value = 0;
+  EXPECT_FALSE(queue.PrepareToWait());
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_TRUE(queue.PrepareToWait());
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_FALSE(queue.Push(3));
+
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_TRUE(queue.PrepareToWait());
+  queue.FinishWait();
+  EXPECT_FALSE(queue.Push(4));
+}
+
+TEST(MpscQueueTest, ManyProducersKeepTheirOwnOrder) {
+  constexpr int kNumProducers = 4;
+  constexpr int kPushesPerProducer = 10000;
+  struct Element {
+    int producer = 0;
+    int sequence_number = 0;
+  };
+  MpscQueue<Element> queue;
+  rtc::Event wake_up;
+
+  std::vector<rtc::PlatformThread> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&queue, &wake_up, i] {
+          for (int j = 0; j < kPushesPerProducer; ++j) {
+            if (queue.Push(Element{i, j}))
+              wake_up.Set();
+          }
+        },
+        "producer"));
+  }
+
+  std::vector<int> next_sequence_number(kNumProducers, 0);
+  int remaining = kNumProducers * kPushesPerProducer;
+  while (remaining > 0) {
+    Element element;
+    while (queue.Pop(&element)) {
+      EXPECT_EQ(element.sequence_number,
+                next_sequence_number[element.producer]);
+      ++next_sequence_number[element.producer];
+      --remaining;
+    }
+    if (remaining > 0 && queue.PrepareToWait()) {
+      // A lost wake-up makes this time out.
+      ASSERT_TRUE(wake_up.Wait(10000));
+      queue.FinishWait();
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_SEQLOCK_H_
+#define RTC_BASE_SYNCHRONIZATION_SEQLOCK_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+namespace webrtc {
+
+// Holds a small value that one writer at a time replaces and any number of
+// threads read without taking a lock. Readers never block the writer; they
+// retry if the value changed while they copied it, so Load() is only cheap
+// for values that are read far more often than they are written. T must be
+// trivially copyable and default constructible.
+//
+// Store() must not be called concurrently with itself, for instance by only
+// calling it with the lock that guards the state the value is derived from.
+template <typename T>
+class SeqLock {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLock copies values word by word");
+
+  SeqLock() : SeqLock(T()) {}
+  explicit SeqLock(const T& value) { Store(value); }
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  void Store(const T& value) {
+    uint64_t words[kNumWords] = {};
+    memcpy(words, &value, sizeof(T));
+    // An odd sequence number tells readers that a store is in progress.
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < kNumWords; ++i)
+      words_[i].store(words[i], std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    uint64_t words[kNumWords];
+    uint32_t sequence;
+    do {
+      sequence = sequence_.load(std::memory_order_acquire);
+      for (int i = 0; i < kNumWords; ++i)
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sequence != sequence_.load(std::memory_order_relaxed));
+    T value;
+    memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+ private:
+  static constexpr int kNumWords = (sizeof(T) + 7) / 8;
+
+  std::atomic<uint32_t> sequence_{0};
+  std::atomic<uint64_t> words_[kNumWords];
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_SEQLOCK_H_
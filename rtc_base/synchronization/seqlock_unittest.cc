@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/seqlock.h"
+
+#include <atomic>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Larger than a word, so that torn reads would show.
+struct Value {
+  int64_t a = 0;
+  int64_t b = 0;
+  int32_t c = 0;
+};
+
+TEST(SeqLockTest, LoadsLastStoredValue) {
+  SeqLock<Value> lock;
+  EXPECT_EQ(lock.Load().a, 0);
+
+  lock.Store({1, 2, 3});
+  Value value = lock.Load();
+  EXPECT_EQ(value.a, 1);
+  EXPECT_EQ(value.b, 2);
+  EXPECT_EQ(value.c, 3);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues) {
+  constexpr int kNumStores = 100000;
+  SeqLock<Value> lock;
+  std::atomic<bool> done{false};
+  std::atomic<int> num_torn{0};
+  auto reader = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        int64_t last = 0;
+        while (!done.load()) {
+          Value value = lock.Load();
+          if (value.b != 2 * value.a || value.c != -value.a || value.a < last)
+            ++num_torn;
+          last = value.a;
+        }
+      },
+      "reader");
+  for (int i = 1; i <= kNumStores; ++i)
+    lock.Store({i, 2 * i, -i});
+  done.store(true);
+  reader.Finalize();
+  EXPECT_EQ(num_torn.load(), 0);
+  EXPECT_EQ(lock.Load().a, kNumStores);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -25,6 +25,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/gcd_helpers.h"
+#include "rtc_base/task_queue_stats.h"
 
 namespace webrtc {
 namespace {
@@ -65,6 +66,8 @@ class TaskQueueGcd : public TaskQueueBase {
 
   dispatch_queue_t queue_;
   bool is_active_;
+  // Null unless task queue stats are enabled.
+  const std::unique_ptr<TaskQueueStatsCollector> stats_;
 };
 
 TaskQueueGcd::TaskQueueGcd(absl::string_view queue_name, int gcd_priority)
@@ -72,7 +75,8 @@ TaskQueueGcd::TaskQueueGcd(absl::string_view queue_name, int gcd_priority)
           std::string(queue_name).c_str(),
           DISPATCH_QUEUE_SERIAL,
           dispatch_get_global_queue(gcd_priority, 0))),
-      is_active_(true) {
+      is_active_(true),
+      stats_(TaskQueueStatsCollector::CreateIfEnabled(queue_name)) {
   RTC_CHECK(queue_);
   dispatch_set_context(queue_, this);
   // Assign a finalizer that will delete the queue when the last reference
@@ -98,12 +102,16 @@ void TaskQueueGcd::Delete() {
 }
 
 void TaskQueueGcd::PostTask(std::unique_ptr<QueuedTask> task) {
+  if (stats_)
+    task = stats_->Wrap(std::move(task));
   auto* context = new TaskContext(this, std::move(task));
   dispatch_async_f(queue_, context, &RunTask);
 }
 
 void TaskQueueGcd::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                    uint32_t milliseconds) {
+  if (stats_)
+    task = stats_->Wrap(std::move(task), TimeDelta::Millis(milliseconds));
   auto* context = new TaskContext(this, std::move(task));
   dispatch_after_f(
       dispatch_time(DISPATCH_TIME_NOW, milliseconds * NSEC_PER_MSEC), queue_,
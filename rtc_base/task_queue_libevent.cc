@@ -34,6 +34,7 @@
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_stats.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 
@@ -130,6 +131,8 @@ class TaskQueueLibevent final : public TaskQueueBase {
       RTC_GUARDED_BY(pending_lock_);
   // Holds a list of events pending timers for cleanup when the loop exits.
   std::list<TimerEvent*> pending_timers_;
+  // Null unless task queue stats are enabled.
+  const std::unique_ptr<TaskQueueStatsCollector> stats_;
 };
 
 struct TaskQueueLibevent::TimerEvent {
@@ -167,7 +170,8 @@ class TaskQueueLibevent::SetTimerTask : public QueuedTask {
 
 TaskQueueLibevent::TaskQueueLibevent(absl::string_view queue_name,
                                      rtc::ThreadPriority priority)
-    : event_base_(event_base_new()) {
+    : event_base_(event_base_new()),
+      stats_(TaskQueueStatsCollector::CreateIfEnabled(queue_name)) {
   int fds[2];
   RTC_CHECK(pipe(fds) == 0);
   SetNonBlocking(fds[0]);
@@ -220,6 +224,8 @@ void TaskQueueLibevent::Delete() {
 }
 
 void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
+  if (stats_)
+    task = stats_->Wrap(std::move(task));
   {
     MutexLock lock(&pending_lock_);
     bool had_pending_tasks = !pending_.empty();
@@ -245,6 +251,8 @@ void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
 void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                         uint32_t milliseconds) {
   if (IsCurrent()) {
+    if (stats_)
+      task = stats_->Wrap(std::move(task), TimeDelta::Millis(milliseconds));
     TimerEvent* timer = new TimerEvent(this, std::move(task));
     EventAssign(&timer->ev, event_base_, -1, 0, &TaskQueueLibevent::RunTimer,
                 timer);
@@ -253,6 +261,7 @@ void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                   rtc::dchecked_cast<int>(milliseconds % 1000) * 1000};
     event_add(&timer->ev, &tv);
   } else {
+    // The task is counted when SetTimerTask posts it again on the queue.
     PostTask(std::make_unique<SetTimerTask>(std::move(task), milliseconds));
   }
 }
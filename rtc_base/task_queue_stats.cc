@@ -0,0 +1,233 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_stats.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+std::atomic<bool> g_stats_enabled{false};
+
+struct Collectors {
+  Mutex mutex;
+  std::set<TaskQueueStatsCollector*> collectors RTC_GUARDED_BY(mutex);
+};
+
+Collectors& GetCollectors() {
+  static Collectors* const collectors = new Collectors();
+  return *collectors;
+}
+
+using SlowTaskObserver = std::function<void(const SlowTask&)>;
+
+// Infinite until an observer is set, so that the observer is only looked up
+// for tasks that are slow.
+std::atomic<int64_t> g_slow_queue_delay_us{
+    std::numeric_limits<int64_t>::max()};
+std::atomic<int64_t> g_slow_run_time_us{std::numeric_limits<int64_t>::max()};
+
+struct SlowTaskObserverHolder {
+  Mutex mutex;
+  std::shared_ptr<const SlowTaskObserver> observer RTC_GUARDED_BY(mutex);
+};
+
+SlowTaskObserverHolder& GetSlowTaskObserverHolder() {
+  static SlowTaskObserverHolder* const holder = new SlowTaskObserverHolder();
+  return *holder;
+}
+
+std::shared_ptr<const SlowTaskObserver> GetSlowTaskObserver() {
+  SlowTaskObserverHolder& holder = GetSlowTaskObserverHolder();
+  MutexLock lock(&holder.mutex);
+  return holder.observer;
+}
+
+int64_t ThresholdUs(TimeDelta threshold) {
+  return threshold.IsFinite() ? threshold.us()
+                              : std::numeric_limits<int64_t>::max();
+}
+
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  // Only the queue writes, so there is no need to compare and swap.
+  if (value > max.load(std::memory_order_relaxed))
+    max.store(value, std::memory_order_relaxed);
+}
+
+class CountedTask : public QueuedTask {
+ public:
+  CountedTask(TaskQueueStatsCollector* collector,
+              std::unique_ptr<QueuedTask> task,
+              Timestamp ready_time)
+      : collector_(collector),
+        task_(std::move(task)),
+        ready_time_(ready_time) {}
+
+  bool Run() override {
+    TaskQueueStatsCollector::ScopedTask scoped_task(collector_, ready_time_);
+    if (!task_->Run()) {
+      // The task has taken ownership of itself, e.g. to post itself again.
+      task_.release();
+    }
+    return true;
+  }
+
+ private:
+  TaskQueueStatsCollector* const collector_;
+  std::unique_ptr<QueuedTask> task_;
+  const Timestamp ready_time_;
+};
+
+}  // namespace
+
+void SetTaskQueueStatsEnabled(bool enabled) {
+  g_stats_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<TaskQueueStats> GetTaskQueueStats() {
+  std::vector<TaskQueueStats> stats;
+  Collectors& collectors = GetCollectors();
+  {
+    MutexLock lock(&collectors.mutex);
+    for (const TaskQueueStatsCollector* collector : collectors.collectors)
+      stats.push_back(collector->GetStats());
+  }
+  std::stable_sort(stats.begin(), stats.end(),
+                   [](const TaskQueueStats& a, const TaskQueueStats& b) {
+                     return a.name < b.name;
+                   });
+  return stats;
+}
+
+void SetSlowTaskObserver(TimeDelta queue_delay_threshold,
+                         TimeDelta run_time_threshold,
+                         std::function<void(const SlowTask&)> observer) {
+  SlowTaskObserverHolder& holder = GetSlowTaskObserverHolder();
+  MutexLock lock(&holder.mutex);
+  if (observer) {
+    holder.observer =
+        std::make_shared<const SlowTaskObserver>(std::move(observer));
+    g_slow_queue_delay_us.store(ThresholdUs(queue_delay_threshold),
+                                std::memory_order_relaxed);
+    g_slow_run_time_us.store(ThresholdUs(run_time_threshold),
+                             std::memory_order_relaxed);
+  } else {
+    holder.observer = nullptr;
+    g_slow_queue_delay_us.store(std::numeric_limits<int64_t>::max(),
+                                std::memory_order_relaxed);
+    g_slow_run_time_us.store(std::numeric_limits<int64_t>::max(),
+                             std::memory_order_relaxed);
+  }
+}
+
+// static
+std::unique_ptr<TaskQueueStatsCollector>
+TaskQueueStatsCollector::CreateIfEnabled(absl::string_view name) {
+  if (!g_stats_enabled.load(std::memory_order_relaxed))
+    return nullptr;
+  return absl::WrapUnique(new TaskQueueStatsCollector(name));
+}
+
+TaskQueueStatsCollector::TaskQueueStatsCollector(absl::string_view name)
+    : name_(name) {
+  Collectors& collectors = GetCollectors();
+  MutexLock lock(&collectors.mutex);
+  collectors.collectors.insert(this);
+}
+
+TaskQueueStatsCollector::~TaskQueueStatsCollector() {
+  Collectors& collectors = GetCollectors();
+  MutexLock lock(&collectors.mutex);
+  collectors.collectors.erase(this);
+}
+
+std::unique_ptr<QueuedTask> TaskQueueStatsCollector::Wrap(
+    std::unique_ptr<QueuedTask> task,
+    TimeDelta delay) {
+  return std::make_unique<CountedTask>(
+      this, std::move(task), Timestamp::Micros(rtc::TimeMicros()) + delay);
+}
+
+TaskQueueStats TaskQueueStatsCollector::GetStats() const {
+  TaskQueueStats stats;
+  stats.name = name_;
+  stats.tasks_run = tasks_run_.load(std::memory_order_relaxed);
+  stats.cpu_time =
+      TimeDelta::Micros(cpu_time_ns_.load(std::memory_order_relaxed) / 1000);
+  stats.run_time =
+      TimeDelta::Micros(run_time_us_.load(std::memory_order_relaxed));
+  stats.queue_delay =
+      TimeDelta::Micros(queue_delay_us_.load(std::memory_order_relaxed));
+  stats.max_queue_delay =
+      TimeDelta::Micros(max_queue_delay_us_.load(std::memory_order_relaxed));
+  stats.max_run_time =
+      TimeDelta::Micros(max_run_time_us_.load(std::memory_order_relaxed));
+  stats.slow_tasks = slow_tasks_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+TaskQueueStatsCollector::ScopedTask::ScopedTask(
+    TaskQueueStatsCollector* collector,
+    Timestamp ready_time,
+    const rtc::Location& posted_from)
+    : collector_(collector), posted_from_(posted_from) {
+  if (!collector_)
+    return;
+  start_us_ = rtc::TimeMicros();
+  start_cpu_ns_ = rtc::GetThreadCpuTimeNanos();
+  queue_delay_us_ = std::max<int64_t>(start_us_ - ready_time.us(), 0);
+  TRACE_EVENT_BEGIN2("webrtc", "TaskQueueStats::RunTask", "queue",
+                     TRACE_STR_COPY(collector_->name_.c_str()),
+                     "queue_delay_us", queue_delay_us_);
+}
+
+TaskQueueStatsCollector::ScopedTask::~ScopedTask() {
+  if (!collector_)
+    return;
+  TRACE_EVENT_END0("webrtc", "TaskQueueStats::RunTask");
+  int64_t run_time_us = rtc::TimeMicros() - start_us_;
+  collector_->tasks_run_.fetch_add(1, std::memory_order_relaxed);
+  collector_->cpu_time_ns_.fetch_add(
+      rtc::GetThreadCpuTimeNanos() - start_cpu_ns_, std::memory_order_relaxed);
+  collector_->run_time_us_.fetch_add(run_time_us, std::memory_order_relaxed);
+  collector_->queue_delay_us_.fetch_add(queue_delay_us_,
+                                        std::memory_order_relaxed);
+  UpdateMax(collector_->max_queue_delay_us_, queue_delay_us_);
+  UpdateMax(collector_->max_run_time_us_, run_time_us);
+
+  bool slow =
+      queue_delay_us_ > g_slow_queue_delay_us.load(std::memory_order_relaxed) ||
+      run_time_us > g_slow_run_time_us.load(std::memory_order_relaxed);
+  if (!slow)
+    return;
+  std::shared_ptr<const SlowTaskObserver> observer = GetSlowTaskObserver();
+  if (!observer)
+    return;
+  collector_->slow_tasks_.fetch_add(1, std::memory_order_relaxed);
+  SlowTask slow_task;
+  slow_task.queue_name = collector_->name_;
+  slow_task.posted_from = posted_from_;
+  slow_task.queue_delay = TimeDelta::Micros(queue_delay_us_);
+  slow_task.run_time = TimeDelta::Micros(run_time_us);
+  (*observer)(slow_task);
+}
+
+}  // namespace webrtc
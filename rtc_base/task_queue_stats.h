@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_STATS_H_
+#define RTC_BASE_TASK_QUEUE_STATS_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/location.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// What a task queue or an rtc::Thread has spent on running tasks, and on
+// messages in the case of threads, since it was created.
+struct TaskQueueStats {
+  std::string name;
+  int64_t tasks_run = 0;
+  // CPU time of the thread while it ran tasks.
+  TimeDelta cpu_time = TimeDelta::Zero();
+  // Wall clock time of running tasks.
+  TimeDelta run_time = TimeDelta::Zero();
+  // Total time tasks waited to run after they were posted, or after they
+  // became due for delayed tasks. A queue whose delay grows faster than time
+  // passes is saturated.
+  TimeDelta queue_delay = TimeDelta::Zero();
+  // The longest any single task waited, and ran.
+  TimeDelta max_queue_delay = TimeDelta::Zero();
+  TimeDelta max_run_time = TimeDelta::Zero();
+  // Tasks that exceeded either threshold of SetSlowTaskObserver().
+  int64_t slow_tasks = 0;
+};
+
+// A task that waited or ran for longer than the thresholds of
+// SetSlowTaskObserver().
+struct SlowTask {
+  absl::string_view queue_name;
+  // Only known for messages and tasks posted to an rtc::Thread, since
+  // TaskQueueBase::PostTask() takes no location.
+  rtc::Location posted_from;
+  TimeDelta queue_delay = TimeDelta::Zero();
+  TimeDelta run_time = TimeDelta::Zero();
+};
+
+// Stats are off by default, since collecting them reads the clocks twice for
+// every task, and allocates for every task posted to a task queue other than
+// TaskQueueStdlib. Turning
+// them on applies to task queues and threads created afterwards. With stats
+// on, every task is also wrapped in a "TaskQueueStats::RunTask" trace event,
+// with the name of the queue and the queue delay.
+RTC_EXPORT void SetTaskQueueStatsEnabled(bool enabled);
+
+// Returns the stats of the task queues and threads that exist and collect
+// stats, ordered by name.
+RTC_EXPORT std::vector<TaskQueueStats> GetTaskQueueStats();
+
+// Calls `observer` for every task that waited longer than
+// `queue_delay_threshold` to run, or ran for longer than
+// `run_time_threshold`, on task queues and threads that collect stats.
+// `observer` is called on the queue of the task, right after it has run, and
+// should return quickly. Passing a null `observer` stops the calls.
+RTC_EXPORT void SetSlowTaskObserver(
+    TimeDelta queue_delay_threshold,
+    TimeDelta run_time_threshold,
+    std::function<void(const SlowTask&)> observer);
+
+// Counts the tasks of one task queue or thread. Task queues wrap tasks as they
+// are posted, threads measure the messages they dispatch with ScopedTask.
+class TaskQueueStatsCollector {
+ public:
+  // Returns nullptr unless stats are enabled.
+  static std::unique_ptr<TaskQueueStatsCollector> CreateIfEnabled(
+      absl::string_view name);
+
+  TaskQueueStatsCollector(const TaskQueueStatsCollector&) = delete;
+  TaskQueueStatsCollector& operator=(const TaskQueueStatsCollector&) = delete;
+  ~TaskQueueStatsCollector();
+
+  // Returns `task`, made to count itself when it runs. The queue delay of a
+  // delayed task is counted from when `delay` has passed.
+  std::unique_ptr<QueuedTask> Wrap(std::unique_ptr<QueuedTask> task,
+                                   TimeDelta delay = TimeDelta::Zero());
+
+  // Counts a task that runs on the current thread while the object exists.
+  // Does nothing if `collector` is null.
+  class ScopedTask {
+   public:
+    // `ready_time` is when the task was posted, or became due.
+    ScopedTask(TaskQueueStatsCollector* collector,
+               Timestamp ready_time,
+               const rtc::Location& posted_from = rtc::Location());
+    ScopedTask(const ScopedTask&) = delete;
+    ScopedTask& operator=(const ScopedTask&) = delete;
+    ~ScopedTask();
+
+   private:
+    TaskQueueStatsCollector* const collector_;
+    const rtc::Location posted_from_;
+    int64_t start_us_ = 0;
+    int64_t start_cpu_ns_ = 0;
+    int64_t queue_delay_us_ = 0;
+  };
+
+  TaskQueueStats GetStats() const;
+
+ private:
+  explicit TaskQueueStatsCollector(absl::string_view name);
+
+  const std::string name_;
+  // Written on the queue, and read from any thread.
+  std::atomic<int64_t> tasks_run_{0};
+  std::atomic<int64_t> cpu_time_ns_{0};
+  std::atomic<int64_t> run_time_us_{0};
+  std::atomic<int64_t> queue_delay_us_{0};
+  std::atomic<int64_t> max_queue_delay_us_{0};
+  std::atomic<int64_t> max_run_time_us_{0};
+  std::atomic<int64_t> slow_tasks_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_STATS_H_
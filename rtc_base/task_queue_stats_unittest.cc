@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_stats.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+absl::optional<TaskQueueStats> FindStats(const std::string& name) {
+  for (const TaskQueueStats& stats : GetTaskQueueStats()) {
+    if (stats.name == name)
+      return stats;
+  }
+  return absl::nullopt;
+}
+
+struct ObservedSlowTask {
+  std::string queue_name;
+  std::string function_name;
+  TimeDelta queue_delay;
+  TimeDelta run_time;
+};
+
+class TaskQueueStatsTest : public ::testing::Test {
+ protected:
+  TaskQueueStatsTest() { SetTaskQueueStatsEnabled(true); }
+  ~TaskQueueStatsTest() override {
+    SetSlowTaskObserver(TimeDelta::PlusInfinity(), TimeDelta::PlusInfinity(),
+                        nullptr);
+    SetTaskQueueStatsEnabled(false);
+  }
+
+  void ObserveSlowTasks(TimeDelta queue_delay_threshold,
+                        TimeDelta run_time_threshold) {
+    SetSlowTaskObserver(queue_delay_threshold, run_time_threshold,
+                        [this](const SlowTask& task) {
+                          MutexLock lock(&mutex_);
+                          slow_tasks_.push_back(
+                              {std::string(task.queue_name),
+                               task.posted_from.function_name(),
+                               task.queue_delay, task.run_time});
+                        });
+  }
+
+  std::vector<ObservedSlowTask> slow_tasks() {
+    MutexLock lock(&mutex_);
+    return slow_tasks_;
+  }
+
+ private:
+  Mutex mutex_;
+  std::vector<ObservedSlowTask> slow_tasks_ RTC_GUARDED_BY(mutex_);
+};
+
+TEST(TaskQueueStatsDisabledTest, DoesNotCountTaskQueues) {
+  TaskQueueForTest queue("StatsQueue");
+  queue.SendTask([] {}, RTC_FROM_HERE);
+  EXPECT_FALSE(FindStats("StatsQueue"));
+}
+
+TEST_F(TaskQueueStatsTest, CountsTasksOfTaskQueue) {
+  TaskQueueForTest queue("StatsQueue");
+  for (int i = 0; i < 3; ++i)
+    queue.SendTask([] {}, RTC_FROM_HERE);
+
+  absl::optional<TaskQueueStats> stats = FindStats("StatsQueue");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->tasks_run, 3);
+  EXPECT_GE(stats->run_time, TimeDelta::Zero());
+  EXPECT_GE(stats->cpu_time, TimeDelta::Zero());
+}
+
+TEST_F(TaskQueueStatsTest, CountsQueueDelayOfTasksWaitingForBusyQueue) {
+  TaskQueueForTest queue("StatsQueue");
+  queue.PostTask([] { rtc::Thread::SleepMs(50); });
+  queue.SendTask([] {}, RTC_FROM_HERE);
+
+  absl::optional<TaskQueueStats> stats = FindStats("StatsQueue");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->tasks_run, 2);
+  EXPECT_GE(stats->run_time, TimeDelta::Millis(40));
+  EXPECT_GE(stats->queue_delay, TimeDelta::Millis(40));
+}
+
+TEST_F(TaskQueueStatsTest, CountsQueueDelayOfDelayedTaskFromWhenItIsDue) {
+  TaskQueueForTest queue("StatsQueue");
+  rtc::Event done;
+  queue.PostDelayedTask([&done] { done.Set(); }, 200);
+  ASSERT_TRUE(done.Wait(1000));
+  queue.WaitForPreviouslyPostedTasks();
+
+  absl::optional<TaskQueueStats> stats = FindStats("StatsQueue");
+  ASSERT_TRUE(stats);
+  EXPECT_LT(stats->queue_delay, TimeDelta::Millis(200));
+}
+
+TEST_F(TaskQueueStatsTest, CountsMessagesOfThread) {
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  thread->SetName("StatsThread", nullptr);
+  thread->Start();
+  for (int i = 0; i < 3; ++i)
+    thread->Invoke<void>(RTC_FROM_HERE, [] {});
+  // A message is counted once it has been dispatched, which may be after the
+  // Invoke() of it has returned, but before the next message is dispatched.
+  thread->Invoke<void>(RTC_FROM_HERE, [] {});
+
+  absl::optional<TaskQueueStats> stats = FindStats("StatsThread");
+  ASSERT_TRUE(stats);
+  EXPECT_GE(stats->tasks_run, 3);
+}
+
+TEST_F(TaskQueueStatsTest, KeepsLongestQueueDelayAndRunTime) {
+  TaskQueueForTest queue("StatsQueue");
+  queue.PostTask([] { rtc::Thread::SleepMs(50); });
+  for (int i = 0; i < 3; ++i)
+    queue.SendTask([] {}, RTC_FROM_HERE);
+
+  absl::optional<TaskQueueStats> stats = FindStats("StatsQueue");
+  ASSERT_TRUE(stats);
+  EXPECT_GE(stats->max_run_time, TimeDelta::Millis(40));
+  EXPECT_GE(stats->max_queue_delay, TimeDelta::Millis(40));
+  EXPECT_LE(stats->max_queue_delay, stats->queue_delay);
+}
+
+TEST_F(TaskQueueStatsTest, ReportsTasksThatRunTooLong) {
+  ObserveSlowTasks(TimeDelta::PlusInfinity(), TimeDelta::Millis(20));
+  TaskQueueForTest queue("StatsQueue");
+  queue.SendTask([] {}, RTC_FROM_HERE);
+  EXPECT_THAT(slow_tasks(), IsEmpty());
+
+  queue.SendTask([] { rtc::Thread::SleepMs(50); }, RTC_FROM_HERE);
+  std::vector<ObservedSlowTask> slow = slow_tasks();
+  ASSERT_THAT(slow, SizeIs(1));
+  EXPECT_EQ(slow[0].queue_name, "StatsQueue");
+  EXPECT_GE(slow[0].run_time, TimeDelta::Millis(40));
+  EXPECT_EQ(FindStats("StatsQueue")->slow_tasks, 1);
+}
+
+TEST_F(TaskQueueStatsTest, ReportsTasksThatWaitTooLong) {
+  ObserveSlowTasks(TimeDelta::Millis(20), TimeDelta::PlusInfinity());
+  TaskQueueForTest queue("StatsQueue");
+  queue.PostTask([] { rtc::Thread::SleepMs(50); });
+  queue.SendTask([] {}, RTC_FROM_HERE);
+
+  std::vector<ObservedSlowTask> slow = slow_tasks();
+  ASSERT_THAT(slow, SizeIs(1));
+  EXPECT_GE(slow[0].queue_delay, TimeDelta::Millis(40));
+}
+
+TEST_F(TaskQueueStatsTest, ReportsLocationOfSlowMessages) {
+  ObserveSlowTasks(TimeDelta::PlusInfinity(), TimeDelta::Millis(20));
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  thread->SetName("StatsThread", nullptr);
+  thread->Start();
+  thread->Invoke<void>(RTC_FROM_HERE_WITH_FUNCTION("SlowInvoke"),
+                       [] { rtc::Thread::SleepMs(50); });
+  thread->Invoke<void>(RTC_FROM_HERE, [] {});
+
+  std::vector<ObservedSlowTask> slow = slow_tasks();
+  ASSERT_THAT(slow, SizeIs(1));
+  EXPECT_EQ(slow[0].queue_name, "StatsThread");
+  EXPECT_EQ(slow[0].function_name, "SlowInvoke");
+}
+
+TEST_F(TaskQueueStatsTest, ForgetsDestroyedTaskQueues) {
+  {
+    TaskQueueForTest queue("StatsQueue");
+    queue.SendTask([] {}, RTC_FROM_HERE);
+    EXPECT_TRUE(FindStats("StatsQueue"));
+  }
+  EXPECT_FALSE(FindStats("StatsQueue"));
+}
+
+}  // namespace
+}  // namespace webrtc
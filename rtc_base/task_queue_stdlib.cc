@@ -13,9 +13,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
-#include <queue>
 #include <utility>
 
 #include "absl/strings/string_view.h"
@@ -25,7 +25,9 @@
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mpsc_queue.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_stats.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 
@@ -67,9 +69,18 @@ class TaskQueueStdlib final : public TaskQueueBase {
     }
   };
 
+  struct PendingEntry {
+    OrderId order_{};
+    // Only set when the queue collects stats.
+    int64_t posted_us_{};
+    std::unique_ptr<QueuedTask> task_;
+  };
+
   struct NextTask {
     bool final_task_{false};
     std::unique_ptr<QueuedTask> run_task_;
+    // When `run_task_` was posted, or became due.
+    int64_t ready_time_us_{};
     int64_t sleep_time_ms_{};
   };
 
@@ -92,12 +103,13 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
   // Holds the next order to use for the next task to be
   // put into one of the pending queues.
-  OrderId thread_posting_order_ RTC_GUARDED_BY(pending_lock_){};
+  std::atomic<OrderId> thread_posting_order_{};
 
   // The list of all pending tasks that need to be processed in the
-  // FIFO queue ordering on the worker thread.
-  std::queue<std::pair<OrderId, std::unique_ptr<QueuedTask>>> pending_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  // FIFO queue ordering on the worker thread. Posting does not take
+  // `pending_lock_`, and only signals flag_notify_ if the worker thread is
+  // waiting for it.
+  MpscQueue<PendingEntry> pending_queue_;
 
   // The list of all pending tasks that need to be processed at a future
   // time based upon a delay. On the off change the delayed task should
@@ -108,6 +120,10 @@ class TaskQueueStdlib final : public TaskQueueBase {
   std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue_
       RTC_GUARDED_BY(pending_lock_);
 
+  // Null unless task queue stats are enabled. Tasks are measured as they run
+  // rather than wrapped, so that posting doesn't allocate.
+  const std::unique_ptr<TaskQueueStatsCollector> stats_;
+
   // Contains the active worker thread assigned to processing
   // tasks (including delayed tasks).
   // Placing this last ensures the thread doesn't touch uninitialized attributes
@@ -119,6 +135,7 @@ TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
                                  rtc::ThreadPriority priority)
     : started_(/*manual_reset=*/false, /*initially_signaled=*/false),
       flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
+      stats_(TaskQueueStatsCollector::CreateIfEnabled(queue_name)),
       thread_(rtc::PlatformThread::SpawnJoinable(
           [this] {
             CurrentTaskQueueSetter set_current(this);
@@ -143,15 +160,13 @@ void TaskQueueStdlib::Delete() {
 }
 
 void TaskQueueStdlib::PostTask(std::unique_ptr<QueuedTask> task) {
-  {
-    MutexLock lock(&pending_lock_);
-    OrderId order = thread_posting_order_++;
-
-    pending_queue_.push(std::pair<OrderId, std::unique_ptr<QueuedTask>>(
-        order, std::move(task)));
-  }
-
-  NotifyWake();
+  PendingEntry entry;
+  entry.order_ = thread_posting_order_++;
+  if (stats_)
+    entry.posted_us_ = rtc::TimeMicros();
+  entry.task_ = std::move(task);
+  if (pending_queue_.Push(std::move(entry)))
+    NotifyWake();
 }
 
 void TaskQueueStdlib::PostDelayedTask(std::unique_ptr<QueuedTask> task,
@@ -187,18 +202,18 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     const auto& delay_info = delayed_entry->first;
     auto& delay_run = delayed_entry->second;
     if (tick >= delay_info.next_fire_at_ms_) {
-      if (pending_queue_.size() > 0) {
-        auto& entry = pending_queue_.front();
-        auto& entry_order = entry.first;
-        auto& entry_run = entry.second;
-        if (entry_order < delay_info.order_) {
-          result.run_task_ = std::move(entry_run);
-          pending_queue_.pop();
-          return result;
-        }
+      const auto* entry = pending_queue_.Peek();
+      if (entry && entry->order_ < delay_info.order_) {
+        PendingEntry pending;
+        pending_queue_.Pop(&pending);
+        result.run_task_ = std::move(pending.task_);
+        result.ready_time_us_ = pending.posted_us_;
+        return result;
       }
 
       result.run_task_ = std::move(delay_run);
+      result.ready_time_us_ =
+          delay_info.next_fire_at_ms_ * rtc::kNumMicrosecsPerMillisec;
       delayed_queue_.erase(delayed_entry);
       return result;
     }
@@ -206,10 +221,10 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     result.sleep_time_ms_ = delay_info.next_fire_at_ms_ - tick;
   }
 
-  if (pending_queue_.size() > 0) {
-    auto& entry = pending_queue_.front();
-    result.run_task_ = std::move(entry.second);
-    pending_queue_.pop();
+  PendingEntry entry;
+  if (pending_queue_.Pop(&entry)) {
+    result.run_task_ = std::move(entry.task_);
+    result.ready_time_us_ = entry.posted_us_;
   }
 
   return result;
@@ -227,17 +242,29 @@ void TaskQueueStdlib::ProcessTasks() {
     if (task.run_task_) {
       // process entry immediately then try again
       QueuedTask* release_ptr = task.run_task_.release();
-      if (release_ptr->Run())
+      bool delete_task;
+      {
+        TaskQueueStatsCollector::ScopedTask scoped_task(
+            stats_.get(), Timestamp::Micros(task.ready_time_us_));
+        delete_task = release_ptr->Run();
+      }
+      if (delete_task)
         delete release_ptr;
 
       // attempt to sleep again
       continue;
     }
 
+    // Tasks posted after GetNextTask() looked make PrepareToWait() fail, or
+    // signal flag_notify_.
+    if (!pending_queue_.PrepareToWait())
+      continue;
+
     if (0 == task.sleep_time_ms_)
       flag_notify_.Wait(rtc::Event::kForever);
     else
       flag_notify_.Wait(task.sleep_time_ms_);
+    pending_queue_.FinishWait();
   }
 }
 
@@ -266,6 +293,11 @@ void TaskQueueStdlib::NotifyWake() {
   // thread is notified to wake up but the task queue's thread finds nothing to
   // do so it waits once again to be signaled where such a signal may never
   // happen.
+
+  // The one exception are immediate tasks posted while the thread is busy.
+  // PostTask() only signals once the thread has announced through
+  // pending_queue_.PrepareToWait() that it is about to wait, and the thread
+  // looks at pending_queue_ once more after announcing it.
   flag_notify_.Set();
 }
 
@@ -39,6 +39,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_stats.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -192,11 +193,14 @@ class TaskQueueWin : public TaskQueueBase {
   std::queue<std::unique_ptr<QueuedTask>> pending_
       RTC_GUARDED_BY(pending_lock_);
   HANDLE in_queue_;
+  // Null unless task queue stats are enabled.
+  const std::unique_ptr<TaskQueueStatsCollector> stats_;
 };
 
 TaskQueueWin::TaskQueueWin(absl::string_view queue_name,
                            rtc::ThreadPriority priority)
-    : in_queue_(::CreateEvent(nullptr, true, false, nullptr)) {
+    : in_queue_(::CreateEvent(nullptr, true, false, nullptr)),
+      stats_(TaskQueueStatsCollector::CreateIfEnabled(queue_name)) {
   RTC_DCHECK(in_queue_);
   thread_ = rtc::PlatformThread::SpawnJoinable(
       [this] { RunThreadMain(); }, queue_name,
@@ -222,6 +226,8 @@ void TaskQueueWin::Delete() {
 }
 
 void TaskQueueWin::PostTask(std::unique_ptr<QueuedTask> task) {
+  if (stats_)
+    task = stats_->Wrap(std::move(task));
   MutexLock lock(&pending_lock_);
   pending_.push(std::move(task));
   ::SetEvent(in_queue_);
@@ -233,6 +239,8 @@ void TaskQueueWin::PostDelayedTask(std::unique_ptr<QueuedTask> task,
     PostTask(std::move(task));
     return;
   }
+  if (stats_)
+    task = stats_->Wrap(std::move(task), TimeDelta::Millis(milliseconds));
 
   // TODO(tommi): Avoid this allocation.  It is currently here since
   // the timestamp stored in the task info object, is a 64bit timestamp
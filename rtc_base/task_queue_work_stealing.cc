@@ -0,0 +1,474 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_work_stealing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/strings/string_view.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Maximum number of tasks a worker runs from one task queue in a row, before
+// it lets the other runnable task queues go first.
+constexpr int kMaxTasksPerSlice = 32;
+
+class WorkerPool;
+class WorkStealingTaskQueue;
+
+struct Worker {
+  Worker(WorkerPool* pool, size_t index) : pool(pool), index(index) {}
+
+  WorkerPool* const pool;
+  const size_t index;
+  Mutex mutex;
+  // Task queues with pending tasks, waiting for this worker or a thief.
+  std::deque<rtc::scoped_refptr<WorkStealingTaskQueue>> runnable
+      RTC_GUARDED_BY(mutex);
+  // Signaled when the worker is idle and new work is scheduled.
+  rtc::Event wake;
+  rtc::PlatformThread thread;
+};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ABSL_CONST_INIT thread_local Worker* current_worker = nullptr;
+#endif
+
+Worker* CurrentWorker() {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  return current_worker;
+#else
+  // Without thread locals, work is always scheduled through the shared queue.
+  return nullptr;
+#endif
+}
+
+void SetCurrentWorker(Worker* worker) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  current_worker = worker;
+#endif
+}
+
+// Runs the task queues on a fixed set of threads. A task queue with pending
+// tasks is put on the run queue of the worker that scheduled it, or on a
+// shared queue if it was scheduled from any other thread. Workers that run
+// out of work take a task queue from the shared queue, or steal one from
+// another worker, before going to sleep. Delayed tasks are handed to the
+// workers by a separate timer thread.
+class WorkerPool {
+ public:
+  explicit WorkerPool(int num_workers);
+  ~WorkerPool();
+
+  // Makes `queue` runnable. Must be called only once until the task queue
+  // reports that it ran out of tasks.
+  void Schedule(rtc::scoped_refptr<WorkStealingTaskQueue> queue);
+
+  // Calls ProcessDelayedTasks() on `queue` once `fire_at_ms` has passed.
+  void ScheduleTimer(rtc::scoped_refptr<WorkStealingTaskQueue> queue,
+                     int64_t fire_at_ms);
+
+ private:
+  void RunWorker(Worker* self);
+  rtc::scoped_refptr<WorkStealingTaskQueue> FindWork(Worker* self);
+  void WakeIdleWorker();
+  void RunTimer();
+
+  std::atomic<bool> quit_{false};
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  Mutex mutex_;
+  std::deque<rtc::scoped_refptr<WorkStealingTaskQueue>> injected_
+      RTC_GUARDED_BY(mutex_);
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(mutex_);
+  // Mirrors idle_workers_.size(), so that scheduling does not need to take
+  // `mutex_` when all workers are busy.
+  std::atomic<int> num_idle_workers_{0};
+
+  Mutex timer_mutex_;
+  std::multimap<int64_t, rtc::scoped_refptr<WorkStealingTaskQueue>> timers_
+      RTC_GUARDED_BY(timer_mutex_);
+  rtc::Event timer_wake_;
+  rtc::PlatformThread timer_thread_;
+};
+
+class WorkStealingTaskQueue final : public TaskQueueBase {
+ public:
+  explicit WorkStealingTaskQueue(WorkerPool* pool) : pool_(pool) {}
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+
+  void AddRef() const { ref_count_.IncRef(); }
+  void Release() const {
+    if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+      delete this;
+    }
+  }
+
+  // Runs pending tasks on the calling worker thread. Returns true if the
+  // slice ended with tasks still pending, in which case the task queue must
+  // be scheduled again.
+  bool RunTasks();
+
+  // Moves the delayed tasks that are due to the pending tasks.
+  void ProcessDelayedTasks();
+
+ private:
+  using OrderId = uint64_t;
+
+  struct DelayedEntryTimeout {
+    int64_t next_fire_at_ms_{};
+    OrderId order_{};
+
+    bool operator<(const DelayedEntryTimeout& o) const {
+      return std::tie(next_fire_at_ms_, order_) <
+             std::tie(o.next_fire_at_ms_, o.order_);
+    }
+  };
+
+  ~WorkStealingTaskQueue() override = default;
+
+  WorkerPool* const pool_;
+  // Held by the owner until Delete(), and by the pool while the task queue is
+  // runnable or has a timer pending.
+  mutable webrtc_impl::RefCounter ref_count_{1};
+
+  // Signaled when the task that was running during Delete() has returned.
+  rtc::Event run_finished_;
+
+  Mutex mutex_;
+  bool deleted_ RTC_GUARDED_BY(mutex_) = false;
+  // True while the task queue sits in a run queue or a worker runs it.
+  bool scheduled_ RTC_GUARDED_BY(mutex_) = false;
+  bool running_ RTC_GUARDED_BY(mutex_) = false;
+  OrderId next_order_ RTC_GUARDED_BY(mutex_) = 0;
+  std::queue<std::unique_ptr<QueuedTask>> pending_queue_
+      RTC_GUARDED_BY(mutex_);
+  std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue_
+      RTC_GUARDED_BY(mutex_);
+};
+
+void WorkStealingTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  // Destroyed after the lock is released, as task destructors may post tasks.
+  std::queue<std::unique_ptr<QueuedTask>> pending_queue;
+  std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    deleted_ = true;
+    pending_queue.swap(pending_queue_);
+    delayed_queue.swap(delayed_queue_);
+    running = running_;
+  }
+
+  if (running)
+    run_finished_.Wait(rtc::Event::kForever);
+
+  Release();
+}
+
+void WorkStealingTaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  bool schedule = false;
+  {
+    MutexLock lock(&mutex_);
+    if (deleted_)
+      return;
+
+    pending_queue_.push(std::move(task));
+    if (!scheduled_) {
+      scheduled_ = true;
+      schedule = true;
+    }
+  }
+
+  if (schedule)
+    pool_->Schedule(rtc::scoped_refptr<WorkStealingTaskQueue>(this));
+}
+
+void WorkStealingTaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                            uint32_t milliseconds) {
+  DelayedEntryTimeout delay;
+  delay.next_fire_at_ms_ = rtc::TimeMillis() + milliseconds;
+
+  {
+    MutexLock lock(&mutex_);
+    if (deleted_)
+      return;
+
+    delay.order_ = next_order_++;
+    delayed_queue_[delay] = std::move(task);
+  }
+
+  pool_->ScheduleTimer(rtc::scoped_refptr<WorkStealingTaskQueue>(this),
+                       delay.next_fire_at_ms_);
+}
+
+bool WorkStealingTaskQueue::RunTasks() {
+  CurrentTaskQueueSetter set_current(this);
+
+  for (int i = 0;; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      MutexLock lock(&mutex_);
+      if (running_) {
+        running_ = false;
+        if (deleted_)
+          run_finished_.Set();
+      }
+      if (deleted_ || pending_queue_.empty()) {
+        scheduled_ = false;
+        return false;
+      }
+      if (i == kMaxTasksPerSlice)
+        return true;
+
+      task = std::move(pending_queue_.front());
+      pending_queue_.pop();
+      running_ = true;
+    }
+
+    QueuedTask* release_ptr = task.release();
+    if (release_ptr->Run())
+      delete release_ptr;
+  }
+}
+
+void WorkStealingTaskQueue::ProcessDelayedTasks() {
+  const int64_t tick = rtc::TimeMillis();
+  {
+    MutexLock lock(&mutex_);
+    while (!delayed_queue_.empty() &&
+           delayed_queue_.begin()->first.next_fire_at_ms_ <= tick) {
+      pending_queue_.push(std::move(delayed_queue_.begin()->second));
+      delayed_queue_.erase(delayed_queue_.begin());
+    }
+    if (pending_queue_.empty() || scheduled_)
+      return;
+
+    scheduled_ = true;
+  }
+
+  pool_->Schedule(rtc::scoped_refptr<WorkStealingTaskQueue>(this));
+}
+
+WorkerPool::WorkerPool(int num_workers) {
+  RTC_DCHECK_GT(num_workers, 0);
+  for (int i = 0; i < num_workers; ++i) {
+    workers_.push_back(std::make_unique<Worker>(this, i));
+  }
+  // The workers look at each other's run queues, so all of them must exist
+  // before the first thread starts.
+  for (auto& worker : workers_) {
+    Worker* self = worker.get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, self] { RunWorker(self); },
+        "TaskQueueWorker" + std::to_string(self->index));
+  }
+  timer_thread_ = rtc::PlatformThread::SpawnJoinable([this] { RunTimer(); },
+                                                     "TaskQueueTimer");
+}
+
+WorkerPool::~WorkerPool() {
+  quit_.store(true);
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+  }
+  timer_wake_.Set();
+  for (auto& worker : workers_) {
+    worker->thread.Finalize();
+  }
+  timer_thread_.Finalize();
+}
+
+void WorkerPool::Schedule(rtc::scoped_refptr<WorkStealingTaskQueue> queue) {
+  Worker* worker = CurrentWorker();
+  if (worker != nullptr && worker->pool == this) {
+    MutexLock lock(&worker->mutex);
+    worker->runnable.push_back(std::move(queue));
+  } else {
+    MutexLock lock(&mutex_);
+    injected_.push_back(std::move(queue));
+  }
+
+  // Pairs with the increment in RunWorker(): either the idle worker sees the
+  // task queue when it looks again, or it is woken up here.
+  if (num_idle_workers_.load() > 0)
+    WakeIdleWorker();
+}
+
+void WorkerPool::ScheduleTimer(rtc::scoped_refptr<WorkStealingTaskQueue> queue,
+                               int64_t fire_at_ms) {
+  bool earliest;
+  {
+    MutexLock lock(&timer_mutex_);
+    earliest = timers_.empty() || fire_at_ms < timers_.begin()->first;
+    timers_.emplace(fire_at_ms, std::move(queue));
+  }
+
+  if (earliest)
+    timer_wake_.Set();
+}
+
+void WorkerPool::RunWorker(Worker* self) {
+  SetCurrentWorker(self);
+
+  while (!quit_.load()) {
+    rtc::scoped_refptr<WorkStealingTaskQueue> queue = FindWork(self);
+    if (!queue) {
+      {
+        MutexLock lock(&mutex_);
+        idle_workers_.push_back(self);
+        num_idle_workers_.fetch_add(1);
+      }
+
+      // Look again, or work scheduled before this worker was visible as idle
+      // could be left behind.
+      queue = FindWork(self);
+      if (!queue) {
+        self->wake.Wait(rtc::Event::kForever);
+        continue;
+      }
+
+      MutexLock lock(&mutex_);
+      auto it = std::find(idle_workers_.begin(), idle_workers_.end(), self);
+      if (it != idle_workers_.end()) {
+        idle_workers_.erase(it);
+        num_idle_workers_.fetch_sub(1);
+      }
+    }
+
+    if (queue->RunTasks())
+      Schedule(std::move(queue));
+  }
+
+  SetCurrentWorker(nullptr);
+}
+
+rtc::scoped_refptr<WorkStealingTaskQueue> WorkerPool::FindWork(Worker* self) {
+  rtc::scoped_refptr<WorkStealingTaskQueue> queue;
+  {
+    MutexLock lock(&self->mutex);
+    if (!self->runnable.empty()) {
+      queue = std::move(self->runnable.front());
+      self->runnable.pop_front();
+      return queue;
+    }
+  }
+  {
+    MutexLock lock(&mutex_);
+    if (!injected_.empty()) {
+      queue = std::move(injected_.front());
+      injected_.pop_front();
+      return queue;
+    }
+  }
+
+  // Steal the task queue that has waited the longest from the first busy
+  // worker, starting with the next one so that thieves spread out.
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(self->index + i) % workers_.size()].get();
+    MutexLock lock(&victim->mutex);
+    if (!victim->runnable.empty()) {
+      queue = std::move(victim->runnable.front());
+      victim->runnable.pop_front();
+      return queue;
+    }
+  }
+  return queue;
+}
+
+void WorkerPool::WakeIdleWorker() {
+  Worker* worker;
+  {
+    MutexLock lock(&mutex_);
+    if (idle_workers_.empty())
+      return;
+
+    worker = idle_workers_.back();
+    idle_workers_.pop_back();
+    num_idle_workers_.fetch_sub(1);
+  }
+  worker->wake.Set();
+}
+
+void WorkerPool::RunTimer() {
+  while (!quit_.load()) {
+    std::vector<rtc::scoped_refptr<WorkStealingTaskQueue>> due;
+    int wait_ms = rtc::Event::kForever;
+    {
+      MutexLock lock(&timer_mutex_);
+      const int64_t tick = rtc::TimeMillis();
+      while (!timers_.empty() && timers_.begin()->first <= tick) {
+        due.push_back(std::move(timers_.begin()->second));
+        timers_.erase(timers_.begin());
+      }
+      if (!timers_.empty())
+        wait_ms = static_cast<int>(timers_.begin()->first - tick);
+    }
+
+    for (auto& queue : due) {
+      queue->ProcessDelayedTasks();
+    }
+    if (due.empty())
+      timer_wake_.Wait(wait_ms);
+  }
+}
+
+class TaskQueueWorkStealingFactory final : public TaskQueueFactory {
+ public:
+  explicit TaskQueueWorkStealingFactory(int num_worker_threads)
+      : pool_(std::make_unique<WorkerPool>(num_worker_threads)) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new WorkStealingTaskQueue(pool_.get()));
+  }
+
+ private:
+  const std::unique_ptr<WorkerPool> pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueWorkStealingFactory(
+    int num_worker_threads) {
+  return std::make_unique<TaskQueueWorkStealingFactory>(num_worker_threads);
+}
+
+}  // namespace webrtc
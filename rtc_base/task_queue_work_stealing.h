@@ -0,0 +1,35 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
+#define RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates a factory whose task queues all share a fixed pool of
+// `num_worker_threads` threads, instead of owning one thread each. Every task
+// queue still runs its tasks in FIFO order, one at a time, with
+// TaskQueueBase::Current() pointing at it. A task queue with pending tasks is
+// picked up by whichever worker is free, and idle workers steal runnable task
+// queues from busy ones. This suits servers with many mostly idle task queues.
+//
+// The requested priority is ignored, all workers run at normal priority. The
+// factory owns the worker threads and must outlive all task queues created by
+// it.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueWorkStealingFactory(
+    int num_worker_threads);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
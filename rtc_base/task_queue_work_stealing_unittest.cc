@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2021 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_work_stealing.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<TaskQueueFactory> CreateSingleWorkerFactory() {
+  return CreateTaskQueueWorkStealingFactory(1);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateFourWorkersFactory() {
+  return CreateTaskQueueWorkStealingFactory(4);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkStealingSingleWorker,
+                         TaskQueueTest,
+                         ::testing::Values(CreateSingleWorkerFactory));
+
+INSTANTIATE_TEST_SUITE_P(WorkStealingFourWorkers,
+                         TaskQueueTest,
+                         ::testing::Values(CreateFourWorkersFactory));
+
+TEST(TaskQueueWorkStealingTest, ManyQueuesKeepFifoOrderAndCurrent) {
+  constexpr int kNumQueues = 100;
+  constexpr int kTasksPerQueue = 100;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueWorkStealingFactory(4);
+
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(factory->CreateTaskQueue(
+        "queue", TaskQueueFactory::Priority::NORMAL));
+  }
+
+  // Each task queue has its own counter, which is not protected by a lock and
+  // must only ever be touched by one task at a time, in posting order.
+  std::vector<int> next_task(kNumQueues, 0);
+  std::atomic<int> failures(0);
+  std::atomic<int> remaining(kNumQueues * kTasksPerQueue);
+  rtc::Event done;
+  for (int task = 0; task < kTasksPerQueue; ++task) {
+    for (int i = 0; i < kNumQueues; ++i) {
+      TaskQueueBase* queue = queues[i].get();
+      int* counter = &next_task[i];
+      queue->PostTask(ToQueuedTask([&, queue, counter, task] {
+        if (TaskQueueBase::Current() != queue || *counter != task)
+          failures.fetch_add(1);
+        ++*counter;
+        if (remaining.fetch_sub(1) == 1)
+          done.Set();
+      }));
+    }
+  }
+
+  EXPECT_TRUE(done.Wait(10000));
+  EXPECT_EQ(failures.load(), 0);
+  for (int i = 0; i < kNumQueues; ++i) {
+    EXPECT_EQ(next_task[i], kTasksPerQueue);
+  }
+}
+
+TEST(TaskQueueWorkStealingTest, BlockedWorkerDoesNotBlockOtherQueues) {
+  rtc::Event blocking_task_started;
+  rtc::Event unblock;
+  rtc::Event other_task_ran;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueWorkStealingFactory(2);
+  auto blocked_queue =
+      factory->CreateTaskQueue("blocked", TaskQueueFactory::Priority::NORMAL);
+  auto other_queue =
+      factory->CreateTaskQueue("other", TaskQueueFactory::Priority::NORMAL);
+
+  blocked_queue->PostTask(ToQueuedTask([&] {
+    blocking_task_started.Set();
+    unblock.Wait(rtc::Event::kForever);
+  }));
+  ASSERT_TRUE(blocking_task_started.Wait(1000));
+
+  other_queue->PostTask(ToQueuedTask([&] { other_task_ran.Set(); }));
+  EXPECT_TRUE(other_task_ran.Wait(1000));
+
+  unblock.Set();
+}
+
+TEST(TaskQueueWorkStealingTest, DeleteWaitsForRunningTask) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueWorkStealingFactory(2);
+  auto queue =
+      factory->CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event task_started;
+  std::atomic<bool> task_finished(false);
+  bool pending_task_ran = false;
+  queue->PostTask(ToQueuedTask([&] {
+    task_started.Set();
+    SleepMs(100);
+    task_finished = true;
+  }));
+  queue->PostTask(ToQueuedTask([&] { pending_task_ran = true; }));
+  ASSERT_TRUE(task_started.Wait(1000));
+
+  queue = nullptr;
+  EXPECT_TRUE(task_finished);
+  EXPECT_FALSE(pending_task_ran);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
+
+#include <utility>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+MetronomeTaskScheduler::MetronomeTaskScheduler(Clock* clock,
+                                               Metronome* metronome,
+                                               TaskQueueBase* task_queue)
+    : clock_(clock), metronome_(metronome), task_queue_(task_queue) {
+  RTC_DCHECK(clock_);
+  RTC_DCHECK(metronome_);
+  RTC_DCHECK(task_queue_);
+}
+
+MetronomeTaskScheduler::~MetronomeTaskScheduler() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  if (listening_)
+    metronome_->RemoveListener(this);
+}
+
+void MetronomeTaskScheduler::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                             TimeDelta delay) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK_GE(delay, TimeDelta::Zero());
+  tasks_.emplace(clock_->CurrentTime() + delay, std::move(task));
+  if (!listening_) {
+    RTC_DLOG(LS_VERBOSE) << "Listening to metronome";
+    metronome_->AddListener(this);
+    listening_ = true;
+  }
+}
+
+void MetronomeTaskScheduler::MaybeStopListening() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  if (!listening_ || !tasks_.empty())
+    return;
+  RTC_DLOG(LS_VERBOSE) << "Not listening to metronome";
+  metronome_->RemoveListener(this);
+  listening_ = false;
+}
+
+void MetronomeTaskScheduler::OnTick() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  // Take the due tasks out before running any of them, since they may post
+  // new tasks, which must wait for a later tick even with a zero delay.
+  auto due_end = tasks_.upper_bound(clock_->CurrentTime());
+  std::vector<std::unique_ptr<QueuedTask>> due_tasks;
+  for (auto it = tasks_.begin(); it != due_end; ++it)
+    due_tasks.push_back(std::move(it->second));
+  tasks_.erase(tasks_.begin(), due_end);
+
+  for (std::unique_ptr<QueuedTask>& task : due_tasks) {
+    // Run() returns false if the task has taken ownership of itself.
+    if (!task->Run())
+      task.release();
+  }
+
+  // Listeners must not be removed from within OnTick().
+  if (tasks_.empty()) {
+    task_queue_->PostTask(
+        ToQueuedTask(safety_.flag(), [this] { MaybeStopListening(); }));
+  }
+}
+
+TaskQueueBase* MetronomeTaskScheduler::OnTickTaskQueue() {
+  return task_queue_;
+}
+
+}  // namespace webrtc
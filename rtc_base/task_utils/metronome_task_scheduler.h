@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_METRONOME_TASK_SCHEDULER_H_
+#define RTC_BASE_TASK_UTILS_METRONOME_TASK_SCHEDULER_H_
+
+#include <map>
+#include <memory>
+
+#include "api/metronome/metronome.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// MetronomeTaskScheduler runs delayed tasks on the ticks of a metronome, so
+// that the timers of all streams sharing a task queue are served by a single
+// wake-up per tick instead of one wake-up each.
+//
+// A task runs on the first tick at which its delay has passed, i.e. it never
+// runs early and runs at most one tick period late. That suits timers which
+// tolerate this much jitter, such as RTCP reports, NACK processing and stats
+// polling, but not work that needs precise timing, such as pacing.
+//
+// The scheduler only listens to the metronome while it has tasks pending.
+//
+// MetronomeTaskScheduler is single threaded - all method calls must run on the
+// `task_queue_`, which is also where the tasks run.
+class MetronomeTaskScheduler : private Metronome::TickListener {
+ public:
+  MetronomeTaskScheduler(Clock* clock,
+                         Metronome* metronome,
+                         TaskQueueBase* task_queue);
+  ~MetronomeTaskScheduler() override;
+  MetronomeTaskScheduler(const MetronomeTaskScheduler&) = delete;
+  MetronomeTaskScheduler& operator=(const MetronomeTaskScheduler&) = delete;
+
+  Clock* clock() const { return clock_; }
+  TaskQueueBase* task_queue() const { return task_queue_; }
+
+  // Runs `task` on the first metronome tick at which `delay` has passed. Tasks
+  // that are due on the same tick run in the order they were posted.
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task, TimeDelta delay);
+
+ private:
+  void MaybeStopListening();
+
+  // Metronome::TickListener implementation.
+  void OnTick() override;
+  TaskQueueBase* OnTickTaskQueue() override;
+
+  Clock* const clock_;
+  Metronome* const metronome_;
+  TaskQueueBase* const task_queue_;
+
+  bool listening_ RTC_GUARDED_BY(task_queue_) = false;
+  std::multimap<Timestamp, std::unique_ptr<QueuedTask>> tasks_
+      RTC_GUARDED_BY(task_queue_);
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_METRONOME_TASK_SCHEDULER_H_
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
+
+#include <vector>
+
+#include "api/metronome/test/fake_metronome.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr TimeDelta kTickPeriod = TimeDelta::Millis(10);
+
+class MetronomeTaskSchedulerTest : public ::testing::Test {
+ public:
+  MetronomeTaskSchedulerTest()
+      : time_controller_(Timestamp::Millis(1337)),
+        metronome_(kTickPeriod),
+        scheduler_(time_controller_.GetClock(),
+                   &metronome_,
+                   time_controller_.GetMainThread()) {}
+
+ protected:
+  // Advances the time by `duration`, then ticks the metronome and runs what
+  // the tick posted.
+  void AdvanceTimeAndTick(TimeDelta duration) {
+    time_controller_.AdvanceTime(duration);
+    metronome_.Tick();
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  test::ForcedTickMetronome metronome_;
+  MetronomeTaskScheduler scheduler_;
+};
+
+TEST_F(MetronomeTaskSchedulerTest, RunsTaskOnFirstTickAfterDelay) {
+  int runs = 0;
+  scheduler_.PostDelayedTask(ToQueuedTask([&runs] { ++runs; }),
+                             TimeDelta::Millis(25));
+
+  AdvanceTimeAndTick(kTickPeriod);
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(runs, 0);
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(runs, 1);
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(runs, 1);
+}
+
+TEST_F(MetronomeTaskSchedulerTest, RunsTasksDueOnSameTickInPostingOrder) {
+  std::vector<int> order;
+  scheduler_.PostDelayedTask(ToQueuedTask([&order] { order.push_back(1); }),
+                             TimeDelta::Millis(5));
+  scheduler_.PostDelayedTask(ToQueuedTask([&order] { order.push_back(2); }),
+                             TimeDelta::Millis(2));
+  scheduler_.PostDelayedTask(ToQueuedTask([&order] { order.push_back(3); }),
+                             TimeDelta::Millis(5));
+
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_THAT(order, ElementsAre(2, 1, 3));
+}
+
+TEST_F(MetronomeTaskSchedulerTest, TaskPostedFromTaskWaitsForNextTick) {
+  int runs = 0;
+  scheduler_.PostDelayedTask(ToQueuedTask([&] {
+                               scheduler_.PostDelayedTask(
+                                   ToQueuedTask([&runs] { ++runs; }),
+                                   TimeDelta::Zero());
+                             }),
+                             TimeDelta::Zero());
+
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(runs, 0);
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(runs, 1);
+}
+
+TEST_F(MetronomeTaskSchedulerTest, ListensToMetronomeOnlyWithPendingTasks) {
+  EXPECT_EQ(metronome_.NumListeners(), 0u);
+  scheduler_.PostDelayedTask(ToQueuedTask([] {}), TimeDelta::Millis(5));
+  EXPECT_EQ(metronome_.NumListeners(), 1u);
+
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(metronome_.NumListeners(), 0u);
+}
+
+TEST_F(MetronomeTaskSchedulerTest, RepeatingTaskKeepsItsAverageInterval) {
+  constexpr TimeDelta kInterval = TimeDelta::Millis(15);
+  std::vector<Timestamp> run_times;
+  RepeatingTaskHandle handle = RepeatingTaskHandle::DelayedStart(
+      &scheduler_, kInterval, [&] {
+        run_times.push_back(time_controller_.GetClock()->CurrentTime());
+        return kInterval;
+      });
+
+  const Timestamp start = time_controller_.GetClock()->CurrentTime();
+  for (int i = 0; i < 8; ++i)
+    AdvanceTimeAndTick(kTickPeriod);
+  // Due at 15, 30, 45, 60 and 75 ms, run on the first tick after each.
+  EXPECT_THAT(run_times,
+              ElementsAre(start + TimeDelta::Millis(20),
+                          start + TimeDelta::Millis(30),
+                          start + TimeDelta::Millis(50),
+                          start + TimeDelta::Millis(60),
+                          start + TimeDelta::Millis(80)));
+
+  handle.Stop();
+  AdvanceTimeAndTick(kTickPeriod);
+  AdvanceTimeAndTick(kTickPeriod);
+  EXPECT_EQ(run_times.size(), 5u);
+  EXPECT_EQ(metronome_.NumListeners(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -24,10 +24,12 @@ RepeatingTaskBase::RepeatingTaskBase(
     TaskQueueBase::DelayPrecision precision,
     TimeDelta first_delay,
     Clock* clock,
-    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag)
+    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag,
+    MetronomeTaskScheduler* scheduler)
     : task_queue_(task_queue),
       precision_(precision),
       clock_(clock),
+      scheduler_(scheduler),
       next_run_time_(clock_->CurrentTime() + first_delay),
       alive_flag_(std::move(alive_flag)) {}
 
@@ -53,8 +55,12 @@ bool RepeatingTaskBase::Run() {
   delay -= lost_time;
   delay = std::max(delay, TimeDelta::Zero());
 
-  task_queue_->PostDelayedTaskWithPrecision(precision_, absl::WrapUnique(this),
-                                            delay.ms());
+  if (scheduler_) {
+    scheduler_->PostDelayedTask(absl::WrapUnique(this), delay);
+  } else {
+    task_queue_->PostDelayedTaskWithPrecision(precision_, absl::WrapUnique(this),
+                                              delay.ms());
+  }
 
   // Return false to tell the TaskQueue to not destruct this object since we
   // have taken ownership with absl::WrapUnique.
@@ -19,6 +19,7 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "system_wrappers/include/clock.h"
 
@@ -37,7 +38,8 @@ class RepeatingTaskBase : public QueuedTask {
                     TaskQueueBase::DelayPrecision precision,
                     TimeDelta first_delay,
                     Clock* clock,
-                    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag);
+                    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag,
+                    MetronomeTaskScheduler* scheduler = nullptr);
   ~RepeatingTaskBase() override;
 
  private:
@@ -48,6 +50,8 @@ class RepeatingTaskBase : public QueuedTask {
   TaskQueueBase* const task_queue_;
   const TaskQueueBase::DelayPrecision precision_;
   Clock* const clock_;
+  // If set, repetitions are posted to `scheduler_` instead of `task_queue_`.
+  MetronomeTaskScheduler* const scheduler_;
   // This is always finite.
   Timestamp next_run_time_ RTC_GUARDED_BY(task_queue_);
   rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag_
@@ -66,12 +70,14 @@ class RepeatingTaskImpl final : public RepeatingTaskBase {
                     TimeDelta first_delay,
                     Closure&& closure,
                     Clock* clock,
-                    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag)
+                    rtc::scoped_refptr<PendingTaskSafetyFlag> alive_flag,
+                    MetronomeTaskScheduler* scheduler = nullptr)
       : RepeatingTaskBase(task_queue,
                           precision,
                           first_delay,
                           clock,
-                          std::move(alive_flag)),
+                          std::move(alive_flag),
+                          scheduler),
         closure_(std::forward<Closure>(closure)) {
     static_assert(
         std::is_same<TimeDelta,
@@ -149,6 +155,27 @@ class RepeatingTaskHandle {
     return RepeatingTaskHandle(std::move(alive_flag));
   }
 
+  // DelayedStart is equivalent to the above except that the closure runs on
+  // the metronome ticks of `scheduler`, on the scheduler's task queue. This
+  // coalesces the wake-ups of all tasks started on the same scheduler; see
+  // MetronomeTaskScheduler for how that affects the timing. Unlike the above,
+  // this must be called on the scheduler's task queue.
+  template <class Closure>
+  static RepeatingTaskHandle DelayedStart(MetronomeTaskScheduler* scheduler,
+                                          TimeDelta first_delay,
+                                          Closure&& closure) {
+    auto alive_flag = PendingTaskSafetyFlag::CreateDetached();
+    webrtc_repeating_task_impl::RepeatingTaskHandleDTraceProbeDelayedStart();
+    scheduler->PostDelayedTask(
+        std::make_unique<
+            webrtc_repeating_task_impl::RepeatingTaskImpl<Closure>>(
+            scheduler->task_queue(), TaskQueueBase::DelayPrecision::kLow,
+            first_delay, std::forward<Closure>(closure), scheduler->clock(),
+            alive_flag, scheduler),
+        first_delay);
+    return RepeatingTaskHandle(std::move(alive_flag));
+  }
+
   // Stops future invocations of the repeating task closure. Can only be called
   // from the TaskQueue where the task is running. The closure is guaranteed to
   // not be running after Stop() returns unless Stop() is called from the
@@ -429,6 +429,13 @@ SocketServer* Thread::socketserver() {
   return ss_;
 }
 
+void Thread::MoveIncomingMessages() const {
+  Message msg;
+  while (incoming_messages_.Pop(&msg)) {
+    messages_.push_back(msg);
+  }
+}
+
 void Thread::WakeUpSocketServer() {
   ss_->WakeUp();
 }
@@ -484,6 +491,7 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
       // Otherwise, disposed MessageHandlers will cause deadlocks.
       {
         CritScope cs(&crit_);
+        MoveIncomingMessages();
         // On the first pass, check for delayed messages that have been
         // triggered and calculate the next trigger time.
         if (first_pass) {
@@ -532,8 +540,23 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
     }
 
     {
+      // Messages posted since the queue was checked above did not wake up the
+      // socket server, pick them up instead of waiting.
+      bool wait;
+      {
+        CritScope cs(&crit_);
+        wait = incoming_messages_.PrepareToWait();
+      }
+      if (!wait)
+        continue;
+
       // Wait and multiplex in the meantime
-      if (!ss_->Wait(static_cast<int>(cmsNext), process_io))
+      bool waited = ss_->Wait(static_cast<int>(cmsNext), process_io);
+      {
+        CritScope cs(&crit_);
+        incoming_messages_.FinishWait();
+      }
+      if (!waited)
         return false;
     }
 
@@ -562,18 +585,18 @@ void Thread::Post(const Location& posted_from,
 
   // Keep thread safe
   // Add the message to the end of the queue
-  // Signal for the multiplexer to return
+  // Signal for the multiplexer to return, unless the thread is busy and will
+  // look at the queue before it waits again
 
-  {
-    CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
-    messages_.push_back(msg);
-  }
-  WakeUpSocketServer();
+  Message msg;
+  msg.posted_from = posted_from;
+  msg.phandler = phandler;
+  msg.message_id = id;
+  msg.pdata = pdata;
+  if (stats_)
+    msg.ready_time_us = TimeMicros();
+  if (incoming_messages_.Push(msg))
+    WakeUpSocketServer();
 }
 
 void Thread::PostDelayed(const Location& posted_from,
@@ -616,6 +639,8 @@ void Thread::DoDelayPost(const Location& posted_from,
     msg.phandler = phandler;
     msg.message_id = id;
     msg.pdata = pdata;
+    if (stats_)
+      msg.ready_time_us = run_at_ms * kNumMicrosecsPerMillisec;
     DelayedMessage delayed(delay_ms, run_at_ms, delayed_next_num_, msg);
     delayed_messages_.push(delayed);
     // If this message queue processes 1 message every millisecond for 50 days,
@@ -629,6 +654,7 @@ void Thread::DoDelayPost(const Location& posted_from,
 
 int Thread::GetDelay() {
   CritScope cs(&crit_);
+  MoveIncomingMessages();
 
   if (!messages_.empty())
     return 0;
@@ -646,6 +672,8 @@ int Thread::GetDelay() {
 void Thread::ClearInternal(MessageHandler* phandler,
                            uint32_t id,
                            MessageList* removed) {
+  MoveIncomingMessages();
+
   // Remove messages with phandler
 
   if (fPeekKeep_ && msgPeek_.Match(phandler, id)) {
@@ -697,7 +725,12 @@ void Thread::Dispatch(Message* pmsg) {
                pmsg->posted_from.function_name());
   RTC_DCHECK_RUN_ON(this);
   int64_t start_time = TimeMillis();
-  pmsg->phandler->OnMessage(pmsg);
+  {
+    webrtc::TaskQueueStatsCollector::ScopedTask scoped_task(
+        stats_.get(), webrtc::Timestamp::Micros(pmsg->ready_time_us),
+        pmsg->posted_from);
+    pmsg->phandler->OnMessage(pmsg);
+  }
   int64_t end_time = TimeMillis();
   int64_t diff = TimeDiff(end_time, start_time);
   if (diff >= dispatch_warning_ms_) {
@@ -781,6 +814,8 @@ bool Thread::Start() {
   ThreadManager::Instance();
 
   owned_ = true;
+  if (!stats_)
+    stats_ = webrtc::TaskQueueStatsCollector::CreateIfEnabled(name_);
 
 #if defined(WEBRTC_WIN)
   thread_ = CreateThread(nullptr, 0, PreRun, this, 0, &thread_id_);
@@ -947,17 +982,20 @@ void Thread::Send(const Location& posted_from,
     done_event.reset(new rtc::Event());
 
   bool ready = false;
-  PostTask(webrtc::ToQueuedTask(
-      [&msg]() mutable { msg.phandler->OnMessage(&msg); },
-      [this, &ready, current_thread, done = done_event.get()] {
-        if (current_thread) {
-          CritScope cs(&crit_);
-          ready = true;
-          current_thread->socketserver()->WakeUp();
-        } else {
-          done->Set();
-        }
-      }));
+  // Posted with the location of the caller rather than through PostTask(), so
+  // that slow task observers can tell who sent it.
+  Post(posted_from, &queued_task_handler_, /*id=*/0,
+       new ScopedMessageData<webrtc::QueuedTask>(webrtc::ToQueuedTask(
+           [&msg]() mutable { msg.phandler->OnMessage(&msg); },
+           [this, &ready, current_thread, done = done_event.get()] {
+             if (current_thread) {
+               CritScope cs(&crit_);
+               ready = true;
+               current_thread->socketserver()->WakeUp();
+             } else {
+               done->Set();
+             }
+           })));
 
   if (current_thread) {
     bool waited = false;
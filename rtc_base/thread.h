@@ -35,7 +35,9 @@
 #include "rtc_base/message_handler.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/socket_server.h"
+#include "rtc_base/synchronization/mpsc_queue.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue_stats.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_message.h"
@@ -327,6 +329,7 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   bool empty() const { return size() == 0u; }
   size_t size() const {
     CritScope cs(&crit_);
+    MoveIncomingMessages();
     return messages_.size() + delayed_messages_.size() + (fPeekKeep_ ? 1u : 0u);
   }
 
@@ -552,6 +555,10 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   // and are not expected to actually hold the lock.
   void DoDestroy() RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
 
+  // Appends the messages that Post() has put in `incoming_messages_` to
+  // `messages_`.
+  void MoveIncomingMessages() const RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+
   void WakeUpSocketServer();
 
   // Same as WrapCurrent except that it never fails as it does not try to
@@ -613,7 +620,13 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
 
   bool fPeekKeep_;
   Message msgPeek_;
-  MessageList messages_ RTC_GUARDED_BY(crit_);
+  // Mutable, as size() moves the incoming messages over first.
+  mutable MessageList messages_ RTC_GUARDED_BY(crit_);
+  // Messages posted since the message queue was last looked at. Post() adds
+  // to it without taking `crit_`, and only wakes up the socket server if the
+  // thread announced that it is about to wait. Everything else only touches
+  // it while holding `crit_`.
+  mutable webrtc::MpscQueue<Message> incoming_messages_;
   PriorityQueue delayed_messages_ RTC_GUARDED_BY(crit_);
   uint32_t delayed_next_num_ RTC_GUARDED_BY(crit_);
 #if RTC_DCHECK_IS_ON
@@ -663,6 +676,10 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   friend class ThreadManager;
 
   int dispatch_warning_ms_ RTC_GUARDED_BY(this) = kSlowDispatchLoggingThreshold;
+
+  // Created by Start() if task queue stats are enabled, so threads that are
+  // only wrapped aren't counted.
+  std::unique_ptr<webrtc::TaskQueueStatsCollector> stats_;
 };
 
 // AutoThread automatically installs itself at construction
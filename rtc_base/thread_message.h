@@ -103,6 +103,9 @@ struct Message {
   MessageHandler* phandler;
   uint32_t message_id;
   MessageData* pdata;
+  // When the message was posted, or is due for delayed messages. Only set by
+  // threads that collect task queue stats.
+  int64_t ready_time_us = 0;
 };
 
 typedef std::list<Message> MessageList;
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/logging.h"
@@ -51,6 +52,12 @@ const uint32_t TCP_MSS = 1400;        // Maximum segment size
 // Note: The current algorithm doesn't work for sample sizes smaller than this.
 const int NUM_SAMPLES = 1000;
 
+// Milliseconds covered by one turn of the timer wheel of throughput mode.
+// Packets that are further out take more than one turn.
+const size_t kWheelSlots = 512;
+// Buffers of received packets kept for reuse in throughput mode.
+const size_t kMaxFreePackets = 1024;
+
 enum {
   MSG_ID_PACKET,
   MSG_ID_CONNECT,
@@ -62,28 +69,32 @@ enum {
 // the kernel does.
 class Packet : public MessageData {
  public:
-  Packet(const char* data, size_t size, const SocketAddress& from)
-      : size_(size), consumed_(0), from_(from) {
-    RTC_DCHECK(nullptr != data);
-    data_ = new char[size_];
-    memcpy(data_, data, size_);
+  Packet(const char* data, size_t size, const SocketAddress& from) {
+    Assign(data, size, from);
   }
 
-  ~Packet() override { delete[] data_; }
+  // Replaces the contents of the packet, reusing its buffer if it's large
+  // enough.
+  void Assign(const char* data, size_t size, const SocketAddress& from) {
+    RTC_DCHECK(nullptr != data);
+    data_.SetData(data, size);
+    consumed_ = 0;
+    from_ = from;
+  }
 
-  const char* data() const { return data_ + consumed_; }
-  size_t size() const { return size_ - consumed_; }
+  const char* data() const { return data_.data() + consumed_; }
+  size_t size() const { return data_.size() - consumed_; }
   const SocketAddress& from() const { return from_; }
 
   // Remove the first size bytes from the data.
   void Consume(size_t size) {
-    RTC_DCHECK(size + consumed_ < size_);
+    RTC_DCHECK(size + consumed_ < data_.size());
     consumed_ += size;
   }
 
  private:
-  char* data_;
-  size_t size_, consumed_;
+  BufferT<char> data_;
+  size_t consumed_ = 0;
   SocketAddress from_;
 };
 
@@ -112,7 +123,7 @@ VirtualSocket::~VirtualSocket() {
 
   for (RecvBuffer::iterator it = recv_buffer_.begin(); it != recv_buffer_.end();
        ++it) {
-    delete *it;
+    server_->ReleasePacket(*it);
   }
 }
 
@@ -243,7 +254,7 @@ int VirtualSocket::RecvFrom(void* pv,
     packet->Consume(data_read);
   } else {
     recv_buffer_.pop_front();
-    delete packet;
+    server_->ReleasePacket(packet);
   }
 
   // To behave like a real socket, SignalReadEvent should fire in the next
@@ -388,6 +399,14 @@ void VirtualSocket::OnMessage(Message* pmsg) {
   }
 }
 
+void VirtualSocket::DeliverPacket(Packet* packet) {
+  {
+    webrtc::MutexLock lock(&mutex_);
+    recv_buffer_.push_back(packet);
+  }
+  SignalReadEvent(this);
+}
+
 int VirtualSocket::InitiateConnect(const SocketAddress& addr, bool use_delay) {
   if (!remote_addr_.IsNil()) {
     error_ = (CS_CONNECTED == state_) ? EISCONN : EINPROGRESS;
@@ -554,13 +573,25 @@ VirtualSocketServer::VirtualSocketServer(ThreadProcessingFakeClock* fake_clock)
       delay_mean_(0),
       delay_stddev_(0),
       delay_samples_(NUM_SAMPLES),
-      drop_prob_(0.0) {
+      drop_prob_(0.0),
+      wheel_(kWheelSlots) {
   UpdateDelayDistribution();
 }
 
 VirtualSocketServer::~VirtualSocketServer() {
   delete bindings_;
   delete connections_;
+  if (msg_queue_) {
+    msg_queue_->Clear(&delivery_handler_);
+  }
+  for (const std::vector<ScheduledPacket>& slot : wheel_) {
+    for (const ScheduledPacket& scheduled : slot) {
+      delete scheduled.packet;
+    }
+  }
+  for (Packet* packet : free_packets_) {
+    delete packet;
+  }
 }
 
 IPAddress VirtualSocketServer::GetNextIP(int family) {
@@ -868,6 +899,147 @@ void VirtualSocketServer::Clear(VirtualSocket* socket) {
   if (msg_queue_) {
     msg_queue_->Clear(socket);
   }
+  if (!throughput_mode_) {
+    return;
+  }
+  std::vector<Packet*> cleared;
+  {
+    webrtc::MutexLock lock(&wheel_mutex_);
+    if (num_scheduled_packets_ == 0) {
+      return;
+    }
+    for (std::vector<ScheduledPacket>& slot : wheel_) {
+      for (const ScheduledPacket& scheduled : slot) {
+        if (scheduled.recipient == socket) {
+          cleared.push_back(scheduled.packet);
+        }
+      }
+      slot.erase(std::remove_if(slot.begin(), slot.end(),
+                                [socket](const ScheduledPacket& scheduled) {
+                                  return scheduled.recipient == socket;
+                                }),
+                 slot.end());
+    }
+    num_scheduled_packets_ -= cleared.size();
+  }
+  for (Packet* packet : cleared) {
+    ReleasePacket(packet);
+  }
+}
+
+void VirtualSocketServer::ReleasePacket(Packet* packet) {
+  if (throughput_mode_) {
+    webrtc::MutexLock lock(&wheel_mutex_);
+    if (free_packets_.size() < kMaxFreePackets) {
+      free_packets_.push_back(packet);
+      return;
+    }
+  }
+  delete packet;
+}
+
+Packet* VirtualSocketServer::AcquirePacket(const char* data,
+                                           size_t data_size,
+                                           const SocketAddress& from) {
+  Packet* packet = nullptr;
+  {
+    webrtc::MutexLock lock(&wheel_mutex_);
+    if (!free_packets_.empty()) {
+      packet = free_packets_.back();
+      free_packets_.pop_back();
+    }
+  }
+  if (!packet) {
+    return new Packet(data, data_size, from);
+  }
+  packet->Assign(data, data_size, from);
+  return packet;
+}
+
+void VirtualSocketServer::SchedulePacket(int64_t delivery_time,
+                                         VirtualSocket* recipient,
+                                         Packet* packet) {
+  {
+    webrtc::MutexLock lock(&wheel_mutex_);
+    // A packet sent on another thread may have been timed before the last
+    // delivery, whose slots won't be visited again until the next turn.
+    delivery_time = std::max(delivery_time, wheel_time_);
+    wheel_[delivery_time % kWheelSlots].push_back(
+        {delivery_time, recipient, packet});
+    ++num_scheduled_packets_;
+    if (next_delivery_time_ >= 0 && next_delivery_time_ <= delivery_time) {
+      return;
+    }
+    next_delivery_time_ = delivery_time;
+  }
+  msg_queue_->PostAt(RTC_FROM_HERE, delivery_time, &delivery_handler_);
+}
+
+void VirtualSocketServer::DeliveryHandler::OnMessage(Message* msg) {
+  server_->DeliverScheduledPackets();
+}
+
+void VirtualSocketServer::DeliverScheduledPackets() {
+  RTC_DCHECK(msg_queue_ == Thread::Current());
+  int64_t now = TimeMillis();
+  std::vector<ScheduledPacket> due;
+  int64_t post_time = -1;
+  {
+    webrtc::MutexLock lock(&wheel_mutex_);
+    if (next_delivery_time_ <= now) {
+      next_delivery_time_ = -1;
+    }
+    int64_t num_slots =
+        std::min<int64_t>(now - wheel_time_ + 1, kWheelSlots);
+    for (int64_t t = now - num_slots + 1; t <= now; ++t) {
+      std::vector<ScheduledPacket>& slot = wheel_[t % kWheelSlots];
+      auto later = std::stable_partition(
+          slot.begin(), slot.end(), [now](const ScheduledPacket& scheduled) {
+            return scheduled.delivery_time <= now;
+          });
+      due.insert(due.end(), slot.begin(), later);
+      slot.erase(slot.begin(), later);
+    }
+    wheel_time_ = now;
+    num_scheduled_packets_ -= due.size();
+    if (num_scheduled_packets_ > 0) {
+      int64_t next = NextDeliveryTime(now);
+      if (next_delivery_time_ < 0 || next < next_delivery_time_) {
+        next_delivery_time_ = next;
+        post_time = next;
+      }
+    }
+  }
+  if (post_time >= 0) {
+    msg_queue_->PostAt(RTC_FROM_HERE, post_time, &delivery_handler_);
+  }
+  // Packets of the same millisecond are in the order they were sent already.
+  std::stable_sort(due.begin(), due.end(),
+                   [](const ScheduledPacket& a, const ScheduledPacket& b) {
+                     return a.delivery_time < b.delivery_time;
+                   });
+  for (const ScheduledPacket& scheduled : due) {
+    scheduled.recipient->DeliverPacket(scheduled.packet);
+  }
+}
+
+int64_t VirtualSocketServer::NextDeliveryTime(int64_t now) const {
+  int64_t next = -1;
+  for (int64_t t = now + 1; t <= now + static_cast<int64_t>(kWheelSlots);
+       ++t) {
+    for (const ScheduledPacket& scheduled : wheel_[t % kWheelSlots]) {
+      if (next < 0 || scheduled.delivery_time < next) {
+        next = scheduled.delivery_time;
+      }
+    }
+    // Slots are visited in time order, so a packet due in this turn of the
+    // wheel is due before any packet of a later slot.
+    if (next == t) {
+      break;
+    }
+  }
+  RTC_DCHECK_GT(next, now);
+  return next;
 }
 
 void VirtualSocketServer::PostSignalReadEvent(VirtualSocket* socket) {
@@ -1025,13 +1197,17 @@ void VirtualSocketServer::AddPacketToNetwork(VirtualSocket* sender,
     sender_addr.SetIP(default_ip);
   }
 
-  // Post the packet as a message to be delivered (on our own thread)
-  Packet* p = new Packet(data, data_size, sender_addr);
-
   int64_t ts = TimeAfter(send_delay + transit_delay);
   if (ordered) {
     ts = sender->UpdateOrderedDelivery(ts);
   }
+  if (throughput_mode_) {
+    SchedulePacket(ts, recipient, AcquirePacket(data, data_size, sender_addr));
+    return;
+  }
+
+  // Post the packet as a message to be delivered (on our own thread)
+  Packet* p = new Packet(data, data_size, sender_addr);
   msg_queue_->PostAt(RTC_FROM_HERE, ts, recipient, MSG_ID_PACKET, p);
 }
 
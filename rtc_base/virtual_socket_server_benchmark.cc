@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kNumPackets = 1000;
+constexpr size_t kPacketSize = 1200;
+
+class PacketCounter : public sigslot::has_slots<> {
+ public:
+  void OnReadEvent(Socket* socket) {
+    while (socket->Recv(buffer_, sizeof(buffer_), nullptr) > 0)
+      ++num_packets_;
+  }
+
+  int num_packets() const { return num_packets_; }
+
+ private:
+  char buffer_[kPacketSize];
+  int num_packets_ = 0;
+};
+
+// Sends `kNumPackets` packets of `kPacketSize` bytes at once through a network
+// with a transit delay of `state.range(1)` ms, jittered by a fifth of it, and
+// runs the simulated clock until they have all arrived. `state.range(0)` turns
+// the throughput mode of the server on.
+void BM_VirtualSocketServerUdpThroughput(benchmark::State& state) {
+  ScopedFakeClock clock;
+  VirtualSocketServer server(&clock);
+  AutoSocketServerThread thread(&server);
+  server.set_throughput_mode(state.range(0) != 0);
+  server.set_network_capacity(kNumPackets * 2 * kPacketSize);
+  server.set_delay_mean(state.range(1));
+  server.set_delay_stddev(state.range(1) / 5);
+  server.UpdateDelayDistribution();
+
+  std::unique_ptr<Socket> sender(server.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver(server.CreateSocket(AF_INET, SOCK_DGRAM));
+  sender->Bind(SocketAddress("1.1.1.1", 0));
+  receiver->Bind(SocketAddress("2.2.2.2", 0));
+  sender->Connect(receiver->GetLocalAddress());
+  PacketCounter counter;
+  receiver->SignalReadEvent.connect(&counter, &PacketCounter::OnReadEvent);
+
+  const char data[kPacketSize] = {0};
+  for (auto s : state) {
+    for (int i = 0; i < kNumPackets; ++i)
+      sender->Send(data, sizeof(data));
+    server.ProcessMessagesUntilIdle();
+  }
+  if (counter.num_packets() != state.iterations() * kNumPackets)
+    state.SkipWithError("Packets were lost.");
+  state.SetItemsProcessed(state.iterations() * kNumPackets);
+}
+
+BENCHMARK(BM_VirtualSocketServerUdpThroughput)
+    ->ArgNames({"throughput_mode", "delay_ms"})
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({0, 50})
+    ->Args({1, 50});
+
+}  // namespace
+}  // namespace rtc
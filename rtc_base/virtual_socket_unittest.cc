@@ -945,6 +945,65 @@ TEST_F(VirtualSocketServerTest, delay_v6) {
   DelayTest(kIPv6AnyAddress);
 }
 
+TEST_F(VirtualSocketServerTest, TcpSendsPacketsInOrderInThroughputMode) {
+  ss_.set_throughput_mode(true);
+  TcpSendsPacketsInOrderTest(kIPv4AnyAddress);
+}
+
+TEST_F(VirtualSocketServerTest, BandwidthInThroughputMode) {
+  ss_.set_throughput_mode(true);
+  BandwidthTest(kIPv4AnyAddress);
+}
+
+TEST_F(VirtualSocketServerTest, DelayInThroughputMode) {
+  ss_.set_throughput_mode(true);
+  DelayTest(kIPv4AnyAddress);
+}
+
+TEST_F(VirtualSocketServerTest, ThroughputModeDeliversPacketsInOrderOfTime) {
+  ss_.set_throughput_mode(true);
+  std::unique_ptr<Socket> sender =
+      absl::WrapUnique(ss_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver =
+      absl::WrapUnique(ss_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(kIPv4AnyAddress));
+  ASSERT_EQ(0, receiver->Bind(kIPv4AnyAddress));
+
+  // Delays of more than a turn of the timer wheel, of less and of none.
+  const int kDelaysMs[] = {1500, 600, 20, 0};
+  for (int delay_ms : kDelaysMs) {
+    ss_.SetDelayOnAddress(sender->GetLocalAddress(), delay_ms);
+    char data = static_cast<char>(delay_ms / 100);
+    EXPECT_EQ(1, sender->SendTo(&data, 1, receiver->GetLocalAddress()));
+  }
+  ss_.ProcessMessagesUntilIdle();
+
+  for (int i = arraysize(kDelaysMs) - 1; i >= 0; --i) {
+    char data = 0;
+    EXPECT_EQ(1, receiver->Recv(&data, 1, nullptr));
+    EXPECT_EQ(static_cast<char>(kDelaysMs[i] / 100), data);
+  }
+  char data = 0;
+  EXPECT_EQ(-1, receiver->Recv(&data, 1, nullptr));
+}
+
+TEST_F(VirtualSocketServerTest, ThroughputModeDropsPacketsOfClosedSocket) {
+  ss_.set_throughput_mode(true);
+  ss_.set_delay_mean(100);
+  ss_.UpdateDelayDistribution();
+  std::unique_ptr<Socket> sender =
+      absl::WrapUnique(ss_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver =
+      absl::WrapUnique(ss_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(kIPv4AnyAddress));
+  ASSERT_EQ(0, receiver->Bind(kIPv4AnyAddress));
+  char data = 'a';
+  EXPECT_EQ(1, sender->SendTo(&data, 1, receiver->GetLocalAddress()));
+
+  receiver.reset();
+  ss_.ProcessMessagesUntilIdle();
+}
+
 // Works, receiving socket sees 127.0.0.2.
 TEST_F(VirtualSocketServerTest, CanConnectFromMappedIPv6ToIPv4Any) {
   CrossFamilyConnectionTest(SocketAddress("::ffff:127.0.0.2", 0),
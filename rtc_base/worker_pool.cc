@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/worker_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+struct WorkerPool::Worker {
+  rtc::Event wake_up;
+  rtc::PlatformThread thread;
+};
+
+WorkerPool::WorkerPool(int num_threads, absl::string_view thread_name) {
+  RTC_DCHECK_GE(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (auto& worker : workers_) {
+    Worker* w = worker.get();
+    w->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, w] { RunWorker(w); }, thread_name,
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime));
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  quit_.store(true);
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Finalize();
+  }
+}
+
+void WorkerPool::ParallelFor(size_t num_tasks,
+                             rtc::FunctionView<void(size_t)> task) {
+  if (workers_.empty() || num_tasks <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  task_ = task;
+  num_tasks_ = num_tasks;
+  next_task_.store(0);
+  busy_workers_.store(workers_.size());
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+  }
+  RunTasks();
+  // Waiting for the workers also makes their writes visible to the caller.
+  batch_done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  task_ = nullptr;
+}
+
+void WorkerPool::RunWorker(Worker* worker) {
+  while (true) {
+    // Idle for as long as no batch is run; that is not a deadlock.
+    worker->wake_up.Wait(rtc::Event::kForever, rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    RunTasks();
+    if (busy_workers_.fetch_sub(1) == 1) {
+      batch_done_.Set();
+    }
+  }
+}
+
+void WorkerPool::RunTasks() {
+  for (size_t i = next_task_.fetch_add(1); i < num_tasks_;
+       i = next_task_.fetch_add(1)) {
+    task_(i);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_WORKER_POOL_H_
+#define RTC_BASE_WORKER_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+
+// A fixed set of realtime priority threads that help the calling thread run a
+// batch of independent tasks, e.g. pulling audio from many sources within one
+// 10 ms mixing tick. The threads sleep between batches.
+class WorkerPool {
+ public:
+  // Starts `num_threads` worker threads named `thread_name`. With no worker
+  // threads, all tasks run on the calling thread.
+  explicit WorkerPool(int num_threads,
+                      absl::string_view thread_name = "WorkerPool");
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Calls `task(i)` once for each `i` in [0, `num_tasks`), on the worker
+  // threads and the calling thread, and returns when all calls have returned.
+  // Must not be called concurrently.
+  void ParallelFor(size_t num_tasks, rtc::FunctionView<void(size_t)> task);
+
+  size_t num_threads() const { return workers_.size(); }
+
+ private:
+  struct Worker;
+
+  void RunWorker(Worker* worker);
+  // Runs tasks of the current batch until all have been claimed.
+  void RunTasks();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Signaled by the last worker to finish a batch.
+  rtc::Event batch_done_;
+  std::atomic<bool> quit_{false};
+
+  // The current batch. Written before the workers are woken up.
+  rtc::FunctionView<void(size_t)> task_;
+  size_t num_tasks_ = 0;
+  std::atomic<size_t> next_task_{0};
+  std::atomic<size_t> busy_workers_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_WORKER_POOL_H_
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/worker_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/platform_thread_types.h"
+#include "system_wrappers/include/sleep.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+class WorkerPoolTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(WorkerPoolTest, RunsEachTaskOnce) {
+  WorkerPool pool(GetParam());
+  for (size_t num_tasks : {0, 1, 2, 5, 100}) {
+    std::vector<std::atomic<int>> calls(num_tasks);
+    pool.ParallelFor(num_tasks, [&](size_t i) { ++calls[i]; });
+    for (size_t i = 0; i < num_tasks; ++i) {
+      EXPECT_EQ(1, calls[i].load()) << "Task " << i << " of " << num_tasks;
+    }
+  }
+}
+
+TEST_P(WorkerPoolTest, ReturnsWhenAllTasksHaveReturned) {
+  constexpr size_t kNumTasks = 8;
+  WorkerPool pool(GetParam());
+  std::atomic<size_t> finished_tasks(0);
+  for (int batch = 0; batch < 3; ++batch) {
+    finished_tasks = 0;
+    pool.ParallelFor(kNumTasks, [&](size_t i) {
+      SleepMs(1);
+      ++finished_tasks;
+    });
+    EXPECT_EQ(kNumTasks, finished_tasks.load());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads,
+                         WorkerPoolTest,
+                         ::testing::Values(0, 1, 4));
+
+TEST(WorkerPool, RunsTasksOnCallingThreadWithoutWorkers) {
+  WorkerPool pool(0);
+  const rtc::PlatformThreadRef calling_thread = rtc::CurrentThreadRef();
+  pool.ParallelFor(3, [&](size_t i) {
+    EXPECT_TRUE(rtc::IsThreadRefEqual(calling_thread, rtc::CurrentThreadRef()));
+  });
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -57,6 +57,10 @@ ABSL_FLAG(std::string,
           "",
           "Where to store perf result in chartjson format, if not present, no "
           "perf result will be stored");
+ABSL_FLAG(int,
+          num_threads,
+          1,
+          "Number of threads used to align and analyze the frames");
 
 namespace {
 
@@ -117,8 +121,10 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  const int num_threads = absl::GetFlag(FLAGS_num_threads);
   const std::vector<size_t> matching_indices =
-      webrtc::test::FindMatchingFrameIndices(reference_video, test_video);
+      webrtc::test::FindMatchingFrameIndices(reference_video, test_video,
+                                             num_threads);
 
   // Align the reference video both temporally and geometrically. I.e. align the
   // frames to match up in order to the test video, and align a crop region of
@@ -147,8 +153,10 @@ int main(int argc, char* argv[]) {
   const rtc::scoped_refptr<webrtc::test::Video> color_adjusted_test_video =
       AdjustColors(color_transformation, test_video);
 
-  results.frames = webrtc::test::RunAnalysis(
-      aligned_reference_video, color_adjusted_test_video, matching_indices);
+  results.frames =
+      webrtc::test::RunAnalysis(aligned_reference_video,
+                                color_adjusted_test_video, matching_indices,
+                                num_threads);
 
   const std::vector<webrtc::test::Cluster> clusters =
       webrtc::test::CalculateFrameClusters(matching_indices);
@@ -12,10 +12,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "test/testsupport/perf_test.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
@@ -57,24 +59,48 @@ std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
+  return RunAnalysis(reference_video, test_video, test_frame_indices,
+                     /*num_threads=*/1);
+}
+
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads) {
+  std::vector<AnalysisResult> results(test_video->number_of_frames());
+  ParallelFor(results.size(), num_threads, [&](size_t i) {
     const rtc::scoped_refptr<I420BufferInterface>& test_frame =
         test_video->GetFrame(i);
     const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
         reference_video->GetFrame(i);
 
     // Fill in the result struct.
-    AnalysisResult result;
+    AnalysisResult& result = results[i];
     result.frame_number = test_frame_indices[i];
     result.psnr_value = Psnr(reference_frame, test_frame);
     result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
-  }
+  });
 
   return results;
 }
 
+void ParallelFor(size_t size,
+                 int num_threads,
+                 rtc::FunctionView<void(size_t index)> function) {
+  std::atomic<size_t> next_index(0);
+  auto run = [&] {
+    for (size_t i = next_index++; i < size; i = next_index++)
+      function(i);
+  };
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 1; i < num_threads && static_cast<size_t>(i) < size; ++i)
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(run, "analysis"));
+  run();
+  // Joins the threads.
+  threads.clear();
+}
+
 std::vector<Cluster> CalculateFrameClusters(
     const std::vector<size_t>& indices) {
   std::vector<Cluster> clusters;
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "api/function_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "rtc_tools/video_file_reader.h"
@@ -56,6 +57,20 @@ std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices);
 
+// As above, but analyzes the frames on `num_threads` threads, which read the
+// videos in parallel.
+std::vector<AnalysisResult> RunAnalysis(
+    const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
+    const rtc::scoped_refptr<webrtc::test::Video>& test_video,
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads);
+
+// Calls `function` once for every index in [0, size) from `num_threads`
+// threads, roughly in index order, and returns when all calls are done.
+void ParallelFor(size_t size,
+                 int num_threads,
+                 rtc::FunctionView<void(size_t index)> function);
+
 // Compute PSNR for an I420 buffer (all planes). The max return value (in the
 // case where the test and reference frames are exactly the same) will be 48.
 double Psnr(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
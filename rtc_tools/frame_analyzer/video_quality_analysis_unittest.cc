@@ -15,9 +15,11 @@
 
 #include <stdio.h>
 
+#include <atomic>
 #include <cstddef>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
@@ -184,5 +186,13 @@ TEST_F(VideoQualityAnalysisTest, GetTotalNumberOfSkippedFramesEmpty) {
   EXPECT_EQ(0, GetTotalNumberOfSkippedFrames({}));
 }
 
+TEST_F(VideoQualityAnalysisTest, ParallelForCallsEveryIndexOnce) {
+  std::vector<std::atomic<int>> calls(100);
+  ParallelFor(calls.size(), /*num_threads=*/4,
+              [&](size_t index) { ++calls[index]; });
+  for (const std::atomic<int>& num_calls : calls)
+    EXPECT_EQ(num_calls, 1);
+}
+
 }  // namespace test
 }  // namespace webrtc
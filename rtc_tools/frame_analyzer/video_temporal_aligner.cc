@@ -151,12 +151,15 @@ class CachedVideo : public Video {
 };
 
 // Try matching the test frame against all frames in the reference video and
-// return the index of the best matching frame.
+// return the index of the best matching frame. The reference frames are read
+// and compared on `num_threads` threads.
 size_t FindBestMatch(const rtc::scoped_refptr<I420BufferInterface>& test_frame,
-                     const Video& reference_video) {
-  std::vector<double> ssim;
-  for (const auto& ref_frame : reference_video)
-    ssim.push_back(Ssim(test_frame, ref_frame));
+                     const Video& reference_video,
+                     int num_threads) {
+  std::vector<double> ssim(reference_video.number_of_frames());
+  ParallelFor(ssim.size(), num_threads, [&](size_t i) {
+    ssim[i] = Ssim(test_frame, reference_video.GetFrame(i));
+  });
   return std::distance(ssim.begin(),
                        std::max_element(ssim.begin(), ssim.end()));
 }
@@ -184,14 +187,23 @@ size_t FindNextMatch(const rtc::scoped_refptr<I420BufferInterface>& test_frame,
 std::vector<size_t> FindMatchingFrameIndices(
     const rtc::scoped_refptr<Video>& reference_video,
     const rtc::scoped_refptr<Video>& test_video) {
+  return FindMatchingFrameIndices(reference_video, test_video,
+                                  /*num_threads=*/1);
+}
+
+std::vector<size_t> FindMatchingFrameIndices(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    int num_threads) {
   // This is done to get a 10x speedup. We don't need the full resolution in
   // order to match frames, and we should limit file access and not read the
   // same memory tens of times.
   const float kScaleFactor = 0.25f;
+  const rtc::scoped_refptr<Video> downscaled_reference_video =
+      rtc::make_ref_counted<DownscaledVideo>(kScaleFactor, reference_video);
   const rtc::scoped_refptr<Video> cached_downscaled_reference_video =
       rtc::make_ref_counted<CachedVideo>(kNumberOfFramesLookAhead,
-                                         rtc::make_ref_counted<DownscaledVideo>(
-                                             kScaleFactor, reference_video));
+                                         downscaled_reference_video);
   const rtc::scoped_refptr<Video> downscaled_test_video =
       rtc::make_ref_counted<DownscaledVideo>(kScaleFactor, test_video);
 
@@ -203,9 +215,10 @@ std::vector<size_t> FindMatchingFrameIndices(
   for (const rtc::scoped_refptr<I420BufferInterface>& test_frame :
        *downscaled_test_video) {
     if (match_indices.empty()) {
-      // First frame.
-      match_indices.push_back(
-          FindBestMatch(test_frame, *cached_downscaled_reference_video));
+      // First frame. The cache isn't thread safe, and wouldn't help either
+      // since every reference frame is read once.
+      match_indices.push_back(FindBestMatch(
+          test_frame, *downscaled_reference_video, num_threads));
     } else {
       match_indices.push_back(FindNextMatch(
           test_frame, *looping_reference_video, match_indices.back()));
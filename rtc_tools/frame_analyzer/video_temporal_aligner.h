@@ -31,6 +31,14 @@ std::vector<size_t> FindMatchingFrameIndices(
     const rtc::scoped_refptr<Video>& reference_video,
     const rtc::scoped_refptr<Video>& test_video);
 
+// As above, but searches the whole reference video for the match of the first
+// test frame on `num_threads` threads, which read `reference_video` in
+// parallel.
+std::vector<size_t> FindMatchingFrameIndices(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    int num_threads);
+
 // Generate a new video using the frames from the original video. The returned
 // video will have the same number of frames as the size of `indices`, and
 // frame nr i in the returned video will point to frame nr indices[i] in the
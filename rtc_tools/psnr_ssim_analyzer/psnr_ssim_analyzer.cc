@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -34,26 +35,31 @@ ABSL_FLAG(std::string,
           test_file,
           "test.yuv",
           "The test YUV file to run the analysis for");
+ABSL_FLAG(int, num_threads, 1, "Number of threads used to analyze the frames");
 
 void CompareFiles(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const char* results_file_name) {
+    const char* results_file_name,
+    int num_threads) {
   FILE* results_file = fopen(results_file_name, "w");
 
   const size_t num_frames = std::min(reference_video->number_of_frames(),
                                      test_video->number_of_frames());
-  for (size_t i = 0; i < num_frames; ++i) {
+  std::vector<webrtc::test::AnalysisResult> results(num_frames);
+  webrtc::test::ParallelFor(num_frames, num_threads, [&](size_t i) {
     const rtc::scoped_refptr<webrtc::I420BufferInterface> ref_buffer =
         reference_video->GetFrame(i);
     const rtc::scoped_refptr<webrtc::I420BufferInterface> test_buffer =
         test_video->GetFrame(i);
 
     // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::Psnr(ref_buffer, test_buffer);
-    double result_ssim = webrtc::test::Ssim(ref_buffer, test_buffer);
-    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i, result_psnr,
-            result_ssim);
+    results[i].psnr_value = webrtc::test::Psnr(ref_buffer, test_buffer);
+    results[i].ssim_value = webrtc::test::Ssim(ref_buffer, test_buffer);
+  });
+  for (size_t i = 0; i < num_frames; ++i) {
+    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i,
+            results[i].psnr_value, results[i].ssim_value);
   }
 
   fclose(results_file);
@@ -103,6 +109,7 @@ int main(int argc, char* argv[]) {
   }
 
   CompareFiles(reference_video, test_video,
-               absl::GetFlag(FLAGS_results_file).c_str());
+               absl::GetFlag(FLAGS_results_file).c_str(),
+               absl::GetFlag(FLAGS_num_threads));
   return 0;
 }
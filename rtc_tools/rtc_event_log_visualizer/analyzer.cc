@@ -1679,6 +1679,7 @@ void EventLogAnalyzer::CreateIceCandidatePairConfigGraph(Plot* plot) {
 
 std::string EventLogAnalyzer::GetCandidatePairLogDescriptionFromId(
     uint32_t candidate_pair_id) {
+  MutexLock lock(&candidate_pair_desc_mutex_);
   if (candidate_pair_desc_by_id_.find(candidate_pair_id) !=
       candidate_pair_desc_by_id_.end()) {
     return candidate_pair_desc_by_id_[candidate_pair_id];
@@ -21,6 +21,8 @@
 #include "logging/rtc_event_log/rtc_event_log_parser.h"
 #include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyzer_common.h"
 #include "rtc_tools/rtc_event_log_visualizer/plot_base.h"
 
@@ -102,7 +104,10 @@ class EventLogAnalyzer {
   // If left empty, all SSRCs will be considered relevant.
   std::vector<uint32_t> desired_ssrc_;
 
-  std::map<uint32_t, std::string> candidate_pair_desc_by_id_;
+  // Guards the cache below, since the ICE plots may be created in parallel.
+  Mutex candidate_pair_desc_mutex_;
+  std::map<uint32_t, std::string> candidate_pair_desc_by_id_
+      RTC_GUARDED_BY(candidate_pair_desc_mutex_);
 
   AnalyzerConfig config_;
 };
@@ -11,6 +11,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -30,6 +32,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_tools/rtc_event_log_visualizer/alerts.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyze_audio.h"
 #include "rtc_tools/rtc_event_log_visualizer/analyzer.h"
@@ -97,6 +100,12 @@ ABSL_FLAG(bool,
           false,
           "Output charts as protobuf instead of python code.");
 
+ABSL_FLAG(int,
+          num_threads,
+          1,
+          "Number of threads used to compute the plots. The output doesn't "
+          "depend on it, but the run time of e.g. --plot=all does.");
+
 ABSL_FLAG(bool,
           list_plots,
           false,
@@ -583,13 +592,46 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  std::vector<const PlotDeclaration*> enabled_plots;
+  std::vector<Plot*> outputs;
   for (const auto& plot : plots) {
     if (plot.enabled) {
-      Plot* output = collection.AppendNewPlot();
-      plot.plot_func(output);
-      output->SetId(plot.label);
+      enabled_plots.push_back(&plot);
+      outputs.push_back(collection.AppendNewPlot());
+    }
+  }
+
+  // The NetEq simulation is shared by several plots, so run it once up front
+  // rather than from whichever of them comes first.
+  bool needs_neteq_stats =
+      absl::c_find(plot_flags, "simulated_neteq_jitter_buffer_delay") !=
+      plot_flags.end();
+  for (const PlotDeclaration* plot : enabled_plots) {
+    needs_neteq_stats |= absl::StartsWith(plot->label, "simulated_neteq_");
+  }
+  if (needs_neteq_stats) {
+    neteq_stats = webrtc::SimulateNetEq(parsed_log, config, wav_path, 48000);
+  }
+
+  // The plots only read the parsed log, so they can be computed in parallel.
+  // Each one is written to the output slot reserved for it above, which keeps
+  // the output order fixed.
+  std::atomic<size_t> next_plot(0);
+  auto compute_plots = [&] {
+    for (size_t i = next_plot++; i < enabled_plots.size(); i = next_plot++) {
+      enabled_plots[i]->plot_func(outputs[i]);
+      outputs[i]->SetId(enabled_plots[i]->label);
     }
+  };
+  const size_t num_threads = std::min<size_t>(
+      std::max(absl::GetFlag(FLAGS_num_threads), 1), enabled_plots.size());
+  std::vector<rtc::PlatformThread> workers;
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers.push_back(
+        rtc::PlatformThread::SpawnJoinable(compute_plots, "plot_worker"));
   }
+  compute_plots();
+  workers.clear();
 
   // The model we use for registering plots assumes that the each plot label
   // can be mapped to a lambda that will produce exactly one plot. The
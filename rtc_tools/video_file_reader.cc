@@ -10,18 +10,27 @@
 
 #include "rtc_tools/video_file_reader.h"
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <cstdio>
 #include <string>
 #include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
+#include "api/ref_counted_base.h"
 #include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_to_number.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -32,17 +41,62 @@ bool ReadBytes(uint8_t* dst, size_t n, FILE* file) {
   return fread(reinterpret_cast<char*>(dst), /* size= */ 1, n, file) == n;
 }
 
-// Common base class for .yuv and .y4m files.
+// Read-only memory mapping of a whole file. Reference counted so that the
+// frames handed out as views into it can outlive the video.
+class MappedFile : public rtc::RefCountedBase {
+ public:
+  // Returns null if `file` can't be mapped, e.g. on platforms without mmap.
+  static rtc::scoped_refptr<MappedFile> Map(FILE* file) {
+#if defined(WEBRTC_POSIX)
+    struct stat file_stat;
+    if (fstat(fileno(file), &file_stat) != 0 || file_stat.st_size <= 0)
+      return nullptr;
+    void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+                      fileno(file), 0);
+    if (data == MAP_FAILED)
+      return nullptr;
+    return rtc::scoped_refptr<MappedFile>(new MappedFile(
+        static_cast<const uint8_t*>(data), file_stat.st_size));
+#else
+    return nullptr;
+#endif
+  }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ protected:
+  ~MappedFile() override {
+#if defined(WEBRTC_POSIX)
+    munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+  }
+
+ private:
+  MappedFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
+// Common base class for .yuv and .y4m files. Frames are returned as views
+// into a memory mapping of the file where possible, and read into new
+// buffers otherwise.
 class VideoFile : public Video {
  public:
   VideoFile(int width,
             int height,
             const std::vector<fpos_t>& frame_positions,
+            const std::vector<size_t>& frame_offsets,
             FILE* file)
       : width_(width),
         height_(height),
         frame_positions_(frame_positions),
-        file_(file) {}
+        frame_offsets_(frame_offsets),
+        mapped_file_(MappedFile::Map(file)),
+        file_(file) {
+    RTC_DCHECK_EQ(frame_positions_.size(), frame_offsets_.size());
+  }
 
   ~VideoFile() override { fclose(file_); }
 
@@ -54,9 +108,12 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
-    fsetpos(file_, &frame_positions_[frame_index]);
-    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    if (mapped_file_)
+      return GetMappedFrame(frame_index);
 
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    MutexLock lock(&file_mutex_);
+    fsetpos(file_, &frame_positions_[frame_index]);
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
                    buffer->ChromaWidth() * buffer->ChromaHeight(), file_) ||
@@ -70,10 +127,34 @@ class VideoFile : public Video {
   }
 
  private:
+  rtc::scoped_refptr<I420BufferInterface> GetMappedFrame(
+      size_t frame_index) const {
+    const int chroma_width = (width_ + 1) / 2;
+    const int chroma_height = (height_ + 1) / 2;
+    const size_t y_size = width_ * height_;
+    const size_t chroma_size = chroma_width * chroma_height;
+    const size_t offset = frame_offsets_[frame_index];
+    if (offset + y_size + 2 * chroma_size > mapped_file_->size()) {
+      RTC_LOG(LS_ERROR) << "Could not read YUV data for frame " << frame_index;
+      return nullptr;
+    }
+    const uint8_t* y_plane = mapped_file_->data() + offset;
+    const uint8_t* u_plane = y_plane + y_size;
+    const uint8_t* v_plane = u_plane + chroma_size;
+    // The frame keeps the mapping alive.
+    return WrapI420Buffer(width_, height_, y_plane, width_, u_plane,
+                          chroma_width, v_plane, chroma_width,
+                          [mapped_file = mapped_file_] {});
+  }
+
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  // Byte offsets of the frames, used to locate them in `mapped_file_`.
+  const std::vector<size_t> frame_offsets_;
+  const rtc::scoped_refptr<MappedFile> mapped_file_;
+  mutable Mutex file_mutex_;
+  FILE* const file_ RTC_PT_GUARDED_BY(file_mutex_);
 };
 
 }  // namespace
@@ -203,6 +284,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
 
   const int i420_frame_size = 3 * *width * *height / 2;
   std::vector<fpos_t> frame_positions;
+  std::vector<size_t> frame_offsets;
   while (true) {
     int parse_frame_header_result = -1;
     if (fscanf(file, "FRAME\n%n", &parse_frame_header_result) != 0 ||
@@ -215,6 +297,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
     fpos_t pos;
     fgetpos(file, &pos);
     frame_positions.push_back(pos);
+    frame_offsets.push_back(ftell(file));
     // Skip over YUV pixel data.
     fseek(file, i420_frame_size, SEEK_CUR);
   }
@@ -225,7 +308,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
   return rtc::make_ref_counted<VideoFile>(*width, *height, frame_positions,
-                                          file);
+                                          frame_offsets, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -254,10 +337,12 @@ rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
   const size_t number_of_frames = file_size / i420_frame_size;
 
   std::vector<fpos_t> frame_positions;
+  std::vector<size_t> frame_offsets;
   for (size_t i = 0; i < number_of_frames; ++i) {
     fpos_t pos;
     fgetpos(file, &pos);
     frame_positions.push_back(pos);
+    frame_offsets.push_back(i * i420_frame_size);
     fseek(file, i420_frame_size, SEEK_CUR);
   }
   if (frame_positions.empty()) {
@@ -266,7 +351,8 @@ rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return rtc::make_ref_counted<VideoFile>(width, height, frame_positions, file);
+  return rtc::make_ref_counted<VideoFile>(width, height, frame_positions,
+                                          frame_offsets, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
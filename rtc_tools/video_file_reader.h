@@ -23,8 +23,8 @@
 namespace webrtc {
 namespace test {
 
-// Iterable class representing a sequence of I420 buffers. This class is not
-// thread safe because it is expected to be backed by a file.
+// Iterable class representing a sequence of I420 buffers. The videos opened by
+// the functions below may be read from several threads at once.
 class Video : public rtc::RefCountInterface {
  public:
   class Iterator {
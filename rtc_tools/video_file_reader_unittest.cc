@@ -73,6 +73,13 @@ TEST_F(Y4mFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(Y4mFileReaderTest, FrameOutlivesVideo) {
+  const rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(1);
+  video = nullptr;
+  EXPECT_EQ(36, frame->DataY()[0]);
+  EXPECT_EQ(71, frame->DataV()[5]);
+}
+
 class YuvFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
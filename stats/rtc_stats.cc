@@ -317,5 +317,9 @@ template class RTC_EXPORT_TEMPLATE_DEFINE(RTC_EXPORT)
     RTCNonStandardStatsMember<std::vector<double>>;
 template class RTC_EXPORT_TEMPLATE_DEFINE(RTC_EXPORT)
     RTCNonStandardStatsMember<std::vector<std::string>>;
+template class RTC_EXPORT_TEMPLATE_DEFINE(RTC_EXPORT)
+    RTCNonStandardStatsMember<std::map<std::string, uint64_t>>;
+template class RTC_EXPORT_TEMPLATE_DEFINE(RTC_EXPORT)
+    RTCNonStandardStatsMember<std::map<std::string, double>>;
 
 }  // namespace webrtc
@@ -0,0 +1,652 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "stats/rtc_stats_binary_encoding.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "api/stats/rtc_stats.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+// Format of an encoded report, where varints are LEB128 encoded, signed values
+// are zigzag encoded and strings are a varint length followed by the bytes:
+//
+//   varint   flags, kKeyReportFlag
+//   varint   timestamp_us, as the difference to the previous report's
+//   varint   number of new stats types, for each:
+//     string   type
+//     varint   number of members, for each:
+//       string   name
+//       uint8    RTCStatsMemberInterface::Type
+//       uint8    1 if standardized, 0 otherwise
+//   varint   number of new ids, for each:
+//     string   id
+//   varint   number of stats objects, for each:
+//     varint   index of the stats type, in the order they were sent
+//     varint   index of the id, in the order they were sent
+//     varint   timestamp_us, as the difference to the report's
+//     uint8[]  MemberState of each member, four per byte
+//     values of the kValue and kDelta members
+//
+// Types and ids are numbered anew from each key report on.
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint64_t kKeyReportFlag = 1;
+
+enum MemberState : uint8_t {
+  kUndefined = 0,
+  // Equal to the member of the previous report's stats object.
+  kUnchanged = 1,
+  kValue = 2,
+  // The difference to the member of the previous report's stats object.
+  kDelta = 3,
+};
+
+constexpr int kMemberStateBits = 2;
+constexpr int kMemberStatesPerByte = 8 / kMemberStateBits;
+constexpr uint8_t kMemberStateMask = (1 << kMemberStateBits) - 1;
+
+template <typename T>
+struct TypeTag {
+  using type = T;
+};
+
+// Calls `visitor` with the TypeTag of the value type of `type`.
+template <typename Visitor>
+void VisitMemberType(RTCStatsMemberInterface::Type type, Visitor&& visitor) {
+  switch (type) {
+    case RTCStatsMemberInterface::kBool:
+      return visitor(TypeTag<bool>());
+    case RTCStatsMemberInterface::kInt32:
+      return visitor(TypeTag<int32_t>());
+    case RTCStatsMemberInterface::kUint32:
+      return visitor(TypeTag<uint32_t>());
+    case RTCStatsMemberInterface::kInt64:
+      return visitor(TypeTag<int64_t>());
+    case RTCStatsMemberInterface::kUint64:
+      return visitor(TypeTag<uint64_t>());
+    case RTCStatsMemberInterface::kDouble:
+      return visitor(TypeTag<double>());
+    case RTCStatsMemberInterface::kString:
+      return visitor(TypeTag<std::string>());
+    case RTCStatsMemberInterface::kSequenceBool:
+      return visitor(TypeTag<std::vector<bool>>());
+    case RTCStatsMemberInterface::kSequenceInt32:
+      return visitor(TypeTag<std::vector<int32_t>>());
+    case RTCStatsMemberInterface::kSequenceUint32:
+      return visitor(TypeTag<std::vector<uint32_t>>());
+    case RTCStatsMemberInterface::kSequenceInt64:
+      return visitor(TypeTag<std::vector<int64_t>>());
+    case RTCStatsMemberInterface::kSequenceUint64:
+      return visitor(TypeTag<std::vector<uint64_t>>());
+    case RTCStatsMemberInterface::kSequenceDouble:
+      return visitor(TypeTag<std::vector<double>>());
+    case RTCStatsMemberInterface::kSequenceString:
+      return visitor(TypeTag<std::vector<std::string>>());
+    case RTCStatsMemberInterface::kMapStringUint64:
+      return visitor(TypeTag<rtc_stats_internal::MapStringUint64>());
+    case RTCStatsMemberInterface::kMapStringDouble:
+      return visitor(TypeTag<rtc_stats_internal::MapStringDouble>());
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+bool IsDeltaEncoded(RTCStatsMemberInterface::Type type) {
+  return type == RTCStatsMemberInterface::kInt32 ||
+         type == RTCStatsMemberInterface::kUint32 ||
+         type == RTCStatsMemberInterface::kInt64 ||
+         type == RTCStatsMemberInterface::kUint64;
+}
+
+uint64_t ToZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t FromZigZag(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void WriteString(rtc::ByteBufferWriter& writer, absl::string_view value) {
+  writer.WriteUVarint(value.size());
+  writer.WriteBytes(value.data(), value.size());
+}
+
+bool ReadString(rtc::ByteBufferReader& reader, std::string* value) {
+  uint64_t size;
+  return reader.ReadUVarint(&size) && size <= reader.Length() &&
+         reader.ReadString(value, size);
+}
+
+void WriteValue(rtc::ByteBufferWriter& writer, bool value) {
+  writer.WriteUInt8(value ? 1 : 0);
+}
+void WriteValue(rtc::ByteBufferWriter& writer, int32_t value) {
+  writer.WriteUVarint(ToZigZag(value));
+}
+void WriteValue(rtc::ByteBufferWriter& writer, uint32_t value) {
+  writer.WriteUVarint(value);
+}
+void WriteValue(rtc::ByteBufferWriter& writer, int64_t value) {
+  writer.WriteUVarint(ToZigZag(value));
+}
+void WriteValue(rtc::ByteBufferWriter& writer, uint64_t value) {
+  writer.WriteUVarint(value);
+}
+void WriteValue(rtc::ByteBufferWriter& writer, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  writer.WriteUInt64(bits);
+}
+void WriteValue(rtc::ByteBufferWriter& writer, const std::string& value) {
+  WriteString(writer, value);
+}
+template <typename T>
+void WriteValue(rtc::ByteBufferWriter& writer, const std::vector<T>& value) {
+  writer.WriteUVarint(value.size());
+  for (const T& element : value) {
+    WriteValue(writer, element);
+  }
+}
+template <typename T>
+void WriteValue(rtc::ByteBufferWriter& writer,
+                const std::map<std::string, T>& value) {
+  writer.WriteUVarint(value.size());
+  for (const auto& element : value) {
+    WriteString(writer, element.first);
+    WriteValue(writer, element.second);
+  }
+}
+
+bool ReadValue(rtc::ByteBufferReader& reader, bool* value) {
+  uint8_t byte;
+  if (!reader.ReadUInt8(&byte) || byte > 1)
+    return false;
+  *value = byte != 0;
+  return true;
+}
+template <typename T>
+bool ReadSignedValue(rtc::ByteBufferReader& reader, T* value) {
+  uint64_t zigzag;
+  if (!reader.ReadUVarint(&zigzag))
+    return false;
+  *value = static_cast<T>(FromZigZag(zigzag));
+  return true;
+}
+template <typename T>
+bool ReadUnsignedValue(rtc::ByteBufferReader& reader, T* value) {
+  uint64_t varint;
+  if (!reader.ReadUVarint(&varint))
+    return false;
+  *value = static_cast<T>(varint);
+  return true;
+}
+bool ReadValue(rtc::ByteBufferReader& reader, int32_t* value) {
+  return ReadSignedValue(reader, value);
+}
+bool ReadValue(rtc::ByteBufferReader& reader, uint32_t* value) {
+  return ReadUnsignedValue(reader, value);
+}
+bool ReadValue(rtc::ByteBufferReader& reader, int64_t* value) {
+  return ReadSignedValue(reader, value);
+}
+bool ReadValue(rtc::ByteBufferReader& reader, uint64_t* value) {
+  return ReadUnsignedValue(reader, value);
+}
+bool ReadValue(rtc::ByteBufferReader& reader, double* value) {
+  uint64_t bits;
+  if (!reader.ReadUInt64(&bits))
+    return false;
+  memcpy(value, &bits, sizeof(bits));
+  return true;
+}
+bool ReadValue(rtc::ByteBufferReader& reader, std::string* value) {
+  return ReadString(reader, value);
+}
+template <typename T>
+bool ReadValue(rtc::ByteBufferReader& reader, std::vector<T>* value) {
+  uint64_t size;
+  // Every element takes at least a byte, which bounds the allocation.
+  if (!reader.ReadUVarint(&size) || size > reader.Length())
+    return false;
+  value->reserve(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    T element;
+    if (!ReadValue(reader, &element))
+      return false;
+    value->push_back(std::move(element));
+  }
+  return true;
+}
+template <typename T>
+bool ReadValue(rtc::ByteBufferReader& reader,
+               std::map<std::string, T>* value) {
+  uint64_t size;
+  if (!reader.ReadUVarint(&size) || size > reader.Length())
+    return false;
+  for (uint64_t i = 0; i < size; ++i) {
+    std::string key;
+    T element;
+    if (!ReadString(reader, &key) || !ReadValue(reader, &element))
+      return false;
+    (*value)[std::move(key)] = std::move(element);
+  }
+  return true;
+}
+
+// The difference of two integers is taken modulo 2^64, which is exact in both
+// directions for all the integer types, including unsigned ones that shrink.
+template <typename T>
+void WriteIntegerDelta(rtc::ByteBufferWriter& writer, T value, T previous) {
+  writer.WriteUVarint(ToZigZag(static_cast<int64_t>(
+      static_cast<uint64_t>(value) - static_cast<uint64_t>(previous))));
+}
+template <typename T>
+bool ReadIntegerDelta(rtc::ByteBufferReader& reader, T previous, T* value) {
+  uint64_t zigzag;
+  if (!reader.ReadUVarint(&zigzag))
+    return false;
+  *value = static_cast<T>(static_cast<uint64_t>(previous) +
+                          static_cast<uint64_t>(FromZigZag(zigzag)));
+  return true;
+}
+void WriteDelta(rtc::ByteBufferWriter& writer,
+                int32_t value,
+                int32_t previous) {
+  WriteIntegerDelta(writer, value, previous);
+}
+void WriteDelta(rtc::ByteBufferWriter& writer,
+                uint32_t value,
+                uint32_t previous) {
+  WriteIntegerDelta(writer, value, previous);
+}
+void WriteDelta(rtc::ByteBufferWriter& writer,
+                int64_t value,
+                int64_t previous) {
+  WriteIntegerDelta(writer, value, previous);
+}
+void WriteDelta(rtc::ByteBufferWriter& writer,
+                uint64_t value,
+                uint64_t previous) {
+  WriteIntegerDelta(writer, value, previous);
+}
+// Members that aren't IsDeltaEncoded().
+template <typename T>
+void WriteDelta(rtc::ByteBufferWriter& writer,
+                const T& value,
+                const T& previous) {
+  RTC_DCHECK_NOTREACHED();
+}
+bool ReadDelta(rtc::ByteBufferReader& reader,
+               int32_t previous,
+               int32_t* value) {
+  return ReadIntegerDelta(reader, previous, value);
+}
+bool ReadDelta(rtc::ByteBufferReader& reader,
+               uint32_t previous,
+               uint32_t* value) {
+  return ReadIntegerDelta(reader, previous, value);
+}
+bool ReadDelta(rtc::ByteBufferReader& reader,
+               int64_t previous,
+               int64_t* value) {
+  return ReadIntegerDelta(reader, previous, value);
+}
+bool ReadDelta(rtc::ByteBufferReader& reader,
+               uint64_t previous,
+               uint64_t* value) {
+  return ReadIntegerDelta(reader, previous, value);
+}
+template <typename T>
+bool ReadDelta(rtc::ByteBufferReader& reader, const T& previous, T* value) {
+  return false;
+}
+
+MemberState GetMemberState(const RTCStatsMemberInterface& member,
+                           const RTCStatsMemberInterface* previous) {
+  if (!member.is_defined())
+    return kUndefined;
+  if (!previous || !previous->is_defined())
+    return kValue;
+  if (member == *previous)
+    return kUnchanged;
+  return IsDeltaEncoded(member.type()) ? kDelta : kValue;
+}
+
+}  // namespace
+
+RTCStatsReportBinaryEncoder::RTCStatsReportBinaryEncoder() = default;
+
+RTCStatsReportBinaryEncoder::~RTCStatsReportBinaryEncoder() = default;
+
+std::string RTCStatsReportBinaryEncoder::Encode(
+    rtc::scoped_refptr<const RTCStatsReport> report,
+    bool key_report) {
+  RTC_DCHECK(report);
+  if (key_report || !previous_report_) {
+    key_report = true;
+    previous_report_ = nullptr;
+    schema_indices_.clear();
+    id_indices_.clear();
+  }
+
+  rtc::ByteBufferWriter writer;
+  writer.WriteUVarint(key_report ? kKeyReportFlag : 0);
+  writer.WriteUVarint(ToZigZag(
+      report->timestamp_us() -
+      (previous_report_ ? previous_report_->timestamp_us() : 0)));
+
+  std::vector<const RTCStats*> new_schemas;
+  std::vector<const std::string*> new_ids;
+  for (const RTCStats& stats : *report) {
+    if (schema_indices_.emplace(stats.type(), schema_indices_.size()).second)
+      new_schemas.push_back(&stats);
+    if (id_indices_.emplace(stats.id(), id_indices_.size()).second)
+      new_ids.push_back(&stats.id());
+  }
+  writer.WriteUVarint(new_schemas.size());
+  for (const RTCStats* stats : new_schemas) {
+    WriteString(writer, stats->type());
+    std::vector<const RTCStatsMemberInterface*> members = stats->Members();
+    writer.WriteUVarint(members.size());
+    for (const RTCStatsMemberInterface* member : members) {
+      WriteString(writer, member->name());
+      writer.WriteUInt8(member->type());
+      writer.WriteUInt8(member->is_standardized() ? 1 : 0);
+    }
+  }
+  writer.WriteUVarint(new_ids.size());
+  for (const std::string* id : new_ids) {
+    WriteString(writer, *id);
+  }
+
+  writer.WriteUVarint(report->size());
+  std::vector<MemberState> states;
+  for (const RTCStats& stats : *report) {
+    writer.WriteUVarint(schema_indices_[stats.type()]);
+    writer.WriteUVarint(id_indices_[stats.id()]);
+    writer.WriteUVarint(
+        ToZigZag(stats.timestamp_us() - report->timestamp_us()));
+
+    std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+    const RTCStats* previous =
+        previous_report_ ? previous_report_->Get(stats.id()) : nullptr;
+    std::vector<const RTCStatsMemberInterface*> previous_members;
+    if (previous && previous->type() == stats.type()) {
+      previous_members = previous->Members();
+      RTC_DCHECK_EQ(previous_members.size(), members.size());
+    }
+
+    states.clear();
+    uint8_t byte = 0;
+    for (size_t i = 0; i < members.size(); ++i) {
+      states.push_back(GetMemberState(
+          *members[i],
+          previous_members.empty() ? nullptr : previous_members[i]));
+      byte |= states.back() << (kMemberStateBits * (i % kMemberStatesPerByte));
+      if (i % kMemberStatesPerByte == kMemberStatesPerByte - 1 ||
+          i == members.size() - 1) {
+        writer.WriteUInt8(byte);
+        byte = 0;
+      }
+    }
+
+    for (size_t i = 0; i < members.size(); ++i) {
+      if (states[i] != kValue && states[i] != kDelta)
+        continue;
+      VisitMemberType(members[i]->type(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        const T& value = *members[i]->cast_to<RTCStatsMember<T>>();
+        if (states[i] == kDelta) {
+          WriteDelta(writer, value,
+                     *previous_members[i]->cast_to<RTCStatsMember<T>>());
+        } else {
+          WriteValue(writer, value);
+        }
+      });
+    }
+  }
+
+  previous_report_ = std::move(report);
+  return std::string(writer.Data(), writer.Length());
+}
+
+struct RTCStatsReportBinaryDecoder::StatsSchema {
+  struct Member {
+    std::string name;
+    RTCStatsMemberInterface::Type type;
+    bool is_standardized;
+  };
+
+  std::string type;
+  std::vector<Member> members;
+};
+
+class RTCStatsReportBinaryDecoder::DecodedStats : public RTCStats {
+ public:
+  DecodedStats(const std::string& id,
+               int64_t timestamp_us,
+               std::shared_ptr<const StatsSchema> schema)
+      : RTCStats(id, timestamp_us), schema_(std::move(schema)) {
+    members_.reserve(schema_->members.size());
+    for (const StatsSchema::Member& member : schema_->members) {
+      VisitMemberType(member.type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        if (member.is_standardized) {
+          members_.push_back(
+              std::make_unique<RTCStatsMember<T>>(member.name.c_str()));
+        } else {
+          members_.push_back(std::make_unique<RTCNonStandardStatsMember<T>>(
+              member.name.c_str()));
+        }
+      });
+    }
+  }
+
+  std::unique_ptr<RTCStats> copy() const override {
+    auto copy = std::make_unique<DecodedStats>(id(), timestamp_us(), schema_);
+    for (size_t i = 0; i < members_.size(); ++i) {
+      if (!members_[i]->is_defined())
+        continue;
+      VisitMemberType(members_[i]->type(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        copy->member<T>(i) = *members_[i]->cast_to<RTCStatsMember<T>>();
+      });
+    }
+    return copy;
+  }
+
+  const char* type() const override { return schema_->type.c_str(); }
+
+  template <typename T>
+  RTCStatsMember<T>& member(size_t index) {
+    RTC_DCHECK_EQ(members_[index]->type(), RTCStatsMember<T>::StaticType());
+    return static_cast<RTCStatsMember<T>&>(*members_[index]);
+  }
+
+ protected:
+  std::vector<const RTCStatsMemberInterface*> MembersOfThisObjectAndAncestors(
+      size_t additional_capacity) const override {
+    std::vector<const RTCStatsMemberInterface*> members =
+        RTCStats::MembersOfThisObjectAndAncestors(additional_capacity +
+                                                  members_.size());
+    for (const auto& member : members_) {
+      members.push_back(member.get());
+    }
+    return members;
+  }
+
+ private:
+  // Owns the names of the members.
+  const std::shared_ptr<const StatsSchema> schema_;
+  std::vector<std::unique_ptr<RTCStatsMemberInterface>> members_;
+};
+
+RTCStatsReportBinaryDecoder::RTCStatsReportBinaryDecoder() = default;
+
+RTCStatsReportBinaryDecoder::~RTCStatsReportBinaryDecoder() = default;
+
+rtc::scoped_refptr<const RTCStatsReport> RTCStatsReportBinaryDecoder::Decode(
+    absl::string_view encoded) {
+  rtc::scoped_refptr<RTCStatsReport> report = DecodeReport(encoded);
+  if (!report) {
+    RTC_LOG(LS_WARNING) << "Failed to decode stats report, waiting for the "
+                           "next key report.";
+    Reset();
+    return nullptr;
+  }
+  previous_report_ = report;
+  return report;
+}
+
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReportBinaryDecoder::DecodeReport(
+    absl::string_view encoded) {
+  rtc::ByteBufferReader reader(encoded.data(), encoded.size());
+  uint64_t flags;
+  if (!reader.ReadUVarint(&flags))
+    return nullptr;
+  if (flags & kKeyReportFlag) {
+    Reset();
+  } else if (!previous_report_) {
+    return nullptr;
+  }
+
+  uint64_t timestamp_delta;
+  if (!reader.ReadUVarint(&timestamp_delta))
+    return nullptr;
+  const int64_t timestamp_us =
+      (previous_report_ ? previous_report_->timestamp_us() : 0) +
+      FromZigZag(timestamp_delta);
+  rtc::scoped_refptr<RTCStatsReport> report =
+      RTCStatsReport::Create(timestamp_us);
+
+  uint64_t num_schemas;
+  if (!reader.ReadUVarint(&num_schemas))
+    return nullptr;
+  for (uint64_t i = 0; i < num_schemas; ++i) {
+    auto schema = std::make_shared<StatsSchema>();
+    uint64_t num_members;
+    // Every member takes at least three bytes.
+    if (!ReadString(reader, &schema->type) ||
+        !reader.ReadUVarint(&num_members) || num_members > reader.Length()) {
+      return nullptr;
+    }
+    schema->members.resize(num_members);
+    for (StatsSchema::Member& member : schema->members) {
+      uint8_t type;
+      uint8_t is_standardized;
+      if (!ReadString(reader, &member.name) || !reader.ReadUInt8(&type) ||
+          type > RTCStatsMemberInterface::kMapStringDouble ||
+          !reader.ReadUInt8(&is_standardized)) {
+        return nullptr;
+      }
+      member.type = static_cast<RTCStatsMemberInterface::Type>(type);
+      member.is_standardized = is_standardized != 0;
+    }
+    schemas_.push_back(std::move(schema));
+  }
+
+  uint64_t num_ids;
+  if (!reader.ReadUVarint(&num_ids))
+    return nullptr;
+  for (uint64_t i = 0; i < num_ids; ++i) {
+    std::string id;
+    if (!ReadString(reader, &id))
+      return nullptr;
+    ids_.push_back(std::move(id));
+  }
+
+  uint64_t num_stats;
+  if (!reader.ReadUVarint(&num_stats))
+    return nullptr;
+  std::vector<uint8_t> state_bytes;
+  for (uint64_t i = 0; i < num_stats; ++i) {
+    uint64_t schema_index;
+    uint64_t id_index;
+    uint64_t stats_timestamp_delta;
+    if (!reader.ReadUVarint(&schema_index) || schema_index >= schemas_.size() ||
+        !reader.ReadUVarint(&id_index) || id_index >= ids_.size() ||
+        report->Get(ids_[id_index]) ||
+        !reader.ReadUVarint(&stats_timestamp_delta)) {
+      return nullptr;
+    }
+    const std::string& id = ids_[id_index];
+    auto stats = std::make_unique<DecodedStats>(
+        id, timestamp_us + FromZigZag(stats_timestamp_delta),
+        schemas_[schema_index]);
+
+    const RTCStats* previous =
+        previous_report_ ? previous_report_->Get(id) : nullptr;
+    std::vector<const RTCStatsMemberInterface*> previous_members;
+    if (previous && previous->type() == stats->type())
+      previous_members = previous->Members();
+
+    const size_t num_members = schemas_[schema_index]->members.size();
+    state_bytes.resize((num_members + kMemberStatesPerByte - 1) /
+                       kMemberStatesPerByte);
+    if (!reader.ReadBytes(reinterpret_cast<char*>(state_bytes.data()),
+                          state_bytes.size())) {
+      return nullptr;
+    }
+    for (size_t j = 0; j < num_members; ++j) {
+      const MemberState state = static_cast<MemberState>(
+          (state_bytes[j / kMemberStatesPerByte] >>
+           (kMemberStateBits * (j % kMemberStatesPerByte))) &
+          kMemberStateMask);
+      if (state == kUndefined)
+        continue;
+      const RTCStatsMemberInterface* previous_member =
+          previous_members.empty() ? nullptr : previous_members[j];
+      if (state != kValue &&
+          !(previous_member && previous_member->is_defined())) {
+        return nullptr;
+      }
+      bool success = true;
+      VisitMemberType(schemas_[schema_index]->members[j].type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        RTCStatsMember<T>& member = stats->member<T>(j);
+        if (state == kUnchanged) {
+          member = *previous_member->cast_to<RTCStatsMember<T>>();
+          return;
+        }
+        T value;
+        success =
+            state == kValue
+                ? ReadValue(reader, &value)
+                : ReadDelta(reader,
+                            *previous_member->cast_to<RTCStatsMember<T>>(),
+                            &value);
+        if (success)
+          member = std::move(value);
+      });
+      if (!success)
+        return nullptr;
+    }
+    report->AddStats(std::move(stats));
+  }
+  if (reader.Length() != 0)
+    return nullptr;
+  return report;
+}
+
+void RTCStatsReportBinaryDecoder::Reset() {
+  previous_report_ = nullptr;
+  schemas_.clear();
+  ids_.clear();
+}
+
+}  // namespace webrtc
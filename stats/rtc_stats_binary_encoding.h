@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef STATS_RTC_STATS_BINARY_ENCODING_H_
+#define STATS_RTC_STATS_BINARY_ENCODING_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/scoped_refptr.h"
+#include "api/stats/rtc_stats_report.h"
+
+namespace webrtc {
+
+// Encodes a sequence of reports, such as the ones obtained by polling the
+// stats of a PeerConnection, into a compact binary format that
+// RTCStatsReportBinaryDecoder turns back into reports. It is meant for
+// exporting stats off-box, where ToJson() spends most of its time formatting
+// numbers and repeating member names.
+//
+// The member names and types of each stats type are sent the first time the
+// type is encoded, and stats ids the first time they are encoded, after which
+// they are referred to by index. Members equal to the same member of the
+// previous report's stats object with the same id cost two bits, and integer
+// members that changed are sent as the difference to their previous value, so
+// that slowly growing counters take a byte or two. Other members are sent in
+// full.
+//
+// A report can only be decoded by a decoder that decoded all reports since,
+// and including, the latest key report. The first report is always a key
+// report, later ones when requested. The index tables grow with every new id
+// until the next key report, so long running streams should request key
+// reports periodically, which also bounds how much is lost with a report.
+class RTCStatsReportBinaryEncoder {
+ public:
+  RTCStatsReportBinaryEncoder();
+  RTCStatsReportBinaryEncoder(const RTCStatsReportBinaryEncoder&) = delete;
+  RTCStatsReportBinaryEncoder& operator=(const RTCStatsReportBinaryEncoder&) =
+      delete;
+  ~RTCStatsReportBinaryEncoder();
+
+  // Encodes `report`, as a key report if `key_report` is true or if it is the
+  // first report. `report` is referenced until the next key report, as the
+  // baseline of the following report.
+  std::string Encode(rtc::scoped_refptr<const RTCStatsReport> report,
+                     bool key_report = false);
+
+ private:
+  rtc::scoped_refptr<const RTCStatsReport> previous_report_;
+  // Indices of the stats types by `RTCStats::type()`, which is unique per
+  // type, and of the stats ids.
+  std::map<const char*, size_t> schema_indices_;
+  std::map<std::string, size_t> id_indices_;
+};
+
+// Decodes the reports encoded by RTCStatsReportBinaryEncoder, in the order they
+// were encoded. The decoded stats objects aren't instances of the encoded
+// classes, but have the same type(), id, timestamp and members, which are
+// instances of the same RTCStatsMember types, so that they compare equal and
+// serialize to the same JSON. Non-standard group ids aren't encoded.
+class RTCStatsReportBinaryDecoder {
+ public:
+  RTCStatsReportBinaryDecoder();
+  RTCStatsReportBinaryDecoder(const RTCStatsReportBinaryDecoder&) = delete;
+  RTCStatsReportBinaryDecoder& operator=(const RTCStatsReportBinaryDecoder&) =
+      delete;
+  ~RTCStatsReportBinaryDecoder();
+
+  // Returns the decoded report, or null if `encoded` is malformed or if it
+  // isn't a key report and the report before it wasn't decoded. After a
+  // failure, only a key report can be decoded.
+  rtc::scoped_refptr<const RTCStatsReport> Decode(absl::string_view encoded);
+
+ private:
+  struct StatsSchema;
+  class DecodedStats;
+
+  rtc::scoped_refptr<RTCStatsReport> DecodeReport(absl::string_view encoded);
+  void Reset();
+
+  rtc::scoped_refptr<const RTCStatsReport> previous_report_;
+  // Shared with the decoded stats objects, which reference the names in them.
+  std::vector<std::shared_ptr<const StatsSchema>> schemas_;
+  std::vector<std::string> ids_;
+};
+
+}  // namespace webrtc
+
+#endif  // STATS_RTC_STATS_BINARY_ENCODING_H_
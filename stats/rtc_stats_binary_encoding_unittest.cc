@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "stats/rtc_stats_binary_encoding.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/stats/rtc_stats.h"
+#include "api/stats/rtc_stats_report.h"
+#include "stats/test/rtc_test_stats.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+class RTCBinaryTestStats : public RTCStats {
+ public:
+  WEBRTC_RTCSTATS_DECL();
+
+  RTCBinaryTestStats(const std::string& id, int64_t timestamp_us)
+      : RTCStats(id, timestamp_us),
+        counter("counter"),
+        non_standard("nonStandard") {}
+
+  RTCStatsMember<uint64_t> counter;
+  RTCNonStandardStatsMember<int32_t> non_standard;
+};
+
+WEBRTC_RTCSTATS_IMPL(RTCBinaryTestStats,
+                     RTCStats,
+                     "binary-test-stats",
+                     &counter,
+                     &non_standard)
+
+namespace {
+
+std::unique_ptr<RTCTestStats> CreateTestStats(const std::string& id,
+                                              int64_t timestamp_us) {
+  auto stats = std::make_unique<RTCTestStats>(id, timestamp_us);
+  stats->m_bool = true;
+  stats->m_int32 = -123;
+  stats->m_uint32 = 123;
+  stats->m_int64 = std::numeric_limits<int64_t>::min();
+  stats->m_uint64 = std::numeric_limits<uint64_t>::max();
+  stats->m_double = 0.25;
+  stats->m_string = "string";
+  stats->m_sequence_bool = std::vector<bool>{true, false, true};
+  stats->m_sequence_int32 = std::vector<int32_t>{-1, 0, 1};
+  stats->m_sequence_uint32 = std::vector<uint32_t>{1, 2, 3};
+  stats->m_sequence_int64 = std::vector<int64_t>{-1000000000000, 1};
+  stats->m_sequence_uint64 = std::vector<uint64_t>{1000000000000};
+  stats->m_sequence_double = std::vector<double>{-0.5, 1e100};
+  stats->m_sequence_string = std::vector<std::string>{"a", "", "c"};
+  stats->m_map_string_uint64 = std::map<std::string, uint64_t>{{"a", 1}};
+  stats->m_map_string_double =
+      std::map<std::string, double>{{"a", 1.5}, {"b", -2.5}};
+  return stats;
+}
+
+void ExpectReportsEqual(const RTCStatsReport& expected,
+                        const RTCStatsReport& actual) {
+  EXPECT_EQ(actual.timestamp_us(), expected.timestamp_us());
+  ASSERT_EQ(actual.size(), expected.size());
+  for (const RTCStats& expected_stats : expected) {
+    const RTCStats* actual_stats = actual.Get(expected_stats.id());
+    ASSERT_TRUE(actual_stats) << expected_stats.id();
+    EXPECT_STREQ(actual_stats->type(), expected_stats.type());
+    EXPECT_EQ(actual_stats->timestamp_us(), expected_stats.timestamp_us());
+    std::vector<const RTCStatsMemberInterface*> expected_members =
+        expected_stats.Members();
+    std::vector<const RTCStatsMemberInterface*> actual_members =
+        actual_stats->Members();
+    ASSERT_EQ(actual_members.size(), expected_members.size());
+    for (size_t i = 0; i < expected_members.size(); ++i) {
+      EXPECT_STREQ(actual_members[i]->name(), expected_members[i]->name());
+      EXPECT_TRUE(*actual_members[i] == *expected_members[i])
+          << expected_members[i]->name();
+    }
+  }
+  EXPECT_EQ(actual.ToJson(), expected.ToJson());
+}
+
+TEST(RTCStatsBinaryEncodingTest, RoundTripsAllMemberTypes) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateTestStats("defined", 1000));
+  report->AddStats(std::make_unique<RTCTestStats>("undefined", 900));
+  auto binary_stats = std::make_unique<RTCBinaryTestStats>("binary", 1000);
+  binary_stats->counter = 7;
+  binary_stats->non_standard = -7;
+  report->AddStats(std::move(binary_stats));
+
+  RTCStatsReportBinaryEncoder encoder;
+  RTCStatsReportBinaryDecoder decoder;
+  rtc::scoped_refptr<const RTCStatsReport> decoded =
+      decoder.Decode(encoder.Encode(report));
+  ASSERT_TRUE(decoded);
+  ExpectReportsEqual(*report, *decoded);
+  EXPECT_FALSE(decoded->Get("binary")->Members()[1]->is_standardized());
+
+  // A copy of a decoded stats object is a decoded stats object too.
+  std::unique_ptr<RTCStats> copy = decoded->Get("defined")->copy();
+  EXPECT_TRUE(*copy == *decoded->Get("defined"));
+  EXPECT_EQ(copy->ToJson(), report->Get("defined")->ToJson());
+}
+
+TEST(RTCStatsBinaryEncodingTest, RoundTripsDeltaReports) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateTestStats("changed", 1000));
+  report->AddStats(CreateTestStats("removed", 1000));
+
+  rtc::scoped_refptr<RTCStatsReport> next_report =
+      RTCStatsReport::Create(2000);
+  // The members that aren't set become undefined.
+  auto changed = std::make_unique<RTCTestStats>("changed", 2000);
+  changed->m_int32 = 123;
+  // Shrinking unsigned members and wrapping around both ways.
+  changed->m_uint32 = 0;
+  changed->m_int64 = std::numeric_limits<int64_t>::max();
+  changed->m_uint64 = 0;
+  changed->m_double = 0.5;
+  changed->m_string = "changed";
+  changed->m_sequence_int32 = std::vector<int32_t>{-1, 0, 1, 2};
+  changed->m_map_string_double =
+      std::map<std::string, double>{{"a", 1.5}, {"b", -2.5}};
+  next_report->AddStats(std::move(changed));
+  next_report->AddStats(CreateTestStats("added", 1500));
+
+  RTCStatsReportBinaryEncoder encoder;
+  RTCStatsReportBinaryDecoder decoder;
+  ASSERT_TRUE(decoder.Decode(encoder.Encode(report)));
+  rtc::scoped_refptr<const RTCStatsReport> decoded =
+      decoder.Decode(encoder.Encode(next_report));
+  ASSERT_TRUE(decoded);
+  ExpectReportsEqual(*next_report, *decoded);
+
+  // Members that become defined again are sent in full.
+  rtc::scoped_refptr<RTCStatsReport> last_report = RTCStatsReport::Create(3000);
+  last_report->AddStats(CreateTestStats("changed", 3000));
+  decoded = decoder.Decode(encoder.Encode(last_report));
+  ASSERT_TRUE(decoded);
+  ExpectReportsEqual(*last_report, *decoded);
+}
+
+TEST(RTCStatsBinaryEncodingTest, DeltaReportsAreSmall) {
+  constexpr int kNumStats = 20;
+  auto create_report = [](int64_t timestamp_us, uint64_t counter) {
+    rtc::scoped_refptr<RTCStatsReport> report =
+        RTCStatsReport::Create(timestamp_us);
+    for (int i = 0; i < kNumStats; ++i) {
+      auto stats = std::make_unique<RTCBinaryTestStats>(
+          "binary-test-stats-" + std::to_string(i), timestamp_us);
+      stats->counter = counter;
+      stats->non_standard = i;
+      report->AddStats(std::move(stats));
+    }
+    return report;
+  };
+
+  rtc::scoped_refptr<RTCStatsReport> report = create_report(1000000, 1000000);
+  RTCStatsReportBinaryEncoder encoder;
+  std::string key_report = encoder.Encode(report);
+  EXPECT_LT(key_report.size(), report->ToJson().size() / 2);
+
+  // Every counter grows by 50, which takes a byte of delta, on top of a byte
+  // of member states and three bytes of indices and timestamp per stats
+  // object.
+  report = create_report(2000000, 1000050);
+  std::string delta_report = encoder.Encode(report);
+  EXPECT_LE(delta_report.size(), 10u + 5 * kNumStats);
+  EXPECT_LT(delta_report.size(), key_report.size() / 4);
+
+  RTCStatsReportBinaryDecoder decoder;
+  ASSERT_TRUE(decoder.Decode(key_report));
+  rtc::scoped_refptr<const RTCStatsReport> decoded =
+      decoder.Decode(delta_report);
+  ASSERT_TRUE(decoded);
+  ExpectReportsEqual(*report, *decoded);
+}
+
+TEST(RTCStatsBinaryEncodingTest, DeltaReportNeedsPreviousReport) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateTestStats("stats", 1000));
+  RTCStatsReportBinaryEncoder encoder;
+  std::string first = encoder.Encode(report);
+  std::string second = encoder.Encode(report);
+  std::string third = encoder.Encode(report, /*key_report=*/true);
+
+  RTCStatsReportBinaryDecoder decoder;
+  EXPECT_FALSE(decoder.Decode(second));
+  rtc::scoped_refptr<const RTCStatsReport> decoded = decoder.Decode(third);
+  ASSERT_TRUE(decoded);
+  ExpectReportsEqual(*report, *decoded);
+
+  // A key report is decodable after a report failed to decode.
+  RTCStatsReportBinaryDecoder other_decoder;
+  ASSERT_TRUE(other_decoder.Decode(first));
+  EXPECT_FALSE(other_decoder.Decode("garbage"));
+  EXPECT_FALSE(other_decoder.Decode(second));
+  EXPECT_TRUE(other_decoder.Decode(third));
+}
+
+TEST(RTCStatsBinaryEncodingTest, RejectsTruncatedReports) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateTestStats("stats", 1000));
+  std::string encoded = RTCStatsReportBinaryEncoder().Encode(report);
+  for (size_t size = 0; size < encoded.size(); ++size) {
+    RTCStatsReportBinaryDecoder decoder;
+    EXPECT_FALSE(decoder.Decode(absl::string_view(encoded.data(), size)))
+        << size;
+  }
+  EXPECT_FALSE(RTCStatsReportBinaryDecoder().Decode(encoded + '\0'));
+}
+
+}  // namespace
+}  // namespace webrtc
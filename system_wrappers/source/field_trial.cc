@@ -12,7 +12,9 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
@@ -29,6 +31,42 @@ static const char* trials_init_string = NULL;
 #ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 namespace {
 constexpr char kPersistentStringSeparator = '/';
+
+using TrialTable = std::unordered_map<std::string, std::string>;
+
+// The groups of `trials_init_string` by trial name, parsed once when the
+// string is set, since FindFullName() is called whenever e.g. a
+// PacingController or a GoogCcNetworkController is created. Null if
+// `trials_init_string` is null or empty.
+const TrialTable* trials_table = nullptr;
+
+// Parses `trials_string` like FindFullName() used to for every lookup: the
+// first group of a trial wins, and parsing stops at the first malformed
+// name/group pair.
+std::unique_ptr<TrialTable> ParseTrials(absl::string_view trials_string) {
+  auto table = std::make_unique<TrialTable>();
+  size_t next_item = 0;
+  while (next_item < trials_string.length()) {
+    // Find next name/value pair in field trial configuration string.
+    size_t field_name_end =
+        trials_string.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials_string.npos || field_name_end == next_item)
+      break;
+    size_t field_value_end =
+        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials_string.npos ||
+        field_value_end == field_name_end + 1)
+      break;
+    absl::string_view field_name =
+        trials_string.substr(next_item, field_name_end - next_item);
+    absl::string_view field_value = trials_string.substr(
+        field_name_end + 1, field_value_end - field_name_end - 1);
+    next_item = field_value_end + 1;
+
+    table->emplace(std::string(field_name), std::string(field_value));
+  }
+  return table;
+}
 // Validates the given field trial string.
 //  E.g.:
 //    "WebRTC-experimentFoo/Enabled/WebRTC-experimentBar/Enabled100kbps/"
@@ -103,35 +141,12 @@ std::string MergeFieldTrialsStrings(const char* first, const char* second) {
 }
 
 std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
+  if (trials_table == nullptr)
     return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
+  auto it = trials_table->find(name);
+  if (it == trials_table->end())
     return std::string();
-
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
-  }
-  return std::string();
+  return it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -143,6 +158,10 @@ void InitFieldTrialsFromString(const char* trials_string) {
     RTC_DCHECK(FieldTrialsStringIsValidInternal(trials_string))
         << "Invalid field trials string:" << trials_string;
   };
+  delete trials_table;
+  trials_table = trials_string && trials_string[0] != '\0'
+                     ? ParseTrials(trials_string).release()
+                     : nullptr;
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
 }
@@ -103,5 +103,31 @@ TEST(FieldTrialMergingTest, HandlesEmptyInput) {
 #endif  // GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID)
         // && !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+TEST(FieldTrialTest, FindsGroupOfEachTrial) {
+  const char* previous_trials = GetFieldTrialString();
+  InitFieldTrialsFromString("Audio/Enabled/Video/Disabled,Foo:1/B/C/");
+  EXPECT_EQ(FindFullName("Audio"), "Enabled");
+  EXPECT_EQ(FindFullName("Video"), "Disabled,Foo:1");
+  EXPECT_EQ(FindFullName("B"), "C");
+  EXPECT_EQ(FindFullName("Audi"), "");
+  EXPECT_EQ(FindFullName("Enabled"), "");
+  EXPECT_TRUE(IsEnabled("Audio"));
+  EXPECT_TRUE(IsDisabled("Video"));
+
+  // The table follows the trial string when it is replaced.
+  InitFieldTrialsFromString("Audio/Disabled/");
+  EXPECT_EQ(FindFullName("Audio"), "Disabled");
+  EXPECT_EQ(FindFullName("Video"), "");
+
+  InitFieldTrialsFromString("");
+  EXPECT_EQ(FindFullName("Audio"), "");
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ(FindFullName("Audio"), "");
+
+  InitFieldTrialsFromString(previous_trials);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 }  // namespace field_trial
 }  // namespace webrtc
@@ -25,6 +25,7 @@ class MockFrameTransformer : public FrameTransformerInterface {
               Transform,
               (std::unique_ptr<TransformableFrameInterface>),
               (override));
+  MOCK_METHOD(bool, IsSynchronous, (), (const, override));
   MOCK_METHOD(void,
               RegisterTransformedFrameCallback,
               (rtc::scoped_refptr<TransformedFrameCallback>),
@@ -311,27 +311,38 @@ void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
 void LinkEmulation::Process(Timestamp at_time) {
   std::vector<PacketDeliveryInfo> delivery_infos =
       network_behavior_->DequeueDeliverablePackets(at_time.us());
+  std::vector<EmulatedIpPacket> delivered_packets;
   for (PacketDeliveryInfo& delivery_info : delivery_infos) {
-    StoredPacket* packet = nullptr;
-    for (auto& stored_packet : packets_) {
-      if (stored_packet.id == delivery_info.packet_id) {
-        packet = &stored_packet;
-        break;
-      }
-    }
-    RTC_CHECK(packet);
+    auto packet = std::lower_bound(
+        packets_.begin(), packets_.end(), delivery_info.packet_id,
+        [](const StoredPacket& stored_packet, uint64_t id) {
+          return stored_packet.id < id;
+        });
+    RTC_CHECK(packet != packets_.end() &&
+              packet->id == delivery_info.packet_id);
     RTC_DCHECK(!packet->removed);
     packet->removed = true;
 
     if (delivery_info.receive_time_us != PacketDeliveryInfo::kNotReceived) {
       packet->packet.arrival_time =
           Timestamp::Micros(delivery_info.receive_time_us);
-      receiver_->OnPacketReceived(std::move(packet->packet));
+      if (receiver_task_queue_ == task_queue_) {
+        receiver_->OnPacketReceived(std::move(packet->packet));
+      } else {
+        delivered_packets.push_back(std::move(packet->packet));
+      }
     }
     while (!packets_.empty() && packets_.front().removed) {
       packets_.pop_front();
     }
   }
+  if (delivered_packets.empty())
+    return;
+  receiver_task_queue_->PostTask(
+      [receiver = receiver_, packets = std::move(delivered_packets)]() mutable {
+        for (EmulatedIpPacket& packet : packets)
+          receiver->OnPacketReceived(std::move(packet));
+      });
 }
 
 NetworkRouterNode::NetworkRouterNode(rtc::TaskQueue* task_queue)
@@ -412,8 +423,22 @@ EmulatedNetworkNode::EmulatedNetworkNode(
     Clock* clock,
     rtc::TaskQueue* task_queue,
     std::unique_ptr<NetworkBehaviorInterface> network_behavior)
+    : EmulatedNetworkNode(clock,
+                          task_queue,
+                          task_queue,
+                          std::move(network_behavior)) {}
+
+EmulatedNetworkNode::EmulatedNetworkNode(
+    Clock* clock,
+    rtc::TaskQueue* task_queue,
+    rtc::TaskQueue* link_task_queue,
+    std::unique_ptr<NetworkBehaviorInterface> network_behavior)
     : router_(task_queue),
-      link_(clock, task_queue, std::move(network_behavior), &router_) {}
+      link_(clock,
+            link_task_queue,
+            std::move(network_behavior),
+            &router_,
+            task_queue) {}
 
 void EmulatedNetworkNode::OnPacketReceived(EmulatedIpPacket packet) {
   link_.OnPacketReceived(std::move(packet));
@@ -16,6 +16,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -27,6 +28,7 @@
 #include "api/test/simulated_network.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_constants.h"
 #include "rtc_base/socket_address.h"
@@ -395,10 +397,23 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
                 rtc::TaskQueue* task_queue,
                 std::unique_ptr<NetworkBehaviorInterface> network_behavior,
                 EmulatedNetworkReceiverInterface* receiver)
+      : LinkEmulation(clock,
+                      task_queue,
+                      std::move(network_behavior),
+                      receiver,
+                      task_queue) {}
+  // Emulates the link on `task_queue` and delivers packets to `receiver` on
+  // `receiver_task_queue`.
+  LinkEmulation(Clock* clock,
+                rtc::TaskQueue* task_queue,
+                std::unique_ptr<NetworkBehaviorInterface> network_behavior,
+                EmulatedNetworkReceiverInterface* receiver,
+                rtc::TaskQueue* receiver_task_queue)
       : clock_(clock),
         task_queue_(task_queue),
         network_behavior_(std::move(network_behavior)),
-        receiver_(receiver) {}
+        receiver_(receiver),
+        receiver_task_queue_(receiver_task_queue) {}
   void OnPacketReceived(EmulatedIpPacket packet) override;
 
  private:
@@ -414,7 +429,9 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
   const std::unique_ptr<NetworkBehaviorInterface> network_behavior_
       RTC_GUARDED_BY(task_queue_);
   EmulatedNetworkReceiverInterface* const receiver_;
+  rtc::TaskQueue* const receiver_task_queue_;
   RepeatingTaskHandle process_task_ RTC_GUARDED_BY(task_queue_);
+  // Ordered by increasing id.
   std::deque<StoredPacket> packets_ RTC_GUARDED_BY(task_queue_);
   uint64_t next_packet_id_ RTC_GUARDED_BY(task_queue_) = 1;
 };
@@ -439,11 +456,19 @@ class NetworkRouterNode : public EmulatedNetworkReceiverInterface {
   void SetFilter(std::function<bool(const EmulatedIpPacket&)> filter);
 
  private:
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+
   rtc::TaskQueue* const task_queue_;
   absl::optional<EmulatedNetworkReceiverInterface*> default_receiver_
       RTC_GUARDED_BY(task_queue_);
-  std::map<rtc::IPAddress, EmulatedNetworkReceiverInterface*> routing_
-      RTC_GUARDED_BY(task_queue_);
+  std::unordered_map<rtc::IPAddress,
+                     EmulatedNetworkReceiverInterface*,
+                     IPAddressHash>
+      routing_ RTC_GUARDED_BY(task_queue_);
   std::function<void(const EmulatedIpPacket&)> watcher_
       RTC_GUARDED_BY(task_queue_);
   std::function<bool(const EmulatedIpPacket&)> filter_
@@ -465,6 +490,14 @@ class EmulatedNetworkNode : public EmulatedNetworkReceiverInterface {
       Clock* clock,
       rtc::TaskQueue* task_queue,
       std::unique_ptr<NetworkBehaviorInterface> network_behavior);
+  // Same as above, but emulates the link on `link_task_queue`, so that nodes
+  // with different link task queues can process packets in parallel. The
+  // packets are still routed on `task_queue`.
+  EmulatedNetworkNode(
+      Clock* clock,
+      rtc::TaskQueue* task_queue,
+      rtc::TaskQueue* link_task_queue,
+      std::unique_ptr<NetworkBehaviorInterface> network_behavior);
   ~EmulatedNetworkNode() override;
 
   EmulatedNetworkNode(const EmulatedNetworkNode&) = delete;
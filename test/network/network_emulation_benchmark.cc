@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/test/network_emulation_manager.h"
+#include "api/test/simulated_network.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/socket_address.h"
+#include "test/network/network_emulation_manager.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kRounds = 100;
+constexpr size_t kPacketSize = 1000;
+constexpr uint16_t kSenderPort = 5000;
+
+class CountingReceiver : public EmulatedNetworkReceiverInterface {
+ public:
+  void OnPacketReceived(EmulatedIpPacket packet) override { ++received_; }
+  int received() const { return received_; }
+
+ private:
+  std::atomic<int> received_{0};
+};
+
+struct Sender {
+  EmulatedEndpoint* endpoint;
+  rtc::SocketAddress to;
+};
+
+// Sends `kRounds` packets, 1 ms apart, from each of `state.range(0)` senders
+// to their own receiver endpoints in simulated time. Every sender has its own
+// access node, and all senders share one core node with a 20 ms delay, so the
+// core router has one route per receiver and the core link holds the packets
+// of 20 rounds.
+void BM_EmulatedPackets(benchmark::State& state) {
+  const int num_senders = state.range(0);
+  for (auto s : state) {
+    state.PauseTiming();
+    auto manager =
+        std::make_unique<NetworkEmulationManagerImpl>(TimeMode::kSimulated);
+    CountingReceiver receiver;
+    BuiltInNetworkBehaviorConfig core_config;
+    core_config.queue_delay_ms = 20;
+    EmulatedNetworkNode* core = manager->CreateEmulatedNode(core_config);
+    std::vector<Sender> senders;
+    for (int i = 0; i < num_senders; ++i) {
+      EmulatedNetworkNode* access =
+          manager->CreateEmulatedNode(BuiltInNetworkBehaviorConfig());
+      EmulatedEndpoint* from =
+          manager->CreateEndpoint(EmulatedEndpointConfig());
+      EmulatedEndpoint* to = manager->CreateEndpoint(EmulatedEndpointConfig());
+      manager->CreateRoute(from, {access, core}, to);
+      uint16_t port = to->BindReceiver(0, &receiver).value();
+      senders.push_back(
+          {from, rtc::SocketAddress(to->GetPeerLocalAddress(), port)});
+    }
+    manager->time_controller()->AdvanceTime(TimeDelta::Zero());
+    state.ResumeTiming();
+
+    for (int round = 0; round < kRounds; ++round) {
+      for (const Sender& sender : senders) {
+        sender.endpoint->SendPacket(
+            rtc::SocketAddress(sender.endpoint->GetPeerLocalAddress(),
+                               kSenderPort),
+            sender.to, rtc::CopyOnWriteBuffer(kPacketSize));
+      }
+      manager->time_controller()->AdvanceTime(TimeDelta::Millis(1));
+    }
+    manager->time_controller()->AdvanceTime(TimeDelta::Millis(100));
+
+    state.PauseTiming();
+    RTC_CHECK_EQ(receiver.received(), num_senders * kRounds);
+    manager.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_senders * kRounds);
+}
+
+BENCHMARK(BM_EmulatedPackets)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -31,6 +31,11 @@ constexpr uint32_t kMinIPv4Address = 0xC0A80000;
 // uint32_t representation of 192.168.255.255 address
 constexpr uint32_t kMaxIPv4Address = 0xC0A8FFFF;
 
+// The links of the emulated nodes are spread over this many task queues, so
+// that they process packets in parallel with each other and with the routing
+// on the emulation task queue.
+constexpr size_t kLinkTaskQueueCount = 8;
+
 std::unique_ptr<TimeController> CreateTimeController(TimeMode mode) {
   switch (mode) {
     case TimeMode::kRealTime:
@@ -73,8 +78,15 @@ EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
     std::unique_ptr<NetworkBehaviorInterface> network_behavior) {
+  size_t link_task_queue_index = next_link_task_queue_++ % kLinkTaskQueueCount;
+  if (link_task_queue_index == link_task_queues_.size()) {
+    link_task_queues_.push_back(std::make_unique<TaskQueueForTest>(
+        time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
+            "NetworkEmulationLink", TaskQueueFactory::Priority::NORMAL)));
+  }
   auto node = std::make_unique<EmulatedNetworkNode>(
-      clock_, &task_queue_, std::move(network_behavior));
+      clock_, &task_queue_, link_task_queues_[link_task_queue_index].get(),
+      std::move(network_behavior));
   EmulatedNetworkNode* out = node.get();
   task_queue_.PostTask([this, node = std::move(node)]() mutable {
     network_nodes_.push_back(std::move(node));
@@ -108,6 +108,7 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   RepeatingTaskHandle process_task_handle_;
 
   uint32_t next_ip4_address_;
+  size_t next_link_task_queue_ = 0;
   std::set<rtc::IPAddress> used_ip_addresses_;
 
   // All objects can be added to the manager only when it is idle.
@@ -124,9 +125,12 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   std::map<EmulatedEndpoint*, EmulatedNetworkManager*>
       endpoint_to_network_manager_;
 
-  // Must be the last field, so it will be deleted first, because tasks
-  // in the TaskQueue can access other fields of the instance of this class.
+  // Must be after all other fields except `link_task_queues_`, so it will be
+  // deleted before them, because tasks in the TaskQueue can access other
+  // fields of the instance of this class.
   TaskQueueForTest task_queue_;
+  // Deleted first, as the links post packets to `task_queue_`.
+  std::vector<std::unique_ptr<TaskQueueForTest>> link_task_queues_;
 };
 
 }  // namespace test
@@ -13,6 +13,7 @@
 #include <atomic>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "api/test/simulated_network.h"
 #include "api/units/time_delta.h"
@@ -639,6 +640,41 @@ TEST(NetworkEmulationManagerTURNTest, GetIceServerConfig) {
             std::string::npos);
 }
 
+TEST(NetworkEmulationManagerTest, PacketsArriveInOrderOverMultipleLinks) {
+  NetworkEmulationManagerImpl emulation(TimeMode::kSimulated);
+  BuiltInNetworkBehaviorConfig config;
+  config.link_capacity_kbps = 1000;
+  config.queue_delay_ms = 20;
+  // The links of the nodes are emulated on different task queues.
+  std::vector<EmulatedNetworkNode*> nodes;
+  for (int i = 0; i < 3; ++i)
+    nodes.push_back(emulation.CreateEmulatedNode(config));
+  EmulatedEndpoint* from = emulation.CreateEndpoint(EmulatedEndpointConfig());
+  EmulatedEndpoint* to = emulation.CreateEndpoint(EmulatedEndpointConfig());
+  emulation.CreateRoute(from, nodes, to);
+
+  std::vector<size_t> received_sizes;
+  MockReceiver receiver;
+  EXPECT_CALL(receiver, OnPacketReceived)
+      .WillRepeatedly([&](EmulatedIpPacket packet) {
+        received_sizes.push_back(packet.size());
+      });
+  uint16_t port = to->BindReceiver(0, &receiver).value();
+
+  constexpr int kNumPackets = 100;
+  for (int i = 0; i < kNumPackets; ++i) {
+    from->SendPacket(rtc::SocketAddress(from->GetPeerLocalAddress(), 1000),
+                     rtc::SocketAddress(to->GetPeerLocalAddress(), port),
+                     rtc::CopyOnWriteBuffer(100 + i));
+    emulation.time_controller()->AdvanceTime(TimeDelta::Millis(1));
+  }
+  emulation.time_controller()->AdvanceTime(TimeDelta::Seconds(1));
+
+  ASSERT_EQ(received_sizes.size(), static_cast<size_t>(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i)
+    EXPECT_EQ(received_sizes[i], static_cast<size_t>(100 + i));
+}
+
 TEST(NetworkEmulationManagerTURNTest, ClientTraffic) {
   NetworkEmulationManagerImpl emulation(TimeMode::kSimulated);
   auto* ep = emulation.CreateEndpoint(EmulatedEndpointConfig());
@@ -240,9 +240,18 @@ uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
     stream_to_frame_id_full_history_[stream_index].push_back(frame_id);
 
     // If state has too many frames that are in flight => remove the oldest
-    // queued frame in order to avoid to use too much memory.
-    if (state->GetAliveFramesCount() >
-        options_.max_frames_in_flight_per_stream_count) {
+    // queued frames in order to avoid to use too much memory.
+    size_t max_alive_frames = options_.max_frames_in_flight_per_stream_count;
+    if (options_.max_captured_frames_memory_bytes.has_value()) {
+      const size_t frame_size = std::max<size_t>(
+          CalcBufferSize(VideoType::kI420, frame.width(), frame.height()), 1);
+      max_alive_frames = std::min(
+          max_alive_frames,
+          std::max<size_t>(*options_.max_captured_frames_memory_bytes /
+                               stream_states_.size() / frame_size,
+                           1));
+    }
+    while (state->GetAliveFramesCount() > max_alive_frames) {
       uint16_t frame_id_to_remove = state->MarkNextAliveFrameAsDead();
       auto it = captured_frames_in_flight_.find(frame_id_to_remove);
       RTC_CHECK(it != captured_frames_in_flight_.end())
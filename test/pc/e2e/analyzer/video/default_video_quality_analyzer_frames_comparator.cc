@@ -315,9 +315,22 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparisonInternal(
     if (!captured && type == FrameComparisonType::kRegular) {
       overload_reason = OverloadReason::kMemory;
     }
+    bool keep_frames = options_.heavy_metrics_computation_enabled;
+    if (keep_frames && captured && rendered &&
+        options_.heavy_metrics_sampling_interval > 1) {
+      int64_t& count = heavy_metrics_candidates_count_[stats_key];
+      keep_frames = count % options_.heavy_metrics_sampling_interval == 0;
+      ++count;
+    }
     comparisons_.emplace_back(ValidateFrameComparison(FrameComparison(
         std::move(stats_key), std::move(captured), std::move(rendered), type,
         std::move(frame_stats), overload_reason)));
+    if (!keep_frames) {
+      // Release the frames right away, PSNR and SSIM won't be computed for
+      // them anyway.
+      comparisons_.back().captured = absl::nullopt;
+      comparisons_.back().rendered = absl::nullopt;
+    }
   }
   comparison_available_event_.Set();
   cpu_measurer_.StopExcludingCpuThreadTime();
@@ -146,6 +146,10 @@ class DefaultVideoQualityAnalyzerFramesComparator {
   std::map<InternalStatsKey, Timestamp> stream_last_freeze_end_time_
       RTC_GUARDED_BY(mutex_);
   std::deque<FrameComparison> comparisons_ RTC_GUARDED_BY(mutex_);
+  // Number of comparisons with both frames present per stream, used to pick
+  // the ones for which PSNR and SSIM are computed.
+  std::map<InternalStatsKey, int64_t> heavy_metrics_candidates_count_
+      RTC_GUARDED_BY(mutex_);
   FramesComparatorStats frames_comparator_stats_ RTC_GUARDED_BY(mutex_);
 
   std::vector<rtc::PlatformThread> thread_pool_;
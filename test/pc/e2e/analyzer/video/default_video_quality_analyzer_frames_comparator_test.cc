@@ -11,10 +11,12 @@
 #include "test/pc/e2e/analyzer/video/default_video_quality_analyzer_frames_comparator.h"
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "api/test/create_frame_generator.h"
 #include "api/units/timestamp.h"
+#include "api/video/video_frame.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/sleep.h"
@@ -131,6 +133,51 @@ TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
       GetFirstOrDie(stats.at(stats_key).resolution_of_rendered_frame), 100.0);
 }
 
+TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
+     HeavyMetricsComputedOnlyForSampledFrames) {
+  DefaultVideoQualityAnalyzerOptions options = AnalyzerOptionsForTest();
+  options.heavy_metrics_computation_enabled = true;
+  options.heavy_metrics_sampling_interval = 3;
+  DefaultVideoQualityAnalyzerCpuMeasurer cpu_measurer;
+  DefaultVideoQualityAnalyzerFramesComparator comparator(
+      Clock::GetRealTimeClock(), cpu_measurer, options);
+
+  Timestamp stream_start_time = Clock::GetRealTimeClock()->CurrentTime();
+  size_t stream = 0;
+  size_t sender = 0;
+  size_t receiver = 1;
+  size_t peers_count = 2;
+  InternalStatsKey stats_key(stream, sender, receiver);
+
+  std::unique_ptr<test::FrameGeneratorInterface> frame_generator =
+      test::CreateSquareFrameGenerator(/*width=*/10, /*height=*/10,
+                                       /*type=*/absl::nullopt,
+                                       /*num_squares=*/absl::nullopt);
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(
+                             frame_generator->NextFrame().buffer)
+                         .set_timestamp_us(0)
+                         .build();
+  FrameStats frame_stats =
+      FrameStatsWith10msDeltaBetweenPhasesAnd10x10Frame(stream_start_time);
+
+  comparator.Start(1);
+  comparator.EnsureStatsForStream(stream, sender, peers_count,
+                                  stream_start_time, stream_start_time);
+  for (int i = 0; i < 6; ++i) {
+    comparator.AddComparison(stats_key, frame, frame,
+                             FrameComparisonType::kRegular, frame_stats);
+    frame_stats = ShiftStatsOn(frame_stats, TimeDelta::Millis(15));
+  }
+  comparator.Stop(/*last_rendered_frame_times=*/{});
+
+  StreamStats stats = comparator.stream_stats().at(stats_key);
+  EXPECT_EQ(stats.psnr.NumSamples(), 2);
+  EXPECT_EQ(stats.ssim.NumSamples(), 2);
+  EXPECT_EQ(stats.total_delay_incl_transport_ms.NumSamples(), 6);
+  EXPECT_EQ(comparator.frames_comparator_stats().comparisons_done, 6);
+}
+
 TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
      MultiFrameStatsPresentedAfterAddingTwoComparisonWith10msDelay) {
   DefaultVideoQualityAnalyzerCpuMeasurer cpu_measurer;
@@ -220,11 +220,23 @@ struct DefaultVideoQualityAnalyzerOptions {
   // significantly slows down the comparison, so turn it on only when it is
   // needed.
   bool adjust_cropping_before_comparing_frames = false;
+  // PSNR and SSIM are computed only for every
+  // `heavy_metrics_sampling_interval`-th rendered frame of each stream on each
+  // receiver. The frames of the other comparisons are released as soon as
+  // they are queued. Has no effect if `heavy_metrics_computation_enabled` is
+  // false.
+  size_t heavy_metrics_sampling_interval = 1;
   // Amount of frames that are queued in the DefaultVideoQualityAnalyzer from
   // the point they were captured to the point they were rendered on all
   // receivers per stream.
   size_t max_frames_in_flight_per_stream_count =
       kDefaultMaxFramesInFlightPerStream;
+  // If set, limits the memory used by the captured frames that are queued in
+  // the DefaultVideoQualityAnalyzer, summed over all streams. The limit is
+  // split evenly between the streams and, like
+  // `max_frames_in_flight_per_stream_count`, is enforced by dropping the
+  // oldest captured frames, so that PSNR and SSIM aren't computed for them.
+  absl::optional<size_t> max_captured_frames_memory_bytes;
   // If true, the analyzer will expect peers to receive their own video streams.
   bool enable_receive_own_stream = false;
 };
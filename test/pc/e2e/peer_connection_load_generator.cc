@@ -0,0 +1,346 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/pc/e2e/peer_connection_load_generator.h"
+
+#include <map>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/jsep.h"
+#include "api/media_stream_interface.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/test/stats_observer_interface.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "system_wrappers/include/clock.h"
+#include "test/fake_decoder.h"
+#include "test/fake_vp8_encoder.h"
+#include "test/frame_generator_capturer.h"
+#include "test/pc/e2e/peer_configurer.h"
+#include "test/pc/e2e/stats_poller.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+namespace {
+
+constexpr TimeDelta kDefaultTimeout = TimeDelta::Seconds(10);
+constexpr char kStreamLabel[] = "video";
+
+class FakeVp8EncoderFactory : public VideoEncoderFactory {
+ public:
+  explicit FakeVp8EncoderFactory(Clock* clock) : clock_(clock) {}
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override {
+    return {SdpVideoFormat("VP8")};
+  }
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override {
+    return std::make_unique<test::FakeVp8Encoder>(clock_);
+  }
+
+ private:
+  Clock* const clock_;
+};
+
+class FakeVp8DecoderFactory : public VideoDecoderFactory {
+ public:
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override {
+    return {SdpVideoFormat("VP8")};
+  }
+  std::unique_ptr<VideoDecoder> CreateVideoDecoder(
+      const SdpVideoFormat& format) override {
+    return std::make_unique<test::FakeDecoder>();
+  }
+};
+
+// Keeps the latest stats report of every peer.
+class StatsCollector : public StatsObserverInterface {
+ public:
+  void OnStatsReports(
+      absl::string_view pc_label,
+      const rtc::scoped_refptr<const RTCStatsReport>& report) override {
+    MutexLock lock(&mutex_);
+    reports_[std::string(pc_label)] = report;
+  }
+
+  size_t size() {
+    MutexLock lock(&mutex_);
+    return reports_.size();
+  }
+
+  rtc::scoped_refptr<const RTCStatsReport> GetReport(const std::string& name) {
+    MutexLock lock(&mutex_);
+    auto it = reports_.find(name);
+    return it == reports_.end() ? nullptr : it->second;
+  }
+
+ private:
+  Mutex mutex_;
+  std::map<std::string, rtc::scoped_refptr<const RTCStatsReport>> reports_
+      RTC_GUARDED_BY(mutex_);
+};
+
+void FillFromReport(const RTCStatsReport& report,
+                    PeerConnectionLoadGenerator::PeerResult& result) {
+  for (const RTCIceCandidatePairStats* pair :
+       report.GetStatsOfType<RTCIceCandidatePairStats>()) {
+    if (pair->nominated.ValueOrDefault(false) &&
+        pair->current_round_trip_time.is_defined()) {
+      result.round_trip_time =
+          TimeDelta::Seconds(1) * *pair->current_round_trip_time;
+    }
+  }
+  for (const RTCInboundRTPStreamStats* stream :
+       report.GetStatsOfType<RTCInboundRTPStreamStats>()) {
+    if (stream->kind.ValueOrDefault("") != "video")
+      continue;
+    result.frames_decoded = stream->frames_decoded.ValueOrDefault(0);
+    uint64_t emitted = stream->jitter_buffer_emitted_count.ValueOrDefault(0);
+    if (emitted > 0) {
+      result.jitter_buffer_delay =
+          TimeDelta::Seconds(1) *
+          stream->jitter_buffer_delay.ValueOrDefault(0.0) / emitted;
+    }
+  }
+}
+
+std::vector<std::unique_ptr<IceCandidateInterface>> CopyCandidates(
+    const std::vector<const IceCandidateInterface*>& candidates) {
+  std::vector<std::unique_ptr<IceCandidateInterface>> out;
+  for (const IceCandidateInterface* candidate : candidates) {
+    out.push_back(CreateIceCandidate(candidate->sdp_mid(),
+                                     candidate->sdp_mline_index(),
+                                     candidate->candidate()));
+  }
+  return out;
+}
+
+}  // namespace
+
+PeerConnectionLoadGenerator::PeerConnectionLoadGenerator(
+    TimeController& time_controller)
+    : time_controller_(time_controller),
+      signaling_thread_(time_controller.CreateThread("signaling_thread")),
+      worker_thread_(time_controller.CreateThread("worker_thread")),
+      peer_factory_(signaling_thread_.get(),
+                    worker_thread_.get(),
+                    time_controller,
+                    /*video_analyzer_helper=*/nullptr,
+                    /*task_queue=*/nullptr) {}
+
+PeerConnectionLoadGenerator::~PeerConnectionLoadGenerator() {
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    for (auto& source : video_sources_) {
+      source->Stop();
+    }
+    video_sources_.clear();
+    calls_.clear();
+  });
+}
+
+void PeerConnectionLoadGenerator::AddCall(
+    EmulatedNetworkManagerInterface* caller_network,
+    EmulatedNetworkManagerInterface* callee_network) {
+  RTC_CHECK(!run_) << "Calls can't be added after Run()";
+  std::string prefix = "call" + std::to_string(calls_.size());
+  Call call;
+  call.caller = CreatePeer(prefix + "_caller", caller_network);
+  call.callee = CreatePeer(prefix + "_callee", callee_network);
+  calls_.push_back(std::move(call));
+}
+
+std::unique_ptr<TestPeer> PeerConnectionLoadGenerator::CreatePeer(
+    const std::string& name,
+    EmulatedNetworkManagerInterface* network) {
+  auto configurer = std::make_unique<PeerConfigurerImpl>(
+      network->network_thread(), network->network_manager(),
+      network->packet_socket_factory());
+  configurer->SetName(name);
+  configurer->SetVideoEncoderFactory(
+      std::make_unique<FakeVp8EncoderFactory>(time_controller_.GetClock()));
+  configurer->SetVideoDecoderFactory(std::make_unique<FakeVp8DecoderFactory>());
+  return peer_factory_.CreateTestPeer(
+      std::move(configurer),
+      std::make_unique<MockPeerConnectionObserver>(),
+      /*remote_audio_config=*/absl::nullopt,
+      /*echo_emulation_config=*/absl::nullopt);
+}
+
+void PeerConnectionLoadGenerator::AddVideo(TestPeer* peer) {
+  rtc::scoped_refptr<TestVideoCapturerVideoTrackSource> source =
+      rtc::make_ref_counted<TestVideoCapturerVideoTrackSource>(
+          test::FrameGeneratorCapturer::Create(
+              time_controller_.GetClock(),
+              *time_controller_.GetTaskQueueFactory(),
+              test::FrameGeneratorCapturerConfig::SquaresVideo()),
+          /*is_screencast=*/false);
+  rtc::scoped_refptr<VideoTrackInterface> track =
+      peer->pc_factory()->CreateVideoTrack(kStreamLabel, source.get());
+  RTC_CHECK(peer->AddTrack(track, {kStreamLabel}));
+  video_sources_.push_back(source);
+}
+
+void PeerConnectionLoadGenerator::ConnectCall(Call& call) {
+  AddVideo(call.caller.get());
+  std::unique_ptr<SessionDescriptionInterface> offer =
+      call.caller->CreateOffer();
+  RTC_CHECK(offer);
+  std::unique_ptr<SessionDescriptionInterface> remote_offer = offer->Clone();
+  RTC_CHECK(call.caller->SetLocalDescription(std::move(offer)));
+  RTC_CHECK(call.callee->SetRemoteDescription(std::move(remote_offer)));
+  // Adding the track after the offer reuses the transceiver created for it,
+  // so the answer is sendrecv.
+  AddVideo(call.callee.get());
+  std::unique_ptr<SessionDescriptionInterface> answer =
+      call.callee->CreateAnswer();
+  RTC_CHECK(answer);
+  std::unique_ptr<SessionDescriptionInterface> remote_answer = answer->Clone();
+  RTC_CHECK(call.callee->SetLocalDescription(std::move(answer)));
+  RTC_CHECK(call.caller->SetRemoteDescription(std::move(remote_answer)));
+}
+
+PeerConnectionLoadGenerator::Results PeerConnectionLoadGenerator::Run(
+    TimeDelta duration) {
+  RTC_CHECK(!run_) << "Run() can be called only once";
+  run_ = true;
+
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    for (Call& call : calls_) {
+      ConnectCall(call);
+    }
+  });
+  RTC_CHECK(time_controller_.Wait(
+      [&]() {
+        return signaling_thread_->Invoke<bool>(RTC_FROM_HERE, [&]() {
+          for (const Call& call : calls_) {
+            if (!call.caller->IsIceGatheringDone() ||
+                !call.callee->IsIceGatheringDone()) {
+              return false;
+            }
+          }
+          return true;
+        });
+      },
+      2 * kDefaultTimeout));
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    for (Call& call : calls_) {
+      RTC_CHECK(call.callee->AddIceCandidates(
+          CopyCandidates(call.caller->observer()->GetAllCandidates())));
+      RTC_CHECK(call.caller->AddIceCandidates(
+          CopyCandidates(call.callee->observer()->GetAllCandidates())));
+    }
+  });
+
+  Results results;
+  std::map<std::string, TestPeer*> peers;
+  for (Call& call : calls_) {
+    for (TestPeer* peer : {call.caller.get(), call.callee.get()}) {
+      PeerResult result;
+      result.name = *peer->params()->name;
+      peers[result.name] = peer;
+      results.peers.push_back(result);
+    }
+  }
+  time_controller_.Wait(
+      [&]() {
+        return signaling_thread_->Invoke<bool>(RTC_FROM_HERE, [&]() {
+          for (auto& name_and_peer : peers) {
+            if (!name_and_peer.second->IsIceConnected())
+              return false;
+          }
+          return true;
+        });
+      },
+      kDefaultTimeout);
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (PeerResult& result : results.peers) {
+      result.connected = peers[result.name]->IsIceConnected();
+    }
+  });
+
+  const int64_t cpu_time_start_ns = rtc::GetProcessCpuTimeNanos();
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    for (auto& source : video_sources_) {
+      source->Start();
+    }
+  });
+  time_controller_.AdvanceTime(duration);
+  const int64_t cpu_time_ns = rtc::GetProcessCpuTimeNanos() - cpu_time_start_ns;
+  if (!results.peers.empty()) {
+    results.cpu_time_per_peer =
+        TimeDelta::Micros(cpu_time_ns / 1000) / results.peers.size();
+  }
+
+  StatsCollector collector;
+  StatsPoller stats_poller({&collector}, peers);
+  stats_poller.PollStatsAndNotifyObservers();
+  time_controller_.Wait([&]() { return collector.size() == peers.size(); },
+                        kDefaultTimeout);
+  for (PeerResult& result : results.peers) {
+    rtc::scoped_refptr<const RTCStatsReport> report =
+        collector.GetReport(result.name);
+    if (report) {
+      FillFromReport(*report, result);
+    }
+  }
+
+  signaling_thread_->Invoke<void>(RTC_FROM_HERE, [this] {
+    for (auto& source : video_sources_) {
+      source->Stop();
+    }
+    video_sources_.clear();
+    for (Call& call : calls_) {
+      call.caller->Close();
+      call.callee->Close();
+    }
+  });
+  return results;
+}
+
+void PeerConnectionLoadGenerator::ReportResults(
+    const std::string& test_case_name,
+    const Results& results) {
+  int connected = 0;
+  for (const PeerResult& peer : results.peers) {
+    if (peer.connected) {
+      ++connected;
+    }
+    if (peer.round_trip_time) {
+      test::PrintResult(peer.name + "_rtt", "", test_case_name,
+                        peer.round_trip_time->ms<double>(), "ms",
+                        /*important=*/false,
+                        test::ImproveDirection::kSmallerIsBetter);
+    }
+    if (peer.jitter_buffer_delay) {
+      test::PrintResult(peer.name + "_jitter_buffer_delay", "",
+                        test_case_name, peer.jitter_buffer_delay->ms<double>(),
+                        "ms", /*important=*/false,
+                        test::ImproveDirection::kSmallerIsBetter);
+    }
+    test::PrintResult(peer.name + "_frames_decoded", "", test_case_name,
+                      peer.frames_decoded, "count", /*important=*/false,
+                      test::ImproveDirection::kBiggerIsBetter);
+  }
+  test::PrintResult("connected_peers", "", test_case_name, connected,
+                    "unitless", /*important=*/false,
+                    test::ImproveDirection::kBiggerIsBetter);
+  test::PrintResult("cpu_time_per_peer", "", test_case_name,
+                    results.cpu_time_per_peer.ms<double>(), "ms",
+                    /*important=*/true,
+                    test::ImproveDirection::kSmallerIsBetter);
+}
+
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
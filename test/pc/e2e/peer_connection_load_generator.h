@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_PC_E2E_PEER_CONNECTION_LOAD_GENERATOR_H_
+#define TEST_PC_E2E_PEER_CONNECTION_LOAD_GENERATOR_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/test/time_controller.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/thread.h"
+#include "test/pc/e2e/media/test_video_capturer_video_track_source.h"
+#include "test/pc/e2e/test_peer.h"
+#include "test/pc/e2e/test_peer_factory.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+
+// Runs many synthetic calls at once to measure how the PeerConnection stack
+// scales with the number of PeerConnections in one process, e.g. to load an
+// SFU or to profile the client side of a large conference.
+//
+// Unlike PeerConnectionE2EQualityTest, all peers share one signaling and one
+// worker thread, send a single low resolution video stream encoded with
+// FakeVp8Encoder and decoded with FakeDecoder, and no audio or video quality
+// analyzers are attached. Only the stats that are cheap to collect are
+// reported: ICE connectivity, round trip time and jitter buffer delay per
+// peer, and the process CPU time per peer for the whole run.
+class PeerConnectionLoadGenerator {
+ public:
+  struct PeerResult {
+    std::string name;
+    bool connected = false;
+    // Current round trip time of the nominated ICE candidate pair, if any.
+    absl::optional<TimeDelta> round_trip_time;
+    // Average jitter buffer delay of the received video frames, if any.
+    absl::optional<TimeDelta> jitter_buffer_delay;
+    uint32_t frames_decoded = 0;
+  };
+
+  struct Results {
+    std::vector<PeerResult> peers;
+    // Process CPU time spent while media was flowing, divided by the number
+    // of peers.
+    TimeDelta cpu_time_per_peer = TimeDelta::Zero();
+  };
+
+  explicit PeerConnectionLoadGenerator(TimeController& time_controller);
+  ~PeerConnectionLoadGenerator();
+
+  // Adds a call between two new peers. The caller sends video to the callee
+  // and the callee sends video back. `caller_network` and `callee_network`
+  // may be shared between calls.
+  void AddCall(EmulatedNetworkManagerInterface* caller_network,
+               EmulatedNetworkManagerInterface* callee_network);
+
+  // Connects all calls, lets media flow for `duration` and closes the calls.
+  // Can be called only once.
+  Results Run(TimeDelta duration);
+
+  // Prints `results` as perf results of `test_case_name`.
+  static void ReportResults(const std::string& test_case_name,
+                            const Results& results);
+
+ private:
+  struct Call {
+    std::unique_ptr<TestPeer> caller;
+    std::unique_ptr<TestPeer> callee;
+  };
+
+  std::unique_ptr<TestPeer> CreatePeer(
+      const std::string& name,
+      EmulatedNetworkManagerInterface* network);
+  // Adds a video track fed by a square frame generator to `peer`.
+  void AddVideo(TestPeer* peer);
+  // Negotiates a sendrecv video call between the peers of `call`.
+  void ConnectCall(Call& call);
+
+  TimeController& time_controller_;
+  std::unique_ptr<rtc::Thread> signaling_thread_;
+  std::unique_ptr<rtc::Thread> worker_thread_;
+  TestPeerFactory peer_factory_;
+  std::vector<Call> calls_;
+  std::vector<rtc::scoped_refptr<TestVideoCapturerVideoTrackSource>>
+      video_sources_;
+  bool run_ = false;
+};
+
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
+
+#endif  // TEST_PC_E2E_PEER_CONNECTION_LOAD_GENERATOR_H_
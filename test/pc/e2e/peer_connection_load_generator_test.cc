@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/pc/e2e/peer_connection_load_generator.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/test/create_network_emulation_manager.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/units/time_delta.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+namespace {
+
+constexpr int kNumCalls = 4;
+
+TEST(PeerConnectionLoadGeneratorTest, AllCallsReceiveVideo) {
+  std::unique_ptr<NetworkEmulationManager> emulation =
+      CreateNetworkEmulationManager(TimeMode::kSimulated);
+  PeerConnectionLoadGenerator generator(*emulation->time_controller());
+  for (int i = 0; i < kNumCalls; ++i) {
+    EmulatedEndpoint* caller =
+        emulation->CreateEndpoint(EmulatedEndpointConfig());
+    EmulatedEndpoint* callee =
+        emulation->CreateEndpoint(EmulatedEndpointConfig());
+    EmulatedNetworkNode* caller_node =
+        emulation->CreateEmulatedNode(BuiltInNetworkBehaviorConfig());
+    EmulatedNetworkNode* callee_node =
+        emulation->CreateEmulatedNode(BuiltInNetworkBehaviorConfig());
+    emulation->CreateRoute(caller, {caller_node}, callee);
+    emulation->CreateRoute(callee, {callee_node}, caller);
+    generator.AddCall(
+        emulation->CreateEmulatedNetworkManagerInterface({caller}),
+        emulation->CreateEmulatedNetworkManagerInterface({callee}));
+  }
+
+  PeerConnectionLoadGenerator::Results results =
+      generator.Run(TimeDelta::Seconds(2));
+
+  ASSERT_EQ(results.peers.size(), 2u * kNumCalls);
+  for (const PeerConnectionLoadGenerator::PeerResult& peer : results.peers) {
+    EXPECT_TRUE(peer.connected) << peer.name;
+    EXPECT_GT(peer.frames_decoded, 0u) << peer.name;
+    EXPECT_TRUE(peer.round_trip_time.has_value()) << peer.name;
+  }
+}
+
+}  // namespace
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
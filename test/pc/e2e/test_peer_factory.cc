@@ -325,22 +325,28 @@ std::unique_ptr<TestPeer> TestPeerFactory::CreateTestPeer(
       CreateAudioDeviceModule(
           params->audio_config, remote_audio_config, echo_emulation_config,
           components->pcf_dependencies->task_queue_factory.get());
-  WrapVideoEncoderFactory(
-      params->name.value(), params->video_encoder_bitrate_multiplier,
-      CalculateRequiredSpatialIndexPerStream(params->video_configs),
-      components->pcf_dependencies.get(), video_analyzer_helper_);
-  WrapVideoDecoderFactory(params->name.value(),
-                          components->pcf_dependencies.get(),
-                          video_analyzer_helper_);
+  if (video_analyzer_helper_ != nullptr) {
+    WrapVideoEncoderFactory(
+        params->name.value(), params->video_encoder_bitrate_multiplier,
+        CalculateRequiredSpatialIndexPerStream(params->video_configs),
+        components->pcf_dependencies.get(), video_analyzer_helper_);
+    WrapVideoDecoderFactory(params->name.value(),
+                            components->pcf_dependencies.get(),
+                            video_analyzer_helper_);
+  }
   std::unique_ptr<cricket::MediaEngineInterface> media_engine =
       CreateMediaEngine(components->pcf_dependencies.get(), audio_device_module,
                         audio_processing);
 
-  std::unique_ptr<rtc::Thread> worker_thread =
-      time_controller_.CreateThread("worker_thread");
+  std::unique_ptr<rtc::Thread> worker_thread;
+  if (worker_thread_ == nullptr) {
+    worker_thread = time_controller_.CreateThread("worker_thread");
+  }
   PeerConnectionFactoryDependencies pcf_deps = CreatePCFDependencies(
       std::move(components->pcf_dependencies), std::move(media_engine),
-      signaling_thread_, worker_thread.get(), components->network_thread);
+      signaling_thread_,
+      worker_thread_ != nullptr ? worker_thread_ : worker_thread.get(),
+      components->network_thread);
   rtc::scoped_refptr<PeerConnectionFactoryInterface> peer_connection_factory =
       CreateModularPeerConnectionFactory(std::move(pcf_deps));
 
@@ -51,13 +51,28 @@ class TestPeerFactory {
   // `time_controller` will be used to create required threads, task queue
   // factories and call factory.
   // `video_analyzer_helper` will be used to setup video quality analysis for
-  // created peers.
+  // created peers. If it is null, video codec factories of the peers aren't
+  // wrapped and no video quality analysis is done.
   // `task_queue` will be used for AEC dump if it is requested.
   TestPeerFactory(rtc::Thread* signaling_thread,
                   TimeController& time_controller,
                   VideoQualityAnalyzerInjectionHelper* video_analyzer_helper,
                   rtc::TaskQueue* task_queue)
+      : TestPeerFactory(signaling_thread,
+                        /*worker_thread=*/nullptr,
+                        time_controller,
+                        video_analyzer_helper,
+                        task_queue) {}
+  // Same as above, but if `worker_thread` isn't null, it will be used as a
+  // worker thread for all peers created by this factory instead of creating
+  // a worker thread per peer. It has to outlive the created peers.
+  TestPeerFactory(rtc::Thread* signaling_thread,
+                  rtc::Thread* worker_thread,
+                  TimeController& time_controller,
+                  VideoQualityAnalyzerInjectionHelper* video_analyzer_helper,
+                  rtc::TaskQueue* task_queue)
       : signaling_thread_(signaling_thread),
+        worker_thread_(worker_thread),
         time_controller_(time_controller),
         video_analyzer_helper_(video_analyzer_helper),
         task_queue_(task_queue) {}
@@ -75,6 +90,7 @@ class TestPeerFactory {
 
  private:
   rtc::Thread* signaling_thread_;
+  rtc::Thread* worker_thread_;
   TimeController& time_controller_;
   VideoQualityAnalyzerInjectionHelper* video_analyzer_helper_;
   rtc::TaskQueue* task_queue_;
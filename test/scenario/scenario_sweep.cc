@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_sweep.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <set>
+
+#if defined(WEBRTC_POSIX)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/field_trial.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+ScenarioSweep::Metrics RunCase(const ScenarioSweep::CaseFunction& function,
+                               const ScenarioSweepCase& sweep_case) {
+  const char* base_trials = field_trial::GetFieldTrialString();
+  ScopedFieldTrials field_trials(field_trial::MergeFieldTrialsStrings(
+      base_trials ? base_trials : "", sweep_case.field_trials.c_str()));
+  Scenario s(sweep_case.name);
+  return function(s, sweep_case);
+}
+
+#if defined(WEBRTC_POSIX)
+std::string SerializeMetrics(const ScenarioSweep::Metrics& metrics) {
+  rtc::StringBuilder sb;
+  for (const auto& metric : metrics) {
+    RTC_DCHECK(metric.first.find_first_of("=\n") == std::string::npos);
+    char value[32];
+    snprintf(value, sizeof(value), "%.17g", metric.second);
+    sb << metric.first << "=" << value << "\n";
+  }
+  return sb.Release();
+}
+
+ScenarioSweep::Metrics ParseMetrics(const std::string& serialized) {
+  ScenarioSweep::Metrics metrics;
+  size_t line_start = 0;
+  while (line_start < serialized.size()) {
+    size_t line_end = serialized.find('\n', line_start);
+    if (line_end == std::string::npos)
+      line_end = serialized.size();
+    const std::string line =
+        serialized.substr(line_start, line_end - line_start);
+    const size_t separator = line.rfind('=');
+    if (separator != std::string::npos) {
+      metrics[line.substr(0, separator)] =
+          strtod(line.c_str() + separator + 1, nullptr);
+    }
+    line_start = line_end + 1;
+  }
+  return metrics;
+}
+
+std::string ReadAll(int fd) {
+  std::string data;
+  char buffer[4096];
+  ssize_t read_size;
+  while ((read_size = read(fd, buffer, sizeof(buffer))) != 0) {
+    if (read_size < 0)
+      break;
+    data.append(buffer, read_size);
+  }
+  return data;
+}
+
+// Runs the case in a child process that writes its metrics to `write_fd`.
+// Never returns in the child.
+pid_t ForkCase(const ScenarioSweep::CaseFunction& function,
+               const ScenarioSweepCase& sweep_case,
+               int read_fd,
+               int write_fd) {
+  pid_t pid = fork();
+  if (pid != 0)
+    return pid;
+  close(read_fd);
+  const std::string serialized =
+      SerializeMetrics(RunCase(function, sweep_case));
+  size_t written = 0;
+  while (written < serialized.size()) {
+    ssize_t result = write(write_fd, serialized.data() + written,
+                           serialized.size() - written);
+    if (result <= 0)
+      _exit(1);
+    written += result;
+  }
+  close(write_fd);
+  // Skips static destructors and atexit handlers that belong to the parent.
+  _exit(0);
+}
+#endif  // defined(WEBRTC_POSIX)
+
+}  // namespace
+
+ScenarioSweep::ScenarioSweep(
+    std::vector<std::string> field_trials,
+    std::vector<std::pair<std::string, NetworkSimulationConfig>> networks) {
+  for (size_t trial_index = 0; trial_index < field_trials.size();
+       ++trial_index) {
+    for (const auto& network : networks) {
+      ScenarioSweepCase sweep_case;
+      sweep_case.field_trials = field_trials[trial_index];
+      sweep_case.network_name = network.first;
+      sweep_case.network = network.second;
+      sweep_case.name = "sweep/trials" + std::to_string(trial_index) + "_" +
+                        network.first;
+      cases_.push_back(std::move(sweep_case));
+    }
+  }
+}
+
+ScenarioSweep::~ScenarioSweep() = default;
+
+std::vector<ScenarioSweepResult> ScenarioSweep::Run(CaseFunction case_function,
+                                                    int max_parallel) const {
+  RTC_DCHECK_GT(max_parallel, 0);
+  std::vector<ScenarioSweepResult> results(cases_.size());
+  for (size_t i = 0; i < cases_.size(); ++i)
+    results[i].sweep_case = cases_[i];
+
+#if defined(WEBRTC_POSIX)
+  struct Child {
+    size_t case_index;
+    int read_fd;
+  };
+  std::map<pid_t, Child> running;
+  size_t next_case = 0;
+  while (next_case < cases_.size() || !running.empty()) {
+    if (next_case < cases_.size() &&
+        static_cast<int>(running.size()) < max_parallel) {
+      int fds[2];
+      RTC_CHECK_EQ(pipe(fds), 0);
+      pid_t pid = ForkCase(case_function, cases_[next_case], fds[0], fds[1]);
+      RTC_CHECK_GT(pid, 0) << "fork() failed";
+      close(fds[1]);
+      running[pid] = {next_case, fds[0]};
+      ++next_case;
+      continue;
+    }
+    // The metrics of a case are much smaller than the pipe buffer, so a child
+    // never blocks on writing them before it exits.
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    auto it = running.find(pid);
+    if (it == running.end())
+      continue;
+    ScenarioSweepResult& result = results[it->second.case_index];
+    const std::string serialized = ReadAll(it->second.read_fd);
+    close(it->second.read_fd);
+    running.erase(it);
+    result.completed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (result.completed) {
+      result.metrics = ParseMetrics(serialized);
+    } else {
+      RTC_LOG(LS_WARNING) << "Sweep case " << result.sweep_case.name
+                          << " did not complete.";
+    }
+  }
+#else
+  for (ScenarioSweepResult& result : results) {
+    result.metrics = RunCase(case_function, result.sweep_case);
+    result.completed = true;
+  }
+#endif
+  return results;
+}
+
+std::string ScenarioSweep::ResultsTable(
+    const std::vector<ScenarioSweepResult>& results) {
+  std::set<std::string> metric_names;
+  for (const ScenarioSweepResult& result : results) {
+    for (const auto& metric : result.metrics)
+      metric_names.insert(metric.first);
+  }
+  rtc::StringBuilder sb;
+  sb << "network field_trials";
+  for (const std::string& name : metric_names)
+    sb << " " << name;
+  sb << "\n";
+  for (const ScenarioSweepResult& result : results) {
+    const std::string& trials = result.sweep_case.field_trials;
+    sb << result.sweep_case.network_name << " "
+       << (trials.empty() ? "-" : trials);
+    for (const std::string& name : metric_names) {
+      auto it = result.metrics.find(name);
+      if (it == result.metrics.end()) {
+        sb << " NaN";
+      } else {
+        char value[32];
+        snprintf(value, sizeof(value), "%g", it->second);
+        sb << " " << value;
+      }
+    }
+    sb << "\n";
+  }
+  return sb.Release();
+}
+
+}  // namespace test
+}  // namespace webrtc
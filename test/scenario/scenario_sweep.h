@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_SCENARIO_SCENARIO_SWEEP_H_
+#define TEST_SCENARIO_SCENARIO_SWEEP_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test/scenario/scenario.h"
+#include "test/scenario/scenario_config.h"
+
+namespace webrtc {
+namespace test {
+
+struct ScenarioSweepCase {
+  // Field trial string applied while the case runs, e.g. GoogCC settings like
+  // "WebRTC-Bwe-LossBasedControl/Enabled/".
+  std::string field_trials;
+  std::string network_name;
+  NetworkSimulationConfig network;
+  // Unique name of the case, used as the scenario log name.
+  std::string name;
+};
+
+struct ScenarioSweepResult {
+  ScenarioSweepCase sweep_case;
+  // False if the case crashed or exited without reporting.
+  bool completed = false;
+  std::map<std::string, double> metrics;
+};
+
+// ScenarioSweep runs the same scenario setup for every combination of field
+// trial strings and network configurations, and collects the metrics reported
+// for each combination into one table.
+//
+// Field trials and the clock override installed by the simulated time
+// controller are process global, so scenarios can't run concurrently on
+// threads of the same process. Instead, each case runs in a forked child
+// process with its own Scenario, and up to `max_parallel` children run at the
+// same time. On platforms without fork() the cases run one after another in
+// the calling process.
+class ScenarioSweep {
+ public:
+  using Metrics = std::map<std::string, double>;
+  // Sets up the scenario for `sweep_case`, runs it and returns the metrics to
+  // report. The field trials of the case are already applied. Metric names
+  // must not contain '=' or newlines.
+  using CaseFunction =
+      std::function<Metrics(Scenario& s, const ScenarioSweepCase& sweep_case)>;
+
+  ScenarioSweep(
+      std::vector<std::string> field_trials,
+      std::vector<std::pair<std::string, NetworkSimulationConfig>> networks);
+  ~ScenarioSweep();
+
+  const std::vector<ScenarioSweepCase>& cases() const { return cases_; }
+
+  // Runs all cases and returns their results in the order of cases().
+  std::vector<ScenarioSweepResult> Run(CaseFunction case_function,
+                                       int max_parallel) const;
+
+  // Formats `results` as a space separated table with one row per case and
+  // one column per metric name seen in any of the results.
+  static std::string ResultsTable(
+      const std::vector<ScenarioSweepResult>& results);
+
+ private:
+  std::vector<ScenarioSweepCase> cases_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_SCENARIO_SCENARIO_SWEEP_H_
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/scenario/scenario_sweep.h"
+
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+ScenarioSweep::Metrics RunVideoCall(Scenario& s,
+                                    const ScenarioSweepCase& sweep_case) {
+  CallClientConfig call_config;
+  auto* alice = s.CreateClient("alice", call_config);
+  auto* bob = s.CreateClient("bob", call_config);
+  auto* send_net = s.CreateSimulationNode(sweep_case.network);
+  auto* ret_net = s.CreateSimulationNode(NetworkSimulationConfig());
+  auto* route = s.CreateRoutes(alice, {send_net}, bob, {ret_net});
+  s.CreateVideoStream(route->forward(), VideoStreamConfig());
+  s.RunFor(TimeDelta::Seconds(10));
+  return {{"target_kbps", alice->target_rate().kbps<double>()},
+          {"trial_enabled",
+           field_trial::IsEnabled("WebRTC-Bwe-SweepTest") ? 1.0 : 0.0}};
+}
+}  // namespace
+
+TEST(ScenarioSweepTest, RunsEveryCombinationOfTrialsAndNetworks) {
+  NetworkSimulationConfig slow;
+  slow.bandwidth = DataRate::KilobitsPerSec(250);
+  NetworkSimulationConfig fast;
+  fast.bandwidth = DataRate::KilobitsPerSec(2000);
+  ScenarioSweep sweep({"", "WebRTC-Bwe-SweepTest/Enabled/"},
+                      {{"slow", slow}, {"fast", fast}});
+  ASSERT_EQ(sweep.cases().size(), 4u);
+
+  std::vector<ScenarioSweepResult> results =
+      sweep.Run(&RunVideoCall, /*max_parallel=*/2);
+  ASSERT_EQ(results.size(), 4u);
+  for (const ScenarioSweepResult& result : results) {
+    ASSERT_TRUE(result.completed) << result.sweep_case.name;
+    EXPECT_EQ(result.metrics.at("trial_enabled"),
+              result.sweep_case.field_trials.empty() ? 0.0 : 1.0);
+    if (result.sweep_case.network_name == "slow") {
+      EXPECT_LT(result.metrics.at("target_kbps"), 300);
+    } else {
+      EXPECT_GT(result.metrics.at("target_kbps"), 500);
+    }
+  }
+  // The trials of a case don't leak into the calling process.
+  EXPECT_FALSE(field_trial::IsEnabled("WebRTC-Bwe-SweepTest"));
+
+  const std::string table = ScenarioSweep::ResultsTable(results);
+  EXPECT_EQ(table.find("network field_trials target_kbps trial_enabled\n"), 0u);
+  EXPECT_NE(table.find("slow WebRTC-Bwe-SweepTest/Enabled/ "),
+            std::string::npos);
+}
+
+}  // namespace test
+}  // namespace webrtc
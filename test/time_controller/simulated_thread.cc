@@ -79,9 +79,14 @@ void SimulatedThread::Send(const rtc::Location& posted_from,
   } else {
     TaskQueueBase* yielding_from = TaskQueueBase::Current();
     handler_->StartYield(yielding_from);
+    bool acquired = handler_->AcquireRunner(this);
     RunReady(Timestamp::MinusInfinity());
-    CurrentThreadSetter set_current(this);
-    msg.phandler->OnMessage(&msg);
+    {
+      CurrentThreadSetter set_current(this);
+      msg.phandler->OnMessage(&msg);
+    }
+    if (acquired)
+      handler_->ReleaseRunner(this);
     handler_->StopYield(yielding_from);
   }
 }
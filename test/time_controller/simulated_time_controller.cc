@@ -38,9 +38,31 @@ bool RemoveByValue(C* vec, typename C::value_type val) {
 namespace sim_time_impl {
 
 SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time)
-    : thread_id_(rtc::CurrentThreadId()), current_time_(start_time) {}
+    : SimulatedTimeControllerImpl(start_time, /*worker_threads=*/0) {}
 
-SimulatedTimeControllerImpl::~SimulatedTimeControllerImpl() = default;
+SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time,
+                                                         int worker_threads)
+    : thread_id_(rtc::CurrentThreadId()), current_time_(start_time) {
+  RTC_DCHECK_GE(worker_threads, 0);
+  for (int i = 0; i < worker_threads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    Worker* worker_ptr = worker.get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker_ptr] { RunWorker(worker_ptr); }, "SimTimeWorker");
+    workers_.push_back(std::move(worker));
+  }
+}
+
+SimulatedTimeControllerImpl::~SimulatedTimeControllerImpl() {
+  {
+    MutexLock lock(&lock_);
+    stopping_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread.Finalize();
+  }
+}
 
 std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
 SimulatedTimeControllerImpl::CreateTaskQueue(
@@ -73,6 +95,20 @@ std::unique_ptr<rtc::Thread> SimulatedTimeControllerImpl::CreateThread(
 }
 
 void SimulatedTimeControllerImpl::YieldExecution() {
+  if (!workers_.empty()) {
+    if (rtc::CurrentThreadId() == thread_id_ && !in_parallel_run_) {
+      RunReadyRunners();
+      return;
+    }
+    // The yielding runner is marked as running, so it's not run again while
+    // it waits. Helps with running the other ready runners, as one of them
+    // might be what it's waiting for.
+    TokenTaskQueue::CurrentTaskQueueSetter reset_queue(nullptr);
+    Timestamp current_time = CurrentTime();
+    while (RunNextReadyRunner(current_time)) {
+    }
+    return;
+  }
   if (rtc::CurrentThreadId() == thread_id_) {
     TaskQueueBase* yielding_from = TaskQueueBase::Current();
     // Since we might continue execution on a process thread, we should reset
@@ -84,14 +120,17 @@ void SimulatedTimeControllerImpl::YieldExecution() {
     // currently executing task queue. If there's a ready task that also yields,
     // it's added to this set as well and only tasks on the remaining task
     // queues are executed.
-    auto inserted = yielded_.insert(yielding_from);
-    RTC_DCHECK(inserted.second);
+    StartYield(yielding_from);
     RunReadyRunners();
-    yielded_.erase(inserted.first);
+    StopYield(yielding_from);
   }
 }
 
 void SimulatedTimeControllerImpl::RunReadyRunners() {
+  if (!workers_.empty()) {
+    RunReadyRunnersInParallel();
+    return;
+  }
   // Using a dummy thread rather than nullptr to avoid implicit thread creation
   // by Thread::Current().
   SimulatedThread::CurrentThreadSetter set_current(dummy_thread_.get());
@@ -106,10 +145,8 @@ void SimulatedTimeControllerImpl::RunReadyRunners() {
   // runners.
   while (true) {
     for (auto* runner : runners_) {
-      if (yielded_.find(runner->GetAsTaskQueue()) == yielded_.end() &&
-          runner->GetNextRunTime() <= current_time) {
+      if (IsReady(runner, current_time))
         ready_runners_.push_back(runner);
-      }
     }
     if (ready_runners_.empty())
       break;
@@ -126,6 +163,110 @@ void SimulatedTimeControllerImpl::RunReadyRunners() {
   }
 }
 
+bool SimulatedTimeControllerImpl::IsReady(SimulatedSequenceRunner* runner,
+                                          Timestamp at_time) const {
+  return yielded_.find(runner->GetAsTaskQueue()) == yielded_.end() &&
+         running_.find(runner) == running_.end() &&
+         runner->GetNextRunTime() <= at_time;
+}
+
+bool SimulatedTimeControllerImpl::RunNextReadyRunner(Timestamp at_time) {
+  SimulatedSequenceRunner* runner = nullptr;
+  {
+    MutexLock lock(&lock_);
+    for (auto* candidate : runners_) {
+      if (IsReady(candidate, at_time)) {
+        runner = candidate;
+        break;
+      }
+    }
+    if (!runner)
+      return false;
+    running_[runner] = rtc::CurrentThreadId();
+  }
+  {
+    SimulatedThread::CurrentThreadSetter set_current(dummy_thread_.get());
+    rtc::ScopedYieldPolicy yield_policy(this);
+    runner->RunReady(at_time);
+  }
+  MutexLock lock(&lock_);
+  running_.erase(runner);
+  return true;
+}
+
+void SimulatedTimeControllerImpl::RunReadyRunnersInParallel() {
+  RTC_DCHECK_EQ(rtc::CurrentThreadId(), thread_id_);
+  Timestamp current_time = CurrentTime();
+  bool was_in_parallel_run = in_parallel_run_;
+  in_parallel_run_ = true;
+  // Every thread keeps running ready runners until it finds none that isn't
+  // already running. A runner that gets new tasks after its thread checked for
+  // them is caught by the next round, so time isn't advanced before all tasks
+  // at `current_time` have run.
+  while (true) {
+    {
+      MutexLock lock(&lock_);
+      bool any_ready = false;
+      for (auto* runner : runners_)
+        any_ready = any_ready || IsReady(runner, current_time);
+      if (!any_ready)
+        break;
+      busy_workers_ = static_cast<int>(workers_.size());
+    }
+    for (auto& worker : workers_)
+      worker->wake_up.Set();
+    while (RunNextReadyRunner(current_time)) {
+    }
+    // Waiting must not yield, as that would run more runners on this thread.
+    rtc::ScopedYieldPolicy no_yield(nullptr);
+    workers_done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  }
+  in_parallel_run_ = was_in_parallel_run;
+}
+
+void SimulatedTimeControllerImpl::RunWorker(Worker* worker) {
+  while (true) {
+    worker->wake_up.Wait(rtc::Event::kForever, rtc::Event::kForever);
+    {
+      MutexLock lock(&lock_);
+      if (stopping_)
+        return;
+    }
+    Timestamp current_time = CurrentTime();
+    while (RunNextReadyRunner(current_time)) {
+    }
+    MutexLock lock(&lock_);
+    if (--busy_workers_ == 0)
+      workers_done_.Set();
+  }
+}
+
+bool SimulatedTimeControllerImpl::AcquireRunner(
+    SimulatedSequenceRunner* runner) {
+  if (workers_.empty())
+    return false;
+  const rtc::PlatformThreadId thread_id = rtc::CurrentThreadId();
+  MutexLock lock(&lock_);
+  while (true) {
+    auto it = running_.find(runner);
+    if (it == running_.end())
+      break;
+    if (it->second == thread_id)
+      return false;
+    lock_.Unlock();
+    std::this_thread::yield();
+    lock_.Lock();
+  }
+  running_[runner] = thread_id;
+  return true;
+}
+
+void SimulatedTimeControllerImpl::ReleaseRunner(
+    SimulatedSequenceRunner* runner) {
+  MutexLock lock(&lock_);
+  running_.erase(runner);
+}
+
 Timestamp SimulatedTimeControllerImpl::CurrentTime() const {
   MutexLock lock(&time_lock_);
   return current_time_;
@@ -157,17 +298,29 @@ void SimulatedTimeControllerImpl::Register(SimulatedSequenceRunner* runner) {
 
 void SimulatedTimeControllerImpl::Unregister(SimulatedSequenceRunner* runner) {
   MutexLock lock(&lock_);
+  // A runner destroyed from another sequence might still be running its last
+  // tasks on another thread.
+  while (true) {
+    auto it = running_.find(runner);
+    if (it == running_.end() || it->second == rtc::CurrentThreadId())
+      break;
+    lock_.Unlock();
+    std::this_thread::yield();
+    lock_.Lock();
+  }
   bool removed = RemoveByValue(&runners_, runner);
   RTC_CHECK(removed);
   RemoveByValue(&ready_runners_, runner);
 }
 
 void SimulatedTimeControllerImpl::StartYield(TaskQueueBase* yielding_from) {
+  MutexLock lock(&lock_);
   auto inserted = yielded_.insert(yielding_from);
   RTC_DCHECK(inserted.second);
 }
 
 void SimulatedTimeControllerImpl::StopYield(TaskQueueBase* yielding_from) {
+  MutexLock lock(&lock_);
   yielded_.erase(yielding_from);
 }
 
@@ -175,7 +328,14 @@ void SimulatedTimeControllerImpl::StopYield(TaskQueueBase* yielding_from) {
 
 GlobalSimulatedTimeController::GlobalSimulatedTimeController(
     Timestamp start_time)
-    : sim_clock_(start_time.us()), impl_(start_time), yield_policy_(&impl_) {
+    : GlobalSimulatedTimeController(start_time, /*worker_threads=*/0) {}
+
+GlobalSimulatedTimeController::GlobalSimulatedTimeController(
+    Timestamp start_time,
+    int worker_threads)
+    : sim_clock_(start_time.us()),
+      impl_(start_time, worker_threads),
+      yield_policy_(&impl_) {
   global_clock_.SetTime(start_time);
   auto main_thread = std::make_unique<SimulatedMainThread>(&impl_);
   impl_.Register(main_thread.get());
@@ -12,10 +12,12 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "rtc_base/event.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -148,4 +150,74 @@ TEST(SimulatedTimeControllerTest, ThreadYeildsOnInvoke) {
   ASSERT_TRUE(task_has_run);
 }
 
+TEST(SimulatedTimeControllerTest, ParallelRunsTasksAtTheirSimulatedTime) {
+  constexpr int kNumQueues = 8;
+  GlobalSimulatedTimeController time_simulation(kStartTime,
+                                                /*worker_threads=*/3);
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> task_queues;
+  std::vector<RepeatingTaskHandle> handles(kNumQueues);
+  std::atomic<int> runs(0);
+  std::atomic<int> runs_at_wrong_time(0);
+  for (int i = 0; i < kNumQueues; ++i) {
+    task_queues.push_back(
+        time_simulation.GetTaskQueueFactory()->CreateTaskQueue(
+            "TestQueue", TaskQueueFactory::Priority::NORMAL));
+    TaskQueueBase* task_queue = task_queues.back().get();
+    task_queue->PostTask(ToQueuedTask([&, i, task_queue] {
+      Timestamp next_run = time_simulation.GetClock()->CurrentTime();
+      handles[i] =
+          RepeatingTaskHandle::Start(task_queue, [&, next_run]() mutable {
+            if (time_simulation.GetClock()->CurrentTime() != next_run)
+              ++runs_at_wrong_time;
+            ++runs;
+            next_run += TimeDelta::Millis(10);
+            return TimeDelta::Millis(10);
+          });
+    }));
+  }
+
+  time_simulation.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_EQ(runs, kNumQueues * 101);
+  EXPECT_EQ(runs_at_wrong_time, 0);
+
+  for (int i = 0; i < kNumQueues; ++i) {
+    task_queues[i]->PostTask(
+        ToQueuedTask([handle = &handles[i]] { handle->Stop(); }));
+  }
+  time_simulation.AdvanceTime(TimeDelta::Zero());
+}
+
+TEST(SimulatedTimeControllerTest, ParallelThreadYieldsOnInvoke) {
+  GlobalSimulatedTimeController sim(kStartTime, /*worker_threads=*/2);
+  auto main_thread = sim.GetMainThread();
+  auto t2 = sim.CreateThread("thread", nullptr);
+  std::atomic<bool> task_has_run(false);
+  main_thread->PostTask([&] { task_has_run = true; });
+  t2->Invoke<void>(RTC_FROM_HERE, [] {
+    rtc::Event yield_event;
+    yield_event.Wait(0);
+  });
+  EXPECT_FALSE(task_has_run);
+  sim.AdvanceTime(TimeDelta::Seconds(1));
+  ASSERT_TRUE(task_has_run);
+}
+
+TEST(SimulatedTimeControllerTest, ParallelInvokeFromTaskQueue) {
+  GlobalSimulatedTimeController sim(kStartTime, /*worker_threads=*/2);
+  auto thread = sim.CreateThread("thread", nullptr);
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+      sim.GetTaskQueueFactory()->CreateTaskQueue(
+          "TestQueue", TaskQueueFactory::Priority::NORMAL);
+  std::atomic<int> result(0);
+  task_queue->PostDelayedTask(ToQueuedTask([&] {
+                                result = thread->Invoke<int>(
+                                    RTC_FROM_HERE, [] { return 17; });
+                              }),
+                              /*milliseconds=*/10);
+  sim.AdvanceTime(TimeDelta::Millis(9));
+  EXPECT_EQ(result, 0);
+  sim.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_EQ(result, 17);
+}
+
 }  // namespace webrtc
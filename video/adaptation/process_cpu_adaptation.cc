@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/process_cpu_adaptation.h"
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+// Measures the CPU usage of the thread of the task queue that it is added on,
+// and reports the usage states that ProcessCpuAdaptation decides on.
+class ProcessCpuAdaptation::EncoderResource : public Resource {
+ public:
+  EncoderResource(rtc::scoped_refptr<ProcessCpuAdaptation> adaptation,
+                  double priority)
+      : adaptation_(std::move(adaptation)), priority_(priority) {}
+  ~EncoderResource() override { RTC_DCHECK(!repeating_task_.Running()); }
+
+  std::string Name() const override { return "ProcessCpuResource"; }
+
+  void SetResourceListener(ResourceListener* listener) override {
+    if (!listener) {
+      RTC_DCHECK_RUN_ON(task_queue_);
+      repeating_task_.Stop();
+      adaptation_->RemoveEncoder(this);
+      listener_ = nullptr;
+      return;
+    }
+    // The adaptation task queue of a VideoStreamEncoder is its encoder task
+    // queue.
+    task_queue_ = TaskQueueBase::Current();
+    RTC_DCHECK(task_queue_);
+    RTC_DCHECK_RUN_ON(task_queue_);
+    listener_ = listener;
+    last_cpu_time_ns_ = absl::nullopt;
+    adaptation_->AddEncoder(this, priority_);
+    repeating_task_.Stop();
+    repeating_task_ = RepeatingTaskHandle::Start(task_queue_, [this] {
+      RTC_DCHECK_RUN_ON(task_queue_);
+      Measure();
+      return adaptation_->config_.check_interval;
+    });
+  }
+
+  // May be called on any task queue while the resource has a listener.
+  void Report(ResourceUsageState usage_state) {
+    task_queue_->PostTask(
+        ToQueuedTask([resource = rtc::scoped_refptr<EncoderResource>(this),
+                      usage_state] {
+          RTC_DCHECK_RUN_ON(resource->task_queue_);
+          if (resource->listener_) {
+            resource->listener_->OnResourceUsageStateMeasured(resource,
+                                                              usage_state);
+          }
+        }));
+  }
+
+ private:
+  void Measure() RTC_RUN_ON(task_queue_) {
+    int64_t cpu_time_ns = adaptation_->config_.thread_cpu_time_ns();
+    Timestamp now = adaptation_->clock_->CurrentTime();
+    if (last_cpu_time_ns_ && now > last_measurement_) {
+      adaptation_->OnUsageMeasured(
+          this, static_cast<double>(cpu_time_ns - *last_cpu_time_ns_) /
+                    (now - last_measurement_).ns());
+    }
+    last_cpu_time_ns_ = cpu_time_ns;
+    last_measurement_ = now;
+  }
+
+  const rtc::scoped_refptr<ProcessCpuAdaptation> adaptation_;
+  const double priority_;
+  TaskQueueBase* task_queue_ = nullptr;
+  ResourceListener* listener_ RTC_GUARDED_BY(task_queue_) = nullptr;
+  RepeatingTaskHandle repeating_task_ RTC_GUARDED_BY(task_queue_);
+  absl::optional<int64_t> last_cpu_time_ns_ RTC_GUARDED_BY(task_queue_);
+  Timestamp last_measurement_ RTC_GUARDED_BY(task_queue_) =
+      Timestamp::MinusInfinity();
+};
+
+ProcessCpuAdaptation::Config::Config()
+    : num_cores(CpuInfo::DetectNumberOfCores()),
+      thread_cpu_time_ns(&rtc::GetThreadCpuTimeNanos) {}
+ProcessCpuAdaptation::Config::Config(const Config&) = default;
+ProcessCpuAdaptation::Config::~Config() = default;
+
+// static
+rtc::scoped_refptr<ProcessCpuAdaptation> ProcessCpuAdaptation::Create(
+    Clock* clock,
+    const Config& config) {
+  return rtc::make_ref_counted<ProcessCpuAdaptation>(clock, config);
+}
+
+ProcessCpuAdaptation::ProcessCpuAdaptation(Clock* clock, const Config& config)
+    : clock_(clock), config_(config) {
+  RTC_DCHECK(clock_);
+  RTC_DCHECK_GT(config_.num_cores, 0);
+  RTC_DCHECK_LT(config_.underuse_threshold, config_.overuse_threshold);
+}
+
+ProcessCpuAdaptation::~ProcessCpuAdaptation() {
+  RTC_DCHECK(encoders_.empty());
+}
+
+rtc::scoped_refptr<Resource> ProcessCpuAdaptation::CreateResource(
+    double priority) {
+  RTC_DCHECK_GT(priority, 0);
+  return rtc::make_ref_counted<EncoderResource>(
+      rtc::scoped_refptr<ProcessCpuAdaptation>(this), priority);
+}
+
+double ProcessCpuAdaptation::usage() const {
+  MutexLock lock(&lock_);
+  return TotalUsage();
+}
+
+void ProcessCpuAdaptation::AddEncoder(EncoderResource* resource,
+                                      double priority) {
+  MutexLock lock(&lock_);
+  Encoder encoder;
+  encoder.priority = priority;
+  encoders_[resource] = encoder;
+}
+
+void ProcessCpuAdaptation::RemoveEncoder(EncoderResource* resource) {
+  MutexLock lock(&lock_);
+  encoders_.erase(resource);
+}
+
+void ProcessCpuAdaptation::OnUsageMeasured(EncoderResource* resource,
+                                           double usage) {
+  MutexLock lock(&lock_);
+  auto it = encoders_.find(resource);
+  if (it == encoders_.end())
+    return;
+  it->second.usage = usage;
+
+  Timestamp now = clock_->CurrentTime();
+  if (last_adaptation_ && now - *last_adaptation_ < config_.check_interval)
+    return;
+  double total_usage = TotalUsage();
+  if (total_usage > config_.overuse_threshold) {
+    // Degrade the encoder that has been degraded the least for its priority,
+    // preferring the one that uses the most CPU.
+    auto key = [](const Encoder& encoder) {
+      return std::make_tuple((encoder.degradations + 1) * encoder.priority,
+                             -encoder.usage.value_or(0), encoder.priority);
+    };
+    auto target = encoders_.begin();
+    for (auto other = encoders_.begin(); other != encoders_.end(); ++other) {
+      if (key(other->second) < key(target->second))
+        target = other;
+    }
+    ++target->second.degradations;
+    last_adaptation_ = now;
+    RTC_LOG(LS_INFO) << "Encoders use " << total_usage
+                     << " of the CPU, adapting down encoder of priority "
+                     << target->second.priority;
+    target->first->Report(ResourceUsageState::kOveruse);
+  } else if (total_usage < config_.underuse_threshold) {
+    // Restore the encoder that has been degraded the most for its priority,
+    // preferring the one of the highest priority.
+    auto key = [](const Encoder& encoder) {
+      return std::make_tuple(encoder.degradations * encoder.priority,
+                             encoder.priority);
+    };
+    auto target = encoders_.end();
+    for (auto other = encoders_.begin(); other != encoders_.end(); ++other) {
+      if (other->second.degradations > 0 &&
+          (target == encoders_.end() ||
+           key(target->second) < key(other->second))) {
+        target = other;
+      }
+    }
+    if (target == encoders_.end())
+      return;
+    --target->second.degradations;
+    last_adaptation_ = now;
+    RTC_LOG(LS_INFO) << "Encoders use " << total_usage
+                     << " of the CPU, adapting up encoder of priority "
+                     << target->second.priority;
+    target->first->Report(ResourceUsageState::kUnderuse);
+  }
+}
+
+double ProcessCpuAdaptation::TotalUsage() const {
+  double usage = 0;
+  for (const auto& encoder : encoders_)
+    usage += encoder.second.usage.value_or(0);
+  return usage / config_.num_cores;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ADAPTATION_PROCESS_CPU_ADAPTATION_H_
+#define VIDEO_ADAPTATION_PROCESS_CPU_ADAPTATION_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+
+#include "absl/types/optional.h"
+#include "api/adaptation/resource.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Adapts the VideoStreamEncoders of a process to the CPU that they use
+// together. The EncodeUsageResource of each encoder only sees the encode time
+// of its own frames, so with many encoders in one process each of them can be
+// fine while the machine is saturated.
+//
+// Each encoder gets a resource from CreateResource(), to be added with
+// VideoStreamEncoder::AddAdaptationResource(). The resource measures the CPU
+// time of the thread of the encoder task queue. When the encoder threads
+// together use more than `overuse_threshold` of all cores, one encoder at a
+// time is asked to adapt down, and when they use less than
+// `underuse_threshold`, one encoder at a time is asked to adapt up again.
+// Encoders are degraded in inverse proportion to their priority: an encoder
+// of priority 2 is degraded half as many times as one of priority 1.
+class ProcessCpuAdaptation : public rtc::RefCountedBase {
+ public:
+  struct Config {
+    Config();
+    Config(const Config&);
+    ~Config();
+
+    // Fractions of the CPU time of all cores.
+    double overuse_threshold = 0.85;
+    double underuse_threshold = 0.6;
+    // How often the encoder threads are measured, and the shortest time
+    // between two adaptations.
+    TimeDelta check_interval = TimeDelta::Seconds(2);
+    int num_cores;
+    // Returns the CPU time of the calling thread. Replaceable for tests.
+    std::function<int64_t()> thread_cpu_time_ns;
+  };
+
+  static rtc::scoped_refptr<ProcessCpuAdaptation> Create(Clock* clock,
+                                                         const Config& config);
+
+  ProcessCpuAdaptation(Clock* clock, const Config& config);
+
+  // `priority` must be positive. The resource must be added to a single
+  // VideoStreamEncoder.
+  rtc::scoped_refptr<Resource> CreateResource(double priority);
+
+  // The CPU usage of the encoder threads, as a fraction of all cores, at the
+  // last measurement.
+  double usage() const;
+
+ protected:
+  ~ProcessCpuAdaptation() override;
+
+ private:
+  class EncoderResource;
+
+  struct Encoder {
+    double priority;
+    absl::optional<double> usage;
+    // Number of times the encoder has been asked to adapt down, minus the
+    // number of times it has been asked to adapt up.
+    int degradations = 0;
+  };
+
+  void AddEncoder(EncoderResource* resource, double priority);
+  void RemoveEncoder(EncoderResource* resource);
+  // Called on the task queue of `resource` with the usage of its thread, as a
+  // fraction of one core.
+  void OnUsageMeasured(EncoderResource* resource, double usage);
+  double TotalUsage() const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  Clock* const clock_;
+  const Config config_;
+  mutable Mutex lock_;
+  std::map<EncoderResource*, Encoder> encoders_ RTC_GUARDED_BY(lock_);
+  absl::optional<Timestamp> last_adaptation_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ADAPTATION_PROCESS_CPU_ADAPTATION_H_
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/process_cpu_adaptation.h"
+
+#include <memory>
+#include <utility>
+
+#include "api/units/timestamp.h"
+#include "call/adaptation/test/mock_resource_listener.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+using testing::_;
+
+namespace webrtc {
+
+namespace {
+
+constexpr TimeDelta kCheckInterval = TimeDelta::Seconds(1);
+
+}  // namespace
+
+class ProcessCpuAdaptationTest : public ::testing::Test {
+ public:
+  ProcessCpuAdaptationTest()
+      : time_controller_(Timestamp::Micros(1234)),
+        task_queue_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "TestQueue",
+            TaskQueueFactory::Priority::NORMAL)) {
+    ProcessCpuAdaptation::Config config;
+    config.overuse_threshold = 0.85;
+    config.underuse_threshold = 0.6;
+    config.check_interval = kCheckInterval;
+    config.num_cores = 1;
+    // Both resources are on the same task queue, so they measure the same
+    // thread.
+    config.thread_cpu_time_ns = [this] { return cpu_time_ns_; };
+    adaptation_ =
+        ProcessCpuAdaptation::Create(time_controller_.GetClock(), config);
+  }
+
+  // Advances time by one check interval, in which each encoder uses
+  // `usage` of the CPU.
+  void AdvanceInterval(double usage) {
+    cpu_time_ns_ += usage * kCheckInterval.ns();
+    time_controller_.AdvanceTime(kCheckInterval);
+  }
+
+  void RunTaskOnTaskQueue(std::unique_ptr<QueuedTask> task) {
+    task_queue_->PostTask(std::move(task));
+    time_controller_.AdvanceTime(TimeDelta::Millis(0));
+  }
+
+ protected:
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+  int64_t cpu_time_ns_ = 0;
+  rtc::scoped_refptr<ProcessCpuAdaptation> adaptation_;
+};
+
+TEST_F(ProcessCpuAdaptationTest, IsSilentWithinThresholds) {
+  testing::StrictMock<MockResourceListener> listener;
+  rtc::scoped_refptr<Resource> resource = adaptation_->CreateResource(1.0);
+  RunTaskOnTaskQueue(
+      ToQueuedTask([&] { resource->SetResourceListener(&listener); }));
+
+  for (int i = 0; i < 10; ++i)
+    AdvanceInterval(0.7);
+  EXPECT_DOUBLE_EQ(adaptation_->usage(), 0.7);
+
+  RunTaskOnTaskQueue(
+      ToQueuedTask([&] { resource->SetResourceListener(nullptr); }));
+}
+
+TEST_F(ProcessCpuAdaptationTest, DegradesEncodersInProportionToPriority) {
+  testing::StrictMock<MockResourceListener> low_listener;
+  testing::StrictMock<MockResourceListener> high_listener;
+  rtc::scoped_refptr<Resource> low = adaptation_->CreateResource(1.0);
+  rtc::scoped_refptr<Resource> high = adaptation_->CreateResource(2.0);
+  RunTaskOnTaskQueue(ToQueuedTask([&] {
+    low->SetResourceListener(&low_listener);
+    high->SetResourceListener(&high_listener);
+  }));
+
+  // Together the encoders use the whole CPU, while each uses half of it.
+  // The encoder of priority 2 is degraded half as often.
+  EXPECT_CALL(low_listener,
+              OnResourceUsageStateMeasured(_, ResourceUsageState::kOveruse))
+      .Times(1);
+  AdvanceInterval(0.5);
+  EXPECT_CALL(low_listener,
+              OnResourceUsageStateMeasured(_, ResourceUsageState::kOveruse))
+      .Times(1);
+  AdvanceInterval(0.5);
+  EXPECT_CALL(high_listener,
+              OnResourceUsageStateMeasured(_, ResourceUsageState::kOveruse))
+      .Times(1);
+  AdvanceInterval(0.5);
+  testing::Mock::VerifyAndClearExpectations(&low_listener);
+  testing::Mock::VerifyAndClearExpectations(&high_listener);
+
+  // When the CPU frees up, the encoder of the higher priority is restored
+  // first, and then the other one, until no encoder is degraded.
+  EXPECT_CALL(high_listener,
+              OnResourceUsageStateMeasured(_, ResourceUsageState::kUnderuse))
+      .Times(1);
+  AdvanceInterval(0.2);
+  EXPECT_CALL(low_listener,
+              OnResourceUsageStateMeasured(_, ResourceUsageState::kUnderuse))
+      .Times(2);
+  AdvanceInterval(0.2);
+  AdvanceInterval(0.2);
+  AdvanceInterval(0.2);
+  AdvanceInterval(0.2);
+
+  RunTaskOnTaskQueue(ToQueuedTask([&] {
+    low->SetResourceListener(nullptr);
+    high->SetResourceListener(nullptr);
+  }));
+}
+
+}  // namespace webrtc
@@ -54,6 +54,19 @@ void BufferedFrameDecryptor::ManageEncryptedFrame(
   }
 }
 
+void BufferedFrameDecryptor::ManageEncryptedFrames(
+    std::vector<std::unique_ptr<RtpFrameObject>> encrypted_frames) {
+  const FrameDecryptorInterface::Status status_before_batch = last_status_;
+  managing_batch_ = true;
+  for (auto& encrypted_frame : encrypted_frames) {
+    ManageEncryptedFrame(std::move(encrypted_frame));
+  }
+  managing_batch_ = false;
+  if (last_status_ != status_before_batch) {
+    decryption_status_change_callback_->OnDecryptionStatusChange(last_status_);
+  }
+}
+
 BufferedFrameDecryptor::FrameDecision BufferedFrameDecryptor::DecryptFrame(
     RtpFrameObject* frame) {
   // Optionally attempt to decrypt the raw video frame if it was provided.
@@ -82,11 +95,14 @@ BufferedFrameDecryptor::FrameDecision BufferedFrameDecryptor::DecryptFrame(
       frame_decryptor_->Decrypt(cricket::MEDIA_TYPE_VIDEO, /*csrcs=*/{},
                                 additional_data, *frame,
                                 inline_decrypted_bitstream);
-  // Optionally call the callback if there was a change in status
+  // Optionally call the callback if there was a change in status. Within a
+  // batch, it's called once the whole batch has been managed.
   if (decrypt_result.status != last_status_) {
     last_status_ = decrypt_result.status;
-    decryption_status_change_callback_->OnDecryptionStatusChange(
-        decrypt_result.status);
+    if (!managing_batch_) {
+      decryption_status_change_callback_->OnDecryptionStatusChange(
+          decrypt_result.status);
+    }
   }
 
   if (!decrypt_result.IsOk()) {
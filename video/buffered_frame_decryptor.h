@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 #include "api/crypto/crypto_options.h"
 #include "api/crypto/frame_decryptor_interface.h"
@@ -73,6 +74,13 @@ class BufferedFrameDecryptor final {
   // the OnDecryptedFrameCallback.
   void ManageEncryptedFrame(std::unique_ptr<RtpFrameObject> encrypted_frame);
 
+  // Same as ManageEncryptedFrame() for each of `encrypted_frames`, in order,
+  // e.g. for the frames completed by a burst of packets. Frames are decrypted
+  // in place, and a change of decryption status is reported once for the
+  // whole batch.
+  void ManageEncryptedFrames(
+      std::vector<std::unique_ptr<RtpFrameObject>> encrypted_frames);
+
  private:
   // Represents what should be done with a given frame.
   enum class FrameDecision { kStash, kDecrypted, kDrop };
@@ -91,6 +99,7 @@ class BufferedFrameDecryptor final {
   bool first_frame_decrypted_ = false;
   FrameDecryptorInterface::Status last_status_ =
       FrameDecryptorInterface::Status::kUnknown;
+  bool managing_batch_ = false;
   rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor_;
   OnDecryptedFrameCallback* const decrypted_frame_callback_;
   OnDecryptionStatusChangeCallback* const decryption_status_change_callback_;
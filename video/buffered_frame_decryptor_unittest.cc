@@ -152,6 +152,28 @@ TEST_F(BufferedFrameDecryptorTest, DelayedCallbackOnBufferedFrames) {
   EXPECT_EQ(decryption_status_change_count_, static_cast<size_t>(2));
 }
 
+// Frames managed as a batch are handled like single frames, but the status
+// change is only reported once, for the end of the batch.
+TEST_F(BufferedFrameDecryptorTest, StatusChangeReportedOncePerBatch) {
+  EXPECT_CALL(*mock_frame_decryptor_, Decrypt)
+      .Times(3)
+      .WillOnce(Return(DecryptFail()))
+      .WillOnce(Return(DecryptSuccess()))
+      .WillOnce(Return(DecryptSuccess()));
+  EXPECT_CALL(*mock_frame_decryptor_, GetMaxPlaintextByteSize)
+      .Times(3)
+      .WillRepeatedly(Return(0));
+
+  // The first frame fails and is stashed, then played back when the second
+  // one succeeds.
+  std::vector<std::unique_ptr<RtpFrameObject>> frames;
+  frames.push_back(CreateRtpFrameObject(true));
+  frames.push_back(CreateRtpFrameObject(false));
+  buffered_frame_decryptor_->ManageEncryptedFrames(std::move(frames));
+  EXPECT_EQ(decrypted_frame_call_count_, static_cast<size_t>(2));
+  EXPECT_EQ(decryption_status_change_count_, static_cast<size_t>(1));
+}
+
 // Subsequent failure to decrypts after the first successful decryption should
 // fail to decryptk
 TEST_F(BufferedFrameDecryptorTest, FTDDiscardedAfterFirstSuccess) {
@@ -66,16 +66,20 @@ int64_t GetNewAvgRttMs(const std::list<CallStats::RttTime>& reports,
 
 constexpr TimeDelta CallStats::kUpdateInterval;
 
-CallStats::CallStats(Clock* clock, TaskQueueBase* task_queue)
+CallStats::CallStats(Clock* clock,
+                     TaskQueueBase* task_queue,
+                     MetronomeTaskScheduler* tick_scheduler)
     : clock_(clock),
       max_rtt_ms_(-1),
       avg_rtt_ms_(-1),
       sum_avg_rtt_ms_(0),
       num_avg_rtt_(0),
       time_of_first_rtt_ms_(-1),
-      task_queue_(task_queue) {
+      task_queue_(task_queue),
+      tick_scheduler_(tick_scheduler) {
   RTC_DCHECK(task_queue_);
   RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(!tick_scheduler_ || tick_scheduler_->task_queue() == task_queue_);
 }
 
 CallStats::~CallStats() {
@@ -89,11 +93,17 @@ CallStats::~CallStats() {
 
 void CallStats::EnsureStarted() {
   RTC_DCHECK_RUN_ON(task_queue_);
-  repeating_task_ =
-      RepeatingTaskHandle::DelayedStart(task_queue_, kUpdateInterval, [this]() {
-        UpdateAndReport();
-        return kUpdateInterval;
-      });
+  auto update = [this]() {
+    UpdateAndReport();
+    return kUpdateInterval;
+  };
+  if (tick_scheduler_) {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        tick_scheduler_, kUpdateInterval, std::move(update));
+  } else {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_, kUpdateInterval, std::move(update));
+  }
 }
 
 void CallStats::UpdateAndReport() {
@@ -18,6 +18,7 @@
 #include "modules/include/module_common_types.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "system_wrappers/include/clock.h"
@@ -30,8 +31,12 @@ class CallStats {
   // Time interval for updating the observers.
   static constexpr TimeDelta kUpdateInterval = TimeDelta::Millis(1000);
 
-  // Must be created and destroyed on the same task_queue.
-  CallStats(Clock* clock, TaskQueueBase* task_queue);
+  // Must be created and destroyed on the same task_queue. If `tick_scheduler`
+  // is set, the observers are updated on its metronome ticks. It must run on
+  // `task_queue`.
+  CallStats(Clock* clock,
+            TaskQueueBase* task_queue,
+            MetronomeTaskScheduler* tick_scheduler = nullptr);
   ~CallStats();
 
   CallStats(const CallStats&) = delete;
@@ -124,6 +129,7 @@ class CallStats {
   std::list<CallStatsObserver*> observers_ RTC_GUARDED_BY(task_queue_);
 
   TaskQueueBase* const task_queue_;
+  MetronomeTaskScheduler* const tick_scheduler_;
 
   // Used to signal destruction to potentially pending tasks.
   ScopedTaskSafety task_safety_;
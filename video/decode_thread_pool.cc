@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+class DecodeThreadPool::Sequence final : public TaskQueueBase {
+ public:
+  explicit Sequence(DecodeThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override { pool_->DeleteSequence(this); }
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    pool_->PostTask(this, std::move(task), pool_->clock_->CurrentTime());
+  }
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    pool_->PostDelayedTask(this, std::move(task), milliseconds);
+  }
+
+  void RunTask(std::unique_ptr<QueuedTask> task) {
+    CurrentTaskQueueSetter set_current(this);
+    QueuedTask* release_ptr = task.release();
+    if (release_ptr->Run())
+      delete release_ptr;
+  }
+
+  // All guarded by the pool's `mutex_`.
+  std::deque<PendingTask> tasks;
+  bool running = false;
+  bool deleted = false;
+
+  // Signaled when a task finishes after the sequence was deleted.
+  rtc::Event task_finished;
+
+ private:
+  DecodeThreadPool* const pool_;
+};
+
+DecodeThreadPool::DecodeThreadPool(Clock* clock, int num_threads)
+    : clock_(clock) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this] { RunWorker(); }, "DecodeThreadPool",
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime)));
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK(sequences_.empty());
+    stopping_ = true;
+  }
+  wake_up_.Set();
+  // Destroying the threads joins them.
+  threads_.clear();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateSequence(absl::string_view name) {
+  // The pool's threads are shared, so they aren't named after the sequences.
+  Sequence* sequence = new Sequence(this);
+  MutexLock lock(&mutex_);
+  sequences_.insert(sequence);
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(sequence);
+}
+
+void DecodeThreadPool::PostTaskWithDeadline(TaskQueueBase* sequence,
+                                            std::unique_ptr<QueuedTask> task,
+                                            Timestamp deadline) {
+  PostTask(static_cast<Sequence*>(sequence), std::move(task), deadline);
+}
+
+void DecodeThreadPool::PostTask(Sequence* sequence,
+                                std::unique_ptr<QueuedTask> task,
+                                Timestamp deadline) {
+  // Tasks posted while the sequence is being deleted are dropped, like on
+  // other task queues.
+  std::unique_ptr<QueuedTask> dropped_task;
+  {
+    MutexLock lock(&mutex_);
+    if (sequence->deleted) {
+      dropped_task = std::move(task);
+      return;
+    }
+    sequence->tasks.push_back({deadline, next_order_++, std::move(task)});
+    // A running sequence is picked up again by its thread when the task ends.
+    if (sequence->running)
+      return;
+  }
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::PostDelayedTask(Sequence* sequence,
+                                       std::unique_ptr<QueuedTask> task,
+                                       uint32_t milliseconds) {
+  std::unique_ptr<QueuedTask> dropped_task;
+  {
+    MutexLock lock(&mutex_);
+    if (sequence->deleted) {
+      dropped_task = std::move(task);
+      return;
+    }
+    DelayedTaskKey key{
+        clock_->CurrentTime() + TimeDelta::Millis(milliseconds),
+        next_order_++};
+    delayed_tasks_[key] = {sequence, std::move(task)};
+  }
+  // Makes a waiting thread recompute how long it may sleep.
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::DeleteSequence(Sequence* sequence) {
+  RTC_DCHECK(!sequence->IsCurrent());
+  // Tasks are destroyed outside of the lock, since destroying them may post
+  // other tasks.
+  std::deque<PendingTask> tasks;
+  std::vector<std::unique_ptr<QueuedTask>> delayed_tasks;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    sequences_.erase(sequence);
+    sequence->deleted = true;
+    tasks.swap(sequence->tasks);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.sequence == sequence) {
+        delayed_tasks.push_back(std::move(it->second.task));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    running = sequence->running;
+  }
+  if (running)
+    sequence->task_finished.Wait(rtc::Event::kForever);
+  delete sequence;
+}
+
+TimeDelta DecodeThreadPool::MoveDueDelayedTasks(Timestamp now) {
+  while (!delayed_tasks_.empty()) {
+    auto it = delayed_tasks_.begin();
+    if (it->first.run_at > now)
+      return it->first.run_at - now;
+    it->second.sequence->tasks.push_back(
+        {it->first.run_at, next_order_++, std::move(it->second.task)});
+    delayed_tasks_.erase(it);
+  }
+  return TimeDelta::PlusInfinity();
+}
+
+DecodeThreadPool::Sequence* DecodeThreadPool::NextSequence(
+    bool* more_runnable) {
+  // There is one sequence per receive stream, so a linear scan is cheap
+  // compared to decoding a frame.
+  Sequence* next = nullptr;
+  *more_runnable = false;
+  for (Sequence* sequence : sequences_) {
+    if (sequence->running || sequence->tasks.empty())
+      continue;
+    if (next) {
+      *more_runnable = true;
+      const PendingTask& task = sequence->tasks.front();
+      const PendingTask& next_task = next->tasks.front();
+      if (task.deadline > next_task.deadline ||
+          (task.deadline == next_task.deadline &&
+           task.order > next_task.order)) {
+        continue;
+      }
+    }
+    next = sequence;
+  }
+  return next;
+}
+
+void DecodeThreadPool::RunWorker() {
+  while (true) {
+    Sequence* sequence = nullptr;
+    std::unique_ptr<QueuedTask> task;
+    TimeDelta wait_time = TimeDelta::PlusInfinity();
+    bool more_runnable = false;
+    {
+      MutexLock lock(&mutex_);
+      if (stopping_)
+        break;
+      wait_time = MoveDueDelayedTasks(clock_->CurrentTime());
+      sequence = NextSequence(&more_runnable);
+      if (sequence) {
+        task = std::move(sequence->tasks.front().task);
+        sequence->tasks.pop_front();
+        sequence->running = true;
+      }
+    }
+
+    if (!sequence) {
+      wake_up_.Wait(wait_time.IsFinite() ? wait_time.ms() + 1
+                                         : rtc::Event::kForever);
+      continue;
+    }
+    if (more_runnable)
+      wake_up_.Set();
+
+    sequence->RunTask(std::move(task));
+
+    MutexLock lock(&mutex_);
+    sequence->running = false;
+    if (sequence->deleted)
+      sequence->task_finished.Set();
+  }
+  // Lets the next thread see that the pool is stopping.
+  wake_up_.Set();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// DecodeThreadPool runs the decode queues of many video receive streams on a
+// bounded number of threads, instead of one thread per stream.
+//
+// Each stream gets a sequence from `CreateSequence()`, which is a task queue:
+// its tasks run in FIFO order and never overlap, but they may run on any of
+// the pool's threads. When more sequences have tasks than there are threads,
+// the sequence whose next task has the earliest deadline runs first. Frames
+// posted with `PostTaskWithDeadline()` use their render time as deadline,
+// other tasks use the time they were posted (or, for delayed tasks, the time
+// they became due), so a stream whose frame must be rendered soon is decoded
+// before a stream whose frame can wait.
+//
+// All sequences must be deleted before the pool.
+class DecodeThreadPool {
+ public:
+  DecodeThreadPool(Clock* clock, int num_threads);
+  ~DecodeThreadPool();
+
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateSequence(
+      absl::string_view name);
+
+  // Posts `task` to `sequence`, which must have been created by this pool,
+  // with `deadline` instead of the current time as its deadline.
+  void PostTaskWithDeadline(TaskQueueBase* sequence,
+                            std::unique_ptr<QueuedTask> task,
+                            Timestamp deadline);
+
+ private:
+  class Sequence;
+
+  struct PendingTask {
+    Timestamp deadline;
+    uint64_t order;
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  struct DelayedTaskKey {
+    Timestamp run_at;
+    uint64_t order;
+
+    bool operator<(const DelayedTaskKey& o) const {
+      return run_at < o.run_at || (run_at == o.run_at && order < o.order);
+    }
+  };
+
+  struct DelayedTask {
+    Sequence* sequence;
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  void PostTask(Sequence* sequence,
+                std::unique_ptr<QueuedTask> task,
+                Timestamp deadline);
+  void PostDelayedTask(Sequence* sequence,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+  void DeleteSequence(Sequence* sequence);
+
+  // Moves the delayed tasks that are due to their sequences, and returns the
+  // time until the next one is due.
+  TimeDelta MoveDueDelayedTasks(Timestamp now)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Returns the idle sequence with the earliest deadline, or null if no idle
+  // sequence has tasks. Sets `more_runnable` if other sequences can run too.
+  Sequence* NextSequence(bool* more_runnable)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RunWorker();
+
+  Clock* const clock_;
+
+  // Signaled whenever there may be a task that no thread is running yet, or
+  // when the pool is stopping. Each thread that wakes up passes it on if there
+  // is more work than it can take.
+  rtc::Event wake_up_;
+
+  Mutex mutex_;
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  uint64_t next_order_ RTC_GUARDED_BY(mutex_) = 0;
+  std::set<Sequence*> sequences_ RTC_GUARDED_BY(mutex_);
+  std::map<DelayedTaskKey, DelayedTask> delayed_tasks_ RTC_GUARDED_BY(mutex_);
+
+  std::vector<rtc::PlatformThread> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+using ::testing::ElementsAre;
+
+namespace {
+
+constexpr int kWaitMs = 5000;
+
+class DecodeThreadPoolTest : public ::testing::Test {
+ protected:
+  void Record(int id) {
+    MutexLock lock(&mutex_);
+    order_.push_back(id);
+  }
+  std::vector<int> Order() {
+    MutexLock lock(&mutex_);
+    return order_;
+  }
+
+  Clock* const clock_ = Clock::GetRealTimeClock();
+
+ private:
+  Mutex mutex_;
+  std::vector<int> order_;
+};
+
+}  // namespace
+
+TEST_F(DecodeThreadPoolTest, RunsTasksOfASequenceInOrder) {
+  DecodeThreadPool pool(clock_, 4);
+  rtc::TaskQueue sequence(pool.CreateSequence("sequence"));
+  rtc::Event done;
+  for (int i = 0; i < 10; ++i) {
+    sequence.PostTask([this, i, &sequence] {
+      EXPECT_TRUE(sequence.IsCurrent());
+      Record(i);
+    });
+  }
+  sequence.PostTask([&done] { done.Set(); });
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_THAT(Order(), ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST_F(DecodeThreadPoolTest, RunsEarliestDeadlineFirst) {
+  DecodeThreadPool pool(clock_, 1);
+  rtc::TaskQueue blocked(pool.CreateSequence("blocked"));
+  rtc::TaskQueue late(pool.CreateSequence("late"));
+  rtc::TaskQueue early(pool.CreateSequence("early"));
+
+  // Keep the only thread busy until both frames are posted.
+  rtc::Event started;
+  rtc::Event release;
+  blocked.PostTask([&] {
+    started.Set();
+    release.Wait(kWaitMs);
+  });
+  ASSERT_TRUE(started.Wait(kWaitMs));
+
+  const Timestamp now = clock_->CurrentTime();
+  pool.PostTaskWithDeadline(late.Get(), ToQueuedTask([this] { Record(2); }),
+                            now + TimeDelta::Millis(30));
+  pool.PostTaskWithDeadline(early.Get(), ToQueuedTask([this] { Record(1); }),
+                            now + TimeDelta::Millis(10));
+  rtc::Event done;
+  pool.PostTaskWithDeadline(late.Get(), ToQueuedTask([&done] { done.Set(); }),
+                            now + TimeDelta::Millis(30));
+  release.Set();
+
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_THAT(Order(), ElementsAre(1, 2));
+}
+
+TEST_F(DecodeThreadPoolTest, RunsSequencesInParallel) {
+  DecodeThreadPool pool(clock_, 2);
+  rtc::TaskQueue first(pool.CreateSequence("first"));
+  rtc::TaskQueue second(pool.CreateSequence("second"));
+
+  // Both tasks only finish if they run at the same time.
+  rtc::Event first_running;
+  rtc::Event second_running;
+  rtc::Event first_done;
+  rtc::Event second_done;
+  first.PostTask([&] {
+    first_running.Set();
+    if (second_running.Wait(kWaitMs))
+      first_done.Set();
+  });
+  second.PostTask([&] {
+    second_running.Set();
+    if (first_running.Wait(kWaitMs))
+      second_done.Set();
+  });
+  EXPECT_TRUE(first_done.Wait(kWaitMs));
+  EXPECT_TRUE(second_done.Wait(kWaitMs));
+}
+
+TEST_F(DecodeThreadPoolTest, RunsDelayedTasks) {
+  DecodeThreadPool pool(clock_, 2);
+  rtc::TaskQueue sequence(pool.CreateSequence("sequence"));
+  rtc::Event done;
+  const Timestamp start = clock_->CurrentTime();
+  sequence.PostDelayedTask([&done] { done.Set(); }, 20);
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_GE(clock_->CurrentTime() - start, TimeDelta::Millis(20));
+}
+
+TEST_F(DecodeThreadPoolTest, DeletingSequenceDropsItsTasks) {
+  DecodeThreadPool pool(clock_, 1);
+  rtc::TaskQueue other(pool.CreateSequence("other"));
+  rtc::Event started;
+  rtc::Event release;
+  other.PostTask([&] {
+    started.Set();
+    release.Wait(kWaitMs);
+  });
+  ASSERT_TRUE(started.Wait(kWaitMs));
+
+  {
+    rtc::TaskQueue deleted(pool.CreateSequence("deleted"));
+    deleted.PostTask([this] { Record(1); });
+    deleted.PostDelayedTask([this] { Record(2); }, 1);
+  }
+  release.Set();
+
+  rtc::Event done;
+  other.PostDelayedTask([&done] { done.Set(); }, 10);
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_TRUE(Order().empty());
+}
+
+}  // namespace webrtc
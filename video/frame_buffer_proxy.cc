@@ -132,6 +132,8 @@ class FrameBuffer2Proxy : public FrameBufferProxy {
       PendingTaskSafetyFlag::CreateDetached();
 };
 
+constexpr const char* kLowLatencyReceiveFieldTrial = "WebRTC-LowLatencyReceive";
+
 // Max number of frames the buffer will hold.
 static constexpr size_t kMaxFramesBuffered = 800;
 // Max number of decoded frame info that will be saved.
@@ -175,12 +177,14 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
       FrameSchedulingReceiver* receiver,
       TimeDelta max_wait_for_keyframe,
       TimeDelta max_wait_for_frame,
-      std::unique_ptr<FrameDecodeScheduler> frame_decode_scheduler)
+      std::unique_ptr<FrameDecodeScheduler> frame_decode_scheduler,
+      DecodeThreadPool* decode_pool)
       : max_wait_for_keyframe_(max_wait_for_keyframe),
         max_wait_for_frame_(max_wait_for_frame),
         clock_(clock),
         worker_queue_(worker_queue),
         decode_queue_(decode_queue),
+        decode_pool_(decode_pool),
         stats_proxy_(stats_proxy),
         receiver_(receiver),
         timing_(timing),
@@ -306,8 +310,13 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
     if (first_frame.is_keyframe())
       keyframe_required_ = false;
 
+    // With zero playout delay frames are rendered as soon as they are decoded,
+    // so there is no render time to check and no delay to estimate.
+    const bool zero_playout_delay = IsZeroPlayoutDelay();
+
     // Gracefully handle bad RTP timestamps and render time issues.
-    if (FrameHasBadRenderTiming(render_time, now,
+    if (!zero_playout_delay &&
+        FrameHasBadRenderTiming(render_time, now,
                                 timing_->TargetVideoDelay())) {
       jitter_estimator_.Reset();
       timing_->Reset();
@@ -323,7 +332,10 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
       superframe_size += DataSize::Bytes(frame->size());
     }
 
-    if (!superframe_delayed_by_retransmission) {
+    if (zero_playout_delay) {
+      // Restarts the inter-frame delay once the stream leaves the mode.
+      inter_frame_delay_.Reset(now.ms());
+    } else if (!superframe_delayed_by_retransmission) {
       int64_t frame_delay;
 
       if (inter_frame_delay_.CalculateDelay(first_frame.Timestamp(),
@@ -358,10 +370,18 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
 
     decoder_ready_for_new_frame_ = false;
     // VideoReceiveStream2 wants frames on the decoder thread.
-    decode_queue_->PostTask(ToQueuedTask(
+    auto decode_task = ToQueuedTask(
         decode_safety_, [this, frame = std::move(frame)]() mutable {
           receiver_->OnEncodedFrame(std::move(frame));
-        }));
+        });
+    if (decode_pool_) {
+      // Streams sharing the pool are decoded in the order their frames are
+      // rendered.
+      decode_pool_->PostTaskWithDeadline(decode_queue_->Get(),
+                                         std::move(decode_task), render_time);
+    } else {
+      decode_queue_->PostTask(std::move(decode_task));
+    }
   }
 
   void OnTimeout() {
@@ -390,6 +410,13 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
     OnFrameReady(std::move(frames), render_time);
   }
 
+  // Returns true if decodable frames are released to the decoder right away,
+  // see `low_latency_receive_`.
+  bool IsZeroPlayoutDelay() const {
+    return low_latency_receive_ && timing_->min_playout_delay().IsZero() &&
+           timing_->max_playout_delay().IsZero();
+  }
+
   TimeDelta MaxWait() const RTC_RUN_ON(&worker_sequence_checker_) {
     return keyframe_required_ ? max_wait_for_keyframe_ : max_wait_for_frame_;
   }
@@ -450,6 +477,26 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
     }
   }
 
+  // Returns true if the next decodable temporal unit can't be decoded in time
+  // for its render time, given the decode time measured by `timing_`, and no
+  // other frame needs it as a reference. Decoding it would only delay the
+  // frames after it.
+  bool IsLateDiscardableTemporalUnit(uint32_t rtp_timestamp)
+      RTC_RUN_ON(&worker_sequence_checker_) {
+    if (!skip_late_discardable_frames_ ||
+        !buffer_->IsNextDecodableTemporalUnitDiscardable()) {
+      return false;
+    }
+    const Timestamp now = clock_->CurrentTime();
+    const Timestamp render_time = timing_->RenderTime(rtp_timestamp, now);
+    // Frames with zero render time are rendered as soon as they are decoded.
+    if (render_time.IsZero())
+      return false;
+    return timing_->MaxWaitingTime(render_time, now,
+                                   /*too_many_frames_queued=*/false) <
+           TimeDelta::Zero();
+  }
+
   void MaybeScheduleFrameForRelease() RTC_RUN_ON(&worker_sequence_checker_) {
     if (!decoder_ready_for_new_frame_ ||
         !buffer_->NextDecodableTemporalUnitRtpTimestamp())
@@ -459,6 +506,12 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
       return ForceKeyFrameReleaseImmediately();
     }
 
+    if (IsZeroPlayoutDelay()) {
+      frame_decode_scheduler_->CancelOutstanding();
+      return OnFrameReady(buffer_->ExtractNextDecodableTemporalUnit(),
+                          Timestamp::Zero());
+    }
+
     // TODO(https://bugs.webrtc.org/13343): Make [next,last] decodable returned
     // as an optional pair and remove this check.
     RTC_CHECK(buffer_->LastDecodableTemporalUnitRtpTimestamp());
@@ -472,6 +525,13 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
     absl::optional<FrameDecodeTiming::FrameSchedule> schedule;
     while (buffer_->NextDecodableTemporalUnitRtpTimestamp()) {
       auto next_rtp = *buffer_->NextDecodableTemporalUnitRtpTimestamp();
+      if (IsLateDiscardableTemporalUnit(next_rtp)) {
+        const int dropped_frames = buffer_->GetTotalNumberOfDroppedFrames();
+        buffer_->DropNextDecodableTemporalUnit();
+        stats_proxy_->OnLateFramesSkipped(
+            buffer_->GetTotalNumberOfDroppedFrames() - dropped_frames);
+        continue;
+      }
       schedule = decode_timing_.OnFrameBufferUpdated(next_rtp, last_rtp,
                                                      IsTooManyFramesQueued());
       if (schedule) {
@@ -497,6 +557,8 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
   Clock* const clock_;
   TaskQueueBase* const worker_queue_;
   rtc::TaskQueue* const decode_queue_;
+  // If set, `decode_queue_` is a sequence of this pool.
+  DecodeThreadPool* const decode_pool_;
   VCMReceiveStatisticsCallback* const stats_proxy_;
   FrameSchedulingReceiver* const receiver_;
   VCMTiming* const timing_;
@@ -532,6 +594,17 @@ class FrameBuffer3Proxy : public FrameBufferProxy {
   // the frame's render time == 0.
   FieldTrialParameter<unsigned> zero_playout_delay_max_decode_queue_size_;
 
+  // Skips decoding of discardable frames that would be rendered late, see
+  // IsLateDiscardableTemporalUnit().
+  const bool skip_late_discardable_frames_ =
+      field_trial::IsEnabled("WebRTC-SkipLateDiscardableFrames");
+
+  // Set by the field trial WebRTC-LowLatencyReceive. While the playout delay
+  // is zero, frames are passed to the decoder as soon as they are decodable,
+  // without the frame decode scheduler and without jitter estimation.
+  const bool low_latency_receive_ =
+      field_trial::IsEnabled(kLowLatencyReceiveFieldTrial);
+
   rtc::scoped_refptr<PendingTaskSafetyFlag> decode_safety_ =
       PendingTaskSafetyFlag::CreateDetached();
   ScopedTaskSafety worker_safety_;
@@ -554,6 +627,11 @@ FrameBufferArm ParseFrameBufferFieldTrial() {
           {"SyncDecoding", FrameBufferArm::kSyncDecode},
       });
   ParseFieldTrial({&arm}, field_trial::FindFullName(kFrameBufferFieldTrial));
+  // FrameBuffer2 can't pass frames to the decoder outside of its scheduling.
+  if (arm.Get() == FrameBufferArm::kFrameBuffer2 &&
+      field_trial::IsEnabled(kLowLatencyReceiveFieldTrial)) {
+    return FrameBufferArm::kFrameBuffer3;
+  }
   return arm.Get();
 }
 
@@ -568,14 +646,16 @@ std::unique_ptr<FrameBufferProxy> FrameBufferProxy::CreateFromFieldTrial(
     FrameSchedulingReceiver* receiver,
     TimeDelta max_wait_for_keyframe,
     TimeDelta max_wait_for_frame,
-    DecodeSynchronizer* decode_sync) {
+    DecodeSynchronizer* decode_sync,
+    DecodeThreadPool* decode_pool) {
   switch (ParseFrameBufferFieldTrial()) {
     case FrameBufferArm::kFrameBuffer3: {
       auto scheduler =
           std::make_unique<TaskQueueFrameDecodeScheduler>(clock, worker_queue);
       return std::make_unique<FrameBuffer3Proxy>(
           clock, worker_queue, timing, stats_proxy, decode_queue, receiver,
-          max_wait_for_keyframe, max_wait_for_frame, std::move(scheduler));
+          max_wait_for_keyframe, max_wait_for_frame, std::move(scheduler),
+          decode_pool);
     }
     case FrameBufferArm::kSyncDecode: {
       std::unique_ptr<FrameDecodeScheduler> scheduler;
@@ -591,7 +671,8 @@ std::unique_ptr<FrameBufferProxy> FrameBufferProxy::CreateFromFieldTrial(
       }
       return std::make_unique<FrameBuffer3Proxy>(
           clock, worker_queue, timing, stats_proxy, decode_queue, receiver,
-          max_wait_for_keyframe, max_wait_for_frame, std::move(scheduler));
+          max_wait_for_keyframe, max_wait_for_frame, std::move(scheduler),
+          decode_pool);
     }
     case FrameBufferArm::kFrameBuffer2:
       ABSL_FALLTHROUGH_INTENDED;
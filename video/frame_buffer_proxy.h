@@ -21,6 +21,7 @@
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
 #include "video/decode_synchronizer.h"
+#include "video/decode_thread_pool.h"
 
 namespace webrtc {
 
@@ -47,7 +48,8 @@ class FrameBufferProxy {
       FrameSchedulingReceiver* receiver,
       TimeDelta max_wait_for_keyframe,
       TimeDelta max_wait_for_frame,
-      DecodeSynchronizer* decode_sync);
+      DecodeSynchronizer* decode_sync,
+      DecodeThreadPool* decode_pool);
   virtual ~FrameBufferProxy() = default;
 
   // Run on the worker thread.
@@ -184,6 +184,7 @@ class VCMReceiveStatisticsCallbackMock : public VCMReceiveStatisticsCallback {
                VideoContentType content_type),
               (override));
   MOCK_METHOD(void, OnDroppedFrames, (uint32_t num_dropped), (override));
+  MOCK_METHOD(void, OnLateFramesSkipped, (uint32_t num_skipped), (override));
   MOCK_METHOD(void,
               OnFrameBufferTimingsUpdated,
               (int max_decode_ms,
@@ -231,7 +232,8 @@ class FrameBufferProxyFixture
                                                       this,
                                                       kMaxWaitForKeyframe,
                                                       kMaxWaitForFrame,
-                                                      &decode_sync_)) {
+                                                      &decode_sync_,
+                                                      nullptr)) {
     // Avoid starting with negative render times.
     timing_.set_min_playout_delay(TimeDelta::Millis(10));
 
@@ -767,6 +769,51 @@ INSTANTIATE_TEST_SUITE_P(
                       "WebRTC-FrameBuffer3/arm:FrameBuffer3/",
                       "WebRTC-FrameBuffer3/arm:SyncDecoding/"));
 
+class SkipLateFramesFrameBufferProxyTest : public ::testing::Test,
+                                           public FrameBufferProxyFixture {};
+
+TEST_P(SkipLateFramesFrameBufferProxyTest, LateDiscardableFrameIsSkipped) {
+  StartNextDecodeForceKeyframe();
+  proxy_->InsertFrame(Builder().Id(0).Time(0).AsLast().Build());
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(0)));
+
+  // F3 doesn't reference F1, and isn't decodable since F2 is missing.
+  proxy_->InsertFrame(
+      Builder().Id(1).Time(kFps30Rtp).Refs({0}).AsLast().Build());
+  proxy_->InsertFrame(
+      Builder().Id(3).Time(3 * kFps30Rtp).Refs({2}).AsLast().Build());
+
+  // Decoding F0 took so long that F1 can't be rendered in time anymore.
+  time_controller_.AdvanceTime(kFps30Delay * 4);
+  EXPECT_CALL(stats_callback_, OnLateFramesSkipped(1));
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(kMaxWaitForFrame), TimedOut());
+}
+
+TEST_P(SkipLateFramesFrameBufferProxyTest, LateReferenceFrameIsDecoded) {
+  StartNextDecodeForceKeyframe();
+  proxy_->InsertFrame(Builder().Id(0).Time(0).AsLast().Build());
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(0)));
+
+  proxy_->InsertFrame(
+      Builder().Id(1).Time(kFps30Rtp).Refs({0}).AsLast().Build());
+  proxy_->InsertFrame(
+      Builder().Id(3).Time(3 * kFps30Rtp).Refs({1, 2}).AsLast().Build());
+
+  time_controller_.AdvanceTime(kFps30Delay * 4);
+  EXPECT_CALL(stats_callback_, OnLateFramesSkipped).Times(0);
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(1)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FrameBufferProxy,
+    SkipLateFramesFrameBufferProxyTest,
+    ::testing::Values("WebRTC-FrameBuffer3/arm:FrameBuffer3/"
+                      "WebRTC-SkipLateDiscardableFrames/Enabled/",
+                      "WebRTC-FrameBuffer3/arm:SyncDecoding/"
+                      "WebRTC-SkipLateDiscardableFrames/Enabled/"));
+
 class LowLatencyFrameBufferProxyTest : public ::testing::Test,
                                        public FrameBufferProxyFixture {};
 
@@ -851,4 +898,82 @@ INSTANTIATE_TEST_SUITE_P(
         "WebRTC-FrameBuffer3/arm:SyncDecoding/"
         "WebRTC-ZeroPlayoutDelay/min_pacing:16ms,max_decode_queue_size:5/"));
 
+class LowLatencyReceiveFrameBufferProxyTest : public ::testing::Test,
+                                              public FrameBufferProxyFixture {
+ protected:
+  LowLatencyReceiveFrameBufferProxyTest() {
+    timing_.set_min_playout_delay(TimeDelta::Zero());
+    timing_.set_max_playout_delay(TimeDelta::Zero());
+  }
+
+  void InsertFrame(int64_t id, std::vector<int64_t> refs) {
+    proxy_->InsertFrame(Builder()
+                            .Id(id)
+                            .Time(kFps30Rtp * id)
+                            .Refs(refs)
+                            .PlayoutDelay({0, 0})
+                            .ReceivedTime(clock_->CurrentTime())
+                            .AsLast()
+                            .Build());
+  }
+};
+
+TEST_P(LowLatencyReceiveFrameBufferProxyTest, FramesAreReleasedOnInsertion) {
+  StartNextDecodeForceKeyframe();
+  InsertFrame(0, {});
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(0)));
+
+  // Released without waiting for a scheduler, or a metronome tick.
+  StartNextDecode();
+  InsertFrame(1, {0});
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(1)));
+}
+
+TEST_P(LowLatencyReceiveFrameBufferProxyTest, FramesWaitForDecoder) {
+  StartNextDecodeForceKeyframe();
+  InsertFrame(0, {});
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(0)));
+
+  InsertFrame(1, {0});
+  InsertFrame(2, {1});
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(1)));
+  StartNextDecode();
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(2)));
+}
+
+TEST_P(LowLatencyReceiveFrameBufferProxyTest, JitterIsNotEstimated) {
+  StartNextDecodeForceKeyframe();
+  InsertFrame(0, {});
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(0)));
+  for (int64_t id = 1; id < 10; ++id) {
+    // Frames arrive with up to a frame interval of jitter.
+    time_controller_.AdvanceTime(id % 2 == 0 ? kFps30Delay * 2
+                                             : TimeDelta::Millis(1));
+    StartNextDecode();
+    InsertFrame(id, {id - 1});
+    EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(WithId(id)));
+  }
+
+  TimeDelta max_decode = TimeDelta::Zero();
+  TimeDelta current_delay = TimeDelta::Zero();
+  TimeDelta target_delay = TimeDelta::Zero();
+  TimeDelta jitter_buffer = TimeDelta::Zero();
+  TimeDelta min_playout_delay = TimeDelta::Zero();
+  TimeDelta render_delay = TimeDelta::Zero();
+  timing_.GetTimings(&max_decode, &current_delay, &target_delay,
+                     &jitter_buffer, &min_playout_delay, &render_delay);
+  EXPECT_EQ(jitter_buffer, TimeDelta::Zero());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FrameBufferProxy,
+    LowLatencyReceiveFrameBufferProxyTest,
+    ::testing::Values("WebRTC-FrameBuffer3/arm:FrameBuffer2/"
+                      "WebRTC-LowLatencyReceive/Enabled/",
+                      "WebRTC-FrameBuffer3/arm:FrameBuffer3/"
+                      "WebRTC-LowLatencyReceive/Enabled/",
+                      "WebRTC-FrameBuffer3/arm:SyncDecoding/"
+                      "WebRTC-LowLatencyReceive/Enabled/"));
+
 }  // namespace webrtc
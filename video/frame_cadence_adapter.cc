@@ -99,7 +99,8 @@ class ZeroHertzAdapterMode : public AdapterMode {
   ZeroHertzAdapterMode(TaskQueueBase* queue,
                        Clock* clock,
                        FrameCadenceAdapterInterface::Callback* callback,
-                       double max_fps);
+                       double max_fps,
+                       bool content_aware);
 
   // Reconfigures according to parameters.
   // All spatial layer trackers are initialized as unconverged by this method.
@@ -181,6 +182,9 @@ class ZeroHertzAdapterMode : public AdapterMode {
   // Returns the repeat duration depending on if it's an idle repeat or not.
   TimeDelta RepeatDuration(bool idle_repeat) const
       RTC_RUN_ON(sequence_checker_);
+  // Returns true if `frame` is known to have the same content as the last
+  // frame that entered.
+  bool IsUnchanged(const VideoFrame& frame) const RTC_RUN_ON(sequence_checker_);
 
   TaskQueueBase* const queue_;
   Clock* const clock_;
@@ -190,6 +194,9 @@ class ZeroHertzAdapterMode : public AdapterMode {
   const double max_fps_;
   // How much the incoming frame sequence is delayed by.
   const TimeDelta frame_delay_ = TimeDelta::Seconds(1) / max_fps_;
+  // If true, incoming frames with an empty update rect are absorbed by the
+  // ongoing cadence instead of being sent and restarting it.
+  const bool content_aware_;
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
   // A queue of incoming frames and repeated frames.
@@ -255,6 +262,10 @@ class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
   // 0 Hz.
   const bool zero_hertz_screenshare_enabled_;
 
+  // True if zero-hertz mode absorbs incoming frames whose update rect says
+  // that nothing changed.
+  const bool zero_hertz_content_aware_;
+
   // The two possible modes we're under.
   absl::optional<PassthroughAdapterMode> passthrough_adapter_;
   absl::optional<ZeroHertzAdapterMode> zero_hertz_adapter_;
@@ -289,8 +300,13 @@ ZeroHertzAdapterMode::ZeroHertzAdapterMode(
     TaskQueueBase* queue,
     Clock* clock,
     FrameCadenceAdapterInterface::Callback* callback,
-    double max_fps)
-    : queue_(queue), clock_(clock), callback_(callback), max_fps_(max_fps) {
+    double max_fps,
+    bool content_aware)
+    : queue_(queue),
+      clock_(clock),
+      callback_(callback),
+      max_fps_(max_fps),
+      content_aware_(content_aware) {
   sequence_checker_.Detach();
 }
 
@@ -344,6 +360,15 @@ void ZeroHertzAdapterMode::OnFrame(Timestamp post_time,
   RTC_DLOG(LS_VERBOSE) << "ZeroHertzAdapterMode::" << __func__ << " this "
                        << this;
 
+  // A frame that changes nothing would only be encoded into an empty frame and
+  // restart refining the quality of the previous frame. Keep the current
+  // cadence going instead, which already sends that frame as long as needed.
+  if (content_aware_ && IsUnchanged(frame)) {
+    RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this
+                         << " absorbing unchanged frame";
+    return;
+  }
+
   // Assume all enabled layers are unconverged after frame entry.
   ResetQualityConvergenceInfo();
 
@@ -542,12 +567,26 @@ TimeDelta ZeroHertzAdapterMode::RepeatDuration(bool idle_repeat) const {
              : frame_delay_;
 }
 
+// RTC_RUN_ON(&sequence_checker_)
+bool ZeroHertzAdapterMode::IsUnchanged(const VideoFrame& frame) const {
+  // Frames without an update rect are assumed to be entirely updated.
+  if (queued_frames_.empty() || !frame.has_update_rect() ||
+      !frame.update_rect().IsEmpty()) {
+    return false;
+  }
+  const VideoFrame& last_frame = queued_frames_.back();
+  return frame.width() == last_frame.width() &&
+         frame.height() == last_frame.height();
+}
+
 FrameCadenceAdapterImpl::FrameCadenceAdapterImpl(Clock* clock,
                                                  TaskQueueBase* queue)
     : clock_(clock),
       queue_(queue),
       zero_hertz_screenshare_enabled_(
-          !field_trial::IsDisabled("WebRTC-ZeroHertzScreenshare")) {}
+          !field_trial::IsDisabled("WebRTC-ZeroHertzScreenshare")),
+      zero_hertz_content_aware_(
+          field_trial::IsEnabled("WebRTC-ZeroHertzContentAwareCadence")) {}
 
 FrameCadenceAdapterImpl::~FrameCadenceAdapterImpl() {
   RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this;
@@ -662,7 +701,8 @@ void FrameCadenceAdapterImpl::MaybeReconfigureAdapters(
   if (is_zero_hertz_enabled) {
     if (!was_zero_hertz_enabled) {
       zero_hertz_adapter_.emplace(queue_, clock_, callback_,
-                                  source_constraints_->max_fps.value());
+                                  source_constraints_->max_fps.value(),
+                                  zero_hertz_content_aware_);
       RTC_LOG(LS_INFO) << "Zero hertz mode activated.";
 
       if (should_request_refresh_frame_) {
@@ -357,6 +357,95 @@ TEST(FrameCadenceAdapterTest, StopsRepeatingFramesDelayed) {
   time_controller.AdvanceTime(TimeDelta::Seconds(1));
 }
 
+VideoFrame CreateUnchangedFrame() {
+  VideoFrame frame = CreateFrame();
+  VideoFrame::UpdateRect empty_update_rect;
+  empty_update_rect.MakeEmptyUpdate();
+  frame.set_update_rect(empty_update_rect);
+  return frame;
+}
+
+TEST(FrameCadenceAdapterTest, ForwardsUnchangedFramesByDefault) {
+  ZeroHertzFieldTrialEnabler enabler;
+  MockCallback callback;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(0));
+  auto adapter = CreateAdapter(time_controller.GetClock());
+  adapter->Initialize(&callback);
+  adapter->SetZeroHertzModeEnabled(
+      FrameCadenceAdapterInterface::ZeroHertzModeParams{});
+  adapter->OnConstraintsChanged(VideoTrackSourceConstraints{0, 1});
+
+  adapter->OnFrame(CreateFrame());
+  time_controller.AdvanceTime(TimeDelta::Millis(500));
+  adapter->OnFrame(CreateUnchangedFrame());
+  // The unchanged frame cancels the repeat due at 1s and is sent at 1.5s.
+  EXPECT_CALL(callback, OnFrame).Times(1);
+  time_controller.AdvanceTime(TimeDelta::Millis(600));
+  Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_CALL(callback, OnFrame)
+      .WillOnce(Invoke([](Timestamp, int, const VideoFrame& frame) {
+        EXPECT_TRUE(frame.update_rect().IsEmpty());
+      }));
+  time_controller.AdvanceTime(TimeDelta::Millis(400));
+}
+
+TEST(FrameCadenceAdapterTest, AbsorbsUnchangedFramesWhenContentAware) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-ZeroHertzScreenshare/Enabled/"
+      "WebRTC-ZeroHertzContentAwareCadence/Enabled/");
+  MockCallback callback;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(0));
+  auto adapter = CreateAdapter(time_controller.GetClock());
+  adapter->Initialize(&callback);
+  adapter->SetZeroHertzModeEnabled(
+      FrameCadenceAdapterInterface::ZeroHertzModeParams{});
+  adapter->OnConstraintsChanged(VideoTrackSourceConstraints{0, 1});
+
+  adapter->OnFrame(CreateFrame());
+  time_controller.AdvanceTime(TimeDelta::Millis(500));
+  // Unchanged frames don't restart the cadence, so the frame sent at 1s is
+  // repeated at 2s as if they never arrived.
+  adapter->OnFrame(CreateUnchangedFrame());
+  EXPECT_CALL(callback, OnFrame).Times(1);
+  time_controller.AdvanceTime(TimeDelta::Millis(600));
+  Mock::VerifyAndClearExpectations(&callback);
+  adapter->OnFrame(CreateUnchangedFrame());
+  EXPECT_CALL(callback, OnFrame)
+      .WillOnce(Invoke([](Timestamp, int, const VideoFrame& frame) {
+        EXPECT_TRUE(frame.update_rect().IsEmpty());
+      }));
+  time_controller.AdvanceTime(TimeDelta::Millis(900));
+  Mock::VerifyAndClearExpectations(&callback);
+
+  // Frames with changes still restart the cadence, keeping their update rect.
+  VideoFrame changed_frame = CreateFrame();
+  changed_frame.set_update_rect(VideoFrame::UpdateRect{2, 2, 4, 4});
+  adapter->OnFrame(changed_frame);
+  EXPECT_CALL(callback, OnFrame)
+      .WillOnce(Invoke([](Timestamp, int, const VideoFrame& frame) {
+        EXPECT_EQ(frame.update_rect(), (VideoFrame::UpdateRect{2, 2, 4, 4}));
+      }));
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+}
+
+TEST(FrameCadenceAdapterTest, ForwardsFirstUnchangedFrameWhenContentAware) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-ZeroHertzScreenshare/Enabled/"
+      "WebRTC-ZeroHertzContentAwareCadence/Enabled/");
+  MockCallback callback;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(0));
+  auto adapter = CreateAdapter(time_controller.GetClock());
+  adapter->Initialize(&callback);
+  adapter->SetZeroHertzModeEnabled(
+      FrameCadenceAdapterInterface::ZeroHertzModeParams{});
+  adapter->OnConstraintsChanged(VideoTrackSourceConstraints{0, 1});
+
+  // Without an earlier frame there's nothing to repeat.
+  adapter->OnFrame(CreateUnchangedFrame());
+  EXPECT_CALL(callback, OnFrame).Times(1);
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+}
+
 TEST(FrameCadenceAdapterTest, RequestsRefreshFrameOnKeyFrameRequestWhenNew) {
   ZeroHertzFieldTrialEnabler enabler;
   MockCallback callback;
@@ -883,6 +883,11 @@ void ReceiveStatisticsProxy::OnDroppedFrames(uint32_t frames_dropped) {
   stats_.frames_dropped += frames_dropped;
 }
 
+void ReceiveStatisticsProxy::OnLateFramesSkipped(uint32_t frames_skipped) {
+  MutexLock lock(&mutex_);
+  stats_.frames_skipped_late += frames_skipped;
+}
+
 void ReceiveStatisticsProxy::OnPreDecode(VideoCodecType codec_type, int qp) {
   RTC_DCHECK_RUN_ON(&decode_thread_);
   MutexLock lock(&mutex_);
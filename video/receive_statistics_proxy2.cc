@@ -691,6 +691,8 @@ VideoReceiveStream::Stats ReceiveStatisticsProxy::GetStats() const {
       video_quality_observer_->SumSquaredFrameDurationsSec();
   stats_.content_type = last_content_type_;
   stats_.timing_frame_info = timing_frame_info_counter_.Max(now_ms);
+  stats_.timing_frame_stage_delays_ms =
+      timing_frame_stage_delays_.PercentilesMs();
   stats_.jitter_buffer_delay_seconds =
       static_cast<double>(current_delay_counter_.Sum(1).value_or(0)) /
       rtc::kNumMillisecsPerSec;
@@ -772,6 +774,7 @@ void ReceiveStatisticsProxy::OnTimingFrameInfoUpdated(
   if (info.flags != VideoSendTiming::kInvalid) {
     int64_t now_ms = clock_->TimeInMilliseconds();
     timing_frame_info_counter_.Add(info, now_ms);
+    timing_frame_stage_delays_.Add(info);
   }
 
   // Measure initial decoding latency between the first frame arriving and
@@ -1016,6 +1019,12 @@ void ReceiveStatisticsProxy::OnDroppedFrames(uint32_t frames_dropped) {
   }));
 }
 
+void ReceiveStatisticsProxy::OnLateFramesSkipped(uint32_t frames_skipped) {
+  // Only FrameBuffer3 skips frames, and it runs on the worker thread.
+  RTC_DCHECK_RUN_ON(&main_thread_);
+  stats_.frames_skipped_late += frames_skipped;
+}
+
 void ReceiveStatisticsProxy::OnPreDecode(VideoCodecType codec_type, int qp) {
   RTC_DCHECK_RUN_ON(&decode_queue_);
   worker_thread_->PostTask(ToQueuedTask(task_safety_, [codec_type, qp, this]() {
@@ -33,6 +33,7 @@
 #include "rtc_base/thread_annotations.h"
 #include "video/quality_threshold.h"
 #include "video/stats_counter.h"
+#include "video/timing_frame_stage_delays.h"
 #include "video/video_quality_observer2.h"
 
 namespace webrtc {
@@ -87,6 +88,7 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
                        size_t size_bytes,
                        VideoContentType content_type) override;
   void OnDroppedFrames(uint32_t frames_dropped) override;
+  void OnLateFramesSkipped(uint32_t frames_skipped) override;
   void OnFrameBufferTimingsUpdated(int max_decode_ms,
                                    int current_delay_ms,
                                    int target_delay_ms,
@@ -201,6 +203,9 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   // called from const GetStats().
   mutable rtc::MovingMaxCounter<TimingFrameInfo> timing_frame_info_counter_
       RTC_GUARDED_BY(main_thread_);
+  // Mutable because getting the percentiles is not const either.
+  mutable TimingFrameStageDelays timing_frame_stage_delays_
+      RTC_GUARDED_BY(main_thread_);
   absl::optional<int> num_unique_frames_ RTC_GUARDED_BY(main_thread_);
   absl::optional<int64_t> last_estimated_playout_ntp_timestamp_ms_
       RTC_GUARDED_BY(main_thread_);
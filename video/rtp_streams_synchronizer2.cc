@@ -10,6 +10,8 @@
 
 #include "video/rtp_streams_synchronizer2.h"
 
+#include <utility>
+
 #include "absl/types/optional.h"
 #include "call/syncable.h"
 #include "rtc_base/checks.h"
@@ -37,9 +39,12 @@ bool UpdateMeasurements(StreamSynchronization::Measurements* stream,
 
 }  // namespace
 
-RtpStreamsSynchronizer::RtpStreamsSynchronizer(TaskQueueBase* main_queue,
-                                               Syncable* syncable_video)
+RtpStreamsSynchronizer::RtpStreamsSynchronizer(
+    TaskQueueBase* main_queue,
+    MetronomeTaskScheduler* tick_scheduler,
+    Syncable* syncable_video)
     : task_queue_(main_queue),
+      tick_scheduler_(tick_scheduler),
       syncable_video_(syncable_video),
       last_stats_log_ms_(rtc::TimeMillis()) {
   RTC_DCHECK(syncable_video);
@@ -70,11 +75,17 @@ void RtpStreamsSynchronizer::ConfigureSync(Syncable* syncable_audio) {
   if (repeating_task_.Running())
     return;
 
-  repeating_task_ =
-      RepeatingTaskHandle::DelayedStart(task_queue_, kSyncInterval, [this]() {
-        UpdateDelay();
-        return kSyncInterval;
-      });
+  auto update = [this]() {
+    UpdateDelay();
+    return kSyncInterval;
+  };
+  if (tick_scheduler_) {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        tick_scheduler_, kSyncInterval, std::move(update));
+  } else {
+    repeating_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_, kSyncInterval, std::move(update));
+  }
 }
 
 void RtpStreamsSynchronizer::UpdateDelay() {
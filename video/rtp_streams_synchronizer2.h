@@ -16,6 +16,7 @@
 #include "api/sequence_checker.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/metronome_task_scheduler.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "video/stream_synchronization.h"
 
@@ -29,7 +30,11 @@ namespace internal {
 // a given audio receive stream and video receive stream.
 class RtpStreamsSynchronizer {
  public:
-  RtpStreamsSynchronizer(TaskQueueBase* main_queue, Syncable* syncable_video);
+  // If `tick_scheduler` is set, the delays are updated on its metronome ticks.
+  // It must run on `main_queue`.
+  RtpStreamsSynchronizer(TaskQueueBase* main_queue,
+                         MetronomeTaskScheduler* tick_scheduler,
+                         Syncable* syncable_video);
   ~RtpStreamsSynchronizer();
 
   void ConfigureSync(Syncable* syncable_audio);
@@ -49,6 +54,7 @@ class RtpStreamsSynchronizer {
   void UpdateDelay();
 
   TaskQueueBase* const task_queue_;
+  MetronomeTaskScheduler* const tick_scheduler_;
 
   // Used to check if we're running on the main thread/task queue.
   // The reason we currently don't use RTC_DCHECK_RUN_ON(task_queue_) is because
@@ -27,6 +27,9 @@
 #include "modules/rtp_rtcp/include/rtp_cvo.h"
 #include "modules/rtp_rtcp/include/ulpfec_receiver.h"
 #include "modules/rtp_rtcp/source/create_video_rtp_depacketizer.h"
+#include "modules/rtp_rtcp/source/key_frame_request_aggregator.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
+#include "modules/rtp_rtcp/source/rtcp_transceiver.h"
 #include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
@@ -42,6 +45,7 @@
 #include "modules/video_coding/nack_requester.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
@@ -81,6 +85,7 @@ std::unique_ptr<ModuleRtpRtcpImpl2> CreateRtpRtcpModule(
     RtcpRttStats* rtt_stats,
     RtcpPacketTypeCounterObserver* rtcp_packet_type_counter_observer,
     RtcpCnameCallback* rtcp_cname_callback,
+    MetronomeTaskScheduler* tick_scheduler,
     bool non_sender_rtt_measurement,
     uint32_t local_ssrc) {
   RtpRtcpInterface::Configuration configuration;
@@ -93,6 +98,7 @@ std::unique_ptr<ModuleRtpRtcpImpl2> CreateRtpRtcpModule(
   configuration.rtcp_packet_type_counter_observer =
       rtcp_packet_type_counter_observer;
   configuration.rtcp_cname_callback = rtcp_cname_callback;
+  configuration.tick_scheduler = tick_scheduler;
   configuration.local_media_ssrc = local_ssrc;
   configuration.non_sender_rtt_measurement = non_sender_rtt_measurement;
 
@@ -213,6 +219,7 @@ RtpVideoStreamReceiver2::RtpVideoStreamReceiver2(
     RtcpPacketTypeCounterObserver* rtcp_packet_type_counter_observer,
     RtcpCnameCallback* rtcp_cname_callback,
     NackPeriodicProcessor* nack_periodic_processor,
+    MetronomeTaskScheduler* tick_scheduler,
     NackSender* nack_sender,
     KeyFrameRequestSender* keyframe_request_sender,
     OnCompleteFrameCallback* complete_frame_callback,
@@ -238,6 +245,7 @@ RtpVideoStreamReceiver2::RtpVideoStreamReceiver2(
           rtt_stats,
           rtcp_packet_type_counter_observer,
           rtcp_cname_callback,
+          tick_scheduler,
           config_.rtp.rtcp_xr.receiver_reference_time_report,
           config_.rtp.local_ssrc)),
       complete_frame_callback_(complete_frame_callback),
@@ -259,7 +267,9 @@ RtpVideoStreamReceiver2::RtpVideoStreamReceiver2(
       absolute_capture_time_interpolator_(clock) {
   packet_sequence_checker_.Detach();
   constexpr bool remb_candidate = true;
-  if (packet_router_)
+  // With a shared RtcpTransceiver, the owner of the transceiver registers it
+  // with the packet router for sending REMB and transport feedback.
+  if (packet_router_ && !config_.rtp.rtcp_transceiver)
     packet_router_->AddReceiveRtpModule(rtp_rtcp_.get(), remb_candidate);
 
   RTC_DCHECK(config_.rtp.rtcp_mode != RtcpMode::kOff)
@@ -269,7 +279,14 @@ RtpVideoStreamReceiver2::RtpVideoStreamReceiver2(
   RTC_DCHECK(config_.rtp.local_ssrc != 0);
   RTC_DCHECK(config_.rtp.remote_ssrc != config_.rtp.local_ssrc);
 
-  rtp_rtcp_->SetRTCPStatus(config_.rtp.rtcp_mode);
+  if (config_.rtp.rtcp_transceiver) {
+    // The module still handles incoming RTCP, but the shared transceiver
+    // sends the reports and the feedback for this stream.
+    rtp_rtcp_->SetRTCPStatus(RtcpMode::kOff);
+    config_.rtp.rtcp_transceiver->AddReceiveStatistics(rtp_receive_statistics_);
+  } else {
+    rtp_rtcp_->SetRTCPStatus(config_.rtp.rtcp_mode);
+  }
   rtp_rtcp_->SetRemoteSSRC(config_.rtp.remote_ssrc);
 
   static const int kMaxPacketAgeToNack = 450;
@@ -316,8 +333,15 @@ RtpVideoStreamReceiver2::RtpVideoStreamReceiver2(
 }
 
 RtpVideoStreamReceiver2::~RtpVideoStreamReceiver2() {
-  if (packet_router_)
+  if (config_.rtp.rtcp_transceiver) {
+    // `rtp_receive_statistics_` may be destroyed as soon as this returns.
+    rtc::Event removed;
+    config_.rtp.rtcp_transceiver->RemoveReceiveStatistics(
+        rtp_receive_statistics_, [&removed] { removed.Set(); });
+    removed.Wait(rtc::Event::kForever);
+  } else if (packet_router_) {
     packet_router_->RemoveReceiveRtpModule(rtp_rtcp_.get());
+  }
   UpdateHistograms();
   if (frame_transformer_delegate_)
     frame_transformer_delegate_->Reset();
@@ -670,8 +694,21 @@ void RtpVideoStreamReceiver2::RequestKeyFrame() {
   // TODO(bugs.webrtc.org/10336): Allow the sender to ignore key frame requests
   // issued by anything other than the LossNotificationController if it (the
   // sender) is relying on LNTF alone.
+  if (config_.rtp.keyframe_request_aggregator &&
+      !config_.rtp.keyframe_request_aggregator->OnKeyFrameRequest(
+          config_.rtp.remote_ssrc)) {
+    return;
+  }
   if (keyframe_request_sender_) {
     keyframe_request_sender_->RequestKeyFrame();
+  } else if (config_.rtp.rtcp_transceiver) {
+    if (keyframe_request_method_ == KeyFrameReqMethod::kPliRtcp) {
+      config_.rtp.rtcp_transceiver->SendPictureLossIndication(
+          config_.rtp.remote_ssrc);
+    } else if (keyframe_request_method_ == KeyFrameReqMethod::kFirRtcp) {
+      config_.rtp.rtcp_transceiver->SendFullIntraRequest(
+          {config_.rtp.remote_ssrc}, /*new_request=*/true);
+    }
   } else if (keyframe_request_method_ == KeyFrameReqMethod::kPliRtcp) {
     rtp_rtcp_->SendPictureLossIndication();
   } else if (keyframe_request_method_ == KeyFrameReqMethod::kFirRtcp) {
@@ -685,6 +722,16 @@ void RtpVideoStreamReceiver2::SendLossNotification(
     bool decodability_flag,
     bool buffering_allowed) {
   RTC_DCHECK(config_.rtp.lntf.enabled);
+  if (config_.rtp.rtcp_transceiver) {
+    // Sent right away, since the transceiver doesn't buffer feedback.
+    auto loss_notification = std::make_unique<rtcp::LossNotification>(
+        last_decoded_seq_num, last_received_seq_num, decodability_flag);
+    loss_notification->SetMediaSsrc(config_.rtp.remote_ssrc);
+    std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets;
+    packets.push_back(std::move(loss_notification));
+    config_.rtp.rtcp_transceiver->SendCombinedRtcpPacket(std::move(packets));
+    return;
+  }
   rtp_rtcp_->SendLossNotification(last_decoded_seq_num, last_received_seq_num,
                                   decodability_flag, buffering_allowed);
 }
@@ -700,6 +747,11 @@ bool RtpVideoStreamReceiver2::IsRetransmissionsEnabled() const {
 void RtpVideoStreamReceiver2::RequestPacketRetransmit(
     const std::vector<uint16_t>& sequence_numbers) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  if (config_.rtp.rtcp_transceiver) {
+    config_.rtp.rtcp_transceiver->SendNack(config_.rtp.remote_ssrc,
+                                           sequence_numbers);
+    return;
+  }
   rtp_rtcp_->SendNack(sequence_numbers);
 }
 
@@ -777,6 +829,11 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
     }
   }
   RTC_DCHECK(frame_boundary);
+  if (!encrypted_frames_.empty()) {
+    buffered_frame_decryptor_->ManageEncryptedFrames(
+        std::move(encrypted_frames_));
+    encrypted_frames_.clear();
+  }
   if (result.buffer_cleared) {
     last_received_rtp_system_time_.reset();
     last_received_keyframe_rtp_system_time_.reset();
@@ -802,6 +859,12 @@ void RtpVideoStreamReceiver2::OnAssembledFrame(
         descriptor->dependencies);
   }
 
+  if (config_.rtp.keyframe_request_aggregator &&
+      frame->FrameType() == VideoFrameType::kVideoFrameKey) {
+    config_.rtp.keyframe_request_aggregator->OnKeyFrameReceived(
+        config_.rtp.remote_ssrc);
+  }
+
   // If frames arrive before a key frame, they would not be decodable.
   // In that case, request a key frame ASAP.
   if (!has_received_frame_) {
@@ -845,7 +908,9 @@ void RtpVideoStreamReceiver2::OnAssembledFrame(
   }
 
   if (buffered_frame_decryptor_ != nullptr) {
-    buffered_frame_decryptor_->ManageEncryptedFrame(std::move(frame));
+    // Decrypted together with the other frames completed by the same packet,
+    // at the end of OnInsertedPacket().
+    encrypted_frames_.push_back(std::move(frame));
   } else if (frame_transformer_delegate_) {
     frame_transformer_delegate_->TransformFrame(std::move(frame));
   } else {
@@ -1084,6 +1149,9 @@ void RtpVideoStreamReceiver2::FrameDecoded(int64_t picture_id) {
 
 void RtpVideoStreamReceiver2::SignalNetworkState(NetworkState state) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  // The owner of a shared RtcpTransceiver sets its network state.
+  if (config_.rtp.rtcp_transceiver)
+    return;
   rtp_rtcp_->SetRTCPStatus(state == kNetworkUp ? config_.rtp.rtcp_mode
                                                : RtcpMode::kOff);
 }
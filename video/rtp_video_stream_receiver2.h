@@ -52,6 +52,7 @@
 
 namespace webrtc {
 
+class MetronomeTaskScheduler;
 class NackRequester;
 class PacketRouter;
 class ReceiveStatistics;
@@ -90,6 +91,8 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
       RtcpPacketTypeCounterObserver* rtcp_packet_type_counter_observer,
       RtcpCnameCallback* rtcp_cname_callback,
       NackPeriodicProcessor* nack_periodic_processor,
+      // Optional; if provided, the RTCP timers run on its metronome ticks.
+      MetronomeTaskScheduler* tick_scheduler,
       NackSender* nack_sender,
       // The KeyFrameRequestSender is optional; if not provided, key frame
       // requests are sent via the internal RtpRtcp module.
@@ -379,6 +382,9 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   // rtp_reference_finder if they are decryptable.
   std::unique_ptr<BufferedFrameDecryptor> buffered_frame_decryptor_
       RTC_PT_GUARDED_BY(packet_sequence_checker_);
+  // Assembled frames waiting to be handed to `buffered_frame_decryptor_`.
+  std::vector<std::unique_ptr<RtpFrameObject>> encrypted_frames_
+      RTC_GUARDED_BY(packet_sequence_checker_);
   bool frames_decryptable_ RTC_GUARDED_BY(worker_task_checker_);
   absl::optional<ColorSpace> last_color_space_;
 
@@ -76,6 +76,7 @@ RtpVideoStreamReceiverFrameTransformerDelegate::
         uint32_t ssrc)
     : receiver_(receiver),
       frame_transformer_(std::move(frame_transformer)),
+      transformer_is_synchronous_(frame_transformer_->IsSynchronous()),
       network_thread_(network_thread),
       ssrc_(ssrc) {}
 
@@ -102,6 +103,10 @@ void RtpVideoStreamReceiverFrameTransformerDelegate::TransformFrame(
 
 void RtpVideoStreamReceiverFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
+  if (transformer_is_synchronous_ && network_thread_->IsCurrent()) {
+    ManageFrame(std::move(frame));
+    return;
+  }
   rtc::scoped_refptr<RtpVideoStreamReceiverFrameTransformerDelegate> delegate(
       this);
   network_thread_->PostTask(ToQueuedTask(
@@ -49,7 +49,8 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   void TransformFrame(std::unique_ptr<RtpFrameObject> frame);
 
   // Implements TransformedFrameCallback. Can be called on any thread. Posts
-  // the transformed frame to be managed on the `network_thread_`.
+  // the transformed frame to be managed on the `network_thread_`, or manages
+  // it right away if a synchronous transformer calls back on that thread.
   void OnTransformedFrame(
       std::unique_ptr<TransformableFrameInterface> frame) override;
 
@@ -65,6 +66,7 @@ class RtpVideoStreamReceiverFrameTransformerDelegate
   RtpVideoFrameReceiver* receiver_ RTC_GUARDED_BY(network_sequence_checker_);
   rtc::scoped_refptr<FrameTransformerInterface> frame_transformer_
       RTC_GUARDED_BY(network_sequence_checker_);
+  const bool transformer_is_synchronous_;
   rtc::Thread* const network_thread_;
   const uint32_t ssrc_;
 };
@@ -138,6 +138,7 @@ SendStatisticsProxy::SendStatisticsProxy(
       rtp_config_(config.rtp),
       fallback_max_pixels_(GetFallbackMaxPixelsIfFieldTrialEnabled()),
       fallback_max_pixels_disabled_(GetFallbackMaxPixelsIfFieldTrialDisabled()),
+      ssrc_bitrates_(CreateSsrcBitrates(config.rtp)),
       content_type_(content_type),
       start_ms_(clock->TimeInMilliseconds()),
       encode_time_(kEncodeTimeWeigthFactor),
@@ -155,6 +156,7 @@ SendStatisticsProxy::SendStatisticsProxy(
 
 SendStatisticsProxy::~SendStatisticsProxy() {
   MutexLock lock(&mutex_);
+  FoldAccumulatedStats();
   uma_container_->UpdateHistograms(rtp_config_, stats_);
 
   int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
@@ -674,6 +676,7 @@ void SendStatisticsProxy::OnEncoderReconfigured(
   MutexLock lock(&mutex_);
 
   if (content_type_ != config.content_type) {
+    FoldAccumulatedStats();
     uma_container_->UpdateHistograms(rtp_config_, stats_);
     uma_container_.reset(new UmaSamplesContainer(
         GetUmaPrefix(config.content_type), stats_, clock_));
@@ -735,6 +738,7 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
 
 VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   MutexLock lock(&mutex_);
+  FoldAccumulatedStats();
   PurgeOldStats();
   stats_.input_frame_rate =
       uma_container_->input_frame_rate_tracker_.ComputeRate();
@@ -759,6 +763,45 @@ VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   return stats_;
 }
 
+std::map<uint32_t, std::unique_ptr<SendStatisticsProxy::SsrcBitrates>>
+SendStatisticsProxy::CreateSsrcBitrates(const RtpConfig& rtp_config) {
+  std::map<uint32_t, std::unique_ptr<SsrcBitrates>> bitrates;
+  for (uint32_t ssrc : rtp_config.ssrcs)
+    bitrates[ssrc] = std::make_unique<SsrcBitrates>();
+  for (uint32_t ssrc : rtp_config.rtx.ssrcs)
+    bitrates[ssrc] = std::make_unique<SsrcBitrates>();
+  if (rtp_config.flexfec.payload_type != -1) {
+    bitrates[rtp_config.flexfec.ssrc] = std::make_unique<SsrcBitrates>();
+  }
+  return bitrates;
+}
+
+void SendStatisticsProxy::FoldAccumulatedStats() {
+  stats_.frames_dropped_by_capturer +=
+      dropped_frames_.by_capturer.exchange(0, std::memory_order_relaxed);
+  stats_.frames_dropped_by_encoder_queue +=
+      dropped_frames_.by_encoder_queue.exchange(0, std::memory_order_relaxed);
+  stats_.frames_dropped_by_encoder +=
+      dropped_frames_.by_encoder.exchange(0, std::memory_order_relaxed);
+  stats_.frames_dropped_by_rate_limiter +=
+      dropped_frames_.by_rate_limiter.exchange(0, std::memory_order_relaxed);
+  stats_.frames_dropped_by_congestion_window +=
+      dropped_frames_.by_congestion_window.exchange(0,
+                                                    std::memory_order_relaxed);
+
+  for (const auto& kv : ssrc_bitrates_) {
+    if (!kv.second->reported.load(std::memory_order_acquire))
+      continue;
+    VideoSendStream::StreamStats* stats = GetStatsEntry(kv.first);
+    if (!stats)
+      continue;
+    const uint64_t bitrates_bps =
+        kv.second->bitrates_bps.load(std::memory_order_relaxed);
+    stats->total_bitrate_bps = static_cast<uint32_t>(bitrates_bps >> 32);
+    stats->retransmit_bitrate_bps = static_cast<uint32_t>(bitrates_bps);
+  }
+}
+
 void SendStatisticsProxy::PurgeOldStats() {
   int64_t old_stats_ms = clock_->TimeInMilliseconds() - kStatsTimeoutMs;
   for (std::map<uint32_t, VideoSendStream::StreamStats>::iterator it =
@@ -819,6 +862,9 @@ void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
   if (!stats)
     return;
 
+  auto it = ssrc_bitrates_.find(ssrc);
+  if (it != ssrc_bitrates_.end())
+    it->second->bitrates_bps.store(0, std::memory_order_relaxed);
   stats->total_bitrate_bps = 0;
   stats->retransmit_bitrate_bps = 0;
   stats->height = 0;
@@ -989,6 +1035,14 @@ void SendStatisticsProxy::OnSendEncodedImage(
     stats->height = encoded_image._encodedHeight;
     update_times_[ssrc].resolution_update_ms = clock_->TimeInMilliseconds();
   }
+  // Like the resolution, the speed is that of the top spatial layer.
+  if (encoded_image.EncoderSpeed() && is_top_spatial_layer) {
+    if (stats->encoder_speed &&
+        *stats->encoder_speed != *encoded_image.EncoderSpeed()) {
+      ++stats->encoder_speed_changes;
+    }
+    stats->encoder_speed = encoded_image.EncoderSpeed();
+  }
 
   uma_container_->key_frame_counter_.Add(encoded_image._frameType ==
                                          VideoFrameType::kVideoFrameKey);
@@ -1084,22 +1138,22 @@ void SendStatisticsProxy::OnIncomingFrame(int width, int height) {
 }
 
 void SendStatisticsProxy::OnFrameDropped(DropReason reason) {
-  MutexLock lock(&mutex_);
   switch (reason) {
     case DropReason::kSource:
-      ++stats_.frames_dropped_by_capturer;
+      dropped_frames_.by_capturer.fetch_add(1, std::memory_order_relaxed);
       break;
     case DropReason::kEncoderQueue:
-      ++stats_.frames_dropped_by_encoder_queue;
+      dropped_frames_.by_encoder_queue.fetch_add(1, std::memory_order_relaxed);
       break;
     case DropReason::kEncoder:
-      ++stats_.frames_dropped_by_encoder;
+      dropped_frames_.by_encoder.fetch_add(1, std::memory_order_relaxed);
       break;
     case DropReason::kMediaOptimization:
-      ++stats_.frames_dropped_by_rate_limiter;
+      dropped_frames_.by_rate_limiter.fetch_add(1, std::memory_order_relaxed);
       break;
     case DropReason::kCongestionWindow:
-      ++stats_.frames_dropped_by_congestion_window;
+      dropped_frames_.by_congestion_window.fetch_add(1,
+                                                     std::memory_order_relaxed);
       break;
   }
 }
@@ -1359,13 +1413,14 @@ void SendStatisticsProxy::DataCountersUpdated(
 void SendStatisticsProxy::Notify(uint32_t total_bitrate_bps,
                                  uint32_t retransmit_bitrate_bps,
                                  uint32_t ssrc) {
-  MutexLock lock(&mutex_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
+  // Called per sent packet, so only the latest values are stored here.
+  auto it = ssrc_bitrates_.find(ssrc);
+  if (it == ssrc_bitrates_.end())
     return;
-
-  stats->total_bitrate_bps = total_bitrate_bps;
-  stats->retransmit_bitrate_bps = retransmit_bitrate_bps;
+  it->second->bitrates_bps.store(
+      (static_cast<uint64_t>(total_bitrate_bps) << 32) | retransmit_bitrate_bps,
+      std::memory_order_relaxed);
+  it->second->reported.store(true, std::memory_order_release);
 }
 
 void SendStatisticsProxy::FrameCountUpdated(const FrameCounts& frame_counts,
@@ -12,6 +12,7 @@
 #define VIDEO_SEND_STATISTICS_PROXY_H_
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -219,6 +220,26 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   };
   typedef std::map<uint32_t, Frame, TimestampOlderThan> EncodedFrameMap;
 
+  // Counters that are updated per frame or per packet without taking
+  // `mutex_`, so that the encoder and network threads don't contend with
+  // GetStats(). They are folded into `stats_` by FoldAccumulatedStats().
+  struct DroppedFrameCounters {
+    std::atomic<uint32_t> by_capturer{0};
+    std::atomic<uint32_t> by_encoder_queue{0};
+    std::atomic<uint32_t> by_encoder{0};
+    std::atomic<uint32_t> by_rate_limiter{0};
+    std::atomic<uint32_t> by_congestion_window{0};
+  };
+  struct SsrcBitrates {
+    // Total bitrate in the upper and retransmit bitrate in the lower 32 bits,
+    // so that both are updated together.
+    std::atomic<uint64_t> bitrates_bps{0};
+    std::atomic<bool> reported{false};
+  };
+
+  static std::map<uint32_t, std::unique_ptr<SsrcBitrates>> CreateSsrcBitrates(
+      const RtpConfig& rtp_config);
+  void FoldAccumulatedStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void PurgeOldStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   VideoSendStream::StreamStats* GetStatsEntry(uint32_t ssrc)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
@@ -274,6 +295,9 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   const RtpConfig rtp_config_;
   const absl::optional<int> fallback_max_pixels_;
   const absl::optional<int> fallback_max_pixels_disabled_;
+  DroppedFrameCounters dropped_frames_;
+  // Keyed by the media, rtx and flexfec ssrcs of `rtp_config_`.
+  const std::map<uint32_t, std::unique_ptr<SsrcBitrates>> ssrc_bitrates_;
   mutable Mutex mutex_;
   VideoEncoderConfig::ContentType content_type_ RTC_GUARDED_BY(mutex_);
   const int64_t start_ms_;
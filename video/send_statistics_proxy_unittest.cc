@@ -402,6 +402,28 @@ TEST_F(SendStatisticsProxyTest, OnSendEncodedImageWithoutQpQpSumWontExist) {
             statistics_proxy_->GetStats().substreams[ssrc].qp_sum);
 }
 
+TEST_F(SendStatisticsProxyTest, OnSendEncodedImageCountsEncoderSpeedChanges) {
+  EncodedImage encoded_image;
+  CodecSpecificInfo codec_info;
+  auto ssrc = config_.rtp.ssrcs[0];
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  EXPECT_EQ(absl::nullopt,
+            statistics_proxy_->GetStats().substreams[ssrc].encoder_speed);
+
+  encoded_image.SetEncoderSpeed(7);
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  EXPECT_EQ(7, statistics_proxy_->GetStats().substreams[ssrc].encoder_speed);
+  EXPECT_EQ(
+      0u, statistics_proxy_->GetStats().substreams[ssrc].encoder_speed_changes);
+
+  encoded_image.SetEncoderSpeed(8);
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  EXPECT_EQ(8, statistics_proxy_->GetStats().substreams[ssrc].encoder_speed);
+  EXPECT_EQ(
+      1u, statistics_proxy_->GetStats().substreams[ssrc].encoder_speed_changes);
+}
+
 TEST_F(SendStatisticsProxyTest, TotalEncodedBytesTargetFirstFrame) {
   const uint32_t kTargetBytesPerSecond = 100000;
   statistics_proxy_->OnSetEncoderTargetRate(kTargetBytesPerSecond * 8);
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/timing_frame_stage_delays.h"
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+namespace {
+
+// Delays up to this many ms are counted in a flat array, longer delays in a
+// map.
+constexpr uint32_t kLongTailBoundaryMs = 500;
+
+struct Stage {
+  const char* name;
+  const char* trace_name;
+};
+
+constexpr Stage kStages[] = {
+    {"encodeQueue", "TimingFrameEncodeQueue"},
+    {"encode", "TimingFrameEncode"},
+    {"packetization", "TimingFramePacketization"},
+    {"pacer", "TimingFramePacer"},
+    {"network", "TimingFrameNetwork"},
+    {"assembly", "TimingFrameAssembly"},
+    {"jitterBuffer", "TimingFrameJitterBuffer"},
+    {"decode", "TimingFrameDecode"},
+    {"render", "TimingFrameRender"},
+};
+constexpr size_t kNumStages = sizeof(kStages) / sizeof(kStages[0]);
+
+constexpr struct {
+  const char* suffix;
+  float fraction;
+} kPercentiles[] = {{".p50", 0.50f}, {".p95", 0.95f}, {".p99", 0.99f}};
+
+// Returns `to_ms - from_ms`, or nullopt if either timestamp is missing or the
+// stage appears to have taken negative time.
+absl::optional<int64_t> StageDelayMs(int64_t from_ms, int64_t to_ms) {
+  if (from_ms == -1 || to_ms == -1 || to_ms < from_ms)
+    return absl::nullopt;
+  return to_ms - from_ms;
+}
+
+}  // namespace
+
+TimingFrameStageDelays::TimingFrameStageDelays()
+    : histograms_(kNumStages,
+                  rtc::HistogramPercentileCounter(kLongTailBoundaryMs)) {}
+
+TimingFrameStageDelays::~TimingFrameStageDelays() = default;
+
+void TimingFrameStageDelays::Add(const TimingFrameInfo& info) {
+  if (info.IsInvalid())
+    return;
+  // Sender timestamps are only comparable to receiver timestamps once the
+  // sender clock offset is estimated, see TimingFrameInfo.
+  const bool clocks_synchronized = info.capture_time_ms >= 0;
+  const absl::optional<int64_t> delays_ms[] = {
+      StageDelayMs(info.capture_time_ms, info.encode_start_ms),
+      StageDelayMs(info.encode_start_ms, info.encode_finish_ms),
+      StageDelayMs(info.encode_finish_ms, info.packetization_finish_ms),
+      StageDelayMs(info.packetization_finish_ms, info.pacer_exit_ms),
+      clocks_synchronized
+          ? StageDelayMs(info.pacer_exit_ms, info.receive_start_ms)
+          : absl::nullopt,
+      StageDelayMs(info.receive_start_ms, info.receive_finish_ms),
+      StageDelayMs(info.receive_finish_ms, info.decode_start_ms),
+      StageDelayMs(info.decode_start_ms, info.decode_finish_ms),
+      StageDelayMs(info.decode_finish_ms, info.render_time_ms),
+  };
+  static_assert(sizeof(delays_ms) / sizeof(delays_ms[0]) == kNumStages, "");
+  for (size_t i = 0; i < kNumStages; ++i) {
+    if (!delays_ms[i])
+      continue;
+    histograms_[i].Add(static_cast<uint32_t>(*delays_ms[i]));
+    TRACE_EVENT_INSTANT2("webrtc", kStages[i].trace_name, "rtp_timestamp",
+                         info.rtp_timestamp, "delay_ms", *delays_ms[i]);
+  }
+}
+
+std::map<std::string, double> TimingFrameStageDelays::PercentilesMs() {
+  std::map<std::string, double> percentiles_ms;
+  for (size_t i = 0; i < kNumStages; ++i) {
+    for (const auto& percentile : kPercentiles) {
+      absl::optional<uint32_t> value_ms =
+          histograms_[i].GetPercentile(percentile.fraction);
+      if (!value_ms)
+        break;
+      percentiles_ms[std::string(kStages[i].name) + percentile.suffix] =
+          *value_ms;
+    }
+  }
+  return percentiles_ms;
+}
+
+}  // namespace webrtc
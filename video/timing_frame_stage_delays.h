@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_TIMING_FRAME_STAGE_DELAYS_H_
+#define VIDEO_TIMING_FRAME_STAGE_DELAYS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "api/video/video_timing.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
+
+namespace webrtc {
+
+// Splits the lifetime of received timing frames into the stages of the media
+// pipeline and keeps a histogram of the delay of each stage. Timing frames are
+// sampled by the sender, periodically and for frames of unusual size, so the
+// histograms cost next to nothing for the frames in between.
+//
+// The stages are, in order:
+//   "encodeQueue"   capture to encode start, i.e. the encoder queue.
+//   "encode"        encode start to encode finish.
+//   "packetization" encode finish to the packets being handed to the pacer.
+//   "pacer"         pacer enqueue to the last packet leaving the pacer.
+//   "network"       pacer exit to the first packet being received. Only
+//                   measured once the sender clock offset is estimated.
+//   "assembly"      first to last packet of the frame, i.e. the time spent
+//                   in the packet buffer.
+//   "jitterBuffer"  last packet received to decode start, i.e. the time spent
+//                   in the frame buffer.
+//   "decode"        decode start to decode finish.
+//   "render"        decode finish to the scheduled render time.
+class TimingFrameStageDelays {
+ public:
+  TimingFrameStageDelays();
+  ~TimingFrameStageDelays();
+
+  // Adds the stage delays of `info`. Invalid timing frames are ignored.
+  void Add(const TimingFrameInfo& info);
+
+  // Returns the 50th, 95th and 99th percentile of the delay of each stage with
+  // at least one sample, keyed by "<stage>.p50", "<stage>.p95" and
+  // "<stage>.p99".
+  std::map<std::string, double> PercentilesMs();
+
+ private:
+  std::vector<rtc::HistogramPercentileCounter> histograms_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_TIMING_FRAME_STAGE_DELAYS_H_
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/timing_frame_stage_delays.h"
+
+#include <map>
+#include <string>
+
+#include "api/video/video_timing.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Contains;
+using ::testing::IsEmpty;
+using ::testing::Key;
+using ::testing::Not;
+using ::testing::Pair;
+
+// A timing frame captured at `capture_time_ms` that spends 1, 2, ..., 9 ms in
+// the stages from "encodeQueue" to "render".
+TimingFrameInfo CreateTimingFrame(int64_t capture_time_ms) {
+  TimingFrameInfo info;
+  info.flags = VideoSendTiming::kTriggeredByTimer;
+  info.capture_time_ms = capture_time_ms;
+  info.encode_start_ms = info.capture_time_ms + 1;
+  info.encode_finish_ms = info.encode_start_ms + 2;
+  info.packetization_finish_ms = info.encode_finish_ms + 3;
+  info.pacer_exit_ms = info.packetization_finish_ms + 4;
+  info.receive_start_ms = info.pacer_exit_ms + 5;
+  info.receive_finish_ms = info.receive_start_ms + 6;
+  info.decode_start_ms = info.receive_finish_ms + 7;
+  info.decode_finish_ms = info.decode_start_ms + 8;
+  info.render_time_ms = info.decode_finish_ms + 9;
+  return info;
+}
+
+TEST(TimingFrameStageDelaysTest, NoPercentilesWithoutTimingFrames) {
+  TimingFrameStageDelays stage_delays;
+  EXPECT_THAT(stage_delays.PercentilesMs(), IsEmpty());
+
+  TimingFrameInfo invalid = CreateTimingFrame(1000);
+  invalid.flags = VideoSendTiming::kInvalid;
+  stage_delays.Add(invalid);
+  EXPECT_THAT(stage_delays.PercentilesMs(), IsEmpty());
+}
+
+TEST(TimingFrameStageDelaysTest, SplitsTimingFrameIntoStages) {
+  TimingFrameStageDelays stage_delays;
+  stage_delays.Add(CreateTimingFrame(1000));
+
+  std::map<std::string, double> percentiles = stage_delays.PercentilesMs();
+  EXPECT_EQ(percentiles.size(), 9u * 3u);
+  EXPECT_THAT(percentiles, Contains(Pair("encodeQueue.p50", 1)));
+  EXPECT_THAT(percentiles, Contains(Pair("encode.p95", 2)));
+  EXPECT_THAT(percentiles, Contains(Pair("packetization.p99", 3)));
+  EXPECT_THAT(percentiles, Contains(Pair("pacer.p50", 4)));
+  EXPECT_THAT(percentiles, Contains(Pair("network.p50", 5)));
+  EXPECT_THAT(percentiles, Contains(Pair("assembly.p50", 6)));
+  EXPECT_THAT(percentiles, Contains(Pair("jitterBuffer.p50", 7)));
+  EXPECT_THAT(percentiles, Contains(Pair("decode.p50", 8)));
+  EXPECT_THAT(percentiles, Contains(Pair("render.p50", 9)));
+}
+
+TEST(TimingFrameStageDelaysTest, SkipsNetworkUntilClocksAreSynchronized) {
+  TimingFrameStageDelays stage_delays;
+  // Sender timestamps are negative until the sender clock offset is known.
+  stage_delays.Add(CreateTimingFrame(-1000));
+
+  std::map<std::string, double> percentiles = stage_delays.PercentilesMs();
+  EXPECT_THAT(percentiles, Not(Contains(Key("network.p50"))));
+  EXPECT_THAT(percentiles, Contains(Pair("encode.p50", 2)));
+  EXPECT_THAT(percentiles, Contains(Pair("decode.p50", 8)));
+}
+
+TEST(TimingFrameStageDelaysTest, ReportsPercentilesOfAllTimingFrames) {
+  TimingFrameStageDelays stage_delays;
+  for (int i = 0; i < 100; ++i) {
+    TimingFrameInfo info = CreateTimingFrame(1000 + i * 33);
+    // Decode takes 1 ms for 95 frames and 1000 ms for 5 frames.
+    info.decode_finish_ms = info.decode_start_ms + (i < 95 ? 1 : 1000);
+    info.render_time_ms = info.decode_finish_ms + 9;
+    stage_delays.Add(info);
+  }
+
+  std::map<std::string, double> percentiles = stage_delays.PercentilesMs();
+  EXPECT_THAT(percentiles, Contains(Pair("decode.p50", 1)));
+  EXPECT_THAT(percentiles, Contains(Pair("decode.p95", 1)));
+  EXPECT_THAT(percentiles, Contains(Pair("decode.p99", 1000)));
+}
+
+}  // namespace
+}  // namespace webrtc
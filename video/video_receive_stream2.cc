@@ -212,7 +212,9 @@ VideoReceiveStream2::VideoReceiveStream2(
     Clock* clock,
     VCMTiming* timing,
     NackPeriodicProcessor* nack_periodic_processor,
-    DecodeSynchronizer* decode_sync)
+    DecodeSynchronizer* decode_sync,
+    MetronomeTaskScheduler* tick_scheduler,
+    DecodeThreadPool* decode_pool)
     : task_queue_factory_(task_queue_factory),
       transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
@@ -235,12 +237,13 @@ VideoReceiveStream2::VideoReceiveStream2(
                                  &stats_proxy_,
                                  &stats_proxy_,
                                  nack_periodic_processor,
+                                 tick_scheduler,
                                  this,     // NackSender
                                  nullptr,  // Use default KeyFrameRequestSender
                                  this,     // OnCompleteFrameCallback
                                  std::move(config_.frame_decryptor),
                                  std::move(config_.frame_transformer)),
-      rtp_stream_sync_(call->worker_thread(), this),
+      rtp_stream_sync_(call->worker_thread(), tick_scheduler, this),
       max_wait_for_keyframe_ms_(DetermineMaxWaitForFrame(config_, true)),
       max_wait_for_frame_ms_(DetermineMaxWaitForFrame(config_, false)),
       low_latency_renderer_enabled_("enabled", true),
@@ -248,9 +251,11 @@ VideoReceiveStream2::VideoReceiveStream2(
                                                      true),
       maximum_pre_stream_decoders_("max", kDefaultMaximumPreStreamDecoders),
       decode_sync_(decode_sync),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_pool_(decode_pool),
+      decode_queue_(decode_pool_ ? decode_pool_->CreateSequence("DecodingQueue")
+                                 : task_queue_factory_->CreateTaskQueue(
+                                       "DecodingQueue",
+                                       TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(call_->worker_thread());
@@ -274,7 +279,7 @@ VideoReceiveStream2::VideoReceiveStream2(
   frame_buffer_ = FrameBufferProxy::CreateFromFieldTrial(
       clock_, call_->worker_thread(), timing_.get(), &stats_proxy_,
       &decode_queue_, this, TimeDelta::Millis(max_wait_for_keyframe_ms_),
-      TimeDelta::Millis(max_wait_for_frame_ms_), decode_sync_);
+      TimeDelta::Millis(max_wait_for_frame_ms_), decode_sync_, decode_pool_);
 
   if (config_.rtp.rtx_ssrc) {
     rtx_receive_stream_ = std::make_unique<RtxReceiveStream>(
@@ -32,6 +32,7 @@
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
+#include "video/decode_thread_pool.h"
 #include "video/frame_buffer_proxy.h"
 #include "video/receive_statistics_proxy2.h"
 #include "video/rtp_streams_synchronizer2.h"
@@ -102,7 +103,9 @@ class VideoReceiveStream2
                       Clock* clock,
                       VCMTiming* timing,
                       NackPeriodicProcessor* nack_periodic_processor,
-                      DecodeSynchronizer* decode_sync);
+                      DecodeSynchronizer* decode_sync,
+                      MetronomeTaskScheduler* tick_scheduler,
+                      DecodeThreadPool* decode_pool);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -325,6 +328,8 @@ class VideoReceiveStream2
   FieldTrialParameter<int> maximum_pre_stream_decoders_;
 
   DecodeSynchronizer* decode_sync_;
+  // If set, `decode_queue_` is a sequence of this pool.
+  DecodeThreadPool* const decode_pool_;
 
   // Defined last so they are destroyed before all other members.
   rtc::TaskQueue decode_queue_;
@@ -106,7 +106,7 @@ class VideoReceiveStream2Test : public ::testing::Test {
         std::make_unique<webrtc::internal::VideoReceiveStream2>(
             task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
             &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-            &nack_periodic_processor_, nullptr);
+            &nack_periodic_processor_, nullptr, nullptr, nullptr);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
   }
@@ -286,7 +286,7 @@ class VideoReceiveStream2TestWithFakeDecoder : public ::testing::Test {
     video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream2(
         task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
         &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-        &nack_periodic_processor_, nullptr));
+        &nack_periodic_processor_, nullptr, nullptr, nullptr));
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     video_receive_stream_->SetAndGetRecordingState(std::move(state), false);
@@ -557,6 +557,7 @@ class VideoReceiveStream2TestWithSimulatedClock
                               time_controller_.GetClock(),
                               new VCMTiming(time_controller_.GetClock()),
                               &nack_periodic_processor_,
+                              nullptr,
                               nullptr) {
     video_receive_stream_.RegisterWithTransport(
         &rtp_stream_receiver_controller_);
@@ -742,7 +743,7 @@ class VideoReceiveStream2TestWithLazyDecoderCreation : public ::testing::Test {
         std::make_unique<webrtc::internal::VideoReceiveStream2>(
             task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
             &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-            &nack_periodic_processor_, nullptr);
+            &nack_periodic_processor_, nullptr, nullptr, nullptr);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
   }
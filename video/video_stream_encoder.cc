@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/queued_task.h"
@@ -1765,15 +1766,34 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
        !info.supports_native_handle)) {
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer =
+        video_frame.video_frame_buffer();
+    // Map native frames that the encoder can't consume to a format it prefers
+    // before cropping, as the native buffer may otherwise crop to I420.
+    if (buffer->type() == VideoFrameBuffer::Type::kNative) {
+      absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+          formats = info.preferred_pixel_formats;
+      if (formats.empty())
+        formats.push_back(VideoFrameBuffer::Type::kI420);
+      rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+          buffer->GetMappedFrameBuffer(formats);
+      if (mapped_buffer)
+        buffer = std::move(mapped_buffer);
+    }
     rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer;
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
+    ScaledFrameBufferCache* cache = settings_.scaled_frame_buffer_cache.get();
     if (crop_width_ < 4 && crop_height_ < 4) {
       // The difference is small, crop without scaling.
-      cropped_buffer = video_frame.video_frame_buffer()->CropAndScale(
-          crop_width_ / 2, crop_height_ / 2, cropped_width, cropped_height,
-          cropped_width, cropped_height);
+      cropped_buffer =
+          cache ? cache->CropAndScale(buffer, crop_width_ / 2, crop_height_ / 2,
+                                      cropped_width, cropped_height,
+                                      cropped_width, cropped_height)
+                : buffer->CropAndScale(crop_width_ / 2, crop_height_ / 2,
+                                       cropped_width, cropped_height,
+                                       cropped_width, cropped_height);
       update_rect.offset_x -= crop_width_ / 2;
       update_rect.offset_y -= crop_height_ / 2;
       update_rect.Intersect(
@@ -1781,8 +1801,9 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
 
     } else {
       // The difference is large, scale it.
-      cropped_buffer = video_frame.video_frame_buffer()->Scale(cropped_width,
-                                                               cropped_height);
+      cropped_buffer = cache
+                           ? cache->Scale(buffer, cropped_width, cropped_height)
+                           : buffer->Scale(cropped_width, cropped_height);
       if (!update_rect.IsEmpty()) {
         // Since we can't reason about pixels after scaling, we invalidate whole
         // picture, if anything changed.